@@ -0,0 +1,271 @@
+// Copyright 2010-2024 Google LLC
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Benchmark of the LP solvers available through MPSolver (glop, pdlp, clp,
+// ...) on a set of MPS or linear_solver.proto files.
+//
+// Each model is solved by each solver of --solvers, with each parameter set of
+// --parameter_sets. The benchmark outputs in CSV format:
+// - in --output, one line per solve with the status, objective, time,
+//   iterations and peak memory. For glop, it also gives the time spent in
+//   each phase (presolve, scaling, simplex, postsolve) and the number of
+//   factorizations, read from the profiling counters of util/stats.h;
+// - in --summary_output, one line per solver and parameter set with the
+//   number of optimal solves and the shifted geometric means of the time and
+//   iterations.
+//
+// Example:
+//   lp_benchmark --inputs=netlib/ --solvers=glop,pdlp \
+//     --parameter_sets='use_dual_simplex:true;use_dual_simplex:false'
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstdlib>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "absl/container/flat_hash_map.h"
+#include "absl/flags/flag.h"
+#include "absl/strings/str_cat.h"
+#include "absl/strings/str_format.h"
+#include "absl/strings/str_split.h"
+#include "absl/strings/string_view.h"
+#include "absl/time/time.h"
+#include "ortools/base/file.h"
+#include "ortools/base/filesystem.h"
+#include "ortools/base/helpers.h"
+#include "ortools/base/init_google.h"
+#include "ortools/base/logging.h"
+#include "ortools/base/path.h"
+#include "ortools/base/sysinfo.h"
+#include "ortools/base/timer.h"
+#include "ortools/linear_solver/linear_solver.h"
+#include "ortools/linear_solver/linear_solver.pb.h"
+#include "ortools/lp_data/model_reader.h"
+#include "ortools/util/stats.h"
+
+ABSL_FLAG(std::string, inputs, "",
+          "Comma-separated list of model files (MPS, possibly gzipped, or "
+          "MPModelProto/MPModelRequest) or of directories, in which case all "
+          "the files they contain are used.");
+ABSL_FLAG(std::string, solvers, "glop",
+          "Comma-separated list of the MPSolver ids of the solvers to run.");
+ABSL_FLAG(std::string, parameter_sets, "",
+          "Semicolon-separated list of solver specific parameters, in the "
+          "format of SetSolverSpecificParametersAsString(). Each model is "
+          "solved once per parameter set. The empty default means one solve "
+          "with the default parameters.");
+ABSL_FLAG(double, time_limit, 300.0, "Time limit of each solve, in seconds.");
+ABSL_FLAG(double, time_shift, 1.0,
+          "Shift of the geometric means of the times, in seconds.");
+ABSL_FLAG(std::string, output, "",
+          "If non-empty, write the per-solve CSV there instead of on stdout.");
+ABSL_FLAG(std::string, summary_output, "",
+          "If non-empty, write the summary CSV there instead of on stdout.");
+
+namespace operations_research {
+namespace {
+
+// Returns the files of --inputs, sorted so that the output does not depend on
+// the order of the files in a directory.
+std::vector<std::string> GetInputFiles() {
+  std::vector<std::string> files;
+  for (const absl::string_view input :
+       absl::StrSplit(absl::GetFlag(FLAGS_inputs), ',', absl::SkipEmpty())) {
+    if (file::IsDirectory(input, file::Defaults()).ok()) {
+      std::vector<std::string> directory_files;
+      CHECK_OK(file::Match(file::JoinPath(input, "*"), &directory_files,
+                           file::Defaults()));
+      for (const std::string& filename : directory_files) {
+        if (!file::IsDirectory(filename, file::Defaults()).ok()) {
+          files.push_back(filename);
+        }
+      }
+    } else {
+      files.push_back(std::string(input));
+    }
+  }
+  std::sort(files.begin(), files.end());
+  return files;
+}
+
+struct SolveResult {
+  MPSolver::ResultStatus status = MPSolver::NOT_SOLVED;
+  double objective = 0.0;
+  double wall_time = 0.0;
+  int64_t iterations = 0;
+  // The glop phases. They stay at zero for the other solvers.
+  double presolve_time = 0.0;
+  double scaling_time = 0.0;
+  double simplex_time = 0.0;
+  double postsolve_time = 0.0;
+  int64_t num_factorizations = 0;
+  int64_t peak_memory = 0;
+};
+
+SolveResult Solve(const MPModelProto& model, absl::string_view solver_id,
+                  const std::string& parameters) {
+  SolveResult result;
+  std::unique_ptr<MPSolver> solver(
+      MPSolver::CreateSolver(std::string(solver_id)));
+  if (solver == nullptr) {
+    LOG(WARNING) << "Solver '" << solver_id << "' is not available.";
+    result.status = MPSolver::MODEL_INVALID;
+    return result;
+  }
+  std::string error;
+  if (solver->LoadModelFromProto(model, &error) !=
+      MPSolverResponseStatus::MPSOLVER_MODEL_IS_VALID) {
+    LOG(WARNING) << "Invalid model '" << model.name() << "': " << error;
+    result.status = MPSolver::MODEL_INVALID;
+    return result;
+  }
+  if (!solver->SetSolverSpecificParametersAsString(parameters)) {
+    LOG(WARNING) << "Invalid parameters for '" << solver_id
+                 << "': " << parameters;
+    result.status = MPSolver::MODEL_INVALID;
+    return result;
+  }
+  solver->SetTimeLimit(absl::Seconds(absl::GetFlag(FLAGS_time_limit)));
+
+  ResetProfilingCounters();
+  WallTimer timer;
+  timer.Start();
+  result.status = solver->Solve();
+  timer.Stop();
+
+  result.wall_time = timer.Get();
+  result.iterations = solver->iterations();
+  if (result.status == MPSolver::OPTIMAL ||
+      result.status == MPSolver::FEASIBLE) {
+    result.objective = solver->Objective().Value();
+  }
+  absl::flat_hash_map<std::string, ProfilingCounterSample> counters;
+  for (ProfilingCounterSample& sample : ProfilingCountersSnapshot()) {
+    counters[sample.name] = std::move(sample);
+  }
+  // The scaling is done by the glop preprocessor, so its time is removed from
+  // the presolve time.
+  result.scaling_time = counters["glop.Scaling"].total_seconds;
+  result.presolve_time =
+      counters["glop.Preprocess"].total_seconds - result.scaling_time;
+  result.simplex_time = counters["glop.RevisedSimplex"].total_seconds;
+  result.postsolve_time = counters["glop.Postsolve"].total_seconds;
+  result.num_factorizations = counters["glop.ComputeFactorization"].num_calls;
+  result.peak_memory = GetProcessPeakMemoryUsage();
+  return result;
+}
+
+// Accumulates the solves of a solver with a parameter set.
+struct SolverSummary {
+  std::string solver_id;
+  int parameter_set = 0;
+  int num_solves = 0;
+  int num_optimal = 0;
+  double sum_log_time = 0.0;
+  double sum_log_iterations = 0.0;
+
+  void Add(const SolveResult& result, double time_shift) {
+    ++num_solves;
+    if (result.status == MPSolver::OPTIMAL) ++num_optimal;
+    sum_log_time += std::log(result.wall_time + time_shift);
+    sum_log_iterations += std::log(result.iterations + 1.0);
+  }
+};
+
+void WriteCsv(const std::string& filename, const std::string& csv) {
+  if (filename.empty()) {
+    absl::PrintF("%s", csv);
+  } else {
+    CHECK_OK(file::SetContents(filename, csv, file::Defaults()));
+  }
+}
+
+void Run() {
+  const std::vector<std::string> parameter_sets =
+      absl::StrSplit(absl::GetFlag(FLAGS_parameter_sets), ';');
+  const std::vector<std::string> solver_ids =
+      absl::StrSplit(absl::GetFlag(FLAGS_solvers), ',', absl::SkipEmpty());
+  const double time_shift = absl::GetFlag(FLAGS_time_shift);
+
+  std::vector<SolverSummary> summaries;
+  for (const std::string& solver_id : solver_ids) {
+    for (int p = 0; p < parameter_sets.size(); ++p) {
+      summaries.push_back({.solver_id = solver_id, .parameter_set = p});
+    }
+  }
+
+  EnableProfilingCounters(true);
+  std::string csv =
+      "name,solver,parameter_set,status,objective,wall_time,iterations,"
+      "presolve_time,scaling_time,simplex_time,postsolve_time,"
+      "num_factorizations,peak_memory_bytes\n";
+  for (const std::string& filename : GetInputFiles()) {
+    MPModelProto model;
+    if (!glop::LoadMPModelProtoFromModelOrRequest(filename, &model)) {
+      LOG(WARNING) << "Cannot load '" << filename << "'.";
+      continue;
+    }
+    const std::string name = model.name().empty()
+                                 ? std::string(file::Basename(filename))
+                                 : model.name();
+    int summary_index = 0;
+    for (const std::string& solver_id : solver_ids) {
+      for (int p = 0; p < parameter_sets.size(); ++p) {
+        LOG(INFO) << "Solving '" << name << "' with " << solver_id
+                  << " and parameter set #" << p << ".";
+        const SolveResult result = Solve(model, solver_id, parameter_sets[p]);
+        summaries[summary_index++].Add(result, time_shift);
+        // The values of MPSolver::ResultStatus are the ones of the
+        // corresponding MPSolverResponseStatus.
+        absl::StrAppendFormat(
+            &csv, "%s,%s,%d,%s,%.15g,%.3f,%d,%.3f,%.3f,%.3f,%.3f,%d,%d\n",
+            name, solver_id, p,
+            MPSolverResponseStatus_Name(
+                static_cast<MPSolverResponseStatus>(result.status)),
+            result.objective, result.wall_time, result.iterations,
+            result.presolve_time, result.scaling_time, result.simplex_time,
+            result.postsolve_time, result.num_factorizations,
+            result.peak_memory);
+      }
+    }
+  }
+  EnableProfilingCounters(false);
+  WriteCsv(absl::GetFlag(FLAGS_output), csv);
+
+  std::string summary_csv =
+      "solver,parameter_set,parameters,num_solves,num_optimal,"
+      "shifted_geomean_time,geomean_iterations\n";
+  for (const SolverSummary& summary : summaries) {
+    const double n = std::max(summary.num_solves, 1);
+    absl::StrAppendFormat(
+        &summary_csv, "%s,%d,\"%s\",%d,%d,%.3f,%.1f\n", summary.solver_id,
+        summary.parameter_set, parameter_sets[summary.parameter_set],
+        summary.num_solves, summary.num_optimal,
+        std::exp(summary.sum_log_time / n) - time_shift,
+        std::exp(summary.sum_log_iterations / n) - 1.0);
+  }
+  WriteCsv(absl::GetFlag(FLAGS_summary_output), summary_csv);
+}
+
+}  // namespace
+}  // namespace operations_research
+
+int main(int argc, char** argv) {
+  InitGoogle(argv[0], &argc, &argv, true);
+  operations_research::Run();
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,395 @@
+// Copyright 2010-2024 Google LLC
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Benchmark of the routing library on instances read by the parsers of
+// ortools/routing/parsers:
+// - Solomon instances (capacitated vehicle routing with time windows),
+// - Li & Lim instances (pickup and delivery with time windows),
+// - TSPLIB instances (TSP, ATSP and CVRP).
+//
+// Each instance is solved with the given RoutingSearchParameters, and the
+// benchmark outputs in CSV format:
+// - in --output, one line per instance with the time to the first solution,
+//   the number of local search neighbors and filter calls per second, and the
+//   final gap to the best known solution;
+// - in --solutions_output, one line per solution found, which gives the gap
+//   to the best known solution over time.
+//
+// Example:
+//   routing_benchmark --format=solomon --instances=c101.txt,r101.txt \
+//     --best_known_solutions=bks.txt \
+//     --routing_search_parameters='time_limit:{seconds:10}'
+// where bks.txt contains lines like "c101 828.94".
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstdlib>
+#include <optional>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "absl/container/flat_hash_map.h"
+#include "absl/flags/flag.h"
+#include "absl/strings/numbers.h"
+#include "absl/strings/str_cat.h"
+#include "absl/strings/str_format.h"
+#include "absl/strings/str_split.h"
+#include "absl/strings/string_view.h"
+#include "google/protobuf/text_format.h"
+#include "ortools/base/file.h"
+#include "ortools/base/helpers.h"
+#include "ortools/base/init_google.h"
+#include "ortools/base/logging.h"
+#include "ortools/base/path.h"
+#include "ortools/base/timer.h"
+#include "ortools/constraint_solver/routing.h"
+#include "ortools/constraint_solver/routing_index_manager.h"
+#include "ortools/constraint_solver/routing_parameters.h"
+#include "ortools/constraint_solver/routing_parameters.pb.h"
+#include "ortools/constraint_solver/search_stats.pb.h"
+#include "ortools/routing/parsers/lilim_parser.h"
+#include "ortools/routing/parsers/solomon_parser.h"
+#include "ortools/routing/parsers/tsplib_parser.h"
+
+ABSL_FLAG(std::string, instances, "",
+          "Comma-separated list of the instance files to solve.");
+ABSL_FLAG(std::string, format, "solomon",
+          "Format of the instances: solomon, lilim or tsplib.");
+ABSL_FLAG(std::string, best_known_solutions, "",
+          "If non-empty, a file with one line per instance containing its "
+          "name (the file name without directory and extension) and the cost "
+          "of its best known solution, separated by a space.");
+ABSL_FLAG(std::string, routing_search_parameters, "",
+          "Text proto RoutingSearchParameters (possibly partial) that will "
+          "override the DefaultRoutingSearchParameters().");
+ABSL_FLAG(std::string, output, "",
+          "If non-empty, write the per-instance CSV there instead of on "
+          "stdout.");
+ABSL_FLAG(std::string, solutions_output, "",
+          "If non-empty, write there the CSV of all the solutions found, "
+          "with their time and gap to the best known solution.");
+
+namespace operations_research {
+namespace {
+
+// Scaling factor used to scale up the Euclidean distances of the Solomon and
+// Li & Lim instances, which are not integers.
+const int64_t kScalingFactor = 1000;
+
+// The data of an instance, common to all the formats.
+struct RoutingInstance {
+  std::string name;
+  int num_nodes = 0;
+  int num_vehicles = 0;
+  int depot = 0;
+  // The costs of the arcs, in the units of the model, that is after scaling
+  // by cost_scaling. Indexed by from * num_nodes + to.
+  std::vector<int64_t> costs;
+  int64_t cost_scaling = 1;
+  // Empty if there is no capacity constraint.
+  std::vector<int64_t> demands;
+  int64_t capacity = 0;
+  // Empty if there are no time windows. The travel times include the service
+  // time of the origin, and are scaled like the costs.
+  std::vector<SimpleTimeWindow<int64_t>> time_windows;
+  std::vector<int64_t> travel_times;
+  std::vector<std::pair<int, int>> pickup_deliveries;
+
+  int64_t Cost(int from, int to) const { return costs[from * num_nodes + to]; }
+  int64_t TravelTime(int from, int to) const {
+    return travel_times[from * num_nodes + to];
+  }
+};
+
+std::string InstanceName(absl::string_view filename) {
+  return std::string(file::Stem(file::Basename(filename)));
+}
+
+// Fills the fields of `instance` shared by the Solomon and Li & Lim formats.
+template <typename Parser>
+void FillTimeWindowInstance(const Parser& parser, RoutingInstance* instance) {
+  const int num_nodes = parser.NumberOfNodes();
+  instance->num_nodes = num_nodes;
+  instance->num_vehicles = parser.NumberOfVehicles();
+  instance->depot = parser.Depot();
+  instance->cost_scaling = kScalingFactor;
+  instance->capacity = parser.capacity();
+  instance->demands = parser.demands();
+  instance->costs.resize(num_nodes * num_nodes);
+  instance->travel_times.resize(num_nodes * num_nodes);
+  for (int from = 0; from < num_nodes; ++from) {
+    for (int to = 0; to < num_nodes; ++to) {
+      instance->costs[from * num_nodes + to] =
+          std::round(kScalingFactor * parser.GetDistance(from, to));
+      instance->travel_times[from * num_nodes + to] =
+          std::round(kScalingFactor * parser.GetTravelTime(from, to));
+    }
+  }
+  for (const SimpleTimeWindow<int64_t>& window : parser.time_windows()) {
+    instance->time_windows.push_back(
+        {kScalingFactor * window.start, kScalingFactor * window.end});
+  }
+}
+
+bool LoadInstance(const std::string& filename, absl::string_view format,
+                  RoutingInstance* instance) {
+  instance->name = InstanceName(filename);
+  if (format == "solomon") {
+    SolomonParser parser;
+    if (!parser.LoadFile(filename)) return false;
+    FillTimeWindowInstance(parser, instance);
+  } else if (format == "lilim") {
+    LiLimParser parser;
+    if (!parser.LoadFile(filename)) return false;
+    FillTimeWindowInstance(parser, instance);
+    for (int node = 0; node < parser.NumberOfNodes(); ++node) {
+      const std::optional<int> delivery = parser.GetDelivery(node);
+      if (delivery.has_value()) {
+        instance->pickup_deliveries.push_back({node, *delivery});
+      }
+    }
+  } else if (format == "tsplib") {
+    TspLibParser parser;
+    if (!parser.LoadFile(filename)) return false;
+    const int num_nodes = parser.size();
+    instance->num_nodes = num_nodes;
+    instance->depot = parser.depot();
+    // There is no number of vehicles in the CVRP instances of TSPLIB, we
+    // allow one vehicle per customer.
+    instance->num_vehicles =
+        parser.type() == TspLibParser::CVRP ? std::max(num_nodes - 1, 1) : 1;
+    if (parser.type() == TspLibParser::CVRP) {
+      instance->capacity = parser.capacity();
+      instance->demands = parser.demands();
+    }
+    const EdgeWeights weights = parser.GetEdgeWeights();
+    instance->costs.resize(num_nodes * num_nodes);
+    for (int from = 0; from < num_nodes; ++from) {
+      for (int to = 0; to < num_nodes; ++to) {
+        instance->costs[from * num_nodes + to] = weights(from, to);
+      }
+    }
+  } else {
+    LOG(FATAL) << "Unknown format: " << format;
+  }
+  return instance->num_nodes > 0;
+}
+
+// Returns the best known solution cost of each instance name.
+absl::flat_hash_map<std::string, double> ReadBestKnownSolutions(
+    const std::string& filename) {
+  absl::flat_hash_map<std::string, double> best_known_solutions;
+  if (filename.empty()) return best_known_solutions;
+  std::string contents;
+  CHECK_OK(file::GetContents(filename, &contents, file::Defaults()));
+  for (const absl::string_view line :
+       absl::StrSplit(contents, '\n', absl::SkipEmpty())) {
+    const std::vector<absl::string_view> words =
+        absl::StrSplit(line, ' ', absl::SkipEmpty());
+    double value;
+    if (words.size() != 2 || !absl::SimpleAtod(words[1], &value)) {
+      LOG(WARNING) << "Malformed best known solution line: " << line;
+      continue;
+    }
+    best_known_solutions[words[0]] = value;
+  }
+  return best_known_solutions;
+}
+
+// The statistics of one solve.
+struct BenchmarkResult {
+  bool solved = false;
+  double cost = 0.0;
+  double wall_time = 0.0;
+  double first_solution_time = 0.0;
+  int64_t num_neighbors = 0;
+  int64_t num_filtered_neighbors = 0;
+  int64_t num_accepted_neighbors = 0;
+  int64_t num_filter_calls = 0;
+  // The time and the (unscaled) cost of each solution found.
+  std::vector<std::pair<double, double>> solutions;
+};
+
+BenchmarkResult Solve(const RoutingInstance& instance,
+                      const RoutingSearchParameters& search_parameters) {
+  RoutingIndexManager manager(instance.num_nodes, instance.num_vehicles,
+                              RoutingIndexManager::NodeIndex(instance.depot));
+  RoutingModelParameters model_parameters = DefaultRoutingModelParameters();
+  // Needed to get the local search statistics.
+  model_parameters.mutable_solver_parameters()->set_profile_local_search(true);
+  RoutingModel routing(manager, model_parameters);
+
+  const int cost_evaluator = routing.RegisterTransitCallback(
+      [&instance, &manager](int64_t i, int64_t j) {
+        return instance.Cost(manager.IndexToNode(i).value(),
+                             manager.IndexToNode(j).value());
+      });
+  routing.SetArcCostEvaluatorOfAllVehicles(cost_evaluator);
+  if (!instance.demands.empty()) {
+    routing.AddDimension(
+        routing.RegisterUnaryTransitCallback(
+            [&instance, &manager](int64_t i) {
+              return instance.demands[manager.IndexToNode(i).value()];
+            }),
+        0, instance.capacity, /*fix_start_cumul_to_zero=*/true, "demand");
+  }
+  if (!instance.time_windows.empty()) {
+    int64_t horizon = 0;
+    for (const SimpleTimeWindow<int64_t>& window : instance.time_windows) {
+      horizon = std::max(horizon, window.end);
+    }
+    routing.AddDimension(routing.RegisterTransitCallback(
+                             [&instance, &manager](int64_t i, int64_t j) {
+                               return instance.TravelTime(
+                                   manager.IndexToNode(i).value(),
+                                   manager.IndexToNode(j).value());
+                             }),
+                         horizon, horizon, /*fix_start_cumul_to_zero=*/false,
+                         "time");
+    const RoutingDimension& time_dimension = routing.GetDimensionOrDie("time");
+    for (int node = 0; node < instance.num_nodes; ++node) {
+      if (node == instance.depot) continue;
+      time_dimension
+          .CumulVar(manager.NodeToIndex(RoutingIndexManager::NodeIndex(node)))
+          ->SetRange(instance.time_windows[node].start,
+                     instance.time_windows[node].end);
+    }
+    for (int vehicle = 0; vehicle < instance.num_vehicles; ++vehicle) {
+      const SimpleTimeWindow<int64_t>& window =
+          instance.time_windows[instance.depot];
+      time_dimension.CumulVar(routing.Start(vehicle))
+          ->SetRange(window.start, window.end);
+      time_dimension.CumulVar(routing.End(vehicle))
+          ->SetRange(window.start, window.end);
+    }
+    Solver* const solver = routing.solver();
+    for (const auto& [pickup, delivery] : instance.pickup_deliveries) {
+      const int64_t pickup_index =
+          manager.NodeToIndex(RoutingIndexManager::NodeIndex(pickup));
+      const int64_t delivery_index =
+          manager.NodeToIndex(RoutingIndexManager::NodeIndex(delivery));
+      routing.AddPickupAndDelivery(pickup_index, delivery_index);
+      solver->AddConstraint(
+          solver->MakeEquality(routing.VehicleVar(pickup_index),
+                               routing.VehicleVar(delivery_index)));
+      solver->AddConstraint(
+          solver->MakeLessOrEqual(time_dimension.CumulVar(pickup_index),
+                                  time_dimension.CumulVar(delivery_index)));
+    }
+  }
+
+  BenchmarkResult result;
+  WallTimer timer;
+  routing.AddAtSolutionCallback([&result, &routing, &timer, &instance]() {
+    result.solutions.push_back(
+        {timer.Get(), static_cast<double>(routing.CostVar()->Min()) /
+                          instance.cost_scaling});
+  });
+  timer.Start();
+  const Assignment* solution = routing.SolveWithParameters(search_parameters);
+  timer.Stop();
+
+  result.wall_time = timer.Get();
+  if (!result.solutions.empty()) {
+    result.first_solution_time = result.solutions.front().first;
+  }
+  if (solution != nullptr) {
+    result.solved = true;
+    result.cost =
+        static_cast<double>(solution->ObjectiveValue()) / instance.cost_scaling;
+  }
+  const LocalSearchStatistics statistics = routing.GetLocalSearchStatistics();
+  result.num_neighbors = statistics.total_num_neighbors();
+  result.num_filtered_neighbors = statistics.total_num_filtered_neighbors();
+  result.num_accepted_neighbors = statistics.total_num_accepted_neighbors();
+  for (const LocalSearchStatistics::LocalSearchFilterStatistics& filter :
+       statistics.local_search_filter_statistics()) {
+    result.num_filter_calls += filter.num_calls();
+  }
+  return result;
+}
+
+// Returns the relative gap of `cost` to the best known solution of `name`, or
+// NaN if it is unknown.
+double Gap(const absl::flat_hash_map<std::string, double>& best_known,
+           const std::string& name, double cost) {
+  const auto it = best_known.find(name);
+  if (it == best_known.end() || it->second == 0.0) return std::nan("");
+  return (cost - it->second) / it->second;
+}
+
+double Rate(int64_t count, double time) {
+  return time > 0.0 ? static_cast<double>(count) / time : 0.0;
+}
+
+void WriteCsv(const std::string& filename, const std::string& csv) {
+  if (filename.empty()) {
+    absl::PrintF("%s", csv);
+  } else {
+    CHECK_OK(file::SetContents(filename, csv, file::Defaults()));
+  }
+}
+
+void Run(const RoutingSearchParameters& search_parameters) {
+  const absl::flat_hash_map<std::string, double> best_known =
+      ReadBestKnownSolutions(absl::GetFlag(FLAGS_best_known_solutions));
+  std::string summary_csv =
+      "name,num_nodes,num_vehicles,solved,cost,gap,wall_time,"
+      "first_solution_time,num_neighbors,num_filtered_neighbors,"
+      "num_accepted_neighbors,num_filter_calls,neighbors_per_second,"
+      "filter_calls_per_second\n";
+  std::string solutions_csv = "name,time,cost,gap\n";
+  for (const absl::string_view filename :
+       absl::StrSplit(absl::GetFlag(FLAGS_instances), ',', absl::SkipEmpty())) {
+    RoutingInstance instance;
+    if (!LoadInstance(std::string(filename), absl::GetFlag(FLAGS_format),
+                      &instance)) {
+      LOG(WARNING) << "Cannot load instance '" << filename << "'.";
+      continue;
+    }
+    LOG(INFO) << "Solving '" << instance.name << "'.";
+    const BenchmarkResult result = Solve(instance, search_parameters);
+    absl::StrAppendFormat(
+        &summary_csv, "%s,%d,%d,%d,%.3f,%.6g,%.3f,%.3f,%d,%d,%d,%d,%.6g,%.6g\n",
+        instance.name, instance.num_nodes, instance.num_vehicles,
+        result.solved, result.cost, Gap(best_known, instance.name, result.cost),
+        result.wall_time, result.first_solution_time, result.num_neighbors,
+        result.num_filtered_neighbors, result.num_accepted_neighbors,
+        result.num_filter_calls, Rate(result.num_neighbors, result.wall_time),
+        Rate(result.num_filter_calls, result.wall_time));
+    for (const auto& [time, cost] : result.solutions) {
+      absl::StrAppendFormat(&solutions_csv, "%s,%.3f,%.3f,%.6g\n",
+                            instance.name, time, cost,
+                            Gap(best_known, instance.name, cost));
+    }
+  }
+  WriteCsv(absl::GetFlag(FLAGS_output), summary_csv);
+  if (!absl::GetFlag(FLAGS_solutions_output).empty()) {
+    WriteCsv(absl::GetFlag(FLAGS_solutions_output), solutions_csv);
+  }
+}
+
+}  // namespace
+}  // namespace operations_research
+
+int main(int argc, char** argv) {
+  InitGoogle(argv[0], &argc, &argv, true);
+  operations_research::RoutingSearchParameters search_parameters =
+      operations_research::DefaultRoutingSearchParameters();
+  CHECK(google::protobuf::TextFormat::MergeFromString(
+      absl::GetFlag(FLAGS_routing_search_parameters), &search_parameters));
+  operations_research::Run(search_parameters);
+  return EXIT_SUCCESS;
+}
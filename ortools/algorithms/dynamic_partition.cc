@@ -20,6 +20,7 @@
 #include <vector>
 
 #include "absl/log/check.h"
+#include "absl/numeric/bits.h"
 #include "absl/strings/str_join.h"
 #include "absl/types/span.h"
 #include "ortools/base/murmur.h"
@@ -127,9 +128,21 @@ void DynamicPartition::Refine(absl::Span<const int> distinguished_subset) {
   }
 
   // Sort affected parts. This is important to behave as advertised in the .h.
-  // TODO(user): automatically switch to an O(N) sort when it's faster
-  // than this one, which is O(K log K) with K = tmp_affected_parts_.size().
-  std::sort(tmp_affected_parts_.begin(), tmp_affected_parts_.end());
+  // The affected parts are exactly those with a nonzero counter, so scanning
+  // tmp_counter_of_part_ sorts them in O(NumParts()), which beats the
+  // O(K log K) sort (with K = tmp_affected_parts_.size()) when many parts are
+  // affected, as in the first refinements of a big graph.
+  const int num_affected_parts = tmp_affected_parts_.size();
+  if (int64_t{num_affected_parts} *
+          absl::bit_width(static_cast<uint32_t>(num_affected_parts)) >
+      NumParts()) {
+    tmp_affected_parts_.clear();
+    for (int part = 0; part < NumParts(); ++part) {
+      if (tmp_counter_of_part_[part] > 0) tmp_affected_parts_.push_back(part);
+    }
+  } else {
+    std::sort(tmp_affected_parts_.begin(), tmp_affected_parts_.end());
+  }
 
   // Iterate on each affected part and split it, or keep it intact if all
   // of its elements were distinguished.
@@ -144,22 +157,21 @@ void DynamicPartition::Refine(absl::Span<const int> distinguished_subset) {
     // Do nothing if all elements were distinguished.
     if (split_index == start_index) continue;
 
-    // Compute the fingerprint of the new part.
+    // Compute the fingerprint of the new part, and move its elements to it, in
+    // a single pass.
+    const int new_part = NumParts();
     uint64_t new_fprint = 0;
     for (int i = split_index; i < end_index; ++i) {
-      new_fprint ^= FprintOfInt32(element_[i]);
+      const int element = element_[i];
+      new_fprint ^= FprintOfInt32(element);
+      part_of_[element] = new_part;
     }
 
-    const int new_part = NumParts();
-
     // Perform the split.
     part_[part].end_index = split_index;
     part_[part].fprint ^= new_fprint;
     part_.push_back(Part(/*start_index*/ split_index, /*end_index*/ end_index,
                          /*parent_part*/ part, new_fprint));
-    for (const int element : ElementsInPart(new_part)) {
-      part_of_[element] = new_part;
-    }
   }
 }
 
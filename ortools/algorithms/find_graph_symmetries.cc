@@ -175,7 +175,7 @@ GraphSymmetryFinder::GraphSymmetryFinder(const Graph& graph, bool is_undirected)
       tmp_dynamic_permutation_(NumNodes()),
       tmp_node_mask_(NumNodes(), false),
       tmp_degree_(NumNodes(), 0),
-      tmp_nodes_with_degree_(NumNodes() + 1) {
+      tmp_degree_start_(NumNodes() + 1, 0) {
   // Set up an "unlimited" time limit by default.
   time_limit_ = &dummy_time_limit_;
   tmp_partition_.Reset(NumNodes());
@@ -309,24 +309,43 @@ void GraphSymmetryFinder::RecursivelyRefinePartitionByAdjacency(
               &tmp_nodes_with_nonzero_degree, &num_operations);
         }
       }
-      // Group the nodes by (nonzero) degree. Remember the maximum degree.
+      // Group the nodes by (nonzero) degree, with a counting sort into a flat
+      // buffer. tmp_degree_start_[d] first counts the nodes of degree d, and
+      // then becomes the start of their range.
       int max_degree = 0;
       num_operations += 3 + tmp_nodes_with_nonzero_degree.size();
       for (const int node : tmp_nodes_with_nonzero_degree) {
         const int degree = tmp_degree_[node];
-        tmp_degree_[node] = 0;  // To clean up after us.
         max_degree = std::max(max_degree, degree);
-        tmp_nodes_with_degree_[degree].push_back(node);
+        ++tmp_degree_start_[degree];
+      }
+      int num_nodes_with_lower_degree = 0;
+      for (int degree = 1; degree <= max_degree; ++degree) {
+        const int num_nodes_with_degree = tmp_degree_start_[degree];
+        tmp_degree_start_[degree] = num_nodes_with_lower_degree;
+        num_nodes_with_lower_degree += num_nodes_with_degree;
+      }
+      tmp_nodes_sorted_by_degree_.resize(tmp_nodes_with_nonzero_degree.size());
+      for (const int node : tmp_nodes_with_nonzero_degree) {
+        int& degree = tmp_degree_[node];
+        tmp_nodes_sorted_by_degree_[tmp_degree_start_[degree]++] = node;
+        degree = 0;  // To clean up after us.
       }
       tmp_nodes_with_nonzero_degree.clear();  // To clean up after us.
       // For each degree, refine the partition by the set of nodes with that
-      // degree.
+      // degree. The placement above shifted tmp_degree_start_[d] to the end of
+      // the range of degree d.
+      int start = 0;
       for (int degree = 1; degree <= max_degree; ++degree) {
+        const int end = tmp_degree_start_[degree];
+        tmp_degree_start_[degree] = 0;  // To clean up after us.
         // We use a manually tuned factor 3 because Refine() does quite a bit of
         // operations for each node in its argument.
-        num_operations += 1 + 3 * tmp_nodes_with_degree_[degree].size();
-        partition->Refine(tmp_nodes_with_degree_[degree]);
-        tmp_nodes_with_degree_[degree].clear();  // To clean up after us.
+        num_operations += 1 + 3 * (end - start);
+        if (end == start) continue;
+        partition->Refine(absl::MakeConstSpan(tmp_nodes_sorted_by_degree_)
+                              .subspan(start, end - start));
+        start = end;
       }
     }
   }
@@ -341,7 +360,7 @@ void GraphSymmetryFinder::RecursivelyRefinePartitionByAdjacency(
 void GraphSymmetryFinder::DistinguishNodeInPartition(
     int node, DynamicPartition* partition, std::vector<int>* new_singletons) {
   const int original_num_parts = partition->NumParts();
-  partition->Refine(std::vector<int>(1, node));
+  partition->Refine(absl::MakeConstSpan(&node, 1));
   RecursivelyRefinePartitionByAdjacency(partition->PartOf(node), partition);
 
   // Explore the newly refined parts to gather all the new singletons.
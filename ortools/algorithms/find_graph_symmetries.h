@@ -242,7 +242,8 @@ class GraphSymmetryFinder {
   mutable std::vector<bool> tmp_node_mask_;              // [0..N-1] = false
   std::vector<int> tmp_degree_;                          // [0..N-1] = 0.
   std::vector<int> tmp_stack_;                           // Empty.
-  std::vector<std::vector<int>> tmp_nodes_with_degree_;  // [0..N-1] = [].
+  std::vector<int> tmp_degree_start_;                    // [0..N] = 0.
+  std::vector<int> tmp_nodes_sorted_by_degree_;          // Any content.
   MergingPartition tmp_partition_;                       // Reset(N).
   std::vector<const SparsePermutation*> tmp_compatible_permutations_;  // Empty.
 
@@ -15,13 +15,16 @@
 
 #include <algorithm>
 #include <cmath>
+#include <cstdint>
 #include <cstdio>
 #include <limits>
+#include <memory>
 #include <vector>
 
 #include "absl/strings/str_format.h"
 #include "absl/types/span.h"
 #include "ortools/base/logging.h"
+#include "ortools/base/threadpool.h"
 
 namespace operations_research {
 
@@ -688,4 +691,196 @@ void MaximizeLinearAssignment(
   }
 }
 
+bool DenseAssignmentSolver::Solve(absl::Span<const double> costs,
+                                  int num_rows, int num_cols,
+                                  absl::Span<int> row_to_col) {
+  CHECK_GE(num_rows, 0);
+  CHECK_GE(num_cols, 0);
+  CHECK_EQ(costs.size(), static_cast<int64_t>(num_rows) * num_cols);
+  CHECK_EQ(row_to_col.size(), num_rows);
+  cost_ = 0.0;
+  for (const double cost : costs) {
+    if (std::isnan(cost) || cost == -std::numeric_limits<double>::infinity()) {
+      return false;
+    }
+  }
+  if (num_rows <= num_cols) {
+    if (!SolveWithFewerRows(costs.data(), num_rows, num_cols)) return false;
+    for (int row = 0; row < num_rows; ++row) {
+      row_to_col[row] = col_of_row_[row];
+      cost_ += costs[static_cast<int64_t>(row) * num_cols + col_of_row_[row]];
+    }
+    return true;
+  }
+  // Assign the columns instead, on the transposed matrix.
+  transposed_costs_.resize(costs.size());
+  for (int row = 0; row < num_rows; ++row) {
+    for (int col = 0; col < num_cols; ++col) {
+      transposed_costs_[static_cast<int64_t>(col) * num_rows + row] =
+          costs[static_cast<int64_t>(row) * num_cols + col];
+    }
+  }
+  if (!SolveWithFewerRows(transposed_costs_.data(), num_cols, num_rows)) {
+    return false;
+  }
+  std::fill(row_to_col.begin(), row_to_col.end(), -1);
+  for (int col = 0; col < num_cols; ++col) {
+    const int row = col_of_row_[col];
+    row_to_col[row] = col;
+    cost_ += costs[static_cast<int64_t>(row) * num_cols + col];
+  }
+  return true;
+}
+
+bool DenseAssignmentSolver::SolveWithFewerRows(const double* costs,
+                                               int num_rows, int num_cols) {
+  DCHECK_LE(num_rows, num_cols);
+  row_potential_.assign(num_rows, 0.0);
+  col_potential_.assign(num_cols, 0.0);
+  col_of_row_.assign(num_rows, -1);
+  row_of_col_.assign(num_cols, -1);
+  path_.assign(num_cols, -1);
+  shortest_path_length_.resize(num_cols);
+  remaining_cols_.resize(num_cols);
+  row_is_scanned_.resize(num_rows);
+  col_is_scanned_.resize(num_cols);
+  if (num_rows == num_cols) {
+    // The column reduction of Jonker and Volgenant: the column potentials are
+    // the column minima, and each column is assigned to the row of its minimum
+    // if that row is still free. This leaves far fewer rows to augment. It
+    // would break the optimality conditions of the rectangular case, where
+    // the columns left unassigned must keep a zero potential.
+    for (int col = 0; col < num_cols; ++col) {
+      int best_row = 0;
+      for (int row = 1; row < num_rows; ++row) {
+        if (costs[static_cast<int64_t>(row) * num_cols + col] <
+            costs[static_cast<int64_t>(best_row) * num_cols + col]) {
+          best_row = row;
+        }
+      }
+      col_potential_[col] =
+          costs[static_cast<int64_t>(best_row) * num_cols + col];
+      // A column of forbidden assignments is detected by the search below.
+      if (col_potential_[col] == std::numeric_limits<double>::infinity()) {
+        col_potential_[col] = 0.0;
+      } else if (col_of_row_[best_row] == -1) {
+        col_of_row_[best_row] = col;
+        row_of_col_[col] = best_row;
+      }
+    }
+  }
+  for (int start_row = 0; start_row < num_rows; ++start_row) {
+    if (col_of_row_[start_row] != -1) continue;
+    double length;
+    const int sink = FindShortestAugmentingPath(costs, num_rows, num_cols,
+                                                start_row, &length);
+    if (sink < 0) return false;
+
+    // Update the potentials so that the reduced costs stay non-negative and
+    // are zero on the (new) assignment.
+    row_potential_[start_row] += length;
+    for (int row = 0; row < num_rows; ++row) {
+      if (row_is_scanned_[row] && row != start_row) {
+        row_potential_[row] +=
+            length - shortest_path_length_[col_of_row_[row]];
+      }
+    }
+    for (int col = 0; col < num_cols; ++col) {
+      if (col_is_scanned_[col]) {
+        col_potential_[col] -= length - shortest_path_length_[col];
+      }
+    }
+
+    // Augment along the path.
+    int col = sink;
+    while (true) {
+      const int row = path_[col];
+      row_of_col_[col] = row;
+      std::swap(col_of_row_[row], col);
+      if (row == start_row) break;
+    }
+  }
+  return true;
+}
+
+int DenseAssignmentSolver::FindShortestAugmentingPath(const double* costs,
+                                                      int num_rows,
+                                                      int num_cols,
+                                                      int start_row,
+                                                      double* length) {
+  constexpr double kInfinity = std::numeric_limits<double>::infinity();
+  double min_length = 0.0;
+  int num_remaining = num_cols;
+  for (int i = 0; i < num_cols; ++i) remaining_cols_[i] = num_cols - i - 1;
+  std::fill(row_is_scanned_.begin(), row_is_scanned_.end(), false);
+  std::fill(col_is_scanned_.begin(), col_is_scanned_.end(), false);
+  std::fill(shortest_path_length_.begin(), shortest_path_length_.end(),
+            kInfinity);
+  int sink = -1;
+  int row = start_row;
+  while (sink == -1) {
+    row_is_scanned_[row] = true;
+    const double* const row_costs =
+        costs + static_cast<int64_t>(row) * num_cols;
+    const double base = min_length - row_potential_[row];
+    int best_index = -1;
+    double lowest = kInfinity;
+    for (int index = 0; index < num_remaining; ++index) {
+      const int col = remaining_cols_[index];
+      const double reduced = base + row_costs[col] - col_potential_[col];
+      if (reduced < shortest_path_length_[col]) {
+        path_[col] = row;
+        shortest_path_length_[col] = reduced;
+      }
+      // Among the closest columns, prefer an unassigned one, which ends the
+      // search.
+      if (shortest_path_length_[col] < lowest ||
+          (shortest_path_length_[col] == lowest && row_of_col_[col] == -1)) {
+        lowest = shortest_path_length_[col];
+        best_index = index;
+      }
+    }
+    min_length = lowest;
+    if (min_length == kInfinity) return -1;
+    const int col = remaining_cols_[best_index];
+    if (row_of_col_[col] == -1) {
+      sink = col;
+    } else {
+      row = row_of_col_[col];
+    }
+    col_is_scanned_[col] = true;
+    remaining_cols_[best_index] = remaining_cols_[--num_remaining];
+  }
+  *length = min_length;
+  return sink;
+}
+
+std::vector<double> SolveDenseAssignments(absl::Span<const double> costs,
+                                          int num_problems, int num_rows,
+                                          int num_cols, int num_threads,
+                                          absl::Span<int> row_to_col) {
+  CHECK_GE(num_threads, 1);
+  CHECK_GE(num_problems, 0);
+  const int64_t matrix_size = static_cast<int64_t>(num_rows) * num_cols;
+  CHECK_EQ(costs.size(), num_problems * matrix_size);
+  CHECK_EQ(row_to_col.size(), static_cast<int64_t>(num_problems) * num_rows);
+  std::vector<double> assignment_costs(num_problems);
+  std::unique_ptr<ThreadPool> thread_pool;
+  if (num_threads > 1) {
+    thread_pool = std::make_unique<ThreadPool>("DenseAssignments", num_threads);
+    thread_pool->StartWorkers();
+  }
+  std::vector<DenseAssignmentSolver> solvers(num_threads);
+  ParallelForEachItem(
+      thread_pool.get(), num_threads, num_problems, [&](int worker, int64_t p) {
+        DenseAssignmentSolver& solver = solvers[worker];
+        assignment_costs[p] =
+            solver.Solve(costs.subspan(p * matrix_size, matrix_size), num_rows,
+                         num_cols, row_to_col.subspan(p * num_rows, num_rows))
+                ? solver.cost()
+                : std::numeric_limits<double>::quiet_NaN();
+      });
+  return assignment_costs;
+}
+
 }  // namespace operations_research
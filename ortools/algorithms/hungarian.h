@@ -34,6 +34,14 @@
 // This code is based on (read: translated from) the Java version
 // (read: translated from) the Python version at
 //   http://www.clapper.org/software/python/munkres/.
+//
+// DenseAssignmentSolver and SolveDenseAssignments() below are the O(n^3)
+// alternative for dense problems: the shortest augmenting path algorithm of
+// Jonker and Volgenant, in the rectangular form of D. F. Crouse, "On
+// implementing 2D rectangular assignment algorithms", IEEE Transactions on
+// Aerospace and Electronic Systems 52(4), 2016. They work on flat row-major
+// cost matrices and reuse their working memory from one problem to the next,
+// which matters when solving many small problems.
 
 #ifndef OR_TOOLS_ALGORITHMS_HUNGARIAN_H_
 #define OR_TOOLS_ALGORITHMS_HUNGARIAN_H_
@@ -57,6 +65,67 @@ void MaximizeLinearAssignment(
     absl::flat_hash_map<int, int>* direct_assignment,
     absl::flat_hash_map<int, int>* reverse_assignment);
 
+// Solves dense min-cost assignment problems given as row-major matrices:
+// with `num_rows <= num_cols` every row is assigned a distinct column, and
+// with `num_rows > num_cols` every column is assigned a distinct row. To
+// maximize, negate the costs. A cost of +infinity forbids an assignment.
+//
+// Usage:
+//   DenseAssignmentSolver solver;
+//   std::vector<int> row_to_col(num_rows);
+//   for (...) {
+//     if (!solver.Solve(costs, num_rows, num_cols, absl::MakeSpan(row_to_col)))
+//       ...
+//   }
+class DenseAssignmentSolver {
+ public:
+  // Fills `row_to_col` (of size `num_rows`) with the column assigned to each
+  // row, or -1 for the rows left unassigned when `num_rows > num_cols`, and
+  // returns true. Returns false, leaving `row_to_col` unspecified, if `costs`
+  // contains a NaN or -infinity, or if there is no assignment of finite cost.
+  bool Solve(absl::Span<const double> costs, int num_rows, int num_cols,
+             absl::Span<int> row_to_col);
+
+  // The cost of the last assignment found by Solve().
+  double cost() const { return cost_; }
+
+ private:
+  // Runs the algorithm on the rows of `costs`, with `num_rows <= num_cols`,
+  // and fills `col_of_row_`.
+  bool SolveWithFewerRows(const double* costs, int num_rows, int num_cols);
+
+  // Finds a shortest augmenting path from the unassigned row `start_row`, in
+  // the reduced costs, and returns the unassigned column where it ends, or -1
+  // if there is none. See Crouse's paper.
+  int FindShortestAugmentingPath(const double* costs, int num_rows,
+                                 int num_cols, int start_row, double* length);
+
+  double cost_ = 0.0;
+  std::vector<double> transposed_costs_;
+  std::vector<double> row_potential_;
+  std::vector<double> col_potential_;
+  std::vector<double> shortest_path_length_;
+  std::vector<int> col_of_row_;
+  std::vector<int> row_of_col_;
+  std::vector<int> path_;
+  std::vector<int> remaining_cols_;
+  std::vector<bool> row_is_scanned_;
+  std::vector<bool> col_is_scanned_;
+};
+
+// Solves `num_problems` independent assignment problems of the same shape on
+// `num_threads` threads, with one DenseAssignmentSolver per thread. The cost
+// matrix of the problem p is
+//   costs.subspan(p * num_rows * num_cols, num_rows * num_cols),
+// and its assignment is written into
+//   row_to_col.subspan(p * num_rows, num_rows).
+// Returns the costs of the assignments, with NaN for the problems where
+// DenseAssignmentSolver::Solve() returned false.
+std::vector<double> SolveDenseAssignments(absl::Span<const double> costs,
+                                          int num_problems, int num_rows,
+                                          int num_cols, int num_threads,
+                                          absl::Span<int> row_to_col);
+
 }  // namespace operations_research
 
 #endif  // OR_TOOLS_ALGORITHMS_HUNGARIAN_H_
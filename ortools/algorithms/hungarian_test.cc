@@ -15,13 +15,16 @@
 
 #include "ortools/algorithms/hungarian.h"
 
+#include <algorithm>
 #include <cmath>
 #include <cstdint>
+#include <limits>
 #include <random>
 #include <vector>
 
 #include "absl/container/flat_hash_map.h"
 #include "absl/random/distributions.h"
+#include "absl/types/span.h"
 #include "gtest/gtest.h"
 #include "ortools/base/macros.h"
 #include "ortools/base/map_util.h"
@@ -170,4 +173,112 @@ TEST(LinearAssignmentTest, Small4x3Matrix) {
 
 #undef MATRIX_TEST
 
+// Checks that `row_to_col` is a valid assignment of the given shape, and
+// returns its cost.
+double CheckDenseAssignment(absl::Span<const double> costs, int num_rows,
+                            int num_cols, absl::Span<const int> row_to_col) {
+  std::vector<bool> col_is_used(num_cols, false);
+  int num_assigned = 0;
+  double cost = 0.0;
+  for (int row = 0; row < num_rows; ++row) {
+    const int col = row_to_col[row];
+    if (col == -1) continue;
+    EXPECT_GE(col, 0);
+    EXPECT_LT(col, num_cols);
+    EXPECT_FALSE(col_is_used[col]);
+    col_is_used[col] = true;
+    ++num_assigned;
+    cost += costs[row * num_cols + col];
+  }
+  EXPECT_EQ(num_assigned, std::min(num_rows, num_cols));
+  return cost;
+}
+
+TEST(DenseAssignmentSolverTest, MatchesHungarianOnRandomMatrices) {
+  std::mt19937 random(12345);
+  DenseAssignmentSolver solver;
+  for (int num_rows = 0; num_rows <= 9; ++num_rows) {
+    for (int num_cols = 0; num_cols <= 9; ++num_cols) {
+      std::vector<std::vector<double>> cost(num_rows,
+                                            std::vector<double>(num_cols));
+      std::vector<double> flat_costs;
+      for (std::vector<double>& row : cost) {
+        for (double& c : row) {
+          c = absl::Uniform(random, -100.0, 100.0);
+          flat_costs.push_back(c);
+        }
+      }
+      absl::flat_hash_map<int, int> direct_assignment;
+      absl::flat_hash_map<int, int> reverse_assignment;
+      std::vector<std::vector<double>> shifted_cost = cost;
+      for (std::vector<double>& row : shifted_cost) {
+        for (double& c : row) c += 100.0;
+      }
+      MinimizeLinearAssignment(shifted_cost, &direct_assignment,
+                               &reverse_assignment);
+      double expected_cost = 0.0;
+      for (const auto [row, col] : direct_assignment) {
+        expected_cost += cost[row][col];
+      }
+
+      std::vector<int> row_to_col(num_rows);
+      ASSERT_TRUE(solver.Solve(flat_costs, num_rows, num_cols,
+                               absl::MakeSpan(row_to_col)));
+      EXPECT_NEAR(solver.cost(), expected_cost, 1e-9)
+          << num_rows << "x" << num_cols;
+      EXPECT_NEAR(
+          CheckDenseAssignment(flat_costs, num_rows, num_cols, row_to_col),
+          solver.cost(), 1e-9);
+    }
+  }
+}
+
+TEST(DenseAssignmentSolverTest, ForbiddenAndInvalidCosts) {
+  constexpr double kInf = std::numeric_limits<double>::infinity();
+  DenseAssignmentSolver solver;
+  std::vector<int> row_to_col(2);
+  ASSERT_TRUE(
+      solver.Solve({kInf, 1, 2, kInf}, 2, 2, absl::MakeSpan(row_to_col)));
+  EXPECT_EQ(solver.cost(), 3);
+  EXPECT_EQ(row_to_col, std::vector<int>({1, 0}));
+
+  EXPECT_FALSE(
+      solver.Solve({kInf, 1, kInf, 2}, 2, 2, absl::MakeSpan(row_to_col)));
+  EXPECT_FALSE(solver.Solve({0, 1, std::nan(""), 2}, 2, 2,
+                            absl::MakeSpan(row_to_col)));
+  EXPECT_FALSE(
+      solver.Solve({0, 1, -kInf, 2}, 2, 2, absl::MakeSpan(row_to_col)));
+}
+
+TEST(SolveDenseAssignmentsTest, MatchesDenseAssignmentSolver) {
+  constexpr int kNumProblems = 200;
+  constexpr int kNumRows = 12;
+  constexpr int kNumCols = 10;
+  std::mt19937 random(12345);
+  std::vector<double> costs(kNumProblems * kNumRows * kNumCols);
+  for (double& c : costs) c = absl::Uniform(random, 0.0, 1000.0);
+  costs[5] = std::nan("");  // Makes the first problem invalid.
+
+  for (const int num_threads : {1, 4}) {
+    std::vector<int> row_to_col(kNumProblems * kNumRows);
+    const std::vector<double> assignment_costs =
+        SolveDenseAssignments(costs, kNumProblems, kNumRows, kNumCols,
+                              num_threads, absl::MakeSpan(row_to_col));
+    ASSERT_EQ(assignment_costs.size(), kNumProblems);
+    EXPECT_TRUE(std::isnan(assignment_costs[0]));
+    DenseAssignmentSolver solver;
+    std::vector<int> expected_row_to_col(kNumRows);
+    for (int p = 1; p < kNumProblems; ++p) {
+      const absl::Span<const double> problem_costs = absl::MakeConstSpan(
+          costs.data() + p * kNumRows * kNumCols, kNumRows * kNumCols);
+      ASSERT_TRUE(solver.Solve(problem_costs, kNumRows, kNumCols,
+                               absl::MakeSpan(expected_row_to_col)));
+      EXPECT_EQ(assignment_costs[p], solver.cost());
+      EXPECT_EQ(absl::MakeConstSpan(row_to_col.data() + p * kNumRows,
+                                    kNumRows),
+                expected_row_to_col);
+    }
+  }
+}
+
 }  // namespace operations_research
@@ -24,7 +24,9 @@
 #include "absl/log/check.h"
 #include "absl/strings/string_view.h"
 #include "absl/time/time.h"
+#include "absl/types/span.h"
 #include "ortools/base/stl_util.h"
+#include "ortools/base/threadpool.h"
 #include "ortools/linear_solver/linear_solver.h"
 #include "ortools/sat/cp_model.h"
 #include "ortools/sat/cp_model.pb.h"
@@ -939,10 +941,15 @@ void Knapsack64ItemsSolver::BuildBestSolution() {
 // ----- KnapsackDynamicProgrammingSolver -----
 // KnapsackDynamicProgrammingSolver solves the 0-1 knapsack problem
 // using dynamic programming. This algorithm is pseudo-polynomial because it
-// depends on capacity, ie. the time and space complexity is
+// depends on capacity, ie. the time complexity is
 // O(capacity * number_of_items).
-// The implemented algorithm is 'DP-3' in "Knapsack problems", Hans Kellerer,
-// Ulrich Pferschy and David Pisinger, Springer book (ISBN 978-3540402862).
+// When the number_of_items x (capacity + 1) table of decisions fits in
+// kMaxDecisionTableSize bytes, the profits are computed item by item from the
+// previous row of profits only, and the solution is read back from the table.
+// Otherwise, the implemented algorithm is 'DP-3' in "Knapsack problems", Hans
+// Kellerer, Ulrich Pferschy and David Pisinger, Springer book
+// (ISBN 978-3540402862), which uses O(capacity) memory but repeats the dynamic
+// programming for each item of the solution.
 class KnapsackDynamicProgrammingSolver : public BaseKnapsackSolver {
  public:
   explicit KnapsackDynamicProgrammingSolver(absl::string_view solver_name);
@@ -952,6 +959,11 @@ class KnapsackDynamicProgrammingSolver : public BaseKnapsackSolver {
             const std::vector<std::vector<int64_t>>& weights,
             const std::vector<int64_t>& capacities) override;
 
+  // Same as above, for a single dimension. This reuses the memory of the
+  // previous problem.
+  void InitOneDimension(absl::Span<const int64_t> profits,
+                        absl::Span<const int64_t> weights, int64_t capacity);
+
   // Solves the problem and returns the profit of the optimal solution.
   int64_t Solve(TimeLimit* time_limit, double time_limit_in_second,
                 bool* is_solution_optimal) override;
@@ -962,12 +974,19 @@ class KnapsackDynamicProgrammingSolver : public BaseKnapsackSolver {
   }
 
  private:
+  static constexpr int64_t kMaxDecisionTableSize = int64_t{1} << 25;
+
+  int64_t SolveWithDecisionTable();
   int64_t SolveSubProblem(int64_t capacity, int num_items);
 
   std::vector<int64_t> profits_;
   std::vector<int64_t> weights_;
   int64_t capacity_;
   std::vector<int64_t> computed_profits_;
+  std::vector<int64_t> previous_profits_;
+  // is_item_taken_[item_id * (capacity_ + 1) + c] is 1 if the best packing of
+  // the items up to item_id in capacity c contains item_id.
+  std::vector<uint8_t> is_item_taken_;
   std::vector<int> selected_item_ids_;
   std::vector<bool> best_solution_;
 };
@@ -992,9 +1011,52 @@ void KnapsackDynamicProgrammingSolver::Init(
       << " with one dimension.";
   CHECK_EQ(capacities.size(), weights.size());
 
-  profits_ = profits;
-  weights_ = weights[0];
-  capacity_ = capacities[0];
+  InitOneDimension(profits, weights[0], capacities[0]);
+}
+
+void KnapsackDynamicProgrammingSolver::InitOneDimension(
+    absl::Span<const int64_t> profits, absl::Span<const int64_t> weights,
+    int64_t capacity) {
+  CHECK_EQ(profits.size(), weights.size());
+  profits_.assign(profits.begin(), profits.end());
+  weights_.assign(weights.begin(), weights.end());
+  capacity_ = capacity;
+}
+
+int64_t KnapsackDynamicProgrammingSolver::SolveWithDecisionTable() {
+  const int num_items = profits_.size();
+  const int64_t capacity_plus_1 = capacity_ + 1;
+  computed_profits_.assign(capacity_plus_1, int64_t{0});
+  previous_profits_.resize(capacity_plus_1);
+  is_item_taken_.resize(num_items * capacity_plus_1);
+  for (int item_id = 0; item_id < num_items; ++item_id) {
+    computed_profits_.swap(previous_profits_);
+    const int64_t* const previous = previous_profits_.data();
+    int64_t* const current = computed_profits_.data();
+    uint8_t* const taken = is_item_taken_.data() + item_id * capacity_plus_1;
+    const int64_t item_weight = std::min(weights_[item_id], capacity_plus_1);
+    const int64_t item_profit = profits_[item_id];
+    std::copy(previous, previous + item_weight, current);
+    std::fill(taken, taken + item_weight, 0);
+    // Branch-free, and without the loop-carried dependency of the in-place
+    // update, so that the compiler vectorizes it.
+    for (int64_t used_capacity = item_weight; used_capacity < capacity_plus_1;
+         ++used_capacity) {
+      const int64_t profit_with_item =
+          previous[used_capacity - item_weight] + item_profit;
+      taken[used_capacity] = profit_with_item > previous[used_capacity];
+      current[used_capacity] =
+          std::max(previous[used_capacity], profit_with_item);
+    }
+  }
+  int64_t remaining_capacity = capacity_;
+  for (int item_id = num_items - 1; item_id >= 0; --item_id) {
+    if (is_item_taken_[item_id * capacity_plus_1 + remaining_capacity]) {
+      best_solution_[item_id] = true;
+      remaining_capacity -= weights_[item_id];
+    }
+  }
+  return computed_profits_[capacity_];
 }
 
 int64_t KnapsackDynamicProgrammingSolver::SolveSubProblem(int64_t capacity,
@@ -1024,12 +1086,15 @@ int64_t KnapsackDynamicProgrammingSolver::Solve(TimeLimit* /*time_limit*/,
   DCHECK(is_solution_optimal != nullptr);
   *is_solution_optimal = true;
   const int64_t capacity_plus_1 = capacity_ + 1;
+  int num_items = profits_.size();
+  best_solution_.assign(num_items, false);
+  if (num_items * capacity_plus_1 <= kMaxDecisionTableSize) {
+    return SolveWithDecisionTable();
+  }
   selected_item_ids_.assign(capacity_plus_1, 0);
   computed_profits_.assign(capacity_plus_1, 0LL);
 
   int64_t remaining_capacity = capacity_;
-  int num_items = profits_.size();
-  best_solution_.assign(num_items, false);
 
   while (remaining_capacity > 0 && num_items > 0) {
     const int selected_item_id = SolveSubProblem(remaining_capacity, num_items);
@@ -1657,4 +1722,41 @@ void BaseKnapsackSolver::GetLowerAndUpperBoundWhenItem(int /*item_id*/,
   *upper_bound = std::numeric_limits<int64_t>::max();
 }
 
+std::vector<int64_t> SolveKnapsacksWithDynamicProgramming(
+    absl::Span<const OneDimensionalKnapsack> problems, int num_threads,
+    std::vector<std::vector<bool>>* solutions) {
+  CHECK_GE(num_threads, 1);
+  std::vector<int64_t> profits(problems.size());
+  if (solutions != nullptr) solutions->assign(problems.size(), {});
+  std::unique_ptr<ThreadPool> thread_pool;
+  if (num_threads > 1) {
+    thread_pool = std::make_unique<ThreadPool>("Knapsacks", num_threads);
+    thread_pool->StartWorkers();
+  }
+  std::vector<std::unique_ptr<KnapsackDynamicProgrammingSolver>> solvers(
+      num_threads);
+  for (auto& solver : solvers) {
+    solver = std::make_unique<KnapsackDynamicProgrammingSolver>("Knapsacks");
+  }
+  ParallelForEachItem(
+      thread_pool.get(), num_threads, problems.size(),
+      [&](int worker, int64_t i) {
+        const OneDimensionalKnapsack& problem = problems[i];
+        KnapsackDynamicProgrammingSolver& solver = *solvers[worker];
+        solver.InitOneDimension(problem.profits, problem.weights,
+                                problem.capacity);
+        bool is_solution_optimal = false;
+        profits[i] = solver.Solve(/*time_limit=*/nullptr,
+                                  std::numeric_limits<double>::infinity(),
+                                  &is_solution_optimal);
+        if (solutions == nullptr) return;
+        std::vector<bool>& solution = (*solutions)[i];
+        solution.resize(problem.profits.size());
+        for (int item_id = 0; item_id < solution.size(); ++item_id) {
+          solution[item_id] = solver.best_solution(item_id);
+        }
+      });
+  return profits;
+}
+
 }  // namespace operations_research
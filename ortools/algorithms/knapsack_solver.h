@@ -20,6 +20,7 @@
 #include <vector>
 
 #include "absl/strings/string_view.h"
+#include "absl/types/span.h"
 #include "ortools/util/time_limit.h"
 
 namespace operations_research {
@@ -136,8 +137,11 @@ class KnapsackSolver {
     /** Dynamic Programming approach for single dimension problems
      *
      * Limited to one dimension, this solver is based on a dynamic programming
-     * algorithm. The time and space complexity is O(capacity *
-     * number_of_items).
+     * algorithm. The time complexity is O(capacity * number_of_items). The
+     * space complexity is O(capacity * number_of_items) bytes, falling back to
+     * O(capacity) (at the price of a slower solution recovery) for large
+     * problems. To solve many small problems, see
+     * SolveKnapsacksWithDynamicProgramming().
      */
     KNAPSACK_DYNAMIC_PROGRAMMING_SOLVER = 2,
 
@@ -272,6 +276,25 @@ class KnapsackSolver {
 };
 
 #if !defined(SWIG)
+// A single dimension knapsack problem, for
+// SolveKnapsacksWithDynamicProgramming(). Weights must be non-negative.
+struct OneDimensionalKnapsack {
+  std::vector<int64_t> profits;
+  std::vector<int64_t> weights;
+  int64_t capacity = 0;
+};
+
+// Solves the given independent problems with the algorithm of
+// KNAPSACK_DYNAMIC_PROGRAMMING_SOLVER, on `num_threads` threads, and returns
+// their optimal profits. If `solutions` is not nullptr, (*solutions)[i][j]
+// tells whether the item j is packed in the optimal knapsack of problems[i].
+// This is meant for the many small pricing problems of a column generation:
+// the working memory of a thread is reused from one problem to the next, and
+// the problems are not reduced as in KnapsackSolver.
+std::vector<int64_t> SolveKnapsacksWithDynamicProgramming(
+    absl::Span<const OneDimensionalKnapsack> problems, int num_threads = 1,
+    std::vector<std::vector<bool>>* solutions = nullptr);
+
 // The following code defines needed classes for the KnapsackGenericSolver
 // class which is the entry point to extend knapsack with new constraints such
 // as conflicts between items.
@@ -15,6 +15,7 @@
 
 #include <cstdint>
 #include <limits>
+#include <random>
 #include <vector>
 
 #include "gtest/gtest.h"
@@ -623,5 +624,38 @@ TEST(KnapsackSolverTest, AllItemsReduced) {
   EXPECT_EQ(kOptimalProfit, profit);
 }
 
+TEST(KnapsackSolverTest, SolveKnapsacksWithDynamicProgramming) {
+  std::mt19937 random(12345);
+  std::vector<OneDimensionalKnapsack> problems(200);
+  for (OneDimensionalKnapsack& problem : problems) {
+    const int num_items = random() % 40;
+    for (int i = 0; i < num_items; ++i) {
+      problem.profits.push_back(random() % 100);
+      problem.weights.push_back(random() % 50);
+    }
+    problem.capacity = random() % 300;
+  }
+  for (const int num_threads : {1, 4}) {
+    std::vector<std::vector<bool>> solutions;
+    const std::vector<int64_t> profits =
+        SolveKnapsacksWithDynamicProgramming(problems, num_threads, &solutions);
+    ASSERT_EQ(profits.size(), problems.size());
+    ASSERT_EQ(solutions.size(), problems.size());
+    for (int i = 0; i < problems.size(); ++i) {
+      const OneDimensionalKnapsack& problem = problems[i];
+      KnapsackSolver solver(
+          KnapsackSolver::KNAPSACK_MULTIDIMENSION_BRANCH_AND_BOUND_SOLVER,
+          "solver");
+      solver.Init(problem.profits, {problem.weights}, {problem.capacity});
+      EXPECT_EQ(profits[i], solver.Solve());
+      EXPECT_TRUE(IsSolutionValid(problem.profits, {problem.weights},
+                                  {problem.capacity}, solutions[i],
+                                  profits[i]));
+    }
+  }
+  EXPECT_EQ(SolveKnapsacksWithDynamicProgramming(problems, 4),
+            SolveKnapsacksWithDynamicProgramming(problems));
+}
+
 }  // namespace
 }  // namespace operations_research
@@ -33,12 +33,18 @@
 //
 // TODO: it could be even faster than that when the values are in [0..N) for a
 // known value N that's significantly lower than the max integer value.
+//
+// RadixSortWithPayload() and RadixSortPermutation() sort (key, payload) pairs
+// and compute sorting permutations, and all the variants can run on several
+// threads for large arrays.
 
 #include <algorithm>
 #include <cstddef>
 #include <cstdint>
 #include <cstring>
 #include <limits>
+#include <memory>
+#include <numeric>
 #include <type_traits>
 #include <utility>
 #include <vector>
@@ -48,6 +54,7 @@
 #include "absl/log/check.h"
 #include "absl/types/span.h"
 #include "ortools/base/logging.h"
+#include "ortools/base/threadpool.h"
 
 namespace operations_research {
 
@@ -61,6 +68,27 @@ void RadixSort(absl::Span<T> values);
 template <typename T, int radix_width, int num_passes>
 void RadixSortTpl(absl::Span<T> values);
 
+// Same as RadixSort(), on `num_threads` threads when there are at least
+// kMinSizeForParallelRadixSort values.
+template <typename T>
+void ParallelRadixSort(absl::Span<T> values, int num_threads);
+
+// Sorts `keys` like RadixSort(), and applies the same permutation to
+// `payloads`, which must have the same size. The sort is stable: pairs with
+// equal keys keep their relative order.
+template <typename T, typename Payload>
+void RadixSortWithPayload(absl::Span<T> keys, absl::Span<Payload> payloads,
+                          int num_threads = 1);
+
+// Returns the stable permutation `p` that sorts `keys`, i.e. keys[p[0]] <=
+// keys[p[1]] <= ..., without modifying them.
+template <typename T>
+std::vector<int> RadixSortPermutation(absl::Span<const T> keys,
+                                      int num_threads = 1);
+
+// Below this size, the multi-threaded variants run on the calling thread.
+inline constexpr size_t kMinSizeForParallelRadixSort = 1 << 18;
+
 // TODO(user): Support arbitrary types with an int() or other numerical getter.
 // TODO(user): Support the user providing already-allocated memory buffers
 //              for the radix counts and/or for the temporary vector<T> copy.
@@ -85,6 +113,129 @@ struct ToUInt<float> {
 
 template <typename T>
 using to_uint = typename ToUInt<T>::type;
+
+// Maps a value to an unsigned integer with the same order, so that the
+// (key, payload) sorts below need none of the sign fix-ups of RadixSortTpl():
+// the sign bit of the integers is flipped, and so are all the bits of the
+// negative floating-point numbers.
+template <typename T>
+to_uint<T> ToOrderedUInt(T value) {
+  typedef to_uint<T> U;
+  constexpr U kSignBit = U{1} << (std::numeric_limits<U>::digits - 1);
+  const U bits = absl::bit_cast<U>(value);
+  if constexpr (!std::is_signed_v<T>) {
+    return bits;
+  } else if constexpr (std::is_integral_v<T>) {
+    return bits ^ kSignBit;
+  } else {
+    return (bits & kSignBit) ? ~bits : bits ^ kSignBit;
+  }
+}
+
+// Stable LSD radix sort of `keys`, with 8-bit digits, that moves the
+// `payloads` along if kHasPayload. The array is split into one chunk per
+// thread: each chunk counts its digits, and then scatters its elements at the
+// offsets given by the counts of all chunks. The passes on a digit shared by
+// all the keys are skipped.
+template <typename T, typename Payload, bool kHasPayload>
+void ChunkedRadixSort(absl::Span<T> keys, absl::Span<Payload> payloads,
+                      int num_threads) {
+  typedef to_uint<T> U;
+  constexpr int kRadixWidth = 8;
+  constexpr int kNumBuckets = 1 << kRadixWidth;
+  constexpr int kNumPasses = sizeof(T);
+  DCHECK_LE(keys.size(),
+            static_cast<size_t>(std::numeric_limits<uint32_t>::max()));
+  const uint32_t size = keys.size();
+  const int num_chunks =
+      size < kMinSizeForParallelRadixSort ? 1 : std::max(num_threads, 1);
+  std::unique_ptr<ThreadPool> thread_pool;
+  if (num_chunks > 1) {
+    thread_pool = std::make_unique<ThreadPool>("RadixSort", num_chunks);
+    thread_pool->StartWorkers();
+  }
+  auto chunk_start = [size, num_chunks](int chunk) {
+    return static_cast<uint32_t>(uint64_t{size} * chunk / num_chunks);
+  };
+
+  // count[(chunk * kNumPasses + pass) * kNumBuckets + digit]. The first sweep
+  // counts the digits of all passes at once, which is only valid for the
+  // chunks of the first pass that moves the data. The later passes recount.
+  std::vector<uint32_t> count(num_chunks * kNumPasses * kNumBuckets, 0);
+  auto count_digits = [&](const T* data, int chunk, int first_pass,
+                          int end_pass) {
+    for (uint32_t i = chunk_start(chunk); i < chunk_start(chunk + 1); ++i) {
+      const U key = ToOrderedUInt(data[i]);
+      for (int pass = first_pass; pass < end_pass; ++pass) {
+        ++count[(chunk * kNumPasses + pass) * kNumBuckets +
+                ((key >> (kRadixWidth * pass)) & (kNumBuckets - 1))];
+      }
+    }
+  };
+  ParallelForEachItem(thread_pool.get(), num_chunks, num_chunks,
+                      [&](int, int64_t chunk) {
+                        count_digits(keys.data(), chunk, 0, kNumPasses);
+                      });
+
+  std::vector<T> tmp_keys(size);
+  std::vector<Payload> tmp_payloads(kHasPayload ? size : 0);
+  T* from_keys = keys.data();
+  T* to_keys = tmp_keys.data();
+  Payload* from_payloads = payloads.data();
+  Payload* to_payloads = tmp_payloads.data();
+  bool data_moved = false;
+  for (int pass = 0; pass < kNumPasses; ++pass) {
+    if (data_moved) {
+      ParallelForEachItem(
+          thread_pool.get(), num_chunks, num_chunks, [&](int, int64_t chunk) {
+            uint32_t* const chunk_count =
+                count.data() + (chunk * kNumPasses + pass) * kNumBuckets;
+            std::fill(chunk_count, chunk_count + kNumBuckets, 0);
+            count_digits(from_keys, chunk, pass, pass + 1);
+          });
+    }
+    // Convert the counts into offsets, digit-major and then chunk-major, and
+    // skip the pass if all the keys have the same digit.
+    uint32_t sum = 0;
+    bool skip_pass = false;
+    for (int digit = 0; digit < kNumBuckets; ++digit) {
+      uint32_t digit_count = 0;
+      for (int chunk = 0; chunk < num_chunks; ++chunk) {
+        uint32_t& c = count[(chunk * kNumPasses + pass) * kNumBuckets + digit];
+        digit_count += c;
+        const uint32_t old_sum = sum;
+        sum += c;
+        c = old_sum;
+      }
+      if (digit_count == size) skip_pass = true;
+    }
+    if (skip_pass) continue;
+    ParallelForEachItem(
+        thread_pool.get(), num_chunks, num_chunks, [&](int, int64_t chunk) {
+          uint32_t* const offset =
+              count.data() + (chunk * kNumPasses + pass) * kNumBuckets;
+          for (uint32_t i = chunk_start(chunk); i < chunk_start(chunk + 1);
+               ++i) {
+            const uint32_t j = offset[(ToOrderedUInt(from_keys[i]) >>
+                                       (kRadixWidth * pass)) &
+                                      (kNumBuckets - 1)]++;
+            to_keys[j] = from_keys[i];
+            if constexpr (kHasPayload) to_payloads[j] = from_payloads[i];
+          }
+        });
+    std::swap(from_keys, to_keys);
+    if constexpr (kHasPayload) std::swap(from_payloads, to_payloads);
+    data_moved = true;
+  }
+
+  // Copy the data back if it ended up in the temporary buffers.
+  if (from_keys != keys.data()) {
+    std::copy(from_keys, from_keys + size, keys.data());
+    if constexpr (kHasPayload) {
+      std::copy(from_payloads, from_payloads + size, payloads.data());
+    }
+  }
+}
 }  // namespace internal
 
 // The internal template that does all the work.
@@ -285,6 +436,50 @@ void RadixSort(absl::Span<T> values) {
   absl::c_sort(values);
 }
 
+template <typename T>
+void ParallelRadixSort(absl::Span<T> values, int num_threads) {
+  if (num_threads <= 1 || values.size() < kMinSizeForParallelRadixSort) {
+    RadixSort(values);
+    return;
+  }
+  internal::ChunkedRadixSort<T, char, /*kHasPayload=*/false>(
+      values, absl::Span<char>(), num_threads);
+}
+
+template <typename T, typename Payload>
+void RadixSortWithPayload(absl::Span<T> keys, absl::Span<Payload> payloads,
+                          int num_threads) {
+  CHECK_EQ(keys.size(), payloads.size());
+  if (keys.size() < 300) {
+    // Insertion sort, which is stable.
+    for (size_t i = 1; i < keys.size(); ++i) {
+      const T key = keys[i];
+      Payload payload = std::move(payloads[i]);
+      size_t j = i;
+      for (; j > 0 && key < keys[j - 1]; --j) {
+        keys[j] = keys[j - 1];
+        payloads[j] = std::move(payloads[j - 1]);
+      }
+      keys[j] = key;
+      payloads[j] = std::move(payload);
+    }
+    return;
+  }
+  internal::ChunkedRadixSort<T, Payload, /*kHasPayload=*/true>(keys, payloads,
+                                                               num_threads);
+}
+
+template <typename T>
+std::vector<int> RadixSortPermutation(absl::Span<const T> keys,
+                                      int num_threads) {
+  std::vector<T> sorted_keys(keys.begin(), keys.end());
+  std::vector<int> permutation(keys.size());
+  std::iota(permutation.begin(), permutation.end(), 0);
+  RadixSortWithPayload(absl::MakeSpan(sorted_keys),
+                       absl::MakeSpan(permutation), num_threads);
+  return permutation;
+}
+
 }  // namespace operations_research
 
 #endif  // OR_TOOLS_ALGORITHMS_RADIX_SORT_H_
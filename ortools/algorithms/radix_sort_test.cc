@@ -222,9 +222,51 @@ TYPED_TEST_P(RadixSortTest, RandomizedCorrectnessTestAgainstStdSortLargeSizes) {
   }
 }
 
+TYPED_TEST_P(RadixSortTest, WithPayloadIsStableAndParallelSortIsCorrect) {
+  constexpr int kNumTests = 40;
+  absl::BitGen rng;
+  for (int test = 0; test < kNumTests; ++test) {
+    const size_t size = absl::LogUniform<size_t>(
+        rng, 0, 4 * kMaxSizeForSmallStressTests << (test % 12));
+    const int num_threads = absl::Bernoulli(rng, 0.5) ? 1 : 4;
+    const bool allow_negative =
+        std::is_signed_v<TypeParam> && absl::Bernoulli(rng, 0.5);
+    // Draw the keys from a small pool of values, to have many equal keys.
+    const std::vector<TypeParam> pool = RandomValues<TypeParam>(
+        rng, 1 + size / 4, allow_negative, /*max_abs_val=*/{});
+    std::vector<TypeParam> keys(size);
+    for (TypeParam& key : keys) {
+      key = pool[absl::Uniform<size_t>(rng, 0, pool.size())];
+    }
+    SCOPED_TRACE(DUMP_VARS(test, size, num_threads, allow_negative));
+
+    std::vector<int> expected_permutation(size);
+    absl::c_iota(expected_permutation, 0);
+    absl::c_stable_sort(expected_permutation,
+                        [&keys](int a, int b) { return keys[a] < keys[b]; });
+    ASSERT_EQ(RadixSortPermutation<TypeParam>(keys, num_threads),
+              expected_permutation);
+
+    std::vector<TypeParam> sorted_keys = keys;
+    std::vector<int> payloads(size);
+    absl::c_iota(payloads, 0);
+    RadixSortWithPayload(absl::MakeSpan(sorted_keys), absl::MakeSpan(payloads),
+                         num_threads);
+    ASSERT_EQ(payloads, expected_permutation);
+    ASSERT_TRUE(absl::c_is_sorted(sorted_keys));
+
+    sorted_keys = keys;
+    ParallelRadixSort(absl::MakeSpan(sorted_keys), num_threads);
+    std::vector<TypeParam> expected_keys = keys;
+    absl::c_sort(expected_keys);
+    ASSERT_TRUE(sorted_keys == expected_keys);
+  }
+}
+
 REGISTER_TYPED_TEST_SUITE_P(RadixSortTest, SizeZeroAndOne,
                             RandomizedCorrectnessTestAgainstStdSortSmallSizes,
-                            RandomizedCorrectnessTestAgainstStdSortLargeSizes);
+                            RandomizedCorrectnessTestAgainstStdSortLargeSizes,
+                            WithPayloadIsStableAndParallelSortIsCorrect);
 using MyTypes = ::testing::Types<int, uint32_t, int64_t, uint64_t, int16_t,
                                  uint16_t, int8_t, uint8_t, double, float>;
 
@@ -152,7 +152,7 @@ bool GreedySolutionGenerator::NextSolution(
       subset_priorities, inv_->model()->num_subsets().value());
   while (!pq.IsEmpty()) {
     const SubsetIndex best_subset(pq.Pop().index());
-    const std::vector<SubsetIndex> impacted_subsets =
+    const absl::Span<const SubsetIndex> impacted_subsets =
         inv_->UnsafeUse(best_subset);
     // NOMUTANTS -- reason, for C++
     if (inv_->num_uncovered_elements() == 0) break;
@@ -178,6 +178,62 @@ bool GreedySolutionGenerator::NextSolution(
   return true;
 }
 
+// LazyGreedySolutionGenerator.
+
+bool LazyGreedySolutionGenerator::NextSolution() {
+  return NextSolution(inv_->model()->all_subsets(),
+                      inv_->model()->subset_costs());
+}
+
+bool LazyGreedySolutionGenerator::NextSolution(
+    const std::vector<SubsetIndex>& focus) {
+  return NextSolution(focus, inv_->model()->subset_costs());
+}
+
+bool LazyGreedySolutionGenerator::NextSolution(
+    const std::vector<SubsetIndex>& focus, const SubsetCostVector& costs) {
+  inv_->RecomputeInvariant();
+  num_reevaluations_ = 0;
+  SubsetCostVector elements_per_cost(costs.size(), 0.0);
+  for (const SubsetIndex subset : focus) {
+    elements_per_cost[subset] = 1.0 / costs[subset];
+  }
+  std::vector<SubsetIndexWithPriority> heap;
+  heap.reserve(focus.size());
+  for (const SubsetIndex subset : focus) {
+    if (!inv_->is_selected()[subset] &&
+        inv_->num_free_elements()[subset] != 0) {
+      const float priority =
+          elements_per_cost[subset] * inv_->num_free_elements()[subset].value();
+      heap.push_back({priority, subset.value()});
+    }
+  }
+  // A binary heap is enough here: there is no update, and most pops are
+  // followed by a push of the same subset with a slightly lower priority.
+  std::make_heap(heap.begin(), heap.end());
+  const float tolerance_factor = 1.0 - priority_tolerance_;
+  while (!heap.empty() && inv_->num_uncovered_elements() > 0) {
+    std::pop_heap(heap.begin(), heap.end());
+    const SubsetIndex subset(heap.back().index());
+    heap.pop_back();
+    const ElementIndex num_free_elements = inv_->num_free_elements()[subset];
+    if (num_free_elements == 0) continue;
+    // NOMUTANTS -- reason, for C++
+    const float priority =
+        elements_per_cost[subset] * num_free_elements.value();
+    ++num_reevaluations_;
+    if (heap.empty() ||
+        priority >= tolerance_factor * heap.front().priority()) {
+      inv_->UnsafeUse(subset);
+    } else {
+      heap.push_back({priority, subset.value()});
+      std::push_heap(heap.begin(), heap.end());
+    }
+  }
+  DCHECK(LogAndCheck(inv_, focus));
+  return true;
+}
+
 class ElementIndexWithDegree {
  public:
   using Index = int;
@@ -304,7 +360,7 @@ bool SteepestSearch::NextSolution(absl::Span<const SubsetIndex> focus,
     const SubsetIndex best_subset(pq.Pop().index());
     if (!inv_->is_removable()[best_subset]) continue;
     DCHECK_GT(costs[best_subset], 0.0);
-    const std::vector<SubsetIndex> impacted_subsets =
+    const absl::Span<const SubsetIndex> impacted_subsets =
         inv_->UnsafeRemove(best_subset);
     for (const SubsetIndex subset : impacted_subsets) {
       if (!inv_->is_removable()[subset]) {
@@ -418,8 +474,7 @@ bool GuidedTabuSearch::NextSolution(const std::vector<SubsetIndex>& focus,
 
     UpdatePenalties(focus);
     tabu_list_.Add(best_subset);
-    const std::vector<SubsetIndex> impacted_subsets =
-        inv_->UnsafeToggle(best_subset, !inv_->is_selected()[best_subset]);
+    inv_->UnsafeToggle(best_subset, !inv_->is_selected()[best_subset]);
     // TODO(user): make the cost computation incremental.
     augmented_cost =
         std::accumulate(augmented_costs_.begin(), augmented_costs_.end(), 0.0);
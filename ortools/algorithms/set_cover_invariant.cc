@@ -19,6 +19,7 @@
 #include <vector>
 
 #include "absl/log/check.h"
+#include "absl/types/span.h"
 #include "ortools/algorithms/set_cover_model.h"
 #include "ortools/base/logging.h"
 
@@ -37,6 +38,7 @@ void SetCoverInvariant::Initialize() {
   is_removable_.assign(num_subsets, false);
   num_free_elements_.assign(num_subsets, ElementIndex(0));
   num_coverage_le_1_elements_.assign(num_subsets, ElementIndex(0));
+  subset_seen_.assign(num_subsets, false);
 
   const SparseColumnView& columns = model_->columns();
   for (SubsetIndex subset(0); subset < num_subsets; ++subset) {
@@ -148,8 +150,8 @@ SetCoverInvariant::ComputeImpliedData(const ElementToSubsetVector& cvrg) const {
   return {num_uncvrd_elts, num_free_elts, num_cvrg_le_1_elts, is_rdndnt};
 }
 
-std::vector<SubsetIndex> SetCoverInvariant::Toggle(SubsetIndex subset,
-                                                   bool value) {
+absl::Span<const SubsetIndex> SetCoverInvariant::Toggle(SubsetIndex subset,
+                                                        bool value) {
   if (value) {
     DCHECK(!is_removable_[subset]);
     DCHECK_GT(num_free_elements_[subset], 0);
@@ -160,8 +162,8 @@ std::vector<SubsetIndex> SetCoverInvariant::Toggle(SubsetIndex subset,
   }
 }
 
-std::vector<SubsetIndex> SetCoverInvariant::UnsafeToggle(SubsetIndex subset,
-                                                         bool value) {
+absl::Span<const SubsetIndex> SetCoverInvariant::UnsafeToggle(
+    SubsetIndex subset, bool value) {
   if (value) {
     return UnsafeUse(subset);
   } else {
@@ -179,7 +181,16 @@ void CollectSubsets(SubsetIndex s, std::vector<SubsetIndex>* subsets,
 }
 }  // namespace
 
-std::vector<SubsetIndex> SetCoverInvariant::UnsafeUse(SubsetIndex subset) {
+void SetCoverInvariant::ClearSubsetSeen(
+    SubsetIndex subset, absl::Span<const SubsetIndex> impacted_subsets) {
+  subset_seen_[subset] = false;
+  for (const SubsetIndex impacted_subset : impacted_subsets) {
+    subset_seen_[impacted_subset] = false;
+  }
+}
+
+absl::Span<const SubsetIndex> SetCoverInvariant::UnsafeUse(
+    SubsetIndex subset) {
   DCHECK(!is_selected_[subset]);
   DVLOG(1) << "Selecting subset " << subset;
   is_selected_[subset] = true;
@@ -188,12 +199,11 @@ std::vector<SubsetIndex> SetCoverInvariant::UnsafeUse(SubsetIndex subset) {
 
   const SparseColumnView& columns = model_->columns();
 
-  SubsetBoolVector subset_seen(columns.size(), false);
-  std::vector<SubsetIndex> impacted_subsets;
-  impacted_subsets.reserve(columns.size().value());
+  std::vector<SubsetIndex>& impacted_subsets = impacted_subsets_;
+  impacted_subsets.clear();
 
-  // Initialize subset_seen so that `subset` not be in impacted_subsets.
-  subset_seen[subset] = true;
+  // Initialize subset_seen_ so that `subset` not be in impacted_subsets.
+  subset_seen_[subset] = true;
 
   const SparseRowView& rows = model_->rows();
   for (const ElementIndex element : columns[subset]) {
@@ -203,13 +213,13 @@ std::vector<SubsetIndex> SetCoverInvariant::UnsafeUse(SubsetIndex subset) {
       // `element` is newly covered.
       --num_uncovered_elements_;
       for (const SubsetIndex impacted_subset : rows[element]) {
-        CollectSubsets(impacted_subset, &impacted_subsets, &subset_seen);
+        CollectSubsets(impacted_subset, &impacted_subsets, &subset_seen_);
         --num_free_elements_[impacted_subset];
       }
     } else if (coverage_[element] == 2) {
       // `element` is newly overcovered.
       for (const SubsetIndex impacted_subset : rows[element]) {
-        CollectSubsets(impacted_subset, &impacted_subsets, &subset_seen);
+        CollectSubsets(impacted_subset, &impacted_subsets, &subset_seen_);
         --num_coverage_le_1_elements_[impacted_subset];
         if (num_coverage_le_1_elements_[impacted_subset] == 0) {
           // All the elements in impacted_subset are now overcovered, so it
@@ -220,11 +230,13 @@ std::vector<SubsetIndex> SetCoverInvariant::UnsafeUse(SubsetIndex subset) {
       }
     }
   }
+  ClearSubsetSeen(subset, impacted_subsets);
   DCHECK(CheckConsistency());
   return impacted_subsets;
 }
 
-std::vector<SubsetIndex> SetCoverInvariant::UnsafeRemove(SubsetIndex subset) {
+absl::Span<const SubsetIndex> SetCoverInvariant::UnsafeRemove(
+    SubsetIndex subset) {
   DCHECK(is_selected_[subset]);
   // If already selected, then num_free_elements == 0.
   DCHECK_EQ(num_free_elements_[subset], 0);
@@ -235,12 +247,11 @@ std::vector<SubsetIndex> SetCoverInvariant::UnsafeRemove(SubsetIndex subset) {
 
   const SparseColumnView& columns = model_->columns();
 
-  SubsetBoolVector subset_seen(columns.size(), false);
-  std::vector<SubsetIndex> impacted_subsets;
-  impacted_subsets.reserve(columns.size().value());
+  std::vector<SubsetIndex>& impacted_subsets = impacted_subsets_;
+  impacted_subsets.clear();
 
-  // Initialize subset_seen so that `subset` not be in impacted_subsets.
-  subset_seen[subset] = true;
+  // Initialize subset_seen_ so that `subset` not be in impacted_subsets.
+  subset_seen_[subset] = true;
 
   const SparseRowView& rows = model_->rows();
   for (const ElementIndex element : columns[subset]) {
@@ -250,13 +261,13 @@ std::vector<SubsetIndex> SetCoverInvariant::UnsafeRemove(SubsetIndex subset) {
       // `element` is no longer covered.
       ++num_uncovered_elements_;
       for (const SubsetIndex impacted_subset : rows[element]) {
-        CollectSubsets(impacted_subset, &impacted_subsets, &subset_seen);
+        CollectSubsets(impacted_subset, &impacted_subsets, &subset_seen_);
         ++num_free_elements_[impacted_subset];
       }
     } else if (coverage_[element] == 1) {
       // `element` is no longer overcovered.
       for (const SubsetIndex impacted_subset : rows[element]) {
-        CollectSubsets(impacted_subset, &impacted_subsets, &subset_seen);
+        CollectSubsets(impacted_subset, &impacted_subsets, &subset_seen_);
         ++num_coverage_le_1_elements_[impacted_subset];
         if (num_coverage_le_1_elements_[impacted_subset] == 1) {
           // There is one element of impacted_subset which is not overcovered.
@@ -266,6 +277,7 @@ std::vector<SubsetIndex> SetCoverInvariant::UnsafeRemove(SubsetIndex subset) {
       }
     }
   }
+  ClearSubsetSeen(subset, impacted_subsets);
   DCHECK(CheckConsistency());
   return impacted_subsets;
 }
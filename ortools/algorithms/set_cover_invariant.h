@@ -19,6 +19,7 @@
 #include <tuple>
 #include <vector>
 
+#include "absl/types/span.h"
 #include "ortools/algorithms/set_cover.pb.h"
 #include "ortools/algorithms/set_cover_model.h"
 
@@ -104,22 +105,25 @@ class SetCoverInvariant {
 
   // Toggles is_selected_[subset] to value, and incrementally updates the
   // invariant.
-  // Returns a vector of subsets impacted by the change, in case they need
+  // Returns the subsets impacted by the change, in case they need
   // to be reconsidered in a solution geneator or a local search algorithm.
+  // The returned span points into a buffer owned by the invariant, so no
+  // allocation happens in local search loops. It is only valid until the next
+  // call to a method modifying the invariant; copy it if needed beyond that.
   // Calls UnsafeToggle, with the added checks:
   // If value is true, DCHECKs that subset is removable.
   // If value is true, DCHECKs that marginal impact of subset is removable.
-  std::vector<SubsetIndex> Toggle(SubsetIndex subset, bool value);
+  absl::Span<const SubsetIndex> Toggle(SubsetIndex subset, bool value);
 
   // Same as Toggle, with less DCHECKS.
   // Useful for some meta-heuristics that allow to go through infeasible
   // solutions.
   // Only checks that value is different from is_selected_[subset].
-  std::vector<SubsetIndex> UnsafeToggle(SubsetIndex subset, bool value);
+  absl::Span<const SubsetIndex> UnsafeToggle(SubsetIndex subset, bool value);
 
-  std::vector<SubsetIndex> UnsafeUse(SubsetIndex subset);
+  absl::Span<const SubsetIndex> UnsafeUse(SubsetIndex subset);
 
-  std::vector<SubsetIndex> UnsafeRemove(SubsetIndex subset);
+  absl::Span<const SubsetIndex> UnsafeRemove(SubsetIndex subset);
 
   // Returns the current solution as a proto.
   SetCoverSolutionResponse ExportSolutionAsProto() const;
@@ -141,9 +145,13 @@ class SetCoverInvariant {
              SubsetBoolVector>       // Removability for each subset.
   ComputeImpliedData(const ElementToSubsetVector& cvrg) const;
 
+  // Resets `subset_seen_` for `subset` and `impacted_subsets`.
+  void ClearSubsetSeen(SubsetIndex subset,
+                       absl::Span<const SubsetIndex> impacted_subsets);
+
   // Internal UnsafeToggle where value is a constant for the template.
   template <bool value>
-  std::vector<SubsetIndex> UnsafeToggleInternal(SubsetIndex subset);
+  absl::Span<const SubsetIndex> UnsafeToggleInternal(SubsetIndex subset);
 
   // The weighted set covering model on which the solver is run.
   SetCoverModel* model_;
@@ -173,6 +181,17 @@ class SetCoverInvariant {
   // True if the subset is redundant, i.e. can be removed from the solution
   // without making it infeasible.
   SubsetBoolVector is_removable_;
+
+  // Scratch vector used by UnsafeUse() and UnsafeRemove() to collect the
+  // impacted subsets, all false between calls. Keeping it avoids allocating
+  // and clearing a vector of size #subsets at each call, which made the
+  // greedy heuristics quadratic.
+  SubsetBoolVector subset_seen_;
+
+  // The subsets impacted by the last call to UnsafeUse() or UnsafeRemove(),
+  // returned as a span. Reused across calls so that its capacity quickly
+  // reaches the largest neighborhood and the moves stop allocating.
+  std::vector<SubsetIndex> impacted_subsets_;
 };
 
 }  // namespace operations_research
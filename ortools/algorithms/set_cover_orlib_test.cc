@@ -137,12 +137,28 @@ SetCoverInvariant IterateClearElementDegreeAndSteepest(std::string name,
   return inv;
 }
 
+// Measures the throughput of the local search moves, i.e. of the incremental
+// updates of the invariant, on a copy of `inv`.
+void RunGuidedTabuSearchThroughput(std::string name, SetCoverInvariant inv) {
+  constexpr int kNumIterations = 1000;
+  GuidedTabuSearch gts(&inv);
+  WallTimer timer;
+  timer.Start();
+  gts.NextSolution(kNumIterations);
+  timer.Stop();
+  LOG(INFO) << name << ", GuidedTabuSearch_cost, " << inv.cost() << ", "
+            << absl::ToInt64Microseconds(timer.GetDuration()) << ", us, "
+            << absl::ToDoubleMicroseconds(timer.GetDuration()) / kNumIterations
+            << ", us/iteration";
+}
+
 double RunSolver(std::string name, SetCoverModel* model) {
   LogStats(name, model);
   WallTimer global_timer;
   global_timer.Start();
   RunChvatalAndSteepest(name, model);
   SetCoverInvariant inv = RunElementDegreeGreedyAndSteepest(name, model);
+  RunGuidedTabuSearchThroughput(name, inv);
   // IterateClearAndMip(name, inv);
   IterateClearElementDegreeAndSteepest(name, inv);
   return inv.cost();
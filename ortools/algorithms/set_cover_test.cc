@@ -127,6 +127,34 @@ TEST(SetCoverTest, InitialValues) {
   EXPECT_TRUE(inv.CheckConsistency());
 }
 
+TEST(SetCoverTest, ToggleReturnsImpactedSubsets) {
+  SetCoverModel model;
+  model.AddEmptySubset(1);
+  model.AddElementToLastSubset(0);
+  model.AddEmptySubset(1);
+  model.AddElementToLastSubset(1);
+  model.AddElementToLastSubset(2);
+  model.AddEmptySubset(1);
+  model.AddElementToLastSubset(1);
+  model.AddEmptySubset(1);
+  model.AddElementToLastSubset(2);
+  SetCoverInvariant inv(&model);
+
+  EXPECT_THAT(inv.Toggle(SubsetIndex(1), true),
+              ::testing::UnorderedElementsAre(SubsetIndex(2), SubsetIndex(3)));
+  EXPECT_THAT(inv.Toggle(SubsetIndex(0), true), ::testing::IsEmpty());
+  EXPECT_THAT(inv.UnsafeToggle(SubsetIndex(2), true),
+              ::testing::ElementsAre(SubsetIndex(1)));
+  EXPECT_THAT(inv.UnsafeToggle(SubsetIndex(3), true),
+              ::testing::ElementsAre(SubsetIndex(1)));
+  EXPECT_TRUE(inv.is_removable()[SubsetIndex(1)]);
+  EXPECT_THAT(inv.Toggle(SubsetIndex(1), false),
+              ::testing::UnorderedElementsAre(SubsetIndex(2), SubsetIndex(3)));
+  EXPECT_FALSE(inv.is_removable()[SubsetIndex(2)]);
+  EXPECT_EQ(inv.num_uncovered_elements(), 0);
+  EXPECT_TRUE(inv.CheckConsistency());
+}
+
 TEST(SetCoverTest, Preprocessor) {
   SetCoverModel model;
   model.AddEmptySubset(1);
@@ -206,6 +234,38 @@ TEST(SetCoverTest, KnightsCoverGreedy) {
   LOG(INFO) << "SteepestSearch cost: " << inv.cost();
 }
 
+TEST(SetCoverTest, KnightsCoverLazyGreedy) {
+  SetCoverModel model = CreateKnightsCoverModel(SIZE, SIZE);
+  SetCoverInvariant inv(&model);
+
+  GreedySolutionGenerator greedy(&inv);
+  CHECK(greedy.NextSolution());
+  const Cost greedy_cost = inv.cost();
+  LOG(INFO) << "GreedySolutionGenerator cost: " << greedy_cost;
+
+  inv.Clear();
+  LazyGreedySolutionGenerator lazy_greedy(&inv);
+  CHECK(lazy_greedy.NextSolution());
+  LOG(INFO) << "LazyGreedySolutionGenerator cost: " << inv.cost() << " with "
+            << lazy_greedy.num_reevaluations() << " reevaluations";
+  EXPECT_TRUE(inv.CheckConsistency());
+  EXPECT_EQ(inv.num_uncovered_elements(), 0);
+  EXPECT_EQ(inv.cost(), greedy_cost);
+
+  inv.Clear();
+  lazy_greedy.SetPriorityTolerance(0.2);
+  CHECK(lazy_greedy.NextSolution());
+  LOG(INFO) << "LazyGreedySolutionGenerator cost with tolerance: "
+            << inv.cost();
+  EXPECT_TRUE(inv.CheckConsistency());
+  EXPECT_EQ(inv.num_uncovered_elements(), 0);
+
+  SteepestSearch steepest(&inv);
+  CHECK(steepest.NextSolution(100000));
+  LOG(INFO) << "SteepestSearch cost: " << inv.cost();
+  EXPECT_TRUE(inv.CheckConsistency());
+}
+
 TEST(SetCoverTest, KnightsCoverRandom) {
   SetCoverModel model = CreateKnightsCoverModel(SIZE, SIZE);
   EXPECT_TRUE(model.ComputeFeasibility());
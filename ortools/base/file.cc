@@ -60,6 +60,14 @@ size_t File::Size() {
   return f_stat.st_size;
 }
 
+bool File::Seek(int64_t position) {
+#if defined(_MSC_VER)
+  return _fseeki64(f_, position, SEEK_SET) == 0;
+#else
+  return fseeko(f_, position, SEEK_SET) == 0;
+#endif
+}
+
 bool File::Flush() { return fflush(f_) == 0; }
 
 bool File::Close() {
@@ -81,6 +81,10 @@ class File {
   // Returns file size.
   size_t Size();
 
+  // Moves the position of the next read or write to `position` bytes from the
+  // beginning of the file.
+  bool Seek(int64_t position);
+
   // Inits internal data structures.
   static void Init();
 
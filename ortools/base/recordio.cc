@@ -15,12 +15,24 @@
 
 #include <zlib.h>
 
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
 #include <memory>
 #include <string>
+#include <utility>
+#include <vector>
 
+#include "absl/strings/string_view.h"
+#include "ortools/base/file.h"
 #include "ortools/base/logging.h"
+#include "ortools/base/threadpool.h"
 
 namespace recordio {
+
+using ::operations_research::ParallelFor;
+using ::operations_research::ThreadPool;
+
 const int RecordWriter::kMagicNumber = 0x3ed7230a;
 
 RecordWriter::RecordWriter(File* const file)
@@ -53,6 +65,39 @@ RecordReader::RecordReader(File* const file) : file_(file) {}
 
 bool RecordReader::Close() { return file_->Close(); }
 
+bool RecordReader::ReadRecord(std::string* record) {
+  uint64_t usize = 0;
+  uint64_t csize = 0;
+  int magic_number = 0;
+  if (file_->Read(&magic_number, sizeof(magic_number)) !=
+      sizeof(magic_number)) {
+    return false;
+  }
+  if (magic_number != RecordWriter::kMagicNumber) {
+    return false;
+  }
+  if (file_->Read(&usize, sizeof(usize)) != sizeof(usize)) {
+    return false;
+  }
+  if (file_->Read(&csize, sizeof(csize)) != sizeof(csize)) {
+    return false;
+  }
+  record->resize(usize);
+  if (csize != 0) {  // The data is compressed.
+    std::unique_ptr<char[]> compressed_buffer(new char[csize + 1]);
+    if (file_->Read(compressed_buffer.get(), csize) != csize) {
+      return false;
+    }
+    compressed_buffer[csize] = '\0';
+    Uncompress(compressed_buffer.get(), csize, record->data(), usize);
+  } else {
+    if (file_->Read(record->data(), usize) != usize) {
+      return false;
+    }
+  }
+  return true;
+}
+
 void RecordReader::Uncompress(const char* const source, uint64_t source_size,
                               char* const output_buffer,
                               uint64_t output_size) const {
@@ -66,4 +111,240 @@ void RecordReader::Uncompress(const char* const source, uint64_t source_size,
   }
   CHECK_LE(result_size, static_cast<unsigned long>(output_size));  // NOLINT
 }
+
+namespace {
+
+template <typename T>
+void AppendValue(T value, std::string* output) {
+  output->append(reinterpret_cast<const char*>(&value), sizeof(value));
+}
+
+template <typename T>
+bool WriteValue(T value, File* file) {
+  return file->Write(&value, sizeof(value)) == sizeof(value);
+}
+
+template <typename T>
+bool ReadValue(File* file, T* value) {
+  return file->Read(value, sizeof(*value)) == sizeof(*value);
+}
+
+}  // namespace
+
+const int BlockRecordWriter::kBlockMagicNumber = 0x3ed7230b;
+const int BlockRecordWriter::kIndexMagicNumber = 0x3ed7230c;
+
+BlockRecordWriter::BlockRecordWriter(File* const file, int64_t block_size,
+                                     int num_threads)
+    : file_(file),
+      block_size_(std::max<int64_t>(1, block_size)),
+      num_threads_(std::max(1, num_threads)) {
+  if (num_threads_ > 1) {
+    thread_pool_ = std::make_unique<ThreadPool>("RecordIO", num_threads_);
+    thread_pool_->StartWorkers();
+  }
+}
+
+bool BlockRecordWriter::WriteRecord(absl::string_view record) {
+  if (pending_blocks_.empty() ||
+      pending_blocks_.back().uncompressed.size() >= block_size_) {
+    if (pending_blocks_.size() == num_threads_ && !WritePendingBlocks()) {
+      return false;
+    }
+    pending_blocks_.emplace_back();
+  }
+  Block& block = pending_blocks_.back();
+  AppendValue<uint64_t>(record.size(), &block.uncompressed);
+  block.uncompressed.append(record.data(), record.size());
+  ++block.num_records;
+  return ok_;
+}
+
+bool BlockRecordWriter::WritePendingBlocks() {
+  ParallelFor(thread_pool_.get(), 0, pending_blocks_.size(), /*grain=*/1,
+              [this](int64_t begin, int64_t end) {
+                for (int64_t i = begin; i < end; ++i) {
+                  Block& block = pending_blocks_[i];
+                  block.compressed.resize(
+                      compressBound(block.uncompressed.size()));
+                  unsigned long size = block.compressed.size();  // NOLINT
+                  const int result = compress(
+                      reinterpret_cast<unsigned char*>(block.compressed.data()),
+                      &size,
+                      reinterpret_cast<const unsigned char*>(
+                          block.uncompressed.data()),
+                      block.uncompressed.size());
+                  if (result != Z_OK) {
+                    LOG(FATAL) << "Compress error occurred! Error code: "
+                               << result;
+                  }
+                  block.compressed.resize(size);
+                }
+              });
+  for (const Block& block : pending_blocks_) {
+    block_offsets_.push_back(file_offset_);
+    block_first_records_.push_back(num_records_);
+    num_records_ += block.num_records;
+    ok_ = ok_ && WriteValue(kBlockMagicNumber, file_) &&
+          WriteValue<uint64_t>(block.num_records, file_) &&
+          WriteValue<uint64_t>(block.uncompressed.size(), file_) &&
+          WriteValue<uint64_t>(block.compressed.size(), file_) &&
+          file_->Write(block.compressed.data(), block.compressed.size()) ==
+              block.compressed.size();
+    file_offset_ += sizeof(kBlockMagicNumber) + 3 * sizeof(uint64_t) +
+                    block.compressed.size();
+  }
+  pending_blocks_.clear();
+  return ok_;
+}
+
+bool BlockRecordWriter::Close() {
+  WritePendingBlocks();
+  for (int i = 0; i < block_offsets_.size(); ++i) {
+    ok_ = ok_ && WriteValue(block_offsets_[i], file_) &&
+          WriteValue(block_first_records_[i], file_);
+  }
+  ok_ = ok_ && WriteValue<uint64_t>(block_offsets_.size(), file_) &&
+        WriteValue<uint64_t>(num_records_, file_) &&
+        WriteValue(kIndexMagicNumber, file_);
+  return file_->Close() && ok_;
+}
+
+BlockRecordReader::BlockRecordReader(File* const file) : file_(file) {}
+
+bool BlockRecordReader::Close() { return file_->Close(); }
+
+bool BlockRecordReader::ReadIndex() {
+  const int64_t file_size = file_->Size();
+  const int64_t trailer_size =
+      2 * sizeof(uint64_t) + sizeof(BlockRecordWriter::kIndexMagicNumber);
+  if (file_size < trailer_size) return false;
+  uint64_t num_blocks = 0;
+  uint64_t num_records = 0;
+  int magic_number = 0;
+  if (!file_->Seek(file_size - trailer_size) ||
+      !ReadValue(file_, &num_blocks) || !ReadValue(file_, &num_records) ||
+      !ReadValue(file_, &magic_number) ||
+      magic_number != BlockRecordWriter::kIndexMagicNumber) {
+    return false;
+  }
+  const int64_t index_size = 2 * sizeof(uint64_t) * num_blocks;
+  if (num_blocks > file_size || index_size > file_size - trailer_size ||
+      !file_->Seek(file_size - trailer_size - index_size)) {
+    return false;
+  }
+  block_offsets_.resize(num_blocks);
+  block_first_records_.resize(num_blocks);
+  for (int i = 0; i < num_blocks; ++i) {
+    if (!ReadValue(file_, &block_offsets_[i]) ||
+        !ReadValue(file_, &block_first_records_[i])) {
+      return false;
+    }
+  }
+  cached_block_index_ = -1;
+  num_records_ = num_records;
+  return true;
+}
+
+bool BlockRecordReader::ReadBlock(int block, Block* output) {
+  int magic_number = 0;
+  uint64_t num_records = 0;
+  uint64_t compressed_size = 0;
+  if (!file_->Seek(block_offsets_[block]) ||
+      !ReadValue(file_, &magic_number) ||
+      magic_number != BlockRecordWriter::kBlockMagicNumber ||
+      !ReadValue(file_, &num_records) ||
+      !ReadValue(file_, &output->uncompressed_size) ||
+      !ReadValue(file_, &compressed_size)) {
+    return false;
+  }
+  output->num_records = num_records;
+  output->compressed.resize(compressed_size);
+  return file_->Read(output->compressed.data(), compressed_size) ==
+         compressed_size;
+}
+
+bool BlockRecordReader::UncompressBlock(Block* block) {
+  block->uncompressed.resize(block->uncompressed_size);
+  unsigned long size = block->uncompressed_size;  // NOLINT
+  if (uncompress(reinterpret_cast<unsigned char*>(block->uncompressed.data()),
+                 &size,
+                 reinterpret_cast<const unsigned char*>(
+                     block->compressed.data()),
+                 block->compressed.size()) != Z_OK ||
+      size != block->uncompressed_size) {
+    return false;
+  }
+  block->compressed.clear();
+  block->records.clear();
+  block->records.reserve(block->num_records);
+  uint64_t offset = 0;
+  for (int64_t i = 0; i < block->num_records; ++i) {
+    uint64_t record_size = 0;
+    if (size - offset < sizeof(record_size)) return false;
+    memcpy(&record_size, block->uncompressed.data() + offset,
+           sizeof(record_size));
+    offset += sizeof(record_size);
+    if (size - offset < record_size) return false;
+    block->records.push_back({offset, record_size});
+    offset += record_size;
+  }
+  return offset == size;
+}
+
+bool BlockRecordReader::ReadRecord(int64_t index, std::string* record) {
+  if (index < 0 || index >= num_records_) return false;
+  const int block =
+      std::upper_bound(block_first_records_.begin(),
+                       block_first_records_.end(), index) -
+      block_first_records_.begin() - 1;
+  if (block != cached_block_index_) {
+    cached_block_index_ = -1;
+    if (!ReadBlock(block, &cached_block_) ||
+        !UncompressBlock(&cached_block_)) {
+      return false;
+    }
+    cached_block_index_ = block;
+  }
+  const int64_t index_in_block = index - block_first_records_[block];
+  if (index_in_block >= cached_block_.records.size()) return false;
+  const auto [offset, size] = cached_block_.records[index_in_block];
+  record->assign(cached_block_.uncompressed, offset, size);
+  return true;
+}
+
+bool BlockRecordReader::ReadAllRecords(int num_threads,
+                                       std::vector<std::string>* records) {
+  num_threads = std::max(1, num_threads);
+  std::unique_ptr<ThreadPool> thread_pool;
+  if (num_threads > 1) {
+    thread_pool = std::make_unique<ThreadPool>("RecordIO", num_threads);
+    thread_pool->StartWorkers();
+  }
+  records->clear();
+  records->reserve(num_records_);
+  std::vector<Block> blocks(num_threads);
+  std::vector<char> uncompressed_ok(num_threads);
+  for (int first_block = 0; first_block < block_offsets_.size();
+       first_block += num_threads) {
+    const int num_blocks = std::min<int>(num_threads,
+                                         block_offsets_.size() - first_block);
+    for (int i = 0; i < num_blocks; ++i) {
+      if (!ReadBlock(first_block + i, &blocks[i])) return false;
+    }
+    ParallelFor(thread_pool.get(), 0, num_blocks, /*grain=*/1,
+                [&](int64_t begin, int64_t end) {
+                  for (int64_t i = begin; i < end; ++i) {
+                    uncompressed_ok[i] = UncompressBlock(&blocks[i]);
+                  }
+                });
+    for (int i = 0; i < num_blocks; ++i) {
+      if (!uncompressed_ok[i]) return false;
+      for (const auto [offset, size] : blocks[i].records) {
+        records->emplace_back(blocks[i].uncompressed, offset, size);
+      }
+    }
+  }
+  return true;
+}
 }  // namespace recordio
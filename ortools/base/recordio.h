@@ -14,10 +14,15 @@
 #ifndef OR_TOOLS_BASE_RECORDIO_H_
 #define OR_TOOLS_BASE_RECORDIO_H_
 
+#include <cstdint>
 #include <memory>
 #include <string>
+#include <utility>
+#include <vector>
 
+#include "absl/strings/string_view.h"
 #include "ortools/base/file.h"
+#include "ortools/base/threadpool.h"
 
 // This file defines some IO interfaces to compatible with Google
 // IO specifications.
@@ -89,39 +94,17 @@ class RecordReader {
 
   template <class P>
   bool ReadProtocolMessage(P* const proto) {
-    uint64_t usize = 0;
-    uint64_t csize = 0;
-    int magic_number = 0;
-    if (file_->Read(&magic_number, sizeof(magic_number)) !=
-        sizeof(magic_number)) {
-      return false;
-    }
-    if (magic_number != RecordWriter::kMagicNumber) {
-      return false;
-    }
-    if (file_->Read(&usize, sizeof(usize)) != sizeof(usize)) {
-      return false;
-    }
-    if (file_->Read(&csize, sizeof(csize)) != sizeof(csize)) {
-      return false;
-    }
-    std::unique_ptr<char[]> buffer(new char[usize + 1]);
-    if (csize != 0) {  // The data is compressed.
-      std::unique_ptr<char[]> compressed_buffer(new char[csize + 1]);
-      if (file_->Read(compressed_buffer.get(), csize) != csize) {
-        return false;
-      }
-      compressed_buffer[csize] = '\0';
-      Uncompress(compressed_buffer.get(), csize, buffer.get(), usize);
-    } else {
-      if (file_->Read(buffer.get(), usize) != usize) {
-        return false;
-      }
-    }
-    proto->ParseFromArray(buffer.get(), usize);
+    std::string record;
+    if (!ReadRecord(&record)) return false;
+    proto->ParseFromString(record);
     return true;
   }
 
+  // Reads the next record and returns its uncompressed payload, i.e. the
+  // serialized protocol buffer. This allows to parse it later, possibly in
+  // another thread. Returns false at the end of the file or on error.
+  bool ReadRecord(std::string* record);
+
   // Closes the underlying file.
   bool Close();
 
@@ -131,6 +114,139 @@ class RecordReader {
 
   File* const file_;
 };
+
+// This class appends records (e.g. serialized protocol buffers) to a file by
+// blocks of consecutive records, compressed in parallel, and ends the file with
+// an index of the blocks, which allows BlockRecordReader to read any record
+// without reading the whole file, and to uncompress the blocks in parallel.
+// The data written in the file follows the following format:
+// - For each block:
+//   - kBlockMagicNumber (32 bits).
+//   - The number of records of the block (64 bits).
+//   - The uncompressed and compressed sizes of the payload (64 bits each).
+//   - The payload, compressed with zlib: for each record, its size (64 bits)
+//     followed by its data.
+// - For each block, its offset in the file and the index of its first record
+//   (64 bits each).
+// - The number of blocks and of records (64 bits each) and kIndexMagicNumber
+//   (32 bits).
+//
+// This format is not compatible with the one of RecordWriter.
+class BlockRecordWriter {
+ public:
+  static const int kBlockMagicNumber;
+  static const int kIndexMagicNumber;
+
+  // Does not take ownership of `file`. A block is compressed when the size of
+  // its records reaches `block_size` bytes. With `num_threads` > 1, up to
+  // `num_threads` blocks are kept in memory and compressed in parallel.
+  explicit BlockRecordWriter(File* file, int64_t block_size = 1 << 20,
+                             int num_threads = 1);
+
+  // This type is neither copyable nor movable.
+  BlockRecordWriter(const BlockRecordWriter&) = delete;
+  BlockRecordWriter& operator=(const BlockRecordWriter&) = delete;
+
+  template <class P>
+  bool WriteProtocolMessage(const P& proto) {
+    std::string record;
+    proto.SerializeToString(&record);
+    return WriteRecord(record);
+  }
+
+  // Appends a record. Returns false if some data couldn't be written, in which
+  // case the file is invalid.
+  bool WriteRecord(absl::string_view record);
+
+  // Writes the pending blocks and the index, and closes the underlying file.
+  // This must be called for the file to be valid.
+  bool Close();
+
+ private:
+  struct Block {
+    int64_t num_records = 0;
+    std::string uncompressed;
+    std::string compressed;
+  };
+
+  // Compresses the pending blocks, in parallel, and writes them.
+  bool WritePendingBlocks();
+
+  File* const file_;
+  const int64_t block_size_;
+  const int num_threads_;
+  std::unique_ptr<operations_research::ThreadPool> thread_pool_;
+  // The blocks not written yet, the last one being filled.
+  std::vector<Block> pending_blocks_;
+  int64_t num_records_ = 0;
+  int64_t file_offset_ = 0;
+  // The offset and the index of the first record of the written blocks.
+  std::vector<uint64_t> block_offsets_;
+  std::vector<uint64_t> block_first_records_;
+  bool ok_ = true;
+};
+
+// This class reads the records of a file written by BlockRecordWriter, in any
+// order.
+class BlockRecordReader {
+ public:
+  // Does not take ownership of `file`.
+  explicit BlockRecordReader(File* file);
+
+  // This type is neither copyable nor movable.
+  BlockRecordReader(const BlockRecordReader&) = delete;
+  BlockRecordReader& operator=(const BlockRecordReader&) = delete;
+
+  // Reads the index at the end of the file. Must be called, and return true,
+  // before the functions below. Returns false if the file wasn't written (and
+  // closed) by a BlockRecordWriter.
+  bool ReadIndex();
+
+  int64_t NumRecords() const { return num_records_; }
+
+  // Reads the record of index `index`, in [0, NumRecords()). The last block
+  // read is kept in memory, so reading the records in order only reads and
+  // uncompresses each block once.
+  bool ReadRecord(int64_t index, std::string* record);
+
+  template <class P>
+  bool ReadProtocolMessage(int64_t index, P* const proto) {
+    std::string record;
+    if (!ReadRecord(index, &record)) return false;
+    return proto->ParseFromString(record);
+  }
+
+  // Reads all the records, in order. The blocks are read by the calling
+  // thread and uncompressed by batches of `num_threads` blocks in parallel.
+  bool ReadAllRecords(int num_threads, std::vector<std::string>* records);
+
+  // Closes the underlying file.
+  bool Close();
+
+ private:
+  struct Block {
+    int64_t num_records = 0;
+    uint64_t uncompressed_size = 0;
+    std::string compressed;
+    std::string uncompressed;
+    // The offset and size of each record in `uncompressed`.
+    std::vector<std::pair<uint64_t, uint64_t>> records;
+  };
+
+  // Reads block `block` from the file, without uncompressing it.
+  bool ReadBlock(int block, Block* output);
+
+  // Uncompresses `block->compressed` and finds its records.
+  static bool UncompressBlock(Block* block);
+
+  File* const file_;
+  int64_t num_records_ = 0;
+  std::vector<uint64_t> block_offsets_;
+  std::vector<uint64_t> block_first_records_;
+  // The last block read by ReadRecord(), or -1.
+  int cached_block_index_ = -1;
+  Block cached_block_;
+};
 }  // namespace recordio
 
 #endif  // OR_TOOLS_BASE_RECORDIO_H_
@@ -17,6 +17,7 @@
 #if defined(__APPLE__) && defined(__GNUC__)  // MacOS
 #include <mach/mach_init.h>
 #include <mach/task.h>
+#include <sys/resource.h>
 #elif (defined(__FreeBSD__) || defined(__OpenBSD__))  // FreeBSD or OpenBSD
 #include <sys/resource.h>
 #include <sys/time.h>
@@ -48,6 +49,13 @@ int64_t GetProcessMemoryUsage() {
   int64_t resident_memory = t_info.resident_size;
   return resident_memory;
 }
+
+int64_t GetProcessPeakMemoryUsage() {
+  struct rusage rusage;
+  if (getrusage(RUSAGE_SELF, &rusage) != 0) return 0;
+  // On MacOS, ru_maxrss is in bytes.
+  return static_cast<int64_t>(rusage.ru_maxrss);
+}
 #elif defined(__GNUC__) && !defined(__FreeBSD__) && \
     !defined(__OpenBSD__) && !defined(__EMSCRIPTEN__) && \
     !defined(_WIN32)  // Linux
@@ -62,6 +70,22 @@ int64_t GetProcessMemoryUsage() {
   fclose(pf);
   return int64_t{1024} * size;
 }
+
+int64_t GetProcessPeakMemoryUsage() {
+  FILE* const pf = fopen("/proc/self/status", "r");
+  if (pf == nullptr) return 0;
+  int64_t peak_kb = 0;
+  char line[128];
+  while (fgets(line, sizeof(line), pf) != nullptr) {
+    long long value;  // NOLINT
+    if (sscanf(line, "VmHWM: %lld kB", &value) == 1) {
+      peak_kb = value;
+      break;
+    }
+  }
+  fclose(pf);
+  return int64_t{1024} * peak_kb;
+}
 #elif (defined(__FreeBSD__) || defined(__OpenBSD__)) // FreeBSD or OpenBSD
 int64_t GetProcessMemoryUsage() {
   int who = RUSAGE_SELF;
@@ -69,6 +93,8 @@ int64_t GetProcessMemoryUsage() {
   getrusage(who, &rusage);
   return (int64_t)(int64_t{1024} * rusage.ru_maxrss);
 }
+
+int64_t GetProcessPeakMemoryUsage() { return GetProcessMemoryUsage(); }
 //                               Windows
 #elif defined(_MSC_VER) || defined(__MINGW32__) || defined(__MINGW64__)
 int64_t GetProcessMemoryUsage() {
@@ -85,8 +111,24 @@ int64_t GetProcessMemoryUsage() {
   }
   return memory;
 }
+
+int64_t GetProcessPeakMemoryUsage() {
+  HANDLE hProcess;
+  PROCESS_MEMORY_COUNTERS pmc;
+  hProcess = OpenProcess(PROCESS_QUERY_INFORMATION | PROCESS_VM_READ, FALSE,
+                         GetCurrentProcessId());
+  int64_t memory = 0;
+  if (hProcess) {
+    if (GetProcessMemoryInfo(hProcess, &pmc, sizeof(pmc))) {
+      memory = pmc.PeakWorkingSetSize;
+    }
+    CloseHandle(hProcess);
+  }
+  return memory;
+}
 #else  // Unknown, returning 0.
 int64_t GetProcessMemoryUsage() { return 0; }
+int64_t GetProcessPeakMemoryUsage() { return 0; }
 #endif
 
 }  // namespace operations_research
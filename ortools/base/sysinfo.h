@@ -19,6 +19,10 @@
 namespace operations_research {
 // Returns the memory usage of the process.
 int64_t GetProcessMemoryUsage();
+
+// Returns the peak resident memory usage of the process since its start, or
+// 0 if it is not known on this platform.
+int64_t GetProcessPeakMemoryUsage();
 }  // namespace operations_research
 
 inline int64_t MemoryUsage(int unused) {
@@ -13,26 +13,45 @@
 
 #include "ortools/base/threadpool.h"
 
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
 #include <functional>
+#include <memory>
 #include <mutex>
+#include <thread>
+#include <utility>
+#include <vector>
 
+#if defined(__linux__)
+#include <pthread.h>
+#include <sched.h>
+#endif  // __linux__
+
+#include "absl/functional/function_ref.h"
 #include "absl/log/check.h"
 #include "absl/strings/string_view.h"
+#include "absl/synchronization/blocking_counter.h"
+#include "absl/synchronization/notification.h"
 
 namespace operations_research {
-void RunWorker(void* data) {
-  ThreadPool* const thread_pool = reinterpret_cast<ThreadPool*>(data);
-  std::function<void()> work = thread_pool->GetNextTask();
-  while (work != nullptr) {
-    work();
-    work = thread_pool->GetNextTask();
+namespace {
+
+// The pool and worker index of the current thread, if it is a pool worker.
+thread_local const ThreadPool* current_pool = nullptr;
+thread_local int current_worker = -1;
+
+}  // namespace
+
+ThreadPool::ThreadPool(int num_threads) : num_workers_(num_threads) {
+  CHECK_GT(num_workers_, 0);
+  for (int i = 0; i < num_workers_; ++i) {
+    queues_.push_back(std::make_unique<WorkerQueue>());
   }
 }
 
-ThreadPool::ThreadPool(int num_threads) : num_workers_(num_threads) {}
-
 ThreadPool::ThreadPool(absl::string_view /*prefix*/, int num_threads)
-    : num_workers_(num_threads) {}
+    : ThreadPool(num_threads) {}
 
 ThreadPool::~ThreadPool() {
   if (started_) {
@@ -52,45 +71,256 @@ void ThreadPool::SetQueueCapacity(int capacity) {
   queue_capacity_ = capacity;
 }
 
+void ThreadPool::PinWorkersToCpus() {
+  CHECK(!started_);
+  pin_workers_to_cpus_ = true;
+}
+
 void ThreadPool::StartWorkers() {
   started_ = true;
   for (int i = 0; i < num_workers_; ++i) {
-    all_workers_.push_back(std::thread(&RunWorker, this));
+    all_workers_.push_back(std::thread(&ThreadPool::RunWorker, this, i));
+  }
+#if defined(__linux__)
+  if (pin_workers_to_cpus_) {
+    cpu_set_t allowed;
+    CPU_ZERO(&allowed);
+    if (sched_getaffinity(0, sizeof(allowed), &allowed) != 0) return;
+    std::vector<int> cpus;
+    for (int cpu = 0; cpu < CPU_SETSIZE; ++cpu) {
+      if (CPU_ISSET(cpu, &allowed)) cpus.push_back(cpu);
+    }
+    if (cpus.empty()) return;
+    for (int i = 0; i < num_workers_; ++i) {
+      cpu_set_t cpu_set;
+      CPU_ZERO(&cpu_set);
+      CPU_SET(cpus[i % cpus.size()], &cpu_set);
+      // This is best effort, a failure only costs some locality.
+      pthread_setaffinity_np(all_workers_[i].native_handle(), sizeof(cpu_set),
+                             &cpu_set);
+    }
   }
+#endif  // __linux__
 }
 
-std::function<void()> ThreadPool::GetNextTask() {
-  std::unique_lock<std::mutex> lock(mutex_);
+void ThreadPool::RunWorker(int worker) {
+  current_pool = this;
+  current_worker = worker;
+  std::function<void()> work = GetNextTask(worker);
+  while (work != nullptr) {
+    work();
+    work = GetNextTask(worker);
+  }
+}
+
+bool ThreadPool::TryPopTask(int worker, std::function<void()>* task) {
+  // Our own queue is used as a stack, this gives better locality for tasks
+  // scheduled from within a task.
+  {
+    WorkerQueue& queue = *queues_[worker];
+    std::lock_guard<std::mutex> lock(queue.mutex);
+    if (!queue.tasks.empty()) {
+      *task = std::move(queue.tasks.back());
+      queue.tasks.pop_back();
+      return true;
+    }
+  }
+
+  // Steal the oldest task of another queue.
+  for (int i = 1; i < num_workers_; ++i) {
+    WorkerQueue& queue = *queues_[(worker + i) % num_workers_];
+    std::lock_guard<std::mutex> lock(queue.mutex);
+    if (!queue.tasks.empty()) {
+      *task = std::move(queue.tasks.front());
+      queue.tasks.pop_front();
+      return true;
+    }
+  }
+  return false;
+}
+
+std::function<void()> ThreadPool::GetNextTask(int worker) {
+  CHECK_GE(worker, 0);
+  CHECK_LT(worker, num_workers_);
+  std::function<void()> task;
   for (;;) {
-    if (!tasks_.empty()) {
-      std::function<void()> task = tasks_.front();
-      tasks_.pop_front();
-      if (tasks_.size() < queue_capacity_ && waiting_for_capacity_) {
+    if (num_queued_tasks_.load(std::memory_order_acquire) > 0 &&
+        TryPopTask(worker, &task)) {
+      const int remaining = num_queued_tasks_.fetch_sub(1) - 1;
+      if (remaining < queue_capacity_ && waiting_for_capacity_.load()) {
+        std::unique_lock<std::mutex> lock(mutex_);
         waiting_for_capacity_ = false;
         capacity_condition_.notify_all();
       }
       return task;
     }
-    if (waiting_to_finish_) {
-      return nullptr;
-    } else {
-      condition_.wait(lock);
-    }
+
+    std::unique_lock<std::mutex> lock(mutex_);
+    if (num_queued_tasks_.load() > 0) continue;
+    if (waiting_to_finish_) return nullptr;
+    condition_.wait(lock);
   }
   return nullptr;
 }
 
 void ThreadPool::Schedule(std::function<void()> closure) {
-  std::unique_lock<std::mutex> lock(mutex_);
-  while (tasks_.size() >= queue_capacity_) {
-    waiting_for_capacity_ = true;
-    capacity_condition_.wait(lock);
+  const int worker =
+      current_pool == this
+          ? current_worker
+          : static_cast<int>(next_queue_.fetch_add(1, std::memory_order_relaxed) %
+                             static_cast<uint32_t>(num_workers_));
+  PushTask(worker, std::move(closure));
+}
+
+void ThreadPool::ScheduleOnWorker(int worker, std::function<void()> closure) {
+  CHECK_GE(worker, 0);
+  PushTask(worker % num_workers_, std::move(closure));
+}
+
+void ThreadPool::PushTask(int worker, std::function<void()> closure) {
+  if (num_queued_tasks_.load() >= queue_capacity_) {
+    std::unique_lock<std::mutex> lock(mutex_);
+    while (num_queued_tasks_.load() >= queue_capacity_) {
+      waiting_for_capacity_ = true;
+      capacity_condition_.wait(lock);
+    }
+  }
+
+  {
+    WorkerQueue& queue = *queues_[worker];
+    std::lock_guard<std::mutex> lock(queue.mutex);
+    queue.tasks.push_back(std::move(closure));
   }
-  tasks_.push_back(closure);
+  num_queued_tasks_.fetch_add(1, std::memory_order_release);
+
+  // Taking the mutex makes sure a worker that just saw an empty pool is either
+  // already waiting or will see the new count before waiting.
   if (started_) {
-    lock.unlock();
-    condition_.notify_all();
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+    }
+    condition_.notify_one();
+  }
+}
+
+void ParallelForEachItem(ThreadPool* thread_pool, int num_workers,
+                         int64_t num_items,
+                         const std::function<void(int, int64_t)>& f) {
+  constexpr int64_t kItemsPerChunk = 64;
+  if (thread_pool == nullptr || num_items <= kItemsPerChunk) {
+    for (int64_t i = 0; i < num_items; ++i) f(0, i);
+    return;
+  }
+  std::atomic<int64_t> next_item = 0;
+  absl::BlockingCounter counter(num_workers);
+  for (int worker = 0; worker < num_workers; ++worker) {
+    thread_pool->Schedule([&, worker]() {
+      while (true) {
+        const int64_t begin = next_item.fetch_add(kItemsPerChunk);
+        if (begin >= num_items) break;
+        const int64_t end = std::min(num_items, begin + kItemsPerChunk);
+        for (int64_t i = begin; i < end; ++i) f(worker, i);
+      }
+      counter.DecrementCount();
+    });
+  }
+  counter.Wait();
+}
+
+namespace {
+
+// The state of a ParallelFor() call. It is shared with the scheduled tasks, as
+// some of them may only start after the call returned.
+struct ParallelForState {
+  ParallelForState(int64_t begin, int64_t end, int64_t grain,
+                   absl::FunctionRef<void(int64_t, int64_t)> f)
+      : begin(begin),
+        end(end),
+        grain(grain),
+        num_chunks((end - begin + grain - 1) / grain),
+        f(f) {}
+
+  // Runs chunks until there is none left to start.
+  void RunChunks() {
+    int64_t num_done = 0;
+    for (;;) {
+      const int64_t chunk = next_chunk.fetch_add(1, std::memory_order_relaxed);
+      if (chunk >= num_chunks) break;
+      const int64_t chunk_begin = begin + chunk * grain;
+      f(chunk_begin, std::min(end, chunk_begin + grain));
+      ++num_done;
+    }
+    if (num_done > 0 &&
+        num_done_chunks.fetch_add(num_done, std::memory_order_acq_rel) +
+                num_done ==
+            num_chunks) {
+      all_done.Notify();
+    }
+  }
+
+  const int64_t begin;
+  const int64_t end;
+  const int64_t grain;
+  const int64_t num_chunks;
+  // Only called for the chunks started before all_done is notified, hence
+  // while the caller of ParallelFor() still waits.
+  const absl::FunctionRef<void(int64_t, int64_t)> f;
+  std::atomic<int64_t> next_chunk = 0;
+  std::atomic<int64_t> num_done_chunks = 0;
+  absl::Notification all_done;
+};
+
+}  // namespace
+
+void ParallelFor(ThreadPool* thread_pool, int64_t begin, int64_t end,
+                 int64_t grain, absl::FunctionRef<void(int64_t, int64_t)> f) {
+  CHECK_GT(grain, 0);
+  if (begin >= end) return;
+  if (thread_pool == nullptr || end - begin <= grain) {
+    for (int64_t chunk_begin = begin; chunk_begin < end;
+         chunk_begin += grain) {
+      f(chunk_begin, std::min(end, chunk_begin + grain));
+    }
+    return;
+  }
+  const auto state = std::make_shared<ParallelForState>(begin, end, grain, f);
+  // The calling thread runs one share of the chunks.
+  const int64_t num_tasks = std::min<int64_t>(thread_pool->NumWorkers(),
+                                              state->num_chunks - 1);
+  for (int64_t i = 0; i < num_tasks; ++i) {
+    thread_pool->Schedule([state]() { state->RunChunks(); });
   }
+  state->RunChunks();
+  state->all_done.WaitForNotification();
+}
+
+namespace {
+
+std::mutex shared_pool_mutex;
+ThreadPool* shared_pool = nullptr;
+int shared_pool_num_threads = 0;
+
+}  // namespace
+
+ThreadPool* SharedThreadPool() {
+  std::lock_guard<std::mutex> lock(shared_pool_mutex);
+  if (shared_pool == nullptr) {
+    const int num_threads =
+        shared_pool_num_threads > 0
+            ? shared_pool_num_threads
+            : std::max<int>(1, std::thread::hardware_concurrency());
+    shared_pool = new ThreadPool("shared", num_threads);
+    shared_pool->StartWorkers();
+  }
+  return shared_pool;
+}
+
+bool SetSharedThreadPoolNumThreads(int num_threads) {
+  CHECK_GT(num_threads, 0);
+  std::lock_guard<std::mutex> lock(shared_pool_mutex);
+  if (shared_pool != nullptr) return false;
+  shared_pool_num_threads = num_threads;
+  return true;
 }
 
 }  // namespace operations_research
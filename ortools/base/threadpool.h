@@ -14,17 +14,29 @@
 #ifndef OR_TOOLS_BASE_THREADPOOL_H_
 #define OR_TOOLS_BASE_THREADPOOL_H_
 
+#include <atomic>
 #include <condition_variable>  // NOLINT
+#include <cstdint>
+#include <deque>
 #include <functional>
-#include <list>
+#include <memory>
 #include <mutex>  // NOLINT
 #include <string>
 #include <thread>  // NOLINT
 #include <vector>
 
+#include "absl/functional/function_ref.h"
 #include "absl/strings/string_view.h"
 
 namespace operations_research {
+
+// Simple thread pool with one task queue per worker.
+//
+// A task scheduled from one of the pool workers is pushed on the queue of that
+// worker, other tasks are distributed in a round-robin fashion. Each worker
+// pops tasks from the back of its own queue and, when it is empty, steals from
+// the front of the other queues. This avoids having all the threads contend on
+// a single mutex when many short tasks are scheduled.
 class ThreadPool {
  public:
   explicit ThreadPool(int num_threads);
@@ -33,20 +45,89 @@ class ThreadPool {
 
   void StartWorkers();
   void Schedule(std::function<void()> closure);
-  std::function<void()> GetNextTask();
   void SetQueueCapacity(int capacity);
 
+  // Same as Schedule(), but always pushes the task on the queue of the given
+  // worker (modulo the number of workers). Scheduling the same part of a
+  // computation on the same worker each time keeps its data in the caches and,
+  // with PinWorkersToCpus(), in the memory of the same NUMA node since Linux
+  // allocates pages where they are first touched. Idle workers can still steal
+  // the task, so this is only a hint.
+  void ScheduleOnWorker(int worker, std::function<void()> closure);
+
+  // If called before StartWorkers(), each worker is bound to a single CPU,
+  // taken in turn from the CPUs this process is allowed to run on. This is
+  // only supported on Linux and is a no-op elsewhere.
+  void PinWorkersToCpus();
+
+  int NumWorkers() const { return num_workers_; }
+
+  // Blocks until a task is available and returns it. Returns nullptr once the
+  // pool is being destroyed and there is no more task to run. The worker index
+  // is only used to select the queue to look at first.
+  std::function<void()> GetNextTask(int worker = 0);
+
  private:
+  struct WorkerQueue {
+    std::mutex mutex;
+    std::deque<std::function<void()>> tasks;
+  };
+
+  void RunWorker(int worker);
+  bool TryPopTask(int worker, std::function<void()>* task);
+  void PushTask(int worker, std::function<void()> closure);
+
   const int num_workers_;
-  std::list<std::function<void()>> tasks_;
+  std::vector<std::unique_ptr<WorkerQueue>> queues_;
+
+  // Total number of tasks in all the queues. It is only incremented after a
+  // task was pushed, so a positive value does not guarantee that a pop will
+  // succeed, but a zero value with mutex_ held means there is nothing to do.
+  std::atomic<int> num_queued_tasks_ = 0;
+  std::atomic<uint32_t> next_queue_ = 0;
+  std::atomic<bool> waiting_for_capacity_ = false;
+
+  // Only used to put idle workers or blocked producers to sleep.
   std::mutex mutex_;
   std::condition_variable condition_;
   std::condition_variable capacity_condition_;
   bool waiting_to_finish_ = false;
-  bool waiting_for_capacity_ = false;
   bool started_ = false;
   int queue_capacity_ = 2e9;
+  bool pin_workers_to_cpus_ = false;
   std::vector<std::thread> all_workers_;
 };
+
+// Runs `f(worker, i)` for all `i` in [0, `num_items`), on the `num_workers`
+// workers of `thread_pool` when it is not nullptr, or else on the calling
+// thread with `worker` = 0. Calls with the same `worker` never run
+// concurrently, so `f` can use per-worker data without locking. The items are
+// handed out by chunks of consecutive indices.
+void ParallelForEachItem(ThreadPool* thread_pool, int num_workers,
+                         int64_t num_items,
+                         const std::function<void(int, int64_t)>& f);
+
+// Runs `f(chunk_begin, chunk_end)` on consecutive chunks of at most `grain`
+// indices covering [`begin`, `end`), on the workers of `thread_pool` and on the
+// calling thread, or only on the calling thread when `thread_pool` is nullptr.
+// Returns once all the chunks are done.
+//
+// Contrary to ParallelForEachItem(), at most one task per worker is scheduled
+// whatever the number of chunks, `f` is not copied, and the calling thread
+// runs chunks instead of waiting: ParallelFor() can thus be called from the
+// tasks of the same pool, e.g. of SharedThreadPool(), without deadlocking.
+void ParallelFor(ThreadPool* thread_pool, int64_t begin, int64_t end,
+                 int64_t grain, absl::FunctionRef<void(int64_t, int64_t)> f);
+
+// A process-wide pool with one worker per hardware thread (see
+// SetSharedThreadPoolNumThreads()), started on first use and never destroyed,
+// which can be shared by the solvers instead of each one starting its own
+// threads. This bounds the number of threads of concurrent solves.
+ThreadPool* SharedThreadPool();
+
+// Sets the number of workers of SharedThreadPool(). Returns false, and does
+// nothing, if the shared pool was already created.
+bool SetSharedThreadPoolNumThreads(int num_threads);
+
 }  // namespace operations_research
 #endif  // OR_TOOLS_BASE_THREADPOOL_H_
@@ -205,15 +205,17 @@ template class BacktrackableIntegerSet<ConstraintIndex>;
 AssignmentAndConstraintFeasibilityMaintainer::
     AssignmentAndConstraintFeasibilityMaintainer(
         const LinearBooleanProblem& problem, absl::BitGenRef random)
-    : by_variable_matrix_(problem.num_variables()),
-      constraint_lower_bounds_(),
-      constraint_upper_bounds_(),
+    : by_variable_matrix_(),
+      column_starts_(),
       assignment_(problem, "Assignment"),
       reference_(problem, "Assignment"),
-      constraint_values_(),
+      constraints_(),
       flipped_var_trail_backtrack_levels_(),
       flipped_var_trail_(),
       constraint_set_hasher_(random) {
+  absl::StrongVector<VariableIndex, std::vector<ConstraintEntry>> columns(
+      problem.num_variables());
+
   // Add the objective constraint as the first constraint.
   const LinearObjective& objective = problem.objective();
   CHECK_EQ(objective.literals_size(), objective.coefficients_size());
@@ -223,12 +225,11 @@ AssignmentAndConstraintFeasibilityMaintainer::
 
     const VariableIndex var(objective.literals(i) - 1);
     const int64_t weight = objective.coefficients(i);
-    by_variable_matrix_[var].push_back(
-        ConstraintEntry(kObjectiveConstraint, weight));
+    columns[var].push_back(ConstraintEntry(kObjectiveConstraint, weight));
   }
-  constraint_lower_bounds_.push_back(std::numeric_limits<int64_t>::min());
-  constraint_values_.push_back(0);
-  constraint_upper_bounds_.push_back(std::numeric_limits<int64_t>::max());
+  constraints_.push_back({.lower_bound = std::numeric_limits<int64_t>::min(),
+                          .value = 0,
+                          .upper_bound = std::numeric_limits<int64_t>::max()});
 
   // Add each constraint.
   ConstraintIndex num_constraints_with_objective(1);
@@ -244,26 +245,38 @@ AssignmentAndConstraintFeasibilityMaintainer::
     for (int i = 0; i < constraint.literals_size(); ++i) {
       const VariableIndex var(constraint.literals(i) - 1);
       const int64_t weight = constraint.coefficients(i);
-      by_variable_matrix_[var].push_back(
+      columns[var].push_back(
           ConstraintEntry(num_constraints_with_objective, weight));
     }
-    constraint_lower_bounds_.push_back(
-        constraint.has_lower_bound() ? constraint.lower_bound()
-                                     : std::numeric_limits<int64_t>::min());
-    constraint_values_.push_back(0);
-    constraint_upper_bounds_.push_back(
-        constraint.has_upper_bound() ? constraint.upper_bound()
-                                     : std::numeric_limits<int64_t>::max());
+    constraints_.push_back(
+        {.lower_bound = constraint.has_lower_bound()
+                            ? constraint.lower_bound()
+                            : std::numeric_limits<int64_t>::min(),
+         .value = 0,
+         .upper_bound = constraint.has_upper_bound()
+                            ? constraint.upper_bound()
+                            : std::numeric_limits<int64_t>::max()});
 
     ++num_constraints_with_objective;
   }
 
+  // Pack the columns.
+  int num_entries = 0;
+  for (const std::vector<ConstraintEntry>& column : columns) {
+    num_entries += column.size();
+  }
+  by_variable_matrix_.reserve(num_entries);
+  column_starts_.reserve(columns.size() + 1);
+  for (const std::vector<ConstraintEntry>& column : columns) {
+    column_starts_.push_back(by_variable_matrix_.size());
+    by_variable_matrix_.insert(by_variable_matrix_.end(), column.begin(),
+                               column.end());
+  }
+  column_starts_.push_back(by_variable_matrix_.size());
+
   // Initialize infeasible_constraint_set_;
   infeasible_constraint_set_.ClearAndResize(
-      ConstraintIndex(constraint_values_.size()));
-
-  CHECK_EQ(constraint_values_.size(), constraint_lower_bounds_.size());
-  CHECK_EQ(constraint_values_.size(), constraint_upper_bounds_.size());
+      ConstraintIndex(constraints_.size()));
 }
 
 const ConstraintIndex
@@ -281,11 +294,13 @@ void AssignmentAndConstraintFeasibilityMaintainer::SetReferenceSolution(
   AddBacktrackingLevel();  // To handle initial propagation.
 
   // Recompute the value of all constraints.
-  constraint_values_.assign(NumConstraints(), 0);
+  for (ConstraintState& constraint : constraints_) {
+    constraint.value = 0;
+  }
   for (VariableIndex var(0); var < assignment_.Size(); ++var) {
     if (assignment_.Value(var)) {
-      for (const ConstraintEntry& entry : by_variable_matrix_[var]) {
-        constraint_values_[entry.constraint] += entry.weight;
+      for (const ConstraintEntry& entry : Column(var)) {
+        constraints_[entry.constraint].value += entry.weight;
       }
     }
   }
@@ -308,8 +323,8 @@ void AssignmentAndConstraintFeasibilityMaintainer::
     MakeObjectiveConstraintInfeasible(int delta) {
   CHECK(IsFeasible());
   CHECK(flipped_var_trail_.empty());
-  constraint_upper_bounds_[kObjectiveConstraint] =
-      constraint_values_[kObjectiveConstraint] - delta;
+  constraints_[kObjectiveConstraint].upper_bound =
+      constraints_[kObjectiveConstraint].value - delta;
   infeasible_constraint_set_.BacktrackAll();
   infeasible_constraint_set_.ChangeState(kObjectiveConstraint, true);
   infeasible_constraint_set_.AddBacktrackingLevel();
@@ -330,11 +345,11 @@ void AssignmentAndConstraintFeasibilityMaintainer::Assign(
     if (assignment_.Value(var) != value) {
       flipped_var_trail_.push_back(var);
       assignment_.SetValue(var, value);
-      for (const ConstraintEntry& entry : by_variable_matrix_[var]) {
-        const bool was_feasible = ConstraintIsFeasible(entry.constraint);
-        constraint_values_[entry.constraint] +=
-            value ? entry.weight : -entry.weight;
-        if (ConstraintIsFeasible(entry.constraint) != was_feasible) {
+      for (const ConstraintEntry& entry : Column(var)) {
+        ConstraintState& constraint = constraints_[entry.constraint];
+        const bool was_feasible = constraint.IsFeasible();
+        constraint.value += value ? entry.weight : -entry.weight;
+        if (constraint.IsFeasible() != was_feasible) {
           infeasible_constraint_set_.ChangeState(entry.constraint,
                                                  was_feasible);
         }
@@ -356,8 +371,8 @@ void AssignmentAndConstraintFeasibilityMaintainer::BacktrackOneLevel() {
     const bool new_value = !assignment_.Value(var);
     DCHECK_EQ(new_value, reference_.Value(var));
     assignment_.SetValue(var, new_value);
-    for (const ConstraintEntry& entry : by_variable_matrix_[var]) {
-      constraint_values_[entry.constraint] +=
+    for (const ConstraintEntry& entry : Column(var)) {
+      constraints_[entry.constraint].value +=
           new_value ? entry.weight : -entry.weight;
     }
   }
@@ -417,14 +432,12 @@ std::string AssignmentAndConstraintFeasibilityMaintainer::DebugString() const {
     str += absl::StrFormat(" %d", var.value());
   }
   str += "\nmin  curr  max\n";
-  for (ConstraintIndex ct(0); ct < constraint_values_.size(); ++ct) {
-    if (constraint_lower_bounds_[ct] == std::numeric_limits<int64_t>::min()) {
-      str += absl::StrFormat("-  %d  %d\n", constraint_values_[ct],
-                             constraint_upper_bounds_[ct]);
+  for (const ConstraintState& ct : constraints_) {
+    if (ct.lower_bound == std::numeric_limits<int64_t>::min()) {
+      str += absl::StrFormat("-  %d  %d\n", ct.value, ct.upper_bound);
     } else {
-      str +=
-          absl::StrFormat("%d  %d  %d\n", constraint_lower_bounds_[ct],
-                          constraint_values_[ct], constraint_upper_bounds_[ct]);
+      str += absl::StrFormat("%d  %d  %d\n", ct.lower_bound, ct.value,
+                             ct.upper_bound);
     }
   }
   return str;
@@ -432,7 +445,7 @@ std::string AssignmentAndConstraintFeasibilityMaintainer::DebugString() const {
 
 void AssignmentAndConstraintFeasibilityMaintainer::
     InitializeConstraintSetHasher() {
-  const int num_constraints_with_objective = constraint_upper_bounds_.size();
+  const int num_constraints_with_objective = constraints_.size();
 
   // Initialize the potential one flip repair. Note that we ignore the
   // objective constraint completely so that we consider a repair even if the
@@ -442,12 +455,12 @@ void AssignmentAndConstraintFeasibilityMaintainer::
       FromConstraintIndex(kObjectiveConstraint, true));
   constraint_set_hasher_.IgnoreElement(
       FromConstraintIndex(kObjectiveConstraint, false));
-  for (VariableIndex var(0); var < by_variable_matrix_.size(); ++var) {
+  for (VariableIndex var(0); var + 1 < column_starts_.size(); ++var) {
     // We add two entries, one for a positive flip (from false to true) and one
     // for a negative flip (from true to false).
     for (const bool flip_is_positive : {true, false}) {
       uint64_t hash = 0;
-      for (const ConstraintEntry& entry : by_variable_matrix_[var]) {
+      for (const ConstraintEntry& entry : Column(var)) {
         const bool coeff_is_positive = entry.weight > 0;
         hash ^= constraint_set_hasher_.Hash(FromConstraintIndex(
             entry.constraint,
@@ -349,7 +349,7 @@ class AssignmentAndConstraintFeasibilityMaintainer {
 
   // Returns the number of constraints of the problem, objective included,
   // i.e. the number of constraint in the problem + 1.
-  size_t NumConstraints() const { return constraint_lower_bounds_.size(); }
+  size_t NumConstraints() const { return constraints_.size(); }
 
   // Returns the value of the var in the assignment.
   // As the assignment is initialized with the reference solution, if the
@@ -362,26 +362,24 @@ class AssignmentAndConstraintFeasibilityMaintainer {
 
   // Returns the lower bound of the constraint.
   int64_t ConstraintLowerBound(ConstraintIndex constraint) const {
-    return constraint_lower_bounds_[constraint];
+    return constraints_[constraint].lower_bound;
   }
 
   // Returns the upper bound of the constraint.
   int64_t ConstraintUpperBound(ConstraintIndex constraint) const {
-    return constraint_upper_bounds_[constraint];
+    return constraints_[constraint].upper_bound;
   }
 
   // Returns the value of the constraint. The value is computed using the
   // variable values in the assignment. Note that a constraint is feasible iff
   // its value is between its two bounds (inclusive).
   int64_t ConstraintValue(ConstraintIndex constraint) const {
-    return constraint_values_[constraint];
+    return constraints_[constraint].value;
   }
 
   // Returns true if the given constraint is currently feasible.
   bool ConstraintIsFeasible(ConstraintIndex constraint) const {
-    const int64_t value = ConstraintValue(constraint);
-    return value >= ConstraintLowerBound(constraint) &&
-           value <= ConstraintUpperBound(constraint);
+    return constraints_[constraint].IsFeasible();
   }
 
   std::string DebugString() const;
@@ -413,16 +411,34 @@ class AssignmentAndConstraintFeasibilityMaintainer {
     int64_t weight;
   };
 
-  absl::StrongVector<VariableIndex,
-                     absl::StrongVector<EntryIndex, ConstraintEntry>>
-      by_variable_matrix_;
-  absl::StrongVector<ConstraintIndex, int64_t> constraint_lower_bounds_;
-  absl::StrongVector<ConstraintIndex, int64_t> constraint_upper_bounds_;
+  // The bounds and the current value of a constraint, stored together so that
+  // a flip only touches one cache line per constraint of the variable.
+  struct ConstraintState {
+    bool IsFeasible() const {
+      return value >= lower_bound && value <= upper_bound;
+    }
+    int64_t lower_bound;
+    int64_t value;
+    int64_t upper_bound;
+  };
+
+  // The entries of the variable `var`.
+  absl::Span<const ConstraintEntry> Column(VariableIndex var) const {
+    return absl::MakeConstSpan(by_variable_matrix_)
+        .subspan(column_starts_[var],
+                 column_starts_[var + 1] - column_starts_[var]);
+  }
+
+  // The matrix of the constraints by variable, packed in a single vector: the
+  // entries of the variable `var` are in [column_starts_[var],
+  // column_starts_[var + 1]).
+  std::vector<ConstraintEntry> by_variable_matrix_;
+  absl::StrongVector<VariableIndex, int> column_starts_;
 
   BopSolution assignment_;
   BopSolution reference_;
 
-  absl::StrongVector<ConstraintIndex, int64_t> constraint_values_;
+  absl::StrongVector<ConstraintIndex, ConstraintState> constraints_;
   BacktrackableIntegerSet<ConstraintIndex> infeasible_constraint_set_;
 
   // This contains the list of variable flipped in assignment_.
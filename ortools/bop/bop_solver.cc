@@ -13,6 +13,8 @@
 
 #include "ortools/bop/bop_solver.h"
 
+#include <algorithm>
+#include <atomic>
 #include <cstdlib>
 #include <memory>
 #include <string>
@@ -20,7 +22,10 @@
 
 #include "absl/log/check.h"
 #include "absl/status/status.h"
+#include "absl/strings/str_cat.h"
 #include "absl/strings/str_format.h"
+#include "absl/synchronization/blocking_counter.h"
+#include "absl/synchronization/mutex.h"
 #include "google/protobuf/text_format.h"
 #include "ortools/base/logging.h"
 #include "ortools/base/threadpool.h"
@@ -140,8 +145,129 @@ BopSolveStatus BopSolver::InternalMonothreadSolver(TimeLimit* time_limit) {
 
 BopSolveStatus BopSolver::InternalMultithreadSolver(TimeLimit* time_limit) {
   CHECK(time_limit != nullptr);
-  // Not implemented.
-  return BopSolveStatus::INVALID_PROBLEM;
+  const int num_solvers = parameters_.number_of_solvers();
+  const BopParameters::ThreadSynchronizationType synchronization_type =
+      parameters_.synchronization_type();
+
+  // Each solver runs its own portfolio on its own ProblemState, and merges
+  // what it learns in problem_state_, which is shared by all the solvers and
+  // guarded by `mutex`. Depending on the synchronization type, the solvers
+  // then wait for the other ones to finish the same number of optimizer runs,
+  // and update their state from problem_state_.
+  absl::Mutex mutex;
+  std::vector<int> num_runs(num_solvers, 0);    // Guarded by `mutex`.
+  std::vector<bool> finished(num_solvers, false);  // Guarded by `mutex`.
+  std::atomic<bool> stop = false;
+
+  // The time limits of the solvers, created here as time_limit is not
+  // thread-safe.
+  std::vector<std::unique_ptr<TimeLimit>> solver_time_limits;
+  for (int i = 0; i < num_solvers; ++i) {
+    solver_time_limits.push_back(std::make_unique<TimeLimit>(
+        time_limit->GetTimeLeft(), time_limit->GetDeterministicTimeLeft()));
+    solver_time_limits.back()->RegisterExternalBooleanAsLimit(
+        time_limit->ExternalBooleanAsLimit());
+    solver_time_limits.back()->RegisterSecondaryExternalBooleanAsLimit(&stop);
+  }
+
+  const auto run_solver = [&](const int solver_index) {
+    TimeLimit* const solver_time_limit = solver_time_limits[solver_index].get();
+    BopParameters parameters = parameters_;
+    parameters.set_random_seed(parameters_.random_seed() + solver_index);
+    ProblemState problem_state(problem_);
+    problem_state.SetParameters(parameters);
+    {
+      const absl::MutexLock lock(&mutex);
+      problem_state.set_assignment_preference(
+          problem_state_.assignment_preference());
+      problem_state.MergeLearnedInfo(problem_state_.GetLearnedInfo(),
+                                     BopOptimizerBase::CONTINUE);
+    }
+    PortfolioOptimizer optimizer(
+        problem_state, parameters,
+        parameters.solver_optimizer_sets(std::min(
+            solver_index, parameters.solver_optimizer_sets_size() - 1)),
+        absl::StrCat("Portfolio_", solver_index));
+    LearnedInfo learned_info(problem_state.original_problem());
+    const int num_solvers_to_wait_for =
+        synchronization_type == BopParameters::SYNCHRONIZE_ALL ? num_solvers
+        : synchronization_type == BopParameters::SYNCHRONIZE_ON_RIGHT
+            ? solver_index
+            : 0;
+    for (int run = 1; !solver_time_limit->LimitReached(); ++run) {
+      const BopOptimizerBase::Status optimization_status = optimizer.Optimize(
+          parameters, problem_state, &learned_info, solver_time_limit);
+      problem_state.MergeLearnedInfo(learned_info, optimization_status);
+
+      const absl::MutexLock lock(&mutex);
+      // A solver may only prove its state infeasible when it has no feasible
+      // solution, which another solver may have found since.
+      problem_state_.MergeLearnedInfo(
+          learned_info,
+          optimization_status == BopOptimizerBase::INFEASIBLE &&
+                  problem_state_.solution().IsFeasible()
+              ? BopOptimizerBase::CONTINUE
+              : optimization_status);
+      learned_info.Clear();
+      if (optimization_status == BopOptimizerBase::SOLUTION_FOUND) {
+        VLOG(1) << problem_state_.solution().GetScaledCost()
+                << "  New solution! (solver " << solver_index << ")";
+      }
+      if (problem_state_.IsOptimal() || problem_state_.IsInfeasible()) {
+        stop = true;
+      }
+      if (stop || optimization_status == BopOptimizerBase::ABORT) break;
+
+      num_runs[solver_index] = run;
+      if (num_solvers_to_wait_for > 0) {
+        const auto others_are_done = [&]() {
+          if (stop) return true;
+          for (int i = 0; i < num_solvers_to_wait_for; ++i) {
+            if (!finished[i] && num_runs[i] < run) return false;
+          }
+          return true;
+        };
+        mutex.Await(absl::Condition(&others_are_done));
+        problem_state.MergeLearnedInfo(problem_state_.GetLearnedInfo(),
+                                       BopOptimizerBase::CONTINUE);
+      }
+    }
+    const absl::MutexLock lock(&mutex);
+    finished[solver_index] = true;
+  };
+
+  {
+    ThreadPool pool(num_solvers - 1);
+    pool.StartWorkers();
+    absl::BlockingCounter solvers_done(num_solvers - 1);
+    for (int i = 1; i < num_solvers; ++i) {
+      pool.Schedule([&, i]() {
+        run_solver(i);
+        solvers_done.DecrementCount();
+      });
+    }
+    run_solver(0);
+    solvers_done.Wait();
+  }
+
+  double max_deterministic_time = 0.0;
+  for (const std::unique_ptr<TimeLimit>& solver_time_limit :
+       solver_time_limits) {
+    max_deterministic_time =
+        std::max(max_deterministic_time,
+                 solver_time_limit->GetElapsedDeterministicTime());
+  }
+  time_limit->AdvanceDeterministicTime(max_deterministic_time);
+
+  if (problem_state_.IsOptimal()) {
+    CHECK(problem_state_.solution().IsFeasible());
+    return BopSolveStatus::OPTIMAL_SOLUTION_FOUND;
+  } else if (problem_state_.IsInfeasible()) {
+    return BopSolveStatus::INFEASIBLE_PROBLEM;
+  }
+  return problem_state_.solution().IsFeasible()
+             ? BopSolveStatus::FEASIBLE_SOLUTION_FOUND
+             : BopSolveStatus::NO_SOLUTION_FOUND;
 }
 
 BopSolveStatus BopSolver::Solve(const BopSolution& first_solution) {
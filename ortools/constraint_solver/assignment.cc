@@ -13,6 +13,7 @@
 
 #include <stddef.h>
 
+#include <algorithm>
 #include <cstdint>
 #include <limits>
 #include <ostream>
@@ -610,6 +611,169 @@ void Assignment::Save(AssignmentProto* const assignment_proto) const {
   }
 }
 
+void Assignment::Save(
+    PackedAssignmentProto* const packed_assignment_proto) const {
+  packed_assignment_proto->Clear();
+  const int num_int_vars = int_var_container_.Size();
+  packed_assignment_proto->mutable_int_var_index()->Reserve(num_int_vars);
+  packed_assignment_proto->mutable_int_var_min()->Reserve(num_int_vars);
+  packed_assignment_proto->mutable_int_var_range_size()->Reserve(num_int_vars);
+  packed_assignment_proto->mutable_int_var_active()->Reserve(num_int_vars);
+  for (const IntVarElement& element : int_var_container_.elements()) {
+    packed_assignment_proto->add_int_var_index(element.Var()->index());
+    packed_assignment_proto->add_int_var_min(element.Min());
+    // Unsigned arithmetic avoids overflows on wide domains.
+    packed_assignment_proto->add_int_var_range_size(
+        static_cast<uint64_t>(element.Max()) -
+        static_cast<uint64_t>(element.Min()));
+    packed_assignment_proto->add_int_var_active(element.Activated());
+  }
+  const int num_interval_vars = interval_var_container_.Size();
+  packed_assignment_proto->mutable_interval_var_bounds()->Reserve(
+      8 * num_interval_vars);
+  packed_assignment_proto->mutable_interval_var_active()->Reserve(
+      num_interval_vars);
+  for (const IntervalVarElement& element : interval_var_container_.elements()) {
+    for (const int64_t bound :
+         {element.StartMin(), element.StartMax(), element.DurationMin(),
+          element.DurationMax(), element.EndMin(), element.EndMax(),
+          element.PerformedMin(), element.PerformedMax()}) {
+      packed_assignment_proto->add_interval_var_bounds(bound);
+    }
+    packed_assignment_proto->add_interval_var_active(element.Activated());
+  }
+  for (const SequenceVarElement& element : sequence_var_container_.elements()) {
+    for (const std::vector<int>* values :
+         {&element.ForwardSequence(), &element.BackwardSequence(),
+          &element.Unperformed()}) {
+      packed_assignment_proto->add_sequence_var_sizes(values->size());
+      packed_assignment_proto->mutable_sequence_var_values()->Add(
+          values->begin(), values->end());
+    }
+    packed_assignment_proto->add_sequence_var_active(element.Activated());
+  }
+  for (int i = 0; i < objective_elements_.size(); ++i) {
+    packed_assignment_proto->add_objective_bounds(ObjectiveMinFromIndex(i));
+    packed_assignment_proto->add_objective_bounds(ObjectiveMaxFromIndex(i));
+    packed_assignment_proto->add_objective_active(
+        ActivatedObjectiveFromIndex(i));
+  }
+}
+
+bool Assignment::Load(const PackedAssignmentProto& packed_assignment_proto) {
+  const PackedAssignmentProto& packed = packed_assignment_proto;
+  const int num_int_vars = packed.int_var_index_size();
+  if (packed.int_var_min_size() != num_int_vars ||
+      packed.int_var_range_size_size() != num_int_vars ||
+      packed.int_var_active_size() != num_int_vars) {
+    LOG(INFO) << "Inconsistent integer variables in packed assignment";
+    return false;
+  }
+  if (packed.interval_var_active_size() != NumIntervalVars() ||
+      packed.interval_var_bounds_size() != 8 * NumIntervalVars()) {
+    LOG(INFO) << "Packed assignment does not match interval variables";
+    return false;
+  }
+  if (packed.sequence_var_active_size() != NumSequenceVars() ||
+      packed.sequence_var_sizes_size() != 3 * NumSequenceVars()) {
+    LOG(INFO) << "Packed assignment does not match sequence variables";
+    return false;
+  }
+  int64_t num_sequence_values = 0;
+  for (const int size : packed.sequence_var_sizes()) {
+    if (size < 0) return false;
+    num_sequence_values += size;
+  }
+  if (num_sequence_values != packed.sequence_var_values_size() ||
+      packed.objective_bounds_size() != 2 * packed.objective_active_size()) {
+    LOG(INFO) << "Inconsistent packed assignment";
+    return false;
+  }
+
+  // Integer variables: when the variables are the same, in the same order, as
+  // when the assignment was saved, which is the common case, elements are
+  // loaded by position, without any lookup.
+  const auto load_int_var = [&packed](int i, IntVarElement* element) {
+    const int64_t min = packed.int_var_min(i);
+    element->SetRange(min, static_cast<int64_t>(static_cast<uint64_t>(min) +
+                                                packed.int_var_range_size(i)));
+    if (packed.int_var_active(i)) {
+      element->Activate();
+    } else {
+      element->Deactivate();
+    }
+  };
+  bool load_by_position = num_int_vars == NumIntVars();
+  for (int i = 0; load_by_position && i < num_int_vars; ++i) {
+    load_by_position =
+        int_var_container_.Element(i).Var()->index() == packed.int_var_index(i);
+  }
+  if (load_by_position) {
+    for (int i = 0; i < num_int_vars; ++i) {
+      load_int_var(i, int_var_container_.MutableElement(i));
+    }
+  } else {
+    absl::flat_hash_map<int, int> index_to_position;
+    index_to_position.reserve(NumIntVars());
+    for (int i = 0; i < NumIntVars(); ++i) {
+      index_to_position[int_var_container_.Element(i).Var()->index()] = i;
+    }
+    for (int i = 0; i < num_int_vars; ++i) {
+      const int position =
+          gtl::FindWithDefault(index_to_position, packed.int_var_index(i), -1);
+      if (position >= 0) {
+        load_int_var(i, int_var_container_.MutableElement(position));
+      }
+    }
+  }
+
+  for (int i = 0; i < NumIntervalVars(); ++i) {
+    IntervalVarElement* const element =
+        interval_var_container_.MutableElement(i);
+    const int64_t* const bounds = packed.interval_var_bounds().data() + 8 * i;
+    element->SetStartRange(bounds[0], bounds[1]);
+    element->SetDurationRange(bounds[2], bounds[3]);
+    element->SetEndRange(bounds[4], bounds[5]);
+    element->SetPerformedRange(bounds[6], bounds[7]);
+    if (packed.interval_var_active(i)) {
+      element->Activate();
+    } else {
+      element->Deactivate();
+    }
+  }
+
+  const int32_t* values = packed.sequence_var_values().data();
+  std::vector<int> sequences[3];
+  for (int i = 0; i < NumSequenceVars(); ++i) {
+    for (int j = 0; j < 3; ++j) {
+      const int size = packed.sequence_var_sizes(3 * i + j);
+      sequences[j].assign(values, values + size);
+      values += size;
+    }
+    SequenceVarElement* const element =
+        sequence_var_container_.MutableElement(i);
+    element->SetSequence(sequences[0], sequences[1], sequences[2]);
+    if (packed.sequence_var_active(i)) {
+      element->Activate();
+    } else {
+      element->Deactivate();
+    }
+  }
+
+  const int num_objectives =
+      std::min<int>(NumObjectives(), packed.objective_active_size());
+  for (int i = 0; i < num_objectives; ++i) {
+    SetObjectiveRangeFromIndex(i, packed.objective_bounds(2 * i),
+                               packed.objective_bounds(2 * i + 1));
+    if (packed.objective_active(i)) {
+      ActivateObjectiveFromIndex(i);
+    } else {
+      DeactivateObjectiveFromIndex(i);
+    }
+  }
+  return true;
+}
+
 template <class Container, class Element>
 void RealDebugString(const Container& container, std::string* const out) {
   for (const Element& element : container.elements()) {
@@ -19,8 +19,8 @@
 
 #include <algorithm>
 #include <csetjmp>
+#include <cstddef>
 #include <cstdint>
-#include <deque>
 #include <iosfwd>
 #include <limits>
 #include <memory>
@@ -223,6 +223,49 @@ void Demon::desinhibit(Solver* const s) {
 
 extern void CleanVariableOnFail(IntVar* var);
 
+namespace {
+// A FIFO of demons stored in a ring buffer, whose capacity is a power of
+// two. Unlike a std::deque, it keeps its memory once it has grown, so pushing
+// and popping demons never allocates in steady state, and it is cleared in
+// constant time after a failure.
+class DemonQueue {
+ public:
+  bool empty() const { return head_ == tail_; }
+
+  void clear() { head_ = tail_ = 0; }
+
+  void push_back(Demon* const demon) {
+    if (tail_ - head_ == buffer_.size()) Grow();
+    buffer_[tail_++ & mask_] = demon;
+  }
+
+  Demon* pop_front() {
+    DCHECK(!empty());
+    return buffer_[head_++ & mask_];
+  }
+
+ private:
+  void Grow() {
+    const size_t size = tail_ - head_;
+    std::vector<Demon*> buffer(std::max<size_t>(16, 2 * buffer_.size()));
+    for (size_t i = 0; i < size; ++i) {
+      buffer[i] = buffer_[(head_ + i) & mask_];
+    }
+    buffer_ = std::move(buffer);
+    mask_ = buffer_.size() - 1;
+    head_ = 0;
+    tail_ = size;
+  }
+
+  std::vector<Demon*> buffer_;
+  size_t mask_ = 0;
+  // The demons of the queue are the ones at positions [head_, tail_), modulo
+  // the capacity of the buffer.
+  size_t head_ = 0;
+  size_t tail_ = 0;
+};
+}  // namespace
+
 class Queue {
  public:
   static constexpr int64_t kTestPeriod = 10000;
@@ -273,15 +316,13 @@ class Queue {
     if (!in_process_) {
       in_process_ = true;
       while (!var_queue_.empty() || !delayed_queue_.empty()) {
-        if (!var_queue_.empty()) {
-          Demon* const demon = var_queue_.front();
-          var_queue_.pop_front();
-          ProcessOneDemon(demon);
-        } else {
-          DCHECK(!delayed_queue_.empty());
-          Demon* const demon = delayed_queue_.front();
-          delayed_queue_.pop_front();
-          ProcessOneDemon(demon);
+        // Variable demons are processed in batches: a delayed demon only
+        // runs once the variable queue is empty.
+        while (!var_queue_.empty()) {
+          ProcessOneDemon(var_queue_.pop_front());
+        }
+        if (!delayed_queue_.empty()) {
+          ProcessOneDemon(delayed_queue_.pop_front());
         }
       }
       in_process_ = false;
@@ -407,8 +448,8 @@ class Queue {
 
  private:
   Solver* const solver_;
-  std::deque<Demon*> var_queue_;
-  std::deque<Demon*> delayed_queue_;
+  DemonQueue var_queue_;
+  DemonQueue delayed_queue_;
   uint64_t stamp_;
   // The number of nested freeze levels. The queue is frozen if and only if
   // freeze_level_ > 0.
@@ -421,6 +462,70 @@ class Queue {
   const bool instruments_demons_;
 };
 
+namespace {
+// ----- RevArena -----
+
+// A bump allocator for the memory of Solver::UnsafeRevNew(). The memory
+// allocated since a given position is reclaimed at once by resetting the
+// arena to that position, its blocks being kept for the next allocations and
+// only freed with the arena.
+class RevArena {
+ public:
+  // The position of the next allocation.
+  struct Position {
+    int block = 0;
+    size_t offset = 0;
+  };
+
+  RevArena() = default;
+
+  // This type is neither copyable nor movable.
+  RevArena(const RevArena&) = delete;
+  RevArena& operator=(const RevArena&) = delete;
+
+  void* Allocate(size_t size, size_t alignment) {
+    DCHECK_LE(alignment, alignof(std::max_align_t));
+    DCHECK_EQ(alignment & (alignment - 1), 0);
+    while (true) {
+      if (position_.block < static_cast<int>(blocks_.size())) {
+        Block& block = blocks_[position_.block];
+        const size_t offset =
+            (position_.offset + alignment - 1) & ~(alignment - 1);
+        if (offset + size <= block.size) {
+          position_.offset = offset + size;
+          return block.data.get() + offset;
+        }
+        ++position_.block;
+        position_.offset = 0;
+      } else {
+        const size_t block_size = std::max(kBlockSize, size);
+        blocks_.push_back({std::make_unique<char[]>(block_size), block_size});
+      }
+    }
+  }
+
+  Position position() const { return position_; }
+
+  void ResetTo(Position position) {
+    DCHECK(position.block < position_.block ||
+           (position.block == position_.block &&
+            position.offset <= position_.offset));
+    position_ = position;
+  }
+
+ private:
+  static constexpr size_t kBlockSize = 64 << 10;
+
+  struct Block {
+    std::unique_ptr<char[]> data;
+    size_t size;
+  };
+
+  std::vector<Block> blocks_;
+  Position position_;
+};
+}  // namespace
+
 // ------------------ StateMarker / StateInfo struct -----------
 
 struct StateInfo {  // This is an internal structure to store
@@ -480,6 +585,7 @@ struct StateMarker {
   int rev_object_array_memory_index_;
   int rev_memory_index_;
   int rev_memory_array_index_;
+  RevArena::Position rev_arena_position_;
   StateInfo info_;
 };
 
@@ -754,6 +860,7 @@ struct Trail {
   std::vector<BaseObject**> rev_object_array_memory_;
   std::vector<void*> rev_memory_;
   std::vector<void**> rev_memory_array_;
+  RevArena rev_arena_;
 
   Trail(int block_size,
         ConstraintSolverParameters::TrailCompression compression_level)
@@ -868,6 +975,8 @@ struct Trail {
       // delete [] version of the previous unsafe case.
     }
     rev_memory_array_.resize(target);
+
+    rev_arena_.ResetTo(m->rev_arena_position_);
   }
 };
 
@@ -962,6 +1071,11 @@ void** Solver::UnsafeRevAllocArrayAux(void** ptr) {
   return ptr;
 }
 
+void* Solver::UnsafeRevArenaAllocAux(size_t size, size_t alignment) {
+  check_alloc_state();
+  return trail_->rev_arena_.Allocate(size, alignment);
+}
+
 void InternalSaveBooleanVarValue(Solver* const solver, IntVar* const var) {
   solver->trail_->rev_boolvar_list_.push_back(var);
 }
@@ -1614,6 +1728,7 @@ void Solver::PushState(Solver::MarkerType t, const StateInfo& info) {
     m->rev_object_array_memory_index_ = trail_->rev_object_array_memory_.size();
     m->rev_memory_index_ = trail_->rev_memory_.size();
     m->rev_memory_array_index_ = trail_->rev_memory_array_.size();
+    m->rev_arena_position_ = trail_->rev_arena_.position();
   }
   searches_.back()->marker_stack_.push_back(m);
   queue_->increase_stamp();
@@ -74,9 +74,11 @@
 #include <deque>
 #include <functional>
 #include <memory>
+#include <new>
 #include <ostream>
 #include <random>
 #include <string>
+#include <type_traits>
 #include <utility>
 #include <vector>
 
@@ -96,6 +98,7 @@
 #include "ortools/base/map_util.h"
 #include "ortools/base/timer.h"
 #include "ortools/base/types.h"
+#include "ortools/constraint_solver/demon_profiler.pb.h"
 #include "ortools/constraint_solver/search_stats.pb.h"
 #include "ortools/constraint_solver/solver_parameters.pb.h"
 #include "ortools/util/piecewise_linear_function.h"
@@ -142,6 +145,7 @@ class ModelVisitor;
 class ObjectiveMonitor;
 class OptimizeVar;
 class Pack;
+class PackedAssignmentProto;
 class ProfiledDecisionBuilder;
 class PropagationBaseObject;
 class PropagationMonitor;
@@ -2722,11 +2726,11 @@ class Solver {
   /// Local Search Operators.
   LocalSearchOperator* MakeOperator(
       const std::vector<IntVar*>& vars, LocalSearchOperators op,
-      std::function<const std::vector<int>&(int, int)> get_neighbors = nullptr);
+      std::function<absl::Span<const int>(int, int)> get_neighbors = nullptr);
   LocalSearchOperator* MakeOperator(
       const std::vector<IntVar*>& vars,
       const std::vector<IntVar*>& secondary_vars, LocalSearchOperators op,
-      std::function<const std::vector<int>&(int, int)> get_neighbors = nullptr);
+      std::function<absl::Span<const int>(int, int)> get_neighbors = nullptr);
   // TODO(user): Make the callback an IndexEvaluator2 when there are no
   // secondary variables.
   LocalSearchOperator* MakeOperator(const std::vector<IntVar*>& vars,
@@ -3003,6 +3007,10 @@ class Solver {
   ConstraintSolverStatistics GetConstraintSolverStatistics() const;
   /// Returns detailed local search statistics.
   LocalSearchStatistics GetLocalSearchStatistics() const;
+  /// Returns the runs of the demons aggregated by class, by decreasing total
+  /// runtime. The parameter profile_level used to create the solver must be
+  /// set to true, otherwise the result is empty.
+  std::vector<DemonClassRuns> GetDemonClassRuns() const;
 #endif  // !defined(SWIG)
 
   /// Returns true whether the current search has been
@@ -3199,6 +3207,18 @@ class Solver {
     return reinterpret_cast<T**>(
         UnsafeRevAllocArrayAux(reinterpret_cast<void**>(ptr)));
   }
+  /// Like UnsafeRevAlloc(new T(args...)), but allocates the object in an arena
+  /// owned by the solver: its memory is reclaimed in bulk on backtrack, by
+  /// resetting the position of the arena, and the arena is freed with the
+  /// solver. As the object is never destroyed, T must be trivially
+  /// destructible.
+  void* UnsafeRevArenaAllocAux(size_t size, size_t alignment);
+  template <class T, class... Args>
+  T* UnsafeRevNew(Args&&... args) {
+    static_assert(std::is_trivially_destructible_v<T>);
+    return new (UnsafeRevArenaAllocAux(sizeof(T), alignof(T)))
+        T(std::forward<Args>(args)...);
+  }
 
   void InitCachedIntConstants();
   void InitCachedConstraint();
@@ -5416,6 +5436,18 @@ class Assignment : public PropagationBaseObject {
   bool Save(File* file) const;
 #endif  // #if !defined(SWIG)
   void Save(AssignmentProto* assignment_proto) const;
+#if !defined(SWIG)
+  /// Saves the assignment in a compact form, without variable names. This is
+  /// much faster and smaller than AssignmentProto on large models; see
+  /// PackedAssignmentProto for restrictions.
+  void Save(PackedAssignmentProto* packed_assignment_proto) const;
+  /// Loads an assignment saved with Save(PackedAssignmentProto*). Integer
+  /// variables are matched by position when possible, by solver index
+  /// otherwise; intervals and sequences are matched by position. Returns false,
+  /// without modifying the assignment, if the proto is inconsistent or if the
+  /// numbers of intervals or sequences differ.
+  bool Load(const PackedAssignmentProto& packed_assignment_proto);
+#endif  // #if !defined(SWIG)
 
   void AddObjective(IntVar* const v) { AddObjectives({v}); }
   void AddObjectives(const std::vector<IntVar*>& vars) {
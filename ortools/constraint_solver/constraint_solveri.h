@@ -64,6 +64,7 @@
 #include "absl/algorithm/container.h"
 #include "absl/container/flat_hash_map.h"
 #include "absl/strings/str_cat.h"
+#include "absl/types/span.h"
 #include "ortools/base/logging.h"
 #include "ortools/base/strong_int.h"
 #include "ortools/base/strong_vector.h"
@@ -172,7 +173,7 @@ class SimpleRevFIFO {
 
   void Push(Solver* const s, T val) {
     if (pos_.Value() == 0) {
-      Chunk* const chunk = s->UnsafeRevAlloc(new Chunk(chunks_));
+      Chunk* const chunk = s->UnsafeRevNew<Chunk>(chunks_);
       s->SaveAndSetValue(reinterpret_cast<void**>(&chunks_),
                          reinterpret_cast<void*>(chunk));
       pos_.SetValue(s, CHUNK_SIZE - 1);
@@ -1324,7 +1325,7 @@ class PathOperator : public IntVarLocalSearchOperator {
     /// be removed.
     std::function<int(int64_t)> start_empty_path_class;
     /// Callback returning neighbors of a node on a path starting at start_node.
-    std::function<const std::vector<int>&(/*node=*/int, /*start_node=*/int)>
+    std::function<absl::Span<const int>(/*node=*/int, /*start_node=*/int)>
         get_neighbors;
   };
   /// Builds an instance of PathOperator from next and path variables.
@@ -1335,7 +1336,7 @@ class PathOperator : public IntVarLocalSearchOperator {
                const std::vector<IntVar*>& path_vars, int number_of_base_nodes,
                bool skip_locally_optimal_paths, bool accept_path_end_base,
                std::function<int(int64_t)> start_empty_path_class,
-               std::function<const std::vector<int>&(int, int)> get_neighbors)
+               std::function<absl::Span<const int>(int, int)> get_neighbors)
       : PathOperator(next_vars, path_vars,
                      {number_of_base_nodes, skip_locally_optimal_paths,
                       accept_path_end_base, std::move(start_empty_path_class),
@@ -1372,6 +1373,22 @@ class PathOperator : public IntVarLocalSearchOperator {
  protected:
   /// This method should not be overridden. Override MakeNeighbor() instead.
   bool MakeOneNeighbor() override;
+#ifndef SWIG
+  /// The loop of MakeOneNeighbor(), calling "make_neighbor" instead of
+  /// MakeNeighbor() on each position of the base nodes.
+  template <typename MakeNeighborFn>
+  bool MakeOneNeighborWith(const MakeNeighborFn& make_neighbor) {
+    while (IncrementPosition()) {
+      // Need to revert changes here since make_neighbor might have returned
+      // false and have done changes in the previous iteration.
+      RevertChanges(true);
+      if (make_neighbor()) {
+        return true;
+      }
+    }
+    return false;
+  }
+#endif  // SWIG
   /// Called by OnStart() after initializing node information. Should be
   /// overridden instead of OnStart() to avoid calling PathOperator::OnStart
   /// explicitly.
@@ -1683,6 +1700,24 @@ class PathOperator : public IntVarLocalSearchOperator {
   std::vector<int> sibling_alternative_;
 };
 
+#ifndef SWIG
+/// A PathOperator calling Derived::MakeNeighbor() without a virtual call, once
+/// per position of the base nodes, which lets the compiler inline it in the
+/// iteration. Derived must be final and define "bool MakeNeighbor() override".
+template <class Derived>
+class SpecializedPathOperator : public PathOperator {
+ public:
+  using PathOperator::PathOperator;
+
+ protected:
+  bool MakeOneNeighbor() final {
+    Derived* const derived = static_cast<Derived*>(this);
+    return MakeOneNeighborWith(
+        [derived]() { return derived->Derived::MakeNeighbor(); });
+  }
+};
+#endif  // SWIG
+
 /// Operator Factories.
 template <class T>
 LocalSearchOperator* MakeLocalSearchOperator(
@@ -1695,7 +1730,7 @@ LocalSearchOperator* MakeLocalSearchOperatorWithNeighbors(
     Solver* solver, const std::vector<IntVar*>& vars,
     const std::vector<IntVar*>& secondary_vars,
     std::function<int(int64_t)> start_empty_path_class,
-    std::function<const std::vector<int>&(int, int)> get_neighbors);
+    std::function<absl::Span<const int>(int, int)> get_neighbors);
 
 /// Classes to which this template function can be applied to as of 04/2014.
 /// Usage: LocalSearchOperator* op = MakeLocalSearchOperator<Relocate>(...);
@@ -3746,25 +3781,31 @@ class DimensionChecker {
   // Range intersection query in <O(n log n), O(1)>, with n = #nodes.
   // Let node be in a path, i = index_[node], start the start of node's path.
   // Let l such that index_[start] <= i - 2**l.
-  // - riq_[l][i].tsum_at_lst contains the sum of demands from start to node.
-  // - riq_[l][i].tsum_at_fst contains the sum of demands from start to the
-  //   node at i - 2**l.
+  // - tsum_[i] contains the sum of demands from start to node.
   // - riq_[l][i].tightest_tsum contains the intersection of
-  //   riq_[0][j].tsum_at_lst for all j in (i - 2**l, i].
+  //   tsum_[j] for all j in (i - 2**l, i].
   // - riq_[0][i].cumuls_to_lst and riq_[0][i].cumuls_to_fst contain
   //   the node's capacity.
   // - riq_[l][i].cumuls_to_lst is the intersection, for j in (i - 2**l, i], of
   //   riq_[0][j].cumuls_to_lst + sum_{k in [j, i)} demand(k, k+1)
   // - riq_[l][i].cumuls_to_fst is the intersection, for j in (i - 2**l, i], of
   //   riq_[0][j].cumuls_to_fst - sum_{k in (i-2**l, j)} demand(k, k+1)
+  // The sums at the first and last nodes of a window of riq_[l][i] are
+  // tsum_[i - 2**l + 1] and tsum_[i], so they are not stored in the layers,
+  // which keeps a RIQNode within two cache lines.
   struct RIQNode {
     ExtendedInterval cumuls_to_fst;
     ExtendedInterval tightest_tsum;
     ExtendedInterval cumuls_to_lst;
-    ExtendedInterval tsum_at_fst;
-    ExtendedInterval tsum_at_lst;
   };
   std::vector<std::vector<RIQNode>> riq_;
+  std::vector<ExtendedInterval> tsum_;
+  // prefix_cumul_[i] is the cumul of the node of index i when the path is
+  // unchanged from its start to the node, or an empty interval if the path is
+  // infeasible before the node. Since all the paths of a change start with an
+  // unchanged chain, Check() gets the cumul at the end of the first chain of
+  // each changed path from here.
+  std::vector<ExtendedInterval> prefix_cumul_;
   // The incremental branch of Commit() may waste space in the layers of the
   // RIQ structure. This is the upper limit of a layer's size.
   const int maximum_riq_layer_size_;
@@ -268,6 +268,16 @@ namespace operations_research {
 // Ignored:
 %ignore Assignment::Load;
 %ignore Assignment::Save;
+// Methods:
+%extend Assignment {
+  // Returns the values of the given variables, in a single call.
+  std::vector<int64_t> Values(const std::vector<IntVar*>& vars) const {
+    std::vector<int64_t> values;
+    values.reserve(vars.size());
+    for (const IntVar* const var : vars) values.push_back($self->Value(var));
+    return values;
+  }
+}
 
 // template AssignmentContainer<>
 // Ignored:
@@ -28,6 +28,7 @@
 #include "ortools/base/file.h"
 #include "ortools/base/hash.h"
 #include "ortools/base/helpers.h"
+#include "ortools/base/map_util.h"
 #include "ortools/base/logging.h"
 #include "ortools/base/mathutil.h"
 #include "ortools/base/stl_util.h"
@@ -45,6 +46,13 @@ struct Container {
   const Constraint* ct;
   int64_t value;
 };
+
+// Returns the class of a demon given its debug string, i.e. the identifier
+// preceding its parameters, e.g. "CallMethod_Propagate" for
+// "CallMethod_Propagate(AllDifferent(...))".
+absl::string_view DemonClass(absl::string_view demon_id) {
+  return demon_id.substr(0, demon_id.find('('));
+}
 }  // namespace
 
 // DemonProfiler manages the profiling of demons and allows access to gathered
@@ -61,6 +69,8 @@ class DemonProfiler : public PropagationMonitor {
   ~DemonProfiler() override {
     gtl::STLDeleteContainerPairSecondPointers(constraint_map_.begin(),
                                               constraint_map_.end());
+    gtl::STLDeleteContainerPairSecondPointers(demon_class_runs_.begin(),
+                                              demon_class_runs_.end());
   }
 
   // In microseconds.
@@ -143,6 +153,14 @@ class DemonProfiler : public PropagationMonitor {
       demon_run->set_failures(0);
       demon_map_[demon] = demon_run;
       demons_per_constraint_[active_constraint_].push_back(demon_run);
+      const absl::string_view demon_class = DemonClass(demon_run->demon_id());
+      DemonClassRuns*& class_runs =
+          demon_class_runs_[std::string(demon_class)];
+      if (class_runs == nullptr) {
+        class_runs = new DemonClassRuns;
+        class_runs->set_demon_class(std::string(demon_class));
+      }
+      demon_class_map_[demon] = class_runs;
     }
   }
 
@@ -168,6 +186,7 @@ class DemonProfiler : public PropagationMonitor {
     DemonRuns* const demon_run = demon_map_[active_demon_];
     if (demon_run != nullptr) {
       demon_run->add_end_time(CurrentTime());
+      AddLastRunToDemonClass(*demon_run, /*failed=*/false);
     }
     active_demon_ = nullptr;
   }
@@ -183,6 +202,7 @@ class DemonProfiler : public PropagationMonitor {
       if (demon_run != nullptr) {
         demon_run->add_end_time(CurrentTime());
         demon_run->set_failures(demon_run->failures() + 1);
+        AddLastRunToDemonClass(*demon_run, /*failed=*/true);
       }
       active_demon_ = nullptr;
       // active_constraint_ can be non null in case of initial propagation.
@@ -204,6 +224,10 @@ class DemonProfiler : public PropagationMonitor {
     constraint_map_.clear();
     demon_map_.clear();
     demons_per_constraint_.clear();
+    gtl::STLDeleteContainerPairSecondPointers(demon_class_runs_.begin(),
+                                              demon_class_runs_.end());
+    demon_class_runs_.clear();
+    demon_class_map_.clear();
   }
 
   // IntExpr modifiers.
@@ -266,6 +290,9 @@ class DemonProfiler : public PropagationMonitor {
     const char* const kDemonFormat =
         "  --- Demon: %s\n             invocations=%d, failures=%d, total "
         "runtime=%d us, [average=%.2lf, median=%.2lf, stddev=%.2lf]\n";
+    const char* const kDemonClassFormat =
+        "  - Demon class: %s\n                invocations=%d, failures=%d, "
+        "total runtime=%d us\n";
     File* file;
     const std::string model =
         absl::StrFormat("Model %s:\n", solver->model_name());
@@ -325,6 +352,16 @@ class DemonProfiler : public PropagationMonitor {
           file::WriteString(file, runs, file::Defaults()).IgnoreError();
         }
       }
+      file::WriteString(file, "Demon classes:\n", file::Defaults())
+          .IgnoreError();
+      for (const DemonClassRuns& class_runs : ExportDemonClassRuns()) {
+        const std::string class_message = absl::StrFormat(
+            kDemonClassFormat, class_runs.demon_class(),
+            class_runs.invocations(), class_runs.failures(),
+            class_runs.total_runtime());
+        file::WriteString(file, class_message, file::Defaults())
+            .IgnoreError();
+      }
     }
     file->Close(file::Defaults()).IgnoreError();
   }
@@ -415,6 +452,24 @@ class DemonProfiler : public PropagationMonitor {
     }
   }
 
+  // Returns the runs of the demons aggregated by class, by decreasing total
+  // runtime.
+  std::vector<DemonClassRuns> ExportDemonClassRuns() const {
+    std::vector<DemonClassRuns> class_runs;
+    class_runs.reserve(demon_class_runs_.size());
+    for (const auto& [demon_class, runs] : demon_class_runs_) {
+      class_runs.push_back(*runs);
+    }
+    std::sort(class_runs.begin(), class_runs.end(),
+              [](const DemonClassRuns& a, const DemonClassRuns& b) {
+                if (a.total_runtime() != b.total_runtime()) {
+                  return a.total_runtime() > b.total_runtime();
+                }
+                return a.demon_class() < b.demon_class();
+              });
+    return class_runs;
+  }
+
   // The demon_profiler is added by default on the main propagation
   // monitor.  It just needs to be added to the search monitors at the
   // start of the search.
@@ -423,6 +478,19 @@ class DemonProfiler : public PropagationMonitor {
   std::string DebugString() const override { return "DemonProfiler"; }
 
  private:
+  // Adds the last run of the active demon, whose runs are `demon_run`, to the
+  // runs of its class.
+  void AddLastRunToDemonClass(const DemonRuns& demon_run, bool failed) {
+    DemonClassRuns* const class_runs =
+        gtl::FindPtrOrNull(demon_class_map_, active_demon_);
+    if (class_runs == nullptr || demon_run.start_time().empty()) return;
+    class_runs->set_invocations(class_runs->invocations() + 1);
+    if (failed) class_runs->set_failures(class_runs->failures() + 1);
+    class_runs->set_total_runtime(
+        class_runs->total_runtime() +
+        *demon_run.end_time().rbegin() - *demon_run.start_time().rbegin());
+  }
+
   Constraint* active_constraint_;
   Demon* active_demon_;
   const int64_t start_time_ns_;
@@ -430,6 +498,8 @@ class DemonProfiler : public PropagationMonitor {
   absl::flat_hash_map<const Demon*, DemonRuns*> demon_map_;
   absl::flat_hash_map<const Constraint*, std::vector<DemonRuns*> >
       demons_per_constraint_;
+  absl::flat_hash_map<std::string, DemonClassRuns*> demon_class_runs_;
+  absl::flat_hash_map<const Demon*, DemonClassRuns*> demon_class_map_;
 };
 
 void Solver::ExportProfilingOverview(const std::string& filename) {
@@ -438,6 +508,11 @@ void Solver::ExportProfilingOverview(const std::string& filename) {
   }
 }
 
+std::vector<DemonClassRuns> Solver::GetDemonClassRuns() const {
+  if (demon_profiler_ == nullptr) return {};
+  return demon_profiler_->ExportDemonClassRuns();
+}
+
 // ----- Exported Functions -----
 
 void InstallDemonProfiler(DemonProfiler* monitor) { monitor->Install(); }
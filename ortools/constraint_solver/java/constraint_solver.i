@@ -552,6 +552,17 @@ namespace operations_research {
 %rename (startValue) Assignment::StartValue;
 %rename (store) Assignment::Store;
 %rename (unperformed) Assignment::Unperformed;
+%extend Assignment {
+  /**
+   * Returns the values of the given variables, in a single call.
+   */
+  std::vector<int64_t> values(const std::vector<IntVar*>& vars) const {
+    std::vector<int64_t> values;
+    values.reserve(vars.size());
+    for (const IntVar* const var : vars) values.push_back($self->Value(var));
+    return values;
+  }
+}
 
 // template AssignmentContainer<>
 %ignore AssignmentContainer::MutableElementOrNull;
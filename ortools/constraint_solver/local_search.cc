@@ -48,6 +48,7 @@
 #include "ortools/graph/hamiltonian_path.h"
 #include "ortools/util/bitset.h"
 #include "ortools/util/saturated_arithmetic.h"
+#include "ortools/util/stats.h"
 
 ABSL_FLAG(int, cp_local_search_sync_frequency, 16,
           "Frequency of checks for better solutions in the solution pool.");
@@ -894,14 +895,14 @@ bool PathOperator::CheckChainValidity(int64_t before_chain, int64_t chain_end,
 // 1 -> 3 -> 2 -> 4 -> 5
 // 1 -> 4 -> 3 -> 2 -> 5
 // 1 -> 2 -> 4 -> 3 -> 5
-class TwoOpt : public PathOperator {
+class TwoOpt final : public SpecializedPathOperator<TwoOpt> {
  public:
   TwoOpt(
       const std::vector<IntVar*>& vars,
       const std::vector<IntVar*>& secondary_vars,
       std::function<int(int64_t)> start_empty_path_class,
-      std::function<const std::vector<int>&(int, int)> get_neighbors = nullptr)
-      : PathOperator(
+      std::function<absl::Span<const int>(int, int)> get_neighbors = nullptr)
+      : SpecializedPathOperator(
             vars, secondary_vars, get_neighbors == nullptr ? 2 : 1,
             /*skip_locally_optimal_paths=*/true, /*accept_path_end_base=*/true,
             std::move(start_empty_path_class), std::move(get_neighbors)),
@@ -990,14 +991,14 @@ bool TwoOpt::MakeNeighbor() {
 // the OrOpt operator on a path. The OrOpt operator is a limited version of
 // 3Opt (breaks 3 arcs on a path).
 
-class Relocate : public PathOperator {
+class Relocate final : public SpecializedPathOperator<Relocate> {
  public:
   Relocate(const std::vector<IntVar*>& vars,
            const std::vector<IntVar*>& secondary_vars, const std::string& name,
            std::function<int(int64_t)> start_empty_path_class,
-           std::function<const std::vector<int>&(int, int)> get_neighbors,
+           std::function<absl::Span<const int>(int, int)> get_neighbors,
            int64_t chain_length = 1LL, bool single_path = false)
-      : PathOperator(
+      : SpecializedPathOperator(
             vars, secondary_vars, get_neighbors == nullptr ? 2 : 1,
             /*skip_locally_optimal_paths=*/true, /*accept_path_end_base=*/false,
             std::move(start_empty_path_class), std::move(get_neighbors)),
@@ -1009,7 +1010,7 @@ class Relocate : public PathOperator {
   Relocate(const std::vector<IntVar*>& vars,
            const std::vector<IntVar*>& secondary_vars,
            std::function<int(int64_t)> start_empty_path_class,
-           std::function<const std::vector<int>&(int, int)> get_neighbors,
+           std::function<absl::Span<const int>(int, int)> get_neighbors,
            int64_t chain_length = 1LL, bool single_path = false)
       : Relocate(vars, secondary_vars,
                  absl::StrCat("Relocate<", chain_length, ">"),
@@ -1072,17 +1073,19 @@ bool Relocate::MakeNeighbor() {
 // 1 -> 4 -> 3 -> 2 -> 5
 // 1 -> 2 -> 4 -> 3 -> 5
 
-class Exchange : public PathOperator {
+class Exchange final : public SpecializedPathOperator<Exchange> {
  public:
   Exchange(
       const std::vector<IntVar*>& vars,
       const std::vector<IntVar*>& secondary_vars,
       std::function<int(int64_t)> start_empty_path_class,
-      std::function<const std::vector<int>&(int, int)> get_neighbors = nullptr)
-      : PathOperator(vars, secondary_vars, get_neighbors == nullptr ? 2 : 1,
-                     /*skip_locally_optimal_paths=*/true,
-                     /*accept_path_end_base=*/false,
-                     std::move(start_empty_path_class), get_neighbors) {}
+      std::function<absl::Span<const int>(int, int)> get_neighbors = nullptr)
+      : SpecializedPathOperator(vars, secondary_vars,
+                                get_neighbors == nullptr ? 2 : 1,
+                                /*skip_locally_optimal_paths=*/true,
+                                /*accept_path_end_base=*/false,
+                                std::move(start_empty_path_class),
+                                get_neighbors) {}
   ~Exchange() override {}
   bool MakeNeighbor() override;
 
@@ -1124,7 +1127,7 @@ class Cross : public PathOperator {
       const std::vector<IntVar*>& vars,
       const std::vector<IntVar*>& secondary_vars,
       std::function<int(int64_t)> start_empty_path_class,
-      std::function<const std::vector<int>&(int, int)> get_neighbors = nullptr)
+      std::function<absl::Span<const int>(int, int)> get_neighbors = nullptr)
       : PathOperator(
             vars, secondary_vars, get_neighbors == nullptr ? 2 : 1,
             /*skip_locally_optimal_paths=*/true, /*accept_path_end_base=*/true,
@@ -1213,7 +1216,7 @@ class BaseInactiveNodeToPathOperator : public PathOperator {
       const std::vector<IntVar*>& vars,
       const std::vector<IntVar*>& secondary_vars, int number_of_base_nodes,
       std::function<int(int64_t)> start_empty_path_class,
-      std::function<const std::vector<int>&(int, int)> get_neighbors = nullptr)
+      std::function<absl::Span<const int>(int, int)> get_neighbors = nullptr)
       : PathOperator(vars, secondary_vars, number_of_base_nodes, false, false,
                      std::move(start_empty_path_class),
                      std::move(get_neighbors)),
@@ -1269,7 +1272,7 @@ class MakeActiveOperator : public BaseInactiveNodeToPathOperator {
       const std::vector<IntVar*>& vars,
       const std::vector<IntVar*>& secondary_vars,
       std::function<int(int64_t)> start_empty_path_class,
-      std::function<const std::vector<int>&(int, int)> get_neighbors = nullptr)
+      std::function<absl::Span<const int>(int, int)> get_neighbors = nullptr)
       : BaseInactiveNodeToPathOperator(vars, secondary_vars, 1,
                                        std::move(start_empty_path_class),
                                        std::move(get_neighbors)) {}
@@ -2435,7 +2438,7 @@ LocalSearchOperator* MakeLocalSearchOperatorWithNeighbors(
     Solver* solver, const std::vector<IntVar*>& vars,
     const std::vector<IntVar*>& secondary_vars,
     std::function<int(int64_t)> start_empty_path_class,
-    std::function<const std::vector<int>&(int, int)> get_neighbors) {
+    std::function<absl::Span<const int>(int, int)> get_neighbors) {
   return solver->RevAlloc(new T(vars, secondary_vars,
                                 std::move(start_empty_path_class),
                                 std::move(get_neighbors)));
@@ -2457,7 +2460,7 @@ LocalSearchOperator* MakeLocalSearchOperatorWithNeighbors(
       Solver * solver, const std::vector<IntVar*>& vars,                    \
       const std::vector<IntVar*>& secondary_vars,                           \
       std::function<int(int64_t)> start_empty_path_class,                   \
-      std::function<const std::vector<int>&(int, int)> get_neighbors) {     \
+      std::function<absl::Span<const int>(int, int)> get_neighbors) {     \
     return solver->RevAlloc(new OperatorClass(                              \
         vars, secondary_vars, std::move(start_empty_path_class),            \
         std::move(get_neighbors)));                                         \
@@ -2487,14 +2490,14 @@ MAKE_LOCAL_SEARCH_OPERATOR(RelocateAndMakeInactiveOperator)
 // MakeLocalSearchOperator functions.
 LocalSearchOperator* Solver::MakeOperator(
     const std::vector<IntVar*>& vars, Solver::LocalSearchOperators op,
-    std::function<const std::vector<int>&(int, int)> get_neighbors) {
+    std::function<absl::Span<const int>(int, int)> get_neighbors) {
   return MakeOperator(vars, std::vector<IntVar*>(), op, get_neighbors);
 }
 
 LocalSearchOperator* Solver::MakeOperator(
     const std::vector<IntVar*>& vars,
     const std::vector<IntVar*>& secondary_vars, Solver::LocalSearchOperators op,
-    std::function<const std::vector<int>&(int, int)> get_neighbors) {
+    std::function<absl::Span<const int>(int, int)> get_neighbors) {
   switch (op) {
     case Solver::TWOOPT: {
       return MakeLocalSearchOperatorWithNeighbors<TwoOpt>(
@@ -3196,13 +3199,24 @@ bool DimensionChecker::Check() const {
     // Loop invariant: except for the first chain, cumul represents the cumul
     // state of the last node of the previous chain, and it is nonempty.
     int prev_node = path_state_->Start(path);
-    EInterval cumul = node_capacity_[prev_node] & path_capacity;
-    if (IsEmpty(cumul)) return false;
+    EInterval cumul = {0, 0, 0, 0};
+    bool is_first_chain = true;
 
     for (const auto chain : path_state_->Chains(path)) {
       const int first_node = chain.First();
       const int last_node = chain.Last();
 
+      if (is_first_chain) {
+        // The first chain is an unchanged part of the path from its start.
+        DCHECK_EQ(first_node, prev_node);
+        DCHECK_EQ(path_state_->Path(first_node), path);
+        is_first_chain = false;
+        cumul = prefix_cumul_[index_[last_node]];
+        if (IsEmpty(cumul)) return false;
+        prev_node = last_node;
+        continue;
+      }
+
       if (prev_node != first_node) {
         // Bring cumul state from last node of previous chain to first node of
         // current chain.
@@ -3275,6 +3289,8 @@ void DimensionChecker::IncrementalCommit() {
 void DimensionChecker::FullCommit() {
   // Clear all structures.
   for (auto& layer : riq_) layer.clear();
+  tsum_.clear();
+  prefix_cumul_.clear();
   // Append all paths.
   const int num_paths = path_state_->NumPaths();
   for (int path = 0; path < num_paths; ++path) {
@@ -3288,8 +3304,11 @@ void DimensionChecker::AppendPathDemandsToSums(int path) {
   // Value of forwards_demand_sums_riq_ at node_index must be the sum
   // of all demands of nodes from start of path to node.
   const int path_class = path_class_[path];
+  const EInterval& path_capacity = path_capacity_[path];
   EInterval demand_sum = {0, 0, 0, 0};
   int prev = path_state_->Start(path);
+  EInterval cumul = path_capacity;
+  bool is_feasible = true;
   int index = riq_[0].size();
   for (const int node : path_state_->Nodes(path)) {
     // Transition to current node.
@@ -3300,13 +3319,20 @@ void DimensionChecker::AppendPathDemandsToSums(int path) {
     demand_sum += demand;
     cached_demand_[prev] = demand;
     prev = node;
+    // Same propagation as in Check(), an empty cumul staying empty.
+    if (is_feasible) {
+      cumul += demand;
+      cumul &= node_capacity_[node];
+      cumul &= path_capacity;
+      is_feasible = !IsEmpty(cumul);
+    }
     // Store all data of current node.
     index_[node] = index++;
     riq_[0].push_back({.cumuls_to_fst = node_capacity_[node],
                        .tightest_tsum = demand_sum,
-                       .cumuls_to_lst = node_capacity_[node],
-                       .tsum_at_fst = demand_sum,
-                       .tsum_at_lst = demand_sum});
+                       .cumuls_to_lst = node_capacity_[node]});
+    tsum_.push_back(demand_sum);
+    prefix_cumul_.push_back(cumul);
   }
   cached_demand_[path_state_->End(path)] = {0, 0, 0, 0};
 }
@@ -3327,15 +3353,14 @@ void DimensionChecker::UpdateRIQStructure(int begin_index, int end_index) {
       // the L-window - (i - half_window, i].
       const RIQNode& fw = riq_[layer - 1][i - half_window];
       const RIQNode& lw = riq_[layer - 1][i];
-      const EInterval lst_to_lst = Delta(fw.tsum_at_lst, lw.tsum_at_lst);
-      const EInterval fst_to_fst = Delta(fw.tsum_at_fst, lw.tsum_at_fst);
+      const EInterval lst_to_lst = Delta(tsum_[i - half_window], tsum_[i]);
+      const EInterval fst_to_fst = Delta(tsum_[i - 2 * half_window + 1],
+                                         tsum_[i - half_window + 1]);
 
       riq_[layer][i] = {
           .cumuls_to_fst = fw.cumuls_to_fst & lw.cumuls_to_fst - fst_to_fst,
           .tightest_tsum = fw.tightest_tsum & lw.tightest_tsum,
-          .cumuls_to_lst = fw.cumuls_to_lst + lst_to_lst & lw.cumuls_to_lst,
-          .tsum_at_fst = fw.tsum_at_fst,
-          .tsum_at_lst = lw.tsum_at_lst};
+          .cumuls_to_lst = fw.cumuls_to_lst + lst_to_lst & lw.cumuls_to_lst};
     }
   }
 }
@@ -3354,21 +3379,26 @@ void DimensionChecker::UpdateCumulUsingChainRIQ(
   const int window = 1 << layer;
   const RIQNode& fw = riq_[layer][first_index + window - 1];
   const RIQNode& lw = riq_[layer][last_index];
+  // The sums at the first and last nodes of the F and L windows.
+  const EInterval& fw_tsum_at_fst = tsum_[first_index];
+  const EInterval& fw_tsum_at_lst = tsum_[first_index + window - 1];
+  const EInterval& lw_tsum_at_fst = tsum_[last_index - window + 1];
+  const EInterval& lw_tsum_at_lst = tsum_[last_index];
 
   // Compute the set of cumul values that can reach the last node.
   cumul &= fw.cumuls_to_fst;
-  cumul &= lw.cumuls_to_fst - Delta(fw.tsum_at_fst, lw.tsum_at_fst);
+  cumul &= lw.cumuls_to_fst - Delta(fw_tsum_at_fst, lw_tsum_at_fst);
   cumul &= path_capacity -
-           Delta(fw.tsum_at_fst, fw.tightest_tsum & lw.tightest_tsum);
+           Delta(fw_tsum_at_fst, fw.tightest_tsum & lw.tightest_tsum);
 
   // We need to check for emptiness before widening the interval with transit.
   if (IsEmpty(cumul)) return;
 
   // Transit to last node.
-  cumul += Delta(fw.tsum_at_fst, lw.tsum_at_lst);
+  cumul += Delta(fw_tsum_at_fst, lw_tsum_at_lst);
 
   // Compute the set of cumul values that are reached from first node.
-  cumul &= fw.cumuls_to_lst + Delta(fw.tsum_at_lst, lw.tsum_at_lst);
+  cumul &= fw.cumuls_to_lst + Delta(fw_tsum_at_lst, lw_tsum_at_lst);
   cumul &= lw.cumuls_to_lst;
 }
 
@@ -4297,23 +4327,40 @@ class LocalSearchProfiler : public LocalSearchMonitor {
 
   template <typename Callback>
   void ParseLocalSearchOperatorStatistics(const Callback& callback) const {
-    std::vector<const LocalSearchOperator*> operators;
-    for (const auto& stat : operator_stats_) {
-      operators.push_back(stat.first);
-    }
-    std::sort(
-        operators.begin(), operators.end(),
-        [this](const LocalSearchOperator* op1, const LocalSearchOperator* op2) {
-          return gtl::FindOrDie(operator_stats_, op1).neighbors >
-                 gtl::FindOrDie(operator_stats_, op2).neighbors;
-        });
-    for (const LocalSearchOperator* const op : operators) {
+    for (const LocalSearchOperator* const op : SortedOperators()) {
       const OperatorStats& stats = gtl::FindOrDie(operator_stats_, op);
       callback(op->DebugString(), stats.neighbors, stats.filtered_neighbors,
                stats.accepted_neighbors, stats.seconds);
     }
   }
 
+  // Calls `callback` on the filter statistics of the neighbors of each
+  // operator, in the order of ParseLocalSearchOperatorStatistics().
+  template <typename Callback>
+  void ParseLocalSearchOperatorFilterStatistics(
+      const Callback& callback) const {
+    for (const LocalSearchOperator* const op : SortedOperators()) {
+      const OperatorStats& stats = gtl::FindOrDie(operator_stats_, op);
+      std::vector<const LocalSearchFilter*> filters;
+      for (const auto& stat : stats.filter_stats) {
+        filters.push_back(stat.first);
+      }
+      std::sort(filters.begin(), filters.end(),
+                [&stats](const LocalSearchFilter* filter1,
+                         const LocalSearchFilter* filter2) {
+                  return gtl::FindOrDie(stats.filter_stats, filter1).calls >
+                         gtl::FindOrDie(stats.filter_stats, filter2).calls;
+                });
+      std::vector<std::pair<const LocalSearchFilter*, const FilterStats*>>
+          sorted_filter_stats;
+      for (const LocalSearchFilter* const filter : filters) {
+        sorted_filter_stats.push_back(
+            {filter, &gtl::FindOrDie(stats.filter_stats, filter)});
+      }
+      callback(stats.filter_seconds, sorted_filter_stats);
+    }
+  }
+
   template <typename Callback>
   void ParseLocalSearchFilterStatistics(const Callback& callback) const {
     absl::flat_hash_map<std::string, std::vector<const LocalSearchFilter*>>
@@ -4362,6 +4409,35 @@ class LocalSearchProfiler : public LocalSearchMonitor {
           num_accepted_neighbors);
       local_search_operator_statistics->set_duration_seconds(duration_seconds);
     });
+    int operator_index = 0;
+    ParseLocalSearchOperatorFilterStatistics(
+        [&statistics_proto, &operator_index](
+            double filter_duration_seconds,
+            absl::Span<const std::pair<const LocalSearchFilter*,
+                                       const FilterStats*>>
+                filter_stats) {
+          LocalSearchStatistics::LocalSearchOperatorStatistics* const
+              local_search_operator_statistics =
+                  statistics_proto.mutable_local_search_operator_statistics(
+                      operator_index++);
+          local_search_operator_statistics->set_filter_duration_seconds(
+              filter_duration_seconds);
+          for (const auto& [filter, stats] : filter_stats) {
+            LocalSearchStatistics::LocalSearchFilterStatistics* const
+                local_search_filter_statistics =
+                    local_search_operator_statistics
+                        ->add_local_search_filter_statistics();
+            local_search_filter_statistics->set_local_search_filter(
+                filter->DebugString());
+            local_search_filter_statistics->set_num_calls(stats->calls);
+            local_search_filter_statistics->set_num_rejects(stats->rejects);
+            local_search_filter_statistics->set_duration_seconds(
+                stats->seconds);
+            local_search_filter_statistics->set_num_rejects_per_second(
+                stats->rejects / stats->seconds);
+            local_search_filter_statistics->set_context(stats->context);
+          }
+        });
     ParseLocalSearchFilterStatistics([&statistics_proto](
                                          const std::string& context,
                                          const std::string& name,
@@ -4496,9 +4572,12 @@ class LocalSearchProfiler : public LocalSearchMonitor {
       operator_stats_[op->Self()].neighbors++;
     }
   }
-  void BeginFilterNeighbor(const LocalSearchOperator*) override {}
+  void BeginFilterNeighbor(const LocalSearchOperator* op) override {
+    filtered_operator_ = op->Self();
+  }
   void EndFilterNeighbor(const LocalSearchOperator* op,
                          bool neighbor_found) override {
+    filtered_operator_ = nullptr;
     if (neighbor_found) {
       operator_stats_[op->Self()].filtered_neighbors++;
     }
@@ -4518,11 +4597,23 @@ class LocalSearchProfiler : public LocalSearchMonitor {
   }
   void EndFiltering(const LocalSearchFilter* filter, bool reject) override {
     filter_timer_.Stop();
+    const double seconds = filter_timer_.Get();
     auto& stats = filter_stats_[filter];
-    stats.seconds += filter_timer_.Get();
+    stats.seconds += seconds;
     if (reject) {
       stats.rejects++;
     }
+    if (filtered_operator_ != nullptr) {
+      OperatorStats& operator_stats = operator_stats_[filtered_operator_];
+      operator_stats.filter_seconds += seconds;
+      FilterStats& operator_filter_stats = operator_stats.filter_stats[filter];
+      operator_filter_stats.calls++;
+      operator_filter_stats.seconds += seconds;
+      operator_filter_stats.context = stats.context;
+      if (reject) {
+        operator_filter_stats.rejects++;
+      }
+    }
   }
   void AddFirstSolutionProfiledDecisionBuilder(
       ProfiledDecisionBuilder* profiled_db) {
@@ -4540,12 +4631,20 @@ class LocalSearchProfiler : public LocalSearchMonitor {
     timer_.Start();
   }
 
-  struct OperatorStats {
-    int64_t neighbors = 0;
-    int64_t filtered_neighbors = 0;
-    int64_t accepted_neighbors = 0;
-    double seconds = 0;
-  };
+  // Returns the operators by decreasing number of neighbors.
+  std::vector<const LocalSearchOperator*> SortedOperators() const {
+    std::vector<const LocalSearchOperator*> operators;
+    for (const auto& stat : operator_stats_) {
+      operators.push_back(stat.first);
+    }
+    std::sort(
+        operators.begin(), operators.end(),
+        [this](const LocalSearchOperator* op1, const LocalSearchOperator* op2) {
+          return gtl::FindOrDie(operator_stats_, op1).neighbors >
+                 gtl::FindOrDie(operator_stats_, op2).neighbors;
+        });
+    return operators;
+  }
 
   struct FilterStats {
     int64_t calls = 0;
@@ -4553,9 +4652,21 @@ class LocalSearchProfiler : public LocalSearchMonitor {
     double seconds = 0;
     std::string context;
   };
+
+  struct OperatorStats {
+    int64_t neighbors = 0;
+    int64_t filtered_neighbors = 0;
+    int64_t accepted_neighbors = 0;
+    double seconds = 0;
+    // Filtering of the neighbors of the operator, included in `seconds`.
+    double filter_seconds = 0;
+    absl::flat_hash_map<const LocalSearchFilter*, FilterStats> filter_stats;
+  };
   WallTimer timer_;
   WallTimer filter_timer_;
   const LocalSearchOperator* last_operator_ = nullptr;
+  // The operator whose neighbor is being filtered, if any.
+  const LocalSearchOperator* filtered_operator_ = nullptr;
   absl::flat_hash_map<const LocalSearchOperator*, OperatorStats>
       operator_stats_;
   absl::flat_hash_map<const LocalSearchFilter*, FilterStats> filter_stats_;
@@ -4851,6 +4962,7 @@ FindOneNeighbor::FindOneNeighbor(Assignment* const assignment,
 }
 
 Decision* FindOneNeighbor::Next(Solver* const solver) {
+  SCOPED_PROFILING_COUNTER("local_search.FindOneNeighbor");
   CHECK(nullptr != solver);
 
   if (original_limit_ != nullptr) {
@@ -0,0 +1,200 @@
+// Copyright 2010-2024 Google LLC
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "ortools/constraint_solver/parallel_local_search.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "absl/base/thread_annotations.h"
+#include "absl/log/check.h"
+#include "absl/synchronization/mutex.h"
+#include "absl/time/clock.h"
+#include "absl/time/time.h"
+#include "ortools/base/threadpool.h"
+#include "ortools/constraint_solver/assignment.pb.h"
+#include "ortools/constraint_solver/constraint_solver.h"
+
+namespace operations_research {
+
+namespace {
+
+// The best solution found so far by the workers, shared between them. Its
+// cost can be read without locking, which lets the workers check cheaply, and
+// often, whether they should pick up the solution.
+class SharedSolution {
+ public:
+  int64_t cost() const { return cost_.load(std::memory_order_acquire); }
+
+  // Replaces the best solution by `solution` if its cost is lower.
+  void Offer(const Assignment& solution) {
+    const int64_t cost = solution.ObjectiveValue();
+    if (cost >= this->cost()) return;
+    // Serializing the solution is done outside of the lock.
+    AssignmentProto proto;
+    solution.Save(&proto);
+    absl::MutexLock lock(&mutex_);
+    if (cost >= cost_.load(std::memory_order_relaxed)) return;
+    solution_.Swap(&proto);
+    cost_.store(cost, std::memory_order_release);
+  }
+
+  // Loads the best solution into `solution` and returns true if its cost is
+  // lower than `cost`.
+  bool LoadIfBetter(int64_t cost, Assignment* solution) const {
+    if (this->cost() >= cost) return false;
+    absl::MutexLock lock(&mutex_);
+    const int64_t best_cost = cost_.load(std::memory_order_relaxed);
+    if (best_cost >= cost) return false;
+    solution->Load(solution_);
+    // The objective is not saved if it has no name.
+    solution->SetObjectiveValue(best_cost);
+    return true;
+  }
+
+  // Copies the best solution into `solution` and its cost into `cost`, and
+  // returns false if there is none.
+  bool Get(AssignmentProto* solution, int64_t* cost) const {
+    absl::MutexLock lock(&mutex_);
+    const int64_t best_cost = cost_.load(std::memory_order_relaxed);
+    if (best_cost == std::numeric_limits<int64_t>::max()) return false;
+    *solution = solution_;
+    if (cost != nullptr) *cost = best_cost;
+    return true;
+  }
+
+ private:
+  std::atomic<int64_t> cost_ = std::numeric_limits<int64_t>::max();
+  mutable absl::Mutex mutex_;
+  AssignmentProto solution_ ABSL_GUARDED_BY(mutex_);
+};
+
+// The solution pool of the local search of a worker: offers the solutions it
+// accepts to the other workers, and restarts it from theirs when they are
+// better.
+class SharedSolutionPool : public SolutionPool {
+ public:
+  explicit SharedSolutionPool(SharedSolution* shared_solution)
+      : shared_solution_(shared_solution) {}
+  ~SharedSolutionPool() override {}
+
+  void Initialize(Assignment* const assignment) override {
+    reference_assignment_ = std::make_unique<Assignment>(assignment);
+    shared_solution_->Offer(*assignment);
+  }
+
+  void RegisterNewSolution(Assignment* const assignment) override {
+    reference_assignment_->CopyIntersection(assignment);
+    shared_solution_->Offer(*assignment);
+  }
+
+  void GetNextSolution(Assignment* const assignment) override {
+    shared_solution_->LoadIfBetter(reference_assignment_->ObjectiveValue(),
+                                   reference_assignment_.get());
+    assignment->CopyIntersection(reference_assignment_.get());
+  }
+
+  bool SyncNeeded(Assignment* const local_assignment) override {
+    return shared_solution_->cost() < local_assignment->ObjectiveValue();
+  }
+
+  std::string DebugString() const override { return "SharedSolutionPool"; }
+
+ private:
+  SharedSolution* const shared_solution_;
+  std::unique_ptr<Assignment> reference_assignment_;
+};
+
+// Runs the search of one worker of SolveWithParallelLocalSearch() until
+// `deadline`, exchanging solutions with `shared_solution`.
+void RunParallelLocalSearchWorker(const ParallelLocalSearchModel& model,
+                                  absl::Time deadline,
+                                  SharedSolution* shared_solution) {
+  Solver* const solver = model.solver.get();
+  Assignment* const solution = model.solution;
+  IntVar* const objective = solution->Objective();
+  const auto time_left = [deadline]() {
+    return std::max(absl::ZeroDuration(), deadline - absl::Now());
+  };
+
+  SolutionCollector* const first_collector =
+      solver->MakeFirstSolutionCollector(solution);
+  solver->Solve(model.first_solution, first_collector,
+                solver->MakeTimeLimit(time_left()));
+  if (first_collector->solution_count() > 0) {
+    solution->Copy(first_collector->solution(0));
+    shared_solution->Offer(*solution);
+  } else if (!shared_solution->LoadIfBetter(
+                 std::numeric_limits<int64_t>::max(), solution)) {
+    return;
+  }
+
+  LocalSearchPhaseParameters* const parameters =
+      solver->MakeLocalSearchPhaseParameters(
+          objective,
+          solver->RevAlloc(new SharedSolutionPool(shared_solution)),
+          model.ls_operator, model.sub_decision_builder, model.neighbor_limit);
+  std::vector<SearchMonitor*> monitors = model.monitors;
+  if (monitors.empty()) monitors.push_back(solver->MakeMinimize(objective, 1));
+  SolutionCollector* const best_collector =
+      solver->MakeBestValueSolutionCollector(solution, /*maximize=*/false);
+  monitors.push_back(best_collector);
+  monitors.push_back(solver->MakeTimeLimit(time_left()));
+  solver->Solve(solver->MakeLocalSearchPhase(solution, parameters), monitors);
+  if (best_collector->solution_count() > 0) {
+    shared_solution->Offer(*best_collector->solution(0));
+  }
+}
+
+}  // namespace
+
+bool SolveWithParallelLocalSearch(
+    const ParallelLocalSearchModelBuilder& build_model, int num_workers,
+    absl::Duration time_limit, AssignmentProto* solution,
+    int64_t* objective_value) {
+  CHECK(solution != nullptr);
+  num_workers = std::max(1, num_workers);
+  const absl::Time deadline = absl::Now() + time_limit;
+  SharedSolution shared_solution;
+  const auto run_worker = [&](int worker) {
+    const ParallelLocalSearchModel model = build_model(worker);
+    CHECK(model.solver != nullptr);
+    CHECK(model.solution != nullptr);
+    CHECK(model.solution->HasObjective());
+    CHECK(model.first_solution != nullptr);
+    CHECK(model.ls_operator != nullptr);
+    model.solver->ReSeed(worker);
+    RunParallelLocalSearchWorker(model, deadline, &shared_solution);
+  };
+  {
+    std::unique_ptr<ThreadPool> thread_pool;
+    if (num_workers > 1) {
+      thread_pool =
+          std::make_unique<ThreadPool>("ParallelLocalSearch", num_workers - 1);
+      thread_pool->StartWorkers();
+    }
+    for (int worker = 1; worker < num_workers; ++worker) {
+      thread_pool->Schedule([&run_worker, worker]() { run_worker(worker); });
+    }
+    run_worker(0);
+    // Waits for the other workers.
+  }
+  return shared_solution.Get(solution, objective_value);
+}
+
+}  // namespace operations_research
@@ -0,0 +1,109 @@
+// Copyright 2010-2024 Google LLC
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// A parallel local search (typically a large neighborhood search) driver for
+// the constraint solver. A Solver is single-threaded, so each worker solves
+// its own copy of the model, built on its own thread by a user-provided
+// function, with its own neighborhoods (e.g. BaseLns operators) and random
+// seed. The workers share their improving solutions through a pool of the
+// best solution found so far, which is plugged in the local search of each
+// worker as its SolutionPool: a worker restarts its neighborhoods from the
+// solution of the pool as soon as it is better than its own.
+//
+// Solutions are exchanged as AssignmentProto, the variables being matched by
+// name: the variables of the solution of a model must have unique names, the
+// same in all the copies of the model. Integer, interval and sequence
+// variables are supported.
+//
+// Usage:
+//   const auto build_model = [](int worker) {
+//     ParallelLocalSearchModel model;
+//     model.solver = std::make_unique<Solver>("jobshop");
+//     Solver* const solver = model.solver.get();
+//     // Create the (named) variables and the constraints.
+//     model.solution = solver->MakeAssignment();
+//     model.solution->Add(sequences);
+//     model.solution->AddObjective(makespan);
+//     model.first_solution = ...;
+//     model.ls_operator = solver->ConcatenateOperators(
+//         {...}, /*restart=*/true);
+//     model.sub_decision_builder = ...;
+//     return model;
+//   };
+//   AssignmentProto solution;
+//   int64_t makespan = 0;
+//   if (SolveWithParallelLocalSearch(build_model, /*num_workers=*/8,
+//                                    absl::Seconds(60), &solution,
+//                                    &makespan)) {
+//     ...
+//   }
+
+#ifndef OR_TOOLS_CONSTRAINT_SOLVER_PARALLEL_LOCAL_SEARCH_H_
+#define OR_TOOLS_CONSTRAINT_SOLVER_PARALLEL_LOCAL_SEARCH_H_
+
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <vector>
+
+#include "absl/time/time.h"
+#include "ortools/constraint_solver/assignment.pb.h"
+#include "ortools/constraint_solver/constraint_solver.h"
+
+namespace operations_research {
+
+// A copy of the model solved by a worker of SolveWithParallelLocalSearch().
+// All the pointers are owned by `solver`.
+struct ParallelLocalSearchModel {
+  std::unique_ptr<Solver> solver;
+  // The variables exchanged between the workers and the objective, which is
+  // minimized. The objective does not need to be named.
+  Assignment* solution = nullptr;
+  // Builds the first solution of the worker. If it fails, the worker starts
+  // from the best solution of the other workers, if any.
+  DecisionBuilder* first_solution = nullptr;
+  // The neighborhoods of the worker, e.g. a concatenation of BaseLns.
+  LocalSearchOperator* ls_operator = nullptr;
+  // Completes the neighbors, in particular the variables relaxed by the large
+  // neighborhoods. Can be null.
+  DecisionBuilder* sub_decision_builder = nullptr;
+  // The limit of each neighbor search (see MakeLocalSearchPhaseParameters()).
+  // Can be null.
+  RegularLimit* neighbor_limit = nullptr;
+  // The monitors of the local search, e.g. a metaheuristic. If empty, the
+  // objective is minimized with a step of 1.
+  std::vector<SearchMonitor*> monitors;
+};
+
+// Returns the copy of the model solved by the given worker. It is called
+// concurrently from several threads, so it must only read the data it shares
+// with other calls. The worker index can be used to vary the neighborhoods.
+using ParallelLocalSearchModelBuilder =
+    std::function<ParallelLocalSearchModel(int worker)>;
+
+// Solves the models returned by `build_model` with `num_workers` workers, on
+// as many threads, for at most `time_limit`. Returns false if no solution was
+// found, and otherwise copies the best solution found by any worker into
+// `solution` and its objective value into `objective_value` (which can be
+// null). The solution can be loaded in an assignment holding the same
+// variables with Assignment::Load().
+//
+// The worker index is used as random seed of the solver of its model.
+bool SolveWithParallelLocalSearch(
+    const ParallelLocalSearchModelBuilder& build_model, int num_workers,
+    absl::Duration time_limit, AssignmentProto* solution,
+    int64_t* objective_value);
+
+}  // namespace operations_research
+
+#endif  // OR_TOOLS_CONSTRAINT_SOLVER_PARALLEL_LOCAL_SEARCH_H_
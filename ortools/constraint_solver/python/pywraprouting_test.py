@@ -17,6 +17,7 @@
 import functools
 
 from absl.testing import absltest
+import numpy as np
 from ortools.constraint_solver import routing_enums_pb2
 from ortools.constraint_solver import pywrapcp
 
@@ -163,6 +164,24 @@ class TestPyWrapRoutingModel(absltest.TestCase):
         self.assertEqual(model.ROUTING_SUCCESS, model.status())
         self.assertEqual(15, assignment.ObjectiveValue())
 
+    def testTransitMatrixFromArray(self):
+        manager = pywrapcp.RoutingIndexManager(5, 1, 0)
+        self.assertIsNotNone(manager)
+        model = pywrapcp.RoutingModel(manager)
+        self.assertIsNotNone(model)
+        matrix = np.tile(np.arange(1, 6, dtype=np.int64), (5, 1))
+        transit_idx = model.RegisterTransitMatrixFromArray(matrix)
+        self.assertEqual(1, transit_idx)
+        model.SetArcCostEvaluatorOfAllVehicles(transit_idx)
+        assignment = model.Solve()
+        self.assertTrue(assignment)
+        self.assertEqual(model.ROUTING_SUCCESS, model.status())
+        self.assertEqual(15, assignment.ObjectiveValue())
+        with self.assertRaises(TypeError):
+            model.RegisterTransitMatrixFromArray(matrix.astype(np.float64))
+        with self.assertRaises(ValueError):
+            model.RegisterTransitMatrixFromArray(matrix[:2])
+
     def testUnaryTransitCallback(self):
         manager = pywrapcp.RoutingIndexManager(5, 1, 0)
         self.assertIsNotNone(manager)
@@ -208,6 +227,21 @@ class TestPyWrapRoutingModel(absltest.TestCase):
         self.assertEqual(model.ROUTING_SUCCESS, model.status())
         self.assertEqual(45, assignment.ObjectiveValue())
 
+    def testUnaryTransitVectorFromArray(self):
+        manager = pywrapcp.RoutingIndexManager(10, 1, 0)
+        self.assertIsNotNone(manager)
+        model = pywrapcp.RoutingModel(manager)
+        self.assertIsNotNone(model)
+        transit_idx = model.RegisterUnaryTransitVectorFromArray(
+            np.arange(10, dtype=np.int64)
+        )
+        self.assertEqual(1, transit_idx)
+        model.SetArcCostEvaluatorOfAllVehicles(transit_idx)
+        assignment = model.Solve()
+        self.assertTrue(assignment)
+        self.assertEqual(model.ROUTING_SUCCESS, model.status())
+        self.assertEqual(45, assignment.ObjectiveValue())
+
     def testTSP(self):
         # Create routing model
         manager = pywrapcp.RoutingIndexManager(10, 1, 0)
@@ -110,6 +110,87 @@ struct LocalSearchMetaheuristic {
 
 }  // namespace operations_research
 
+// Registration of transits from numpy arrays (or any object supporting the
+// buffer protocol). The values are read directly from the buffer, instead of
+// converting one python int per arc as RegisterTransitMatrix() does with
+// lists, and are then evaluated in C++ without calling back into python.
+%{
+#include <cstring>
+
+namespace {
+// Gets a C-contiguous view of `obj` as an int64 array with `ndim` dimensions.
+// On failure, sets a python error and returns false; otherwise the caller
+// must release the view.
+bool GetInt64ArrayView(PyObject* obj, int ndim, Py_buffer* view) {
+  if (PyObject_GetBuffer(obj, view, PyBUF_C_CONTIGUOUS | PyBUF_FORMAT) != 0) {
+    return false;
+  }
+  const char* format = view->format == nullptr ? "B" : view->format;
+  const char type = format[strlen(format) - 1];
+  if (view->ndim != ndim || view->itemsize != sizeof(int64_t) ||
+      (type != 'q' && type != 'l')) {
+    PyBuffer_Release(view);
+    PyErr_Format(PyExc_TypeError,
+                 "Expected a C-contiguous %dD array of int64, use e.g. "
+                 "numpy.ascontiguousarray(values, dtype=numpy.int64)",
+                 ndim);
+    return false;
+  }
+  return true;
+}
+}  // namespace
+%}
+
+%exception operations_research::RoutingModel::RegisterTransitMatrixFromArray {
+  $action
+  if (PyErr_Occurred()) SWIG_fail;
+}
+%exception operations_research::RoutingModel::RegisterUnaryTransitVectorFromArray {
+  $action
+  if (PyErr_Occurred()) SWIG_fail;
+}
+
+%extend operations_research::RoutingModel {
+  // Same as RegisterTransitMatrix(), from a 2D int64 array indexed by nodes.
+  int RegisterTransitMatrixFromArray(PyObject* values) {
+    Py_buffer view;
+    if (!GetInt64ArrayView(values, 2, &view)) return -1;
+    const Py_ssize_t num_rows = view.shape[0];
+    const Py_ssize_t num_cols = view.shape[1];
+    if (num_rows < $self->nodes() || num_cols < $self->nodes()) {
+      PyBuffer_Release(&view);
+      PyErr_SetString(PyExc_ValueError,
+                      "The matrix must have at least one row and one column "
+                      "per node");
+      return -1;
+    }
+    const int64_t* const data = static_cast<const int64_t*>(view.buf);
+    std::vector<std::vector<int64_t>> matrix(num_rows);
+    for (Py_ssize_t row = 0; row < num_rows; ++row) {
+      matrix[row].assign(data + row * num_cols, data + (row + 1) * num_cols);
+    }
+    PyBuffer_Release(&view);
+    return $self->RegisterTransitMatrix(std::move(matrix));
+  }
+
+  // Same as RegisterUnaryTransitVector(), from a 1D int64 array indexed by
+  // nodes.
+  int RegisterUnaryTransitVectorFromArray(PyObject* values) {
+    Py_buffer view;
+    if (!GetInt64ArrayView(values, 1, &view)) return -1;
+    if (view.shape[0] < $self->nodes()) {
+      PyBuffer_Release(&view);
+      PyErr_SetString(PyExc_ValueError,
+                      "The vector must have at least one value per node");
+      return -1;
+    }
+    const int64_t* const data = static_cast<const int64_t*>(view.buf);
+    std::vector<int64_t> vector(data, data + view.shape[0]);
+    PyBuffer_Release(&view);
+    return $self->RegisterUnaryTransitVector(std::move(vector));
+  }
+}
+
 // TODO(user): Use ignoreall/unignoreall for this one. A lot of work.
 //swiglint: disable include-h-allglobals
 %include "ortools/constraint_solver/routing.h"
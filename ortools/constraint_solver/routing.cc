@@ -56,6 +56,7 @@
 #include "ortools/base/protoutil.h"
 #include "ortools/base/stl_util.h"
 #include "ortools/base/strong_vector.h"
+#include "ortools/base/threadpool.h"
 #include "ortools/base/types.h"
 #include "ortools/constraint_solver/constraint_solver.h"
 #include "ortools/constraint_solver/constraint_solveri.h"
@@ -183,6 +184,8 @@ const Assignment* RoutingModel::PackCumulsOfOptimizerDimensionsFromAssignment(
 
   std::vector<DecisionBuilder*> decision_builders;
   decision_builders.push_back(solver_->MakeRestoreAssignment(preassignment_));
+  decision_builders.push_back(
+      solver_->MakeRestoreAssignment(dynamic_restrictions_));
   decision_builders.push_back(
       solver_->MakeRestoreAssignment(packed_assignment));
   for (auto& [lp_optimizer, mp_optimizer] : local_dimension_optimizers_) {
@@ -240,80 +243,202 @@ void RoutingModel::NodeNeighborsByCostClass::ComputeNeighbors(
   // TODO(user): consider checking search limits.
   const int size = routing_model.Size();
   const int size_with_vehicle_nodes = size + routing_model.vehicles();
-  node_index_to_neighbors_by_cost_class_.clear();
-  if (num_neighbors >= size) {
+  neighbors_.clear();
+  offsets_.clear();
+  all_nodes_.clear();
+  full_neighborhood_ = num_neighbors >= size;
+  if (full_neighborhood_) {
     all_nodes_.resize(size);
     std::iota(all_nodes_.begin(), all_nodes_.end(), 0);
     return;
   }
-  node_index_to_neighbors_by_cost_class_.resize(size_with_vehicle_nodes);
-
-  const int num_cost_classes = routing_model.GetCostClassesCount();
-  for (int node_index = 0; node_index < size_with_vehicle_nodes; node_index++) {
-    node_index_to_neighbors_by_cost_class_[node_index].resize(num_cost_classes);
-    for (int cc = 0; cc < num_cost_classes; cc++) {
-      node_index_to_neighbors_by_cost_class_[node_index][cc] =
-          std::make_unique<SparseBitset<int>>(size);
-    }
-  }
-
-  std::vector<std::pair</*cost*/ int64_t, /*node*/ int>> cost_nodes;
-  cost_nodes.reserve(size);
-  for (int node_index = 0; node_index < size_with_vehicle_nodes; ++node_index) {
-    if (routing_model.IsStart(node_index) || routing_model.IsEnd(node_index)) {
-      // For vehicle starts/ends, we consider all nodes (see below)
-      continue;
+  num_cost_classes_ = routing_model.GetCostClassesCount();
+  const NodeNeighborsOptions& options = routing_model.node_neighbors_options_;
+  DCHECK(options.candidates.empty() || options.candidates.size() >= size);
+  // Arc costs can only be computed concurrently without the cost cache.
+  const bool parallel =
+      options.num_threads > 1 && routing_model.ArcCostsAreFlat();
+
+  // The neighbors of the nodes for one cost class, in the same format as
+  // neighbors_ and offsets_.
+  struct ClassNeighbors {
+    std::vector<int> neighbors;
+    std::vector<int64_t> offsets;
+  };
+  std::vector<ClassNeighbors> class_neighbors(num_cost_classes_);
+  const auto compute_class_neighbors = [&](int cost_class) {
+    ClassNeighbors& result = class_neighbors[cost_class];
+    result.offsets.assign(size_with_vehicle_nodes + 1, 0);
+    if (!routing_model.HasVehicleWithCostClassIndex(
+            RoutingCostClassIndex(cost_class))) {
+      // No vehicle with this cost class, avoid unnecessary computations.
+      return;
     }
-
-    // TODO(user): Use the model's IndexNeighborFinder when available.
-    for (int cost_class = 0; cost_class < num_cost_classes; cost_class++) {
-      if (!routing_model.HasVehicleWithCostClassIndex(
-              RoutingCostClassIndex(cost_class))) {
-        // No vehicle with this cost class, avoid unnecessary computations.
+    const auto arc_cost = [&routing_model, cost_class, parallel](int64_t from,
+                                                                 int64_t to) {
+      return parallel ? routing_model.ComputeArcCostForClass(
+                            from, to, CostClassIndex(cost_class))
+                      : routing_model.GetArcCostForClass(from, to, cost_class);
+    };
+    const auto is_neighbor_candidate = [&routing_model, size](int node,
+                                                              int candidate) {
+      return candidate != node && candidate < size &&
+             !routing_model.IsStart(candidate);
+    };
+    // The num_neighbors closest nodes of each node, by increasing cost, are
+    // closest[closest_offsets[node], closest_offsets[node + 1]).
+    std::vector<int> closest;
+    std::vector<int> closest_offsets(size + 1, 0);
+    std::vector<std::pair</*cost*/ int64_t, /*node*/ int>> cost_nodes;
+    cost_nodes.reserve(options.candidates.empty() ? size : num_neighbors);
+    for (int node_index = 0; node_index < size; ++node_index) {
+      closest_offsets[node_index] = closest.size();
+      if (routing_model.IsStart(node_index)) {
+        // For vehicle starts/ends, we consider all nodes (see below)
         continue;
       }
       cost_nodes.clear();
-      for (int after_node = 0; after_node < size; ++after_node) {
-        if (after_node != node_index && !routing_model.IsStart(after_node)) {
-          cost_nodes.push_back(
-              std::make_pair(routing_model.GetArcCostForClass(
-                                 node_index, after_node, cost_class),
-                             after_node));
+      const absl::Span<const int64_t> successors =
+          routing_model.GetAllowedSuccessors(node_index);
+      // TODO(user): Use the model's IndexNeighborFinder when available.
+      if (!options.candidates.empty()) {
+        for (const int after_node : options.candidates[node_index]) {
+          DCHECK_GE(after_node, 0);
+          if (is_neighbor_candidate(node_index, after_node)) {
+            cost_nodes.push_back(
+                {arc_cost(node_index, after_node), after_node});
+          }
+        }
+      } else if (!successors.empty()) {
+        for (const int64_t after_node : successors) {
+          if (is_neighbor_candidate(node_index, after_node)) {
+            cost_nodes.push_back(
+                {arc_cost(node_index, after_node), after_node});
+          }
+        }
+      } else {
+        for (int after_node = 0; after_node < size; ++after_node) {
+          if (is_neighbor_candidate(node_index, after_node)) {
+            cost_nodes.push_back(
+                {arc_cost(node_index, after_node), after_node});
+          }
         }
       }
+      const int num_closest =
+          std::min<int>(num_neighbors, cost_nodes.size());
+      if (num_closest == 0) continue;
       std::nth_element(cost_nodes.begin(),
-                       cost_nodes.begin() + num_neighbors - 1,
+                       cost_nodes.begin() + num_closest - 1,
                        cost_nodes.end());
-      cost_nodes.resize(num_neighbors);
+      cost_nodes.resize(num_closest);
       // Make sure the order of the n first element is always the same.
       std::sort(cost_nodes.begin(), cost_nodes.end());
+      for (const auto& [cost, neighbor] : cost_nodes) {
+        closest.push_back(neighbor);
+      }
+    }
+    closest_offsets[size] = closest.size();
+    std::vector<int> sorted_closest = closest;
+    for (int node_index = 0; node_index < size; ++node_index) {
+      std::sort(sorted_closest.begin() + closest_offsets[node_index],
+                sorted_closest.begin() + closest_offsets[node_index + 1]);
+    }
+    const auto is_closest = [&sorted_closest, &closest_offsets](int node,
+                                                                int neighbor) {
+      return std::binary_search(
+          sorted_closest.begin() + closest_offsets[node],
+          sorted_closest.begin() + closest_offsets[node + 1], neighbor);
+    };
 
-      auto& node_neighbors =
-          node_index_to_neighbors_by_cost_class_[node_index][cost_class];
-      for (const auto& costed_node : cost_nodes) {
-        const int neighbor = costed_node.second;
-        node_neighbors->Set(neighbor);
-
-        // Add reverse neighborhood.
-        DCHECK(!routing_model.IsEnd(neighbor) &&
-               !routing_model.IsStart(neighbor));
-        node_index_to_neighbors_by_cost_class_[neighbor][cost_class]->Set(
-            node_index);
+    // The neighborhood is symmetric: a node is a neighbor of its closest
+    // nodes, and of all vehicle starts and ends. The neighbors of each node
+    // are listed in the order in which they are first found when iterating
+    // on the nodes, then on their closest nodes.
+    const auto for_each_neighbor = [&](const auto& add_neighbor) {
+      for (int node_index = 0; node_index < size; ++node_index) {
+        if (routing_model.IsStart(node_index)) continue;
+        for (int i = closest_offsets[node_index];
+             i < closest_offsets[node_index + 1]; ++i) {
+          const int neighbor = closest[i];
+          // Both arcs were already added with the closest nodes of neighbor.
+          if (neighbor < node_index && is_closest(neighbor, node_index)) {
+            continue;
+          }
+          add_neighbor(node_index, neighbor);
+          // Add reverse neighborhood.
+          DCHECK(!routing_model.IsEnd(neighbor) &&
+                 !routing_model.IsStart(neighbor));
+          add_neighbor(neighbor, node_index);
+        }
+        // Add all vehicle starts as neighbors to this node and vice-versa.
+        // TODO(user): Consider keeping vehicle start/ends out of neighbors, to
+        // prune arcs going from node to start for instance.
+        for (int vehicle = 0; vehicle < routing_model.vehicles(); vehicle++) {
+          const int vehicle_start = routing_model.Start(vehicle);
+          if (add_vehicle_starts_to_neighbors) {
+            add_neighbor(node_index, vehicle_start);
+          }
+          add_neighbor(vehicle_start, node_index);
+          add_neighbor(routing_model.End(vehicle), node_index);
+        }
       }
-      // Add all vehicle starts as neighbors to this node and vice-versa.
-      // TODO(user): Consider keeping vehicle start/ends out of neighbors, to
-      // prune arcs going from node to start for instance.
-      for (int vehicle = 0; vehicle < routing_model.vehicles(); vehicle++) {
-        const int vehicle_start = routing_model.Start(vehicle);
-        if (add_vehicle_starts_to_neighbors) node_neighbors->Set(vehicle_start);
-        node_index_to_neighbors_by_cost_class_[vehicle_start][cost_class]->Set(
-            node_index);
-        node_index_to_neighbors_by_cost_class_[routing_model.End(vehicle)]
-                                              [cost_class]
-                                                  ->Set(node_index);
+    };
+    for_each_neighbor([&result](int node, int) { ++result.offsets[node + 1]; });
+    std::partial_sum(result.offsets.begin(), result.offsets.end(),
+                     result.offsets.begin());
+    result.neighbors.resize(result.offsets.back());
+    std::vector<int64_t> next_position(result.offsets.begin(),
+                                       result.offsets.end() - 1);
+    for_each_neighbor([&result, &next_position](int node, int neighbor) {
+      result.neighbors[next_position[node]++] = neighbor;
+    });
+  };
+  {
+    std::unique_ptr<ThreadPool> thread_pool;
+    if (parallel && num_cost_classes_ > 1) {
+      thread_pool = std::make_unique<ThreadPool>(
+          "NodeNeighbors", std::min(options.num_threads, num_cost_classes_));
+      thread_pool->StartWorkers();
+    }
+    for (int cost_class = 0; cost_class < num_cost_classes_; ++cost_class) {
+      if (thread_pool == nullptr) {
+        compute_class_neighbors(cost_class);
+      } else {
+        thread_pool->Schedule(
+            [&compute_class_neighbors, cost_class]() {
+              compute_class_neighbors(cost_class);
+            });
       }
     }
+    // Waits for the cost classes to be processed.
+  }
+
+  int64_t num_total_neighbors = 0;
+  for (const ClassNeighbors& neighbors : class_neighbors) {
+    num_total_neighbors += neighbors.neighbors.size();
+  }
+  neighbors_.reserve(num_total_neighbors);
+  offsets_.reserve(
+      static_cast<int64_t>(size_with_vehicle_nodes) * num_cost_classes_ + 1);
+  for (int node_index = 0; node_index < size_with_vehicle_nodes; ++node_index) {
+    for (const ClassNeighbors& neighbors : class_neighbors) {
+      offsets_.push_back(neighbors_.size());
+      neighbors_.insert(
+          neighbors_.end(),
+          neighbors.neighbors.begin() + neighbors.offsets[node_index],
+          neighbors.neighbors.begin() + neighbors.offsets[node_index + 1]);
+    }
   }
+  offsets_.push_back(neighbors_.size());
+}
+
+void RoutingModel::SetNodeNeighborsOptions(NodeNeighborsOptions options) {
+  if (closed_) {
+    LOG(WARNING) << "Model is closed, node neighbors options will be ignored.";
+    return;
+  }
+  node_neighbors_options_ = std::move(options);
+  node_neighbors_by_cost_class_per_size_.clear();
 }
 
 const RoutingModel::NodeNeighborsByCostClass*
@@ -466,6 +591,7 @@ void RoutingModel::Initialize() {
   cost_cache_.clear();
   cost_cache_.resize(size + vehicles_, {kUnassigned, CostClassIndex(-1), 0});
   preassignment_ = solver_->MakeAssignment();
+  dynamic_restrictions_ = solver_->MakeAssignment();
 }
 
 RoutingModel::~RoutingModel() {
@@ -493,11 +619,16 @@ int RoutingModel::RegisterUnaryTransitVector(std::vector<int64_t> values) {
                          [](int64_t transit) { return transit <= 0; })) {
     sign = kTransitEvaluatorSignNegativeOrZero;
   }
-  return RegisterUnaryTransitCallback(
-      [this, values = std::move(values)](int64_t i) {
-        return values[manager_.IndexToNode(i).value()];
-      },
-      sign);
+  CHECK_GE(values.size(), manager_.num_nodes());
+  FlatTransits flat_transits;
+  flat_transits.row_offsets.resize(manager_.num_indices());
+  for (int64_t index = 0; index < manager_.num_indices(); ++index) {
+    flat_transits.row_offsets[index] = manager_.IndexToNode(index).value();
+  }
+  flat_transits.col_offsets.assign(manager_.num_indices(), 0);
+  flat_transits.values = std::move(values);
+  return RegisterFlatTransits(std::move(flat_transits), /*is_unary=*/true,
+                              sign);
 }
 
 int RoutingModel::RegisterUnaryTransitCallback(TransitCallback1 callback,
@@ -513,28 +644,39 @@ int RoutingModel::RegisterUnaryTransitCallback(TransitCallback1 callback,
 
 int RoutingModel::RegisterTransitMatrix(
     std::vector<std::vector<int64_t> /*needed_for_swig*/> values) {
-  // TODO(user): when we move away from std::functions, use a (potentially
-  // vectorized) helper to compute the sign of a range.
+  // The matrix is flattened in node order, whereas callbacks are called with
+  // indices: the offsets hold the index to node mapping.
+  const int num_nodes = manager_.num_nodes();
+  CHECK_GE(values.size(), num_nodes);
+  FlatTransits flat_transits;
+  flat_transits.values.reserve(static_cast<int64_t>(num_nodes) * num_nodes);
   bool all_transits_geq_zero = true;
   bool all_transits_leq_zero = true;
-  for (const std::vector<int64_t>& transit_values : values) {
-    for (const int64_t value : transit_values) {
+  for (int node = 0; node < num_nodes; ++node) {
+    std::vector<int64_t>& transit_values = values[node];
+    CHECK_GE(transit_values.size(), num_nodes);
+    for (int next = 0; next < num_nodes; ++next) {
+      const int64_t value = transit_values[next];
       all_transits_leq_zero &= value <= 0;
       all_transits_geq_zero &= value >= 0;
+      flat_transits.values.push_back(value);
     }
-    if (!all_transits_geq_zero && !all_transits_leq_zero) break;
+    std::vector<int64_t>().swap(transit_values);
   }
   const TransitEvaluatorSign sign =
       all_transits_geq_zero
           ? kTransitEvaluatorSignPositiveOrZero
           : (all_transits_leq_zero ? kTransitEvaluatorSignNegativeOrZero
                                    : kTransitEvaluatorSignUnknown);
-  return RegisterTransitCallback(
-      [this, values = std::move(values)](int64_t i, int64_t j) {
-        return values[manager_.IndexToNode(i).value()]
-                     [manager_.IndexToNode(j).value()];
-      },
-      sign);
+  flat_transits.row_offsets.resize(manager_.num_indices());
+  flat_transits.col_offsets.resize(manager_.num_indices());
+  for (int64_t index = 0; index < manager_.num_indices(); ++index) {
+    const int64_t node = manager_.IndexToNode(index).value();
+    flat_transits.row_offsets[index] = node * num_nodes;
+    flat_transits.col_offsets[index] = node;
+  }
+  return RegisterFlatTransits(std::move(flat_transits), /*is_unary=*/false,
+                              sign);
 }
 
 int RoutingModel::RegisterTransitCallback(TransitCallback2 callback,
@@ -542,13 +684,18 @@ int RoutingModel::RegisterTransitCallback(TransitCallback2 callback,
   if (cache_callbacks_) {
     TransitEvaluatorSign actual_sign = sign;
     const int size = Size() + vehicles();
-    std::vector<int64_t> cache(size * size, 0);
+    FlatTransits cache;
+    cache.values.resize(static_cast<int64_t>(size) * size, 0);
+    cache.row_offsets.resize(size);
+    cache.col_offsets.resize(size);
     bool all_transits_geq_zero = true;
     bool all_transits_leq_zero = true;
     for (int i = 0; i < size; ++i) {
+      cache.row_offsets[i] = static_cast<int64_t>(i) * size;
+      cache.col_offsets[i] = i;
       for (int j = 0; j < size; ++j) {
         const int64_t value = callback(i, j);
-        cache[i * size + j] = value;
+        cache.values[cache.row_offsets[i] + j] = value;
         all_transits_geq_zero &= value >= 0;
         all_transits_leq_zero &= value <= 0;
       }
@@ -558,12 +705,14 @@ int RoutingModel::RegisterTransitCallback(TransitCallback2 callback,
             ? kTransitEvaluatorSignPositiveOrZero
             : (all_transits_leq_zero ? kTransitEvaluatorSignNegativeOrZero
                                      : kTransitEvaluatorSignUnknown);
-    transit_evaluators_.push_back(
-        [cache = std::move(cache), size](int64_t i, int64_t j) {
-          return cache[i * size + j];
-        });
     DCHECK(sign == kTransitEvaluatorSignUnknown || actual_sign == sign);
+    const int index = transit_evaluators_.size();
+    flat_transits_.push_back(std::move(cache));
+    transit_evaluators_.push_back([this, index](int64_t i, int64_t j) {
+      return GetTransitValue(index, i, j);
+    });
   } else {
+    flat_transits_.emplace_back();
     transit_evaluators_.push_back(std::move(callback));
   }
   if (transit_evaluators_.size() != unary_transit_evaluators_.size()) {
@@ -574,6 +723,26 @@ int RoutingModel::RegisterTransitCallback(TransitCallback2 callback,
   return transit_evaluators_.size() - 1;
 }
 
+int RoutingModel::RegisterFlatTransits(FlatTransits flat_transits,
+                                       bool is_unary,
+                                       TransitEvaluatorSign sign) {
+  const int index = transit_evaluators_.size();
+  DCHECK_EQ(flat_transits_.size(), index);
+  DCHECK_EQ(unary_transit_evaluators_.size(), index);
+  flat_transits_.push_back(std::move(flat_transits));
+  transit_evaluators_.push_back([this, index](int64_t i, int64_t j) {
+    return GetTransitValue(index, i, j);
+  });
+  if (is_unary) {
+    unary_transit_evaluators_.push_back(
+        [this, index](int64_t i) { return GetTransitValue(index, i, 0); });
+  } else {
+    unary_transit_evaluators_.push_back(nullptr);
+  }
+  transit_evaluator_sign_.push_back(sign);
+  return index;
+}
+
 int RoutingModel::RegisterStateDependentTransitCallback(
     VariableIndexEvaluator2 callback) {
   state_dependent_transit_evaluators_cache_.push_back(
@@ -1398,72 +1567,99 @@ struct VehicleClass {
 
 }  // namespace
 
-void RoutingModel::ComputeVehicleClasses() {
-  vehicle_class_index_of_vehicle_.assign(vehicles_, VehicleClassIndex(-1));
-  absl::flat_hash_map<VehicleClass, VehicleClassIndex> vehicle_class_map;
-  std::vector<bool> node_is_visitable(Size(), true);
+void RoutingModel::ComputeVehicleClasses(
+    const RoutingSearchParameters& parameters) {
+  // The classes of the vehicles only read the model, so they are built
+  // independently, possibly on several threads, and then numbered in the order
+  // of the vehicles.
+  std::vector<VehicleClass> vehicle_classes(vehicles_);
   const auto bool_vec_hash = absl::Hash<std::vector<bool>>();
-  for (int vehicle = 0; vehicle < vehicles(); ++vehicle) {
-    VehicleClass vehicle_class;
-    vehicle_class.cost_class_index = cost_class_index_of_vehicle_[vehicle];
-    vehicle_class.fixed_cost = fixed_cost_of_vehicle_[vehicle];
-    vehicle_class.used_when_empty = vehicle_used_when_empty_[vehicle];
-    vehicle_class.start_equivalence_class =
-        index_to_equivalence_class_[Start(vehicle)];
-    vehicle_class.end_equivalence_class =
-        index_to_equivalence_class_[End(vehicle)];
-    for (const RoutingDimension* const dimension : dimensions_) {
-      IntVar* const start_cumul_var = dimension->cumuls()[Start(vehicle)];
-      vehicle_class.dimension_start_cumuls_min.push_back(
-          start_cumul_var->Min());
-      vehicle_class.dimension_start_cumuls_max.push_back(
-          start_cumul_var->Max());
-      IntVar* const end_cumul_var = dimension->cumuls()[End(vehicle)];
-      vehicle_class.dimension_end_cumuls_min.push_back(end_cumul_var->Min());
-      vehicle_class.dimension_end_cumuls_max.push_back(end_cumul_var->Max());
-      vehicle_class.dimension_capacities.push_back(
-          dimension->vehicle_capacities()[vehicle]);
-      vehicle_class.dimension_evaluator_classes.push_back(
-          dimension->vehicle_to_class(vehicle));
-    }
-    node_is_visitable.assign(Size(), true);
-    for (int index = 0; index < Size(); ++index) {
-      DCHECK(!IsEnd(index));
-      if (IsStart(index)) continue;
-      if (!vehicle_vars_[index]->Contains(vehicle) ||
-          !IsVehicleAllowedForIndex(vehicle, index)) {
-        node_is_visitable[index] = false;
+  const auto build_vehicle_classes = [this, &vehicle_classes, &bool_vec_hash](
+                                         int begin_vehicle, int end_vehicle) {
+    std::vector<bool> node_is_visitable(Size(), true);
+    for (int vehicle = begin_vehicle; vehicle < end_vehicle; ++vehicle) {
+      VehicleClass& vehicle_class = vehicle_classes[vehicle];
+      vehicle_class.cost_class_index = cost_class_index_of_vehicle_[vehicle];
+      vehicle_class.fixed_cost = fixed_cost_of_vehicle_[vehicle];
+      vehicle_class.used_when_empty = vehicle_used_when_empty_[vehicle];
+      vehicle_class.start_equivalence_class =
+          index_to_equivalence_class_[Start(vehicle)];
+      vehicle_class.end_equivalence_class =
+          index_to_equivalence_class_[End(vehicle)];
+      for (const RoutingDimension* const dimension : dimensions_) {
+        IntVar* const start_cumul_var = dimension->cumuls()[Start(vehicle)];
+        vehicle_class.dimension_start_cumuls_min.push_back(
+            start_cumul_var->Min());
+        vehicle_class.dimension_start_cumuls_max.push_back(
+            start_cumul_var->Max());
+        IntVar* const end_cumul_var = dimension->cumuls()[End(vehicle)];
+        vehicle_class.dimension_end_cumuls_min.push_back(end_cumul_var->Min());
+        vehicle_class.dimension_end_cumuls_max.push_back(end_cumul_var->Max());
+        vehicle_class.dimension_capacities.push_back(
+            dimension->vehicle_capacities()[vehicle]);
+        vehicle_class.dimension_evaluator_classes.push_back(
+            dimension->vehicle_to_class(vehicle));
       }
-    }
-    vehicle_class.visitable_nodes_hash = bool_vec_hash(node_is_visitable);
-
-    std::vector<int64_t>& allowed_resources_hash =
-        vehicle_class.group_allowed_resources_hash;
-    allowed_resources_hash.reserve(resource_groups_.size());
-    for (int rg_index = 0; rg_index < resource_groups_.size(); rg_index++) {
-      const ResourceGroup& resource_group = *resource_groups_[rg_index];
-      if (!resource_group.VehicleRequiresAResource(vehicle)) {
-        allowed_resources_hash.push_back(-1);
-        continue;
+      node_is_visitable.assign(Size(), true);
+      for (int index = 0; index < Size(); ++index) {
+        DCHECK(!IsEnd(index));
+        if (IsStart(index)) continue;
+        if (!vehicle_vars_[index]->Contains(vehicle) ||
+            !IsVehicleAllowedForIndex(vehicle, index)) {
+          node_is_visitable[index] = false;
+        }
       }
-      const std::vector<IntVar*>& resource_vars = resource_vars_[rg_index];
-      std::vector<bool> resource_allowed_for_vehicle(resource_group.Size(),
-                                                     true);
-      for (int resource = 0; resource < resource_group.Size(); resource++) {
-        if (!resource_vars[vehicle]->Contains(resource) ||
-            !resource_group.IsResourceAllowedForVehicle(resource, vehicle)) {
-          resource_allowed_for_vehicle[resource] = false;
-    }
+      vehicle_class.visitable_nodes_hash = bool_vec_hash(node_is_visitable);
+
+      std::vector<int64_t>& allowed_resources_hash =
+          vehicle_class.group_allowed_resources_hash;
+      allowed_resources_hash.reserve(resource_groups_.size());
+      for (int rg_index = 0; rg_index < resource_groups_.size(); rg_index++) {
+        const ResourceGroup& resource_group = *resource_groups_[rg_index];
+        if (!resource_group.VehicleRequiresAResource(vehicle)) {
+          allowed_resources_hash.push_back(-1);
+          continue;
+        }
+        const std::vector<IntVar*>& resource_vars = resource_vars_[rg_index];
+        std::vector<bool> resource_allowed_for_vehicle(resource_group.Size(),
+                                                       true);
+        for (int resource = 0; resource < resource_group.Size(); resource++) {
+          if (!resource_vars[vehicle]->Contains(resource) ||
+              !resource_group.IsResourceAllowedForVehicle(resource, vehicle)) {
+            resource_allowed_for_vehicle[resource] = false;
+          }
+        }
+        allowed_resources_hash.push_back(
+            bool_vec_hash(resource_allowed_for_vehicle));
       }
-      allowed_resources_hash.push_back(
-          bool_vec_hash(resource_allowed_for_vehicle));
+      DCHECK_EQ(allowed_resources_hash.size(), resource_groups_.size());
     }
-    DCHECK_EQ(allowed_resources_hash.size(), resource_groups_.size());
+  };
+  const int num_threads =
+      std::min(parameters.close_model_num_threads(), vehicles_);
+  if (num_threads <= 1) {
+    build_vehicle_classes(0, vehicles_);
+  } else {
+    ThreadPool thread_pool("VehicleClasses", num_threads);
+    thread_pool.StartWorkers();
+    const int vehicles_per_thread =
+        MathUtil::CeilOfRatio(vehicles_, num_threads);
+    for (int begin = 0; begin < vehicles_; begin += vehicles_per_thread) {
+      const int end = std::min(begin + vehicles_per_thread, vehicles_);
+      thread_pool.Schedule([&build_vehicle_classes, begin, end]() {
+        build_vehicle_classes(begin, end);
+      });
+    }
+    // Waits for the threads.
+  }
 
+  vehicle_class_index_of_vehicle_.assign(vehicles_, VehicleClassIndex(-1));
+  absl::flat_hash_map<VehicleClass, VehicleClassIndex> vehicle_class_map;
+  for (int vehicle = 0; vehicle < vehicles(); ++vehicle) {
     const VehicleClassIndex num_vehicle_classes(vehicle_class_map.size());
     vehicle_class_index_of_vehicle_[vehicle] = gtl::LookupOrInsert(
-        &vehicle_class_map, vehicle_class, num_vehicle_classes);
-    }
+        &vehicle_class_map, vehicle_classes[vehicle], num_vehicle_classes);
+  }
   num_vehicle_classes_ = vehicle_class_map.size();
 }
 
@@ -1767,6 +1963,35 @@ void RoutingModel::SetAllowedVehiclesForIndex(const std::vector<int>& vehicles,
   }
 }
 
+void RoutingModel::SetAllowedSuccessorsForIndex(
+    const std::vector<int64_t>& successors, int64_t index) {
+  DCHECK(!closed_);
+  DCHECK_GE(index, 0);
+  DCHECK_LT(index, Size());
+  if (successors.empty() && allowed_successors_per_index_.empty()) return;
+  allowed_successors_per_index_.resize(Size());
+  allowed_successors_per_index_[index] = successors;
+}
+
+void RoutingModel::FinalizeAllowedSuccessors() {
+  if (allowed_successors_per_index_.empty()) return;
+  allowed_successor_offsets_.assign(Size() + 1, 0);
+  for (int64_t index = 0; index < Size(); ++index) {
+    std::vector<int64_t>& successors = allowed_successors_per_index_[index];
+    std::sort(successors.begin(), successors.end());
+    successors.erase(std::unique(successors.begin(), successors.end()),
+                     successors.end());
+    allowed_successor_offsets_[index] = allowed_successors_.size();
+    allowed_successors_.insert(allowed_successors_.end(), successors.begin(),
+                               successors.end());
+    // Frees the per-index vectors as they are compacted.
+    std::vector<int64_t>().swap(successors);
+  }
+  allowed_successor_offsets_[Size()] = allowed_successors_.size();
+  allowed_successors_per_index_.clear();
+  allowed_successors_per_index_.shrink_to_fit();
+}
+
 void RoutingModel::AddPickupAndDelivery(int64_t pickup, int64_t delivery) {
   AddPickupAndDeliverySetsInternal({pickup}, {delivery});
   pickup_delivery_disjunctions_.push_back({kNoDisjunction, kNoDisjunction});
@@ -2204,8 +2429,9 @@ void RoutingModel::CloseModelWithParameters(
   // NOTE: FinalizeAllowedVehicles() must be called *after* calling
   // CloseModel() on dimensions and *before* ComputeVehicleClasses().
   FinalizeAllowedVehicles();
+  FinalizeAllowedSuccessors();
   ComputeCostClasses(parameters);
-  ComputeVehicleClasses();
+  ComputeVehicleClasses(parameters);
   ComputeVehicleTypes();
   ComputeResourceClasses();
   FinalizeVisitTypes();
@@ -2291,6 +2517,13 @@ void RoutingModel::CloseModelWithParameters(
     // Extra constraint to state an active node can't point to itself.
     solver_->AddConstraint(
         solver_->MakeIsDifferentCstCt(nexts_[i], i, active_[i]));
+    const absl::Span<const int64_t> successors = GetAllowedSuccessors(i);
+    if (!successors.empty()) {
+      // The node points to itself when it is unperformed.
+      std::vector<int64_t> values(successors.begin(), successors.end());
+      values.push_back(i);
+      solver_->AddConstraint(solver_->MakeMemberCt(nexts_[i], values));
+    }
   }
 
   // Add constraints to bind vehicle_vars_[i] to -1 in case that node i is not
@@ -3081,25 +3314,11 @@ const Assignment* RoutingModel::SolveWithIteratedLocalSearch(
       parameters, this, best_solution,
       [this]() { return CheckLimit(time_buffer_); }, filter_manager);
 
-  // TODO(user): This lambda can probably be refactored into a function as a
-  // similar version in used in another place.
   const auto update_time_limits = [this, start_time_ms, &parameters]() {
     const absl::Duration elapsed_time =
         absl::Milliseconds(solver_->wall_time() - start_time_ms);
-    const absl::Duration time_left = GetTimeLimit(parameters) - elapsed_time;
-    if (time_left < absl::ZeroDuration()) {
-      return false;
-    }
-    limit_->UpdateLimits(time_left, std::numeric_limits<int64_t>::max(),
-                         std::numeric_limits<int64_t>::max(),
-                         parameters.solution_limit());
-    DCHECK_NE(ls_limit_, nullptr);
-    ls_limit_->UpdateLimits(time_left, std::numeric_limits<int64_t>::max(),
-                            std::numeric_limits<int64_t>::max(), 1);
-    // TODO(user): Come up with a better formula. Ideally this should be
-    // calibrated in the first solution strategies.
-    time_buffer_ = std::min(absl::Seconds(1), time_left * 0.05);
-    return true;
+    return UpdateIteratedLocalSearchLimits(
+        parameters, GetTimeLimit(parameters) - elapsed_time);
   };
 
   std::unique_ptr<NeighborAcceptanceCriterion> acceptance_criterion =
@@ -3141,6 +3360,51 @@ const Assignment* RoutingModel::SolveWithIteratedLocalSearch(
   return best_solution;
 }
 
+const Assignment* RoutingModel::FindIteratedLocalSearchNeighbor(
+    const RoutingSearchParameters& parameters, const Assignment& reference,
+    absl::Duration time_limit) {
+  QuietCloseModelWithParameters(parameters);
+  if (ils_reference_ == nullptr) {
+    ils_reference_ = solver_->MakeAssignment(&reference);
+    ils_perturbation_db_ = MakePerturbationDecisionBuilder(
+        parameters, this, ils_reference_,
+        [this]() { return CheckLimit(time_buffer_); },
+        GetOrCreateLocalSearchFilterManager(parameters,
+                                            {/*filter_objective=*/false,
+                                             /*filter_with_cp_solver=*/false}));
+  } else {
+    ils_reference_->CopyIntersection(&reference);
+  }
+  if (!UpdateIteratedLocalSearchLimits(parameters, time_limit)) return nullptr;
+
+  solver_->Solve(ils_perturbation_db_, monitors_);
+  const Assignment* neighbor = collect_assignments_->last_solution_or_null();
+  if (neighbor == nullptr || !parameters.iterated_local_search_parameters()
+                                  .improve_perturbed_solution()) {
+    return neighbor;
+  }
+  assignment_->CopyIntersection(neighbor);
+  solver_->Solve(improve_db_, monitors_);
+  return collect_assignments_->last_solution_or_null();
+}
+
+bool RoutingModel::UpdateIteratedLocalSearchLimits(
+    const RoutingSearchParameters& parameters, absl::Duration time_left) {
+  if (time_left < absl::ZeroDuration()) {
+    return false;
+  }
+  limit_->UpdateLimits(time_left, std::numeric_limits<int64_t>::max(),
+                       std::numeric_limits<int64_t>::max(),
+                       parameters.solution_limit());
+  DCHECK_NE(ls_limit_, nullptr);
+  ls_limit_->UpdateLimits(time_left, std::numeric_limits<int64_t>::max(),
+                          std::numeric_limits<int64_t>::max(), 1);
+  // TODO(user): Come up with a better formula. Ideally this should be
+  // calibrated in the first solution strategies.
+  time_buffer_ = std::min(absl::Seconds(1), time_left * 0.05);
+  return true;
+}
+
 void RoutingModel::SetAssignmentFromOtherModelAssignment(
     Assignment* target_assignment, const RoutingModel* source_model,
     const Assignment* source_assignment) {
@@ -3441,6 +3705,65 @@ bool RoutingModel::ApplyLocksToAllVehicles(
   return RoutesToAssignment(locks, true, close_routes, preassignment_);
 }
 
+void RoutingModel::SetDynamicNodeActive(int64_t index, bool active) {
+  CHECK_LT(index, Size());
+  CHECK(!IsStart(index));
+  CHECK(!GetDisjunctionIndices(index).empty())
+      << "Only nodes in disjunctions can be deactivated";
+  IntVarElement* element =
+      dynamic_restrictions_->MutableIntVarContainer()->MutableElementOrNull(
+          nexts_[index]);
+  if (element == nullptr) {
+    if (active) return;
+    element = dynamic_restrictions_->Add(nexts_[index]);
+  }
+  if (active) {
+    element->Deactivate();
+  } else {
+    element->Activate();
+    element->SetValue(index);
+  }
+}
+
+bool RoutingModel::IsDynamicNodeActive(int64_t index) const {
+  if (index >= Size()) return true;
+  const IntVarElement* const element =
+      dynamic_restrictions_->IntVarContainer().ElementPtrOrNull(nexts_[index]);
+  return element == nullptr || !element->Activated();
+}
+
+void RoutingModel::SetDynamicCumulRange(const RoutingDimension& dimension,
+                                        int64_t index, int64_t min,
+                                        int64_t max) {
+  CHECK_EQ(dimension.model(), this);
+  IntVar* const cumul = dimension.CumulVar(index);
+  IntVarElement* element =
+      dynamic_restrictions_->MutableIntVarContainer()->MutableElementOrNull(
+          cumul);
+  if (element == nullptr) element = dynamic_restrictions_->Add(cumul);
+  element->Activate();
+  element->SetRange(min, max);
+}
+
+const Assignment* RoutingModel::ReoptimizeWithParameters(
+    const Assignment& solution,
+    const RoutingSearchParameters& search_parameters) {
+  QuietCloseModelWithParameters(search_parameters);
+  std::vector<std::vector<int64_t>> routes;
+  AssignmentToRoutes(solution, &routes);
+  for (std::vector<int64_t>& route : routes) {
+    route.erase(std::remove_if(route.begin(), route.end(),
+                               [this](int64_t index) {
+                                 return !IsDynamicNodeActive(index);
+                               }),
+                route.end());
+  }
+  const Assignment* const start =
+      ReadAssignmentFromRoutes(routes, /*ignore_inactive_indices=*/true);
+  if (start == nullptr) return SolveWithParameters(search_parameters);
+  return SolveFromAssignmentWithParameters(start, search_parameters);
+}
+
 int64_t RoutingModel::GetNumberOfDecisionsInFirstSolution(
     const RoutingSearchParameters& parameters) const {
   IntVarFilteredDecisionBuilder* const decision_builder =
@@ -3676,6 +3999,120 @@ std::vector<std::vector<int64_t>> RoutingModel::GetRoutesFromAssignment(
   }
   return route_indices;
 }
+
+namespace {
+// Returns the position of the element of vars[0] in `container` if the
+// elements of `vars` are stored contiguously and in order from there, as in
+// the assignments built by the model, or -1 otherwise.
+int FindContiguousElements(const Assignment::IntContainer& container,
+                           absl::Span<IntVar* const> vars) {
+  if (vars.empty()) return -1;
+  const IntVarElement* const first_element =
+      container.ElementPtrOrNull(vars[0]);
+  if (first_element == nullptr) return -1;
+  const int start = first_element - &container.Element(0);
+  if (start + static_cast<int64_t>(vars.size()) > container.Size()) return -1;
+  for (int i = 0; i < vars.size(); ++i) {
+    if (container.Element(start + i).Var() != vars[i]) return -1;
+  }
+  return start;
+}
+
+// Copies the values of `vars` in `assignment` to `values`.
+void ReadValues(const Assignment& assignment, absl::Span<IntVar* const> vars,
+                std::vector<int64_t>* values) {
+  values->resize(vars.size());
+  const Assignment::IntContainer& container = assignment.IntVarContainer();
+  const int start = FindContiguousElements(container, vars);
+  if (start < 0) {
+    for (int i = 0; i < vars.size(); ++i) {
+      (*values)[i] = assignment.Value(vars[i]);
+    }
+    return;
+  }
+  for (int i = 0; i < vars.size(); ++i) {
+    (*values)[i] = container.Element(start + i).Value();
+  }
+}
+
+// Sets the values of `vars` in `assignment` to `values`.
+void WriteValues(absl::Span<IntVar* const> vars,
+                 absl::Span<const int64_t> values, Assignment* assignment) {
+  DCHECK_EQ(vars.size(), values.size());
+  Assignment::IntContainer* const container =
+      assignment->MutableIntVarContainer();
+  const int start = FindContiguousElements(*container, vars);
+  for (int i = 0; i < vars.size(); ++i) {
+    IntVarElement* const element =
+        start < 0 ? container->MutableElement(vars[i])
+                  : container->MutableElement(start + i);
+    element->Activate();
+    element->SetValue(values[i]);
+  }
+}
+}  // namespace
+
+void RoutingModel::ExportSolutionSnapshot(const Assignment& assignment,
+                                          SolutionSnapshot* snapshot) const {
+  CHECK(closed_);
+  snapshot->objective_value =
+      assignment.HasObjective() ? assignment.ObjectiveValue() : 0;
+  ReadValues(assignment, nexts_, &snapshot->nexts);
+  // The vehicles are deduced from the nexts rather than read, since the
+  // vehicle variables are not in all the assignments.
+  snapshot->vehicles.assign(Size() + vehicles_, -1);
+  for (int vehicle = 0; vehicle < vehicles_; ++vehicle) {
+    int64_t index = Start(vehicle);
+    while (!IsEnd(index)) {
+      snapshot->vehicles[index] = vehicle;
+      index = snapshot->nexts[index];
+    }
+    snapshot->vehicles[index] = vehicle;
+  }
+  snapshot->cumuls.resize(dimensions_.size());
+  int d = 0;
+  for (const RoutingDimension* const dimension : dimensions_) {
+    const std::vector<IntVar*>& cumuls = dimension->cumuls();
+    if (cumuls.empty() || !assignment.Contains(cumuls[0])) {
+      snapshot->cumuls[d++].clear();
+      continue;
+    }
+    ReadValues(assignment, cumuls, &snapshot->cumuls[d++]);
+  }
+}
+
+const Assignment* RoutingModel::RestoreSolutionSnapshot(
+    const SolutionSnapshot& snapshot) {
+  QuietCloseModel();
+  CHECK(assignment_ != nullptr);
+  CHECK_EQ(snapshot.nexts.size(), Size());
+  WriteValues(nexts_, snapshot.nexts, assignment_);
+  if (!CostsAreHomogeneousAcrossVehicles()) {
+    DCHECK_EQ(snapshot.vehicles.size(), vehicle_vars_.size());
+    std::vector<int64_t> vehicles(snapshot.vehicles.begin(),
+                                  snapshot.vehicles.end());
+    WriteValues(vehicle_vars_, vehicles, assignment_);
+  }
+  return DoRestoreAssignment();
+}
+
+void RoutingModel::SolutionSnapshotToRoutes(
+    const SolutionSnapshot& snapshot,
+    std::vector<std::vector<int64_t>>* routes) const {
+  CHECK(routes != nullptr);
+  CHECK_EQ(snapshot.nexts.size(), Size());
+  routes->resize(vehicles_);
+  for (int vehicle = 0; vehicle < vehicles_; ++vehicle) {
+    std::vector<int64_t>* const vehicle_route = &(*routes)[vehicle];
+    vehicle_route->clear();
+    for (int64_t index = snapshot.nexts[Start(vehicle)]; !IsEnd(index);
+         index = snapshot.nexts[index]) {
+      vehicle_route->push_back(index);
+      CHECK_LE(vehicle_route->size(), Size())
+          << "The snapshot contains a cycle";
+    }
+  }
+}
 #endif
 
 int64_t RoutingModel::GetArcCostForClassInternal(
@@ -3690,9 +4127,20 @@ int64_t RoutingModel::GetArcCostForClassInternal(
       cache->cost_class_index == cost_class_index) {
     return cache->cost;
   }
+  const int64_t cost =
+      ComputeArcCostForClass(from_index, to_index, cost_class_index);
+  *cache = {static_cast<int>(to_index), cost_class_index, cost};
+  return cost;
+}
+
+int64_t RoutingModel::ComputeArcCostForClass(
+    int64_t from_index, int64_t to_index,
+    CostClassIndex cost_class_index) const {
   int64_t cost = 0;
   const CostClass& cost_class = cost_classes_[cost_class_index];
-  const auto& evaluator = transit_evaluators_[cost_class.evaluator_index];
+  const auto evaluator = [this, &cost_class](int64_t i, int64_t j) {
+    return GetTransitValue(cost_class.evaluator_index, i, j);
+  };
   if (!IsStart(from_index)) {
     cost = CapAdd(evaluator(from_index, to_index),
                   GetDimensionTransitCostSum(from_index, to_index, cost_class));
@@ -3714,10 +4162,29 @@ int64_t RoutingModel::GetArcCostForClassInternal(
       cost = 0;
     }
   }
-  *cache = {static_cast<int>(to_index), cost_class_index, cost};
   return cost;
 }
 
+bool RoutingModel::ArcCostsAreFlat() const {
+  // The callback 0 is the stateless ReturnZero registered by the constructor.
+  const auto is_flat = [this](int evaluator_index) {
+    return evaluator_index == 0 ||
+           !flat_transits_[evaluator_index].values.empty();
+  };
+  for (const CostClass& cost_class : cost_classes_) {
+    if (!is_flat(cost_class.evaluator_index)) return false;
+    for (const auto& [transit_evaluator_class, span_cost_coefficient,
+                      unused_slack_cost_coefficient, dimension] :
+         cost_class.dimension_transit_evaluator_class_and_cost_coefficient) {
+      if (span_cost_coefficient != 0 &&
+          !is_flat(dimension->class_evaluators_[transit_evaluator_class])) {
+        return false;
+      }
+    }
+  }
+  return true;
+}
+
 bool RoutingModel::IsVehicleUsed(const Assignment& assignment,
                                  int vehicle) const {
   CHECK_GE(vehicle, 0);
@@ -4275,7 +4742,7 @@ void RoutingModel::CreateNeighborhoodOperators(
           /*add_vehicle_starts_to_neighbors=*/false);
   const auto get_neighbors = [neighbors_by_cost_class, this](
                                  int64_t node,
-                                 int64_t start) -> const std::vector<int>& {
+                                 int64_t start) -> absl::Span<const int> {
     return neighbors_by_cost_class->GetNeighborsOfNodeForCostClass(
         GetCostClassIndexOfVehicle(VehicleIndex(start)).value(), node);
   };
@@ -4814,7 +5281,8 @@ RoutingModel::CreateLocalSearchFilters(
     for (const RoutingDimension* dimension : dimensions_) {
       if (!dimension->HasBreakConstraints()) continue;
       filter_events.push_back(
-          {MakeVehicleBreaksFilter(*this, *dimension), kAccept, priority});
+          {MakeVehicleBreaksFilter(*this, *dimension, path_state_reference),
+           kAccept, priority});
     }
   }
 
@@ -5280,6 +5748,21 @@ void RoutingModel::CreateFirstSolutionDecisionBuilders(
           .cheapest_insertion_first_solution_use_neighbors_ratio_for_initialization();  // NOLINT
   gci_parameters.add_unperformed_entries =
       search_parameters.cheapest_insertion_add_unperformed_entries();
+  // The arc costs can only be computed concurrently without the cost cache,
+  // and if they do not call user callbacks.
+  const bool parallel_gci =
+      search_parameters.cheapest_insertion_first_solution_num_threads() > 1 &&
+      ArcCostsAreFlat();
+  gci_parameters.num_threads =
+      parallel_gci
+          ? search_parameters.cheapest_insertion_first_solution_num_threads()
+          : 1;
+  const auto gci_evaluator = [this, parallel_gci](int64_t i, int64_t j,
+                                                  int64_t vehicle) {
+    if (!parallel_gci) return GetArcCostForVehicle(i, j, vehicle);
+    if (i == j || vehicle < 0) return int64_t{0};
+    return ComputeArcCostForClass(i, j, GetCostClassIndexOfVehicle(vehicle));
+  };
   for (bool is_sequential : {false, true}) {
     FirstSolutionStrategy::Value first_solution_strategy =
         is_sequential ? FirstSolutionStrategy::SEQUENTIAL_CHEAPEST_INSERTION
@@ -5289,9 +5772,7 @@ void RoutingModel::CreateFirstSolutionDecisionBuilders(
     first_solution_filtered_decision_builders_[first_solution_strategy] =
         CreateIntVarFilteredDecisionBuilder<
             GlobalCheapestInsertionFilteredHeuristic>(
-            [this](int64_t i, int64_t j, int64_t vehicle) {
-              return GetArcCostForVehicle(i, j, vehicle);
-            },
+            gci_evaluator,
             [this](int64_t i) { return UnperformedPenaltyOrValue(0, i); },
             GetOrCreateLocalSearchFilterManager(
                 search_parameters, {/*filter_objective=*/false,
@@ -5300,9 +5781,7 @@ void RoutingModel::CreateFirstSolutionDecisionBuilders(
     IntVarFilteredDecisionBuilder* const strong_gci =
         CreateIntVarFilteredDecisionBuilder<
             GlobalCheapestInsertionFilteredHeuristic>(
-            [this](int64_t i, int64_t j, int64_t vehicle) {
-              return GetArcCostForVehicle(i, j, vehicle);
-            },
+            gci_evaluator,
             [this](int64_t i) { return UnperformedPenaltyOrValue(0, i); },
             GetOrCreateLocalSearchFilterManager(
                 search_parameters, {/*filter_objective=*/false,
@@ -5398,6 +5877,16 @@ void RoutingModel::CreateFirstSolutionDecisionBuilders(
       search_parameters.savings_add_reverse_arcs();
   savings_parameters.arc_coefficient =
       search_parameters.savings_arc_coefficient();
+  // As for the global cheapest insertion, the savings can only be computed
+  // concurrently without the cost cache and user callbacks.
+  if (search_parameters.savings_num_threads() > 1 && ArcCostsAreFlat()) {
+    savings_parameters.num_threads = search_parameters.savings_num_threads();
+    savings_parameters.arc_cost_for_class = [this](int64_t i, int64_t j,
+                                                   int64_t cost_class) {
+      if (i == j) return int64_t{0};
+      return ComputeArcCostForClass(i, j, CostClassIndex(cost_class));
+    };
+  }
   LocalSearchFilterManager* filter_manager = nullptr;
   if (!search_parameters.use_unfiltered_first_solution_strategy()) {
     filter_manager = GetOrCreateLocalSearchFilterManager(
@@ -5605,8 +6094,11 @@ void RoutingModel::SetupDecisionBuilders(
     solve_db_ = CreatePrimaryLocalSearchDecisionBuilder(search_parameters);
   }
   CHECK(preassignment_ != nullptr);
+  DecisionBuilder* restore_dynamic_restrictions =
+      solver_->MakeRestoreAssignment(dynamic_restrictions_);
   DecisionBuilder* restore_preassignment =
-      solver_->MakeRestoreAssignment(preassignment_);
+      solver_->Compose(solver_->MakeRestoreAssignment(preassignment_),
+                       restore_dynamic_restrictions);
   solve_db_ = solver_->Compose(restore_preassignment, solve_db_);
 
   improve_db_ =
@@ -5622,6 +6114,7 @@ void RoutingModel::SetupDecisionBuilders(
   secondary_ls_db_ = solver_->Compose(restore_preassignment, secondary_ls_db_);
 
   restore_assignment_ = solver_->Compose(
+      restore_dynamic_restrictions,
       solver_->MakeRestoreAssignment(GetOrCreateAssignment()),
       CreateSolutionFinalizer(search_parameters,
                               GetOrCreateLargeNeighborhoodSearchLimit()));
@@ -6439,7 +6932,8 @@ void RoutingDimension::CloseModel(bool use_light_propagation) {
 int64_t RoutingDimension::GetTransitValue(int64_t from_index, int64_t to_index,
                                           int64_t vehicle) const {
   DCHECK(transit_evaluator(vehicle) != nullptr);
-  return transit_evaluator(vehicle)(from_index, to_index);
+  return model_->GetTransitValue(class_evaluators_[vehicle_to_class_[vehicle]],
+                                 from_index, to_index);
 }
 
 bool RoutingDimension::AllTransitEvaluatorSignsAreUnknown() const {
@@ -253,6 +253,15 @@ class PathsMetadata {
   std::vector<int64_t> path_of_node_;
 };
 
+#ifndef SWIG
+// The CP-SAT model built from a RoutingModel by SolveModelWithSat(), defined
+// in routing_sat.cc.
+struct RoutingSatModelCache;
+struct RoutingSatModelCacheDeleter {
+  void operator()(RoutingSatModelCache* cache) const;
+};
+#endif  // SWIG
+
 class RoutingModel {
  public:
   /// Status of the search.
@@ -662,6 +671,22 @@ class RoutingModel {
     CHECK_LT(callback_index, transit_evaluators_.size());
     return transit_evaluators_[callback_index];
   }
+  /// Returns TransitCallback(callback_index)(from_index, to_index). The
+  /// transits registered with RegisterTransitMatrix() or
+  /// RegisterUnaryTransitVector(), and all of them when callbacks are cached
+  /// (see RoutingModelParameters.max_callback_cache_size), are stored in flat
+  /// arrays which this reads directly, without going through a std::function.
+  /// Prefer it to TransitCallback() in inner loops.
+  int64_t GetTransitValue(int callback_index, int64_t from_index,
+                          int64_t to_index) const {
+    DCHECK_LT(callback_index, flat_transits_.size());
+    const FlatTransits& flat = flat_transits_[callback_index];
+    if (flat.values.empty()) {
+      return transit_evaluators_[callback_index](from_index, to_index);
+    }
+    return flat.values[flat.row_offsets[from_index] +
+                       flat.col_offsets[to_index]];
+  }
   const TransitCallback1& UnaryTransitCallbackOrNull(int callback_index) const {
     CHECK_LT(callback_index, unary_transit_evaluators_.size());
     return unary_transit_evaluators_[callback_index];
@@ -965,6 +990,29 @@ class RoutingModel {
                allowed_vehicles_[index].end();
   }
 
+  /// Sets the indices which can follow a given (non-end) node on its route,
+  /// for sparse models where each node only has a few possible successors.
+  /// The node can still be unperformed, i.e. followed by itself, and it can
+  /// only be the last node of a route if `successors` contains vehicle ends.
+  /// Specifying an empty vector has no effect (all the indices can follow the
+  /// node). Must be called before the model is closed.
+  /// The successors restrict the domains of the next variables, and are the
+  /// candidate neighbors of the nodes (see GetOrCreateNodeNeighborsByCostClass)
+  /// unless NodeNeighborsOptions::candidates is set, so that the neighbors are
+  /// computed in time proportional to the number of allowed arcs.
+  void SetAllowedSuccessorsForIndex(const std::vector<int64_t>& successors,
+                                    int64_t index);
+  /// Returns the indices which can follow a given node, by increasing index,
+  /// or an empty span if any index can. Only valid once the model is closed.
+  absl::Span<const int64_t> GetAllowedSuccessors(int64_t index) const {
+    DCHECK(closed_);
+    if (allowed_successor_offsets_.empty()) return {};
+    return absl::MakeConstSpan(allowed_successors_)
+        .subspan(allowed_successor_offsets_[index],
+                 allowed_successor_offsets_[index + 1] -
+                     allowed_successor_offsets_[index]);
+  }
+
   /// Notifies that index1 and index2 form a pair of nodes which should belong
   /// to the same route. This methods helps the search find better solutions,
   /// especially in the local search phase.
@@ -1347,6 +1395,17 @@ class RoutingModel {
   /// approach.
   const Assignment* SolveWithIteratedLocalSearch(
       const RoutingSearchParameters& search_parameters);
+#ifndef SWIG
+  /// Runs a single iteration of the Iterated Local Search of
+  /// SolveWithIteratedLocalSearch() from "reference", an assignment of this
+  /// model which is copied before any search: perturbs it and, if the
+  /// parameters ask for it, improves the perturbed solution. Returns the
+  /// neighbor found, owned by the model, or nullptr if none was found within
+  /// "time_limit". The acceptance of the neighbor is left to the caller.
+  const Assignment* FindIteratedLocalSearchNeighbor(
+      const RoutingSearchParameters& search_parameters,
+      const Assignment& reference, absl::Duration time_limit);
+#endif  // SWIG
   /// Given a "source_model" and its "source_assignment", resets
   /// "target_assignment" with the IntVar variables (nexts_, and vehicle_vars_
   /// if costs aren't homogeneous across vehicles) of "this" model, with the
@@ -1394,6 +1453,33 @@ class RoutingModel {
   /// already been driven in online routing problems.
   const Assignment* PreAssignment() const { return preassignment_; }
   Assignment* MutablePreAssignment() { return preassignment_; }
+  /// Dynamic routing: rather than rebuilding the model each time an order
+  /// arrives or is cancelled, the model can be built once with a pool of nodes
+  /// in disjunctions, which are then activated, deactivated or restricted
+  /// between searches. The restrictions apply to all the following searches,
+  /// including the restoration of assignments, until they are changed, and
+  /// ReoptimizeWithParameters() updates a solution to them.
+  ///
+  /// Sets whether "index", which must belong to a disjunction, can be active
+  /// in the next searches. All the nodes can be active by default.
+  void SetDynamicNodeActive(int64_t index, bool active);
+  bool IsDynamicNodeActive(int64_t index) const;
+  /// Restricts the cumul of "index" in "dimension" to [min, max] in the next
+  /// searches, e.g. to update a time window. The restriction is intersected
+  /// with the domain of the cumul in the model, which must thus be built with
+  /// the widest windows.
+  void SetDynamicCumulRange(const RoutingDimension& dimension, int64_t index,
+                            int64_t min, int64_t max);
+  /// Re-optimizes "solution" after dynamic changes: removes the nodes which
+  /// can no longer be active from its routes and improves it with the local
+  /// search of "search_parameters", which inserts the newly active nodes and
+  /// should have a time limit to bound the update latency. Falls back to a
+  /// search from scratch if the routes are no longer feasible, e.g. after a
+  /// time window update. The solution is read before any search, so it can be
+  /// an assignment returned by the model.
+  const Assignment* ReoptimizeWithParameters(
+      const Assignment& solution,
+      const RoutingSearchParameters& search_parameters);
   /// Writes the current solution to a file containing an AssignmentProto.
   /// Returns false if the file cannot be opened or if there is no current
   /// solution.
@@ -1444,6 +1530,35 @@ class RoutingModel {
 #ifndef SWIG
   std::vector<std::vector<int64_t>> GetRoutesFromAssignment(
       const Assignment& assignment);
+  /// A compact copy of a solution, as arrays indexed by variable index, which
+  /// is much cheaper to copy and to keep than an Assignment, e.g. in a pool of
+  /// solutions. It only depends on the variable indices, so it can also move a
+  /// solution between models with the same indices.
+  struct SolutionSnapshot {
+    int64_t objective_value = 0;
+    /// nexts[i] is the value of NextVar(i), for i < Size().
+    std::vector<int64_t> nexts;
+    /// vehicles[i] is the vehicle serving i, or -1 if i is inactive, for
+    /// i < Size() + vehicles().
+    std::vector<int> vehicles;
+    /// cumuls[d][i] is the value of the i-th cumul of GetDimensions()[d], for
+    /// i < Size() + vehicles(), or empty if the cumuls of the dimension were
+    /// not in the exported assignment.
+    std::vector<std::vector<int64_t>> cumuls;
+  };
+  /// Exports the solution in the given assignment to "snapshot", reusing its
+  /// memory. The assignment must contain all the next variables; the solutions
+  /// returned by the model are read without any hash lookup.
+  void ExportSolutionSnapshot(const Assignment& assignment,
+                              SolutionSnapshot* snapshot) const;
+  /// Restores the solution of "snapshot" from its nexts, as with
+  /// RestoreAssignment(). Returns nullptr if it is not a solution of the model.
+  const Assignment* RestoreSolutionSnapshot(const SolutionSnapshot& snapshot);
+  /// Converts the solution of "snapshot" to routes, e.g. to warm start a search
+  /// with ReadAssignmentFromRoutes(); see AssignmentToRoutes().
+  void SolutionSnapshotToRoutes(
+      const SolutionSnapshot& snapshot,
+      std::vector<std::vector<int64_t>>* routes) const;
 #endif
   /// Returns a compacted version of the given assignment, in which all vehicles
   /// with id lower or equal to some N have non-empty routes, and all vehicles
@@ -1553,24 +1668,51 @@ class RoutingModel {
     NodeNeighborsByCostClass() = default;
 
     /// Computes num_neighbors neighbors of all nodes for every cost class in
-    /// routing_model.
+    /// routing_model, with the options given to SetNodeNeighborsOptions().
     void ComputeNeighbors(const RoutingModel& routing_model, int num_neighbors,
                           bool add_vehicle_starts_to_neighbors);
     /// Returns the neighbors of the given node for the given cost_class.
-    const std::vector<int>& GetNeighborsOfNodeForCostClass(
+    absl::Span<const int> GetNeighborsOfNodeForCostClass(
         int cost_class, int node_index) const {
-      return all_nodes_.empty() ? node_index_to_neighbors_by_cost_class_
-                                      [node_index][cost_class]
-                                          ->PositionsSetAtLeastOnce()
-                                : all_nodes_;
+      if (full_neighborhood_) return all_nodes_;
+      const int list = node_index * num_cost_classes_ + cost_class;
+      return absl::MakeConstSpan(neighbors_.data() + offsets_[list],
+                                 offsets_[list + 1] - offsets_[list]);
     }
 
    private:
-    std::vector<std::vector<std::unique_ptr<SparseBitset<int>>>>
-        node_index_to_neighbors_by_cost_class_;
+    bool full_neighborhood_ = false;
+    int num_cost_classes_ = 0;
+    // The neighbors of the node i for the cost class c are
+    // neighbors_[offsets_[l], offsets_[l + 1]) with l = i * num_cost_classes_ +
+    // c.
+    std::vector<int> neighbors_;
+    std::vector<int64_t> offsets_;
     std::vector<int> all_nodes_;
   };
 
+#ifndef SWIG
+  /// Options of the computation of the neighbors of the nodes by
+  /// GetOrCreateNodeNeighborsByCostClass().
+  struct NodeNeighborsOptions {
+    /// If not empty, candidates[i] lists the candidate neighbors of the node
+    /// of index i, without duplicates, for all i < Size(). The closest
+    /// neighbors of a node are then its candidates with the smallest arc
+    /// costs, instead of the nodes with the smallest arc costs among all the
+    /// nodes, which requires computing all the arc costs. The candidates can
+    /// for instance be the nearest nodes by coordinates, as returned by
+    /// FindNearestNeighbors2D() (see routing_utils.h).
+    std::vector<std::vector<int>> candidates;
+    /// Number of threads on which the cost classes are processed. More than
+    /// one thread is only used if the arc costs are all read from matrices,
+    /// vectors or cached callbacks.
+    int num_threads = 1;
+  };
+  /// Sets the options of the neighbor computations. Calling this method after
+  /// the routing model has been closed has no effect.
+  void SetNodeNeighborsOptions(NodeNeighborsOptions options);
+#endif  // SWIG
+
   /// Returns neighbors of all nodes for every cost class. The result is cached
   /// and is computed once. The number of neighbors considered is based on a
   /// ratio of non-vehicle nodes, specified by neighbors_ratio, with a minimum
@@ -1832,6 +1974,15 @@ class RoutingModel {
       const RoutingSearchParameters& search_parameters) const;
   int64_t GetNumberOfRejectsInFirstSolution(
       const RoutingSearchParameters& search_parameters) const;
+  /// Returns statistics on the local search operators and filters of all the
+  /// searches run so far by the model: per operator, the number of neighbors
+  /// generated, accepted by the filters and accepted by the solver, and the
+  /// time spent, with a breakdown of the calls, rejects and time of each filter
+  /// on its neighbors. Only filled when local search profiling is enabled, e.g.
+  /// by RoutingModelParameters.solver_parameters.profile_local_search.
+  LocalSearchStatistics GetLocalSearchStatistics() const {
+    return solver_->GetLocalSearchStatistics();
+  }
   /// Returns the automatic first solution strategy selected.
   operations_research::FirstSolutionStrategy::Value
   GetAutomaticFirstSolutionStrategy() const {
@@ -2045,9 +2196,10 @@ class RoutingModel {
   /// dimension, this node cannot be served by this vehicle and the latter is
   /// thus removed from allowed_vehicles_[node].
   void FinalizeAllowedVehicles();
+  void FinalizeAllowedSuccessors();
 
   void ComputeCostClasses(const RoutingSearchParameters& parameters);
-  void ComputeVehicleClasses();
+  void ComputeVehicleClasses(const RoutingSearchParameters& parameters);
   /// The following method initializes the vehicle_type_container_:
   /// - Computes the vehicle types of vehicles and stores it in
   ///   type_index_of_vehicle.
@@ -2072,6 +2224,13 @@ class RoutingModel {
   void TopologicallySortVisitTypes();
   int64_t GetArcCostForClassInternal(int64_t from_index, int64_t to_index,
                                      CostClassIndex cost_class_index) const;
+  // Same as GetArcCostForClassInternal() without the cost cache. Thread-safe
+  // if ArcCostsAreFlat().
+  int64_t ComputeArcCostForClass(int64_t from_index, int64_t to_index,
+                                 CostClassIndex cost_class_index) const;
+  // Returns true if all the transits involved in the arc costs are read from
+  // flat arrays, and not from user callbacks (see FlatTransits).
+  bool ArcCostsAreFlat() const;
   void AppendHomogeneousArcCosts(const RoutingSearchParameters& parameters,
                                  int node_index,
                                  std::vector<IntVar*>* cost_elements);
@@ -2113,6 +2272,11 @@ class RoutingModel {
   bool ReplaceUnusedVehicle(int unused_vehicle, int active_vehicle,
                             Assignment* compact_assignment) const;
 
+  /// Sets the limits of the searches of an Iterated Local Search iteration to
+  /// "time_left". Returns false if there is no time left.
+  bool UpdateIteratedLocalSearchLimits(
+      const RoutingSearchParameters& parameters, absl::Duration time_left);
+
   void QuietCloseModel();
   void QuietCloseModelWithParameters(
       const RoutingSearchParameters& parameters) {
@@ -2169,7 +2333,7 @@ class RoutingModel {
   LocalSearchOperator* CreateCPOperator() {
     return CreateCPOperator(MakeLocalSearchOperator<T>);
   }
-  using NeighborAccessor = std::function<const std::vector<int>&(int, int)>;
+  using NeighborAccessor = std::function<absl::Span<const int>(int, int)>;
   template <class T>
   LocalSearchOperator* CreateCPOperatorWithNeighbors(
       NeighborAccessor get_neighbors) {
@@ -2424,6 +2588,13 @@ class RoutingModel {
   /// Allowed vehicles
 #ifndef SWIG
   std::vector<absl::flat_hash_set<int>> allowed_vehicles_;
+  // The successors set by SetAllowedSuccessorsForIndex(), per index until the
+  // model is closed (empty if none was set), and then in compressed sparse row
+  // form: the successors of index i are allowed_successors_[
+  // allowed_successor_offsets_[i], allowed_successor_offsets_[i + 1]).
+  std::vector<std::vector<int64_t>> allowed_successors_per_index_;
+  std::vector<int64_t> allowed_successor_offsets_;
+  std::vector<int64_t> allowed_successors_;
 #endif  // SWIG
   /// Pickup and delivery
   std::vector<PickupDeliveryPair> pickup_delivery_pairs_;
@@ -2534,6 +2705,9 @@ class RoutingModel {
   DecisionBuilder* restore_tmp_assignment_ = nullptr;
   Assignment* assignment_ = nullptr;
   Assignment* preassignment_ = nullptr;
+  // Restrictions of SetDynamicNodeActive() and SetDynamicCumulRange(), restored
+  // with the preassignment.
+  Assignment* dynamic_restrictions_ = nullptr;
   Assignment* tmp_assignment_ = nullptr;
   LocalSearchOperator* primary_ls_operator_ = nullptr;
   LocalSearchOperator* secondary_ls_operator_ = nullptr;
@@ -2561,6 +2735,9 @@ class RoutingModel {
   absl::flat_hash_map<NodeNeighborsParameters,
                       std::unique_ptr<NodeNeighborsByCostClass>>
       node_neighbors_by_cost_class_per_size_;
+#ifndef SWIG
+  NodeNeighborsOptions node_neighbors_options_;
+#endif  // SWIG
   std::unique_ptr<FinalizerVariables> finalizer_variables_;
 #ifndef SWIG
   std::unique_ptr<SweepArranger> sweep_arranger_;
@@ -2572,9 +2749,21 @@ class RoutingModel {
   RegularLimit* lns_limit_ = nullptr;
   RegularLimit* first_solution_lns_limit_ = nullptr;
   absl::Duration time_buffer_;
+#ifndef SWIG
+  // Reference solution and perturbation of FindIteratedLocalSearchNeighbor(),
+  // created by its first call.
+  Assignment* ils_reference_ = nullptr;
+  DecisionBuilder* ils_perturbation_db_ = nullptr;
+#endif  // SWIG
 
   std::atomic<bool> interrupt_cp_sat_;
   std::atomic<bool> interrupt_cp_;
+#ifndef SWIG
+  // The CP-SAT model of the routing model, built by the first call to
+  // SolveModelWithSat() and reused by the next ones.
+  std::unique_ptr<RoutingSatModelCache, RoutingSatModelCacheDeleter>
+      sat_model_cache_;
+#endif  // SWIG
 
   typedef std::pair<int64_t, int64_t> CacheKey;
   typedef absl::flat_hash_map<CacheKey, int64_t> TransitCallbackCache;
@@ -2592,6 +2781,21 @@ class RoutingModel {
   std::vector<TransitCallback1> unary_transit_evaluators_;
   std::vector<TransitCallback2> transit_evaluators_;
   std::vector<TransitEvaluatorSign> transit_evaluator_sign_;
+  // Flat copies of the transits of some of the callbacks, empty for the
+  // others, see GetTransitValue(). The transit from the index i to the index j
+  // is values[row_offsets[i] + col_offsets[j]], which covers matrices indexed
+  // by node, caches indexed by index and unary vectors (with zero column
+  // offsets) without branching.
+  struct FlatTransits {
+    std::vector<int64_t> values;
+    std::vector<int64_t> row_offsets;
+    std::vector<int64_t> col_offsets;
+  };
+  std::vector<FlatTransits> flat_transits_;
+  // Registers a callback reading the given flat transits, unary if
+  // `is_unary`, in which case the column offsets must all be zero.
+  int RegisterFlatTransits(FlatTransits flat_transits, bool is_unary,
+                           TransitEvaluatorSign sign);
 
   std::vector<VariableIndexEvaluator2> state_dependent_transit_evaluators_;
   std::vector<std::unique_ptr<StateDependentTransitCallbackCache>>
@@ -2603,6 +2807,9 @@ class RoutingModel {
   friend class RoutingDimension;
   friend class RoutingModelInspector;
   friend class ResourceGroup::Resource;
+#ifndef SWIG
+  friend struct RoutingSatModelCache;
+#endif  // SWIG
 };
 
 /// Routing model visitor.
@@ -3052,8 +3259,8 @@ class RoutingDimension {
   /// vehicle (the class of a vehicle can be obtained with vehicle_to_class()).
   int64_t GetTransitValueFromClass(int64_t from_index, int64_t to_index,
                                    int64_t vehicle_class) const {
-    return model_->TransitCallback(class_evaluators_[vehicle_class])(from_index,
-                                                                     to_index);
+    return model_->GetTransitValue(class_evaluators_[vehicle_class], from_index,
+                                   to_index);
   }
   /// Get the cumul, transit and slack variables for the given node (given as
   /// int64_t var index).
@@ -3126,6 +3333,13 @@ class RoutingDimension {
         class_evaluators_[vehicle_to_class_[vehicle]]);
   }
 
+  /// Returns the index of the callback evaluating the transit value between two
+  /// node indices for a given vehicle, e.g. to be used with
+  /// RoutingModel::GetTransitValue().
+  int transit_evaluator_index(int vehicle) const {
+    return class_evaluators_[vehicle_to_class_[vehicle]];
+  }
+
   /// Returns the callback evaluating the transit value between two node indices
   /// for a given vehicle class.
   const RoutingModel::TransitCallback2& class_transit_evaluator(
@@ -3601,14 +3815,29 @@ class RoutingDimension {
 /// solve the TSP corresponding to the model if it has a single vehicle.
 /// Therefore the resulting solution might not actually be feasible. Will return
 /// false if a solution could not be found.
+/// The CP-SAT model is built by the first call on a (closed) model, and reused
+/// by the next ones, which only change its hint (initial_solution).
 bool SolveModelWithSat(RoutingModel* model,
                        const RoutingSearchParameters& search_parameters,
                        const Assignment* initial_solution,
                        Assignment* solution);
 
+/// Same as SolveModelWithSat(), but only the next variables of the nodes in
+/// `relaxed_nodes` can change: the others keep their value in
+/// `initial_solution`, which must not be null. This solves the sub-problem of
+/// re-routing a few nodes, or a few routes when `relaxed_nodes` contains all
+/// their nodes, on the cached CP-SAT model of `model`.
+bool SolveModelWithSatAroundSolution(
+    RoutingModel* model, const RoutingSearchParameters& search_parameters,
+    const Assignment* initial_solution, absl::Span<const int64_t> relaxed_nodes,
+    Assignment* solution);
+
 #if !defined(SWIG)
-IntVarLocalSearchFilter* MakeVehicleBreaksFilter(
-    const RoutingModel& routing_model, const RoutingDimension& dimension);
+/// Returns a filter checking the break constraints of dimension on the paths
+/// changed in path_state, which must have one path per vehicle.
+LocalSearchFilter* MakeVehicleBreaksFilter(const RoutingModel& routing_model,
+                                           const RoutingDimension& dimension,
+                                           const PathState* path_state);
 #endif
 
 }  // namespace operations_research
@@ -973,21 +973,48 @@ void GlobalVehicleBreaksConstraint::PropagateVehicle(int vehicle) {
 }
 
 namespace {
-class VehicleBreaksFilter : public BasePathFilter {
+// Checks break constraints on the paths changed by a candidate, using the
+// chains of a PathState shared with other filters.
+// Two things make this filter cheaper than a full propagation per path:
+// - the travel bounds of the arcs of committed paths are cached, and only the
+//   arcs between chains, which were changed by the candidate, are evaluated;
+// - the breaks that must be performed between the latest start and the
+//   earliest end of a route are known in advance, so that paths that are too
+//   long to fit their own travels and those breaks are rejected without
+//   propagation.
+class VehicleBreaksFilter : public LocalSearchFilter {
  public:
   VehicleBreaksFilter(const RoutingModel& routing_model,
-                      const RoutingDimension& dimension);
+                      const RoutingDimension& dimension,
+                      const PathState* path_state);
   std::string DebugString() const override { return "VehicleBreaksFilter"; }
-  bool AcceptPath(int64_t path_start, int64_t chain_start,
-                  int64_t chain_end) override;
+  bool Accept(const Assignment* delta, const Assignment* deltadelta,
+              int64_t objective_min, int64_t objective_max) override;
+  void Synchronize(const Assignment* assignment,
+                   const Assignment* delta) override;
 
  private:
-  // Fills path_ with the path of vehicle, start to end.
-  void FillPathOfVehicle(int64_t vehicle);
+  struct Travel {
+    int64_t min_travel;
+    int64_t pre_travel;
+    int64_t post_travel;
+  };
+  // Returns the travel bounds of arc from -> to for the given vehicle.
+  Travel ComputeTravel(int vehicle, int64_t from, int64_t to) const;
+  // Computes the travel bounds of all arcs of the committed path of vehicle.
+  void CacheCommittedTravelsOfVehicle(int vehicle);
+  // Fills path_ and travel_bounds_ with the current path of vehicle, start to
+  // end, reusing the cached travels of arcs that are inside committed chains.
+  // Returns the sum of min travels of the path.
+  int64_t FillPathAndTravelBoundsOfVehicle(int vehicle);
+  // Runs the disjunctive propagator on path_ and the breaks of vehicle.
+  bool PropagateBreaksOfVehicle(int vehicle);
+
   std::vector<int64_t> path_;
   // Handles to model.
   const RoutingModel& model_;
   const RoutingDimension& dimension_;
+  const PathState* const path_state_;
   // Strong energy-based filtering algorithm.
   DisjunctivePropagator disjunctive_propagator_;
   DisjunctivePropagator::Tasks tasks_;
@@ -997,43 +1024,113 @@ class VehicleBreaksFilter : public BasePathFilter {
   std::vector<int64_t> old_end_min_;
   std::vector<int64_t> old_end_max_;
 
-  std::vector<int> start_to_vehicle_;
   TravelBounds travel_bounds_;
+  // Travel from a node to its next in the committed paths, indexed by node.
+  std::vector<Travel> committed_travel_from_;
+  // Per vehicle, whether it has break intervals or break distance duration
+  // constraints.
+  std::vector<bool> vehicle_has_breaks_;
+  // Per vehicle, sum of minimal durations of the breaks that must be performed
+  // between the latest start and the earliest end of the route. Those breaks
+  // fall inside the route whatever its schedule.
+  std::vector<int64_t> vehicle_min_duration_of_inner_breaks_;
+  // Per vehicle, maximal span of the route allowed by the cumuls of its start
+  // and end and by its span upper bound.
+  std::vector<int64_t> vehicle_max_span_;
 };
 
 VehicleBreaksFilter::VehicleBreaksFilter(const RoutingModel& routing_model,
-                                         const RoutingDimension& dimension)
-    : BasePathFilter(routing_model.Nexts(),
-                     routing_model.Size() + routing_model.vehicles()),
-      model_(routing_model),
-      dimension_(dimension) {
+                                         const RoutingDimension& dimension,
+                                         const PathState* path_state)
+    : model_(routing_model), dimension_(dimension), path_state_(path_state) {
   DCHECK(dimension_.HasBreakConstraints());
-  start_to_vehicle_.resize(Size(), -1);
-  for (int i = 0; i < routing_model.vehicles(); ++i) {
-    start_to_vehicle_[routing_model.Start(i)] = i;
+  DCHECK_EQ(path_state_->NumPaths(), routing_model.vehicles());
+  const int num_vehicles = routing_model.vehicles();
+  vehicle_has_breaks_.assign(num_vehicles, false);
+  vehicle_min_duration_of_inner_breaks_.assign(num_vehicles, 0);
+  vehicle_max_span_.assign(num_vehicles, std::numeric_limits<int64_t>::max());
+  committed_travel_from_.assign(path_state_->NumNodes(), {0, 0, 0});
+  for (int vehicle = 0; vehicle < num_vehicles; ++vehicle) {
+    const auto& breaks = dimension_.GetBreakIntervalsOfVehicle(vehicle);
+    if (breaks.empty() &&
+        dimension_.GetBreakDistanceDurationOfVehicle(vehicle).empty()) {
+      continue;
+    }
+    vehicle_has_breaks_[vehicle] = true;
+    const IntVar* start_cumul = dimension_.CumulVar(model_.Start(vehicle));
+    const IntVar* end_cumul = dimension_.CumulVar(model_.End(vehicle));
+    int64_t min_duration = 0;
+    for (const IntervalVar* interval : breaks) {
+      if (!interval->MustBePerformed()) continue;
+      if (interval->StartMin() < start_cumul->Max()) continue;
+      if (interval->EndMax() > end_cumul->Min()) continue;
+      min_duration = CapAdd(min_duration, interval->DurationMin());
+    }
+    vehicle_min_duration_of_inner_breaks_[vehicle] = min_duration;
+    vehicle_max_span_[vehicle] =
+        std::min(CapSub(end_cumul->Max(), start_cumul->Min()),
+                 dimension_.GetSpanUpperBoundForVehicle(vehicle));
+    CacheCommittedTravelsOfVehicle(vehicle);
   }
 }
 
-void VehicleBreaksFilter::FillPathOfVehicle(int64_t vehicle) {
-  path_.clear();
-  int current = model_.Start(vehicle);
-  while (!model_.IsEnd(current)) {
-    path_.push_back(current);
-    current = GetNext(current);
+VehicleBreaksFilter::Travel VehicleBreaksFilter::ComputeTravel(
+    int vehicle, int64_t from, int64_t to) const {
+  const int pre_travel_index =
+      dimension_.GetPreTravelEvaluatorOfVehicle(vehicle);
+  const int post_travel_index =
+      dimension_.GetPostTravelEvaluatorOfVehicle(vehicle);
+  return {dimension_.transit_evaluator(vehicle)(from, to),
+          pre_travel_index == -1
+              ? 0
+              : model_.TransitCallback(pre_travel_index)(from, to),
+          post_travel_index == -1
+              ? 0
+              : model_.TransitCallback(post_travel_index)(from, to)};
+}
+
+void VehicleBreaksFilter::CacheCommittedTravelsOfVehicle(int vehicle) {
+  int64_t prev_node = -1;
+  for (const int node : path_state_->Nodes(vehicle)) {
+    if (prev_node != -1) {
+      committed_travel_from_[prev_node] =
+          ComputeTravel(vehicle, prev_node, node);
+    }
+    prev_node = node;
   }
-  path_.push_back(current);
 }
 
-bool VehicleBreaksFilter::AcceptPath(int64_t path_start, int64_t chain_start,
-                                     int64_t chain_end) {
-  const int vehicle = start_to_vehicle_[path_start];
-  if (dimension_.GetBreakIntervalsOfVehicle(vehicle).empty() &&
-      dimension_.GetBreakDistanceDurationOfVehicle(vehicle).empty()) {
-    return true;
+int64_t VehicleBreaksFilter::FillPathAndTravelBoundsOfVehicle(int vehicle) {
+  path_.clear();
+  travel_bounds_.min_travels.clear();
+  travel_bounds_.pre_travels.clear();
+  travel_bounds_.post_travels.clear();
+  int64_t total_min_travel = 0;
+  int64_t prev_node = -1;
+  for (const auto chain : path_state_->Chains(vehicle)) {
+    // Arcs inside a chain that was already on this path are committed arcs of
+    // this vehicle, their travels are cached.
+    const bool chain_was_on_path = path_state_->Path(chain.First()) == vehicle;
+    for (const int node : chain) {
+      if (prev_node != -1) {
+        const Travel travel = chain_was_on_path && node != chain.First()
+                                  ? committed_travel_from_[prev_node]
+                                  : ComputeTravel(vehicle, prev_node, node);
+        travel_bounds_.min_travels.push_back(travel.min_travel);
+        travel_bounds_.pre_travels.push_back(travel.pre_travel);
+        travel_bounds_.post_travels.push_back(travel.post_travel);
+        total_min_travel = CapAdd(total_min_travel, travel.min_travel);
+      }
+      path_.push_back(node);
+      prev_node = node;
+    }
   }
-  // Fill path and pre/post travel information.
-  FillPathOfVehicle(vehicle);
-  FillTravelBoundsOfVehicle(vehicle, path_, dimension_, &travel_bounds_);
+  travel_bounds_.max_travels.assign(travel_bounds_.min_travels.size(),
+                                    std::numeric_limits<int64_t>::max());
+  return total_min_travel;
+}
+
+bool VehicleBreaksFilter::PropagateBreaksOfVehicle(int vehicle) {
   // Fill tasks from path, forbidden intervals, breaks and break constraints.
   tasks_.Clear();
   AppendTasksFromPath(path_, travel_bounds_, dimension_, &tasks_);
@@ -1076,12 +1173,40 @@ bool VehicleBreaksFilter::AcceptPath(int64_t path_start, int64_t chain_start,
   return is_feasible;
 }
 
+bool VehicleBreaksFilter::Accept(const Assignment*, const Assignment*,
+                                 int64_t, int64_t) {
+  if (path_state_->IsInvalid()) return true;
+  for (const int vehicle : path_state_->ChangedPaths()) {
+    if (!vehicle_has_breaks_[vehicle]) continue;
+    const int64_t total_min_travel = FillPathAndTravelBoundsOfVehicle(vehicle);
+    // Travels and inner breaks are disjoint, and must all fit in the route.
+    if (CapAdd(total_min_travel,
+               vehicle_min_duration_of_inner_breaks_[vehicle]) >
+        vehicle_max_span_[vehicle]) {
+      return false;
+    }
+    if (!PropagateBreaksOfVehicle(vehicle)) return false;
+  }
+  return true;
+}
+
+void VehicleBreaksFilter::Synchronize(const Assignment*, const Assignment*) {
+  // Filters are synchronized before the PathState is committed, so the
+  // changed paths are the ones of the new committed state.
+  if (path_state_->IsInvalid()) return;
+  for (const int vehicle : path_state_->ChangedPaths()) {
+    if (!vehicle_has_breaks_[vehicle]) continue;
+    CacheCommittedTravelsOfVehicle(vehicle);
+  }
+}
+
 }  // namespace
 
-IntVarLocalSearchFilter* MakeVehicleBreaksFilter(
-    const RoutingModel& routing_model, const RoutingDimension& dimension) {
+LocalSearchFilter* MakeVehicleBreaksFilter(const RoutingModel& routing_model,
+                                           const RoutingDimension& dimension,
+                                           const PathState* path_state) {
   return routing_model.solver()->RevAlloc(
-      new VehicleBreaksFilter(routing_model, dimension));
+      new VehicleBreaksFilter(routing_model, dimension, path_state));
 }
 
 }  // namespace operations_research
@@ -837,10 +837,11 @@ class ChainCumulFilter : public BasePathFilter {
   bool AcceptPath(int64_t path_start, int64_t chain_start,
                   int64_t chain_end) override;
 
+  const RoutingModel& routing_model_;
   const std::vector<IntVar*> cumuls_;
   std::vector<int64_t> start_to_vehicle_;
   std::vector<int64_t> start_to_end_;
-  std::vector<const RoutingModel::TransitCallback2*> evaluators_;
+  std::vector<int> evaluator_indices_;
   const std::vector<int64_t> vehicle_capacities_;
   std::vector<int64_t> current_path_cumul_mins_;
   std::vector<int64_t> current_max_of_path_end_cumul_mins_;
@@ -853,8 +854,9 @@ class ChainCumulFilter : public BasePathFilter {
 ChainCumulFilter::ChainCumulFilter(const RoutingModel& routing_model,
                                    const RoutingDimension& dimension)
     : BasePathFilter(routing_model.Nexts(), dimension.cumuls().size()),
+      routing_model_(routing_model),
       cumuls_(dimension.cumuls()),
-      evaluators_(routing_model.vehicles(), nullptr),
+      evaluator_indices_(routing_model.vehicles(), -1),
       vehicle_capacities_(dimension.vehicle_capacities()),
       current_path_cumul_mins_(dimension.cumuls().size(), 0),
       current_max_of_path_end_cumul_mins_(dimension.cumuls().size(), 0),
@@ -867,7 +869,7 @@ ChainCumulFilter::ChainCumulFilter(const RoutingModel& routing_model,
   for (int i = 0; i < routing_model.vehicles(); ++i) {
     start_to_vehicle_[routing_model.Start(i)] = i;
     start_to_end_[routing_model.Start(i)] = routing_model.End(i);
-    evaluators_[i] = &dimension.transit_evaluator(i);
+    evaluator_indices_[i] = dimension.transit_evaluator_index(i);
   }
 }
 
@@ -886,7 +888,8 @@ void ChainCumulFilter::OnSynchronizePathFromStart(int64_t start) {
     if (next != old_nexts_[node] || vehicle != old_vehicles_[node]) {
       old_nexts_[node] = next;
       old_vehicles_[node] = vehicle;
-      current_transits_[node] = (*evaluators_[vehicle])(node, next);
+      current_transits_[node] = routing_model_.GetTransitValue(
+          evaluator_indices_[vehicle], node, next);
     }
     cumul = CapAdd(cumul, current_transits_[node]);
     cumul = std::max(cumuls_[next]->Min(), cumul);
@@ -915,7 +918,8 @@ bool ChainCumulFilter::AcceptPath(int64_t path_start, int64_t chain_start,
         vehicle == old_vehicles_[node]) {
       cumul = CapAdd(cumul, current_transits_[node]);
     } else {
-      cumul = CapAdd(cumul, (*evaluators_[vehicle])(node, next));
+      cumul = CapAdd(cumul, routing_model_.GetTransitValue(
+                                evaluator_indices_[vehicle], node, next));
     }
     cumul = std::max(cumuls_[next]->Min(), cumul);
     if (cumul > capacity) return false;
@@ -1155,7 +1159,7 @@ class PathCumulFilter : public BasePathFilter {
   const std::vector<IntVar*> cumuls_;
   const std::vector<IntVar*> slacks_;
   std::vector<int64_t> start_to_vehicle_;
-  std::vector<const RoutingModel::TransitCallback2*> evaluators_;
+  std::vector<int> evaluator_indices_;
   std::vector<int64_t> vehicle_span_upper_bounds_;
   const bool has_vehicle_span_upper_bounds_;
   int64_t total_current_cumul_cost_value_;
@@ -1228,7 +1232,7 @@ PathCumulFilter::PathCumulFilter(const RoutingModel& routing_model,
       dimension_(dimension),
       cumuls_(dimension.cumuls()),
       slacks_(dimension.slacks()),
-      evaluators_(routing_model.vehicles(), nullptr),
+      evaluator_indices_(routing_model.vehicles(), -1),
       vehicle_span_upper_bounds_(dimension.vehicle_span_upper_bounds()),
       has_vehicle_span_upper_bounds_(absl::c_any_of(
           vehicle_span_upper_bounds_,
@@ -1317,7 +1321,7 @@ PathCumulFilter::PathCumulFilter(const RoutingModel& routing_model,
   start_to_vehicle_.resize(Size(), -1);
   for (int i = 0; i < routing_model.vehicles(); ++i) {
     start_to_vehicle_[routing_model.Start(i)] = i;
-    evaluators_[i] = &dimension.transit_evaluator(i);
+    evaluator_indices_[i] = dimension.transit_evaluator_index(i);
   }
 
   const std::vector<RoutingDimension::NodePrecedence>& node_precedences =
@@ -1433,7 +1437,8 @@ void PathCumulFilter::OnBeforeSynchronizePaths() {
       int64_t total_transit = 0;
       while (node < Size()) {
         const int64_t next = Value(node);
-        const int64_t transit = (*evaluators_[vehicle])(node, next);
+        const int64_t transit = routing_model_.GetTransitValue(
+            evaluator_indices_[vehicle], node, next);
         total_transit = CapAdd(total_transit, transit);
         const int64_t transit_slack = CapAdd(transit, slacks_[node]->Min());
         current_path_transits_.PushTransit(r, node, next, transit_slack);
@@ -1599,7 +1604,8 @@ bool PathCumulFilter::AcceptPath(int64_t path_start, int64_t /*chain_start*/,
   node = path_start;
   while (node < Size()) {
     const int64_t next = GetNext(node);
-    const int64_t transit = (*evaluators_[vehicle])(node, next);
+    const int64_t transit = routing_model_.GetTransitValue(
+        evaluator_indices_[vehicle], node, next);
     total_transit = CapAdd(total_transit, transit);
     const int64_t transit_slack = CapAdd(transit, slacks_[node]->Min());
     delta_path_transits_.PushTransit(path, node, next, transit_slack);
@@ -2276,7 +2282,20 @@ class PickupDeliveryFilter : public BasePathFilter {
   std::string DebugString() const override { return "PickupDeliveryFilter"; }
 
  private:
+  void OnSynchronizePathFromStart(int64_t start) override;
   bool AcceptPathDefault(int64_t path_start);
+  // Same as AcceptPathDefault(), but only checks the pairs having a node in the
+  // touched chain, either before or after the change. This relies on the
+  // synchronized path being valid, and on the nodes before chain_start and
+  // after chain_end being unchanged.
+  bool AcceptPathDefaultIncrementally(int64_t path_start, int64_t chain_start,
+                                      int64_t chain_end);
+  // Returns the position of node in the path being checked by
+  // AcceptPathDefaultIncrementally(), -1 if it is not on the path.
+  int PositionInChangedPath(int64_t node, int64_t path_start) const;
+  // Checks the precedences of a pair on the path being checked by
+  // AcceptPathDefaultIncrementally().
+  bool AcceptPairInChangedPath(int pair, int64_t path_start) const;
   template <bool lifo>
   bool AcceptPathOrdered(int64_t path_start);
 
@@ -2286,6 +2305,17 @@ class PickupDeliveryFilter : public BasePathFilter {
   SparseBitset<> visited_;
   std::deque<int> visited_deque_;
   const std::vector<RoutingModel::PickupAndDeliveryPolicy> vehicle_policies_;
+
+  // Whether the synchronized path starting at a given node is valid, only
+  // maintained for paths without ordering policy.
+  std::vector<bool> synchronized_path_is_valid_;
+  // Nodes of the touched chain of the path being checked, and their position
+  // in the path, -1 for nodes outside of the chain.
+  std::vector<int64_t> chain_nodes_;
+  std::vector<int> chain_node_position_;
+  int chain_start_rank_;
+  int chain_end_rank_;
+  SparseBitset<> touched_pairs_;
 };
 
 PickupDeliveryFilter::PickupDeliveryFilter(
@@ -2297,7 +2327,12 @@ PickupDeliveryFilter::PickupDeliveryFilter(
       pair_seconds_(next_domain_size, kUnassigned),
       pairs_(pairs),
       visited_(Size()),
-      vehicle_policies_(vehicle_policies) {
+      vehicle_policies_(vehicle_policies),
+      synchronized_path_is_valid_(Size(), false),
+      chain_node_position_(next_domain_size, -1),
+      chain_start_rank_(0),
+      chain_end_rank_(0),
+      touched_pairs_(pairs.size()) {
   for (int i = 0; i < pairs.size(); ++i) {
     const auto& index_pair = pairs[i];
     for (int first : index_pair.pickup_alternatives) {
@@ -2310,11 +2345,12 @@ PickupDeliveryFilter::PickupDeliveryFilter(
 }
 
 bool PickupDeliveryFilter::AcceptPath(int64_t path_start,
-                                      int64_t /*chain_start*/,
-                                      int64_t /*chain_end*/) {
+                                      int64_t chain_start,
+                                      int64_t chain_end) {
   switch (vehicle_policies_[GetPath(path_start)]) {
     case RoutingModel::PICKUP_AND_DELIVERY_NO_ORDER:
-      return AcceptPathDefault(path_start);
+      return AcceptPathDefaultIncrementally(path_start, chain_start,
+                                            chain_end);
     case RoutingModel::PICKUP_AND_DELIVERY_LIFO:
       return AcceptPathOrdered<true>(path_start);
     case RoutingModel::PICKUP_AND_DELIVERY_FIFO:
@@ -2389,6 +2425,116 @@ bool PickupDeliveryFilter::AcceptPathDefault(int64_t path_start) {
   return true;
 }
 
+void PickupDeliveryFilter::OnSynchronizePathFromStart(int64_t start) {
+  if (vehicle_policies_[GetPath(start)] !=
+      RoutingModel::PICKUP_AND_DELIVERY_NO_ORDER) {
+    return;
+  }
+  synchronized_path_is_valid_[start] = AcceptPathDefault(start);
+}
+
+bool PickupDeliveryFilter::AcceptPathDefaultIncrementally(int64_t path_start,
+                                                          int64_t chain_start,
+                                                          int64_t chain_end) {
+  if (!synchronized_path_is_valid_[path_start]) {
+    return AcceptPathDefault(path_start);
+  }
+  for (const int64_t node : chain_nodes_) chain_node_position_[node] = -1;
+  chain_nodes_.clear();
+  chain_start_rank_ = Rank(chain_start);
+  chain_end_rank_ = Rank(chain_end);
+  // Position the nodes of the new chain from chain_start to chain_end. Any
+  // unexpected path shape is left to the full check.
+  int64_t node = chain_start;
+  while (true) {
+    // Detect sub-cycles.
+    if (chain_node_position_[node] != -1) return false;
+    chain_node_position_[node] = chain_start_rank_ + chain_nodes_.size();
+    chain_nodes_.push_back(node);
+    if (node == chain_end) break;
+    node = GetNext(node);
+    if (node == kUnassigned || (node >= Size() && node != chain_end)) {
+      return AcceptPathDefault(path_start);
+    }
+  }
+  if (chain_end < Size() &&
+      (!IsVarSynced(chain_end) || GetNext(chain_end) != Value(chain_end))) {
+    return AcceptPathDefault(path_start);
+  }
+  // Pairs whose nodes are all outside of the old and new chains keep the same
+  // relative order, and were valid on the synchronized path.
+  touched_pairs_.SparseClearAll();
+  const auto touch_pairs_of_node = [this](int64_t chain_node) {
+    if (chain_node >= Size()) return;
+    if (pair_firsts_[chain_node] != kUnassigned) {
+      touched_pairs_.Set(pair_firsts_[chain_node]);
+    }
+    if (pair_seconds_[chain_node] != kUnassigned) {
+      touched_pairs_.Set(pair_seconds_[chain_node]);
+    }
+  };
+  for (const int64_t new_node : chain_nodes_) touch_pairs_of_node(new_node);
+  for (int64_t old_node = chain_start; old_node != chain_end;
+       old_node = Value(old_node)) {
+    touch_pairs_of_node(old_node);
+  }
+  for (const int pair : touched_pairs_.PositionsSetAtLeastOnce()) {
+    if (!AcceptPairInChangedPath(pair, path_start)) return false;
+  }
+  return true;
+}
+
+int PickupDeliveryFilter::PositionInChangedPath(int64_t node,
+                                                int64_t path_start) const {
+  const int chain_position = chain_node_position_[node];
+  if (chain_position != -1) return chain_position;
+  if (GetPathStart(node) != path_start) return -1;
+  const int rank = Rank(node);
+  if (rank < chain_start_rank_) return rank;
+  if (rank > chain_end_rank_) {
+    return rank - chain_end_rank_ + chain_start_rank_ + chain_nodes_.size() -
+           1;
+  }
+  // The node was in the old chain and is not in the new one.
+  return -1;
+}
+
+bool PickupDeliveryFilter::AcceptPairInChangedPath(int pair,
+                                                   int64_t path_start) const {
+  constexpr int kNotOnPath = std::numeric_limits<int>::max();
+  int first_pickup = kNotOnPath;
+  int last_pickup = -1;
+  bool some_pickup_synced = false;
+  for (const int pickup : pairs_[pair].pickup_alternatives) {
+    const int position = PositionInChangedPath(pickup, path_start);
+    if (position != -1) {
+      first_pickup = std::min(first_pickup, position);
+      last_pickup = std::max(last_pickup, position);
+    }
+    some_pickup_synced |= IsVarSynced(pickup);
+  }
+  int first_delivery = kNotOnPath;
+  bool some_delivery_synced = false;
+  for (const int delivery : pairs_[pair].delivery_alternatives) {
+    const int position = PositionInChangedPath(delivery, path_start);
+    if (position != -1) first_delivery = std::min(first_delivery, position);
+    some_delivery_synced |= IsVarSynced(delivery);
+  }
+  // No delivery can be visited before a pickup.
+  if (first_delivery < last_pickup) return false;
+  // A delivery on the path must have a pickup before it.
+  if (first_delivery != kNotOnPath && first_pickup > first_delivery &&
+      some_pickup_synced) {
+    return false;
+  }
+  // A pickup on the path must have a delivery on the path.
+  if (first_pickup != kNotOnPath && first_delivery == kNotOnPath &&
+      some_delivery_synced) {
+    return false;
+  }
+  return true;
+}
+
 template <bool lifo>
 bool PickupDeliveryFilter::AcceptPathOrdered(int64_t path_start) {
   visited_deque_.clear();
@@ -2761,6 +2907,23 @@ class ResourceGroupAssignmentFilter : public BasePathFilter {
   }
 
  private:
+  // Same as ComputeVehicleToResourceClassAssignmentCosts(), but looks up the
+  // costs of the path of v in a per-vehicle cache keyed by the sequence of
+  // nodes of the path, and stores them in the cache when they are computed.
+  bool ComputeVehicleToResourceClassAssignmentCostsWithCache(
+      int v, const std::function<int64_t(int64_t)>& next_accessor,
+      std::vector<int64_t>* assignment_costs);
+  // Tries to deduce the cost of the best assignment of the candidate from the
+  // synchronized assignment, without solving a min-cost flow:
+  // - if no touched vehicle has new assignment costs, the synchronized
+  //   assignment is still optimal;
+  // - when costs are not filtered, all feasible assignments have cost 0, so it
+  //   is enough to find one by keeping the synchronized resource class of
+  //   touched vehicles when possible, and by giving free resources to the
+  //   others.
+  // Returns -1 if the cost could not be deduced this way.
+  int64_t ComputeBestAssignmentCostFromSynchronizedAssignment();
+
   const RoutingModel& model_;
   const RoutingDimension& dimension_;
   const ResourceGroup& resource_group_;
@@ -2773,6 +2936,24 @@ class ResourceGroupAssignmentFilter : public BasePathFilter {
   std::vector<std::vector<int64_t>> vehicle_to_resource_class_assignment_costs_;
   std::vector<std::vector<int64_t>>
       delta_vehicle_to_resource_class_assignment_costs_;
+
+  // Cache of the assignment costs of the paths evaluated for each vehicle,
+  // cleared when the path of the vehicle is synchronized.
+  static constexpr int kMaxNumCachedPathsPerVehicle = 64;
+  std::vector<absl::flat_hash_map<std::vector<int64_t>, std::vector<int64_t>>>
+      vehicle_path_to_assignment_costs_;
+  std::vector<int64_t> path_;
+
+  // Synchronized assignment of vehicles to resource classes, -1 for vehicles
+  // without resource, and number of resources of each class left unassigned.
+  // Only valid if synchronized_assignment_cost_ >= 0.
+  int64_t synchronized_assignment_cost_;
+  std::vector<int> synchronized_resource_indices_;
+  std::vector<int> synchronized_vehicle_resource_class_;
+  std::vector<int> synchronized_num_free_resources_per_class_;
+  // Used in ComputeBestAssignmentCostFromSynchronizedAssignment().
+  std::vector<int> num_free_resources_per_class_;
+  std::vector<int> vehicles_to_reassign_;
 };
 
 ResourceGroupAssignmentFilter::ResourceGroupAssignmentFilter(
@@ -2788,9 +2969,92 @@ ResourceGroupAssignmentFilter::ResourceGroupAssignmentFilter(
       filter_objective_cost_(filter_objective_cost),
       current_synch_failed_(false),
       synchronized_cost_without_transit_(-1),
-      delta_cost_without_transit_(-1) {
+      delta_cost_without_transit_(-1),
+      synchronized_assignment_cost_(-1) {
   vehicle_to_resource_class_assignment_costs_.resize(model_.vehicles());
   delta_vehicle_to_resource_class_assignment_costs_.resize(model_.vehicles());
+  vehicle_path_to_assignment_costs_.resize(model_.vehicles());
+  synchronized_vehicle_resource_class_.assign(model_.vehicles(), -1);
+}
+
+bool ResourceGroupAssignmentFilter::
+    ComputeVehicleToResourceClassAssignmentCostsWithCache(
+        int v, const std::function<int64_t(int64_t)>& next_accessor,
+        std::vector<int64_t>* assignment_costs) {
+  path_.clear();
+  int64_t node = model_.Start(v);
+  while (!model_.IsEnd(node)) {
+    path_.push_back(node);
+    node = next_accessor(node);
+  }
+  path_.push_back(node);
+  auto& path_to_costs = vehicle_path_to_assignment_costs_[v];
+  const auto it = path_to_costs.find(path_);
+  if (it != path_to_costs.end()) {
+    *assignment_costs = it->second;
+    return true;
+  }
+  using RCIndex = RoutingModel::ResourceClassIndex;
+  const absl::StrongVector<RCIndex, absl::flat_hash_set<int>>
+      ignored_resources_per_class(resource_group_.GetResourceClassesCount());
+  if (!ComputeVehicleToResourceClassAssignmentCosts(
+          v, resource_group_, ignored_resources_per_class, next_accessor,
+          dimension_.transit_evaluator(v), filter_objective_cost_,
+          lp_optimizer_, mp_optimizer_, assignment_costs, nullptr, nullptr)) {
+    // Failures are not cached, they can come from the time limit.
+    return false;
+  }
+  if (path_to_costs.size() >= kMaxNumCachedPathsPerVehicle) {
+    path_to_costs.clear();
+  }
+  path_to_costs.emplace(path_, *assignment_costs);
+  return true;
+}
+
+int64_t ResourceGroupAssignmentFilter::
+    ComputeBestAssignmentCostFromSynchronizedAssignment() {
+  if (synchronized_assignment_cost_ < 0) return -1;
+  num_free_resources_per_class_ = synchronized_num_free_resources_per_class_;
+  vehicles_to_reassign_.clear();
+  for (int v : resource_group_.GetVehiclesRequiringAResource()) {
+    if (!PathStartTouched(model_.Start(v))) continue;
+    const std::vector<int64_t>& costs =
+        delta_vehicle_to_resource_class_assignment_costs_[v];
+    if (costs == vehicle_to_resource_class_assignment_costs_[v]) continue;
+    if (filter_objective_cost_) return -1;
+    const int rc = synchronized_vehicle_resource_class_[v];
+    if (rc >= 0) ++num_free_resources_per_class_[rc];
+    if (!costs.empty()) vehicles_to_reassign_.push_back(v);
+  }
+  if (filter_objective_cost_) return synchronized_assignment_cost_;
+  // Costs are 0 (feasible) or -1 (infeasible), find a feasible assignment.
+  int num_reassigned = 0;
+  for (int& v : vehicles_to_reassign_) {
+    const int rc = synchronized_vehicle_resource_class_[v];
+    if (rc < 0 || num_free_resources_per_class_[rc] == 0 ||
+        delta_vehicle_to_resource_class_assignment_costs_[v][rc] < 0) {
+      continue;
+    }
+    --num_free_resources_per_class_[rc];
+    v = -1;
+    ++num_reassigned;
+  }
+  if (num_reassigned == vehicles_to_reassign_.size()) return 0;
+  for (const int v : vehicles_to_reassign_) {
+    if (v < 0) continue;
+    const std::vector<int64_t>& costs =
+        delta_vehicle_to_resource_class_assignment_costs_[v];
+    bool assigned = false;
+    for (int rc = 0; rc < costs.size(); ++rc) {
+      if (costs[rc] < 0 || num_free_resources_per_class_[rc] == 0) continue;
+      --num_free_resources_per_class_[rc];
+      assigned = true;
+      break;
+    }
+    // The greedy assignment failed, this does not prove infeasibility.
+    if (!assigned) return -1;
+  }
+  return 0;
 }
 
 bool ResourceGroupAssignmentFilter::InitializeAcceptPath() {
@@ -2819,20 +3083,18 @@ bool ResourceGroupAssignmentFilter::AcceptPath(int64_t path_start,
   // delta_ignored_resources_per_class_ class members, properly update them in
   // AcceptPath(), and delay calls to
   // ComputeVehicleToResourceClassAssignmentCosts() to FinalizeAcceptPath().
-  using RCIndex = RoutingModel::ResourceClassIndex;
-  const absl::StrongVector<RCIndex, absl::flat_hash_set<int>>
-      ignored_resources_per_class(resource_group_.GetResourceClassesCount());
-  return ComputeVehicleToResourceClassAssignmentCosts(
-      vehicle, resource_group_, ignored_resources_per_class,
-      [this](int64_t index) { return GetNext(index); },
-      dimension_.transit_evaluator(vehicle), filter_objective_cost_,
-      lp_optimizer_, mp_optimizer_,
-      &delta_vehicle_to_resource_class_assignment_costs_[vehicle], nullptr,
-      nullptr);
+  return ComputeVehicleToResourceClassAssignmentCostsWithCache(
+      vehicle, [this](int64_t index) { return GetNext(index); },
+      &delta_vehicle_to_resource_class_assignment_costs_[vehicle]);
 }
 
 bool ResourceGroupAssignmentFilter::FinalizeAcceptPath(
     int64_t /*objective_min*/, int64_t objective_max) {
+  delta_cost_without_transit_ =
+      ComputeBestAssignmentCostFromSynchronizedAssignment();
+  if (delta_cost_without_transit_ >= 0) {
+    return delta_cost_without_transit_ <= objective_max;
+  }
   using RCIndex = RoutingModel::ResourceClassIndex;
   const absl::StrongVector<RCIndex, absl::flat_hash_set<int>>
       ignored_resources_per_class(resource_group_.GetResourceClassesCount());
@@ -2870,14 +3132,13 @@ void ResourceGroupAssignmentFilter::OnSynchronizePathFromStart(int64_t start) {
   // ignored_resources_per_class_ class members, properly update them in
   // OnSynchronizePathFromStart(), and delay calls to
   // ComputeVehicleToResourceClassAssignmentCosts() to OnAfterSynchronizePaths()
-  using RCIndex = RoutingModel::ResourceClassIndex;
-  const absl::StrongVector<RCIndex, absl::flat_hash_set<int>>
-      ignored_resources_per_class(resource_group_.GetResourceClassesCount());
-  if (!ComputeVehicleToResourceClassAssignmentCosts(
-          v, resource_group_, ignored_resources_per_class, next_accessor,
-          dimension_.transit_evaluator(v), filter_objective_cost_,
-          lp_optimizer_, mp_optimizer_,
-          &vehicle_to_resource_class_assignment_costs_[v], nullptr, nullptr)) {
+  // The new path was usually evaluated by the last accepted candidate, so its
+  // costs are likely to be cached. Other cached paths were neighbors of the
+  // previous path and are unlikely to be evaluated again.
+  const bool feasible = ComputeVehicleToResourceClassAssignmentCostsWithCache(
+      v, next_accessor, &vehicle_to_resource_class_assignment_costs_[v]);
+  vehicle_path_to_assignment_costs_[v].clear();
+  if (!feasible) {
     vehicle_to_resource_class_assignment_costs_[v].assign(
         resource_group_.GetResourceClassesCount(), -1);
     current_synch_failed_ = true;
@@ -2888,9 +3149,12 @@ void ResourceGroupAssignmentFilter::OnAfterSynchronizePaths() {
   using RCIndex = RoutingModel::ResourceClassIndex;
   const absl::StrongVector<RCIndex, absl::flat_hash_set<int>>
       ignored_resources_per_class(resource_group_.GetResourceClassesCount());
-  synchronized_cost_without_transit_ =
-      (current_synch_failed_ || !filter_objective_cost_)
-          ? 0
+  // The assignment is also computed when costs are not filtered, since it is
+  // reused by ComputeBestAssignmentCostFromSynchronizedAssignment().
+  synchronized_resource_indices_.resize(model_.vehicles());
+  synchronized_assignment_cost_ =
+      current_synch_failed_
+          ? -1
           : ComputeBestVehicleToResourceAssignment(
                 resource_group_.GetVehiclesRequiringAResource(),
                 resource_group_.GetResourceIndicesPerClass(),
@@ -2898,9 +3162,26 @@ void ResourceGroupAssignmentFilter::OnAfterSynchronizePaths() {
                 [this](int v) {
                   return &vehicle_to_resource_class_assignment_costs_[v];
                 },
-                nullptr);
+                &synchronized_resource_indices_);
   synchronized_cost_without_transit_ =
-      std::max<int64_t>(synchronized_cost_without_transit_, 0);
+      filter_objective_cost_
+          ? std::max<int64_t>(synchronized_assignment_cost_, 0)
+          : 0;
+  synchronized_vehicle_resource_class_.assign(model_.vehicles(), -1);
+  synchronized_num_free_resources_per_class_.resize(
+      resource_group_.GetResourceClassesCount());
+  for (int rc = 0; rc < resource_group_.GetResourceClassesCount(); ++rc) {
+    synchronized_num_free_resources_per_class_[rc] =
+        resource_group_.GetResourceIndicesInClass(RCIndex(rc)).size();
+  }
+  if (synchronized_assignment_cost_ < 0) return;
+  for (int v = 0; v < synchronized_resource_indices_.size(); ++v) {
+    const int resource = synchronized_resource_indices_[v];
+    if (resource < 0) continue;
+    const int rc = resource_group_.GetResourceClassIndex(resource).value();
+    synchronized_vehicle_resource_class_[v] = rc;
+    --synchronized_num_free_resources_per_class_[rc];
+  }
 }
 
 // ResourceAssignmentFilter
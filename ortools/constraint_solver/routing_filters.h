@@ -154,6 +154,9 @@ class BasePathFilter : public IntVarLocalSearchFilter {
   int NumPaths() const { return starts_.size(); }
   int64_t Start(int i) const { return starts_[i]; }
   int GetPath(int64_t node) const { return paths_[node]; }
+  // Returns the start of the synchronized path of node, kUnassigned if node is
+  // not on a path.
+  int64_t GetPathStart(int64_t node) const { return node_path_starts_[node]; }
   int Rank(int64_t node) const { return ranks_[node]; }
   bool IsDisabled() const { return status_ == DISABLED; }
   const std::vector<int64_t>& GetTouchedPathStarts() const {
@@ -16,13 +16,20 @@
 #include <cstddef>
 #include <cstdint>
 #include <functional>
+#include <limits>
 #include <memory>
 #include <utility>
 #include <vector>
 
 #include "absl/functional/bind_front.h"
 #include "absl/log/check.h"
+#include "absl/synchronization/blocking_counter.h"
+#include "absl/time/clock.h"
+#include "absl/time/time.h"
+#include "absl/types/span.h"
 #include "ortools/base/logging.h"
+#include "ortools/base/protoutil.h"
+#include "ortools/base/threadpool.h"
 #include "ortools/constraint_solver/constraint_solver.h"
 #include "ortools/constraint_solver/routing.h"
 #include "ortools/constraint_solver/routing_ils.pb.h"
@@ -63,7 +70,7 @@ std::unique_ptr<RuinProcedure> MakeRuinProcedure(
       [[fallthrough]];
     case RuinStrategy::SPATIALLY_CLOSE_ROUTES_REMOVAL:
       return std::make_unique<CloseRoutesRemovalRuinProcedure>(
-          model, parameters.num_ruined_routes());
+          model, parameters.num_ruined_routes(), parameters.random_seed());
       break;
     default:
       LOG(ERROR) << "Unsupported ruin procedure.";
@@ -138,13 +145,13 @@ class GreedyDescentAcceptanceCriterion : public NeighborAcceptanceCriterion {
 }  // namespace
 
 CloseRoutesRemovalRuinProcedure::CloseRoutesRemovalRuinProcedure(
-    RoutingModel* model, size_t num_routes)
+    RoutingModel* model, size_t num_routes, uint32_t random_seed)
     : model_(*model),
       neighbors_manager_(model->GetOrCreateNodeNeighborsByCostClass(
           /*TODO(user): use a parameter*/ 100,
           /*add_vehicle_starts_to_neighbors=*/false)),
       num_routes_(num_routes),
-      rnd_(/*fixed seed=*/0),
+      rnd_(random_seed),
       customer_dist_(0, model->Size() - 1),
       removed_routes_(model->vehicles()) {}
 
@@ -164,7 +171,7 @@ std::function<int64_t(int64_t)> CloseRoutesRemovalRuinProcedure::Ruin(
     const RoutingCostClassIndex cost_class_index =
         model_.GetCostClassIndexOfVehicle(seed_route);
 
-    const std::vector<int>& neighbors =
+    const absl::Span<const int> neighbors =
         neighbors_manager_->GetNeighborsOfNodeForCostClass(
             cost_class_index.value(), seed_node);
 
@@ -283,4 +290,116 @@ std::unique_ptr<NeighborAcceptanceCriterion> MakeNeighborAcceptanceCriterion(
   }
 }
 
+const Assignment* SolveWithParallelIteratedLocalSearch(
+    const RoutingSearchParameters& search_parameters,
+    const RoutingModelBuilder& build_model, RoutingModel* model) {
+  const int num_workers = search_parameters.num_workers();
+  if (num_workers <= 1) {
+    return model->SolveWithIteratedLocalSearch(search_parameters);
+  }
+  const absl::Time deadline =
+      search_parameters.has_time_limit()
+          ? absl::Now() +
+                util_time::DecodeGoogleApiProto(search_parameters.time_limit())
+                    .value()
+          : absl::InfiniteFuture();
+
+  const Assignment* first_solution =
+      model->SolveWithParameters(search_parameters);
+  if (first_solution == nullptr) return nullptr;
+  Assignment* const reference = model->solver()->MakeAssignment(first_solution);
+  uint64_t explored_solutions = model->solver()->solutions();
+
+  std::vector<RoutingSearchParameters> worker_parameters(num_workers,
+                                                         search_parameters);
+  for (int worker = 0; worker < num_workers; ++worker) {
+    worker_parameters[worker].set_num_workers(1);
+    RuinRecreateParameters* ruin_recreate_parameters =
+        worker_parameters[worker]
+            .mutable_iterated_local_search_parameters()
+            ->mutable_ruin_recreate_parameters();
+    ruin_recreate_parameters->set_random_seed(
+        ruin_recreate_parameters->random_seed() + worker);
+  }
+  std::unique_ptr<NeighborAcceptanceCriterion> acceptance_criterion =
+      MakeNeighborAcceptanceCriterion(search_parameters);
+
+  // The worker models are built by the first batch, each on the thread of its
+  // worker. A worker only reads the reference solution again when it changed.
+  std::vector<std::unique_ptr<RoutingModel>> worker_models(num_workers);
+  std::vector<std::unique_ptr<Assignment>> worker_references(num_workers);
+  std::vector<int> worker_reference_versions(num_workers, -1);
+  std::vector<int64_t> neighbor_costs(num_workers);
+  std::vector<RoutingModel::SolutionSnapshot> neighbor_snapshots(num_workers);
+  RoutingModel::SolutionSnapshot reference_snapshot;
+  int reference_version = 0;
+  const int64_t size = model->Size();
+  const int num_vehicles = model->vehicles();
+  const auto run_worker = [&](int worker) {
+    neighbor_costs[worker] = std::numeric_limits<int64_t>::max();
+    std::unique_ptr<RoutingModel>& worker_model = worker_models[worker];
+    if (worker_model == nullptr) {
+      worker_model = build_model();
+      CHECK(worker_model != nullptr);
+      CHECK_EQ(worker_model->Size(), size);
+      CHECK_EQ(worker_model->vehicles(), num_vehicles);
+      worker_model->solver()->ReSeed(worker);
+      worker_model->CloseModelWithParameters(worker_parameters[worker]);
+    }
+    if (worker_reference_versions[worker] != reference_version) {
+      const Assignment* worker_reference =
+          worker_model->RestoreSolutionSnapshot(reference_snapshot);
+      if (worker_reference == nullptr) return;
+      worker_references[worker] =
+          std::make_unique<Assignment>(worker_reference);
+      worker_reference_versions[worker] = reference_version;
+    }
+    const Assignment* neighbor = worker_model->FindIteratedLocalSearchNeighbor(
+        worker_parameters[worker], *worker_references[worker],
+        deadline - absl::Now());
+    if (neighbor == nullptr) return;
+    neighbor_costs[worker] = neighbor->ObjectiveValue();
+    worker_model->ExportSolutionSnapshot(*neighbor,
+                                         &neighbor_snapshots[worker]);
+  };
+
+  ThreadPool thread_pool("RoutingParallelIls", num_workers);
+  thread_pool.StartWorkers();
+  model->ExportSolutionSnapshot(*reference, &reference_snapshot);
+  while (absl::Now() < deadline &&
+         explored_solutions < search_parameters.solution_limit()) {
+    absl::BlockingCounter batch(num_workers);
+    for (int worker = 0; worker < num_workers; ++worker) {
+      thread_pool.Schedule([&run_worker, &batch, worker]() {
+        run_worker(worker);
+        batch.DecrementCount();
+      });
+    }
+    batch.Wait();
+
+    int best_worker = -1;
+    for (int worker = 0; worker < num_workers; ++worker) {
+      if (neighbor_costs[worker] == std::numeric_limits<int64_t>::max()) {
+        continue;
+      }
+      ++explored_solutions;
+      if (best_worker < 0 ||
+          neighbor_costs[worker] < neighbor_costs[best_worker]) {
+        best_worker = worker;
+      }
+    }
+    if (best_worker < 0) continue;
+    const Assignment* neighbor =
+        model->RestoreSolutionSnapshot(neighbor_snapshots[best_worker]);
+    if (neighbor != nullptr &&
+        acceptance_criterion->Accept(neighbor, reference)) {
+      reference->CopyIntersection(neighbor);
+      // Swapping keeps the memory of both snapshots for the next exports.
+      std::swap(reference_snapshot, neighbor_snapshots[best_worker]);
+      ++reference_version;
+    }
+  }
+  return reference;
+}
+
 }  // namespace operations_research
@@ -23,6 +23,7 @@
 #include "ortools/constraint_solver/constraint_solver.h"
 #include "ortools/constraint_solver/routing.h"
 #include "ortools/constraint_solver/routing_parameters.pb.h"
+#include "ortools/constraint_solver/routing_portfolio.h"
 #include "ortools/util/bitset.h"
 
 namespace operations_research {
@@ -38,7 +39,8 @@ class RuinProcedure {
 // Remove a number of routes that are spatially close together.
 class CloseRoutesRemovalRuinProcedure : public RuinProcedure {
  public:
-  CloseRoutesRemovalRuinProcedure(RoutingModel* model, size_t num_routes);
+  CloseRoutesRemovalRuinProcedure(RoutingModel* model, size_t num_routes,
+                                  uint32_t random_seed = 0);
   // Returns next accessors where at most num_routes routes have been shortcut,
   // i.e., next(shortcut route begin) = shortcut route end.
   // Next accessors for customers belonging to shortcut routes are still set to
@@ -77,6 +79,19 @@ class NeighborAcceptanceCriterion {
 std::unique_ptr<NeighborAcceptanceCriterion> MakeNeighborAcceptanceCriterion(
     const RoutingSearchParameters& parameters);
 
+// Solves `model` with an Iterated Local Search whose perturbations are run in
+// batches of `search_parameters.num_workers()`: each worker perturbs and
+// (optionally) improves the current reference solution on its own copy of the
+// model, built by `build_model` (see routing_portfolio.h), with its own ruin
+// seed, and the acceptance criterion is applied to the best neighbor of each
+// batch. The first solution is found by `model` itself. Returns the last
+// reference solution as an assignment owned by `model`, or nullptr if no first
+// solution was found. With at most one worker, this is
+// RoutingModel::SolveWithIteratedLocalSearch().
+const Assignment* SolveWithParallelIteratedLocalSearch(
+    const RoutingSearchParameters& search_parameters,
+    const RoutingModelBuilder& build_model, RoutingModel* model);
+
 }  // namespace operations_research
 
 #endif  // OR_TOOLS_CONSTRAINT_SOLVER_ROUTING_ILS_H_
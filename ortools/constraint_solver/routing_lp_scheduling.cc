@@ -23,6 +23,7 @@
 #include <limits>
 #include <memory>
 #include <numeric>
+#include <queue>
 #include <string>
 #include <utility>
 #include <vector>
@@ -184,31 +185,38 @@ void StoreVisitedPickupDeliveryPairsOnRoute(
 LocalDimensionCumulOptimizer::LocalDimensionCumulOptimizer(
     const RoutingDimension* dimension,
     RoutingSearchParameters::SchedulingSolver solver_type)
-    : optimizer_core_(dimension, /*use_precedence_propagator=*/false) {
+    : solver_type_(solver_type),
+      optimizer_core_(dimension, /*use_precedence_propagator=*/false) {
   // Using one solver per vehicle in the hope that if routes don't change this
-  // will be faster.
-  const int vehicles = dimension->model()->vehicles();
-  solver_.resize(vehicles);
-  switch (solver_type) {
+  // will be faster. The solvers are only created when their vehicle is first
+  // optimized: with many vehicles and dimensions, a lot of them would
+  // otherwise never be used but still take memory.
+  solver_.resize(dimension->model()->vehicles());
+  LOG_IF(DFATAL, solver_type != RoutingSearchParameters::SCHEDULING_GLOP &&
+                     solver_type != RoutingSearchParameters::SCHEDULING_CP_SAT)
+      << "Unrecognized solver type: " << solver_type;
+}
+
+RoutingLinearSolverWrapper* LocalDimensionCumulOptimizer::GetOrCreateSolver(
+    int vehicle) {
+  std::unique_ptr<RoutingLinearSolverWrapper>& solver = solver_[vehicle];
+  if (solver != nullptr) return solver.get();
+  switch (solver_type_) {
     case RoutingSearchParameters::SCHEDULING_GLOP: {
-      const glop::GlopParameters parameters = GetGlopParametersForLocalLP();
-      for (int vehicle = 0; vehicle < vehicles; ++vehicle) {
-        // TODO(user): Instead of passing false, detect if the relaxation
-        // will always violate the MIPL constraints.
-        solver_[vehicle] =
-            std::make_unique<RoutingGlopWrapper>(false, parameters);
-      }
+      // TODO(user): Instead of passing false, detect if the relaxation
+      // will always violate the MIPL constraints.
+      solver = std::make_unique<RoutingGlopWrapper>(
+          false, GetGlopParametersForLocalLP());
       break;
     }
     case RoutingSearchParameters::SCHEDULING_CP_SAT: {
-      for (int vehicle = 0; vehicle < vehicles; ++vehicle) {
-        solver_[vehicle] = std::make_unique<RoutingCPSatWrapper>();
-      }
+      solver = std::make_unique<RoutingCPSatWrapper>();
       break;
     }
     default:
-      LOG(DFATAL) << "Unrecognized solver type: " << solver_type;
+      LOG(DFATAL) << "Unrecognized solver type: " << solver_type_;
   }
+  return solver.get();
 }
 
 DimensionSchedulingStatus LocalDimensionCumulOptimizer::ComputeRouteCumulCost(
@@ -221,7 +229,7 @@ DimensionSchedulingStatus LocalDimensionCumulOptimizer::ComputeRouteCumulCost(
           /*dimension_travel_info=*/{},
           /*resource=*/nullptr,
           /*optimize_vehicle_costs=*/optimal_cost != nullptr,
-          solver_[vehicle].get(), /*cumul_values=*/nullptr,
+          GetOrCreateSolver(vehicle), /*cumul_values=*/nullptr,
           /*break_values=*/nullptr, optimal_cost, &transit_cost);
   if (status != DimensionSchedulingStatus::INFEASIBLE &&
       optimal_cost != nullptr) {
@@ -240,7 +248,7 @@ LocalDimensionCumulOptimizer::ComputeRouteCumulCostWithoutFixedTransits(
       /*dimension_travel_info=*/{},
       /*resource=*/nullptr,
       /*optimize_vehicle_costs=*/optimal_cost_without_transits != nullptr,
-      solver_[vehicle].get(), /*cumul_values=*/nullptr,
+      GetOrCreateSolver(vehicle), /*cumul_values=*/nullptr,
       /*break_values=*/nullptr, optimal_cost_without_transits, nullptr);
 }
 
@@ -255,7 +263,7 @@ std::vector<DimensionSchedulingStatus> LocalDimensionCumulOptimizer::
         std::vector<std::vector<int64_t>>* optimal_breaks) {
   return optimizer_core_.OptimizeSingleRouteWithResources(
       vehicle, next_accessor, transit_accessor, {}, resources, resource_indices,
-      optimize_vehicle_costs, solver_[vehicle].get(), optimal_cumuls,
+      optimize_vehicle_costs, GetOrCreateSolver(vehicle), optimal_cumuls,
       optimal_breaks, optimal_costs_without_transits, nullptr);
 }
 
@@ -267,8 +275,9 @@ DimensionSchedulingStatus LocalDimensionCumulOptimizer::ComputeRouteCumuls(
     std::vector<int64_t>* optimal_breaks) {
   return optimizer_core_.OptimizeSingleRouteWithResource(
       vehicle, next_accessor, dimension_travel_info, resource,
-      /*optimize_vehicle_costs=*/true, solver_[vehicle].get(), optimal_cumuls,
-      optimal_breaks, /*cost=*/nullptr, /*transit_cost=*/nullptr);
+      /*optimize_vehicle_costs=*/true, GetOrCreateSolver(vehicle),
+      optimal_cumuls, optimal_breaks, /*cost=*/nullptr,
+      /*transit_cost=*/nullptr);
 }
 
 DimensionSchedulingStatus
@@ -279,8 +288,8 @@ LocalDimensionCumulOptimizer::ComputeRouteCumulsAndCostWithoutFixedTransits(
     int64_t* optimal_cost_without_transits) {
   return optimizer_core_.OptimizeSingleRouteWithResource(
       vehicle, next_accessor, dimension_travel_info, nullptr,
-      /*optimize_vehicle_costs=*/true, solver_[vehicle].get(), optimal_cumuls,
-      optimal_breaks, optimal_cost_without_transits, nullptr);
+      /*optimize_vehicle_costs=*/true, GetOrCreateSolver(vehicle),
+      optimal_cumuls, optimal_breaks, optimal_cost_without_transits, nullptr);
 }
 
 DimensionSchedulingStatus
@@ -291,7 +300,7 @@ LocalDimensionCumulOptimizer::ComputeRouteSolutionCostWithoutFixedTransits(
     const std::vector<int64_t>& solution_break_values, int64_t* solution_cost,
     int64_t* cost_offset, bool reuse_previous_model_if_possible, bool clear_lp,
     absl::Duration* solve_duration) {
-  RoutingLinearSolverWrapper* solver = solver_[vehicle].get();
+  RoutingLinearSolverWrapper* solver = GetOrCreateSolver(vehicle);
   return optimizer_core_.ComputeSingleRouteSolutionCostWithoutFixedTransits(
       vehicle, next_accessor, dimension_travel_info, solver,
       solution_cumul_values, solution_break_values, solution_cost, cost_offset,
@@ -307,7 +316,7 @@ LocalDimensionCumulOptimizer::ComputePackedRouteCumuls(
     std::vector<int64_t>* packed_cumuls, std::vector<int64_t>* packed_breaks) {
   return optimizer_core_.OptimizeAndPackSingleRoute(
       vehicle, next_accessor, dimension_travel_info, resource,
-      solver_[vehicle].get(), packed_cumuls, packed_breaks);
+      GetOrCreateSolver(vehicle), packed_cumuls, packed_breaks);
 }
 
 const int CumulBoundsPropagator::kNoParent = -2;
@@ -684,6 +693,137 @@ void ClearIfNonNull(std::vector<T>* v) {
     v->clear();
   }
 }
+
+// A convex piecewise linear function of an integer, represented by the
+// breakpoints of its slope on both sides of its leftmost minimum ("slope
+// trick"): going left from the minimum, the slope decreases by 'weight' at each
+// breakpoint of left_, and going right from the end of the flat part of the
+// minimum, it increases by 'weight' at each breakpoint of right_. Breakpoints at
+// kint64min/kint64max are slope changes at infinity, when the function
+// decreases up to one of the infinities. The function value itself is not
+// represented, only its minimizers are.
+// Adding a hinge takes O(log(#breakpoints)) per breakpoint whose weight moves
+// to the other side of the minimum, shifting the function takes O(1).
+class ConvexPiecewiseLinearFunction {
+ public:
+  // Weight of the breakpoints of FixBounds(), which are steeper than the
+  // function can ever be.
+  static constexpr int64_t kBoundWeight = std::numeric_limits<int64_t>::max();
+
+  // Adds weight * max(0, position - x) to the function.
+  void AddLeftHinge(int64_t position, int64_t weight) {
+    DCHECK_GT(weight, 0);
+    if (!right_.empty() && position > RightTop()) {
+      PushRight(position, weight);
+      MoveWeightToLeft(weight);
+    } else {
+      PushLeft(position, weight);
+    }
+  }
+  // Adds weight * max(0, x - position) to the function.
+  void AddRightHinge(int64_t position, int64_t weight) {
+    DCHECK_GT(weight, 0);
+    if (!left_.empty() && position < LeftTop()) {
+      PushLeft(position, weight);
+      MoveWeightToRight(weight);
+    } else {
+      PushRight(position, weight);
+    }
+  }
+  // Adds slope * x to the function.
+  void AddLinear(int64_t slope) {
+    if (slope > 0) MoveWeightToRight(slope);
+    if (slope < 0) MoveWeightToLeft(CapOpp(slope));
+  }
+  // Restricts the function to [min, max], i.e. makes it infinite outside of
+  // this interval, assumed to intersect its domain.
+  void FixBounds(int64_t min, int64_t max) {
+    if (min > std::numeric_limits<int64_t>::min()) {
+      AddLeftHinge(min, kBoundWeight);
+    }
+    if (max < std::numeric_limits<int64_t>::max()) {
+      AddRightHinge(max, kBoundWeight);
+    }
+  }
+  // Replaces the function f by y -> min{f(x) | y - x in [min_delta,
+  // max_delta]}: the decreasing part of f is shifted by min_delta, its
+  // increasing part by max_delta.
+  void AddDeltaInterval(int64_t min_delta, int64_t max_delta) {
+    DCHECK_LE(min_delta, max_delta);
+    left_shift_ = CapAdd(left_shift_, min_delta);
+    right_shift_ = CapAdd(right_shift_, max_delta);
+  }
+  // Returns the smallest minimizer of the function, kint64min (resp.
+  // kint64max) if it decreases down to -infinity (resp. up to +infinity).
+  int64_t ArgMin() const {
+    return left_.empty() ? std::numeric_limits<int64_t>::min() : LeftTop();
+  }
+
+ private:
+  // Breakpoints are stored as (position - shift, weight), so that the
+  // positions of a whole side can be shifted in O(1).
+  using Breakpoint = std::pair<int64_t, int64_t>;
+
+  static bool IsInfinite(int64_t position) {
+    return position == std::numeric_limits<int64_t>::min() ||
+           position == std::numeric_limits<int64_t>::max();
+  }
+  static int64_t Shifted(int64_t position, int64_t shift) {
+    return IsInfinite(position) ? position : CapAdd(position, shift);
+  }
+  int64_t LeftTop() const { return Shifted(left_.top().first, left_shift_); }
+  int64_t RightTop() const {
+    return Shifted(right_.top().first, right_shift_);
+  }
+  void PushLeft(int64_t position, int64_t weight) {
+    left_.push({Shifted(position, CapOpp(left_shift_)), weight});
+  }
+  void PushRight(int64_t position, int64_t weight) {
+    right_.push({Shifted(position, CapOpp(right_shift_)), weight});
+  }
+  // Moves 'weight' from the breakpoints closest to the minimum on the left
+  // (resp. right) side to the other side, which shifts the minimum to the left
+  // (resp. right).
+  void MoveWeightToRight(int64_t weight) {
+    while (weight > 0) {
+      if (left_.empty()) {
+        PushRight(std::numeric_limits<int64_t>::min(), weight);
+        return;
+      }
+      const auto [position, top_weight] = left_.top();
+      left_.pop();
+      const int64_t moved_weight = std::min(weight, top_weight);
+      if (moved_weight < top_weight) {
+        left_.push({position, top_weight - moved_weight});
+      }
+      PushRight(Shifted(position, left_shift_), moved_weight);
+      weight -= moved_weight;
+    }
+  }
+  void MoveWeightToLeft(int64_t weight) {
+    while (weight > 0) {
+      if (right_.empty()) {
+        PushLeft(std::numeric_limits<int64_t>::max(), weight);
+        return;
+      }
+      const auto [position, top_weight] = right_.top();
+      right_.pop();
+      const int64_t moved_weight = std::min(weight, top_weight);
+      if (moved_weight < top_weight) {
+        right_.push({position, top_weight - moved_weight});
+      }
+      PushLeft(Shifted(position, right_shift_), moved_weight);
+      weight -= moved_weight;
+    }
+  }
+
+  std::priority_queue<Breakpoint> left_;
+  std::priority_queue<Breakpoint, std::vector<Breakpoint>,
+                      std::greater<Breakpoint>>
+      right_;
+  int64_t left_shift_ = 0;
+  int64_t right_shift_ = 0;
+};
 }  // namespace
 
 DimensionSchedulingStatus
@@ -698,6 +838,17 @@ DimensionCumulOptimizerCore::OptimizeSingleRouteWithResource(
   ClearIfNonNull(cumul_values);
   ClearIfNonNull(break_values);
 
+  if (resource == nullptr && dimension_travel_info.transition_info.empty() &&
+      clear_lp) {
+    DimensionSchedulingStatus status;
+    if (OptimizeSingleRouteWithoutLP(vehicle, next_accessor,
+                                     optimize_vehicle_costs, solver,
+                                     cumul_values, cost_without_transits,
+                                     transit_cost, &status)) {
+      return status;
+    }
+  }
+
   const std::vector<Resource> resources =
       resource == nullptr ? std::vector<Resource>()
                           : std::vector<Resource>({*resource});
@@ -733,6 +884,204 @@ DimensionCumulOptimizerCore::OptimizeSingleRouteWithResource(
   return status;
 }
 
+bool DimensionCumulOptimizerCore::OptimizeSingleRouteWithoutLP(
+    int vehicle, const std::function<int64_t(int64_t)>& next_accessor,
+    bool optimize_vehicle_costs, RoutingLinearSolverWrapper* solver,
+    std::vector<int64_t>* cumul_values, int64_t* cost_without_transits,
+    int64_t* transit_cost, DimensionSchedulingStatus* status) {
+  // Only the cumul bounds, the slacks, the linear soft bounds and the span and
+  // slack costs of SetRouteCumulConstraints() are supported.
+  if (propagator_ != nullptr || dimension_->HasBreakConstraints() ||
+      dimension_->HasPickupToDeliveryLimits() ||
+      dimension_->GetSpanUpperBoundForVehicle(vehicle) <
+          std::numeric_limits<int64_t>::max()) {
+    return false;
+  }
+  RoutingModel* const model = dimension_->model();
+  if (model->IsEnd(next_accessor(model->Start(vehicle))) &&
+      !model->IsVehicleUsedWhenEmpty(vehicle)) {
+    optimize_vehicle_costs = false;
+  }
+  if (optimize_vehicle_costs && dimension_->HasSoftSpanUpperBounds()) {
+    const BoundCost bound_cost =
+        dimension_->GetSoftSpanUpperBoundForVehicle(vehicle);
+    if (bound_cost.bound < std::numeric_limits<int64_t>::max() &&
+        bound_cost.cost > 0) {
+      return false;
+    }
+  }
+  std::vector<int64_t> path;
+  {
+    int node = model->Start(vehicle);
+    while (true) {
+      if (dimension_->forbidden_intervals()[node].NumIntervals() > 0) {
+        return false;
+      }
+      path.push_back(node);
+      if (model->IsEnd(node)) break;
+      node = next_accessor(node);
+    }
+    DCHECK_GE(path.size(), 2);
+  }
+  const int path_size = path.size();
+
+  const auto& transit_accessor = dimension_->transit_evaluator(vehicle);
+  std::vector<int64_t> fixed_transit(path_size - 1);
+  int64_t total_fixed_transit = 0;
+  for (int pos = 1; pos < path_size; ++pos) {
+    fixed_transit[pos - 1] = transit_accessor(path[pos - 1], path[pos]);
+    total_fixed_transit = CapAdd(total_fixed_transit, fixed_transit[pos - 1]);
+  }
+  const int64_t cumul_offset =
+      dimension_->GetLocalOptimizerOffsetForVehicle(vehicle);
+  if (!ExtractRouteCumulBounds(path, cumul_offset) ||
+      !TightenRouteCumulBounds(path, fixed_transit, cumul_offset)) {
+    if (!solver->ModelIsEmpty()) solver->Clear();
+    *status = DimensionSchedulingStatus::INFEASIBLE;
+    return true;
+  }
+  // The breakpoints of the functions below are shifted by sums of deltas,
+  // which must not overflow; the LP is used on larger values.
+  const int64_t max_value = std::numeric_limits<int64_t>::max() / 4;
+  const int64_t max_delta = max_value / path_size;
+  std::vector<int64_t> min_deltas(path_size - 1);
+  std::vector<int64_t> max_deltas(path_size - 1);
+  for (int pos = 0; pos < path_size; ++pos) {
+    if (current_route_min_cumuls_[pos] > max_value ||
+        (current_route_max_cumuls_[pos] > max_value &&
+         current_route_max_cumuls_[pos] <
+             std::numeric_limits<int64_t>::max())) {
+      return false;
+    }
+    if (pos == path_size - 1) break;
+    const IntVar* slack = dimension_->SlackVar(path[pos]);
+    min_deltas[pos] = CapAdd(fixed_transit[pos], slack->Min());
+    max_deltas[pos] = CapAdd(fixed_transit[pos], slack->Max());
+    if (std::abs(min_deltas[pos]) > max_delta ||
+        std::abs(max_deltas[pos]) > max_delta) {
+      return false;
+    }
+  }
+  if (!solver->ModelIsEmpty()) solver->Clear();
+  *status = DimensionSchedulingStatus::INFEASIBLE;
+
+  const int64_t span_cost_coef =
+      dimension_->GetSpanCostCoefficientForVehicle(vehicle);
+  const int64_t slack_cost_coef =
+      optimize_vehicle_costs
+          ? CapAdd(span_cost_coef,
+                   dimension_->GetSlackCostCoefficientForVehicle(vehicle))
+          : 0;
+  // The model is min sum_pos soft_costs(cumul[pos]) + slack_cost_coef *
+  // (cumul[end] - cumul[start]), s.t. cumul[pos] in [min_cumul, max_cumul] and
+  // cumul[pos + 1] - cumul[pos] in [min_delta, max_delta], with
+  // delta = transit + slack. Let f_pos(x) be the minimum of the soft costs up to
+  // pos minus slack_cost_coef * cumul[start], over the cumuls with
+  // cumul[pos] == x: f_pos is convex piecewise linear, and the best cumul[pos]
+  // given cumul[pos + 1] is the closest value to argmin(f_pos) compatible with
+  // cumul[pos + 1]. 'cumuls' first holds these argmins.
+  ConvexPiecewiseLinearFunction function;
+  std::vector<int64_t> cumuls(path_size);
+  int64_t reachable_min = current_route_min_cumuls_[0];
+  int64_t reachable_max = current_route_max_cumuls_[0];
+  for (int pos = 0; pos < path_size; ++pos) {
+    const int64_t node = path[pos];
+    const int64_t min_cumul = current_route_min_cumuls_[pos];
+    const int64_t max_cumul = current_route_max_cumuls_[pos];
+    if (pos > 0) {
+      function.AddDeltaInterval(min_deltas[pos - 1], max_deltas[pos - 1]);
+      reachable_min =
+          std::max(min_cumul, CapAdd(reachable_min, min_deltas[pos - 1]));
+      reachable_max =
+          std::min(max_cumul, CapAdd(reachable_max, max_deltas[pos - 1]));
+      if (reachable_min > reachable_max) return true;
+    }
+    function.FixBounds(min_cumul, max_cumul);
+    if (optimize_vehicle_costs) {
+      if (dimension_->HasCumulVarSoftLowerBound(node)) {
+        const int64_t coef =
+            dimension_->GetCumulVarSoftLowerBoundCoefficient(node);
+        const int64_t bound = std::max<int64_t>(
+            0, CapSub(dimension_->GetCumulVarSoftLowerBound(node),
+                      cumul_offset));
+        if (bound > max_value) return false;
+        if (coef > 0 && min_cumul < bound) {
+          function.AddLeftHinge(bound, coef);
+        }
+      }
+      if (dimension_->HasCumulVarSoftUpperBound(node)) {
+        const int64_t coef =
+            dimension_->GetCumulVarSoftUpperBoundCoefficient(node);
+        const int64_t bound = std::max<int64_t>(
+            0, CapSub(dimension_->GetCumulVarSoftUpperBound(node),
+                      cumul_offset));
+        if (bound > max_value) return false;
+        if (coef > 0 && max_cumul > bound) {
+          function.AddRightHinge(bound, coef);
+        }
+      }
+    }
+    if (pos == 0) function.AddLinear(CapOpp(slack_cost_coef));
+    if (pos == path_size - 1) function.AddLinear(slack_cost_coef);
+    cumuls[pos] = function.ArgMin();
+  }
+
+  // Backtrack from the best end cumul.
+  for (int pos = path_size - 2; pos >= 0; --pos) {
+    cumuls[pos] = std::clamp(cumuls[pos],
+                             CapSub(cumuls[pos + 1], max_deltas[pos]),
+                             CapSub(cumuls[pos + 1], min_deltas[pos]));
+    DCHECK_GE(cumuls[pos], current_route_min_cumuls_[pos]);
+    DCHECK_LE(cumuls[pos], current_route_max_cumuls_[pos]);
+  }
+  *status = DimensionSchedulingStatus::OPTIMAL;
+
+  if (transit_cost != nullptr) {
+    *transit_cost = optimize_vehicle_costs && span_cost_coef > 0
+                        ? CapProd(total_fixed_transit, span_cost_coef)
+                        : 0;
+  }
+  if (cost_without_transits != nullptr) {
+    // Same cost as the objective of the LP of SetRouteCumulConstraints(),
+    // plus its cost offset.
+    int64_t cost = 0;
+    for (int pos = 0; optimize_vehicle_costs && pos < path_size; ++pos) {
+      const int64_t node = path[pos];
+      if (dimension_->HasCumulVarSoftUpperBound(node)) {
+        const int64_t coef =
+            dimension_->GetCumulVarSoftUpperBoundCoefficient(node);
+        const int64_t bound = dimension_->GetCumulVarSoftUpperBound(node);
+        cost = CapAdd(
+            cost,
+            CapProd(coef, std::max<int64_t>(
+                              0, CapSub(CapAdd(cumuls[pos], cumul_offset),
+                                        bound))));
+      }
+      if (dimension_->HasCumulVarSoftLowerBound(node)) {
+        const int64_t coef =
+            dimension_->GetCumulVarSoftLowerBoundCoefficient(node);
+        const int64_t bound = std::max<int64_t>(
+            0, CapSub(dimension_->GetCumulVarSoftLowerBound(node),
+                      cumul_offset));
+        cost = CapAdd(cost, CapProd(coef, std::max<int64_t>(
+                                              0, CapSub(bound, cumuls[pos]))));
+      }
+    }
+    cost = CapAdd(
+        cost, CapProd(slack_cost_coef,
+                      CapSub(CapSub(cumuls.back(), cumuls.front()),
+                             total_fixed_transit)));
+    *cost_without_transits = cost;
+  }
+  if (cumul_values != nullptr) {
+    cumul_values->resize(path_size);
+    for (int pos = 0; pos < path_size; ++pos) {
+      (*cumul_values)[pos] = CapAdd(cumuls[pos], cumul_offset);
+    }
+  }
+  return true;
+}
+
 namespace {
 
 using ResourceGroup = RoutingModel::ResourceGroup;
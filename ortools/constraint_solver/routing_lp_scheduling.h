@@ -263,6 +263,14 @@ class RoutingLinearSolverWrapper {
   }
 };
 
+// The linear program is kept by Clear(): while the next model is built with the
+// same variables, constraints and coefficients, created in the same order, only
+// the bounds and objective of the kept program are updated. In that case,
+// glop's Solve() sees an unchanged matrix, and warm-starts its dual simplex
+// from the basis of the previous solve, which usually only takes a few pivots
+// when for instance the same route is checked again with different bounds.
+// As soon as the new model differs, the kept program is replaced by the part of
+// the model built so far and the rest of the model is built as usual.
 class RoutingGlopWrapper : public RoutingLinearSolverWrapper {
  public:
   RoutingGlopWrapper(bool is_relaxation, const glop::GlopParameters& parameters)
@@ -271,12 +279,23 @@ class RoutingGlopWrapper : public RoutingLinearSolverWrapper {
     linear_program_.SetMaximizationProblem(false);
   }
   void Clear() override {
-    linear_program_.Clear();
-    linear_program_.SetMaximizationProblem(false);
+    num_variables_ = 0;
+    num_constraints_ = 0;
+    reusing_program_ = true;
+    reused_coefficients_.clear();
     allowed_intervals_.clear();
   }
   int CreateNewPositiveVariable() override {
-    return linear_program_.CreateNewVariable().value();
+    const glop::ColIndex col(num_variables_);
+    if (reusing_program_ && col < linear_program_.num_variables()) {
+      linear_program_.SetVariableBounds(col, 0, glop::kInfinity);
+      linear_program_.SetObjectiveCoefficient(col, 0);
+    } else {
+      StopReusingProgram();
+      linear_program_.CreateNewVariable();
+    }
+    ++num_variables_;
+    return col.value();
   }
   void SetVariableName(int index, absl::string_view name) override {
     linear_program_.SetVariableName(glop::ColIndex(index), name);
@@ -325,15 +344,18 @@ class RoutingGlopWrapper : public RoutingLinearSolverWrapper {
     return linear_program_.objective_coefficients()[glop::ColIndex(index)];
   }
   void ClearObjective() override {
-    for (glop::ColIndex i(0); i < linear_program_.num_variables(); ++i) {
+    for (glop::ColIndex i(0); i < num_variables_; ++i) {
       linear_program_.SetObjectiveCoefficient(i, 0);
     }
   }
-  int NumVariables() const override {
-    return linear_program_.num_variables().value();
-  }
+  int NumVariables() const override { return num_variables_; }
   int CreateNewConstraint(int64_t lower_bound, int64_t upper_bound) override {
-    const glop::RowIndex ct = linear_program_.CreateNewConstraint();
+    const glop::RowIndex ct(num_constraints_);
+    if (!reusing_program_ || ct >= linear_program_.num_constraints()) {
+      StopReusingProgram();
+      linear_program_.CreateNewConstraint();
+    }
+    ++num_constraints_;
     linear_program_.SetConstraintBounds(
         ct,
         (lower_bound == std::numeric_limits<int64_t>::min()) ? -glop::kInfinity
@@ -346,8 +368,17 @@ class RoutingGlopWrapper : public RoutingLinearSolverWrapper {
     // Necessary to keep the model clean
     // (cf. glop::LinearProgram::NotifyThatColumnsAreClean).
     if (coefficient == 0.0) return;
-    linear_program_.SetCoefficient(glop::RowIndex(ct), glop::ColIndex(index),
-                                   coefficient);
+    const glop::RowIndex row(ct);
+    const glop::ColIndex col(index);
+    if (reusing_program_) {
+      if (linear_program_.GetSparseColumn(col).LookUpCoefficient(row) ==
+          coefficient) {
+        reused_coefficients_.push_back({row, col, coefficient});
+        return;
+      }
+      StopReusingProgram();
+    }
+    linear_program_.SetCoefficient(row, col, coefficient);
   }
   bool IsCPSATSolver() override { return false; }
   void AddObjectiveConstraint() override {
@@ -361,7 +392,7 @@ class RoutingGlopWrapper : public RoutingLinearSolverWrapper {
       // There are no terms in the objective.
       return;
     }
-    const glop::RowIndex ct = linear_program_.CreateNewConstraint();
+    const glop::RowIndex ct(CreateNewConstraint(0, 0));
     double normalized_objective_value = 0;
     for (int variable = 0; variable < NumVariables(); variable++) {
       const double coefficient = GetObjectiveCoefficient(variable);
@@ -384,6 +415,17 @@ class RoutingGlopWrapper : public RoutingLinearSolverWrapper {
   DimensionSchedulingStatus Solve(absl::Duration duration_limit) override {
     lp_solver_.GetMutableParameters()->set_max_time_in_seconds(
         absl::ToDoubleSeconds(duration_limit));
+    if (reusing_program_ &&
+        (glop::ColIndex(num_variables_) < linear_program_.num_variables() ||
+         glop::RowIndex(num_constraints_) < linear_program_.num_constraints() ||
+         static_cast<int64_t>(reused_coefficients_.size()) <
+             linear_program_.num_entries().value())) {
+      // The new model is a strict subset of the kept program.
+      StopReusingProgram();
+    }
+    // The program is now exactly the model, and can be modified directly.
+    reusing_program_ = false;
+    reused_coefficients_.clear();
 
     // Because we construct the lp one constraint at a time and we never call
     // SetCoefficient() on the same variable twice for a constraint, we know
@@ -438,8 +480,52 @@ class RoutingGlopWrapper : public RoutingLinearSolverWrapper {
   std::string PrintModel() const override { return linear_program_.Dump(); }
 
  private:
+  struct Coefficient {
+    glop::RowIndex row;
+    glop::ColIndex col;
+    double value;
+  };
+
+  // Replaces the kept linear program by the part of the model built since the
+  // last Clear(), and builds the rest of the model directly in it.
+  void StopReusingProgram() {
+    if (!reusing_program_) return;
+    reusing_program_ = false;
+    glop::LinearProgram program;
+    program.SetMaximizationProblem(false);
+    for (glop::ColIndex col(0); col < num_variables_; ++col) {
+      program.CreateNewVariable();
+      program.SetVariableBounds(col,
+                                linear_program_.variable_lower_bounds()[col],
+                                linear_program_.variable_upper_bounds()[col]);
+      program.SetObjectiveCoefficient(
+          col, linear_program_.objective_coefficients()[col]);
+    }
+    for (glop::RowIndex row(0); row < num_constraints_; ++row) {
+      program.CreateNewConstraint();
+      program.SetConstraintBounds(
+          row, linear_program_.constraint_lower_bounds()[row],
+          linear_program_.constraint_upper_bounds()[row]);
+    }
+    for (const Coefficient& coefficient : reused_coefficients_) {
+      program.SetCoefficient(coefficient.row, coefficient.col,
+                             coefficient.value);
+    }
+    reused_coefficients_.clear();
+    linear_program_.Swap(&program);
+  }
+
   const bool is_relaxation_;
   glop::LinearProgram linear_program_;
+  // Number of variables and constraints of the model built since the last
+  // Clear(), the first ones of linear_program_.
+  int num_variables_ = 0;
+  int num_constraints_ = 0;
+  // True while the model built since the last Clear() matches the beginning
+  // of linear_program_, in which case reused_coefficients_ contains the
+  // coefficients of this model.
+  bool reusing_program_ = false;
+  std::vector<Coefficient> reused_coefficients_;
   glop::LPSolver lp_solver_;
   absl::flat_hash_map<int, std::unique_ptr<SortedDisjointIntervalList>>
       allowed_intervals_;
@@ -729,6 +815,22 @@ class DimensionCumulOptimizerCore {
                                const std::vector<int64_t>& min_transits,
                                int64_t cumul_offset);
 
+  // Computes the optimal cumuls and cost of the route of "vehicle" without the
+  // linear solver, when the route's model of SetRouteCumulConstraints() only
+  // has cumul bounds, slacks, linear soft bounds and span/slack costs. Such a
+  // model is a chain of difference constraints with a separable convex
+  // objective, which is minimized in O(n log(n)) by propagating convex
+  // piecewise linear functions along the route.
+  // Returns false if the route has other constraints or costs (or values too
+  // large for this method), in which case the linear solver must be used.
+  // Otherwise, sets "status" and the outputs like
+  // OptimizeSingleRouteWithResource() and returns true.
+  bool OptimizeSingleRouteWithoutLP(
+      int vehicle, const std::function<int64_t(int64_t)>& next_accessor,
+      bool optimize_vehicle_costs, RoutingLinearSolverWrapper* solver,
+      std::vector<int64_t>* cumul_values, int64_t* cost_without_transits,
+      int64_t* transit_cost, DimensionSchedulingStatus* status);
+
   // Sets the constraints for all nodes on "vehicle"'s route according to
   // "next_accessor". If optimize_costs is true, also sets the objective
   // coefficients for the LP.
@@ -900,6 +1002,10 @@ class LocalDimensionCumulOptimizer {
   }
 
  private:
+  // Returns the solver of the given vehicle, creating it if needed.
+  RoutingLinearSolverWrapper* GetOrCreateSolver(int vehicle);
+
+  const RoutingSearchParameters::SchedulingSolver solver_type_;
   std::vector<std::unique_ptr<RoutingLinearSolverWrapper>> solver_;
   DimensionCumulOptimizerCore optimizer_core_;
 };
@@ -34,7 +34,7 @@ MakeRelocateNeighborsOperator::MakeRelocateNeighborsOperator(
     const std::vector<IntVar*>& vars,
     const std::vector<IntVar*>& secondary_vars,
     std::function<int(int64_t)> start_empty_path_class,
-    std::function<const std::vector<int>&(int, int)> get_neighbors,
+    std::function<absl::Span<const int>(int, int)> get_neighbors,
     RoutingTransitCallback2 arc_evaluator)
     : PathOperator(vars, secondary_vars,
                    /*number_of_base_nodes=*/get_neighbors == nullptr ? 2 : 1,
@@ -411,7 +411,7 @@ GroupPairAndRelocateOperator::GroupPairAndRelocateOperator(
     const std::vector<IntVar*>& vars,
     const std::vector<IntVar*>& secondary_vars,
     std::function<int(int64_t)> start_empty_path_class,
-    std::function<const std::vector<int>&(int, int)> get_neighbors,
+    std::function<absl::Span<const int>(int, int)> get_neighbors,
     const std::vector<PickupDeliveryPair>& pairs)
     : PathOperator(vars, secondary_vars,
                    /*number_of_base_nodes=*/get_neighbors == nullptr ? 2 : 1,
@@ -442,7 +442,7 @@ LightPairRelocateOperator::LightPairRelocateOperator(
     const std::vector<IntVar*>& vars,
     const std::vector<IntVar*>& secondary_vars,
     std::function<int(int64_t)> start_empty_path_class,
-    std::function<const std::vector<int>&(int, int)> get_neighbors,
+    std::function<absl::Span<const int>(int, int)> get_neighbors,
     const std::vector<PickupDeliveryPair>& pairs,
     std::function<bool(int64_t)> force_lifo)
     : PathOperator(vars, secondary_vars,
@@ -529,7 +529,7 @@ PairExchangeOperator::PairExchangeOperator(
     const std::vector<IntVar*>& vars,
     const std::vector<IntVar*>& secondary_vars,
     std::function<int(int64_t)> start_empty_path_class,
-    std::function<const std::vector<int>&(int, int)> get_neighbors,
+    std::function<absl::Span<const int>(int, int)> get_neighbors,
     const std::vector<PickupDeliveryPair>& pairs)
     : PathOperator(vars, secondary_vars,
                    /*number_of_base_nodes=*/get_neighbors == nullptr ? 2 : 1,
@@ -1043,7 +1043,7 @@ RelocateSubtrip::RelocateSubtrip(
     const std::vector<IntVar*>& vars,
     const std::vector<IntVar*>& secondary_vars,
     std::function<int(int64_t)> start_empty_path_class,
-    std::function<const std::vector<int>&(int, int)> get_neighbors,
+    std::function<absl::Span<const int>(int, int)> get_neighbors,
     const std::vector<PickupDeliveryPair>& pairs)
     : PathOperator(vars, secondary_vars,
                    /*number_of_base_nodes=*/get_neighbors == nullptr ? 2 : 1,
@@ -1171,7 +1171,7 @@ ExchangeSubtrip::ExchangeSubtrip(
     const std::vector<IntVar*>& vars,
     const std::vector<IntVar*>& secondary_vars,
     std::function<int(int64_t)> start_empty_path_class,
-    std::function<const std::vector<int>&(int, int)> get_neighbors,
+    std::function<absl::Span<const int>(int, int)> get_neighbors,
     const std::vector<PickupDeliveryPair>& pairs)
     : PathOperator(vars, secondary_vars,
                    /*number_of_base_nodes=*/get_neighbors == nullptr ? 2 : 1,
@@ -56,7 +56,7 @@ class MakeRelocateNeighborsOperator : public PathOperator {
       const std::vector<IntVar*>& vars,
       const std::vector<IntVar*>& secondary_vars,
       std::function<int(int64_t)> start_empty_path_class,
-      std::function<const std::vector<int>&(int, int)> get_neighbors,
+      std::function<absl::Span<const int>(int, int)> get_neighbors,
       RoutingTransitCallback2 arc_evaluator);
   MakeRelocateNeighborsOperator(
       const std::vector<IntVar*>& vars,
@@ -253,7 +253,7 @@ class GroupPairAndRelocateOperator : public PathOperator {
       const std::vector<IntVar*>& vars,
       const std::vector<IntVar*>& secondary_vars,
       std::function<int(int64_t)> start_empty_path_class,
-      std::function<const std::vector<int>&(int, int)> get_neighbors,
+      std::function<absl::Span<const int>(int, int)> get_neighbors,
       const std::vector<PickupDeliveryPair>& pairs);
   GroupPairAndRelocateOperator(
       const std::vector<IntVar*>& vars,
@@ -286,7 +286,7 @@ class LightPairRelocateOperator : public PathOperator {
       const std::vector<IntVar*>& vars,
       const std::vector<IntVar*>& secondary_vars,
       std::function<int(int64_t)> start_empty_path_class,
-      std::function<const std::vector<int>&(int, int)> get_neighbors,
+      std::function<absl::Span<const int>(int, int)> get_neighbors,
       const std::vector<PickupDeliveryPair>& pairs,
       std::function<bool(int64_t)> force_lifo = nullptr);
   LightPairRelocateOperator(const std::vector<IntVar*>& vars,
@@ -317,7 +317,7 @@ class PairExchangeOperator : public PathOperator {
       const std::vector<IntVar*>& vars,
       const std::vector<IntVar*>& secondary_vars,
       std::function<int(int64_t)> start_empty_path_class,
-      std::function<const std::vector<int>&(int, int)> get_neighbors,
+      std::function<absl::Span<const int>(int, int)> get_neighbors,
       const std::vector<PickupDeliveryPair>& pairs);
   PairExchangeOperator(const std::vector<IntVar*>& vars,
                        const std::vector<IntVar*>& secondary_vars,
@@ -658,7 +658,7 @@ class RelocateSubtrip : public PathOperator {
       const std::vector<IntVar*>& vars,
       const std::vector<IntVar*>& secondary_vars,
       std::function<int(int64_t)> start_empty_path_class,
-      std::function<const std::vector<int>&(int, int)> get_neighbors,
+      std::function<absl::Span<const int>(int, int)> get_neighbors,
       const std::vector<PickupDeliveryPair>& pairs);
   RelocateSubtrip(const std::vector<IntVar*>& vars,
                   const std::vector<IntVar*>& secondary_vars,
@@ -695,7 +695,7 @@ class ExchangeSubtrip : public PathOperator {
       const std::vector<IntVar*>& vars,
       const std::vector<IntVar*>& secondary_vars,
       std::function<int(int64_t)> start_empty_path_class,
-      std::function<const std::vector<int>&(int, int)> get_neighbors,
+      std::function<absl::Span<const int>(int, int)> get_neighbors,
       const std::vector<PickupDeliveryPair>& pairs);
   ExchangeSubtrip(const std::vector<IntVar*>& vars,
                   const std::vector<IntVar*>& secondary_vars,
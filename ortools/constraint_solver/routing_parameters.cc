@@ -72,6 +72,7 @@ RoutingSearchParameters CreateDefaultRoutingSearchParameters() {
   p.set_savings_add_reverse_arcs(false);
   p.set_savings_arc_coefficient(1);
   p.set_savings_parallel_routes(false);
+  p.set_savings_num_threads(1);
   p.set_cheapest_insertion_farthest_seeds_ratio(0);
   p.set_cheapest_insertion_first_solution_neighbors_ratio(1);
   p.set_cheapest_insertion_first_solution_min_neighbors(1);
@@ -80,6 +81,7 @@ RoutingSearchParameters CreateDefaultRoutingSearchParameters() {
   p.set_cheapest_insertion_first_solution_use_neighbors_ratio_for_initialization(  // NOLINT
       false);
   p.set_cheapest_insertion_add_unperformed_entries(false);
+  p.set_cheapest_insertion_first_solution_num_threads(1);
   p.set_local_cheapest_insertion_pickup_delivery_strategy(
       RoutingSearchParameters::BEST_PICKUP_THEN_BEST_DELIVERY);
   p.set_local_cheapest_cost_insertion_pickup_delivery_strategy(
@@ -157,6 +159,8 @@ RoutingSearchParameters CreateDefaultRoutingSearchParameters() {
   p.set_use_iterated_local_search(false);
   *p.mutable_iterated_local_search_parameters() =
       CreateDefaultIteratedLocalSearchParameters();
+  p.set_num_workers(1);
+  p.set_close_model_num_threads(1);
 
   const std::string error = FindErrorInRoutingSearchParameters(p);
   LOG_IF(DFATAL, !error.empty())
@@ -375,6 +379,22 @@ std::vector<std::string> FindErrorsInRoutingSearchParameters(
   }
   if (const int64_t lim = search_parameters.solution_limit(); lim < 1)
     errors.emplace_back(StrCat("Invalid solution_limit: ", lim));
+  if (const int32_t num = search_parameters.num_workers(); num < 0) {
+    errors.emplace_back(StrCat("Invalid num_workers: ", num));
+  }
+  if (const int32_t num = search_parameters.close_model_num_threads();
+      num < 0) {
+    errors.emplace_back(StrCat("Invalid close_model_num_threads: ", num));
+  }
+  if (const int32_t num = search_parameters.savings_num_threads(); num < 0) {
+    errors.emplace_back(StrCat("Invalid savings_num_threads: ", num));
+  }
+  if (const int32_t num =
+          search_parameters.cheapest_insertion_first_solution_num_threads();
+      num < 0) {
+    errors.emplace_back(StrCat(
+        "Invalid cheapest_insertion_first_solution_num_threads: ", num));
+  }
   if (!IsValidNonNegativeDuration(search_parameters.time_limit())) {
     errors.emplace_back("Invalid time_limit: " +
                         search_parameters.time_limit().ShortDebugString());
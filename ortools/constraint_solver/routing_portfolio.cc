@@ -0,0 +1,237 @@
+// Copyright 2010-2024 Google LLC
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "ortools/constraint_solver/routing_portfolio.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <iterator>
+#include <limits>
+#include <memory>
+#include <vector>
+
+#include "absl/base/thread_annotations.h"
+#include "absl/log/check.h"
+#include "absl/strings/str_cat.h"
+#include "absl/synchronization/mutex.h"
+#include "absl/time/clock.h"
+#include "absl/time/time.h"
+#include "ortools/base/logging.h"
+#include "ortools/base/protoutil.h"
+#include "ortools/base/threadpool.h"
+#include "ortools/constraint_solver/constraint_solver.h"
+#include "ortools/constraint_solver/routing.h"
+#include "ortools/constraint_solver/routing_enums.pb.h"
+#include "ortools/constraint_solver/routing_parameters.pb.h"
+
+namespace operations_research {
+
+namespace {
+
+// Number of slices of the time limit, i.e. of opportunities for a worker to
+// pick up the best solution of the others.
+constexpr int kNumTimeSlices = 10;
+
+// The best solution found so far by the workers, shared between them.
+class RoutingSolutionPool {
+ public:
+  // Replaces the best solution by `solution` if its cost is lower.
+  void Offer(const RoutingModel::SolutionSnapshot& solution) {
+    absl::MutexLock lock(&mutex_);
+    if (solution.objective_value >= cost_) return;
+    cost_ = solution.objective_value;
+    solution_ = solution;
+  }
+
+  // Copies the best solution into `solution` and returns true if its cost is
+  // lower than `cost`.
+  bool GetIfBetter(int64_t cost,
+                   RoutingModel::SolutionSnapshot* solution) const {
+    absl::MutexLock lock(&mutex_);
+    if (cost_ >= cost) return false;
+    *solution = solution_;
+    return true;
+  }
+
+ private:
+  mutable absl::Mutex mutex_;
+  int64_t cost_ ABSL_GUARDED_BY(mutex_) = std::numeric_limits<int64_t>::max();
+  RoutingModel::SolutionSnapshot solution_ ABSL_GUARDED_BY(mutex_);
+};
+
+// Returns an assignment of `model` holding the given solution, or nullptr if
+// it is not a solution of `model`. The assignment is owned by the caller, the
+// ones returned by the model being overwritten by its next search.
+std::unique_ptr<Assignment> RestoreSolution(
+    const RoutingModel::SolutionSnapshot& solution, RoutingModel* model) {
+  const Assignment* assignment = model->RestoreSolutionSnapshot(solution);
+  if (assignment == nullptr) return nullptr;
+  return std::make_unique<Assignment>(assignment);
+}
+
+// Runs the searches of one worker of SolveWithPortfolio() on `model` until
+// `deadline`, exchanging solutions with `pool`.
+void RunPortfolioWorker(const RoutingSearchParameters& parameters,
+                        absl::Time deadline, RoutingModel* model,
+                        RoutingSolutionPool* pool) {
+  int64_t cost = std::numeric_limits<int64_t>::max();
+  RoutingModel::SolutionSnapshot snapshot;
+  std::unique_ptr<Assignment> solution;
+  const auto record = [&](const Assignment* new_solution) {
+    if (new_solution == nullptr || new_solution->ObjectiveValue() >= cost) {
+      return false;
+    }
+    cost = new_solution->ObjectiveValue();
+    solution = std::make_unique<Assignment>(new_solution);
+    model->ExportSolutionSnapshot(*solution, &snapshot);
+    pool->Offer(snapshot);
+    return true;
+  };
+
+  if (deadline == absl::InfiniteFuture()) {
+    record(parameters.use_iterated_local_search()
+               ? model->SolveWithIteratedLocalSearch(parameters)
+               : model->SolveWithParameters(parameters));
+    return;
+  }
+  // The time spent building the models counts in the time limit.
+  RoutingSearchParameters slice_parameters = parameters;
+  *slice_parameters.mutable_time_limit() =
+      util_time::EncodeGoogleApiProto(
+          std::max(absl::ZeroDuration(), deadline - absl::Now()))
+          .value();
+  // The iterated local search always builds its own first solution, so it
+  // cannot be restarted from the solutions of the other workers.
+  if (parameters.use_iterated_local_search()) {
+    record(model->SolveWithIteratedLocalSearch(slice_parameters));
+    return;
+  }
+
+  const absl::Duration slice =
+      util_time::DecodeGoogleApiProto(parameters.time_limit()).value() /
+      kNumTimeSlices;
+  while (true) {
+    const absl::Time slice_start = absl::Now();
+    const absl::Duration slice_limit = std::min(slice, deadline - slice_start);
+    if (slice_limit <= absl::ZeroDuration()) break;
+    *slice_parameters.mutable_time_limit() =
+        util_time::EncodeGoogleApiProto(slice_limit).value();
+    bool imported = false;
+    if (pool->GetIfBetter(cost, &snapshot)) {
+      if (std::unique_ptr<Assignment> other = RestoreSolution(snapshot, model);
+          other != nullptr) {
+        imported = true;
+        cost = other->ObjectiveValue();
+        solution = std::move(other);
+      }
+    }
+    const bool improved =
+        record(solution == nullptr
+                   ? model->SolveWithParameters(slice_parameters)
+                   : model->SolveFromAssignmentWithParameters(
+                         solution.get(), slice_parameters));
+    // A search which stops well before its time limit without improving its
+    // starting point (e.g. a greedy descent at a local optimum) would only
+    // stop again from the same point.
+    if (!improved && !imported &&
+        absl::Now() - slice_start < 0.9 * slice_limit) {
+      break;
+    }
+  }
+}
+
+}  // namespace
+
+RoutingSearchParameters GetPortfolioWorkerParameters(
+    const RoutingSearchParameters& search_parameters, int worker) {
+  CHECK_GE(worker, 0);
+  RoutingSearchParameters parameters = search_parameters;
+  parameters.set_num_workers(1);
+  if (worker == 0) return parameters;
+  static constexpr FirstSolutionStrategy::Value kFirstSolutionStrategies[] = {
+      FirstSolutionStrategy::PATH_CHEAPEST_ARC,
+      FirstSolutionStrategy::PARALLEL_CHEAPEST_INSERTION,
+      FirstSolutionStrategy::LOCAL_CHEAPEST_INSERTION,
+      FirstSolutionStrategy::SAVINGS,
+      FirstSolutionStrategy::SEQUENTIAL_CHEAPEST_INSERTION,
+      FirstSolutionStrategy::CHRISTOFIDES,
+  };
+  static constexpr LocalSearchMetaheuristic::Value kMetaheuristics[] = {
+      LocalSearchMetaheuristic::GUIDED_LOCAL_SEARCH,
+      LocalSearchMetaheuristic::SIMULATED_ANNEALING,
+      LocalSearchMetaheuristic::TABU_SEARCH,
+  };
+  constexpr int kNumStrategies = std::size(kFirstSolutionStrategies);
+  constexpr int kNumMetaheuristics = std::size(kMetaheuristics);
+  // The metaheuristics and the iterated local search.
+  constexpr int kNumSearches = kNumMetaheuristics + 1;
+  parameters.set_first_solution_strategy(
+      kFirstSolutionStrategies[(worker - 1) % kNumStrategies]);
+  const int search = (worker - 1) % kNumSearches;
+  if (search < kNumMetaheuristics) {
+    parameters.set_local_search_metaheuristic(kMetaheuristics[search]);
+    parameters.set_use_iterated_local_search(false);
+  } else {
+    parameters.set_use_iterated_local_search(true);
+  }
+  parameters.set_use_multi_armed_bandit_concatenate_operators(
+      ((worker - 1) / kNumSearches) % 2 == 1);
+  parameters.set_log_tag(
+      absl::StrCat(search_parameters.log_tag(), " worker ", worker));
+  return parameters;
+}
+
+const Assignment* SolveWithPortfolio(
+    const RoutingSearchParameters& search_parameters,
+    const RoutingModelBuilder& build_model, RoutingModel* model) {
+  const int num_workers = std::max(1, search_parameters.num_workers());
+  const absl::Time deadline =
+      search_parameters.has_time_limit()
+          ? absl::Now() +
+                util_time::DecodeGoogleApiProto(search_parameters.time_limit())
+                    .value()
+          : absl::InfiniteFuture();
+  const int64_t size = model->Size();
+  const int num_vehicles = model->vehicles();
+  RoutingSolutionPool pool;
+  {
+    std::unique_ptr<ThreadPool> thread_pool;
+    if (num_workers > 1) {
+      thread_pool =
+          std::make_unique<ThreadPool>("RoutingPortfolio", num_workers - 1);
+      thread_pool->StartWorkers();
+    }
+    for (int worker = 1; worker < num_workers; ++worker) {
+      thread_pool->Schedule([&, worker]() {
+        std::unique_ptr<RoutingModel> worker_model = build_model();
+        CHECK(worker_model != nullptr);
+        CHECK_EQ(worker_model->Size(), size);
+        CHECK_EQ(worker_model->vehicles(), num_vehicles);
+        worker_model->solver()->ReSeed(worker);
+        RunPortfolioWorker(
+            GetPortfolioWorkerParameters(search_parameters, worker), deadline,
+            worker_model.get(), &pool);
+      });
+    }
+    RunPortfolioWorker(GetPortfolioWorkerParameters(search_parameters, 0),
+                       deadline, model, &pool);
+    // Waits for the other workers.
+  }
+  RoutingModel::SolutionSnapshot snapshot;
+  if (!pool.GetIfBetter(std::numeric_limits<int64_t>::max(), &snapshot)) {
+    return nullptr;
+  }
+  return model->RestoreSolutionSnapshot(snapshot);
+}
+
+}  // namespace operations_research
@@ -0,0 +1,77 @@
+// Copyright 2010-2024 Google LLC
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// A parallel portfolio of routing searches. A RoutingModel is its own
+// constraint solver and cannot be copied or shared between threads, so each
+// worker solves its own copy of the model, built by a user-provided function,
+// with its own first solution strategy, metaheuristic, operators and random
+// seed. The workers exchange their solutions, as snapshots (see
+// RoutingModel::SolutionSnapshot), through a pool of the best solution found so
+// far: the time limit is split into slices, and at the start of each slice a
+// worker restarts from the pool's solution if it is better than its own.
+//
+// Usage:
+//   RoutingIndexManager manager(...);
+//   const auto build_model = [&manager]() {
+//     auto model = std::make_unique<RoutingModel>(manager);
+//     // Register the callbacks, add the dimensions, etc.
+//     return model;
+//   };
+//   std::unique_ptr<RoutingModel> model = build_model();
+//   RoutingSearchParameters parameters = DefaultRoutingSearchParameters();
+//   parameters.set_num_workers(8);
+//   parameters.mutable_time_limit()->set_seconds(60);
+//   const Assignment* solution =
+//       SolveWithPortfolio(parameters, build_model, model.get());
+
+#ifndef OR_TOOLS_CONSTRAINT_SOLVER_ROUTING_PORTFOLIO_H_
+#define OR_TOOLS_CONSTRAINT_SOLVER_ROUTING_PORTFOLIO_H_
+
+#include <functional>
+#include <memory>
+
+#include "ortools/constraint_solver/constraint_solver.h"
+#include "ortools/constraint_solver/routing.h"
+#include "ortools/constraint_solver/routing_parameters.pb.h"
+
+namespace operations_research {
+
+// Returns a new model identical to the one given to SolveWithPortfolio(), and
+// in particular with the same node indices. It is called concurrently from
+// several threads, so it must only read the data it shares with other calls
+// (e.g. the RoutingIndexManager, which is never modified by a model).
+using RoutingModelBuilder = std::function<std::unique_ptr<RoutingModel>()>;
+
+// Solves `model` with `search_parameters.num_workers()` workers, and returns
+// the best solution found by any of them as an assignment of `model`, or
+// nullptr if none was found. The worker 0 runs on the calling thread and
+// solves `model` itself with `search_parameters`, the others solve models
+// returned by `build_model` with GetPortfolioWorkerParameters(). The
+// assignment is owned by `model`, as for RoutingModel::SolveWithParameters().
+//
+// Without a time limit, each worker runs a single search and no solution is
+// exchanged.
+const Assignment* SolveWithPortfolio(
+    const RoutingSearchParameters& search_parameters,
+    const RoutingModelBuilder& build_model, RoutingModel* model);
+
+// Returns the parameters used by the given worker of SolveWithPortfolio():
+// `search_parameters` for the worker 0, and for the others variations of them
+// which cycle through several first solution strategies and metaheuristics,
+// and alternately enable the multi-armed bandit concatenation of operators.
+RoutingSearchParameters GetPortfolioWorkerParameters(
+    const RoutingSearchParameters& search_parameters, int worker);
+
+}  // namespace operations_research
+
+#endif  // OR_TOOLS_CONSTRAINT_SOLVER_ROUTING_PORTFOLIO_H_
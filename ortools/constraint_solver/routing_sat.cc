@@ -1040,41 +1040,37 @@ bool ConvertGeneralizedResponseToSolution(const CpSolverResponse& response,
   return true;
 }
 
-// Uses CP solution as hint for CP-SAT.
-void AddSolutionAsHintToGeneralizedModel(const Assignment* solution,
-                                         const RoutingModel& model,
-                                         const ArcVarMap& arc_vars,
-                                         CpModelProto* cp_model) {
-  if (solution == nullptr) return;
-  PartialVariableAssignment* const hint = cp_model->mutable_solution_hint();
-  hint->Clear();
+// Calls `f(tail, arc_var)` for each arc tail-->head of a CP solution with the
+// variable arc_var in the generalized CP-SAT model.
+void ForEachSolutionArcVarOfGeneralizedModel(
+    const Assignment& solution, const RoutingModel& model,
+    const ArcVarMap& arc_vars,
+    const std::function<void(int64_t tail, int arc_var)>& f) {
   const int num_nodes = model.Nexts().size();
   for (int tail = 0; tail < num_nodes; ++tail) {
     const int cp_tail = tail + 1;
-    const int cp_head = solution->Value(model.NextVar(tail)) + 1;
+    const int cp_head = solution.Value(model.NextVar(tail)) + 1;
     const int* const arc_var = gtl::FindOrNull(arc_vars, {cp_tail, cp_head});
     // Arcs with a cost of max int64_t are not added to the model (considered as
     // infeasible). In some rare cases CP solutions might contain such arcs in
     // which case they are skipped here and a partial solution is used as a
     // hint.
     if (arc_var == nullptr) continue;
-    hint->add_vars(*arc_var);
-    hint->add_values(1);
+    f(tail, *arc_var);
   }
 }
 
-void AddSolutionAsHintToModel(const Assignment* solution,
-                              const RoutingModel& model,
-                              const ArcVarMap& arc_vars,
-                              CpModelProto* cp_model) {
-  if (solution == nullptr) return;
-  PartialVariableAssignment* const hint = cp_model->mutable_solution_hint();
-  hint->Clear();
+// Same as ForEachSolutionArcVarOfGeneralizedModel() for the model of
+// PopulateModelFromRoutingModel().
+void ForEachSolutionArcVarOfModel(
+    const Assignment& solution, const RoutingModel& model,
+    const ArcVarMap& arc_vars,
+    const std::function<void(int64_t tail, int arc_var)>& f) {
   const int depot = GetDepotFromModel(model);
   const int num_nodes = model.Nexts().size();
   for (int tail = 0; tail < num_nodes; ++tail) {
     const int tail_index = model.IsStart(tail) ? depot : tail;
-    const int head = solution->Value(model.NextVar(tail));
+    const int head = solution.Value(model.NextVar(tail));
     const int head_index = model.IsEnd(head) ? depot : head;
     if (tail_index == depot && head_index == depot) continue;
     const int* const var_index =
@@ -1084,8 +1080,7 @@ void AddSolutionAsHintToModel(const Assignment* solution,
     // which case they are skipped here and a partial solution is used as a
     // hint.
     if (var_index == nullptr) continue;
-    hint->add_vars(*var_index);
-    hint->add_values(1);
+    f(tail, *var_index);
   }
 }
 
@@ -1135,71 +1130,158 @@ bool IsFeasibleArcVarMap(const ArcVarMap& arc_vars, int max_node_index) {
 }  // namespace
 }  // namespace sat
 
-// Solves a RoutingModel using the CP-SAT solver. Returns false if no solution
-// was found.
-bool SolveModelWithSat(RoutingModel* model,
-                       const RoutingSearchParameters& search_parameters,
-                       const Assignment* initial_solution,
-                       Assignment* solution) {
+// The CP-SAT model of a RoutingModel, reused by the successive calls to
+// SolveModelWithSat(): only its hint, the scaling of its objective and the
+// variables fixed by SolveModelWithSatAroundSolution() change between solves.
+struct RoutingSatModelCache {
+  // Returns the cache of `model`, which is (re)built if it does not hold the
+  // generalized model when `generalized` is true, or the other model
+  // otherwise.
+  static RoutingSatModelCache* Get(RoutingModel* model, bool generalized);
+
+  bool generalized = false;
+  // False if the model cannot be solved with CP-SAT.
+  bool solvable = false;
+  sat::CpModelProto cp_model;
+  sat::ArcVarMap arc_vars;
+};
+
+RoutingSatModelCache* RoutingSatModelCache::Get(RoutingModel* model,
+                                                bool generalized) {
+  auto& cache = model->sat_model_cache_;
+  if (cache != nullptr && cache->generalized == generalized) {
+    return cache.get();
+  }
+  cache.reset(new RoutingSatModelCache);
+  cache->generalized = generalized;
+  if (generalized) {
+    cache->arc_vars = sat::PopulateGeneralizedRouteModelFromRoutingModel(
+        *model, &cache->cp_model);
+    const int max_node_index = model->Nexts().size() + model->vehicles();
+    cache->solvable = sat::IsFeasibleArcVarMap(cache->arc_vars, max_node_index);
+  } else if (sat::RoutingModelCanBeSolvedBySat(*model)) {
+    cache->arc_vars =
+        sat::PopulateModelFromRoutingModel(*model, &cache->cp_model);
+    cache->solvable = true;
+  }
+  return cache.get();
+}
+
+void RoutingSatModelCacheDeleter::operator()(
+    RoutingSatModelCache* cache) const {
+  delete cache;
+}
+
+namespace {
+
+// Solves a RoutingModel using the CP-SAT solver. If `fix_other_nodes` is true,
+// the arcs of `initial_solution` starting at nodes which are not in
+// `relaxed_nodes` are fixed. Returns false if no solution was found.
+bool SolveModelWithSatInternal(RoutingModel* model,
+                               const RoutingSearchParameters& search_parameters,
+                               const Assignment* initial_solution,
+                               absl::Span<const int64_t> relaxed_nodes,
+                               bool fix_other_nodes, Assignment* solution) {
   const absl::Duration remaining_time = model->RemainingTime();
   const absl::Time deadline = model->solver()->Now() + remaining_time;
-  sat::CpModelProto cp_model;
+  const bool generalized =
+      search_parameters.use_generalized_cp_sat() == BOOL_TRUE;
+  RoutingSatModelCache* const cache =
+      RoutingSatModelCache::Get(model, generalized);
+  if (!cache->solvable) return false;
+  sat::CpModelProto& cp_model = cache->cp_model;
+  const sat::ArcVarMap& arc_vars = cache->arc_vars;
   cp_model.mutable_objective()->set_scaling_factor(
       search_parameters.log_cost_scaling_factor());
   cp_model.mutable_objective()->set_offset(search_parameters.log_cost_offset());
   const sat::CpObjectiveProto& objective = cp_model.objective();
+
+  // The fixed variables and their original domains, restored after the solve.
+  std::vector<std::pair<int, sat::IntegerVariableProto>> fixed_variables;
+  cp_model.clear_solution_hint();
+  if (initial_solution != nullptr) {
+    std::vector<bool> is_relaxed;
+    if (fix_other_nodes) {
+      is_relaxed.assign(model->Size(), false);
+      for (const int64_t node : relaxed_nodes) {
+        DCHECK_GE(node, 0);
+        DCHECK_LT(node, model->Size());
+        is_relaxed[node] = true;
+      }
+    }
+    sat::PartialVariableAssignment* const hint =
+        cp_model.mutable_solution_hint();
+    const auto add_solution_arc = [&](int64_t tail, int arc_var) {
+      hint->add_vars(arc_var);
+      hint->add_values(1);
+      if (!fix_other_nodes || is_relaxed[tail]) return;
+      fixed_variables.push_back({arc_var, cp_model.variables(arc_var)});
+      sat::IntegerVariableProto* const variable =
+          cp_model.mutable_variables(arc_var);
+      variable->clear_domain();
+      variable->add_domain(1);
+      variable->add_domain(1);
+    };
+    if (generalized) {
+      sat::ForEachSolutionArcVarOfGeneralizedModel(*initial_solution, *model,
+                                                   arc_vars, add_solution_arc);
+    } else {
+      sat::ForEachSolutionArcVarOfModel(*initial_solution, *model, arc_vars,
+                                        add_solution_arc);
+    }
+  }
+
+  const auto convert_to_solution = [generalized, &objective, model, &arc_vars](
+                                       const sat::CpSolverResponse& response,
+                                       Assignment* solution) {
+    return generalized
+               ? sat::ConvertGeneralizedResponseToSolution(
+                     response, objective, *model, arc_vars, solution)
+               : sat::ConvertToSolution(response, objective, *model, arc_vars,
+                                        solution);
+  };
   const std::function<void(const sat::CpSolverResponse& response)>
       null_observer;
-  if (search_parameters.use_generalized_cp_sat() == BOOL_TRUE) {
-    const sat::ArcVarMap arc_vars =
-        sat::PopulateGeneralizedRouteModelFromRoutingModel(*model, &cp_model);
-    const int max_node_index = model->Nexts().size() + model->vehicles();
-    if (!sat::IsFeasibleArcVarMap(arc_vars, max_node_index)) return false;
-    sat::AddSolutionAsHintToGeneralizedModel(initial_solution, *model, arc_vars,
-                                             &cp_model);
-    const std::function<void(const sat::CpSolverResponse& response)> observer =
-        search_parameters.report_intermediate_cp_sat_solutions() ?
-        [model, &objective, &arc_vars, solution, deadline]
-        (const sat::CpSolverResponse& response) {
-          // TODO(user): Check that performance is acceptable.
-          sat::ConvertGeneralizedResponseToSolution(
-              response, objective, *model, arc_vars, solution);
-          const absl::Duration remaining_time =
-              deadline - model->solver()->Now();
-          if (remaining_time < absl::ZeroDuration()) return;
-          model->UpdateTimeLimit(remaining_time);
-          model->CheckIfAssignmentIsFeasible(
-              *solution,
-              /*call_at_solution_monitors=*/true);
-        } : null_observer;
-    return sat::ConvertGeneralizedResponseToSolution(
-        sat::SolveRoutingModel(cp_model, remaining_time,
-                               model->GetMutableCPSatInterrupt(),
-                               search_parameters, observer),
-        objective, *model, arc_vars, solution);
-  }
-  if (!sat::RoutingModelCanBeSolvedBySat(*model)) return false;
-  const sat::ArcVarMap arc_vars =
-      sat::PopulateModelFromRoutingModel(*model, &cp_model);
-  sat::AddSolutionAsHintToModel(initial_solution, *model, arc_vars, &cp_model);
   const std::function<void(const sat::CpSolverResponse& response)> observer =
       search_parameters.report_intermediate_cp_sat_solutions() ?
-      [model, &objective, &arc_vars, solution, deadline]
+      [model, &convert_to_solution, solution, deadline]
       (const sat::CpSolverResponse& response) {
         // TODO(user): Check that performance is acceptable.
-        sat::ConvertToSolution(response, objective, *model, arc_vars, solution);
+        convert_to_solution(response, solution);
         const absl::Duration remaining_time = deadline - model->solver()->Now();
         if (remaining_time < absl::ZeroDuration()) return;
         model->UpdateTimeLimit(remaining_time);
-
         model->CheckIfAssignmentIsFeasible(*solution,
                                            /*call_at_solution_monitors=*/true);
       } : null_observer;
-  return sat::ConvertToSolution(
-      sat::SolveRoutingModel(cp_model, remaining_time,
-                             model->GetMutableCPSatInterrupt(),
-                             search_parameters, observer),
-      objective, *model, arc_vars, solution);
+  const sat::CpSolverResponse response = sat::SolveRoutingModel(
+      cp_model, remaining_time, model->GetMutableCPSatInterrupt(),
+      search_parameters, observer);
+  for (auto it = fixed_variables.rbegin(); it != fixed_variables.rend(); ++it) {
+    *cp_model.mutable_variables(it->first) = std::move(it->second);
+  }
+  return convert_to_solution(response, solution);
+}
+
+}  // namespace
+
+bool SolveModelWithSat(RoutingModel* model,
+                       const RoutingSearchParameters& search_parameters,
+                       const Assignment* initial_solution,
+                       Assignment* solution) {
+  return SolveModelWithSatInternal(model, search_parameters, initial_solution,
+                                   /*relaxed_nodes=*/{},
+                                   /*fix_other_nodes=*/false, solution);
+}
+
+bool SolveModelWithSatAroundSolution(
+    RoutingModel* model, const RoutingSearchParameters& search_parameters,
+    const Assignment* initial_solution, absl::Span<const int64_t> relaxed_nodes,
+    Assignment* solution) {
+  CHECK(initial_solution != nullptr);
+  return SolveModelWithSatInternal(model, search_parameters, initial_solution,
+                                   relaxed_nodes, /*fix_other_nodes=*/true,
+                                   solution);
 }
 
 }  // namespace operations_research
@@ -43,10 +43,13 @@
 #include "absl/log/die_if_null.h"
 #include "absl/strings/str_cat.h"
 #include "absl/strings/string_view.h"
+#include "absl/types/span.h"
+#include "ortools/algorithms/radix_sort.h"
 #include "ortools/base/adjustable_priority_queue.h"
 #include "ortools/base/logging.h"
 #include "ortools/base/map_util.h"
 #include "ortools/base/stl_util.h"
+#include "ortools/base/threadpool.h"
 #include "ortools/base/types.h"
 #include "ortools/constraint_solver/constraint_solver.h"
 #include "ortools/constraint_solver/constraint_solveri.h"
@@ -715,6 +718,15 @@ GlobalCheapestInsertionFilteredHeuristic::
   CHECK_GT(gci_params_.neighbors_ratio, 0);
   CHECK_LE(gci_params_.neighbors_ratio, 1);
   CHECK_GE(gci_params_.min_neighbors, 1);
+  CHECK_GE(gci_params_.num_threads, 1);
+  // Without an evaluator, the insertion costs are computed by the filters,
+  // which cannot be called concurrently.
+  if (gci_params_.num_threads > 1 && evaluator_ != nullptr) {
+    thread_pool_ = std::make_unique<ThreadPool>(
+        "GlobalCheapestInsertion", gci_params_.num_threads);
+    thread_pool_->StartWorkers();
+    worker_buffers_.resize(gci_params_.num_threads);
+  }
 }
 
 bool GlobalCheapestInsertionFilteredHeuristic::CheckVehicleIndices() const {
@@ -1980,11 +1992,8 @@ bool GlobalCheapestInsertionFilteredHeuristic::InitializePositions(
       vehicles.empty() ? model()->vehicles() : vehicles.size();
   const bool all_vehicles = (num_vehicles == model()->vehicles());
 
-  for (int node = 0; node < nodes.size(); node++) {
-    if (!nodes[node] || Contains(node)) {
-      continue;
-    }
-    if (StopSearch()) return false;
+  const auto add_entries = [this, &vehicles, all_vehicles](int node,
+                                                           auto* queue) {
     // Add insertion entry making node unperformed.
     if (gci_params_.add_unperformed_entries &&
         GetUnperformedValue(node) != std::numeric_limits<int64_t>::max()) {
@@ -1992,14 +2001,61 @@ bool GlobalCheapestInsertionFilteredHeuristic::InitializePositions(
     }
     // Add all insertion entries making node performed.
     InitializeInsertionEntriesPerformingNode(node, vehicles, queue);
+  };
+  if (thread_pool_ == nullptr) {
+    for (int node = 0; node < nodes.size(); node++) {
+      if (!nodes[node] || Contains(node)) {
+        continue;
+      }
+      if (StopSearch()) return false;
+      add_entries(node, queue);
+    }
+    return true;
+  }
+
+  // StopSearch() can only be called from this thread, so the nodes are
+  // processed by blocks, checking the limits in between.
+  constexpr int kNodesPerBlock = 1024;
+  std::vector<int> block;
+  block.reserve(kNodesPerBlock);
+  for (int node = 0; node < nodes.size(); node++) {
+    if (nodes[node] && !Contains(node)) block.push_back(node);
+    if (block.size() < kNodesPerBlock && node + 1 < nodes.size()) continue;
+    if (StopSearch()) return false;
+    ParallelAddNodeEntries(
+        block.size(),
+        [&block, &add_entries](int64_t i, NodeInsertionBuffer* buffer) {
+          add_entries(block[i], buffer);
+        },
+        queue);
+    block.clear();
   }
   return true;
 }
 
+void GlobalCheapestInsertionFilteredHeuristic::ParallelAddNodeEntries(
+    int64_t num_items,
+    const std::function<void(int64_t, NodeInsertionBuffer*)>& add_entries,
+    NodeEntryQueue* queue) {
+  DCHECK(thread_pool_ != nullptr);
+  ParallelForEachItem(thread_pool_.get(), gci_params_.num_threads, num_items,
+                      [this, &add_entries](int worker, int64_t i) {
+                        add_entries(i, &worker_buffers_[worker]);
+                      });
+  for (NodeInsertionBuffer& buffer : worker_buffers_) {
+    for (const NodeInsertionBuffer::Insertion& insertion : buffer.insertions) {
+      queue->PushInsertion(insertion.node, insertion.insert_after,
+                           insertion.vehicle, insertion.bucket,
+                           insertion.value);
+    }
+    buffer.insertions.clear();
+  }
+}
+
+template <typename Queue>
 void GlobalCheapestInsertionFilteredHeuristic::
     InitializeInsertionEntriesPerformingNode(
-        int64_t node, const absl::flat_hash_set<int>& vehicles,
-        NodeEntryQueue* queue) {
+        int64_t node, const absl::flat_hash_set<int>& vehicles, Queue* queue) {
   const int num_vehicles =
       vehicles.empty() ? model()->vehicles() : vehicles.size();
   const bool all_vehicles = (num_vehicles == model()->vehicles());
@@ -2092,9 +2148,23 @@ bool GlobalCheapestInsertionFilteredHeuristic::AddNodeEntriesAfter(
   // Remove existing entries at 'insert_after', needed either when updating
   // entries or if unperformed node insertions were present.
   queue->ClearInsertions(insert_after);
-  for (int node :
-       node_index_to_neighbors_by_cost_class_->GetNeighborsOfNodeForCostClass(
-           cost_class, insert_after)) {
+  const absl::Span<const int> neighbors =
+      node_index_to_neighbors_by_cost_class_->GetNeighborsOfNodeForCostClass(
+          cost_class, insert_after);
+  if (thread_pool_ != nullptr) {
+    if (StopSearch()) return false;
+    ParallelAddNodeEntries(
+        neighbors.size(),
+        [&](int64_t i, NodeInsertionBuffer* buffer) {
+          const int node = neighbors[i];
+          if (!Contains(node) && nodes[node]) {
+            AddNodeEntry(node, insert_after, vehicle, all_vehicles, buffer);
+          }
+        },
+        queue);
+    return true;
+  }
+  for (int node : neighbors) {
     if (StopSearch()) return false;
     if (!Contains(node) && nodes[node]) {
       AddNodeEntry(node, insert_after, vehicle, all_vehicles, queue);
@@ -2103,9 +2173,10 @@ bool GlobalCheapestInsertionFilteredHeuristic::AddNodeEntriesAfter(
   return true;
 }
 
+template <typename Queue>
 void GlobalCheapestInsertionFilteredHeuristic::AddNodeEntry(
     int64_t node, int64_t insert_after, int vehicle, bool all_vehicles,
-    NodeEntryQueue* queue) const {
+    Queue* queue) const {
   const int64_t node_penalty = GetUnperformedValue(node);
   const int64_t penalty_shift =
       absl::GetFlag(FLAGS_routing_shift_insertion_cost_by_penalty)
@@ -3130,9 +3201,10 @@ void ComparatorCheapestAdditionFilteredHeuristic::SortSuccessors(
 template <typename Saving>
 class SavingsFilteredHeuristic::SavingsContainer {
  public:
-  explicit SavingsContainer(const SavingsFilteredHeuristic* savings_db,
-                            int vehicle_types)
+  SavingsContainer(const SavingsFilteredHeuristic* savings_db,
+                   int vehicle_types, int num_threads)
       : savings_db_(savings_db),
+        num_threads_(num_threads),
         index_in_sorted_savings_(0),
         vehicle_types_(vehicle_types),
         single_vehicle_type_(vehicle_types == 1),
@@ -3180,9 +3252,19 @@ class SavingsFilteredHeuristic::SavingsContainer {
   void Sort() {
     CHECK(!sorted_) << "Container already sorted!";
 
+    // The savings of a vehicle type are added by increasing before node and
+    // then after node (see ComputeSavings()), so a stable sort of their saving
+    // values orders them as Saving::operator< does.
+    std::vector<int64_t> saving_values;
     for (std::vector<Saving>& savings : sorted_savings_per_vehicle_type_) {
-      absl::c_sort(savings);
+      saving_values.resize(savings.size());
+      absl::c_transform(savings, saving_values.begin(),
+                        [](const Saving& saving) { return saving.saving; });
+      RadixSortWithPayload(absl::MakeSpan(saving_values),
+                           absl::MakeSpan(savings), num_threads_);
+      DCHECK(absl::c_is_sorted(savings));
     }
+    gtl::STLClearObject(&saving_values);
 
     if (single_vehicle_type_) {
       const auto& savings = sorted_savings_per_vehicle_type_[0];
@@ -3484,6 +3566,7 @@ class SavingsFilteredHeuristic::SavingsContainer {
   }
 
   const SavingsFilteredHeuristic* const savings_db_;
+  const int num_threads_;
   int64_t index_in_sorted_savings_;
   std::vector<std::vector<Saving>> sorted_savings_per_vehicle_type_;
   std::vector<SavingAndArc> sorted_savings_;
@@ -3520,6 +3603,13 @@ SavingsFilteredHeuristic::SavingsFilteredHeuristic(
   DCHECK_LE(savings_params_.neighbors_ratio, 1);
   DCHECK_GT(savings_params_.max_memory_usage_bytes, 0);
   DCHECK_GT(savings_params_.arc_coefficient, 0);
+  CHECK_GE(savings_params_.num_threads, 1);
+  if (savings_params_.num_threads > 1 &&
+      savings_params_.arc_cost_for_class != nullptr) {
+    thread_pool_ = std::make_unique<ThreadPool>("Savings",
+                                                savings_params_.num_threads);
+    thread_pool_->StartWorkers();
+  }
 }
 
 SavingsFilteredHeuristic::~SavingsFilteredHeuristic() {}
@@ -3604,16 +3694,34 @@ bool SavingsFilteredHeuristic::ComputeSavings() {
       uncontained_non_start_end_nodes.push_back(node);
     }
   }
+  const int num_nodes = uncontained_non_start_end_nodes.size();
 
   const int64_t saving_neighbors =
       std::min(MaxNumNeighborsPerNode(num_vehicle_types),
-               static_cast<int64_t>(uncontained_non_start_end_nodes.size()));
+               static_cast<int64_t>(num_nodes));
 
-  savings_container_ =
-      std::make_unique<SavingsContainer<Saving>>(this, num_vehicle_types);
+  const int num_workers =
+      thread_pool_ == nullptr ? 1 : savings_params_.num_threads;
+  savings_container_ = std::make_unique<SavingsContainer<Saving>>(
+      this, num_vehicle_types, num_workers);
   savings_container_->InitializeContainer(size, saving_neighbors);
   if (StopSearch()) return false;
   std::vector<std::vector<int64_t>> adjacency_lists(size);
+  std::vector<std::vector<std::pair</*cost*/ int64_t, /*node*/ int64_t>>>
+      costed_after_nodes_per_worker(num_workers);
+  // The savings of the current vehicle type, by increasing before node and
+  // then after node: the savings of uncontained_non_start_end_nodes[i] are in
+  // [saving_offsets[i], saving_offsets[i + 1]).
+  std::vector<int64_t> saving_offsets(num_nodes + 1, 0);
+  std::vector<Saving> savings;
+  std::vector<int64_t> total_costs;
+  // The search limits can only be checked from the calling thread, i.e. when
+  // the nodes are not processed concurrently.
+  bool stopped = false;
+  const auto stop_search = [this, &stopped]() {
+    if (thread_pool_ == nullptr && !stopped) stopped = StopSearch();
+    return stopped;
+  };
 
   for (int type = 0; type < num_vehicle_types; ++type) {
     const int vehicle =
@@ -3628,77 +3736,109 @@ bool SavingsFilteredHeuristic::ComputeSavings() {
 
     // Compute the neighbors for each non-start/end node not already inserted in
     // the model.
-    for (int before_node : uncontained_non_start_end_nodes) {
-      std::vector<std::pair</*cost*/ int64_t, /*node*/ int64_t>>
-          costed_after_nodes;
-      costed_after_nodes.reserve(uncontained_non_start_end_nodes.size());
-      if (StopSearch()) return false;
-      for (int after_node : uncontained_non_start_end_nodes) {
-        if (after_node != before_node) {
-          costed_after_nodes.push_back(std::make_pair(
-              model()->GetArcCostForClass(before_node, after_node, cost_class),
-              after_node));
-        }
-      }
-      if (saving_neighbors < costed_after_nodes.size()) {
-        std::nth_element(costed_after_nodes.begin(),
-                         costed_after_nodes.begin() + saving_neighbors,
-                         costed_after_nodes.end());
-        costed_after_nodes.resize(saving_neighbors);
-      }
-      adjacency_lists[before_node].resize(costed_after_nodes.size());
-      std::transform(costed_after_nodes.begin(), costed_after_nodes.end(),
-                     adjacency_lists[before_node].begin(),
-                     [](std::pair<int64_t, int64_t> cost_and_node) {
-                       return cost_and_node.second;
-                     });
-    }
+    ParallelForEachItem(
+        thread_pool_.get(), num_workers, num_nodes,
+        [&](int worker, int64_t i) {
+          if (stop_search()) return;
+          const int64_t before_node = uncontained_non_start_end_nodes[i];
+          std::vector<std::pair<int64_t, int64_t>>& costed_after_nodes =
+              costed_after_nodes_per_worker[worker];
+          costed_after_nodes.clear();
+          costed_after_nodes.reserve(num_nodes);
+          for (int64_t after_node : uncontained_non_start_end_nodes) {
+            if (after_node != before_node) {
+              costed_after_nodes.push_back(std::make_pair(
+                  GetArcCost(before_node, after_node, cost_class),
+                  after_node));
+            }
+          }
+          if (saving_neighbors < costed_after_nodes.size()) {
+            std::nth_element(costed_after_nodes.begin(),
+                             costed_after_nodes.begin() + saving_neighbors,
+                             costed_after_nodes.end());
+            costed_after_nodes.resize(saving_neighbors);
+          }
+          adjacency_lists[before_node].resize(costed_after_nodes.size());
+          std::transform(costed_after_nodes.begin(), costed_after_nodes.end(),
+                         adjacency_lists[before_node].begin(),
+                         [](std::pair<int64_t, int64_t> cost_and_node) {
+                           return cost_and_node.second;
+                         });
+        });
+    if (stopped) return false;
     if (savings_params_.add_reverse_arcs) {
       AddSymmetricArcsToAdjacencyLists(&adjacency_lists);
     }
     if (StopSearch()) return false;
 
+    // Keep the after nodes of the savings by increasing index, which lets the
+    // container sort the savings of a type by saving value only (see
+    // SavingsContainer::Sort()).
+    for (int i = 0; i < num_nodes; ++i) {
+      const int64_t before_node = uncontained_non_start_end_nodes[i];
+      std::vector<int64_t>& after_nodes = adjacency_lists[before_node];
+      after_nodes.erase(
+          std::remove_if(after_nodes.begin(), after_nodes.end(),
+                         [this, before_node](int64_t after_node) {
+                           return model()->IsStart(after_node) ||
+                                  model()->IsEnd(after_node) ||
+                                  before_node == after_node ||
+                                  Contains(after_node);
+                         }),
+          after_nodes.end());
+      if (!savings_params_.add_reverse_arcs) absl::c_sort(after_nodes);
+      saving_offsets[i + 1] = saving_offsets[i] + after_nodes.size();
+    }
+    savings.resize(saving_offsets[num_nodes]);
+    total_costs.resize(saving_offsets[num_nodes]);
+
     // Build the savings for this vehicle type given the adjacency_lists.
-    for (int before_node : uncontained_non_start_end_nodes) {
-      const int64_t before_to_end_cost =
-          model()->GetArcCostForClass(before_node, end, cost_class);
-      const int64_t start_to_before_cost =
-          CapSub(model()->GetArcCostForClass(start, before_node, cost_class),
-                 fixed_cost);
-      if (StopSearch()) return false;
-      for (int64_t after_node : adjacency_lists[before_node]) {
-        if (model()->IsStart(after_node) || model()->IsEnd(after_node) ||
-            before_node == after_node || Contains(after_node)) {
-          continue;
-        }
-        const int64_t arc_cost =
-            model()->GetArcCostForClass(before_node, after_node, cost_class);
-        const int64_t start_to_after_cost =
-            CapSub(model()->GetArcCostForClass(start, after_node, cost_class),
-                   fixed_cost);
-        const int64_t after_to_end_cost =
-            model()->GetArcCostForClass(after_node, end, cost_class);
-
-        const double weighted_arc_cost_fp =
-            savings_params_.arc_coefficient * arc_cost;
-        const int64_t weighted_arc_cost =
-            weighted_arc_cost_fp < std::numeric_limits<int64_t>::max()
-                ? static_cast<int64_t>(weighted_arc_cost_fp)
-                : std::numeric_limits<int64_t>::max();
-        const int64_t saving_value = CapSub(
-            CapAdd(before_to_end_cost, start_to_after_cost), weighted_arc_cost);
-
-        const Saving saving =
-            BuildSaving(-saving_value, type, before_node, after_node);
-
-        const int64_t total_cost =
-            CapAdd(CapAdd(start_to_before_cost, arc_cost), after_to_end_cost);
-
-        savings_container_->AddNewSaving(saving, total_cost, before_node,
-                                         after_node, type);
-      }
-    }
-  }
+    ParallelForEachItem(
+        thread_pool_.get(), num_workers, num_nodes,
+        [&](int /*worker*/, int64_t i) {
+          if (stop_search()) return;
+          const int64_t before_node = uncontained_non_start_end_nodes[i];
+          const int64_t before_to_end_cost =
+              GetArcCost(before_node, end, cost_class);
+          const int64_t start_to_before_cost =
+              CapSub(GetArcCost(start, before_node, cost_class), fixed_cost);
+          int64_t saving_index = saving_offsets[i];
+          for (int64_t after_node : adjacency_lists[before_node]) {
+            const int64_t arc_cost =
+                GetArcCost(before_node, after_node, cost_class);
+            const int64_t start_to_after_cost =
+                CapSub(GetArcCost(start, after_node, cost_class), fixed_cost);
+            const int64_t after_to_end_cost =
+                GetArcCost(after_node, end, cost_class);
+
+            const double weighted_arc_cost_fp =
+                savings_params_.arc_coefficient * arc_cost;
+            const int64_t weighted_arc_cost =
+                weighted_arc_cost_fp < std::numeric_limits<int64_t>::max()
+                    ? static_cast<int64_t>(weighted_arc_cost_fp)
+                    : std::numeric_limits<int64_t>::max();
+            const int64_t saving_value =
+                CapSub(CapAdd(before_to_end_cost, start_to_after_cost),
+                       weighted_arc_cost);
+
+            savings[saving_index] =
+                BuildSaving(-saving_value, type, before_node, after_node);
+            total_costs[saving_index] = CapAdd(
+                CapAdd(start_to_before_cost, arc_cost), after_to_end_cost);
+            ++saving_index;
+          }
+        });
+    if (stopped || StopSearch()) return false;
+    for (int64_t saving_index = 0; saving_index < savings.size();
+         ++saving_index) {
+      const Saving& saving = savings[saving_index];
+      savings_container_->AddNewSaving(saving, total_costs[saving_index],
+                                       saving.before_node, saving.after_node,
+                                       type);
+    }
+  }
+  gtl::STLClearObject(&savings);
+  gtl::STLClearObject(&total_costs);
   savings_container_->Sort();
   return !StopSearch();
 }
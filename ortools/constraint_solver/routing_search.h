@@ -38,6 +38,7 @@
 #include "absl/log/check.h"
 #include "absl/types/span.h"
 #include "ortools/base/adjustable_priority_queue.h"
+#include "ortools/base/threadpool.h"
 #include "ortools/constraint_solver/constraint_solver.h"
 #include "ortools/constraint_solver/constraint_solveri.h"
 #include "ortools/constraint_solver/routing.h"
@@ -462,6 +463,11 @@ class GlobalCheapestInsertionFilteredHeuristic
     /// the node/pair will be made unperformed. If false, only entries making
     /// a node/pair performed are considered.
     bool add_unperformed_entries;
+    /// Number of threads computing the insertion costs of single nodes, when
+    /// initializing the insertion positions and after each insertion. Only
+    /// used with an evaluator, which must then be thread-safe, and a penalty
+    /// evaluator, if any, which must be thread-safe too.
+    int num_threads = 1;
   };
 
   /// Takes ownership of evaluators.
@@ -480,6 +486,23 @@ class GlobalCheapestInsertionFilteredHeuristic
  private:
   /// Priority queue entries used by global cheapest insertion heuristic.
   class NodeEntryQueue;
+  /// Node insertions computed by a worker thread, before they are pushed in
+  /// the NodeEntryQueue by the calling thread. Has the same PushInsertion() as
+  /// NodeEntryQueue, for AddNodeEntry().
+  struct NodeInsertionBuffer {
+    struct Insertion {
+      int64_t node;
+      int64_t insert_after;
+      int vehicle;
+      int bucket;
+      int64_t value;
+    };
+    void PushInsertion(int64_t node, int64_t insert_after, int vehicle,
+                       int bucket, int64_t value) {
+      insertions.push_back({node, insert_after, vehicle, bucket, value});
+    }
+    std::vector<Insertion> insertions;
+  };
 
   /// Entry in priority queue containing the insertion positions of a node pair.
   class PairEntry {
@@ -779,9 +802,10 @@ class GlobalCheapestInsertionFilteredHeuristic
   /// Based on gci_params_.use_neighbors_ratio_for_initialization, either all
   /// contained nodes are considered as insertion positions, or only the
   /// closest neighbors of 'node'.
+  /// 'queue' is either a NodeEntryQueue or a NodeInsertionBuffer.
+  template <typename Queue>
   void InitializeInsertionEntriesPerformingNode(
-      int64_t node, const absl::flat_hash_set<int>& vehicles,
-      NodeEntryQueue* queue);
+      int64_t node, const absl::flat_hash_set<int>& vehicles, Queue* queue);
   /// Performs all the necessary updates after 'node' was successfully inserted
   /// on the 'vehicle' after 'insert_after'.
   bool UpdateAfterNodeInsertion(const std::vector<bool>& nodes, int vehicle,
@@ -803,9 +827,19 @@ class GlobalCheapestInsertionFilteredHeuristic
 
   /// Creates a NodeEntry corresponding to the insertion of 'node' after
   /// 'insert_after' on 'vehicle' and adds it to the 'queue' and
-  /// 'node_entries'.
+  /// 'node_entries'. 'queue' is either a NodeEntryQueue or a
+  /// NodeInsertionBuffer.
+  template <typename Queue>
   void AddNodeEntry(int64_t node, int64_t insert_after, int vehicle,
-                    bool all_vehicles, NodeEntryQueue* queue) const;
+                    bool all_vehicles, Queue* queue) const;
+  /// Calls 'add_entries(i, buffer)' for all i in [0, num_items) on the threads
+  /// of thread_pool_, 'buffer' being the buffer of the calling worker, then
+  /// pushes the buffered insertions in 'queue'. Since the entries of the queue
+  /// are totally ordered, the result does not depend on the scheduling.
+  void ParallelAddNodeEntries(
+      int64_t num_items,
+      const std::function<void(int64_t, NodeInsertionBuffer*)>& add_entries,
+      NodeEntryQueue* queue);
 
   void ResetVehicleIndices() override {
     node_index_to_vehicle_.assign(node_index_to_vehicle_.size(), -1);
@@ -861,6 +895,10 @@ class GlobalCheapestInsertionFilteredHeuristic
   std::unique_ptr<VehicleTypeCurator> empty_vehicle_type_curator_;
 
   mutable EntryAllocator<PairEntry> pair_entry_allocator_;
+
+  /// Only created if gci_params_.num_threads > 1, with one buffer per thread.
+  std::unique_ptr<ThreadPool> thread_pool_;
+  std::vector<NodeInsertionBuffer> worker_buffers_;
 };
 
 // Holds sequences of insertions.
@@ -1257,6 +1295,13 @@ class SavingsFilteredHeuristic : public RoutingFilteredHeuristic {
     /// arc_coefficient is a strictly positive parameter indicating the
     /// coefficient of the arc being considered in the Saving formula.
     double arc_coefficient = 1.0;
+    /// Number of threads computing the neighbors and the savings of the nodes,
+    /// and sorting the savings. Only used with arc_cost_for_class.
+    int num_threads = 1;
+    /// If set, returns the cost of the arc from_index-->to_index for a cost
+    /// class, like RoutingModel::GetArcCostForClass(). It is used instead of
+    /// the latter, which is not thread-safe, and must be thread-safe.
+    std::function<int64_t(int64_t, int64_t, int64_t)> arc_cost_for_class;
   };
 
   SavingsFilteredHeuristic(RoutingModel* model,
@@ -1335,7 +1380,20 @@ class SavingsFilteredHeuristic : public RoutingFilteredHeuristic {
   /// memory usage specified by the savings_params_.
   int64_t MaxNumNeighborsPerNode(int num_vehicle_types) const;
 
+  /// Returns the cost of the arc from_index-->to_index for a cost class, with
+  /// savings_params_.arc_cost_for_class if set.
+  int64_t GetArcCost(int64_t from_index, int64_t to_index,
+                     int64_t cost_class) const {
+    return savings_params_.arc_cost_for_class != nullptr
+               ? savings_params_.arc_cost_for_class(from_index, to_index,
+                                                    cost_class)
+               : model()->GetArcCostForClass(from_index, to_index, cost_class);
+  }
+
   const SavingsParameters savings_params_;
+  /// Only created if savings_params_.num_threads > 1 and
+  /// savings_params_.arc_cost_for_class is set.
+  std::unique_ptr<ThreadPool> thread_pool_;
 
   friend class SavingsFilteredHeuristicTestPeer;
 };
@@ -15,12 +15,14 @@
 
 #include <algorithm>
 #include <functional>
+#include <numeric>
 #include <queue>
 #include <tuple>
 #include <utility>
 #include <vector>
 
 #include "absl/log/check.h"
+#include "absl/types/span.h"
 #include "ortools/util/saturated_arithmetic.h"
 
 namespace operations_research {
@@ -172,4 +174,103 @@ bool FindMostExpensiveArcsOnRoute(
   return true;
 }
 
+namespace {
+
+// A 2-d tree, stored implicitly in a permutation of the points: the subtree of
+// a range [begin, end) of the permutation is split at its middle point along
+// the x axis at even depths and the y axis at odd depths, its children being
+// the ranges before and after the middle point.
+class KdTree2D {
+ public:
+  KdTree2D(absl::Span<const double> x, absl::Span<const double> y)
+      : x_(x), y_(y), points_(x.size()) {
+    std::iota(points_.begin(), points_.end(), 0);
+    Build(0, points_.size(), /*axis=*/0);
+  }
+
+  // Returns the num_neighbors nearest points of point, sorted as in
+  // FindNearestNeighbors2D().
+  std::vector<int> FindNearestNeighbors(int point, int num_neighbors) {
+    nearest_.clear();
+    if (num_neighbors > 0) {
+      Search(0, points_.size(), /*axis=*/0, point, num_neighbors);
+    }
+    std::sort_heap(nearest_.begin(), nearest_.end());
+    std::vector<int> neighbors;
+    neighbors.reserve(nearest_.size());
+    for (const auto& [distance, neighbor] : nearest_) {
+      neighbors.push_back(neighbor);
+    }
+    return neighbors;
+  }
+
+ private:
+  double Coordinate(int point, int axis) const {
+    return axis == 0 ? x_[point] : y_[point];
+  }
+
+  void Build(int begin, int end, int axis) {
+    if (end - begin <= 1) return;
+    const int middle = begin + (end - begin) / 2;
+    std::nth_element(points_.begin() + begin, points_.begin() + middle,
+                     points_.begin() + end, [this, axis](int a, int b) {
+                       return Coordinate(a, axis) < Coordinate(b, axis);
+                     });
+    Build(begin, middle, 1 - axis);
+    Build(middle + 1, end, 1 - axis);
+  }
+
+  // Updates nearest_, a max-heap of the num_neighbors nearest points found so
+  // far, with the points of the subtree of [begin, end).
+  void Search(int begin, int end, int axis, int point, int num_neighbors) {
+    if (begin >= end) return;
+    const int middle = begin + (end - begin) / 2;
+    const int candidate = points_[middle];
+    if (candidate != point) {
+      const double dx = x_[point] - x_[candidate];
+      const double dy = y_[point] - y_[candidate];
+      const std::pair<double, int> entry = {dx * dx + dy * dy, candidate};
+      if (nearest_.size() < num_neighbors) {
+        nearest_.push_back(entry);
+        std::push_heap(nearest_.begin(), nearest_.end());
+      } else if (entry < nearest_.front()) {
+        std::pop_heap(nearest_.begin(), nearest_.end());
+        nearest_.back() = entry;
+        std::push_heap(nearest_.begin(), nearest_.end());
+      }
+    }
+    // Searches the side of the split containing the point first, and the
+    // other side only if it can contain points nearer than the farthest one
+    // found so far.
+    const double offset = Coordinate(point, axis) - Coordinate(candidate, axis);
+    const bool point_is_before = offset < 0;
+    Search(point_is_before ? begin : middle + 1,
+           point_is_before ? middle : end, 1 - axis, point, num_neighbors);
+    if (nearest_.size() < num_neighbors ||
+        offset * offset <= nearest_.front().first) {
+      Search(point_is_before ? middle + 1 : begin,
+             point_is_before ? end : middle, 1 - axis, point, num_neighbors);
+    }
+  }
+
+  const absl::Span<const double> x_;
+  const absl::Span<const double> y_;
+  std::vector<int> points_;
+  std::vector<std::pair</*squared distance*/ double, /*point*/ int>> nearest_;
+};
+
+}  // namespace
+
+std::vector<std::vector<int>> FindNearestNeighbors2D(
+    absl::Span<const double> x, absl::Span<const double> y,
+    int num_neighbors) {
+  CHECK_EQ(x.size(), y.size());
+  KdTree2D tree(x, y);
+  std::vector<std::vector<int>> neighbors(x.size());
+  for (int point = 0; point < x.size(); ++point) {
+    neighbors[point] = tree.FindNearestNeighbors(point, num_neighbors);
+  }
+  return neighbors;
+}
+
 }  // namespace operations_research
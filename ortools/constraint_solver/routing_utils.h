@@ -19,6 +19,8 @@
 #include <utility>
 #include <vector>
 
+#include "absl/types/span.h"
+
 namespace operations_research {
 
 // Tracks whether bins constrained by several nonnegative dimensions can contain
@@ -87,6 +89,15 @@ bool FindMostExpensiveArcsOnRoute(
     std::vector<std::pair<int64_t, int>>* most_expensive_arc_starts_and_ranks,
     std::pair<int, int>* first_expensive_arc_indices);
 
+// Returns the num_neighbors nearest points of each point for the Euclidean
+// distance, the point itself excluded, given the coordinates x and y of the
+// points. The neighbors of a point are sorted by increasing distance, then by
+// increasing index. Uses a 2-d tree, in O(n.log(n)) for well-spread points and
+// a small number of neighbors, instead of the O(n^2) of a full scan.
+std::vector<std::vector<int>> FindNearestNeighbors2D(
+    absl::Span<const double> x, absl::Span<const double> y,
+    int num_neighbors);
+
 }  // namespace operations_research
 
 #endif  // OR_TOOLS_CONSTRAINT_SOLVER_ROUTING_UTILS_H_
@@ -3663,6 +3663,18 @@ namespace {
 // GLS penalty management classes. Maintains the penalty frequency for each
 // (variable, value) pair.
 
+// Penalty frequency of a (variable, value) pair, with a cache of its penalized
+// value for the last secondary value it was computed with (e.g. the vehicle in
+// routing), which saves the calls to the objective function of the GLS until
+// the penalty changes.
+struct GuidedLocalSearchPenalty {
+  static constexpr int64_t kNoSecondaryValue =
+      std::numeric_limits<int64_t>::min();
+  int64_t penalty = 0;
+  int64_t secondary_value = kNoSecondaryValue;
+  int64_t penalized_value = 0;
+};
+
 // Dense GLS penalties implementation using a matrix to store penalties.
 class GuidedLocalSearchPenaltiesTable {
  public:
@@ -3674,10 +3686,13 @@ class GuidedLocalSearchPenaltiesTable {
   bool HasPenalties() const { return has_values_; }
   void IncrementPenalty(const VarValue& var_value);
   int64_t GetPenalty(const VarValue& var_value) const;
+  // Returns the penalty of the pair, or nullptr if it has never been
+  // penalized.
+  GuidedLocalSearchPenalty* MutablePenaltyOrNull(const VarValue& var_value);
   void Reset();
 
  private:
-  std::vector<std::vector<int64_t>> penalties_;
+  std::vector<std::vector<GuidedLocalSearchPenalty>> penalties_;
   bool has_values_;
 };
 
@@ -3686,12 +3701,15 @@ GuidedLocalSearchPenaltiesTable::GuidedLocalSearchPenaltiesTable(int num_vars)
 
 void GuidedLocalSearchPenaltiesTable::IncrementPenalty(
     const VarValue& var_value) {
-  std::vector<int64_t>& var_penalties = penalties_[var_value.var];
+  std::vector<GuidedLocalSearchPenalty>& var_penalties =
+      penalties_[var_value.var];
   const int64_t value = var_value.value;
   if (value >= var_penalties.size()) {
-    var_penalties.resize(value + 1, 0);
+    var_penalties.resize(value + 1);
   }
-  ++var_penalties[value];
+  GuidedLocalSearchPenalty& penalty = var_penalties[value];
+  ++penalty.penalty;
+  penalty.secondary_value = GuidedLocalSearchPenalty::kNoSecondaryValue;
   has_values_ = true;
 }
 
@@ -3704,9 +3722,20 @@ void GuidedLocalSearchPenaltiesTable::Reset() {
 
 int64_t GuidedLocalSearchPenaltiesTable::GetPenalty(
     const VarValue& var_value) const {
-  const std::vector<int64_t>& var_penalties = penalties_[var_value.var];
+  const std::vector<GuidedLocalSearchPenalty>& var_penalties =
+      penalties_[var_value.var];
+  const int64_t value = var_value.value;
+  return (value >= var_penalties.size()) ? 0 : var_penalties[value].penalty;
+}
+
+GuidedLocalSearchPenalty* GuidedLocalSearchPenaltiesTable::MutablePenaltyOrNull(
+    const VarValue& var_value) {
+  std::vector<GuidedLocalSearchPenalty>& var_penalties =
+      penalties_[var_value.var];
   const int64_t value = var_value.value;
-  return (value >= var_penalties.size()) ? 0 : var_penalties[value];
+  return (value >= var_penalties.size() || var_penalties[value].penalty == 0)
+             ? nullptr
+             : &var_penalties[value];
 }
 
 // Sparse GLS penalties implementation using hash_map to store penalties.
@@ -3728,11 +3757,14 @@ class GuidedLocalSearchPenaltiesMap {
   bool HasPenalties() const { return (!penalties_.empty()); }
   void IncrementPenalty(const VarValue& var_value);
   int64_t GetPenalty(const VarValue& var_value) const;
+  // Returns the penalty of the pair, or nullptr if it has never been
+  // penalized. The pointer is invalidated by IncrementPenalty().
+  GuidedLocalSearchPenalty* MutablePenaltyOrNull(const VarValue& var_value);
   void Reset();
 
  private:
   Bitmap penalized_;
-  absl::flat_hash_map<VarValue, int64_t> penalties_;
+  absl::flat_hash_map<VarValue, GuidedLocalSearchPenalty> penalties_;
 };
 
 GuidedLocalSearchPenaltiesMap::GuidedLocalSearchPenaltiesMap(int num_vars)
@@ -3740,7 +3772,9 @@ GuidedLocalSearchPenaltiesMap::GuidedLocalSearchPenaltiesMap(int num_vars)
 
 void GuidedLocalSearchPenaltiesMap::IncrementPenalty(
     const VarValue& var_value) {
-  ++penalties_[var_value];
+  GuidedLocalSearchPenalty& penalty = penalties_[var_value];
+  ++penalty.penalty;
+  penalty.secondary_value = GuidedLocalSearchPenalty::kNoSecondaryValue;
   penalized_.Set(var_value.var, true);
 }
 
@@ -3751,9 +3785,15 @@ void GuidedLocalSearchPenaltiesMap::Reset() {
 
 int64_t GuidedLocalSearchPenaltiesMap::GetPenalty(
     const VarValue& var_value) const {
-  return (penalized_.Get(var_value.var))
-             ? gtl::FindWithDefault(penalties_, var_value)
-             : 0;
+  if (!penalized_.Get(var_value.var)) return 0;
+  const auto it = penalties_.find(var_value);
+  return it == penalties_.end() ? 0 : it->second.penalty;
+}
+
+GuidedLocalSearchPenalty* GuidedLocalSearchPenaltiesMap::MutablePenaltyOrNull(
+    const VarValue& var_value) {
+  return penalized_.Get(var_value.var) ? gtl::FindOrNull(penalties_, var_value)
+                                       : nullptr;
 }
 
 template <typename P>
@@ -3769,7 +3809,7 @@ class GuidedLocalSearch : public Metaheuristic {
   bool AtSolution() override;
   void EnterSearch() override;
   bool LocalOptimum() override;
-  virtual int64_t AssignmentElementPenalty(int index) const = 0;
+  virtual int64_t AssignmentElementPenalty(int index) = 0;
   virtual int64_t AssignmentPenalty(int64_t var, int64_t value) const = 0;
   virtual int64_t Evaluate(const Assignment* delta, int64_t current_penalty,
                            bool incremental) = 0;
@@ -3841,6 +3881,26 @@ class GuidedLocalSearch : public Metaheuristic {
                : -1;
   }
   void ResetPenalties();
+  // Returns the penalized value of (i, j) for the secondary value k, i.e.
+  // penalty_factor_ * penalty(i, j) * cost, with cost = cost_function() only
+  // computed when it is not cached in the penalty of (i, j).
+  template <typename CostFunction>
+  int64_t CachedPenalizedValue(int64_t i, int64_t j, int64_t k,
+                               const CostFunction& cost_function) {
+    GuidedLocalSearchPenalty* const penalty =
+        penalties_.MutablePenaltyOrNull({i, j});
+    if (penalty == nullptr) return 0;
+    if (penalty->secondary_value != k) {
+      const double penalized_value_fp =
+          penalty_factor_ * penalty->penalty * cost_function();
+      penalty->penalized_value =
+          (penalized_value_fp < std::numeric_limits<int64_t>::max())
+              ? static_cast<int64_t>(penalized_value_fp)
+              : std::numeric_limits<int64_t>::max();
+      penalty->secondary_value = k;
+    }
+    return penalty->penalized_value;
+  }
 
   IntVar* penalized_objective_;
   Assignment::IntContainer assignment_;
@@ -4069,13 +4129,13 @@ class BinaryGuidedLocalSearch : public GuidedLocalSearch<P> {
       double penalty_factor, bool reset_penalties_on_new_best_solution);
   ~BinaryGuidedLocalSearch() override {}
   IntExpr* MakeElementPenalty(int index) override;
-  int64_t AssignmentElementPenalty(int index) const override;
+  int64_t AssignmentElementPenalty(int index) override;
   int64_t AssignmentPenalty(int64_t var, int64_t value) const override;
   int64_t Evaluate(const Assignment* delta, int64_t current_penalty,
                    bool incremental) override;
 
  private:
-  int64_t PenalizedValue(int64_t i, int64_t j) const;
+  int64_t PenalizedValue(int64_t i, int64_t j);
   std::function<int64_t(int64_t, int64_t)> objective_function_;
 };
 
@@ -4098,7 +4158,7 @@ IntExpr* BinaryGuidedLocalSearch<P>::MakeElementPenalty(int index) {
 }
 
 template <typename P>
-int64_t BinaryGuidedLocalSearch<P>::AssignmentElementPenalty(int index) const {
+int64_t BinaryGuidedLocalSearch<P>::AssignmentElementPenalty(int index) {
   return PenalizedValue(index, this->GetValue(index));
 }
 
@@ -4131,17 +4191,11 @@ int64_t BinaryGuidedLocalSearch<P>::Evaluate(const Assignment* delta,
 
 // Penalized value for (i, j) = penalty_factor_ * penalty(i, j) * cost (i, j)
 template <typename P>
-int64_t BinaryGuidedLocalSearch<P>::PenalizedValue(int64_t i, int64_t j) const {
-  const int64_t penalty = this->penalties_.GetPenalty({i, j});
-  // Calls to objective_function_(i, j) can be costly.
-  if (penalty == 0) return 0;
-  const double penalized_value_fp =
-      this->penalty_factor_ * penalty * objective_function_(i, j);
-  const int64_t penalized_value =
-      (penalized_value_fp <= std::numeric_limits<int64_t>::max())
-          ? static_cast<int64_t>(penalized_value_fp)
-          : std::numeric_limits<int64_t>::max();
-  return penalized_value;
+int64_t BinaryGuidedLocalSearch<P>::PenalizedValue(int64_t i, int64_t j) {
+  // Calls to objective_function_(i, j) can be costly, the cost does not depend
+  // on any secondary value.
+  return this->CachedPenalizedValue(
+      i, j, /*k=*/0, [this, i, j]() { return objective_function_(i, j); });
 }
 
 template <typename P>
@@ -4155,13 +4209,13 @@ class TernaryGuidedLocalSearch : public GuidedLocalSearch<P> {
       bool reset_penalties_on_new_best_solution);
   ~TernaryGuidedLocalSearch() override {}
   IntExpr* MakeElementPenalty(int index) override;
-  int64_t AssignmentElementPenalty(int index) const override;
+  int64_t AssignmentElementPenalty(int index) override;
   int64_t AssignmentPenalty(int64_t var, int64_t value) const override;
   int64_t Evaluate(const Assignment* delta, int64_t current_penalty,
                    bool incremental) override;
 
  private:
-  int64_t PenalizedValue(int64_t i, int64_t j, int64_t k) const;
+  int64_t PenalizedValue(int64_t i, int64_t j, int64_t k);
 
   std::function<int64_t(int64_t, int64_t, int64_t)> objective_function_;
   std::vector<int> secondary_values_;
@@ -4195,7 +4249,7 @@ IntExpr* TernaryGuidedLocalSearch<P>::MakeElementPenalty(int index) {
 }
 
 template <typename P>
-int64_t TernaryGuidedLocalSearch<P>::AssignmentElementPenalty(int index) const {
+int64_t TernaryGuidedLocalSearch<P>::AssignmentElementPenalty(int index) {
   return PenalizedValue(index, this->GetValue(index),
                         this->GetValue(this->NumPrimaryVars() + index));
 }
@@ -4252,17 +4306,11 @@ int64_t TernaryGuidedLocalSearch<P>::Evaluate(const Assignment* delta,
 // Penalized value for (i, j) = penalty_factor_ * penalty(i, j) * cost (i, j, k)
 template <typename P>
 int64_t TernaryGuidedLocalSearch<P>::PenalizedValue(int64_t i, int64_t j,
-                                                    int64_t k) const {
-  const int64_t penalty = this->penalties_.GetPenalty({i, j});
+                                                    int64_t k) {
   // Calls to objective_function_(i, j, k) can be costly.
-  if (penalty == 0) return 0;
-  const double penalized_value_fp =
-      this->penalty_factor_ * penalty * objective_function_(i, j, k);
-  const int64_t penalized_value =
-      (penalized_value_fp < std::numeric_limits<int64_t>::max())
-          ? static_cast<int64_t>(penalized_value_fp)
-          : std::numeric_limits<int64_t>::max();
-  return penalized_value;
+  return this->CachedPenalizedValue(i, j, k, [this, i, j, k]() {
+    return objective_function_(i, j, k);
+  });
 }
 }  // namespace
 
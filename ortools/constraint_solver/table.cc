@@ -577,16 +577,31 @@ class CompactPositiveTableConstraint : public BasePositiveTableConstraint {
         const int64_t number_of_operations =
             estimated_hole_size + var_min - old_min + old_max - var_max;
         if (number_of_operations < var_size) {
-          // Let's scan the removed values since last run.
+          // Let's scan the removed values since last run. Unless a single
+          // value was removed, their masks are merged in temp_mask_ so that
+          // each active word is updated and trailed once, instead of once per
+          // removed value.
+          const bool merge_masks = estimated_hole_size > 1;
+          if (merge_masks) ClearTempMask();
+          const auto remove_value = [this, var_index, omin, merge_masks,
+                                     &changed](int64_t value) {
+            if (merge_masks) {
+              OrTempMask(var_index, value - omin);
+            } else {
+              changed |=
+                  SubtractMaskFromActive(masks_[var_index][value - omin]);
+            }
+          };
           for (int64_t value = old_min; value < var_min; ++value) {
-            changed |= SubtractMaskFromActive(masks_[var_index][value - omin]);
+            remove_value(value);
           }
           for (const int64_t value : InitAndGetValues(holes_[var_index])) {
-            changed |= SubtractMaskFromActive(masks_[var_index][value - omin]);
+            remove_value(value);
           }
           for (int64_t value = var_max + 1; value <= old_max; ++value) {
-            changed |= SubtractMaskFromActive(masks_[var_index][value - omin]);
+            remove_value(value);
           }
+          if (merge_masks) changed = SubtractMaskFromActive(temp_mask_);
         } else {
           ClearTempMask();
           // Let's build the mask of supported tuples from the current
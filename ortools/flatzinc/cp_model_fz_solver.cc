@@ -1284,6 +1284,8 @@ void SolveFzWithCpModelProto(const fz::Model& fz_model,
   // plus eventually a bunch of constant variables that will be created
   // lazily.
   int num_variables = 0;
+  m.proto.mutable_variables()->Reserve(fz_model.variables().size());
+  m.fz_var_to_index.reserve(fz_model.variables().size());
   for (fz::Variable* fz_var : fz_model.variables()) {
     if (!fz_var->active) continue;
     CHECK(!fz_var->domain.is_float)
@@ -1314,6 +1316,7 @@ void SolveFzWithCpModelProto(const fz::Model& fz_model,
   }
 
   // Translate the constraints.
+  m.proto.mutable_constraints()->Reserve(fz_model.constraints().size());
   for (fz::Constraint* fz_ct : fz_model.constraints()) {
     if (fz_ct == nullptr || !fz_ct->active) continue;
     ConstraintProto* ct = m.proto.add_constraints();
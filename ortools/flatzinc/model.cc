@@ -1026,18 +1026,21 @@ Variable* Model::AddVariable(absl::string_view name, const Domain& domain,
   return var;
 }
 
-// TODO(user): Create only once constant per value.
 Variable* Model::AddConstant(int64_t value) {
-  Variable* const var =
-      new Variable(absl::StrCat(value), Domain::IntegerValue(value), true);
-  variables_.push_back(var);
+  Variable*& var = constants_[value];
+  if (var == nullptr) {
+    var = new Variable(absl::StrCat(value), Domain::IntegerValue(value), true);
+    variables_.push_back(var);
+  }
   return var;
 }
 
 Variable* Model::AddFloatConstant(double value) {
-  Variable* const var =
-      new Variable(absl::StrCat(value), Domain::FloatValue(value), true);
-  variables_.push_back(var);
+  Variable*& var = float_constants_[value];
+  if (var == nullptr) {
+    var = new Variable(absl::StrCat(value), Domain::FloatValue(value), true);
+    variables_.push_back(var);
+  }
   return var;
 }
 
@@ -353,6 +353,8 @@ class Model {
   // are owned by the model and will remain live for its lifetime.
   Variable* AddVariable(absl::string_view name, const Domain& domain,
                         bool defined);
+  // Returns the temporary variable fixed to `value`. It is created only once
+  // per value, and shared by all the constraints using this value.
   Variable* AddConstant(int64_t value);
   Variable* AddFloatConstant(double value);
   // Creates and add a constraint to the model.
@@ -405,6 +407,9 @@ class Model {
   // owned.
   // TODO(user): use unique_ptr
   std::vector<Constraint*> constraints_;
+  // The variables created by AddConstant() and AddFloatConstant(), by value.
+  absl::flat_hash_map<int64_t, Variable*> constants_;
+  absl::flat_hash_map<double, Variable*> float_constants_;
   // The objective variable (it belongs to variables_).
   Variable* objective_;
   bool maximize_;
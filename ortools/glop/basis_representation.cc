@@ -14,6 +14,7 @@
 #include "ortools/glop/basis_representation.h"
 
 #include <algorithm>
+#include <cmath>
 #include <cstdlib>
 #include <vector>
 
@@ -197,6 +198,7 @@ BasisFactorization::~BasisFactorization() = default;
 void BasisFactorization::Clear() {
   SCOPED_TIME_STAT(&stats_);
   num_updates_ = 0;
+  max_update_growth_ = 0.0;
   tau_computation_can_be_optimized_ = false;
   eta_factorization_.Clear();
   lu_factorization_.Clear();
@@ -238,6 +240,7 @@ Status BasisFactorization::ForceRefactorization() {
 }
 
 Status BasisFactorization::ComputeFactorization() {
+  SCOPED_PROFILING_COUNTER("glop.ComputeFactorization");
   CompactSparseMatrixView basis_matrix(&compact_matrix_, &basis_);
   const Status status = lu_factorization_.ComputeFactorization(basis_matrix);
   last_factorization_deterministic_time_ =
@@ -297,6 +300,24 @@ Status BasisFactorization::MiddleProductFormUpdate(
   if (elementary_update_matrix.IsSingular()) {
     GLOP_RETURN_AND_LOG_ERROR(Status::ERROR_LU, "Degenerate rank-one update.");
   }
+
+  // The inverse of the elementary matrix is I - u.v^T / mu, so a solve with it
+  // can amplify the errors by up to 1 + |u|.|v| / |mu|. Like the stability test
+  // on the new diagonal entry of a Forrest-Tomlin update, we monitor this
+  // factor and ask for a refactorization as soon as it gets too large.
+  const auto storage_view = storage_.view();
+  Fractional u_norm = 0.0;
+  for (const EntryIndex i : storage_view.Column(u_index)) {
+    u_norm = std::max(u_norm, std::abs(storage_view.EntryCoefficient(i)));
+  }
+  Fractional v_norm = 0.0;
+  for (const EntryIndex i : storage_view.Column(left_index)) {
+    v_norm = std::max(v_norm, std::abs(storage_view.EntryCoefficient(i)));
+  }
+  max_update_growth_ =
+      std::max(max_update_growth_,
+               1.0 + u_norm * v_norm / std::abs(1.0 + scalar_product));
+
   rank_one_factorization_.Update(elementary_update_matrix);
   return Status::OK();
 }
@@ -307,6 +328,13 @@ Status BasisFactorization::Update(ColIndex entering_col,
   // Note that in addition to the logic here, we also refactorize when we detect
   // numerical imprecisions. There is various tests for that during an
   // iteration.
+  //
+  // We also refactorize as soon as the measured growth of one of the updates
+  // since the last factorization is too large, whatever the refactorization
+  // period.
+  if (max_update_growth_ > kMaxUpdateGrowth) {
+    return ForceRefactorization();
+  }
   if (num_updates_ >= max_num_updates_) {
     if (!parameters_.dynamically_adjust_refactorization_period()) {
       return ForceRefactorization();
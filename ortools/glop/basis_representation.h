@@ -387,6 +387,11 @@ class BasisFactorization {
   bool use_middle_product_form_update_;
   int max_num_updates_;
   int num_updates_;
+
+  // Largest error amplification factor of the rank one updates since the last
+  // factorization. See MiddleProductFormUpdate().
+  static constexpr double kMaxUpdateGrowth = 1e8;
+  double max_update_growth_ = 0.0;
   EtaFactorization eta_factorization_;
   LuFactorization lu_factorization_;
 
@@ -93,14 +93,19 @@ void DualEdgeNorms::UpdateBeforeBasisPivot(
       edge_squared_norms_[leaving_row] / Square(pivot);
 
   // Update the norm.
+  //
+  // Note that the division is hoisted out of the loop, the result is exactly
+  // the same since 2.0 / pivot was evaluated first anyway.
   int stat_lower_bounded_norms = 0;
+  const Fractional tau_factor = 2.0 / pivot;
   auto output = edge_squared_norms_.view();
+  const auto tau_values = tau.const_view();
   for (const auto e : direction) {
     // Note that the update formula used is important to maximize the precision.
     // See Koberstein's PhD section 8.2.2.1.
     output[e.row()] +=
         e.coefficient() * (e.coefficient() * new_leaving_squared_norm -
-                           2.0 / pivot * tau[e.row()]);
+                           tau_factor * tau_values[e.row()]);
 
     // Avoid 0.0 norms (The 1e-4 is the value used by Koberstein).
     // TODO(user): use a more precise lower bound depending on the column norm?
@@ -58,6 +58,11 @@ class EnteringVariable {
   // the "update" row vector in the direction given by the sign of
   // cost_variation. Computes the smallest step that keeps the dual feasibility
   // for all the columns.
+  //
+  // This is a bound flipping (or long-step) ratio test: the breakpoints of the
+  // boxed columns are passed over as long as flipping them to their other
+  // bound still leaves a positive slope. These columns are returned in
+  // bound_flip_candidates and are flipped by the caller in the same iteration.
   ABSL_MUST_USE_RESULT Status DualChooseEnteringColumn(
       bool nothing_to_recompute, const UpdateRow& update_row,
       Fractional cost_variation, std::vector<ColIndex>* bound_flip_candidates,
@@ -0,0 +1,464 @@
+// Copyright 2010-2024 Google LLC
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "ortools/glop/interior_point.h"
+
+#include <algorithm>
+#include <cmath>
+
+#include "absl/strings/str_format.h"
+#include "ortools/glop/parameters.pb.h"
+#include "ortools/glop/status.h"
+#include "ortools/lp_data/lp_data.h"
+#include "ortools/lp_data/lp_types.h"
+#include "ortools/lp_data/lp_utils.h"
+#include "ortools/lp_data/sparse.h"
+#include "ortools/util/logging.h"
+#include "ortools/util/time_limit.h"
+
+namespace operations_research {
+namespace glop {
+
+namespace {
+
+// Added to the inverse of theta, this keeps the normal equations well defined
+// in the presence of free variables.
+constexpr Fractional kPrimalRegularization = 1e-8;
+
+// Added to the diagonal of the normal equations, this keeps them non-singular
+// when A does not have full row rank.
+constexpr Fractional kDualRegularization = 1e-8;
+
+// The fraction of the maximum step to the boundary that we actually take.
+constexpr Fractional kStepToBoundaryFactor = 0.9995;
+
+}  // namespace
+
+ProblemStatus InteriorPointSolver::Solve(const LinearProgram& lp,
+                                         TimeLimit* time_limit) {
+  Initialize(lp);
+  lu_factorization_.SetParameters(parameters_);
+  num_iterations_ = 0;
+
+  SOLVER_LOG(logger_, "");
+  SOLVER_LOG(logger_, "Interior point on ", lp.GetDimensionString());
+
+  ProblemStatus status = ProblemStatus::INIT;
+  DenseRow lower_complementarity(num_vars_, 0.0);
+  DenseRow upper_complementarity(num_vars_, 0.0);
+  while (true) {
+    if (!ComputeResidualsAndCheckConvergence()) {
+      status = ProblemStatus::OPTIMAL;
+      break;
+    }
+    if (num_iterations_ >= parameters_.interior_point_max_iterations() ||
+        time_limit->LimitReached()) {
+      break;
+    }
+    const Status factorization_status = FactorizeNormalEquations();
+    time_limit->AdvanceDeterministicTime(
+        lu_factorization_.DeterministicTimeOfLastFactorization() +
+        DeterministicTimeForFpOperations(normal_matrix_.num_entries().value()));
+    if (!factorization_status.ok()) {
+      SOLVER_LOG(logger_, "Interior point: ",
+                 factorization_status.error_message());
+      status = ProblemStatus::ABNORMAL;
+      break;
+    }
+
+    // Predictor: the affine scaling direction that targets mu = 0.
+    for (ColIndex col(0); col < num_vars_; ++col) {
+      lower_complementarity[col] =
+          has_lower_bound_[col] ? -lower_gaps_[col] * lower_duals_[col] : 0.0;
+      upper_complementarity[col] =
+          has_upper_bound_[col] ? -upper_gaps_[col] * upper_duals_[col] : 0.0;
+    }
+    ComputeNewtonDirection(lower_complementarity, upper_complementarity);
+    const Fractional affine_mu =
+        ComplementarityAfterStep(MaxPrimalStep(), MaxDualStep());
+    const Fractional sigma =
+        mu_ > 0.0 ? std::pow(std::min(1.0, affine_mu / mu_), 3) : 0.0;
+
+    // Corrector: centers the iterate and compensates for the second order
+    // term of the predictor complementarity.
+    for (ColIndex col(0); col < num_vars_; ++col) {
+      if (has_lower_bound_[col]) {
+        lower_complementarity[col] =
+            sigma * mu_ - lower_gaps_[col] * lower_duals_[col] -
+            d_lower_gaps_[col] * d_lower_duals_[col];
+      }
+      if (has_upper_bound_[col]) {
+        upper_complementarity[col] =
+            sigma * mu_ - upper_gaps_[col] * upper_duals_[col] -
+            d_upper_gaps_[col] * d_upper_duals_[col];
+      }
+    }
+    ComputeNewtonDirection(lower_complementarity, upper_complementarity);
+    time_limit->AdvanceDeterministicTime(DeterministicTimeForFpOperations(
+        4 * (lu_factorization_.NumberOfEntries().value() +
+             matrix_.num_entries().value())));
+
+    const Fractional primal_step = kStepToBoundaryFactor * MaxPrimalStep();
+    const Fractional dual_step = kStepToBoundaryFactor * MaxDualStep();
+    for (ColIndex col(0); col < num_vars_; ++col) {
+      x_[col] += primal_step * dx_[col];
+      lower_gaps_[col] += primal_step * d_lower_gaps_[col];
+      upper_gaps_[col] += primal_step * d_upper_gaps_[col];
+      lower_duals_[col] += dual_step * d_lower_duals_[col];
+      upper_duals_[col] += dual_step * d_upper_duals_[col];
+    }
+    for (RowIndex row(0); row < num_rows_; ++row) {
+      y_[row] += dual_step * dy_[row];
+    }
+    ++num_iterations_;
+  }
+
+  SOLVER_LOG(logger_, "Interior point status: ",
+             GetProblemStatusString(status), " after ", num_iterations_,
+             " iterations.");
+  ExtractSolution();
+  return status;
+}
+
+void InteriorPointSolver::Initialize(const LinearProgram& lp) {
+  num_rows_ = lp.num_constraints();
+  num_cols_ = lp.num_variables();
+  num_vars_ = num_cols_ + RowToColIndex(num_rows_);
+  objective_sign_ = lp.IsMaximizationProblem() ? -1.0 : 1.0;
+  matrix_.PopulateFromMatrixView(MatrixView(lp.GetSparseMatrix()));
+  transposed_matrix_.PopulateFromTranspose(matrix_);
+
+  objective_.assign(num_vars_, 0.0);
+  lower_bounds_.assign(num_vars_, 0.0);
+  upper_bounds_.assign(num_vars_, 0.0);
+  for (ColIndex col(0); col < num_cols_; ++col) {
+    objective_[col] = objective_sign_ * lp.objective_coefficients()[col];
+    lower_bounds_[col] = lp.variable_lower_bounds()[col];
+    upper_bounds_[col] = lp.variable_upper_bounds()[col];
+  }
+  for (RowIndex row(0); row < num_rows_; ++row) {
+    const ColIndex slack = num_cols_ + RowToColIndex(row);
+    lower_bounds_[slack] = lp.constraint_lower_bounds()[row];
+    upper_bounds_[slack] = lp.constraint_upper_bounds()[row];
+  }
+
+  // We start from zero projected onto the bounds, but with gaps of at least
+  // one. The difference only shows up in the bound residuals, which the
+  // infeasible method drives to zero.
+  is_fixed_.ClearAndResize(num_vars_);
+  has_lower_bound_.ClearAndResize(num_vars_);
+  has_upper_bound_.ClearAndResize(num_vars_);
+  x_.assign(num_vars_, 0.0);
+  lower_gaps_.assign(num_vars_, 0.0);
+  upper_gaps_.assign(num_vars_, 0.0);
+  lower_duals_.assign(num_vars_, 0.0);
+  upper_duals_.assign(num_vars_, 0.0);
+  y_.assign(num_rows_, 0.0);
+  num_complementarity_pairs_ = 0;
+  bound_norm_ = 0.0;
+  objective_norm_ = 0.0;
+  for (ColIndex col(0); col < num_vars_; ++col) {
+    const Fractional lb = lower_bounds_[col];
+    const Fractional ub = upper_bounds_[col];
+    objective_norm_ = std::max(objective_norm_, std::abs(objective_[col]));
+    if (IsFinite(lb)) bound_norm_ = std::max(bound_norm_, std::abs(lb));
+    if (IsFinite(ub)) bound_norm_ = std::max(bound_norm_, std::abs(ub));
+    if (lb == ub) {
+      is_fixed_.Set(col);
+      x_[col] = lb;
+      continue;
+    }
+    x_[col] = std::clamp(0.0, lb, ub);
+    if (IsFinite(lb)) {
+      has_lower_bound_.Set(col);
+      lower_gaps_[col] = std::max(1.0, x_[col] - lb);
+      lower_duals_[col] = 1.0;
+      ++num_complementarity_pairs_;
+    }
+    if (IsFinite(ub)) {
+      has_upper_bound_.Set(col);
+      upper_gaps_[col] = std::max(1.0, ub - x_[col]);
+      upper_duals_[col] = 1.0;
+      ++num_complementarity_pairs_;
+    }
+  }
+
+  primal_residual_.assign(num_rows_, 0.0);
+  lower_residual_.assign(num_vars_, 0.0);
+  upper_residual_.assign(num_vars_, 0.0);
+  dual_residual_.assign(num_vars_, 0.0);
+  theta_.assign(num_vars_, 0.0);
+  dx_.assign(num_vars_, 0.0);
+  dy_.assign(num_rows_, 0.0);
+  d_lower_gaps_.assign(num_vars_, 0.0);
+  d_upper_gaps_.assign(num_vars_, 0.0);
+  d_lower_duals_.assign(num_vars_, 0.0);
+  d_upper_duals_.assign(num_vars_, 0.0);
+  tmp_column_.assign(num_rows_, 0.0);
+  identity_basis_.resize(num_rows_);
+  for (RowIndex row(0); row < num_rows_; ++row) {
+    identity_basis_[row] = RowToColIndex(row);
+  }
+}
+
+bool InteriorPointSolver::ComputeResidualsAndCheckConvergence() {
+  const auto view = matrix_.view();
+
+  // Primal residual: 0 - (A.x - s).
+  Fractional primal_objective = 0.0;
+  for (RowIndex row(0); row < num_rows_; ++row) {
+    primal_residual_[row] = x_[num_cols_ + RowToColIndex(row)];
+  }
+  for (ColIndex col(0); col < num_cols_; ++col) {
+    primal_objective += objective_[col] * x_[col];
+    for (const EntryIndex i : view.Column(col)) {
+      primal_residual_[view.EntryRow(i)] -= view.EntryCoefficient(i) * x_[col];
+    }
+  }
+  Fractional primal_infeasibility = InfinityNorm(primal_residual_);
+
+  // Bound and dual residuals. The dual objective is computed under the
+  // assumption that the dual is feasible, see for instance Wright's book.
+  Fractional dual_objective = 0.0;
+  Fractional dual_infeasibility = 0.0;
+  Fractional complementarity = 0.0;
+  for (ColIndex col(0); col < num_vars_; ++col) {
+    Fractional transpose_product;
+    if (col < num_cols_) {
+      transpose_product = 0.0;
+      for (const EntryIndex i : view.Column(col)) {
+        transpose_product += view.EntryCoefficient(i) * y_[view.EntryRow(i)];
+      }
+    } else {
+      transpose_product = -y_[ColToRowIndex(col - num_cols_)];
+    }
+    if (is_fixed_[col]) {
+      dual_residual_[col] = 0.0;
+      dual_objective +=
+          (objective_[col] - transpose_product) * lower_bounds_[col];
+      continue;
+    }
+    Fractional dual_residual = objective_[col] - transpose_product;
+    if (has_lower_bound_[col]) {
+      lower_residual_[col] = lower_bounds_[col] - x_[col] + lower_gaps_[col];
+      primal_infeasibility =
+          std::max(primal_infeasibility, std::abs(lower_residual_[col]));
+      dual_residual -= lower_duals_[col];
+      dual_objective += lower_bounds_[col] * lower_duals_[col];
+      complementarity += lower_gaps_[col] * lower_duals_[col];
+    }
+    if (has_upper_bound_[col]) {
+      upper_residual_[col] = upper_bounds_[col] - x_[col] - upper_gaps_[col];
+      primal_infeasibility =
+          std::max(primal_infeasibility, std::abs(upper_residual_[col]));
+      dual_residual += upper_duals_[col];
+      dual_objective -= upper_bounds_[col] * upper_duals_[col];
+      complementarity += upper_gaps_[col] * upper_duals_[col];
+    }
+    dual_residual_[col] = dual_residual;
+    dual_infeasibility = std::max(dual_infeasibility, std::abs(dual_residual));
+  }
+  mu_ = num_complementarity_pairs_ > 0
+            ? complementarity / num_complementarity_pairs_
+            : 0.0;
+
+  const Fractional relative_primal_infeasibility =
+      primal_infeasibility / (1.0 + bound_norm_);
+  const Fractional relative_dual_infeasibility =
+      dual_infeasibility / (1.0 + objective_norm_);
+  const Fractional relative_gap = std::abs(primal_objective - dual_objective) /
+                                  (1.0 + std::abs(primal_objective));
+  SOLVER_LOG(logger_,
+             absl::StrFormat("Interior point %3d: obj = [%+.10e, %+.10e] "
+                             "pinf = %.2e dinf = %.2e mu = %.2e",
+                             num_iterations_,
+                             objective_sign_ * primal_objective,
+                             objective_sign_ * dual_objective,
+                             relative_primal_infeasibility,
+                             relative_dual_infeasibility, mu_));
+  const Fractional tolerance = parameters_.interior_point_tolerance();
+  return relative_primal_infeasibility > tolerance ||
+         relative_dual_infeasibility > tolerance || relative_gap > tolerance;
+}
+
+Status InteriorPointSolver::FactorizeNormalEquations() {
+  for (ColIndex col(0); col < num_vars_; ++col) {
+    if (is_fixed_[col]) {
+      theta_[col] = 0.0;
+      continue;
+    }
+    Fractional inverse = kPrimalRegularization;
+    if (has_lower_bound_[col]) {
+      inverse += lower_duals_[col] / lower_gaps_[col];
+    }
+    if (has_upper_bound_[col]) {
+      inverse += upper_duals_[col] / upper_gaps_[col];
+    }
+    theta_[col] = 1.0 / inverse;
+  }
+
+  // The column of A.Theta.A^T associated to a row is the sum, over the entries
+  // (row, col) of A, of a_row_col.theta_col.A_col. The slack columns are -I
+  // and only contribute to the diagonal.
+  //
+  // TODO(user): A few dense columns of A make the normal equations dense.
+  // Handle them separately, for instance with a Sherman-Morrison-Woodbury
+  // update or by switching to the augmented system.
+  const auto view = matrix_.view();
+  const auto transposed_view = transposed_matrix_.view();
+  normal_matrix_.Reset(num_rows_);
+  for (RowIndex row(0); row < num_rows_; ++row) {
+    for (const EntryIndex i : transposed_view.Column(RowToColIndex(row))) {
+      const ColIndex col = RowToColIndex(transposed_view.EntryRow(i));
+      const Fractional factor =
+          transposed_view.EntryCoefficient(i) * theta_[col];
+      if (factor == 0.0) continue;
+      for (const EntryIndex j : view.Column(col)) {
+        const RowIndex other_row = view.EntryRow(j);
+        if (tmp_column_[other_row] == 0.0) tmp_non_zeros_.push_back(other_row);
+        tmp_column_[other_row] += factor * view.EntryCoefficient(j);
+      }
+    }
+    if (tmp_column_[row] == 0.0) tmp_non_zeros_.push_back(row);
+    tmp_column_[row] +=
+        theta_[num_cols_ + RowToColIndex(row)] + kDualRegularization;
+    normal_matrix_.AddAndClearColumnWithNonZeros(&tmp_column_,
+                                                 &tmp_non_zeros_);
+  }
+  return lu_factorization_.ComputeFactorization(
+      CompactSparseMatrixView(&normal_matrix_, &identity_basis_));
+}
+
+void InteriorPointSolver::ComputeNewtonDirection(
+    const DenseRow& lower_complementarity,
+    const DenseRow& upper_complementarity) {
+  // Eliminating the gaps and the bound duals from the Newton system gives
+  // A^T.dy - Theta^-1.dx = r and A.dx = primal_residual. We first store
+  // Theta.r in dx_.
+  for (ColIndex col(0); col < num_vars_; ++col) {
+    if (is_fixed_[col]) {
+      dx_[col] = 0.0;
+      continue;
+    }
+    Fractional r = dual_residual_[col];
+    if (has_lower_bound_[col]) {
+      r -= (lower_complementarity[col] +
+            lower_duals_[col] * lower_residual_[col]) /
+           lower_gaps_[col];
+    }
+    if (has_upper_bound_[col]) {
+      r += (upper_complementarity[col] -
+            upper_duals_[col] * upper_residual_[col]) /
+           upper_gaps_[col];
+    }
+    dx_[col] = theta_[col] * r;
+  }
+
+  // A.Theta.A^T.dy = primal_residual + A.Theta.r.
+  const auto view = matrix_.view();
+  for (RowIndex row(0); row < num_rows_; ++row) {
+    dy_[row] = primal_residual_[row] - dx_[num_cols_ + RowToColIndex(row)];
+  }
+  for (ColIndex col(0); col < num_cols_; ++col) {
+    const Fractional value = dx_[col];
+    if (value == 0.0) continue;
+    for (const EntryIndex i : view.Column(col)) {
+      dy_[view.EntryRow(i)] += view.EntryCoefficient(i) * value;
+    }
+  }
+  lu_factorization_.RightSolve(&dy_);
+
+  // dx = Theta.(A^T.dy - r), and then the gaps and bound duals.
+  for (ColIndex col(0); col < num_vars_; ++col) {
+    if (is_fixed_[col]) continue;
+    Fractional transpose_product;
+    if (col < num_cols_) {
+      transpose_product = 0.0;
+      for (const EntryIndex i : view.Column(col)) {
+        transpose_product += view.EntryCoefficient(i) * dy_[view.EntryRow(i)];
+      }
+    } else {
+      transpose_product = -dy_[ColToRowIndex(col - num_cols_)];
+    }
+    dx_[col] = theta_[col] * transpose_product - dx_[col];
+    if (has_lower_bound_[col]) {
+      d_lower_gaps_[col] = dx_[col] - lower_residual_[col];
+      d_lower_duals_[col] = (lower_complementarity[col] -
+                             lower_duals_[col] * d_lower_gaps_[col]) /
+                            lower_gaps_[col];
+    }
+    if (has_upper_bound_[col]) {
+      d_upper_gaps_[col] = upper_residual_[col] - dx_[col];
+      d_upper_duals_[col] = (upper_complementarity[col] -
+                             upper_duals_[col] * d_upper_gaps_[col]) /
+                            upper_gaps_[col];
+    }
+  }
+}
+
+Fractional InteriorPointSolver::MaxPrimalStep() const {
+  Fractional step = 1.0;
+  for (ColIndex col(0); col < num_vars_; ++col) {
+    if (has_lower_bound_[col] && d_lower_gaps_[col] < 0.0) {
+      step = std::min(step, -lower_gaps_[col] / d_lower_gaps_[col]);
+    }
+    if (has_upper_bound_[col] && d_upper_gaps_[col] < 0.0) {
+      step = std::min(step, -upper_gaps_[col] / d_upper_gaps_[col]);
+    }
+  }
+  return step;
+}
+
+Fractional InteriorPointSolver::MaxDualStep() const {
+  Fractional step = 1.0;
+  for (ColIndex col(0); col < num_vars_; ++col) {
+    if (has_lower_bound_[col] && d_lower_duals_[col] < 0.0) {
+      step = std::min(step, -lower_duals_[col] / d_lower_duals_[col]);
+    }
+    if (has_upper_bound_[col] && d_upper_duals_[col] < 0.0) {
+      step = std::min(step, -upper_duals_[col] / d_upper_duals_[col]);
+    }
+  }
+  return step;
+}
+
+Fractional InteriorPointSolver::ComplementarityAfterStep(
+    Fractional primal_step, Fractional dual_step) const {
+  if (num_complementarity_pairs_ == 0) return 0.0;
+  Fractional sum = 0.0;
+  for (ColIndex col(0); col < num_vars_; ++col) {
+    if (has_lower_bound_[col]) {
+      sum += (lower_gaps_[col] + primal_step * d_lower_gaps_[col]) *
+             (lower_duals_[col] + dual_step * d_lower_duals_[col]);
+    }
+    if (has_upper_bound_[col]) {
+      sum += (upper_gaps_[col] + primal_step * d_upper_gaps_[col]) *
+             (upper_duals_[col] + dual_step * d_upper_duals_[col]);
+    }
+  }
+  return sum / num_complementarity_pairs_;
+}
+
+void InteriorPointSolver::ExtractSolution() {
+  primal_values_.assign(num_cols_, 0.0);
+  for (ColIndex col(0); col < num_cols_; ++col) {
+    primal_values_[col] = x_[col];
+  }
+  dual_values_.assign(num_rows_, 0.0);
+  for (RowIndex row(0); row < num_rows_; ++row) {
+    dual_values_[row] = objective_sign_ * y_[row];
+  }
+}
+
+}  // namespace glop
+}  // namespace operations_research
@@ -0,0 +1,172 @@
+// Copyright 2010-2024 Google LLC
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef OR_TOOLS_GLOP_INTERIOR_POINT_H_
+#define OR_TOOLS_GLOP_INTERIOR_POINT_H_
+
+#include <vector>
+
+#include "ortools/glop/lu_factorization.h"
+#include "ortools/glop/parameters.pb.h"
+#include "ortools/glop/status.h"
+#include "ortools/lp_data/lp_data.h"
+#include "ortools/lp_data/lp_types.h"
+#include "ortools/lp_data/sparse.h"
+#include "ortools/util/logging.h"
+#include "ortools/util/time_limit.h"
+
+namespace operations_research {
+namespace glop {
+
+// A primal-dual interior point (barrier) method with Mehrotra's
+// predictor-corrector, see for instance:
+//
+// Sanjay Mehrotra, "On the Implementation of a Primal-Dual Interior Point
+// Method", SIAM Journal on Optimization, Vol. 2, No. 4, 1992.
+// http://dx.doi.org/10.1137/0802028
+//
+// The problem "min c.x, lb <= x <= ub, clb <= A.x <= cub" is solved in the
+// form "A.x - s = 0" where s is the vector of row activities with bounds
+// [clb, cub]. Each finite bound gets its own non-negative gap and dual
+// variable, fixed variables (this includes the slacks of the equality rows)
+// never move, and free variables are handled with a small primal
+// regularization. The Newton systems are reduced to the normal equations
+// A.Theta.A^T + delta.I, which are factorized with our Markowitz LU.
+//
+// The result is only an approximate, interior, solution. Use it to crossover to
+// a basic solution with the RevisedSimplex, see
+// LPSolver::SetStartingPrimalDualSolution().
+class InteriorPointSolver {
+ public:
+  InteriorPointSolver() = default;
+
+  // This type is neither copyable nor movable.
+  InteriorPointSolver(const InteriorPointSolver&) = delete;
+  InteriorPointSolver& operator=(const InteriorPointSolver&) = delete;
+
+  void SetParameters(const GlopParameters& parameters) {
+    parameters_ = parameters;
+  }
+  void SetLogger(SolverLogger* logger) { logger_ = logger; }
+
+  // Solves the given linear program. Returns OPTIMAL if the relative primal
+  // and dual infeasibilities and the relative duality gap are all below
+  // interior_point_tolerance, ABNORMAL if the normal equations could not be
+  // factorized and INIT if the method ran out of time or iterations. Note that
+  // infeasibility and unboundedness are not detected: the method will just
+  // not converge.
+  ProblemStatus Solve(const LinearProgram& lp, TimeLimit* time_limit);
+
+  // The last solution found, in the same format as the one returned by
+  // LPSolver. The dual values follow the sign convention of the problem
+  // direction, so that the reduced costs are c - A^T.dual_values.
+  const DenseRow& primal_values() const { return primal_values_; }
+  const DenseColumn& dual_values() const { return dual_values_; }
+
+  int num_iterations() const { return num_iterations_; }
+
+ private:
+  // Initializes the internal representation of the problem and a starting
+  // point that is strictly inside the bounds but not necessarily feasible.
+  void Initialize(const LinearProgram& lp);
+
+  // Computes the residuals of the current point and returns false if it is
+  // already accurate enough.
+  bool ComputeResidualsAndCheckConvergence();
+
+  // Computes theta_ and factorizes the normal equations.
+  Status FactorizeNormalEquations();
+
+  // Solves the Newton system for the given complementarity right hand sides.
+  // The result is stored in the d*_ members.
+  void ComputeNewtonDirection(const DenseRow& lower_complementarity,
+                              const DenseRow& upper_complementarity);
+
+  // Returns the largest step in [0, 1] along the current direction that keeps
+  // the given gaps or duals non-negative.
+  Fractional MaxPrimalStep() const;
+  Fractional MaxDualStep() const;
+
+  // Returns the average complementarity product after a step of the given
+  // lengths along the current direction.
+  Fractional ComplementarityAfterStep(Fractional primal_step,
+                                      Fractional dual_step) const;
+
+  // Copies the structural part of the current point to the solution.
+  void ExtractSolution();
+
+  GlopParameters parameters_;
+  SolverLogger default_logger_;
+  SolverLogger* logger_ = &default_logger_;
+
+  // The columns are the structural variables followed by one slack per row.
+  RowIndex num_rows_;
+  ColIndex num_cols_;
+  ColIndex num_vars_;
+  Fractional objective_sign_ = 1.0;
+  CompactSparseMatrix matrix_;
+  CompactSparseMatrix transposed_matrix_;
+  DenseRow objective_;
+  DenseRow lower_bounds_;
+  DenseRow upper_bounds_;
+  DenseBitRow is_fixed_;
+  DenseBitRow has_lower_bound_;
+  DenseBitRow has_upper_bound_;
+  int num_complementarity_pairs_ = 0;
+
+  // The magnitudes used to make the convergence criteria relative.
+  Fractional bound_norm_ = 0.0;
+  Fractional objective_norm_ = 0.0;
+
+  // The current point. The gaps are x - lb and ub - x, the associated duals
+  // must be non-negative and A^T.y + lower_duals - upper_duals must be equal
+  // to the objective.
+  DenseRow x_;
+  DenseColumn y_;
+  DenseRow lower_gaps_;
+  DenseRow upper_gaps_;
+  DenseRow lower_duals_;
+  DenseRow upper_duals_;
+
+  // The residuals of the current point and its average complementarity.
+  DenseColumn primal_residual_;
+  DenseRow lower_residual_;
+  DenseRow upper_residual_;
+  DenseRow dual_residual_;
+  Fractional mu_ = 0.0;
+
+  // The normal equations and their factorization.
+  DenseRow theta_;
+  CompactSparseMatrix normal_matrix_;
+  RowToColMapping identity_basis_;
+  LuFactorization lu_factorization_;
+  DenseColumn tmp_column_;
+  std::vector<RowIndex> tmp_non_zeros_;
+
+  // The current Newton direction.
+  DenseRow dx_;
+  DenseColumn dy_;
+  DenseRow d_lower_gaps_;
+  DenseRow d_upper_gaps_;
+  DenseRow d_lower_duals_;
+  DenseRow d_upper_duals_;
+
+  DenseRow primal_values_;
+  DenseColumn dual_values_;
+  int num_iterations_ = 0;
+};
+
+}  // namespace glop
+}  // namespace operations_research
+
+#endif  // OR_TOOLS_GLOP_INTERIOR_POINT_H_
@@ -14,10 +14,13 @@
 #include "ortools/glop/lp_solver.h"
 
 #include <algorithm>
+#include <atomic>
 #include <cmath>
 #include <cstdlib>
 #include <memory>
 #include <string>
+#include <utility>
+#include <vector>
 
 #include "absl/flags/flag.h"
 #include "absl/log/check.h"
@@ -25,7 +28,9 @@
 #include "absl/strings/str_format.h"
 #include "google/protobuf/text_format.h"
 #include "ortools/base/logging.h"
+#include "ortools/base/threadpool.h"
 #include "ortools/base/version.h"
+#include "ortools/glop/interior_point.h"
 #include "ortools/glop/parameters.pb.h"
 #include "ortools/glop/preprocessor.h"
 #include "ortools/glop/revised_simplex.h"
@@ -33,12 +38,14 @@
 #include "ortools/glop/variables_info.h"
 #include "ortools/linear_solver/linear_solver.pb.h"
 #include "ortools/lp_data/lp_data.h"
+#include "ortools/lp_data/lp_decomposer.h"
 #include "ortools/lp_data/lp_types.h"
 #include "ortools/lp_data/lp_utils.h"
 #include "ortools/lp_data/proto_utils.h"
 #include "ortools/port/proto_utils.h"
 #include "ortools/util/fp_utils.h"
 #include "ortools/util/logging.h"
+#include "ortools/util/stats.h"
 
 #ifndef __PORTABLE_PLATFORM__
 // TODO(user): abstract this in some way to the port directory.
@@ -251,8 +258,20 @@ ProblemStatus LPSolver::SolveWithTimeLimit(const LinearProgram& lp,
   // Do not launch the solver if the time limit was already reached. This might
   // mean that the pre-processors were not all run, and current_linear_program_
   // might not be in a completely safe state.
+  //
+  // Note that the decomposition relies on the preprocessors to remove the
+  // empty constraints, which do not belong to any block.
   if (!time_limit->LimitReached()) {
-    RunRevisedSimplexIfNeeded(&solution, time_limit);
+    const bool use_starting_solution =
+        (!starting_primal_values_.empty() &&
+         LoadStartingPrimalDualSolution(lp)) ||
+        RunInteriorPointIfNeeded(time_limit);
+    const bool solved_by_blocks =
+        !use_starting_solution &&
+        parameters_.num_block_decomposition_threads() > 1 &&
+        parameters_.use_preprocessing() &&
+        RunRevisedSimplexOnIndependentBlocks(&solution, time_limit);
+    if (!solved_by_blocks) RunRevisedSimplexIfNeeded(&solution, time_limit);
   }
   if (postsolve_is_needed) preprocessor.DestructiveRecoverSolution(&solution);
   const ProblemStatus status = LoadAndVerifySolution(lp, solution);
@@ -278,6 +297,17 @@ void LPSolver::Clear() {
 void LPSolver::SetInitialBasis(
     const VariableStatusRow& variable_statuses,
     const ConstraintStatusColumn& constraint_statuses) {
+  LoadInitialBasis(variable_statuses, constraint_statuses);
+  if (parameters_.use_preprocessing()) {
+    LOG(WARNING) << "In GLOP, SetInitialBasis() was called but the parameter "
+                    "use_preprocessing is true, this will likely not result in "
+                    "what you want.";
+  }
+}
+
+void LPSolver::LoadInitialBasis(
+    const VariableStatusRow& variable_statuses,
+    const ConstraintStatusColumn& constraint_statuses) {
   // Create the associated basis state.
   BasisState state;
   state.statuses = variable_statuses;
@@ -307,13 +337,151 @@ void LPSolver::SetInitialBasis(
     revised_simplex_->SetLogger(&logger_);
   }
   revised_simplex_->LoadStateForNextSolve(state);
+}
+
+void LPSolver::SetStartingPrimalDualSolution(const DenseRow& primal_values,
+                                             const DenseColumn& dual_values) {
+  starting_primal_values_ = primal_values;
+  starting_dual_values_ = dual_values;
   if (parameters_.use_preprocessing()) {
-    LOG(WARNING) << "In GLOP, SetInitialBasis() was called but the parameter "
-                    "use_preprocessing is true, this will likely not result in "
-                    "what you want.";
+    LOG(WARNING) << "In GLOP, SetStartingPrimalDualSolution() was called but "
+                    "the parameter use_preprocessing is true, the given "
+                    "solution will likely be ignored.";
   }
 }
 
+namespace {
+
+// Returns the crossover status of a variable (or of the activity of a
+// constraint) with the given value, bounds and reduced cost, in an approximate
+// optimal solution of a minimization problem. Note that this never returns
+// FREE: a free variable is a candidate for the basis.
+VariableStatus CrossoverStatus(Fractional value, Fractional lb, Fractional ub,
+                               Fractional reduced_cost,
+                               Fractional primal_tolerance,
+                               Fractional dual_tolerance) {
+  if (lb == ub) return VariableStatus::FIXED_VALUE;
+  if (reduced_cost > dual_tolerance && IsFinite(lb)) {
+    return VariableStatus::AT_LOWER_BOUND;
+  }
+  if (reduced_cost < -dual_tolerance && IsFinite(ub)) {
+    return VariableStatus::AT_UPPER_BOUND;
+  }
+  if (IsFinite(lb) &&
+      value - lb <= primal_tolerance * std::max(1.0, std::abs(lb))) {
+    return VariableStatus::AT_LOWER_BOUND;
+  }
+  if (IsFinite(ub) &&
+      ub - value <= primal_tolerance * std::max(1.0, std::abs(ub))) {
+    return VariableStatus::AT_UPPER_BOUND;
+  }
+  return VariableStatus::BASIC;
+}
+
+ConstraintStatus VariableToConstraintStatus(VariableStatus status) {
+  switch (status) {
+    case VariableStatus::FIXED_VALUE:
+      return ConstraintStatus::FIXED_VALUE;
+    case VariableStatus::AT_LOWER_BOUND:
+      return ConstraintStatus::AT_LOWER_BOUND;
+    case VariableStatus::AT_UPPER_BOUND:
+      return ConstraintStatus::AT_UPPER_BOUND;
+    case VariableStatus::FREE:
+      return ConstraintStatus::FREE;
+    case VariableStatus::BASIC:
+      return ConstraintStatus::BASIC;
+  }
+  return ConstraintStatus::BASIC;
+}
+
+}  // namespace
+
+bool LPSolver::LoadStartingPrimalDualSolution(const LinearProgram& lp) {
+  const DenseRow primal_values = std::move(starting_primal_values_);
+  const DenseColumn dual_values = std::move(starting_dual_values_);
+  starting_primal_values_.clear();
+  starting_dual_values_.clear();
+  const RowIndex num_rows = lp.num_constraints();
+  const ColIndex num_cols = lp.num_variables();
+  if (primal_values.size() != num_cols || dual_values.size() != num_rows ||
+      current_linear_program_.num_variables() != num_cols ||
+      current_linear_program_.num_constraints() != num_rows) {
+    SOLVER_LOG(&logger_,
+               "Ignoring the starting primal/dual solution because it does "
+               "not match the problem to solve.");
+    return false;
+  }
+  LoadCrossoverBasis(lp, primal_values, dual_values);
+  return true;
+}
+
+void LPSolver::LoadCrossoverBasis(const LinearProgram& lp,
+                                  const DenseRow& primal_values,
+                                  const DenseColumn& dual_values) {
+  const RowIndex num_rows = lp.num_constraints();
+  const ColIndex num_cols = lp.num_variables();
+
+  // We work as if the problem was a minimization problem.
+  const Fractional sign = lp.IsMaximizationProblem() ? -1.0 : 1.0;
+  const Fractional primal_tolerance = parameters_.primal_feasibility_tolerance();
+  const Fractional dual_tolerance = parameters_.dual_feasibility_tolerance();
+  const SparseMatrix& matrix = lp.GetSparseMatrix();
+  DenseColumn activities(num_rows, 0.0);
+  VariableStatusRow variable_statuses(num_cols, VariableStatus::FREE);
+  int num_basic_candidates = 0;
+  for (ColIndex col(0); col < num_cols; ++col) {
+    Fractional reduced_cost = lp.objective_coefficients()[col];
+    for (const SparseColumn::Entry e : matrix.column(col)) {
+      activities[e.row()] += e.coefficient() * primal_values[col];
+      reduced_cost -= e.coefficient() * dual_values[e.row()];
+    }
+    variable_statuses[col] = CrossoverStatus(
+        primal_values[col], lp.variable_lower_bounds()[col],
+        lp.variable_upper_bounds()[col], sign * reduced_cost, primal_tolerance,
+        dual_tolerance);
+    if (variable_statuses[col] == VariableStatus::BASIC) ++num_basic_candidates;
+  }
+  ConstraintStatusColumn constraint_statuses(num_rows, ConstraintStatus::FREE);
+  for (RowIndex row(0); row < num_rows; ++row) {
+    constraint_statuses[row] = VariableToConstraintStatus(CrossoverStatus(
+        activities[row], lp.constraint_lower_bounds()[row],
+        lp.constraint_upper_bounds()[row], sign * dual_values[row],
+        primal_tolerance, dual_tolerance));
+    if (constraint_statuses[row] == ConstraintStatus::BASIC) {
+      ++num_basic_candidates;
+    }
+  }
+  SOLVER_LOG(&logger_, "Crossover from the given solution with ",
+             num_basic_candidates, " basis candidates (num_rows = ",
+             num_rows.value(), ").");
+
+  LoadInitialBasis(variable_statuses, constraint_statuses);
+  if (!parameters_.use_scaling()) {
+    revised_simplex_->SetStartingVariableValuesForNextSolve(primal_values);
+  }
+}
+
+bool LPSolver::RunInteriorPointIfNeeded(TimeLimit* time_limit) {
+  if (!parameters_.use_interior_point() ||
+      current_linear_program_.num_constraints() == 0) {
+    return false;
+  }
+  InteriorPointSolver interior_point;
+  interior_point.SetParameters(parameters_);
+  interior_point.SetLogger(&logger_);
+  const ProblemStatus status =
+      interior_point.Solve(current_linear_program_, time_limit);
+  if (status != ProblemStatus::OPTIMAL) {
+    SOLVER_LOG(&logger_,
+               "The interior point did not converge, running the simplex "
+               "from scratch.");
+    return false;
+  }
+  LoadCrossoverBasis(current_linear_program_, interior_point.primal_values(),
+                     interior_point.dual_values());
+  return true;
+}
+
 namespace {
 // Computes the "real" problem objective from the one without offset nor
 // scaling.
@@ -600,6 +768,7 @@ void LPSolver::ResizeSolution(RowIndex num_rows, ColIndex num_cols) {
 
 void LPSolver::RunRevisedSimplexIfNeeded(ProblemSolution* solution,
                                          TimeLimit* time_limit) {
+  SCOPED_PROFILING_COUNTER("glop.RevisedSimplex");
   // Note that the transpose matrix is no longer needed at this point.
   // This helps reduce the peak memory usage of the solver.
   //
@@ -669,6 +838,110 @@ void LPSolver::RunRevisedSimplexIfNeeded(ProblemSolution* solution,
 
 namespace {
 
+// Returns the status of a problem made of independent blocks with the given
+// statuses: an error or infeasibility in one block is an error or an
+// infeasibility of the whole problem.
+ProblemStatus CombineBlockStatuses(const std::vector<ProblemStatus>& statuses) {
+  const auto contains = [&statuses](ProblemStatus status) {
+    return std::find(statuses.begin(), statuses.end(), status) !=
+           statuses.end();
+  };
+  for (const ProblemStatus status :
+       {ProblemStatus::ABNORMAL, ProblemStatus::INVALID_PROBLEM,
+        ProblemStatus::IMPRECISE, ProblemStatus::PRIMAL_INFEASIBLE,
+        ProblemStatus::DUAL_UNBOUNDED, ProblemStatus::INFEASIBLE_OR_UNBOUNDED,
+        ProblemStatus::PRIMAL_UNBOUNDED, ProblemStatus::DUAL_INFEASIBLE,
+        ProblemStatus::INIT}) {
+    if (contains(status)) return status;
+  }
+  const bool primal_feasible = contains(ProblemStatus::PRIMAL_FEASIBLE);
+  const bool dual_feasible = contains(ProblemStatus::DUAL_FEASIBLE);
+  if (primal_feasible && dual_feasible) return ProblemStatus::INIT;
+  if (primal_feasible) return ProblemStatus::PRIMAL_FEASIBLE;
+  if (dual_feasible) return ProblemStatus::DUAL_FEASIBLE;
+  return ProblemStatus::OPTIMAL;
+}
+
+}  // namespace
+
+bool LPSolver::RunRevisedSimplexOnIndependentBlocks(ProblemSolution* solution,
+                                                    TimeLimit* time_limit) {
+  if (solution->status != ProblemStatus::INIT) return false;
+  LPDecomposer decomposer;
+  decomposer.Decompose(&current_linear_program_);
+  const int num_blocks = decomposer.GetNumberOfProblems();
+  if (num_blocks <= 1) return false;
+
+  SCOPED_PROFILING_COUNTER("glop.RevisedSimplex");
+  SOLVER_LOG(&logger_, "Solving ", num_blocks, " independent blocks with ",
+             parameters_.num_block_decomposition_threads(), " threads.");
+  std::vector<LinearProgram> blocks(num_blocks);
+  std::vector<ProblemSolution> block_solutions;
+  block_solutions.reserve(num_blocks);
+  for (int b = 0; b < num_blocks; ++b) {
+    decomposer.ExtractLocalProblem(b, &blocks[b]);
+    blocks[b].CleanUp();
+    block_solutions.emplace_back(blocks[b].num_constraints(),
+                                 blocks[b].num_variables());
+  }
+
+  // Each block uses its own TimeLimit since they are not thread-safe. Their
+  // deterministic times are added to the given one once all blocks are done.
+  std::vector<double> block_deterministic_times(num_blocks, 0.0);
+  std::vector<int> block_iterations(num_blocks, 0);
+  const double time_left = time_limit->GetTimeLeft();
+  const double deterministic_time_left =
+      time_limit->GetDeterministicTimeLeft();
+  std::atomic<bool>* const external_stop = time_limit->ExternalBooleanAsLimit();
+  {
+    ThreadPool pool("GlopBlocks",
+                    std::min(num_blocks,
+                             parameters_.num_block_decomposition_threads()));
+    pool.StartWorkers();
+    for (int b = 0; b < num_blocks; ++b) {
+      pool.Schedule([&, b]() {
+        TimeLimit block_time_limit(time_left, deterministic_time_left);
+        block_time_limit.RegisterExternalBooleanAsLimit(external_stop);
+        RevisedSimplex simplex;
+        simplex.SetParameters(parameters_);
+        ProblemSolution& block_solution = block_solutions[b];
+        if (!simplex.Solve(blocks[b], &block_time_limit).ok()) {
+          block_solution.status = ProblemStatus::ABNORMAL;
+        } else {
+          block_solution.status = simplex.GetProblemStatus();
+          block_iterations[b] = simplex.GetNumberOfIterations();
+          const ColIndex num_cols = block_solution.primal_values.size();
+          for (ColIndex col(0); col < num_cols; ++col) {
+            block_solution.primal_values[col] = simplex.GetVariableValue(col);
+            block_solution.variable_statuses[col] =
+                simplex.GetVariableStatus(col);
+          }
+          const RowIndex num_rows = block_solution.dual_values.size();
+          for (RowIndex row(0); row < num_rows; ++row) {
+            block_solution.dual_values[row] = simplex.GetDualValue(row);
+            block_solution.constraint_statuses[row] =
+                simplex.GetConstraintStatus(row);
+          }
+        }
+        block_deterministic_times[b] =
+            block_time_limit.GetElapsedDeterministicTime();
+      });
+    }
+  }
+
+  std::vector<ProblemStatus> statuses;
+  for (int b = 0; b < num_blocks; ++b) {
+    statuses.push_back(block_solutions[b].status);
+    num_revised_simplex_iterations_ += block_iterations[b];
+    time_limit->AdvanceDeterministicTime(block_deterministic_times[b]);
+  }
+  *solution = decomposer.AggregateSolutions(block_solutions);
+  solution->status = CombineBlockStatuses(statuses);
+  return true;
+}
+
+namespace {
+
 void LogVariableStatusError(ColIndex col, Fractional value,
                             VariableStatus status, Fractional lb,
                             Fractional ub) {
@@ -90,6 +90,22 @@ class LPSolver {
   void SetInitialBasis(const VariableStatusRow& variable_statuses,
                        const ConstraintStatusColumn& constraint_statuses);
 
+  // Advanced usage. Crossover from an approximate optimal solution of the
+  // problem given to the next Solve(), for instance one computed by an interior
+  // point or a first order method like PDLP. The dual values must follow the
+  // same sign convention as GetDualValues().
+  //
+  // The variables and constraints that are strictly within their bounds and
+  // whose reduced cost (or dual value) is close to zero are used as candidates
+  // for the initial basis, which is completed or repaired by the simplex. The
+  // others start at the bound indicated by their value and reduced cost. The
+  // simplex then finishes the solve and, with push_to_vertex, moves the
+  // remaining super-basic variables to a bound so that the returned solution
+  // is basic. Like for SetInitialBasis(), presolve should be disabled. The
+  // primal values are only used as starting values when use_scaling is false.
+  void SetStartingPrimalDualSolution(const DenseRow& primal_values,
+                                     const DenseColumn& dual_values);
+
   // This loads a given solution and computes related quantities so that the
   // getters below will refer to it.
   //
@@ -195,6 +211,35 @@ class LPSolver {
   void RunRevisedSimplexIfNeeded(ProblemSolution* solution,
                                  TimeLimit* time_limit);
 
+  // If current_linear_program_ decomposes into independent blocks, solves
+  // each of them with its own RevisedSimplex on a pool of
+  // num_block_decomposition_threads threads, fills the solution by combining
+  // their solutions and returns true. Returns false if the problem does not
+  // decompose, in which case nothing is done.
+  bool RunRevisedSimplexOnIndependentBlocks(ProblemSolution* solution,
+                                            TimeLimit* time_limit);
+
+  // Loads in revised_simplex_ the crash basis derived from the solution given
+  // to SetStartingPrimalDualSolution() and clears it. Returns false if it does
+  // not correspond to the given problem.
+  bool LoadStartingPrimalDualSolution(const LinearProgram& lp);
+
+  // Loads in revised_simplex_ a crash basis for lp derived from the given
+  // approximate optimal solution. The basic candidates are the variables and
+  // constraints that are neither at a bound nor have a non-zero reduced cost.
+  void LoadCrossoverBasis(const LinearProgram& lp,
+                          const DenseRow& primal_values,
+                          const DenseColumn& dual_values);
+
+  // Loads the given basis in revised_simplex_, creating it if needed.
+  void LoadInitialBasis(const VariableStatusRow& variable_statuses,
+                        const ConstraintStatusColumn& constraint_statuses);
+
+  // If use_interior_point is true, solves current_linear_program_ with the
+  // InteriorPointSolver and, if it converged, loads the crossover basis
+  // derived from its solution and returns true.
+  bool RunInteriorPointIfNeeded(TimeLimit* time_limit);
+
   // Checks that the returned solution values and statuses are consistent.
   // Returns true if this is the case. See the code for the exact check
   // performed.
@@ -290,6 +335,10 @@ class LPSolver {
   DenseColumn constraints_dual_ray_;
   DenseRow variable_bounds_dual_ray_;
 
+  // The solution given to SetStartingPrimalDualSolution() if any.
+  DenseRow starting_primal_values_;
+  DenseColumn starting_dual_values_;
+
   // Quantities computed from the solution and the linear program.
   DenseRow reduced_costs_;
   DenseColumn constraint_activities_;
@@ -299,12 +299,19 @@ void LuFactorization::RightSolveLWithNonZeros(ScatteredColumn* x) const {
 
   PermuteWithKnownNonZeros(row_perm_, &dense_zero_scratchpad_, &x->values,
                            &x->non_zeros);
-  lower_.ComputeRowsToConsiderInSortedOrder(&x->non_zeros);
-  x->non_zeros_are_sorted = true;
+
+  // All the clients of this function sort the non-zeros at the end of the full
+  // solve if needed, so we can use the DFS which gives a topological order of
+  // the reach without paying for a sort like in the other functions. This
+  // makes the cost of the hyper-sparse solve linear in the number of touched
+  // entries.
+  lower_.ComputeRowsToConsiderWithDfs(&x->non_zeros);
   if (x->non_zeros.empty()) {
+    x->non_zeros_are_sorted = true;
     lower_.LowerSolve(&x->values);
   } else {
-    lower_.HyperSparseSolve(&x->values, &x->non_zeros);
+    x->non_zeros_are_sorted = false;
+    lower_.HyperSparseSolveWithReversedNonZeros(&x->values, &x->non_zeros);
   }
 }
 
@@ -68,7 +68,23 @@ Status Markowitz::ComputeRowAndColumnPermutation(
   const int end_index = std::min(num_rows.value(), num_cols.value());
   const Fractional singularity_threshold =
       parameters_.markowitz_singularity_threshold();
+  const double dense_tail_density = parameters_.markowitz_dense_tail_density();
+  int last_pivot_col_degree = 0;
   while (index < end_index) {
+    // Switch to a dense factorization if the residual matrix is dense enough.
+    // Because FindPivot() looks at the columns by increasing degree, the degree
+    // of the last pivot column is a good estimate of the minimum column degree
+    // of the residual matrix.
+    const int residual_size = end_index - index;
+    if (num_rows.value() == num_cols.value() &&
+        residual_size >= kMinDenseTailSize &&
+        residual_size <= kMaxDenseTailSize &&
+        last_pivot_col_degree >= dense_tail_density * residual_size) {
+      stats_.dense_tail_ratio.Add(1.0 * residual_size / num_rows.value());
+      GLOP_RETURN_IF_ERROR(FactorizeDenseTail(row_perm, col_perm, &index));
+      break;
+    }
+
     Fractional pivot_coefficient = 0.0;
     RowIndex pivot_row = kInvalidRow;
     ColIndex pivot_col = kInvalidCol;
@@ -100,6 +116,7 @@ Status Markowitz::ComputeRowAndColumnPermutation(
     // updated.
     const int pivot_col_degree = residual_matrix_non_zero_.ColDegree(pivot_col);
     const int pivot_row_degree = residual_matrix_non_zero_.RowDegree(pivot_row);
+    last_pivot_col_degree = pivot_col_degree;
     residual_matrix_non_zero_.DeleteRowAndColumn(pivot_row, pivot_col);
     if (min_markowitz == 0) {
       ++stats_num_pivots_without_fill_in;
@@ -150,6 +167,124 @@ Status Markowitz::ComputeRowAndColumnPermutation(
   return Status::OK();
 }
 
+Status Markowitz::FactorizeDenseTail(RowPermutation* row_perm,
+                                     ColumnPermutation* col_perm, int* index) {
+  SCOPED_TIME_STAT(&stats_);
+  const RowIndex num_rows = row_perm->size();
+  const ColIndex num_cols = col_perm->size();
+
+  // Collect the rows and columns of the residual matrix.
+  dense_tail_rows_.clear();
+  dense_tail_cols_.clear();
+  row_to_dense_tail_index_.assign(num_rows, -1);
+  for (RowIndex row(0); row < num_rows; ++row) {
+    if ((*row_perm)[row] != kInvalidRow) continue;
+    row_to_dense_tail_index_[row] = dense_tail_rows_.size();
+    dense_tail_rows_.push_back(row);
+  }
+  for (ColIndex col(0); col < num_cols; ++col) {
+    if ((*col_perm)[col] == kInvalidCol) dense_tail_cols_.push_back(col);
+  }
+  const int size = dense_tail_rows_.size();
+  DCHECK_EQ(size, dense_tail_cols_.size());
+
+  // Compute the residual columns with the L constructed so far and copy them
+  // in a column-major dense matrix. Note that this also computes the part of
+  // the columns of U corresponding to the rows already eliminated in
+  // permuted_upper_.
+  dense_tail_.assign(static_cast<size_t>(size) * size, 0.0);
+  for (int j = 0; j < size; ++j) {
+    Fractional* column = &dense_tail_[static_cast<size_t>(j) * size];
+    for (const SparseColumn::Entry e :
+         ComputeColumn(*row_perm, dense_tail_cols_[j])) {
+      DCHECK_GE(row_to_dense_tail_index_[e.row()], 0);
+      column[row_to_dense_tail_index_[e.row()]] = e.coefficient();
+    }
+  }
+
+  // Right-looking LU with partial pivoting. The row swaps are applied to the
+  // full rows, so that at the end dense_tail_rows_ gives the final pivot rows.
+  // All the inner loops work on contiguous memory.
+  const Fractional singularity_threshold =
+      parameters_.markowitz_singularity_threshold();
+  for (int k = 0; k < size; ++k) {
+    Fractional* pivot_column = &dense_tail_[static_cast<size_t>(k) * size];
+    int pivot = k;
+    Fractional max_magnitude = std::abs(pivot_column[k]);
+    for (int i = k + 1; i < size; ++i) {
+      const Fractional magnitude = std::abs(pivot_column[i]);
+      if (magnitude > max_magnitude) {
+        max_magnitude = magnitude;
+        pivot = i;
+      }
+    }
+    if (max_magnitude <= singularity_threshold) {
+      // The rows and columns of the previous dense pivots are final, we report
+      // them like the sparse code does so ComputeInitialBasis() can use them.
+      for (int i = 0; i < k; ++i) {
+        (*col_perm)[dense_tail_cols_[i]] = ColIndex(*index + i);
+        (*row_perm)[dense_tail_rows_[i]] = RowIndex(*index + i);
+      }
+      const std::string error_message = absl::StrFormat(
+          "The matrix is singular! pivot = %E", max_magnitude);
+      VLOG(1) << "ERROR_LU: " << error_message;
+      return Status(Status::ERROR_LU, error_message);
+    }
+    if (pivot != k) {
+      std::swap(dense_tail_rows_[k], dense_tail_rows_[pivot]);
+      for (int j = 0; j < size; ++j) {
+        Fractional* column = &dense_tail_[static_cast<size_t>(j) * size];
+        std::swap(column[k], column[pivot]);
+      }
+    }
+
+    const Fractional inverse_pivot = 1.0 / pivot_column[k];
+    for (int i = k + 1; i < size; ++i) pivot_column[i] *= inverse_pivot;
+    for (int j = k + 1; j < size; ++j) {
+      Fractional* column = &dense_tail_[static_cast<size_t>(j) * size];
+      const Fractional multiplier = column[k];
+      if (multiplier == 0.0) continue;
+      for (int i = k + 1; i < size; ++i) {
+        column[i] -= multiplier * pivot_column[i];
+      }
+    }
+  }
+  num_fp_operations_ += 2 * static_cast<int64_t>(size) * size * size / 3;
+
+  // Append the dense columns to lower_ and upper_.
+  for (int k = 0; k < size; ++k) {
+    const Fractional* column = &dense_tail_[static_cast<size_t>(k) * size];
+    const RowIndex pivot_row = dense_tail_rows_[k];
+    const ColIndex pivot_col = dense_tail_cols_[k];
+
+    dense_tail_column_.Clear();
+    for (int i = k + 1; i < size; ++i) {
+      if (column[i] == 0.0) continue;
+      dense_tail_column_.SetCoefficient(dense_tail_rows_[i], column[i]);
+    }
+    lower_.AddTriangularColumnWithGivenDiagonalEntry(dense_tail_column_,
+                                                     pivot_row, 1.0);
+    permuted_lower_.ClearAndReleaseColumn(pivot_col);
+
+    dense_tail_column_.Clear();
+    for (const SparseColumn::Entry e : permuted_upper_.column(pivot_col)) {
+      dense_tail_column_.SetCoefficient(e.row(), e.coefficient());
+    }
+    for (int i = 0; i < k; ++i) {
+      if (column[i] == 0.0) continue;
+      dense_tail_column_.SetCoefficient(dense_tail_rows_[i], column[i]);
+    }
+    upper_.AddTriangularColumnWithGivenDiagonalEntry(dense_tail_column_,
+                                                     pivot_row, column[k]);
+    permuted_upper_.ClearAndReleaseColumn(pivot_col);
+
+    (*col_perm)[pivot_col] = ColIndex(*index);
+    (*row_perm)[pivot_row] = RowIndex(*index);
+    ++(*index);
+  }
+  return Status::OK();
+}
+
 Status Markowitz::ComputeLU(const CompactSparseMatrixView& basis_matrix,
                             RowPermutation* row_perm,
                             ColumnPermutation* col_perm,
@@ -339,11 +339,13 @@ class Markowitz {
           basis_residual_singleton_column_ratio(
               "basis_residual_singleton_column_ratio", this),
           pivots_without_fill_in_ratio("pivots_without_fill_in_ratio", this),
-          degree_two_pivot_columns("degree_two_pivot_columns", this) {}
+          degree_two_pivot_columns("degree_two_pivot_columns", this),
+          dense_tail_ratio("dense_tail_ratio", this) {}
     RatioDistribution basis_singleton_column_ratio;
     RatioDistribution basis_residual_singleton_column_ratio;
     RatioDistribution pivots_without_fill_in_ratio;
     RatioDistribution degree_two_pivot_columns;
+    RatioDistribution dense_tail_ratio;
   };
   Stats stats_;
 
@@ -412,6 +414,14 @@ class Markowitz {
   // Remove...() functions above.
   void UpdateResidualMatrix(RowIndex pivot_row, ColIndex pivot_col);
 
+  // Finishes the factorization of the current residual matrix with a dense LU
+  // with partial pivoting and appends the result to lower_ and upper_. This is
+  // used once the residual matrix is dense enough, see
+  // markowitz_dense_tail_density. The residual matrix must be square.
+  ABSL_MUST_USE_RESULT Status FactorizeDenseTail(RowPermutation* row_perm,
+                                                 ColumnPermutation* col_perm,
+                                                 int* index);
+
   // Pointer to the matrix to factorize.
   CompactSparseMatrixView const* basis_matrix_;
 
@@ -462,6 +472,17 @@ class Markowitz {
 
   // Number of floating point operations of the last factorization.
   int64_t num_fp_operations_;
+
+  // Used by FactorizeDenseTail(). The residual matrix is only converted to a
+  // dense one if its size is in [kMinDenseTailSize, kMaxDenseTailSize], this
+  // way the dense matrix uses at most 32MB.
+  static constexpr int kMinDenseTailSize = 32;
+  static constexpr int kMaxDenseTailSize = 2048;
+  std::vector<Fractional> dense_tail_;
+  std::vector<RowIndex> dense_tail_rows_;
+  std::vector<ColIndex> dense_tail_cols_;
+  StrictITIVector<RowIndex, int> row_to_dense_tail_index_;
+  SparseColumn dense_tail_column_;
 };
 
 }  // namespace glop
@@ -56,6 +56,7 @@ std::string ValidateParameters(const GlopParameters& params) {
   TEST_FINITE_AND_NON_NEGATIVE(dual_small_pivot_threshold);
   TEST_FINITE_AND_NON_NEGATIVE(dualizer_threshold);
   TEST_FINITE_AND_NON_NEGATIVE(harris_tolerance_ratio);
+  TEST_FINITE_AND_NON_NEGATIVE(interior_point_tolerance);
   TEST_FINITE_AND_NON_NEGATIVE(lu_factorization_pivot_threshold);
   TEST_FINITE_AND_NON_NEGATIVE(markowitz_singularity_threshold);
   TEST_FINITE_AND_NON_NEGATIVE(max_number_of_reoptimizations);
@@ -91,6 +92,7 @@ std::string ValidateParameters(const GlopParameters& params) {
 
   TEST_INTEGER_NON_NEGATIVE(basis_refactorization_period);
   TEST_INTEGER_NON_NEGATIVE(devex_weights_reset_period);
+  TEST_INTEGER_NON_NEGATIVE(interior_point_max_iterations);
   TEST_INTEGER_NON_NEGATIVE(num_omp_threads);
   TEST_INTEGER_NON_NEGATIVE(random_seed);
 
@@ -37,6 +37,7 @@
 #include "ortools/lp_data/lp_types.h"
 #include "ortools/lp_data/lp_utils.h"
 #include "ortools/lp_data/matrix_utils.h"
+#include "ortools/util/stats.h"
 
 namespace operations_research {
 namespace glop {
@@ -74,6 +75,7 @@ Preprocessor::~Preprocessor() {}
                        #name, time_limit_, lp)
 
 bool MainLpPreprocessor::Run(LinearProgram* lp) {
+  SCOPED_PROFILING_COUNTER("glop.Preprocess");
   RETURN_VALUE_IF_NULL(lp, false);
 
   default_logger_.EnableLogging(parameters_.log_search_progress());
@@ -201,6 +203,7 @@ void MainLpPreprocessor::RecoverSolution(ProblemSolution* solution) const {
 }
 
 void MainLpPreprocessor::DestructiveRecoverSolution(ProblemSolution* solution) {
+  SCOPED_PROFILING_COUNTER("glop.Postsolve");
   SCOPED_INSTRUCTION_COUNT(time_limit_);
   while (!preprocessors_.empty()) {
     preprocessors_.back()->RecoverSolution(solution);
@@ -498,7 +501,8 @@ bool ProportionalColumnPreprocessor::Run(LinearProgram* lp) {
   SCOPED_INSTRUCTION_COUNT(time_limit_);
   RETURN_VALUE_IF_NULL(lp, false);
   ColMapping mapping = FindProportionalColumns(
-      lp->GetSparseMatrix(), parameters_.preprocessor_zero_tolerance());
+      lp->GetSparseMatrix(), parameters_.preprocessor_zero_tolerance(),
+      parameters_.num_omp_threads());
 
   // Compute some statistics and make each class representative point to itself
   // in the mapping. Also store the columns that are proportional to at least
@@ -870,7 +874,8 @@ bool ProportionalRowPreprocessor::Run(LinearProgram* lp) {
   // itself for the loop below. TODO(user): Already return such a mapping from
   // FindProportionalColumns()?
   ColMapping mapping = FindProportionalColumns(
-      transpose, parameters_.preprocessor_zero_tolerance());
+      transpose, parameters_.preprocessor_zero_tolerance(),
+      parameters_.num_omp_threads());
   DenseBooleanColumn is_a_representative(num_rows, false);
   int num_proportional_rows = 0;
   for (RowIndex row(0); row < num_rows; ++row) {
@@ -3766,6 +3771,7 @@ void ShiftVariableBoundsPreprocessor::RecoverSolution(
 // --------------------------------------------------------
 
 bool ScalingPreprocessor::Run(LinearProgram* lp) {
+  SCOPED_PROFILING_COUNTER("glop.Scaling");
   SCOPED_INSTRUCTION_COUNT(time_limit_);
   RETURN_VALUE_IF_NULL(lp, false);
   if (!parameters_.use_scaling()) return false;
@@ -3781,6 +3787,7 @@ bool ScalingPreprocessor::Run(LinearProgram* lp) {
 
   // See the doc of these functions for more details.
   // It is important to call Scale() before the other two.
+  scaler_.set_num_threads(parameters_.num_omp_threads());
   Scale(lp, &scaler_, parameters_.scaling_method());
   cost_scaling_factor_ = lp->ScaleObjective(parameters_.cost_scaling());
   bound_scaling_factor_ = lp->ScaleBounds();
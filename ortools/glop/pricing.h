@@ -14,13 +14,21 @@
 #ifndef OR_TOOLS_GLOP_PRICING_H_
 #define OR_TOOLS_GLOP_PRICING_H_
 
+#include <algorithm>
 #include <cmath>
+#include <cstdint>
+#include <memory>
 #include <random>
 #include <string>
+#include <vector>
 
 #include "absl/log/check.h"
 #include "absl/random/bit_gen_ref.h"
 #include "absl/random/random.h"
+#include "absl/synchronization/blocking_counter.h"
+#if !defined(__PORTABLE_PLATFORM__)
+#include "ortools/base/threadpool.h"
+#endif  // __PORTABLE_PLATFORM__
 #include "ortools/lp_data/lp_types.h"
 #include "ortools/util/bitset.h"
 #include "ortools/util/stats.h"
@@ -54,6 +62,12 @@ namespace glop {
 // the first 120s of that problem was 250757 / 255659. Note that n was 282624 in
 // this case, which is not even the biggest size we can tackle.
 //
+// When the set of candidates is large and more than one thread is allowed, the
+// O(num_candidates) scan is split in contiguous shards that each compute their
+// own top-k in parallel. These are then merged in order of index, which only
+// touches O(num_shards * k) elements. The maximum value is the same, but the
+// tie-breaking can depend on the number of shards.
+//
 // Note(user): This could be moved to util/ as a general class if someone wants
 // to reuse it, it is however tuned for use in Glop pricing step and might
 // becomes even more specific in the future.
@@ -94,6 +108,10 @@ class DynamicMaximum {
   void Clear() { ClearAndResize(Index(0)); }
   Index Size() const { return values_.size(); }
 
+  // Maximum number of threads used by the full scans of GetMaximum(). This is
+  // only used when there is a really large number of candidates.
+  void SetNumThreads(int num_threads) { num_threads_ = num_threads; }
+
   // Returns some stats about this class if they are enabled.
   std::string StatString() const { return stats_.StatString(); }
 
@@ -101,6 +119,11 @@ class DynamicMaximum {
   // Adds an elements to the set of top elements.
   void UpdateTopK(Index position, Fractional value);
 
+  // Processes a candidate during a full scan of GetMaximum(): updates tops_,
+  // the current best value and position, and equivalent_choices_.
+  void ScanCandidate(Index position, Fractional value, Fractional* best_value,
+                     Index* best_position);
+
   // Returns a random element from the set {best} U {equivalent_choices_}.
   // If equivalent_choices_ is empty, this just returns best.
   Index RandomizeIfManyChoices(Index best);
@@ -143,6 +166,30 @@ class DynamicMaximum {
   Fractional threshold_;
   std::vector<HeapElement> tops_;
 
+  // Returns the number of shards to use for a full scan.
+  int NumScanShards() const;
+
+  // Fills shard_tops_[shard] with the top-k candidates of each shard, sorted by
+  // index. Ties are broken towards the smallest index so that this does not
+  // depend on the thread scheduling.
+  void ComputeShardTopsInParallel(int num_shards);
+  void ComputeShardTops(int64_t begin_word, int64_t end_word,
+                        std::vector<HeapElement>* shard_tops) const;
+
+  // The size of tops_ once it is full.
+  static constexpr int kTopSize = 31;
+
+  // Below this number of candidates per shard, it is not worth scanning in
+  // parallel.
+  static constexpr int64_t kMinCandidatesPerShard = 1 << 17;
+
+  int num_threads_ = 1;
+  std::vector<std::vector<HeapElement>> shard_tops_;
+#if !defined(__PORTABLE_PLATFORM__)
+  int thread_pool_num_workers_ = 0;
+  std::unique_ptr<ThreadPool> thread_pool_;
+#endif  // __PORTABLE_PLATFORM__
+
   // Statistics about the class.
   struct QueryStats : public StatsGroup {
     QueryStats()
@@ -248,27 +295,124 @@ inline Index DynamicMaximum<Index>::GetMaximum() {
   // We need to iterate over all the candidates.
   threshold_ = -kInfinity;
   DCHECK(tops_.empty());
+  const int num_shards = NumScanShards();
+  if (num_shards > 1) {
+    // All the candidates that are not in the shard tops are dominated by k
+    // elements of their shard, so they would not end up in tops_ anyway.
+    ComputeShardTopsInParallel(num_shards);
+    for (int shard = 0; shard < num_shards; ++shard) {
+      for (const HeapElement e : shard_tops_[shard]) {
+        ScanCandidate(e.index, e.value, &best_value, &best_position);
+      }
+    }
+    return RandomizeIfManyChoices(best_position);
+  }
+
   const auto values = values_.const_view();
   for (const Index position : is_candidate_) {
-    const Fractional value = values[position];
+    ScanCandidate(position, values[position], &best_value, &best_position);
+  }
 
-    // TODO(user): Add a mode when we do not maintain the TopK for small sizes
-    // (like n < 1000) ? The gain might not be worth the extra code though.
-    if (value < threshold_) continue;
-    UpdateTopK(position, value);
+  return RandomizeIfManyChoices(best_position);
+}
 
-    if (value >= best_value) {
-      if (value == best_value) {
-        equivalent_choices_.push_back(position);
-        continue;
+template <typename Index>
+inline void DynamicMaximum<Index>::ScanCandidate(Index position,
+                                                 Fractional value,
+                                                 Fractional* best_value,
+                                                 Index* best_position) {
+  // TODO(user): Add a mode when we do not maintain the TopK for small sizes
+  // (like n < 1000) ? The gain might not be worth the extra code though.
+  if (value < threshold_) return;
+  UpdateTopK(position, value);
+
+  if (value >= *best_value) {
+    if (value == *best_value) {
+      equivalent_choices_.push_back(position);
+      return;
+    }
+    equivalent_choices_.clear();
+    *best_value = value;
+    *best_position = position;
+  }
+}
+
+template <typename Index>
+inline int DynamicMaximum<Index>::NumScanShards() const {
+#if defined(__PORTABLE_PLATFORM__)
+  return 1;
+#else
+  const int64_t size = values_.size().value();
+  if (num_threads_ <= 1 || size < kMinCandidatesPerShard * 2) return 1;
+  return static_cast<int>(
+      std::min<int64_t>(num_threads_, size / kMinCandidatesPerShard));
+#endif  // __PORTABLE_PLATFORM__
+}
+
+template <typename Index>
+void DynamicMaximum<Index>::ComputeShardTopsInParallel(int num_shards) {
+#if !defined(__PORTABLE_PLATFORM__)
+  if (thread_pool_ == nullptr || thread_pool_num_workers_ != num_shards - 1) {
+    thread_pool_num_workers_ = num_shards - 1;
+    thread_pool_ = std::make_unique<ThreadPool>("DynamicMaximum",
+                                                thread_pool_num_workers_);
+    thread_pool_->StartWorkers();
+  }
+  shard_tops_.resize(num_shards);
+
+  // The shards are aligned on the 64-bit words of is_candidate_.
+  const int64_t num_words = (values_.size().value() + 63) / 64;
+  const auto shard_begin = [num_words, num_shards](int shard) {
+    return num_words * shard / num_shards;
+  };
+
+  // The calling thread processes the first shard.
+  absl::BlockingCounter counter(num_shards - 1);
+  for (int shard = 1; shard < num_shards; ++shard) {
+    thread_pool_->Schedule([this, &counter, &shard_begin, shard]() {
+      ComputeShardTops(shard_begin(shard), shard_begin(shard + 1),
+                       &shard_tops_[shard]);
+      counter.DecrementCount();
+    });
+  }
+  ComputeShardTops(0, shard_begin(1), &shard_tops_[0]);
+  counter.Wait();
+#endif  // __PORTABLE_PLATFORM__
+}
+
+template <typename Index>
+void DynamicMaximum<Index>::ComputeShardTops(
+    int64_t begin_word, int64_t end_word,
+    std::vector<HeapElement>* shard_tops) const {
+  // A min-heap where the smallest index is preferred among equal values.
+  const auto is_better = [](const HeapElement& a, const HeapElement& b) {
+    return a.value > b.value || (a.value == b.value && a.index < b.index);
+  };
+  shard_tops->clear();
+  const uint64_t* const words = is_candidate_.const_view().data();
+  const auto values = values_.const_view();
+  for (int64_t w = begin_word; w < end_word; ++w) {
+    uint64_t word = words[w];
+    while (word != 0) {
+      const Index position(w * 64 + LeastSignificantBitPosition64(word));
+      word &= word - 1;
+      const HeapElement e(position, values[position]);
+      if (shard_tops->size() < kTopSize) {
+        shard_tops->push_back(e);
+        std::push_heap(shard_tops->begin(), shard_tops->end(), is_better);
+      } else if (is_better(e, shard_tops->front())) {
+        std::pop_heap(shard_tops->begin(), shard_tops->end(), is_better);
+        shard_tops->back() = e;
+        std::push_heap(shard_tops->begin(), shard_tops->end(), is_better);
       }
-      equivalent_choices_.clear();
-      best_value = value;
-      best_position = position;
     }
   }
 
-  return RandomizeIfManyChoices(best_position);
+  // The merge must see the candidates in the same order as a sequential scan.
+  std::sort(shard_tops->begin(), shard_tops->end(),
+            [](const HeapElement& a, const HeapElement& b) {
+              return a.index < b.index;
+            });
 }
 
 template <typename Index>
@@ -281,7 +425,7 @@ inline void DynamicMaximum<Index>::UpdateTopK(Index position,
   //
   // TODO(user): Adapt the size depending on the problem size? Note sure it is
   // worth it. To experiment more.
-  constexpr int k = 31;
+  constexpr int k = kTopSize;
   static_assert(((k + 1) & k) == 0, "k + 1 should be a power of 2.");
 
   // Simply grow the vector until we hit a size of k.
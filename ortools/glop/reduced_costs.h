@@ -325,6 +325,9 @@ class PrimalPrices {
   // GetBestEnteringColumn() is called.
   void ForceRecomputation() { recompute_ = true; }
 
+  // Maximum number of threads used to scan all the prices at once.
+  void SetNumThreads(int num_threads) { prices_.SetNumThreads(num_threads); }
+
  private:
   // Recomputes the primal prices but only for the given column indices. If
   // from_clean_state is true, then we assume that there is currently no
@@ -2532,6 +2532,7 @@ Status RevisedSimplex::UpdateAndPivot(ColIndex entering_col,
                                       RowIndex leaving_row,
                                       Fractional target_bound) {
   SCOPED_TIME_STAT(&function_stats_);
+  SCOPED_PROFILING_COUNTER("glop.UpdateAndPivot");
 
   // Tricky and a bit hacky.
   //
@@ -3638,6 +3639,8 @@ void RevisedSimplex::PropagateParameters() {
   dual_edge_norms_.SetParameters(parameters_);
   primal_edge_norms_.SetParameters(parameters_);
   update_row_.SetParameters(parameters_);
+  dual_prices_.SetNumThreads(parameters_.num_omp_threads());
+  primal_prices_.SetNumThreads(parameters_.num_omp_threads());
 }
 
 void RevisedSimplex::DisplayIterationInfo(bool primal,
@@ -3923,7 +3926,7 @@ void RevisedSimplex::AdvanceDeterministicTime(TimeLimit* time_limit) {
   const double current_deterministic_time = DeterministicTime();
   const double deterministic_time_delta =
       current_deterministic_time - last_deterministic_time_update_;
-  time_limit->AdvanceDeterministicTime(deterministic_time_delta);
+  time_limit->AdvanceDeterministicTime(deterministic_time_delta, "glop");
   last_deterministic_time_update_ = current_deterministic_time;
 }
 
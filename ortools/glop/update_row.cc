@@ -13,10 +13,13 @@
 
 #include "ortools/glop/update_row.h"
 
+#include <algorithm>
 #include <cstdlib>
+#include <memory>
 #include <string>
 
 #include "absl/log/check.h"
+#include "absl/synchronization/blocking_counter.h"
 #include "absl/types/span.h"
 #include "ortools/base/logging.h"
 #include "ortools/glop/basis_representation.h"
@@ -28,6 +31,10 @@
 #include "ortools/lp_data/sparse.h"
 #include "ortools/util/stats.h"
 
+#if !defined(__PORTABLE_PLATFORM__)
+#include "ortools/base/threadpool.h"
+#endif  // __PORTABLE_PLATFORM__
+
 namespace operations_research {
 namespace glop {
 
@@ -49,6 +56,8 @@ UpdateRow::UpdateRow(const CompactSparseMatrix& matrix,
       parameters_(),
       stats_() {}
 
+UpdateRow::~UpdateRow() = default;
+
 void UpdateRow::Invalidate() {
   SCOPED_TIME_STAT(&stats_);
   left_inverse_computed_for_ = kInvalidRow;
@@ -301,13 +310,29 @@ void UpdateRow::ComputeUpdatesColumnWise() {
 
   coefficient_.resize(matrix_.num_cols(), 0.0);
   non_zero_position_list_.resize(matrix_.num_cols().value());
-  auto* non_zeros = non_zero_position_list_.data();
 
+  const int num_shards = NumColumnWiseShards();
+  if (num_shards > 1) {
+    ComputeUpdatesColumnWiseInParallel(num_shards);
+    return;
+  }
+  num_non_zeros_ =
+      ComputeUpdatesColumnWiseInRange(ColIndex(0), matrix_.num_cols(),
+                                      non_zero_position_list_.data()) -
+      non_zero_position_list_.data();
+}
+
+ColIndex* UpdateRow::ComputeUpdatesColumnWiseInRange(ColIndex begin,
+                                                     ColIndex end,
+                                                     ColIndex* non_zeros) {
   const Fractional drop_tolerance = parameters_.drop_tolerance();
   const auto output_coeffs = coefficient_.view();
   const auto view = matrix_.view();
   const auto unit_row_left_inverse = unit_row_left_inverse_.values.const_view();
-  for (const ColIndex col : variables_info_.GetIsRelevantBitRow()) {
+  const DenseBitRow& is_relevant = variables_info_.GetIsRelevantBitRow();
+  for (ColIndex col(begin); col < end; ++col) {
+    if (!is_relevant.IsSet(col)) continue;
+
     // Coefficient of the column right inverse on the 'leaving_row'.
     const Fractional coeff =
         view.ColumnScalarProduct(col, unit_row_left_inverse);
@@ -321,7 +346,73 @@ void UpdateRow::ComputeUpdatesColumnWise() {
       output_coeffs[col] = coeff;
     }
   }
-  num_non_zeros_ = non_zeros - non_zero_position_list_.data();
+  return non_zeros;
+}
+
+int UpdateRow::NumColumnWiseShards() const {
+#if defined(__PORTABLE_PLATFORM__)
+  return 1;
+#else
+  const int num_threads = parameters_.num_omp_threads();
+  if (num_threads <= 1) return 1;
+
+  // Below this size, the cost of waking up the workers dominates.
+  const int64_t num_entries =
+      variables_info_.GetNumEntriesInRelevantColumns().value();
+  if (num_entries < kMinEntriesPerShard * 2) return 1;
+  return static_cast<int>(std::min<int64_t>(
+      num_threads, std::min<int64_t>(num_entries / kMinEntriesPerShard,
+                                     matrix_.num_cols().value())));
+#endif  // __PORTABLE_PLATFORM__
+}
+
+// Each shard works on a contiguous range of columns and writes its non-zero
+// positions at the beginning of its own range in non_zero_position_list_. The
+// shards are then compacted in order, which gives exactly the same result as
+// the sequential version, whatever the number of threads.
+void UpdateRow::ComputeUpdatesColumnWiseInParallel(int num_shards) {
+#if defined(__PORTABLE_PLATFORM__)
+  LOG(FATAL) << "Not supported on this platform.";
+#else
+  if (thread_pool_ == nullptr || thread_pool_num_workers_ != num_shards - 1) {
+    thread_pool_.reset();
+    thread_pool_num_workers_ = num_shards - 1;
+    if (thread_pool_num_workers_ > 0) {
+      thread_pool_ =
+          std::make_unique<ThreadPool>("UpdateRow", thread_pool_num_workers_);
+      thread_pool_->StartWorkers();
+    }
+  }
+
+  const ColIndex num_cols = matrix_.num_cols();
+  shard_ends_.resize(num_shards);
+  ColIndex* const list = non_zero_position_list_.data();
+  const auto shard_begin = [num_cols, num_shards](int shard) {
+    return ColIndex(num_cols.value() * static_cast<int64_t>(shard) /
+                    num_shards);
+  };
+
+  // The calling thread processes the first shard.
+  absl::BlockingCounter counter(num_shards - 1);
+  for (int shard = 1; shard < num_shards; ++shard) {
+    thread_pool_->Schedule([this, &counter, &shard_begin, list, shard]() {
+      const ColIndex begin = shard_begin(shard);
+      shard_ends_[shard] = ComputeUpdatesColumnWiseInRange(
+          begin, shard_begin(shard + 1), list + begin.value());
+      counter.DecrementCount();
+    });
+  }
+  shard_ends_[0] =
+      ComputeUpdatesColumnWiseInRange(ColIndex(0), shard_begin(1), list);
+  counter.Wait();
+
+  ColIndex* non_zeros = shard_ends_[0];
+  for (int shard = 1; shard < num_shards; ++shard) {
+    ColIndex* const begin = list + shard_begin(shard).value();
+    non_zeros = std::copy(begin, shard_ends_[shard], non_zeros);
+  }
+  num_non_zeros_ = non_zeros - list;
+#endif  // __PORTABLE_PLATFORM__
 }
 
 // Note that we use the same algo as ComputeUpdatesColumnWise() here. The
@@ -15,6 +15,7 @@
 #define OR_TOOLS_GLOP_UPDATE_ROW_H_
 
 #include <cstdint>
+#include <memory>
 #include <string>
 #include <vector>
 
@@ -28,6 +29,8 @@
 #include "ortools/util/stats.h"
 
 namespace operations_research {
+class ThreadPool;
+
 namespace glop {
 
 // During a simplex iteration, when the basis 'leaving_row' has been
@@ -48,6 +51,7 @@ class UpdateRow {
             const CompactSparseMatrix& transposed_matrix,
             const VariablesInfo& variables_info, const RowToColMapping& basis,
             const BasisFactorization& basis_factorization);
+  ~UpdateRow();
 
   // This type is neither copyable nor movable.
   UpdateRow(const UpdateRow&) = delete;
@@ -123,6 +127,17 @@ class UpdateRow {
   void ComputeUpdatesColumnWise();
   void ComputeUpdatesForSingleRow(ColIndex row_as_col);
 
+  // Column-wise computation restricted to the relevant columns in [begin,
+  // end). The non-zero positions are written starting at 'non_zeros' and the
+  // pointer past the last written position is returned.
+  ColIndex* ComputeUpdatesColumnWiseInRange(ColIndex begin, ColIndex end,
+                                            ColIndex* non_zeros);
+
+  // Returns the number of shards ComputeUpdatesColumnWise() should use, this
+  // is 1 unless num_omp_threads > 1 and the problem is large enough.
+  int NumColumnWiseShards() const;
+  void ComputeUpdatesColumnWiseInParallel(int num_shards);
+
   // Problem data that should be updated from outside.
   const CompactSparseMatrix& matrix_;
   const CompactSparseMatrix& transposed_matrix_;
@@ -169,6 +184,15 @@ class UpdateRow {
   // Glop standard classes.
   GlopParameters parameters_;
   Stats stats_;
+
+  // Used by ComputeUpdatesColumnWiseInParallel(). The pool is created lazily
+  // and kept across calls since this is called at each simplex iteration.
+  static constexpr int64_t kMinEntriesPerShard = 50000;
+  std::vector<ColIndex*> shard_ends_;
+#if !defined(__PORTABLE_PLATFORM__)
+  int thread_pool_num_workers_ = 0;
+  std::unique_ptr<ThreadPool> thread_pool_;
+#endif  // __PORTABLE_PLATFORM__
 };
 
 }  // namespace glop
@@ -15,8 +15,10 @@
 
 #include <algorithm>
 #include <limits>
+#include <memory>
 
 #include "absl/flags/flag.h"
+#include "absl/log/check.h"
 #include "ortools/graph/ebert_graph.h"
 #include "ortools/graph/linear_assignment.h"
 
@@ -24,6 +26,8 @@ namespace operations_research {
 
 SimpleLinearSumAssignment::SimpleLinearSumAssignment() : num_nodes_(0) {}
 
+SimpleLinearSumAssignment::~SimpleLinearSumAssignment() = default;
+
 ArcIndex SimpleLinearSumAssignment::AddArcWithCost(NodeIndex left_node,
                                                    NodeIndex right_node,
                                                    CostValue cost) {
@@ -36,6 +40,16 @@ ArcIndex SimpleLinearSumAssignment::AddArcWithCost(NodeIndex left_node,
   return num_arcs;
 }
 
+void SimpleLinearSumAssignment::SetArcCost(ArcIndex arc, CostValue cost) {
+  arc_cost_[arc] = cost;
+  if (assignment_ != nullptr) assignment_->SetArcCost(arc, cost);
+}
+
+void SimpleLinearSumAssignment::SetNumThreads(int num_threads) {
+  CHECK_GE(num_threads, 1);
+  num_threads_ = num_threads;
+}
+
 NodeIndex SimpleLinearSumAssignment::NumNodes() const { return num_nodes_; }
 
 ArcIndex SimpleLinearSumAssignment::NumArcs() const { return arc_cost_.size(); }
@@ -55,30 +69,72 @@ CostValue SimpleLinearSumAssignment::Cost(ArcIndex arc) const {
 SimpleLinearSumAssignment::Status SimpleLinearSumAssignment::Solve() {
   optimal_cost_ = 0;
   assignment_arcs_.clear();
+  assignment_.reset();
+  graph_.reset();
   if (NumNodes() == 0) return OPTIMAL;
+  if (HasPossibleOverflow()) return POSSIBLE_OVERFLOW;
+
+  const ArcIndex num_arcs = arc_cost_.size();
+  graph_ = std::make_unique<ForwardStarGraph>(2 * num_nodes_, num_arcs);
+  assignment_ = std::make_unique<LinearSumAssignment<ForwardStarGraph>>(
+      *graph_, num_nodes_);
+  for (ArcIndex arc = 0; arc < num_arcs; ++arc) {
+    graph_->AddArc(arc_tail_[arc], num_nodes_ + arc_head_[arc]);
+    assignment_->SetArcCost(arc, arc_cost_[arc]);
+  }
+  assignment_->SetNumThreads(num_threads_);
+  // TODO(user): Improve the LinearSumAssignment api to clearly define
+  // the error cases.
+  Status status = OPTIMAL;
+  if (!assignment_->FinalizeSetup()) {
+    status = POSSIBLE_OVERFLOW;
+  } else if (!assignment_->ComputeAssignment()) {
+    status = INFEASIBLE;
+  }
+  return RecordSolution(status);
+}
+
+SimpleLinearSumAssignment::Status
+SimpleLinearSumAssignment::SolveFromLastSolution() {
+  if (assignment_ == nullptr || graph_->num_arcs() != NumArcs() ||
+      assignment_->NumLeftNodes() != num_nodes_) {
+    return Solve();
+  }
+  optimal_cost_ = 0;
+  assignment_arcs_.clear();
+  if (HasPossibleOverflow()) {
+    assignment_.reset();
+    graph_.reset();
+    return POSSIBLE_OVERFLOW;
+  }
+  assignment_->SetNumThreads(num_threads_);
+  return RecordSolution(assignment_->ComputeAssignmentFromCurrentSolution()
+                            ? OPTIMAL
+                            : INFEASIBLE);
+}
+
+bool SimpleLinearSumAssignment::HasPossibleOverflow() const {
   // HACK(user): Detect overflows early. In ./linear_assignment.h, the cost of
   // each arc is internally multiplied by cost_scaling_factor_ (which is equal
   // to (num_nodes + 1)) without overflow checking.
   const CostValue max_supported_arc_cost =
       std::numeric_limits<CostValue>::max() / (NumNodes() + 1);
   for (const CostValue unscaled_arc_cost : arc_cost_) {
-    if (unscaled_arc_cost > max_supported_arc_cost) return POSSIBLE_OVERFLOW;
+    if (unscaled_arc_cost > max_supported_arc_cost) return true;
   }
+  return false;
+}
 
-  const ArcIndex num_arcs = arc_cost_.size();
-  ForwardStarGraph graph(2 * num_nodes_, num_arcs);
-  LinearSumAssignment<ForwardStarGraph> assignment(graph, num_nodes_);
-  for (ArcIndex arc = 0; arc < num_arcs; ++arc) {
-    graph.AddArc(arc_tail_[arc], num_nodes_ + arc_head_[arc]);
-    assignment.SetArcCost(arc, arc_cost_[arc]);
+SimpleLinearSumAssignment::Status SimpleLinearSumAssignment::RecordSolution(
+    Status status) {
+  if (status != OPTIMAL) {
+    assignment_.reset();
+    graph_.reset();
+    return status;
   }
-  // TODO(user): Improve the LinearSumAssignment api to clearly define
-  // the error cases.
-  if (!assignment.FinalizeSetup()) return POSSIBLE_OVERFLOW;
-  if (!assignment.ComputeAssignment()) return INFEASIBLE;
-  optimal_cost_ = assignment.GetCost();
+  optimal_cost_ = assignment_->GetCost();
   for (NodeIndex node = 0; node < num_nodes_; ++node) {
-    assignment_arcs_.push_back(assignment.GetAssignmentArc(node));
+    assignment_arcs_.push_back(assignment_->GetAssignmentArc(node));
   }
   return OPTIMAL;
 }
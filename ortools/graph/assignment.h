@@ -44,21 +44,30 @@
 // } else {
 //   printf("There is an issue with the input or no perfect matching exists.");
 // }
+//
+// After a Solve(), the costs can be modified with SetArcCost() and the problem
+// re-solved from the last solution with SolveFromLastSolution(), which is
+// faster when the optimal assignment changes little.
 
 #ifndef OR_TOOLS_GRAPH_ASSIGNMENT_H_
 #define OR_TOOLS_GRAPH_ASSIGNMENT_H_
 
+#include <memory>
 #include <vector>
 
 #include "ortools/graph/ebert_graph.h"
 
 namespace operations_research {
 
+template <typename GraphType>
+class LinearSumAssignment;
+
 class SimpleLinearSumAssignment {
  public:
   // The constructor takes no size.
   // New node indices will be created lazily by AddArcWithCost().
   SimpleLinearSumAssignment();
+  ~SimpleLinearSumAssignment();
 
 #ifndef SWIG
   // This type is neither copyable nor movable.
@@ -76,6 +85,14 @@ class SimpleLinearSumAssignment {
   ArcIndex AddArcWithCost(NodeIndex left_node, NodeIndex right_node,
                           CostValue cost);
 
+  // Modifies the cost of an existing arc.
+  void SetArcCost(ArcIndex arc, CostValue cost);
+
+  // Sets the number of threads used by Solve() and SolveFromLastSolution().
+  // Defaults to 1. More threads only help on large problems where the nodes
+  // have many arcs, e.g. dense ones.
+  void SetNumThreads(int num_threads);
+
   // Returns the current number of left nodes which is the same as the
   // number of right nodes. This is one greater than the largest node
   // index seen so far in AddArcWithCost().
@@ -99,6 +116,12 @@ class SimpleLinearSumAssignment {
   };
   Status Solve();
 
+  // Same as Solve(), but starts from the prices and the assignment of the last
+  // solve that returned OPTIMAL, so that it is much faster when only a few
+  // costs changed since then, with SetArcCost(). Falls back to Solve() if there
+  // is no such solve, or if arcs were added since.
+  Status SolveFromLastSolution();
+
   // Returns the cost of an assignment with minimal cost.
   // This is 0 if the last Solve() didn't return OPTIMAL.
   CostValue OptimalCost() const { return optimal_cost_; }
@@ -123,12 +146,25 @@ class SimpleLinearSumAssignment {
   }
 
  private:
+  // Returns true if an arc cost is too large for the scaling done by
+  // LinearSumAssignment.
+  bool HasPossibleOverflow() const;
+  // Fills optimal_cost_ and assignment_arcs_ if status is OPTIMAL, and
+  // discards the solver otherwise. Returns status.
+  Status RecordSolution(Status status);
+
   NodeIndex num_nodes_;
   std::vector<NodeIndex> arc_tail_;
   std::vector<NodeIndex> arc_head_;
   std::vector<CostValue> arc_cost_;
   std::vector<ArcIndex> assignment_arcs_;
   CostValue optimal_cost_;
+  int num_threads_ = 1;
+
+  // The graph and the solver of the last solve that returned OPTIMAL, kept
+  // for SolveFromLastSolution().
+  std::unique_ptr<ForwardStarGraph> graph_;
+  std::unique_ptr<LinearSumAssignment<ForwardStarGraph>> assignment_;
 };
 
 }  // namespace operations_research
@@ -77,4 +77,51 @@ TEST(SimpleLinearSumAssignmentTest, Overflow) {
   EXPECT_EQ(0, assignment.OptimalCost());
 }
 
+TEST(SimpleLinearSumAssignmentTest, SolveFromLastSolution) {
+  SimpleLinearSumAssignment assignment;
+  assignment.AddArcWithCost(0, 0, 0);
+  assignment.AddArcWithCost(0, 1, 2);
+  assignment.AddArcWithCost(1, 0, 3);
+  const ArcIndex arc = assignment.AddArcWithCost(1, 1, 4);
+  EXPECT_EQ(SimpleLinearSumAssignment::OPTIMAL,
+            assignment.SolveFromLastSolution());
+  EXPECT_EQ(4, assignment.OptimalCost());
+  assignment.SetArcCost(arc, 10);
+  EXPECT_EQ(SimpleLinearSumAssignment::OPTIMAL,
+            assignment.SolveFromLastSolution());
+  EXPECT_EQ(5, assignment.OptimalCost());
+  EXPECT_EQ(1, assignment.RightMate(0));
+  EXPECT_EQ(2, assignment.AssignmentCost(0));
+  EXPECT_EQ(0, assignment.RightMate(1));
+  EXPECT_EQ(10, assignment.Cost(arc));
+  // Adding an arc falls back to Solve().
+  assignment.AddArcWithCost(1, 1, -1);
+  EXPECT_EQ(SimpleLinearSumAssignment::OPTIMAL,
+            assignment.SolveFromLastSolution());
+  EXPECT_EQ(-1, assignment.OptimalCost());
+}
+
+TEST(SimpleLinearSumAssignmentTest, MultipleThreads) {
+  const int n = 300;
+  SimpleLinearSumAssignment sequential;
+  SimpleLinearSumAssignment parallel;
+  parallel.SetNumThreads(4);
+  for (int left = 0; left < n; ++left) {
+    for (int right = 0; right < n; ++right) {
+      const CostValue cost = (left * 7919 + right * 104729) % 1000;
+      sequential.AddArcWithCost(left, right, cost);
+      parallel.AddArcWithCost(left, right, cost);
+    }
+  }
+  ASSERT_EQ(SimpleLinearSumAssignment::OPTIMAL, sequential.Solve());
+  ASSERT_EQ(SimpleLinearSumAssignment::OPTIMAL, parallel.Solve());
+  EXPECT_EQ(sequential.OptimalCost(), parallel.OptimalCost());
+  parallel.SetArcCost(0, 1000);
+  sequential.SetArcCost(0, 1000);
+  ASSERT_EQ(SimpleLinearSumAssignment::OPTIMAL, sequential.Solve());
+  ASSERT_EQ(SimpleLinearSumAssignment::OPTIMAL,
+            parallel.SolveFromLastSolution());
+  EXPECT_EQ(sequential.OptimalCost(), parallel.OptimalCost());
+}
+
 }  // namespace operations_research
@@ -15,14 +15,19 @@
 #define OR_TOOLS_GRAPH_BOUNDED_DIJKSTRA_H_
 
 #include <algorithm>
+#include <array>
+#include <cstdint>
 #include <functional>
 #include <limits>
+#include <tuple>
+#include <type_traits>
 #include <utility>
 #include <vector>
 
 #include "absl/algorithm/container.h"
 #include "absl/base/attributes.h"
 #include "absl/log/check.h"
+#include "absl/numeric/bits.h"
 #include "absl/types/span.h"
 #include "ortools/base/iterator_adaptors.h"
 #include "ortools/base/top_n.h"
@@ -70,6 +75,104 @@ class ElementGetter {
   const std::vector<T>& c_;
 };
 
+// The priority queues that BoundedDijkstraWrapper can use, chosen with its
+// last template parameter. They all support:
+//   bool empty() const;
+//   void clear();
+//   void Push(int node, DistanceType distance);
+//   std::pair<int, DistanceType> Pop();  // Removes an element of min distance.
+
+// The default: a binary heap, O(log(size)) per operation. Elements of equal
+// distance are popped by increasing node.
+template <typename DistanceType>
+class BinaryHeapDijkstraQueue {
+ public:
+  bool empty() const { return heap_.empty(); }
+  void clear() { heap_.clear(); }
+  void Push(int node, DistanceType distance) {
+    heap_.push_back({distance, node});
+    std::push_heap(heap_.begin(), heap_.end(), std::greater<Element>());
+  }
+  std::pair<int, DistanceType> Pop() {
+    std::pop_heap(heap_.begin(), heap_.end(), std::greater<Element>());
+    const Element top = heap_.back();
+    heap_.pop_back();
+    return {top.second, top.first};
+  }
+
+ private:
+  using Element = std::pair<DistanceType, int>;
+  std::vector<Element> heap_;
+};
+
+// A radix heap, for integer distances only. It relies on the fact that a
+// Dijkstra never pushes a distance smaller than the last one popped: elements
+// are kept in one bucket per bit position of (distance XOR last popped
+// distance), and each element moves to a strictly lower bucket at most once
+// per bit, so Push() is O(1) and Pop() is amortized O(log(C)), where C is the
+// largest arc length. When arc lengths are small integers this is a lot
+// faster than the binary heap. Elements of equal distance are popped in no
+// particular order, so the shortest path trees may differ from the ones found
+// with the default queue (not the distances).
+template <typename DistanceType>
+class RadixHeapDijkstraQueue {
+  static_assert(std::is_integral_v<DistanceType>,
+                "RadixHeapDijkstraQueue only supports integer distances");
+
+ public:
+  bool empty() const { return size_ == 0; }
+  void clear() {
+    for (std::vector<Element>& bucket : buckets_) bucket.clear();
+    size_ = 0;
+    last_key_ = 0;
+  }
+  void Push(int node, DistanceType distance) {
+    const Key key = ToKey(distance);
+    // A new Dijkstra run can start from any distance.
+    if (size_ == 0) last_key_ = 0;
+    DCHECK_GE(key, last_key_) << "Non-monotone push in a radix heap.";
+    buckets_[BucketIndex(key)].push_back({key, node});
+    ++size_;
+  }
+  std::pair<int, DistanceType> Pop() {
+    DCHECK(!empty());
+    if (buckets_[0].empty()) {
+      // Redistributes the first non-empty bucket around its min key.
+      int b = 1;
+      while (buckets_[b].empty()) ++b;
+      std::vector<Element>& bucket = buckets_[b];
+      last_key_ = std::min_element(bucket.begin(), bucket.end())->first;
+      for (const Element& element : bucket) {
+        buckets_[BucketIndex(element.first)].push_back(element);
+      }
+      bucket.clear();
+    }
+    const Element top = buckets_[0].back();
+    buckets_[0].pop_back();
+    --size_;
+    return {top.second, FromKey(top.first)};
+  }
+
+ private:
+  // Distances are mapped to unsigned keys with the same order, so that
+  // negative source offsets are supported.
+  using Key = std::make_unsigned_t<DistanceType>;
+  using Element = std::pair<Key, int>;
+  static constexpr Key kSignBit =
+      std::is_signed_v<DistanceType> ? Key{1} << (8 * sizeof(Key) - 1) : 0;
+  static Key ToKey(DistanceType distance) {
+    return static_cast<Key>(distance) ^ kSignBit;
+  }
+  static DistanceType FromKey(Key key) {
+    return static_cast<DistanceType>(key ^ kSignBit);
+  }
+  int BucketIndex(Key key) const { return absl::bit_width(key ^ last_key_); }
+
+  std::array<std::vector<Element>, 8 * sizeof(Key) + 1> buckets_;
+  int64_t size_ = 0;
+  Key last_key_ = 0;
+};
+
 // A wrapper that holds the memory needed to run many bounded shortest path
 // computations on the given graph. The graph must implement the
 // interface described in graph.h (without the need for reverse arcs).
@@ -91,8 +194,13 @@ class ElementGetter {
 // that (distance_limit + destination_offset) do not overflow. Note that with
 // negative source_offset, arc with a length greater than the distance_limit can
 // still be considered!
+//
+// The priority queue of the Dijkstra can be changed with the last template
+// parameter, e.g. to RadixHeapDijkstraQueue<DistanceType> for integer arc
+// lengths, see above.
 template <class GraphType, class DistanceType,
-          class ArcLengthFunctor = ElementGetter<DistanceType>>
+          class ArcLengthFunctor = ElementGetter<DistanceType>,
+          class PriorityQueue = BinaryHeapDijkstraQueue<DistanceType>>
 class BoundedDijkstraWrapper {
  public:
   typedef typename GraphType::NodeIndex node_type;
@@ -296,7 +404,7 @@ class BoundedDijkstraWrapper {
     }
     bool operator>(const NodeDistance& other) const { return other < *this; }
   };
-  std::vector<NodeDistance> queue_;
+  PriorityQueue queue_;
 
   // These are used by some of the Run...() variants, and are kept as data
   // members to avoid reallocation upon multiple calls.
@@ -311,8 +419,10 @@ class BoundedDijkstraWrapper {
 // Implementation.
 // -----------------------------------------------------------------------------
 
-template <class GraphType, class DistanceType, class ArcLengthFunctor>
-BoundedDijkstraWrapper<GraphType, DistanceType, ArcLengthFunctor>::
+template <class GraphType, class DistanceType, class ArcLengthFunctor,
+          class PriorityQueue>
+BoundedDijkstraWrapper<GraphType, DistanceType, ArcLengthFunctor,
+                       PriorityQueue>::
     BoundedDijkstraWrapper(const GraphType* graph,
                            const std::vector<DistanceType>* arc_lengths)
     : graph_(graph),
@@ -325,24 +435,30 @@ BoundedDijkstraWrapper<GraphType, DistanceType, ArcLengthFunctor>::
   }
 }
 
-template <class GraphType, class DistanceType, class ArcLengthFunctor>
-BoundedDijkstraWrapper<GraphType, DistanceType, ArcLengthFunctor>::
+template <class GraphType, class DistanceType, class ArcLengthFunctor,
+          class PriorityQueue>
+BoundedDijkstraWrapper<GraphType, DistanceType, ArcLengthFunctor,
+                       PriorityQueue>::
     BoundedDijkstraWrapper(const GraphType* graph,
                            ArcLengthFunctor arc_length_functor)
     : graph_(graph),
       arc_length_functor_(std::move(arc_length_functor)),
       arc_lengths_(nullptr) {}
 
-template <class GraphType, class DistanceType, class ArcLengthFunctor>
-BoundedDijkstraWrapper<GraphType, DistanceType, ArcLengthFunctor>::
+template <class GraphType, class DistanceType, class ArcLengthFunctor,
+          class PriorityQueue>
+BoundedDijkstraWrapper<GraphType, DistanceType, ArcLengthFunctor,
+                       PriorityQueue>::
     BoundedDijkstraWrapper(const BoundedDijkstraWrapper& other)
     : graph_(other.graph_),
       arc_length_functor_(other.arc_length_functor_),
       arc_lengths_(other.arc_lengths_) {}
 
-template <class GraphType, class DistanceType, class ArcLengthFunctor>
+template <class GraphType, class DistanceType, class ArcLengthFunctor,
+          class PriorityQueue>
 const std::vector<int>&
-BoundedDijkstraWrapper<GraphType, DistanceType, ArcLengthFunctor>::
+BoundedDijkstraWrapper<GraphType, DistanceType, ArcLengthFunctor,
+                       PriorityQueue>::
     RunBoundedDijkstraFromMultipleSources(
         const std::vector<std::pair<int, DistanceType>>&
             sources_with_distance_offsets,
@@ -351,9 +467,11 @@ BoundedDijkstraWrapper<GraphType, DistanceType, ArcLengthFunctor>::
       sources_with_distance_offsets, nullptr, distance_limit);
 }
 
-template <class GraphType, class DistanceType, class ArcLengthFunctor>
+template <class GraphType, class DistanceType, class ArcLengthFunctor,
+          class PriorityQueue>
 std::vector<int>
-BoundedDijkstraWrapper<GraphType, DistanceType, ArcLengthFunctor>::
+BoundedDijkstraWrapper<GraphType, DistanceType, ArcLengthFunctor,
+                       PriorityQueue>::
     RunBoundedDijkstraFromMultipleSourcesToMultipleDestinations(
         const std::vector<std::pair<int, DistanceType>>&
             sources_with_distance_offsets,
@@ -436,8 +554,10 @@ BoundedDijkstraWrapper<GraphType, DistanceType, ArcLengthFunctor>::
   return sorted_destinations;
 }
 
-template <class GraphType, class DistanceType, class ArcLengthFunctor>
-bool BoundedDijkstraWrapper<GraphType, DistanceType, ArcLengthFunctor>::
+template <class GraphType, class DistanceType, class ArcLengthFunctor,
+          class PriorityQueue>
+bool BoundedDijkstraWrapper<GraphType, DistanceType, ArcLengthFunctor,
+                            PriorityQueue>::
     OneToOneShortestPath(int from, int to, DistanceType distance_limit) {
   bool reached = false;
   std::function<void(node_type, DistanceType, DistanceType*)>
@@ -455,9 +575,11 @@ bool BoundedDijkstraWrapper<GraphType, DistanceType, ArcLengthFunctor>::
   return reached;
 }
 
-template <class GraphType, class DistanceType, class ArcLengthFunctor>
+template <class GraphType, class DistanceType, class ArcLengthFunctor,
+          class PriorityQueue>
 const std::vector<int>&
-BoundedDijkstraWrapper<GraphType, DistanceType, ArcLengthFunctor>::
+BoundedDijkstraWrapper<GraphType, DistanceType, ArcLengthFunctor,
+                       PriorityQueue>::
     RunBoundedDijkstraWithSettledNodeCallback(
         const std::vector<std::pair<int, DistanceType>>&
             sources_with_distance_offsets,
@@ -499,15 +621,13 @@ BoundedDijkstraWrapper<GraphType, DistanceType, ArcLengthFunctor>::
     distances_[node] = distance;
   }
   for (const int source : reached_nodes_) {
-    queue_.push_back({source, distances_[source]});
+    queue_.Push(source, distances_[source]);
   }
-  std::make_heap(queue_.begin(), queue_.end(), std::greater<NodeDistance>());
 
   // Dijkstra loop.
   while (!queue_.empty()) {
-    const NodeDistance top = queue_.front();
-    std::pop_heap(queue_.begin(), queue_.end(), std::greater<NodeDistance>());
-    queue_.pop_back();
+    NodeDistance top;
+    std::tie(top.node, top.distance) = queue_.Pop();
 
     // The queue may contain the same node more than once, skip irrelevant
     // entries.
@@ -553,19 +673,18 @@ BoundedDijkstraWrapper<GraphType, DistanceType, ArcLengthFunctor>::
       distances_[head] = candidate_distance;
       parents_[head] = top.node;
       arc_from_source_[head] = arc;
-      queue_.push_back({head, candidate_distance});
-      std::push_heap(queue_.begin(), queue_.end(),
-                     std::greater<NodeDistance>());
+      queue_.Push(head, candidate_distance);
     }
   }
 
   return reached_nodes_;
 }
 
-template <class GraphType, class DistanceType, class ArcLengthFunctor>
+template <class GraphType, class DistanceType, class ArcLengthFunctor,
+          class PriorityQueue>
 std::vector<int>
-BoundedDijkstraWrapper<GraphType, DistanceType, ArcLengthFunctor>::ArcPathTo(
-    int node) const {
+BoundedDijkstraWrapper<GraphType, DistanceType, ArcLengthFunctor,
+                       PriorityQueue>::ArcPathTo(int node) const {
   std::vector<int> output;
   int loop_detector = 0;
   while (true) {
@@ -580,10 +699,11 @@ BoundedDijkstraWrapper<GraphType, DistanceType, ArcLengthFunctor>::ArcPathTo(
   return output;
 }
 
-template <class GraphType, class DistanceType, class ArcLengthFunctor>
+template <class GraphType, class DistanceType, class ArcLengthFunctor,
+          class PriorityQueue>
 std::vector<int>
-BoundedDijkstraWrapper<GraphType, DistanceType, ArcLengthFunctor>::NodePathTo(
-    int node) const {
+BoundedDijkstraWrapper<GraphType, DistanceType, ArcLengthFunctor,
+                       PriorityQueue>::NodePathTo(int node) const {
   std::vector<int> output;
   int loop_detector = 0;
   while (true) {
@@ -598,26 +718,29 @@ BoundedDijkstraWrapper<GraphType, DistanceType, ArcLengthFunctor>::NodePathTo(
   return output;
 }
 
-template <class GraphType, class DistanceType, class ArcLengthFunctor>
-int BoundedDijkstraWrapper<GraphType, DistanceType, ArcLengthFunctor>::
+template <class GraphType, class DistanceType, class ArcLengthFunctor,
+          class PriorityQueue>
+int BoundedDijkstraWrapper<GraphType, DistanceType, ArcLengthFunctor,
+                           PriorityQueue>::
     SourceOfShortestPathToNode(int node) const {
   int parent = node;
   while (parents_[parent] != parent) parent = parents_[parent];
   return parent;
 }
 
-template <class GraphType, class DistanceType, class ArcLengthFunctor>
-int BoundedDijkstraWrapper<GraphType, DistanceType,
-                           ArcLengthFunctor>::GetSourceIndex(int node) const {
+template <class GraphType, class DistanceType, class ArcLengthFunctor,
+          class PriorityQueue>
+int BoundedDijkstraWrapper<GraphType, DistanceType, ArcLengthFunctor,
+                           PriorityQueue>::GetSourceIndex(int node) const {
   DCHECK_GE(node, 0);
   DCHECK_LT(node, node_to_source_index_.size());
   return node_to_source_index_[node];
 }
 
-template <class GraphType, class DistanceType, class ArcLengthFunctor>
-int BoundedDijkstraWrapper<GraphType, DistanceType,
-                           ArcLengthFunctor>::GetDestinationIndex(int node)
-    const {
+template <class GraphType, class DistanceType, class ArcLengthFunctor,
+          class PriorityQueue>
+int BoundedDijkstraWrapper<GraphType, DistanceType, ArcLengthFunctor,
+                           PriorityQueue>::GetDestinationIndex(int node) const {
   DCHECK_GE(node, 0);
   DCHECK_LT(node, node_to_destination_index_.size());
   return node_to_destination_index_[node];
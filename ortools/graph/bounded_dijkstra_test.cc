@@ -39,6 +39,7 @@
 namespace operations_research {
 namespace {
 
+using ::testing::AnyOf;
 using ::testing::Contains;
 using ::testing::ElementsAre;
 using ::testing::IsEmpty;
@@ -691,7 +692,88 @@ TEST(BoundedDisjktraTest, RandomizedStressTest) {
   }
 }
 
-template <bool arc_lengths_are_discrete>
+TEST(RadixHeapDijkstraQueueTest, PopsByIncreasingDistance) {
+  RadixHeapDijkstraQueue<int64_t> queue;
+  EXPECT_TRUE(queue.empty());
+  queue.Push(0, 5);
+  queue.Push(1, -3);
+  queue.Push(2, 5);
+  queue.Push(3, 1'000'000'000'000);
+  EXPECT_THAT(queue.Pop(), Pair(1, -3));
+  queue.Push(4, 2);
+  queue.Push(5, -3);
+  EXPECT_THAT(queue.Pop(), Pair(5, -3));
+  EXPECT_THAT(queue.Pop(), Pair(4, 2));
+  const auto [node, distance] = queue.Pop();
+  EXPECT_THAT(node, AnyOf(0, 2));
+  EXPECT_EQ(distance, 5);
+  EXPECT_EQ(queue.Pop().second, 5);
+  EXPECT_THAT(queue.Pop(), Pair(3, 1'000'000'000'000));
+  EXPECT_TRUE(queue.empty());
+
+  // A new run can start below the last popped distance.
+  queue.Push(6, 0);
+  EXPECT_THAT(queue.Pop(), Pair(6, 0));
+  queue.Push(7, 3);
+  queue.clear();
+  EXPECT_TRUE(queue.empty());
+}
+
+TEST(BoundedDijkstraWrapperTest, RadixHeapMatchesBinaryHeap) {
+  std::mt19937 random(1234);
+  const int num_nodes = 1000;
+  const int num_arcs = 4000;
+  ListGraph<> graph(num_nodes, num_arcs);
+  std::vector<int> lengths;
+  for (int a = 0; a < num_arcs; ++a) {
+    graph.AddArc(absl::Uniform(random, 0, num_nodes),
+                 absl::Uniform(random, 0, num_nodes));
+    lengths.push_back(absl::Uniform(random, 0, 60));
+  }
+  BoundedDijkstraWrapper<ListGraph<>, int> binary_heap_dijkstra(&graph,
+                                                                &lengths);
+  BoundedDijkstraWrapper<ListGraph<>, int, ElementGetter<int>,
+                         RadixHeapDijkstraQueue<int>>
+      radix_heap_dijkstra(&graph, &lengths);
+  for (int run = 0; run < 50; ++run) {
+    // Sources with offsets, some of them negative.
+    std::vector<std::pair<int, int>> sources(absl::Uniform(random, 1, 4));
+    for (auto& [node, offset] : sources) {
+      node = absl::Uniform(random, 0, num_nodes);
+      offset = absl::Uniform(random, -100, 100);
+    }
+    const int limit = absl::Bernoulli(random, 0.5)
+                          ? std::numeric_limits<int>::max()
+                          : absl::Uniform(random, 0, 500);
+    const std::vector<int> expected_reached_nodes =
+        binary_heap_dijkstra.RunBoundedDijkstraFromMultipleSources(sources,
+                                                                   limit);
+    ASSERT_THAT(
+        radix_heap_dijkstra.RunBoundedDijkstraFromMultipleSources(sources,
+                                                                  limit),
+        UnorderedElementsAreArray(expected_reached_nodes));
+    for (const int node : expected_reached_nodes) {
+      ASSERT_EQ(radix_heap_dijkstra.distances()[node],
+                binary_heap_dijkstra.distances()[node]);
+    }
+
+    // The early-stopping variants use the same loop.
+    const int from = absl::Uniform(random, 0, num_nodes);
+    const int to = absl::Uniform(random, 0, num_nodes);
+    const bool reached = binary_heap_dijkstra.OneToOneShortestPath(
+        from, to, std::numeric_limits<int>::max());
+    ASSERT_EQ(radix_heap_dijkstra.OneToOneShortestPath(
+                  from, to, std::numeric_limits<int>::max()),
+              reached);
+    if (reached) {
+      EXPECT_EQ(radix_heap_dijkstra.distances()[to],
+                binary_heap_dijkstra.distances()[to]);
+    }
+  }
+}
+
+template <bool arc_lengths_are_discrete,
+          class PriorityQueue = BinaryHeapDijkstraQueue<int64_t>>
 void BM_GridGraph(benchmark::State& state) {
   typedef util::StaticGraph<int> Graph;
   const int64_t kWidth = 100;
@@ -706,7 +788,8 @@ void BM_GridGraph(benchmark::State& state) {
   for (int64_t& length : arc_lengths) {
     length = absl::Uniform(random, min_length, max_length + 1);
   }
-  BoundedDijkstraWrapper<Graph, int64_t> dijkstra(graph.get(), &arc_lengths);
+  BoundedDijkstraWrapper<Graph, int64_t, ElementGetter<int64_t>, PriorityQueue>
+      dijkstra(graph.get(), &arc_lengths);
   const int64_t kSearchRadius = kWidth * (min_length + max_length) / 2;
   // NOTE(user): The expected number of nodes visited is in ϴ(kWidth²),
   // since the search radius is ϴ(kWidth). The exact constant is hard to
@@ -731,6 +814,8 @@ void BM_GridGraph(benchmark::State& state) {
 
 BENCHMARK(BM_GridGraph<true>);
 BENCHMARK(BM_GridGraph<false>);
+BENCHMARK(BM_GridGraph<true, RadixHeapDijkstraQueue<int64_t>>);
+BENCHMARK(BM_GridGraph<false, RadixHeapDijkstraQueue<int64_t>>);
 
 }  // namespace
 }  // namespace operations_research
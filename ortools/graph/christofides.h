@@ -27,7 +27,9 @@
 #define OR_TOOLS_GRAPH_CHRISTOFIDES_H_
 
 #include <cstdint>
+#include <limits>
 #include <string>
+#include <utility>
 #include <vector>
 
 #include "absl/status/status.h"
@@ -113,15 +115,32 @@ ComputeMinimumWeightMatching(const GraphType& graph,
   using ArcIndex = typename GraphType::ArcIndex;
   using NodeIndex = typename GraphType::NodeIndex;
   MinCostPerfectMatching matching(graph.num_nodes());
+  // Jump-start the matching with a greedy one, where each node is matched in
+  // turn to its closest unmatched neighbor. This is a lot cheaper than the
+  // matching itself and saves many of its iterations.
+  std::vector<int> hint(graph.num_nodes(), -1);
   for (NodeIndex tail : graph.AllNodes()) {
+    NodeIndex closest_head = -1;
+    int64_t closest_cost = std::numeric_limits<int64_t>::max();
     for (const ArcIndex arc : graph.OutgoingArcs(tail)) {
       const NodeIndex head = graph.Head(arc);
+      const int64_t cost = weight(arc);
       // Adding both arcs is redundant for MinCostPerfectMatching.
       if (tail < head) {
-        matching.AddEdgeWithCost(tail, head, weight(arc));
+        matching.AddEdgeWithCost(tail, head, cost);
       }
+      if (hint[tail] == -1 && head != tail && hint[head] == -1 &&
+          cost < closest_cost) {
+        closest_head = head;
+        closest_cost = cost;
+      }
+    }
+    if (hint[tail] == -1 && closest_head != -1) {
+      hint[tail] = closest_head;
+      hint[closest_head] = tail;
     }
   }
+  matching.SetMatchingHint(std::move(hint));
   MinCostPerfectMatching::Status status = matching.Solve();
   if (status != MinCostPerfectMatching::OPTIMAL) {
     return absl::InvalidArgumentError("Perfect matching failed");
@@ -14,12 +14,18 @@
 #include "ortools/graph/cliques.h"
 
 #include <algorithm>
+#include <cstdint>
 #include <functional>
 #include <memory>
 #include <utility>
 #include <vector>
 
 #include "absl/container/flat_hash_set.h"
+#include "absl/synchronization/mutex.h"
+#include "ortools/base/logging.h"
+#include "ortools/base/threadpool.h"
+#include "ortools/util/bitset.h"
+#include "ortools/util/time_limit.h"
 
 namespace operations_research {
 namespace {
@@ -260,4 +266,195 @@ void CoverArcsByCliques(std::function<bool(int, int)> graph, int node_count,
          &actual, &stop);
 }
 
+BitsetBronKerboschAlgorithm::BitsetBronKerboschAlgorithm(int num_nodes)
+    : num_nodes_(num_nodes),
+      num_words_(BitLength64(num_nodes)),
+      adjacency_(static_cast<size_t>(num_nodes) * num_words_, 0) {}
+
+void BitsetBronKerboschAlgorithm::AddEdge(int node1, int node2) {
+  DCHECK_GE(node1, 0);
+  DCHECK_LT(node1, num_nodes_);
+  DCHECK_GE(node2, 0);
+  DCHECK_LT(node2, num_nodes_);
+  if (node1 == node2) return;
+  adjacency_[static_cast<size_t>(node1) * num_words_ + BitOffset64(node2)] |=
+      OneBit64(BitPos64(node2));
+  adjacency_[static_cast<size_t>(node2) * num_words_ + BitOffset64(node1)] |=
+      OneBit64(BitPos64(node1));
+}
+
+BronKerboschAlgorithmStatus BitsetBronKerboschAlgorithm::Run(
+    const CliqueCallback& clique_callback, TimeLimit* time_limit,
+    int num_threads) {
+  CHECK(time_limit != nullptr);
+  CHECK_GE(num_threads, 1);
+  clique_callback_ = &clique_callback;
+  time_limit_ = time_limit;
+  stop_ = time_limit->LimitReached();
+
+  if (num_threads == 1 || num_nodes_ <= 1) {
+    WorkerState state;
+    for (int node = 0; node < num_nodes_ && !stop_; ++node) {
+      ExploreNode(node, &state);
+    }
+    SyncWithTimeLimit(&state);
+  } else {
+    // The first nodes have the largest branches, so we hand out the nodes one
+    // by one to balance the work.
+    std::atomic<int> next_node = 0;
+    ThreadPool pool("BronKerbosch", num_threads);
+    pool.StartWorkers();
+    for (int worker = 0; worker < num_threads; ++worker) {
+      pool.Schedule([this, &next_node]() {
+        WorkerState state;
+        while (!stop_) {
+          const int node = next_node.fetch_add(1);
+          if (node >= num_nodes_) break;
+          ExploreNode(node, &state);
+        }
+        SyncWithTimeLimit(&state);
+      });
+    }
+    // The destructor of the pool waits for all the workers.
+  }
+
+  clique_callback_ = nullptr;
+  time_limit_ = nullptr;
+  return stop_ ? BronKerboschAlgorithmStatus::INTERRUPTED
+               : BronKerboschAlgorithmStatus::COMPLETED;
+}
+
+void BitsetBronKerboschAlgorithm::ExploreNode(int node, WorkerState* state) {
+  if (state->candidates.size() < static_cast<size_t>(num_words_)) {
+    state->candidates.resize(num_words_);
+    state->not_set.resize(num_words_);
+  }
+  const uint64_t* neighbors = Neighbors(node);
+  const int node_word = BitOffset64(node);
+  for (int w = 0; w < num_words_; ++w) {
+    if (w < node_word) {
+      state->candidates[w] = 0;
+      state->not_set[w] = neighbors[w];
+    } else if (w > node_word) {
+      state->candidates[w] = neighbors[w];
+      state->not_set[w] = 0;
+    } else {
+      const uint64_t after_node = ~IntervalDown64(BitPos64(node));
+      state->candidates[w] = neighbors[w] & after_node;
+      state->not_set[w] = neighbors[w] & ~after_node;
+    }
+  }
+  state->num_word_operations += num_words_;
+  state->clique.assign(1, node);
+  Expand(/*depth=*/0, state);
+  state->clique.clear();
+}
+
+void BitsetBronKerboschAlgorithm::Expand(int depth, WorkerState* state) {
+  if (state->num_word_operations >= kWordOperationsBetweenSyncs) {
+    SyncWithTimeLimit(state);
+  }
+  if (stop_) return;
+
+  const size_t offset = static_cast<size_t>(depth) * num_words_;
+  uint64_t* candidates = &state->candidates[offset];
+  uint64_t* not_set = &state->not_set[offset];
+
+  bool has_candidates = false;
+  bool has_not_set = false;
+  for (int w = 0; w < num_words_; ++w) {
+    has_candidates |= candidates[w] != 0;
+    has_not_set |= not_set[w] != 0;
+  }
+  state->num_word_operations += num_words_;
+  if (!has_candidates) {
+    // The clique cannot be extended. It is maximal iff not_set is empty too.
+    if (!has_not_set) ReportClique(*state);
+    return;
+  }
+
+  // Select the pivot, the node of candidates ∪ not_set with the most
+  // neighbors among the candidates.
+  int pivot = -1;
+  int64_t best_num_connected = -1;
+  for (int w = 0; w < num_words_; ++w) {
+    for (uint64_t word = candidates[w] | not_set[w]; word != 0;
+         word &= word - 1) {
+      const int node = (w << 6) + LeastSignificantBitPosition64(word);
+      const uint64_t* neighbors = Neighbors(node);
+      int64_t num_connected = 0;
+      for (int i = 0; i < num_words_; ++i) {
+        num_connected += BitCount64(candidates[i] & neighbors[i]);
+      }
+      state->num_word_operations += num_words_;
+      if (num_connected > best_num_connected) {
+        best_num_connected = num_connected;
+        pivot = node;
+      }
+    }
+  }
+  DCHECK_NE(pivot, -1);
+
+  // Only the candidates that are not connected to the pivot need to be
+  // explored.
+  const int start = state->to_explore.size();
+  const uint64_t* pivot_neighbors = Neighbors(pivot);
+  for (int w = 0; w < num_words_; ++w) {
+    for (uint64_t word = candidates[w] & ~pivot_neighbors[w]; word != 0;
+         word &= word - 1) {
+      state->to_explore.push_back((w << 6) +
+                                  LeastSignificantBitPosition64(word));
+    }
+  }
+  const int end = state->to_explore.size();
+
+  const size_t next_offset = offset + num_words_;
+  if (state->candidates.size() < next_offset + num_words_) {
+    state->candidates.resize(next_offset + num_words_);
+    state->not_set.resize(next_offset + num_words_);
+  }
+  for (int i = start; i < end && !stop_; ++i) {
+    const int node = state->to_explore[i];
+    const uint64_t* neighbors = Neighbors(node);
+
+    // The vectors might have been reallocated by a deeper recursion.
+    candidates = &state->candidates[offset];
+    not_set = &state->not_set[offset];
+    uint64_t* next_candidates = &state->candidates[next_offset];
+    uint64_t* next_not_set = &state->not_set[next_offset];
+    for (int w = 0; w < num_words_; ++w) {
+      next_candidates[w] = candidates[w] & neighbors[w];
+      next_not_set[w] = not_set[w] & neighbors[w];
+    }
+    state->num_word_operations += num_words_;
+
+    state->clique.push_back(node);
+    Expand(depth + 1, state);
+    state->clique.pop_back();
+
+    candidates = &state->candidates[offset];
+    not_set = &state->not_set[offset];
+    candidates[BitOffset64(node)] &= ~OneBit64(BitPos64(node));
+    not_set[BitOffset64(node)] |= OneBit64(BitPos64(node));
+  }
+  state->to_explore.resize(start);
+}
+
+void BitsetBronKerboschAlgorithm::ReportClique(const WorkerState& state) {
+  absl::MutexLock lock(&mutex_);
+  if (stop_) return;
+  if ((*clique_callback_)(state.clique) == CliqueResponse::STOP) {
+    stop_ = true;
+  }
+}
+
+void BitsetBronKerboschAlgorithm::SyncWithTimeLimit(WorkerState* state) {
+  absl::MutexLock lock(&mutex_);
+  time_limit_->AdvanceDeterministicTime(
+      state->num_word_operations * kDeterministicTimePerWordOperation,
+      "BitsetBronKerbosch");
+  state->num_word_operations = 0;
+  if (time_limit_->LimitReached()) stop_ = true;
+}
+
 }  // namespace operations_research
@@ -24,6 +24,7 @@
 #ifndef OR_TOOLS_GRAPH_CLIQUES_H_
 #define OR_TOOLS_GRAPH_CLIQUES_H_
 
+#include <atomic>
 #include <cstdint>
 #include <functional>
 #include <limits>
@@ -32,6 +33,7 @@
 #include <vector>
 
 #include "absl/strings/str_cat.h"
+#include "absl/synchronization/mutex.h"
 #include "ortools/base/int_type.h"
 #include "ortools/base/logging.h"
 #include "ortools/base/strong_vector.h"
@@ -561,6 +563,91 @@ BronKerboschAlgorithmStatus BronKerboschAlgorithm<NodeIndex>::Run() {
 template <typename NodeIndex>
 const double BronKerboschAlgorithm<
     NodeIndex>::kPushStateDeterministicTimeSecondsPerCandidate = 0.54663e-7;
+
+// A variant of BronKerboschAlgorithm for dense graphs given by their adjacency
+// matrix, stored as one bitset per node. All the sets of the algorithm are
+// bitsets too, so that restricting the candidates and the "not" set to the
+// neighbors of a node is done 64 nodes at a time, and the pivot is the node of
+// candidates ∪ "not" with the most neighbors among the candidates (Tomita et
+// al., 2006), which is computed with popcounts.
+//
+// The top-level branches, one per node v with the candidates N(v) ∩ {u > v}
+// and the "not" set N(v) ∩ {u < v}, are independent and can be explored in
+// parallel.
+//
+// The memory is in O(N^2 / 8) bytes for the adjacency matrix, plus the same
+// amount per thread in the worst case, so this is meant for graphs with up to
+// a few tens of thousands of nodes.
+class BitsetBronKerboschAlgorithm {
+ public:
+  // See BronKerboschAlgorithm::CliqueCallback. The cliques are reported in no
+  // particular order, and with more than one thread, the callback is called by
+  // the worker threads, one call at a time.
+  using CliqueCallback = std::function<CliqueResponse(const std::vector<int>&)>;
+
+  explicit BitsetBronKerboschAlgorithm(int num_nodes);
+
+  // Adds the undirected edge (node1, node2). Self-loops are ignored.
+  void AddEdge(int node1, int node2);
+
+  // Reports all the maximal cliques, including the ones of size 1, to the
+  // given callback. Returns COMPLETED if all of them were reported, and
+  // INTERRUPTED if the time limit was reached or if the callback returned
+  // STOP. Contrary to BronKerboschAlgorithm, the search cannot be resumed.
+  BronKerboschAlgorithmStatus Run(const CliqueCallback& clique_callback,
+                                  TimeLimit* time_limit, int num_threads = 1);
+
+ private:
+  // The data used by one thread. The candidates and "not" sets of each depth
+  // of the recursion are stored one after the other in a flat vector.
+  struct WorkerState {
+    std::vector<int> clique;
+    std::vector<uint64_t> candidates;
+    std::vector<uint64_t> not_set;
+    std::vector<int> to_explore;
+    int64_t num_word_operations = 0;
+  };
+
+  // Explores the top-level branch of the given node.
+  void ExploreNode(int node, WorkerState* state);
+
+  // Reports all the maximal cliques containing state->clique and any subset of
+  // the candidates of the given depth, but no node of the "not" set.
+  void Expand(int depth, WorkerState* state);
+
+  // Reports state->clique, which is maximal.
+  void ReportClique(const WorkerState& state);
+
+  // Adds the work done by the given state to the deterministic time, and
+  // updates stop_ if the time limit is reached.
+  void SyncWithTimeLimit(WorkerState* state);
+
+  const uint64_t* Neighbors(int node) const {
+    return &adjacency_[static_cast<size_t>(node) * num_words_];
+  }
+
+  // The deterministic time per 64-bit word operation. This was set to match
+  // approximately the running time in seconds on a recent workstation.
+  static constexpr double kDeterministicTimePerWordOperation = 2e-10;
+
+  // Amount of work, in word operations, after which a worker synchronizes with
+  // the time limit.
+  static constexpr int64_t kWordOperationsBetweenSyncs = 1 << 20;
+
+  const int num_nodes_;
+  const int num_words_;
+  std::vector<uint64_t> adjacency_;
+
+  // Set when the search must stop, either because of the time limit or of the
+  // clique callback.
+  std::atomic<bool> stop_ = false;
+
+  // Protects the callback and the time limit, which are not thread-safe.
+  absl::Mutex mutex_;
+  const CliqueCallback* clique_callback_ = nullptr;
+  TimeLimit* time_limit_ = nullptr;
+};
+
 }  // namespace operations_research
 
 #endif  // OR_TOOLS_GRAPH_CLIQUES_H_
@@ -527,6 +527,103 @@ TEST(BronKerboschAlgorithmTest, DeterministicTimeLimit) {
   EXPECT_TRUE(time_limit->LimitReached());
 }
 
+TEST(BitsetBronKerboschAlgorithmTest, RandomGraph) {
+  constexpr int kNumNodes = 1000;
+  constexpr double kArcProbability = 0.1;
+  constexpr int kSeed = 123456789;
+  constexpr int kExpectedNumCliques = 100485;
+  const absl::flat_hash_set<std::pair<int, int>> adjacency_matrix =
+      MakeRandomGraphAdjacencyMatrix(kNumNodes, kArcProbability, kSeed);
+  BitsetBronKerboschAlgorithm bron_kerbosch(kNumNodes);
+  for (const auto& [node1, node2] : adjacency_matrix) {
+    bron_kerbosch.AddEdge(node1, node2);
+  }
+  for (const int num_threads : {1, 4}) {
+    SCOPED_TRACE(absl::StrCat("num_threads = ", num_threads));
+    TimeLimit time_limit;
+    CliqueSizeVerifier verifier(0, kNumNodes);
+    EXPECT_EQ(BronKerboschAlgorithmStatus::COMPLETED,
+              bron_kerbosch.Run(verifier.MakeCliqueCallback(), &time_limit,
+                                num_threads));
+    EXPECT_EQ(kExpectedNumCliques, verifier.num_cliques());
+  }
+}
+
+TEST(BitsetBronKerboschAlgorithmTest, SameCliquesAsBronKerboschAlgorithm) {
+  constexpr int kNumNodes = 130;
+  constexpr double kArcProbability = 0.5;
+  constexpr int kSeed = 987654321;
+  const absl::flat_hash_set<std::pair<int, int>> adjacency_matrix =
+      MakeRandomGraphAdjacencyMatrix(kNumNodes, kArcProbability, kSeed);
+  auto graph = [&adjacency_matrix](int index1, int index2) {
+    return BitmapGraph(adjacency_matrix, index1, index2);
+  };
+  CliqueReporter<int> expected_reporter;
+  BronKerboschAlgorithm<int> reference(graph, kNumNodes,
+                                       expected_reporter.MakeCliqueCallback());
+  reference.Run();
+  std::vector<std::vector<int>> expected = expected_reporter.all_cliques();
+  for (std::vector<int>& clique : expected) {
+    std::sort(clique.begin(), clique.end());
+  }
+  std::sort(expected.begin(), expected.end());
+
+  BitsetBronKerboschAlgorithm bron_kerbosch(kNumNodes);
+  for (const auto& [node1, node2] : adjacency_matrix) {
+    bron_kerbosch.AddEdge(node1, node2);
+  }
+  for (const int num_threads : {1, 4}) {
+    SCOPED_TRACE(absl::StrCat("num_threads = ", num_threads));
+    TimeLimit time_limit;
+    CliqueReporter<int> reporter;
+    EXPECT_EQ(BronKerboschAlgorithmStatus::COMPLETED,
+              bron_kerbosch.Run(reporter.MakeCliqueCallback(), &time_limit,
+                                num_threads));
+    std::vector<std::vector<int>> cliques = reporter.all_cliques();
+    for (std::vector<int>& clique : cliques) {
+      std::sort(clique.begin(), clique.end());
+    }
+    std::sort(cliques.begin(), cliques.end());
+    EXPECT_EQ(expected, cliques);
+  }
+}
+
+TEST(BitsetBronKerboschAlgorithmTest, StopAfterFirstClique) {
+  constexpr int kNumNodes = 10;
+  BitsetBronKerboschAlgorithm bron_kerbosch(kNumNodes);
+  for (const int num_threads : {1, 4}) {
+    SCOPED_TRACE(absl::StrCat("num_threads = ", num_threads));
+    TimeLimit time_limit;
+    CliqueReporter<int> reporter(1);
+    EXPECT_EQ(BronKerboschAlgorithmStatus::INTERRUPTED,
+              bron_kerbosch.Run(reporter.MakeCliqueCallback(), &time_limit,
+                                num_threads));
+    EXPECT_EQ(1, reporter.all_cliques().size());
+  }
+}
+
+TEST(BitsetBronKerboschAlgorithmTest, DeterministicTimeLimit) {
+  const int kNumPartitions = 15;
+  const int kNumNodes = kNumPartitions * kNumPartitions;
+  const double kDeterministicLimit = 0.01;
+
+  std::unique_ptr<TimeLimit> time_limit =
+      TimeLimit::FromDeterministicTime(kDeterministicLimit);
+  BitsetBronKerboschAlgorithm bron_kerbosch(kNumNodes);
+  for (int node1 = 0; node1 < kNumNodes; ++node1) {
+    for (int node2 = node1 + 1; node2 < kNumNodes; ++node2) {
+      if (FullKPartiteGraph(kNumPartitions, node1, node2)) {
+        bron_kerbosch.AddEdge(node1, node2);
+      }
+    }
+  }
+  CliqueSizeVerifier verifier(kNumPartitions, kNumPartitions);
+  EXPECT_EQ(BronKerboschAlgorithmStatus::INTERRUPTED,
+            bron_kerbosch.Run(verifier.MakeCliqueCallback(), time_limit.get(),
+                              /*num_threads=*/4));
+  EXPECT_TRUE(time_limit->LimitReached());
+}
+
 // A benchmark that finds all maximal cliques in a modulo graph of the given
 // size.
 void BM_FindCliquesInModuloGraph(benchmark::State& state) {
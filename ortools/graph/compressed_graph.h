@@ -0,0 +1,601 @@
+// Copyright 2010-2024 Google LLC
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// An immutable graph without reverse arcs, with the interface of StaticGraph<>
+// of graph.h but a much smaller memory footprint, for huge graphs like
+// continental road networks.
+//
+// The arcs are stored in compressed sparse row form, i.e. sorted by tail (and
+// by head for a given tail), so that the arcs of a node are consecutive and
+// the tails don't need to be stored. The heads are delta-encoded: the arcs are
+// cut into blocks of kArcsPerBlock consecutive arcs, and each block stores the
+// head of its first arc followed by the differences between the heads of
+// consecutive arcs, all as variable-length integers. There is one 64-bit
+// offset per block, so Head(arc) only decodes a part of one block.
+//
+// On a road network whose nodes are numbered with some locality (e.g. along a
+// space-filling curve), an arc then takes about 1.5 bytes plus the 0.5 byte of
+// its block offset, against 2 * sizeof(NodeIndexType) for StaticGraph<>.
+//
+// Usage:
+//   CompressedStaticGraph<> graph;
+//   for (...) graph.AddArc(tail, head);
+//   std::vector<int32_t> permutation;
+//   graph.Build(&permutation);
+//   Permute(permutation, &arc_lengths);
+//   ...
+//   for (const int arc : graph.OutgoingArcs(node)) {
+//     ... graph.Head(arc) ... arc_lengths[arc] ...
+//   }
+//   for (const int head : graph[node]) { ... }  // The fastest iteration.
+//
+// The graph can be written to a file with Serialize() and loaded back with
+// Deserialize(), or used in place with View(), e.g. on a memory-mapped file:
+// a graph that doesn't fit in memory once built can thus be built once on a
+// bigger machine and then used from disk, the OS paging in the parts that are
+// actually accessed.
+//
+// The class works with the algorithms that only use OutgoingArcs(), Head() or
+// operator[], like BoundedDijkstraWrapper or GetConnectedComponents() (on a
+// symmetric graph).
+
+#ifndef UTIL_GRAPH_COMPRESSED_GRAPH_H_
+#define UTIL_GRAPH_COMPRESSED_GRAPH_H_
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <iterator>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "absl/log/check.h"
+#include "absl/status/status.h"
+#include "absl/status/statusor.h"
+#include "absl/strings/string_view.h"
+#include "absl/types/span.h"
+#include "ortools/graph/graph.h"
+#include "ortools/graph/iterators.h"
+
+namespace util {
+
+template <typename NodeIndexType = int32_t, typename ArcIndexType = int32_t>
+class CompressedStaticGraph
+    : public BaseGraph<NodeIndexType, ArcIndexType, false> {
+  typedef BaseGraph<NodeIndexType, ArcIndexType, false> Base;
+  using Base::arc_capacity_;
+  using Base::const_capacities_;
+  using Base::node_capacity_;
+  using Base::num_arcs_;
+  using Base::num_nodes_;
+
+ public:
+  // The number of arcs whose heads are encoded relative to each other. Head()
+  // decodes on average kArcsPerBlock / 2 integers.
+  static constexpr int kArcsPerBlock = 16;
+
+  using Base::IsArcValid;
+  CompressedStaticGraph() = default;
+  CompressedStaticGraph(NodeIndexType num_nodes, ArcIndexType arc_capacity) {
+    this->Reserve(num_nodes, arc_capacity);
+    this->FreezeCapacities();
+    this->AddNode(num_nodes - 1);
+  }
+
+  // Do not use directly. See operator[] below.
+  class OutgoingHeadIterator;
+
+  // Only valid after Build(). Tail() works in O(log(num_nodes())) with a
+  // binary search on the node starts, and Head() in O(kArcsPerBlock).
+  NodeIndexType Head(ArcIndexType arc) const;
+  NodeIndexType Tail(ArcIndexType arc) const;
+  ArcIndexType OutDegree(NodeIndexType node) const;  // Work in O(1).
+  IntegerRange<ArcIndexType> OutgoingArcs(NodeIndexType node) const;
+  IntegerRange<ArcIndexType> OutgoingArcsStartingFrom(NodeIndexType node,
+                                                      ArcIndexType from) const;
+
+  // This loops over the heads of the OutgoingArcs(node), decoding them
+  // sequentially, which is much faster than calling Head() on each arc.
+  BeginEndWrapper<OutgoingHeadIterator> operator[](NodeIndexType node) const;
+
+  void ReserveArcs(ArcIndexType bound) override;
+  void AddNode(NodeIndexType node);
+  ArcIndexType AddArc(NodeIndexType tail, NodeIndexType head);
+
+  // Compresses the graph, after which no node or arc can be added. As for
+  // StaticGraph<>, the arc indices change: the new index of the arc returned by
+  // the i-th AddArc() is stored in (*permutation)[i]. Note that the arcs are
+  // also sorted by head for a given tail, so the permutation is usually not the
+  // one of StaticGraph<>. The peak memory usage is the one of StaticGraph<>.
+  void Build() { Build(nullptr); }
+  void Build(std::vector<ArcIndexType>* permutation);
+
+  // Returns the binary representation of a built graph, which is meant to be
+  // reloaded by Deserialize() or View() on the same kind of machine (the arrays
+  // are stored with the native byte order).
+  std::string Serialize() const;
+
+  // Loads the output of Serialize(). Returns an InvalidArgumentError if `data`
+  // isn't a valid graph with these index types.
+  static absl::StatusOr<CompressedStaticGraph> Deserialize(
+      absl::string_view data);
+
+  // Same as Deserialize(), but without copying `data`, which must outlive the
+  // returned graph and be 8-byte aligned, as the memory returned by mmap() is.
+  // Note that the whole graph is decoded once to be validated.
+  static absl::StatusOr<CompressedStaticGraph> View(absl::string_view data);
+
+ private:
+  static absl::StatusOr<CompressedStaticGraph> Load(absl::string_view data,
+                                                    bool copy);
+  // Points start_, block_offset_ and encoded_heads_ into data_, whose header
+  // and array sizes must have been checked.
+  void SetViews();
+  absl::Status Validate() const;
+
+  bool is_built_ = false;
+
+  // The arcs added before Build().
+  std::vector<NodeIndexType> tail_;
+  std::vector<NodeIndexType> head_;
+
+  // The serialized graph, which is owned by owned_data_ (shared by the copies
+  // of the graph since it is immutable) or by the user of View(). The arrays
+  // below point into it.
+  std::shared_ptr<const std::string> owned_data_;
+  absl::string_view data_;
+  // The first arc of each node, plus num_arcs() at the end.
+  absl::Span<const ArcIndexType> start_;
+  // The offset in encoded_heads_ of each block, plus encoded_heads_.size()
+  // at the end.
+  absl::Span<const uint64_t> block_offset_;
+  absl::Span<const uint8_t> encoded_heads_;
+};
+
+// Implementation.
+
+namespace internal {
+
+inline constexpr char kCompressedGraphMagic[8] = {'O', 'R', 'C', 'G',
+                                                  'v', '1', 0,   0};
+
+// Appends `value` with 7 bits per byte, the high bit being set on all the
+// bytes but the last one.
+inline void AppendVarint(uint64_t value, std::string& output) {
+  while (value >= 0x80) {
+    output.push_back(static_cast<char>(value | 0x80));
+    value >>= 7;
+  }
+  output.push_back(static_cast<char>(value));
+}
+
+// Decodes the output of AppendVarint() at `data`, without bound checks, and
+// returns the position just after it.
+inline const uint8_t* DecodeVarint(const uint8_t* data, uint64_t& value) {
+  // Most deltas fit in one byte.
+  if (*data < 0x80) {
+    value = *data;
+    return data + 1;
+  }
+  value = 0;
+  int shift = 0;
+  while (*data >= 0x80) {
+    value |= static_cast<uint64_t>(*data & 0x7f) << shift;
+    shift += 7;
+    ++data;
+  }
+  value |= static_cast<uint64_t>(*data) << shift;
+  return data + 1;
+}
+
+// Same as DecodeVarint() but returns nullptr if the varint doesn't end before
+// `end` or is too long.
+inline const uint8_t* DecodeVarintChecked(const uint8_t* data,
+                                          const uint8_t* end,
+                                          uint64_t& value) {
+  value = 0;
+  for (int shift = 0; data < end && shift < 64; shift += 7) {
+    value |= static_cast<uint64_t>(*data & 0x7f) << shift;
+    if (*data++ < 0x80) return data;
+  }
+  return nullptr;
+}
+
+// Maps the small (in absolute value) integers to small unsigned integers.
+inline uint64_t ZigZagEncode(int64_t value) {
+  return (static_cast<uint64_t>(value) << 1) ^
+         static_cast<uint64_t>(value >> 63);
+}
+inline int64_t ZigZagDecode(uint64_t value) {
+  return static_cast<int64_t>(value >> 1) ^ -static_cast<int64_t>(value & 1);
+}
+
+inline void AppendPadding(std::string& output) {
+  output.resize((output.size() + 7) / 8 * 8, 0);
+}
+
+}  // namespace internal
+
+template <typename NodeIndexType, typename ArcIndexType>
+class CompressedStaticGraph<NodeIndexType, ArcIndexType>::OutgoingHeadIterator {
+ public:
+  using iterator_category = std::input_iterator_tag;
+  using value_type = NodeIndexType;
+  using difference_type = std::ptrdiff_t;
+  using pointer = const NodeIndexType*;
+  using reference = const NodeIndexType&;
+
+  // Iterates over the heads of the arcs in [arc, end_arc), which must be in
+  // the same node.
+  OutgoingHeadIterator(const CompressedStaticGraph& graph, ArcIndexType arc,
+                       ArcIndexType end_arc)
+      : arc_(arc), end_arc_(end_arc) {
+    if (arc >= end_arc) return;
+    const int64_t block = arc / kArcsPerBlock;
+    data_ = graph.encoded_heads_.data() + graph.block_offset_[block];
+    for (int64_t a = block * kArcsPerBlock; a <= arc; ++a) DecodeNext(a);
+  }
+
+  NodeIndexType operator*() const { return head_; }
+  bool operator!=(const OutgoingHeadIterator& other) const {
+    return arc_ != other.arc_;
+  }
+  OutgoingHeadIterator& operator++() {
+    ++arc_;
+    // Never decodes past the end of the last block.
+    if (arc_ < end_arc_) DecodeNext(arc_);
+    return *this;
+  }
+
+ private:
+  void DecodeNext(int64_t arc) {
+    uint64_t value;
+    data_ = internal::DecodeVarint(data_, value);
+    head_ = static_cast<NodeIndexType>(
+        arc % kArcsPerBlock == 0 ? static_cast<int64_t>(value)
+                                 : head_ + internal::ZigZagDecode(value));
+  }
+
+  ArcIndexType arc_;
+  const ArcIndexType end_arc_;
+  const uint8_t* data_ = nullptr;
+  NodeIndexType head_ = 0;
+};
+
+template <typename NodeIndexType, typename ArcIndexType>
+NodeIndexType CompressedStaticGraph<NodeIndexType, ArcIndexType>::Head(
+    ArcIndexType arc) const {
+  DCHECK(is_built_);
+  DCHECK(IsArcValid(arc));
+  const int64_t block = arc / kArcsPerBlock;
+  const uint8_t* data = encoded_heads_.data() + block_offset_[block];
+  uint64_t value;
+  data = internal::DecodeVarint(data, value);
+  int64_t head = value;
+  for (int i = arc % kArcsPerBlock; i > 0; --i) {
+    data = internal::DecodeVarint(data, value);
+    head += internal::ZigZagDecode(value);
+  }
+  return static_cast<NodeIndexType>(head);
+}
+
+template <typename NodeIndexType, typename ArcIndexType>
+NodeIndexType CompressedStaticGraph<NodeIndexType, ArcIndexType>::Tail(
+    ArcIndexType arc) const {
+  DCHECK(is_built_);
+  DCHECK(IsArcValid(arc));
+  // The last node whose first arc is at most arc, which skips the nodes
+  // without outgoing arcs.
+  return static_cast<NodeIndexType>(
+      std::upper_bound(start_.begin(), start_.end(), arc) - start_.begin() -
+      1);
+}
+
+template <typename NodeIndexType, typename ArcIndexType>
+ArcIndexType CompressedStaticGraph<NodeIndexType, ArcIndexType>::OutDegree(
+    NodeIndexType node) const {
+  DCHECK(is_built_);
+  DCHECK(Base::IsNodeValid(node));
+  return start_[node + 1] - start_[node];
+}
+
+template <typename NodeIndexType, typename ArcIndexType>
+IntegerRange<ArcIndexType>
+CompressedStaticGraph<NodeIndexType, ArcIndexType>::OutgoingArcs(
+    NodeIndexType node) const {
+  DCHECK(is_built_);
+  DCHECK(Base::IsNodeValid(node));
+  return IntegerRange<ArcIndexType>(start_[node], start_[node + 1]);
+}
+
+template <typename NodeIndexType, typename ArcIndexType>
+IntegerRange<ArcIndexType>
+CompressedStaticGraph<NodeIndexType, ArcIndexType>::OutgoingArcsStartingFrom(
+    NodeIndexType node, ArcIndexType from) const {
+  DCHECK(is_built_);
+  DCHECK(Base::IsNodeValid(node));
+  DCHECK_GE(from, start_[node]);
+  DCHECK_LE(from, start_[node + 1]);
+  return IntegerRange<ArcIndexType>(from, start_[node + 1]);
+}
+
+template <typename NodeIndexType, typename ArcIndexType>
+BeginEndWrapper<
+    typename CompressedStaticGraph<NodeIndexType, ArcIndexType>::
+        OutgoingHeadIterator>
+CompressedStaticGraph<NodeIndexType, ArcIndexType>::operator[](
+    NodeIndexType node) const {
+  DCHECK(is_built_);
+  DCHECK(Base::IsNodeValid(node));
+  const ArcIndexType end_arc = start_[node + 1];
+  return BeginEndWrapper<OutgoingHeadIterator>(
+      OutgoingHeadIterator(*this, start_[node], end_arc),
+      OutgoingHeadIterator(*this, end_arc, end_arc));
+}
+
+template <typename NodeIndexType, typename ArcIndexType>
+void CompressedStaticGraph<NodeIndexType, ArcIndexType>::ReserveArcs(
+    ArcIndexType bound) {
+  Base::ReserveArcs(bound);
+  if (bound <= num_arcs_) return;
+  head_.reserve(bound);
+  tail_.reserve(bound);
+}
+
+template <typename NodeIndexType, typename ArcIndexType>
+void CompressedStaticGraph<NodeIndexType, ArcIndexType>::AddNode(
+    NodeIndexType node) {
+  DCHECK(!is_built_);
+  if (node < num_nodes_) return;
+  DCHECK(!const_capacities_ || node < node_capacity_) << node;
+  num_nodes_ = node + 1;
+}
+
+template <typename NodeIndexType, typename ArcIndexType>
+ArcIndexType CompressedStaticGraph<NodeIndexType, ArcIndexType>::AddArc(
+    NodeIndexType tail, NodeIndexType head) {
+  DCHECK_GE(tail, 0);
+  DCHECK_GE(head, 0);
+  DCHECK(!is_built_);
+  AddNode(tail > head ? tail : head);
+  tail_.push_back(tail);
+  head_.push_back(head);
+  DCHECK(!const_capacities_ || num_arcs_ < arc_capacity_);
+  return num_arcs_++;
+}
+
+template <typename NodeIndexType, typename ArcIndexType>
+void CompressedStaticGraph<NodeIndexType, ArcIndexType>::Build(
+    std::vector<ArcIndexType>* permutation) {
+  DCHECK(!is_built_);
+  if (is_built_) return;
+  is_built_ = true;
+  node_capacity_ = num_nodes_;
+  arc_capacity_ = num_arcs_;
+  this->FreezeCapacities();
+
+  // Sorts the arcs by tail with a counting sort, then by head.
+  std::vector<ArcIndexType> start(static_cast<size_t>(num_nodes_) + 1, 0);
+  for (const NodeIndexType tail : tail_) ++start[tail + 1];
+  for (NodeIndexType node = 0; node < num_nodes_; ++node) {
+    start[node + 1] += start[node];
+  }
+  std::vector<ArcIndexType> sorted_arcs(num_arcs_);
+  {
+    std::vector<ArcIndexType> next(start.begin(), start.end() - 1);
+    for (ArcIndexType arc = 0; arc < num_arcs_; ++arc) {
+      sorted_arcs[next[tail_[arc]]++] = arc;
+    }
+  }
+  std::vector<NodeIndexType>().swap(tail_);
+  for (NodeIndexType node = 0; node < num_nodes_; ++node) {
+    std::sort(sorted_arcs.begin() + start[node],
+              sorted_arcs.begin() + start[node + 1],
+              [this](ArcIndexType a, ArcIndexType b) {
+                return std::make_pair(head_[a], a) <
+                       std::make_pair(head_[b], b);
+              });
+  }
+
+  // Writes the serialized graph directly.
+  const int64_t num_blocks = (num_arcs_ + kArcsPerBlock - 1) / kArcsPerBlock;
+  std::string encoded_heads;
+  std::vector<uint64_t> block_offset;
+  block_offset.reserve(num_blocks + 1);
+  int64_t previous_head = 0;
+  for (ArcIndexType arc = 0; arc < num_arcs_; ++arc) {
+    const int64_t head = head_[sorted_arcs[arc]];
+    if (arc % kArcsPerBlock == 0) {
+      block_offset.push_back(encoded_heads.size());
+      internal::AppendVarint(head, encoded_heads);
+    } else {
+      internal::AppendVarint(internal::ZigZagEncode(head - previous_head),
+                             encoded_heads);
+    }
+    previous_head = head;
+  }
+  block_offset.push_back(encoded_heads.size());
+  std::vector<NodeIndexType>().swap(head_);
+
+  if (permutation != nullptr) {
+    permutation->resize(num_arcs_);
+    for (ArcIndexType arc = 0; arc < num_arcs_; ++arc) {
+      (*permutation)[sorted_arcs[arc]] = arc;
+    }
+  }
+  std::vector<ArcIndexType>().swap(sorted_arcs);
+
+  auto data = std::make_shared<std::string>(
+      internal::kCompressedGraphMagic, sizeof(internal::kCompressedGraphMagic));
+  const uint32_t index_sizes[2] = {sizeof(NodeIndexType), sizeof(ArcIndexType)};
+  const uint64_t sizes[3] = {static_cast<uint64_t>(num_nodes_),
+                             static_cast<uint64_t>(num_arcs_),
+                             encoded_heads.size()};
+  data->append(reinterpret_cast<const char*>(index_sizes), sizeof(index_sizes));
+  data->append(reinterpret_cast<const char*>(sizes), sizeof(sizes));
+  data->append(reinterpret_cast<const char*>(start.data()),
+               start.size() * sizeof(ArcIndexType));
+  internal::AppendPadding(*data);
+  data->append(reinterpret_cast<const char*>(block_offset.data()),
+               block_offset.size() * sizeof(uint64_t));
+  data->append(encoded_heads);
+  owned_data_ = std::move(data);
+  data_ = *owned_data_;
+  SetViews();
+}
+
+template <typename NodeIndexType, typename ArcIndexType>
+void CompressedStaticGraph<NodeIndexType, ArcIndexType>::SetViews() {
+  constexpr size_t kHeaderSize = sizeof(internal::kCompressedGraphMagic) +
+                                 2 * sizeof(uint32_t) + 3 * sizeof(uint64_t);
+  uint64_t sizes[3];
+  std::memcpy(sizes, data_.data() + kHeaderSize - sizeof(sizes), sizeof(sizes));
+  const char* position = data_.data() + kHeaderSize;
+  start_ = absl::MakeConstSpan(
+      reinterpret_cast<const ArcIndexType*>(position), sizes[0] + 1);
+  position += ((sizes[0] + 1) * sizeof(ArcIndexType) + 7) / 8 * 8;
+  const uint64_t num_blocks = (sizes[1] + kArcsPerBlock - 1) / kArcsPerBlock;
+  block_offset_ = absl::MakeConstSpan(
+      reinterpret_cast<const uint64_t*>(position), num_blocks + 1);
+  position += (num_blocks + 1) * sizeof(uint64_t);
+  encoded_heads_ = absl::MakeConstSpan(
+      reinterpret_cast<const uint8_t*>(position), sizes[2]);
+}
+
+template <typename NodeIndexType, typename ArcIndexType>
+std::string CompressedStaticGraph<NodeIndexType, ArcIndexType>::Serialize()
+    const {
+  DCHECK(is_built_);
+  return std::string(data_);
+}
+
+template <typename NodeIndexType, typename ArcIndexType>
+absl::StatusOr<CompressedStaticGraph<NodeIndexType, ArcIndexType>>
+CompressedStaticGraph<NodeIndexType, ArcIndexType>::Deserialize(
+    absl::string_view data) {
+  return Load(data, /*copy=*/true);
+}
+
+template <typename NodeIndexType, typename ArcIndexType>
+absl::StatusOr<CompressedStaticGraph<NodeIndexType, ArcIndexType>>
+CompressedStaticGraph<NodeIndexType, ArcIndexType>::View(
+    absl::string_view data) {
+  if (reinterpret_cast<uintptr_t>(data.data()) % 8 != 0) {
+    return absl::InvalidArgumentError("The graph data must be 8-byte aligned");
+  }
+  return Load(data, /*copy=*/false);
+}
+
+template <typename NodeIndexType, typename ArcIndexType>
+absl::StatusOr<CompressedStaticGraph<NodeIndexType, ArcIndexType>>
+CompressedStaticGraph<NodeIndexType, ArcIndexType>::Load(absl::string_view data,
+                                                         bool copy) {
+  constexpr int kMagicSize = sizeof(internal::kCompressedGraphMagic);
+  uint32_t index_sizes[2];
+  uint64_t sizes[3];
+  if (data.size() < kMagicSize + sizeof(index_sizes) + sizeof(sizes) ||
+      std::memcmp(data.data(), internal::kCompressedGraphMagic, kMagicSize) !=
+          0) {
+    return absl::InvalidArgumentError("Not a serialized compressed graph");
+  }
+  std::memcpy(index_sizes, data.data() + kMagicSize, sizeof(index_sizes));
+  std::memcpy(sizes, data.data() + kMagicSize + sizeof(index_sizes),
+              sizeof(sizes));
+  if (index_sizes[0] != sizeof(NodeIndexType) ||
+      index_sizes[1] != sizeof(ArcIndexType)) {
+    return absl::InvalidArgumentError(
+        "The serialized graph has different index types");
+  }
+  const auto [num_nodes, num_arcs, num_bytes] = sizes;
+  // Checks that the sizes can't overflow below, and fit in the index types.
+  constexpr uint64_t kMaxSize = uint64_t{1} << 56;
+  if (num_nodes >= kMaxSize || num_arcs >= kMaxSize || num_bytes >= kMaxSize ||
+      num_nodes > static_cast<uint64_t>(Base::kNilNode) ||
+      num_arcs > static_cast<uint64_t>(Base::kNilArc)) {
+    return absl::InvalidArgumentError("Invalid compressed graph sizes");
+  }
+  const uint64_t num_blocks = (num_arcs + kArcsPerBlock - 1) / kArcsPerBlock;
+  const uint64_t expected_size =
+      kMagicSize + sizeof(index_sizes) + sizeof(sizes) +
+      ((num_nodes + 1) * sizeof(ArcIndexType) + 7) / 8 * 8 +
+      (num_blocks + 1) * sizeof(uint64_t) + num_bytes;
+  if (data.size() != expected_size) {
+    return absl::InvalidArgumentError("Truncated or corrupted graph data");
+  }
+
+  CompressedStaticGraph graph;
+  if (copy) {
+    graph.owned_data_ = std::make_shared<const std::string>(data);
+    graph.data_ = *graph.owned_data_;
+  } else {
+    graph.data_ = data;
+  }
+  graph.SetViews();
+  graph.num_nodes_ = graph.node_capacity_ = num_nodes;
+  graph.num_arcs_ = graph.arc_capacity_ = num_arcs;
+  graph.is_built_ = true;
+  graph.FreezeCapacities();
+  if (absl::Status status = graph.Validate(); !status.ok()) return status;
+  return graph;
+}
+
+template <typename NodeIndexType, typename ArcIndexType>
+absl::Status CompressedStaticGraph<NodeIndexType, ArcIndexType>::Validate()
+    const {
+  if (start_.front() != 0 || start_.back() != num_arcs_) {
+    return absl::InvalidArgumentError("Invalid node starts");
+  }
+  for (NodeIndexType node = 0; node < num_nodes_; ++node) {
+    if (start_[node] > start_[node + 1]) {
+      return absl::InvalidArgumentError("Invalid node starts");
+    }
+  }
+  if (block_offset_.front() != 0 ||
+      block_offset_.back() != encoded_heads_.size()) {
+    return absl::InvalidArgumentError("Invalid block offsets");
+  }
+  const uint8_t* const begin = encoded_heads_.data();
+  for (size_t block = 0; block + 1 < block_offset_.size(); ++block) {
+    if (block_offset_[block] > block_offset_[block + 1]) {
+      return absl::InvalidArgumentError("Invalid block offsets");
+    }
+    const uint8_t* data = begin + block_offset_[block];
+    const uint8_t* const end = begin + block_offset_[block + 1];
+    const int64_t num_block_arcs =
+        std::min<int64_t>(kArcsPerBlock, num_arcs_ - block * kArcsPerBlock);
+    int64_t head = 0;
+    for (int64_t i = 0; i < num_block_arcs; ++i) {
+      uint64_t value;
+      data = internal::DecodeVarintChecked(data, end, value);
+      if (data == nullptr) {
+        return absl::InvalidArgumentError("Truncated encoded heads");
+      }
+      // Computes the new head without overflows.
+      const int64_t delta = i == 0 ? 0 : internal::ZigZagDecode(value);
+      if (i == 0 ? value >= static_cast<uint64_t>(num_nodes_)
+                 : delta < -head || delta >= num_nodes_ - head) {
+        return absl::InvalidArgumentError("Head out of range");
+      }
+      head = i == 0 ? static_cast<int64_t>(value) : head + delta;
+    }
+    if (data != end) return absl::InvalidArgumentError("Invalid block size");
+  }
+  return absl::OkStatus();
+}
+
+}  // namespace util
+
+#endif  // UTIL_GRAPH_COMPRESSED_GRAPH_H_
@@ -0,0 +1,283 @@
+// Copyright 2010-2024 Google LLC
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "ortools/graph/compressed_graph.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <random>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "absl/random/distributions.h"
+#include "absl/status/status.h"
+#include "gtest/gtest.h"
+#include "ortools/base/gmock.h"
+#include "ortools/graph/bounded_dijkstra.h"
+#include "ortools/graph/connected_components.h"
+#include "ortools/graph/graph.h"
+
+namespace util {
+namespace {
+
+using ::testing::ElementsAre;
+using ::testing::IsEmpty;
+
+template <typename Graph>
+std::vector<typename Graph::NodeIndex> Heads(const Graph& graph,
+                                             typename Graph::NodeIndex node) {
+  std::vector<typename Graph::NodeIndex> heads;
+  for (const auto head : graph[node]) heads.push_back(head);
+  return heads;
+}
+
+TEST(CompressedStaticGraphTest, SmallGraph) {
+  CompressedStaticGraph<> graph;
+  graph.AddArc(2, 0);
+  graph.AddArc(0, 3);
+  graph.AddArc(0, 1);
+  graph.AddArc(2, 2);
+  graph.AddNode(4);
+  std::vector<int32_t> permutation;
+  graph.Build(&permutation);
+  EXPECT_THAT(permutation, ElementsAre(2, 1, 0, 3));
+  EXPECT_EQ(graph.num_nodes(), 5);
+  EXPECT_EQ(graph.num_arcs(), 4);
+  EXPECT_EQ(graph.OutDegree(0), 2);
+  EXPECT_EQ(graph.OutDegree(1), 0);
+  EXPECT_THAT(Heads(graph, 0), ElementsAre(1, 3));
+  EXPECT_THAT(Heads(graph, 1), IsEmpty());
+  EXPECT_THAT(Heads(graph, 2), ElementsAre(0, 2));
+  EXPECT_THAT(Heads(graph, 4), IsEmpty());
+  std::vector<int32_t> arcs;
+  for (const int32_t arc : graph.OutgoingArcs(2)) arcs.push_back(arc);
+  EXPECT_THAT(arcs, ElementsAre(2, 3));
+  EXPECT_EQ(graph.Head(2), 0);
+  EXPECT_EQ(graph.Tail(2), 2);
+  EXPECT_EQ(graph.Tail(1), 0);
+}
+
+TEST(CompressedStaticGraphTest, EmptyGraph) {
+  CompressedStaticGraph<> graph;
+  graph.Build();
+  EXPECT_EQ(graph.num_nodes(), 0);
+  EXPECT_EQ(graph.num_arcs(), 0);
+  const absl::StatusOr<CompressedStaticGraph<>> reloaded =
+      CompressedStaticGraph<>::Deserialize(graph.Serialize());
+  ASSERT_TRUE(reloaded.ok()) << reloaded.status();
+  EXPECT_EQ(reloaded->num_nodes(), 0);
+}
+
+// Builds the same random graph, with far away heads to exercise the long
+// varints, as a StaticGraph<> and as a CompressedStaticGraph<>.
+template <typename NodeIndex, typename ArcIndex>
+void BuildRandomGraphs(NodeIndex num_nodes, ArcIndex num_arcs,
+                       std::mt19937& random,
+                       StaticGraph<NodeIndex, ArcIndex>& graph,
+                       std::vector<int64_t>& arc_lengths,
+                       CompressedStaticGraph<NodeIndex, ArcIndex>& compressed,
+                       std::vector<int64_t>& compressed_arc_lengths) {
+  graph = StaticGraph<NodeIndex, ArcIndex>(num_nodes, num_arcs);
+  compressed = CompressedStaticGraph<NodeIndex, ArcIndex>(num_nodes, num_arcs);
+  arc_lengths.clear();
+  for (ArcIndex arc = 0; arc < num_arcs; ++arc) {
+    const NodeIndex tail = absl::Uniform<NodeIndex>(random, 0, num_nodes);
+    const NodeIndex head =
+        absl::Bernoulli(random, 0.8)
+            ? std::min<NodeIndex>(num_nodes - 1,
+                                  tail + absl::Uniform<NodeIndex>(random, 0, 5))
+            : absl::Uniform<NodeIndex>(random, 0, num_nodes);
+    graph.AddArc(tail, head);
+    compressed.AddArc(tail, head);
+    arc_lengths.push_back(absl::Uniform(random, 0, 1000));
+  }
+  compressed_arc_lengths = arc_lengths;
+  std::vector<ArcIndex> permutation;
+  graph.Build(&permutation);
+  Permute(permutation, &arc_lengths);
+  compressed.Build(&permutation);
+  Permute(permutation, &compressed_arc_lengths);
+}
+
+template <typename NodeIndex, typename ArcIndex>
+void ExpectSameGraphs(
+    const StaticGraph<NodeIndex, ArcIndex>& graph,
+    const std::vector<int64_t>& arc_lengths,
+    const CompressedStaticGraph<NodeIndex, ArcIndex>& compressed,
+    const std::vector<int64_t>& compressed_arc_lengths) {
+  ASSERT_EQ(compressed.num_nodes(), graph.num_nodes());
+  ASSERT_EQ(compressed.num_arcs(), graph.num_arcs());
+  for (NodeIndex node = 0; node < graph.num_nodes(); ++node) {
+    ASSERT_EQ(compressed.OutDegree(node), graph.OutDegree(node));
+    // The arcs of a node are sorted by head in the compressed graph.
+    std::vector<std::pair<NodeIndex, int64_t>> arcs;
+    for (const ArcIndex arc : graph.OutgoingArcs(node)) {
+      arcs.push_back({graph.Head(arc), arc_lengths[arc]});
+    }
+    std::vector<std::pair<NodeIndex, int64_t>> compressed_arcs;
+    for (const ArcIndex arc : compressed.OutgoingArcs(node)) {
+      ASSERT_EQ(compressed.Tail(arc), node);
+      compressed_arcs.push_back(
+          {compressed.Head(arc), compressed_arc_lengths[arc]});
+    }
+    std::sort(arcs.begin(), arcs.end());
+    std::sort(compressed_arcs.begin(), compressed_arcs.end());
+    ASSERT_EQ(compressed_arcs, arcs);
+    std::vector<NodeIndex> heads;
+    for (const ArcIndex arc : compressed.OutgoingArcs(node)) {
+      heads.push_back(compressed.Head(arc));
+    }
+    ASSERT_EQ(Heads(compressed, node), heads);
+  }
+}
+
+TEST(CompressedStaticGraphTest, MatchesStaticGraph) {
+  std::mt19937 random(12345);
+  StaticGraph<> graph;
+  CompressedStaticGraph<> compressed;
+  std::vector<int64_t> arc_lengths;
+  std::vector<int64_t> compressed_arc_lengths;
+  for (const auto& [num_nodes, num_arcs] :
+       {std::pair{1, 0}, std::pair{1, 40}, std::pair{30, 100},
+        std::pair{1000, 5000}, std::pair{100000, 300000}}) {
+    BuildRandomGraphs(num_nodes, num_arcs, random, graph, arc_lengths,
+                      compressed, compressed_arc_lengths);
+    ExpectSameGraphs(graph, arc_lengths, compressed, compressed_arc_lengths);
+  }
+  // On this graph, whose arcs are mostly local, the compressed graph should be
+  // much smaller than the 8 bytes per arc of StaticGraph<>.
+  EXPECT_LT(compressed.Serialize().size(), 4 * compressed.num_arcs());
+}
+
+TEST(CompressedStaticGraphTest, Int64Indices) {
+  std::mt19937 random(42);
+  StaticGraph<int64_t, int64_t> graph;
+  CompressedStaticGraph<int64_t, int64_t> compressed;
+  std::vector<int64_t> arc_lengths;
+  std::vector<int64_t> compressed_arc_lengths;
+  BuildRandomGraphs<int64_t, int64_t>(3000, 10000, random, graph, arc_lengths,
+                                      compressed, compressed_arc_lengths);
+  ExpectSameGraphs(graph, arc_lengths, compressed, compressed_arc_lengths);
+}
+
+TEST(CompressedStaticGraphTest, SerializationRoundTrip) {
+  std::mt19937 random(7);
+  StaticGraph<> graph;
+  CompressedStaticGraph<> compressed;
+  std::vector<int64_t> arc_lengths;
+  std::vector<int64_t> compressed_arc_lengths;
+  BuildRandomGraphs(2000, 7000, random, graph, arc_lengths, compressed,
+                    compressed_arc_lengths);
+  const std::string data = compressed.Serialize();
+
+  absl::StatusOr<CompressedStaticGraph<>> reloaded =
+      CompressedStaticGraph<>::Deserialize(data);
+  ASSERT_TRUE(reloaded.ok()) << reloaded.status();
+  EXPECT_EQ(reloaded->Serialize(), data);
+  ExpectSameGraphs(graph, arc_lengths, *reloaded, compressed_arc_lengths);
+
+  // Copies, and the graphs viewing the data directly, share the same data.
+  const CompressedStaticGraph<> copy = *reloaded;
+  reloaded = absl::UnknownError("");
+  ExpectSameGraphs(graph, arc_lengths, copy, compressed_arc_lengths);
+  const absl::StatusOr<CompressedStaticGraph<>> view =
+      CompressedStaticGraph<>::View(data);
+  ASSERT_TRUE(view.ok()) << view.status();
+  ExpectSameGraphs(graph, arc_lengths, *view, compressed_arc_lengths);
+}
+
+TEST(CompressedStaticGraphTest, DeserializeRejectsInvalidData) {
+  std::mt19937 random(8);
+  StaticGraph<> graph;
+  CompressedStaticGraph<> compressed;
+  std::vector<int64_t> arc_lengths;
+  std::vector<int64_t> compressed_arc_lengths;
+  BuildRandomGraphs(100, 300, random, graph, arc_lengths, compressed,
+                    compressed_arc_lengths);
+  const std::string data = compressed.Serialize();
+
+  EXPECT_EQ(CompressedStaticGraph<>::Deserialize("garbage").status().code(),
+            absl::StatusCode::kInvalidArgument);
+  EXPECT_EQ(
+      CompressedStaticGraph<>::Deserialize(data.substr(0, data.size() - 1))
+          .status()
+          .code(),
+      absl::StatusCode::kInvalidArgument);
+  EXPECT_EQ((CompressedStaticGraph<int64_t, int64_t>::Deserialize(data)
+                 .status()
+                 .code()),
+            absl::StatusCode::kInvalidArgument);
+  // The head of the first arc, which follows the 40-byte header, the 101 node
+  // starts (padded to 408 bytes) and the 20 block offsets, is made out of
+  // range.
+  std::string corrupted = data;
+  corrupted[40 + 408 + 20 * 8] = static_cast<char>(0x7f);
+  EXPECT_EQ(CompressedStaticGraph<>::Deserialize(corrupted).status().code(),
+            absl::StatusCode::kInvalidArgument);
+  // A varint is made longer than its block.
+  corrupted = data;
+  corrupted.back() = static_cast<char>(0x81);
+  EXPECT_EQ(CompressedStaticGraph<>::Deserialize(corrupted).status().code(),
+            absl::StatusCode::kInvalidArgument);
+
+  // View() requires aligned data.
+  const std::string unaligned = " " + data;
+  EXPECT_EQ(
+      CompressedStaticGraph<>::View(absl::string_view(unaligned).substr(1))
+          .status()
+          .code(),
+      absl::StatusCode::kInvalidArgument);
+}
+
+TEST(CompressedStaticGraphTest, BoundedDijkstra) {
+  std::mt19937 random(1234);
+  StaticGraph<> graph;
+  CompressedStaticGraph<> compressed;
+  std::vector<int64_t> arc_lengths;
+  std::vector<int64_t> compressed_arc_lengths;
+  BuildRandomGraphs(1000, 4000, random, graph, arc_lengths, compressed,
+                    compressed_arc_lengths);
+  operations_research::BoundedDijkstraWrapper<StaticGraph<>, int64_t> dijkstra(
+      &graph, &arc_lengths);
+  operations_research::BoundedDijkstraWrapper<CompressedStaticGraph<>, int64_t>
+      compressed_dijkstra(&compressed, &compressed_arc_lengths);
+  for (int source = 0; source < 1000; source += 97) {
+    std::vector<int> reached = dijkstra.RunBoundedDijkstra(source, 5000);
+    std::vector<int> compressed_reached =
+        compressed_dijkstra.RunBoundedDijkstra(source, 5000);
+    std::sort(reached.begin(), reached.end());
+    std::sort(compressed_reached.begin(), compressed_reached.end());
+    ASSERT_EQ(compressed_reached, reached);
+    for (const int node : reached) {
+      ASSERT_EQ(compressed_dijkstra.distances()[node],
+                dijkstra.distances()[node]);
+    }
+  }
+}
+
+TEST(CompressedStaticGraphTest, ConnectedComponents) {
+  // 5--3--0--1  2--4, with both directions of each edge.
+  CompressedStaticGraph<> graph;
+  for (const auto& [a, b] : {std::pair{5, 3}, std::pair{3, 0}, std::pair{0, 1},
+                             std::pair{2, 4}}) {
+    graph.AddArc(a, b);
+    graph.AddArc(b, a);
+  }
+  graph.Build();
+  EXPECT_THAT(GetConnectedComponents(graph.num_nodes(), graph),
+              ElementsAre(0, 0, 1, 0, 1, 0));
+}
+
+}  // namespace
+}  // namespace util
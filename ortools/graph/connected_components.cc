@@ -30,7 +30,10 @@
 #include "ortools/graph/connected_components.h"
 
 #include <algorithm>
+#include <atomic>
+#include <memory>
 #include <numeric>
+#include <utility>
 #include <vector>
 
 #include "ortools/base/stl_util.h"
@@ -162,3 +165,73 @@ std::vector<int> DenseConnectedComponentsFinder::GetComponentIds() {
   }
   return component_ids;
 }
+
+ConcurrentConnectedComponentsFinder::ConcurrentConnectedComponentsFinder(
+    int num_nodes)
+    : num_nodes_(num_nodes),
+      parent_(std::make_unique<std::atomic<int>[]>(num_nodes)),
+      num_components_(num_nodes) {
+  CHECK_GE(num_nodes, 0);
+  for (int node = 0; node < num_nodes; ++node) {
+    parent_[node].store(node, std::memory_order_relaxed);
+  }
+}
+
+int ConcurrentConnectedComponentsFinder::FindRoot(int node) {
+  DCHECK_GE(node, 0);
+  DCHECK_LT(node, num_nodes_);
+  // Path halving. The parent of a non-root node can only be replaced by one of
+  // its ancestors, so the racy stores below never break the tree: at worst,
+  // they undo some of the halving done by another thread.
+  int parent = parent_[node].load(std::memory_order_relaxed);
+  while (parent != node) {
+    const int grand_parent = parent_[parent].load(std::memory_order_relaxed);
+    if (grand_parent == parent) return parent;
+    parent_[node].store(grand_parent, std::memory_order_relaxed);
+    node = grand_parent;
+    parent = parent_[node].load(std::memory_order_relaxed);
+  }
+  return node;
+}
+
+bool ConcurrentConnectedComponentsFinder::AddEdge(int node1, int node2) {
+  while (true) {
+    int root1 = FindRoot(node1);
+    int root2 = FindRoot(node2);
+    if (root1 == root2) return false;
+    if (root1 < root2) std::swap(root1, root2);
+    // Link root1 under root2, unless another thread attached it somewhere in
+    // the meantime, in which case we start over from the new roots.
+    int expected = root1;
+    if (parent_[root1].compare_exchange_strong(expected, root2,
+                                               std::memory_order_acq_rel)) {
+      num_components_.fetch_sub(1, std::memory_order_relaxed);
+      return true;
+    }
+  }
+}
+
+bool ConcurrentConnectedComponentsFinder::Connected(int node1, int node2) {
+  while (true) {
+    const int root1 = FindRoot(node1);
+    const int root2 = FindRoot(node2);
+    if (root1 == root2) return true;
+    // If root1 is still a root, then node1 and node2 were not connected when
+    // root2 was found. Otherwise root1 was merged concurrently: try again.
+    if (parent_[root1].load(std::memory_order_acquire) == root1) return false;
+  }
+}
+
+std::vector<int> ConcurrentConnectedComponentsFinder::GetComponentIds() {
+  std::vector<int> component_ids(num_nodes_, -1);
+  int current_component = 0;
+  for (int node = 0; node < num_nodes_; ++node) {
+    int& root_component = component_ids[FindRoot(node)];
+    if (root_component < 0) {
+      root_component = current_component;
+      ++current_component;
+    }
+    component_ids[node] = root_component;
+  }
+  return component_ids;
+}
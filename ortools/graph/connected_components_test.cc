@@ -0,0 +1,92 @@
+// Copyright 2010-2024 Google LLC
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "ortools/graph/connected_components.h"
+
+#include <random>
+#include <utility>
+#include <vector>
+
+#include "absl/random/distributions.h"
+#include "gtest/gtest.h"
+#include "ortools/base/gmock.h"
+#include "ortools/base/threadpool.h"
+
+namespace {
+
+using ::testing::ElementsAre;
+
+TEST(ConcurrentConnectedComponentsFinderTest, SmallGraph) {
+  ConcurrentConnectedComponentsFinder finder(6);
+  EXPECT_EQ(finder.GetNumberOfNodes(), 6);
+  EXPECT_EQ(finder.GetNumberOfComponents(), 6);
+  EXPECT_TRUE(finder.AddEdge(5, 3));
+  EXPECT_TRUE(finder.AddEdge(3, 0));
+  EXPECT_TRUE(finder.AddEdge(1, 0));
+  EXPECT_FALSE(finder.AddEdge(5, 1));
+  EXPECT_TRUE(finder.AddEdge(4, 2));
+  EXPECT_EQ(finder.GetNumberOfComponents(), 2);
+  EXPECT_TRUE(finder.Connected(1, 5));
+  EXPECT_FALSE(finder.Connected(1, 2));
+  EXPECT_EQ(finder.FindRoot(5), 0);
+  EXPECT_THAT(finder.GetComponentIds(), ElementsAre(0, 0, 1, 0, 1, 0));
+}
+
+TEST(ConcurrentConnectedComponentsFinderTest, ConcurrentEdgesMatchDense) {
+  std::mt19937 random(1234);
+  const int num_nodes = 100000;
+  std::vector<std::pair<int, int>> edges(num_nodes);
+  for (auto& [node1, node2] : edges) {
+    node1 = absl::Uniform(random, 0, num_nodes);
+    node2 = absl::Uniform(random, 0, num_nodes);
+  }
+  DenseConnectedComponentsFinder dense;
+  dense.SetNumberOfNodes(num_nodes);
+  for (const auto& [node1, node2] : edges) dense.AddEdge(node1, node2);
+
+  ConcurrentConnectedComponentsFinder finder(num_nodes);
+  operations_research::ThreadPool thread_pool("Test", 4);
+  thread_pool.StartWorkers();
+  std::vector<int> num_merges(4, 0);
+  operations_research::ParallelForEachItem(
+      &thread_pool, 4, edges.size(), [&](int worker, int64_t i) {
+        if (finder.AddEdge(edges[i].first, edges[i].second)) {
+          ++num_merges[worker];
+        }
+      });
+  EXPECT_EQ(finder.GetNumberOfComponents(), dense.GetNumberOfComponents());
+  EXPECT_EQ(num_merges[0] + num_merges[1] + num_merges[2] + num_merges[3],
+            num_nodes - dense.GetNumberOfComponents());
+  EXPECT_EQ(finder.GetComponentIds(), dense.GetComponentIds());
+}
+
+TEST(GetConnectedComponentsInParallelTest, MatchesBfs) {
+  std::mt19937 random(42);
+  for (const int num_nodes : {0, 1, 10, 50000}) {
+    std::vector<std::vector<int>> graph(num_nodes);
+    for (int i = 0; i < num_nodes; ++i) {
+      const int node1 = absl::Uniform(random, 0, num_nodes);
+      const int node2 = absl::Uniform(random, 0, num_nodes);
+      graph[node1].push_back(node2);
+      graph[node2].push_back(node1);
+    }
+    for (const int num_threads : {1, 4}) {
+      EXPECT_EQ(
+          util::GetConnectedComponentsInParallel(num_nodes, graph, num_threads),
+          util::GetConnectedComponents(num_nodes, graph))
+          << num_nodes;
+    }
+  }
+}
+
+}  // namespace
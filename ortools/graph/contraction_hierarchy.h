@@ -0,0 +1,714 @@
+// Copyright 2010-2024 Google LLC
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Contraction hierarchies, for answering many point-to-point shortest path
+// distance queries on the same graph, typically a road network.
+//
+// The preprocessing contracts the nodes one by one in some order (the "rank"
+// of a node is its position in that order). Contracting a node removes it from
+// the graph and adds "shortcut" arcs between its neighbors wherever the path
+// through the node is the only shortest path between them. A distance query
+// then only needs a bidirectional Dijkstra search restricted to arcs going
+// "up" in the hierarchy, which on road networks settles a few hundred nodes
+// instead of a sizable fraction of the graph: queries take microseconds
+// instead of milliseconds.
+//
+// Preprocessing cost: a few local Dijkstra searches ("witness searches",
+// bounded to `kMaxSettledNodesPerWitnessSearch` settled nodes each) per pair
+// of neighbors of each contracted node, and the same again to keep the
+// contraction priorities up to date. On road networks this is typically a
+// few seconds per million nodes and thread, and the hierarchy has at most
+// about twice as many arcs as the input graph. On graphs without a hierarchical
+// structure (e.g. dense or grid-like graphs with uniform lengths) the number of
+// shortcuts, and thus the preprocessing time and the query time, can grow a
+// lot, in which case `BidirectionalDijkstra` is a better choice.
+//
+// Example:
+//   util::StaticGraph<> graph = ...;
+//   std::vector<int64_t> arc_lengths = ...;
+//   const ContractionHierarchy<int64_t> hierarchy =
+//       ContractionHierarchy<int64_t>::Build(graph, arc_lengths,
+//                                            /*num_threads=*/8);
+//   // One query object per thread, each reusable for any number of queries.
+//   ContractionHierarchyQuery<int64_t> query(&hierarchy);
+//   const int64_t distance = query.Distance(source, destination);
+
+#ifndef OR_TOOLS_GRAPH_CONTRACTION_HIERARCHY_H_
+#define OR_TOOLS_GRAPH_CONTRACTION_HIERARCHY_H_
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <limits>
+#include <memory>
+#include <queue>
+#include <string>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "absl/log/check.h"
+#include "absl/status/status.h"
+#include "absl/status/statusor.h"
+#include "absl/strings/str_cat.h"
+#include "absl/strings/string_view.h"
+#include "absl/types/span.h"
+#include "ortools/base/threadpool.h"
+
+namespace operations_research {
+
+template <typename DistanceType>
+class ContractionHierarchyQuery;
+namespace internal {
+template <typename DistanceType>
+class ContractionHierarchyBuilder;
+}  // namespace internal
+
+// An immutable contraction hierarchy. `DistanceType` can be an integer or a
+// floating point type; arc lengths must be non-negative and small enough that
+// the length of any path doesn't overflow. Nodes are numbered from 0 to
+// `num_nodes() - 1`, like in the graph the hierarchy was built from.
+template <typename DistanceType>
+class ContractionHierarchy {
+ public:
+  // Returned by distance queries when there is no path.
+  static constexpr DistanceType kInfinity =
+      std::numeric_limits<DistanceType>::max();
+
+  // Witness searches give up (and add the shortcut, which is always correct
+  // but may be superfluous) after settling this many nodes.
+  static constexpr int kMaxSettledNodesPerWitnessSearch = 500;
+
+  // Builds the hierarchy of the directed `graph` with the given arc lengths
+  // (indexed by arc). `GraphType` is any graph of `ortools/graph/graph.h`, e.g.
+  // `util::StaticGraph<>` or `util::ReverseArcStaticGraph<>`. Parallel arcs are
+  // merged and self-loops ignored. The node ordering and the contractions use
+  // `num_threads` threads.
+  template <typename GraphType>
+  static ContractionHierarchy Build(const GraphType& graph,
+                                    absl::Span<const DistanceType> arc_lengths,
+                                    int num_threads = 1);
+
+  ContractionHierarchy() = default;
+
+  int32_t num_nodes() const { return static_cast<int32_t>(rank_.size()); }
+
+  // Number of arcs of the upward and downward search graphs, shortcuts
+  // included.
+  int64_t num_arcs() const {
+    return static_cast<int64_t>(upward_head_.size() + downward_tail_.size());
+  }
+
+  // The position of `node` in the contraction order.
+  int32_t Rank(int32_t node) const { return rank_[node]; }
+
+  // Returns a compact binary representation of the hierarchy, which is meant
+  // to be reloaded by `Deserialize()` on the same kind of machine (the arrays
+  // are stored with the native byte order).
+  std::string Serialize() const;
+
+  // Loads the output of `Serialize()`. Returns an `InvalidArgumentError` if
+  // `data` isn't a valid hierarchy for this `DistanceType`.
+  static absl::StatusOr<ContractionHierarchy> Deserialize(
+      absl::string_view data);
+
+  // The upward search graph: the arcs `node -> upward_head` of the graph (and
+  // shortcuts) such that `upward_head` has a higher rank, in compressed sparse
+  // row form indexed by tail.
+  absl::Span<const int64_t> UpwardStarts() const { return upward_start_; }
+  absl::Span<const int32_t> UpwardHeads() const { return upward_head_; }
+  absl::Span<const DistanceType> UpwardLengths() const {
+    return upward_length_;
+  }
+
+  // The downward search graph, reversed: the arcs `downward_tail -> node` of
+  // the graph (and shortcuts) such that `downward_tail` has a higher rank,
+  // indexed by `node`. Searching it from a node explores the paths that end at
+  // that node.
+  absl::Span<const int64_t> DownwardStarts() const { return downward_start_; }
+  absl::Span<const int32_t> DownwardTails() const { return downward_tail_; }
+  absl::Span<const DistanceType> DownwardLengths() const {
+    return downward_length_;
+  }
+
+ private:
+  friend class ContractionHierarchyQuery<DistanceType>;
+  friend class internal::ContractionHierarchyBuilder<DistanceType>;
+
+  // Checks the sizes and ranges of all the arrays, and that all arcs go up.
+  absl::Status Validate() const;
+
+  std::vector<int32_t> rank_;
+  std::vector<int64_t> upward_start_ = {0};
+  std::vector<int32_t> upward_head_;
+  std::vector<DistanceType> upward_length_;
+  std::vector<int64_t> downward_start_ = {0};
+  std::vector<int32_t> downward_tail_;
+  std::vector<DistanceType> downward_length_;
+};
+
+// Answers point-to-point distance queries on a `ContractionHierarchy`. A query
+// object is not thread-safe, but several query objects can share the same
+// hierarchy. Its working memory is O(`num_nodes()`), allocated once, and only
+// the part touched by a query is reset after it.
+template <typename DistanceType>
+class ContractionHierarchyQuery {
+ public:
+  // `hierarchy` must outlive this object.
+  explicit ContractionHierarchyQuery(
+      const ContractionHierarchy<DistanceType>* hierarchy);
+
+  // Returns the length of a shortest path from `from` to `to`, or
+  // `ContractionHierarchy<DistanceType>::kInfinity` if there is none.
+  DistanceType Distance(int32_t from, int32_t to);
+
+ private:
+  using HeapEntry = std::pair<DistanceType, int32_t>;
+  using MinHeap = std::priority_queue<HeapEntry, std::vector<HeapEntry>,
+                                      std::greater<HeapEntry>>;
+
+  // Settles the top node of `heap` in the given direction, and updates
+  // `best_distance` if the node was reached from the other direction.
+  void SettleTop(absl::Span<const int64_t> starts,
+                 absl::Span<const int32_t> heads,
+                 absl::Span<const DistanceType> lengths, MinHeap& heap,
+                 std::vector<DistanceType>& distance,
+                 const std::vector<DistanceType>& other_distance,
+                 DistanceType& best_distance);
+
+  const ContractionHierarchy<DistanceType>& hierarchy_;
+  std::vector<DistanceType> forward_distance_;
+  std::vector<DistanceType> backward_distance_;
+  std::vector<int32_t> touched_;
+  MinHeap forward_heap_;
+  MinHeap backward_heap_;
+};
+
+// Implementation.
+
+namespace internal {
+
+// The mutable graph being contracted, see `ContractionHierarchy::Build()`.
+template <typename DistanceType>
+class ContractionHierarchyBuilder {
+ public:
+  using Hierarchy = ContractionHierarchy<DistanceType>;
+
+  struct Edge {
+    int32_t node;
+    DistanceType length;
+  };
+
+  struct Shortcut {
+    int32_t tail;
+    int32_t head;
+    DistanceType length;
+  };
+
+  ContractionHierarchyBuilder(int32_t num_nodes, int num_threads)
+      : num_threads_(num_threads),
+        out_edges_(num_nodes),
+        in_edges_(num_nodes),
+        state_(num_nodes, kActive),
+        num_contracted_neighbors_(num_nodes, 0),
+        priority_(num_nodes, 0),
+        upward_edges_(num_nodes),
+        downward_edges_(num_nodes) {
+    if (num_threads_ > 1) {
+      thread_pool_ =
+          std::make_unique<ThreadPool>("ContractionHierarchy", num_threads_);
+      thread_pool_->StartWorkers();
+    }
+    workspaces_.resize(num_threads_);
+    for (WitnessSearchWorkspace& workspace : workspaces_) {
+      workspace.distance.assign(num_nodes, Hierarchy::kInfinity);
+    }
+  }
+
+  // Adds the arc `tail -> head`, or lowers the length of the existing one.
+  void AddOrImproveEdge(int32_t tail, int32_t head, DistanceType length) {
+    if (tail == head) return;
+    for (Edge& edge : out_edges_[tail]) {
+      if (edge.node == head) {
+        if (length < edge.length) {
+          edge.length = length;
+          for (Edge& reverse_edge : in_edges_[head]) {
+            if (reverse_edge.node == tail) reverse_edge.length = length;
+          }
+        }
+        return;
+      }
+    }
+    out_edges_[tail].push_back({head, length});
+    in_edges_[head].push_back({tail, length});
+  }
+
+  Hierarchy Contract();
+
+ private:
+  enum NodeState : char { kActive, kInBatch, kContracted };
+
+  struct WitnessSearchWorkspace {
+    std::vector<DistanceType> distance;
+    std::vector<int32_t> touched;
+    std::priority_queue<std::pair<DistanceType, int32_t>,
+                        std::vector<std::pair<DistanceType, int32_t>>,
+                        std::greater<std::pair<DistanceType, int32_t>>>
+        heap;
+  };
+
+  // Appends to `shortcuts` the shortcuts needed to contract `node`, which are
+  // the pairs of in and out neighbors without a witness path avoiding `node`
+  // and the nodes of the current batch.
+  void ComputeShortcuts(int32_t node, WitnessSearchWorkspace& workspace,
+                        std::vector<Shortcut>& shortcuts);
+
+  // The simulated edge difference of contracting `node`, plus the number of
+  // its already contracted neighbors, which spreads the contractions
+  // uniformly over the graph.
+  int64_t ComputePriority(int32_t node, WitnessSearchWorkspace& workspace);
+
+  // Returns true if `node` has a smaller priority than all its neighbors.
+  bool IsLocalMinimum(int32_t node) const;
+
+  void RemoveEdgesTo(std::vector<Edge>& edges, int32_t node) {
+    edges.erase(
+        std::remove_if(edges.begin(), edges.end(),
+                       [node](const Edge& e) { return e.node == node; }),
+        edges.end());
+  }
+
+  const int num_threads_;
+  std::unique_ptr<ThreadPool> thread_pool_;
+  std::vector<WitnessSearchWorkspace> workspaces_;
+  std::vector<std::vector<Edge>> out_edges_;
+  std::vector<std::vector<Edge>> in_edges_;
+  std::vector<NodeState> state_;
+  std::vector<int32_t> num_contracted_neighbors_;
+  std::vector<int64_t> priority_;
+  // The arcs of the final hierarchy, indexed by the contracted node.
+  std::vector<std::vector<Edge>> upward_edges_;
+  std::vector<std::vector<Edge>> downward_edges_;
+};
+
+template <typename DistanceType>
+void ContractionHierarchyBuilder<DistanceType>::ComputeShortcuts(
+    int32_t node, WitnessSearchWorkspace& workspace,
+    std::vector<Shortcut>& shortcuts) {
+  std::vector<DistanceType>& distance = workspace.distance;
+  for (const Edge& in_edge : in_edges_[node]) {
+    const int32_t source = in_edge.node;
+    bool has_target = false;
+    DistanceType max_length = 0;
+    for (const Edge& out_edge : out_edges_[node]) {
+      if (out_edge.node == source) continue;
+      has_target = true;
+      max_length = std::max(max_length, in_edge.length + out_edge.length);
+    }
+    if (!has_target) continue;
+
+    // Dijkstra from `source`, bounded by `max_length`.
+    distance[source] = 0;
+    workspace.touched.push_back(source);
+    workspace.heap.push({0, source});
+    int num_settled = 0;
+    while (!workspace.heap.empty() &&
+           num_settled < Hierarchy::kMaxSettledNodesPerWitnessSearch) {
+      const auto [d, u] = workspace.heap.top();
+      workspace.heap.pop();
+      if (d > distance[u]) continue;
+      if (d > max_length) break;
+      ++num_settled;
+      for (const Edge& edge : out_edges_[u]) {
+        const int32_t v = edge.node;
+        if (v == node || state_[v] != kActive) continue;
+        const DistanceType new_distance = d + edge.length;
+        if (new_distance < distance[v]) {
+          if (distance[v] == Hierarchy::kInfinity) {
+            workspace.touched.push_back(v);
+          }
+          distance[v] = new_distance;
+          workspace.heap.push({new_distance, v});
+        }
+      }
+    }
+    for (const Edge& out_edge : out_edges_[node]) {
+      const int32_t target = out_edge.node;
+      if (target == source) continue;
+      const DistanceType length = in_edge.length + out_edge.length;
+      if (distance[target] > length) {
+        shortcuts.push_back({source, target, length});
+      }
+    }
+    for (const int32_t u : workspace.touched) {
+      distance[u] = Hierarchy::kInfinity;
+    }
+    workspace.touched.clear();
+    workspace.heap = {};
+  }
+}
+
+template <typename DistanceType>
+int64_t ContractionHierarchyBuilder<DistanceType>::ComputePriority(
+    int32_t node, WitnessSearchWorkspace& workspace) {
+  std::vector<Shortcut> shortcuts;
+  ComputeShortcuts(node, workspace, shortcuts);
+  return static_cast<int64_t>(shortcuts.size()) -
+         static_cast<int64_t>(in_edges_[node].size() +
+                              out_edges_[node].size()) +
+         num_contracted_neighbors_[node];
+}
+
+template <typename DistanceType>
+bool ContractionHierarchyBuilder<DistanceType>::IsLocalMinimum(
+    int32_t node) const {
+  const auto key = std::make_pair(priority_[node], node);
+  for (const std::vector<Edge>* edges : {&out_edges_[node], &in_edges_[node]}) {
+    for (const Edge& edge : *edges) {
+      if (std::make_pair(priority_[edge.node], edge.node) < key) return false;
+    }
+  }
+  return true;
+}
+
+template <typename DistanceType>
+ContractionHierarchy<DistanceType>
+ContractionHierarchyBuilder<DistanceType>::Contract() {
+  const int32_t num_nodes = static_cast<int32_t>(out_edges_.size());
+  Hierarchy hierarchy;
+  hierarchy.rank_.assign(num_nodes, -1);
+
+  std::vector<int32_t> remaining(num_nodes);
+  for (int32_t node = 0; node < num_nodes; ++node) remaining[node] = node;
+  ParallelForEachItem(thread_pool_.get(), num_threads_, num_nodes,
+                      [&](int worker, int64_t i) {
+                        priority_[i] = ComputePriority(i, workspaces_[worker]);
+                      });
+
+  int32_t next_rank = 0;
+  std::vector<int32_t> batch;
+  std::vector<std::vector<Shortcut>> batch_shortcuts;
+  std::vector<int32_t> neighbors;
+  while (!remaining.empty()) {
+    // Nodes that are local minima are never adjacent, so they can be
+    // contracted independently as long as the witness searches avoid them.
+    batch.clear();
+    for (const int32_t node : remaining) {
+      if (IsLocalMinimum(node)) batch.push_back(node);
+    }
+    DCHECK(!batch.empty());
+    for (const int32_t node : batch) state_[node] = kInBatch;
+    batch_shortcuts.assign(batch.size(), {});
+    ParallelForEachItem(
+        thread_pool_.get(), num_threads_, batch.size(),
+        [&](int worker, int64_t i) {
+          ComputeShortcuts(batch[i], workspaces_[worker], batch_shortcuts[i]);
+        });
+
+    neighbors.clear();
+    for (const int32_t node : batch) {
+      hierarchy.rank_[node] = next_rank++;
+      state_[node] = kContracted;
+      for (const Edge& edge : out_edges_[node]) {
+        RemoveEdgesTo(in_edges_[edge.node], node);
+        ++num_contracted_neighbors_[edge.node];
+        neighbors.push_back(edge.node);
+      }
+      for (const Edge& edge : in_edges_[node]) {
+        RemoveEdgesTo(out_edges_[edge.node], node);
+        ++num_contracted_neighbors_[edge.node];
+        neighbors.push_back(edge.node);
+      }
+      upward_edges_[node] = std::move(out_edges_[node]);
+      downward_edges_[node] = std::move(in_edges_[node]);
+      out_edges_[node].clear();
+      in_edges_[node].clear();
+    }
+    for (const std::vector<Shortcut>& shortcuts : batch_shortcuts) {
+      for (const Shortcut& shortcut : shortcuts) {
+        AddOrImproveEdge(shortcut.tail, shortcut.head, shortcut.length);
+      }
+    }
+
+    // Only the priorities of the neighbors of the contracted nodes changed.
+    std::sort(neighbors.begin(), neighbors.end());
+    neighbors.erase(std::unique(neighbors.begin(), neighbors.end()),
+                    neighbors.end());
+    ParallelForEachItem(thread_pool_.get(), num_threads_, neighbors.size(),
+                        [&](int worker, int64_t i) {
+                          priority_[neighbors[i]] = ComputePriority(
+                              neighbors[i], workspaces_[worker]);
+                        });
+    remaining.erase(std::remove_if(remaining.begin(), remaining.end(),
+                                   [&](int32_t node) {
+                                     return state_[node] == kContracted;
+                                   }),
+                    remaining.end());
+  }
+
+  // Flattens the upward and downward graphs.
+  hierarchy.upward_start_.assign(1, 0);
+  hierarchy.downward_start_.assign(1, 0);
+  for (int32_t node = 0; node < num_nodes; ++node) {
+    for (const Edge& edge : upward_edges_[node]) {
+      hierarchy.upward_head_.push_back(edge.node);
+      hierarchy.upward_length_.push_back(edge.length);
+    }
+    for (const Edge& edge : downward_edges_[node]) {
+      hierarchy.downward_tail_.push_back(edge.node);
+      hierarchy.downward_length_.push_back(edge.length);
+    }
+    hierarchy.upward_start_.push_back(hierarchy.upward_head_.size());
+    hierarchy.downward_start_.push_back(hierarchy.downward_tail_.size());
+    std::vector<Edge>().swap(upward_edges_[node]);
+    std::vector<Edge>().swap(downward_edges_[node]);
+  }
+  return hierarchy;
+}
+
+}  // namespace internal
+
+template <typename DistanceType>
+template <typename GraphType>
+ContractionHierarchy<DistanceType> ContractionHierarchy<DistanceType>::Build(
+    const GraphType& graph, absl::Span<const DistanceType> arc_lengths,
+    int num_threads) {
+  CHECK_GE(num_threads, 1);
+  CHECK_LE(graph.num_nodes(), std::numeric_limits<int32_t>::max());
+  const int32_t num_nodes = static_cast<int32_t>(graph.num_nodes());
+  internal::ContractionHierarchyBuilder<DistanceType> builder(num_nodes,
+                                                              num_threads);
+  for (int32_t tail = 0; tail < num_nodes; ++tail) {
+    for (const auto arc : graph.OutgoingArcs(tail)) {
+      CHECK_LT(arc, arc_lengths.size());
+      const DistanceType length = arc_lengths[arc];
+      CHECK_GE(length, 0) << "Negative length on arc " << arc;
+      builder.AddOrImproveEdge(tail, graph.Head(arc), length);
+    }
+  }
+  return builder.Contract();
+}
+
+template <typename DistanceType>
+absl::Status ContractionHierarchy<DistanceType>::Validate() const {
+  const int64_t n = rank_.size();
+  if (upward_start_.size() != n + 1 || downward_start_.size() != n + 1 ||
+      upward_start_.front() != 0 || downward_start_.front() != 0 ||
+      upward_start_.back() != upward_head_.size() ||
+      downward_start_.back() != downward_tail_.size() ||
+      upward_head_.size() != upward_length_.size() ||
+      downward_tail_.size() != downward_length_.size()) {
+    return absl::InvalidArgumentError("Inconsistent hierarchy array sizes");
+  }
+  std::vector<bool> rank_used(n, false);
+  for (const int32_t rank : rank_) {
+    if (rank < 0 || rank >= n || rank_used[rank]) {
+      return absl::InvalidArgumentError("The ranks are not a permutation");
+    }
+    rank_used[rank] = true;
+  }
+  for (int64_t node = 0; node < n; ++node) {
+    for (const auto& [starts, nodes] :
+         {std::tie(upward_start_, upward_head_),
+          std::tie(downward_start_, downward_tail_)}) {
+      if (starts[node] > starts[node + 1]) {
+        return absl::InvalidArgumentError("Decreasing arc starts");
+      }
+      for (int64_t arc = starts[node]; arc < starts[node + 1]; ++arc) {
+        if (nodes[arc] < 0 || nodes[arc] >= n ||
+            rank_[nodes[arc]] <= rank_[node]) {
+          return absl::InvalidArgumentError(
+              absl::StrCat("Invalid hierarchy arc at node ", node));
+        }
+      }
+    }
+  }
+  return absl::OkStatus();
+}
+
+namespace internal {
+
+inline constexpr char kContractionHierarchyMagic[8] = {'O', 'R', 'C', 'H',
+                                                       'v', '1', 0,   0};
+
+template <typename T>
+void AppendArray(const std::vector<T>& values, std::string& output) {
+  const uint64_t size = values.size();
+  output.append(reinterpret_cast<const char*>(&size), sizeof(size));
+  output.append(reinterpret_cast<const char*>(values.data()),
+                values.size() * sizeof(T));
+}
+
+template <typename T>
+bool ReadArray(absl::string_view& input, std::vector<T>& values) {
+  uint64_t size;
+  if (input.size() < sizeof(size)) return false;
+  std::memcpy(&size, input.data(), sizeof(size));
+  input.remove_prefix(sizeof(size));
+  if (size > input.size() / sizeof(T)) return false;
+  values.resize(size);
+  std::memcpy(values.data(), input.data(), size * sizeof(T));
+  input.remove_prefix(size * sizeof(T));
+  return true;
+}
+
+}  // namespace internal
+
+template <typename DistanceType>
+std::string ContractionHierarchy<DistanceType>::Serialize() const {
+  static_assert(std::is_trivially_copyable_v<DistanceType>);
+  std::string output(internal::kContractionHierarchyMagic,
+                     sizeof(internal::kContractionHierarchyMagic));
+  const uint32_t distance_size = sizeof(DistanceType);
+  const uint32_t distance_is_integral = std::is_integral_v<DistanceType>;
+  output.append(reinterpret_cast<const char*>(&distance_size),
+                sizeof(distance_size));
+  output.append(reinterpret_cast<const char*>(&distance_is_integral),
+                sizeof(distance_is_integral));
+  internal::AppendArray(rank_, output);
+  internal::AppendArray(upward_start_, output);
+  internal::AppendArray(upward_head_, output);
+  internal::AppendArray(upward_length_, output);
+  internal::AppendArray(downward_start_, output);
+  internal::AppendArray(downward_tail_, output);
+  internal::AppendArray(downward_length_, output);
+  return output;
+}
+
+template <typename DistanceType>
+absl::StatusOr<ContractionHierarchy<DistanceType>>
+ContractionHierarchy<DistanceType>::Deserialize(absl::string_view data) {
+  constexpr int kMagicSize = sizeof(internal::kContractionHierarchyMagic);
+  if (data.size() < kMagicSize + 2 * sizeof(uint32_t) ||
+      std::memcmp(data.data(), internal::kContractionHierarchyMagic,
+                  kMagicSize) != 0) {
+    return absl::InvalidArgumentError("Not a serialized contraction hierarchy");
+  }
+  data.remove_prefix(kMagicSize);
+  uint32_t distance_size;
+  uint32_t distance_is_integral;
+  std::memcpy(&distance_size, data.data(), sizeof(distance_size));
+  data.remove_prefix(sizeof(distance_size));
+  std::memcpy(&distance_is_integral, data.data(), sizeof(distance_is_integral));
+  data.remove_prefix(sizeof(distance_is_integral));
+  if (distance_size != sizeof(DistanceType) ||
+      distance_is_integral != std::is_integral_v<DistanceType>) {
+    return absl::InvalidArgumentError(
+        "The serialized hierarchy has a different distance type");
+  }
+  ContractionHierarchy hierarchy;
+  if (!internal::ReadArray(data, hierarchy.rank_) ||
+      !internal::ReadArray(data, hierarchy.upward_start_) ||
+      !internal::ReadArray(data, hierarchy.upward_head_) ||
+      !internal::ReadArray(data, hierarchy.upward_length_) ||
+      !internal::ReadArray(data, hierarchy.downward_start_) ||
+      !internal::ReadArray(data, hierarchy.downward_tail_) ||
+      !internal::ReadArray(data, hierarchy.downward_length_) ||
+      !data.empty()) {
+    return absl::InvalidArgumentError("Truncated or corrupted hierarchy data");
+  }
+  if (absl::Status status = hierarchy.Validate(); !status.ok()) {
+    return status;
+  }
+  return hierarchy;
+}
+
+template <typename DistanceType>
+ContractionHierarchyQuery<DistanceType>::ContractionHierarchyQuery(
+    const ContractionHierarchy<DistanceType>* hierarchy)
+    : hierarchy_(*hierarchy),
+      forward_distance_(hierarchy->num_nodes(),
+                        ContractionHierarchy<DistanceType>::kInfinity),
+      backward_distance_(hierarchy->num_nodes(),
+                         ContractionHierarchy<DistanceType>::kInfinity) {}
+
+template <typename DistanceType>
+void ContractionHierarchyQuery<DistanceType>::SettleTop(
+    absl::Span<const int64_t> starts, absl::Span<const int32_t> heads,
+    absl::Span<const DistanceType> lengths, MinHeap& heap,
+    std::vector<DistanceType>& distance,
+    const std::vector<DistanceType>& other_distance,
+    DistanceType& best_distance) {
+  constexpr DistanceType kInfinity =
+      ContractionHierarchy<DistanceType>::kInfinity;
+  const auto [d, node] = heap.top();
+  heap.pop();
+  if (d > distance[node]) return;
+  if (d >= best_distance) {
+    // No path through the remaining nodes of this direction can be shorter.
+    heap = {};
+    return;
+  }
+  if (other_distance[node] != kInfinity) {
+    best_distance = std::min(best_distance, d + other_distance[node]);
+  }
+  for (int64_t arc = starts[node]; arc < starts[node + 1]; ++arc) {
+    const int32_t head = heads[arc];
+    const DistanceType new_distance = d + lengths[arc];
+    if (new_distance < distance[head]) {
+      if (forward_distance_[head] == kInfinity &&
+          backward_distance_[head] == kInfinity) {
+        touched_.push_back(head);
+      }
+      distance[head] = new_distance;
+      heap.push({new_distance, head});
+    }
+  }
+}
+
+template <typename DistanceType>
+DistanceType ContractionHierarchyQuery<DistanceType>::Distance(int32_t from,
+                                                               int32_t to) {
+  DCHECK_GE(from, 0);
+  DCHECK_LT(from, hierarchy_.num_nodes());
+  DCHECK_GE(to, 0);
+  DCHECK_LT(to, hierarchy_.num_nodes());
+  constexpr DistanceType kInfinity =
+      ContractionHierarchy<DistanceType>::kInfinity;
+  if (from == to) return 0;
+  DistanceType best_distance = kInfinity;
+  forward_distance_[from] = 0;
+  backward_distance_[to] = 0;
+  touched_.push_back(from);
+  touched_.push_back(to);
+  forward_heap_.push({0, from});
+  backward_heap_.push({0, to});
+  while (!forward_heap_.empty() || !backward_heap_.empty()) {
+    // Alternate by always advancing the direction with the smaller frontier.
+    const bool forward =
+        backward_heap_.empty() ||
+        (!forward_heap_.empty() &&
+         forward_heap_.top().first <= backward_heap_.top().first);
+    if (forward) {
+      SettleTop(hierarchy_.upward_start_, hierarchy_.upward_head_,
+                hierarchy_.upward_length_, forward_heap_, forward_distance_,
+                backward_distance_, best_distance);
+    } else {
+      SettleTop(hierarchy_.downward_start_, hierarchy_.downward_tail_,
+                hierarchy_.downward_length_, backward_heap_,
+                backward_distance_, forward_distance_, best_distance);
+    }
+  }
+  for (const int32_t node : touched_) {
+    forward_distance_[node] = kInfinity;
+    backward_distance_[node] = kInfinity;
+  }
+  touched_.clear();
+  return best_distance;
+}
+
+}  // namespace operations_research
+
+#endif  // OR_TOOLS_GRAPH_CONTRACTION_HIERARCHY_H_
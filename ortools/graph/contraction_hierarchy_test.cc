@@ -0,0 +1,199 @@
+// Copyright 2010-2024 Google LLC
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "ortools/graph/contraction_hierarchy.h"
+
+#include <cstdint>
+#include <functional>
+#include <queue>
+#include <random>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "absl/random/distributions.h"
+#include "absl/status/status.h"
+#include "gtest/gtest.h"
+#include "ortools/base/gmock.h"
+#include "ortools/graph/graph.h"
+
+namespace operations_research {
+namespace {
+
+using ::testing::HasSubstr;
+using ::util::ReverseArcStaticGraph;
+using ::util::StaticGraph;
+
+// Plain Dijkstra, used as a reference.
+std::vector<int64_t> AllDistancesFrom(const StaticGraph<>& graph,
+                                      const std::vector<int64_t>& arc_lengths,
+                                      int source) {
+  std::vector<int64_t> distance(graph.num_nodes(),
+                                ContractionHierarchy<int64_t>::kInfinity);
+  using Entry = std::pair<int64_t, int>;
+  std::priority_queue<Entry, std::vector<Entry>, std::greater<Entry>> heap;
+  distance[source] = 0;
+  heap.push({0, source});
+  while (!heap.empty()) {
+    const auto [d, node] = heap.top();
+    heap.pop();
+    if (d > distance[node]) continue;
+    for (const int arc : graph.OutgoingArcs(node)) {
+      const int64_t new_distance = d + arc_lengths[arc];
+      if (new_distance < distance[graph.Head(arc)]) {
+        distance[graph.Head(arc)] = new_distance;
+        heap.push({new_distance, graph.Head(arc)});
+      }
+    }
+  }
+  return distance;
+}
+
+// A random graph with a few parallel arcs, self-loops and zero lengths.
+StaticGraph<> RandomGraph(int num_nodes, int num_arcs, std::mt19937& random,
+                          std::vector<int64_t>& arc_lengths) {
+  StaticGraph<> graph(num_nodes, num_arcs);
+  arc_lengths.clear();
+  for (int i = 0; i < num_arcs; ++i) {
+    graph.AddArc(absl::Uniform(random, 0, num_nodes),
+                 absl::Uniform(random, 0, num_nodes));
+    arc_lengths.push_back(absl::Uniform(random, 0, 100));
+  }
+  std::vector<int> permutation;
+  graph.Build(&permutation);
+  util::Permute(permutation, &arc_lengths);
+  return graph;
+}
+
+TEST(ContractionHierarchyTest, SmallGraph) {
+  //   0 --5--> 1 --1--> 2
+  //   |                 ^
+  //   +--------7--------+      3 (isolated)
+  StaticGraph<> graph;
+  graph.AddArc(0, 1);
+  graph.AddArc(1, 2);
+  graph.AddArc(0, 2);
+  graph.AddNode(3);
+  std::vector<int> permutation;
+  graph.Build(&permutation);
+  std::vector<int64_t> arc_lengths = {5, 1, 7};
+  util::Permute(permutation, &arc_lengths);
+  const auto hierarchy =
+      ContractionHierarchy<int64_t>::Build(graph, arc_lengths);
+  EXPECT_EQ(hierarchy.num_nodes(), 4);
+  ContractionHierarchyQuery<int64_t> query(&hierarchy);
+  EXPECT_EQ(query.Distance(0, 2), 6);
+  EXPECT_EQ(query.Distance(0, 1), 5);
+  EXPECT_EQ(query.Distance(1, 1), 0);
+  EXPECT_EQ(query.Distance(2, 0), ContractionHierarchy<int64_t>::kInfinity);
+  EXPECT_EQ(query.Distance(0, 3), ContractionHierarchy<int64_t>::kInfinity);
+}
+
+TEST(ContractionHierarchyTest, ReverseArcStaticGraph) {
+  ReverseArcStaticGraph<> graph;
+  graph.AddArc(0, 1);
+  graph.AddArc(1, 0);
+  graph.AddArc(1, 2);
+  std::vector<int> permutation;
+  graph.Build(&permutation);
+  std::vector<double> arc_lengths = {1.5, 2.0, 0.25};
+  util::Permute(permutation, &arc_lengths);
+  const auto hierarchy =
+      ContractionHierarchy<double>::Build(graph, arc_lengths);
+  ContractionHierarchyQuery<double> query(&hierarchy);
+  EXPECT_EQ(query.Distance(0, 2), 1.75);
+  EXPECT_EQ(query.Distance(2, 1), ContractionHierarchy<double>::kInfinity);
+}
+
+class ContractionHierarchyRandomTest : public ::testing::TestWithParam<int> {};
+
+TEST_P(ContractionHierarchyRandomTest, MatchesDijkstra) {
+  const int num_threads = GetParam();
+  std::mt19937 random(12345);
+  for (const auto& [num_nodes, num_arcs] :
+       {std::pair{1, 0}, std::pair{10, 30}, std::pair{200, 600},
+        std::pair{1000, 2500}}) {
+    std::vector<int64_t> arc_lengths;
+    const StaticGraph<> graph =
+        RandomGraph(num_nodes, num_arcs, random, arc_lengths);
+    const auto hierarchy =
+        ContractionHierarchy<int64_t>::Build(graph, arc_lengths, num_threads);
+    ContractionHierarchyQuery<int64_t> query(&hierarchy);
+    for (int i = 0; i < 20; ++i) {
+      const int source = absl::Uniform(random, 0, num_nodes);
+      const std::vector<int64_t> expected =
+          AllDistancesFrom(graph, arc_lengths, source);
+      for (int target = 0; target < num_nodes; ++target) {
+        ASSERT_EQ(query.Distance(source, target), expected[target])
+            << "num_nodes=" << num_nodes << " source=" << source
+            << " target=" << target;
+      }
+    }
+  }
+}
+
+INSTANTIATE_TEST_SUITE_P(NumThreads, ContractionHierarchyRandomTest,
+                         ::testing::Values(1, 4));
+
+TEST(ContractionHierarchyTest, SerializationRoundTrip) {
+  std::mt19937 random(42);
+  std::vector<int64_t> arc_lengths;
+  const StaticGraph<> graph = RandomGraph(300, 900, random, arc_lengths);
+  const auto hierarchy =
+      ContractionHierarchy<int64_t>::Build(graph, arc_lengths);
+  const std::string data = hierarchy.Serialize();
+  const absl::StatusOr<ContractionHierarchy<int64_t>> reloaded =
+      ContractionHierarchy<int64_t>::Deserialize(data);
+  ASSERT_TRUE(reloaded.ok()) << reloaded.status();
+  EXPECT_EQ(reloaded->Serialize(), data);
+  ContractionHierarchyQuery<int64_t> query(&hierarchy);
+  ContractionHierarchyQuery<int64_t> reloaded_query(&*reloaded);
+  for (int i = 0; i < 100; ++i) {
+    const int source = absl::Uniform(random, 0, 300);
+    const int target = absl::Uniform(random, 0, 300);
+    EXPECT_EQ(reloaded_query.Distance(source, target),
+              query.Distance(source, target));
+  }
+}
+
+TEST(ContractionHierarchyTest, DeserializeRejectsInvalidData) {
+  std::mt19937 random(7);
+  std::vector<int64_t> arc_lengths;
+  const StaticGraph<> graph = RandomGraph(50, 150, random, arc_lengths);
+  const std::string data =
+      ContractionHierarchy<int64_t>::Build(graph, arc_lengths).Serialize();
+
+  EXPECT_EQ(
+      ContractionHierarchy<int64_t>::Deserialize("garbage").status().code(),
+      absl::StatusCode::kInvalidArgument);
+  EXPECT_EQ(ContractionHierarchy<int64_t>::Deserialize(
+                data.substr(0, data.size() - 1))
+                .status()
+                .code(),
+            absl::StatusCode::kInvalidArgument);
+  EXPECT_THAT(
+      ContractionHierarchy<int32_t>::Deserialize(data).status().message(),
+      HasSubstr("distance type"));
+
+  // The first rank, which follows the 16-byte header and the 8-byte size of
+  // the rank array, is made out of range.
+  std::string corrupted = data;
+  corrupted[24] = static_cast<char>(0x7f);
+  corrupted[27] = static_cast<char>(0x7f);
+  EXPECT_EQ(
+      ContractionHierarchy<int64_t>::Deserialize(corrupted).status().code(),
+      absl::StatusCode::kInvalidArgument);
+}
+
+}  // namespace
+}  // namespace operations_research
@@ -47,6 +47,7 @@
 %unignore operations_research::SimpleMaxFlow::~SimpleMaxFlow;
 %unignore operations_research::SimpleMaxFlow::AddArcWithCapacity;
 %unignore operations_research::SimpleMaxFlow::SetArcCapacity;
+%unignore operations_research::SimpleMaxFlow::SetNumThreads;
 %unignore operations_research::SimpleMaxFlow::Solve;
 %unignore operations_research::SimpleMaxFlow::NumNodes;
 %unignore operations_research::SimpleMaxFlow::NumArcs;
@@ -90,8 +91,11 @@
 %unignore operations_research::SimpleMinCostFlow::~SimpleMinCostFlow;
 %unignore operations_research::SimpleMinCostFlow::AddArcWithCapacityAndUnitCost;
 %unignore operations_research::SimpleMinCostFlow::SetNodeSupply;
+%unignore operations_research::SimpleMinCostFlow::SetArcCapacity;
+%unignore operations_research::SimpleMinCostFlow::SetArcUnitCost;
 %unignore operations_research::SimpleMinCostFlow::Solve;
 %unignore operations_research::SimpleMinCostFlow::SolveMaxFlowWithMinCost;
+%unignore operations_research::SimpleMinCostFlow::SolveFromLastSolution;
 %unignore operations_research::SimpleMinCostFlow::OptimalCost;
 %unignore operations_research::SimpleMinCostFlow::MaximumFlow;
 %unignore operations_research::SimpleMinCostFlow::Flow;
@@ -120,7 +124,10 @@
 %unignore
     operations_research::SimpleLinearSumAssignment::SimpleLinearSumAssignment;
 %unignore operations_research::SimpleLinearSumAssignment::AddArcWithCost;
+%unignore operations_research::SimpleLinearSumAssignment::SetArcCost;
+%unignore operations_research::SimpleLinearSumAssignment::SetNumThreads;
 %unignore operations_research::SimpleLinearSumAssignment::Solve;
+%unignore operations_research::SimpleLinearSumAssignment::SolveFromLastSolution;
 %unignore operations_research::SimpleLinearSumAssignment::NumNodes;
 %unignore operations_research::SimpleLinearSumAssignment::NumArcs;
 %unignore operations_research::SimpleLinearSumAssignment::LeftNode;
@@ -16,6 +16,7 @@
 
 #include <stdbool.h>
 
+#include <algorithm>
 #include <cmath>
 #include <limits>
 #include <vector>
@@ -132,8 +133,22 @@ class ConstrainedShortestPathsOnDagWrapper {
   // `destinations`.
   PathWithLength RunConstrainedShortestPathOnDag();
 
+  // Same as `RunConstrainedShortestPathOnDag()` after the lengths of
+  // `changed_arcs` were modified in `arc_lengths` since the last run. The
+  // labels of a node only depend on the arcs upstream of it (downstream for the
+  // backward search), so each half search restarts from its first node
+  // affected by a changed arc and keeps the labels of the nodes before it; a
+  // half search without changed arcs is not run at all. This is much faster
+  // than a new run when the changed arcs are all close to the sources or to
+  // the destinations. Falls back to a full run if there was no previous run or
+  // if it reached `max_num_created_labels`. `changed_arcs` may contain
+  // duplicates.
+  PathWithLength UpdateConstrainedShortestPathOnDag(
+      absl::Span<const ArcIndex> changed_arcs);
+
   // For benchmarking and informational purposes, returns the number of labels
-  // generated in the call of `RunConstrainedShortestPathOnDag()`.
+  // generated in the last run (including the ones kept from the previous run
+  // by `UpdateConstrainedShortestPathOnDag()`).
   int label_count() const {
     return lengths_from_sources_[FORWARD].size() +
            lengths_from_sources_[BACKWARD].size();
@@ -157,8 +172,17 @@ class ConstrainedShortestPathsOnDagWrapper {
     int label_index[2];
   };
 
-  void RunHalfConstrainedShortestPathOnDag(
-      const GraphType& reverse_graph, absl::Span<const double> arc_lengths,
+  // Runs both half searches from `first_node[dir]`, see
+  // `RunHalfConstrainedShortestPathOnDag()`, or not at all if it is the
+  // additional source node, then merges them.
+  PathWithLength RunFromNodes(const NodeIndex first_node[2]);
+
+  // Computes the labels of the nodes from `first_node` on, keeping the labels
+  // of the previous run for the nodes before it. Returns false if it stopped
+  // because of `max_num_created_labels`.
+  bool RunHalfConstrainedShortestPathOnDag(
+      NodeIndex first_node, const GraphType& reverse_graph,
+      absl::Span<const double> arc_lengths,
       absl::Span<const std::vector<double>> arc_resources,
       absl::Span<const std::vector<double>> min_arc_resources,
       absl::Span<const double> max_resources, int max_num_created_labels,
@@ -224,6 +248,9 @@ class ConstrainedShortestPathsOnDagWrapper {
   // `sub_reverse_graph[dir]`) and `arc` is the arc in the original graph (i.e.
   // `graph`).
   std::vector<NodeIndex> sub_full_arc_indices_[2];
+  // The inverse of `sub_full_arc_indices_[dir]`, with -1 for the arcs that are
+  // not in the reachable sub-graph for direction `dir`.
+  std::vector<ArcIndex> full_sub_arc_indices_[2];
   // `sub_node_indices_[dir]` has size `graph->num_nodes()` such that
   // `sub_node_indices[dir][node] = sub_node` where `node` is the node in the
   // original graph (i.e. `graph`) and `sub_node` is the node in the reachable
@@ -259,6 +286,10 @@ class ConstrainedShortestPathsOnDagWrapper {
   std::vector<ArcIndex> incoming_arc_indices_from_sources_[2];
   std::vector<int> node_first_label_[2];
   std::vector<int> node_num_labels_[2];
+  // The arc lengths of `sub_reverse_graph_[dir]` in the last run, and whether
+  // its half search went through all the nodes.
+  std::vector<double> sub_arc_lengths_[2];
+  bool half_run_is_complete_[2] = {false, false};
 };
 
 std::vector<int> GetInversePermutation(absl::Span<const int> permutation);
@@ -511,6 +542,14 @@ ConstrainedShortestPathsOnDagWrapper<GraphType>::
       util::Permute(sub_permutation, &sub_arc_resources_[dir][r]);
     }
     util::Permute(sub_permutation, &sub_full_arc_indices_[dir]);
+    full_sub_arc_indices_[dir].assign(num_arcs, -1);
+    for (ArcIndex sub_arc_index = 0;
+         sub_arc_index < sub_full_arc_indices_[dir].size(); ++sub_arc_index) {
+      const ArcIndex arc_index = sub_full_arc_indices_[dir][sub_arc_index];
+      if (arc_index != -1) {
+        full_sub_arc_indices_[dir][arc_index] = sub_arc_index;
+      }
+    }
   }
 
   // Memory allocation is done here and only once in order to avoid
@@ -530,39 +569,88 @@ template <class GraphType>
 PathWithLength ConstrainedShortestPathsOnDagWrapper<
     GraphType>::RunConstrainedShortestPathOnDag() {
   // Assign lengths on sub-relevant graphs.
-  std::vector<double> sub_arc_lengths[2];
   for (const Direction dir : {FORWARD, BACKWARD}) {
-    sub_arc_lengths[dir].reserve(sub_reverse_graph_[dir].num_arcs());
+    sub_arc_lengths_[dir].clear();
+    sub_arc_lengths_[dir].reserve(sub_reverse_graph_[dir].num_arcs());
     for (ArcIndex sub_arc_index = 0;
          sub_arc_index < sub_reverse_graph_[dir].num_arcs(); ++sub_arc_index) {
       const ArcIndex arc_index = sub_full_arc_indices_[dir][sub_arc_index];
       if (arc_index == -1) {
-        sub_arc_lengths[dir].push_back(0.0);
+        sub_arc_lengths_[dir].push_back(0.0);
         continue;
       }
-      sub_arc_lengths[dir].push_back((*arc_lengths_)[arc_index]);
+      sub_arc_lengths_[dir].push_back((*arc_lengths_)[arc_index]);
     }
   }
+  const NodeIndex first_node[2] = {0, 0};
+  return RunFromNodes(first_node);
+}
 
-  {
+template <class GraphType>
+#if __cplusplus >= 202002L
+  requires DagGraphType<GraphType>
+#endif
+PathWithLength ConstrainedShortestPathsOnDagWrapper<GraphType>::
+    UpdateConstrainedShortestPathOnDag(
+        absl::Span<const ArcIndex> changed_arcs) {
+  if (!half_run_is_complete_[FORWARD] || !half_run_is_complete_[BACKWARD]) {
+    return RunConstrainedShortestPathOnDag();
+  }
+  // The sub-graph nodes are indexed in the order in which they are visited by
+  // their half search, the additional source node being the last one.
+  NodeIndex first_node[2];
+  for (const Direction dir : {FORWARD, BACKWARD}) {
+    first_node[dir] = sub_reverse_graph_[dir].num_nodes() - 1;
+  }
+  for (const ArcIndex arc_index : changed_arcs) {
+    DCHECK((*arc_lengths_)[arc_index] !=
+               -std::numeric_limits<double>::infinity() &&
+           !std::isnan((*arc_lengths_)[arc_index]));
+    for (const Direction dir : {FORWARD, BACKWARD}) {
+      const ArcIndex sub_arc_index = full_sub_arc_indices_[dir][arc_index];
+      if (sub_arc_index == -1) continue;
+      sub_arc_lengths_[dir][sub_arc_index] = (*arc_lengths_)[arc_index];
+      first_node[dir] = std::min(
+          first_node[dir], sub_reverse_graph_[dir].Tail(sub_arc_index));
+    }
+  }
+  return RunFromNodes(first_node);
+}
+
+template <class GraphType>
+#if __cplusplus >= 202002L
+  requires DagGraphType<GraphType>
+#endif
+PathWithLength ConstrainedShortestPathsOnDagWrapper<GraphType>::RunFromNodes(
+    const NodeIndex first_node[2]) {
+  const auto run_half = [this, first_node](Direction dir) {
+    half_run_is_complete_[dir] = RunHalfConstrainedShortestPathOnDag(
+        /*first_node=*/first_node[dir],
+        /*reverse_graph=*/sub_reverse_graph_[dir],
+        /*arc_lengths=*/sub_arc_lengths_[dir],
+        /*arc_resources=*/sub_arc_resources_[dir],
+        /*min_arc_resources=*/sub_min_arc_resources_[dir],
+        /*max_resources=*/*max_resources_,
+        /*max_num_created_labels=*/max_num_created_labels_[dir],
+        /*lengths_from_sources=*/lengths_from_sources_[dir],
+        /*resources_from_sources=*/resources_from_sources_[dir],
+        /*incoming_arc_indices_from_sources=*/
+        incoming_arc_indices_from_sources_[dir],
+        /*first_label=*/node_first_label_[dir],
+        /*num_labels=*/node_num_labels_[dir]);
+  };
+  const bool needs_run[2] = {
+      first_node[FORWARD] < sub_reverse_graph_[FORWARD].num_nodes() - 1,
+      first_node[BACKWARD] < sub_reverse_graph_[BACKWARD].num_nodes() - 1};
+  if (needs_run[FORWARD] && needs_run[BACKWARD]) {
     ThreadPool search_threads(2);
     search_threads.StartWorkers();
     for (const Direction dir : {FORWARD, BACKWARD}) {
-      search_threads.Schedule([this, dir, &sub_arc_lengths]() {
-        RunHalfConstrainedShortestPathOnDag(
-            /*reverse_graph=*/sub_reverse_graph_[dir],
-            /*arc_lengths=*/sub_arc_lengths[dir],
-            /*arc_resources=*/sub_arc_resources_[dir],
-            /*min_arc_resources=*/sub_min_arc_resources_[dir],
-            /*max_resources=*/*max_resources_,
-            /*max_num_created_labels=*/max_num_created_labels_[dir],
-            /*lengths_from_sources=*/lengths_from_sources_[dir],
-            /*resources_from_sources=*/resources_from_sources_[dir],
-            /*incoming_arc_indices_from_sources=*/
-            incoming_arc_indices_from_sources_[dir],
-            /*first_label=*/node_first_label_[dir],
-            /*num_labels=*/node_num_labels_[dir]);
-      });
+      search_threads.Schedule([&run_half, dir]() { run_half(dir); });
+    }
+  } else {
+    for (const Direction dir : {FORWARD, BACKWARD}) {
+      if (needs_run[dir]) run_half(dir);
     }
   }
 
@@ -609,7 +697,7 @@ PathWithLength ConstrainedShortestPathsOnDagWrapper<
     for (const ArcIndex sub_arc_index : ArcPathTo(
              /*best_label_index=*/best_label_pair.label_index[dir],
              /*reverse_graph=*/sub_reverse_graph_[dir],
-             /*arc_lengths=*/sub_arc_lengths[dir],
+             /*arc_lengths=*/sub_arc_lengths_[dir],
              /*lengths_from_sources=*/lengths_from_sources_[dir],
              /*incoming_arc_indices_from_sources=*/
              incoming_arc_indices_from_sources_[dir],
@@ -627,14 +715,6 @@ PathWithLength ConstrainedShortestPathsOnDagWrapper<
     }
   }
 
-  // Clear all labels from the next run.
-  for (const Direction dir : {FORWARD, BACKWARD}) {
-    lengths_from_sources_[dir].clear();
-    for (int r = 0; r < num_resources_; ++r) {
-      resources_from_sources_[dir][r].clear();
-    }
-    incoming_arc_indices_from_sources_[dir].clear();
-  }
   return {.length = best_label_pair.length,
           .arc_path = arc_path,
           .node_path = NodePathImpliedBy(arc_path, *graph_)};
@@ -644,9 +724,10 @@ template <class GraphType>
 #if __cplusplus >= 202002L
   requires DagGraphType<GraphType>
 #endif
-void ConstrainedShortestPathsOnDagWrapper<GraphType>::
+bool ConstrainedShortestPathsOnDagWrapper<GraphType>::
     RunHalfConstrainedShortestPathOnDag(
-        const GraphType& reverse_graph, absl::Span<const double> arc_lengths,
+        const NodeIndex first_node, const GraphType& reverse_graph,
+        absl::Span<const double> arc_lengths,
         absl::Span<const std::vector<double>> arc_resources,
         absl::Span<const std::vector<double>> min_arc_resources,
         absl::Span<const double> max_resources,
@@ -655,22 +736,37 @@ void ConstrainedShortestPathsOnDagWrapper<GraphType>::
         std::vector<std::vector<double>>& resources_from_sources,
         std::vector<ArcIndex>& incoming_arc_indices_from_sources,
         std::vector<int>& first_label, std::vector<int>& num_labels) {
-  // Initialize source node.
   const NodeIndex source_node = reverse_graph.num_nodes() - 1;
-  first_label[source_node] = 0;
-  num_labels[source_node] = 1;
-  lengths_from_sources.push_back(0);
-  for (int r = 0; r < num_resources_; ++r) {
-    resources_from_sources[r].push_back(0);
+  if (first_node == 0) {
+    // Clear the labels of the previous run and initialize source node.
+    lengths_from_sources.clear();
+    for (int r = 0; r < num_resources_; ++r) {
+      resources_from_sources[r].clear();
+    }
+    incoming_arc_indices_from_sources.clear();
+    first_label[source_node] = 0;
+    num_labels[source_node] = 1;
+    lengths_from_sources.push_back(0);
+    for (int r = 0; r < num_resources_; ++r) {
+      resources_from_sources[r].push_back(0);
+    }
+    incoming_arc_indices_from_sources.push_back(-1);
+  } else {
+    // The labels are stored by increasing node, after the one of the source.
+    const int num_kept_labels = first_label[first_node];
+    lengths_from_sources.resize(num_kept_labels);
+    for (int r = 0; r < num_resources_; ++r) {
+      resources_from_sources[r].resize(num_kept_labels);
+    }
+    incoming_arc_indices_from_sources.resize(num_kept_labels);
   }
-  incoming_arc_indices_from_sources.push_back(-1);
 
   std::vector<double> lengths_to;
   std::vector<std::vector<double>> resources_to(num_resources_);
   std::vector<ArcIndex> incoming_arc_indices_to;
   std::vector<int> label_indices_to;
   std::vector<double> resources(num_resources_);
-  for (NodeIndex to = 0; to < source_node; ++to) {
+  for (NodeIndex to = first_node; to < source_node; ++to) {
     lengths_to.clear();
     for (int r = 0; r < num_resources_; ++r) {
       resources_to[r].clear();
@@ -755,10 +851,11 @@ void ConstrainedShortestPathsOnDagWrapper<GraphType>::
           incoming_arc_indices_to[label_i_index]);
       ++num_labels_to;
       if (lengths_from_sources.size() >= max_num_created_labels) {
-        return;
+        return false;
       }
     }
   }
+  return true;
 }
 
 template <class GraphType>
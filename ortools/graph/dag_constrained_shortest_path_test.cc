@@ -400,6 +400,57 @@ TEST(ConstrainedShortestPathsOnDagWrapperTest, UpdateArcsLength) {
                 /*node_path=*/ElementsAre(source, b, destination)));
 }
 
+TEST(ConstrainedShortestPathsOnDagWrapperTest,
+     UpdateConstrainedShortestPathOnDag) {
+  const int source = 0;
+  const int destination = 1;
+  const int a = 2;
+  const int b = 3;
+  const int num_nodes = 4;
+  util::ListGraph<> graph(num_nodes, /*arc_capacity=*/4);
+  std::vector<double> arc_lengths;
+  std::vector<std::vector<double>> arc_resources(1);
+  graph.AddArc(source, a);
+  arc_lengths.push_back(5.0);
+  arc_resources[0].push_back(1.0);
+  graph.AddArc(source, b);
+  arc_lengths.push_back(2.0);
+  arc_resources[0].push_back(4.0);
+  graph.AddArc(a, destination);
+  arc_lengths.push_back(3.0);
+  arc_resources[0].push_back(5.0);
+  graph.AddArc(b, destination);
+  arc_lengths.push_back(20.0);
+  arc_resources[0].push_back(2.0);
+  const std::vector<int> topological_order = {source, a, b, destination};
+  const std::vector<int> sources = {source};
+  const std::vector<int> destinations = {destination};
+  const std::vector<double> max_resources = {6.0};
+  ConstrainedShortestPathsOnDagWrapper<util::ListGraph<>>
+      constrained_shortest_path_on_dag(&graph, &arc_lengths, &arc_resources,
+                                       topological_order, sources, destinations,
+                                       &max_resources);
+
+  // Without a previous run, this is a full run.
+  EXPECT_THAT(
+      constrained_shortest_path_on_dag.UpdateConstrainedShortestPathOnDag({}),
+      FieldsAre(/*length=*/8.0, /*arc_path=*/ElementsAre(0, 2),
+                /*node_path=*/ElementsAre(source, a, destination)));
+
+  arc_lengths[3] = -1.0;
+  EXPECT_THAT(
+      constrained_shortest_path_on_dag.UpdateConstrainedShortestPathOnDag({3}),
+      FieldsAre(/*length=*/1.0, /*arc_path=*/ElementsAre(1, 3),
+                /*node_path=*/ElementsAre(source, b, destination)));
+
+  arc_lengths[1] = 10.0;
+  arc_lengths[0] = 1.0;
+  EXPECT_THAT(constrained_shortest_path_on_dag
+                  .UpdateConstrainedShortestPathOnDag({1, 0, 1}),
+              FieldsAre(/*length=*/4.0, /*arc_path=*/ElementsAre(0, 2),
+                        /*node_path=*/ElementsAre(source, a, destination)));
+}
+
 TEST(ConstrainedShortestPathsOnDagWrapperTest, LimitMaximumNumberOfLabels) {
   const int source = 0;
   const int destination = 1;
@@ -587,6 +638,55 @@ TEST(ConstrainedShortestPathsOnDagWrapperTest,
   }
 }
 
+TEST(ConstrainedShortestPathsOnDagWrapperTest,
+     RandomizedUpdatesMatchNewRuns) {
+  absl::BitGen bit_gen;
+  const int num_nodes = 60;
+  const int num_arcs = 400;
+  const auto [graph, topological_order] = BuildRandomDag(num_nodes, num_arcs);
+  std::vector<double> arc_lengths = GenerateRandomIntegerValues(graph);
+  std::vector<std::vector<double>> arc_resources(2);
+  for (std::vector<double>& resources : arc_resources) {
+    resources = GenerateRandomIntegerValues(graph, /*min_value=*/1.0,
+                                            /*max_value=*/10.0,
+                                            /*start_to_end_value=*/1.0);
+  }
+  const std::vector<int> sources = {0};
+  const std::vector<int> destinations = {num_nodes - 1};
+  const std::vector<double> max_resources = {25.0, 30.0};
+  ConstrainedShortestPathsOnDagWrapper<util::StaticGraph<>>
+      constrained_shortest_path_on_dag(&graph, &arc_lengths, &arc_resources,
+                                       topological_order, sources,
+                                       destinations, &max_resources);
+  constrained_shortest_path_on_dag.RunConstrainedShortestPathOnDag();
+  for (int iteration = 0; iteration < 50; ++iteration) {
+    std::vector<int> changed_arcs(absl::Uniform(bit_gen, 0, 5));
+    for (int& arc : changed_arcs) {
+      arc = absl::Uniform(bit_gen, 0, num_arcs);
+      arc_lengths[arc] = absl::Uniform<int>(bit_gen, -5, 10);
+    }
+    const PathWithLength path_with_length =
+        constrained_shortest_path_on_dag.UpdateConstrainedShortestPathOnDag(
+            changed_arcs);
+
+    ConstrainedShortestPathsOnDagWrapper<util::StaticGraph<>> expected(
+        &graph, &arc_lengths, &arc_resources, topological_order, sources,
+        destinations, &max_resources);
+    const PathWithLength expected_path_with_length =
+        expected.RunConstrainedShortestPathOnDag();
+    ASSERT_EQ(path_with_length.length, expected_path_with_length.length)
+        << iteration;
+    if (path_with_length.length == kInf) continue;
+    double path_length = 0.0;
+    for (const int arc : path_with_length.arc_path) {
+      path_length += arc_lengths[arc];
+    }
+    EXPECT_EQ(path_length, path_with_length.length);
+    EXPECT_EQ(path_with_length.node_path.front(), 0);
+    EXPECT_EQ(path_with_length.node_path.back(), num_nodes - 1);
+  }
+}
+
 // -----------------------------------------------------------------------------
 // Benchmark.
 // -----------------------------------------------------------------------------
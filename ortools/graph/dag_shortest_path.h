@@ -20,6 +20,7 @@
 #endif
 #include <functional>
 #include <limits>
+#include <queue>
 #include <vector>
 
 #include "absl/algorithm/container.h"
@@ -145,9 +146,23 @@ class ShortestPathsOnDagWrapper {
   // This must be called before any of the query functions below.
   void RunShortestPathOnDag(absl::Span<const NodeIndex> sources);
 
+  // Repairs the result of the last `RunShortestPathOnDag()` (or of this
+  // function) after the lengths of `changed_arcs` were modified in
+  // `arc_lengths`, keeping the same sources. Only the nodes downstream of a
+  // changed arc whose length is affected are visited, in topological order,
+  // each one by scanning its incoming arcs. This is much faster than a new run
+  // when few arcs change, e.g. between two pricing iterations of a column
+  // generation. `changed_arcs` may contain duplicates.
+  //
+  // The first call builds the list of incoming arcs of each node in
+  // O(|E| + |V|). The graph and the topological order must not be modified
+  // after that (the arc lengths and the sources of the runs can).
+  void UpdateShortestPathOnDag(absl::Span<const ArcIndex> changed_arcs);
+
   // Returns true if `node` is reachable from at least one source, i.e., the
   // length from at least one source is finite.
   bool IsReachable(NodeIndex node) const;
+  // The reachable nodes, in topological order.
   const std::vector<NodeIndex>& reached_nodes() const { return reached_nodes_; }
 
   // Returns the length of the shortest path from `node`'s source to `node`.
@@ -176,6 +191,19 @@ class ShortestPathsOnDagWrapper {
   std::vector<double> length_from_sources_;
   std::vector<ArcIndex> incoming_shortest_path_arc_;
   std::vector<NodeIndex> reached_nodes_;
+  std::vector<NodeIndex> sources_;
+
+  // Data only used by UpdateShortestPathOnDag(), built by its first call. The
+  // incoming arcs of `node` are
+  // `incoming_arcs_[incoming_arc_start_[node], incoming_arc_start_[node + 1])`.
+  std::vector<NodeIndex> topological_position_;
+  std::vector<ArcIndex> incoming_arc_start_;
+  std::vector<ArcIndex> incoming_arcs_;
+  std::vector<bool> is_source_;
+  // The nodes to visit, by topological position.
+  std::vector<bool> is_queued_;
+  std::priority_queue<NodeIndex, std::vector<NodeIndex>, std::greater<>>
+      queue_;
 };
 
 // A wrapper that holds the memory needed to run many k-shortest paths
@@ -408,7 +436,13 @@ void ShortestPathsOnDagWrapper<GraphType>::RunShortestPathOnDag(
   for (const NodeIndex source : sources) {
     CheckNodeIsValid(source, *graph_);
     length_from_sources[source] = 0.0;
+    incoming_shortest_path_arc_[source] = -1;
+  }
+  if (!is_source_.empty()) {
+    for (const NodeIndex source : sources_) is_source_[source] = false;
+    for (const NodeIndex source : sources) is_source_[source] = true;
   }
+  sources_.assign(sources.begin(), sources.end());
 
   for (const NodeIndex tail : topological_order_) {
     const double length_to_tail = length_from_sources[tail];
@@ -429,6 +463,95 @@ void ShortestPathsOnDagWrapper<GraphType>::RunShortestPathOnDag(
   }
 }
 
+template <class GraphType>
+#if __cplusplus >= 202002L
+  requires DagGraphType<GraphType>
+#endif
+void ShortestPathsOnDagWrapper<GraphType>::UpdateShortestPathOnDag(
+    absl::Span<const ArcIndex> changed_arcs) {
+  const NodeIndex num_nodes = graph_->num_nodes();
+  if (topological_position_.empty()) {
+    topological_position_.resize(num_nodes);
+    for (NodeIndex position = 0; position < num_nodes; ++position) {
+      topological_position_[topological_order_[position]] = position;
+    }
+    incoming_arc_start_.assign(num_nodes + 1, 0);
+    for (ArcIndex arc = 0; arc < graph_->num_arcs(); ++arc) {
+      ++incoming_arc_start_[graph_->Head(arc) + 1];
+    }
+    for (NodeIndex node = 0; node < num_nodes; ++node) {
+      incoming_arc_start_[node + 1] += incoming_arc_start_[node];
+    }
+    incoming_arcs_.resize(graph_->num_arcs());
+    std::vector<ArcIndex> next(incoming_arc_start_.begin(),
+                               incoming_arc_start_.end() - 1);
+    for (ArcIndex arc = 0; arc < graph_->num_arcs(); ++arc) {
+      incoming_arcs_[next[graph_->Head(arc)]++] = arc;
+    }
+    is_source_.assign(num_nodes, false);
+    for (const NodeIndex source : sources_) is_source_[source] = true;
+    is_queued_.assign(num_nodes, false);
+  }
+
+  const absl::Span<double> length_from_sources =
+      absl::MakeSpan(length_from_sources_);
+  const absl::Span<const double> arc_lengths = *arc_lengths_;
+  const auto enqueue = [this](NodeIndex node) {
+    if (is_queued_[node]) return;
+    is_queued_[node] = true;
+    queue_.push(topological_position_[node]);
+  };
+  // The length of a head can only change if the arc is now shorter than its
+  // shortest path, or if it was on its shortest path.
+  for (const ArcIndex arc : changed_arcs) {
+    DCHECK(arc_lengths[arc] != -kInf && !std::isnan(arc_lengths[arc]));
+    const NodeIndex tail = graph_->Tail(arc);
+    const NodeIndex head = graph_->Head(arc);
+    if (length_from_sources[tail] == kInf) continue;
+    if (incoming_shortest_path_arc_[head] == arc ||
+        length_from_sources[tail] + arc_lengths[arc] <
+            length_from_sources[head]) {
+      enqueue(head);
+    }
+  }
+
+  // Since the nodes are visited in topological order, the lengths of the tails
+  // of the incoming arcs of a node are final when it is visited.
+  bool reached_nodes_changed = false;
+  while (!queue_.empty()) {
+    const NodeIndex node = topological_order_[queue_.top()];
+    queue_.pop();
+    is_queued_[node] = false;
+    double length = is_source_[node] ? 0.0 : kInf;
+    ArcIndex incoming_arc = -1;
+    for (ArcIndex i = incoming_arc_start_[node];
+         i < incoming_arc_start_[node + 1]; ++i) {
+      const ArcIndex arc = incoming_arcs_[i];
+      const double length_through_arc =
+          length_from_sources[graph_->Tail(arc)] + arc_lengths[arc];
+      if (length_through_arc < length) {
+        length = length_through_arc;
+        incoming_arc = arc;
+      }
+    }
+    incoming_shortest_path_arc_[node] = incoming_arc;
+    if (length == length_from_sources[node]) continue;
+    if ((length == kInf) != (length_from_sources[node] == kInf)) {
+      reached_nodes_changed = true;
+    }
+    length_from_sources[node] = length;
+    for (const ArcIndex arc : graph_->OutgoingArcs(node)) {
+      enqueue(graph_->Head(arc));
+    }
+  }
+  if (reached_nodes_changed) {
+    reached_nodes_.clear();
+    for (const NodeIndex node : topological_order_) {
+      if (length_from_sources[node] < kInf) reached_nodes_.push_back(node);
+    }
+  }
+}
+
 template <class GraphType>
 #if __cplusplus >= 202002L
   requires DagGraphType<GraphType>
@@ -525,6 +525,96 @@ TEST(ShortestPathsOnDagWrapperTest, RandomizedStressTest) {
   }
 }
 
+TEST(ShortestPathsOnDagWrapperTest, UpdateShortestPathOnDag) {
+  const int source = 0;
+  const int destination = 1;
+  const int a = 2;
+  const int b = 3;
+  const int num_nodes = 4;
+  util::ListGraph<> graph(num_nodes, /*arc_capacity=*/4);
+  std::vector<double> arc_lengths;
+  graph.AddArc(source, a);
+  arc_lengths.push_back(5.0);
+  graph.AddArc(source, b);
+  arc_lengths.push_back(2.0);
+  graph.AddArc(a, destination);
+  arc_lengths.push_back(3.0);
+  graph.AddArc(b, destination);
+  arc_lengths.push_back(20.0);
+  const std::vector<int> topological_order = {source, a, b, destination};
+  ShortestPathsOnDagWrapper<util::ListGraph<>> shortest_path_on_dag(
+      &graph, &arc_lengths, topological_order);
+  shortest_path_on_dag.RunShortestPathOnDag({source});
+
+  // Update the length of arc b -> destination from 20.0 to -1.0.
+  arc_lengths[3] = -1.0;
+  shortest_path_on_dag.UpdateShortestPathOnDag({3});
+  EXPECT_THAT(shortest_path_on_dag.LengthTo(destination), 1.0);
+  EXPECT_THAT(shortest_path_on_dag.ArcPathTo(destination), ElementsAre(1, 3));
+
+  // Forbid the arc source -> b: the path goes back through a.
+  arc_lengths[1] = kInf;
+  shortest_path_on_dag.UpdateShortestPathOnDag({1});
+  EXPECT_FALSE(shortest_path_on_dag.IsReachable(b));
+  EXPECT_THAT(shortest_path_on_dag.LengthTo(destination), 8.0);
+  EXPECT_THAT(shortest_path_on_dag.ArcPathTo(destination), ElementsAre(0, 2));
+  EXPECT_THAT(shortest_path_on_dag.reached_nodes(),
+              ElementsAre(source, a, destination));
+
+  // Forbid the arc source -> a too.
+  arc_lengths[0] = kInf;
+  shortest_path_on_dag.UpdateShortestPathOnDag({0});
+  EXPECT_FALSE(shortest_path_on_dag.IsReachable(destination));
+  EXPECT_THAT(shortest_path_on_dag.reached_nodes(), ElementsAre(source));
+
+  // A new run from another source, then an update of an unreachable arc.
+  shortest_path_on_dag.RunShortestPathOnDag({b});
+  EXPECT_THAT(shortest_path_on_dag.LengthTo(destination), -1.0);
+  arc_lengths[0] = 1.0;
+  shortest_path_on_dag.UpdateShortestPathOnDag({0});
+  EXPECT_FALSE(shortest_path_on_dag.IsReachable(a));
+  EXPECT_THAT(shortest_path_on_dag.LengthTo(destination), -1.0);
+  EXPECT_THAT(shortest_path_on_dag.NodePathTo(destination),
+              ElementsAre(b, destination));
+}
+
+TEST(ShortestPathsOnDagWrapperTest, RandomizedUpdatesMatchNewRuns) {
+  absl::BitGen bit_gen;
+  const int num_nodes = 300;
+  const int num_arcs = 2000;
+  const auto [graph, topological_order] = BuildRandomDag(num_nodes, num_arcs);
+  std::vector<double> arc_lengths =
+      GenerateRandomLengths(graph, /*min_length=*/-3.0);
+  ShortestPathsOnDagWrapper<util::StaticGraph<>> shortest_path_on_dag(
+      &graph, &arc_lengths, topological_order);
+  const std::vector<int> sources = {0, topological_order[num_nodes / 3]};
+  shortest_path_on_dag.RunShortestPathOnDag(sources);
+  for (int iteration = 0; iteration < 100; ++iteration) {
+    std::vector<int> changed_arcs(absl::Uniform(bit_gen, 1, 20));
+    for (int& arc : changed_arcs) {
+      arc = absl::Uniform(bit_gen, 0, num_arcs);
+      arc_lengths[arc] = absl::Bernoulli(bit_gen, 0.1)
+                             ? kInf
+                             : absl::Uniform<int>(bit_gen, -3, 10);
+    }
+    shortest_path_on_dag.UpdateShortestPathOnDag(changed_arcs);
+
+    ShortestPathsOnDagWrapper<util::StaticGraph<>> expected(
+        &graph, &arc_lengths, topological_order);
+    expected.RunShortestPathOnDag(sources);
+    ASSERT_EQ(shortest_path_on_dag.LengthTo(), expected.LengthTo())
+        << iteration;
+    ASSERT_EQ(shortest_path_on_dag.reached_nodes(), expected.reached_nodes());
+    for (const int node : expected.reached_nodes()) {
+      double path_length = 0.0;
+      for (const int arc : shortest_path_on_dag.ArcPathTo(node)) {
+        path_length += arc_lengths[arc];
+      }
+      ASSERT_EQ(path_length, expected.LengthTo(node)) << node;
+    }
+  }
+}
+
 // Debug tests.
 #ifndef NDEBUG
 TEST(ShortestPathOnDagTest, MinusInfWeight) {
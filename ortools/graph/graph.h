@@ -42,6 +42,7 @@
 //   - ReverseArcListGraph<> to add reverse arcs to ListGraph<>
 //   - ReverseArcStaticGraph<> to add reverse arcs to StaticGraph<>
 //   - ReverseArcMixedGraph<> for a smaller memory footprint
+//   - CompressedStaticGraph<> of compressed_graph.h for huge immutable graphs
 //
 // Utility classes & functions:
 //   - Permute() to permute an array according to a given permutation.
@@ -163,6 +164,7 @@
 #include <limits>
 #include <new>
 #include <type_traits>
+#include <utility>
 #include <vector>
 
 #include "absl/base/port.h"
@@ -451,6 +453,16 @@ class StaticGraph : public BaseGraph<NodeIndexType, ArcIndexType, false> {
   void Build() { Build(nullptr); }
   void Build(std::vector<ArcIndexType>* permutation);
 
+  // Advanced usage, e.g. for the binary i/o of io.h. The arrays representing a
+  // built graph: the first arc of each node and the head of each arc. The
+  // FromBuiltArrays() inverse creates a built graph from them in linear time,
+  // without Build(). Its input must be valid, which is only checked in debug
+  // mode.
+  absl::Span<const ArcIndexType> BuiltStarts() const;
+  absl::Span<const NodeIndexType> BuiltHeads() const;
+  static StaticGraph FromBuiltArrays(std::vector<ArcIndexType> start,
+                                     std::vector<NodeIndexType> head);
+
  private:
   ArcIndexType DirectArcLimit(NodeIndexType node) const {
     DCHECK(is_built_);
@@ -627,6 +639,19 @@ class ReverseArcStaticGraph
   void Build() { Build(nullptr); }
   void Build(std::vector<ArcIndexType>* permutation);
 
+  // Advanced usage, e.g. for the binary i/o of io.h. The arrays representing a
+  // built graph: the first forward arc and the first reverse arc of each node,
+  // and the head and the opposite arc of each forward arc. As for
+  // StaticGraph<>, FromBuiltArrays() is the inverse, in linear time.
+  absl::Span<const ArcIndexType> BuiltStarts() const;
+  absl::Span<const ArcIndexType> BuiltReverseStarts() const;
+  absl::Span<const NodeIndexType> BuiltHeads() const;
+  absl::Span<const ArcIndexType> BuiltOpposites() const;
+  static ReverseArcStaticGraph FromBuiltArrays(
+      std::vector<ArcIndexType> start, std::vector<ArcIndexType> reverse_start,
+      absl::Span<const NodeIndexType> head,
+      absl::Span<const ArcIndexType> opposite);
+
  private:
   ArcIndexType DirectArcLimit(NodeIndexType node) const {
     DCHECK(is_built_);
@@ -1432,6 +1457,42 @@ void StaticGraph<NodeIndexType, ArcIndexType>::Build(
   }
 }
 
+template <typename NodeIndexType, typename ArcIndexType>
+absl::Span<const ArcIndexType>
+StaticGraph<NodeIndexType, ArcIndexType>::BuiltStarts() const {
+  DCHECK(is_built_);
+  return start_;
+}
+
+template <typename NodeIndexType, typename ArcIndexType>
+absl::Span<const NodeIndexType>
+StaticGraph<NodeIndexType, ArcIndexType>::BuiltHeads() const {
+  DCHECK(is_built_);
+  return head_;
+}
+
+template <typename NodeIndexType, typename ArcIndexType>
+StaticGraph<NodeIndexType, ArcIndexType>
+StaticGraph<NodeIndexType, ArcIndexType>::FromBuiltArrays(
+    std::vector<ArcIndexType> start, std::vector<NodeIndexType> head) {
+  StaticGraph graph;
+  graph.num_nodes_ = graph.node_capacity_ = start.size();
+  graph.num_arcs_ = graph.arc_capacity_ = head.size();
+  graph.FreezeCapacities();
+  graph.is_built_ = true;
+  graph.start_ = std::move(start);
+  graph.head_ = std::move(head);
+  graph.tail_.resize(graph.num_arcs_);
+  for (NodeIndexType node = 0; node < graph.num_nodes_; ++node) {
+    DCHECK_LE(graph.start_[node], graph.DirectArcLimit(node));
+    for (const ArcIndexType arc : graph.OutgoingArcs(node)) {
+      DCHECK(graph.IsNodeValid(graph.head_[arc]));
+      graph.tail_[arc] = node;
+    }
+  }
+  return graph;
+}
+
 template <typename NodeIndexType, typename ArcIndexType>
 class StaticGraph<NodeIndexType, ArcIndexType>::OutgoingArcIterator {
  public:
@@ -1847,6 +1908,68 @@ void ReverseArcStaticGraph<NodeIndexType, ArcIndexType>::Build(
   }
 }
 
+template <typename NodeIndexType, typename ArcIndexType>
+absl::Span<const ArcIndexType>
+ReverseArcStaticGraph<NodeIndexType, ArcIndexType>::BuiltStarts() const {
+  DCHECK(is_built_);
+  return start_;
+}
+
+template <typename NodeIndexType, typename ArcIndexType>
+absl::Span<const ArcIndexType>
+ReverseArcStaticGraph<NodeIndexType, ArcIndexType>::BuiltReverseStarts() const {
+  DCHECK(is_built_);
+  return reverse_start_;
+}
+
+template <typename NodeIndexType, typename ArcIndexType>
+absl::Span<const NodeIndexType>
+ReverseArcStaticGraph<NodeIndexType, ArcIndexType>::BuiltHeads() const {
+  DCHECK(is_built_);
+  return absl::Span<const NodeIndexType>(head_.data(), num_arcs_);
+}
+
+template <typename NodeIndexType, typename ArcIndexType>
+absl::Span<const ArcIndexType>
+ReverseArcStaticGraph<NodeIndexType, ArcIndexType>::BuiltOpposites() const {
+  DCHECK(is_built_);
+  return absl::Span<const ArcIndexType>(opposite_.data(), num_arcs_);
+}
+
+template <typename NodeIndexType, typename ArcIndexType>
+ReverseArcStaticGraph<NodeIndexType, ArcIndexType>
+ReverseArcStaticGraph<NodeIndexType, ArcIndexType>::FromBuiltArrays(
+    std::vector<ArcIndexType> start, std::vector<ArcIndexType> reverse_start,
+    absl::Span<const NodeIndexType> head,
+    absl::Span<const ArcIndexType> opposite) {
+  DCHECK_EQ(start.size(), reverse_start.size());
+  DCHECK_EQ(head.size(), opposite.size());
+  ReverseArcStaticGraph graph;
+  graph.num_nodes_ = graph.node_capacity_ = start.size();
+  graph.num_arcs_ = graph.arc_capacity_ = head.size();
+  graph.FreezeCapacities();
+  graph.is_built_ = true;
+  graph.start_ = std::move(start);
+  graph.reverse_start_ = std::move(reverse_start);
+  graph.head_.resize(graph.num_arcs_);
+  graph.opposite_.resize(graph.num_arcs_);
+  std::copy(head.begin(), head.end(), graph.head_.data());
+  std::copy(opposite.begin(), opposite.end(), graph.opposite_.data());
+  // Fills the reverse arcs, as in Build().
+  for (ArcIndexType arc = 0; arc < graph.num_arcs_; ++arc) {
+    DCHECK(graph.IsNodeValid(head[arc]));
+    DCHECK_LT(opposite[arc], 0);
+    DCHECK_GE(opposite[arc], -graph.num_arcs_);
+    graph.opposite_[opposite[arc]] = arc;
+  }
+  for (NodeIndexType node = 0; node < graph.num_nodes_; ++node) {
+    for (const ArcIndexType arc : graph.OutgoingArcs(node)) {
+      graph.head_[graph.opposite_[arc]] = node;
+    }
+  }
+  return graph;
+}
+
 template <typename NodeIndexType, typename ArcIndexType>
 class ReverseArcStaticGraph<NodeIndexType, ArcIndexType>::OutgoingArcIterator {
  public:
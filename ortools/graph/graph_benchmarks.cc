@@ -0,0 +1,267 @@
+// Copyright 2010-2024 Google LLC
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Benchmarks of the main graph algorithms on the random graphs of
+// random_graph.h, at several scales. All the graphs have an average out-degree
+// of kAverageDegree, and the argument of each benchmark is the number of
+// nodes. The random seeds are fixed, so the instances are the same across
+// runs and versions.
+
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <random>
+#include <utility>
+#include <vector>
+
+#include "absl/random/distributions.h"
+#include "benchmark/benchmark.h"
+#include "ortools/base/logging.h"
+#include "ortools/graph/bidirectional_dijkstra.h"
+#include "ortools/graph/bounded_dijkstra.h"
+#include "ortools/graph/graph.h"
+#include "ortools/graph/linear_assignment.h"
+#include "ortools/graph/max_flow.h"
+#include "ortools/graph/min_cost_flow.h"
+#include "ortools/graph/multi_dijkstra.h"
+#include "ortools/graph/random_graph.h"
+
+namespace operations_research {
+namespace {
+
+constexpr int kAverageDegree = 8;
+constexpr int64_t kMaxArcLength = 1000;
+
+// The scales of the benchmarks, in number of nodes.
+void GraphSizes(benchmark::internal::Benchmark* benchmark) {
+  benchmark->Arg(1 << 10)->Arg(1 << 14)->Arg(1 << 18);
+}
+
+std::unique_ptr<util::StaticGraph<>> RandomGraph(int num_nodes) {
+  std::mt19937 random(12345);
+  return util::GenerateRandomDirectedSimpleGraph(
+      num_nodes, num_nodes * kAverageDegree, /*finalized=*/true, random);
+}
+
+std::vector<int64_t> RandomArcLengths(int num_arcs) {
+  std::mt19937 random(67890);
+  std::vector<int64_t> arc_lengths(num_arcs);
+  for (int64_t& length : arc_lengths) {
+    length = absl::Uniform<int64_t>(random, 1, kMaxArcLength + 1);
+  }
+  return arc_lengths;
+}
+
+// Returns the arcs of RandomGraph(num_nodes) in a graph with reverse arcs, as
+// needed by the flow algorithms.
+std::unique_ptr<util::ReverseArcStaticGraph<>> RandomReverseArcGraph(
+    int num_nodes) {
+  const std::unique_ptr<util::StaticGraph<>> graph = RandomGraph(num_nodes);
+  auto reverse_arc_graph = std::make_unique<util::ReverseArcStaticGraph<>>(
+      graph->num_nodes(), graph->num_arcs());
+  for (const int arc : graph->AllForwardArcs()) {
+    reverse_arc_graph->AddArc(graph->Tail(arc), graph->Head(arc));
+  }
+  reverse_arc_graph->Build();
+  return reverse_arc_graph;
+}
+
+void BM_StaticGraphBuild(benchmark::State& state) {
+  const int num_nodes = state.range(0);
+  const int num_arcs = num_nodes * kAverageDegree;
+  std::mt19937 random(12345);
+  std::vector<std::pair<int, int>> arcs(num_arcs);
+  for (auto& [tail, head] : arcs) {
+    tail = absl::Uniform(random, 0, num_nodes);
+    head = absl::Uniform(random, 0, num_nodes);
+  }
+  for (auto _ : state) {
+    util::StaticGraph<> graph(num_nodes, num_arcs);
+    for (const auto& [tail, head] : arcs) graph.AddArc(tail, head);
+    std::vector<int> permutation;
+    graph.Build(&permutation);
+    benchmark::DoNotOptimize(graph);
+  }
+  state.SetItemsProcessed(state.iterations() * num_arcs);
+}
+
+BENCHMARK(BM_StaticGraphBuild)->Apply(GraphSizes);
+
+void BM_BoundedDijkstra(benchmark::State& state) {
+  const int num_nodes = state.range(0);
+  const std::unique_ptr<util::StaticGraph<>> graph = RandomGraph(num_nodes);
+  const std::vector<int64_t> arc_lengths = RandomArcLengths(graph->num_arcs());
+  BoundedDijkstraWrapper<util::StaticGraph<>, int64_t> dijkstra(graph.get(),
+                                                                &arc_lengths);
+  std::mt19937 random(12345);
+  int64_t num_settled_nodes = 0;
+  for (auto _ : state) {
+    const int source = absl::Uniform(random, 0, num_nodes);
+    num_settled_nodes +=
+        dijkstra
+            .RunBoundedDijkstra(source,
+                                std::numeric_limits<int64_t>::max() / 2)
+            .size();
+  }
+  state.SetItemsProcessed(num_settled_nodes);
+}
+
+BENCHMARK(BM_BoundedDijkstra)->Apply(GraphSizes);
+
+void BM_BidirectionalDijkstra(benchmark::State& state) {
+  const int num_nodes = state.range(0);
+  const std::unique_ptr<util::StaticGraph<>> graph = RandomGraph(num_nodes);
+  const std::vector<int64_t> arc_lengths = RandomArcLengths(graph->num_arcs());
+
+  // The backward search needs the reverse graph, with the same arc lengths.
+  util::StaticGraph<> reverse_graph(num_nodes, graph->num_arcs());
+  for (const int arc : graph->AllForwardArcs()) {
+    reverse_graph.AddArc(graph->Head(arc), graph->Tail(arc));
+  }
+  std::vector<int> permutation;
+  reverse_graph.Build(&permutation);
+  std::vector<int64_t> reverse_arc_lengths(graph->num_arcs());
+  for (const int arc : graph->AllForwardArcs()) {
+    const int reverse_arc = permutation.empty() ? arc : permutation[arc];
+    reverse_arc_lengths[reverse_arc] = arc_lengths[arc];
+  }
+
+  BidirectionalDijkstra<util::StaticGraph<>, int64_t> dijkstra(
+      graph.get(), &arc_lengths, &reverse_graph, &reverse_arc_lengths);
+  std::mt19937 random(12345);
+  for (auto _ : state) {
+    const int from = absl::Uniform(random, 0, num_nodes);
+    const int to = absl::Uniform(random, 0, num_nodes);
+    benchmark::DoNotOptimize(dijkstra.OneToOneShortestPath(from, to));
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+
+BENCHMARK(BM_BidirectionalDijkstra)->Apply(GraphSizes);
+
+void BM_MultiDijkstra(benchmark::State& state) {
+  constexpr int kNumSources = 8;
+  constexpr int kNumSettledNodesPerSource = 1000;
+  const int num_nodes = state.range(0);
+  const std::unique_ptr<util::StaticGraph<>> graph = RandomGraph(num_nodes);
+  const std::vector<int64_t> arc_lengths = RandomArcLengths(graph->num_arcs());
+  std::mt19937 random(12345);
+  for (auto _ : state) {
+    std::vector<std::vector<int>> source_sets(kNumSources);
+    for (std::vector<int>& sources : source_sets) {
+      sources.push_back(absl::Uniform(random, 0, num_nodes));
+    }
+    std::vector<int> num_settled_nodes(kNumSources, 0);
+    benchmark::DoNotOptimize(MultiDijkstra<int64_t>(
+        *graph, [&arc_lengths](int arc) { return arc_lengths[arc]; },
+        source_sets,
+        [&num_settled_nodes](int /*node*/, int source, int64_t /*distance*/) {
+          return ++num_settled_nodes[source] >= kNumSettledNodesPerSource;
+        }));
+  }
+  state.SetItemsProcessed(state.iterations() * kNumSources);
+}
+
+BENCHMARK(BM_MultiDijkstra)->Apply(GraphSizes);
+
+void BM_GenericMaxFlow(benchmark::State& state) {
+  using Graph = util::ReverseArcStaticGraph<>;
+  const int num_nodes = state.range(0);
+  const std::unique_ptr<Graph> graph = RandomReverseArcGraph(num_nodes);
+  std::mt19937 random(12345);
+  std::vector<int64_t> capacities(graph->num_arcs());
+  for (int64_t& capacity : capacities) {
+    capacity = absl::Uniform<int64_t>(random, 1, 1001);
+  }
+  for (auto _ : state) {
+    GenericMaxFlow<Graph> max_flow(graph.get(), /*source=*/0,
+                                   /*sink=*/num_nodes - 1);
+    for (int arc = 0; arc < graph->num_arcs(); ++arc) {
+      max_flow.SetArcCapacity(arc, capacities[arc]);
+    }
+    CHECK(max_flow.Solve());
+    benchmark::DoNotOptimize(max_flow.GetOptimalFlow());
+  }
+  state.SetItemsProcessed(state.iterations() * graph->num_arcs());
+}
+
+BENCHMARK(BM_GenericMaxFlow)->Apply(GraphSizes);
+
+void BM_GenericMinCostFlow(benchmark::State& state) {
+  using Graph = util::ReverseArcStaticGraph<>;
+  const int num_nodes = state.range(0);
+  const std::unique_ptr<Graph> graph = RandomReverseArcGraph(num_nodes);
+  std::mt19937 random(12345);
+  std::vector<int64_t> capacities(graph->num_arcs());
+  std::vector<int64_t> unit_costs(graph->num_arcs());
+  for (int arc = 0; arc < graph->num_arcs(); ++arc) {
+    capacities[arc] = absl::Uniform<int64_t>(random, 1, 101);
+    unit_costs[arc] = absl::Uniform<int64_t>(random, 0, 1001);
+  }
+  // A few sources and sinks, with supplies small enough for the problem to be
+  // feasible on almost all these well connected graphs. An infeasible problem
+  // is still a valid benchmark, so the status is not checked.
+  constexpr int kNumSupplyNodes = 16;
+  constexpr int64_t kSupply = 10;
+  for (auto _ : state) {
+    GenericMinCostFlow<Graph> min_cost_flow(graph.get());
+    for (int arc = 0; arc < graph->num_arcs(); ++arc) {
+      min_cost_flow.SetArcCapacity(arc, capacities[arc]);
+      min_cost_flow.SetArcUnitCost(arc, unit_costs[arc]);
+    }
+    for (int i = 0; i < kNumSupplyNodes; ++i) {
+      min_cost_flow.SetNodeSupply(i, kSupply);
+      min_cost_flow.SetNodeSupply(num_nodes - 1 - i, -kSupply);
+    }
+    benchmark::DoNotOptimize(min_cost_flow.Solve());
+  }
+  state.SetItemsProcessed(state.iterations() * graph->num_arcs());
+}
+
+BENCHMARK(BM_GenericMinCostFlow)->Apply(GraphSizes);
+
+void BM_LinearSumAssignment(benchmark::State& state) {
+  using Graph = util::StaticGraph<>;
+  const int num_left_nodes = state.range(0) / 2;
+  const int num_arcs = num_left_nodes * kAverageDegree;
+  std::mt19937 random(12345);
+  Graph graph(2 * num_left_nodes, num_arcs + num_left_nodes);
+  std::vector<int64_t> arc_costs;
+  for (int i = 0; i < num_arcs; ++i) {
+    graph.AddArc(absl::Uniform(random, 0, num_left_nodes),
+                 num_left_nodes + absl::Uniform(random, 0, num_left_nodes));
+    arc_costs.push_back(absl::Uniform<int64_t>(random, 0, 1000000));
+  }
+  // Makes sure that there is a perfect matching.
+  for (int left = 0; left < num_left_nodes; ++left) {
+    graph.AddArc(left, num_left_nodes + left);
+    arc_costs.push_back(1000000);
+  }
+  std::vector<int> permutation;
+  graph.Build(&permutation);
+  util::Permute(permutation, &arc_costs);
+  for (auto _ : state) {
+    LinearSumAssignment<Graph> assignment(graph, num_left_nodes);
+    for (int arc = 0; arc < graph.num_arcs(); ++arc) {
+      assignment.SetArcCost(arc, arc_costs[arc]);
+    }
+    CHECK(assignment.ComputeAssignment());
+    benchmark::DoNotOptimize(assignment.GetCost());
+  }
+  state.SetItemsProcessed(state.iterations() * graph.num_arcs());
+}
+
+BENCHMARK(BM_LinearSumAssignment)->Apply(GraphSizes);
+
+}  // namespace
+}  // namespace operations_research
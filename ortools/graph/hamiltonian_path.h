@@ -90,7 +90,9 @@
 #include <utility>
 #include <vector>
 
+#include "absl/types/span.h"
 #include "ortools/base/logging.h"
+#include "ortools/base/threadpool.h"
 #include "ortools/base/types.h"
 #include "ortools/util/bitset.h"
 #include "ortools/util/saturated_arithmetic.h"
@@ -333,6 +335,17 @@ class LatticeMemoryManager {
   // This is useful in the Dynamic Programming iterations.
   CostType ValueAtOffset(uint64_t offset) const { return memory_[offset]; }
 
+  // Returns (n choose k), with n <= max_card_ and k <= n + 1.
+  uint64_t BinomialCoefficient(int n, int k) const {
+    return binomial_coefficients_[n][k];
+  }
+
+  // Returns the set with cardinality 'card' that has the given rank in the
+  // enumeration of SetRangeWithCardinality, i.e. the inverse of the local
+  // offset computed by BaseOffset(). This makes it possible to split a layer
+  // of the lattice into independent ranges of sets.
+  Set SetWithRank(int card, uint64_t rank) const;
+
  private:
   // Returns true if the values used to manage memory are set correctly.
   // This is intended to only be used in a DCHECK.
@@ -428,6 +441,27 @@ uint64_t LatticeMemoryManager<Set, CostType>::BaseOffset(int card,
   return base_offset_[card] + card * local_offset;
 }
 
+template <typename Set, typename CostType>
+Set LatticeMemoryManager<Set, CostType>::SetWithRank(int card,
+                                                     uint64_t rank) const {
+  DCHECK_LT(0, card);
+  DCHECK_GE(max_card_, card);
+  DCHECK_LT(rank, binomial_coefficients_[max_card_][card]);
+  // This is the combinatorial number system: the element at node_rank is the
+  // largest node such that (node choose node_rank + 1) <= rank. Since
+  // binomial_coefficients_[n][n + 1] == 0, the scan always stops in range.
+  Set set(0);
+  int node = max_card_ - 1;
+  for (int node_rank = card - 1; node_rank >= 0; --node_rank) {
+    while (binomial_coefficients_[node][node_rank + 1] > rank) --node;
+    set = set.AddElement(node);
+    rank -= binomial_coefficients_[node][node_rank + 1];
+    --node;
+  }
+  DCHECK_EQ(0, rank);
+  return set;
+}
+
 template <typename Set, typename CostType>
 uint64_t LatticeMemoryManager<Set, CostType>::Offset(Set set, int node) const {
   DCHECK(set.Contains(node));
@@ -450,11 +484,17 @@ void LatticeMemoryManager<Set, CostType>::SetValue(Set set, int node,
 // Deprecated type.
 typedef int PathNodeIndex;
 
-template <typename CostType, typename CostFunction>
+template <typename CostType, typename CostFunction,
+          typename StoredCostType = CostType>
 class HamiltonianPathSolver {
   // HamiltonianPathSolver computes a minimum Hamiltonian path starting at node
   // 0 over a graph defined by a cost matrix. The cost function need not be
   // symmetric.
+  // The n * 2^(n-1) costs of the partial paths are stored as StoredCostType.
+  // With an integral CostType, a narrower integral type, e.g. int32_t for
+  // int64_t costs, divides the memory used by the solver accordingly. It is
+  // then up to the caller to make sure that the cost of all the paths fits in
+  // StoredCostType, the stored values being saturated.
   // When the Hamiltonian path is closed, it's a Hamiltonian cycle,
   // i.e. the algorithm solves the Traveling Salesman Problem.
   // Example:
@@ -476,6 +516,12 @@ class HamiltonianPathSolver {
   typedef uint32_t Integer;
   typedef Set<Integer> NodeSet;
 
+  static_assert(std::is_same_v<StoredCostType, CostType> ||
+                    (std::is_integral_v<StoredCostType> &&
+                     std::is_integral_v<CostType> &&
+                     sizeof(StoredCostType) <= sizeof(CostType)),
+                "StoredCostType must be CostType or a narrower integral type");
+
   explicit HamiltonianPathSolver(CostFunction cost);
   HamiltonianPathSolver(int num_nodes, CostFunction cost);
 
@@ -483,6 +529,14 @@ class HamiltonianPathSolver {
   void ChangeCostMatrix(CostFunction cost);
   void ChangeCostMatrix(int num_nodes, CostFunction cost);
 
+  // Runs the Dynamic Programming iterations on the workers of 'thread_pool',
+  // which must outlive the solver, or on the calling thread if it is nullptr,
+  // which is the default. The sets of a given cardinality are then split in
+  // ranges that are processed concurrently, so the cost function must support
+  // concurrent calls. This only pays off from about 16 nodes; to solve many
+  // smaller instances, see SolveTravelingSalesmanBatch() instead.
+  void SetThreadPool(ThreadPool* thread_pool) { thread_pool_ = thread_pool; }
+
   // Returns the cost of the Hamiltonian path from 0 to end_node.
   CostType HamiltonianCost(int end_node);
 
@@ -555,9 +609,25 @@ class HamiltonianPathSolver {
   // Returns the cost value between two nodes.
   CostType Cost(int i, int j) { return cost_(i, j); }
 
+  // Converts a cost to the type in which it is memorized, saturating it when
+  // StoredCostType is narrower than CostType.
+  static StoredCostType ToStoredCost(CostType cost) {
+    if constexpr (std::is_same_v<StoredCostType, CostType>) {
+      return cost;
+    } else {
+      return static_cast<StoredCostType>(std::clamp<CostType>(
+          cost, std::numeric_limits<StoredCostType>::min(),
+          std::numeric_limits<StoredCostType>::max()));
+    }
+  }
+
   // Does all the Dynamic Progamming iterations.
   void Solve();
 
+  // Computes f(set, dest) for all the sets with cardinality 'card' whose rank
+  // (see LatticeMemoryManager::SetWithRank()) is in [begin_rank, end_rank).
+  void ComputeLayerRange(int card, uint64_t begin_rank, uint64_t end_rank);
+
   // Computes a path by looking at the information in mem_.
   std::vector<int> ComputePath(CostType cost, NodeSet set, int end);
 
@@ -592,7 +662,10 @@ class HamiltonianPathSolver {
   // is hamiltonian_paths_[best_hamiltonian_path_end_node_].
   int best_hamiltonian_path_end_node_;
 
-  LatticeMemoryManager<NodeSet, CostType> mem_;
+  LatticeMemoryManager<NodeSet, StoredCostType> mem_;
+
+  // Not owned. Used to run the Dynamic Programming iterations in parallel.
+  ThreadPool* thread_pool_ = nullptr;
 };
 
 // Utility function to simplify building a HamiltonianPathSolver from a functor.
@@ -603,14 +676,15 @@ HamiltonianPathSolver<CostType, CostFunction> MakeHamiltonianPathSolver(
                                                        std::move(cost));
 }
 
-template <typename CostType, typename CostFunction>
-HamiltonianPathSolver<CostType, CostFunction>::HamiltonianPathSolver(
-    CostFunction cost)
-    : HamiltonianPathSolver<CostType, CostFunction>(cost.size(), cost) {}
+template <typename CostType, typename CostFunction, typename StoredCostType>
+HamiltonianPathSolver<CostType, CostFunction,
+                      StoredCostType>::HamiltonianPathSolver(CostFunction cost)
+    : HamiltonianPathSolver<CostType, CostFunction, StoredCostType>(cost.size(),
+                                                                    cost) {}
 
-template <typename CostType, typename CostFunction>
-HamiltonianPathSolver<CostType, CostFunction>::HamiltonianPathSolver(
-    int num_nodes, CostFunction cost)
+template <typename CostType, typename CostFunction, typename StoredCostType>
+HamiltonianPathSolver<CostType, CostFunction, StoredCostType>::
+    HamiltonianPathSolver(int num_nodes, CostFunction cost)
     : cost_(std::move(cost)),
       num_nodes_(num_nodes),
       tsp_cost_(0),
@@ -624,15 +698,15 @@ HamiltonianPathSolver<CostType, CostFunction>::HamiltonianPathSolver(
   CHECK(cost_.Check());
 }
 
-template <typename CostType, typename CostFunction>
-void HamiltonianPathSolver<CostType, CostFunction>::ChangeCostMatrix(
-    CostFunction cost) {
+template <typename CostType, typename CostFunction, typename StoredCostType>
+void HamiltonianPathSolver<CostType, CostFunction, StoredCostType>::
+    ChangeCostMatrix(CostFunction cost) {
   ChangeCostMatrix(cost.size(), cost);
 }
 
-template <typename CostType, typename CostFunction>
-void HamiltonianPathSolver<CostType, CostFunction>::ChangeCostMatrix(
-    int num_nodes, CostFunction cost) {
+template <typename CostType, typename CostFunction, typename StoredCostType>
+void HamiltonianPathSolver<CostType, CostFunction, StoredCostType>::
+    ChangeCostMatrix(int num_nodes, CostFunction cost) {
   robustness_checked_ = false;
   triangle_inequality_checked_ = false;
   solved_ = false;
@@ -642,8 +716,8 @@ void HamiltonianPathSolver<CostType, CostFunction>::ChangeCostMatrix(
   CHECK(cost_.Check());
 }
 
-template <typename CostType, typename CostFunction>
-void HamiltonianPathSolver<CostType, CostFunction>::Solve() {
+template <typename CostType, typename CostFunction, typename StoredCostType>
+void HamiltonianPathSolver<CostType, CostFunction, StoredCostType>::Solve() {
   if (solved_) return;
   if (num_nodes_ == 0) {
     tsp_cost_ = 0;
@@ -660,45 +734,21 @@ void HamiltonianPathSolver<CostType, CostFunction>::Solve() {
   // that base_offset_[1] == 0. (This is what the DCHECK_EQ is for).
   for (int dest = 0; dest < num_nodes_; ++dest) {
     DCHECK_EQ(dest, mem_.BaseOffset(1, NodeSet::Singleton(dest)));
-    mem_.SetValueAtOffset(dest, Cost(0, dest));
+    mem_.SetValueAtOffset(dest, ToStoredCost(Cost(0, dest)));
   }
 
   // Populate the dynamic programming lattice layer by layer, by iterating
-  // on cardinality.
+  // on cardinality. The values of a layer only depend on the preceding one, so
+  // the sets of a layer can be processed in any order, and in parallel. The
+  // sets with cardinality card that fit in num_nodes_ bits are the first
+  // (num_nodes_ choose card) ones, even when mem_ was initialized for more
+  // nodes by a previous call.
+  constexpr int64_t kNumSetsPerRange = 512;
   for (int card = 2; card <= num_nodes_; ++card) {
-    // Iterate on sets of same cardinality.
-    for (NodeSet set :
-         SetRangeWithCardinality<Set<uint32_t>>(card, num_nodes_)) {
-      // Using BaseOffset and maintaining the node ranks, to reduce the
-      // computational effort for accessing the data.
-      const uint64_t set_offset = mem_.BaseOffset(card, set);
-      // The first subset on which we'll iterate is set.RemoveSmallestElement().
-      // Compute its offset. It will be updated incrementaly. This saves about
-      // 30-35% of computation time.
-      uint64_t subset_offset =
-          mem_.BaseOffset(card - 1, set.RemoveSmallestElement());
-      int prev_dest = set.SmallestElement();
-      int dest_rank = 0;
-      for (int dest : set) {
-        CostType min_cost = std::numeric_limits<CostType>::max();
-        const NodeSet subset = set.RemoveElement(dest);
-        // We compute the offset for subset from the preceding iteration
-        // by taking into account that prev_dest is now in subset, and
-        // that dest is now removed from subset.
-        subset_offset += mem_.OffsetDelta(card - 1, prev_dest, dest, dest_rank);
-        int src_rank = 0;
-        for (int src : subset) {
-          min_cost = std::min(
-              min_cost, Saturated<CostType>::Add(
-                            Cost(src, dest),
-                            mem_.ValueAtOffset(subset_offset + src_rank)));
-          ++src_rank;
-        }
-        prev_dest = dest;
-        mem_.SetValueAtOffset(set_offset + dest_rank, min_cost);
-        ++dest_rank;
-      }
-    }
+    ParallelFor(thread_pool_, 0, mem_.BinomialCoefficient(num_nodes_, card),
+                kNumSetsPerRange, [this, card](int64_t begin, int64_t end) {
+                  ComputeLayerRange(card, begin, end);
+                });
   }
 
   const NodeSet full_set = NodeSet::FullSet(num_nodes_);
@@ -731,8 +781,49 @@ void HamiltonianPathSolver<CostType, CostFunction>::Solve() {
   solved_ = true;
 }
 
-template <typename CostType, typename CostFunction>
-std::vector<int> HamiltonianPathSolver<CostType, CostFunction>::ComputePath(
+template <typename CostType, typename CostFunction, typename StoredCostType>
+void HamiltonianPathSolver<CostType, CostFunction, StoredCostType>::
+    ComputeLayerRange(int card, uint64_t begin_rank, uint64_t end_rank) {
+  // Iterate on sets of same cardinality.
+  SetRangeIterator<SetRangeWithCardinality<NodeSet>> set_iterator(
+      mem_.SetWithRank(card, begin_rank));
+  for (uint64_t rank = begin_rank; rank < end_rank; ++rank, ++set_iterator) {
+    const NodeSet set = *set_iterator;
+    // Using BaseOffset and maintaining the node ranks, to reduce the
+    // computational effort for accessing the data.
+    const uint64_t set_offset = mem_.BaseOffset(card, set);
+    // The first subset on which we'll iterate is set.RemoveSmallestElement().
+    // Compute its offset. It will be updated incrementaly. This saves about
+    // 30-35% of computation time.
+    uint64_t subset_offset =
+        mem_.BaseOffset(card - 1, set.RemoveSmallestElement());
+    int prev_dest = set.SmallestElement();
+    int dest_rank = 0;
+    for (int dest : set) {
+      CostType min_cost = std::numeric_limits<CostType>::max();
+      const NodeSet subset = set.RemoveElement(dest);
+      // We compute the offset for subset from the preceding iteration
+      // by taking into account that prev_dest is now in subset, and
+      // that dest is now removed from subset.
+      subset_offset += mem_.OffsetDelta(card - 1, prev_dest, dest, dest_rank);
+      int src_rank = 0;
+      for (int src : subset) {
+        min_cost = std::min(
+            min_cost, Saturated<CostType>::Add(
+                          Cost(src, dest),
+                          mem_.ValueAtOffset(subset_offset + src_rank)));
+        ++src_rank;
+      }
+      prev_dest = dest;
+      mem_.SetValueAtOffset(set_offset + dest_rank, ToStoredCost(min_cost));
+      ++dest_rank;
+    }
+  }
+}
+
+template <typename CostType, typename CostFunction, typename StoredCostType>
+std::vector<int>
+HamiltonianPathSolver<CostType, CostFunction, StoredCostType>::ComputePath(
     CostType cost, NodeSet set, int end_node) {
   DCHECK(set.Contains(end_node));
   const int path_size = set.Cardinality() + 1;
@@ -763,8 +854,8 @@ std::vector<int> HamiltonianPathSolver<CostType, CostFunction>::ComputePath(
   return path;
 }
 
-template <typename CostType, typename CostFunction>
-bool HamiltonianPathSolver<CostType, CostFunction>::PathIsValid(
+template <typename CostType, typename CostFunction, typename StoredCostType>
+bool HamiltonianPathSolver<CostType, CostFunction, StoredCostType>::PathIsValid(
     const std::vector<int>& path, CostType cost) {
   NodeSet coverage(0);
   for (int node : path) {
@@ -782,8 +873,8 @@ bool HamiltonianPathSolver<CostType, CostFunction>::PathIsValid(
   return true;
 }
 
-template <typename CostType, typename CostFunction>
-bool HamiltonianPathSolver<CostType, CostFunction>::IsRobust() {
+template <typename CostType, typename CostFunction, typename StoredCostType>
+bool HamiltonianPathSolver<CostType, CostFunction, StoredCostType>::IsRobust() {
   if (std::numeric_limits<CostType>::is_integer) return true;
   if (robustness_checked_) return robust_;
   CostType min_cost = std::numeric_limits<CostType>::max();
@@ -806,9 +897,9 @@ bool HamiltonianPathSolver<CostType, CostFunction>::IsRobust() {
   return robust_;
 }
 
-template <typename CostType, typename CostFunction>
-bool HamiltonianPathSolver<CostType,
-                           CostFunction>::VerifiesTriangleInequality() {
+template <typename CostType, typename CostFunction, typename StoredCostType>
+bool HamiltonianPathSolver<CostType, CostFunction,
+                           StoredCostType>::VerifiesTriangleInequality() {
   if (triangle_inequality_checked_) return triangle_inequality_ok_;
   triangle_inequality_ok_ = true;
   triangle_inequality_checked_ = true;
@@ -827,53 +918,89 @@ bool HamiltonianPathSolver<CostType,
   return triangle_inequality_ok_;
 }
 
-template <typename CostType, typename CostFunction>
-int HamiltonianPathSolver<CostType,
-                          CostFunction>::BestHamiltonianPathEndNode() {
+template <typename CostType, typename CostFunction, typename StoredCostType>
+int HamiltonianPathSolver<CostType, CostFunction,
+                          StoredCostType>::BestHamiltonianPathEndNode() {
   Solve();
   return best_hamiltonian_path_end_node_;
 }
 
-template <typename CostType, typename CostFunction>
-CostType HamiltonianPathSolver<CostType, CostFunction>::HamiltonianCost(
+template <typename CostType, typename CostFunction, typename StoredCostType>
+CostType
+HamiltonianPathSolver<CostType, CostFunction, StoredCostType>::HamiltonianCost(
     int end_node) {
   Solve();
   return hamiltonian_costs_[end_node];
 }
 
-template <typename CostType, typename CostFunction>
-std::vector<int> HamiltonianPathSolver<CostType, CostFunction>::HamiltonianPath(
+template <typename CostType, typename CostFunction, typename StoredCostType>
+std::vector<int>
+HamiltonianPathSolver<CostType, CostFunction, StoredCostType>::HamiltonianPath(
     int end_node) {
   Solve();
   return hamiltonian_paths_[end_node];
 }
 
-template <typename CostType, typename CostFunction>
-void HamiltonianPathSolver<CostType, CostFunction>::HamiltonianPath(
-    std::vector<PathNodeIndex>* path) {
+template <typename CostType, typename CostFunction, typename StoredCostType>
+void HamiltonianPathSolver<CostType, CostFunction, StoredCostType>::
+    HamiltonianPath(std::vector<PathNodeIndex>* path) {
   *path = HamiltonianPath(best_hamiltonian_path_end_node_);
 }
 
-template <typename CostType, typename CostFunction>
-CostType
-HamiltonianPathSolver<CostType, CostFunction>::TravelingSalesmanCost() {
+template <typename CostType, typename CostFunction, typename StoredCostType>
+CostType HamiltonianPathSolver<CostType, CostFunction,
+                               StoredCostType>::TravelingSalesmanCost() {
   Solve();
   return tsp_cost_;
 }
 
-template <typename CostType, typename CostFunction>
+template <typename CostType, typename CostFunction, typename StoredCostType>
 std::vector<int>
-HamiltonianPathSolver<CostType, CostFunction>::TravelingSalesmanPath() {
+HamiltonianPathSolver<CostType, CostFunction,
+                      StoredCostType>::TravelingSalesmanPath() {
   Solve();
   return tsp_path_;
 }
 
-template <typename CostType, typename CostFunction>
-void HamiltonianPathSolver<CostType, CostFunction>::TravelingSalesmanPath(
-    std::vector<PathNodeIndex>* path) {
+template <typename CostType, typename CostFunction, typename StoredCostType>
+void HamiltonianPathSolver<CostType, CostFunction, StoredCostType>::
+    TravelingSalesmanPath(std::vector<PathNodeIndex>* path) {
   *path = TravelingSalesmanPath();
 }
 
+// Solves the Traveling Salesman Problem on each of the given cost matrices and
+// returns the tours, in the same order, and their costs in 'tsp_costs' if it
+// is not nullptr. This is meant for many small instances: they are distributed
+// over the workers of 'thread_pool' when it is not nullptr, and each worker
+// reuses the same solver, and thus the same Dynamic Programming memory, for
+// all the instances it solves.
+template <typename CostType, typename CostFunction,
+          typename StoredCostType = CostType>
+std::vector<std::vector<int>> SolveTravelingSalesmanBatch(
+    absl::Span<const CostFunction> costs, ThreadPool* thread_pool = nullptr,
+    std::vector<CostType>* tsp_costs = nullptr) {
+  using Solver = HamiltonianPathSolver<CostType, CostFunction, StoredCostType>;
+  const int num_workers =
+      thread_pool == nullptr ? 1 : thread_pool->NumWorkers();
+  std::vector<std::unique_ptr<Solver>> solvers(num_workers);
+  std::vector<std::vector<int>> tours(costs.size());
+  if (tsp_costs != nullptr) tsp_costs->assign(costs.size(), 0);
+  ParallelForEachItem(
+      thread_pool, num_workers, costs.size(), [&](int worker, int64_t i) {
+        std::unique_ptr<Solver>& solver = solvers[worker];
+        if (solver == nullptr) {
+          solver = std::make_unique<Solver>(costs[i]);
+        } else {
+          solver->ChangeCostMatrix(costs[i]);
+        }
+        tours[i] = solver->TravelingSalesmanPath();
+        if (tsp_costs != nullptr) {
+          (*tsp_costs)[i] = solver->TravelingSalesmanCost();
+        }
+      });
+  return tours;
+}
+
 template <typename CostType, typename CostFunction>
 class PruningHamiltonianSolver {
   // PruningHamiltonianSolver computes a minimum Hamiltonian path from node 0
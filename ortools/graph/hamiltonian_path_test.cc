@@ -26,6 +26,7 @@
 #include "gtest/gtest.h"
 #include "ortools/base/logging.h"
 #include "ortools/base/macros.h"
+#include "ortools/base/threadpool.h"
 
 namespace operations_research {
 
@@ -91,6 +92,22 @@ TEST(LatticeMemoryManagerTest, Offset) {
   }
 }
 
+TEST(LatticeMemoryManagerTest, SetWithRank) {
+  typedef Set<uint32_t> Set32;
+  for (int max_card = 1; max_card < 16; ++max_card) {
+    LatticeMemoryManager<Set<uint32_t>, double> memory;
+    memory.Init(max_card);
+    for (int card = 1; card <= max_card; ++card) {
+      uint64_t rank = 0;
+      for (Set32 set : SetRangeWithCardinality<Set32>(card, max_card)) {
+        EXPECT_EQ(set.value(), memory.SetWithRank(card, rank).value());
+        ++rank;
+      }
+      EXPECT_EQ(memory.BinomialCoefficient(max_card, card), rank);
+    }
+  }
+}
+
 // Displays the path.
 std::string PathToString(const std::vector<int>& path) {
   std::string path_string;
@@ -424,6 +441,84 @@ TEST(HamiltonianPathTest, EmptyCosts) {
   EXPECT_EQ(kSize + 1, path.size());
 }
 
+// Returns a random asymmetric cost matrix of the given size.
+std::vector<std::vector<int64_t>> RandomCosts(int size,
+                                              std::mt19937* randomizer) {
+  std::vector<std::vector<int64_t>> cost(size, std::vector<int64_t>(size, 0));
+  for (int i = 0; i < size; ++i) {
+    for (int j = 0; j < size; ++j) {
+      if (i != j) cost[i][j] = absl::Uniform<int64_t>(*randomizer, 0, 10'000);
+    }
+  }
+  return cost;
+}
+
+TEST(HamiltonianPathTest, ParallelLayers) {
+  using Solver =
+      HamiltonianPathSolver<int64_t, std::vector<std::vector<int64_t>>>;
+  std::mt19937 randomizer(0);
+  ThreadPool pool(4);
+  pool.StartWorkers();
+  for (const int size : {2, 10, 16}) {
+    SCOPED_TRACE(size);
+    const std::vector<std::vector<int64_t>> cost =
+        RandomCosts(size, &randomizer);
+    Solver sequential_solver(cost);
+    Solver parallel_solver(cost);
+    parallel_solver.SetThreadPool(&pool);
+    EXPECT_EQ(sequential_solver.TravelingSalesmanCost(),
+              parallel_solver.TravelingSalesmanCost());
+    EXPECT_EQ(sequential_solver.TravelingSalesmanPath(),
+              parallel_solver.TravelingSalesmanPath());
+    const int end_node = sequential_solver.BestHamiltonianPathEndNode();
+    EXPECT_EQ(end_node, parallel_solver.BestHamiltonianPathEndNode());
+    EXPECT_EQ(sequential_solver.HamiltonianPath(end_node),
+              parallel_solver.HamiltonianPath(end_node));
+  }
+}
+
+TEST(HamiltonianPathTest, Int32StoredCosts) {
+  std::mt19937 randomizer(0);
+  for (const int size : {1, 5, 12}) {
+    SCOPED_TRACE(size);
+    const std::vector<std::vector<int64_t>> cost =
+        RandomCosts(size, &randomizer);
+    HamiltonianPathSolver<int64_t, std::vector<std::vector<int64_t>>> solver(
+        cost);
+    HamiltonianPathSolver<int64_t, std::vector<std::vector<int64_t>>, int32_t>
+        lean_solver(cost);
+    EXPECT_EQ(solver.TravelingSalesmanCost(),
+              lean_solver.TravelingSalesmanCost());
+    EXPECT_EQ(solver.TravelingSalesmanPath(),
+              lean_solver.TravelingSalesmanPath());
+  }
+}
+
+TEST(HamiltonianPathTest, SolveTravelingSalesmanBatch) {
+  using CostMatrix = std::vector<std::vector<int64_t>>;
+  constexpr int kNumInstances = 300;
+  std::mt19937 randomizer(0);
+  std::vector<CostMatrix> costs;
+  for (int i = 0; i < kNumInstances; ++i) {
+    costs.push_back(RandomCosts(absl::Uniform(randomizer, 1, 11), &randomizer));
+  }
+  ThreadPool pool(4);
+  pool.StartWorkers();
+  for (ThreadPool* thread_pool : {static_cast<ThreadPool*>(nullptr), &pool}) {
+    std::vector<int64_t> tsp_costs;
+    const std::vector<std::vector<int>> tours =
+        SolveTravelingSalesmanBatch<int64_t, CostMatrix>(costs, thread_pool,
+                                                         &tsp_costs);
+    ASSERT_EQ(kNumInstances, tours.size());
+    ASSERT_EQ(kNumInstances, tsp_costs.size());
+    for (int i = 0; i < kNumInstances; ++i) {
+      HamiltonianPathSolver<int64_t, CostMatrix> solver(costs[i]);
+      EXPECT_EQ(solver.TravelingSalesmanCost(), tsp_costs[i]);
+      EXPECT_EQ(solver.TravelingSalesmanPath(), tours[i]);
+    }
+  }
+}
+
 TEST(HamiltonianPathTest, RectangleCosts) {
   using Solver = HamiltonianPathSolver<int, std::vector<std::vector<int>>>;
   const int kSize = 10;
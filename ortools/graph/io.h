@@ -17,10 +17,15 @@
 #define UTIL_GRAPH_IO_H_
 
 #include <algorithm>
+#include <cstddef>
 #include <cstdint>
+#include <cstring>
+#include <limits>
 #include <memory>
 #include <numeric>
 #include <string>
+#include <type_traits>
+#include <utility>
 #include <vector>
 
 #include "absl/status/status.h"
@@ -30,6 +35,7 @@
 #include "absl/strings/str_format.h"
 #include "absl/strings/str_join.h"
 #include "absl/strings/str_split.h"
+#include "absl/strings/string_view.h"
 #include "absl/types/span.h"
 #include "ortools/base/numbers.h"
 #include "ortools/graph/graph.h"
@@ -69,6 +75,53 @@ absl::Status WriteGraphToFile(const Graph& graph, const std::string& filename,
                               bool directed,
                               absl::Span<const int> num_nodes_with_color);
 
+// Binary format of StaticGraph<> and ReverseArcStaticGraph<>. It stores the
+// arrays of the built graph with the native byte order, so a graph is loaded
+// in about the time needed to read it: the arcs are not permuted again as in
+// Build(). Arrays of arc or node annotations, e.g. the arc lengths, can follow
+// the graph in the same string and be used in place, for example from a
+// memory-mapped file:
+//
+//   std::string data;
+//   AppendGraphToBinaryString(graph, data);
+//   AppendArrayToBinaryString<int64_t>(arc_lengths, data);
+//   ... write `data` to a file ...
+//
+//   absl::string_view input = ...;  // The file contents, or an mmap() of it.
+//   ASSIGN_OR_RETURN(const StaticGraph<> graph,
+//                    ReadGraphFromBinaryString<StaticGraph<>>(input));
+//   ASSIGN_OR_RETURN(const absl::Span<const int64_t> arc_lengths,
+//                    ViewArrayInBinaryString<int64_t>(input));
+//
+// The graph is copied into its own arrays, while the annotations are not.
+template <typename NodeIndexType, typename ArcIndexType>
+void AppendGraphToBinaryString(
+    const StaticGraph<NodeIndexType, ArcIndexType>& graph, std::string& output);
+template <typename NodeIndexType, typename ArcIndexType>
+void AppendGraphToBinaryString(
+    const ReverseArcStaticGraph<NodeIndexType, ArcIndexType>& graph,
+    std::string& output);
+
+// Reads a graph written by AppendGraphToBinaryString() at the beginning of
+// `data`, and removes it from `data`. Returns an InvalidArgumentError if it
+// isn't a valid graph of the given type, which is checked in linear time.
+template <class Graph>
+absl::StatusOr<Graph> ReadGraphFromBinaryString(absl::string_view& data);
+
+// Appends `values` to `output` as an array that can be viewed in place by
+// ViewArrayInBinaryString(). The size of `output` stays a multiple of 8, so if
+// the arrays and graphs appended by the functions above are read from an
+// 8-byte aligned address (as the one returned by mmap()), so are the arrays.
+template <typename T>
+void AppendArrayToBinaryString(absl::Span<const T> values,
+                               std::string& output);
+
+// Returns a view of the array written by AppendArrayToBinaryString() at the
+// beginning of `data`, and removes it from `data`.
+template <typename T>
+absl::StatusOr<absl::Span<const T>> ViewArrayInBinaryString(
+    absl::string_view& data);
+
 // Implementations of the templated methods.
 
 template <class Graph>
@@ -161,6 +214,212 @@ absl::Status WriteGraphToFile(const Graph& graph, const std::string& filename,
   return ::absl::OkStatus();
 }
 
+namespace internal {
+
+inline constexpr char kBinaryGraphMagic[8] = {'O', 'R', 'G', 'B',
+                                              'v', '1', 0,   0};
+
+template <typename NodeIndexType, typename ArcIndexType>
+void AppendBinaryGraphHeader(bool has_reverse_arcs, std::string& output) {
+  output.append(kBinaryGraphMagic, sizeof(kBinaryGraphMagic));
+  const uint32_t header[4] = {has_reverse_arcs, sizeof(NodeIndexType),
+                              sizeof(ArcIndexType), 0};
+  output.append(reinterpret_cast<const char*>(header), sizeof(header));
+}
+
+template <typename NodeIndexType, typename ArcIndexType>
+absl::Status ReadBinaryGraphHeader(bool has_reverse_arcs,
+                                   absl::string_view& data) {
+  constexpr int kMagicSize = sizeof(kBinaryGraphMagic);
+  uint32_t header[4];
+  if (data.size() < kMagicSize + sizeof(header) ||
+      std::memcmp(data.data(), kBinaryGraphMagic, kMagicSize) != 0) {
+    return absl::InvalidArgumentError("Not a binary graph");
+  }
+  std::memcpy(header, data.data() + kMagicSize, sizeof(header));
+  if (header[0] != has_reverse_arcs || header[1] != sizeof(NodeIndexType) ||
+      header[2] != sizeof(ArcIndexType)) {
+    return absl::InvalidArgumentError(
+        "The binary graph has a different graph type");
+  }
+  data.remove_prefix(kMagicSize + sizeof(header));
+  return absl::OkStatus();
+}
+
+// Returns the number of bytes of the array of `size` elements of type T
+// started at `data` by AppendArrayToBinaryString(), size and padding included,
+// or 0 if `data` is too short.
+template <typename T>
+size_t BinaryArrayNumBytes(absl::string_view data, uint64_t& size) {
+  if (data.size() < sizeof(size)) return 0;
+  std::memcpy(&size, data.data(), sizeof(size));
+  if (size > (data.size() - sizeof(size)) / sizeof(T)) return 0;
+  const size_t num_bytes = sizeof(size) + (size * sizeof(T) + 7) / 8 * 8;
+  return num_bytes <= data.size() ? num_bytes : 0;
+}
+
+template <typename T>
+bool ReadBinaryArray(absl::string_view& data, std::vector<T>& values) {
+  uint64_t size;
+  const size_t num_bytes = BinaryArrayNumBytes<T>(data, size);
+  if (num_bytes == 0) return false;
+  values.resize(size);
+  if (size > 0) {
+    std::memcpy(values.data(), data.data() + sizeof(size), size * sizeof(T));
+  }
+  data.remove_prefix(num_bytes);
+  return true;
+}
+
+template <typename ArcIndexType>
+bool AreValidStarts(absl::Span<const ArcIndexType> start, ArcIndexType first,
+                    ArcIndexType last) {
+  if (start.empty()) return first == last;
+  if (start.front() != first) return false;
+  for (size_t i = 1; i < start.size(); ++i) {
+    if (start[i - 1] > start[i]) return false;
+  }
+  return start.back() <= last;
+}
+
+template <typename NodeIndexType, typename ArcIndexType>
+absl::StatusOr<StaticGraph<NodeIndexType, ArcIndexType>> ReadBinaryGraph(
+    absl::string_view& data, StaticGraph<NodeIndexType, ArcIndexType>*) {
+  if (absl::Status status =
+          ReadBinaryGraphHeader<NodeIndexType, ArcIndexType>(false, data);
+      !status.ok()) {
+    return status;
+  }
+  std::vector<ArcIndexType> start;
+  std::vector<NodeIndexType> head;
+  if (!ReadBinaryArray(data, start) || !ReadBinaryArray(data, head)) {
+    return absl::InvalidArgumentError("Truncated binary graph");
+  }
+  const uint64_t num_nodes = start.size();
+  const uint64_t num_arcs = head.size();
+  if (num_nodes >
+          static_cast<uint64_t>(std::numeric_limits<NodeIndexType>::max()) ||
+      num_arcs >
+          static_cast<uint64_t>(std::numeric_limits<ArcIndexType>::max()) ||
+      !AreValidStarts<ArcIndexType>(start, 0,
+                                    static_cast<ArcIndexType>(num_arcs))) {
+    return absl::InvalidArgumentError("Invalid binary graph arcs");
+  }
+  for (const NodeIndexType node : head) {
+    if (node < 0 || static_cast<uint64_t>(node) >= num_nodes) {
+      return absl::InvalidArgumentError("Invalid binary graph arcs");
+    }
+  }
+  return StaticGraph<NodeIndexType, ArcIndexType>::FromBuiltArrays(
+      std::move(start), std::move(head));
+}
+
+template <typename NodeIndexType, typename ArcIndexType>
+absl::StatusOr<ReverseArcStaticGraph<NodeIndexType, ArcIndexType>>
+ReadBinaryGraph(absl::string_view& data,
+                ReverseArcStaticGraph<NodeIndexType, ArcIndexType>*) {
+  if (absl::Status status =
+          ReadBinaryGraphHeader<NodeIndexType, ArcIndexType>(true, data);
+      !status.ok()) {
+    return status;
+  }
+  std::vector<ArcIndexType> start;
+  std::vector<ArcIndexType> reverse_start;
+  std::vector<NodeIndexType> head;
+  std::vector<ArcIndexType> opposite;
+  if (!ReadBinaryArray(data, start) || !ReadBinaryArray(data, reverse_start) ||
+      !ReadBinaryArray(data, head) || !ReadBinaryArray(data, opposite)) {
+    return absl::InvalidArgumentError("Truncated binary graph");
+  }
+  const uint64_t num_nodes = start.size();
+  const ArcIndexType num_arcs = head.size();
+  if (num_nodes >
+          static_cast<uint64_t>(std::numeric_limits<NodeIndexType>::max()) ||
+      head.size() >
+          static_cast<uint64_t>(std::numeric_limits<ArcIndexType>::max()) ||
+      reverse_start.size() != num_nodes || opposite.size() != head.size() ||
+      !AreValidStarts<ArcIndexType>(start, 0, num_arcs) ||
+      !AreValidStarts<ArcIndexType>(reverse_start, -num_arcs, 0)) {
+    return absl::InvalidArgumentError("Invalid binary graph arcs");
+  }
+  // The opposite arcs must be a permutation of the reverse arcs, each in the
+  // range of the reverse arcs of the head of its forward arc.
+  std::vector<bool> is_opposite(num_arcs, false);
+  for (ArcIndexType arc = 0; arc < num_arcs; ++arc) {
+    const NodeIndexType node = head[arc];
+    if (node < 0 || static_cast<uint64_t>(node) >= num_nodes) {
+      return absl::InvalidArgumentError("Invalid binary graph arcs");
+    }
+    const ArcIndexType reverse_limit =
+        static_cast<uint64_t>(node) + 1 < num_nodes ? reverse_start[node + 1]
+                                                    : 0;
+    if (opposite[arc] < reverse_start[node] || opposite[arc] >= reverse_limit ||
+        is_opposite[opposite[arc] + num_arcs]) {
+      return absl::InvalidArgumentError("Invalid binary graph opposite arcs");
+    }
+    is_opposite[opposite[arc] + num_arcs] = true;
+  }
+  return ReverseArcStaticGraph<NodeIndexType, ArcIndexType>::FromBuiltArrays(
+      std::move(start), std::move(reverse_start), head, opposite);
+}
+
+}  // namespace internal
+
+template <typename NodeIndexType, typename ArcIndexType>
+void AppendGraphToBinaryString(
+    const StaticGraph<NodeIndexType, ArcIndexType>& graph,
+    std::string& output) {
+  internal::AppendBinaryGraphHeader<NodeIndexType, ArcIndexType>(false,
+                                                                 output);
+  AppendArrayToBinaryString(graph.BuiltStarts(), output);
+  AppendArrayToBinaryString(graph.BuiltHeads(), output);
+}
+
+template <typename NodeIndexType, typename ArcIndexType>
+void AppendGraphToBinaryString(
+    const ReverseArcStaticGraph<NodeIndexType, ArcIndexType>& graph,
+    std::string& output) {
+  internal::AppendBinaryGraphHeader<NodeIndexType, ArcIndexType>(true, output);
+  AppendArrayToBinaryString(graph.BuiltStarts(), output);
+  AppendArrayToBinaryString(graph.BuiltReverseStarts(), output);
+  AppendArrayToBinaryString(graph.BuiltHeads(), output);
+  AppendArrayToBinaryString(graph.BuiltOpposites(), output);
+}
+
+template <class Graph>
+absl::StatusOr<Graph> ReadGraphFromBinaryString(absl::string_view& data) {
+  return internal::ReadBinaryGraph(data, static_cast<Graph*>(nullptr));
+}
+
+template <typename T>
+void AppendArrayToBinaryString(absl::Span<const T> values,
+                               std::string& output) {
+  static_assert(std::is_trivially_copyable_v<T>);
+  const uint64_t size = values.size();
+  output.append(reinterpret_cast<const char*>(&size), sizeof(size));
+  output.append(reinterpret_cast<const char*>(values.data()),
+                values.size() * sizeof(T));
+  output.resize((output.size() + 7) / 8 * 8, 0);
+}
+
+template <typename T>
+absl::StatusOr<absl::Span<const T>> ViewArrayInBinaryString(
+    absl::string_view& data) {
+  static_assert(std::is_trivially_copyable_v<T>);
+  static_assert(alignof(T) <= 8);
+  uint64_t size;
+  const size_t num_bytes = internal::BinaryArrayNumBytes<T>(data, size);
+  if (num_bytes == 0) {
+    return absl::InvalidArgumentError("Truncated binary array");
+  }
+  const char* const values = data.data() + sizeof(size);
+  if (reinterpret_cast<uintptr_t>(values) % alignof(T) != 0) {
+    return absl::InvalidArgumentError("Misaligned binary array");
+  }
+  data.remove_prefix(num_bytes);
+  return absl::Span<const T>(reinterpret_cast<const T*>(values), size);
+}
+
 }  // namespace util
 
 #endif  // UTIL_GRAPH_IO_H_
@@ -0,0 +1,198 @@
+// Copyright 2010-2024 Google LLC
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "ortools/graph/io.h"
+
+#include <cstdint>
+#include <cstring>
+#include <random>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "absl/random/distributions.h"
+#include "absl/status/status.h"
+#include "absl/status/statusor.h"
+#include "absl/strings/string_view.h"
+#include "absl/types/span.h"
+#include "gtest/gtest.h"
+#include "ortools/base/gmock.h"
+#include "ortools/graph/graph.h"
+
+namespace util {
+namespace {
+
+using ::testing::ElementsAre;
+using ::testing::ElementsAreArray;
+using ::testing::IsEmpty;
+
+template <class Graph>
+Graph RandomGraph(int num_nodes, int num_arcs, std::mt19937& random) {
+  Graph graph(num_nodes, num_arcs);
+  for (int i = 0; i < num_arcs; ++i) {
+    graph.AddArc(absl::Uniform(random, 0, num_nodes),
+                 absl::Uniform(random, 0, num_nodes));
+  }
+  graph.Build();
+  return graph;
+}
+
+template <class Graph>
+void ExpectSameGraphs(const Graph& graph, const Graph& expected) {
+  EXPECT_EQ(GraphToString(graph, PRINT_GRAPH_ARCS),
+            GraphToString(expected, PRINT_GRAPH_ARCS));
+  for (const auto arc : expected.AllForwardArcs()) {
+    ASSERT_EQ(graph.Tail(arc), expected.Tail(arc));
+  }
+}
+
+TEST(BinaryGraphTest, StaticGraphRoundTrip) {
+  std::mt19937 random(1234);
+  for (const auto& [num_nodes, num_arcs] :
+       {std::pair{0, 0}, std::pair{1, 0}, std::pair{10, 30},
+        std::pair{1000, 5000}}) {
+    const auto graph = RandomGraph<StaticGraph<>>(num_nodes, num_arcs, random);
+    std::string data;
+    AppendGraphToBinaryString(graph, data);
+    absl::string_view input = data;
+    const absl::StatusOr<StaticGraph<>> reloaded =
+        ReadGraphFromBinaryString<StaticGraph<>>(input);
+    ASSERT_TRUE(reloaded.ok()) << reloaded.status();
+    EXPECT_TRUE(input.empty());
+    EXPECT_EQ(reloaded->num_nodes(), num_nodes);
+    EXPECT_EQ(reloaded->num_arcs(), num_arcs);
+    ExpectSameGraphs(*reloaded, graph);
+  }
+}
+
+TEST(BinaryGraphTest, ReverseArcStaticGraphRoundTrip) {
+  std::mt19937 random(4321);
+  for (const auto& [num_nodes, num_arcs] :
+       {std::pair{0, 0}, std::pair{1, 0}, std::pair{10, 30},
+        std::pair{1000, 5000}}) {
+    const auto graph =
+        RandomGraph<ReverseArcStaticGraph<>>(num_nodes, num_arcs, random);
+    std::string data;
+    AppendGraphToBinaryString(graph, data);
+    absl::string_view input = data;
+    const absl::StatusOr<ReverseArcStaticGraph<>> reloaded =
+        ReadGraphFromBinaryString<ReverseArcStaticGraph<>>(input);
+    ASSERT_TRUE(reloaded.ok()) << reloaded.status();
+    EXPECT_TRUE(input.empty());
+    ExpectSameGraphs(*reloaded, graph);
+    for (const int node : graph.AllNodes()) {
+      std::vector<int> arcs;
+      for (const int arc : graph.OutgoingOrOppositeIncomingArcs(node)) {
+        arcs.push_back(arc);
+      }
+      std::vector<int> reloaded_arcs;
+      for (const int arc : reloaded->OutgoingOrOppositeIncomingArcs(node)) {
+        ASSERT_EQ(reloaded->Head(arc), graph.Head(arc));
+        ASSERT_EQ(reloaded->OppositeArc(arc), graph.OppositeArc(arc));
+        reloaded_arcs.push_back(arc);
+      }
+      ASSERT_EQ(reloaded_arcs, arcs);
+    }
+  }
+}
+
+TEST(BinaryGraphTest, ArraysAfterTheGraph) {
+  StaticGraph<> graph;
+  graph.AddArc(0, 1);
+  graph.AddArc(1, 2);
+  graph.AddArc(2, 0);
+  graph.Build();
+  const std::vector<int64_t> arc_lengths = {5, 7, 11};
+  const std::vector<char> node_colors = {'r', 'g', 'b'};
+  std::string data;
+  AppendGraphToBinaryString(graph, data);
+  AppendArrayToBinaryString<char>(node_colors, data);
+  AppendArrayToBinaryString<int64_t>(arc_lengths, data);
+  AppendArrayToBinaryString<double>({}, data);
+  EXPECT_EQ(data.size() % 8, 0);
+
+  // std::string buffers are aligned enough for the views.
+  absl::string_view input = data;
+  const absl::StatusOr<StaticGraph<>> reloaded =
+      ReadGraphFromBinaryString<StaticGraph<>>(input);
+  ASSERT_TRUE(reloaded.ok()) << reloaded.status();
+  const absl::StatusOr<absl::Span<const char>> colors =
+      ViewArrayInBinaryString<char>(input);
+  ASSERT_TRUE(colors.ok()) << colors.status();
+  EXPECT_THAT(*colors, ElementsAre('r', 'g', 'b'));
+  const absl::StatusOr<absl::Span<const int64_t>> lengths =
+      ViewArrayInBinaryString<int64_t>(input);
+  ASSERT_TRUE(lengths.ok()) << lengths.status();
+  EXPECT_THAT(*lengths, ElementsAreArray(arc_lengths));
+  // The lengths are just before the size of the empty array.
+  EXPECT_EQ(lengths->data(),
+            reinterpret_cast<const int64_t*>(data.data() + data.size() - 32));
+  const absl::StatusOr<absl::Span<const double>> empty =
+      ViewArrayInBinaryString<double>(input);
+  ASSERT_TRUE(empty.ok()) << empty.status();
+  EXPECT_THAT(*empty, IsEmpty());
+  EXPECT_TRUE(input.empty());
+  EXPECT_EQ(ViewArrayInBinaryString<double>(input).status().code(),
+            absl::StatusCode::kInvalidArgument);
+}
+
+TEST(BinaryGraphTest, RejectsInvalidData) {
+  std::mt19937 random(42);
+  const auto graph = RandomGraph<ReverseArcStaticGraph<>>(50, 200, random);
+  std::string data;
+  AppendGraphToBinaryString(graph, data);
+
+  const auto read = [](absl::string_view input) {
+    return ReadGraphFromBinaryString<ReverseArcStaticGraph<>>(input)
+        .status()
+        .code();
+  };
+  EXPECT_EQ(read(data), absl::StatusCode::kOk);
+  EXPECT_EQ(read("garbage"), absl::StatusCode::kInvalidArgument);
+  EXPECT_EQ(read(absl::string_view(data).substr(0, data.size() - 8)),
+            absl::StatusCode::kInvalidArgument);
+  absl::string_view input = data;
+  EXPECT_EQ(ReadGraphFromBinaryString<StaticGraph<>>(input).status().code(),
+            absl::StatusCode::kInvalidArgument);
+  input = data;
+  EXPECT_EQ((ReadGraphFromBinaryString<ReverseArcStaticGraph<int64_t, int64_t>>(
+                 input)
+                 .status()
+                 .code()),
+            absl::StatusCode::kInvalidArgument);
+
+  // The last two opposite arcs are swapped, which breaks the ranges of
+  // reverse arcs per node unless the two forward arcs have the same head.
+  std::string corrupted = data;
+  int32_t opposites[2];
+  std::memcpy(opposites, corrupted.data() + corrupted.size() - 8, 8);
+  std::swap(opposites[0], opposites[1]);
+  std::memcpy(corrupted.data() + corrupted.size() - 8, opposites, 8);
+  const int last_arc = graph.num_arcs() - 1;
+  if (graph.Head(last_arc) != graph.Head(last_arc - 1)) {
+    EXPECT_EQ(read(corrupted), absl::StatusCode::kInvalidArgument);
+  }
+  // Two forward arcs with the same opposite arc.
+  opposites[0] = opposites[1];
+  std::memcpy(corrupted.data() + corrupted.size() - 8, opposites, 8);
+  EXPECT_EQ(read(corrupted), absl::StatusCode::kInvalidArgument);
+  // A head out of range: the heads are right before the 8-byte size and the
+  // 800 bytes of the opposite arcs.
+  corrupted = data;
+  const int32_t invalid_head = 50;
+  std::memcpy(corrupted.data() + corrupted.size() - 808 - 4, &invalid_head, 4);
+  EXPECT_EQ(read(corrupted), absl::StatusCode::kInvalidArgument);
+}
+
+}  // namespace
+}  // namespace util
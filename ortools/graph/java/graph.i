@@ -56,6 +56,7 @@
 %unignore operations_research::SimpleMaxFlow::~SimpleMaxFlow;
 %rename (addArcWithCapacity) operations_research::SimpleMaxFlow::AddArcWithCapacity;
 %rename (setArcCapacity) operations_research::SimpleMaxFlow::SetArcCapacity;
+%rename (setNumThreads) operations_research::SimpleMaxFlow::SetNumThreads;
 %rename (getNumNodes) operations_research::SimpleMaxFlow::NumNodes;  // untested
 %rename (getNumArcs) operations_research::SimpleMaxFlow::NumArcs;
 %rename (getTail) operations_research::SimpleMaxFlow::Tail;
@@ -103,9 +104,13 @@
 %rename (addArcWithCapacityAndUnitCost)
     operations_research::SimpleMinCostFlow::AddArcWithCapacityAndUnitCost;
 %rename (setNodeSupply) operations_research::SimpleMinCostFlow::SetNodeSupply;
+%rename (setArcCapacity) operations_research::SimpleMinCostFlow::SetArcCapacity;
+%rename (setArcUnitCost) operations_research::SimpleMinCostFlow::SetArcUnitCost;
 %rename (solve) operations_research::SimpleMinCostFlow::Solve;
 %rename (solveMaxFlowWithMinCost)
     operations_research::SimpleMinCostFlow::SolveMaxFlowWithMinCost;  // untested
+%rename (solveFromLastSolution)
+    operations_research::SimpleMinCostFlow::SolveFromLastSolution;
 %rename (getOptimalCost) operations_research::SimpleMinCostFlow::OptimalCost;
 %rename (getMaximumFlow) operations_research::SimpleMinCostFlow::MaximumFlow;  // untested
 %rename (getFlow) operations_research::SimpleMinCostFlow::Flow;
@@ -132,12 +137,16 @@
 %unignore operations_research::SimpleLinearSumAssignment::SimpleLinearSumAssignment;
 %unignore operations_research::SimpleLinearSumAssignment::~SimpleLinearSumAssignment;
 %rename (addArcWithCost) operations_research::SimpleLinearSumAssignment::AddArcWithCost;
+%rename (setArcCost) operations_research::SimpleLinearSumAssignment::SetArcCost;
+%rename (setNumThreads) operations_research::SimpleLinearSumAssignment::SetNumThreads;
 %rename (getNumNodes) operations_research::SimpleLinearSumAssignment::NumNodes;
 %rename (getNumArcs) operations_research::SimpleLinearSumAssignment::NumArcs;  // untested
 %rename (getLeftNode) operations_research::SimpleLinearSumAssignment::LeftNode;  // untested
 %rename (getRightNode) operations_research::SimpleLinearSumAssignment::RightNode;  // untested
 %rename (getCost) operations_research::SimpleLinearSumAssignment::Cost;  // untested
 %rename (solve) operations_research::SimpleLinearSumAssignment::Solve;
+%rename (solveFromLastSolution)
+    operations_research::SimpleLinearSumAssignment::SolveFromLastSolution;
 %rename (getOptimalCost) operations_research::SimpleLinearSumAssignment::OptimalCost;
 %rename (getRightMate) operations_research::SimpleLinearSumAssignment::RightMate;
 %rename (getAssignmentCost) operations_research::SimpleLinearSumAssignment::AssignmentCost;
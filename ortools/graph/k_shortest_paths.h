@@ -51,8 +51,10 @@
 #define OR_TOOLS_GRAPH_K_SHORTEST_PATHS_H_
 
 #include <algorithm>
+#include <cstdint>
 #include <iterator>
 #include <limits>
+#include <memory>
 #include <queue>
 #include <tuple>
 #include <utility>
@@ -62,6 +64,7 @@
 #include "absl/base/optimization.h"
 #include "absl/log/check.h"
 #include "absl/types/span.h"
+#include "ortools/base/threadpool.h"
 #include "ortools/graph/bounded_dijkstra.h"
 #include "ortools/graph/ebert_graph.h"
 #include "ortools/graph/shortest_paths.h"
@@ -105,11 +108,26 @@ struct KShortestPaths {
 // Yen, Jin Y. "Finding the k Shortest Loopless Paths in a Network". Management
 // Science. 17 (11): 712–716, 1971.
 // https://doi.org/10.1287%2Fmnsc.17.11.712
+//
+// If `thread_pool` is not nullptr, the spur paths of each iteration are
+// computed in parallel on its workers (and on the calling thread). The result
+// does not depend on the number of threads.
 template <class GraphType>
 KShortestPaths YenKShortestPaths(const GraphType& graph,
                                  const std::vector<PathDistance>& arc_lengths,
                                  NodeIndex source, NodeIndex destination,
-                                 unsigned k);
+                                 unsigned k, ThreadPool* thread_pool = nullptr);
+
+// Same as above for many (source, destination) pairs at once: the i-th element
+// of the result contains the paths for `source_destination_pairs[i]`. The pairs
+// are processed in parallel on `thread_pool` (and on the calling thread), or
+// sequentially if it is nullptr. This is more efficient than parallelizing each
+// call as soon as there are more pairs than threads.
+template <class GraphType>
+std::vector<KShortestPaths> YenKShortestPaths(
+    const GraphType& graph, const std::vector<PathDistance>& arc_lengths,
+    absl::Span<const std::pair<NodeIndex, NodeIndex>> source_destination_pairs,
+    unsigned k, ThreadPool* thread_pool);
 
 // End of the interface. Below is the implementation.
 
@@ -141,34 +159,38 @@ ArcIndex FindArcIndex(const GraphType& graph, const NodeIndex source,
   return (arc != outgoing_arcs_iter.end()) ? *arc : GraphType::kNilArc;
 }
 
-// Determines the shortest path from the given source and destination, returns a
-// tuple with the path (as a vector of node indices) and its cost.
+// Determines the shortest path from the given source and destination with the
+// given Dijkstra wrapper, returns a tuple with the path (as a vector of node
+// indices) and its cost. The search stops as soon as the destination is
+// reached.
 template <class GraphType>
 std::tuple<std::vector<NodeIndex>, PathDistance> ComputeShortestPath(
-    const GraphType& graph, const std::vector<PathDistance>& arc_lengths,
+    BoundedDijkstraWrapper<GraphType, PathDistance>& dijkstra,
     const NodeIndex source, const NodeIndex destination) {
-  BoundedDijkstraWrapper<GraphType, PathDistance> dijkstra(&graph,
-                                                           &arc_lengths);
-  dijkstra.RunBoundedDijkstra(source, kMaxDistance);
-  const PathDistance path_length = dijkstra.distances()[destination];
-
-  if (path_length >= kMaxDistance) {
+  if (!dijkstra.OneToOneShortestPath(source, destination, kMaxDistance)) {
     // There are shortest paths in this graph, just not from the source to this
-    // destination.
-    // This case only happens when some arcs have an infinite length (i.e.
-    // larger than `kMaxDistance`): `BoundedDijkstraWrapper::NodePathTo` fails
-    // to return a path, even empty.
+    // destination with a length below `kMaxDistance`. This happens in
+    // particular when some arcs have an infinite length.
     return {{}, kDisconnectedDistance};
   }
 
-  if (std::vector<NodeIndex> path = std::move(dijkstra.NodePathTo(destination));
+  if (std::vector<NodeIndex> path = dijkstra.NodePathTo(destination);
       !path.empty()) {
-    return {std::move(path), path_length};
+    return {std::move(path), dijkstra.distances()[destination]};
   } else {
     return {{}, kDisconnectedDistance};
   }
 }
 
+template <class GraphType>
+std::tuple<std::vector<NodeIndex>, PathDistance> ComputeShortestPath(
+    const GraphType& graph, const std::vector<PathDistance>& arc_lengths,
+    const NodeIndex source, const NodeIndex destination) {
+  BoundedDijkstraWrapper<GraphType, PathDistance> dijkstra(&graph,
+                                                           &arc_lengths);
+  return ComputeShortestPath(dijkstra, source, destination);
+}
+
 // Computes the total length of a path.
 template <class GraphType>
 PathDistance ComputePathLength(const GraphType& graph,
@@ -213,6 +235,105 @@ class UnderlyingContainerAdapter : public Container {
   [[nodiscard]] const container_type& container() const { return this->c; }
 };
 
+// Computes the deviation from `last_shortest_path` at the given spur node
+// position, i.e. the shortest path that coincides with `last_shortest_path` up
+// to its spur node, then with none of the `previous_paths`. Returns an empty
+// vector if there is no such path.
+//
+// `arc_lengths_for_detour` must contain the arc lengths of the graph, which are
+// also used by `dijkstra`. It is modified during the call, but restored before
+// returning: a single copy can thus be used for all the spur nodes.
+template <class GraphType>
+std::vector<NodeIndex> ComputeDeviationPath(
+    const GraphType& graph, absl::Span<const NodeIndex> last_shortest_path,
+    int spur_node_position,
+    absl::Span<const std::vector<NodeIndex>> previous_paths,
+    std::vector<PathDistance>& arc_lengths_for_detour,
+    BoundedDijkstraWrapper<GraphType, PathDistance>& dijkstra) {
+  const NodeIndex source = last_shortest_path.front();
+  const NodeIndex destination = last_shortest_path.back();
+  if (spur_node_position > 0) {
+    DCHECK_NE(last_shortest_path[spur_node_position], source);
+  }
+  DCHECK_NE(last_shortest_path[spur_node_position], destination);
+
+  const NodeIndex spur_node = last_shortest_path[spur_node_position];
+  // Consider the part of the last shortest path up to and including the spur
+  // node. If spur_node_position == 0, this span only contains the source node.
+  const absl::Span<const NodeIndex> root_path =
+      last_shortest_path.subspan(0, spur_node_position + 1);
+  DCHECK_GE(root_path.length(), 1);
+  DCHECK_NE(root_path.back(), destination);
+
+  // Simplify the graph to have different paths using infinite lengths: set
+  // some of them to infinity, and remember their previous value.
+  //
+  // This trick is used in the original article (it's old-fashioned), but not
+  // in Wikipedia's pseudocode (it prefers mutating the graph, which is harder
+  // to do without copying the whole graph structure).
+  std::vector<std::pair<ArcIndex, PathDistance>> forbidden_arcs;
+  for (absl::Span<const NodeIndex> previous_path : previous_paths) {
+    // Check among the previous paths: if part of the path coincides with the
+    // first few nodes up to the spur node (included), forbid this part of the
+    // path in the search for the next shortest path. More precisely, in that
+    // case, avoid the arc from the spur node to the next node in the path.
+    if (previous_path.size() <= root_path.size()) continue;
+    const bool has_same_prefix_as_root_path =
+        std::equal(root_path.begin(), root_path.end(), previous_path.begin());
+    if (has_same_prefix_as_root_path) {
+      const ArcIndex after_spur_node_arc =
+          FindArcIndex(graph, previous_path[spur_node_position],
+                       previous_path[spur_node_position + 1]);
+      forbidden_arcs.push_back(
+          {after_spur_node_arc, arc_lengths_for_detour[after_spur_node_arc]});
+      arc_lengths_for_detour[after_spur_node_arc] = kDisconnectedDistance;
+    }
+  }
+
+  // Generate a new candidate path from the spur node to the destination
+  // without using the forbidden arcs.
+  std::vector<NodeIndex> spur_path =
+      std::get<0>(ComputeShortestPath(dijkstra, spur_node, destination));
+
+  // Restore in reverse order, in case the same arc was forbidden twice.
+  for (int i = forbidden_arcs.size() - 1; i >= 0; --i) {
+    arc_lengths_for_detour[forbidden_arcs[i].first] = forbidden_arcs[i].second;
+  }
+
+  // Node unreachable after some arcs are forbidden.
+  if (spur_path.empty()) return {};
+
+#ifndef NDEBUG
+  CHECK_EQ(root_path.back(), spur_path.front());
+
+  if (spur_path.size() == 1) {
+    CHECK_EQ(spur_path.front(), destination);
+  } else {
+    // Ensure there is an edge between the end of the root path and the
+    // beginning of the spur path (knowing that both subpaths coincide at the
+    // spur node).
+    const bool root_path_leads_to_spur_path = absl::c_any_of(
+        graph.OutgoingArcs(root_path.back()),
+        [&graph, node_after_spur_in_spur_path =
+                     *(spur_path.begin() + 1)](const ArcIndex arc_index) {
+          return graph.Head(arc_index) == node_after_spur_in_spur_path;
+        });
+    CHECK(root_path_leads_to_spur_path);
+  }
+#endif  // !defined(NDEBUG)
+
+  // Assemble the new path.
+  std::vector<NodeIndex> new_path;
+  new_path.reserve(spur_node_position + spur_path.size());
+  absl::c_copy(root_path.subspan(0, spur_node_position),
+               std::back_inserter(new_path));
+  absl::c_copy(spur_path, std::back_inserter(new_path));
+
+  DCHECK_EQ(new_path.front(), source);
+  DCHECK_EQ(new_path.back(), destination);
+  return new_path;
+}
+
 }  // namespace internal
 
 // TODO(user): Yen's algorithm can work with negative weights, but
@@ -261,7 +382,7 @@ template <class GraphType>
 KShortestPaths YenKShortestPaths(const GraphType& graph,
                                  const std::vector<PathDistance>& arc_lengths,
                                  NodeIndex source, NodeIndex destination,
-                                 unsigned k) {
+                                 unsigned k, ThreadPool* thread_pool) {
   CHECK_GT(internal::kDisconnectedDistance, internal::kMaxDistance);
 
   CHECK_GE(k, 0) << "k must be nonnegative. Input value: " << k;
@@ -302,126 +423,75 @@ KShortestPaths YenKShortestPaths(const GraphType& graph,
       std::priority_queue<internal::PathWithPriority>>
       variant_path_queue;
 
+  // When running sequentially, the same copy of the arc lengths and the same
+  // Dijkstra wrapper are used for all the spur nodes.
+  std::vector<PathDistance> arc_lengths_for_detour;
+  std::unique_ptr<BoundedDijkstraWrapper<GraphType, PathDistance>> dijkstra;
+  if (thread_pool == nullptr) {
+    arc_lengths_for_detour = arc_lengths;
+    dijkstra =
+        std::make_unique<BoundedDijkstraWrapper<GraphType, PathDistance>>(
+            &graph, &arc_lengths_for_detour);
+  }
+
+  std::vector<std::vector<NodeIndex>> new_paths;
   for (; k > 0; --k) {
-    // Generate variant paths from the last shortest path.
-    const absl::Span<NodeIndex> last_shortest_path =
-        absl::MakeSpan(paths.paths.back());
-
-    // TODO(user): think about adding parallelism for this loop to improve
-    // running times.
-    for (int spur_node_position = 0;
-         spur_node_position < last_shortest_path.size() - 1;
-         ++spur_node_position) {
-      if (spur_node_position > 0) {
-        DCHECK_NE(last_shortest_path[spur_node_position], source);
-      }
-      DCHECK_NE(last_shortest_path[spur_node_position], destination);
-
-      const NodeIndex spur_node = last_shortest_path[spur_node_position];
-      // Consider the part of the last shortest path up to and excluding the
-      // spur node. If spur_node_position == 0, this span only contains the
-      // source node.
-      const absl::Span<NodeIndex> root_path =
-          last_shortest_path.subspan(0, spur_node_position + 1);
-      DCHECK_GE(root_path.length(), 1);
-      DCHECK_NE(root_path.back(), destination);
-
-      // Simplify the graph to have different paths using infinite lengths:
-      // copy the weights, set some of them to infinity. There is no need to
-      // restore the graph to its previous state in this case.
-      //
-      // This trick is used in the original article (it's old-fashioned), but
-      // not in Wikipedia's pseudocode (it prefers mutating the graph, which is
-      // harder to do without copying the whole graph structure).
-      // Copying the whole graph might be quite expensive, especially as it is
-      // not useful for long (computing one shortest path).
-      std::vector<PathDistance> arc_lengths_for_detour = arc_lengths;
-      for (absl::Span<const NodeIndex> previous_path : paths.paths) {
-        // Check among the previous paths: if part of the path coincides with
-        // the first few nodes up to the spur node (included), forbid this part
-        // of the path in the search for the next shortest path. More
-        // precisely, in that case, avoid the arc from the spur node to the
-        // next node in the path.
-        if (previous_path.size() < spur_node_position) continue;
-        const bool has_same_prefix_as_root_path = std::equal(
-            root_path.begin(), root_path.end(), previous_path.begin(),
-            previous_path.begin() + root_path.length());
-        if (has_same_prefix_as_root_path) {
-          const ArcIndex after_spur_node_arc =
-              internal::FindArcIndex(graph, previous_path[spur_node_position],
-                                     previous_path[spur_node_position + 1]);
-          arc_lengths_for_detour[after_spur_node_arc] =
-              internal::kDisconnectedDistance;
-        }
+    // Generate variant paths from the last shortest path, one per spur node.
+    // They are computed independently, then added to the queue in order.
+    const absl::Span<const NodeIndex> last_shortest_path = paths.paths.back();
+    const int num_spur_nodes = last_shortest_path.size() - 1;
+    new_paths.assign(num_spur_nodes, {});
+    if (thread_pool == nullptr) {
+      for (int spur_node_position = 0; spur_node_position < num_spur_nodes;
+           ++spur_node_position) {
+        new_paths[spur_node_position] = internal::ComputeDeviationPath(
+            graph, last_shortest_path, spur_node_position, paths.paths,
+            arc_lengths_for_detour, *dijkstra);
       }
+    } else {
+      ParallelFor(
+          thread_pool, 0, num_spur_nodes, /*grain=*/1,
+          [&](int64_t begin, int64_t end) {
+            // Each chunk needs its own copy of the arc lengths.
+            std::vector<PathDistance> chunk_arc_lengths = arc_lengths;
+            BoundedDijkstraWrapper<GraphType, PathDistance> chunk_dijkstra(
+                &graph, &chunk_arc_lengths);
+            for (int64_t spur_node_position = begin; spur_node_position < end;
+                 ++spur_node_position) {
+              new_paths[spur_node_position] = internal::ComputeDeviationPath(
+                  graph, last_shortest_path, spur_node_position, paths.paths,
+                  chunk_arc_lengths, chunk_dijkstra);
+            }
+          });
+    }
 
-      // Generate a new candidate path from the spur node to the destination
-      // without using the forbidden arcs.
-      {
-        std::tuple<std::vector<NodeIndex>, PathDistance> detour_path =
-            internal::ComputeShortestPath(graph, arc_lengths_for_detour,
-                                          spur_node, destination);
-
-        if (std::get<0>(detour_path).empty()) {
-          // Node unreachable after some arcs are forbidden.
-          continue;
-        }
-        std::vector<NodeIndex> spur_path = std::move(std::get<0>(detour_path));
-        if (ABSL_PREDICT_FALSE(spur_path.empty())) continue;
-
-#ifndef NDEBUG
-        CHECK_EQ(root_path.back(), spur_path.front());
-
-        if (spur_path.size() == 1) {
-          CHECK_EQ(spur_path.front(), destination);
-        } else {
-          // Ensure there is an edge between the end of the root path
-          // and the beginning of the spur path (knowing that both subpaths
-          // coincide at the spur node).
-          const bool root_path_leads_to_spur_path = absl::c_any_of(
-              graph.OutgoingArcs(root_path.back()),
-              [&graph, node_after_spur_in_spur_path =
-                           *(spur_path.begin() + 1)](const ArcIndex arc_index) {
-                return graph.Head(arc_index) == node_after_spur_in_spur_path;
-              });
-          CHECK(root_path_leads_to_spur_path);
-        }
-#endif  // !defined(NDEBUG)
-
-        // Assemble the new path.
-        std::vector<NodeIndex> new_path;
-        absl::c_copy(root_path.subspan(0, spur_node_position),
-                     std::back_inserter(new_path));
-        absl::c_copy(spur_path, std::back_inserter(new_path));
-
-        DCHECK_EQ(new_path.front(), source);
-        DCHECK_EQ(new_path.back(), destination);
-
-        // Ensure the new path is not one of the previously known ones. This
-        // operation is required, as there are two sources of paths from the
-        // source to the destination:
-        // - `paths`, the list of paths that is output by the function: there
-        //   is no possible duplicate due to `arc_lengths_for_detour`, where
-        //   edges that might generate a duplicate path are forbidden.
-        // - `variant_path_queue`, the list of potential paths, ordered by
-        //   their cost, with no impact on `arc_lengths_for_detour`.
-        // TODO(user): would it be faster to fingerprint the paths and
-        // filter by fingerprints? Due to the probability of error with
-        // fingerprints, still use this slow-but-exact code, but after
-        // filtering.
-        const bool is_new_path_already_known =
-            std::any_of(variant_path_queue.container().cbegin(),
-                        variant_path_queue.container().cend(),
-                        [&new_path](const internal::PathWithPriority& element) {
-                          return element.path() == new_path;
-                        });
-        if (is_new_path_already_known) continue;
-
-        const PathDistance path_length =
-            internal::ComputePathLength(graph, arc_lengths, new_path);
-        variant_path_queue.emplace(
-            /*priority=*/path_length, /*path=*/std::move(new_path));
-      }
+    for (std::vector<NodeIndex>& new_path : new_paths) {
+      if (new_path.empty()) continue;
+
+      // Ensure the new path is not one of the previously known ones. This
+      // operation is required, as there are two sources of paths from the
+      // source to the destination:
+      // - `paths`, the list of paths that is output by the function: there
+      //   is no possible duplicate due to `arc_lengths_for_detour`, where
+      //   edges that might generate a duplicate path are forbidden.
+      // - `variant_path_queue`, the list of potential paths, ordered by
+      //   their cost, with no impact on `arc_lengths_for_detour`.
+      // TODO(user): would it be faster to fingerprint the paths and
+      // filter by fingerprints? Due to the probability of error with
+      // fingerprints, still use this slow-but-exact code, but after
+      // filtering.
+      const bool is_new_path_already_known =
+          std::any_of(variant_path_queue.container().cbegin(),
+                      variant_path_queue.container().cend(),
+                      [&new_path](const internal::PathWithPriority& element) {
+                        return element.path() == new_path;
+                      });
+      if (is_new_path_already_known) continue;
+
+      const PathDistance path_length =
+          internal::ComputePathLength(graph, arc_lengths, new_path);
+      variant_path_queue.emplace(
+          /*priority=*/path_length, /*path=*/std::move(new_path));
     }
 
     // Add the shortest spur path ever found that has not yet been added. This
@@ -439,6 +509,24 @@ KShortestPaths YenKShortestPaths(const GraphType& graph,
   return paths;
 }
 
+template <class GraphType>
+std::vector<KShortestPaths> YenKShortestPaths(
+    const GraphType& graph, const std::vector<PathDistance>& arc_lengths,
+    absl::Span<const std::pair<NodeIndex, NodeIndex>> source_destination_pairs,
+    unsigned k, ThreadPool* thread_pool) {
+  std::vector<KShortestPaths> result(source_destination_pairs.size());
+  ParallelFor(thread_pool, 0, source_destination_pairs.size(), /*grain=*/1,
+              [&](int64_t begin, int64_t end) {
+                for (int64_t i = begin; i < end; ++i) {
+                  const auto [source, destination] =
+                      source_destination_pairs[i];
+                  result[i] = YenKShortestPaths(graph, arc_lengths, source,
+                                                destination, k);
+                }
+              });
+  return result;
+}
+
 }  // namespace operations_research
 
 #endif  // OR_TOOLS_GRAPH_K_SHORTEST_PATHS_H_
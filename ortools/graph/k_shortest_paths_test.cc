@@ -13,10 +13,12 @@
 
 #include "ortools/graph/k_shortest_paths.h"
 
+#include <utility>
 #include <vector>
 
 #include "gtest/gtest.h"
 #include "ortools/base/gmock.h"
+#include "ortools/base/threadpool.h"
 #include "ortools/graph/graph.h"
 #include "ortools/graph/shortest_paths.h"
 
@@ -164,6 +166,68 @@ TEST(KShortestPathsYenTest, HasTwoPathsWithLongerPath) {
   EXPECT_THAT(paths.distances, ElementsAre(4, 30));
 }
 
+// A grid graph with arcs to the right and to the bottom, with many paths of
+// different lengths between the corners.
+StaticGraph<> GridGraph(int size, std::vector<PathDistance>* lengths) {
+  StaticGraph<> graph;
+  lengths->clear();
+  for (int row = 0; row < size; ++row) {
+    for (int col = 0; col < size; ++col) {
+      const int node = row * size + col;
+      if (col + 1 < size) {
+        graph.AddArc(node, node + 1);
+        lengths->push_back(1 + (row * 7 + col * 3) % 5);
+      }
+      if (row + 1 < size) {
+        graph.AddArc(node, node + size);
+        lengths->push_back(1 + (row * 5 + col * 11) % 7);
+      }
+    }
+  }
+  std::vector<int> permutation;
+  graph.Build(&permutation);
+  util::Permute(permutation, lengths);
+  return graph;
+}
+
+TEST(KShortestPathsYenTest, ParallelSpurPathsGiveTheSameResult) {
+  std::vector<PathDistance> lengths;
+  const StaticGraph<> graph = GridGraph(6, &lengths);
+  ThreadPool pool(4);
+  pool.StartWorkers();
+
+  const KShortestPaths sequential =
+      YenKShortestPaths(graph, lengths, /*source=*/0, /*destination=*/35,
+                        /*k=*/20);
+  const KShortestPaths parallel =
+      YenKShortestPaths(graph, lengths, /*source=*/0, /*destination=*/35,
+                        /*k=*/20, &pool);
+  EXPECT_EQ(sequential.paths.size(), 20);
+  EXPECT_EQ(sequential.paths, parallel.paths);
+  EXPECT_EQ(sequential.distances, parallel.distances);
+}
+
+TEST(KShortestPathsYenTest, BatchOfPairs) {
+  std::vector<PathDistance> lengths;
+  const StaticGraph<> graph = GridGraph(5, &lengths);
+  const std::vector<std::pair<NodeIndex, NodeIndex>> pairs = {
+      {0, 24}, {1, 23}, {5, 19}, {24, 0}, {6, 18}};
+  ThreadPool pool(3);
+  pool.StartWorkers();
+
+  const std::vector<KShortestPaths> batch =
+      YenKShortestPaths(graph, lengths, pairs, /*k=*/5, &pool);
+  ASSERT_EQ(batch.size(), pairs.size());
+  for (int i = 0; i < pairs.size(); ++i) {
+    const KShortestPaths single = YenKShortestPaths(
+        graph, lengths, pairs[i].first, pairs[i].second, /*k=*/5);
+    EXPECT_EQ(batch[i].paths, single.paths);
+    EXPECT_EQ(batch[i].distances, single.distances);
+  }
+  // There is no path going up.
+  EXPECT_TRUE(batch[3].paths.empty());
+}
+
 // TODO(user): randomized tests? Check validity with exhaustive
 // exploration/IP formulation?
 
@@ -167,6 +167,24 @@
 // When asked to solve the given assignment problem we return a
 // boolean to indicate whether the given problem was feasible.
 //
+// Multithreading: with SetNumThreads(), each Refine() starts with rounds of a
+// "Jacobi" auction [Bertsekas and Castanon]: all the unmatched left-side nodes
+// compute their best arc and gap (their bid) concurrently against the same
+// prices, then each right-side node goes to the bidder that lowers its price
+// the most and the other bidders stay unmatched for the next round. This is
+// the same double push as above, with the pushes of a round applied together,
+// so epsilon-optimality is preserved. Once few nodes are left unmatched, the
+// refinement ends with the sequential double pushes. The result does not depend
+// on the number of threads.
+//
+// Warm start: ComputeAssignmentFromCurrentSolution() re-solves the problem
+// after some SetArcCost() calls, starting from the prices and the matching of
+// the last solve. Each refinement only unmatches the left-side nodes whose
+// matching arc violates epsilon-optimality, and the scaling restarts from a
+// small epsilon (at most kMaxWarmStartEpsilonInCostUnits cost units, or the
+// largest violation of the optimality conditions if it is smaller), so that a
+// small change in the costs only costs a few pushes.
+//
 // References:
 // [ Goldberg and Kennedy's CSA paper ] A. V. Goldberg and R. Kennedy,
 // "An Efficient Cost Scaling Algorithm for the Assignment Problem."
@@ -181,6 +199,10 @@
 // Stanford University Doctoral Dissertation, Department of Computer
 // Science, 1995.
 //
+// [ Bertsekas and Castanon ] D. P. Bertsekas, D. A. Castanon, "Parallel
+// Synchronous and Asynchronous Implementations of the Auction Algorithm."
+// Parallel Computing, Vol. 17, pages 707-732, 1991.
+//
 // [ Burkard et al. ] R. Burkard, M. Dell'Amico, S. Martello, "Assignment
 // Problems", SIAM, 2009, ISBN: 978-0898716634,
 // http://www.amazon.com/dp/0898716632/
@@ -207,6 +229,7 @@
 #include "absl/flags/declare.h"
 #include "absl/strings/str_format.h"
 #include "ortools/base/logging.h"
+#include "ortools/base/threadpool.h"
 #include "ortools/base/types.h"
 #include "ortools/graph/ebert_graph.h"
 #include "ortools/util/permutation.h"
@@ -256,6 +279,14 @@ class LinearSumAssignment {
   // divide the scaling parameter on each iteration.
   void SetCostScalingDivisor(CostValue factor) { alpha_ = factor; }
 
+  // Sets the number of threads used to compute the bids of the unmatched
+  // nodes, see the multithreading section above. Defaults to 1. This only pays
+  // off when the left-side nodes have many arcs, e.g. on dense problems.
+  void SetNumThreads(int num_threads) {
+    CHECK_GE(num_threads, 1);
+    num_threads_ = num_threads;
+  }
+
   // Returns a permutation cycle handler that can be passed to the
   // TransformToForwardStaticGraph method so that arc costs get
   // permuted along with arcs themselves.
@@ -317,6 +348,13 @@ class LinearSumAssignment {
   // value of false implies the given problem is infeasible.
   bool ComputeAssignment();
 
+  // Same as ComputeAssignment(), but starts from the prices and the matching
+  // of the last successful ComputeAssignment() (or of a previous call to this
+  // method), e.g. after a few calls to SetArcCost() on the same graph. See the
+  // warm start section above. Falls back to ComputeAssignment() if there is no
+  // previous solution.
+  bool ComputeAssignmentFromCurrentSolution();
+
   // Returns the cost of the minimum-cost perfect matching.
   // Precondition: success_ == true, signifying that we computed the
   // optimum assignment for a feasible problem.
@@ -466,6 +504,23 @@ class LinearSumAssignment {
   // epsilon-optimal. To be used in a DCHECK.
   bool EpsilonOptimal() const;
 
+  // Returns the amount by which the reduced cost of the matching arc of the
+  // given matched left-side node exceeds epsilon-optimality for epsilon = 0,
+  // i.e., the difference between the partial reduced cost of its matching arc
+  // and the smallest one of its other arcs. Returns a negative value if the
+  // node has only one arc, since its matching is forced.
+  CostValue MatchingArcSlack(NodeIndex left_node) const;
+
+  // Sets price_lower_bound_ for the scaling iterations starting from
+  // epsilon_, when all the prices are at least min_price at the start.
+  // Returns false if we cannot rule out arithmetic overflow.
+  bool SetPriceLowerBound(CostValue min_price);
+
+  // Common part of ComputeAssignment() and
+  // ComputeAssignmentFromCurrentSolution(): runs the scaling iterations from
+  // epsilon_.
+  bool RunScalingIterations();
+
   // Checks that all nodes are matched.
   // To be used in a DCHECK.
   bool AllMatched() const;
@@ -506,6 +561,12 @@ class LinearSumAssignment {
   // Performs the push/relabel work for one scaling iteration.
   bool Refine();
 
+  // Runs the rounds of the parallel auction at the start of Refine(), while
+  // there are enough unmatched nodes. Takes the unmatched nodes from
+  // active_nodes_ and puts back the remaining ones. Returns false if
+  // infeasibility is detected.
+  bool RunParallelAuctionRounds();
+
   // Puts all left-side nodes in the active set in preparation for the
   // first scaling iteration.
   void InitializeActiveNodeContainer();
@@ -518,6 +579,11 @@ class LinearSumAssignment {
   // is alwsys enough to saturate only the negative ones.
   void SaturateNegativeArcs();
 
+  // Used instead of SaturateNegativeArcs() when warm-starting: only unmatches
+  // the left-side nodes whose matching arc violates epsilon-optimality,
+  // which is enough to make the pseudoflow epsilon-optimal.
+  void UnmatchNonEpsilonOptimalNodes();
+
   // Performs an optimized sequence of pushing a unit of excess out of
   // the left-side node v and back to another left-side node if no
   // deficit is cancelled with the first push.
@@ -544,6 +610,15 @@ class LinearSumAssignment {
   // A flag indicating that an optimal perfect matching has been computed.
   bool success_;
 
+  // Whether the current computation started from the last solution, in which
+  // case Refine() keeps the epsilon-optimal part of the matching.
+  bool warm_start_;
+
+  // The number of threads, and the thread pool used during the computation
+  // when there is more than one.
+  int num_threads_;
+  std::unique_ptr<ThreadPool> thread_pool_;
+
   // The value by which we multiply all the arc costs we are given in
   // order to be able to use integer arithmetic in all our
   // computations. In order to establish optimality of the final
@@ -558,6 +633,10 @@ class LinearSumAssignment {
   // epsilon == kMinEpsilon, the flow is optimal.
   static const CostValue kMinEpsilon;
 
+  // Largest value of epsilon, in units of the (unscaled) arc costs, of the
+  // first refinement of a warm start.
+  static const CostValue kMaxWarmStartEpsilonInCostUnits;
+
   // Current value of epsilon, the cost scaling parameter.
   CostValue epsilon_;
 
@@ -952,6 +1031,15 @@ class LinearSumAssignment {
   // Statistics giving the numbers of various operations the algorithm
   // has performed in the current iteration.
   Stats iteration_stats_;
+
+  // Working memory of RunParallelAuctionRounds(): the nodes bidding in the
+  // current round and their bids, the ones left unmatched for the next round,
+  // and indexed by right-side node minus num_left_nodes_, the index of the
+  // winning bid so far in the current round, or -1.
+  std::vector<NodeIndex> bidders_;
+  std::vector<ImplicitPriceSummary> bids_;
+  std::vector<NodeIndex> next_bidders_;
+  std::vector<int64_t> winning_bid_;
 };
 
 // Implementation of out-of-line LinearSumAssignment template member
@@ -960,12 +1048,18 @@ class LinearSumAssignment {
 template <typename GraphType>
 const CostValue LinearSumAssignment<GraphType>::kMinEpsilon = 1;
 
+template <typename GraphType>
+const CostValue
+    LinearSumAssignment<GraphType>::kMaxWarmStartEpsilonInCostUnits = 100;
+
 template <typename GraphType>
 LinearSumAssignment<GraphType>::LinearSumAssignment(
     const GraphType& graph, const NodeIndex num_left_nodes)
     : graph_(&graph),
       num_left_nodes_(num_left_nodes),
       success_(false),
+      warm_start_(false),
+      num_threads_(1),
       cost_scaling_factor_(1 + num_left_nodes),
       alpha_(absl::GetFlag(FLAGS_assignment_alpha)),
       epsilon_(0),
@@ -989,6 +1083,8 @@ LinearSumAssignment<GraphType>::LinearSumAssignment(
     : graph_(nullptr),
       num_left_nodes_(num_left_nodes),
       success_(false),
+      warm_start_(false),
+      num_threads_(1),
       cost_scaling_factor_(1 + num_left_nodes),
       alpha_(absl::GetFlag(FLAGS_assignment_alpha)),
       epsilon_(0),
@@ -1105,6 +1201,15 @@ void LinearSumAssignment<GraphType>::OptimizeGraphLayout(GraphType* graph) {
 template <typename GraphType>
 CostValue LinearSumAssignment<GraphType>::NewEpsilon(
     const CostValue current_epsilon) const {
+  // When warm-starting, the matching is mostly optimal already, and large
+  // values of epsilon would only spoil the prices. Going straight to
+  // kMinEpsilon is not better though, since the few violations then turn into
+  // long price wars.
+  const CostValue max_warm_start_epsilon =
+      kMaxWarmStartEpsilonInCostUnits * cost_scaling_factor_;
+  if (warm_start_ && current_epsilon > max_warm_start_epsilon) {
+    return max_warm_start_epsilon;
+  }
   return std::max(current_epsilon / alpha_, kMinEpsilon);
 }
 
@@ -1185,6 +1290,23 @@ void LinearSumAssignment<GraphType>::SaturateNegativeArcs() {
   }
 }
 
+template <typename GraphType>
+void LinearSumAssignment<GraphType>::UnmatchNonEpsilonOptimalNodes() {
+  total_excess_ = 0;
+  for (BipartiteLeftNodeIterator node_it(*graph_, num_left_nodes_);
+       node_it.Ok(); node_it.Next()) {
+    const NodeIndex node = node_it.Index();
+    if (IsActive(node)) {
+      total_excess_ += 1;
+    } else if (MatchingArcSlack(node) > epsilon_) {
+      total_excess_ += 1;
+      const NodeIndex mate = GetMate(node);
+      matched_arc_[node] = GraphType::kNilArc;
+      matched_node_[mate] = GraphType::kNilNode;
+    }
+  }
+}
+
 // Returns true for success, false for infeasible.
 template <typename GraphType>
 bool LinearSumAssignment<GraphType>::DoublePush(NodeIndex source) {
@@ -1224,27 +1346,100 @@ bool LinearSumAssignment<GraphType>::DoublePush(NodeIndex source) {
   return new_price >= price_lower_bound_;
 }
 
+template <typename GraphType>
+bool LinearSumAssignment<GraphType>::RunParallelAuctionRounds() {
+  // Below this number of bidders, a round does not have enough work to be
+  // worth the synchronization of the threads. And when most bids are outbid in
+  // a round, e.g. because many nodes compete for the same few right-side
+  // nodes, the sequential double pushes are much faster: unlike the bids of a
+  // round, each of them sees the price changes of the previous ones.
+  constexpr int kMinNumBidders = 256;
+  constexpr int kMinWinningBidRatio = 4;
+  bidders_.clear();
+  while (!active_nodes_->Empty()) bidders_.push_back(active_nodes_->Get());
+  winning_bid_.assign(num_left_nodes_, -1);
+  bool feasible = true;
+  while (feasible && bidders_.size() >= kMinNumBidders) {
+    bids_.resize(bidders_.size());
+    ParallelForEachItem(thread_pool_.get(), num_threads_, bidders_.size(),
+                        [this](int, int64_t i) {
+                          bids_[i] = BestArcAndGap(bidders_[i]);
+                        });
+    // Each right-side node goes to the bid that lowers its price the most, or
+    // to the first one in case of a tie.
+    for (int64_t i = 0; i < bidders_.size(); ++i) {
+      if (bids_[i].first == GraphType::kNilArc) return false;
+      const NodeIndex new_mate = Head(bids_[i].first);
+      int64_t& winner = winning_bid_[new_mate - num_left_nodes_];
+      if (winner < 0 || bids_[i].second > bids_[winner].second) winner = i;
+    }
+    next_bidders_.clear();
+    int64_t num_winning_bids = 0;
+    for (int64_t i = 0; i < bidders_.size(); ++i) {
+      const NodeIndex source = bidders_[i];
+      const auto [best_arc, gap] = bids_[i];
+      const NodeIndex new_mate = Head(best_arc);
+      int64_t& winner = winning_bid_[new_mate - num_left_nodes_];
+      if (winner != i) {
+        // Outbid: this node stays unmatched and bids again in the next round.
+        next_bidders_.push_back(source);
+        continue;
+      }
+      winner = -1;
+      ++num_winning_bids;
+      const NodeIndex to_unmatch = matched_node_[new_mate];
+      if (to_unmatch != GraphType::kNilNode) {
+        matched_arc_[to_unmatch] = GraphType::kNilArc;
+        next_bidders_.push_back(to_unmatch);
+        iteration_stats_.double_pushes_ += 1;
+      } else {
+        total_excess_ -= 1;
+        iteration_stats_.pushes_ += 1;
+      }
+      matched_arc_[source] = best_arc;
+      matched_node_[new_mate] = source;
+      iteration_stats_.relabelings_ += 1;
+      const CostValue new_price = price_[new_mate] - gap - epsilon_;
+      price_[new_mate] = new_price;
+      if (new_price < price_lower_bound_) feasible = false;
+    }
+    std::swap(bidders_, next_bidders_);
+    if (num_winning_bids * kMinWinningBidRatio < next_bidders_.size()) break;
+  }
+  for (auto it = bidders_.rbegin(); it != bidders_.rend(); ++it) {
+    active_nodes_->Add(*it);
+  }
+  return feasible;
+}
+
 template <typename GraphType>
 bool LinearSumAssignment<GraphType>::Refine() {
-  SaturateNegativeArcs();
+  if (warm_start_) {
+    UnmatchNonEpsilonOptimalNodes();
+  } else {
+    SaturateNegativeArcs();
+  }
   InitializeActiveNodeContainer();
-  while (total_excess_ > 0) {
+  bool feasible = true;
+  if (thread_pool_ != nullptr) feasible = RunParallelAuctionRounds();
+  while (feasible && total_excess_ > 0) {
     // Get an active node (i.e., one with excess == 1) and discharge
     // it using DoublePush.
     const NodeIndex node = active_nodes_->Get();
-    if (!DoublePush(node)) {
-      // Infeasibility detected.
-      //
-      // If infeasibility is detected after the first iteration, we
-      // have a bug. We don't crash production code in this case but
-      // we know we're returning a wrong answer so we we leave a
-      // message in the logs to increase our hope of chasing down the
-      // problem.
-      LOG_IF(DFATAL, total_stats_.refinements_ > 0)
-          << "Infeasibility detection triggered after first iteration found "
-          << "a feasible assignment!";
-      return false;
-    }
+    feasible = DoublePush(node);
+  }
+  if (!feasible) {
+    // Infeasibility detected.
+    //
+    // If infeasibility is detected after the first iteration, we
+    // have a bug. We don't crash production code in this case but
+    // we know we're returning a wrong answer so we we leave a
+    // message in the logs to increase our hope of chasing down the
+    // problem.
+    LOG_IF(DFATAL, total_stats_.refinements_ > 0)
+        << "Infeasibility detection triggered after first iteration found "
+        << "a feasible assignment!";
+    return false;
   }
   DCHECK(active_nodes_->Empty());
   iteration_stats_.refinements_ += 1;
@@ -1411,8 +1606,20 @@ bool LinearSumAssignment<GraphType>::FinalizeSetup() {
     price_[node] = 0;
     matched_node_[node] = GraphType::kNilNode;
   }
+  const bool in_range = SetPriceLowerBound(0);
+  if (!in_range) {
+    LOG(WARNING) << "Price change bound exceeds range of representable "
+                 << "costs; arithmetic overflow is not ruled out and "
+                 << "infeasibility might go undetected.";
+  }
+  return in_range;
+}
+
+template <typename GraphType>
+bool LinearSumAssignment<GraphType>::SetPriceLowerBound(
+    const CostValue min_price) {
   bool in_range = true;
-  double double_price_lower_bound = 0.0;
+  double double_price_lower_bound = static_cast<double>(min_price);
   CostValue new_error_parameter;
   CostValue old_error_parameter = epsilon_;
   do {
@@ -1431,15 +1638,29 @@ bool LinearSumAssignment<GraphType>::FinalizeSetup() {
     price_lower_bound_ = static_cast<CostValue>(double_price_lower_bound);
   }
   VLOG(4) << "price_lower_bound_ == " << price_lower_bound_;
-  DCHECK_LE(price_lower_bound_, 0);
-  if (!in_range) {
-    LOG(WARNING) << "Price change bound exceeds range of representable "
-                 << "costs; arithmetic overflow is not ruled out and "
-                 << "infeasibility might go undetected.";
-  }
+  DCHECK_LE(price_lower_bound_, min_price);
   return in_range;
 }
 
+template <typename GraphType>
+CostValue LinearSumAssignment<GraphType>::MatchingArcSlack(
+    NodeIndex left_node) const {
+  const ArcIndex matched_arc = matched_arc_[left_node];
+  DCHECK_NE(matched_arc, GraphType::kNilArc);
+  CostValue min_partial_reduced_cost = std::numeric_limits<CostValue>::max();
+  for (typename GraphType::OutgoingArcIterator arc_it(*graph_, left_node);
+       arc_it.Ok(); arc_it.Next()) {
+    const ArcIndex arc = arc_it.Index();
+    if (arc == matched_arc) continue;
+    min_partial_reduced_cost =
+        std::min(min_partial_reduced_cost, PartialReducedCost(arc));
+  }
+  if (min_partial_reduced_cost == std::numeric_limits<CostValue>::max()) {
+    return -1;
+  }
+  return PartialReducedCost(matched_arc) - min_partial_reduced_cost;
+}
+
 template <typename GraphType>
 void LinearSumAssignment<GraphType>::ReportAndAccumulateStats() {
   total_stats_.Add(iteration_stats_);
@@ -1460,6 +1681,54 @@ bool LinearSumAssignment<GraphType>::ComputeAssignment() {
   FinalizeSetup();
   ok = ok && incidence_precondition_satisfied_;
   DCHECK(!ok || EpsilonOptimal());
+  warm_start_ = false;
+  success_ = ok && RunScalingIterations();
+  return success_;
+}
+
+template <typename GraphType>
+bool LinearSumAssignment<GraphType>::ComputeAssignmentFromCurrentSolution() {
+  if (!success_) return ComputeAssignment();
+  success_ = false;
+  // Only the price differences matter: shift them so that the largest one is
+  // zero, which keeps them in the range covered by our overflow analysis.
+  CostValue max_price = std::numeric_limits<CostValue>::min();
+  CostValue min_price = std::numeric_limits<CostValue>::max();
+  for (NodeIndex node = num_left_nodes_; node < graph_->num_nodes(); ++node) {
+    max_price = std::max(max_price, price_[node]);
+    min_price = std::min(min_price, price_[node]);
+  }
+  for (NodeIndex node = num_left_nodes_; node < graph_->num_nodes(); ++node) {
+    price_[node] -= max_price;
+  }
+  min_price -= max_price;
+  // The last matching is epsilon-optimal for the largest slack of a matching
+  // arc, which is what the price bounds of the first iteration depend on.
+  // There is nothing to do if the last matching is still optimal.
+  CostValue max_slack = 0;
+  for (NodeIndex node = 0; node < num_left_nodes_; ++node) {
+    max_slack = std::max(max_slack, MatchingArcSlack(node));
+  }
+  epsilon_ = max_slack;
+  warm_start_ = true;
+  if (!SetPriceLowerBound(min_price)) {
+    // The previous prices are too low to rule out overflow, start over.
+    warm_start_ = false;
+    return ComputeAssignment();
+  }
+  success_ = RunScalingIterations();
+  warm_start_ = false;
+  return success_;
+}
+
+template <typename GraphType>
+bool LinearSumAssignment<GraphType>::RunScalingIterations() {
+  if (num_threads_ > 1) {
+    thread_pool_ = std::make_unique<ThreadPool>("LinearSumAssignment",
+                                                num_threads_);
+    thread_pool_->StartWorkers();
+  }
+  bool ok = true;
   while (ok && epsilon_ > kMinEpsilon) {
     ok = ok && UpdateEpsilon();
     ok = ok && Refine();
@@ -1467,7 +1736,7 @@ bool LinearSumAssignment<GraphType>::ComputeAssignment() {
     DCHECK(!ok || EpsilonOptimal());
     DCHECK(!ok || AllMatched());
   }
-  success_ = ok;
+  thread_pool_.reset();
   VLOG(1) << "Overall stats: " << total_stats_.StatsString();
   return ok;
 }
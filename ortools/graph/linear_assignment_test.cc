@@ -518,6 +518,109 @@ INSTANTIATE_TEST_CASE_P(MacholWienProblems, MacholWien,
                                            ::testing::Bool()));
 #endif  // LARGE
 
+// A complete bipartite graph with random costs in [0, cost_limit).
+class DenseAssignmentTest : public ::testing::Test {
+ protected:
+  typedef util::StaticGraph<> GraphType;
+
+  void BuildProblem(int num_left_nodes, CostValue cost_limit) {
+    std::mt19937 random(1234);
+    num_left_nodes_ = num_left_nodes;
+    graph_ = std::make_unique<GraphType>(2 * num_left_nodes,
+                                         num_left_nodes * num_left_nodes);
+    costs_.clear();
+    for (int left = 0; left < num_left_nodes; ++left) {
+      for (int right = 0; right < num_left_nodes; ++right) {
+        graph_->AddArc(left, num_left_nodes + right);
+        costs_.push_back(absl::Uniform(random, 0, cost_limit));
+      }
+    }
+    graph_->Build();
+  }
+
+  std::unique_ptr<LinearSumAssignment<GraphType>> NewAssignment() const {
+    auto assignment = std::make_unique<LinearSumAssignment<GraphType>>(
+        *graph_, num_left_nodes_);
+    for (int arc = 0; arc < costs_.size(); ++arc) {
+      assignment->SetArcCost(arc, costs_[arc]);
+    }
+    return assignment;
+  }
+
+  std::vector<int> Mates(const LinearSumAssignment<GraphType>& assignment) {
+    std::vector<int> mates;
+    for (int left = 0; left < num_left_nodes_; ++left) {
+      mates.push_back(assignment.GetMate(left));
+    }
+    return mates;
+  }
+
+  int num_left_nodes_ = 0;
+  std::unique_ptr<GraphType> graph_;
+  std::vector<CostValue> costs_;
+};
+
+TEST_F(DenseAssignmentTest, ParallelAuctionFindsOptimum) {
+  BuildProblem(400, 100000);
+  auto sequential = NewAssignment();
+  ASSERT_TRUE(sequential->ComputeAssignment());
+  std::vector<std::vector<int>> mates;
+  for (const int num_threads : {2, 4}) {
+    auto parallel = NewAssignment();
+    parallel->SetNumThreads(num_threads);
+    ASSERT_TRUE(parallel->ComputeAssignment());
+    EXPECT_EQ(parallel->GetCost(), sequential->GetCost());
+    mates.push_back(Mates(*parallel));
+  }
+  // The result does not depend on the number of threads.
+  EXPECT_EQ(mates[0], mates[1]);
+}
+
+TEST_F(DenseAssignmentTest, WarmStartAfterCostChanges) {
+  BuildProblem(300, 1000);
+  for (const int num_threads : {1, 4}) {
+    auto assignment = NewAssignment();
+    assignment->SetNumThreads(num_threads);
+    ASSERT_TRUE(assignment->ComputeAssignment());
+    // Without any change, the last solution is still optimal.
+    const CostValue cost = assignment->GetCost();
+    ASSERT_TRUE(assignment->ComputeAssignmentFromCurrentSolution());
+    EXPECT_EQ(assignment->GetCost(), cost);
+
+    std::mt19937 random(42);
+    for (int round = 0; round < 5; ++round) {
+      for (int i = 0; i < costs_.size() / 100; ++i) {
+        const int arc = absl::Uniform<int>(random, 0, costs_.size());
+        costs_[arc] = absl::Uniform(random, 0, 1000);
+        assignment->SetArcCost(arc, costs_[arc]);
+      }
+      ASSERT_TRUE(assignment->ComputeAssignmentFromCurrentSolution());
+      auto cold = NewAssignment();
+      ASSERT_TRUE(cold->ComputeAssignment());
+      EXPECT_EQ(assignment->GetCost(), cold->GetCost()) << round;
+    }
+  }
+}
+
+TEST(LinearSumAssignmentParallelTest, Infeasible) {
+  // All the left nodes but the last one only have arcs to the first half of
+  // the right nodes.
+  const int n = 600;
+  util::StaticGraph<> graph(2 * n, n * n);
+  for (int left = 0; left < n; ++left) {
+    for (int right = 0; right < (left == n - 1 ? n : n / 2); ++right) {
+      graph.AddArc(left, n + right);
+    }
+  }
+  graph.Build();
+  LinearSumAssignment<util::StaticGraph<>> assignment(graph, n);
+  for (int arc = 0; arc < graph.num_arcs(); ++arc) {
+    assignment.SetArcCost(arc, arc % 7);
+  }
+  assignment.SetNumThreads(4);
+  EXPECT_FALSE(assignment.ComputeAssignment());
+}
+
 // Helper function for random-assignment benchmarks.
 template <typename GraphType, bool optimize_layout>
 void ConstructRandomAssignment(
@@ -0,0 +1,277 @@
+// Copyright 2010-2024 Google LLC
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Distance matrices between a set of sources and a set of targets, e.g. to
+// build the transit matrices of a vehicle routing model. Contrary to
+// `ComputeManyToManyShortestPathsWithMultipleThreads()` of shortest_paths.h,
+// no path is stored: the distances are written directly into a flat row-major
+// matrix, `distances[i * targets.size() + j]` being the distance from
+// `sources[i]` to `targets[j]`, or `kInfinity` (the max of `DistanceType`) if
+// there is no path.
+//
+// On a `ContractionHierarchy`, the bucket-based algorithm is used: one
+// exhaustive upward search from each target (in the reverse graph) records the
+// target's distance in a "bucket" at each node it settles, then one upward
+// search from each source scans the buckets of the nodes it settles. Since
+// upward searches are tiny, a 10k x 10k matrix on a road network takes about
+// as long as writing it. On a plain graph, one Dijkstra is run from each
+// source, which stops as soon as all the targets are settled.
+//
+// Both are multithreaded by blocks of sources (and of targets for the bucket
+// computation).
+
+#ifndef OR_TOOLS_GRAPH_MANY_TO_MANY_DISTANCES_H_
+#define OR_TOOLS_GRAPH_MANY_TO_MANY_DISTANCES_H_
+
+#include <algorithm>
+#include <cstdint>
+#include <functional>
+#include <limits>
+#include <memory>
+#include <queue>
+#include <utility>
+#include <vector>
+
+#include "absl/log/check.h"
+#include "absl/types/span.h"
+#include "ortools/base/threadpool.h"
+#include "ortools/graph/bounded_dijkstra.h"
+#include "ortools/graph/contraction_hierarchy.h"
+
+namespace operations_research {
+
+// Computes the `sources.size()` x `targets.size()` distance matrix on the given
+// hierarchy, see above.
+template <typename DistanceType>
+std::vector<DistanceType> ComputeManyToManyDistances(
+    const ContractionHierarchy<DistanceType>& hierarchy,
+    absl::Span<const int32_t> sources, absl::Span<const int32_t> targets,
+    int num_threads = 1);
+
+// Same, with a Dijkstra per source on `graph`, which can be any graph of
+// graph.h (without the need for reverse arcs). `arc_lengths` is indexed by arc
+// and must be non-negative. This needs no preprocessing, so it is the better
+// choice when there are few sources or when the graph is small.
+template <typename GraphType, typename DistanceType>
+std::vector<DistanceType> ComputeManyToManyDistancesOnGraph(
+    const GraphType& graph, const std::vector<DistanceType>& arc_lengths,
+    absl::Span<const int32_t> sources, absl::Span<const int32_t> targets,
+    int num_threads = 1);
+
+// Implementation.
+
+namespace internal {
+
+// The working memory of a full Dijkstra search in an upward (or downward)
+// graph of a `ContractionHierarchy`, reset sparsely after each search.
+template <typename DistanceType>
+class UpwardSearch {
+ public:
+  explicit UpwardSearch(int32_t num_nodes)
+      : distance_(num_nodes, ContractionHierarchy<DistanceType>::kInfinity) {}
+
+  // Calls `settled(node, distance)` on all the nodes reachable from `source` in
+  // the given graph (in compressed sparse row form), by increasing distance.
+  template <typename SettledFunction>
+  void Run(absl::Span<const int64_t> starts, absl::Span<const int32_t> heads,
+           absl::Span<const DistanceType> lengths, int32_t source,
+           const SettledFunction& settled);
+
+ private:
+  using HeapEntry = std::pair<DistanceType, int32_t>;
+
+  std::vector<DistanceType> distance_;
+  std::vector<int32_t> touched_;
+  std::priority_queue<HeapEntry, std::vector<HeapEntry>,
+                      std::greater<HeapEntry>>
+      heap_;
+};
+
+template <typename DistanceType>
+template <typename SettledFunction>
+void UpwardSearch<DistanceType>::Run(absl::Span<const int64_t> starts,
+                                     absl::Span<const int32_t> heads,
+                                     absl::Span<const DistanceType> lengths,
+                                     int32_t source,
+                                     const SettledFunction& settled) {
+  distance_[source] = 0;
+  touched_.push_back(source);
+  heap_.push({0, source});
+  while (!heap_.empty()) {
+    const auto [d, node] = heap_.top();
+    heap_.pop();
+    if (d > distance_[node]) continue;
+    settled(node, d);
+    for (int64_t arc = starts[node]; arc < starts[node + 1]; ++arc) {
+      const int32_t head = heads[arc];
+      const DistanceType new_distance = d + lengths[arc];
+      if (new_distance < distance_[head]) {
+        if (distance_[head] == ContractionHierarchy<DistanceType>::kInfinity) {
+          touched_.push_back(head);
+        }
+        distance_[head] = new_distance;
+        heap_.push({new_distance, head});
+      }
+    }
+  }
+  for (const int32_t node : touched_) {
+    distance_[node] = ContractionHierarchy<DistanceType>::kInfinity;
+  }
+  touched_.clear();
+}
+
+inline std::unique_ptr<ThreadPool> StartManyToManyThreadPool(int num_threads) {
+  CHECK_GE(num_threads, 1);
+  if (num_threads == 1) return nullptr;
+  auto thread_pool = std::make_unique<ThreadPool>("ManyToMany", num_threads);
+  thread_pool->StartWorkers();
+  return thread_pool;
+}
+
+}  // namespace internal
+
+template <typename DistanceType>
+std::vector<DistanceType> ComputeManyToManyDistances(
+    const ContractionHierarchy<DistanceType>& hierarchy,
+    absl::Span<const int32_t> sources, absl::Span<const int32_t> targets,
+    int num_threads) {
+  constexpr DistanceType kInfinity =
+      ContractionHierarchy<DistanceType>::kInfinity;
+  const int32_t num_nodes = hierarchy.num_nodes();
+  const int64_t num_targets = targets.size();
+  std::vector<DistanceType> distances(sources.size() * targets.size(),
+                                      kInfinity);
+  if (distances.empty()) return distances;
+  std::unique_ptr<ThreadPool> thread_pool =
+      internal::StartManyToManyThreadPool(num_threads);
+  std::vector<internal::UpwardSearch<DistanceType>> searches(
+      num_threads, internal::UpwardSearch<DistanceType>(num_nodes));
+
+  // The backward searches, whose entries are then bucketed by node.
+  struct BucketEntry {
+    int32_t node;
+    int32_t target_index;
+    DistanceType distance;
+  };
+  std::vector<std::vector<BucketEntry>> worker_entries(num_threads);
+  ParallelForEachItem(
+      thread_pool.get(), num_threads, num_targets, [&](int worker, int64_t j) {
+        DCHECK_GE(targets[j], 0);
+        DCHECK_LT(targets[j], num_nodes);
+        std::vector<BucketEntry>& entries = worker_entries[worker];
+        searches[worker].Run(
+            hierarchy.DownwardStarts(), hierarchy.DownwardTails(),
+            hierarchy.DownwardLengths(), targets[j],
+            [&entries, j](int32_t node, DistanceType distance) {
+              entries.push_back({node, static_cast<int32_t>(j), distance});
+            });
+      });
+  std::vector<int64_t> bucket_start(num_nodes + 1, 0);
+  for (const std::vector<BucketEntry>& entries : worker_entries) {
+    for (const BucketEntry& entry : entries) ++bucket_start[entry.node + 1];
+  }
+  for (int32_t node = 0; node < num_nodes; ++node) {
+    bucket_start[node + 1] += bucket_start[node];
+  }
+  std::vector<std::pair<int32_t, DistanceType>> buckets(
+      bucket_start[num_nodes]);
+  {
+    std::vector<int64_t> next(bucket_start.begin(), bucket_start.end() - 1);
+    for (std::vector<BucketEntry>& entries : worker_entries) {
+      for (const BucketEntry& entry : entries) {
+        buckets[next[entry.node]++] = {entry.target_index, entry.distance};
+      }
+      std::vector<BucketEntry>().swap(entries);
+    }
+  }
+
+  // The forward searches, each filling one row of the matrix.
+  ParallelForEachItem(
+      thread_pool.get(), num_threads, sources.size(),
+      [&](int worker, int64_t i) {
+        DCHECK_GE(sources[i], 0);
+        DCHECK_LT(sources[i], num_nodes);
+        DistanceType* const row = distances.data() + i * num_targets;
+        searches[worker].Run(
+            hierarchy.UpwardStarts(), hierarchy.UpwardHeads(),
+            hierarchy.UpwardLengths(), sources[i],
+            [&](int32_t node, DistanceType distance) {
+              for (int64_t b = bucket_start[node]; b < bucket_start[node + 1];
+                   ++b) {
+                const auto [j, target_distance] = buckets[b];
+                row[j] = std::min(row[j], distance + target_distance);
+              }
+            });
+      });
+  return distances;
+}
+
+template <typename GraphType, typename DistanceType>
+std::vector<DistanceType> ComputeManyToManyDistancesOnGraph(
+    const GraphType& graph, const std::vector<DistanceType>& arc_lengths,
+    absl::Span<const int32_t> sources, absl::Span<const int32_t> targets,
+    int num_threads) {
+  constexpr DistanceType kInfinity = std::numeric_limits<DistanceType>::max();
+  const int64_t num_targets = targets.size();
+  std::vector<DistanceType> distances(sources.size() * targets.size(),
+                                      kInfinity);
+  if (distances.empty()) return distances;
+
+  // The indices of the targets of each node, in compressed sparse row form.
+  std::vector<int64_t> target_start(graph.num_nodes() + 1, 0);
+  for (const int32_t target : targets) ++target_start[target + 1];
+  int64_t num_distinct_targets = 0;
+  for (int64_t node = 0; node < graph.num_nodes(); ++node) {
+    if (target_start[node + 1] > 0) ++num_distinct_targets;
+    target_start[node + 1] += target_start[node];
+  }
+  std::vector<int32_t> target_indices(num_targets);
+  {
+    std::vector<int64_t> next(target_start.begin(), target_start.end() - 1);
+    for (int64_t j = 0; j < num_targets; ++j) {
+      target_indices[next[targets[j]]++] = j;
+    }
+  }
+
+  std::unique_ptr<ThreadPool> thread_pool =
+      internal::StartManyToManyThreadPool(num_threads);
+  using Dijkstra = BoundedDijkstraWrapper<GraphType, DistanceType>;
+  std::vector<std::unique_ptr<Dijkstra>> dijkstras(num_threads);
+  for (std::unique_ptr<Dijkstra>& dijkstra : dijkstras) {
+    dijkstra = std::make_unique<Dijkstra>(&graph, &arc_lengths);
+  }
+  ParallelForEachItem(
+      thread_pool.get(), num_threads, sources.size(),
+      [&](int worker, int64_t i) {
+        DistanceType* const row = distances.data() + i * num_targets;
+        int64_t num_settled_targets = 0;
+        dijkstras[worker]->RunBoundedDijkstraWithSettledNodeCallback(
+            {{sources[i], 0}},
+            [&](int node, DistanceType distance, DistanceType* limit) {
+              if (target_start[node] == target_start[node + 1]) return;
+              for (int64_t t = target_start[node]; t < target_start[node + 1];
+                   ++t) {
+                row[target_indices[t]] = distance;
+              }
+              if (++num_settled_targets == num_distinct_targets) {
+                *limit = distance;
+              }
+            },
+            kInfinity);
+      });
+  return distances;
+}
+
+}  // namespace operations_research
+
+#endif  // OR_TOOLS_GRAPH_MANY_TO_MANY_DISTANCES_H_
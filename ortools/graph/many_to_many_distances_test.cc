@@ -0,0 +1,122 @@
+// Copyright 2010-2024 Google LLC
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "ortools/graph/many_to_many_distances.h"
+
+#include <cstdint>
+#include <limits>
+#include <random>
+#include <vector>
+
+#include "absl/random/distributions.h"
+#include "gtest/gtest.h"
+#include "ortools/base/gmock.h"
+#include "ortools/graph/bounded_dijkstra.h"
+#include "ortools/graph/contraction_hierarchy.h"
+#include "ortools/graph/graph.h"
+
+namespace operations_research {
+namespace {
+
+using ::testing::ElementsAre;
+using ::testing::IsEmpty;
+using ::util::StaticGraph;
+
+constexpr int64_t kInf = std::numeric_limits<int64_t>::max();
+
+TEST(ManyToManyDistancesTest, SmallGraph) {
+  //   0 --5--> 1 --1--> 2      3 (isolated)
+  //   |                 ^
+  //   +--------7--------+
+  StaticGraph<> graph;
+  graph.AddArc(0, 1);
+  graph.AddArc(1, 2);
+  graph.AddArc(0, 2);
+  graph.AddNode(3);
+  std::vector<int> permutation;
+  graph.Build(&permutation);
+  std::vector<int64_t> arc_lengths = {5, 1, 7};
+  util::Permute(permutation, &arc_lengths);
+  const std::vector<int32_t> sources = {0, 2, 1};
+  const std::vector<int32_t> targets = {2, 0, 3, 2};
+
+  EXPECT_THAT(
+      ComputeManyToManyDistancesOnGraph(graph, arc_lengths, sources, targets),
+      ElementsAre(6, 0, kInf, 6,     //
+                  0, kInf, kInf, 0,  //
+                  1, kInf, kInf, 1));
+  const auto hierarchy =
+      ContractionHierarchy<int64_t>::Build(graph, arc_lengths);
+  EXPECT_THAT(ComputeManyToManyDistances(hierarchy, sources, targets),
+              ElementsAre(6, 0, kInf, 6,     //
+                          0, kInf, kInf, 0,  //
+                          1, kInf, kInf, 1));
+  EXPECT_THAT(ComputeManyToManyDistances(hierarchy, sources, {}), IsEmpty());
+}
+
+class ManyToManyDistancesRandomTest : public ::testing::TestWithParam<int> {};
+
+TEST_P(ManyToManyDistancesRandomTest, BucketsMatchDijkstra) {
+  const int num_threads = GetParam();
+  std::mt19937 random(1234);
+  const int num_nodes = 500;
+  const int num_arcs = 1500;
+  StaticGraph<> graph(num_nodes, num_arcs);
+  std::vector<int64_t> arc_lengths;
+  for (int i = 0; i < num_arcs; ++i) {
+    graph.AddArc(absl::Uniform(random, 0, num_nodes),
+                 absl::Uniform(random, 0, num_nodes));
+    arc_lengths.push_back(absl::Uniform(random, 0, 1000));
+  }
+  std::vector<int> permutation;
+  graph.Build(&permutation);
+  util::Permute(permutation, &arc_lengths);
+
+  std::vector<int32_t> sources(150);
+  std::vector<int32_t> targets(200);
+  for (int32_t& node : sources) node = absl::Uniform(random, 0, num_nodes);
+  for (int32_t& node : targets) node = absl::Uniform(random, 0, num_nodes);
+
+  const std::vector<int64_t> expected = ComputeManyToManyDistancesOnGraph(
+      graph, arc_lengths, sources, targets, /*num_threads=*/1);
+  ASSERT_EQ(expected.size(), sources.size() * targets.size());
+  // Spot check the reference against a one-to-one Dijkstra.
+  std::vector<int> tails;
+  std::vector<int> heads;
+  for (int arc = 0; arc < num_arcs; ++arc) {
+    tails.push_back(graph.Tail(arc));
+    heads.push_back(graph.Head(arc));
+  }
+  for (int i = 0; i < sources.size(); i += 7) {
+    for (int j = 0; j < targets.size(); j += 7) {
+      ASSERT_EQ(expected[i * targets.size() + j],
+                SimpleOneToOneShortestPath<int64_t>(sources[i], targets[j],
+                                                    tails, heads, arc_lengths)
+                    .first);
+    }
+  }
+  EXPECT_EQ(ComputeManyToManyDistancesOnGraph(graph, arc_lengths, sources,
+                                              targets, num_threads),
+            expected);
+  const auto hierarchy =
+      ContractionHierarchy<int64_t>::Build(graph, arc_lengths, num_threads);
+  EXPECT_EQ(
+      ComputeManyToManyDistances(hierarchy, sources, targets, num_threads),
+      expected);
+}
+
+INSTANTIATE_TEST_SUITE_P(NumThreads, ManyToManyDistancesRandomTest,
+                         ::testing::Values(1, 4));
+
+}  // namespace
+}  // namespace operations_research
@@ -14,6 +14,9 @@
 #include "ortools/graph/max_flow.h"
 
 #include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <functional>
 #include <limits>
 #include <memory>
 #include <string>
@@ -22,12 +25,45 @@
 #include "absl/memory/memory.h"
 #include "absl/strings/str_format.h"
 #include "absl/strings/string_view.h"
+#include "absl/synchronization/blocking_counter.h"
+#include "ortools/base/threadpool.h"
 #include "ortools/graph/graph.h"
 #include "ortools/graph/graphs.h"
 
 namespace operations_research {
 
-SimpleMaxFlow::SimpleMaxFlow() : num_nodes_(0) {}
+namespace {
+
+// Calls f(worker, begin, end) on disjoint chunks of [0, size) that together
+// cover it, on the workers of thread_pool. Chunks given to the same worker
+// never run concurrently, so f can use per-worker data without locking.
+void ParallelForChunks(
+    ThreadPool* thread_pool, int64_t size,
+    const std::function<void(int, int64_t, int64_t)>& f) {
+  constexpr int64_t kChunkSize = 256;
+  if (size <= kChunkSize) {
+    if (size > 0) f(0, 0, size);
+    return;
+  }
+  const int num_workers = thread_pool->NumWorkers();
+  std::atomic<int64_t> next_begin = 0;
+  absl::BlockingCounter counter(num_workers);
+  for (int worker = 0; worker < num_workers; ++worker) {
+    thread_pool->Schedule([&, worker]() {
+      while (true) {
+        const int64_t begin = next_begin.fetch_add(kChunkSize);
+        if (begin >= size) break;
+        f(worker, begin, std::min(size, begin + kChunkSize));
+      }
+      counter.DecrementCount();
+    });
+  }
+  counter.Wait();
+}
+
+}  // namespace
+
+SimpleMaxFlow::SimpleMaxFlow() : num_nodes_(0), num_threads_(1) {}
 
 ArcIndex SimpleMaxFlow::AddArcWithCapacity(NodeIndex tail, NodeIndex head,
                                            FlowQuantity capacity) {
@@ -56,6 +92,10 @@ void SimpleMaxFlow::SetArcCapacity(ArcIndex arc, FlowQuantity capacity) {
   arc_capacity_[arc] = capacity;
 }
 
+void SimpleMaxFlow::SetNumThreads(int num_threads) {
+  num_threads_ = num_threads;
+}
+
 SimpleMaxFlow::Status SimpleMaxFlow::Solve(NodeIndex source, NodeIndex sink) {
   const ArcIndex num_arcs = arc_capacity_.size();
   arc_flow_.assign(num_arcs, 0);
@@ -77,6 +117,7 @@ SimpleMaxFlow::Status SimpleMaxFlow::Solve(NodeIndex source, NodeIndex sink) {
   underlying_graph_->Build(&arc_permutation_);
   underlying_max_flow_ = std::make_unique<GenericMaxFlow<Graph>>(
       underlying_graph_.get(), source, sink);
+  underlying_max_flow_->SetNumThreads(num_threads_);
   for (ArcIndex arc = 0; arc < num_arcs; ++arc) {
     ArcIndex permuted_arc =
         arc < arc_permutation_.size() ? arc_permutation_[arc] : arc;
@@ -156,6 +197,7 @@ GenericMaxFlow<Graph>::GenericMaxFlow(const Graph* graph, NodeIndex source,
       process_node_by_height_(true),
       check_input_(true),
       check_result_(true),
+      num_threads_(1),
       stats_("MaxFlow") {
   SCOPED_TIME_STAT(&stats_);
   DCHECK(graph->IsNodeValid(source));
@@ -368,7 +410,9 @@ bool GenericMaxFlow<Graph>::Solve() {
     status_ = OPTIMAL;
     return true;
   }
-  if (use_global_update_) {
+  if (num_threads_ > 1) {
+    RefineInParallel();
+  } else if (use_global_update_) {
     RefineWithGlobalUpdate();
   } else {
     Refine();
@@ -862,6 +906,203 @@ void GenericMaxFlow<Graph>::RefineWithGlobalUpdate() {
   }
 }
 
+// The parallel algorithm is the synchronous push-relabel of N. Baumstark, G.
+// Blelloch and J. Shun, "Efficient Implementation of a Synchronous Parallel
+// Push-Relabel Algorithm", ESA 2015, https://arxiv.org/abs/1507.01926.
+//
+// Each round discharges all the active nodes (the "working set") in parallel.
+// The heights are only updated at the end of the round, and the excess pushed
+// to a node is accumulated separately with an atomic addition. The only
+// conflicts are between two adjacent active nodes, and they are resolved with
+// a rule based on the heights at the start of the round under which exactly
+// one of the two nodes "wins" and may use the arcs between them, the other
+// skipping them during this round. Hence each residual capacity is only
+// modified by one thread in a round, without synchronization.
+template <typename Graph>
+void GenericMaxFlow<Graph>::RefineInParallel() {
+  SCOPED_TIME_STAT(&stats_);
+  ThreadPool thread_pool("MaxFlow", num_threads_);
+  thread_pool.StartWorkers();
+  while (SaturateOutgoingArcsFromSource()) {
+    ParallelPushRelabel(&thread_pool);
+    PushFlowExcessBackToSource();
+  }
+}
+
+template <typename Graph>
+std::vector<typename Graph::NodeIndex>
+GenericMaxFlow<Graph>::ParallelGlobalUpdate(ThreadPool* thread_pool) {
+  SCOPED_TIME_STAT(&stats_);
+  const NodeIndex num_nodes = graph_->num_nodes();
+  const int num_workers = thread_pool->NumWorkers();
+  std::vector<std::atomic<bool>> is_labeled(num_nodes);
+  is_labeled[sink_] = true;
+  is_labeled[source_] = true;
+  ParallelForChunks(thread_pool, num_nodes,
+                    [&](int, int64_t begin, int64_t end) {
+                      for (NodeIndex node = begin; node < end; ++node) {
+                        if (node != sink_) node_potential_[node] = num_nodes;
+                      }
+                    });
+  node_potential_[sink_] = 0;
+
+  // Level by level breadth-first search from the sink.
+  std::vector<NodeIndex> frontier = {sink_};
+  std::vector<std::vector<NodeIndex>> next_frontiers(num_workers);
+  for (NodeHeight height = 1; !frontier.empty(); ++height) {
+    ParallelForChunks(
+        thread_pool, frontier.size(),
+        [&](int worker, int64_t begin, int64_t end) {
+          for (int64_t i = begin; i < end; ++i) {
+            for (OutgoingOrOppositeIncomingArcIterator it(*graph_,
+                                                          frontier[i]);
+                 it.Ok(); it.Next()) {
+              const ArcIndex arc = it.Index();
+              const NodeIndex head = Head(arc);
+              if (is_labeled[head].load(std::memory_order_relaxed)) continue;
+              if (residual_arc_capacity_[Opposite(arc)] == 0) continue;
+              if (is_labeled[head].exchange(true)) continue;
+              node_potential_[head] = height;
+              next_frontiers[worker].push_back(head);
+            }
+          }
+        });
+    frontier.clear();
+    for (std::vector<NodeIndex>& next : next_frontiers) {
+      frontier.insert(frontier.end(), next.begin(), next.end());
+      next.clear();
+    }
+  }
+
+  std::vector<NodeIndex> active_nodes;
+  for (NodeIndex node = 0; node < num_nodes; ++node) {
+    if (IsActive(node) && node_potential_[node] < num_nodes) {
+      active_nodes.push_back(node);
+    }
+  }
+  return active_nodes;
+}
+
+template <typename Graph>
+void GenericMaxFlow<Graph>::ParallelPushRelabel(ThreadPool* thread_pool) {
+  SCOPED_TIME_STAT(&stats_);
+  const NodeIndex num_nodes = graph_->num_nodes();
+  const int num_workers = thread_pool->NumWorkers();
+
+  // As in the paper, a global update is done when the work (number of arcs
+  // scanned) since the last one reaches this value.
+  const int64_t global_update_work =
+      6 * static_cast<int64_t>(num_nodes) + graph_->num_arcs();
+
+  std::vector<char> in_working_set(num_nodes, false);
+  std::vector<std::atomic<bool>> in_next_working_set(num_nodes);
+  std::vector<std::atomic<FlowQuantity>> added_excess(num_nodes);
+  std::vector<NodeHeight> new_height(num_nodes);
+  std::vector<std::vector<NodeIndex>> next_working_sets(num_workers);
+  std::vector<int64_t> work(num_workers, 0);
+
+  std::vector<NodeIndex> working_set = ParallelGlobalUpdate(thread_pool);
+  int64_t work_since_global_update = 0;
+  while (!working_set.empty()) {
+    for (const NodeIndex node : working_set) in_working_set[node] = true;
+    ParallelForChunks(
+        thread_pool, working_set.size(),
+        [&](int worker, int64_t begin, int64_t end) {
+          for (int64_t i = begin; i < end; ++i) {
+            const NodeIndex node = working_set[i];
+            const NodeHeight old_height = node_potential_[node];
+            NodeHeight height = old_height;
+            FlowQuantity excess = node_excess_[node];
+            while (true) {
+              NodeHeight min_height = num_nodes;
+              bool skipped = false;
+              for (OutgoingOrOppositeIncomingArcIterator it(*graph_, node);
+                   it.Ok(); it.Next()) {
+                ++work[worker];
+                const ArcIndex arc = it.Index();
+                const NodeIndex head = Head(arc);
+                const NodeHeight head_height = node_potential_[head];
+                if (in_working_set[head]) {
+                  // The winning rule: exactly one of two adjacent active
+                  // nodes wins, whatever their heights.
+                  const bool wins = old_height == head_height + 1 ||
+                                    old_height < head_height - 1 ||
+                                    (old_height == head_height && node < head);
+                  if (!wins) {
+                    skipped = true;
+                    continue;
+                  }
+                }
+                const FlowQuantity capacity = residual_arc_capacity_[arc];
+                if (capacity == 0) continue;
+                if (head_height < height) {
+                  // Pushing downhill, even by more than one level, keeps the
+                  // heights valid since the opposite arc goes uphill.
+                  const FlowQuantity flow = std::min(excess, capacity);
+                  residual_arc_capacity_[arc] -= flow;
+                  residual_arc_capacity_[Opposite(arc)] += flow;
+                  excess -= flow;
+                  added_excess[head].fetch_add(flow,
+                                               std::memory_order_relaxed);
+                  if (head != sink_ && !in_next_working_set[head].exchange(
+                                           true, std::memory_order_relaxed)) {
+                    next_working_sets[worker].push_back(head);
+                  }
+                  if (excess == 0) break;
+                } else {
+                  min_height = std::min(min_height, head_height + 1);
+                }
+              }
+              if (excess == 0 || skipped) break;
+              // Relabel. A node that cannot reach the sink anymore is left
+              // out until the second phase.
+              height = min_height;
+              if (height >= num_nodes) break;
+            }
+            new_height[node] = height;
+            node_excess_[node] = excess;
+            if (excess > 0 && height < num_nodes &&
+                !in_next_working_set[node].exchange(
+                    true, std::memory_order_relaxed)) {
+              next_working_sets[worker].push_back(node);
+            }
+          }
+        });
+
+    // Apply the new heights and the added excesses.
+    for (const NodeIndex node : working_set) {
+      node_potential_[node] = new_height[node];
+      in_working_set[node] = false;
+    }
+    working_set.clear();
+    for (std::vector<NodeIndex>& next : next_working_sets) {
+      working_set.insert(working_set.end(), next.begin(), next.end());
+      next.clear();
+    }
+    node_excess_[sink_] += added_excess[sink_].exchange(0);
+    for (const NodeIndex node : working_set) {
+      node_excess_[node] += added_excess[node].exchange(0);
+      in_next_working_set[node] = false;
+    }
+    working_set.erase(std::remove_if(working_set.begin(), working_set.end(),
+                                     [this, num_nodes](NodeIndex node) {
+                                       return node_potential_[node] >=
+                                              num_nodes;
+                                     }),
+                      working_set.end());
+
+    for (int64_t& worker_work : work) {
+      work_since_global_update += worker_work;
+      worker_work = 0;
+    }
+    if (work_since_global_update >= global_update_work &&
+        !working_set.empty()) {
+      working_set = ParallelGlobalUpdate(thread_pool);
+      work_since_global_update = 0;
+    }
+  }
+}
+
 template <typename Graph>
 void GenericMaxFlow<Graph>::Discharge(NodeIndex node) {
   SCOPED_TIME_STAT(&stats_);
@@ -139,9 +139,10 @@
 
 namespace operations_research {
 
-// Forward declaration.
+// Forward declarations.
 template <typename Graph>
 class GenericMaxFlow;
+class ThreadPool;
 
 // A simple and efficient max-cost flow interface. This is as fast as
 // GenericMaxFlow<ReverseArcStaticGraph>, which is the fastest, but uses
@@ -231,6 +232,11 @@ class SimpleMaxFlow {
   // TODO(user): Support incrementality in the max flow implementation.
   void SetArcCapacity(ArcIndex arc, FlowQuantity capacity);
 
+  // Sets the number of threads used by the next Solve() calls, 1 by default.
+  // See GenericMaxFlow::SetNumThreads(): this is only worth it on large
+  // problems (millions of arcs).
+  void SetNumThreads(int num_threads);
+
   // Creates the protocol buffer representation of the current problem.
   FlowModelProto CreateFlowModelProto(NodeIndex source, NodeIndex sink) const;
 
@@ -242,6 +248,7 @@ class SimpleMaxFlow {
   std::vector<ArcIndex> arc_permutation_;
   std::vector<FlowQuantity> arc_flow_;
   FlowQuantity optimal_flow_;
+  int num_threads_;
 
   // Note that we cannot free the graph before we stop using the max-flow
   // instance that uses it.
@@ -439,6 +446,14 @@ class GenericMaxFlow : public MaxFlowStatusClass {
     process_node_by_height_ = value && use_global_update_;
   }
 
+  // If num_threads > 1, Solve() uses a synchronous parallel push-relabel
+  // instead of the algorithm above: in each round, all the active nodes are
+  // discharged in parallel, using the heights of the beginning of the round,
+  // and a parallel breadth-first search recomputes the exact heights from time
+  // to time. This always uses the two-phase algorithm and ignores the other
+  // options, except the input and result checks. Defaults to 1.
+  void SetNumThreads(int num_threads) { num_threads_ = num_threads; }
+
   // Returns the protocol buffer representation of the current problem.
   FlowModelProto CreateFlowModel();
 
@@ -502,6 +517,20 @@ class GenericMaxFlow : public MaxFlowStatusClass {
   // Performs optimization step.
   void Refine();
   void RefineWithGlobalUpdate();
+  void RefineInParallel();
+
+  // The first phase of the algorithm used by RefineInParallel(): discharges
+  // the active nodes that can reach the sink, in synchronous parallel rounds,
+  // until there are none left.
+  void ParallelPushRelabel(ThreadPool* thread_pool);
+
+  // The parallel version of GlobalUpdate(): sets the height of each node to
+  // its distance to the sink in the reverse residual graph, or to the number
+  // of nodes if it cannot reach the sink. Unlike GlobalUpdate(), it doesn't
+  // steal excess, doesn't relabel the nodes that can only reach the source,
+  // and doesn't fill the active node containers. Instead, it returns the
+  // active nodes that can reach the sink.
+  std::vector<NodeIndex> ParallelGlobalUpdate(ThreadPool* thread_pool);
 
   // Discharges an active node node by saturating its admissible adjacent arcs,
   // if any, and by relabelling it when it becomes inactive.
@@ -654,6 +683,9 @@ class GenericMaxFlow : public MaxFlowStatusClass {
   // TODO(user): Make the check more exhaustive by checking the optimality?
   bool check_result_;
 
+  // The number of threads used by Solve(), see SetNumThreads().
+  int num_threads_;
+
   // Statistics about this class.
   mutable StatsGroup stats_;
 };
@@ -194,6 +194,28 @@ TEST(SimpleMaxFlowTest, ProblematicProblemWithMaxCapacity) {
   EXPECT_EQ(10290243, solver.OptimalFlow());
 }
 
+TEST(SimpleMaxFlowTest, MultipleThreadsGiveTheSameFlowValue) {
+  std::mt19937 random(12345);
+  SimpleMaxFlow sequential_max_flow;
+  SimpleMaxFlow parallel_max_flow;
+  parallel_max_flow.SetNumThreads(4);
+  const int kNumNodes = 2000;
+  for (int i = 0; i < 20000; ++i) {
+    const NodeIndex tail = absl::Uniform(random, 0, kNumNodes);
+    const NodeIndex head = absl::Uniform(random, 0, kNumNodes);
+    const FlowQuantity capacity = absl::Uniform(random, 0, 100);
+    sequential_max_flow.AddArcWithCapacity(tail, head, capacity);
+    parallel_max_flow.AddArcWithCapacity(tail, head, capacity);
+  }
+  for (const auto& [source, sink] : {std::pair{0, 1}, std::pair{17, 1234}}) {
+    ASSERT_EQ(sequential_max_flow.Solve(source, sink), SimpleMaxFlow::OPTIMAL);
+    ASSERT_EQ(parallel_max_flow.Solve(source, sink), SimpleMaxFlow::OPTIMAL);
+    EXPECT_GT(parallel_max_flow.OptimalFlow(), 0);
+    EXPECT_EQ(parallel_max_flow.OptimalFlow(),
+              sequential_max_flow.OptimalFlow());
+  }
+}
+
 template <typename Graph>
 typename GenericMaxFlow<Graph>::Status MaxFlowTester(
     const typename Graph::NodeIndex num_nodes,
@@ -509,6 +531,12 @@ FlowQuantity SolveMaxFlow(GenericMaxFlow<Graph>* max_flow) {
   return max_flow->GetOptimalFlow();
 }
 
+template <typename Graph>
+FlowQuantity SolveMaxFlowInParallel(GenericMaxFlow<Graph>* max_flow) {
+  max_flow->SetNumThreads(4);
+  return SolveMaxFlow(max_flow);
+}
+
 template <typename Graph>
 FlowQuantity SolveMaxFlowWithLP(GenericMaxFlow<Graph>* max_flow) {
   MPSolver solver("LPSolver", MPSolver::GLOP_LINEAR_PROGRAMMING);
@@ -657,7 +685,8 @@ void FullRandomFlow(typename MaxFlowSolver<Graph>::Solver f,
 #define LP_AND_FLOW_TEST(test_name, size, expected_flow1, expected_flow2) \
   LP_ONLY_TEST(test_name, size, expected_flow1, expected_flow2)           \
   FLOW_ONLY_TEST(test_name, size, expected_flow1, expected_flow2)         \
-  FLOW_ONLY_TEST_SG(test_name, size, expected_flow1, expected_flow2)
+  FLOW_ONLY_TEST_SG(test_name, size, expected_flow1, expected_flow2)      \
+  PARALLEL_FLOW_ONLY_TEST(test_name, size, expected_flow1, expected_flow2)
 
 #define LP_ONLY_TEST(test_name, size, expected_flow1, expected_flow2) \
   TEST(LPMaxFlowTest, test_name##size) {                              \
@@ -677,6 +706,15 @@ void FullRandomFlow(typename MaxFlowSolver<Graph>::Solver f,
                                               expected_flow1, expected_flow2); \
   }
 
+#define PARALLEL_FLOW_ONLY_TEST(test_name, size, expected_flow1,           \
+                                expected_flow2)                             \
+  TEST(ParallelMaxFlowTest, test_name##size) {                              \
+    test_name<StarGraph>(SolveMaxFlowInParallel, size, size, expected_flow1, \
+                         expected_flow2);                                   \
+    test_name<util::ReverseArcStaticGraph<> >(                              \
+        SolveMaxFlowInParallel, size, size, expected_flow1, expected_flow2); \
+  }
+
 LP_AND_FLOW_TEST(FullRandomAssignment, 300, 300, 300);
 LP_AND_FLOW_TEST(PartialRandomAssignment, 100, 100, 100);
 LP_AND_FLOW_TEST(PartialRandomAssignment, 1000, 1000, 1000);
@@ -747,6 +785,7 @@ BENCHMARK_TEMPLATE(BM_PartialRandomAssignment, util::ReverseArcMixedGraph<>);
 #undef LP_ONLY_TEST
 #undef FLOW_ONLY_TEST
 #undef FLOW_ONLY_TEST_SG
+#undef PARALLEL_FLOW_ONLY_TEST
 
 // ----------------------------------------------------------
 // PriorityQueueWithRestrictedPush tests.
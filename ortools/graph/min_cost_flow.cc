@@ -18,6 +18,7 @@
 #include <cstdint>
 #include <cstdlib>
 #include <limits>
+#include <memory>
 #include <string>
 #include <vector>
 
@@ -74,7 +75,7 @@ template <typename Graph, typename ArcFlowType, typename ArcScaledCostType>
 void GenericMinCostFlow<Graph, ArcFlowType, ArcScaledCostType>::SetNodeSupply(
     NodeIndex node, FlowQuantity supply) {
   DCHECK(graph_->IsNodeValid(node));
-  node_excess_[node] = supply;
+  node_excess_[node] += supply - initial_node_excess_[node];
   initial_node_excess_[node] = supply;
   status_ = NOT_SOLVED;
   feasibility_checked_ = false;
@@ -342,7 +343,7 @@ bool GenericMinCostFlow<Graph, ArcFlowType, ArcScaledCostType>::MakeFeasible() {
   }
   for (NodeIndex node = 0; node < graph_->num_nodes(); ++node) {
     const FlowQuantity excess = feasible_node_excess_[node];
-    node_excess_[node] = excess;
+    node_excess_[node] += excess - initial_node_excess_[node];
     initial_node_excess_[node] = excess;
   }
   return true;
@@ -452,6 +453,20 @@ GenericMinCostFlow<Graph, ArcFlowType, ArcScaledCostType>::
 
 template <typename Graph, typename ArcFlowType, typename ArcScaledCostType>
 bool GenericMinCostFlow<Graph, ArcFlowType, ArcScaledCostType>::Solve() {
+  warm_start_ = false;
+  return SolveInternal();
+}
+
+template <typename Graph, typename ArcFlowType, typename ArcScaledCostType>
+bool GenericMinCostFlow<Graph, ArcFlowType,
+                        ArcScaledCostType>::SolveFromCurrentSolution() {
+  warm_start_ = true;
+  return SolveInternal();
+}
+
+template <typename Graph, typename ArcFlowType, typename ArcScaledCostType>
+bool GenericMinCostFlow<Graph, ArcFlowType,
+                        ArcScaledCostType>::SolveInternal() {
   if (absl::GetFlag(FLAGS_min_cost_flow_check_balance) &&
       !CheckInputConsistency()) {
     return false;
@@ -462,9 +477,33 @@ bool GenericMinCostFlow<Graph, ArcFlowType, ArcScaledCostType>::Solve() {
   }
 
   status_ = NOT_SOLVED;
-  node_potential_.assign(node_potential_.size(), 0);
+  const NodeIndex num_nodes = graph_->num_nodes();
+  if (warm_start_ && num_nodes > 0) {
+    // Shift the potentials so that the largest is zero, which keeps them away
+    // from the overflow threshold over many re-solves. Only the differences of
+    // potentials matter.
+    const CostValue max_potential = *std::max_element(
+        node_potential_.begin(), node_potential_.begin() + num_nodes);
+    for (NodeIndex node = 0; node < num_nodes; ++node) {
+      node_potential_[node] -= max_potential;
+    }
+  } else {
+    node_potential_.assign(node_potential_.size(), 0);
+  }
   ResetFirstAdmissibleArcs();
   if (!ScaleCosts()) return false;
+  if (warm_start_) {
+    // The kept potentials must be in range for the new costs. The usual
+    // epsilon schedule is kept: starting from the largest violation of the
+    // optimality conditions instead makes the first refinements very long as
+    // soon as one cost changed a lot.
+    for (NodeIndex node = 0; node < num_nodes; ++node) {
+      if (node_potential_[node] < overflow_threshold_) {
+        node_potential_.assign(node_potential_.size(), 0);
+        break;
+      }
+    }
+  }
   if (!Optimize()) return false;
   DCHECK_EQ(status_, NOT_SOLVED);
   status_ = OPTIMAL;
@@ -593,6 +632,25 @@ void GenericMinCostFlow<Graph, ArcFlowType,
   }
 }
 
+template <typename Graph, typename ArcFlowType, typename ArcScaledCostType>
+void GenericMinCostFlow<Graph, ArcFlowType,
+                        ArcScaledCostType>::SaturateNonEpsilonOptimalArcs() {
+  SCOPED_TIME_STAT(&stats_);
+  for (NodeIndex node = 0; node < graph_->num_nodes(); ++node) {
+    const CostValue tail_potential = node_potential_[node];
+    for (OutgoingOrOppositeIncomingArcIterator it(*graph_, node); it.Ok();
+         it.Next()) {
+      const ArcIndex arc = it.Index();
+      if (residual_arc_capacity_[arc] > 0 &&
+          FastReducedCost(arc, tail_potential) < -epsilon_) {
+        FastPushFlow(residual_arc_capacity_[arc], arc, node);
+      }
+    }
+    // Saturating an arc makes it non-admissible and the opposite arc has a
+    // positive reduced cost, so first_admissible_arc_[node] stays valid.
+  }
+}
+
 template <typename Graph, typename ArcFlowType, typename ArcScaledCostType>
 void GenericMinCostFlow<Graph, ArcFlowType, ArcScaledCostType>::PushFlow(
     FlowQuantity flow, ArcIndex arc) {
@@ -796,7 +854,11 @@ bool GenericMinCostFlow<Graph, ArcFlowType, ArcScaledCostType>::UpdatePrices() {
 template <typename Graph, typename ArcFlowType, typename ArcScaledCostType>
 bool GenericMinCostFlow<Graph, ArcFlowType, ArcScaledCostType>::Refine() {
   SCOPED_TIME_STAT(&stats_);
-  SaturateAdmissibleArcs();
+  if (warm_start_) {
+    SaturateNonEpsilonOptimalArcs();
+  } else {
+    SaturateAdmissibleArcs();
+  }
   InitializeActiveNodeStack();
 
   const NodeIndex num_nodes = graph_->num_nodes();
@@ -1047,9 +1109,19 @@ ArcIndex SimpleMinCostFlow::AddArcWithCapacityAndUnitCost(NodeIndex tail,
   arc_head_.push_back(head);
   arc_capacity_.push_back(capacity);
   arc_cost_.push_back(unit_cost);
+  min_cost_flow_.reset();
   return arc;
 }
 
+void SimpleMinCostFlow::SetArcCapacity(ArcIndex arc, FlowQuantity capacity) {
+  DCHECK_GE(capacity, 0);
+  arc_capacity_[arc] = capacity;
+}
+
+void SimpleMinCostFlow::SetArcUnitCost(ArcIndex arc, CostValue unit_cost) {
+  arc_cost_[arc] = unit_cost;
+}
+
 ArcIndex SimpleMinCostFlow::PermutedArc(ArcIndex arc) {
   return arc < arc_permutation_.size() ? arc_permutation_[arc] : arc;
 }
@@ -1095,82 +1167,173 @@ SimpleMinCostFlow::Status SimpleMinCostFlow::SolveWithPossibleAdjustment(
   const NodeIndex sink = num_nodes + 1;
   const NodeIndex augmented_num_nodes = num_nodes + 2;
 
-  Graph graph(augmented_num_nodes, augmented_num_arcs);
+  min_cost_flow_.reset();
+  graph_ = std::make_unique<Graph>(augmented_num_nodes, augmented_num_arcs);
   for (ArcIndex arc = 0; arc < num_arcs; ++arc) {
-    graph.AddArc(arc_tail_[arc], arc_head_[arc]);
+    graph_->AddArc(arc_tail_[arc], arc_head_[arc]);
   }
 
   for (NodeIndex node = 0; node < num_nodes; ++node) {
     if (node_supply_[node] > 0) {
-      graph.AddArc(source, node);
+      graph_->AddArc(source, node);
     } else if (node_supply_[node] < 0) {
-      graph.AddArc(node, sink);
+      graph_->AddArc(node, sink);
     }
   }
 
-  graph.Build(&arc_permutation_);
-
-  {
-    GenericMaxFlow<Graph> max_flow(&graph, source, sink);
-    ArcIndex arc;
-    for (arc = 0; arc < num_arcs; ++arc) {
-      max_flow.SetArcCapacity(PermutedArc(arc), arc_capacity_[arc]);
-    }
-    for (NodeIndex node = 0; node < num_nodes; ++node) {
-      if (node_supply_[node] != 0) {
-        max_flow.SetArcCapacity(PermutedArc(arc), std::abs(node_supply_[node]));
-        ++arc;
-      }
-    }
-    CHECK_EQ(arc, augmented_num_arcs);
-    if (!max_flow.Solve()) {
-      LOG(ERROR) << "Max flow could not be computed.";
-      switch (max_flow.status()) {
-        case MaxFlowStatusClass::NOT_SOLVED:
-          return NOT_SOLVED;
-        case MaxFlowStatusClass::OPTIMAL:
-          LOG(ERROR)
-              << "Max flow failed but claimed to have an optimal solution";
-          ABSL_FALLTHROUGH_INTENDED;
-        default:
-          return BAD_RESULT;
-      }
+  graph_->Build(&arc_permutation_);
+  node_supply_arc_.assign(num_nodes, Graph::kNilArc);
+  ArcIndex arc = num_arcs;
+  for (NodeIndex node = 0; node < num_nodes; ++node) {
+    if (node_supply_[node] != 0) {
+      node_supply_arc_[node] = PermutedArc(arc);
+      ++arc;
     }
-    maximum_flow_ = max_flow.GetOptimalFlow();
   }
+  CHECK_EQ(arc, augmented_num_arcs);
 
+  const Status max_flow_status = ComputeMaximumFlow();
+  if (max_flow_status != OPTIMAL) return max_flow_status;
   if (adjustment == DONT_ADJUST && maximum_flow_ != total_supply) {
     return INFEASIBLE;
   }
 
-  GenericMinCostFlow<Graph> min_cost_flow(&graph);
-  ArcIndex arc;
+  min_cost_flow_ = std::make_unique<GenericMinCostFlow<Graph>>(graph_.get());
   for (arc = 0; arc < num_arcs; ++arc) {
     ArcIndex permuted_arc = PermutedArc(arc);
-    min_cost_flow.SetArcUnitCost(permuted_arc, arc_cost_[arc]);
-    min_cost_flow.SetArcCapacity(permuted_arc, arc_capacity_[arc]);
+    min_cost_flow_->SetArcUnitCost(permuted_arc, arc_cost_[arc]);
+    min_cost_flow_->SetArcCapacity(permuted_arc, arc_capacity_[arc]);
   }
   for (NodeIndex node = 0; node < num_nodes; ++node) {
-    if (node_supply_[node] != 0) {
-      ArcIndex permuted_arc = PermutedArc(arc);
-      min_cost_flow.SetArcCapacity(permuted_arc, std::abs(node_supply_[node]));
-      min_cost_flow.SetArcUnitCost(permuted_arc, 0);
-      ++arc;
+    if (node_supply_arc_[node] != Graph::kNilArc) {
+      min_cost_flow_->SetArcCapacity(node_supply_arc_[node],
+                                     std::abs(node_supply_[node]));
+      min_cost_flow_->SetArcUnitCost(node_supply_arc_[node], 0);
     }
   }
-  min_cost_flow.SetNodeSupply(source, maximum_flow_);
-  min_cost_flow.SetNodeSupply(sink, -maximum_flow_);
-  min_cost_flow.SetCheckFeasibility(false);
-  min_cost_flow.SetPriceScaling(scale_prices_);
+  min_cost_flow_->SetNodeSupply(source, maximum_flow_);
+  min_cost_flow_->SetNodeSupply(sink, -maximum_flow_);
+  min_cost_flow_->SetCheckFeasibility(false);
+  min_cost_flow_->SetPriceScaling(scale_prices_);
+  return SolveMinCostFlow(/*warm_start=*/false);
+}
+
+SimpleMinCostFlow::Status SimpleMinCostFlow::SolveFromLastSolution() {
+  if (min_cost_flow_ == nullptr) return Solve();
+  optimal_cost_ = 0;
+  maximum_flow_ = 0;
+  arc_flow_.clear();
+  const NodeIndex num_nodes = node_supply_.size();
+  const ArcIndex num_arcs = arc_capacity_.size();
+  const NodeIndex source = num_nodes;
+  const NodeIndex sink = num_nodes + 1;
 
+  // The structure of graph_ must still match the problem, and any change of
+  // supply or capacity decrease may make it infeasible.
+  FlowQuantity total_supply = 0, total_demand = 0;
+  bool may_be_infeasible = false;
+  for (NodeIndex node = 0; node < num_nodes; ++node) {
+    const FlowQuantity supply = node_supply_[node];
+    if (supply > 0) {
+      total_supply += supply;
+    } else {
+      total_demand -= supply;
+    }
+    const ArcIndex arc = node_supply_arc_[node];
+    if (arc == Graph::kNilArc) {
+      if (supply != 0) return Solve();
+      continue;
+    }
+    if ((supply > 0 && graph_->Tail(arc) != source) ||
+        (supply < 0 && graph_->Head(arc) != sink)) {
+      return Solve();
+    }
+    if (std::abs(supply) != min_cost_flow_->Capacity(arc)) {
+      may_be_infeasible = true;
+    }
+  }
+  if (total_supply != total_demand) return UNBALANCED;
+  // This also covers a last solve by SolveMaxFlowWithMinCost().
+  if (min_cost_flow_->InitialSupply(source) != total_supply) {
+    may_be_infeasible = true;
+  }
+  for (ArcIndex arc = 0; arc < num_arcs && !may_be_infeasible; ++arc) {
+    if (arc_capacity_[arc] < min_cost_flow_->Capacity(PermutedArc(arc))) {
+      may_be_infeasible = true;
+    }
+  }
+  if (may_be_infeasible) {
+    const Status max_flow_status = ComputeMaximumFlow();
+    if (max_flow_status != OPTIMAL) return max_flow_status;
+    if (maximum_flow_ != total_supply) return INFEASIBLE;
+  }
+  maximum_flow_ = total_supply;
+
+  // The setters below keep the current flow wherever it still fits.
+  for (ArcIndex arc = 0; arc < num_arcs; ++arc) {
+    const ArcIndex permuted_arc = PermutedArc(arc);
+    min_cost_flow_->SetArcUnitCost(permuted_arc, arc_cost_[arc]);
+    min_cost_flow_->SetArcCapacity(permuted_arc, arc_capacity_[arc]);
+  }
+  for (NodeIndex node = 0; node < num_nodes; ++node) {
+    if (node_supply_arc_[node] != Graph::kNilArc) {
+      min_cost_flow_->SetArcCapacity(node_supply_arc_[node],
+                                     std::abs(node_supply_[node]));
+    }
+  }
+  min_cost_flow_->SetNodeSupply(source, maximum_flow_);
+  min_cost_flow_->SetNodeSupply(sink, -maximum_flow_);
+  min_cost_flow_->SetPriceScaling(scale_prices_);
+  const Status status = SolveMinCostFlow(/*warm_start=*/true);
+  // The warm start can fail on a cost overflow that may not happen when
+  // solving from scratch, which also gives the proper status otherwise.
+  if (status != OPTIMAL) return Solve();
+  return status;
+}
+
+SimpleMinCostFlow::Status SimpleMinCostFlow::ComputeMaximumFlow() {
+  const NodeIndex num_nodes = node_supply_.size();
+  GenericMaxFlow<Graph> max_flow(graph_.get(), /*source=*/num_nodes,
+                                 /*sink=*/num_nodes + 1);
+  for (ArcIndex arc = 0; arc < arc_capacity_.size(); ++arc) {
+    max_flow.SetArcCapacity(PermutedArc(arc), arc_capacity_[arc]);
+  }
+  for (NodeIndex node = 0; node < num_nodes; ++node) {
+    if (node_supply_arc_[node] != Graph::kNilArc) {
+      max_flow.SetArcCapacity(node_supply_arc_[node],
+                              std::abs(node_supply_[node]));
+    }
+  }
+  if (!max_flow.Solve()) {
+    LOG(ERROR) << "Max flow could not be computed.";
+    switch (max_flow.status()) {
+      case MaxFlowStatusClass::NOT_SOLVED:
+        return NOT_SOLVED;
+      case MaxFlowStatusClass::OPTIMAL:
+        LOG(ERROR) << "Max flow failed but claimed to have an optimal solution";
+        ABSL_FALLTHROUGH_INTENDED;
+      default:
+        return BAD_RESULT;
+    }
+  }
+  maximum_flow_ = max_flow.GetOptimalFlow();
+  return OPTIMAL;
+}
+
+SimpleMinCostFlow::Status SimpleMinCostFlow::SolveMinCostFlow(bool warm_start) {
+  const ArcIndex num_arcs = arc_capacity_.size();
   arc_flow_.resize(num_arcs);
-  if (min_cost_flow.Solve()) {
-    optimal_cost_ = min_cost_flow.GetOptimalCost();
-    for (arc = 0; arc < num_arcs; ++arc) {
-      arc_flow_[arc] = min_cost_flow.Flow(PermutedArc(arc));
+  const bool solved = warm_start ? min_cost_flow_->SolveFromCurrentSolution()
+                                 : min_cost_flow_->Solve();
+  if (solved) {
+    optimal_cost_ = min_cost_flow_->GetOptimalCost();
+    for (ArcIndex arc = 0; arc < num_arcs; ++arc) {
+      arc_flow_[arc] = min_cost_flow_->Flow(PermutedArc(arc));
     }
   }
-  return min_cost_flow.status();
+  const Status status = min_cost_flow_->status();
+  if (status != OPTIMAL) min_cost_flow_.reset();
+  return status;
 }
 
 CostValue SimpleMinCostFlow::OptimalCost() const { return optimal_cost_; }
@@ -1204,6 +1367,7 @@ FlowQuantity SimpleMinCostFlow::Supply(NodeIndex node) const {
 void SimpleMinCostFlow::ResizeNodeVectors(NodeIndex node) {
   if (node < node_supply_.size()) return;
   node_supply_.resize(node + 1);
+  min_cost_flow_.reset();
 }
 
 }  // namespace operations_research
@@ -170,6 +170,7 @@
 
 #include <algorithm>
 #include <cstdint>
+#include <memory>
 #include <stack>
 #include <string>
 #include <vector>
@@ -237,9 +238,10 @@ class MinCostFlowBase {
 // more memory in order to hide the somewhat involved construction of the
 // static graph.
 //
-// TODO(user): If the need arises, extend this interface to support warm start
-// and incrementality between solves. Note that this is already supported by the
-// GenericMinCostFlow<> interface.
+// After a Solve(), the problem can be modified with SetArcCapacity(),
+// SetArcUnitCost() and SetNodeSupply() and re-solved from the last solution
+// with SolveFromLastSolution(), which reuses the graph, the solver and the last
+// solution instead of rebuilding everything.
 class SimpleMinCostFlow : public MinCostFlowBase {
  public:
   // By default, the constructor takes no size. New node indices are created
@@ -267,6 +269,11 @@ class SimpleMinCostFlow : public MinCostFlowBase {
                                          FlowQuantity capacity,
                                          CostValue unit_cost);
 
+  // Modifies the capacity or the unit cost of an existing arc. The capacity
+  // must be non-negative.
+  void SetArcCapacity(ArcIndex arc, FlowQuantity capacity);
+  void SetArcUnitCost(ArcIndex arc, CostValue unit_cost);
+
   // Sets the supply of the given node. The node index must be non-negative (>=
   // 0). Nodes implicitly created will have a default supply set to 0. A demand
   // is modeled as a negative supply.
@@ -289,6 +296,17 @@ class SimpleMinCostFlow : public MinCostFlowBase {
     return SolveWithPossibleAdjustment(SupplyAdjustment::ADJUST);
   }
 
+  // Same as Solve(), but reuses the internal graph and solver of the last
+  // successful solve, and starts from its flow and node potentials. The
+  // feasibility check with a max-flow is only done if an arc capacity
+  // decreased or a supply changed.
+  //
+  // This falls back to Solve() if there is no previous solution, or if the
+  // structure of the problem changed: new nodes or arcs, or a node whose
+  // supply was zero (resp. positive, negative) that now has a non-zero (resp.
+  // non-positive, non-negative) supply.
+  Status SolveFromLastSolution();
+
   // Returns the cost of the minimum-cost flow found by the algorithm when
   // the returned Status is OPTIMAL.
   CostValue OptimalCost() const;
@@ -343,6 +361,14 @@ class SimpleMinCostFlow : public MinCostFlowBase {
   // Solves the problem, potentially applying supply and demand adjustment,
   // and returns the problem status.
   Status SolveWithPossibleAdjustment(SupplyAdjustment adjustment);
+  // Computes in maximum_flow_ the maximum flow that can be sent from the
+  // supply nodes to the demand nodes of graph_, see
+  // SolveWithPossibleAdjustment().
+  Status ComputeMaximumFlow();
+  // Solves min_cost_flow_, and fills optimal_cost_ and arc_flow_ on success.
+  // min_cost_flow_ is discarded on failure, since its state cannot be used to
+  // warm-start the next solve.
+  Status SolveMinCostFlow(bool warm_start);
   void ResizeNodeVectors(NodeIndex node);
 
   std::vector<NodeIndex> arc_tail_;
@@ -355,6 +381,17 @@ class SimpleMinCostFlow : public MinCostFlowBase {
   CostValue optimal_cost_;
   FlowQuantity maximum_flow_;
 
+  // The graph augmented with a source and a sink, and the min-cost flow
+  // solver of the last successful solve, kept for SolveFromLastSolution().
+  // They are discarded by any change to the structure of the problem.
+  std::unique_ptr<Graph> graph_;
+  std::unique_ptr<GenericMinCostFlow<Graph, FlowQuantity, CostValue>>
+      min_cost_flow_;
+  // For each node with a non-zero supply when graph_ was built, the arc of
+  // graph_ from the source to it (or from it to the sink for a demand), and
+  // Graph::kNilArc for the other nodes.
+  std::vector<ArcIndex> node_supply_arc_;
+
   bool scale_prices_ = true;
 };
 
@@ -407,7 +444,8 @@ class GenericMinCostFlow : public MinCostFlowBase {
   Status status() const { return status_; }
 
   // Sets the supply corresponding to node. A demand is modeled as a negative
-  // supply.
+  // supply. The current flow is kept, so the node excess changes by the
+  // difference with the previous supply.
   void SetNodeSupply(NodeIndex node, FlowQuantity supply);
 
   // Sets the unit cost for the given arc.
@@ -423,6 +461,15 @@ class GenericMinCostFlow : public MinCostFlowBase {
   // Solves the problem, returning true if a min-cost flow could be found.
   bool Solve();
 
+  // Same as Solve(), but starts from the current flow and node potentials
+  // instead of resetting the potentials, e.g. to re-solve the problem after
+  // a few calls to SetArcCapacity(), SetArcUnitCost() or SetNodeSupply(). These
+  // keep the flow on the arcs (up to their new capacity), so the flow of the
+  // last solve stays nearly optimal: at each scaling step, only the arcs
+  // violating the optimality conditions are saturated instead of all the
+  // admissible arcs.
+  bool SolveFromCurrentSolution();
+
   // Checks for feasibility, i.e., that all the supplies and demands can be
   // matched without exceeding bottlenecks in the network.
   // If infeasible_supply_node (resp. infeasible_demand_node) are not NULL,
@@ -538,6 +585,14 @@ class GenericMinCostFlow : public MinCostFlowBase {
   // Saturates the admissible arcs, i.e., push as much flow as possible.
   void SaturateAdmissibleArcs();
 
+  // Saturates only the arcs with a reduced cost smaller than -epsilon_, which
+  // makes the pseudo-flow epsilon-optimal. Used instead of
+  // SaturateAdmissibleArcs() when warm-starting.
+  void SaturateNonEpsilonOptimalArcs();
+
+  // Common part of Solve() and SolveFromCurrentSolution().
+  bool SolveInternal();
+
   // Pushes flow on a given arc,  i.e., consumes flow on
   // residual_arc_capacity_[arc], and consumes -flow on
   // residual_arc_capacity_[Opposite(arc)]. Updates node_excess_ at the tail
@@ -669,6 +724,10 @@ class GenericMinCostFlow : public MinCostFlowBase {
 
   // Whether to scale prices, see SimpleMinCostFlow::SetPriceScaling().
   bool scale_prices_ = true;
+
+  // Whether the current solve started from the previous solution, see
+  // SolveFromCurrentSolution().
+  bool warm_start_ = false;
 };
 
 #if !SWIG
@@ -265,6 +265,28 @@ TYPED_TEST(GenericMinCostFlowTest, Small4x4Matrix) {
   EXPECT_EQ(GenericMinCostFlow<TypeParam>::OPTIMAL, min_cost_flow.status());
   CostValue total_flow_cost = min_cost_flow.GetOptimalCost();
   EXPECT_EQ(kExpectedCost, total_flow_cost);
+
+  // Remove the first source and the first target, and make the arc between
+  // the second ones free: re-solving from the current solution must give the
+  // same cost as a solve from scratch.
+  min_cost_flow.SetNodeSupply(0, 0);
+  min_cost_flow.SetNodeSupply(kNumSources, 0);
+  min_cost_flow.SetArcUnitCost(kNumTargets + 1, 0);
+  GenericMinCostFlow<TypeParam> new_min_cost_flow(&graph);
+  for (arc = 0; arc < graph.num_arcs(); ++arc) {
+    new_min_cost_flow.SetArcUnitCost(arc, min_cost_flow.UnitCost(arc));
+    new_min_cost_flow.SetArcCapacity(arc, 1);
+  }
+  for (NodeIndex node = 0; node < graph.num_nodes(); ++node) {
+    new_min_cost_flow.SetNodeSupply(node, min_cost_flow.InitialSupply(node));
+  }
+  EXPECT_TRUE(new_min_cost_flow.Solve());
+  EXPECT_TRUE(min_cost_flow.SolveFromCurrentSolution());
+  EXPECT_EQ(GenericMinCostFlow<TypeParam>::OPTIMAL, min_cost_flow.status());
+  EXPECT_EQ(min_cost_flow.GetOptimalCost(), new_min_cost_flow.GetOptimalCost());
+  for (NodeIndex target = 0; target < kNumTargets; ++target) {
+    EXPECT_EQ(min_cost_flow.Flow(target), 0);
+  }
 }
 
 // Test that very large flow quantities do not overflow and that the total flow
@@ -479,6 +501,114 @@ TEST(SimpleMinCostFlowTest, OverflowCostBound) {
   EXPECT_EQ(safe_divisor, 11009);
 }
 
+TEST(SimpleMinCostFlowTest, SolveFromLastSolutionMatchesSolve) {
+  const int kNumNodes = 300;
+  const int kNumArcs = 3000;
+  std::mt19937 random(12345);
+  std::vector<NodeIndex> tails;
+  std::vector<NodeIndex> heads;
+  std::vector<FlowQuantity> capacities;
+  std::vector<CostValue> costs;
+  // A ring of expensive arcs with a large capacity keeps the problem feasible.
+  for (NodeIndex node = 0; node < kNumNodes; ++node) {
+    tails.push_back(node);
+    heads.push_back((node + 1) % kNumNodes);
+    capacities.push_back(100'000);
+    costs.push_back(10'000);
+  }
+  while (tails.size() < kNumArcs) {
+    tails.push_back(absl::Uniform(random, 0, kNumNodes));
+    heads.push_back(absl::Uniform(random, 0, kNumNodes));
+    capacities.push_back(absl::Uniform(random, 0, 100));
+    costs.push_back(absl::Uniform(random, 0, 1000));
+  }
+  std::vector<FlowQuantity> supplies(kNumNodes, 0);
+  for (int i = 0; i < 500; ++i) {
+    const FlowQuantity quantity = absl::Uniform(random, 1, 10);
+    supplies[absl::Uniform(random, 0, kNumNodes / 3)] += quantity;
+    supplies[absl::Uniform(random, 2 * kNumNodes / 3, kNumNodes)] -= quantity;
+  }
+
+  SimpleMinCostFlow warm_min_cost_flow;
+  for (ArcIndex arc = 0; arc < kNumArcs; ++arc) {
+    warm_min_cost_flow.AddArcWithCapacityAndUnitCost(
+        tails[arc], heads[arc], capacities[arc], costs[arc]);
+  }
+  for (NodeIndex node = 0; node < kNumNodes; ++node) {
+    warm_min_cost_flow.SetNodeSupply(node, supplies[node]);
+  }
+  ASSERT_EQ(warm_min_cost_flow.Solve(), SimpleMinCostFlow::OPTIMAL);
+
+  for (int iteration = 0; iteration < 20; ++iteration) {
+    for (int i = 0; i < 20; ++i) {
+      const ArcIndex arc = absl::Uniform(random, kNumNodes, kNumArcs);
+      capacities[arc] = absl::Uniform(random, 0, 100);
+      costs[arc] = absl::Uniform(random, 0, 1000);
+      warm_min_cost_flow.SetArcCapacity(arc, capacities[arc]);
+      warm_min_cost_flow.SetArcUnitCost(arc, costs[arc]);
+    }
+    // Move some supply, which needs a feasibility check. On the last such
+    // iteration, a node without supply gets some, which changes the structure
+    // of the problem.
+    const NodeIndex demand_node = kNumNodes - 1 - iteration;
+    if (iteration % 3 == 0 && supplies[demand_node] < 0) {
+      const NodeIndex supply_node =
+          iteration == 18 ? kNumNodes / 2 : absl::Uniform(random, 0, 10);
+      supplies[supply_node] += 1;
+      supplies[demand_node] -= 1;
+      warm_min_cost_flow.SetNodeSupply(supply_node, supplies[supply_node]);
+      warm_min_cost_flow.SetNodeSupply(demand_node, supplies[demand_node]);
+    }
+
+    SimpleMinCostFlow min_cost_flow;
+    for (ArcIndex arc = 0; arc < kNumArcs; ++arc) {
+      min_cost_flow.AddArcWithCapacityAndUnitCost(tails[arc], heads[arc],
+                                                  capacities[arc], costs[arc]);
+    }
+    for (NodeIndex node = 0; node < kNumNodes; ++node) {
+      min_cost_flow.SetNodeSupply(node, supplies[node]);
+    }
+    ASSERT_EQ(min_cost_flow.Solve(), SimpleMinCostFlow::OPTIMAL);
+    ASSERT_EQ(warm_min_cost_flow.SolveFromLastSolution(),
+              SimpleMinCostFlow::OPTIMAL);
+    EXPECT_EQ(warm_min_cost_flow.OptimalCost(), min_cost_flow.OptimalCost())
+        << "iteration " << iteration;
+    EXPECT_EQ(warm_min_cost_flow.MaximumFlow(), min_cost_flow.MaximumFlow());
+    std::vector<FlowQuantity> excess = supplies;
+    for (ArcIndex arc = 0; arc < kNumArcs; ++arc) {
+      const FlowQuantity flow = warm_min_cost_flow.Flow(arc);
+      ASSERT_GE(flow, 0);
+      ASSERT_LE(flow, capacities[arc]);
+      excess[tails[arc]] -= flow;
+      excess[heads[arc]] += flow;
+    }
+    for (NodeIndex node = 0; node < kNumNodes; ++node) {
+      ASSERT_EQ(excess[node], 0) << "node " << node;
+    }
+  }
+}
+
+TEST(SimpleMinCostFlowTest, SolveFromLastSolutionDetectsInfeasibility) {
+  SimpleMinCostFlow min_cost_flow;
+  const ArcIndex arc = min_cost_flow.AddArcWithCapacityAndUnitCost(0, 1, 10, 3);
+  min_cost_flow.SetNodeSupply(0, 5);
+  min_cost_flow.SetNodeSupply(1, -5);
+  EXPECT_EQ(min_cost_flow.SolveFromLastSolution(), SimpleMinCostFlow::OPTIMAL);
+  EXPECT_EQ(min_cost_flow.OptimalCost(), 15);
+
+  min_cost_flow.SetArcCapacity(arc, 4);
+  EXPECT_EQ(min_cost_flow.SolveFromLastSolution(),
+            SimpleMinCostFlow::INFEASIBLE);
+  min_cost_flow.SetArcCapacity(arc, 5);
+  min_cost_flow.SetArcUnitCost(arc, 2);
+  EXPECT_EQ(min_cost_flow.SolveFromLastSolution(), SimpleMinCostFlow::OPTIMAL);
+  EXPECT_EQ(min_cost_flow.OptimalCost(), 10);
+  EXPECT_EQ(min_cost_flow.Flow(arc), 5);
+  min_cost_flow.SetNodeSupply(0, 4);
+  EXPECT_EQ(min_cost_flow.SolveFromLastSolution(),
+            SimpleMinCostFlow::UNBALANCED);
+}
+
 template <typename Graph>
 void GenerateCompleteGraph(const NodeIndex num_sources,
                            const NodeIndex num_targets, Graph* graph) {
@@ -569,8 +699,8 @@ void SetUpNetworkData(absl::Span<const ArcIndex> permutation,
 }
 
 template <typename Graph>
-CostValue SolveMinCostFlow(GenericMinCostFlow<Graph>* min_cost_flow) {
-  bool ok = min_cost_flow->Solve();
+CostValue CheckedOptimalCost(bool ok,
+                             GenericMinCostFlow<Graph>* min_cost_flow) {
   if (ok && min_cost_flow->status() == GenericMinCostFlow<Graph>::OPTIMAL) {
     CostValue cost = min_cost_flow->GetOptimalCost();
     CostValue computed_cost = 0;
@@ -586,6 +716,18 @@ CostValue SolveMinCostFlow(GenericMinCostFlow<Graph>* min_cost_flow) {
   }
 }
 
+template <typename Graph>
+CostValue SolveMinCostFlow(GenericMinCostFlow<Graph>* min_cost_flow) {
+  return CheckedOptimalCost(min_cost_flow->Solve(), min_cost_flow);
+}
+
+template <typename Graph>
+CostValue SolveMinCostFlowFromCurrentSolution(
+    GenericMinCostFlow<Graph>* min_cost_flow) {
+  return CheckedOptimalCost(min_cost_flow->SolveFromCurrentSolution(),
+                            min_cost_flow);
+}
+
 template <typename Graph>
 CostValue SolveMinCostFlowWithLP(GenericMinCostFlow<Graph>* min_cost_flow) {
   MPSolver solver("LPSolver", MPSolver::CLP_LINEAR_PROGRAMMING);
@@ -779,7 +921,8 @@ void FullRandomFlow(typename MinCostFlowSolver<Graph>::Solver f,
 #define LP_AND_FLOW_TEST(test_name, size, expected_cost1, expected_cost2) \
   LP_ONLY_TEST(test_name, size, expected_cost1, expected_cost2)           \
   FLOW_ONLY_TEST(test_name, size, expected_cost1, expected_cost2)         \
-  FLOW_ONLY_TEST_SG(test_name, size, expected_cost1, expected_cost2)
+  FLOW_ONLY_TEST_SG(test_name, size, expected_cost1, expected_cost2)      \
+  WARM_START_FLOW_ONLY_TEST(test_name, size, expected_cost1, expected_cost2)
 
 #define LP_ONLY_TEST(test_name, size, expected_cost1, expected_cost2)        \
   TEST(LPMinCostFlowTest, test_name##size) {                                 \
@@ -799,6 +942,14 @@ void FullRandomFlow(typename MinCostFlowSolver<Graph>::Solver f,
                                              expected_cost1, expected_cost2); \
   }
 
+#define WARM_START_FLOW_ONLY_TEST(test_name, size, expected_cost1,          \
+                                  expected_cost2)                            \
+  TEST(WarmStartMinCostFlowTest, test_name##size) {                          \
+    test_name<util::ReverseArcStaticGraph<>>(                                \
+        SolveMinCostFlowFromCurrentSolution, size, size, expected_cost1,     \
+        expected_cost2);                                                     \
+  }
+
 // The times indicated below are in opt mode.
 // The figures indicate the time with the LP solver and with MinCostFlow,
 // respectively. _ indicates "N/A".
@@ -843,6 +994,7 @@ FLOW_ONLY_TEST_SG(FullRandomFlow, 3000, 5588622, 7140712);  // 230s
 #undef LP_ONLY_TEST
 #undef FLOW_ONLY_TEST
 #undef FLOW_ONLY_TEST_SG
+#undef WARM_START_FLOW_ONLY_TEST
 
 // Benchmark inspired from the existing problem of matching Youtube ads channels
 // to Youtube users, maximizing the expected revenue:
@@ -14,14 +14,19 @@
 #ifndef OR_TOOLS_GRAPH_MINIMUM_SPANNING_TREE_H_
 #define OR_TOOLS_GRAPH_MINIMUM_SPANNING_TREE_H_
 
+#include <algorithm>
+#include <cstdint>
+#include <limits>
 #include <queue>
 #include <vector>
 
 #include "absl/types/span.h"
 #include "ortools/base/adjustable_priority_queue-inl.h"
 #include "ortools/base/adjustable_priority_queue.h"
+#include "ortools/base/threadpool.h"
 #include "ortools/base/types.h"
 #include "ortools/graph/connected_components.h"
+#include "ortools/graph/graph.h"
 #include "ortools/util/vector_or_function.h"
 
 namespace operations_research {
@@ -178,5 +183,99 @@ std::vector<typename Graph::ArcIndex> BuildPrimMinimumSpanningTree(
   return tree_arcs;
 }
 
+// Version of Prim's algorithm for complete graphs, which does not use a
+// priority queue: the cheapest arc from the tree to each node not in the tree
+// is kept in a flat array, which is scanned to select the next node and then
+// updated with the arcs leaving it. This is O(V^2), i.e. linear in the number
+// of arcs, instead of O(V^2 * log(V)), and uses O(V) memory.
+// If 'thread_pool' is not nullptr, the scans of large arrays are split between
+// its workers, so arc_value must support concurrent calls. The returned tree
+// does not depend on the number of threads.
+// Usage:
+//  CompleteGraph<int, int> graph(num_nodes);
+//  const auto arc_cost = [&graph](int arc) -> int64_t {
+//                           return f(graph.Tail(arc), graph.Head(arc));
+//                        };
+//  std::vector<int> mst =
+//      BuildPrimMinimumSpanningTreeOnCompleteGraph(graph, arc_cost);
+//
+template <typename NodeIndex, typename ArcIndex, typename ArcValue>
+std::vector<ArcIndex> BuildPrimMinimumSpanningTreeOnCompleteGraph(
+    const util::CompleteGraph<NodeIndex, ArcIndex>& graph,
+    const ArcValue& arc_value, ThreadPool* thread_pool = nullptr) {
+  using ArcValueType = decltype(arc_value(0));
+  const NodeIndex num_nodes = graph.num_nodes();
+  std::vector<ArcIndex> tree_arcs;
+  if (num_nodes == 0) {
+    return tree_arcs;
+  }
+  tree_arcs.reserve(num_nodes - 1);
+  const auto arc_from = [num_nodes](NodeIndex tail, NodeIndex head) {
+    return static_cast<ArcIndex>(tail) * num_nodes + head;
+  };
+
+  // The first num_remaining elements of these vectors describe the nodes which
+  // are not in the tree yet, and the cheapest arc from the tree to each of
+  // them. Node 0 is the first node of the tree.
+  int num_remaining = num_nodes - 1;
+  std::vector<NodeIndex> remaining_nodes(num_remaining);
+  std::vector<ArcIndex> best_arcs(num_remaining);
+  std::vector<ArcValueType> best_values(num_remaining);
+  for (int i = 0; i < num_remaining; ++i) {
+    remaining_nodes[i] = i + 1;
+    best_arcs[i] = arc_from(0, i + 1);
+    best_values[i] = arc_value(best_arcs[i]);
+  }
+
+  // Returns the position of the cheapest of the remaining nodes in [begin,
+  // end), after updating their cheapest arc with the arcs from 'new_node' if it
+  // is not -1. Ties are broken by position.
+  const auto update_and_select = [&](NodeIndex new_node, int begin, int end) {
+    int best = begin;
+    for (int i = begin; i < end; ++i) {
+      if (new_node != -1) {
+        const ArcIndex arc = arc_from(new_node, remaining_nodes[i]);
+        const ArcValueType value = arc_value(arc);
+        if (value < best_values[i]) {
+          best_values[i] = value;
+          best_arcs[i] = arc;
+        }
+      }
+      if (best_values[i] < best_values[best]) best = i;
+    }
+    return best;
+  };
+
+  // Below this number of remaining nodes, the scans are sequential.
+  constexpr int kNodesPerChunk = 4096;
+  std::vector<int> chunk_best;
+  NodeIndex new_node = -1;
+  while (num_remaining > 0) {
+    int best = 0;
+    if (thread_pool == nullptr || num_remaining <= kNodesPerChunk) {
+      best = update_and_select(new_node, 0, num_remaining);
+    } else {
+      chunk_best.assign((num_remaining + kNodesPerChunk - 1) / kNodesPerChunk,
+                        0);
+      ParallelFor(thread_pool, 0, num_remaining, kNodesPerChunk,
+                  [&](int64_t begin, int64_t end) {
+                    chunk_best[begin / kNodesPerChunk] =
+                        update_and_select(new_node, begin, end);
+                  });
+      best = chunk_best[0];
+      for (const int chunk : chunk_best) {
+        if (best_values[chunk] < best_values[best]) best = chunk;
+      }
+    }
+    new_node = remaining_nodes[best];
+    tree_arcs.push_back(best_arcs[best]);
+    --num_remaining;
+    remaining_nodes[best] = remaining_nodes[num_remaining];
+    best_arcs[best] = best_arcs[num_remaining];
+    best_values[best] = best_values[num_remaining];
+  }
+  return tree_arcs;
+}
+
 }  // namespace operations_research
 #endif  // OR_TOOLS_GRAPH_MINIMUM_SPANNING_TREE_H_
@@ -25,6 +25,7 @@
 #include "benchmark/benchmark.h"
 #include "gtest/gtest.h"
 #include "ortools/base/gmock.h"
+#include "ortools/base/threadpool.h"
 #include "ortools/base/types.h"
 #include "ortools/graph/graph.h"
 
@@ -187,6 +188,51 @@ TEST(MSTTest, SmallDisconnectedGraph) {
   CheckMSTWithKruskal(graph, costs, {0, 2, 4});
 }
 
+// Returns a pseudo-random symmetric cost in [0, 1000000) for the edge between
+// nodes 'a' and 'b'.
+int64_t HashedEdgeCost(int a, int b) {
+  const uint64_t x =
+      static_cast<uint64_t>(std::min(a, b)) << 32 | std::max(a, b);
+  return (x * 0x9E3779B97F4A7C15ull >> 32) % 1000000;
+}
+
+int64_t TreeCost(const CompleteGraph<int, int>& graph,
+                 absl::Span<const int> tree) {
+  int64_t cost = 0;
+  for (const int arc : tree) {
+    cost += HashedEdgeCost(graph.Tail(arc), graph.Head(arc));
+  }
+  return cost;
+}
+
+TEST(MSTTest, PrimOnCompleteGraph) {
+  for (const int num_nodes : {0, 1, 2, 3, 10, 300}) {
+    SCOPED_TRACE(num_nodes);
+    CompleteGraph<int, int> graph(num_nodes);
+    const auto arc_cost = [&graph](int arc) {
+      return HashedEdgeCost(graph.Tail(arc), graph.Head(arc));
+    };
+    const std::vector<int> mst =
+        BuildPrimMinimumSpanningTreeOnCompleteGraph(graph, arc_cost);
+    EXPECT_EQ(std::max(0, num_nodes - 1), mst.size());
+    EXPECT_EQ(TreeCost(graph, BuildPrimMinimumSpanningTree(graph, arc_cost)),
+              TreeCost(graph, mst));
+  }
+}
+
+TEST(MSTTest, ParallelPrimOnCompleteGraph) {
+  const int kNumNodes = 5000;
+  CompleteGraph<int, int> graph(kNumNodes);
+  const auto arc_cost = [&graph](int arc) {
+    return HashedEdgeCost(graph.Tail(arc), graph.Head(arc));
+  };
+  ThreadPool pool(4);
+  pool.StartWorkers();
+  EXPECT_EQ(
+      BuildPrimMinimumSpanningTreeOnCompleteGraph(graph, arc_cost),
+      BuildPrimMinimumSpanningTreeOnCompleteGraph(graph, arc_cost, &pool));
+}
+
 // Benchmark on a grid graph with random arc costs; 'size' corresponds to the
 // number of nodes on a row/column of the grid.
 template <typename GraphType>
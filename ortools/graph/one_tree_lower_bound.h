@@ -110,6 +110,11 @@
 // significantly. At the end of the algorithm a last iteration is run on the
 // complete graph to ensure the bound is correct (the cost of a minimum 1-tree
 // on a partial graph is an upper bound to the one on a complete graph).
+// The costs of the arcs of the partial graph are cached, so the cost function
+// is not called on them again at each iteration. The O(n^2) computations on
+// the complete graph (nearest neighbors and minimum spanning trees) can run on
+// several threads, and use a version of Prim's algorithm without priority
+// queue.
 //
 // Usage:
 // std::function<int64_t(int,int)> cost_function =...;
@@ -127,10 +132,12 @@
 #include <cstdint>
 #include <limits>
 #include <set>
+#include <type_traits>
 #include <utility>
 #include <vector>
 
 #include "absl/types/span.h"
+#include "ortools/base/threadpool.h"
 #include "ortools/base/types.h"
 #include "ortools/graph/christofides.h"
 #include "ortools/graph/minimum_spanning_tree.h"
@@ -211,11 +218,7 @@ template <typename CostType, typename CostFunction>
 class HeldWolfeCrowderEvaluator {
  public:
   HeldWolfeCrowderEvaluator(int number_of_nodes, const CostFunction& cost)
-      : iteration_(0),
-        number_of_iterations_(2 * number_of_nodes),
-        upper_bound_(0),
-        lambda_(2.0),
-        step_(0) {
+      : HeldWolfeCrowderEvaluator(number_of_nodes, CostType{0}) {
     // TODO(user): Improve upper bound with some local search; tighter upper
     // bounds lead to faster convergence.
     ChristofidesPathSolver<CostType, int64_t, int, CostFunction> solver(
@@ -223,6 +226,16 @@ class HeldWolfeCrowderEvaluator {
     upper_bound_ = solver.TravelingSalesmanCost();
   }
 
+  // Uses the given upper bound of the TSP, e.g. the cost of a known tour,
+  // instead of computing one with the Christofides algorithm, which takes
+  // O(n^3) time.
+  HeldWolfeCrowderEvaluator(int number_of_nodes, CostType upper_bound)
+      : iteration_(0),
+        number_of_iterations_(2 * number_of_nodes),
+        upper_bound_(upper_bound),
+        lambda_(2.0),
+        step_(0) {}
+
   bool Next() {
     const int min_iterations = 2;
     if (iteration_ >= number_of_iterations_) {
@@ -263,30 +276,45 @@ class HeldWolfeCrowderEvaluator {
 // nodes to node i. Note that these indices contain the number_of_neighbors
 // nearest neighbors as well as all the nodes for which i is a nearest
 // neighbor.
+// If thread_pool is not nullptr, the neighbors of the nodes are computed in
+// parallel, so the cost function must support concurrent calls.
 template <typename CostFunction>
-std::set<std::pair<int, int>> NearestNeighbors(int number_of_nodes,
-                                               int number_of_neighbors,
-                                               const CostFunction& cost) {
+std::set<std::pair<int, int>> NearestNeighbors(
+    int number_of_nodes, int number_of_neighbors, const CostFunction& cost,
+    ThreadPool* thread_pool = nullptr) {
   using CostType = decltype(cost(0, 0));
+  std::vector<std::vector<int>> nearest_of_node(number_of_nodes);
+  constexpr int kNodesPerChunk = 16;
+  ParallelFor(
+      thread_pool, 0, number_of_nodes, kNodesPerChunk,
+      [&](int64_t begin, int64_t end) {
+        std::vector<std::pair<CostType, int>> neighbors;
+        neighbors.reserve(number_of_nodes - 1);
+        for (int i = begin; i < end; ++i) {
+          neighbors.clear();
+          for (int j = 0; j < number_of_nodes; ++j) {
+            if (i != j) {
+              neighbors.emplace_back(cost(i, j), j);
+            }
+          }
+          int size = neighbors.size();
+          if (number_of_neighbors < size) {
+            std::nth_element(neighbors.begin(),
+                             neighbors.begin() + number_of_neighbors - 1,
+                             neighbors.end());
+            size = number_of_neighbors;
+          }
+          nearest_of_node[i].reserve(size);
+          for (int j = 0; j < size; ++j) {
+            nearest_of_node[i].push_back(neighbors[j].second);
+          }
+        }
+      });
   std::set<std::pair<int, int>> nearest;
   for (int i = 0; i < number_of_nodes; ++i) {
-    std::vector<std::pair<CostType, int>> neighbors;
-    neighbors.reserve(number_of_nodes - 1);
-    for (int j = 0; j < number_of_nodes; ++j) {
-      if (i != j) {
-        neighbors.emplace_back(cost(i, j), j);
-      }
-    }
-    int size = neighbors.size();
-    if (number_of_neighbors < size) {
-      std::nth_element(neighbors.begin(),
-                       neighbors.begin() + number_of_neighbors - 1,
-                       neighbors.end());
-      size = number_of_neighbors;
-    }
-    for (int j = 0; j < size; ++j) {
-      nearest.insert({i, neighbors[j].second});
-      nearest.insert({neighbors[j].second, i});
+    for (const int j : nearest_of_node[i]) {
+      nearest.insert({i, j});
+      nearest.insert({j, i});
     }
   }
   return nearest;
@@ -297,12 +325,15 @@ std::set<std::pair<int, int>> NearestNeighbors(int number_of_nodes,
 template <typename CostFunction>
 void AddArcsFromMinimumSpanningTree(int number_of_nodes,
                                     const CostFunction& cost,
-                                    std::set<std::pair<int, int>>* arcs) {
+                                    std::set<std::pair<int, int>>* arcs,
+                                    ThreadPool* thread_pool = nullptr) {
   util::CompleteGraph<int, int> graph(number_of_nodes);
-  const std::vector<int> mst =
-      BuildPrimMinimumSpanningTree(graph, [&cost, &graph](int arc) {
+  const std::vector<int> mst = BuildPrimMinimumSpanningTreeOnCompleteGraph(
+      graph,
+      [&cost, &graph](int arc) {
         return cost(graph.Tail(arc), graph.Head(arc));
-      });
+      },
+      thread_pool);
   for (int arc : mst) {
     arcs->insert({graph.Tail(arc), graph.Head(arc)});
     arcs->insert({graph.Head(arc), graph.Tail(arc)});
@@ -329,29 +360,17 @@ int GetNodeMinimizingEdgeCostToSource(const GraphType& graph, int source,
   return best_node;
 }
 
-// Computes a 1-tree for the given graph, cost function and node weights.
-// Returns the degree of each node in the 1-tree and the un-weighed cost of the
-// 1-tree.
+// Completes the minimum spanning tree 'mst' of graph into a 1-tree for the
+// given cost function and node weights. Returns the degree of each node in the
+// 1-tree and the un-weighed cost of the 1-tree.
 template <typename CostFunction, typename GraphType, typename CostType>
-std::vector<int> ComputeOneTree(const GraphType& graph,
-                                const CostFunction& cost,
-                                absl::Span<const double> weights,
-                                absl::Span<const int> sorted_arcs,
-                                CostType* one_tree_cost) {
+std::vector<int> ComputeOneTreeFromMinimumSpanningTree(
+    const GraphType& graph, const CostFunction& cost,
+    absl::Span<const double> weights, absl::Span<const int> mst,
+    CostType* one_tree_cost) {
   const auto weighed_cost = [&cost, weights](int from, int to) {
     return cost(from, to) + weights[from] + weights[to];
   };
-  // Compute MST on graph.
-  std::vector<int> mst;
-  if (!sorted_arcs.empty()) {
-    mst = BuildKruskalMinimumSpanningTreeFromSortedArcs<GraphType>(graph,
-                                                                   sorted_arcs);
-  } else {
-    mst = BuildPrimMinimumSpanningTree<GraphType>(
-        graph, [&weighed_cost, &graph](int arc) {
-          return weighed_cost(graph.Tail(arc), graph.Head(arc));
-        });
-  }
   std::vector<int> degrees(graph.num_nodes() + 1, 0);
   *one_tree_cost = 0;
   for (int arc : mst) {
@@ -378,33 +397,75 @@ std::vector<int> ComputeOneTree(const GraphType& graph,
   return degrees;
 }
 
+// Computes a 1-tree for the given graph, cost function and node weights.
+// Returns the degree of each node in the 1-tree and the un-weighed cost of the
+// 1-tree. The thread pool, if not nullptr, is only used on complete graphs.
+template <typename CostFunction, typename GraphType, typename CostType>
+std::vector<int> ComputeOneTree(const GraphType& graph,
+                                const CostFunction& cost,
+                                absl::Span<const double> weights,
+                                absl::Span<const int> sorted_arcs,
+                                CostType* one_tree_cost,
+                                ThreadPool* thread_pool = nullptr) {
+  const auto weighed_arc_cost = [&cost, weights, &graph](int arc) {
+    const int tail = graph.Tail(arc);
+    const int head = graph.Head(arc);
+    return cost(tail, head) + weights[tail] + weights[head];
+  };
+  // Compute MST on graph.
+  std::vector<int> mst;
+  if (!sorted_arcs.empty()) {
+    mst = BuildKruskalMinimumSpanningTreeFromSortedArcs<GraphType>(graph,
+                                                                   sorted_arcs);
+  } else if constexpr (std::is_same_v<GraphType,
+                                      util::CompleteGraph<int, int>>) {
+    mst = BuildPrimMinimumSpanningTreeOnCompleteGraph(graph, weighed_arc_cost,
+                                                      thread_pool);
+  } else {
+    mst = BuildPrimMinimumSpanningTree<GraphType>(graph, weighed_arc_cost);
+  }
+  return ComputeOneTreeFromMinimumSpanningTree(graph, cost, weights, mst,
+                                               one_tree_cost);
+}
+
 // Computes the lower bound of a TSP using a given subgradient algorithm.
+// If thread_pool is not nullptr, it is used for the computations on the
+// complete graph, and the cost function must then support concurrent calls.
 template <typename CostFunction, typename Algorithm>
-double ComputeOneTreeLowerBoundWithAlgorithm(int number_of_nodes,
-                                             int nearest_neighbors,
-                                             const CostFunction& cost,
-                                             Algorithm* algorithm) {
+double ComputeOneTreeLowerBoundWithAlgorithm(
+    int number_of_nodes, int nearest_neighbors, const CostFunction& cost,
+    Algorithm* algorithm, ThreadPool* thread_pool = nullptr) {
   if (number_of_nodes < 2) return 0;
   if (number_of_nodes == 2) return cost(0, 1) + cost(1, 0);
   using CostType = decltype(cost(0, 0));
-  auto nearest = NearestNeighbors(number_of_nodes - 1, nearest_neighbors, cost);
+  auto nearest = NearestNeighbors(number_of_nodes - 1, nearest_neighbors, cost,
+                                  thread_pool);
   // Ensure nearest arcs result in a connected graph by adding arcs from the
   // minimum spanning tree; this will add arcs which are likely to be "good"
   // 1-tree arcs.
-  AddArcsFromMinimumSpanningTree(number_of_nodes - 1, cost, &nearest);
+  AddArcsFromMinimumSpanningTree(number_of_nodes - 1, cost, &nearest,
+                                 thread_pool);
   util::ListGraph<int, int> graph(number_of_nodes - 1, nearest.size());
+  std::vector<CostType> arc_costs;
+  arc_costs.reserve(nearest.size());
   for (const auto& arc : nearest) {
     graph.AddArc(arc.first, arc.second);
+    arc_costs.push_back(cost(arc.first, arc.second));
   }
   std::vector<double> weights(number_of_nodes, 0);
   std::vector<double> best_weights(number_of_nodes, 0);
+  const auto weighed_arc_cost = [&graph, &arc_costs, &weights](int arc) {
+    return arc_costs[arc] + weights[graph.Tail(arc)] + weights[graph.Head(arc)];
+  };
   double max_w = -std::numeric_limits<double>::infinity();
   double w = 0;
   // Iteratively compute lower bound using a partial graph.
   while (algorithm->Next()) {
     CostType one_tree_cost = 0;
-    const std::vector<int> degrees =
-        ComputeOneTree(graph, cost, weights, {}, &one_tree_cost);
+    const std::vector<int> mst =
+        BuildPrimMinimumSpanningTree(graph, weighed_arc_cost);
+    const std::vector<int> degrees = ComputeOneTreeFromMinimumSpanningTree(
+        graph, cost, weights, mst, &one_tree_cost);
     algorithm->OnOneTree(one_tree_cost, w, degrees);
     w = one_tree_cost;
     for (int j = 0; j < number_of_nodes; ++j) {
@@ -425,11 +486,8 @@ double ComputeOneTreeLowerBoundWithAlgorithm(int number_of_nodes,
   // lead to a lower bound.
   util::CompleteGraph<int, int> complete_graph(number_of_nodes - 1);
   CostType one_tree_cost = 0;
-  // TODO(user): We are not caching here since this would take O(n^2) memory;
-  // however the Kruskal algorithm will expand all arcs also consuming O(n^2)
-  // memory; investigate alternatives to expanding all arcs (Prim's algorithm).
-  const std::vector<int> degrees =
-      ComputeOneTree(complete_graph, cost, best_weights, {}, &one_tree_cost);
+  const std::vector<int> degrees = ComputeOneTree(
+      complete_graph, cost, best_weights, {}, &one_tree_cost, thread_pool);
   w = one_tree_cost;
   for (int j = 0; j < number_of_nodes; ++j) {
     w += best_weights[j] * (degrees[j] - 2);
@@ -450,6 +508,14 @@ struct TravelingSalesmanLowerBoundParameters {
   int volgenant_jonker_iterations = 0;
   // Number of nearest neighbors to consider in the miminum spanning trees.
   int nearest_neighbors = 40;
+  // Upper bound of the TSP used by the Held-Wolfe-Crowder algorithm, e.g. the
+  // cost of a known tour. If not positive, it is computed with the Christofides
+  // algorithm, which is impractical on large instances.
+  double held_wolfe_crowder_upper_bound = 0;
+  // If not nullptr, the O(n^2) computations on the complete graph are run on
+  // the workers of this pool. The cost function must then support concurrent
+  // calls. Not owned.
+  ThreadPool* thread_pool = nullptr;
 };
 
 // Computes the lower bound of a TSP using given parameters.
@@ -463,14 +529,24 @@ double ComputeOneTreeLowerBoundWithParameters(
       VolgenantJonkerEvaluator<CostType> algorithm(
           number_of_nodes, parameters.volgenant_jonker_iterations);
       return ComputeOneTreeLowerBoundWithAlgorithm(
-          number_of_nodes, parameters.nearest_neighbors, cost, &algorithm);
+          number_of_nodes, parameters.nearest_neighbors, cost, &algorithm,
+          parameters.thread_pool);
       break;
     }
     case TravelingSalesmanLowerBoundParameters::HeldWolfeCrowder: {
+      if (parameters.held_wolfe_crowder_upper_bound > 0) {
+        HeldWolfeCrowderEvaluator<CostType, CostFunction> algorithm(
+            number_of_nodes,
+            static_cast<CostType>(parameters.held_wolfe_crowder_upper_bound));
+        return ComputeOneTreeLowerBoundWithAlgorithm(
+            number_of_nodes, parameters.nearest_neighbors, cost, &algorithm,
+            parameters.thread_pool);
+      }
       HeldWolfeCrowderEvaluator<CostType, CostFunction> algorithm(
           number_of_nodes, cost);
       return ComputeOneTreeLowerBoundWithAlgorithm(
-          number_of_nodes, parameters.nearest_neighbors, cost, &algorithm);
+          number_of_nodes, parameters.nearest_neighbors, cost, &algorithm,
+          parameters.thread_pool);
     }
     default:
       LOG(ERROR) << "Unsupported algorithm: " << parameters.algorithm;
@@ -22,6 +22,7 @@
 #include "absl/types/span.h"
 #include "gtest/gtest.h"
 #include "ortools/base/path.h"
+#include "ortools/base/threadpool.h"
 #include "ortools/base/types.h"
 #include "ortools/routing/parsers/tsplib_parser.h"
 
@@ -91,5 +92,43 @@ TEST(OneTreeLBTest, Small) {
   EXPECT_EQ(9, cost);
 }
 
+TEST(OneTreeLBTest, SmallWithThreadPool) {
+  const std::vector<int> x = {0, 0, 0, 1, 1, 1, 2, 2, 2};
+  const std::vector<int> y = {0, 1, 2, 0, 1, 2, 0, 1, 2};
+  ThreadPool pool(4);
+  pool.StartWorkers();
+  TravelingSalesmanLowerBoundParameters parameters;
+  parameters.thread_pool = &pool;
+  const double cost = ComputeOneTreeLowerBoundWithParameters(
+      9,
+      [&x, &y](int from, int to) {
+        const int dx = std::abs(x[from] - x[to]);
+        const int dy = std::abs(y[from] - y[to]);
+        return dx + dy;
+      },
+      parameters);
+  EXPECT_EQ(9, cost);
+}
+
+TEST(OneTreeLBTest, HeldWolfeCrowderWithUpperBound) {
+  const std::vector<int> x = {0, 0, 0, 1, 1, 1, 2, 2, 2};
+  const std::vector<int> y = {0, 1, 2, 0, 1, 2, 0, 1, 2};
+  TravelingSalesmanLowerBoundParameters parameters;
+  parameters.algorithm =
+      TravelingSalesmanLowerBoundParameters::HeldWolfeCrowder;
+  // The cost of the tour going through the columns in turn.
+  parameters.held_wolfe_crowder_upper_bound = 10;
+  const double cost = ComputeOneTreeLowerBoundWithParameters(
+      9,
+      [&x, &y](int from, int to) {
+        const int dx = std::abs(x[from] - x[to]);
+        const int dy = std::abs(y[from] - y[to]);
+        return dx + dy;
+      },
+      parameters);
+  EXPECT_LE(8, cost);
+  EXPECT_GE(10, cost);
+}
+
 }  // namespace
 }  // namespace operations_research
@@ -29,8 +29,25 @@ namespace operations_research {
 
 void MinCostPerfectMatching::Reset(int num_nodes) {
   graph_ = std::make_unique<BlossomGraph>(num_nodes);
+  optimal_solution_found_ = false;
   optimal_cost_ = 0;
+  maximum_edge_cost_ = 0;
   matches_.assign(num_nodes, -1);
+  optimal_duals_.clear();
+  warm_start_duals_.clear();
+  matching_hint_.clear();
+}
+
+void MinCostPerfectMatching::ResetForResolve() {
+  if (!optimal_solution_found_) {
+    Reset(matches_.size());
+    return;
+  }
+  std::vector<int64_t> duals = std::move(optimal_duals_);
+  std::vector<int> hint = matches_;
+  Reset(matches_.size());
+  warm_start_duals_ = std::move(duals);
+  matching_hint_ = std::move(hint);
 }
 
 void MinCostPerfectMatching::AddEdgeWithCost(int tail, int head, int64_t cost) {
@@ -65,6 +82,22 @@ MinCostPerfectMatching::Status MinCostPerfectMatching::Solve() {
   }
 
   const int num_nodes = matches_.size();
+  if (!warm_start_duals_.empty() || !matching_hint_.empty()) {
+    std::vector<BlossomGraph::CostValue> duals;
+    duals.reserve(warm_start_duals_.size());
+    for (const int64_t dual : warm_start_duals_) {
+      duals.push_back(BlossomGraph::CostValue(dual));
+    }
+    std::vector<BlossomGraph::NodeIndex> hint;
+    hint.reserve(matching_hint_.size());
+    for (const int node : matching_hint_) {
+      hint.push_back(node < 0 ? BlossomGraph::kNoNodeIndex
+                              : BlossomGraph::NodeIndex(node));
+    }
+    graph_->SetWarmStart(std::move(duals), std::move(hint));
+    warm_start_duals_.clear();
+    matching_hint_.clear();
+  }
   if (!graph_->Initialize()) return Status::INFEASIBLE;
   VLOG(2) << graph_->DebugString();
   VLOG(1) << "num_unmatched: " << num_nodes - graph_->NumMatched()
@@ -102,8 +135,15 @@ MinCostPerfectMatching::Status MinCostPerfectMatching::Solve() {
   // TODO(user): Maybe there is a faster/better way to recover the mapping
   // in the presence of blossoms.
   graph_->ExpandAllBlossoms();
+  optimal_duals_.resize(num_nodes);
   for (int i = 0; i < num_nodes; ++i) {
-    matches_[i] = graph_->Match(BlossomGraph::NodeIndex(i)).value();
+    const BlossomGraph::NodeIndex n(i);
+    matches_[i] = graph_->Match(n).value();
+
+    // The internal duals are scaled by two, and we drop the blossom duals,
+    // which can only make the dual solution "more" feasible.
+    optimal_duals_[i] =
+        std::max<int64_t>(0, graph_->Dual(graph_->GetNode(i)).value() / 2);
   }
 
   optimal_solution_found_ = true;
@@ -146,6 +186,15 @@ void BlossomGraph::AddEdge(NodeIndex tail, NodeIndex head, CostValue cost) {
   graph_[head].push_back(index);
 }
 
+void BlossomGraph::SetWarmStart(std::vector<CostValue> duals,
+                                std::vector<NodeIndex> matching_hint) {
+  DCHECK(!is_initialized_);
+  DCHECK(duals.empty() || duals.size() == nodes_.size());
+  DCHECK(matching_hint.empty() || matching_hint.size() == nodes_.size());
+  warm_start_duals_ = std::move(duals);
+  matching_hint_ = std::move(matching_hint);
+}
+
 // TODO(user): Code the more advanced "Fractional matching initialization"
 // heuristic.
 //
@@ -156,6 +205,16 @@ bool BlossomGraph::Initialize() {
 
   for (NodeIndex n(0); n < nodes_.size(); ++n) {
     if (graph_[n].empty()) return false;  // INFEASIBLE.
+
+    // Starts with all nodes as tree roots.
+    nodes_[n].type = 1;
+
+    if (!warm_start_duals_.empty()) {
+      DCHECK_GE(warm_start_duals_[n.value()], 0);
+      nodes_[n].pseudo_dual = warm_start_duals_[n.value()];
+      continue;
+    }
+
     CostValue min_cost = kMaxCostValue;
 
     // Initialize the dual of each nodes to min_cost / 2.
@@ -167,9 +226,24 @@ bool BlossomGraph::Initialize() {
     }
     DCHECK_NE(min_cost, kMaxCostValue);
     nodes_[n].pseudo_dual = min_cost / 2;
+  }
 
-    // Starts with all nodes as tree roots.
-    nodes_[n].type = 1;
+  // The warm-start duals might not be feasible anymore if some costs
+  // decreased. Lowering the dual of a node only increases the slack of its
+  // other edges, so one pass is enough to restore the dual feasibility. The
+  // duals stay non-negative since the costs are.
+  if (!warm_start_duals_.empty()) {
+    for (const Edge& edge : edges_) {
+      const CostValue excess = nodes_[edge.tail].pseudo_dual +
+                               nodes_[edge.head].pseudo_dual -
+                               edge.pseudo_slack;
+      if (excess <= 0) continue;
+      const CostValue tail_decrease =
+          std::min(excess, nodes_[edge.tail].pseudo_dual);
+      nodes_[edge.tail].pseudo_dual -= tail_decrease;
+      nodes_[edge.head].pseudo_dual -= excess - tail_decrease;
+    }
+    warm_start_duals_.clear();
   }
 
   // Update the slack of each edges now that nodes might have non-zero duals.
@@ -181,6 +255,47 @@ bool BlossomGraph::Initialize() {
     DCHECK_GE(mutable_edge.pseudo_slack, 0);
   }
 
+  // Try to match the hinted pairs first: we raise the dual of both ends as much
+  // as possible in the hope of making their edge tight.
+  for (NodeIndex n(0); n < matching_hint_.size(); ++n) {
+    const NodeIndex m = matching_hint_[n.value()];
+    if (m <= n || m >= nodes_.size()) continue;
+    if (NodeIsMatched(n) || NodeIsMatched(m)) continue;
+
+    EdgeIndex hint_edge = kNoEdgeIndex;
+    for (const EdgeIndex e : graph_[n]) {
+      if (edges_[e].OtherEnd(n) != m) continue;
+      if (hint_edge == kNoEdgeIndex ||
+          edges_[e].pseudo_slack < edges_[hint_edge].pseudo_slack) {
+        hint_edge = e;
+      }
+    }
+    if (hint_edge == kNoEdgeIndex) continue;
+
+    for (const NodeIndex end : {n, m}) {
+      if (edges_[hint_edge].pseudo_slack == 0) break;
+      CostValue min_slack = kMaxCostValue;
+      for (const EdgeIndex e : graph_[end]) {
+        min_slack = std::min(min_slack, edges_[e].pseudo_slack);
+      }
+      const CostValue delta =
+          std::min(min_slack, edges_[hint_edge].pseudo_slack);
+      if (delta == 0) continue;
+      nodes_[end].pseudo_dual += delta;
+      for (const EdgeIndex e : graph_[end]) {
+        edges_[e].pseudo_slack -= delta;
+      }
+      DebugUpdateNodeDual(end, delta);
+    }
+    if (edges_[hint_edge].pseudo_slack != 0) continue;
+
+    nodes_[n].type = 0;
+    nodes_[n].match = m;
+    nodes_[m].type = 0;
+    nodes_[m].match = n;
+  }
+  matching_hint_.clear();
+
   for (NodeIndex n(0); n < nodes_.size(); ++n) {
     if (NodeIsMatched(n)) continue;
 
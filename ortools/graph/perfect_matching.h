@@ -31,6 +31,7 @@
 #include <limits>
 #include <memory>
 #include <string>
+#include <utility>
 #include <vector>
 
 #include "absl/base/attributes.h"
@@ -60,11 +61,26 @@ class MinCostPerfectMatching {
   explicit MinCostPerfectMatching(int num_nodes) { Reset(num_nodes); }
 
   // Resets the class for a new graph.
-  //
-  // TODO(user): Eventually, we may support incremental Solves(). Or at least
-  // memory reuse if one wants to solve many problems in a row.
   void Reset(int num_nodes);
 
+  // Resets the graph for a new Solve() on the same nodes, but keeps the last
+  // optimal solution, if any, to warm-start it. This is meant to be used when
+  // the costs change a little between solves: all the edges must be added
+  // again with their new costs, and the last node dual values (made feasible
+  // for the new costs) and matching are used as the starting point of the
+  // next Solve(). This only affects the running time, not the result.
+  void ResetForResolve();
+
+  // Gives a matching to jump-start the next Solve(), for instance computed by
+  // a greedy heuristic: hint[node] is the node it should be matched to, or -1.
+  // The algorithm will try to match these pairs first by raising the node dual
+  // values as much as possible. This only affects the running time, not the
+  // result.
+  void SetMatchingHint(std::vector<int> hint) {
+    DCHECK_EQ(hint.size(), matches_.size());
+    matching_hint_ = std::move(hint);
+  }
+
   // Adds an undirected edges between the two given nodes.
   //
   // For now we only accept non-negative cost.
@@ -131,6 +147,13 @@ class MinCostPerfectMatching {
   int64_t optimal_cost_ = 0;
   int64_t maximum_edge_cost_ = 0;
   std::vector<int> matches_;
+
+  // The node dual values of the last optimal solution, see ResetForResolve().
+  std::vector<int64_t> optimal_duals_;
+
+  // The warm-start information for the next Solve().
+  std::vector<int64_t> warm_start_duals_;
+  std::vector<int> matching_hint_;
 };
 
 // Class containing the main data structure used by the Blossom algorithm.
@@ -311,6 +334,13 @@ class BlossomGraph {
   // Same comment as MinCostPerfectMatching::AddEdgeWithCost() applies.
   void AddEdge(NodeIndex tail, NodeIndex head, CostValue cost);
 
+  // Sets the node dual values and/or the matching (with kNoNodeIndex for
+  // unmatched nodes) to start from in Initialize(). Any of the two vectors can
+  // be empty. The duals are in the same unit as the costs and must be
+  // non-negative, but they do not need to be feasible.
+  void SetWarmStart(std::vector<CostValue> duals,
+                    std::vector<NodeIndex> matching_hint);
+
   // Heuristic to start with a dual-feasible solution and some matched edges.
   // To be called once all edges are added. Returns false if the problem is
   // detected to be INFEASIBLE.
@@ -455,6 +485,10 @@ class BlossomGraph {
   // Just used to check that initialized is called exactly once.
   bool is_initialized_ = false;
 
+  // See SetWarmStart().
+  std::vector<CostValue> warm_start_duals_;
+  std::vector<NodeIndex> matching_hint_;
+
   // The set of all edges/nodes of the graph.
   absl::StrongVector<EdgeIndex, Edge> edges_;
   absl::StrongVector<NodeIndex, Node> nodes_;
@@ -309,6 +309,59 @@ TEST(BlossomGraphTest, RandomLargeGraph) {
   CheckOptimalSolution(matcher, edges);
 }
 
+TEST(BlossomGraphTest, ResolveWithChangedCosts) {
+  absl::BitGen random;
+  for (const int size : {10, 100, 1000}) {
+    MinCostPerfectMatching matcher;
+    std::vector<Edge> edges =
+        GenerateAndLoadRandomProblem(size, size * 10, &matcher);
+    ASSERT_EQ(matcher.Solve(), MinCostPerfectMatching::OPTIMAL);
+    CheckOptimalSolution(matcher, edges);
+
+    for (int round = 0; round < 5; ++round) {
+      // Perturb the costs up and down, and compare with a solve from scratch.
+      for (Edge& edge : edges) {
+        edge.cost = std::max<int64_t>(
+            0, edge.cost + absl::Uniform<int64_t>(random, -10, 10));
+      }
+      matcher.ResetForResolve();
+      MinCostPerfectMatching from_scratch(size);
+      for (const Edge edge : edges) {
+        matcher.AddEdgeWithCost(edge.node1, edge.node2, edge.cost);
+        from_scratch.AddEdgeWithCost(edge.node1, edge.node2, edge.cost);
+      }
+      ASSERT_EQ(matcher.Solve(), MinCostPerfectMatching::OPTIMAL);
+      ASSERT_EQ(from_scratch.Solve(), MinCostPerfectMatching::OPTIMAL);
+      CheckOptimalSolution(matcher, edges);
+      EXPECT_EQ(matcher.OptimalCost(), from_scratch.OptimalCost());
+    }
+  }
+}
+
+TEST(BlossomGraphTest, MatchingHintDoesNotChangeTheOptimum) {
+  MinCostPerfectMatching matcher;
+  const std::vector<Edge> edges =
+      GenerateAndLoadRandomProblem(100, 1000, &matcher);
+  ASSERT_EQ(matcher.Solve(), MinCostPerfectMatching::OPTIMAL);
+  const int64_t optimal_cost = matcher.OptimalCost();
+
+  // A bad hint: each node is matched to the first other node it is connected
+  // to, if still free.
+  matcher.Reset(100);
+  std::vector<int> hint(100, -1);
+  for (const Edge edge : edges) {
+    matcher.AddEdgeWithCost(edge.node1, edge.node2, edge.cost);
+    if (hint[edge.node1] == -1 && hint[edge.node2] == -1) {
+      hint[edge.node1] = edge.node2;
+      hint[edge.node2] = edge.node1;
+    }
+  }
+  matcher.SetMatchingHint(hint);
+  ASSERT_EQ(matcher.Solve(), MinCostPerfectMatching::OPTIMAL);
+  CheckOptimalSolution(matcher, edges);
+  EXPECT_EQ(matcher.OptimalCost(), optimal_cost);
+}
+
 int64_t SolveWithMip(absl::Span<const Edge> edges) {
   MPModelRequest request;
   request.set_solver_type(MPModelRequest::SAT_INTEGER_PROGRAMMING);
@@ -28,12 +28,18 @@ PYBIND11_MODULE(linear_sum_assignment, m) {
            arg("left_node"), arg("right_node"), arg("cost"));
   slsa.def("add_arcs_with_cost",
            pybind11::vectorize(&SimpleLinearSumAssignment::AddArcWithCost));
+  slsa.def("set_arc_cost", &SimpleLinearSumAssignment::SetArcCost, arg("arc"),
+           arg("cost"));
+  slsa.def("set_num_threads", &SimpleLinearSumAssignment::SetNumThreads,
+           arg("num_threads"));
   slsa.def("num_nodes", &SimpleLinearSumAssignment::NumNodes);
   slsa.def("num_arcs", &SimpleLinearSumAssignment::NumArcs);
   slsa.def("left_node", &SimpleLinearSumAssignment::LeftNode, arg("arc"));
   slsa.def("right_node", &SimpleLinearSumAssignment::RightNode, arg("arc"));
   slsa.def("cost", &SimpleLinearSumAssignment::Cost, arg("arc"));
   slsa.def("solve", &SimpleLinearSumAssignment::Solve);
+  slsa.def("solve_from_last_solution",
+           &SimpleLinearSumAssignment::SolveFromLastSolution);
   slsa.def("optimal_cost", &SimpleLinearSumAssignment::OptimalCost);
   slsa.def("right_mate", &SimpleLinearSumAssignment::RightMate,
            arg("left_node"));
@@ -39,6 +39,8 @@ PYBIND11_MODULE(max_flow, m) {
   smf.def("tail", &SimpleMaxFlow::Tail, arg("arc"));
   smf.def("head", &SimpleMaxFlow::Head, arg("arc"));
   smf.def("capacity", &SimpleMaxFlow::Capacity, arg("arc"));
+  smf.def("set_num_threads", &SimpleMaxFlow::SetNumThreads,
+          arg("num_threads"));
   smf.def("solve", &SimpleMaxFlow::Solve, arg("source"), arg("sink"));
   smf.def("optimal_flow", &SimpleMaxFlow::OptimalFlow);
   smf.def("flow", &SimpleMaxFlow::Flow, arg("arc"));
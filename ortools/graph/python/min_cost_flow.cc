@@ -34,6 +34,10 @@ PYBIND11_MODULE(min_cost_flow, m) {
            arg("supply"));
   smcf.def("set_nodes_supplies",
            pybind11::vectorize(&SimpleMinCostFlow::SetNodeSupply));
+  smcf.def("set_arc_capacity", &SimpleMinCostFlow::SetArcCapacity, arg("arc"),
+           arg("capacity"));
+  smcf.def("set_arc_unit_cost", &SimpleMinCostFlow::SetArcUnitCost,
+           arg("arc"), arg("unit_cost"));
   smcf.def("num_nodes", &SimpleMinCostFlow::NumNodes);
   smcf.def("num_arcs", &SimpleMinCostFlow::NumArcs);
   smcf.def("tail", &SimpleMinCostFlow::Tail, arg("arc"));
@@ -44,6 +48,8 @@ PYBIND11_MODULE(min_cost_flow, m) {
   smcf.def("solve", &SimpleMinCostFlow::Solve);
   smcf.def("solve_max_flow_with_min_cost",
            &SimpleMinCostFlow::SolveMaxFlowWithMinCost);
+  smcf.def("solve_from_last_solution",
+           &SimpleMinCostFlow::SolveFromLastSolution);
   smcf.def("optimal_cost", &SimpleMinCostFlow::OptimalCost);
   smcf.def("maximum_flow", &SimpleMinCostFlow::MaximumFlow);
   smcf.def("flow", &SimpleMinCostFlow::Flow, arg("arc"));
@@ -58,6 +58,10 @@
 //                                                       sinks,
 //                                                       /*num_threads=*/4,
 //                                                       &container);
+//
+// When only the distances are needed, e.g. to build the transit matrices of a
+// routing model, ComputeManyToManyDistances() of many_to_many_distances.h is a
+// lot faster and uses a lot less memory since it stores no path.
 
 #ifndef OR_TOOLS_GRAPH_SHORTEST_PATHS_H_
 #define OR_TOOLS_GRAPH_SHORTEST_PATHS_H_
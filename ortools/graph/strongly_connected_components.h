@@ -39,15 +39,27 @@
 // is the type used internally by the algorithm. It is why it is better to
 // convert it to int or even int32_t rather than using size_t which takes 64
 // bits.
+//
+// On very large graphs, FindStronglyConnectedComponentsInParallel() finds the
+// same components with several threads, but outputs them in a different
+// order: see below.
 
 #ifndef UTIL_GRAPH_STRONGLY_CONNECTED_COMPONENTS_H_
 #define UTIL_GRAPH_STRONGLY_CONNECTED_COMPONENTS_H_
 
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <iterator>
 #include <limits>
+#include <memory>
+#include <utility>
 #include <vector>
 
 #include "absl/log/check.h"
 #include "absl/types/span.h"
+#include "ortools/base/threadpool.h"
+#include "ortools/graph/connected_components.h"
 
 // Finds the strongly connected components of a directed graph. It is templated
 // so it can be used in many contexts. See the simple example above for the
@@ -73,6 +85,34 @@ template <typename NodeIndex, typename Graph, typename SccOutput>
 void FindStronglyConnectedComponents(NodeIndex num_nodes, const Graph& graph,
                                      SccOutput* components);
 
+// Same, with `num_threads` threads, for graphs with up to 2^31 - 1 nodes. The
+// Graph and SccOutput requirements are the same, except that graph[node] must
+// be safe to call concurrently, and that:
+// - The components are NOT output in reverse topological order, but by
+//   increasing smallest node, and the nodes of each component are sorted. Hence
+//   the output is deterministic, whatever the number of threads.
+// - All the components are output at the end, from the calling thread.
+//
+// The algorithm first removes the trivial singleton components (the nodes
+// without incoming or outgoing arcs), then finds the component of the node
+// with the largest in x out degree with two parallel BFS, forward and
+// backward, which on most large graphs catches the giant component. The
+// remaining nodes are split according to whether they were reached by each
+// BFS, and then by weakly connected component, with a
+// ConcurrentConnectedComponentsFinder. Sequential Tarjan searches then run
+// concurrently on these subgraphs. Memory usage is O(nodes + arcs): the
+// reverse graph is built internally.
+//
+// With one thread, this simply sorts the output of
+// FindStronglyConnectedComponents(). The parallel version is slower than that
+// on small graphs, and does not scale when a large part of the graph is neither
+// in nor connected to the giant component by arcs in both directions.
+template <typename NodeIndex, typename Graph, typename SccOutput>
+void FindStronglyConnectedComponentsInParallel(NodeIndex num_nodes,
+                                               const Graph& graph,
+                                               SccOutput* components,
+                                               int num_threads);
+
 // A simple custom output class that just counts the number of SCC. Not
 // allocating many vectors can save both space and speed if your graph is large.
 //
@@ -220,4 +260,337 @@ void FindStronglyConnectedComponents(const NodeIndex num_nodes,
   return helper.FindStronglyConnectedComponents(num_nodes, graph, components);
 }
 
+namespace internal {
+
+// Calls f(worker, begin, end) on consecutive ranges of [0, num_items) that
+// cover it, in parallel. See ParallelForEachItem().
+template <typename F>
+void ParallelForEachRange(operations_research::ThreadPool* thread_pool,
+                          int num_workers, int64_t num_items, const F& f) {
+  constexpr int64_t kItemsPerRange = 1024;
+  operations_research::ParallelForEachItem(
+      thread_pool, num_workers,
+      (num_items + kItemsPerRange - 1) / kItemsPerRange,
+      [&](int worker, int64_t range) {
+        const int64_t begin = range * kItemsPerRange;
+        f(worker, begin, std::min(num_items, begin + kItemsPerRange));
+      });
+}
+
+// The subgraph given to the sequential Tarjan searches, in compressed sparse
+// row form and with local node indices.
+struct SccSubgraph {
+  std::vector<int32_t> start;
+  std::vector<int32_t> heads;
+  absl::Span<const int32_t> operator[](int32_t node) const {
+    return absl::MakeConstSpan(heads.data() + start[node],
+                               start[node + 1] - start[node]);
+  }
+};
+
+// Records the components found by a StronglyConnectedComponentsFinder, by
+// setting the representative of all their nodes to their first node. The
+// nodes found are mapped to global_nodes, unless it is empty.
+template <typename NodeIndex>
+struct SccRepresentativeOutput {
+  absl::Span<const NodeIndex> global_nodes;
+  absl::Span<NodeIndex> representative;
+  template <typename LocalIndex>
+  void emplace_back(LocalIndex const* b, LocalIndex const* e) {
+    const auto global = [this](LocalIndex node) {
+      return global_nodes.empty() ? static_cast<NodeIndex>(node)
+                                  : global_nodes[node];
+    };
+    for (const LocalIndex* it = b; it != e; ++it) {
+      representative[global(*it)] = global(*b);
+    }
+  }
+};
+
+// Sets the representative of all the nodes, see
+// FindStronglyConnectedComponentsInParallel() for the algorithm.
+template <typename NodeIndex, typename Graph>
+void FindSccRepresentativesInParallel(const NodeIndex num_nodes,
+                                      const Graph& graph, int num_threads,
+                                      absl::Span<NodeIndex> representative) {
+  const int64_t n = num_nodes;
+  operations_research::ThreadPool thread_pool("StronglyConnectedComponents",
+                                              num_threads);
+  thread_pool.StartWorkers();
+  const auto for_each_range = [&](int64_t num_items, const auto& f) {
+    ParallelForEachRange(&thread_pool, num_threads, num_items, f);
+  };
+
+  // The reverse graph, in compressed sparse row form. The arcs of each node are
+  // in no particular order.
+  std::vector<int64_t> reverse_start(n + 1);
+  std::vector<NodeIndex> reverse_heads;
+  {
+    std::vector<std::atomic<int64_t>> next(n + 1);
+    for_each_range(n, [&](int, int64_t begin, int64_t end) {
+      for (int64_t node = begin; node < end; ++node) {
+        for (const NodeIndex head : graph[static_cast<NodeIndex>(node)]) {
+          next[head + 1].fetch_add(1, std::memory_order_relaxed);
+        }
+      }
+    });
+    for (int64_t node = 0; node < n; ++node) {
+      reverse_start[node + 1] =
+          reverse_start[node] + next[node + 1].load(std::memory_order_relaxed);
+      next[node].store(reverse_start[node], std::memory_order_relaxed);
+    }
+    reverse_heads.resize(reverse_start[n]);
+    for_each_range(n, [&](int, int64_t begin, int64_t end) {
+      for (int64_t node = begin; node < end; ++node) {
+        for (const NodeIndex head : graph[static_cast<NodeIndex>(node)]) {
+          reverse_heads[next[head].fetch_add(1, std::memory_order_relaxed)] =
+              static_cast<NodeIndex>(node);
+        }
+      }
+    });
+  }
+  const auto reverse_graph = [&](NodeIndex node) {
+    return absl::MakeConstSpan(reverse_heads.data() + reverse_start[node],
+                               reverse_start[node + 1] - reverse_start[node]);
+  };
+
+  constexpr uint8_t kDone = 1;
+  constexpr uint8_t kForward = 2;
+  constexpr uint8_t kBackward = 4;
+  std::vector<std::atomic<uint8_t>> flags(n);
+  const auto is_done = [&flags](NodeIndex node) {
+    return flags[node].load(std::memory_order_relaxed) & kDone;
+  };
+
+  // Trimming: a node without arcs to or from other nodes is a component by
+  // itself. A node whose arcs all come from (or go to) such nodes is also one,
+  // so the nodes trimmed concurrently are taken into account when they are
+  // seen, and a second pass catches some more.
+  for (int pass = 0; pass < 2; ++pass) {
+    for_each_range(n, [&](int, int64_t begin, int64_t end) {
+      const auto has_live_neighbor = [&](NodeIndex node, const auto& heads) {
+        for (const NodeIndex head : heads) {
+          if (head != node && !is_done(head)) return true;
+        }
+        return false;
+      };
+      for (int64_t i = begin; i < end; ++i) {
+        const NodeIndex node = static_cast<NodeIndex>(i);
+        if (is_done(node)) continue;
+        if (!has_live_neighbor(node, graph[node]) ||
+            !has_live_neighbor(node, reverse_graph(node))) {
+          representative[node] = node;
+          flags[node].fetch_or(kDone, std::memory_order_relaxed);
+        }
+      }
+    });
+  }
+
+  // Forward-backward search from the pivot. We pick the smallest node among the
+  // ones with the largest in x out degree, to be deterministic.
+  std::vector<std::pair<int64_t, int64_t>> best_pivot(num_threads, {-1, 0});
+  for_each_range(n, [&](int worker, int64_t begin, int64_t end) {
+    std::pair<int64_t, int64_t>& best = best_pivot[worker];
+    for (int64_t i = begin; i < end; ++i) {
+      const NodeIndex node = static_cast<NodeIndex>(i);
+      if (is_done(node)) continue;
+      const auto& heads = graph[node];
+      const int64_t out_degree =
+          std::distance(std::begin(heads), std::end(heads));
+      const int64_t score =
+          out_degree * (reverse_start[node + 1] - reverse_start[node]);
+      best = std::max(best, {score, -i});
+    }
+  });
+  const std::pair<int64_t, int64_t> pivot =
+      *std::max_element(best_pivot.begin(), best_pivot.end());
+  if (pivot.first >= 0) {
+    std::vector<std::vector<NodeIndex>> next_frontiers(num_threads);
+    std::vector<NodeIndex> frontier;
+    const auto search = [&](uint8_t bit, const auto& neighbors) {
+      frontier.assign(1, static_cast<NodeIndex>(-pivot.second));
+      flags[frontier[0]].fetch_or(bit, std::memory_order_relaxed);
+      while (!frontier.empty()) {
+        for_each_range(frontier.size(), [&](int worker, int64_t begin,
+                                            int64_t end) {
+          for (int64_t i = begin; i < end; ++i) {
+            for (const NodeIndex head : neighbors(frontier[i])) {
+              const uint8_t head_flags =
+                  flags[head].load(std::memory_order_relaxed);
+              if ((head_flags & (kDone | bit)) != 0) continue;
+              if ((flags[head].fetch_or(bit, std::memory_order_relaxed) &
+                   bit) == 0) {
+                next_frontiers[worker].push_back(head);
+              }
+            }
+          }
+        });
+        frontier.clear();
+        for (std::vector<NodeIndex>& next : next_frontiers) {
+          frontier.insert(frontier.end(), next.begin(), next.end());
+          next.clear();
+        }
+      }
+    };
+    search(kForward, [&graph](NodeIndex node) { return graph[node]; });
+    search(kBackward, reverse_graph);
+    const NodeIndex pivot_node = static_cast<NodeIndex>(-pivot.second);
+    for_each_range(n, [&](int, int64_t begin, int64_t end) {
+      for (int64_t i = begin; i < end; ++i) {
+        if (flags[i].load(std::memory_order_relaxed) ==
+            (kForward | kBackward)) {
+          representative[i] = pivot_node;
+          flags[i].store(kDone, std::memory_order_relaxed);
+        }
+      }
+    });
+  }
+  std::vector<int64_t>().swap(reverse_start);
+  std::vector<NodeIndex>().swap(reverse_heads);
+
+  // The remaining components are within the weakly connected components of the
+  // arcs between remaining nodes with the same flags.
+  ConcurrentConnectedComponentsFinder weak_components(num_nodes);
+  for_each_range(n, [&](int, int64_t begin, int64_t end) {
+    for (int64_t i = begin; i < end; ++i) {
+      const NodeIndex node = static_cast<NodeIndex>(i);
+      const uint8_t node_flags = flags[node].load(std::memory_order_relaxed);
+      if (node_flags & kDone) continue;
+      for (const NodeIndex head : graph[node]) {
+        if (flags[head].load(std::memory_order_relaxed) == node_flags) {
+          weak_components.AddEdge(node, head);
+        }
+      }
+    }
+  });
+
+  // Group the remaining nodes by weakly connected component. The local index of
+  // a node is its position in its group.
+  std::vector<int32_t> group_of_root(n, -1);
+  std::vector<int32_t> root_of_node(n, -1);
+  std::vector<int64_t> group_start;
+  for_each_range(n, [&](int, int64_t begin, int64_t end) {
+    for (int64_t i = begin; i < end; ++i) {
+      if (!is_done(static_cast<NodeIndex>(i))) {
+        root_of_node[i] = weak_components.FindRoot(i);
+      }
+    }
+  });
+  for (int64_t node = 0; node < n; ++node) {
+    if (root_of_node[node] < 0) continue;
+    int32_t& group = group_of_root[root_of_node[node]];
+    if (group < 0) {
+      group = group_start.size();
+      group_start.push_back(0);
+    }
+    ++group_start[group];
+  }
+  const int64_t num_groups = group_start.size();
+  int64_t num_grouped_nodes = 0;
+  for (int64_t& start : group_start) {
+    num_grouped_nodes += start;
+    start = num_grouped_nodes - start;
+  }
+  group_start.push_back(num_grouped_nodes);
+  std::vector<NodeIndex> grouped_nodes(num_grouped_nodes);
+  std::vector<int32_t> local_index(n, -1);
+  {
+    std::vector<int64_t> next(group_start.begin(), group_start.end() - 1);
+    for (int64_t node = 0; node < n; ++node) {
+      if (root_of_node[node] < 0) continue;
+      const int32_t group = group_of_root[root_of_node[node]];
+      local_index[node] = next[group] - group_start[group];
+      grouped_nodes[next[group]++] = static_cast<NodeIndex>(node);
+    }
+  }
+  std::vector<int32_t>().swap(group_of_root);
+
+  std::vector<SccSubgraph> subgraphs(num_threads);
+  std::vector<StronglyConnectedComponentsFinder<
+      int32_t, SccSubgraph, SccRepresentativeOutput<NodeIndex>>>
+      finders(num_threads);
+  operations_research::ParallelForEachItem(
+      &thread_pool, num_threads, num_groups,
+      [&](int worker, int64_t group) {
+        const absl::Span<const NodeIndex> nodes =
+            absl::MakeConstSpan(grouped_nodes)
+                .subspan(group_start[group],
+                         group_start[group + 1] - group_start[group]);
+        if (nodes.size() == 1) {
+          representative[nodes[0]] = nodes[0];
+          return;
+        }
+        SccSubgraph& subgraph = subgraphs[worker];
+        subgraph.start.assign(1, 0);
+        subgraph.heads.clear();
+        const int32_t root = root_of_node[nodes[0]];
+        for (const NodeIndex node : nodes) {
+          for (const NodeIndex head : graph[node]) {
+            if (root_of_node[head] == root) {
+              subgraph.heads.push_back(local_index[head]);
+            }
+          }
+          subgraph.start.push_back(subgraph.heads.size());
+        }
+        SccRepresentativeOutput<NodeIndex> output{nodes, representative};
+        finders[worker].FindStronglyConnectedComponents(
+            static_cast<int32_t>(nodes.size()), subgraph, &output);
+      });
+}
+
+}  // namespace internal
+
+template <typename NodeIndex, typename Graph, typename SccOutput>
+void FindStronglyConnectedComponentsInParallel(const NodeIndex num_nodes,
+                                               const Graph& graph,
+                                               SccOutput* components,
+                                               int num_threads) {
+  CHECK_GE(num_threads, 1);
+  CHECK_LE(static_cast<int64_t>(num_nodes),
+           std::numeric_limits<int32_t>::max());
+  const int64_t n = num_nodes;
+  // representative[node] is a node of the component of `node`, the same for
+  // all of them.
+  std::vector<NodeIndex> representative(n);
+  if (num_threads == 1) {
+    internal::SccRepresentativeOutput<NodeIndex> output{
+        {}, absl::MakeSpan(representative)};
+    FindStronglyConnectedComponents(num_nodes, graph, &output);
+  } else {
+    internal::FindSccRepresentativesInParallel(num_nodes, graph, num_threads,
+                                               absl::MakeSpan(representative));
+  }
+
+  // Output the components by increasing smallest node, with a counting sort.
+  std::vector<NodeIndex> component_of_representative(n, num_nodes);
+  std::vector<int64_t> component_start;
+  for (int64_t node = 0; node < n; ++node) {
+    NodeIndex& component = component_of_representative[representative[node]];
+    if (component == num_nodes) {
+      component = static_cast<NodeIndex>(component_start.size());
+      component_start.push_back(0);
+    }
+    ++component_start[component];
+  }
+  int64_t num_sorted_nodes = 0;
+  for (int64_t& start : component_start) {
+    num_sorted_nodes += start;
+    start = num_sorted_nodes - start;
+  }
+  component_start.push_back(num_sorted_nodes);
+  std::vector<NodeIndex> sorted_nodes(n);
+  {
+    std::vector<int64_t> next(component_start.begin(),
+                              component_start.end() - 1);
+    for (int64_t node = 0; node < n; ++node) {
+      sorted_nodes[next[component_of_representative[representative[node]]]++] =
+          static_cast<NodeIndex>(node);
+    }
+  }
+  for (int64_t c = 0; c + 1 < component_start.size(); ++c) {
+    components->emplace_back(sorted_nodes.data() + component_start[c],
+                             sorted_nodes.data() + component_start[c + 1]);
+  }
+}
+
 #endif  // UTIL_GRAPH_STRONGLY_CONNECTED_COMPONENTS_H_
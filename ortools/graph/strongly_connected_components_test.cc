@@ -0,0 +1,113 @@
+// Copyright 2010-2024 Google LLC
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "ortools/graph/strongly_connected_components.h"
+
+#include <algorithm>
+#include <random>
+#include <vector>
+
+#include "absl/random/distributions.h"
+#include "gtest/gtest.h"
+#include "ortools/base/gmock.h"
+#include "ortools/graph/graph.h"
+
+namespace {
+
+using ::testing::ElementsAre;
+
+// The components of the sequential algorithm, in the order of the parallel
+// one.
+std::vector<std::vector<int>> SortedComponents(
+    const std::vector<std::vector<int>>& graph) {
+  std::vector<std::vector<int>> components;
+  FindStronglyConnectedComponents(static_cast<int>(graph.size()), graph,
+                                  &components);
+  for (std::vector<int>& component : components) {
+    std::sort(component.begin(), component.end());
+  }
+  std::sort(components.begin(), components.end());
+  return components;
+}
+
+TEST(FindStronglyConnectedComponentsInParallelTest, SmallGraph) {
+  // 0 <-> 1 -> 2 <-> 3 -> 4 (with a self-loop), 5 isolated.
+  const std::vector<std::vector<int>> graph = {{1}, {0, 2}, {3}, {2, 4},
+                                               {4}, {}};
+  std::vector<std::vector<int>> components;
+  FindStronglyConnectedComponentsInParallel(6, graph, &components,
+                                            /*num_threads=*/2);
+  EXPECT_THAT(components, ElementsAre(ElementsAre(0, 1), ElementsAre(2, 3),
+                                      ElementsAre(4), ElementsAre(5)));
+  SccCounterOutput<int> counter;
+  FindStronglyConnectedComponentsInParallel(6, graph, &counter,
+                                            /*num_threads=*/2);
+  EXPECT_EQ(counter.size(), 4);
+}
+
+TEST(FindStronglyConnectedComponentsInParallelTest, EmptyGraph) {
+  std::vector<std::vector<int>> components;
+  FindStronglyConnectedComponentsInParallel(
+      0, std::vector<std::vector<int>>(), &components, /*num_threads=*/2);
+  EXPECT_TRUE(components.empty());
+}
+
+class FindStronglyConnectedComponentsInParallelRandomTest
+    : public ::testing::TestWithParam<int> {};
+
+TEST_P(FindStronglyConnectedComponentsInParallelRandomTest,
+       MatchesSequentialVersion) {
+  const int num_threads = GetParam();
+  std::mt19937 random(1234);
+  // From a forest of small components to a giant one, with many small ones
+  // hanging around it in both directions.
+  for (const double arcs_per_node : {0.5, 1.0, 1.5, 3.0}) {
+    for (const int num_nodes : {1, 10, 100, 5000, 30000}) {
+      std::vector<std::vector<int>> graph(num_nodes);
+      for (int i = 0; i < num_nodes * arcs_per_node; ++i) {
+        graph[absl::Uniform(random, 0, num_nodes)].push_back(
+            absl::Uniform(random, 0, num_nodes));
+      }
+      std::vector<std::vector<int>> components;
+      FindStronglyConnectedComponentsInParallel(num_nodes, graph, &components,
+                                                num_threads);
+      ASSERT_EQ(components, SortedComponents(graph))
+          << "num_nodes=" << num_nodes << " arcs_per_node=" << arcs_per_node;
+    }
+  }
+}
+
+TEST_P(FindStronglyConnectedComponentsInParallelRandomTest, StaticGraph) {
+  const int num_threads = GetParam();
+  std::mt19937 random(42);
+  const int num_nodes = 20000;
+  util::StaticGraph<> graph(num_nodes, 2 * num_nodes);
+  std::vector<std::vector<int>> adjacency_lists(num_nodes);
+  for (int i = 0; i < 2 * num_nodes; ++i) {
+    const int tail = absl::Uniform(random, 0, num_nodes);
+    const int head = absl::Uniform(random, 0, num_nodes);
+    graph.AddArc(tail, head);
+    adjacency_lists[tail].push_back(head);
+  }
+  graph.Build();
+  std::vector<std::vector<int>> components;
+  FindStronglyConnectedComponentsInParallel(num_nodes, graph, &components,
+                                            num_threads);
+  EXPECT_EQ(components, SortedComponents(adjacency_lists));
+}
+
+INSTANTIATE_TEST_SUITE_P(NumThreads,
+                         FindStronglyConnectedComponentsInParallelRandomTest,
+                         ::testing::Values(1, 2, 4));
+
+}  // namespace
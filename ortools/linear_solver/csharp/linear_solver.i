@@ -170,6 +170,7 @@ CONVERT_VECTOR(operations_research::MPVariable, MPVariable)
     const std::vector<operations_research::MPVariable*>&,
     const std::vector<double>&);
 %unignore operations_research::MPSolver::SetNumThreads;
+%unignore operations_research::MPSolver::SolutionValues;
 %extend operations_research::MPSolver {
   std::string ExportModelAsLpFormat(bool obfuscated) {
     operations_research::MPModelExportOptions options;
@@ -204,6 +205,18 @@ CONVERT_VECTOR(operations_research::MPVariable, MPVariable)
   bool SetNumThreads(int num_theads) {
     return $self->SetNumThreads(num_theads).ok();
   }
+
+  // Returns the solution values of all the variables, in the order of
+  // variables(), in a single call.
+  std::vector<double> SolutionValues() const {
+    std::vector<double> values;
+    values.reserve($self->NumVariables());
+    for (const operations_research::MPVariable* const var :
+         $self->variables()) {
+      values.push_back(var->solution_value());
+    }
+    return values;
+  }
 }
 
 // MPVariable: writer API.
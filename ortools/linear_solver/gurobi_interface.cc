@@ -64,6 +64,7 @@
 #include "absl/strings/str_format.h"
 #include "absl/synchronization/mutex.h"
 #include "absl/time/time.h"
+#include "absl/types/span.h"
 #include "ortools/base/logging.h"
 #include "ortools/base/timer.h"
 #include "ortools/gurobi/environment.h"
@@ -250,6 +251,15 @@ class GurobiInterface : public MPSolverInterface {
 
   void CheckedGurobiCall(int err) const;
 
+  // Appends a linear constraint to the batch of ExtractNewConstraints().
+  void AddConstraintToBatch(const MPConstraint& ct,
+                            absl::Span<const int> grb_vars,
+                            absl::Span<const double> coefs, char sense,
+                            double rhs);
+  // Adds the batched linear constraints to Gurobi with a single
+  // GRBaddconstrs() call, and clears the batch.
+  void FlushConstraintBatch();
+
   int SolutionCount() const;
 
   GRBmodel* model_;
@@ -281,6 +291,17 @@ class GurobiInterface : public MPSolverInterface {
   // See the implementation note at the top of file on incrementalism.
   bool had_nonincremental_change_ = false;
 
+  // The linear constraints batched by ExtractNewConstraints(), in the format of
+  // GRBaddconstrs(). The buffers are kept to be reused by the next
+  // extractions. All the constraints of a batch are either named or unnamed.
+  std::vector<int> batch_starts_;
+  std::vector<int> batch_vars_;
+  std::vector<double> batch_coefs_;
+  std::vector<char> batch_senses_;
+  std::vector<double> batch_rhs_;
+  std::vector<char*> batch_names_;
+  bool batch_is_named_ = false;
+
   // Mutex is held to prevent InterruptSolve() to call GRBterminate() when
   // model_ is not completely built. It also prevents model_ to be changed
   // during the execution of GRBterminate().
@@ -985,18 +1006,55 @@ void GurobiInterface::ExtractNewVariables() {
   DCHECK_EQ(GetIntAttr(GRB_INT_ATTR_NUMVARS), num_gurobi_vars_);
 }
 
+void GurobiInterface::AddConstraintToBatch(const MPConstraint& ct,
+                                           absl::Span<const int> grb_vars,
+                                           absl::Span<const double> coefs,
+                                           const char sense, const double rhs) {
+  const bool is_named = !ct.name().empty();
+  if (!batch_senses_.empty() &&
+      (is_named != batch_is_named_ ||
+       batch_vars_.size() + grb_vars.size() >
+           static_cast<size_t>(std::numeric_limits<int>::max()))) {
+    FlushConstraintBatch();
+  }
+  batch_is_named_ = is_named;
+  batch_starts_.push_back(batch_vars_.size());
+  batch_vars_.insert(batch_vars_.end(), grb_vars.begin(), grb_vars.end());
+  batch_coefs_.insert(batch_coefs_.end(), coefs.begin(), coefs.end());
+  batch_senses_.push_back(sense);
+  batch_rhs_.push_back(rhs);
+  batch_names_.push_back(const_cast<char*>(ct.name().c_str()));
+  mp_cons_to_gurobi_linear_cons_.push_back(num_gurobi_linear_cons_++);
+}
+
+void GurobiInterface::FlushConstraintBatch() {
+  if (batch_senses_.empty()) return;
+  CheckedGurobiCall(GRBaddconstrs(
+      model_, batch_senses_.size(), batch_vars_.size(), batch_starts_.data(),
+      batch_vars_.data(), batch_coefs_.data(), batch_senses_.data(),
+      batch_rhs_.data(), batch_is_named_ ? batch_names_.data() : nullptr));
+  batch_starts_.clear();
+  batch_vars_.clear();
+  batch_coefs_.clear();
+  batch_senses_.clear();
+  batch_rhs_.clear();
+  batch_names_.clear();
+}
+
 void GurobiInterface::ExtractNewConstraints() {
   int total_num_rows = solver_->constraints_.size();
   if (last_constraint_index_ < total_num_rows) {
-    // Add each new constraint.
+    // Add each new constraint. The linear constraints are added by batches
+    // with GRBaddconstrs(), which is much faster than one GRBaddconstr() call
+    // per constraint on large models.
+    std::vector<int> grb_vars;
+    std::vector<double> coefs;
     for (int row = last_constraint_index_; row < total_num_rows; ++row) {
       MPConstraint* const ct = solver_->constraints_[row];
       set_constraint_as_extracted(row, true);
       const int size = ct->coefficients_.size();
-      std::vector<int> grb_vars;
-      std::vector<double> coefs;
-      grb_vars.reserve(size);
-      coefs.reserve(size);
+      grb_vars.clear();
+      coefs.clear();
       for (const auto& entry : ct->coefficients_) {
         const int var_index = entry.first->index();
         CHECK(variable_is_extracted(var_index));
@@ -1025,28 +1083,27 @@ void GurobiInterface::ExtractNewConstraints() {
         // Using GRBaddrangeconstr for constraints that don't require it adds
         // a slack which is not always removed by presolve.
         if (ct->lb() == ct->ub()) {
-          CheckedGurobiCall(GRBaddconstr(model_, size, grb_vars.data(),
-                                         coefs.data(), GRB_EQUAL, ct->lb(),
-                                         name));
+          AddConstraintToBatch(*ct, grb_vars, coefs, GRB_EQUAL, ct->lb());
         } else if (ct->lb() == -std::numeric_limits<double>::infinity()) {
-          CheckedGurobiCall(GRBaddconstr(model_, size, grb_vars.data(),
-                                         coefs.data(), GRB_LESS_EQUAL, ct->ub(),
-                                         name));
+          AddConstraintToBatch(*ct, grb_vars, coefs, GRB_LESS_EQUAL, ct->ub());
         } else if (ct->ub() == std::numeric_limits<double>::infinity()) {
-          CheckedGurobiCall(GRBaddconstr(model_, size, grb_vars.data(),
-                                         coefs.data(), GRB_GREATER_EQUAL,
-                                         ct->lb(), name));
+          AddConstraintToBatch(*ct, grb_vars, coefs, GRB_GREATER_EQUAL,
+                               ct->lb());
         } else {
+          // The batched constraints must be added first to keep the order of
+          // the Gurobi constraints.
+          FlushConstraintBatch();
           CheckedGurobiCall(GRBaddrangeconstr(model_, size, grb_vars.data(),
                                               coefs.data(), ct->lb(), ct->ub(),
                                               name));
           // NOTE(user): range constraints implicitly add an extra variable
           // to the model.
           num_gurobi_vars_++;
+          mp_cons_to_gurobi_linear_cons_.push_back(num_gurobi_linear_cons_++);
         }
-        mp_cons_to_gurobi_linear_cons_.push_back(num_gurobi_linear_cons_++);
       }
     }
+    FlushConstraintBatch();
   }
   CheckedGurobiCall(GRBupdatemodel(model_));
   DCHECK_EQ(GetIntAttr(GRB_INT_ATTR_NUMCONSTRS), num_gurobi_linear_cons_);
@@ -121,6 +121,11 @@ public final class LinearSolverTest {
       assertEquals(66.666667, x2.solutionValue(), NUM_TOLERANCE);
       assertEquals(0, x3.solutionValue(), NUM_TOLERANCE);
     }
+    final double[] values = solver.solutionValues();
+    assertEquals(3, values.length);
+    assertEquals(x1.solutionValue(), values[0], NUM_TOLERANCE);
+    assertEquals(x2.solutionValue(), values[1], NUM_TOLERANCE);
+    assertEquals(x3.solutionValue(), values[2], NUM_TOLERANCE);
   }
 
   @Test
@@ -240,6 +240,20 @@ PROTO2_RETURN(
   bool setNumThreads(int num_theads) {
     return $self->SetNumThreads(num_theads).ok();
   }
+
+  /**
+   * Returns the solution values of all the variables, in the order of
+   * variables(), in a single call.
+   */
+  std::vector<double> solutionValues() const {
+    std::vector<double> values;
+    values.reserve($self->NumVariables());
+    for (const operations_research::MPVariable* const var :
+         $self->variables()) {
+      values.push_back(var->solution_value());
+    }
+    return values;
+  }
 }  // Extend operations_research::MPSolver
 
 // Add java code on MPSolver.
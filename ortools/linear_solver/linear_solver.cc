@@ -871,6 +871,7 @@ MPSolverResponseStatus MPSolver::LoadModelFromProtoInternal(
         MakeRowConstraint(ct_proto.lower_bound(), ct_proto.upper_bound(),
                           clear_names ? empty : ct_proto.name());
     ct->set_is_lazy(ct_proto.is_lazy());
+    ct->coefficients_.reserve(ct_proto.var_index_size());
     for (int j = 0; j < ct_proto.var_index_size(); ++j) {
       ct->SetCoefficient(variables_[ct_proto.var_index(j)],
                          ct_proto.coefficient(j));
@@ -1510,6 +1511,44 @@ MPConstraint* MPSolver::MakeRowConstraint(const LinearRange& range,
   return constraint;
 }
 
+void MPSolver::MakeRowConstraints(absl::Span<const double> lower_bounds,
+                                  absl::Span<const double> upper_bounds,
+                                  absl::Span<const int64_t> row_starts,
+                                  absl::Span<const int> variable_indices,
+                                  absl::Span<const double> coefficients,
+                                  std::vector<MPConstraint*>* constraints) {
+  const int num_rows = lower_bounds.size();
+  CHECK_EQ(upper_bounds.size(), num_rows);
+  CHECK_EQ(row_starts.size(), num_rows + 1);
+  CHECK_EQ(row_starts.front(), 0);
+  CHECK_EQ(row_starts.back(), variable_indices.size());
+  CHECK_EQ(coefficients.size(), variable_indices.size());
+  constraints_.reserve(constraints_.size() + num_rows);
+  constraint_is_extracted_.reserve(constraint_is_extracted_.size() + num_rows);
+  if (constraints != nullptr) {
+    constraints->reserve(constraints->size() + num_rows);
+  }
+  for (int row = 0; row < num_rows; ++row) {
+    MPConstraint* const ct =
+        MakeRowConstraint(lower_bounds[row], upper_bounds[row]);
+    const int64_t start = row_starts[row];
+    const int64_t end = row_starts[row + 1];
+    CHECK_LE(start, end);
+    ct->coefficients_.reserve(end - start);
+    for (int64_t k = start; k < end; ++k) {
+      if (coefficients[k] == 0.0) continue;
+      const int var_index = variable_indices[k];
+      CHECK(var_index >= 0 && var_index < NumVariables()) << var_index;
+      const MPVariable* const var = variables_[var_index];
+      double& coeff = ct->coefficients_[var];
+      const double old_value = coeff;
+      coeff += coefficients[k];
+      interface_->SetCoefficient(ct, var, coeff, old_value);
+    }
+    if (constraints != nullptr) constraints->push_back(ct);
+  }
+}
+
 int MPSolver::ComputeMaxConstraintSize(int min_constraint_index,
                                        int max_constraint_index) const {
   int max_constraint_size = 0;
@@ -159,6 +159,7 @@
 #include "absl/time/clock.h"
 #include "absl/time/time.h"
 #include "absl/types/optional.h"
+#include "absl/types/span.h"
 #include "ortools/base/logging.h"
 #include "ortools/linear_solver/linear_expr.h"
 #include "ortools/linear_solver/linear_solver.pb.h"
@@ -444,6 +445,36 @@ class MPSolver {
   MPConstraint* MakeRowConstraint(const LinearRange& range,
                                   const std::string& name);
 
+#ifndef SWIG
+  /**
+   * Creates lower_bounds.size() constraints from their rows in the compressed
+   * sparse row (CSR) format. The i-th constraint enforces:
+   *     lower_bounds[i]
+   *         <= sum_k coefficients[k] * variable(variable_indices[k])
+   *         <= upper_bounds[i]
+   * for k in [row_starts[i], row_starts[i + 1]).
+   *
+   * row_starts must have lower_bounds.size() + 1 elements, from 0 to
+   * variable_indices.size(). The coefficients of a variable appearing several
+   * times in a row are summed, and the zero coefficients are skipped. The
+   * constraints get the default names.
+   *
+   * This is faster than MakeRowConstraint() followed by SetCoefficient() for
+   * each term: the coefficients of each row are inserted in one pass, in a map
+   * reserved for their number, which also avoids the memory left by the
+   * growth of the maps.
+   *
+   * @param[out] constraints if not nullptr, the vector to which the created
+   * constraints are appended.
+   */
+  void MakeRowConstraints(absl::Span<const double> lower_bounds,
+                          absl::Span<const double> upper_bounds,
+                          absl::Span<const int64_t> row_starts,
+                          absl::Span<const int> variable_indices,
+                          absl::Span<const double> coefficients,
+                          std::vector<MPConstraint*>* constraints = nullptr);
+#endif  // SWIG
+
   /**
    * Returns the objective object.
    *
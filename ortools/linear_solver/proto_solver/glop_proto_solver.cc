@@ -171,7 +171,14 @@ MPSolutionResponse GlopSolveProto(
     }
 
     // Convert and clear the request and mp_model as it is no longer needed.
-    MPModelProtoToLinearProgram(mp_model, &linear_program);
+    // When the model was moved in, its constraints are released during the
+    // conversion.
+    if (optional_model->has_ownership()) {
+      MPModelProtoToLinearProgram(std::move(*optional_model->get_mutable()),
+                                  &linear_program);
+    } else {
+      MPModelProtoToLinearProgram(mp_model, &linear_program);
+    }
     std::move(request).dispose();
   }
 
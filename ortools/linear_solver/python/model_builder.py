@@ -37,7 +37,7 @@ import dataclasses
 import math
 import numbers
 import typing
-from typing import Callable, List, Optional, Sequence, Tuple, Union, cast
+from typing import Any, Callable, List, Optional, Sequence, Tuple, Union, cast
 
 import numpy as np
 from numpy import typing as npt
@@ -1216,21 +1216,54 @@ class Model:
         lower_bounds = _convert_to_series_and_validate_index(lower_bounds, index)
         upper_bounds = _convert_to_series_and_validate_index(upper_bounds, index)
         is_integrals = _convert_to_series_and_validate_index(is_integral, index)
+        # The variables are created in bulk in C++, from contiguous buffers.
+        var_indices = self.__helper.add_var_array_with_bounds(
+            lower_bounds.to_numpy(dtype=np.double),
+            upper_bounds.to_numpy(dtype=np.double),
+            is_integrals.to_numpy(dtype=bool),
+            "",
+        )
+        self.__helper.set_var_names(var_indices, [f"{name}[{i}]" for i in index])
         return pd.Series(
             index=index,
             data=[
-                # pylint: disable=g-complex-comprehension
-                Variable(
-                    helper=self.__helper,
-                    name=f"{name}[{i}]",
-                    lb=lower_bounds[i],
-                    ub=upper_bounds[i],
-                    is_integral=is_integrals[i],
-                )
-                for i in index
+                Variable(self.__helper, var_index, None, None, None)
+                for var_index in var_indices.tolist()
             ],
         )
 
+    def add_linear_constraints(
+        self,
+        constraint_matrix: Any,
+        lower_bounds: npt.ArrayLike,
+        upper_bounds: npt.ArrayLike,
+    ) -> np.ndarray:
+        """Adds the constraints `lower_bounds <= A @ x <= upper_bounds` in bulk.
+
+        The constraints are added in C++ in one call, without creating any
+        Python expression.
+
+        Args:
+          constraint_matrix: The matrix `A`, as a `scipy.sparse.csr_matrix` (or
+            any sparse matrix convertible to it). Its columns are the indices of
+            the variables in the model, as given by `Variable.index`.
+          lower_bounds: The lower bounds of the constraints, one per row of `A`.
+          upper_bounds: The upper bounds of the constraints, one per row of `A`.
+
+        Returns:
+          np.ndarray: The indices of the new constraints in the model. They can be
+          wrapped with linear_constraint_from_index().
+
+        Raises:
+          RuntimeError: if the sizes do not match, or if `A` has more columns
+          than the model has variables.
+        """
+        return self.__helper.add_linear_constraints(
+            constraint_matrix,
+            np.asarray(lower_bounds, dtype=np.double),
+            np.asarray(upper_bounds, dtype=np.double),
+        )
+
     def new_num_var_series(
         self,
         name: str,
@@ -1716,8 +1749,8 @@ class Solver:
         """
         if not self.__solve_helper.has_solution():
             return _attribute_series(func=lambda v: pd.NA, values=variables)
-        return _attribute_series(
-            func=lambda v: self.__solve_helper.var_value(v.index),
+        return _gathered_series(
+            array=self.__solve_helper.variable_values(),
             values=variables,
         )
 
@@ -1738,8 +1771,8 @@ class Solver:
         """
         if not self.__solve_helper.has_solution():
             return _attribute_series(func=lambda v: pd.NA, values=variables)
-        return _attribute_series(
-            func=lambda v: self.__solve_helper.reduced_cost(v.index),
+        return _gathered_series(
+            array=self.__solve_helper.reduced_costs(),
             values=variables,
         )
 
@@ -1766,8 +1799,8 @@ class Solver:
         """
         if not self.__solve_helper.has_solution():
             return _attribute_series(func=lambda v: pd.NA, values=constraints)
-        return _attribute_series(
-            func=lambda v: self.__solve_helper.dual_value(v.index),
+        return _gathered_series(
+            array=self.__solve_helper.dual_values(),
             values=constraints,
         )
 
@@ -1999,6 +2032,23 @@ def _attribute_series(
     )
 
 
+def _gathered_series(*, array: np.ndarray, values: _IndexOrSeries) -> pd.Series:
+    """Returns the elements of `array` at the indices of `values`.
+
+    Args:
+      array: The array of an attribute of all the variables or constraints, as
+        returned by the solve helper in one call.
+      values: The variables or constraints to get the attribute of.
+
+    Returns:
+      pd.Series: The attribute values.
+    """
+    return pd.Series(
+        data=array[np.fromiter((v.index for v in values), dtype=np.int64)],
+        index=_get_index(values),
+    )
+
+
 def _convert_to_series_and_validate_index(
     value_or_series: Union[bool, NumberT, pd.Series], index: pd.Index
 ) -> pd.Series:
@@ -273,6 +273,16 @@ PYBIND11_MODULE(model_builder_helper, m) {
              }
              return result;
            })
+      .def("set_var_names",
+           [](ModelBuilderHelper* helper, const std::vector<int>& var_indices,
+              const std::vector<std::string>& names) {
+             if (var_indices.size() != names.size()) {
+               throw std::runtime_error("Input sizes must match");
+             }
+             for (int i = 0; i < var_indices.size(); ++i) {
+               helper->SetVarName(var_indices[i], names[i]);
+             }
+           })
       .def("set_var_lower_bound", &ModelBuilderHelper::SetVarLowerBound,
            arg("var_index"), arg("lb"))
       .def("set_var_upper_bound", &ModelBuilderHelper::SetVarUpperBound,
@@ -302,6 +312,48 @@ PYBIND11_MODULE(model_builder_helper, m) {
            &ModelBuilderHelper::VarObjectiveCoefficient, arg("var_index"))
       .def("var_name", &ModelBuilderHelper::VarName, arg("var_index"))
       .def("add_linear_constraint", &ModelBuilderHelper::AddLinearConstraint)
+      .def(
+          "add_linear_constraints",
+          [](ModelBuilderHelper* helper,
+             const SparseMatrix<double, Eigen::RowMajor>& constraint_matrix,
+             const Eigen::Ref<const VectorXd>& lower_bounds,
+             const Eigen::Ref<const VectorXd>& upper_bounds) {
+            const int num_constraints = constraint_matrix.rows();
+            if (lower_bounds.size() != num_constraints ||
+                upper_bounds.size() != num_constraints) {
+              throw std::runtime_error(
+                  "The bounds must have one value per row of the matrix");
+            }
+            MPModelProto* model = helper->mutable_model();
+            if (constraint_matrix.cols() > model->variable_size()) {
+              throw std::runtime_error(
+                  "The matrix has more columns than the model has variables");
+            }
+            py::array_t<int> result(num_constraints);
+            py::buffer_info result_info = result.request();
+            auto ptr = static_cast<int*>(result_info.ptr);
+            model->mutable_constraint()->Reserve(model->constraint_size() +
+                                                 num_constraints);
+            for (int row = 0; row < num_constraints; ++row) {
+              ptr[row] = model->constraint_size();
+              MPConstraintProto* ct = model->add_constraint();
+              ct->set_lower_bound(lower_bounds[row]);
+              ct->set_upper_bound(upper_bounds[row]);
+              const int num_terms = constraint_matrix.outerIndexPtr()[row + 1] -
+                                    constraint_matrix.outerIndexPtr()[row];
+              ct->mutable_var_index()->Reserve(num_terms);
+              ct->mutable_coefficient()->Reserve(num_terms);
+              for (SparseMatrix<double, Eigen::RowMajor>::InnerIterator it(
+                       constraint_matrix, row);
+                   it; ++it) {
+                if (it.value() == 0.0) continue;
+                ct->add_var_index(it.col());
+                ct->add_coefficient(it.value());
+              }
+            }
+            return result;
+          },
+          arg("constraint_matrix"), arg("lower_bounds"), arg("upper_bounds"))
       .def("set_constraint_lower_bound",
            &ModelBuilderHelper::SetConstraintLowerBound, arg("ct_index"),
            arg("lb"))
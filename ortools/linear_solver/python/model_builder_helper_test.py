@@ -209,6 +209,38 @@ class PywrapModelBuilderHelperTest(absltest.TestCase):
         model.set_constraint_coefficient(0, var_index2, 7.0)
         self.assertEqual([1.0, 3.0, 7.0, 6.0], model.constraint_coefficients(0))
 
+    def test_add_linear_constraints(self):
+        model = model_builder_helper.ModelBuilderHelper()
+        var_array = model.add_var_array_with_bounds(
+            np.array([0.0, 0.0, 0.0]),
+            np.array([1.0, 2.0, 3.0]),
+            np.array([False, False, True]),
+            "",
+        )
+        model.set_var_names(var_array, ["x", "y", "z"])
+        self.assertEqual("y", model.var_name(1))
+
+        model.add_linear_constraint()
+        constraint_matrix = sparse.csr_matrix(
+            np.array([[1.0, 0.0, 2.0], [0.0, 3.0, 4.0]])
+        )
+        ct_array = model.add_linear_constraints(
+            constraint_matrix, np.array([-1.0, -2.0]), np.array([1.0, 2.0])
+        )
+        self.assertEqual([1, 2], ct_array.tolist())
+        self.assertEqual(3, model.num_constraints())
+        self.assertEqual([0, 2], model.constraint_var_indices(1))
+        self.assertEqual([1.0, 2.0], model.constraint_coefficients(1))
+        self.assertEqual([1, 2], model.constraint_var_indices(2))
+        self.assertEqual([3.0, 4.0], model.constraint_coefficients(2))
+        self.assertEqual(-2.0, model.constraint_lower_bound(2))
+        self.assertEqual(2.0, model.constraint_upper_bound(2))
+
+        with self.assertRaises(RuntimeError):
+            model.add_linear_constraints(
+                constraint_matrix, np.array([-1.0]), np.array([1.0])
+            )
+
 
 if __name__ == "__main__":
     absltest.main()
@@ -13,10 +13,15 @@
 
 #include "ortools/linear_solver/solve_mp_model.h"
 
+#include <algorithm>
 #include <atomic>
+#include <memory>
+#include <optional>
 #include <string>
 #include <utility>
 
+#include "absl/synchronization/mutex.h"
+#include "ortools/base/threadpool.h"
 #include "ortools/linear_solver/linear_solver.h"
 #include "ortools/linear_solver/linear_solver.pb.h"
 #include "ortools/util/lazy_mutable_copy.h"
@@ -49,4 +54,93 @@ std::string MPModelRequestLoggingInfo(const MPModelRequest& request) {
   return MPSolver::GetMPModelRequestLoggingInfo(request);
 }
 
+bool MPModelSolveHandle::IsDone() const {
+  const absl::MutexLock lock(&mutex_);
+  return done_;
+}
+
+const MPSolutionResponse& MPModelSolveHandle::response() const {
+  const absl::MutexLock lock(&mutex_);
+  mutex_.Await(absl::Condition(&done_));
+  return response_;
+}
+
+MPModelSolveExecutor::MPModelSolveExecutor(const int num_threads)
+    : num_threads_(std::max(1, num_threads)),
+      num_available_threads_(num_threads_),
+      pool_(num_threads_) {
+  pool_.StartWorkers();
+}
+
+MPModelSolveExecutor::~MPModelSolveExecutor() {
+  const absl::MutexLock lock(&mutex_);
+  const auto all_done = [this]() ABSL_EXCLUSIVE_LOCKS_REQUIRED(mutex_) {
+    return pending_.empty() && num_running_solves_ == 0;
+  };
+  mutex_.Await(absl::Condition(&all_done));
+}
+
+std::shared_ptr<MPModelSolveHandle> MPModelSolveExecutor::SolveAsync(
+    LazyMutableCopy<MPModelRequest> request, const int num_threads,
+    const SolveInterrupter* const interrupter) {
+  auto solve = std::make_shared<Solve>();
+  solve->request = std::move(request).copy_or_move_as_unique_ptr();
+  solve->num_threads = std::clamp(num_threads, 1, num_threads_);
+  solve->interrupter = interrupter;
+  solve->handle = std::make_shared<MPModelSolveHandle>();
+  std::shared_ptr<MPModelSolveHandle> handle = solve->handle;
+  const absl::MutexLock lock(&mutex_);
+  pending_.push_back(std::move(solve));
+  StartSolves();
+  return handle;
+}
+
+void MPModelSolveExecutor::StartSolves() {
+  while (!pending_.empty() &&
+         pending_.front()->num_threads <= num_available_threads_) {
+    std::shared_ptr<Solve> solve = std::move(pending_.front());
+    pending_.pop_front();
+    num_available_threads_ -= solve->num_threads;
+    ++num_running_solves_;
+    pool_.Schedule([this, solve]() { Run(*solve); });
+  }
+}
+
+void MPModelSolveExecutor::Run(Solve& solve) {
+  MPModelSolveHandle& handle = *solve.handle;
+  MPSolutionResponse response;
+  {
+    // Forwards the interruption of the user interrupter to the one of the
+    // handle.
+    std::optional<ScopedSolveInterrupterCallback> forward_interruption;
+    if (solve.interrupter != nullptr) {
+      forward_interruption.emplace(solve.interrupter, [&handle]() {
+        handle.interrupter_.Interrupt();
+      });
+    }
+    if (handle.interrupter_.IsInterrupted()) {
+      response.set_status(MPSOLVER_CANCELLED_BY_USER);
+      response.set_status_str("Solve cancelled before it started");
+    } else {
+      // SolveMPModel() rejects an interrupter for the solvers that don't
+      // support it.
+      const bool supports_interruption =
+          SolverTypeSupportsInterruption(solve.request->solver_type());
+      response = SolveMPModel(
+          std::move(*solve.request),
+          supports_interruption ? &handle.interrupter_ : nullptr);
+    }
+  }
+  solve.request.reset();
+  {
+    const absl::MutexLock lock(&handle.mutex_);
+    handle.response_ = std::move(response);
+    handle.done_ = true;
+  }
+  const absl::MutexLock lock(&mutex_);
+  num_available_threads_ += solve.num_threads;
+  --num_running_solves_;
+  StartSolves();
+}
+
 }  // namespace operations_research
@@ -19,8 +19,13 @@
 #define OR_TOOLS_LINEAR_SOLVER_SOLVE_MP_MODEL_H_
 
 #include <atomic>
+#include <deque>
+#include <memory>
 #include <string>
 
+#include "absl/base/thread_annotations.h"
+#include "absl/synchronization/mutex.h"
+#include "ortools/base/threadpool.h"
 #include "ortools/linear_solver/linear_solver.pb.h"
 #include "ortools/util/lazy_mutable_copy.h"
 #include "ortools/util/solve_interrupter.h"
@@ -51,6 +56,100 @@ bool SolverTypeSupportsInterruption(MPModelRequest::SolverType solver);
 // the given request, suitable for debug logging.
 std::string MPModelRequestLoggingInfo(const MPModelRequest& request);
 
+// A solve scheduled on an MPModelSolveExecutor. Thread-safe.
+class MPModelSolveHandle {
+ public:
+  MPModelSolveHandle() = default;
+  MPModelSolveHandle(const MPModelSolveHandle&) = delete;
+  MPModelSolveHandle& operator=(const MPModelSolveHandle&) = delete;
+
+  // Cancels the solve if it has not started yet, its response then having the
+  // MPSOLVER_CANCELLED_BY_USER status. Else interrupts it, if
+  // SolverTypeSupportsInterruption() is true for its solver.
+  void Cancel() { interrupter_.Interrupt(); }
+
+  // Returns true if the solve is done, i.e. if response() doesn't block.
+  bool IsDone() const;
+
+  // Blocks until the solve is done and returns its response.
+  const MPSolutionResponse& response() const;
+
+ private:
+  friend class MPModelSolveExecutor;
+
+  SolveInterrupter interrupter_;
+  mutable absl::Mutex mutex_;
+  bool done_ ABSL_GUARDED_BY(mutex_) = false;
+  MPSolutionResponse response_ ABSL_GUARDED_BY(mutex_);
+};
+
+// Runs SolveMPModel() asynchronously, with a budget of threads shared by all
+// the running solves. This bounds the load of a server running many requests
+// concurrently: each solve is charged the number of threads it uses, and waits
+// until enough threads of the budget are available. The solves start in the
+// order they are scheduled.
+//
+// Usage:
+//   MPModelSolveExecutor executor(/*num_threads=*/16);
+//   std::vector<std::shared_ptr<MPModelSolveHandle>> solves;
+//   for (MPModelRequest& request : requests) {
+//     solves.push_back(executor.SolveAsync(std::move(request)));
+//   }
+//   for (const auto& solve : solves) {
+//     Process(solve->response());
+//   }
+//
+// Thread-safe.
+class MPModelSolveExecutor {
+ public:
+  explicit MPModelSolveExecutor(int num_threads);
+  MPModelSolveExecutor(const MPModelSolveExecutor&) = delete;
+  MPModelSolveExecutor& operator=(const MPModelSolveExecutor&) = delete;
+
+  // Waits until all the scheduled solves are done. The solves are not
+  // cancelled.
+  ~MPModelSolveExecutor();
+
+  // The budget of threads.
+  int num_threads() const { return num_threads_; }
+
+  // Schedules SolveMPModel(request). Contrary to SolveMPModel(), the request
+  // is copied if it is not moved in.
+  //
+  // `num_threads` is the number of threads used by the solve, usually set in
+  // the solver specific parameters of the request. It is clamped to
+  // [1, num_threads()].
+  //
+  // If `interrupter` is not nullptr, triggering it has the same effect as
+  // MPModelSolveHandle::Cancel(). It must outlive the solve.
+  std::shared_ptr<MPModelSolveHandle> SolveAsync(
+      LazyMutableCopy<MPModelRequest> request, int num_threads = 1,
+      const SolveInterrupter* interrupter = nullptr);
+
+ private:
+  struct Solve {
+    std::unique_ptr<MPModelRequest> request;
+    int num_threads = 1;
+    const SolveInterrupter* interrupter = nullptr;
+    std::shared_ptr<MPModelSolveHandle> handle;
+  };
+
+  // Starts the first pending solves, as long as their threads are available.
+  void StartSolves() ABSL_EXCLUSIVE_LOCKS_REQUIRED(mutex_);
+
+  // Runs a solve, on a thread of pool_.
+  void Run(Solve& solve);
+
+  const int num_threads_;
+  absl::Mutex mutex_;
+  std::deque<std::shared_ptr<Solve>> pending_ ABSL_GUARDED_BY(mutex_);
+  int num_available_threads_ ABSL_GUARDED_BY(mutex_);
+  int num_running_solves_ ABSL_GUARDED_BY(mutex_) = 0;
+  // Its number of workers is the budget of threads, each running solve using
+  // at least one thread: a scheduled task never waits for a worker.
+  ThreadPool pool_;
+};
+
 }  // namespace operations_research
 
 #endif  // OR_TOOLS_LINEAR_SOLVER_SOLVE_MP_MODEL_H_
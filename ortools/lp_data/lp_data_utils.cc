@@ -85,6 +85,7 @@ void LpScalingHelper::Scale(LinearProgram* lp) { Scale(GlopParameters(), lp); }
 
 void LpScalingHelper::Scale(const GlopParameters& params, LinearProgram* lp) {
   scaler_.Clear();
+  scaler_.set_num_threads(params.num_omp_threads());
   ::operations_research::glop::Scale(lp, &scaler_, params.scaling_method());
   bound_scaling_factor_ = 1.0 / lp->ScaleBounds();
   objective_scaling_factor_ = 1.0 / lp->ScaleObjective(params.cost_scaling());
@@ -24,7 +24,6 @@
 #include "ortools/lp_data/lp_types.h"
 #include "ortools/lp_data/sparse.h"
 #include "ortools/lp_data/sparse_column.h"
-#include "ortools/util/bitset.h"
 
 namespace operations_research {
 namespace glop {
@@ -33,12 +32,13 @@ namespace glop {
 // LPDecomposer
 //------------------------------------------------------------------------------
 LPDecomposer::LPDecomposer()
-    : original_problem_(nullptr), clusters_(), mutex_() {}
+    : original_problem_(nullptr), clusters_(), row_clusters_(), mutex_() {}
 
 void LPDecomposer::Decompose(const LinearProgram* linear_problem) {
   absl::MutexLock mutex_lock(&mutex_);
   original_problem_ = linear_problem;
   clusters_.clear();
+  row_clusters_.clear();
 
   const SparseMatrix& transposed_matrix =
       original_problem_->GetTransposeSparseMatrix();
@@ -66,6 +66,15 @@ void LPDecomposer::Decompose(const LinearProgram* linear_problem) {
   for (int i = 0; i < num_classes; ++i) {
     std::sort(clusters_[i].begin(), clusters_[i].end());
   }
+
+  // All the variables of a constraint are in the same cluster.
+  row_clusters_.resize(num_classes);
+  for (ColIndex ct(0); ct < num_ct; ++ct) {
+    const SparseColumn& sparse_constraint = transposed_matrix.column(ct);
+    if (sparse_constraint.IsEmpty()) continue;
+    const int cluster = classes[sparse_constraint.GetFirstRow().value()];
+    row_clusters_[cluster].push_back(ColToRowIndex(ct));
+  }
 }
 
 int LPDecomposer::GetNumberOfProblems() const {
@@ -89,12 +98,9 @@ void LPDecomposer::ExtractLocalProblem(int problem_index, LinearProgram* lp) {
   const std::vector<ColIndex>& cluster = clusters_[problem_index];
   StrictITIVector<ColIndex, ColIndex> global_to_local(
       original_problem_->num_variables(), kInvalidCol);
-  SparseBitset<RowIndex> constraints_to_use(
-      original_problem_->num_constraints());
   lp->SetMaximizationProblem(original_problem_->IsMaximizationProblem());
 
-  // Create variables and get all constraints of the cluster.
-  const SparseMatrix& original_matrix = original_problem_->GetSparseMatrix();
+  // Create variables.
   const SparseMatrix& transposed_matrix =
       original_problem_->GetTransposeSparseMatrix();
   for (int i = 0; i < cluster.size(); ++i) {
@@ -115,14 +121,9 @@ void LPDecomposer::ExtractLocalProblem(int problem_index, LinearProgram* lp) {
         original_problem_->variable_upper_bounds()[global_col]);
     lp->SetObjectiveCoefficient(
         local_col, original_problem_->objective_coefficients()[global_col]);
-
-    for (const SparseColumn::Entry e : original_matrix.column(global_col)) {
-      constraints_to_use.Set(e.row());
-    }
   }
   // Create the constraints.
-  for (const RowIndex global_row :
-       constraints_to_use.PositionsSetAtLeastOnce()) {
+  for (const RowIndex global_row : row_clusters_[problem_index]) {
     const RowIndex local_row = lp->CreateNewConstraint();
     lp->SetConstraintName(local_row,
                           original_problem_->GetConstraintName(global_row));
@@ -157,6 +158,39 @@ DenseRow LPDecomposer::AggregateAssignments(
   return global_assignment;
 }
 
+ProblemSolution LPDecomposer::AggregateSolutions(
+    absl::Span<const ProblemSolution> solutions) const {
+  CHECK_EQ(solutions.size(), clusters_.size());
+
+  absl::MutexLock mutex_lock(&mutex_);
+  ProblemSolution global_solution(original_problem_->num_constraints(),
+                                  original_problem_->num_variables());
+  global_solution.constraint_statuses.assign(
+      original_problem_->num_constraints(), ConstraintStatus::BASIC);
+  for (int problem = 0; problem < solutions.size(); ++problem) {
+    const ProblemSolution& local_solution = solutions[problem];
+    const std::vector<ColIndex>& cluster = clusters_[problem];
+    CHECK_EQ(local_solution.primal_values.size(), ColIndex(cluster.size()));
+    for (int i = 0; i < cluster.size(); ++i) {
+      const ColIndex global_col = cluster[i];
+      global_solution.primal_values[global_col] =
+          local_solution.primal_values[ColIndex(i)];
+      global_solution.variable_statuses[global_col] =
+          local_solution.variable_statuses[ColIndex(i)];
+    }
+    const std::vector<RowIndex>& row_cluster = row_clusters_[problem];
+    CHECK_EQ(local_solution.dual_values.size(), RowIndex(row_cluster.size()));
+    for (int i = 0; i < row_cluster.size(); ++i) {
+      const RowIndex global_row = row_cluster[i];
+      global_solution.dual_values[global_row] =
+          local_solution.dual_values[RowIndex(i)];
+      global_solution.constraint_statuses[global_row] =
+          local_solution.constraint_statuses[RowIndex(i)];
+    }
+  }
+  return global_solution;
+}
+
 DenseRow LPDecomposer::ExtractLocalAssignment(int problem_index,
                                               const DenseRow& assignment) {
   CHECK_GE(problem_index, 0);
@@ -85,10 +85,25 @@ class LPDecomposer {
   DenseRow ExtractLocalAssignment(int problem_index, const DenseRow& assignment)
       ABSL_LOCKS_EXCLUDED(mutex_);
 
+  // Returns a solution to the original problem based on the solutions of the
+  // independent problems: primal and dual values as well as the variable and
+  // constraint statuses. The empty constraints, which do not belong to any
+  // problem, are reported as basic with a zero dual value. The returned status
+  // is OPTIMAL, it is up to the caller to combine the statuses of the
+  // independent problems. Requires Decompose() to have been called.
+  ProblemSolution AggregateSolutions(
+      absl::Span<const ProblemSolution> solutions) const
+      ABSL_LOCKS_EXCLUDED(mutex_);
+
  private:
   const LinearProgram* original_problem_;
   std::vector<std::vector<ColIndex>> clusters_;
 
+  // The non-empty constraints of each independent problem, in increasing
+  // order. They are the constraints of the problems generated by
+  // ExtractLocalProblem().
+  std::vector<std::vector<RowIndex>> row_clusters_;
+
   mutable absl::Mutex mutex_;
 };
 
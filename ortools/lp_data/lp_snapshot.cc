@@ -0,0 +1,343 @@
+// Copyright 2010-2024 Google LLC
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "ortools/lp_data/lp_snapshot.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <string>
+#include <vector>
+
+#include "absl/log/check.h"
+#include "absl/status/status.h"
+#include "absl/status/statusor.h"
+#include "absl/strings/str_format.h"
+#include "absl/strings/string_view.h"
+#include "absl/types/span.h"
+#include "ortools/base/file.h"
+#include "ortools/base/status_macros.h"
+#include "ortools/lp_data/lp_data.h"
+#include "ortools/lp_data/lp_types.h"
+#include "ortools/lp_data/sparse_column.h"
+
+namespace operations_research {
+namespace glop {
+
+namespace {
+
+constexpr char kMagic[8] = {'G', 'L', 'O', 'P', 'S', 'N', 'A', 'P'};
+constexpr uint32_t kVersion = 1;
+constexpr uint32_t kByteOrderMark = 0x01020304;
+constexpr uint32_t kMaximizeFlag = 1;
+
+// All the arrays start at a multiple of this.
+constexpr size_t kAlignment = 8;
+
+struct SnapshotHeader {
+  char magic[8];
+  uint32_t version;
+  uint32_t byte_order_mark;
+  int64_t num_rows;
+  int64_t num_cols;
+  int64_t num_entries;
+  double objective_offset;
+  double objective_scaling_factor;
+  uint32_t flags;
+  uint32_t unused;
+
+  // Number of bytes in the string table.
+  int64_t names_size;
+};
+static_assert(sizeof(SnapshotHeader) % kAlignment == 0);
+
+// The string table contains the problem name, then the variable names and
+// then the constraint names. An empty name means the default one.
+int64_t NumNames(const SnapshotHeader& header) {
+  return 1 + header.num_cols + header.num_rows;
+}
+
+class SnapshotWriter {
+ public:
+  explicit SnapshotWriter(std::string* output) : output_(output) {}
+
+  template <typename T>
+  void Append(const T* data, size_t size) {
+    output_->append(reinterpret_cast<const char*>(data), size * sizeof(T));
+    output_->append((kAlignment - output_->size() % kAlignment) % kAlignment,
+                    '\0');
+  }
+
+ private:
+  std::string* output_;
+};
+
+class SnapshotReader {
+ public:
+  explicit SnapshotReader(absl::string_view data) : data_(data) {}
+
+  template <typename T>
+  absl::StatusOr<absl::Span<const T>> Read(int64_t size) {
+    if (size < 0 ||
+        static_cast<uint64_t>(size) > (data_.size() - position_) / sizeof(T)) {
+      return absl::InvalidArgumentError("Truncated snapshot.");
+    }
+    const char* begin = data_.data() + position_;
+    DCHECK_EQ(reinterpret_cast<uintptr_t>(begin) % alignof(T), 0);
+    const size_t num_bytes = size * sizeof(T);
+    position_ += num_bytes + (kAlignment - num_bytes % kAlignment) % kAlignment;
+    if (position_ > data_.size()) {
+      return absl::InvalidArgumentError("Truncated snapshot.");
+    }
+    return absl::MakeConstSpan(reinterpret_cast<const T*>(begin), size);
+  }
+
+  bool AtEnd() const { return position_ == data_.size(); }
+
+ private:
+  absl::string_view data_;
+  size_t position_ = 0;
+};
+
+template <typename IndexType>
+std::string NameOrEmpty(const std::string& name, absl::string_view prefix,
+                        IndexType index) {
+  if (name == absl::StrFormat("%s%d", prefix, index.value())) return "";
+  return name;
+}
+
+}  // namespace
+
+std::string LinearProgramToSnapshot(const LinearProgram& linear_program) {
+  DCHECK(linear_program.IsCleanedUp());
+  const RowIndex num_rows = linear_program.num_constraints();
+  const ColIndex num_cols = linear_program.num_variables();
+
+  SnapshotHeader header;
+  std::memset(&header, 0, sizeof(header));
+  std::memcpy(header.magic, kMagic, sizeof(kMagic));
+  header.version = kVersion;
+  header.byte_order_mark = kByteOrderMark;
+  header.num_rows = num_rows.value();
+  header.num_cols = num_cols.value();
+  header.num_entries = linear_program.num_entries().value();
+  header.objective_offset = linear_program.objective_offset();
+  header.objective_scaling_factor = linear_program.objective_scaling_factor();
+  header.flags = linear_program.IsMaximizationProblem() ? kMaximizeFlag : 0;
+
+  // The names. Note that LinearProgram returns a default name for the unnamed
+  // rows and columns that we do not need to store.
+  std::string names;
+  std::vector<int64_t> name_starts;
+  name_starts.reserve(NumNames(header) + 1);
+  const auto add_name = [&names, &name_starts](absl::string_view name) {
+    name_starts.push_back(names.size());
+    names.append(name);
+  };
+  add_name(linear_program.name());
+  for (ColIndex col(0); col < num_cols; ++col) {
+    add_name(NameOrEmpty(linear_program.GetVariableName(col), "c", col));
+  }
+  for (RowIndex row(0); row < num_rows; ++row) {
+    add_name(NameOrEmpty(linear_program.GetConstraintName(row), "r", row));
+  }
+  name_starts.push_back(names.size());
+  header.names_size = names.size();
+
+  // The matrix, column by column.
+  std::vector<int64_t> starts;
+  std::vector<RowIndex::ValueType> rows;
+  std::vector<Fractional> coefficients;
+  std::vector<uint8_t> types;
+  starts.reserve(num_cols.value() + 1);
+  rows.reserve(header.num_entries);
+  coefficients.reserve(header.num_entries);
+  types.reserve(num_cols.value());
+  for (ColIndex col(0); col < num_cols; ++col) {
+    starts.push_back(rows.size());
+    for (const SparseColumn::Entry e : linear_program.GetSparseColumn(col)) {
+      rows.push_back(e.row().value());
+      coefficients.push_back(e.coefficient());
+    }
+    types.push_back(static_cast<uint8_t>(linear_program.GetVariableType(col)));
+  }
+  starts.push_back(rows.size());
+
+  std::string output;
+  SnapshotWriter writer(&output);
+  writer.Append(&header, 1);
+  writer.Append(starts.data(), starts.size());
+  writer.Append(rows.data(), rows.size());
+  writer.Append(coefficients.data(), coefficients.size());
+  writer.Append(linear_program.objective_coefficients().data(),
+                num_cols.value());
+  writer.Append(linear_program.variable_lower_bounds().data(),
+                num_cols.value());
+  writer.Append(linear_program.variable_upper_bounds().data(),
+                num_cols.value());
+  writer.Append(types.data(), types.size());
+  writer.Append(linear_program.constraint_lower_bounds().data(),
+                num_rows.value());
+  writer.Append(linear_program.constraint_upper_bounds().data(),
+                num_rows.value());
+  writer.Append(name_starts.data(), name_starts.size());
+  writer.Append(names.data(), names.size());
+  return output;
+}
+
+absl::Status SnapshotToLinearProgram(absl::string_view snapshot,
+                                     LinearProgram* linear_program) {
+  // The arrays are read in place, so we need an aligned buffer.
+  std::vector<int64_t> aligned_copy;
+  if (reinterpret_cast<uintptr_t>(snapshot.data()) % kAlignment != 0) {
+    aligned_copy.resize((snapshot.size() + kAlignment - 1) / kAlignment);
+    std::memcpy(aligned_copy.data(), snapshot.data(), snapshot.size());
+    snapshot = absl::string_view(
+        reinterpret_cast<const char*>(aligned_copy.data()), snapshot.size());
+  }
+  SnapshotReader reader(snapshot);
+
+  // Validate the header.
+  ASSIGN_OR_RETURN(const absl::Span<const SnapshotHeader> header_span,
+                   reader.Read<SnapshotHeader>(1));
+  const SnapshotHeader& header = header_span[0];
+  if (std::memcmp(header.magic, kMagic, sizeof(kMagic)) != 0) {
+    return absl::InvalidArgumentError("Not a LinearProgram snapshot.");
+  }
+  if (header.version != kVersion) {
+    return absl::InvalidArgumentError(
+        absl::StrFormat("Unsupported snapshot version %d.", header.version));
+  }
+  if (header.byte_order_mark != kByteOrderMark) {
+    return absl::InvalidArgumentError(
+        "The snapshot was written with a different byte order.");
+  }
+  constexpr int64_t kMaxIndex = std::numeric_limits<int32_t>::max();
+  if (header.num_rows < 0 || header.num_rows > kMaxIndex ||
+      header.num_cols < 0 || header.num_cols > kMaxIndex ||
+      header.num_entries < 0 || header.names_size < 0) {
+    return absl::InvalidArgumentError("Invalid snapshot dimensions.");
+  }
+  const int64_t num_rows = header.num_rows;
+  const int64_t num_cols = header.num_cols;
+
+  ASSIGN_OR_RETURN(const absl::Span<const int64_t> starts,
+                   reader.Read<int64_t>(num_cols + 1));
+  ASSIGN_OR_RETURN(const absl::Span<const RowIndex::ValueType> rows,
+                   reader.Read<RowIndex::ValueType>(header.num_entries));
+  ASSIGN_OR_RETURN(const absl::Span<const Fractional> coefficients,
+                   reader.Read<Fractional>(header.num_entries));
+  ASSIGN_OR_RETURN(const absl::Span<const Fractional> objective,
+                   reader.Read<Fractional>(num_cols));
+  ASSIGN_OR_RETURN(const absl::Span<const Fractional> variable_lower_bounds,
+                   reader.Read<Fractional>(num_cols));
+  ASSIGN_OR_RETURN(const absl::Span<const Fractional> variable_upper_bounds,
+                   reader.Read<Fractional>(num_cols));
+  ASSIGN_OR_RETURN(const absl::Span<const uint8_t> types,
+                   reader.Read<uint8_t>(num_cols));
+  ASSIGN_OR_RETURN(const absl::Span<const Fractional> constraint_lower_bounds,
+                   reader.Read<Fractional>(num_rows));
+  ASSIGN_OR_RETURN(const absl::Span<const Fractional> constraint_upper_bounds,
+                   reader.Read<Fractional>(num_rows));
+  ASSIGN_OR_RETURN(const absl::Span<const int64_t> name_starts,
+                   reader.Read<int64_t>(NumNames(header) + 1));
+  ASSIGN_OR_RETURN(const absl::Span<const char> names,
+                   reader.Read<char>(header.names_size));
+  if (!reader.AtEnd()) {
+    return absl::InvalidArgumentError("Trailing data in snapshot.");
+  }
+
+  // Validate the arrays before touching linear_program.
+  if (starts[0] != 0 || starts[num_cols] != header.num_entries) {
+    return absl::InvalidArgumentError("Invalid column starts in snapshot.");
+  }
+  for (int64_t col = 0; col < num_cols; ++col) {
+    if (starts[col + 1] < starts[col]) {
+      return absl::InvalidArgumentError("Invalid column starts in snapshot.");
+    }
+    for (int64_t i = starts[col]; i < starts[col + 1]; ++i) {
+      if (rows[i] < 0 || rows[i] >= num_rows ||
+          (i > starts[col] && rows[i] <= rows[i - 1])) {
+        return absl::InvalidArgumentError(
+            absl::StrFormat("Invalid rows in column %d of snapshot.", col));
+      }
+    }
+    if (types[col] >
+        static_cast<uint8_t>(LinearProgram::VariableType::IMPLIED_INTEGER)) {
+      return absl::InvalidArgumentError(
+          absl::StrFormat("Invalid type for column %d of snapshot.", col));
+    }
+  }
+  if (name_starts[0] != 0 || name_starts.back() != header.names_size) {
+    return absl::InvalidArgumentError("Invalid string table in snapshot.");
+  }
+  for (int i = 1; i < name_starts.size(); ++i) {
+    if (name_starts[i] < name_starts[i - 1]) {
+      return absl::InvalidArgumentError("Invalid string table in snapshot.");
+    }
+  }
+  const auto name = [&names, &name_starts](int64_t i) {
+    return absl::string_view(names.data() + name_starts[i],
+                             name_starts[i + 1] - name_starts[i]);
+  };
+
+  // Fill the linear program.
+  linear_program->Clear();
+  linear_program->SetDcheckBounds(false);
+  linear_program->SetName(name(0));
+  linear_program->SetMaximizationProblem(header.flags & kMaximizeFlag);
+  linear_program->SetObjectiveOffset(header.objective_offset);
+  linear_program->SetObjectiveScalingFactor(header.objective_scaling_factor);
+  for (int64_t r = 0; r < num_rows; ++r) {
+    const RowIndex row = linear_program->CreateNewConstraint();
+    linear_program->SetConstraintBounds(row, constraint_lower_bounds[r],
+                                        constraint_upper_bounds[r]);
+    const absl::string_view row_name = name(1 + num_cols + r);
+    if (!row_name.empty()) linear_program->SetConstraintName(row, row_name);
+  }
+  for (int64_t c = 0; c < num_cols; ++c) {
+    const ColIndex col = linear_program->CreateNewVariable();
+    linear_program->SetVariableBounds(col, variable_lower_bounds[c],
+                                      variable_upper_bounds[c]);
+    linear_program->SetObjectiveCoefficient(col, objective[c]);
+    linear_program->SetVariableType(
+        col, static_cast<LinearProgram::VariableType>(types[c]));
+    const absl::string_view col_name = name(1 + c);
+    if (!col_name.empty()) linear_program->SetVariableName(col, col_name);
+
+    SparseColumn* column = linear_program->GetMutableSparseColumn(col);
+    column->Reserve(EntryIndex(starts[c + 1] - starts[c]));
+    for (int64_t i = starts[c]; i < starts[c + 1]; ++i) {
+      column->SetCoefficient(RowIndex(rows[i]), coefficients[i]);
+    }
+  }
+  linear_program->CleanUp();
+  return absl::OkStatus();
+}
+
+absl::Status WriteLinearProgramSnapshot(const LinearProgram& linear_program,
+                                        absl::string_view file_name) {
+  return file::SetContents(file_name, LinearProgramToSnapshot(linear_program),
+                           file::Defaults());
+}
+
+absl::Status ReadLinearProgramSnapshot(absl::string_view file_name,
+                                       LinearProgram* linear_program) {
+  std::string snapshot;
+  RETURN_IF_ERROR(file::GetContents(file_name, &snapshot, file::Defaults()));
+  return SnapshotToLinearProgram(snapshot, linear_program);
+}
+
+}  // namespace glop
+}  // namespace operations_research
@@ -0,0 +1,61 @@
+// Copyright 2010-2024 Google LLC
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// A binary, versioned and columnar on-disk format for a LinearProgram. It is a
+// lot faster to load than an MPS file or an MPModelProto because there is no
+// parsing and no name lookup: the file is a fixed header followed by
+// contiguous arrays (column starts, rows and coefficients of the matrix,
+// bounds, objective, variable types) and a string table for the names.
+//
+// The arrays are stored with the native byte order and are 8-bytes aligned, so
+// a snapshot is meant to be reloaded on the same kind of machine that wrote it.
+// This is checked at load time, together with the consistency of all the
+// arrays.
+
+#ifndef OR_TOOLS_LP_DATA_LP_SNAPSHOT_H_
+#define OR_TOOLS_LP_DATA_LP_SNAPSHOT_H_
+
+#include <string>
+
+#include "absl/status/status.h"
+#include "absl/strings/string_view.h"
+#include "ortools/lp_data/lp_data.h"
+
+namespace operations_research {
+namespace glop {
+
+// The file name suffix used by LoadLinearProgramFromModelOrRequest() to
+// recognize a snapshot.
+inline constexpr absl::string_view kLinearProgramSnapshotSuffix =
+    ".glop_snapshot";
+
+// Serializes the given linear program. The linear program must be cleaned up
+// (see LinearProgram::CleanUp()).
+std::string LinearProgramToSnapshot(const LinearProgram& linear_program);
+
+// Loads a snapshot created by LinearProgramToSnapshot(). Returns an
+// InvalidArgumentError if the data is not a valid snapshot, in which case
+// linear_program is left in an unspecified state.
+absl::Status SnapshotToLinearProgram(absl::string_view snapshot,
+                                     LinearProgram* linear_program);
+
+// Same as above, but with files.
+absl::Status WriteLinearProgramSnapshot(const LinearProgram& linear_program,
+                                        absl::string_view file_name);
+absl::Status ReadLinearProgramSnapshot(absl::string_view file_name,
+                                       LinearProgram* linear_program);
+
+}  // namespace glop
+}  // namespace operations_research
+
+#endif  // OR_TOOLS_LP_DATA_LP_SNAPSHOT_H_
@@ -15,15 +15,21 @@
 
 #include <algorithm>
 #include <cmath>
+#include <cstdint>
 #include <cstdlib>
+#include <functional>
 #include <memory>
 #include <string>
 #include <vector>
 
 #include "absl/log/check.h"
 #include "absl/strings/str_format.h"
+#include "absl/synchronization/blocking_counter.h"
 #include "ortools/base/logging.h"
 #include "ortools/base/strong_vector.h"
+#if !defined(__PORTABLE_PLATFORM__)
+#include "ortools/base/threadpool.h"
+#endif  // __PORTABLE_PLATFORM__
 #include "ortools/glop/parameters.pb.h"
 #include "ortools/glop/revised_simplex.h"
 #include "ortools/glop/status.h"
@@ -41,6 +47,8 @@ namespace glop {
 SparseMatrixScaler::SparseMatrixScaler()
     : matrix_(nullptr), row_scales_(), col_scales_() {}
 
+SparseMatrixScaler::~SparseMatrixScaler() = default;
+
 void SparseMatrixScaler::Init(SparseMatrix* matrix) {
   DCHECK(matrix != nullptr);
   matrix_ = matrix;
@@ -126,6 +134,14 @@ void SparseMatrixScaler::Scale(GlopParameters::ScalingAlgorithm method) {
   // off geometric scaling.
   const Fractional dynamic_range = max_magnitude / min_magnitude;
   const Fractional kMaxDynamicRangeForGeometricScaling = 1e20;
+  ComputeColumnShards();
+#if !defined(__PORTABLE_PLATFORM__)
+  if (NumColumnShards() > 1) {
+    thread_pool_ = std::make_unique<ThreadPool>("SparseMatrixScaler",
+                                                NumColumnShards() - 1);
+    thread_pool_->StartWorkers();
+  }
+#endif  // __PORTABLE_PLATFORM__
   if (dynamic_range < kMaxDynamicRangeForGeometricScaling) {
     const int kScalingIterations = 4;
     const Fractional kVarianceThreshold(10.0);
@@ -148,6 +164,66 @@ void SparseMatrixScaler::Scale(GlopParameters::ScalingAlgorithm method) {
   VLOG(1) << "Equilibration step: Rows scaled = " << rows_equilibrated
           << ", columns scaled = " << cols_equilibrated << "\n";
   VLOG(1) << DebugInformationString();
+
+  // Do not keep idle threads around once the matrix is scaled.
+#if !defined(__PORTABLE_PLATFORM__)
+  thread_pool_.reset();
+#endif  // __PORTABLE_PLATFORM__
+  shard_starts_.clear();
+  shard_max_in_row_.clear();
+  shard_min_in_row_.clear();
+}
+
+void SparseMatrixScaler::ComputeColumnShards() {
+  DCHECK(matrix_ != nullptr);
+  const ColIndex num_cols = matrix_->num_cols();
+  shard_starts_.assign(1, ColIndex(0));
+#if !defined(__PORTABLE_PLATFORM__)
+  // Below this number of entries per shard, the synchronization and the
+  // merging of the per-row statistics cost more than what we gain.
+  const int64_t kMinEntriesPerShard = 200000;
+  const int64_t num_entries = matrix_->num_entries().value();
+  const int num_shards = static_cast<int>(std::min<int64_t>(
+      std::max(1, num_threads_), num_entries / kMinEntriesPerShard));
+  if (num_shards > 1) {
+    // Balance the shards by number of entries rather than by number of
+    // columns, all the passes of Scale() being linear in the former.
+    const int64_t target = num_entries / num_shards;
+    int64_t entries_in_shard = 0;
+    for (ColIndex col(0); col + 1 < num_cols; ++col) {
+      entries_in_shard += matrix_->column(col).num_entries().value();
+      if (entries_in_shard >= target &&
+          shard_starts_.size() < static_cast<size_t>(num_shards)) {
+        shard_starts_.push_back(col + 1);
+        entries_in_shard = 0;
+      }
+    }
+  }
+#endif  // __PORTABLE_PLATFORM__
+  shard_starts_.push_back(num_cols);
+}
+
+void SparseMatrixScaler::ForEachColumnShard(
+    const std::function<void(int, ColIndex, ColIndex)>& f) {
+  const int num_shards = NumColumnShards();
+  if (num_shards <= 1) {
+    f(0, ColIndex(0), matrix_->num_cols());
+    return;
+  }
+#if !defined(__PORTABLE_PLATFORM__)
+  DCHECK(thread_pool_ != nullptr);
+
+  // The calling thread processes the first shard.
+  absl::BlockingCounter counter(num_shards - 1);
+  for (int shard = 1; shard < num_shards; ++shard) {
+    thread_pool_->Schedule([this, &counter, &f, shard]() {
+      f(shard, shard_starts_[shard], shard_starts_[shard + 1]);
+      counter.DecrementCount();
+    });
+  }
+  f(0, shard_starts_[0], shard_starts_[1]);
+  counter.Wait();
+#endif  // __PORTABLE_PLATFORM__
 }
 
 namespace {
@@ -220,52 +296,81 @@ Fractional SparseMatrixScaler::VarianceOfAbsoluteValueOfNonZeros() const {
 
 RowIndex SparseMatrixScaler::ScaleRowsGeometrically() {
   DCHECK(matrix_ != nullptr);
-  DenseColumn max_in_row(matrix_->num_rows(), 0.0);
-  DenseColumn min_in_row(matrix_->num_rows(), kInfinity);
-  const ColIndex num_cols = matrix_->num_cols();
-  for (ColIndex col(0); col < num_cols; ++col) {
-    for (const SparseColumn::Entry e : matrix_->column(col)) {
-      const Fractional magnitude = fabs(e.coefficient());
-      const RowIndex row = e.row();
-      if (magnitude != 0.0) {
-        max_in_row[row] = std::max(max_in_row[row], magnitude);
-        min_in_row[row] = std::min(min_in_row[row], magnitude);
+  const RowIndex num_rows = matrix_->num_rows();
+  DenseColumn max_in_row(num_rows, 0.0);
+  DenseColumn min_in_row(num_rows, kInfinity);
+  const int num_shards = NumColumnShards();
+  shard_max_in_row_.resize(num_shards - 1);
+  shard_min_in_row_.resize(num_shards - 1);
+  ForEachColumnShard([&](int shard, ColIndex begin, ColIndex end) {
+    DenseColumn* max_in_shard = &max_in_row;
+    DenseColumn* min_in_shard = &min_in_row;
+    if (shard > 0) {
+      max_in_shard = &shard_max_in_row_[shard - 1];
+      min_in_shard = &shard_min_in_row_[shard - 1];
+      max_in_shard->assign(num_rows, 0.0);
+      min_in_shard->assign(num_rows, kInfinity);
+    }
+    for (ColIndex col = begin; col < end; ++col) {
+      for (const SparseColumn::Entry e : matrix_->column(col)) {
+        const Fractional magnitude = fabs(e.coefficient());
+        const RowIndex row = e.row();
+        if (magnitude != 0.0) {
+          (*max_in_shard)[row] = std::max((*max_in_shard)[row], magnitude);
+          (*min_in_shard)[row] = std::min((*min_in_shard)[row], magnitude);
+        }
       }
     }
+  });
+
+  // The min and max are exact, so the merge order does not matter.
+  for (int shard = 1; shard < num_shards; ++shard) {
+    const DenseColumn& max_in_shard = shard_max_in_row_[shard - 1];
+    const DenseColumn& min_in_shard = shard_min_in_row_[shard - 1];
+    for (RowIndex row(0); row < num_rows; ++row) {
+      max_in_row[row] = std::max(max_in_row[row], max_in_shard[row]);
+      min_in_row[row] = std::min(min_in_row[row], min_in_shard[row]);
+    }
   }
-  const RowIndex num_rows = matrix_->num_rows();
-  DenseColumn scaling_factor(num_rows, 0.0);
+
+  // We reuse max_in_row to store the scaling factors.
   for (RowIndex row(0); row < num_rows; ++row) {
     if (max_in_row[row] == 0.0) {
-      scaling_factor[row] = 1.0;
+      max_in_row[row] = 1.0;
     } else {
       DCHECK_NE(kInfinity, min_in_row[row]);
-      scaling_factor[row] = std::sqrt(max_in_row[row] * min_in_row[row]);
+      max_in_row[row] = std::sqrt(max_in_row[row] * min_in_row[row]);
     }
   }
-  return ScaleMatrixRows(scaling_factor);
+  return ScaleMatrixRows(max_in_row);
 }
 
 ColIndex SparseMatrixScaler::ScaleColumnsGeometrically() {
   DCHECK(matrix_ != nullptr);
-  ColIndex num_cols_scaled(0);
-  const ColIndex num_cols = matrix_->num_cols();
-  for (ColIndex col(0); col < num_cols; ++col) {
-    Fractional max_in_col(0.0);
-    Fractional min_in_col(kInfinity);
-    for (const SparseColumn::Entry e : matrix_->column(col)) {
-      const Fractional magnitude = fabs(e.coefficient());
-      if (magnitude != 0.0) {
-        max_in_col = std::max(max_in_col, magnitude);
-        min_in_col = std::min(min_in_col, magnitude);
+  std::vector<ColIndex> num_cols_scaled_in_shard(NumColumnShards(),
+                                                 ColIndex(0));
+  ForEachColumnShard([&](int shard, ColIndex begin, ColIndex end) {
+    ColIndex num_cols_scaled(0);
+    for (ColIndex col = begin; col < end; ++col) {
+      Fractional max_in_col(0.0);
+      Fractional min_in_col(kInfinity);
+      for (const SparseColumn::Entry e : matrix_->column(col)) {
+        const Fractional magnitude = fabs(e.coefficient());
+        if (magnitude != 0.0) {
+          max_in_col = std::max(max_in_col, magnitude);
+          min_in_col = std::min(min_in_col, magnitude);
+        }
+      }
+      if (max_in_col != 0.0) {
+        const Fractional factor(std::sqrt(ToDouble(max_in_col * min_in_col)));
+        ScaleMatrixColumn(col, factor);
+        num_cols_scaled++;
       }
     }
-    if (max_in_col != 0.0) {
-      const Fractional factor(std::sqrt(ToDouble(max_in_col * min_in_col)));
-      ScaleMatrixColumn(col, factor);
-      num_cols_scaled++;
-    }
-  }
+    num_cols_scaled_in_shard[shard] = num_cols_scaled;
+  });
+  ColIndex num_cols_scaled(0);
+  for (const ColIndex n : num_cols_scaled_in_shard) num_cols_scaled += n;
   return num_cols_scaled;
 }
 
@@ -278,15 +383,29 @@ RowIndex SparseMatrixScaler::EquilibrateRows() {
   DCHECK(matrix_ != nullptr);
   const RowIndex num_rows = matrix_->num_rows();
   DenseColumn max_magnitudes(num_rows, 0.0);
-  const ColIndex num_cols = matrix_->num_cols();
-  for (ColIndex col(0); col < num_cols; ++col) {
-    for (const SparseColumn::Entry e : matrix_->column(col)) {
-      const Fractional magnitude = fabs(e.coefficient());
-      if (magnitude != 0.0) {
-        const RowIndex row = e.row();
-        max_magnitudes[row] = std::max(max_magnitudes[row], magnitude);
+  const int num_shards = NumColumnShards();
+  shard_max_in_row_.resize(num_shards - 1);
+  ForEachColumnShard([&](int shard, ColIndex begin, ColIndex end) {
+    DenseColumn* max_in_shard = &max_magnitudes;
+    if (shard > 0) {
+      max_in_shard = &shard_max_in_row_[shard - 1];
+      max_in_shard->assign(num_rows, 0.0);
+    }
+    for (ColIndex col = begin; col < end; ++col) {
+      for (const SparseColumn::Entry e : matrix_->column(col)) {
+        const Fractional magnitude = fabs(e.coefficient());
+        if (magnitude != 0.0) {
+          const RowIndex row = e.row();
+          (*max_in_shard)[row] = std::max((*max_in_shard)[row], magnitude);
+        }
       }
     }
+  });
+  for (int shard = 1; shard < num_shards; ++shard) {
+    const DenseColumn& max_in_shard = shard_max_in_row_[shard - 1];
+    for (RowIndex row(0); row < num_rows; ++row) {
+      max_magnitudes[row] = std::max(max_magnitudes[row], max_in_shard[row]);
+    }
   }
   for (RowIndex row(0); row < num_rows; ++row) {
     if (max_magnitudes[row] == 0.0) {
@@ -298,15 +417,21 @@ RowIndex SparseMatrixScaler::EquilibrateRows() {
 
 ColIndex SparseMatrixScaler::EquilibrateColumns() {
   DCHECK(matrix_ != nullptr);
-  ColIndex num_cols_scaled(0);
-  const ColIndex num_cols = matrix_->num_cols();
-  for (ColIndex col(0); col < num_cols; ++col) {
-    const Fractional max_magnitude = InfinityNorm(matrix_->column(col));
-    if (max_magnitude != 0.0 && max_magnitude != 1.0) {
-      ScaleMatrixColumn(col, max_magnitude);
-      num_cols_scaled++;
+  std::vector<ColIndex> num_cols_scaled_in_shard(NumColumnShards(),
+                                                 ColIndex(0));
+  ForEachColumnShard([&](int shard, ColIndex begin, ColIndex end) {
+    ColIndex num_cols_scaled(0);
+    for (ColIndex col = begin; col < end; ++col) {
+      const Fractional max_magnitude = InfinityNorm(matrix_->column(col));
+      if (max_magnitude != 0.0 && max_magnitude != 1.0) {
+        ScaleMatrixColumn(col, max_magnitude);
+        num_cols_scaled++;
+      }
     }
-  }
+    num_cols_scaled_in_shard[shard] = num_cols_scaled;
+  });
+  ColIndex num_cols_scaled(0);
+  for (const ColIndex n : num_cols_scaled_in_shard) num_cols_scaled += n;
   return num_cols_scaled;
 }
 
@@ -325,10 +450,14 @@ RowIndex SparseMatrixScaler::ScaleMatrixRows(const DenseColumn& factors) {
     }
   }
 
-  const ColIndex num_cols = matrix_->num_cols();
-  for (ColIndex col(0); col < num_cols; ++col) {
-    matrix_->mutable_column(col)->ComponentWiseDivide(factors);
-  }
+  // Dividing by 1.0 does not change anything, so we can skip the pass over the
+  // matrix entries altogether.
+  if (num_rows_scaled == 0) return num_rows_scaled;
+  ForEachColumnShard([this, &factors](int, ColIndex begin, ColIndex end) {
+    for (ColIndex col = begin; col < end; ++col) {
+      matrix_->mutable_column(col)->ComponentWiseDivide(factors);
+    }
+  });
 
   return num_rows_scaled;
 }
@@ -60,6 +60,8 @@
 #ifndef OR_TOOLS_LP_DATA_MATRIX_SCALER_H_
 #define OR_TOOLS_LP_DATA_MATRIX_SCALER_H_
 
+#include <functional>
+#include <memory>
 #include <string>
 #include <vector>
 
@@ -71,11 +73,15 @@
 #include "ortools/lp_data/lp_types.h"
 
 namespace operations_research {
+
+class ThreadPool;
+
 namespace glop {
 
 class SparseMatrixScaler {
  public:
   SparseMatrixScaler();
+  ~SparseMatrixScaler();
 
   // This type is neither copyable nor movable.
   SparseMatrixScaler(const SparseMatrixScaler&) = delete;
@@ -112,6 +118,11 @@ class SparseMatrixScaler {
   // Scales the matrix.
   void Scale(GlopParameters::ScalingAlgorithm method);
 
+  // Maximum number of threads that Scale() may use to process the columns of
+  // a large matrix in parallel. The result does not depend on this number.
+  // This is not changed by Init() or Clear().
+  void set_num_threads(int num_threads) { num_threads_ = num_threads; }
+
   // Scales a row vector up or down (depending whether parameter up is true or
   // false) using the scaling factors determined by Scale().
   // Scaling up means multiplying by the scaling factors, while scaling down
@@ -156,6 +167,18 @@ class SparseMatrixScaler {
   // Used by ScaleColumnsGeometrically and EquilibrateColumns.
   void ScaleMatrixColumn(ColIndex col, Fractional factor);
 
+  // Splits the columns of the matrix into contiguous ranges with a similar
+  // number of entries, one per shard, and updates shard_starts_.
+  void ComputeColumnShards();
+  int NumColumnShards() const {
+    return static_cast<int>(shard_starts_.size()) - 1;
+  }
+
+  // Calls f(shard, begin, end) for each column shard [begin, end). The shards
+  // are processed in parallel if there is more than one.
+  void ForEachColumnShard(
+      const std::function<void(int, ColIndex, ColIndex)>& f);
+
   // Returns a string containing information on the progress of the scaling
   // algorithm. This is not meant to be called in an optimized mode as it takes
   // some time to compute the displayed quantities.
@@ -169,6 +192,18 @@ class SparseMatrixScaler {
 
   // Array of scaling factors for each column. Indexed by column number.
   DenseRow col_scales_;
+
+  // The column shards used by Scale(): shard i contains the columns in
+  // [shard_starts_[i], shard_starts_[i + 1]). The per-row statistics of all
+  // the shards but the first are accumulated in these temporary vectors and
+  // then merged, which gives the same result as a sequential pass.
+  int num_threads_ = 1;
+  std::vector<ColIndex> shard_starts_;
+  std::vector<DenseColumn> shard_max_in_row_;
+  std::vector<DenseColumn> shard_min_in_row_;
+#if !defined(__PORTABLE_PLATFORM__)
+  std::unique_ptr<ThreadPool> thread_pool_;
+#endif  // __PORTABLE_PLATFORM__
 };
 
 }  // namespace glop
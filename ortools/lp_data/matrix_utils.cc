@@ -25,6 +25,10 @@
 #include "ortools/lp_data/sparse.h"
 #include "ortools/lp_data/sparse_column.h"
 
+#if !defined(__PORTABLE_PLATFORM__)
+#include "ortools/base/threadpool.h"
+#endif  // __PORTABLE_PLATFORM__
+
 namespace operations_research {
 namespace glop {
 
@@ -121,17 +125,55 @@ ColumnFingerprint ComputeFingerprint(ColIndex col, const SparseColumn& column) {
 }  // namespace
 
 ColMapping FindProportionalColumns(const SparseMatrix& matrix,
-                                   Fractional tolerance) {
+                                   Fractional tolerance, int num_threads) {
   const ColIndex num_cols = matrix.num_cols();
   ColMapping mapping(num_cols, kInvalidCol);
 
-  // Compute the fingerprint of each columns and sort them.
+  // Compute the fingerprint of each columns and sort them. This scans the full
+  // matrix, so on large problems we split it in contiguous ranges of columns
+  // each processed by a different thread. The shards are concatenated in order
+  // so that the result does not depend on the number of threads.
   std::vector<ColumnFingerprint> fingerprints;
-  for (ColIndex col(0); col < num_cols; ++col) {
-    if (!matrix.column(col).IsEmpty()) {
-      fingerprints.push_back(ComputeFingerprint(col, matrix.column(col)));
+  const auto append_fingerprints = [&matrix](
+                                       ColIndex begin, ColIndex end,
+                                       std::vector<ColumnFingerprint>* output) {
+    for (ColIndex col(begin); col < end; ++col) {
+      if (!matrix.column(col).IsEmpty()) {
+        output->push_back(ComputeFingerprint(col, matrix.column(col)));
+      }
+    }
+  };
+#if !defined(__PORTABLE_PLATFORM__)
+  // Below this number of entries per thread, it is not worth it.
+  constexpr int64_t kMinEntriesPerShard = 1'000'000;
+  const int num_shards = static_cast<int>(std::min<int64_t>(
+      std::min<int64_t>(num_threads, num_cols.value()),
+      matrix.num_entries().value() / kMinEntriesPerShard));
+  if (num_shards > 1) {
+    std::vector<std::vector<ColumnFingerprint>> shards(num_shards);
+    const auto shard_begin = [num_cols, num_shards](int shard) {
+      return ColIndex(num_cols.value() * static_cast<int64_t>(shard) /
+                      num_shards);
+    };
+    {
+      ThreadPool pool("FindProportionalColumns", num_shards);
+      pool.StartWorkers();
+      for (int shard = 0; shard < num_shards; ++shard) {
+        pool.Schedule([&, shard]() {
+          append_fingerprints(shard_begin(shard), shard_begin(shard + 1),
+                              &shards[shard]);
+        });
+      }
+    }
+    for (const std::vector<ColumnFingerprint>& shard : shards) {
+      fingerprints.insert(fingerprints.end(), shard.begin(), shard.end());
     }
+  } else {
+    append_fingerprints(ColIndex(0), num_cols, &fingerprints);
   }
+#else
+  append_fingerprints(ColIndex(0), num_cols, &fingerprints);
+#endif  // __PORTABLE_PLATFORM__
   std::sort(fingerprints.begin(), fingerprints.end());
 
   // Find a representative of each proportional columns class. This only
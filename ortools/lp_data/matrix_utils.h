@@ -33,8 +33,12 @@ namespace glop {
 // The complexity is in most cases O(num entries of the matrix). However,
 // compared to the less efficient algorithm below, it is highly unlikely but
 // possible that some pairs of proportional columns are not detected.
+//
+// If num_threads > 1, the fingerprint computation, which scans the whole
+// matrix, is split between this number of threads on large matrices. The
+// result is the same whatever the number of threads.
 ColMapping FindProportionalColumns(const SparseMatrix& matrix,
-                                   Fractional tolerance);
+                                   Fractional tolerance, int num_threads = 1);
 
 // A simple version of FindProportionalColumns() that compares all the columns
 // pairs one by one. This is slow, but here for reference. The complexity is
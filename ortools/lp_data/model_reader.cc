@@ -15,9 +15,12 @@
 
 #include <string>
 
+#include "absl/status/status.h"
+#include "absl/strings/match.h"
 #include "ortools/base/logging.h"
 #include "ortools/linear_solver/linear_solver.pb.h"
 #include "ortools/lp_data/lp_data.h"
+#include "ortools/lp_data/lp_snapshot.h"
 #include "ortools/lp_data/proto_utils.h"
 #include "ortools/util/file_util.h"
 
@@ -58,6 +61,16 @@ bool LoadMPModelProtoFromModelOrRequest(const std::string& input_file_path,
 
 bool LoadLinearProgramFromModelOrRequest(const std::string& input_file_path,
                                          LinearProgram* linear_program) {
+  if (absl::EndsWith(input_file_path, kLinearProgramSnapshotSuffix)) {
+    const absl::Status status =
+        ReadLinearProgramSnapshot(input_file_path, linear_program);
+    if (!status.ok()) {
+      LOG(ERROR) << "Failed to load the snapshot '" << input_file_path
+                 << "': " << status;
+      return false;
+    }
+    return true;
+  }
   MPModelProto model_proto;
   if (LoadMPModelProtoFromModelOrRequest(input_file_path, &model_proto)) {
     MPModelProtoToLinearProgram(model_proto, linear_program);
@@ -23,7 +23,8 @@ namespace operations_research {
 namespace glop {
 
 // Helper function to read data from model files into MPModelProto and
-// LinearProgram.
+// LinearProgram. LoadLinearProgramFromModelOrRequest() also accepts the
+// snapshots of lp_snapshot.h, recognized by their kLinearProgramSnapshotSuffix.
 bool LoadMPModelProtoFromModelOrRequest(const std::string& input_file_path,
                                         MPModelProto* model);
 bool LoadLinearProgramFromModelOrRequest(const std::string& input_file_path,
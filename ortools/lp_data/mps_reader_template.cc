@@ -13,7 +13,16 @@
 
 #include "ortools/lp_data/mps_reader_template.h"
 
+#include <cstddef>
 #include <cstdint>
+#include <string>
+
+#if !defined(_MSC_VER)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif  // _MSC_VER
 
 #include "absl/container/inlined_vector.h"
 #include "absl/status/status.h"
@@ -38,6 +47,47 @@ static constexpr int kSpacePos[12] = {12, 13, 22, 23, 36, 37,
 
 }  // namespace
 
+// static
+absl::StatusOr<MemoryMappedFile> MemoryMappedFile::Open(
+    absl::string_view file_name) {
+#if defined(_MSC_VER)
+  return absl::UnimplementedError("Memory mapping is not supported.");
+#else
+  const std::string null_terminated_name(file_name);
+  const int fd = open(null_terminated_name.c_str(), O_RDONLY);
+  if (fd < 0) return absl::NotFoundError("Could not open file.");
+  struct stat file_stat;
+  if (fstat(fd, &file_stat) != 0 || !S_ISREG(file_stat.st_mode)) {
+    close(fd);
+    return absl::InvalidArgumentError("Not a regular file.");
+  }
+  const size_t size = file_stat.st_size;
+  if (size == 0) {
+    close(fd);
+    return MemoryMappedFile(nullptr, 0);
+  }
+  void* const data = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+
+  // The mapping stays valid after the file descriptor is closed.
+  close(fd);
+  if (data == MAP_FAILED) return absl::InternalError("mmap() failed.");
+  madvise(data, size, MADV_SEQUENTIAL);
+  return MemoryMappedFile(static_cast<const char*>(data), size);
+#endif  // _MSC_VER
+}
+
+MemoryMappedFile::MemoryMappedFile(MemoryMappedFile&& other)
+    : data_(other.data_), size_(other.size_) {
+  other.data_ = nullptr;
+  other.size_ = 0;
+}
+
+MemoryMappedFile::~MemoryMappedFile() {
+#if !defined(_MSC_VER)
+  if (data_ != nullptr) munmap(const_cast<char*>(data_), size_);
+#endif  // _MSC_VER
+}
+
 // static
 absl::StatusOr<MPSLineInfo> MPSLineInfo::Create(int64_t line_num,
                                                 bool free_form,
@@ -322,6 +322,30 @@ enum class MPSSectionId {
   kEndData
 };
 
+// Read-only memory mapping of a whole file, used by `ParseFile()` to iterate
+// over the lines of a local file without copying them. This is only supported
+// on POSIX platforms, `Open()` returns an UnimplementedError elsewhere, in
+// which case the reader falls back to reading the file line by line.
+class MemoryMappedFile {
+ public:
+  static absl::StatusOr<MemoryMappedFile> Open(absl::string_view file_name);
+
+  MemoryMappedFile(MemoryMappedFile&& other);
+  MemoryMappedFile& operator=(MemoryMappedFile&& other) = delete;
+  MemoryMappedFile(const MemoryMappedFile&) = delete;
+  MemoryMappedFile& operator=(const MemoryMappedFile&) = delete;
+  ~MemoryMappedFile();
+
+  // The content of the file, valid as long as this object is alive.
+  absl::string_view contents() const { return {data_, size_}; }
+
+ private:
+  MemoryMappedFile(const char* data, size_t size) : data_(data), size_(size) {}
+
+  const char* data_;
+  size_t size_;
+};
+
 // Represents a single line of an MPS file (or string), and its corresponding
 // fields.
 class MPSLineInfo {
@@ -668,6 +692,22 @@ absl::StatusOr<MPSReaderFormat> MPSReaderTemplate<DataWrapper>::ParseFile(
   free_form_ = form == MPSReaderFormat::kFree;
   Reset();
   data->SetUp();
+
+  // Iterate directly over the mapped file if possible. This avoids copying
+  // each line, and makes the second pass of the format auto-detection cheap
+  // since the file stays in the page cache.
+  if (absl::StatusOr<internal::MemoryMappedFile> mapped_file =
+          internal::MemoryMappedFile::Open(file_name);
+      mapped_file.ok()) {
+    for (const absl::string_view line :
+         absl::StrSplit(mapped_file->contents(), '\n')) {
+      RETURN_IF_ERROR(ProcessLine(line, data));
+    }
+    data->CleanUp();
+    DisplaySummary();
+    return form;
+  }
+
   File* file = nullptr;
   RETURN_IF_ERROR(file::Open(file_name, "r", &file, file::Defaults()));
   for (const absl::string_view line :
@@ -13,6 +13,10 @@
 
 #include "ortools/lp_data/proto_utils.h"
 
+#include <cstdint>
+#include <utility>
+#include <vector>
+
 #include "absl/log/check.h"
 #include "ortools/linear_solver/linear_solver.pb.h"
 #include "ortools/lp_data/lp_data.h"
@@ -54,9 +58,11 @@ void LinearProgramToMPModelProto(const LinearProgram& input,
   }
 }
 
-// Converts a MPModelProto to a LinearProgram.
-void MPModelProtoToLinearProgram(const MPModelProto& input,
-                                 LinearProgram* output) {
+namespace {
+
+// Clears `output` and sets its objective and variables from `input`.
+void CopyVariablesToLinearProgram(const MPModelProto& input,
+                                  LinearProgram* output) {
   output->Clear();
   output->SetName(input.name());
   output->SetMaximizationProblem(input.maximize());
@@ -72,6 +78,14 @@ void MPModelProtoToLinearProgram(const MPModelProto& input,
       output->SetVariableType(col, LinearProgram::VariableType::INTEGER);
     }
   }
+}
+
+}  // namespace
+
+// Converts a MPModelProto to a LinearProgram.
+void MPModelProtoToLinearProgram(const MPModelProto& input,
+                                 LinearProgram* output) {
+  CopyVariablesToLinearProgram(input, output);
   for (int j = 0; j < input.constraint_size(); ++j) {
     const MPConstraintProto& cst = input.constraint(j);
     const RowIndex row = output->CreateNewConstraint();
@@ -88,5 +102,38 @@ void MPModelProtoToLinearProgram(const MPModelProto& input,
   output->CleanUp();
 }
 
+void MPModelProtoToLinearProgram(MPModelProto&& input, LinearProgram* output) {
+  CopyVariablesToLinearProgram(input, output);
+  const int num_variables = input.variable_size();
+  std::vector<int64_t> column_sizes(num_variables, 0);
+  for (const MPConstraintProto& cst : input.constraint()) {
+    for (const int var_index : cst.var_index()) {
+      CHECK_GE(var_index, 0);
+      CHECK_LT(var_index, num_variables);
+      ++column_sizes[var_index];
+    }
+  }
+  for (int i = 0; i < num_variables; ++i) {
+    output->GetMutableSparseColumn(ColIndex(i))
+        ->Reserve(EntryIndex(column_sizes[i]));
+  }
+  column_sizes.clear();
+  column_sizes.shrink_to_fit();
+  for (int j = 0; j < input.constraint_size(); ++j) {
+    MPConstraintProto& cst = *input.mutable_constraint(j);
+    const RowIndex row = output->CreateNewConstraint();
+    output->SetConstraintName(row, cst.name());
+    output->SetConstraintBounds(row, cst.lower_bound(), cst.upper_bound());
+    CHECK_EQ(cst.var_index_size(), cst.coefficient_size());
+    for (int k = 0; k < cst.var_index_size(); ++k) {
+      output->SetCoefficient(row, ColIndex(cst.var_index(k)),
+                             cst.coefficient(k));
+    }
+    // Clear() would keep the capacity of the repeated fields.
+    MPConstraintProto().Swap(&cst);
+  }
+  output->CleanUp();
+}
+
 }  // namespace glop
 }  // namespace operations_research
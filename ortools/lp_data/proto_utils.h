@@ -28,6 +28,13 @@ void LinearProgramToMPModelProto(const LinearProgram& input,
 void MPModelProtoToLinearProgram(const MPModelProto& input,
                                  LinearProgram* output);
 
+// Same as above, but the memory of each constraint of `input` is released as
+// soon as it is converted, and the columns of the matrix are reserved to their
+// final size beforehand, so that the peak memory is about the one of the
+// largest of `input` and `output` instead of their sum. `input` is left with
+// its variables and empty constraints.
+void MPModelProtoToLinearProgram(MPModelProto&& input, LinearProgram* output);
+
 }  // namespace glop
 }  // namespace operations_research
 
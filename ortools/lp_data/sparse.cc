@@ -1365,6 +1365,21 @@ void TriangularMatrix::PermutedComputeRowsToConsider(
   }
 }
 
+int64_t TriangularMatrix::HyperSparseNumOpsThreshold() const {
+  // A dense solve looks at every column after the identity prefix and at the
+  // entries of the ones with a non-zero value. The hyper-sparse solve only
+  // looks at the reached columns, but each operation of the symbolic phase and
+  // of the solve itself is a lot more expensive because of the indirections
+  // and the cache misses. We only go the hyper-sparse way if the symbolic phase
+  // is at least kHyperSparseCostFactor times cheaper than a dense scan.
+  //
+  // Note that with an empty identity prefix, this is 5% of the number of rows.
+  constexpr int64_t kHyperSparseCostFactor = 20;
+  const int64_t num_dense_columns =
+      num_cols_.value() - first_non_identity_column_.value();
+  return num_dense_columns / kHyperSparseCostFactor;
+}
+
 void TriangularMatrix::ComputeRowsToConsiderWithDfs(
     RowIndexVector* non_zero_rows) const {
   if (non_zero_rows->empty()) return;
@@ -1377,12 +1392,9 @@ void TriangularMatrix::ComputeRowsToConsiderWithDfs(
   // will use the non-hypersparse version of the code.
   //
   // TODO(user): Investigate the best thresholds.
-  const int sparsity_threshold =
-      static_cast<int>(0.025 * static_cast<double>(num_rows_.value()));
-  const int num_ops_threshold =
-      static_cast<int>(0.05 * static_cast<double>(num_rows_.value()));
-  int num_ops = non_zero_rows->size();
-  if (num_ops > sparsity_threshold) {
+  const int64_t num_ops_threshold = HyperSparseNumOpsThreshold();
+  int64_t num_ops = non_zero_rows->size();
+  if (2 * num_ops > num_ops_threshold) {
     non_zero_rows->clear();
     return;
   }
@@ -1448,12 +1460,9 @@ void TriangularMatrix::ComputeRowsToConsiderInSortedOrder(
   if (non_zero_rows->empty()) return;
 
   // TODO(user): Investigate the best thresholds.
-  const int sparsity_threshold =
-      static_cast<int>(0.025 * static_cast<double>(num_rows_.value()));
-  const int num_ops_threshold =
-      static_cast<int>(0.05 * static_cast<double>(num_rows_.value()));
-  int num_ops = non_zero_rows->size();
-  if (num_ops > sparsity_threshold) {
+  const int64_t num_ops_threshold = HyperSparseNumOpsThreshold();
+  int64_t num_ops = non_zero_rows->size();
+  if (2 * num_ops > num_ops_threshold) {
     non_zero_rows->clear();
     return;
   }
@@ -744,6 +744,12 @@ class TriangularMatrix : private CompactSparseMatrix {
   // aborts early and non_zero_rows is cleared.
   void ComputeRowsToConsiderWithDfs(RowIndexVector* non_zero_rows) const;
 
+  // Both functions abort and clear non_zero_rows as soon as the number of
+  // operations of the symbolic phase exceeds the cost model returned by
+  // HyperSparseNumOpsThreshold(), in which case a dense solve is expected to
+  // be faster.
+  int64_t HyperSparseNumOpsThreshold() const;
+
   // Same as TriangularComputeRowsToConsider() but always returns the non-zeros
   // sorted by rows. It is up to the client to call the direct or reverse
   // hyper-sparse solve function depending if the matrix is upper or lower
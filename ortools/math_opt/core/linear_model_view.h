@@ -0,0 +1,75 @@
+// Copyright 2010-2024 Google LLC
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// A read only view of a linear model: variables, a linear (primary) objective
+// and linear constraints, with the ids of the ModelProto of the model.
+//
+// Solvers supporting it can be created from a LinearModelView (see
+// SolverInterface::ViewFactory) instead of a ModelProto, which lets them read
+// the model directly from its in-memory storage, without the copy of the
+// whole model into a ModelProto. The data is not owned by the view, and only
+// has to outlive the creation of the solver.
+#ifndef OR_TOOLS_MATH_OPT_CORE_LINEAR_MODEL_VIEW_H_
+#define OR_TOOLS_MATH_OPT_CORE_LINEAR_MODEL_VIEW_H_
+
+#include <cstdint>
+
+#include "absl/functional/function_ref.h"
+#include "absl/strings/string_view.h"
+
+namespace operations_research {
+namespace math_opt {
+
+class LinearModelView {
+ public:
+  virtual ~LinearModelView() = default;
+
+  virtual absl::string_view name() const = 0;
+
+  // The primary objective.
+  virtual bool maximize() const = 0;
+  virtual double objective_offset() const = 0;
+  virtual absl::string_view objective_name() const = 0;
+  // Calls `f` for each nonzero linear objective coefficient, in any order.
+  virtual void ForEachLinearObjectiveCoefficient(
+      absl::FunctionRef<void(int64_t variable_id, double coefficient)> f)
+      const = 0;
+
+  virtual int64_t num_variables() const = 0;
+  // Calls `f` for each variable, by increasing id.
+  virtual void ForEachVariable(
+      absl::FunctionRef<void(int64_t id, double lower_bound,
+                             double upper_bound, bool is_integer,
+                             absl::string_view name)>
+          f) const = 0;
+
+  virtual int64_t num_linear_constraints() const = 0;
+  // Calls `f` for each linear constraint, by increasing id.
+  virtual void ForEachLinearConstraint(
+      absl::FunctionRef<void(int64_t id, double lower_bound,
+                             double upper_bound, absl::string_view name)>
+          f) const = 0;
+
+  virtual int64_t num_linear_constraint_matrix_nonzeros() const = 0;
+  // Calls `f` for each nonzero coefficient of the linear constraint matrix, in
+  // any order.
+  virtual void ForEachLinearConstraintCoefficient(
+      absl::FunctionRef<void(int64_t linear_constraint_id, int64_t variable_id,
+                             double coefficient)>
+          f) const = 0;
+};
+
+}  // namespace math_opt
+}  // namespace operations_research
+
+#endif  // OR_TOOLS_MATH_OPT_CORE_LINEAR_MODEL_VIEW_H_
@@ -0,0 +1,180 @@
+// Copyright 2010-2024 Google LLC
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "ortools/math_opt/core/solve_session.h"
+
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "absl/status/status.h"
+#include "absl/status/statusor.h"
+#include "absl/synchronization/mutex.h"
+#include "ortools/base/status_macros.h"
+#include "ortools/math_opt/callback.pb.h"
+#include "ortools/math_opt/core/solver.h"
+#include "ortools/math_opt/model_update.pb.h"
+#include "ortools/math_opt/result.pb.h"
+#include "ortools/math_opt/rpc.pb.h"
+#include "ortools/math_opt/storage/model_storage.h"
+#include "ortools/util/solve_interrupter.h"
+#include "ortools/util/status_macros.h"
+
+namespace operations_research {
+namespace math_opt {
+namespace {
+
+StatusProto ToStatusProto(const absl::Status& status) {
+  StatusProto result;
+  result.set_code(static_cast<int>(status.code()));
+  result.set_message(std::string(status.message()));
+  return result;
+}
+
+}  // namespace
+
+void SolveSession::Process(const SessionRequest& request,
+                           const Respond& respond) {
+  if (request.has_interrupt()) {
+    Interrupt();
+    return;
+  }
+  if (status_.ok()) {
+    if (request.has_create() != (solver_ == nullptr)) {
+      status_ = absl::FailedPreconditionError(
+          solver_ == nullptr
+              ? "the first request of a session must be `create`"
+              : "`create` must only be the first request of a session");
+    } else {
+      switch (request.request_case()) {
+        case SessionRequest::kCreate:
+        case SessionRequest::kUpdate: {
+          const absl::StatusOr<bool> updated =
+              request.has_create() ? Create(request.create())
+                                   : Update(request.update());
+          if (updated.ok()) {
+            SessionResponse response;
+            response.set_updated(*updated);
+            respond(response);
+            return;
+          }
+          status_ = updated.status();
+          break;
+        }
+        case SessionRequest::kSolve: {
+          absl::StatusOr<SolveResultProto> result =
+              Solve(request.solve(), respond);
+          if (result.ok()) {
+            SessionResponse response;
+            *response.mutable_result() = *std::move(result);
+            respond(response);
+            return;
+          }
+          status_ = result.status();
+          break;
+        }
+        default:
+          status_ = absl::InvalidArgumentError("empty session request");
+      }
+    }
+  }
+  SessionResponse response;
+  *response.mutable_status() = ToStatusProto(status_);
+  respond(response);
+}
+
+void SolveSession::Interrupt() {
+  const absl::MutexLock lock(&interrupter_mutex_);
+  if (interrupter_ != nullptr) {
+    interrupter_->Interrupt();
+  }
+}
+
+absl::StatusOr<bool> SolveSession::Create(
+    const CreateSessionRequest& request) {
+  solver_type_ = request.solver_type();
+  initializer_ = request.initializer();
+  ASSIGN_OR_RETURN(storage_, ModelStorage::FromModelProto(request.model()));
+  ASSIGN_OR_RETURN(solver_, Solver::New(solver_type_, request.model(),
+                                        {.streamable = initializer_}));
+  return true;
+}
+
+absl::StatusOr<bool> SolveSession::Update(const ModelUpdateProto& update) {
+  RETURN_IF_ERROR(storage_->ApplyUpdateProto(update))
+      << "invalid model update";
+  ASSIGN_OR_RETURN(const bool updated, solver_->Update(update));
+  if (updated) {
+    return true;
+  }
+  OR_ASSIGN_OR_RETURN3(solver_,
+                       Solver::New(solver_type_, storage_->ExportModel(),
+                                   {.streamable = initializer_}),
+                       _ << "solver re-creation failed");
+  return false;
+}
+
+absl::StatusOr<SolveResultProto> SolveSession::Solve(
+    const SessionSolveRequest& request, const Respond& respond) {
+  if (request.callback_registration().add_cuts() ||
+      request.callback_registration().add_lazy_constraints()) {
+    return absl::InvalidArgumentError(
+        "the callbacks of a session can't add cuts or lazy constraints");
+  }
+  // The messages and callbacks can be called concurrently from the threads of
+  // the solver.
+  absl::Mutex respond_mutex;
+  const auto message_callback = [&](const std::vector<std::string>& messages) {
+    SessionResponse response;
+    for (const std::string& message : messages) {
+      response.add_messages(message);
+    }
+    const absl::MutexLock lock(&respond_mutex);
+    respond(response);
+  };
+  const auto callback = [&](const CallbackDataProto& callback_data) {
+    SessionResponse response;
+    *response.mutable_callback_data() = callback_data;
+    {
+      const absl::MutexLock lock(&respond_mutex);
+      respond(response);
+    }
+    return CallbackResultProto();
+  };
+  const bool has_callback =
+      !request.callback_registration().request_registration().empty();
+
+  SolveInterrupter interrupter;
+  {
+    const absl::MutexLock lock(&interrupter_mutex_);
+    interrupter_ = &interrupter;
+  }
+  absl::StatusOr<SolveResultProto> result = solver_->Solve(
+      {.parameters = request.parameters(),
+       .model_parameters = request.model_parameters(),
+       .message_callback = request.parameters().enable_output()
+                               ? Solver::MessageCallback(message_callback)
+                               : nullptr,
+       .callback_registration = request.callback_registration(),
+       .user_cb = has_callback ? Solver::Callback(callback) : nullptr,
+       .interrupter = &interrupter});
+  {
+    const absl::MutexLock lock(&interrupter_mutex_);
+    interrupter_ = nullptr;
+  }
+  return result;
+}
+
+}  // namespace math_opt
+}  // namespace operations_research
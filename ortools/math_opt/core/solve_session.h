@@ -0,0 +1,104 @@
+// Copyright 2010-2024 Google LLC
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// The server side of a solve session (see SessionRequest in rpc.proto),
+// independent of the transport: an RPC server passes the requests of the
+// stream of a client to Process(), and writes the responses back to the
+// client.
+//
+// Usage, in the handler of a bidirectional stream, reading the requests on a
+// thread and processing them on another one, so that the interrupt requests
+// are handled while a solve runs:
+//   SolveSession session;
+//   // Reading thread.
+//   SessionRequest request;
+//   while (stream->Read(&request)) {
+//     if (request.has_interrupt()) {
+//       session.Interrupt();
+//     } else {
+//       queue.Push(request);
+//     }
+//   }
+//   // Processing thread.
+//   while (queue.Pop(&request)) {
+//     session.Process(request, [&](const SessionResponse& response) {
+//       stream->Write(response);
+//     });
+//   }
+#ifndef OR_TOOLS_MATH_OPT_CORE_SOLVE_SESSION_H_
+#define OR_TOOLS_MATH_OPT_CORE_SOLVE_SESSION_H_
+
+#include <functional>
+#include <memory>
+
+#include "absl/base/thread_annotations.h"
+#include "absl/status/status.h"
+#include "absl/status/statusor.h"
+#include "absl/synchronization/mutex.h"
+#include "ortools/math_opt/core/solver.h"
+#include "ortools/math_opt/model_update.pb.h"
+#include "ortools/math_opt/parameters.pb.h"
+#include "ortools/math_opt/result.pb.h"
+#include "ortools/math_opt/rpc.pb.h"
+#include "ortools/math_opt/storage/model_storage.h"
+#include "ortools/util/solve_interrupter.h"
+
+namespace operations_research {
+namespace math_opt {
+
+class SolveSession {
+ public:
+  // Sends a response to the client. Responses are sent one at a time, from
+  // the thread calling Process() or from a thread of the solver.
+  using Respond = std::function<void(const SessionResponse&)>;
+
+  SolveSession() = default;
+  SolveSession(const SolveSession&) = delete;
+  SolveSession& operator=(const SolveSession&) = delete;
+
+  // Processes a request of the client, sending its responses with `respond`
+  // before returning. The error of a request is sent as a `status` response
+  // and ends the session.
+  //
+  // Process() must not be called concurrently; interrupt requests can instead
+  // be passed to Interrupt() while Process() runs.
+  void Process(const SessionRequest& request, const Respond& respond);
+
+  // Interrupts the running solve, if any. Thread-safe.
+  void Interrupt();
+
+ private:
+  absl::StatusOr<bool> Create(const CreateSessionRequest& request);
+  absl::StatusOr<bool> Update(const ModelUpdateProto& update);
+  absl::StatusOr<SolveResultProto> Solve(const SessionSolveRequest& request,
+                                         const Respond& respond);
+
+  // The first error of the session, or OK.
+  absl::Status status_;
+
+  SolverTypeProto solver_type_ = SOLVER_TYPE_UNSPECIFIED;
+  SolverInitializerProto initializer_;
+  // The model of the session, used to re-create the solver when it does not
+  // support an update.
+  std::unique_ptr<ModelStorage> storage_;
+  std::unique_ptr<Solver> solver_;
+
+  absl::Mutex interrupter_mutex_;
+  // The interrupter of the running solve, if any.
+  SolveInterrupter* interrupter_ ABSL_GUARDED_BY(interrupter_mutex_) = nullptr;
+};
+
+}  // namespace math_opt
+}  // namespace operations_research
+
+#endif  // OR_TOOLS_MATH_OPT_CORE_SOLVE_SESSION_H_
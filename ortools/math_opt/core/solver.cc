@@ -24,6 +24,7 @@
 #include "ortools/base/status_macros.h"
 #include "ortools/math_opt/callback.pb.h"
 #include "ortools/math_opt/core/concurrent_calls_guard.h"
+#include "ortools/math_opt/core/linear_model_view.h"
 #include "ortools/math_opt/core/math_opt_proto_utils.h"
 #include "ortools/math_opt/core/model_summary.h"
 #include "ortools/math_opt/core/non_streamable_solver_init_arguments.h"
@@ -98,6 +99,18 @@ absl::StatusOr<std::unique_ptr<Solver>> Solver::New(
   return result;
 }
 
+absl::StatusOr<std::unique_ptr<Solver>> Solver::NewFromView(
+    const SolverTypeProto solver_type, const LinearModelView& model,
+    const InitArgs& arguments) {
+  RETURN_IF_ERROR(internal::ValidateInitArgs(arguments, solver_type));
+  ASSIGN_OR_RETURN(ModelSummary summary, ValidateModel(model));
+  ASSIGN_OR_RETURN(auto underlying_solver,
+                   AllSolversRegistry::Instance()->CreateFromView(
+                       solver_type, model, arguments));
+  return absl::WrapUnique(
+      new Solver(std::move(underlying_solver), std::move(summary)));
+}
+
 absl::StatusOr<SolveResultProto> Solver::Solve(const SolveArgs& arguments) {
   ASSIGN_OR_RETURN(const auto guard,
                    ConcurrentCallsGuard::TryAcquire(concurrent_calls_tracker_));
@@ -21,6 +21,7 @@
 #include "absl/status/statusor.h"
 #include "ortools/math_opt/callback.pb.h"
 #include "ortools/math_opt/core/concurrent_calls_guard.h"
+#include "ortools/math_opt/core/linear_model_view.h"
 #include "ortools/math_opt/core/model_summary.h"
 #include "ortools/math_opt/core/solver_interface.h"
 #include "ortools/math_opt/infeasible_subsystem.pb.h"
@@ -129,6 +130,12 @@ class Solver {
       SolverTypeProto solver_type, const ModelProto& model,
       const InitArgs& arguments);
 
+  // Same as New() with a view of a linear model, for the solver types having a
+  // view factory (see AllSolversRegistry::HasViewFactory()).
+  static absl::StatusOr<std::unique_ptr<Solver>> NewFromView(
+      SolverTypeProto solver_type, const LinearModelView& model,
+      const InitArgs& arguments);
+
   Solver(const Solver&) = delete;
   Solver& operator=(const Solver&) = delete;
 
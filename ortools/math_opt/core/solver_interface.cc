@@ -35,7 +35,19 @@
 
 namespace operations_research {
 namespace math_opt {
-namespace {}  // namespace
+namespace {
+
+absl::Status SolverNotRegisteredError(const SolverTypeProto solver_type) {
+  std::string name = SolverTypeProto_Name(solver_type);
+  if (name.empty()) {
+    name = absl::StrCat("unknown(", static_cast<int>(solver_type), ")");
+  }
+  return util::InvalidArgumentErrorBuilder()
+         << "solver type " << name << " is not registered"
+         << ", support for this solver has not been compiled";
+}
+
+}  // namespace
 
 AllSolversRegistry* AllSolversRegistry::Instance() {
   static AllSolversRegistry* const instance = new AllSolversRegistry;
@@ -63,13 +75,35 @@ absl::StatusOr<std::unique_ptr<SolverInterface>> AllSolversRegistry::Create(
     factory = gtl::FindOrNull(registered_solvers_, solver_type);
   }
   if (factory == nullptr) {
-    std::string name = SolverTypeProto_Name(solver_type);
-    if (name.empty()) {
-      name = absl::StrCat("unknown(", static_cast<int>(solver_type), ")");
-    }
-    return util::InvalidArgumentErrorBuilder()
-           << "solver type " << name << " is not registered"
-           << ", support for this solver has not been compiled";
+    return SolverNotRegisteredError(solver_type);
+  }
+  return (*factory)(model, init_args);
+}
+
+void AllSolversRegistry::RegisterViewFactory(
+    const SolverTypeProto solver_type, SolverInterface::ViewFactory factory) {
+  bool inserted;
+  {
+    const absl::MutexLock lock(&mutex_);
+    inserted =
+        registered_view_factories_.emplace(solver_type, std::move(factory))
+            .second;
+  }
+  CHECK(inserted) << "View factory of solver type: "
+                  << ProtoEnumToString(solver_type) << " already registered.";
+}
+
+absl::StatusOr<std::unique_ptr<SolverInterface>>
+AllSolversRegistry::CreateFromView(
+    SolverTypeProto solver_type, const LinearModelView& model,
+    const SolverInterface::InitArgs& init_args) const {
+  const SolverInterface::ViewFactory* factory = nullptr;
+  {
+    const absl::MutexLock lock(&mutex_);
+    factory = gtl::FindOrNull(registered_view_factories_, solver_type);
+  }
+  if (factory == nullptr) {
+    return SolverNotRegisteredError(solver_type);
   }
   return (*factory)(model, init_args);
 }
@@ -79,6 +113,12 @@ bool AllSolversRegistry::IsRegistered(const SolverTypeProto solver_type) const {
   return registered_solvers_.contains(solver_type);
 }
 
+bool AllSolversRegistry::HasViewFactory(
+    const SolverTypeProto solver_type) const {
+  const absl::MutexLock lock(&mutex_);
+  return registered_view_factories_.contains(solver_type);
+}
+
 std::vector<SolverTypeProto> AllSolversRegistry::RegisteredSolvers() const {
   std::vector<SolverTypeProto> result;
   {
@@ -25,6 +25,7 @@
 #include "absl/strings/string_view.h"
 #include "absl/synchronization/mutex.h"
 #include "ortools/math_opt/callback.pb.h"
+#include "ortools/math_opt/core/linear_model_view.h"
 #include "ortools/math_opt/core/non_streamable_solver_init_arguments.h"
 #include "ortools/math_opt/infeasible_subsystem.pb.h"
 #include "ortools/math_opt/model.pb.h"
@@ -89,6 +90,16 @@ class SolverInterface {
       std::function<absl::StatusOr<std::unique_ptr<SolverInterface>>(
           const ModelProto& model, const InitArgs& init_args)>;
 
+  // An optional factory building a solver from a view of a linear model,
+  // without the ModelProto copy of the model. It must build the same solver as
+  // the Factory would with the ModelProto of the view.
+  //
+  // The implementation should assume the view is valid, with the same
+  // guarantees as the ModelProto of a Factory.
+  using ViewFactory =
+      std::function<absl::StatusOr<std::unique_ptr<SolverInterface>>(
+          const LinearModelView& model, const InitArgs& init_args)>;
+
   SolverInterface() = default;
   SolverInterface(const SolverInterface&) = delete;
   SolverInterface& operator=(const SolverInterface&) = delete;
@@ -174,9 +185,26 @@ class AllSolversRegistry {
       SolverTypeProto solver_type, const ModelProto& model,
       const SolverInterface::InitArgs& init_args) const;
 
+  // Maps the given view factory to the given solver type, which must also be
+  // registered with Register(). Calling this twice will result in an error,
+  // see MATH_OPT_REGISTER_SOLVER_VIEW_FACTORY defined below.
+  //
+  // Required: factory must be threadsafe.
+  void RegisterViewFactory(SolverTypeProto solver_type,
+                           SolverInterface::ViewFactory factory);
+
+  // Invokes the view factory associated to the solver type with the provided
+  // arguments.
+  absl::StatusOr<std::unique_ptr<SolverInterface>> CreateFromView(
+      SolverTypeProto solver_type, const LinearModelView& model,
+      const SolverInterface::InitArgs& init_args) const;
+
   // Whether a solver type is supported.
   bool IsRegistered(SolverTypeProto solver_type) const;
 
+  // Whether a solver type has a view factory.
+  bool HasViewFactory(SolverTypeProto solver_type) const;
+
   // List all supported solver types.
   std::vector<SolverTypeProto> RegisteredSolvers() const;
 
@@ -189,6 +217,8 @@ class AllSolversRegistry {
   mutable absl::Mutex mutex_;
   absl::flat_hash_map<SolverTypeProto, SolverInterface::Factory>
       registered_solvers_;
+  absl::flat_hash_map<SolverTypeProto, SolverInterface::ViewFactory>
+      registered_view_factories_;
 };
 
 // Use to ensure that a solver is registered exactly one time. Invoke in each cc
@@ -209,6 +239,22 @@ class AllSolversRegistry {
   }();                                                                     \
   }  // namespace
 
+// Macro to register a SolverInterface::ViewFactory, in addition to the factory
+// registered with MATH_OPT_REGISTER_SOLVER().
+//
+// Arguments:
+//   solver_type: A SolverTypeProto proto enum.
+//   view_factory: A SolverInterface::ViewFactory for solver_type.
+#define MATH_OPT_REGISTER_SOLVER_VIEW_FACTORY(solver_type, view_factory)   \
+  namespace {                                                              \
+  const void* const kRegisterSolverViewFactory ABSL_ATTRIBUTE_UNUSED =     \
+      [] {                                                                 \
+        AllSolversRegistry::Instance()->RegisterViewFactory(solver_type,   \
+                                                            view_factory); \
+        return nullptr;                                                    \
+      }();                                                                 \
+  }  // namespace
+
 }  // namespace math_opt
 }  // namespace operations_research
 
@@ -14,6 +14,7 @@
 #include "ortools/math_opt/cpp/model.h"
 
 #include <algorithm>
+#include <cstdint>
 #include <limits>
 #include <memory>
 #include <optional>
@@ -82,6 +83,44 @@ LinearConstraint Model::AddLinearConstraint(
   return LinearConstraint(storage(), constraint);
 }
 
+std::vector<Variable> Model::AddVariables(
+    absl::Span<const double> lower_bounds,
+    absl::Span<const double> upper_bounds, const bool is_integer,
+    absl::Span<const std::string> names) {
+  const VariableId first =
+      storage()->AddVariables(lower_bounds, upper_bounds, is_integer, names);
+  std::vector<Variable> result;
+  result.reserve(lower_bounds.size());
+  for (int64_t v = 0; v < lower_bounds.size(); ++v) {
+    result.push_back(Variable(storage(), first + VariableId(v)));
+  }
+  return result;
+}
+
+std::vector<LinearConstraint> Model::AddLinearConstraints(
+    absl::Span<const double> lower_bounds,
+    absl::Span<const double> upper_bounds, absl::Span<const int64_t> row_starts,
+    absl::Span<const Variable> variables,
+    absl::Span<const double> coefficients,
+    absl::Span<const std::string> names) {
+  std::vector<VariableId> variable_ids;
+  variable_ids.reserve(variables.size());
+  for (const Variable variable : variables) {
+    CheckModel(variable.storage());
+    variable_ids.push_back(variable.typed_id());
+  }
+  const LinearConstraintId first = storage()->AddLinearConstraints(
+      lower_bounds, upper_bounds, row_starts, variable_ids, coefficients,
+      names);
+  std::vector<LinearConstraint> result;
+  result.reserve(lower_bounds.size());
+  for (int64_t c = 0; c < lower_bounds.size(); ++c) {
+    result.push_back(
+        LinearConstraint(storage(), first + LinearConstraintId(c)));
+  }
+  return result;
+}
+
 std::vector<Variable> Model::Variables() const {
   std::vector<Variable> result;
   result.reserve(storage()->num_variables());
@@ -187,6 +187,17 @@ class Model {
   inline Variable AddIntegerVariable(double lower_bound, double upper_bound,
                                      absl::string_view name = "");
 
+  // Adds lower_bounds.size() variables to the model with the given bounds and
+  // integrality, and returns them. `names` is either empty, for unnamed
+  // variables, or has one name per variable.
+  //
+  // Faster than calling AddVariable() for each variable when building large
+  // models.
+  std::vector<Variable> AddVariables(absl::Span<const double> lower_bounds,
+                                     absl::Span<const double> upper_bounds,
+                                     bool is_integer,
+                                     absl::Span<const std::string> names = {});
+
   // Removes a variable from the model.
   //
   // It is an error to use any reference to this variable after this operation.
@@ -288,6 +299,33 @@ class Model {
   LinearConstraint AddLinearConstraint(
       const BoundedLinearExpression& bounded_expr, absl::string_view name = "");
 
+  // Adds lower_bounds.size() linear constraints to the model with the given
+  // bounds and terms, and returns them. `names` is either empty, for unnamed
+  // constraints, or has one name per constraint.
+  //
+  // The terms are given in compressed sparse row format: the terms of the i-th
+  // constraint are the `variables` and `coefficients` in the range
+  // [row_starts[i], row_starts[i + 1]). Zero coefficients are ignored, and the
+  // variables of a constraint must be unique.
+  //
+  // Usage, for the constraints 1 <= x + 2 * y <= 3 and 0 <= 4 * y <= 5:
+  //   model.AddLinearConstraints(/*lower_bounds=*/{1.0, 0.0},
+  //                              /*upper_bounds=*/{3.0, 5.0},
+  //                              /*row_starts=*/{0, 2, 3},
+  //                              /*variables=*/{x, y, y},
+  //                              /*coefficients=*/{1.0, 2.0, 4.0});
+  //
+  // Faster than calling AddLinearConstraint() for each constraint when
+  // building large models, and the update trackers are not visited for each
+  // term.
+  std::vector<LinearConstraint> AddLinearConstraints(
+      absl::Span<const double> lower_bounds,
+      absl::Span<const double> upper_bounds,
+      absl::Span<const int64_t> row_starts,
+      absl::Span<const Variable> variables,
+      absl::Span<const double> coefficients,
+      absl::Span<const std::string> names = {});
+
   // Removes a linear constraint from the model.
   //
   // It is an error to use any reference to this linear constraint after this
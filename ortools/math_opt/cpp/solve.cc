@@ -17,14 +17,18 @@
 #include <memory>
 #include <optional>
 #include <utility>
+#include <vector>
 
 #include "absl/memory/memory.h"
 #include "absl/status/status.h"
 #include "absl/status/statusor.h"
 #include "absl/synchronization/mutex.h"
+#include "absl/types/span.h"
 #include "ortools/base/status_macros.h"
+#include "ortools/base/threadpool.h"
 #include "ortools/math_opt/callback.pb.h"
 #include "ortools/math_opt/core/solver.h"
+#include "ortools/math_opt/core/solver_interface.h"
 #include "ortools/math_opt/cpp/callback.h"
 #include "ortools/math_opt/cpp/compute_infeasible_subsystem_arguments.h"
 #include "ortools/math_opt/cpp/compute_infeasible_subsystem_result.h"
@@ -38,7 +42,10 @@
 #include "ortools/math_opt/cpp/streamable_solver_init_arguments.h"
 #include "ortools/math_opt/cpp/update_tracker.h"
 #include "ortools/math_opt/infeasible_subsystem.pb.h"
+#include "ortools/math_opt/model.pb.h"
 #include "ortools/math_opt/storage/model_storage.h"
+#include "ortools/math_opt/storage/model_storage_view.h"
+#include "ortools/util/solve_interrupter.h"
 #include "ortools/util/status_macros.h"
 
 namespace operations_research {
@@ -53,6 +60,57 @@ Solver::InitArgs ToSolverInitArgs(const SolverInitArguments& arguments) {
   };
 }
 
+// Returns true if NewSolver() creates the solver from a view of `storage`
+// instead of its ModelProto: when the solver has a view factory and the model
+// is linear.
+bool NewSolverUsesView(const ModelStorage& storage,
+                       const SolverType solver_type) {
+  return AllSolversRegistry::Instance()->HasViewFactory(
+             EnumToProto(solver_type)) &&
+         ModelStorageView::IsLinear(storage);
+}
+
+// Returns a new solver of the model in `storage`. When NewSolverUsesView(),
+// the solver reads the storage directly instead of its ModelProto, saving a
+// copy of the whole model. Otherwise `model_proto`, if not null, must be the
+// export of `storage` with init_args.remove_names, and is used instead of
+// exporting the model again.
+absl::StatusOr<std::unique_ptr<Solver>> NewSolver(
+    const ModelStorage& storage, const SolverType solver_type,
+    const SolverInitArguments& init_args,
+    const ModelProto* const model_proto = nullptr) {
+  const SolverTypeProto solver_type_proto = EnumToProto(solver_type);
+  if (NewSolverUsesView(storage, solver_type)) {
+    return Solver::NewFromView(
+        solver_type_proto, ModelStorageView(storage, init_args.remove_names),
+        ToSolverInitArgs(init_args));
+  }
+  if (model_proto != nullptr) {
+    return Solver::New(solver_type_proto, *model_proto,
+                       ToSolverInitArgs(init_args));
+  }
+  return Solver::New(solver_type_proto,
+                     storage.ExportModel(init_args.remove_names),
+                     ToSolverInitArgs(init_args));
+}
+
+// Returns true if the termination of `result` proves the optimality of its
+// solution, or the infeasibility or unboundedness of the model.
+bool IsConclusive(const absl::StatusOr<SolveResult>& result) {
+  if (!result.ok()) {
+    return false;
+  }
+  switch (result->termination.reason) {
+    case TerminationReason::kOptimal:
+    case TerminationReason::kInfeasible:
+    case TerminationReason::kUnbounded:
+    case TerminationReason::kInfeasibleOrUnbounded:
+      return true;
+    default:
+      return false;
+  }
+}
+
 absl::StatusOr<SolveResult> CallSolve(
     Solver& solver, const ModelStorage* const expected_storage,
     const SolveArguments& arguments) {
@@ -89,7 +147,7 @@ absl::StatusOr<SolveResult> CallSolve(
     };
   }
   ASSIGN_OR_RETURN(
-      const SolveResultProto solve_result,
+      SolveResultProto solve_result,
       solver.Solve(
           {.parameters = arguments.parameters.Proto(),
            .model_parameters = arguments.model_parameters.Proto(),
@@ -101,6 +159,10 @@ absl::StatusOr<SolveResult> CallSolve(
   const absl::MutexLock lock(&mutex);
   RETURN_IF_ERROR(cb_status);
 
+  if (arguments.dense_values) {
+    return SolveResult::FromProtoWithDenseValues(expected_storage,
+                                                 std::move(solve_result));
+  }
   return SolveResult::FromProto(expected_storage, solve_result);
 }
 
@@ -111,12 +173,96 @@ absl::StatusOr<SolveResult> Solve(const Model& model,
                                   const SolveArguments& solve_args,
                                   const SolverInitArguments& init_args) {
   ASSIGN_OR_RETURN(const std::unique_ptr<Solver> solver,
-                   Solver::New(EnumToProto(solver_type),
-                               model.ExportModel(init_args.remove_names),
-                               ToSolverInitArgs(init_args)));
+                   NewSolver(*model.storage(), solver_type, init_args));
   return CallSolve(*solver, model.storage(), solve_args);
 }
 
+absl::StatusOr<SolveResult> SolveConcurrently(
+    const Model& model, absl::Span<const ConcurrentSolver> solvers,
+    const SolveInterrupter* const interrupter) {
+  if (solvers.empty()) {
+    return absl::InvalidArgumentError("no solver to run");
+  }
+  const ModelStorage& storage = *model.storage();
+  const int num_solvers = static_cast<int>(solvers.size());
+
+  // The exports of the model, indexed by init_args.remove_names.
+  std::optional<ModelProto> model_protos[2];
+  for (const ConcurrentSolver& solver : solvers) {
+    if (NewSolverUsesView(storage, solver.solver_type)) continue;
+    std::optional<ModelProto>& model_proto =
+        model_protos[solver.init_args.remove_names];
+    if (!model_proto.has_value()) {
+      model_proto = storage.ExportModel(solver.init_args.remove_names);
+    }
+  }
+
+  // Each solver has its own interrupter, triggered by the interrupter of its
+  // arguments, `interrupter`, or the first solver to conclude.
+  std::vector<SolveInterrupter> interrupters(num_solvers);
+  const auto interrupt_all = [&interrupters]() {
+    for (SolveInterrupter& solver_interrupter : interrupters) {
+      solver_interrupter.Interrupt();
+    }
+  };
+  const ScopedSolveInterrupterCallback interrupt_all_callback(interrupter,
+                                                              interrupt_all);
+
+  absl::Mutex mutex;
+  int winner = -1;
+  std::vector<absl::StatusOr<SolveResult>> results(
+      num_solvers, absl::UnknownError("solver did not run"));
+  const auto run_solver = [&](const int i) {
+    const ConcurrentSolver& solver = solvers[i];
+    SolveInterrupter& solver_interrupter = interrupters[i];
+    const ScopedSolveInterrupterCallback interrupt_callback(
+        solver.solve_args.interrupter,
+        [&solver_interrupter]() { solver_interrupter.Interrupt(); });
+    absl::StatusOr<SolveResult> result = [&]() -> absl::StatusOr<SolveResult> {
+      const std::optional<ModelProto>& model_proto =
+          model_protos[solver.init_args.remove_names];
+      ASSIGN_OR_RETURN(
+          const std::unique_ptr<Solver> new_solver,
+          NewSolver(storage, solver.solver_type, solver.init_args,
+                    model_proto.has_value() ? &*model_proto : nullptr));
+      SolveArguments solve_args = solver.solve_args;
+      solve_args.interrupter = &solver_interrupter;
+      return CallSolve(*new_solver, &storage, solve_args);
+    }();
+    bool interrupt_others = false;
+    {
+      const absl::MutexLock lock(&mutex);
+      if (winner == -1 && IsConclusive(result)) {
+        winner = i;
+        interrupt_others = true;
+      }
+      results[i] = std::move(result);
+    }
+    if (interrupt_others) interrupt_all();
+  };
+  {
+    std::unique_ptr<ThreadPool> thread_pool;
+    if (num_solvers > 1) {
+      thread_pool =
+          std::make_unique<ThreadPool>("SolveConcurrently", num_solvers - 1);
+      thread_pool->StartWorkers();
+    }
+    for (int i = 1; i < num_solvers; ++i) {
+      thread_pool->Schedule([&run_solver, i]() { run_solver(i); });
+    }
+    run_solver(0);
+    // Waits for the other solvers.
+  }
+
+  if (winner != -1) {
+    return std::move(results[winner]);
+  }
+  for (absl::StatusOr<SolveResult>& result : results) {
+    if (result.ok()) return std::move(result);
+  }
+  return std::move(results[0]);
+}
+
 absl::StatusOr<ComputeInfeasibleSubsystemResult> ComputeInfeasibleSubsystem(
     const Model& model, const SolverType solver_type,
     const ComputeInfeasibleSubsystemArguments& infeasible_subsystem_args,
@@ -140,11 +286,8 @@ absl::StatusOr<std::unique_ptr<IncrementalSolver>> IncrementalSolver::New(
     return absl::InvalidArgumentError("input model can't be null");
   }
   std::unique_ptr<UpdateTracker> update_tracker = model->NewUpdateTracker();
-  ASSIGN_OR_RETURN(const ModelProto model_proto,
-                   update_tracker->ExportModel(arguments.remove_names));
   ASSIGN_OR_RETURN(std::unique_ptr<Solver> solver,
-                   Solver::New(EnumToProto(solver_type), model_proto,
-                               ToSolverInitArgs(arguments)));
+                   NewSolver(*model->storage(), solver_type, arguments));
   return absl::WrapUnique<IncrementalSolver>(
       new IncrementalSolver(solver_type, std::move(arguments), model->storage(),
                             std::move(update_tracker), std::move(solver)));
@@ -182,12 +325,10 @@ absl::StatusOr<UpdateResult> IncrementalSolver::Update() {
     return UpdateResult(true, std::move(model_update));
   }
 
-  ASSIGN_OR_RETURN(const ModelProto model_proto,
-                   update_tracker_->ExportModel(init_args_.remove_names));
-  OR_ASSIGN_OR_RETURN3(solver_,
-                       Solver::New(EnumToProto(solver_type_), model_proto,
-                                   ToSolverInitArgs(init_args_)),
-                       _ << "solver re-creation failed");
+  // The storage is alive since the export of the update succeeded.
+  OR_ASSIGN_OR_RETURN3(
+      solver_, NewSolver(*expected_storage_, solver_type_, init_args_),
+      _ << "solver re-creation failed");
 
   return UpdateResult(false, std::move(model_update));
 }
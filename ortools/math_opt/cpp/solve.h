@@ -28,6 +28,7 @@
 #include <memory>
 
 #include "absl/status/statusor.h"
+#include "absl/types/span.h"
 #include "ortools/math_opt/core/solver.h"
 #include "ortools/math_opt/cpp/compute_infeasible_subsystem_arguments.h"  // IWYU pragma: export
 #include "ortools/math_opt/cpp/compute_infeasible_subsystem_result.h"  // IWYU pragma: export
@@ -40,6 +41,7 @@
 #include "ortools/math_opt/cpp/update_tracker.h"         // IWYU pragma: export
 #include "ortools/math_opt/parameters.pb.h"              // IWYU pragma: export
 #include "ortools/math_opt/storage/model_storage.h"
+#include "ortools/util/solve_interrupter.h"
 
 namespace operations_research {
 namespace math_opt {
@@ -88,6 +90,47 @@ using SolveFunction =
         const operations_research::math_opt::SolveArguments&,
         const operations_research::math_opt::SolverInitArguments&)>;
 
+// One of the solvers run by SolveConcurrently().
+struct ConcurrentSolver {
+  SolverType solver_type;
+
+  // The arguments of the solve of this solver. Its number of threads is set
+  // with solve_args.parameters.threads, and solve_args.interrupter, if set,
+  // only interrupts this solver.
+  //
+  // The callbacks are called from the thread of this solver.
+  SolveArguments solve_args;
+
+  SolverInitArguments init_args;
+};
+
+// Solves the input model with all the `solvers` in parallel, each on its own
+// thread, and returns the result of the first one to terminate with a proof:
+// an optimal solution, or a proof of infeasibility or unboundedness. The other
+// solvers are then interrupted.
+//
+// If no solver terminates with a proof (e.g. they all reach their time limit),
+// returns the result of the first solver of `solvers` that did not fail, or
+// the error of the first solver if they all failed.
+//
+// The model is exported at most once (per value of init_args.remove_names)
+// for all the solvers that need a ModelProto. It must not be modified during
+// the call. The optional `interrupter` interrupts all the solvers.
+//
+// Usage:
+//   SolveArguments glop_args;
+//   SolveArguments pdlp_args;
+//   pdlp_args.parameters.threads = 4;
+//   ASSIGN_OR_RETURN(
+//       const SolveResult result,
+//       SolveConcurrently(model, {{.solver_type = SolverType::kGlop,
+//                                  .solve_args = glop_args},
+//                                 {.solver_type = SolverType::kPdlp,
+//                                  .solve_args = pdlp_args}}));
+absl::StatusOr<SolveResult> SolveConcurrently(
+    const Model& model, absl::Span<const ConcurrentSolver> solvers,
+    const SolveInterrupter* interrupter = nullptr);
+
 // Computes an infeasible subsystem of the input model.
 //
 // A Status error will be returned if the inputs are invalid or there is an
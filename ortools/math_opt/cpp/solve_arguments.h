@@ -84,6 +84,22 @@ struct SolveArguments {
   //
   const SolveInterrupter* interrupter = nullptr;
 
+  // If true, the values of the variables and linear constraints of the
+  // solutions and rays (variable values, dual values and reduced costs) are not
+  // converted to VariableMap and LinearConstraintMap, which are left empty.
+  // They are instead kept as returned by the solver, and read without copy
+  // with the SolveResult::dense_*() functions.
+  //
+  // This is much faster for large models, for which building the maps can take
+  // longer than the solve.
+  //
+  // Usage:
+  //   ASSIGN_OR_RETURN(
+  //       const SolveResult result,
+  //       Solve(model, SolverType::kGlop, {.dense_values = true}));
+  //   const DenseValuesView x = result.dense_variable_values();
+  bool dense_values = false;
+
   // Returns a failure if the referenced variables and constraints don't belong
   // to the input expected_storage (which must not be nullptr). Also returns a
   // failure if callback events are registered but no callback is provided.
@@ -15,6 +15,7 @@
 
 #include <initializer_list>
 #include <limits>
+#include <memory>
 #include <optional>
 #include <ostream>
 #include <sstream>
@@ -519,6 +520,17 @@ absl::StatusOr<SolveResultProto> SolveResult::Proto() const {
   if (pdlp_solver_specific_output.ByteSizeLong() > 0) {
     *result.mutable_pdlp_output() = pdlp_solver_specific_output;
   }
+  if (dense_values != nullptr) {
+    for (int i = 0; i < dense_values->solutions_size(); ++i) {
+      result.mutable_solutions(i)->MergeFrom(dense_values->solutions(i));
+    }
+    for (int i = 0; i < dense_values->primal_rays_size(); ++i) {
+      result.mutable_primal_rays(i)->MergeFrom(dense_values->primal_rays(i));
+    }
+    for (int i = 0; i < dense_values->dual_rays_size(); ++i) {
+      result.mutable_dual_rays(i)->MergeFrom(dense_values->dual_rays(i));
+    }
+  }
   return result;
 }
 namespace {
@@ -534,7 +546,67 @@ TerminationProto UpgradedTerminationProtoForStatsMigration(
   return termination;
 }
 
+// Moves the values of `from` to `to`, only checking their sizes.
+absl::Status MoveDenseValues(SparseDoubleVectorProto& from,
+                             SparseDoubleVectorProto& to) {
+  to.Swap(&from);
+  if (to.ids_size() != to.values_size()) {
+    return util::InvalidArgumentErrorBuilder()
+           << "ids.size()=" << to.ids_size()
+           << " != values.size()=" << to.values_size();
+  }
+  return absl::OkStatus();
+}
+
+DenseValuesView ToView(const SparseDoubleVectorProto& vector) {
+  return {.ids = vector.ids(), .values = vector.values()};
+}
+
 }  // namespace
+absl::StatusOr<SolveResult> SolveResult::FromProtoWithDenseValues(
+    const ModelStorage* model, SolveResultProto solve_result_proto) {
+  auto values = std::make_shared<SolveResultProto>();
+  for (int i = 0; i < solve_result_proto.solutions_size(); ++i) {
+    SolutionProto& solution = *solve_result_proto.mutable_solutions(i);
+    SolutionProto& dense_solution = *values->add_solutions();
+    if (solution.has_primal_solution()) {
+      RETURN_IF_ERROR(MoveDenseValues(
+          *solution.mutable_primal_solution()->mutable_variable_values(),
+          *dense_solution.mutable_primal_solution()->mutable_variable_values()))
+          << "invalid variable_values of solution at index " << i;
+    }
+    if (solution.has_dual_solution()) {
+      DualSolutionProto& dual = *solution.mutable_dual_solution();
+      DualSolutionProto& dense_dual = *dense_solution.mutable_dual_solution();
+      RETURN_IF_ERROR(MoveDenseValues(*dual.mutable_dual_values(),
+                                      *dense_dual.mutable_dual_values()))
+          << "invalid dual_values of solution at index " << i;
+      RETURN_IF_ERROR(MoveDenseValues(*dual.mutable_reduced_costs(),
+                                      *dense_dual.mutable_reduced_costs()))
+          << "invalid reduced_costs of solution at index " << i;
+    }
+  }
+  for (int i = 0; i < solve_result_proto.primal_rays_size(); ++i) {
+    RETURN_IF_ERROR(MoveDenseValues(
+        *solve_result_proto.mutable_primal_rays(i)->mutable_variable_values(),
+        *values->add_primal_rays()->mutable_variable_values()))
+        << "invalid variable_values of primal ray at index " << i;
+  }
+  for (int i = 0; i < solve_result_proto.dual_rays_size(); ++i) {
+    DualRayProto& ray = *solve_result_proto.mutable_dual_rays(i);
+    DualRayProto& dense_ray = *values->add_dual_rays();
+    RETURN_IF_ERROR(MoveDenseValues(*ray.mutable_dual_values(),
+                                    *dense_ray.mutable_dual_values()))
+        << "invalid dual_values of dual ray at index " << i;
+    RETURN_IF_ERROR(MoveDenseValues(*ray.mutable_reduced_costs(),
+                                    *dense_ray.mutable_reduced_costs()))
+        << "invalid reduced_costs of dual ray at index " << i;
+  }
+  ASSIGN_OR_RETURN(SolveResult result, FromProto(model, solve_result_proto));
+  result.dense_values = std::move(values);
+  return result;
+}
+
 absl::StatusOr<SolveResult> SolveResult::FromProto(
     const ModelStorage* model, const SolveResultProto& solve_result_proto) {
   OR_ASSIGN_OR_RETURN3(
@@ -675,6 +747,50 @@ const VariableMap<BasisStatus>& SolveResult::variable_status() const {
   return solutions[0].basis->variable_status;
 }
 
+DenseValuesView SolveResult::dense_variable_values(
+    const int solution_index) const {
+  CHECK(dense_values != nullptr);
+  CHECK(solutions.at(solution_index).primal_solution.has_value());
+  return ToView(dense_values->solutions(solution_index)
+                    .primal_solution()
+                    .variable_values());
+}
+
+DenseValuesView SolveResult::dense_dual_values(const int solution_index) const {
+  CHECK(dense_values != nullptr);
+  CHECK(solutions.at(solution_index).dual_solution.has_value());
+  return ToView(
+      dense_values->solutions(solution_index).dual_solution().dual_values());
+}
+
+DenseValuesView SolveResult::dense_reduced_costs(
+    const int solution_index) const {
+  CHECK(dense_values != nullptr);
+  CHECK(solutions.at(solution_index).dual_solution.has_value());
+  return ToView(
+      dense_values->solutions(solution_index).dual_solution().reduced_costs());
+}
+
+DenseValuesView SolveResult::dense_ray_variable_values(
+    const int ray_index) const {
+  CHECK(dense_values != nullptr);
+  CHECK_LT(ray_index, dense_values->primal_rays_size());
+  return ToView(dense_values->primal_rays(ray_index).variable_values());
+}
+
+DenseValuesView SolveResult::dense_ray_dual_values(const int ray_index) const {
+  CHECK(dense_values != nullptr);
+  CHECK_LT(ray_index, dense_values->dual_rays_size());
+  return ToView(dense_values->dual_rays(ray_index).dual_values());
+}
+
+DenseValuesView SolveResult::dense_ray_reduced_costs(
+    const int ray_index) const {
+  CHECK(dense_values != nullptr);
+  CHECK_LT(ray_index, dense_values->dual_rays_size());
+  return ToView(dense_values->dual_rays(ray_index).reduced_costs());
+}
+
 namespace {
 // Prints only the vector size, not its content.
 template <typename T>
@@ -17,7 +17,9 @@
 #ifndef OR_TOOLS_MATH_OPT_CPP_SOLVE_RESULT_H_
 #define OR_TOOLS_MATH_OPT_CPP_SOLVE_RESULT_H_
 
+#include <cstdint>
 #include <initializer_list>
+#include <memory>
 #include <optional>
 #include <ostream>
 #include <string>
@@ -27,6 +29,7 @@
 #include "absl/status/status.h"
 #include "absl/status/statusor.h"
 #include "absl/time/time.h"
+#include "absl/types/span.h"
 #include "ortools/gscip/gscip.pb.h"
 #include "ortools/math_opt/cpp/enums.h"  // IWYU pragma: export
 #include "ortools/math_opt/cpp/linear_constraint.h"
@@ -455,6 +458,17 @@ void AbslStringify(Sink& sink, const Termination& termination) {
 }
 
 // The result of solving an optimization problem with Solve().
+// A view of values of the variables (or linear constraints) of a SolveResult,
+// by increasing id, see SolveArguments::dense_values.
+//
+// When ModelSolveParameters sets no filter, `ids` are the ids of all the
+// variables (or linear constraints) of the model, so that `values[i]` is the
+// value of the i-th one by increasing id, e.g. of model.SortedVariables()[i].
+struct DenseValuesView {
+  absl::Span<const int64_t> ids;
+  absl::Span<const double> values;
+};
+
 struct SolveResult {
   explicit SolveResult(Termination termination)
       : termination(std::move(termination)) {}
@@ -497,6 +511,16 @@ struct SolveResult {
   // Solver specific output from Pdlp. Only populated if Pdlp is used.
   SolveResultProto::PdlpOutput pdlp_solver_specific_output;
 
+  // The values of the variables and linear constraints of the solutions and
+  // rays when solving with SolveArguments::dense_values, nullptr else. They are
+  // read with the dense_*() functions below, and their maps in `solutions`,
+  // `primal_rays` and `dual_rays` are empty.
+  //
+  // The solutions(i) (resp. primal_rays(i) and dual_rays(i)) of this proto only
+  // have the variable_values, reduced_costs and dual_values of solutions[i]
+  // (resp. primal_rays[i] and dual_rays[i]).
+  std::shared_ptr<const SolveResultProto> dense_values;
+
   // Returns the SolveResult equivalent of solve_result_proto.
   //
   // Returns an error if:
@@ -520,6 +544,12 @@ struct SolveResult {
   static absl::StatusOr<SolveResult> FromProto(
       const ModelStorage* model, const SolveResultProto& solve_result_proto);
 
+  // Same as FromProto(), except that the values of the variables and linear
+  // constraints of the solutions and rays are moved to `dense_values` instead
+  // of being converted to maps. The ids of these values are not validated.
+  static absl::StatusOr<SolveResult> FromProtoWithDenseValues(
+      const ModelStorage* model, SolveResultProto solve_result_proto);
+
   // Returns the proto equivalent of this.
   //
   // Note that the proto uses a oneof for solver specific output. This method
@@ -635,6 +665,24 @@ struct SolveResult {
   // The variable basis status for the best solution. Will CHECK fail if the
   // best solution does not have an associated basis.
   const VariableMap<BasisStatus>& variable_status() const;
+
+  // The variable values of solutions[solution_index]. Will CHECK fail if
+  // dense_values is nullptr or if this solution has no primal solution.
+  DenseValuesView dense_variable_values(int solution_index = 0) const;
+
+  // The dual values and reduced costs of solutions[solution_index]. Will CHECK
+  // fail if dense_values is nullptr or if this solution has no dual solution.
+  DenseValuesView dense_dual_values(int solution_index = 0) const;
+  DenseValuesView dense_reduced_costs(int solution_index = 0) const;
+
+  // The variable values of primal_rays[ray_index]. Will CHECK fail if
+  // dense_values is nullptr.
+  DenseValuesView dense_ray_variable_values(int ray_index = 0) const;
+
+  // The dual values and reduced costs of dual_rays[ray_index]. Will CHECK fail
+  // if dense_values is nullptr.
+  DenseValuesView dense_ray_dual_values(int ray_index = 0) const;
+  DenseValuesView dense_ray_reduced_costs(int ray_index = 0) const;
 };
 
 // Prints a summary of the solve result on a single line.
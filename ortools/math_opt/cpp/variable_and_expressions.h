@@ -86,6 +86,15 @@
 // Pre C++20, avoid the use of std::accumulate and std::inner_product with
 // LinearExpression, they cause a quadratic blowup in running time.
 //
+// For expressions with a very large number of terms, a LinearExpressionBuilder
+// accumulates the terms in a flat buffer and only merges the duplicated
+// variables when the expression is built, e.g.
+//   LinearExpressionBuilder builder;
+//   builder.reserve(vars.size());
+//   builder.AddInnerProduct(doubles, vars);
+//   builder += 3.0;
+//   const LinearExpression e = builder.Build();
+//
 // While there is some complexity in the source, users typically should not need
 // to look at types other than Variable and LinearExpression too closely. Their
 // code usually will only refer to those types.
@@ -94,12 +103,16 @@
 
 #include <stdint.h>
 
+#include <cstdint>
+
 #include <initializer_list>
 #include <iterator>
 #include <limits>
 #include <ostream>
 #include <string>
+#include <type_traits>
 #include <utility>
+#include <vector>
 
 #include "absl/container/flat_hash_map.h"
 #include "absl/log/check.h"
@@ -207,8 +220,9 @@ inline LinearTerm operator*(Variable variable, double coefficient);
 inline LinearTerm operator/(LinearTerm term, double coefficient);
 inline LinearTerm operator/(Variable variable, double coefficient);
 
-// Forward declaration so that we may add it as a friend to LinearExpression
+// Forward declarations so that we may add them as friends to LinearExpression
 class QuadraticExpression;
+class LinearExpressionBuilder;
 
 // This class represents a sum of variables multiplied by coefficient and an
 // optional offset constant. For example: "3*x + 2*y + 5".
@@ -380,6 +394,7 @@ class LinearExpression {
   friend std::ostream& operator<<(std::ostream& ostr,
                                   const LinearExpression& expression);
   friend QuadraticExpression;
+  friend LinearExpressionBuilder;
 
   // Sets the storage_ to the input value if nullptr, else CHECKs that it is
   // equal. Also CHECKs that the input value is not nullptr.
@@ -412,6 +427,8 @@ class LinearExpression {
 // Prefer:
 //   expr.AddSum(items);
 //
+// The terms are accumulated with a LinearExpressionBuilder.
+//
 // See LinearExpression::AddSum() for a precise contract on the type Iterable.
 //
 // If the inner product cannot be represented as a LinearExpression, consider
@@ -440,6 +457,9 @@ inline LinearExpression Sum(const Iterable& items);
 // Prefer:
 //   expr.AddInnerProduct(left, right);
 //
+// The terms are accumulated with a LinearExpressionBuilder, so the products of
+// a number and a LinearExpression don't create temporary expressions.
+//
 // Requires that left and right have equal size, see
 // LinearExpression::AddInnerProduct for a precise contract on template types.
 //
@@ -449,6 +469,77 @@ template <typename LeftIterable, typename RightIterable>
 inline LinearExpression InnerProduct(const LeftIterable& left,
                                      const RightIterable& right);
 
+// Accumulates the terms of a LinearExpression in a flat buffer, the terms of
+// the same variable being merged only by Build().
+//
+// Adding a term to a LinearExpression looks up its variable in a hash map, and
+// operations like `coefficient * expression` create temporary expressions.
+// The builder instead appends the terms to a vector, which can be reserved
+// beforehand, and AddInnerProduct() scales the LinearExpression elements
+// without copying them. This is faster for large expressions, in particular
+// when they are built from many small expressions.
+//
+// Example:
+//   const std::vector<Variable> vars = ...;
+//   const std::vector<double> costs = ...;
+//   const Variable x = ...;
+//   LinearExpressionBuilder builder;
+//   builder.reserve(vars.size() + 1);
+//   builder.AddInnerProduct(costs, vars);
+//   builder += 2.0 * x;
+//   const LinearExpression objective = builder.Build();
+//
+// As for LinearExpression, all operations CHECK that the variables belong to
+// the same model.
+class LinearExpressionBuilder {
+ public:
+  LinearExpressionBuilder() = default;
+
+  // Reserves the buffer for `num_terms` terms, duplicates included.
+  inline void reserve(int64_t num_terms);
+
+  // The number of terms in the buffer, duplicates included.
+  int64_t num_terms() const { return static_cast<int64_t>(terms_.size()); }
+
+  inline LinearExpressionBuilder& operator+=(const LinearExpression& expr);
+  inline LinearExpressionBuilder& operator+=(const LinearTerm& term);
+  inline LinearExpressionBuilder& operator+=(Variable variable);
+  inline LinearExpressionBuilder& operator+=(double value);
+  inline LinearExpressionBuilder& operator-=(const LinearExpression& expr);
+  inline LinearExpressionBuilder& operator-=(const LinearTerm& term);
+  inline LinearExpressionBuilder& operator-=(Variable variable);
+  inline LinearExpressionBuilder& operator-=(double value);
+
+  // Adds `scale * expr`, without building it.
+  inline void AddScaled(double scale, const LinearExpression& expr);
+
+  // Same as LinearExpression::AddSum().
+  template <typename Iterable>
+  inline void AddSum(const Iterable& items);
+
+  // Same as LinearExpression::AddInnerProduct(), except that the products of a
+  // number and a LinearExpression are added with AddScaled().
+  template <typename LeftIterable, typename RightIterable>
+  inline void AddInnerProduct(const LeftIterable& left,
+                              const RightIterable& right);
+
+  // Returns the expression, merging the terms of the same variable, and resets
+  // the builder to an empty expression.
+  inline LinearExpression Build();
+
+ private:
+  inline void SetOrCheckStorage(const ModelStorage* storage);
+
+  // Adds `left * right`, see AddInnerProduct().
+  template <typename Left, typename Right>
+  inline void AddProduct(const Left& left, const Right& right);
+
+  // Same invariants as LinearExpression::storage_.
+  const ModelStorage* storage_ = nullptr;
+  std::vector<LinearTerm> terms_;
+  double offset_ = 0.0;
+};
+
 std::ostream& operator<<(std::ostream& ostr,
                          const LinearExpression& expression);
 
@@ -1659,7 +1750,9 @@ LinearExpression LinearExpression::Sum(const Iterable& items) {
 
 template <typename Iterable>
 LinearExpression Sum(const Iterable& items) {
-  return LinearExpression::Sum(items);
+  LinearExpressionBuilder builder;
+  builder.AddSum(items);
+  return builder.Build();
 }
 
 namespace internal {
@@ -1701,7 +1794,9 @@ LinearExpression LinearExpression::InnerProduct(const LeftIterable& left,
 template <typename LeftIterable, typename RightIterable>
 LinearExpression InnerProduct(const LeftIterable& left,
                               const RightIterable& right) {
-  return LinearExpression::InnerProduct(left, right);
+  LinearExpressionBuilder builder;
+  builder.AddInnerProduct(left, right);
+  return builder.Build();
 }
 
 const VariableMap<double>& LinearExpression::terms() const { return terms_; }
@@ -1710,6 +1805,136 @@ double LinearExpression::offset() const { return offset_; }
 
 const ModelStorage* LinearExpression::storage() const { return storage_; }
 
+////////////////////////////////////////////////////////////////////////////////
+// LinearExpressionBuilder
+////////////////////////////////////////////////////////////////////////////////
+
+void LinearExpressionBuilder::SetOrCheckStorage(
+    const ModelStorage* const storage) {
+  CHECK(storage != nullptr) << internal::kKeyHasNullModelStorage;
+  if (storage_ == nullptr) {
+    storage_ = storage;
+    return;
+  }
+  CHECK_EQ(storage, storage_) << internal::kObjectsFromOtherModelStorage;
+}
+
+void LinearExpressionBuilder::reserve(const int64_t num_terms) {
+  terms_.reserve(num_terms);
+}
+
+LinearExpressionBuilder& LinearExpressionBuilder::operator+=(
+    const LinearExpression& expr) {
+  AddScaled(1.0, expr);
+  return *this;
+}
+
+LinearExpressionBuilder& LinearExpressionBuilder::operator+=(
+    const LinearTerm& term) {
+  SetOrCheckStorage(term.variable.storage());
+  terms_.push_back(term);
+  return *this;
+}
+
+LinearExpressionBuilder& LinearExpressionBuilder::operator+=(
+    const Variable variable) {
+  return *this += LinearTerm(variable, 1.0);
+}
+
+LinearExpressionBuilder& LinearExpressionBuilder::operator+=(
+    const double value) {
+  offset_ += value;
+  return *this;
+}
+
+LinearExpressionBuilder& LinearExpressionBuilder::operator-=(
+    const LinearExpression& expr) {
+  AddScaled(-1.0, expr);
+  return *this;
+}
+
+LinearExpressionBuilder& LinearExpressionBuilder::operator-=(
+    const LinearTerm& term) {
+  return *this += LinearTerm(term.variable, -term.coefficient);
+}
+
+LinearExpressionBuilder& LinearExpressionBuilder::operator-=(
+    const Variable variable) {
+  return *this += LinearTerm(variable, -1.0);
+}
+
+LinearExpressionBuilder& LinearExpressionBuilder::operator-=(
+    const double value) {
+  offset_ -= value;
+  return *this;
+}
+
+void LinearExpressionBuilder::AddScaled(const double scale,
+                                        const LinearExpression& expr) {
+  // As in LinearExpression::operator+=, the keys of expr.terms_ have already
+  // been checked.
+  if (!expr.terms_.empty()) {
+    SetOrCheckStorage(expr.storage());
+    for (const auto& [v, coeff] : expr.terms_) {
+      terms_.push_back(LinearTerm(v, scale * coeff));
+    }
+  }
+  offset_ += scale * expr.offset_;
+}
+
+template <typename Iterable>
+void LinearExpressionBuilder::AddSum(const Iterable& items) {
+  for (const auto& item : items) {
+    *this += item;
+  }
+}
+
+template <typename Left, typename Right>
+void LinearExpressionBuilder::AddProduct(const Left& left, const Right& right) {
+  if constexpr (std::is_same_v<Right, LinearExpression> &&
+                std::is_convertible_v<Left, double>) {
+    AddScaled(left, right);
+  } else if constexpr (std::is_same_v<Left, LinearExpression> &&
+                       std::is_convertible_v<Right, double>) {
+    AddScaled(right, left);
+  } else {
+    *this += left * right;
+  }
+}
+
+template <typename LeftIterable, typename RightIterable>
+void LinearExpressionBuilder::AddInnerProduct(const LeftIterable& left,
+                                              const RightIterable& right) {
+  using std::begin;
+  using std::end;
+  auto l = begin(left);
+  auto r = begin(right);
+  const auto l_end = end(left);
+  const auto r_end = end(right);
+  for (; l != l_end && r != r_end; ++l, ++r) {
+    AddProduct(*l, *r);
+  }
+  CHECK(l == l_end)
+      << "left had more elements than right, sizes should be equal";
+  CHECK(r == r_end)
+      << "right had more elements than left, sizes should be equal";
+}
+
+LinearExpression LinearExpressionBuilder::Build() {
+  LinearExpression result;
+  result.offset_ = std::exchange(offset_, 0.0);
+  if (!terms_.empty()) {
+    result.storage_ = storage_;
+    result.terms_.reserve(terms_.size());
+    for (const LinearTerm& term : terms_) {
+      result.terms_[term.variable] += term.coefficient;
+    }
+  }
+  storage_ = nullptr;
+  terms_.clear();
+  return result;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 // VariablesEquality
 ////////////////////////////////////////////////////////////////////////////////
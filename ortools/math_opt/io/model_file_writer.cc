@@ -0,0 +1,648 @@
+// Copyright 2010-2024 Google LLC
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "ortools/math_opt/io/model_file_writer.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <cstdint>
+#include <functional>
+#include <limits>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "absl/container/flat_hash_set.h"
+#include "absl/log/check.h"
+#include "absl/status/status.h"
+#include "absl/strings/str_cat.h"
+#include "absl/strings/string_view.h"
+#include "absl/synchronization/notification.h"
+#include "absl/types/span.h"
+#include "google/protobuf/repeated_ptr_field.h"
+#include "ortools/base/file.h"
+#include "ortools/base/status_macros.h"
+#include "ortools/base/threadpool.h"
+#include "ortools/math_opt/model.pb.h"
+#include "ortools/math_opt/sparse_containers.pb.h"
+#include "ortools/math_opt/validators/model_validator.h"
+#include "ortools/util/fp_roundtrip_conv.h"
+
+namespace operations_research::math_opt {
+namespace {
+
+constexpr double kInf = std::numeric_limits<double>::infinity();
+
+// The approximate cost of a chunk, counting one per column or row and one per
+// nonzero: large enough for the scheduling to be negligible, small enough for
+// the memory of the chunks in flight to be.
+constexpr int64_t kChunkCost = int64_t{1} << 16;
+
+// The maximum number of terms on a line of an LP file, since some readers
+// limit the line length.
+constexpr int kMaxLpTermsPerLine = 16;
+
+absl::Status CheckIsLinear(const ModelProto& model) {
+  if (model.objective().quadratic_coefficients().row_ids_size() > 0 ||
+      !model.auxiliary_objectives().empty() ||
+      !model.quadratic_constraints().empty() ||
+      !model.second_order_cone_constraints().empty() ||
+      !model.sos1_constraints().empty() || !model.sos2_constraints().empty() ||
+      !model.indicator_constraints().empty()) {
+    return absl::InvalidArgumentError(
+        "only linear models can be written by chunks, use the functions of "
+        "mps_converter.h or lp_converter.h for this model");
+  }
+  return absl::OkStatus();
+}
+
+// Returns the index of `id` in the sorted `ids`.
+int64_t IndexOf(absl::Span<const int64_t> ids, const int64_t id) {
+  const auto it = std::lower_bound(ids.begin(), ids.end(), id);
+  DCHECK(it != ids.end() && *it == id) << id;
+  return it - ids.begin();
+}
+
+// Returns `names` if they are all valid and unique, else names generated from
+// the `ids` and `prefix`.
+std::vector<std::string> ExportedNames(
+    const google::protobuf::RepeatedPtrField<std::string>& names,
+    absl::Span<const int64_t> ids, absl::string_view prefix,
+    absl::string_view forbidden_first_chars, absl::string_view forbidden_chars,
+    absl::string_view reserved_name) {
+  constexpr int kMaxNameLength = 255;
+  bool valid = names.size() == ids.size();
+  absl::flat_hash_set<absl::string_view> seen;
+  for (int i = 0; valid && i < names.size(); ++i) {
+    const absl::string_view name = names[i];
+    valid = !name.empty() && name.size() <= kMaxNameLength &&
+            name != reserved_name &&
+            forbidden_first_chars.find(name.front()) ==
+                absl::string_view::npos &&
+            name.find_first_of(forbidden_chars) == absl::string_view::npos &&
+            seen.insert(name).second;
+  }
+  std::vector<std::string> result;
+  result.reserve(ids.size());
+  for (int i = 0; i < ids.size(); ++i) {
+    result.push_back(valid ? names[i] : absl::StrCat(prefix, ids[i]));
+  }
+  return result;
+}
+
+// Returns the boundaries of consecutive chunks of the items [0, num_items),
+// each one with a cost of about kChunkCost, the cost of item `i` being
+// 1 + extra_cost(i).
+std::vector<int64_t> ChunkBoundaries(
+    const int64_t num_items,
+    const std::function<int64_t(int64_t)>& extra_cost) {
+  std::vector<int64_t> boundaries = {0};
+  int64_t cost = 0;
+  for (int64_t i = 0; i < num_items; ++i) {
+    cost += 1 + extra_cost(i);
+    if (cost >= kChunkCost) {
+      boundaries.push_back(i + 1);
+      cost = 0;
+    }
+  }
+  if (boundaries.back() != num_items) {
+    boundaries.push_back(num_items);
+  }
+  return boundaries;
+}
+
+std::vector<int64_t> ChunkBoundaries(const int64_t num_items) {
+  return ChunkBoundaries(num_items, [](int64_t) { return 0; });
+}
+
+// Writes text to a file, the chunks of a section being formatted concurrently
+// ahead of their writing.
+class ParallelFileWriter {
+ public:
+  // Formats a chunk [begin, end) of the items of a section.
+  using FormatChunk =
+      std::function<void(int64_t begin, int64_t end, std::string& output)>;
+
+  ParallelFileWriter(File* const file, const int num_threads)
+      : file_(file), num_threads_(std::max(1, num_threads)) {
+    if (num_threads_ > 1) {
+      pool_ = std::make_unique<ThreadPool>(num_threads_);
+      pool_->StartWorkers();
+    }
+  }
+
+  absl::Status Write(const absl::string_view text) {
+    return file::WriteString(file_, text, file::Defaults());
+  }
+
+  // Formats the chunks [boundaries[c], boundaries[c + 1]) and writes them in
+  // order. At most 2 * num_threads chunks are in memory at any time.
+  absl::Status WriteChunks(absl::Span<const int64_t> boundaries,
+                           const FormatChunk& format);
+
+ private:
+  struct Chunk {
+    std::string text;
+    absl::Notification formatted;
+  };
+
+  File* const file_;
+  const int num_threads_;
+  // nullptr when num_threads_ is 1.
+  std::unique_ptr<ThreadPool> pool_;
+};
+
+absl::Status ParallelFileWriter::WriteChunks(
+    absl::Span<const int64_t> boundaries, const FormatChunk& format) {
+  const int64_t num_chunks = static_cast<int64_t>(boundaries.size()) - 1;
+  if (pool_ == nullptr) {
+    std::string text;
+    for (int64_t c = 0; c < num_chunks; ++c) {
+      text.clear();
+      format(boundaries[c], boundaries[c + 1], text);
+      RETURN_IF_ERROR(Write(text));
+    }
+    return absl::OkStatus();
+  }
+
+  const int64_t window = 2 * num_threads_;
+  std::vector<std::unique_ptr<Chunk>> chunks(window);
+  int64_t num_scheduled = 0;
+  const auto schedule_next = [&]() {
+    Chunk& chunk =
+        *(chunks[num_scheduled % window] = std::make_unique<Chunk>());
+    pool_->Schedule([&format, &chunk, begin = boundaries[num_scheduled],
+                     end = boundaries[num_scheduled + 1]]() {
+      format(begin, end, chunk.text);
+      chunk.formatted.Notify();
+    });
+    ++num_scheduled;
+  };
+  while (num_scheduled < std::min(window, num_chunks)) {
+    schedule_next();
+  }
+  // On errors, the chunks already scheduled are still waited for since they
+  // reference `format`.
+  absl::Status status;
+  for (int64_t c = 0; c < num_scheduled; ++c) {
+    std::unique_ptr<Chunk> chunk = std::move(chunks[c % window]);
+    chunk->formatted.WaitForNotification();
+    if (status.ok()) {
+      status = Write(chunk->text);
+    }
+    if (status.ok() && num_scheduled < num_chunks) {
+      schedule_next();
+    }
+  }
+  return status;
+}
+
+// Opens `filename`, calls write() and closes the file.
+absl::Status WriteFile(
+    const absl::string_view filename, const int num_threads,
+    const std::function<absl::Status(ParallelFileWriter&)>& write) {
+  File* file;
+  RETURN_IF_ERROR(file::Open(filename, "w", &file, file::Defaults()));
+  absl::Status status;
+  {
+    ParallelFileWriter writer(file, num_threads);
+    status = write(writer);
+  }
+  status.Update(file->Close(file::Defaults()));
+  delete file;
+  return status;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// MPS
+////////////////////////////////////////////////////////////////////////////////
+
+void AppendMpsEntry(const absl::string_view column, const absl::string_view row,
+                    const double value, std::string& output) {
+  absl::StrAppend(&output, " ", column, " ", row, " ",
+                  RoundTripDoubleFormat::ToString(value), "\n");
+}
+
+void AppendMpsBound(const absl::string_view type, const absl::string_view name,
+                    std::string& output) {
+  absl::StrAppend(&output, " ", type, " BOUND ", name, "\n");
+}
+
+void AppendMpsBound(const absl::string_view type, const absl::string_view name,
+                    const double value, std::string& output) {
+  absl::StrAppend(&output, " ", type, " BOUND ", name, " ",
+                  RoundTripDoubleFormat::ToString(value), "\n");
+}
+
+void AppendMpsBounds(const absl::string_view name, const double lb,
+                     const double ub, const bool is_integer,
+                     std::string& output) {
+  if (lb == -kInf && ub == kInf) {
+    AppendMpsBound("FR", name, output);
+    return;
+  }
+  if (is_integer && lb == 0.0 && ub == 1.0) {
+    AppendMpsBound("BV", name, output);
+    return;
+  }
+  if (lb == ub) {
+    AppendMpsBound("FX", name, lb, output);
+    return;
+  }
+  if (lb == -kInf) {
+    AppendMpsBound("MI", name, output);
+  } else if (lb != 0.0 || (is_integer && ub == kInf)) {
+    // The lower bound of 0 is the default one, but some readers consider
+    // integer columns without bounds to be binary.
+    AppendMpsBound("LO", name, lb, output);
+  }
+  if (ub != kInf) {
+    AppendMpsBound("UP", name, ub, output);
+  }
+}
+
+absl::Status WriteMps(const ModelProto& model, ParallelFileWriter& writer) {
+  const VariablesProto& variables = model.variables();
+  const LinearConstraintsProto& constraints = model.linear_constraints();
+  const SparseDoubleMatrixProto& matrix = model.linear_constraint_matrix();
+  const int64_t num_variables = variables.ids_size();
+  const int64_t num_constraints = constraints.ids_size();
+  const int64_t num_nonzeros = matrix.row_ids_size();
+
+  constexpr absl::string_view kObjectiveRow = "COST";
+  const std::vector<std::string> variable_names =
+      ExportedNames(variables.names(), variables.ids(), "V",
+                    /*forbidden_first_chars=*/"", /*forbidden_chars=*/" ",
+                    /*reserved_name=*/"");
+  const std::vector<std::string> constraint_names =
+      ExportedNames(constraints.names(), constraints.ids(), "C",
+                    /*forbidden_first_chars=*/"", /*forbidden_chars=*/" ",
+                    /*reserved_name=*/kObjectiveRow);
+
+  std::vector<double> objective(num_variables, 0.0);
+  for (int i = 0; i < model.objective().linear_coefficients().ids_size(); ++i) {
+    objective[IndexOf(variables.ids(),
+                      model.objective().linear_coefficients().ids(i))] =
+        model.objective().linear_coefficients().values(i);
+  }
+
+  // The COLUMNS section lists the matrix by column, the ModelProto stores it
+  // by row: column_nonzeros lists the nonzeros of the column j in
+  // [column_starts[j], column_starts[j + 1]), by increasing row.
+  std::vector<int64_t> nonzero_columns(num_nonzeros);
+  std::vector<int64_t> nonzero_rows(num_nonzeros);
+  std::vector<int64_t> column_starts(num_variables + 1, 0);
+  for (int64_t k = 0, row = 0; k < num_nonzeros; ++k) {
+    while (constraints.ids(row) != matrix.row_ids(k)) {
+      ++row;
+    }
+    nonzero_rows[k] = row;
+    nonzero_columns[k] = IndexOf(variables.ids(), matrix.column_ids(k));
+    ++column_starts[nonzero_columns[k] + 1];
+  }
+  for (int64_t j = 0; j < num_variables; ++j) {
+    column_starts[j + 1] += column_starts[j];
+  }
+  std::vector<int64_t> column_nonzeros(num_nonzeros);
+  {
+    std::vector<int64_t> next(column_starts.begin(), column_starts.end() - 1);
+    for (int64_t k = 0; k < num_nonzeros; ++k) {
+      column_nonzeros[next[nonzero_columns[k]]++] = k;
+    }
+  }
+  nonzero_columns.clear();
+  nonzero_columns.shrink_to_fit();
+
+  RETURN_IF_ERROR(writer.Write(absl::StrCat("NAME ", model.name(), "\n")));
+  if (model.objective().maximize()) {
+    RETURN_IF_ERROR(writer.Write("OBJSENSE\n    MAX\n"));
+  }
+
+  // ROWS section.
+  RETURN_IF_ERROR(writer.Write(absl::StrCat("ROWS\n N ", kObjectiveRow, "\n")));
+  RETURN_IF_ERROR(writer.WriteChunks(
+      ChunkBoundaries(num_constraints),
+      [&](const int64_t begin, const int64_t end, std::string& output) {
+        for (int64_t i = begin; i < end; ++i) {
+          const double lb = constraints.lower_bounds(i);
+          const double ub = constraints.upper_bounds(i);
+          absl::string_view type = "G";
+          if (lb == -kInf && ub == kInf) {
+            type = "N";
+          } else if (lb == ub) {
+            type = "E";
+          } else if (lb == -kInf) {
+            type = "L";
+          }
+          absl::StrAppend(&output, " ", type, " ", constraint_names[i], "\n");
+        }
+      }));
+
+  // COLUMNS section.
+  RETURN_IF_ERROR(writer.Write("COLUMNS\n"));
+  RETURN_IF_ERROR(writer.WriteChunks(
+      ChunkBoundaries(num_variables,
+                      [&](const int64_t j) {
+                        return column_starts[j + 1] - column_starts[j];
+                      }),
+      [&](const int64_t begin, const int64_t end, std::string& output) {
+        // The integer columns are enclosed in markers, for each run of
+        // consecutive integer columns.
+        bool in_integer_run = false;
+        for (int64_t j = begin; j <= end; ++j) {
+          const bool is_integer = j < end && variables.integers(j);
+          if (is_integer != in_integer_run) {
+            absl::StrAppend(&output, is_integer
+                                         ? " MARKER 'MARKER' 'INTORG'\n"
+                                         : " MARKER 'MARKER' 'INTEND'\n");
+            in_integer_run = is_integer;
+          }
+          if (j == end) break;
+          const std::string& name = variable_names[j];
+          // The objective entry is written even when zero for the columns
+          // without nonzeros, which would otherwise be undeclared.
+          if (objective[j] != 0.0 || column_starts[j] == column_starts[j + 1]) {
+            AppendMpsEntry(name, kObjectiveRow, objective[j], output);
+          }
+          for (int64_t p = column_starts[j]; p < column_starts[j + 1]; ++p) {
+            const int64_t k = column_nonzeros[p];
+            AppendMpsEntry(name, constraint_names[nonzero_rows[k]],
+                           matrix.coefficients(k), output);
+          }
+        }
+      }));
+
+  // RHS section, using Gurobi's convention for the objective offset.
+  RETURN_IF_ERROR(writer.Write("RHS\n"));
+  if (model.objective().offset() != 0.0) {
+    std::string offset;
+    AppendMpsEntry("RHS", kObjectiveRow, -model.objective().offset(), offset);
+    RETURN_IF_ERROR(writer.Write(offset));
+  }
+  RETURN_IF_ERROR(writer.WriteChunks(
+      ChunkBoundaries(num_constraints),
+      [&](const int64_t begin, const int64_t end, std::string& output) {
+        for (int64_t i = begin; i < end; ++i) {
+          const double lb = constraints.lower_bounds(i);
+          const double ub = constraints.upper_bounds(i);
+          if (lb != -kInf) {
+            AppendMpsEntry("RHS", constraint_names[i], lb, output);
+          } else if (ub != kInf) {
+            AppendMpsEntry("RHS", constraint_names[i], ub, output);
+          }
+        }
+      }));
+
+  // RANGES section.
+  const auto has_range = [&](const int64_t i) {
+    const double range =
+        constraints.upper_bounds(i) - constraints.lower_bounds(i);
+    return range != 0.0 && std::isfinite(range);
+  };
+  bool has_ranges = false;
+  for (int64_t i = 0; !has_ranges && i < num_constraints; ++i) {
+    has_ranges = has_range(i);
+  }
+  if (has_ranges) {
+    RETURN_IF_ERROR(writer.Write("RANGES\n"));
+    RETURN_IF_ERROR(writer.WriteChunks(
+        ChunkBoundaries(num_constraints),
+        [&](const int64_t begin, const int64_t end, std::string& output) {
+          for (int64_t i = begin; i < end; ++i) {
+            if (has_range(i)) {
+              AppendMpsEntry(
+                  "RANGE", constraint_names[i],
+                  constraints.upper_bounds(i) - constraints.lower_bounds(i),
+                  output);
+            }
+          }
+        }));
+  }
+
+  // BOUNDS section.
+  RETURN_IF_ERROR(writer.Write("BOUNDS\n"));
+  RETURN_IF_ERROR(writer.WriteChunks(
+      ChunkBoundaries(num_variables),
+      [&](const int64_t begin, const int64_t end, std::string& output) {
+        for (int64_t j = begin; j < end; ++j) {
+          AppendMpsBounds(variable_names[j], variables.lower_bounds(j),
+                          variables.upper_bounds(j), variables.integers(j),
+                          output);
+        }
+      }));
+
+  return writer.Write("ENDATA\n");
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// LP
+////////////////////////////////////////////////////////////////////////////////
+
+// Appends the terms `coefficient(k) variable(k)` for k in [begin, end), on
+// lines of at most kMaxLpTermsPerLine terms.
+void AppendLpTerms(const int64_t begin, const int64_t end,
+                   const std::function<int64_t(int64_t)>& variable,
+                   const std::function<double(int64_t)>& coefficient,
+                   absl::Span<const std::string> variable_names,
+                   std::string& output) {
+  int num_terms_on_line = 0;
+  for (int64_t k = begin; k < end; ++k) {
+    const double value = coefficient(k);
+    if (value == 0.0) continue;
+    if (num_terms_on_line == kMaxLpTermsPerLine) {
+      absl::StrAppend(&output, "\n");
+      num_terms_on_line = 0;
+    }
+    absl::StrAppend(&output, " ", value < 0.0 ? "" : "+",
+                    RoundTripDoubleFormat::ToString(value), " ",
+                    variable_names[variable(k)]);
+    ++num_terms_on_line;
+  }
+}
+
+absl::Status WriteLp(const ModelProto& model, ParallelFileWriter& writer) {
+  const VariablesProto& variables = model.variables();
+  const LinearConstraintsProto& constraints = model.linear_constraints();
+  const SparseDoubleMatrixProto& matrix = model.linear_constraint_matrix();
+  const SparseDoubleVectorProto& objective =
+      model.objective().linear_coefficients();
+  const int64_t num_variables = variables.ids_size();
+  const int64_t num_constraints = constraints.ids_size();
+
+  // The objective offset is the coefficient of a variable fixed to 1.
+  constexpr absl::string_view kConstant = "Constant";
+  constexpr absl::string_view kForbiddenFirstChars = "$.0123456789";
+  constexpr absl::string_view kForbiddenChars = " +-*/<>=:\\";
+  const std::vector<std::string> variable_names =
+      ExportedNames(variables.names(), variables.ids(), "V",
+                    kForbiddenFirstChars, kForbiddenChars, kConstant);
+  const std::vector<std::string> constraint_names =
+      ExportedNames(constraints.names(), constraints.ids(), "C",
+                    kForbiddenFirstChars, kForbiddenChars, "");
+
+  // The nonzeros of the row i are [row_starts[i], row_starts[i + 1]).
+  std::vector<int64_t> row_starts(num_constraints + 1, 0);
+  for (int64_t k = 0, row = 0; k < matrix.row_ids_size(); ++k) {
+    while (constraints.ids(row) != matrix.row_ids(k)) {
+      ++row;
+    }
+    ++row_starts[row + 1];
+  }
+  for (int64_t i = 0; i < num_constraints; ++i) {
+    row_starts[i + 1] += row_starts[i];
+  }
+
+  // Objective.
+  const bool use_constant =
+      model.objective().offset() != 0.0 || objective.ids_size() == 0;
+  RETURN_IF_ERROR(writer.Write(absl::StrCat(
+      model.objective().maximize() ? "Maximize\n" : "Minimize\n", " obj:")));
+  if (use_constant) {
+    const double offset = model.objective().offset();
+    RETURN_IF_ERROR(writer.Write(absl::StrCat(
+        " ", offset < 0.0 ? "" : "+", RoundTripDoubleFormat::ToString(offset),
+        " ", kConstant, "\n")));
+  }
+  RETURN_IF_ERROR(writer.WriteChunks(
+      ChunkBoundaries(objective.ids_size()),
+      [&](const int64_t begin, const int64_t end, std::string& output) {
+        AppendLpTerms(
+            begin, end,
+            [&](const int64_t k) {
+              return IndexOf(variables.ids(), objective.ids(k));
+            },
+            [&](const int64_t k) { return objective.values(k); },
+            variable_names, output);
+        absl::StrAppend(&output, "\n");
+      }));
+
+  // Constraints. The ranged ones are written as two constraints.
+  std::atomic<bool> constant_in_constraints = false;
+  RETURN_IF_ERROR(writer.Write("Subject To\n"));
+  RETURN_IF_ERROR(writer.WriteChunks(
+      ChunkBoundaries(num_constraints,
+                      [&](const int64_t i) {
+                        return row_starts[i + 1] - row_starts[i];
+                      }),
+      [&](const int64_t begin, const int64_t end, std::string& output) {
+        std::string terms;
+        for (int64_t i = begin; i < end; ++i) {
+          const double lb = constraints.lower_bounds(i);
+          const double ub = constraints.upper_bounds(i);
+          if (lb == -kInf && ub == kInf) continue;
+          terms.clear();
+          AppendLpTerms(
+              row_starts[i], row_starts[i + 1],
+              [&](const int64_t k) {
+                return IndexOf(variables.ids(), matrix.column_ids(k));
+              },
+              [&](const int64_t k) { return matrix.coefficients(k); },
+              variable_names, terms);
+          if (terms.empty()) {
+            absl::StrAppend(&terms, " +0 ", kConstant);
+            constant_in_constraints = true;
+          }
+          const std::string& name = constraint_names[i];
+          if (lb == ub) {
+            absl::StrAppend(&output, " ", name, ":", terms, " = ",
+                            RoundTripDoubleFormat::ToString(ub), "\n");
+            continue;
+          }
+          const bool ranged = lb != -kInf && ub != kInf;
+          if (ub != kInf) {
+            absl::StrAppend(&output, " ", name, ranged ? "_rhs:" : ":", terms,
+                            " <= ", RoundTripDoubleFormat::ToString(ub), "\n");
+          }
+          if (lb != -kInf) {
+            absl::StrAppend(&output, " ", name, ranged ? "_lhs:" : ":", terms,
+                            " >= ", RoundTripDoubleFormat::ToString(lb), "\n");
+          }
+        }
+      }));
+
+  // Bounds, written for all variables so that the unused ones are declared.
+  RETURN_IF_ERROR(writer.Write("Bounds\n"));
+  if (use_constant || constant_in_constraints) {
+    RETURN_IF_ERROR(writer.Write(absl::StrCat(" ", kConstant, " = 1\n")));
+  }
+  RETURN_IF_ERROR(writer.WriteChunks(
+      ChunkBoundaries(num_variables),
+      [&](const int64_t begin, const int64_t end, std::string& output) {
+        for (int64_t j = begin; j < end; ++j) {
+          const double lb = variables.lower_bounds(j);
+          const double ub = variables.upper_bounds(j);
+          const std::string& name = variable_names[j];
+          if (lb == -kInf && ub == kInf) {
+            absl::StrAppend(&output, " ", name, " free\n");
+          } else if (lb == ub) {
+            absl::StrAppend(&output, " ", name, " = ",
+                            RoundTripDoubleFormat::ToString(lb), "\n");
+          } else if (ub == kInf) {
+            absl::StrAppend(&output, " ", name,
+                            " >= ", RoundTripDoubleFormat::ToString(lb), "\n");
+          } else {
+            absl::StrAppend(&output, " ",
+                            lb == -kInf ? std::string("-inf")
+                                        : RoundTripDoubleFormat::ToString(lb),
+                            " <= ", name,
+                            " <= ", RoundTripDoubleFormat::ToString(ub), "\n");
+          }
+        }
+      }));
+
+  bool has_integers = false;
+  for (int64_t j = 0; !has_integers && j < num_variables; ++j) {
+    has_integers = variables.integers(j);
+  }
+  if (has_integers) {
+    RETURN_IF_ERROR(writer.Write("Generals\n"));
+    RETURN_IF_ERROR(writer.WriteChunks(
+        ChunkBoundaries(num_variables),
+        [&](const int64_t begin, const int64_t end, std::string& output) {
+          for (int64_t j = begin; j < end; ++j) {
+            if (variables.integers(j)) {
+              absl::StrAppend(&output, " ", variable_names[j], "\n");
+            }
+          }
+        }));
+  }
+
+  return writer.Write("End\n");
+}
+
+}  // namespace
+
+absl::Status WriteMpsFile(const ModelProto& model,
+                          const absl::string_view filename,
+                          const ModelFileWriterOptions& options) {
+  RETURN_IF_ERROR(ValidateModel(model, /*check_names=*/false).status());
+  RETURN_IF_ERROR(CheckIsLinear(model));
+  return WriteFile(filename, options.num_threads,
+                   [&](ParallelFileWriter& writer) {
+                     return WriteMps(model, writer);
+                   });
+}
+
+absl::Status WriteLpFile(const ModelProto& model,
+                         const absl::string_view filename,
+                         const ModelFileWriterOptions& options) {
+  RETURN_IF_ERROR(ValidateModel(model, /*check_names=*/false).status());
+  RETURN_IF_ERROR(CheckIsLinear(model));
+  return WriteFile(filename, options.num_threads,
+                   [&](ParallelFileWriter& writer) {
+                     return WriteLp(model, writer);
+                   });
+}
+
+}  // namespace operations_research::math_opt
@@ -0,0 +1,55 @@
+// Copyright 2010-2024 Google LLC
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Functions writing large linear models to MPS and LP files.
+//
+// Contrary to ModelProtoToMps() and ModelProtoToLp(), which build the whole
+// file contents in a std::string, going through an MPModelProto, the model is
+// written directly from the ModelProto, by chunks of columns or rows formatted
+// in parallel and written to the file as soon as they are ready. The memory
+// used is thus bounded by the chunks in flight.
+//
+// Only linear models are supported (continuous and integer variables, a
+// linear objective and linear constraints); the other ones must use the
+// functions of mps_converter.h and lp_converter.h.
+//
+// The names of the variables (resp. constraints) are used if they are all
+// valid in the file format and unique, else all of them are replaced by names
+// generated from the ids ("V<id>" and "C<id>"). The numbers are written so
+// that they are read back exactly.
+#ifndef OR_TOOLS_MATH_OPT_IO_MODEL_FILE_WRITER_H_
+#define OR_TOOLS_MATH_OPT_IO_MODEL_FILE_WRITER_H_
+
+#include "absl/status/status.h"
+#include "absl/strings/string_view.h"
+#include "ortools/math_opt/model.pb.h"
+
+namespace operations_research::math_opt {
+
+struct ModelFileWriterOptions {
+  // The number of threads formatting the chunks of the file, the calling
+  // thread writing them. With 1, the file is formatted by the calling thread.
+  int num_threads = 4;
+};
+
+// Writes the model to `filename` in the free MPS format.
+absl::Status WriteMpsFile(const ModelProto& model, absl::string_view filename,
+                          const ModelFileWriterOptions& options = {});
+
+// Writes the model to `filename` in the "CPLEX LP" format.
+absl::Status WriteLpFile(const ModelProto& model, absl::string_view filename,
+                         const ModelFileWriterOptions& options = {});
+
+}  // namespace operations_research::math_opt
+
+#endif  // OR_TOOLS_MATH_OPT_IO_MODEL_FILE_WRITER_H_
@@ -13,20 +13,30 @@
 
 #include "ortools/math_opt/labs/solution_feasibility_checker.h"
 
+#include <algorithm>
 #include <cmath>
+#include <cstdint>
+#include <limits>
+#include <memory>
 #include <string>
+#include <utility>
 #include <vector>
 
 #include "absl/algorithm/container.h"
+#include "absl/memory/memory.h"
 #include "absl/status/status.h"
 #include "absl/status/statusor.h"
 #include "absl/strings/str_cat.h"
 #include "absl/strings/str_format.h"
 #include "absl/strings/str_join.h"
+#include "absl/synchronization/blocking_counter.h"
+#include "absl/types/span.h"
 #include "ortools/base/mathutil.h"
 #include "ortools/base/status_builder.h"
 #include "ortools/base/status_macros.h"
+#include "ortools/base/threadpool.h"
 #include "ortools/math_opt/cpp/math_opt.h"
+#include "ortools/math_opt/storage/model_storage.h"
 #include "ortools/util/fp_roundtrip_conv.h"
 
 namespace operations_research::math_opt {
@@ -283,6 +293,250 @@ absl::StatusOr<ModelSubset> CheckPrimalSolutionFeasibility(
 
 namespace {
 
+// Returns by how much `value` is out of [lower_bound, upper_bound], 0.0 if it
+// is in.
+double BoundViolation(const double value, const double lower_bound,
+                      const double upper_bound) {
+  return std::max({0.0, lower_bound - value, value - upper_bound});
+}
+
+// Returns num_ranges + 1 boundaries of consecutive ranges of [0, num_items),
+// of about the same cost, where starts[i + 1] - starts[i] is the cost of the
+// item i (or 0 if `starts` is empty), plus one.
+std::vector<int64_t> RangeBoundaries(const int num_ranges,
+                                     const int64_t num_items,
+                                     absl::Span<const int64_t> starts) {
+  const int64_t total_cost = num_items + (starts.empty() ? 0 : starts.back());
+  std::vector<int64_t> boundaries = {0};
+  int64_t item = 0;
+  for (int r = 1; r < num_ranges; ++r) {
+    const int64_t target = total_cost * r / num_ranges;
+    while (item < num_items &&
+           item + (starts.empty() ? 0 : starts[item]) < target) {
+      ++item;
+    }
+    boundaries.push_back(item);
+  }
+  boundaries.push_back(num_items);
+  return boundaries;
+}
+
+// The violations found in a range of LinearFeasibilityChecker.
+struct RangeViolations {
+  std::vector<std::pair<int64_t, ModelSubset::Bounds>> variable_bounds;
+  std::vector<int64_t> variable_integrality;
+  std::vector<std::pair<int64_t, ModelSubset::Bounds>> linear_constraints;
+  double max_variable_bound_violation = 0.0;
+  double max_integrality_violation = 0.0;
+  double max_linear_constraint_violation = 0.0;
+};
+
+}  // namespace
+
+absl::StatusOr<std::unique_ptr<LinearFeasibilityChecker>>
+LinearFeasibilityChecker::New(const Model& model,
+                              const FeasibilityCheckerOptions& options,
+                              const int num_threads) {
+  RETURN_IF_ERROR(ValidateOptions(options));
+  if (num_threads < 1) {
+    return util::InvalidArgumentErrorBuilder()
+           << "invalid num_threads value: " << num_threads;
+  }
+  if (model.num_quadratic_constraints() > 0 ||
+      model.num_second_order_cone_constraints() > 0 ||
+      model.num_sos1_constraints() > 0 || model.num_sos2_constraints() > 0 ||
+      model.num_indicator_constraints() > 0) {
+    return absl::InvalidArgumentError(
+        "LinearFeasibilityChecker only supports linear constraints, use "
+        "CheckPrimalSolutionFeasibility() for this model");
+  }
+  if (model.num_variables() > std::numeric_limits<int32_t>::max()) {
+    return util::InvalidArgumentErrorBuilder()
+           << "too many variables: " << model.num_variables();
+  }
+  auto checker = absl::WrapUnique(new LinearFeasibilityChecker(options));
+
+  checker->variables_ = model.SortedVariables();
+  const int64_t num_variables = checker->variables_.size();
+  std::vector<int32_t> variable_index(model.next_variable_id(), -1);
+  checker->variable_lower_bounds_.reserve(num_variables);
+  checker->variable_upper_bounds_.reserve(num_variables);
+  checker->variable_is_integer_.reserve(num_variables);
+  for (int32_t j = 0; j < num_variables; ++j) {
+    const Variable variable = checker->variables_[j];
+    variable_index[variable.id()] = j;
+    checker->variable_lower_bounds_.push_back(variable.lower_bound());
+    checker->variable_upper_bounds_.push_back(variable.upper_bound());
+    checker->variable_is_integer_.push_back(variable.is_integer());
+  }
+
+  checker->linear_constraints_ = model.SortedLinearConstraints();
+  const int64_t num_rows = checker->linear_constraints_.size();
+  std::vector<int64_t> row_index(model.next_linear_constraint_id(), -1);
+  checker->constraint_lower_bounds_.reserve(num_rows);
+  checker->constraint_upper_bounds_.reserve(num_rows);
+  for (int64_t i = 0; i < num_rows; ++i) {
+    const LinearConstraint constraint = checker->linear_constraints_[i];
+    row_index[constraint.id()] = i;
+    checker->constraint_lower_bounds_.push_back(constraint.lower_bound());
+    checker->constraint_upper_bounds_.push_back(constraint.upper_bound());
+  }
+
+  // Builds the CSR matrix by a counting sort of the nonzeros by row.
+  std::vector<int64_t>& row_starts = checker->row_starts_;
+  row_starts.assign(num_rows + 1, 0);
+  model.storage()->ForEachLinearConstraintCoefficient(
+      [&](const LinearConstraintId row, VariableId, double) {
+        ++row_starts[row_index[row.value()] + 1];
+      });
+  for (int64_t i = 0; i < num_rows; ++i) {
+    row_starts[i + 1] += row_starts[i];
+  }
+  const int64_t num_nonzeros = row_starts.back();
+  std::vector<std::pair<int32_t, double>> nonzeros(num_nonzeros);
+  {
+    std::vector<int64_t> next(row_starts.begin(), row_starts.end() - 1);
+    model.storage()->ForEachLinearConstraintCoefficient(
+        [&](const LinearConstraintId row, const VariableId variable,
+            const double coefficient) {
+          nonzeros[next[row_index[row.value()]]++] = {
+              variable_index[variable.value()], coefficient};
+        });
+  }
+  checker->columns_.reserve(num_nonzeros);
+  checker->coefficients_.reserve(num_nonzeros);
+  for (int64_t i = 0; i < num_rows; ++i) {
+    // Sorting the rows makes the activities independent of the storage order,
+    // and the accesses to the values more local.
+    std::sort(nonzeros.begin() + row_starts[i],
+              nonzeros.begin() + row_starts[i + 1]);
+    for (int64_t k = row_starts[i]; k < row_starts[i + 1]; ++k) {
+      checker->columns_.push_back(nonzeros[k].first);
+      checker->coefficients_.push_back(nonzeros[k].second);
+    }
+  }
+
+  checker->range_rows_ = RangeBoundaries(num_threads, num_rows, row_starts);
+  checker->range_variables_ = RangeBoundaries(num_threads, num_variables, {});
+  if (num_threads > 1) {
+    checker->pool_ = std::make_unique<ThreadPool>(num_threads - 1);
+    checker->pool_->StartWorkers();
+  }
+  return checker;
+}
+
+absl::StatusOr<LinearFeasibilityResult> LinearFeasibilityChecker::Check(
+    const VariableMap<double>& variable_values) const {
+  if (variable_values.size() != variables_.size()) {
+    return util::InvalidArgumentErrorBuilder()
+           << "`variable_values` has " << variable_values.size()
+           << " entries but the model has " << variables_.size()
+           << " variables";
+  }
+  std::vector<double> values;
+  values.reserve(variables_.size());
+  for (const Variable variable : variables_) {
+    const auto it = variable_values.find(variable);
+    if (it == variable_values.end()) {
+      return util::InvalidArgumentErrorBuilder()
+             << "Variable present in `model` but not `variable_values`: "
+             << variable;
+    }
+    values.push_back(it->second);
+  }
+  return Check(values);
+}
+
+absl::StatusOr<LinearFeasibilityResult> LinearFeasibilityChecker::Check(
+    absl::Span<const double> variable_values) const {
+  if (variable_values.size() != variables_.size()) {
+    return util::InvalidArgumentErrorBuilder()
+           << "`variable_values` has " << variable_values.size()
+           << " values but the model has " << variables_.size()
+           << " variables";
+  }
+  const int num_ranges = static_cast<int>(range_rows_.size()) - 1;
+  std::vector<RangeViolations> range_violations(num_ranges);
+  const auto check_range = [&](const int r) {
+    RangeViolations& violations = range_violations[r];
+    for (int64_t j = range_variables_[r]; j < range_variables_[r + 1]; ++j) {
+      const double value = variable_values[j];
+      const double lower_bound = variable_lower_bounds_[j];
+      const double upper_bound = variable_upper_bounds_[j];
+      const ModelSubset::Bounds bounds =
+          CheckBoundedConstraint(value, lower_bound, upper_bound, options_);
+      if (!bounds.empty()) {
+        violations.variable_bounds.push_back({j, bounds});
+        violations.max_variable_bound_violation =
+            std::max(violations.max_variable_bound_violation,
+                     BoundViolation(value, lower_bound, upper_bound));
+      }
+      if (variable_is_integer_[j]) {
+        const double fractionality = std::fabs(value - std::round(value));
+        violations.max_integrality_violation =
+            std::max(violations.max_integrality_violation, fractionality);
+        if (fractionality > options_.integrality_tolerance) {
+          violations.variable_integrality.push_back(j);
+        }
+      }
+    }
+    for (int64_t i = range_rows_[r]; i < range_rows_[r + 1]; ++i) {
+      double activity = 0.0;
+      for (int64_t k = row_starts_[i]; k < row_starts_[i + 1]; ++k) {
+        activity += coefficients_[k] * variable_values[columns_[k]];
+      }
+      const double lower_bound = constraint_lower_bounds_[i];
+      const double upper_bound = constraint_upper_bounds_[i];
+      const ModelSubset::Bounds bounds =
+          CheckBoundedConstraint(activity, lower_bound, upper_bound, options_);
+      if (!bounds.empty()) {
+        violations.linear_constraints.push_back({i, bounds});
+        violations.max_linear_constraint_violation =
+            std::max(violations.max_linear_constraint_violation,
+                     BoundViolation(activity, lower_bound, upper_bound));
+      }
+    }
+  };
+  if (pool_ == nullptr) {
+    check_range(0);
+  } else {
+    absl::BlockingCounter counter(num_ranges - 1);
+    for (int r = 1; r < num_ranges; ++r) {
+      pool_->Schedule([&, r]() {
+        check_range(r);
+        counter.DecrementCount();
+      });
+    }
+    check_range(0);
+    counter.Wait();
+  }
+
+  LinearFeasibilityResult result;
+  ModelSubset& violated = result.violated_constraints;
+  for (const RangeViolations& violations : range_violations) {
+    for (const auto [j, bounds] : violations.variable_bounds) {
+      violated.variable_bounds[variables_[j]] = bounds;
+    }
+    for (const int64_t j : violations.variable_integrality) {
+      violated.variable_integrality.insert(variables_[j]);
+    }
+    for (const auto [i, bounds] : violations.linear_constraints) {
+      violated.linear_constraints[linear_constraints_[i]] = bounds;
+    }
+    result.max_variable_bound_violation =
+        std::max(result.max_variable_bound_violation,
+                 violations.max_variable_bound_violation);
+    result.max_integrality_violation = std::max(
+        result.max_integrality_violation, violations.max_integrality_violation);
+    result.max_linear_constraint_violation =
+        std::max(result.max_linear_constraint_violation,
+                 violations.max_linear_constraint_violation);
+  }
+  return result;
+}
+
+namespace {
+
 // `variables` and `variable_values` must share a common Model.
 std::string VariableValuesAsString(std::vector<Variable> variables,
                                    const VariableMap<double>& variable_values) {
@@ -14,10 +14,14 @@
 #ifndef OR_TOOLS_MATH_OPT_LABS_SOLUTION_FEASIBILITY_CHECKER_H_
 #define OR_TOOLS_MATH_OPT_LABS_SOLUTION_FEASIBILITY_CHECKER_H_
 
+#include <cstdint>
+#include <memory>
 #include <string>
 #include <vector>
 
 #include "absl/status/statusor.h"
+#include "absl/types/span.h"
+#include "ortools/base/threadpool.h"
 #include "ortools/math_opt/cpp/math_opt.h"
 
 namespace operations_research::math_opt {
@@ -79,6 +83,98 @@ absl::StatusOr<std::vector<std::string>> ViolatedConstraintsAsStrings(
     const Model& model, const ModelSubset& violated_constraints,
     const VariableMap<double>& variable_values);
 
+// The result of LinearFeasibilityChecker::Check().
+struct LinearFeasibilityResult {
+  // The violated constraints, within the tolerances of the options.
+  ModelSubset violated_constraints;
+
+  // The largest violations, ignoring the tolerances (0.0 when all constraints
+  // of the kind are exactly satisfied).
+  double max_variable_bound_violation = 0.0;
+  double max_integrality_violation = 0.0;
+  double max_linear_constraint_violation = 0.0;
+};
+
+// Checks the feasibility of primal solutions of a linear model, like
+// CheckPrimalSolutionFeasibility(), but much faster when many solutions of a
+// large model are checked.
+//
+// The variable bounds and the linear constraints are copied at construction,
+// the linear constraint matrix in compressed sparse row (CSR) format, so that
+// each check is a sparse matrix-vector product, split in ranges of rows of
+// about the same number of nonzeros evaluated in parallel. The changes of the
+// model after the construction are ignored, but the model must outlive the
+// results since they reference its variables and constraints.
+//
+// Usage:
+//   ASSIGN_OR_RETURN(const std::unique_ptr<LinearFeasibilityChecker> checker,
+//                    LinearFeasibilityChecker::New(model, options,
+//                                                  /*num_threads=*/8));
+//   for (const Solution& solution : solutions) {
+//     ASSIGN_OR_RETURN(
+//         const LinearFeasibilityResult result,
+//         checker->Check(solution.primal_solution->variable_values));
+//     ...
+//   }
+class LinearFeasibilityChecker {
+ public:
+  // Returns an InvalidArgument error if the options are invalid or if the
+  // model has constraints other than linear ones. The objectives are ignored.
+  static absl::StatusOr<std::unique_ptr<LinearFeasibilityChecker>> New(
+      const Model& model, const FeasibilityCheckerOptions& options = {},
+      int num_threads = 1);
+
+  LinearFeasibilityChecker(const LinearFeasibilityChecker&) = delete;
+  LinearFeasibilityChecker& operator=(const LinearFeasibilityChecker&) =
+      delete;
+
+  // The variables of the model, sorted by id.
+  const std::vector<Variable>& variables() const { return variables_; }
+
+  // Returns an InvalidArgument error if `variable_values` does not contain an
+  // entry for each variable of the model (and no extras).
+  //
+  // Thread-safe.
+  absl::StatusOr<LinearFeasibilityResult> Check(
+      const VariableMap<double>& variable_values) const;
+
+  // Same as above, with the values of variables() in the same order, which
+  // avoids the hash map look-ups.
+  absl::StatusOr<LinearFeasibilityResult> Check(
+      absl::Span<const double> variable_values) const;
+
+ private:
+  explicit LinearFeasibilityChecker(const FeasibilityCheckerOptions& options)
+      : options_(options) {}
+
+  const FeasibilityCheckerOptions options_;
+
+  std::vector<Variable> variables_;
+  std::vector<double> variable_lower_bounds_;
+  std::vector<double> variable_upper_bounds_;
+  std::vector<bool> variable_is_integer_;
+
+  std::vector<LinearConstraint> linear_constraints_;
+  std::vector<double> constraint_lower_bounds_;
+  std::vector<double> constraint_upper_bounds_;
+
+  // The nonzeros of the linear constraint i are [row_starts_[i],
+  // row_starts_[i + 1]), sorted by column, the column j being the variable
+  // variables_[j].
+  std::vector<int64_t> row_starts_;
+  std::vector<int32_t> columns_;
+  std::vector<double> coefficients_;
+
+  // The ranges checked in parallel: the range r contains the rows
+  // [range_rows_[r], range_rows_[r + 1]) and the variables
+  // [range_variables_[r], range_variables_[r + 1]).
+  std::vector<int64_t> range_rows_;
+  std::vector<int64_t> range_variables_;
+
+  // nullptr with a single thread.
+  std::unique_ptr<ThreadPool> pool_;
+};
+
 }  // namespace  operations_research::math_opt
 
 #endif  // OR_TOOLS_MATH_OPT_LABS_SOLUTION_FEASIBILITY_CHECKER_H_
@@ -46,6 +46,7 @@
 #include "ortools/lp_data/lp_types.h"
 #include "ortools/math_opt/callback.pb.h"
 #include "ortools/math_opt/core/inverted_bounds.h"
+#include "ortools/math_opt/core/linear_model_view.h"
 #include "ortools/math_opt/core/math_opt_proto_utils.h"
 #include "ortools/math_opt/core/solver_interface.h"
 #include "ortools/math_opt/core/sparse_vector_view.h"
@@ -212,6 +213,23 @@ void UpdateIdIndexMap(glop::StrictITIVector<IndexType, bool> indices_to_delete,
   }
 }
 
+// Removes the values at the deleted indices, re-indexing the others in the
+// same way as Glop does (see UpdateIdIndexMap()).
+template <typename IndexType, typename T>
+void DeleteIndices(
+    const glop::StrictITIVector<IndexType, bool>& indices_to_delete,
+    glop::StrictITIVector<IndexType, T>& values) {
+  DCHECK_EQ(values.size(), indices_to_delete.size());
+  IndexType new_index(0);
+  for (IndexType index(0); index < values.size(); ++index) {
+    if (!indices_to_delete[index]) {
+      values[new_index] = values[index];
+      ++new_index;
+    }
+  }
+  values.resize(new_index);
+}
+
 void GlopSolver::DeleteVariables(absl::Span<const int64_t> ids_to_delete) {
   const glop::ColIndex num_cols = linear_program_.num_variables();
   glop::StrictITIVector<glop::ColIndex, bool> columns_to_delete(num_cols,
@@ -221,6 +239,9 @@ void GlopSolver::DeleteVariables(absl::Span<const int64_t> ids_to_delete) {
   }
   linear_program_.DeleteColumns(columns_to_delete);
   UpdateIdIndexMap<glop::ColIndex>(columns_to_delete, num_cols, variables_);
+  if (warm_start_basis_.has_value()) {
+    DeleteIndices(columns_to_delete, warm_start_basis_->variable_statuses);
+  }
 }
 
 void GlopSolver::DeleteLinearConstraints(
@@ -233,6 +254,9 @@ void GlopSolver::DeleteLinearConstraints(
   linear_program_.DeleteRows(rows_to_delete);
   UpdateIdIndexMap<glop::RowIndex>(rows_to_delete, num_rows,
                                    linear_constraints_);
+  if (warm_start_basis_.has_value()) {
+    DeleteIndices(rows_to_delete, warm_start_basis_->constraint_statuses);
+  }
 }
 
 void GlopSolver::AddLinearConstraints(
@@ -760,6 +784,36 @@ void GlopSolver::SetGlopBasis(const BasisProto& basis) {
   lp_solver_.SetInitialBasis(variable_statuses, constraint_statuses);
 }
 
+void GlopSolver::ResizeWarmStartBasis() {
+  DCHECK(warm_start_basis_.has_value());
+  // The new variables are appended to linear_program_ and start at their
+  // default bound, the slacks of the new constraints are basic, which keeps
+  // the basis square.
+  warm_start_basis_->variable_statuses.resize(linear_program_.num_variables(),
+                                              glop::VariableStatus::FREE);
+  warm_start_basis_->constraint_statuses.resize(
+      linear_program_.num_constraints(), glop::ConstraintStatus::BASIC);
+}
+
+void GlopSolver::SaveWarmStart(const glop::ProblemStatus status) {
+  internal_warm_start_ = false;
+  warm_start_basis_.reset();
+  if (status == glop::ProblemStatus::ABNORMAL ||
+      status == glop::ProblemStatus::INVALID_PROBLEM ||
+      status == glop::ProblemStatus::IMPRECISE) {
+    return;
+  }
+  if (lp_solver_.GetParameters().use_preprocessing()) {
+    // The internal state of lp_solver_ is the one of the presolved model, only
+    // the basis of linear_program_ can be reused.
+    warm_start_basis_ = {.variable_statuses = lp_solver_.variable_statuses(),
+                         .constraint_statuses =
+                             lp_solver_.constraint_statuses()};
+  } else {
+    internal_warm_start_ = true;
+  }
+}
+
 absl::StatusOr<SolveResultProto> GlopSolver::Solve(
     const SolveParametersProto& parameters,
     const ModelSolveParametersProto& model_parameters,
@@ -770,17 +824,31 @@ absl::StatusOr<SolveResultProto> GlopSolver::Solve(
                                                 /*supported_events=*/{}));
 
   const absl::Time start = absl::Now();
+  // The solves after an Update() start from the basis of the previous solve,
+  // unless the user provides one or chooses the presolve: the basis of a
+  // presolved model does not apply to linear_program_.
+  const bool warm_start =
+      !model_parameters.has_initial_basis() &&
+      (internal_warm_start_ || warm_start_basis_.has_value()) &&
+      parameters.presolve() == EMPHASIS_UNSPECIFIED &&
+      !parameters.glop().has_use_preprocessing();
   ASSIGN_OR_RETURN(
       const glop::GlopParameters glop_parameters,
-      MergeSolveParameters(
-          parameters,
-          /*setting_initial_basis=*/model_parameters.has_initial_basis(),
-          /*has_message_callback=*/message_cb != nullptr,
-          linear_program_.IsMaximizationProblem()));
+      MergeSolveParameters(parameters,
+                           /*setting_initial_basis=*/
+                           model_parameters.has_initial_basis() || warm_start,
+                           /*has_message_callback=*/message_cb != nullptr,
+                           linear_program_.IsMaximizationProblem()));
   lp_solver_.SetParameters(glop_parameters);
 
   if (model_parameters.has_initial_basis()) {
     SetGlopBasis(model_parameters.initial_basis());
+  } else if (warm_start && warm_start_basis_.has_value()) {
+    // Otherwise lp_solver_ warm starts from its internal state, reusing the
+    // factorization of the previous basis when the matrix is unchanged.
+    ResizeWarmStartBasis();
+    lp_solver_.SetInitialBasis(warm_start_basis_->variable_statuses,
+                               warm_start_basis_->constraint_statuses);
   }
 
   std::atomic<bool> interrupt_solve = false;
@@ -822,6 +890,7 @@ absl::StatusOr<SolveResultProto> GlopSolver::Solve(
 
   const glop::ProblemStatus status =
       lp_solver_.SolveWithTimeLimit(linear_program_, time_limit.get());
+  SaveWarmStart(status);
   const absl::Duration solve_time = absl::Now() - start;
   return MakeSolveResult(status, model_parameters, interrupter, solve_time);
 }
@@ -849,11 +918,81 @@ absl::StatusOr<std::unique_ptr<SolverInterface>> GlopSolver::New(
   return solver;
 }
 
+absl::StatusOr<std::unique_ptr<SolverInterface>> GlopSolver::NewFromView(
+    const LinearModelView& model, const InitArgs&) {
+  bool has_integer_variables = false;
+  model.ForEachVariable([&](int64_t, double, double, const bool is_integer,
+                            absl::string_view) {
+    has_integer_variables |= is_integer;
+  });
+  if (has_integer_variables) {
+    return absl::InvalidArgumentError(
+        "Glop does not support integer variables");
+  }
+  auto solver = absl::WrapUnique(new GlopSolver);
+  glop::LinearProgram& lp = solver->linear_program_;
+  // As in New(), inverted bounds must not be CHECKed.
+  lp.SetDcheckBounds(false);
+
+  lp.SetName(model.name());
+  lp.SetMaximizationProblem(model.maximize());
+  lp.SetObjectiveOffset(model.objective_offset());
+
+  solver->variables_.reserve(model.num_variables());
+  model.ForEachVariable([&](const int64_t id, const double lower_bound,
+                            const double upper_bound, bool,
+                            const absl::string_view name) {
+    const glop::ColIndex col_index = lp.CreateNewVariable();
+    lp.SetVariableBounds(col_index, lower_bound, upper_bound);
+    lp.SetVariableName(col_index, name);
+    gtl::InsertOrDie(&solver->variables_, id, col_index);
+  });
+  model.ForEachLinearObjectiveCoefficient(
+      [&](const int64_t variable_id, const double coefficient) {
+        lp.SetObjectiveCoefficient(solver->variables_.at(variable_id),
+                                   coefficient);
+      });
+
+  solver->linear_constraints_.reserve(model.num_linear_constraints());
+  model.ForEachLinearConstraint([&](const int64_t id, const double lower_bound,
+                                    const double upper_bound,
+                                    const absl::string_view name) {
+    const glop::RowIndex row_index = lp.CreateNewConstraint();
+    lp.SetConstraintBounds(row_index, lower_bound, upper_bound);
+    lp.SetConstraintName(row_index, name);
+    gtl::InsertOrDie(&solver->linear_constraints_, id, row_index);
+  });
+  model.ForEachLinearConstraintCoefficient(
+      [&](const int64_t linear_constraint_id, const int64_t variable_id,
+          const double coefficient) {
+        lp.SetCoefficient(solver->linear_constraints_.at(linear_constraint_id),
+                          solver->variables_.at(variable_id), coefficient);
+      });
+  lp.CleanUp();
+  return solver;
+}
+
 absl::StatusOr<bool> GlopSolver::Update(const ModelUpdateProto& model_update) {
   if (!UpdateIsSupported(model_update, kGlopSupportedStructures)) {
     return false;
   }
 
+  if (internal_warm_start_ &&
+      (!model_update.deleted_variable_ids().empty() ||
+       !model_update.deleted_linear_constraint_ids().empty())) {
+    // The deletions re-index linear_program_, which invalidates the internal
+    // state of lp_solver_; the basis is kept instead, with the new indices.
+    warm_start_basis_ = {.variable_statuses = lp_solver_.variable_statuses(),
+                         .constraint_statuses =
+                             lp_solver_.constraint_statuses()};
+    internal_warm_start_ = false;
+  }
+  if (warm_start_basis_.has_value()) {
+    // Takes into account the variables and constraints added by the previous
+    // updates.
+    ResizeWarmStartBasis();
+  }
+
   if (model_update.objective_updates().has_direction_update()) {
     linear_program_.SetMaximizationProblem(
         model_update.objective_updates().direction_update());
@@ -890,6 +1029,7 @@ GlopSolver::ComputeInfeasibleSubsystem(const SolveParametersProto&,
 }
 
 MATH_OPT_REGISTER_SOLVER(SOLVER_TYPE_GLOP, GlopSolver::New)
+MATH_OPT_REGISTER_SOLVER_VIEW_FACTORY(SOLVER_TYPE_GLOP, GlopSolver::NewFromView)
 
 }  // namespace math_opt
 }  // namespace operations_research
@@ -17,6 +17,7 @@
 #include <stdint.h>
 
 #include <memory>
+#include <optional>
 
 #include "absl/container/flat_hash_map.h"
 #include "absl/status/status.h"
@@ -29,6 +30,7 @@
 #include "ortools/lp_data/lp_types.h"
 #include "ortools/math_opt/callback.pb.h"
 #include "ortools/math_opt/core/inverted_bounds.h"
+#include "ortools/math_opt/core/linear_model_view.h"
 #include "ortools/math_opt/core/solver_interface.h"
 #include "ortools/math_opt/infeasible_subsystem.pb.h"
 #include "ortools/math_opt/model.pb.h"
@@ -47,6 +49,9 @@ class GlopSolver : public SolverInterface {
  public:
   static absl::StatusOr<std::unique_ptr<SolverInterface>> New(
       const ModelProto& model, const InitArgs& init_args);
+  // Same as New() but reads the model from `model`, without a ModelProto.
+  static absl::StatusOr<std::unique_ptr<SolverInterface>> NewFromView(
+      const LinearModelView& model, const InitArgs& init_args);
 
   absl::StatusOr<SolveResultProto> Solve(
       const SolveParametersProto& parameters,
@@ -100,9 +105,29 @@ class GlopSolver : public SolverInterface {
 
   void SetGlopBasis(const BasisProto& basis);
 
+  // Resizes warm_start_basis_, which must be set, to the size of
+  // linear_program_.
+  void ResizeWarmStartBasis();
+  // Saves what the next solve can warm start from, after a solve that returned
+  // `status`.
+  void SaveWarmStart(glop::ProblemStatus status);
+
+  struct GlopBasis {
+    glop::VariableStatusRow variable_statuses;
+    glop::ConstraintStatusColumn constraint_statuses;
+  };
+
   glop::LinearProgram linear_program_;
   glop::LPSolver lp_solver_;
 
+  // True if the next solve can warm start from the internal state of
+  // lp_solver_, i.e. the last solve did not presolve linear_program_ and it
+  // was not re-indexed since.
+  bool internal_warm_start_ = false;
+  // Otherwise, the basis of the last solve, if any, with the indices of
+  // linear_program_ (a variable or constraint added since has no entry).
+  std::optional<GlopBasis> warm_start_basis_;
+
   absl::flat_hash_map<int64_t, glop::ColIndex> variables_;
   absl::flat_hash_map<int64_t, glop::RowIndex> linear_constraints_;
 };
@@ -301,39 +301,41 @@ absl::Status GScipSolver::AddVariables(
   return absl::OkStatus();
 }
 
-absl::StatusOr<bool> GScipSolver::UpdateVariables(
+absl::Status GScipSolver::PrepareBinaryVariableForBound(SCIP_VAR* const var,
+                                                        const double bound) {
+  // gSCIP (and SCIP actually) upgrades the variable type to kBinary if the
+  // bounds passed to AddVariable() are both in {0.0, 1.0}. Changing a bound of
+  // a binary variable then raises an assertion in SCIP if the bound is not in
+  // [0.0, 1.0] (the bounds in between are rounded), so we first downgrade the
+  // variable to kInteger.
+  if (gscip_->VarType(var) == GScipVarType::kBinary &&
+      (bound < 0.0 || bound > 1.0)) {
+    RETURN_IF_ERROR(gscip_->SetVarType(var, GScipVarType::kInteger));
+  }
+  return absl::OkStatus();
+}
+
+absl::Status GScipSolver::UpdateVariables(
     const VariableUpdatesProto& variable_updates) {
+  // We intentionally update vartype first to ensure the bound updates below
+  // see the up-to-date variable types. The bound updates can then be applied
+  // in place, including on binary variables, which keeps the SCIP problem (and
+  // its plugins) across solves.
   for (const auto [id, is_integer] : MakeView(variable_updates.integers())) {
-    // We intentionally update vartype first to ensure the checks below against
-    // binary variables are against the up-to-date model.
-    SCIP_VAR* const var = variables_.at(id);
-    if (gscip_->VarType(var) == GScipVarType::kBinary) {
-      // We reject bound updates on binary variables as they can lead to
-      // crashes, or unexpected round-trip values if the vartype changes.
-      return false;
-    }
-    RETURN_IF_ERROR(
-        gscip_->SetVarType(var, GScipVarTypeFromIsInteger(is_integer)));
+    RETURN_IF_ERROR(gscip_->SetVarType(variables_.at(id),
+                                       GScipVarTypeFromIsInteger(is_integer)));
   }
   for (const auto [id, lb] : MakeView(variable_updates.lower_bounds())) {
     SCIP_VAR* const var = variables_.at(id);
-    if (gscip_->VarType(var) == GScipVarType::kBinary) {
-      // We reject bound updates on binary variables as they can lead to
-      // crashes, or unexpected round-trip values if the vartype changes.
-      return false;
-    }
+    RETURN_IF_ERROR(PrepareBinaryVariableForBound(var, lb));
     RETURN_IF_ERROR(gscip_->SetLb(var, lb));
   }
   for (const auto [id, ub] : MakeView(variable_updates.upper_bounds())) {
     SCIP_VAR* const var = variables_.at(id);
-    if (gscip_->VarType(var) == GScipVarType::kBinary) {
-      // We reject bound updates on binary variables as they can lead to
-      // crashes, or unexpected round-trip values if the vartype changes.
-      return false;
-    }
+    RETURN_IF_ERROR(PrepareBinaryVariableForBound(var, ub));
     RETURN_IF_ERROR(gscip_->SetUb(var, ub));
   }
-  return true;
+  return absl::OkStatus();
 }
 
 // SCIP does not natively support quadratic objectives, so we formulate them
@@ -1221,10 +1223,7 @@ absl::StatusOr<bool> GScipSolver::Update(const ModelUpdateProto& model_update) {
     RETURN_IF_ERROR(gscip_->SetObjectiveOffset(
         model_update.objective_updates().offset_update()));
   }
-  if (const auto response = UpdateVariables(model_update.variable_updates());
-      !response.ok() || !(*response)) {
-    return response;
-  }
+  RETURN_IF_ERROR(UpdateVariables(model_update.variable_updates()));
   const absl::flat_hash_map<int64_t, double> linear_objective_updates =
       SparseDoubleVectorAsMap(
           model_update.objective_updates().linear_coefficients());
@@ -94,10 +94,12 @@ class GScipSolver : public SolverInterface {
                             const absl::flat_hash_map<int64_t, double>&
                                 linear_objective_coefficients);
 
-  // Update existing variables' parameters. Returns false if the update cannot
-  // be performed (namely, if attempting to update bounds on a binary variable).
-  absl::StatusOr<bool> UpdateVariables(
-      const VariableUpdatesProto& variable_updates);
+  // Update existing variables' parameters.
+  absl::Status UpdateVariables(const VariableUpdatesProto& variable_updates);
+
+  // Changes the type of `var` to kInteger if it is kBinary and `bound` is
+  // outside [0.0, 1.0], so that the bound can be set.
+  absl::Status PrepareBinaryVariableForBound(SCIP_VAR* var, double bound);
 
   absl::Status AddQuadraticObjectiveTerms(
       const SparseDoubleMatrixProto& new_qp_terms, bool maximize);
@@ -143,7 +143,7 @@ LogicalConstraintTestParameters GetGscipLogicalConstraintTestParameters() {
       /*supports_incremental_add_and_deletes=*/true,
       /*supports_incremental_variable_deletions=*/false,
       /*supports_deleting_indicator_variables=*/false,
-      /*supports_updating_binary_variables=*/false);
+      /*supports_updating_binary_variables=*/true);
 }
 INSTANTIATE_TEST_SUITE_P(GscipSimpleLogicalConstraintTest,
                          SimpleLogicalConstraintTest,
@@ -339,46 +339,71 @@ TEST(GScipSolverTest, InvalidCoefficient) {
                        HasSubstr("broken constraint")));
 }
 
-TEST(GScipSolverTest, UpdatingLowerBoundNotAllowedOnBinaryVariables) {
+TEST(GScipSolverTest, UpdatingLowerBoundOnBinaryVariables) {
   Model model;
   const Variable x = model.AddBinaryVariable("x");
+  model.Minimize(x);
   ASSERT_OK_AND_ASSIGN(auto solver,
                        IncrementalSolver::New(&model, SolverType::kGscip, {}));
+  ASSERT_THAT(solver->Solve(), IsOkAndHolds(IsOptimal(0.0)));
 
   model.set_lower_bound(x, -1.0);
-  EXPECT_THAT(solver->Update(), IsOkAndHolds(Not(DidUpdate())));
+  ASSERT_THAT(solver->Update(), IsOkAndHolds(DidUpdate()));
+  EXPECT_THAT(solver->SolveWithoutUpdate(), IsOkAndHolds(IsOptimal(-1.0)));
 }
 
-TEST(GScipSolverTest, UpdatingUpperBoundNotAllowedOnBinaryVariables) {
+TEST(GScipSolverTest, UpdatingUpperBoundOnBinaryVariables) {
   Model model;
   const Variable x = model.AddBinaryVariable("x");
+  model.Maximize(x);
   ASSERT_OK_AND_ASSIGN(auto solver,
                        IncrementalSolver::New(&model, SolverType::kGscip, {}));
+  ASSERT_THAT(solver->Solve(), IsOkAndHolds(IsOptimal(1.0)));
 
   model.set_upper_bound(x, 2.0);
-  EXPECT_THAT(solver->Update(), IsOkAndHolds(Not(DidUpdate())));
+  ASSERT_THAT(solver->Update(), IsOkAndHolds(DidUpdate()));
+  EXPECT_THAT(solver->SolveWithoutUpdate(), IsOkAndHolds(IsOptimal(2.0)));
+}
+
+TEST(GScipSolverTest, FixingBinaryVariables) {
+  Model model;
+  const Variable x = model.AddBinaryVariable("x");
+  model.Maximize(x);
+  ASSERT_OK_AND_ASSIGN(auto solver,
+                       IncrementalSolver::New(&model, SolverType::kGscip, {}));
+  ASSERT_THAT(solver->Solve(), IsOkAndHolds(IsOptimal(1.0)));
+
+  model.set_upper_bound(x, 0.0);
+  ASSERT_THAT(solver->Update(), IsOkAndHolds(DidUpdate()));
+  EXPECT_THAT(solver->SolveWithoutUpdate(), IsOkAndHolds(IsOptimal(0.0)));
 }
 
-TEST(GScipSolverTest, UpdatingLowerBoundNotAllowedOnImplicitBinaryVariables) {
+TEST(GScipSolverTest, UpdatingLowerBoundOnImplicitBinaryVariables) {
   Model model;
   // This will be silently converted to a binary variable in SCIP.
   const Variable y = model.AddIntegerVariable(0.0, 1.0, "y");
+  model.Minimize(y);
   ASSERT_OK_AND_ASSIGN(auto solver,
                        IncrementalSolver::New(&model, SolverType::kGscip, {}));
+  ASSERT_THAT(solver->Solve(), IsOkAndHolds(IsOptimal(0.0)));
 
   model.set_lower_bound(y, -1.0);
-  EXPECT_THAT(solver->Update(), IsOkAndHolds(Not(DidUpdate())));
+  ASSERT_THAT(solver->Update(), IsOkAndHolds(DidUpdate()));
+  EXPECT_THAT(solver->SolveWithoutUpdate(), IsOkAndHolds(IsOptimal(-1.0)));
 }
 
-TEST(GScipSolverTest, UpdatingUpperBoundNotAllowedOnImplicitBinaryVariables) {
+TEST(GScipSolverTest, UpdatingUpperBoundOnImplicitBinaryVariables) {
   Model model;
   // This will be silently converted to a binary variable in SCIP.
   const Variable y = model.AddIntegerVariable(0.0, 1.0, "y");
+  model.Maximize(y);
   ASSERT_OK_AND_ASSIGN(auto solver,
                        IncrementalSolver::New(&model, SolverType::kGscip, {}));
+  ASSERT_THAT(solver->Solve(), IsOkAndHolds(IsOptimal(1.0)));
 
   model.set_upper_bound(y, 2.0);
-  EXPECT_THAT(solver->Update(), IsOkAndHolds(Not(DidUpdate())));
+  ASSERT_THAT(solver->Update(), IsOkAndHolds(DidUpdate()));
+  EXPECT_THAT(solver->SolveWithoutUpdate(), IsOkAndHolds(IsOptimal(2.0)));
 }
 
 }  // namespace
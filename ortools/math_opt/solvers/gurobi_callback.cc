@@ -305,8 +305,159 @@ absl::Status ApplyResult(const Gurobi::CallbackContext& context,
   return absl::OkStatus();
 }
 
+absl::Status CheckCsrConstraints(const GurobiCsrConstraints& constraints,
+                                 const int num_gurobi_vars) {
+  const int num_rows = constraints.num_rows();
+  if (static_cast<int>(constraints.row_starts.size()) != num_rows + 1 ||
+      static_cast<int>(constraints.rhs.size()) != num_rows ||
+      constraints.row_starts.front() != 0) {
+    return absl::InvalidArgumentError(
+        absl::StrCat("inconsistent CSR constraints: ", num_rows, " senses, ",
+                     constraints.rhs.size(), " rhs and ",
+                     constraints.row_starts.size(), " row starts"));
+  }
+  const int num_terms = constraints.row_starts.back();
+  if (static_cast<int>(constraints.var_indices.size()) != num_terms ||
+      static_cast<int>(constraints.coefficients.size()) != num_terms) {
+    return absl::InvalidArgumentError(absl::StrCat(
+        "inconsistent CSR constraints: ", num_terms, " terms but ",
+        constraints.var_indices.size(), " indices and ",
+        constraints.coefficients.size(), " coefficients"));
+  }
+  for (int r = 0; r < num_rows; ++r) {
+    if (constraints.row_starts[r] > constraints.row_starts[r + 1]) {
+      return absl::InvalidArgumentError(
+          absl::StrCat("decreasing CSR row starts at row ", r));
+    }
+  }
+  for (const int index : constraints.var_indices) {
+    if (index < 0 || index >= num_gurobi_vars) {
+      return absl::InvalidArgumentError(
+          absl::StrCat("invalid Gurobi variable index: ", index));
+    }
+  }
+  return absl::OkStatus();
+}
+
+// Calls `add` on each row of `constraints`, which must have been validated by
+// CheckCsrConstraints().
+template <typename AddFn>
+absl::Status ForEachCsrRow(const GurobiCsrConstraints& constraints,
+                           const AddFn& add) {
+  const absl::Span<const int> indices = constraints.var_indices;
+  const absl::Span<const double> values = constraints.coefficients;
+  for (int r = 0; r < constraints.num_rows(); ++r) {
+    const int start = constraints.row_starts[r];
+    const int size = constraints.row_starts[r + 1] - start;
+    RETURN_IF_ERROR(add(indices.subspan(start, size),
+                        values.subspan(start, size), constraints.senses[r],
+                        constraints.rhs[r]));
+  }
+  return absl::OkStatus();
+}
+
+// Runs the dense callback if it is registered for the current event. It reads
+// the variable values directly into the reused buffer and applies the CSR
+// constraints of the result without going through protos.
+absl::Status RunDenseCallback(const Gurobi::CallbackContext& c,
+                              const GurobiCallbackInput& callback_input,
+                              GurobiDenseCallbackBuffers& buffers,
+                              SolveInterrupter& local_interrupter) {
+  GurobiDenseCallbackData data;
+  data.where = c.where();
+  data.variable_ids = &callback_input.variable_ids;
+  buffers.var_values.resize(callback_input.num_gurobi_vars);
+  if (c.where() == GRB_CB_MIPSOL) {
+    ASSIGN_OR_RETURN(data.primal_bound, c.CbGetDouble(GRB_CB_MIPSOL_OBJBST));
+    ASSIGN_OR_RETURN(data.dual_bound, c.CbGetDouble(GRB_CB_MIPSOL_OBJBND));
+    RETURN_IF_ERROR(c.CbGetDoubleArray(GRB_CB_MIPSOL_SOL,
+                                       absl::MakeSpan(buffers.var_values)))
+        << "Error reading solution at event MIP_SOLUTION";
+  } else {
+    ASSIGN_OR_RETURN(const int grb_status, c.CbGetInt(GRB_CB_MIPNODE_STATUS));
+    // There is no relaxation solution to look at.
+    if (grb_status != GRB_OPTIMAL) return absl::OkStatus();
+    ASSIGN_OR_RETURN(data.primal_bound, c.CbGetDouble(GRB_CB_MIPNODE_OBJBST));
+    ASSIGN_OR_RETURN(data.dual_bound, c.CbGetDouble(GRB_CB_MIPNODE_OBJBND));
+    RETURN_IF_ERROR(c.CbGetDoubleArray(GRB_CB_MIPNODE_REL,
+                                       absl::MakeSpan(buffers.var_values)))
+        << "Error reading solution at event MIP_NODE";
+  }
+  data.var_values = buffers.var_values;
+
+  GurobiDenseCallbackResult& result = buffers.result;
+  result.Clear();
+  if (const absl::Status status = callback_input.dense_cb(data, result);
+      !status.ok()) {
+    local_interrupter.Interrupt();
+    return status;
+  }
+
+  const int num_vars = callback_input.num_gurobi_vars;
+  RETURN_IF_ERROR(CheckCsrConstraints(result.lazy_constraints, num_vars))
+      << "in lazy constraints of the dense callback";
+  RETURN_IF_ERROR(CheckCsrConstraints(result.cuts, num_vars))
+      << "in cuts of the dense callback";
+  if (c.where() != GRB_CB_MIPNODE &&
+      (!result.cuts.empty() || !result.suggested_solution.empty())) {
+    return absl::InvalidArgumentError(
+        "the dense callback can only add cuts and suggest solutions at "
+        "GRB_CB_MIPNODE");
+  }
+  if (!result.suggested_solution.empty() &&
+      static_cast<int>(result.suggested_solution.size()) != num_vars) {
+    return absl::InvalidArgumentError(absl::StrCat(
+        "the suggested solution of the dense callback has ",
+        result.suggested_solution.size(), " values, expected ", num_vars));
+  }
+  RETURN_IF_ERROR(ForEachCsrRow(
+      result.lazy_constraints,
+      [&](absl::Span<const int> ind, absl::Span<const double> val,
+          const char sense, const double rhs) {
+        return c.CbLazy(ind, val, sense, rhs);
+      }));
+  RETURN_IF_ERROR(ForEachCsrRow(
+      result.cuts, [&](absl::Span<const int> ind, absl::Span<const double> val,
+                       const char sense, const double rhs) {
+        return c.CbCut(ind, val, sense, rhs);
+      }));
+  if (!result.suggested_solution.empty()) {
+    RETURN_IF_ERROR(c.CbSolution(result.suggested_solution).status());
+  }
+  if (result.terminate) {
+    local_interrupter.Interrupt();
+  }
+  return absl::OkStatus();
+}
+
 }  // namespace
 
+void GurobiCsrConstraints::AddRow(const absl::Span<const int> indices,
+                                  const absl::Span<const double> values,
+                                  const char sense, const double bound) {
+  DCHECK_EQ(indices.size(), values.size());
+  var_indices.insert(var_indices.end(), indices.begin(), indices.end());
+  coefficients.insert(coefficients.end(), values.begin(), values.end());
+  row_starts.push_back(static_cast<int>(var_indices.size()));
+  senses.push_back(sense);
+  rhs.push_back(bound);
+}
+
+void GurobiCsrConstraints::Clear() {
+  row_starts.assign(1, 0);
+  var_indices.clear();
+  coefficients.clear();
+  senses.clear();
+  rhs.clear();
+}
+
+void GurobiDenseCallbackResult::Clear() {
+  lazy_constraints.Clear();
+  cuts.Clear();
+  suggested_solution.clear();
+  terminate = false;
+}
+
 std::vector<bool> EventToGurobiWhere(
     const absl::flat_hash_set<CallbackEventProto>& events) {
   std::vector<bool> result(kNumGurobiEvents);
@@ -319,6 +470,7 @@ std::vector<bool> EventToGurobiWhere(
 absl::Status GurobiCallbackImpl(const Gurobi::CallbackContext& context,
                                 const GurobiCallbackInput& callback_input,
                                 MessageCallbackData& message_callback_data,
+                                GurobiDenseCallbackBuffers& dense_cb_buffers,
                                 SolveInterrupter* const local_interrupter) {
   // Gurobi 9 ignores early calls to GRBterminate(). For example calling
   // GRBterminate() in the first call of a MESSAGE callback only will not
@@ -354,6 +506,16 @@ absl::Status GurobiCallbackImpl(const Gurobi::CallbackContext& context,
     return absl::OkStatus();
   }
 
+  if (callback_input.dense_cb != nullptr &&
+      (context.where() == GRB_CB_MIPSOL ||
+       (context.where() == GRB_CB_MIPNODE &&
+        callback_input.dense_cb_at_mip_node))) {
+    // The dense callback is only registered along with a local interrupter.
+    CHECK(local_interrupter != nullptr);
+    RETURN_IF_ERROR(RunDenseCallback(context, callback_input, dense_cb_buffers,
+                                     *local_interrupter));
+  }
+
   if (callback_input.user_cb == nullptr ||
       !callback_input.events[context.where()]) {
     return absl::OkStatus();
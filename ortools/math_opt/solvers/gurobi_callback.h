@@ -15,11 +15,13 @@
 #define OR_TOOLS_MATH_OPT_SOLVERS_GUROBI_CALLBACK_H_
 
 #include <cstdint>
+#include <functional>
 #include <vector>
 
 #include "absl/container/flat_hash_set.h"
 #include "absl/status/status.h"
 #include "absl/time/time.h"
+#include "absl/types/span.h"
 #include "ortools/base/linked_hash_map.h"
 #include "ortools/gurobi/environment.h"
 #include "ortools/math_opt/callback.pb.h"
@@ -32,6 +34,80 @@
 namespace operations_research {
 namespace math_opt {
 
+// Data passed to a GurobiDenseCallback. It directly exposes the buffers read
+// from Gurobi, without any conversion to CallbackDataProto.
+struct GurobiDenseCallbackData {
+  // Either GRB_CB_MIPSOL or GRB_CB_MIPNODE.
+  int where = 0;
+
+  // The new incumbent (at GRB_CB_MIPSOL) or the optimal solution of the node
+  // relaxation (at GRB_CB_MIPNODE), indexed by Gurobi variable index. The
+  // underlying buffer is reused between calls and is only valid during the
+  // callback.
+  absl::Span<const double> var_values;
+
+  // Maps MathOpt variable ids to Gurobi variable indices. It is stable during
+  // the whole solve so callers can compute the indices they need once.
+  const gtl::linked_hash_map<int64_t, int>* variable_ids = nullptr;
+
+  double primal_bound = 0.0;
+  double dual_bound = 0.0;
+};
+
+// Linear constraints in compressed sparse row format. Row r has the terms
+// [row_starts[r], row_starts[r + 1]) of var_indices and coefficients (Gurobi
+// variable indices) and reads `terms senses[r] rhs[r]` where senses are
+// GRB_LESS_EQUAL, GRB_GREATER_EQUAL or GRB_EQUAL.
+struct GurobiCsrConstraints {
+  int num_rows() const { return static_cast<int>(senses.size()); }
+  bool empty() const { return senses.empty(); }
+
+  // Appends a row. This is a convenience; callers may also fill the vectors
+  // directly as long as row_starts ends up with num_rows() + 1 entries.
+  void AddRow(absl::Span<const int> indices, absl::Span<const double> values,
+              char sense, double bound);
+
+  // Clears all rows but keeps the allocated memory.
+  void Clear();
+
+  std::vector<int> row_starts = {0};
+  std::vector<int> var_indices;
+  std::vector<double> coefficients;
+  std::vector<char> senses;
+  std::vector<double> rhs;
+};
+
+// Result filled by a GurobiDenseCallback. The object is reused between calls
+// and cleared before each of them, so that steady-state callbacks do not
+// allocate.
+struct GurobiDenseCallbackResult {
+  void Clear();
+
+  // Requires the LazyConstraints Gurobi parameter, which is set when a dense
+  // callback is registered.
+  GurobiCsrConstraints lazy_constraints;
+  // Only valid at GRB_CB_MIPNODE.
+  GurobiCsrConstraints cuts;
+
+  // If not empty, a (partial) solution indexed by Gurobi variable index that
+  // is passed to GRBcbsolution(). Unknown values must be GRB_UNDEFINED. Only
+  // valid at GRB_CB_MIPNODE.
+  std::vector<double> suggested_solution;
+
+  bool terminate = false;
+};
+
+// Low overhead callback for MIP_SOLUTION and MIP_NODE events, see
+// NonStreamableGurobiInitArguments::dense_callback.
+using GurobiDenseCallback = std::function<absl::Status(
+    const GurobiDenseCallbackData&, GurobiDenseCallbackResult&)>;
+
+// Buffers reused by all the calls to a GurobiDenseCallback during a solve.
+struct GurobiDenseCallbackBuffers {
+  std::vector<double> var_values;
+  GurobiDenseCallbackResult result;
+};
+
 struct GurobiCallbackInput {
   SolverInterface::Callback user_cb;
   SolverInterface::MessageCallback message_cb;
@@ -45,6 +121,10 @@ struct GurobiCallbackInput {
   const SparseVectorFilterProto& mip_solution_filter;
   const SparseVectorFilterProto& mip_node_filter;
   const absl::Time start;
+  // Optional fast path called at GRB_CB_MIPSOL, and at GRB_CB_MIPNODE when
+  // dense_cb_at_mip_node is true, before user_cb.
+  GurobiDenseCallback dense_cb = nullptr;
+  bool dense_cb_at_mip_node = false;
 };
 
 // Converts a set of CallbackEventProto enums to a bit vector indicating which
@@ -59,6 +139,7 @@ std::vector<bool> EventToGurobiWhere(
 absl::Status GurobiCallbackImpl(const Gurobi::CallbackContext& context,
                                 const GurobiCallbackInput& callback_input,
                                 MessageCallbackData& message_callback_data,
+                                GurobiDenseCallbackBuffers& dense_cb_buffers,
                                 SolveInterrupter* local_interrupter);
 
 // Makes the final calls to the message callback with any unfinished line if
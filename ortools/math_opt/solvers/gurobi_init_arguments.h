@@ -21,6 +21,7 @@
 #include "ortools/math_opt/parameters.pb.h"
 #include "ortools/math_opt/solvers/gurobi.pb.h"
 #include "ortools/math_opt/solvers/gurobi/g_gurobi.h"
+#include "ortools/math_opt/solvers/gurobi_callback.h"
 
 namespace operations_research {
 namespace math_opt {
@@ -104,6 +105,23 @@ struct NonStreamableGurobiInitArguments
   // that used it have been destroyed.
   GRBenv* primary_env = nullptr;
 
+  // Optional low overhead callback, called at each new incumbent (Gurobi's
+  // MIPSOL event) and, if dense_callback_at_mip_node is true, at each node
+  // whose relaxation was solved to optimality (MIPNODE event).
+  //
+  // Contrary to the callback passed to Solve(), it does not convert the data
+  // to CallbackDataProto: it reads Gurobi's dense array of variable values
+  // (indexed by Gurobi variable index, see GurobiDenseCallbackData) and adds
+  // the lazy constraints and cuts it returns in CSR format directly. This is
+  // meant for lazy constraint generation loops where the conversion dominates
+  // the callback time.
+  //
+  // When set, the LazyConstraints and PreCrush Gurobi parameters are set for
+  // each solve. The solve callback, if any, is called after this one for the
+  // same event.
+  GurobiDenseCallback dense_callback;
+  bool dense_callback_at_mip_node = false;
+
   const NonStreamableGurobiInitArguments* ToNonStreamableGurobiInitArguments()
       const override {
     return this;
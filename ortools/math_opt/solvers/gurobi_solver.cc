@@ -2721,6 +2721,15 @@ absl::StatusOr<std::unique_ptr<GurobiSolver>> GurobiSolver::New(
   ASSIGN_OR_RETURN(std::unique_ptr<Gurobi> gurobi,
                    GurobiFromInitArgs(init_args));
   auto gurobi_solver = absl::WrapUnique(new GurobiSolver(std::move(gurobi)));
+  if (init_args.non_streamable != nullptr) {
+    const NonStreamableGurobiInitArguments* const non_streamable_args =
+        init_args.non_streamable->ToNonStreamableGurobiInitArguments();
+    if (non_streamable_args != nullptr) {
+      gurobi_solver->dense_callback_ = non_streamable_args->dense_callback;
+      gurobi_solver->dense_callback_at_mip_node_ =
+          non_streamable_args->dense_callback_at_mip_node;
+    }
+  }
   RETURN_IF_ERROR(gurobi_solver->LoadModel(input_model));
   return gurobi_solver;
 }
@@ -2729,6 +2738,7 @@ absl::StatusOr<std::unique_ptr<GurobiSolver::GurobiCallbackData>>
 GurobiSolver::RegisterCallback(const CallbackRegistrationProto& registration,
                                const Callback cb,
                                const MessageCallback message_cb,
+                               GurobiDenseCallback dense_cb,
                                const absl::Time start,
                                SolveInterrupter* const local_interrupter) {
   const absl::flat_hash_set<CallbackEventProto> events = EventSet(registration);
@@ -2751,12 +2761,13 @@ GurobiSolver::RegisterCallback(const CallbackRegistrationProto& registration,
     // messages.
     RETURN_IF_ERROR(gurobi_->SetIntParam(GRB_INT_PAR_LOGTOCONSOLE, 0));
   }
-  if (registration.add_cuts() || registration.add_lazy_constraints()) {
+  if (registration.add_cuts() || registration.add_lazy_constraints() ||
+      dense_cb != nullptr) {
     // This is to signal the solver presolve to limit primal transformations
     // that precludes crushing cuts to the presolved model.
     RETURN_IF_ERROR(gurobi_->SetIntParam(GRB_INT_PAR_PRECRUSH, 1));
   }
-  if (registration.add_lazy_constraints()) {
+  if (registration.add_lazy_constraints() || dense_cb != nullptr) {
     // This is needed so that the solver knows that some presolve reductions
     // can not be performed safely.
     RETURN_IF_ERROR(gurobi_->SetIntParam(GRB_INT_PAR_LAZYCONSTRAINTS, 1));
@@ -2770,7 +2781,9 @@ GurobiSolver::RegisterCallback(const CallbackRegistrationProto& registration,
           .events = EventToGurobiWhere(events),
           .mip_solution_filter = registration.mip_solution_filter(),
           .mip_node_filter = registration.mip_node_filter(),
-          .start = start},
+          .start = start,
+          .dense_cb = std::move(dense_cb),
+          .dense_cb_at_mip_node = dense_callback_at_mip_node_},
       local_interrupter);
 }
 
@@ -2927,7 +2940,7 @@ absl::StatusOr<SolveResultProto> GurobiSolver::Solve(
   // when either the user interrupter is triggered or when a callback returns
   // a true `terminate`.
   std::unique_ptr<SolveInterrupter> local_interrupter;
-  if (cb != nullptr || interrupter != nullptr) {
+  if (cb != nullptr || dense_callback_ != nullptr || interrupter != nullptr) {
     local_interrupter = std::make_unique<SolveInterrupter>();
   }
   const ScopedSolveInterrupterCallback scoped_terminate_callback(
@@ -2987,13 +3000,15 @@ absl::StatusOr<SolveResultProto> GurobiSolver::Solve(
   Gurobi::Callback grb_cb = nullptr;
   std::unique_ptr<GurobiCallbackData> gurobi_cb_data;
   if (cb != nullptr || local_interrupter != nullptr || message_cb != nullptr) {
-    ASSIGN_OR_RETURN(gurobi_cb_data,
-                     RegisterCallback(callback_registration, cb, message_cb,
-                                      start, local_interrupter.get()));
+    ASSIGN_OR_RETURN(
+        gurobi_cb_data,
+        RegisterCallback(callback_registration, cb, message_cb,
+                         dense_callback_, start, local_interrupter.get()));
     grb_cb = [&gurobi_cb_data](
                  const Gurobi::CallbackContext& cb_context) -> absl::Status {
       return GurobiCallbackImpl(cb_context, gurobi_cb_data->callback_input,
                                 gurobi_cb_data->message_callback_data,
+                                gurobi_cb_data->dense_callback_buffers,
                                 gurobi_cb_data->local_interrupter);
     };
   }
@@ -3079,12 +3094,14 @@ GurobiSolver::ComputeInfeasibleSubsystem(
   std::unique_ptr<GurobiCallbackData> gurobi_cb_data;
   if (local_interrupter != nullptr || message_cb != nullptr) {
     ASSIGN_OR_RETURN(gurobi_cb_data,
-                     RegisterCallback({}, nullptr, message_cb, start,
+                     RegisterCallback({}, nullptr, message_cb,
+                                      /*dense_cb=*/nullptr, start,
                                       local_interrupter.get()));
     grb_cb = [&gurobi_cb_data](
                  const Gurobi::CallbackContext& cb_context) -> absl::Status {
       return GurobiCallbackImpl(cb_context, gurobi_cb_data->callback_input,
                                 gurobi_cb_data->message_callback_data,
+                                gurobi_cb_data->dense_callback_buffers,
                                 gurobi_cb_data->local_interrupter);
     };
   }
@@ -86,6 +86,7 @@ class GurobiSolver : public SolverInterface {
     SolveInterrupter* const local_interrupter;
 
     MessageCallbackData message_callback_data;
+    GurobiDenseCallbackBuffers dense_callback_buffers;
 
     absl::Status status = absl::OkStatus();
   };
@@ -351,8 +352,8 @@ class GurobiSolver : public SolverInterface {
 
   absl::StatusOr<std::unique_ptr<GurobiCallbackData>> RegisterCallback(
       const CallbackRegistrationProto& registration, Callback cb,
-      MessageCallback message_cb, absl::Time start,
-      SolveInterrupter* local_interrupter);
+      MessageCallback message_cb, GurobiDenseCallback dense_cb,
+      absl::Time start, SolveInterrupter* local_interrupter);
 
   // Returns the ids of variables and linear constraints with inverted bounds.
   absl::StatusOr<InvertedBounds> ListInvertedBounds() const;
@@ -391,6 +392,9 @@ class GurobiSolver : public SolverInterface {
       const ModelSolveParametersProto& model_parameters);
 
   const std::unique_ptr<Gurobi> gurobi_;
+  // See NonStreamableGurobiInitArguments::dense_callback.
+  GurobiDenseCallback dense_callback_ = nullptr;
+  bool dense_callback_at_mip_node_ = false;
 
   // Note that we use linked_hash_map for the indices of the gurobi_model_
   // variables and linear constraints to ensure that iteration over the map
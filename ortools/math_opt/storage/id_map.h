@@ -0,0 +1,206 @@
+// Copyright 2010-2024 Google LLC
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef OR_TOOLS_MATH_OPT_STORAGE_ID_MAP_H_
+#define OR_TOOLS_MATH_OPT_STORAGE_ID_MAP_H_
+
+#include <algorithm>
+#include <cstdint>
+#include <optional>
+#include <utility>
+#include <vector>
+
+#include "absl/algorithm/container.h"
+#include "absl/container/flat_hash_map.h"
+#include "absl/log/check.h"
+
+namespace operations_research::math_opt {
+
+// A map from the ids of the elements of a model (e.g. VariableId) to their
+// data, for ids allocated in increasing order and rarely deleted.
+//
+// The data is stored in a vector indexed by id, with a tombstone for each
+// deleted (or never inserted) id: look-ups do not hash, and the elements are
+// scanned sequentially, by increasing id. When more than half of the slots are
+// tombstones (after many deletions, or a large gap between the ids), the map
+// switches for good to a hash map, so that its memory stays proportional to
+// its size.
+template <typename Id, typename Value>
+class IdMap {
+ public:
+  // The number of ids in the map.
+  int64_t size() const { return size_; }
+
+  bool contains(Id id) const;
+
+  // Inserts `id`, which must not be in the map, with a default value and
+  // returns this value.
+  Value& Insert(Id id);
+
+  // Removes `id`, which must be in the map.
+  void erase(Id id);
+
+  // The value of `id`, which must be in the map.
+  Value& at(Id id);
+  const Value& at(Id id) const;
+
+  // Reserves the capacity for `size` ids, assuming that the new ids are
+  // larger than the ones in the map.
+  void reserve(int64_t size);
+
+  // The ids in the map, in an undefined order.
+  std::vector<Id> Keys() const;
+
+  // The ids in the map, sorted.
+  std::vector<Id> SortedKeys() const;
+
+ private:
+  // Below this number of slots, the map stays dense whatever its number of
+  // tombstones.
+  static constexpr int64_t kMinSlotsForSparse = 64;
+
+  // Returns true if a dense map with `num_slots` slots holding `size` ids would
+  // have too many tombstones.
+  static bool TooSparse(int64_t num_slots, int64_t size) {
+    return num_slots > kMinSlotsForSparse && num_slots - size > size;
+  }
+
+  // Moves the values of `dense_` to `sparse_`.
+  void SwitchToSparse();
+
+  bool is_dense_ = true;
+  // The values by id when is_dense_, std::nullopt for the ids not in the map.
+  std::vector<std::optional<Value>> dense_;
+  // The values when !is_dense_.
+  absl::flat_hash_map<Id, Value> sparse_;
+  int64_t size_ = 0;
+};
+
+////////////////////////////////////////////////////////////////////////////////
+// Inline functions implementations
+////////////////////////////////////////////////////////////////////////////////
+
+template <typename Id, typename Value>
+bool IdMap<Id, Value>::contains(const Id id) const {
+  if (!is_dense_) {
+    return sparse_.contains(id);
+  }
+  const int64_t index = id.value();
+  return index >= 0 && index < dense_.size() && dense_[index].has_value();
+}
+
+template <typename Id, typename Value>
+Value& IdMap<Id, Value>::Insert(const Id id) {
+  CHECK(!contains(id)) << id;
+  ++size_;
+  if (is_dense_ && id.value() >= dense_.size() &&
+      TooSparse(id.value() + 1, size_)) {
+    SwitchToSparse();
+  }
+  if (!is_dense_) {
+    return sparse_[id];
+  }
+  CHECK_GE(id.value(), 0);
+  if (id.value() >= dense_.size()) {
+    dense_.resize(id.value() + 1);
+  }
+  return dense_[id.value()].emplace();
+}
+
+template <typename Id, typename Value>
+void IdMap<Id, Value>::erase(const Id id) {
+  CHECK(contains(id)) << id;
+  --size_;
+  if (!is_dense_) {
+    sparse_.erase(id);
+    return;
+  }
+  dense_[id.value()].reset();
+  // Trailing tombstones can be dropped, which keeps append-and-pop workloads
+  // dense.
+  while (!dense_.empty() && !dense_.back().has_value()) {
+    dense_.pop_back();
+  }
+  if (TooSparse(dense_.size(), size_)) {
+    SwitchToSparse();
+  }
+}
+
+template <typename Id, typename Value>
+Value& IdMap<Id, Value>::at(const Id id) {
+  DCHECK(contains(id)) << id;
+  return is_dense_ ? *dense_[id.value()] : sparse_.at(id);
+}
+
+template <typename Id, typename Value>
+const Value& IdMap<Id, Value>::at(const Id id) const {
+  DCHECK(contains(id)) << id;
+  return is_dense_ ? *dense_[id.value()] : sparse_.at(id);
+}
+
+template <typename Id, typename Value>
+void IdMap<Id, Value>::reserve(const int64_t size) {
+  if (is_dense_) {
+    dense_.reserve(dense_.size() + std::max<int64_t>(0, size - size_));
+  } else {
+    sparse_.reserve(size);
+  }
+}
+
+template <typename Id, typename Value>
+std::vector<Id> IdMap<Id, Value>::Keys() const {
+  if (is_dense_) {
+    return SortedKeys();
+  }
+  std::vector<Id> result;
+  result.reserve(size_);
+  for (const auto& [id, _] : sparse_) {
+    result.push_back(id);
+  }
+  return result;
+}
+
+template <typename Id, typename Value>
+std::vector<Id> IdMap<Id, Value>::SortedKeys() const {
+  if (!is_dense_) {
+    std::vector<Id> result = Keys();
+    absl::c_sort(result);
+    return result;
+  }
+  std::vector<Id> result;
+  result.reserve(size_);
+  for (int64_t index = 0; index < dense_.size(); ++index) {
+    if (dense_[index].has_value()) {
+      result.push_back(Id(index));
+    }
+  }
+  return result;
+}
+
+template <typename Id, typename Value>
+void IdMap<Id, Value>::SwitchToSparse() {
+  DCHECK(is_dense_);
+  sparse_.reserve(size_);
+  for (int64_t index = 0; index < dense_.size(); ++index) {
+    if (dense_[index].has_value()) {
+      sparse_.try_emplace(Id(index), *std::move(dense_[index]));
+    }
+  }
+  dense_.clear();
+  dense_.shrink_to_fit();
+  is_dense_ = false;
+}
+
+}  // namespace operations_research::math_opt
+
+#endif  // OR_TOOLS_MATH_OPT_STORAGE_ID_MAP_H_
@@ -19,8 +19,8 @@
 #include <vector>
 
 #include "absl/algorithm/container.h"
-#include "absl/container/flat_hash_map.h"
 #include "absl/container/flat_hash_set.h"
+#include "absl/log/check.h"
 #include "absl/strings/string_view.h"
 #include "absl/types/span.h"
 #include "ortools/base/strong_int.h"
@@ -37,27 +37,28 @@ LinearConstraintId LinearConstraintStorage::Add(const double lower_bound,
                                                 const double upper_bound,
                                                 const absl::string_view name) {
   const LinearConstraintId id = next_id_++;
-  Data& lin_con_data = linear_constraints_[id];
+  Data& lin_con_data = linear_constraints_.Insert(id);
   lin_con_data.lower_bound = lower_bound;
   lin_con_data.upper_bound = upper_bound;
   lin_con_data.name = std::string(name);
   return id;
 }
 
+void LinearConstraintStorage::set_terms_of_new_constraint(
+    const LinearConstraintId constraint, absl::Span<const VariableId> variables,
+    absl::Span<const double> coefficients) {
+  DCHECK(linear_constraints_.contains(constraint));
+  matrix_.AddRow(constraint, variables, coefficients);
+}
+
 std::vector<LinearConstraintId> LinearConstraintStorage::LinearConstraints()
     const {
-  std::vector<LinearConstraintId> result;
-  for (const auto& [lin_con, _] : linear_constraints_) {
-    result.push_back(lin_con);
-  }
-  return result;
+  return linear_constraints_.Keys();
 }
 
 std::vector<LinearConstraintId>
 LinearConstraintStorage::SortedLinearConstraints() const {
-  std::vector<LinearConstraintId> result = LinearConstraints();
-  absl::c_sort(result);
-  return result;
+  return linear_constraints_.SortedKeys();
 }
 
 std::vector<LinearConstraintId> LinearConstraintStorage::ConstraintsFrom(
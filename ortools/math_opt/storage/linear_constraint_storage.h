@@ -21,7 +21,6 @@
 #include <utility>
 #include <vector>
 
-#include "absl/container/flat_hash_map.h"
 #include "absl/container/flat_hash_set.h"
 #include "absl/log/check.h"
 #include "absl/meta/type_traits.h"
@@ -31,6 +30,7 @@
 #include "ortools/math_opt/model.pb.h"
 #include "ortools/math_opt/model_update.pb.h"
 #include "ortools/math_opt/sparse_containers.pb.h"
+#include "ortools/math_opt/storage/id_map.h"
 #include "ortools/math_opt/storage/model_storage_types.h"
 #include "ortools/math_opt/storage/range.h"
 #include "ortools/math_opt/storage/sparse_matrix.h"
@@ -113,6 +113,10 @@ class LinearConstraintStorage {
   // Sets the next variable id to be the maximum of next_id() and `minimum`.
   inline void ensure_next_id_at_least(LinearConstraintId minimum);
 
+  // Reserves the capacity for `size` linear constraints, `num_nonzeros` of
+  // them having nonzero coefficients in `matrix()`.
+  inline void reserve(int64_t size, int64_t num_nonzeros);
+
   // Returns true if this id has been created and not yet deleted.
   inline bool contains(LinearConstraintId id) const;
 
@@ -135,6 +139,16 @@ class LinearConstraintStorage {
   void set_term(LinearConstraintId constraint, VariableId variable,
                 double value, const iterator_range<DiffIter>& diffs);
 
+  // Sets the terms of `constraint`, which must have been added after the
+  // checkpoints of all the diffs and must not have terms yet. Zero
+  // coefficients are ignored and variables must be unique.
+  //
+  // Since the diffs do not track the terms of new constraints, this is
+  // equivalent to calling set_term() for each term, but cheaper.
+  void set_terms_of_new_constraint(LinearConstraintId constraint,
+                                   absl::Span<const VariableId> variables,
+                                   absl::Span<const double> coefficients);
+
   // The matrix of coefficients for the linear terms in the constraints.
   const SparseMatrix<LinearConstraintId, VariableId>& matrix() const {
     return matrix_;
@@ -185,7 +199,7 @@ class LinearConstraintStorage {
                                LinearConstraintId end) const;
 
   LinearConstraintId next_id_{0};
-  absl::flat_hash_map<LinearConstraintId, Data> linear_constraints_;
+  IdMap<LinearConstraintId, Data> linear_constraints_;
   SparseMatrix<LinearConstraintId, VariableId> matrix_;
 };
 
@@ -210,11 +224,11 @@ template <typename DiffIter>
 void LinearConstraintStorage::set_lower_bound(
     const LinearConstraintId id, const double lower_bound,
     const iterator_range<DiffIter>& diffs) {
-  const auto it = linear_constraints_.find(id);
-  if (it->second.lower_bound == lower_bound) {
+  Data& data = linear_constraints_.at(id);
+  if (data.lower_bound == lower_bound) {
     return;
   }
-  it->second.lower_bound = lower_bound;
+  data.lower_bound = lower_bound;
   for (Diff& diff : diffs) {
     if (id < diff.checkpoint) {
       diff.lower_bounds.insert(id);
@@ -226,11 +240,11 @@ template <typename DiffIter>
 void LinearConstraintStorage::set_upper_bound(
     const LinearConstraintId id, const double upper_bound,
     const iterator_range<DiffIter>& diffs) {
-  const auto it = linear_constraints_.find(id);
-  if (it->second.upper_bound == upper_bound) {
+  Data& data = linear_constraints_.at(id);
+  if (data.upper_bound == upper_bound) {
     return;
   }
-  it->second.upper_bound = upper_bound;
+  data.upper_bound = upper_bound;
   for (Diff& diff : diffs) {
     if (id < diff.checkpoint) {
       diff.upper_bounds.insert(id);
@@ -286,6 +300,12 @@ void LinearConstraintStorage::ensure_next_id_at_least(
   next_id_ = std::max(minimum, next_id_);
 }
 
+void LinearConstraintStorage::reserve(const int64_t size,
+                                      const int64_t num_nonzeros) {
+  linear_constraints_.reserve(size);
+  matrix_.Reserve(size, num_nonzeros);
+}
+
 bool LinearConstraintStorage::contains(const LinearConstraintId id) const {
   return linear_constraints_.contains(id);
 }
@@ -183,6 +183,21 @@ VariableId ModelStorage::AddVariable(const double lower_bound,
   return variables_.Add(lower_bound, upper_bound, is_integer, name);
 }
 
+VariableId ModelStorage::AddVariables(absl::Span<const double> lower_bounds,
+                                      absl::Span<const double> upper_bounds,
+                                      const bool is_integer,
+                                      absl::Span<const std::string> names) {
+  CHECK_EQ(lower_bounds.size(), upper_bounds.size());
+  CHECK(names.empty() || names.size() == lower_bounds.size());
+  const VariableId first = variables_.next_id();
+  variables_.reserve(variables_.size() + lower_bounds.size());
+  for (int64_t v = 0; v < lower_bounds.size(); ++v) {
+    variables_.Add(lower_bounds[v], upper_bounds[v], is_integer,
+                   names.empty() ? absl::string_view() : names[v]);
+  }
+  return first;
+}
+
 void ModelStorage::AddVariables(const VariablesProto& variables) {
   const bool has_names = !variables.names().empty();
   for (int v = 0; v < variables.ids_size(); ++v) {
@@ -233,6 +248,37 @@ LinearConstraintId ModelStorage::AddLinearConstraint(
   return linear_constraints_.Add(lower_bound, upper_bound, name);
 }
 
+LinearConstraintId ModelStorage::AddLinearConstraints(
+    absl::Span<const double> lower_bounds,
+    absl::Span<const double> upper_bounds, absl::Span<const int64_t> row_starts,
+    absl::Span<const VariableId> variables,
+    absl::Span<const double> coefficients,
+    absl::Span<const std::string> names) {
+  const int64_t num_constraints = lower_bounds.size();
+  CHECK_EQ(upper_bounds.size(), num_constraints);
+  CHECK_EQ(row_starts.size(), num_constraints + 1);
+  CHECK_EQ(row_starts.front(), 0);
+  CHECK_EQ(row_starts.back(), variables.size());
+  CHECK_EQ(coefficients.size(), variables.size());
+  CHECK(names.empty() || names.size() == num_constraints);
+  const LinearConstraintId first = linear_constraints_.next_id();
+  linear_constraints_.reserve(
+      linear_constraints_.size() + num_constraints,
+      linear_constraints_.matrix().nonzeros() + variables.size());
+  for (int64_t c = 0; c < num_constraints; ++c) {
+    const LinearConstraintId constraint = linear_constraints_.Add(
+        lower_bounds[c], upper_bounds[c],
+        names.empty() ? absl::string_view() : names[c]);
+    const int64_t start = row_starts[c];
+    const int64_t end = row_starts[c + 1];
+    CHECK_LE(start, end);
+    linear_constraints_.set_terms_of_new_constraint(
+        constraint, variables.subspan(start, end - start),
+        coefficients.subspan(start, end - start));
+  }
+  return first;
+}
+
 void ModelStorage::AddLinearConstraints(
     const LinearConstraintsProto& linear_constraints) {
   const bool has_names = !linear_constraints.names().empty();
@@ -30,6 +30,7 @@
 #include "absl/status/status.h"
 #include "absl/status/statusor.h"
 #include "absl/strings/string_view.h"
+#include "absl/types/span.h"
 #include "ortools/base/map_util.h"
 #include "ortools/base/strong_int.h"
 #include "ortools/math_opt/constraints/indicator/storage.h"  // IWYU pragma: export
@@ -206,6 +207,18 @@ class ModelStorage {
   VariableId AddVariable(double lower_bound, double upper_bound,
                          bool is_integer, absl::string_view name = "");
 
+  // Adds lower_bounds.size() variables to the model, with the given bounds and
+  // integrality, and returns the id of the first one; the ids of the others
+  // follow consecutively. `names` is either empty, for unnamed variables, or
+  // has one name per variable.
+  //
+  // This is equivalent to calling AddVariable() for each variable, but the
+  // storage is reserved once for all of them.
+  VariableId AddVariables(absl::Span<const double> lower_bounds,
+                          absl::Span<const double> upper_bounds,
+                          bool is_integer,
+                          absl::Span<const std::string> names = {});
+
   inline double variable_lower_bound(VariableId id) const;
   inline double variable_upper_bound(VariableId id) const;
   inline bool is_variable_integer(VariableId id) const;
@@ -268,6 +281,29 @@ class ModelStorage {
   LinearConstraintId AddLinearConstraint(double lower_bound, double upper_bound,
                                          absl::string_view name = "");
 
+  // Adds lower_bounds.size() linear constraints to the model, with the given
+  // bounds and linear terms, and returns the id of the first one; the ids of
+  // the others follow consecutively. `names` is either empty, for unnamed
+  // constraints, or has one name per constraint.
+  //
+  // The terms are given in compressed sparse row format: the terms of the i-th
+  // constraint are the `variables` and `coefficients` in the range
+  // [row_starts[i], row_starts[i + 1]), so `row_starts` has one more element
+  // than `lower_bounds`. Zero coefficients are ignored, and the variables of a
+  // constraint must be unique.
+  //
+  // This is equivalent to calling AddLinearConstraint() and
+  // set_linear_constraint_coefficient() for each constraint and term, but the
+  // storage is reserved once for all of them, and the update trackers are not
+  // visited for each term (they do not track the terms of new constraints).
+  LinearConstraintId AddLinearConstraints(
+      absl::Span<const double> lower_bounds,
+      absl::Span<const double> upper_bounds,
+      absl::Span<const int64_t> row_starts,
+      absl::Span<const VariableId> variables,
+      absl::Span<const double> coefficients,
+      absl::Span<const std::string> names = {});
+
   inline double linear_constraint_lower_bound(LinearConstraintId id) const;
   inline double linear_constraint_upper_bound(LinearConstraintId id) const;
   inline const std::string& linear_constraint_name(LinearConstraintId id) const;
@@ -333,6 +369,17 @@ class ModelStorage {
   inline std::vector<std::tuple<LinearConstraintId, VariableId, double>>
   linear_constraint_matrix() const;
 
+  // Calls `f(linear constraint, variable, coefficient)` for each nonzero linear
+  // constraint matrix coefficient, in an undefined order, without the copy of
+  // linear_constraint_matrix().
+  template <typename F>
+  void ForEachLinearConstraintCoefficient(const F& f) const {
+    linear_constraints_.matrix().ForEachTerm(f);
+  }
+
+  // The number of nonzero linear constraint matrix coefficients.
+  inline int64_t num_linear_constraint_matrix_nonzeros() const;
+
   // Returns the variables with nonzero coefficients in a linear constraint.
   inline std::vector<VariableId> variables_in_linear_constraint(
       LinearConstraintId constraint) const;
@@ -913,6 +960,10 @@ ModelStorage::linear_constraint_matrix() const {
   return linear_constraints_.matrix().Terms();
 }
 
+int64_t ModelStorage::num_linear_constraint_matrix_nonzeros() const {
+  return linear_constraints_.matrix().nonzeros();
+}
+
 std::vector<VariableId> ModelStorage::variables_in_linear_constraint(
     LinearConstraintId constraint) const {
   return linear_constraints_.matrix().row(constraint);
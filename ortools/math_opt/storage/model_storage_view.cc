@@ -0,0 +1,119 @@
+// Copyright 2010-2024 Google LLC
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "ortools/math_opt/storage/model_storage_view.h"
+
+#include <cstdint>
+
+#include "absl/functional/function_ref.h"
+#include "absl/log/check.h"
+#include "absl/strings/string_view.h"
+#include "ortools/math_opt/storage/model_storage.h"
+#include "ortools/math_opt/storage/model_storage_types.h"
+
+namespace operations_research {
+namespace math_opt {
+
+bool ModelStorageView::IsLinear(const ModelStorage& storage) {
+  return storage.num_auxiliary_objectives() == 0 &&
+         storage.num_quadratic_objective_terms(kPrimaryObjectiveId) == 0 &&
+         storage.num_constraints<QuadraticConstraintId>() == 0 &&
+         storage.num_constraints<SecondOrderConeConstraintId>() == 0 &&
+         storage.num_constraints<Sos1ConstraintId>() == 0 &&
+         storage.num_constraints<Sos2ConstraintId>() == 0 &&
+         storage.num_constraints<IndicatorConstraintId>() == 0;
+}
+
+ModelStorageView::ModelStorageView(const ModelStorage& storage,
+                                   const bool remove_names)
+    : storage_(storage), remove_names_(remove_names) {
+  DCHECK(IsLinear(storage));
+}
+
+absl::string_view ModelStorageView::name() const {
+  if (remove_names_) return {};
+  return storage_.name();
+}
+
+bool ModelStorageView::maximize() const {
+  return storage_.is_maximize(kPrimaryObjectiveId);
+}
+
+double ModelStorageView::objective_offset() const {
+  return storage_.objective_offset(kPrimaryObjectiveId);
+}
+
+absl::string_view ModelStorageView::objective_name() const {
+  return storage_.objective_name(kPrimaryObjectiveId);
+}
+
+void ModelStorageView::ForEachLinearObjectiveCoefficient(
+    absl::FunctionRef<void(int64_t variable_id, double coefficient)> f) const {
+  for (const auto& [variable, coefficient] :
+       storage_.linear_objective(kPrimaryObjectiveId)) {
+    f(variable.value(), coefficient);
+  }
+}
+
+int64_t ModelStorageView::num_variables() const {
+  return storage_.num_variables();
+}
+
+void ModelStorageView::ForEachVariable(
+    absl::FunctionRef<void(int64_t id, double lower_bound, double upper_bound,
+                           bool is_integer, absl::string_view name)>
+        f) const {
+  for (const VariableId variable : storage_.SortedVariables()) {
+    f(variable.value(), storage_.variable_lower_bound(variable),
+      storage_.variable_upper_bound(variable),
+      storage_.is_variable_integer(variable),
+      remove_names_ ? absl::string_view()
+                    : absl::string_view(storage_.variable_name(variable)));
+  }
+}
+
+int64_t ModelStorageView::num_linear_constraints() const {
+  return storage_.num_linear_constraints();
+}
+
+void ModelStorageView::ForEachLinearConstraint(
+    absl::FunctionRef<void(int64_t id, double lower_bound, double upper_bound,
+                           absl::string_view name)>
+        f) const {
+  for (const LinearConstraintId constraint :
+       storage_.SortedLinearConstraints()) {
+    f(constraint.value(), storage_.linear_constraint_lower_bound(constraint),
+      storage_.linear_constraint_upper_bound(constraint),
+      remove_names_
+          ? absl::string_view()
+          : absl::string_view(storage_.linear_constraint_name(constraint)));
+  }
+}
+
+int64_t ModelStorageView::num_linear_constraint_matrix_nonzeros() const {
+  return storage_.num_linear_constraint_matrix_nonzeros();
+}
+
+void ModelStorageView::ForEachLinearConstraintCoefficient(
+    absl::FunctionRef<void(int64_t linear_constraint_id, int64_t variable_id,
+                           double coefficient)>
+        f) const {
+  storage_.ForEachLinearConstraintCoefficient(
+      [f](const LinearConstraintId constraint, const VariableId variable,
+          const double coefficient) {
+        f(constraint.value(), variable.value(), coefficient);
+      });
+}
+
+}  // namespace math_opt
+}  // namespace operations_research
@@ -0,0 +1,77 @@
+// Copyright 2010-2024 Google LLC
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef OR_TOOLS_MATH_OPT_STORAGE_MODEL_STORAGE_VIEW_H_
+#define OR_TOOLS_MATH_OPT_STORAGE_MODEL_STORAGE_VIEW_H_
+
+#include <cstdint>
+
+#include "absl/functional/function_ref.h"
+#include "absl/strings/string_view.h"
+#include "ortools/math_opt/core/linear_model_view.h"
+#include "ortools/math_opt/storage/model_storage.h"
+
+namespace operations_research {
+namespace math_opt {
+
+// A LinearModelView of a ModelStorage, which is read directly by the solvers
+// created from it (see Solver::NewFromView()), without the ModelProto of
+// ModelStorage::ExportModel().
+class ModelStorageView : public LinearModelView {
+ public:
+  // Returns true if the storage only has variables, a linear primary objective
+  // and linear constraints, i.e. if it can be viewed.
+  static bool IsLinear(const ModelStorage& storage);
+
+  // The storage must be linear (see IsLinear()), and must outlive the view.
+  // If `remove_names` is true, the names are removed as by
+  // ModelStorage::ExportModel().
+  ModelStorageView(const ModelStorage& storage, bool remove_names);
+
+  absl::string_view name() const override;
+
+  bool maximize() const override;
+  double objective_offset() const override;
+  absl::string_view objective_name() const override;
+  void ForEachLinearObjectiveCoefficient(
+      absl::FunctionRef<void(int64_t variable_id, double coefficient)> f)
+      const override;
+
+  int64_t num_variables() const override;
+  void ForEachVariable(
+      absl::FunctionRef<void(int64_t id, double lower_bound,
+                             double upper_bound, bool is_integer,
+                             absl::string_view name)>
+          f) const override;
+
+  int64_t num_linear_constraints() const override;
+  void ForEachLinearConstraint(
+      absl::FunctionRef<void(int64_t id, double lower_bound,
+                             double upper_bound, absl::string_view name)>
+          f) const override;
+
+  int64_t num_linear_constraint_matrix_nonzeros() const override;
+  void ForEachLinearConstraintCoefficient(
+      absl::FunctionRef<void(int64_t linear_constraint_id, int64_t variable_id,
+                             double coefficient)>
+          f) const override;
+
+ private:
+  const ModelStorage& storage_;
+  const bool remove_names_;
+};
+
+}  // namespace math_opt
+}  // namespace operations_research
+
+#endif  // OR_TOOLS_MATH_OPT_STORAGE_MODEL_STORAGE_VIEW_H_
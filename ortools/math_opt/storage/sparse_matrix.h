@@ -24,6 +24,7 @@
 #include "absl/algorithm/container.h"
 #include "absl/container/flat_hash_map.h"
 #include "absl/container/flat_hash_set.h"
+#include "absl/log/check.h"
 #include "absl/meta/type_traits.h"
 #include "absl/types/span.h"
 #include "ortools/base/map_util.h"
@@ -184,6 +185,18 @@ class SparseMatrix {
   // Returns true if the value is present (nonzero).
   bool contains(RowId row, ColumnId column) const;
 
+  // Sets the entries of `row`, which must have none, to `values` in the given
+  // `columns`. Zero values are ignored and columns must be unique.
+  //
+  // This is equivalent to calling set() for each entry but only looks up the
+  // row once.
+  void AddRow(RowId row, absl::Span<const ColumnId> columns,
+              absl::Span<const double> values);
+
+  // Reserves the capacity for `num_rows` rows with entries and `num_nonzeros`
+  // entries, so that adding them does not rehash the matrix.
+  void Reserve(int64_t num_rows, int64_t num_nonzeros);
+
   // Zeros out all coefficients for this variable.
   void DeleteRow(RowId row);
 
@@ -219,6 +232,13 @@ class SparseMatrix {
   // TODO(b/233630053): expose an iterator based API to avoid making a copy.
   std::vector<std::tuple<RowId, ColumnId, double>> Terms() const;
 
+  // Calls `f(row, column, value)` for each nonzero entry, like Terms() but
+  // without copying the entries.
+  //
+  // The call order is non-deterministic and not defined.
+  template <typename F>
+  void ForEachTerm(const F& f) const;
+
   // Removes all terms from the matrix.
   void Clear();
 
@@ -493,6 +513,47 @@ SparseMatrix<RowId, ColumnId>::Terms() const {
   return result;
 }
 
+template <typename RowId, typename ColumnId>
+template <typename F>
+void SparseMatrix<RowId, ColumnId>::ForEachTerm(const F& f) const {
+  for (const auto& [k, v] : values_) {
+    if (v != 0.0) {
+      f(k.first, k.second, v);
+    }
+  }
+}
+
+template <typename RowId, typename ColumnId>
+void SparseMatrix<RowId, ColumnId>::AddRow(const RowId row,
+                                           absl::Span<const ColumnId> columns,
+                                           absl::Span<const double> values) {
+  CHECK_EQ(columns.size(), values.size());
+  DCHECK(!rows_.contains(row));
+  std::vector<ColumnId>* row_entries = nullptr;
+  for (int64_t i = 0; i < columns.size(); ++i) {
+    if (values[i] == 0.0) {
+      continue;
+    }
+    const ColumnId column = columns[i];
+    CHECK(values_.try_emplace({row, column}, values[i]).second)
+        << "duplicated column " << column << " in row " << row;
+    if (row_entries == nullptr) {
+      row_entries = &rows_[row];
+      row_entries->reserve(columns.size() - i);
+    }
+    row_entries->push_back(column);
+    columns_[column].push_back(row);
+    ++nonzeros_;
+  }
+}
+
+template <typename RowId, typename ColumnId>
+void SparseMatrix<RowId, ColumnId>::Reserve(const int64_t num_rows,
+                                            const int64_t num_nonzeros) {
+  rows_.reserve(num_rows);
+  values_.reserve(num_nonzeros);
+}
+
 template <typename RowId, typename ColumnId>
 void SparseMatrix<RowId, ColumnId>::Clear() {
   rows_.clear();
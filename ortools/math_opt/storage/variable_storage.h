@@ -20,12 +20,12 @@
 #include <string>
 #include <vector>
 
-#include "absl/container/flat_hash_map.h"
 #include "absl/container/flat_hash_set.h"
 #include "absl/strings/string_view.h"
 #include "ortools/base/strong_int.h"
 #include "ortools/math_opt/model.pb.h"
 #include "ortools/math_opt/model_update.pb.h"
+#include "ortools/math_opt/storage/id_map.h"
 #include "ortools/math_opt/storage/model_storage_types.h"
 #include "ortools/math_opt/storage/range.h"
 
@@ -110,6 +110,9 @@ class VariableStorage {
   // Sets the next variable id to be the maximum of next_id() and `minimum`.
   inline void ensure_next_id_at_least(VariableId minimum);
 
+  // Reserves the capacity for `size` variables.
+  inline void reserve(int64_t size);
+
   // Returns true if this id has been created and not yet deleted.
   inline bool contains(VariableId id) const;
 
@@ -153,7 +156,7 @@ class VariableStorage {
   void AppendVariable(VariableId variable, VariablesProto* proto) const;
 
   VariableId next_variable_id_ = VariableId(0);
-  absl::flat_hash_map<VariableId, VariableData> variables_;
+  IdMap<VariableId, VariableData> variables_;
 };
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -244,6 +247,8 @@ void VariableStorage::ensure_next_id_at_least(VariableId minimum) {
   next_variable_id_ = std::max(minimum, next_variable_id_);
 }
 
+void VariableStorage::reserve(const int64_t size) { variables_.reserve(size); }
+
 bool VariableStorage::contains(const VariableId id) const {
   return variables_.contains(id);
 }
@@ -15,16 +15,19 @@
 
 #include <cstdint>
 #include <limits>
+#include <string>
 #include <utility>
 
 #include "absl/status/status.h"
 #include "absl/status/statusor.h"
+#include "absl/strings/string_view.h"
 #include "ortools/base/status_builder.h"
 #include "ortools/base/status_macros.h"
 #include "ortools/math_opt/constraints/indicator/validator.h"
 #include "ortools/math_opt/constraints/quadratic/validator.h"
 #include "ortools/math_opt/constraints/second_order_cone/validator.h"
 #include "ortools/math_opt/constraints/sos/validator.h"
+#include "ortools/math_opt/core/linear_model_view.h"
 #include "ortools/math_opt/core/model_summary.h"
 #include "ortools/math_opt/core/sparse_vector_view.h"
 #include "ortools/math_opt/model.pb.h"
@@ -266,6 +269,90 @@ absl::StatusOr<ModelSummary> ValidateModel(const ModelProto& model,
   return model_summary;
 }
 
+absl::StatusOr<ModelSummary> ValidateModel(const LinearModelView& model,
+                                           const bool check_names) {
+  ModelSummary summary(check_names);
+  summary.maximize = model.maximize();
+  summary.primary_objective_name = std::string(model.objective_name());
+  // The views call back for each element, so the first error is kept and the
+  // next elements are skipped.
+  absl::Status status;
+  model.ForEachVariable([&](const int64_t id, const double lower_bound,
+                            const double upper_bound, bool /*is_integer*/,
+                            const absl::string_view name) {
+    if (!status.ok()) return;
+    status = summary.variables.Insert(id, std::string(name));
+    if (status.ok()) {
+      status = CheckScalar(lower_bound, {.allow_positive_infinity = false});
+    }
+    if (status.ok()) {
+      status = CheckScalar(upper_bound, {.allow_negative_infinity = false});
+    }
+    if (!status.ok()) {
+      status = util::StatusBuilder(status) << "invalid variable id: " << id;
+    }
+  });
+  RETURN_IF_ERROR(status) << "model variables are invalid";
+
+  RETURN_IF_ERROR(CheckScalarNoNanNoInf(model.objective_offset()))
+      << "Objective offset invalid";
+  model.ForEachLinearObjectiveCoefficient(
+      [&](const int64_t variable_id, const double coefficient) {
+        if (!status.ok()) return;
+        status = CheckScalar(coefficient, {.allow_positive_infinity = false,
+                                           .allow_negative_infinity = false});
+        if (status.ok() && !summary.variables.HasId(variable_id)) {
+          status = util::InvalidArgumentErrorBuilder()
+                   << "unknown variable id";
+        }
+        if (!status.ok()) {
+          status = util::StatusBuilder(status)
+                   << "invalid coefficient of variable id: " << variable_id;
+        }
+      });
+  RETURN_IF_ERROR(status) << "model objective is invalid";
+
+  model.ForEachLinearConstraint([&](const int64_t id, const double lower_bound,
+                                    const double upper_bound,
+                                    const absl::string_view name) {
+    if (!status.ok()) return;
+    status = summary.linear_constraints.Insert(id, std::string(name));
+    if (status.ok()) {
+      status = CheckScalar(lower_bound, {.allow_positive_infinity = false});
+    }
+    if (status.ok()) {
+      status = CheckScalar(upper_bound, {.allow_negative_infinity = false});
+    }
+    if (!status.ok()) {
+      status = util::StatusBuilder(status)
+               << "invalid linear constraint id: " << id;
+    }
+  });
+  RETURN_IF_ERROR(status) << "model linear constraints are invalid";
+
+  model.ForEachLinearConstraintCoefficient(
+      [&](const int64_t linear_constraint_id, const int64_t variable_id,
+          const double coefficient) {
+        if (!status.ok()) return;
+        status = CheckScalar(coefficient, {.allow_positive_infinity = false,
+                                           .allow_negative_infinity = false});
+        if (status.ok() &&
+            (!summary.linear_constraints.HasId(linear_constraint_id) ||
+             !summary.variables.HasId(variable_id))) {
+          status = util::InvalidArgumentErrorBuilder() << "unknown id";
+        }
+        if (!status.ok()) {
+          status = util::StatusBuilder(status)
+                   << "invalid coefficient of linear constraint id: "
+                   << linear_constraint_id << " and variable id: "
+                   << variable_id;
+        }
+      });
+  RETURN_IF_ERROR(status) << "model linear constraint matrix is invalid";
+
+  return summary;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 // Model Update
 ////////////////////////////////////////////////////////////////////////////////
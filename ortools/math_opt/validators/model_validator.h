@@ -16,6 +16,7 @@
 
 #include "absl/status/status.h"
 #include "absl/status/statusor.h"
+#include "ortools/math_opt/core/linear_model_view.h"
 #include "ortools/math_opt/core/model_summary.h"
 #include "ortools/math_opt/model.pb.h"
 #include "ortools/math_opt/model_update.pb.h"
@@ -28,6 +29,11 @@ namespace math_opt {
 absl::StatusOr<ModelSummary> ValidateModel(const ModelProto& model,
                                            bool check_names = true);
 
+// Same as above for a view of a linear model, with the same checks as for its
+// ModelProto.
+absl::StatusOr<ModelSummary> ValidateModel(const LinearModelView& model,
+                                           bool check_names = true);
+
 // Validates the update is consistent both internally and with current model (as
 // given by model_summary) and updates the model_summary.
 //
@@ -15,10 +15,10 @@
 
 #include <algorithm>
 #include <cstdint>
-#include <set>
 #include <utility>
 #include <vector>
 
+#include "absl/algorithm/container.h"
 #include "absl/container/flat_hash_map.h"
 #include "absl/strings/str_cat.h"
 #include "absl/strings/str_join.h"
@@ -42,10 +42,6 @@ class ArcFlowBuilder {
   // Builds the arc-flow graph.
   ArcFlowGraph BuildVectorBinPackingGraph();
 
-  // For debugging purposes.tring(
-  // Returns the number of states explored in the dynamic programming phase.
-  int64_t NumDpStates() const;
-
  private:
   // All items data, regrouped for sorting purposes.
   struct Item {
@@ -57,11 +53,10 @@ class ArcFlowBuilder {
     double NormalizedSize(absl::Span<const int> bin_dimensions) const;
   };
 
-  // State of the dynamic programming algorithm.
+  // State of the dynamic programming algorithm. Its used dimensions are
+  // stored in dp_dimensions_.
   struct DpState {
     int cur_item_index;
-    int cur_item_quantity;
-    std::vector<int> used_dimensions;
     // DP State indices of the states that can be obtained by moving
     // either "right" to (cur_item_index, cur_item_quantity++) or "up"
     // to (cur_item_index++, cur_item_quantity=0). -1 if impossible.
@@ -69,8 +64,32 @@ class ArcFlowBuilder {
     int up_child;
   };
 
-  // Add item iteratively to create all possible nodes in a forward pass.
-  void ForwardCreationPass(DpState* dp_state);
+  // The DP states of a level, i.e. with the same (cur_item_index,
+  // cur_item_quantity), while the level is being created. Equivalent states
+  // (with the same used dimensions) are merged.
+  struct DpLevel {
+    // Returns the index of the state in the level.
+    int LookupOrCreate(absl::Span<const int> used_dimensions);
+
+    absl::flat_hash_map<std::vector<int>, int> state_indices;
+    // The used dimensions of the states of the level, flattened.
+    std::vector<int> dimensions;
+  };
+
+  // Creates all the possible DP states in a forward pass, level by level.
+  // Only the levels being created are indexed, the other states are stored
+  // without their index.
+  void ForwardCreationPass();
+  // Appends the states of `level` to dp_states_ and returns the index of the
+  // first one.
+  int AppendDpLevel(int item, const DpLevel& level);
+  // The used dimensions of a DP state.
+  absl::Span<int> DpStateDimensions(int state_index) {
+    const int num_dims = bin_dimensions_.size();
+    return absl::MakeSpan(dp_dimensions_)
+        .subspan(static_cast<int64_t>(state_index) * num_dims, num_dims);
+  }
+
   // Scan DP-nodes backward to relabels each nodes by increasing them as much
   // as possible.
   void BackwardCompressionPass(int state_index);
@@ -78,26 +97,22 @@ class ArcFlowBuilder {
   void ForwardCompressionPass(const std::vector<int>& source_node);
 
   // Can we fit one more item in the bin?
-  bool CanFitNewItem(const std::vector<int>& used_dimensions, int item) const;
+  bool CanFitNewItem(absl::Span<const int> used_dimensions, int item) const;
   // Create a new used_dimensions that is used_dimensions + item dimensions.
-  std::vector<int> AddItem(const std::vector<int>& used_dimensions,
+  std::vector<int> AddItem(absl::Span<const int> used_dimensions,
                            int item) const;
 
-  // DpState helpers.
-  int LookupOrCreateDpState(int item, int quantity,
-                            const std::vector<int>& used_dimensions);
-
   const std::vector<int> bin_dimensions_;
   std::vector<Item> items_;
 
   typedef absl::flat_hash_map<std::vector<int>, int> VectorIntIntMap;
   int GetOrCreateNode(const std::vector<int>& used_dimensions);
 
-  // We store all DP states in a dense vector, and remember their index
-  // in the dp_state_index_ map (we use a tri-dimensional indexing because
-  // it's faster for the hash part).
-  std::vector<DpState*> dp_states_;
-  std::vector<std::vector<VectorIntIntMap>> dp_state_index_;
+  // We store all DP states in a dense vector, level by level: the children of
+  // a state always have a larger index. Their used dimensions are stored in a
+  // separate flat vector, with bin_dimensions_.size() values per state.
+  std::vector<DpState> dp_states_;
+  std::vector<int> dp_dimensions_;
 
   // The ArcFlowGraph will have nodes which will correspond to "some"
   // of the vector<int> representing the partial bin usages encountered during
@@ -106,9 +121,18 @@ class ArcFlowBuilder {
   absl::flat_hash_map<std::vector<int>, int> node_indices_;
   std::vector<std::vector<int>> nodes_;
 
-  std::set<ArcFlowGraph::Arc> arcs_;
+  // The arcs of the graph, with duplicates until they are sorted by
+  // SortAndRemoveDuplicateArcs().
+  std::vector<ArcFlowGraph::Arc> arcs_;
 };
 
+void SortAndRemoveDuplicateArcs(std::vector<ArcFlowGraph::Arc>* arcs) {
+  gtl::STLSortAndRemoveDuplicates(
+      arcs, [](const ArcFlowGraph::Arc& a, const ArcFlowGraph::Arc& b) {
+        return a < b;
+      });
+}
+
 double ArcFlowBuilder::Item::NormalizedSize(
     absl::Span<const int> bin_dimensions) const {
   double size = 0.0;
@@ -118,14 +142,16 @@ double ArcFlowBuilder::Item::NormalizedSize(
   return size;
 }
 
-int64_t ArcFlowBuilder::NumDpStates() const {
-  int64_t res = 1;  // We do not store the initial state.
-  for (const auto& it1 : dp_state_index_) {
-    for (const auto& it2 : it1) {
-      res += it2.size();
-    }
+int ArcFlowBuilder::DpLevel::LookupOrCreate(
+    absl::Span<const int> used_dimensions) {
+  const auto [it, inserted] = state_indices.try_emplace(
+      std::vector<int>(used_dimensions.begin(), used_dimensions.end()),
+      state_indices.size());
+  if (inserted) {
+    dimensions.insert(dimensions.end(), used_dimensions.begin(),
+                      used_dimensions.end());
   }
-  return res;
+  return it->second;
 }
 
 ArcFlowBuilder::ArcFlowBuilder(
@@ -151,7 +177,7 @@ ArcFlowBuilder::ArcFlowBuilder(
   });
 }
 
-bool ArcFlowBuilder::CanFitNewItem(const std::vector<int>& used_dimensions,
+bool ArcFlowBuilder::CanFitNewItem(absl::Span<const int> used_dimensions,
                                    int item) const {
   for (int d = 0; d < bin_dimensions_.size(); ++d) {
     if (used_dimensions[d] + items_[item].dimensions[d] > bin_dimensions_[d]) {
@@ -162,9 +188,9 @@ bool ArcFlowBuilder::CanFitNewItem(const std::vector<int>& used_dimensions,
 }
 
 std::vector<int> ArcFlowBuilder::AddItem(
-    const std::vector<int>& used_dimensions, int item) const {
+    absl::Span<const int> used_dimensions, int item) const {
   DCHECK(CanFitNewItem(used_dimensions, item));
-  std::vector<int> result = used_dimensions;
+  std::vector<int> result(used_dimensions.begin(), used_dimensions.end());
   for (int d = 0; d < bin_dimensions_.size(); ++d) {
     result[d] += items_[item].dimensions[d];
   }
@@ -183,125 +209,137 @@ int ArcFlowBuilder::GetOrCreateNode(const std::vector<int>& used_dimensions) {
 }
 
 ArcFlowGraph ArcFlowBuilder::BuildVectorBinPackingGraph() {
-  // Initialize the DP states map.
-  dp_state_index_.resize(items_.size());
-  for (int i = 0; i < items_.size(); ++i) {
-    dp_state_index_[i].resize(items_[i].demand + 1);
-  }
-
   // Explore all possible DP states (starting from the initial 'empty' state),
   // and remember their ancestry.
-  std::vector<int> zero(bin_dimensions_.size(), 0);
-  dp_states_.push_back(new DpState({0, 0, zero, -1, -1}));
-  for (int i = 0; i < dp_states_.size(); ++i) {
-    ForwardCreationPass(dp_states_[i]);
-  }
-
-  // We can clear the dp_state_index map as it will not be used anymore.
-  // From now on, we will use the dp_states.used_dimensions to store the new
-  // labels in the backward pass.
-  const int64_t num_dp_states = NumDpStates();
-  dp_state_index_.clear();
-
-  // Backwards pass: "push" the bin dimensions as far as possible.
-  const int num_states = dp_states_.size();
-  std::vector<std::pair<int, int>> flat_deps;
-  for (int i = 0; i < dp_states_.size(); ++i) {
-    if (dp_states_[i]->up_child != -1) {
-      flat_deps.push_back(std::make_pair(dp_states_[i]->up_child, i));
-    }
-    if (dp_states_[i]->right_child != -1) {
-      flat_deps.push_back(std::make_pair(dp_states_[i]->right_child, i));
-    }
-  }
-  const std::vector<int> sorted_work =
-      util::graph::DenseIntStableTopologicalSortOrDie(num_states, flat_deps);
-  for (const int w : sorted_work) {
-    BackwardCompressionPass(w);
+  ForwardCreationPass();
+  const int64_t num_dp_states = dp_states_.size();
+
+  // Backwards pass: "push" the bin dimensions as far as possible. The children
+  // of a state have a larger index, so scanning the states by decreasing
+  // index visits the children first. From now on, we will use dp_dimensions_
+  // to store the new labels.
+  for (int state = dp_states_.size() - 1; state >= 0; --state) {
+    BackwardCompressionPass(state);
   }
+  SortAndRemoveDuplicateArcs(&arcs_);
 
   // ForwardCreationPass again, push the bin dimensions as low as possible.
-  const std::vector<int> source_node = dp_states_[0]->used_dimensions;
-  // We can now delete the states stored in dp_states_.
-  gtl::STLDeleteElements(&dp_states_);
+  const absl::Span<const int> source_dimensions = DpStateDimensions(0);
+  const std::vector<int> source_node(source_dimensions.begin(),
+                                     source_dimensions.end());
+  // We can now delete the DP states.
+  gtl::STLClearObject(&dp_states_);
+  gtl::STLClearObject(&dp_dimensions_);
   ForwardCompressionPass(source_node);
 
   // We need to connect all nodes that corresponds to at least one item selected
   // to the sink node.
   const int sink_node_index = nodes_.size() - 1;
   for (int node = 1; node < sink_node_index; ++node) {
-    arcs_.insert({node, sink_node_index, -1});
+    arcs_.push_back({node, sink_node_index, -1});
   }
+  SortAndRemoveDuplicateArcs(&arcs_);
 
   ArcFlowGraph result;
-  result.arcs.assign(arcs_.begin(), arcs_.end());
-  result.nodes.assign(nodes_.begin(), nodes_.end());
+  result.arcs = std::move(arcs_);
+  result.nodes = std::move(nodes_);
   result.num_dp_states = num_dp_states;
   return result;
 }
 
-int ArcFlowBuilder::LookupOrCreateDpState(
-    int item, int quantity, const std::vector<int>& used_dimensions) {
-  VectorIntIntMap& map = dp_state_index_[item][quantity];
-  const int index =
-      map.insert({used_dimensions, dp_states_.size()}).first->second;
-  if (index == dp_states_.size()) {
-    dp_states_.push_back(
-        new DpState({item, quantity, used_dimensions, -1, -1}));
+int ArcFlowBuilder::AppendDpLevel(int item, const DpLevel& level) {
+  const int first_state = dp_states_.size();
+  for (int i = 0; i < level.state_indices.size(); ++i) {
+    dp_states_.push_back({item, -1, -1});
   }
-  return index;
+  dp_dimensions_.insert(dp_dimensions_.end(), level.dimensions.begin(),
+                        level.dimensions.end());
+  return first_state;
 }
 
-void ArcFlowBuilder::ForwardCreationPass(DpState* dp_state) {
-  const int item = dp_state->cur_item_index;
-  const int quantity = dp_state->cur_item_quantity;
-  const std::vector<int>& used_dimensions = dp_state->used_dimensions;
-
-  // Explore path up.
-  if (item < items_.size() - 1) {
-    dp_state->up_child = LookupOrCreateDpState(item + 1, 0, used_dimensions);
-  } else {
-    dp_state->up_child = -1;
-  }
+void ArcFlowBuilder::ForwardCreationPass() {
+  // The levels are created in the order (0, 0), (0, 1), ..., (0, demand_0),
+  // (1, 0), ...: the "right" children of the states of a level are in the next
+  // level, and their "up" children in the first level of the next item. So
+  // only these two levels need to be indexed while the states of a level are
+  // expanded.
+  DpLevel next_item_level;
+  next_item_level.LookupOrCreate(std::vector<int>(bin_dimensions_.size(), 0));
+  int item_first_state = 0;
+  for (int item = 0; item < items_.size(); ++item) {
+    const int first_state = AppendDpLevel(item, next_item_level);
+    // The "up" children of the previous item were indexed in their level.
+    for (int state = item_first_state; state < first_state; ++state) {
+      if (dp_states_[state].up_child != -1) {
+        dp_states_[state].up_child += first_state;
+      }
+    }
+    item_first_state = first_state;
+    next_item_level = DpLevel();
+
+    int level_first_state = first_state;
+    for (int quantity = 0;; ++quantity) {
+      const int level_end = dp_states_.size();
+      if (level_first_state == level_end) break;
+      DpLevel next_level;
+      for (int state = level_first_state; state < level_end; ++state) {
+        const absl::Span<const int> used_dimensions = DpStateDimensions(state);
+
+        // Explore path up.
+        if (item < items_.size() - 1) {
+          // The index in next_item_level, made global when it is appended.
+          dp_states_[state].up_child =
+              next_item_level.LookupOrCreate(used_dimensions);
+        }
 
-  // Explore path right.
-  if (quantity < items_[item].demand && CanFitNewItem(used_dimensions, item)) {
-    const std::vector<int> added = AddItem(used_dimensions, item);
-    dp_state->right_child = LookupOrCreateDpState(item, quantity + 1, added);
-  } else {
-    dp_state->right_child = -1;
+        // Explore path right. The next level is appended right after this
+        // one.
+        if (quantity < items_[item].demand &&
+            CanFitNewItem(used_dimensions, item)) {
+          dp_states_[state].right_child =
+              level_end +
+              next_level.LookupOrCreate(AddItem(used_dimensions, item));
+        }
+      }
+      level_first_state = AppendDpLevel(item, next_level);
+    }
   }
 }
 
 void ArcFlowBuilder::BackwardCompressionPass(int state_index) {
   // The goal of this function is to fill this.
-  std::vector<int>& result = dp_states_[state_index]->used_dimensions;
+  const absl::Span<int> result = DpStateDimensions(state_index);
 
   // Inherit our result from the result one step up.
-  const int up_index = dp_states_[state_index]->up_child;
-  const std::vector<int>& result_up =
-      up_index == -1 ? bin_dimensions_ : dp_states_[up_index]->used_dimensions;
-  result = result_up;
+  const int up_index = dp_states_[state_index].up_child;
+  const std::vector<int> result_up =
+      up_index == -1 ? bin_dimensions_
+                     : std::vector<int>(DpStateDimensions(up_index).begin(),
+                                        DpStateDimensions(up_index).end());
+  absl::c_copy(result_up, result.begin());
 
   // Adjust our result from the result one step right.
-  const int right_index = dp_states_[state_index]->right_child;
+  const int right_index = dp_states_[state_index].right_child;
   if (right_index == -1) return;  // We're done.
-  const std::vector<int>& result_right =
-      dp_states_[right_index]->used_dimensions;
-  const Item& item = items_[dp_states_[state_index]->cur_item_index];
+  const absl::Span<const int> right_dimensions =
+      DpStateDimensions(right_index);
+  const std::vector<int> result_right(right_dimensions.begin(),
+                                      right_dimensions.end());
+  const Item& item = items_[dp_states_[state_index].cur_item_index];
   for (int d = 0; d < bin_dimensions_.size(); ++d) {
     result[d] = std::min(result[d], result_right[d] - item.dimensions[d]);
   }
 
   // Insert the arc from the node to the "right" node.
-  const int node = GetOrCreateNode(result);
+  const std::vector<int> result_node(result.begin(), result.end());
+  const int node = GetOrCreateNode(result_node);
   const int right_node = GetOrCreateNode(result_right);
   DCHECK_NE(node, right_node);
-  arcs_.insert({node, right_node, item.original_index});
+  arcs_.push_back({node, right_node, item.original_index});
   // Also insert the 'dotted' arc from the node to the "up" node (if different).
-  if (result != result_up) {
+  if (result_node != result_up) {
     const int up_node = GetOrCreateNode(result_up);
-    arcs_.insert({node, up_node, -1});
+    arcs_.push_back({node, up_node, -1});
   }
 }
 
@@ -313,7 +351,7 @@ void ArcFlowBuilder::ForwardCompressionPass(
     const std::vector<int>& source_node) {
   const int num_nodes = node_indices_.size();
   const int num_dims = bin_dimensions_.size();
-  std::set<ArcFlowGraph::Arc> new_arcs;
+  std::vector<ArcFlowGraph::Arc> new_arcs;
   std::vector<std::vector<int>> new_nodes;
   VectorIntIntMap new_node_indices;
   std::vector<int> node_remap(num_nodes, -1);
@@ -324,6 +362,7 @@ void ArcFlowBuilder::ForwardCompressionPass(
   }
 
   std::vector<std::pair<int, int>> forward_deps;
+  forward_deps.reserve(arcs_.size());
   std::vector<std::vector<ArcFlowGraph::Arc>> incoming_arcs(num_nodes);
   for (const ArcFlowGraph::Arc& arc : arcs_) {
     forward_deps.push_back(std::make_pair(arc.source, arc.destination));
@@ -379,13 +418,14 @@ void ArcFlowBuilder::ForwardCompressionPass(
     if (arc.item_index == -1 &&
         node_remap[arc.source] == node_remap[arc.destination])
       continue;
-    new_arcs.insert(
+    new_arcs.push_back(
         {node_remap[arc.source], node_remap[arc.destination], arc.item_index});
   }
+  SortAndRemoveDuplicateArcs(&new_arcs);
   VLOG(1) << "Reduced nodes from " << num_nodes << " to " << new_nodes.size();
   VLOG(1) << "Reduced arcs from " << arcs_.size() << " to " << new_arcs.size();
-  nodes_ = new_nodes;
-  arcs_ = new_arcs;
+  nodes_ = std::move(new_nodes);
+  arcs_ = std::move(new_arcs);
   CHECK_NE(node_remap[old_source_node], -1);
   CHECK_EQ(0, node_remap[old_source_node]);
   CHECK_NE(node_remap[old_sink_node], -1);
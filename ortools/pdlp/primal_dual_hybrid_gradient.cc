@@ -19,6 +19,7 @@
 #include <cstdint>
 #include <functional>
 #include <limits>
+#include <memory>
 #include <optional>
 #include <random>
 #include <string>
@@ -34,11 +35,13 @@
 #include "absl/strings/str_cat.h"
 #include "absl/strings/str_format.h"
 #include "absl/strings/string_view.h"
+#include "absl/synchronization/notification.h"
 #include "absl/time/clock.h"
 #include "absl/time/time.h"
 #include "google/protobuf/repeated_ptr_field.h"
 #include "ortools/base/logging.h"
 #include "ortools/base/mathutil.h"
+#include "ortools/base/threadpool.h"
 #include "ortools/base/timer.h"
 #include "ortools/glop/parameters.pb.h"
 #include "ortools/glop/preprocessor.h"
@@ -57,6 +60,7 @@
 #include "ortools/pdlp/termination.h"
 #include "ortools/pdlp/trust_region.h"
 #include "ortools/util/logging.h"
+#include "ortools/util/stats.h"
 
 namespace operations_research::pdlp {
 
@@ -332,7 +336,10 @@ class PreprocessSolver {
   PreprocessSolver(PreprocessSolver&&) = delete;
   PreprocessSolver& operator=(PreprocessSolver&&) = delete;
 
-  // Zero is used if `initial_solution` is nullopt. If `interrupt_solve` is not
+  // Zero is used if `initial_solution` is nullopt. `warm_start_state`, if
+  // present, replaces the rescaling and the initial step size and primal
+  // weight computations when it matches the problem (see the public
+  // `PrimalDualHybridGradient()` overload). If `interrupt_solve` is not
   // nullptr, then the solver will periodically check if
   // `interrupt_solve->load()` is true, in which case the solve will terminate
   // with `TERMINATION_REASON_INTERRUPTED_BY_USER`. Ownership is not
@@ -342,6 +349,7 @@ class PreprocessSolver {
   SolverResult PreprocessAndSolve(
       const PrimalDualHybridGradientParams& params,
       std::optional<PrimalAndDualSolution> initial_solution,
+      std::optional<PdlpWarmStartState> warm_start_state,
       const std::atomic<bool>* interrupt_solve,
       IterationStatsCallback iteration_stats_callback);
 
@@ -419,6 +427,15 @@ class PreprocessSolver {
 
   SolverLogger& Logger() { return logger_; }
 
+  // Returns a copy of this object for running feasibility polishing phases on
+  // another thread: it has its own copy of the working problem, sharded for a
+  // single thread, the same scaling vectors and bound norms, and no iteration
+  // stats callback. `logger` must outlive the copy. Presolve must not have
+  // been applied.
+  std::unique_ptr<PreprocessSolver> CloneForConcurrentPolishing(
+      const PrimalDualHybridGradientParams& params,
+      SolverLogger* logger) const;
+
  private:
   struct PresolveInfo {
     explicit PresolveInfo(ShardedQuadraticProgram original_qp,
@@ -452,7 +469,10 @@ class PreprocessSolver {
       const PrimalDualHybridGradientParams& params,
       std::optional<PrimalAndDualSolution>* initial_solution);
 
+  // Applies the scaling vectors of `warm_start_state` if it is not nullptr,
+  // otherwise computes the rescaling specified by `params`.
   void ComputeAndApplyRescaling(const PrimalDualHybridGradientParams& params,
+                                const PdlpWarmStartState* warm_start_state,
                                 VectorXd& starting_primal_solution,
                                 VectorXd& starting_dual_solution);
 
@@ -477,6 +497,10 @@ class PreprocessSolver {
 
   const int num_threads_;
   const int num_shards_;
+  const bool pin_threads_to_cpus_;
+  // The pool of `sharded_qp_` if it isn't owned by it, see
+  // `use_shared_thread_pool`.
+  ThreadPool* const thread_pool_;
 
   // The bound norms of the original problem.
   QuadraticProgramBoundNorms original_bound_norms_;
@@ -539,11 +563,17 @@ class Solver {
                      const std::atomic<bool>* interrupt_solve,
                      SolveLog solve_log);
 
+  // The current step size and primal weight, e.g. once `Solve()` returned.
+  double StepSize() const { return step_size_; }
+  double PrimalWeight() const { return primal_weight_; }
+
  private:
   struct NextSolutionAndDelta {
     VectorXd value;
     // `delta` is `value` - current_solution.
     VectorXd delta;
+    // The squared norm of `delta`, computed in the same pass as `delta`.
+    double delta_squared_norm = 0.0;
   };
 
   struct DistanceBasedRestartInfo {
@@ -551,6 +581,31 @@ class Solver {
     int length_of_last_restart_period;
   };
 
+  // A feasibility polishing attempt running concurrently with the main
+  // iterations, see `run_feasibility_polishing_concurrently`.
+  struct ConcurrentPolishing {
+    // Interrupts the attempt and waits for it to finish.
+    ~ConcurrentPolishing() {
+      interrupt.store(true);
+      thread.reset();
+    }
+
+    // Logging of the polishing phases is disabled, the logger of the main
+    // solve isn't meant to be used from several threads.
+    SolverLogger logger;
+    std::unique_ptr<PreprocessSolver> preprocess_solver;
+    // A copy of the main solver state when the attempt started.
+    std::unique_ptr<Solver> snapshot;
+    // Holds the feasibility polishing details of the previous attempts, and
+    // then those of this attempt.
+    SolveLog solve_log;
+    int num_previous_details = 0;
+    std::optional<SolverResult> result;
+    std::atomic<bool> interrupt = false;
+    absl::Notification done;
+    std::unique_ptr<ThreadPool> thread;
+  };
+
   // Movement terms (weighted squared norms of primal and dual deltas) larger
   // than this cause termination because iterates are diverging, and likely to
   // cause infinite and NaN values.
@@ -565,6 +620,15 @@ class Solver {
       int iteration_limit, const std::atomic<bool>* interrupt_solve,
       SolveLog& solve_log);
 
+  // Starts `TryFeasibilityPolishing()` on another thread, from a snapshot of
+  // the average iterate, in `concurrent_polishing_` (which must be nullptr).
+  void StartConcurrentPolishing(int iteration_limit, const SolveLog& solve_log);
+
+  // Waits for `concurrent_polishing_` to finish, appends its feasibility
+  // polishing details to `solve_log`, and resets it. Returns the polished
+  // solution if it met the termination criteria, otherwise nullopt.
+  std::optional<SolverResult> FinishConcurrentPolishing(SolveLog& solve_log);
+
   // Tries to find primal feasibility, adds the solve log details to
   // `solve_log.feasibility_polishing_details`, and returns the result.
   SolverResult TryPrimalPolishing(VectorXd starting_primal_solution,
@@ -585,12 +649,26 @@ class Solver {
       double dual_step_size, double extrapolation_factor,
       const NextSolutionAndDelta& next_primal) const;
 
-  double ComputeMovement(const VectorXd& delta_primal,
-                         const VectorXd& delta_dual) const;
+  // Returns true if the matrix-vector products of the iterations should use the
+  // single precision copies of the constraint matrix.
+  bool UseFloat32MatrixProducts() const;
+
+  // Returns K^T `dual_solution` for the PDHG iterations.
+  VectorXd ComputeIterationDualProduct(const VectorXd& dual_solution) const;
+
+  double ComputeMovement(const NextSolutionAndDelta& next_primal,
+                         const NextSolutionAndDelta& next_dual) const;
 
   double ComputeNonlinearity(const VectorXd& delta_primal,
                              const VectorXd& next_dual_product) const;
 
+  // Returns K^T `dual_solution` like `ComputeIterationDualProduct()` and sets
+  // `nonlinearity` to `ComputeNonlinearity(delta_primal, <the result>)`. Both
+  // are computed in the same pass over each shard when possible.
+  VectorXd ComputeIterationDualProductAndNonlinearity(
+      const VectorXd& dual_solution, const VectorXd& delta_primal,
+      double& nonlinearity) const;
+
   // Creates all the simple-to-compute statistics in stats.
   IterationStats CreateSimpleIterationStats(RestartChoice restart_used) const;
 
@@ -598,6 +676,10 @@ class Solver {
   // polishing phases.
   IterationStats TotalWorkSoFar(const SolveLog& solve_log) const;
 
+  // Returns the work of the feasibility polishing phases in `solve_log`,
+  // without their time when they ran concurrently with the main iterations.
+  IterationStats FeasibilityPolishingWork(const SolveLog& solve_log) const;
+
   RestartChoice ChooseRestartToApply(bool is_major_iteration);
 
   VectorXd PrimalAverage() const;
@@ -710,6 +792,8 @@ class Solver {
           std::numeric_limits<double>::infinity(),
       .length_of_last_restart_period = 1,
   };
+  // The feasibility polishing attempt in progress, if any.
+  std::unique_ptr<ConcurrentPolishing> concurrent_polishing_;
 };
 
 PreprocessSolver::PreprocessSolver(QuadraticProgram qp,
@@ -718,9 +802,29 @@ PreprocessSolver::PreprocessSolver(QuadraticProgram qp,
     : num_threads_(
           NumThreads(params.num_threads(), params.num_shards(), qp, *logger)),
       num_shards_(NumShards(num_threads_, params.num_shards())),
-      sharded_qp_(std::move(qp), num_threads_, num_shards_),
+      pin_threads_to_cpus_(params.pin_threads_to_cpus()),
+      thread_pool_(params.use_shared_thread_pool() ? SharedThreadPool()
+                                                   : nullptr),
+      sharded_qp_(std::move(qp), num_threads_, num_shards_, /*logger=*/nullptr,
+                  pin_threads_to_cpus_, thread_pool_),
       logger_(*logger) {}
 
+std::unique_ptr<PreprocessSolver> PreprocessSolver::CloneForConcurrentPolishing(
+    const PrimalDualHybridGradientParams& params, SolverLogger* logger) const {
+  CHECK(!presolve_info_.has_value());
+  PrimalDualHybridGradientParams single_thread_params = params;
+  single_thread_params.set_num_threads(1);
+  single_thread_params.clear_num_shards();
+  single_thread_params.set_pin_threads_to_cpus(false);
+  single_thread_params.set_use_shared_thread_pool(false);
+  auto clone =
+      std::make_unique<PreprocessSolver>(Qp(), single_thread_params, logger);
+  clone->original_bound_norms_ = original_bound_norms_;
+  clone->col_scaling_vec_ = col_scaling_vec_;
+  clone->row_scaling_vec_ = row_scaling_vec_;
+  return clone;
+}
+
 SolverResult ErrorSolverResult(const TerminationReason reason,
                                const std::string& message,
                                SolverLogger& logger) {
@@ -984,9 +1088,28 @@ std::optional<SolverResult> CheckInitialSolution(
   return std::nullopt;
 }
 
+// Returns true if the scaling vectors of `warm_start_state` have the sizes of
+// `sharded_qp` and are positive and finite.
+bool WarmStartStateMatchesProblem(const PdlpWarmStartState& warm_start_state,
+                                  const ShardedQuadraticProgram& sharded_qp) {
+  auto is_valid_scaling = [](const VectorXd& scaling_vec,
+                             const Sharder& sharder) {
+    return scaling_vec.size() == sharder.NumElements() &&
+           sharder.ParallelTrueForAllShards([&](const Sharder::Shard& shard) {
+             return (shard(scaling_vec).array() > 0.0).all() &&
+                    shard(scaling_vec).allFinite();
+           });
+  };
+  return is_valid_scaling(warm_start_state.col_scaling_vec,
+                          sharded_qp.PrimalSharder()) &&
+         is_valid_scaling(warm_start_state.row_scaling_vec,
+                          sharded_qp.DualSharder());
+}
+
 SolverResult PreprocessSolver::PreprocessAndSolve(
     const PrimalDualHybridGradientParams& params,
     std::optional<PrimalAndDualSolution> initial_solution,
+    std::optional<PdlpWarmStartState> warm_start_state,
     const std::atomic<bool>* interrupt_solve,
     IterationStatsCallback iteration_stats_callback) {
   WallTimer timer;
@@ -1112,17 +1235,47 @@ SolverResult PreprocessSolver::PreprocessAndSolve(
   ProjectToPrimalVariableBounds(sharded_qp_, starting_primal_solution);
   ProjectToDualVariableBounds(sharded_qp_, starting_dual_solution);
 
-  ComputeAndApplyRescaling(params, starting_primal_solution,
-                           starting_dual_solution);
+  if (warm_start_state.has_value()) {
+    if (presolve_info_.has_value()) {
+      SOLVER_LOG(&logger_,
+                 "WARNING: Ignoring the warm start state because presolve is "
+                 "enabled.");
+      warm_start_state.reset();
+    } else if (!WarmStartStateMatchesProblem(*warm_start_state, sharded_qp_)) {
+      SOLVER_LOG(&logger_,
+                 "WARNING: Ignoring the warm start state because its scaling "
+                 "vectors don't match the problem.");
+      warm_start_state.reset();
+    }
+  }
+  ComputeAndApplyRescaling(
+      params, warm_start_state.has_value() ? &*warm_start_state : nullptr,
+      starting_primal_solution, starting_dual_solution);
+  if (params.use_float32_matrix_products() &&
+      !sharded_qp_.CreateFloat32ConstraintMatrices()) {
+    SOLVER_LOG(&logger_,
+               "WARNING: The constraint matrix is too large for 32-bit "
+               "indices, ignoring use_float32_matrix_products.");
+  }
   *solve_log.mutable_preprocessed_problem_stats() = ComputeStats(sharded_qp_);
   if (params.verbosity_level() >= 1) {
     SOLVER_LOG(&logger_, "Problem stats after ", preprocessing_string);
     LogQuadraticProgramStats(solve_log.preprocessed_problem_stats());
   }
 
+  // A constant step size must stay below the inverse of the norm of the
+  // constraint matrix, which may have changed since the warm start state was
+  // computed, so it is only reused by the adaptive rules.
+  const bool reuse_step_size =
+      warm_start_state.has_value() && warm_start_state->step_size > 0.0 &&
+      std::isfinite(warm_start_state->step_size) &&
+      params.linesearch_rule() !=
+          PrimalDualHybridGradientParams::CONSTANT_STEP_SIZE_RULE;
   double step_size = 0.0;
-  if (params.linesearch_rule() ==
-      PrimalDualHybridGradientParams::CONSTANT_STEP_SIZE_RULE) {
+  if (reuse_step_size) {
+    step_size = warm_start_state->step_size;
+  } else if (params.linesearch_rule() ==
+             PrimalDualHybridGradientParams::CONSTANT_STEP_SIZE_RULE) {
     std::mt19937 random(1);
     double inverse_step_size;
     const auto lipschitz_result =
@@ -1154,18 +1307,33 @@ SolverResult PreprocessSolver::PreprocessAndSolve(
             1.0e-20,
             solve_log.preprocessed_problem_stats().constraint_matrix_abs_max());
   }
-  step_size *= params.initial_step_size_scaling();
+  if (!reuse_step_size) step_size *= params.initial_step_size_scaling();
 
-  const double primal_weight = InitialPrimalWeight(
-      params, solve_log.preprocessed_problem_stats().objective_vector_l2_norm(),
-      solve_log.preprocessed_problem_stats().combined_bounds_l2_norm());
+  double primal_weight;
+  if (warm_start_state.has_value() && warm_start_state->primal_weight > 0.0 &&
+      std::isfinite(warm_start_state->primal_weight)) {
+    primal_weight = warm_start_state->primal_weight;
+  } else {
+    primal_weight = InitialPrimalWeight(
+        params,
+        solve_log.preprocessed_problem_stats().objective_vector_l2_norm(),
+        solve_log.preprocessed_problem_stats().combined_bounds_l2_norm());
+  }
 
   Solver solver(params, starting_primal_solution, starting_dual_solution,
                 step_size, primal_weight, this);
   solve_log.set_preprocessing_time_sec(timer.Get());
   SolverResult result = solver.Solve(IterationType::kNormal, interrupt_solve,
                                      std::move(solve_log));
-  return ConstructOriginalSolverResult(params, std::move(result), logger_);
+  result = ConstructOriginalSolverResult(params, std::move(result), logger_);
+  if (!presolve_info_.has_value()) {
+    result.warm_start_state =
+        PdlpWarmStartState{.col_scaling_vec = col_scaling_vec_,
+                           .row_scaling_vec = row_scaling_vec_,
+                           .step_size = solver.StepSize(),
+                           .primal_weight = solver.PrimalWeight()};
+  }
+  return result;
 }
 
 glop::GlopParameters PreprocessSolver::PreprocessorParameters(
@@ -1257,7 +1425,8 @@ std::optional<TerminationReason> PreprocessSolver::ApplyPresolveIfEnabled(
   // set it for completeness.
   presolved_qp->objective_scaling_factor = glop_lp.objective_scaling_factor();
   sharded_qp_ = ShardedQuadraticProgram(std::move(*presolved_qp), num_threads_,
-                                        num_shards_);
+                                        num_shards_, /*logger=*/nullptr,
+                                        pin_threads_to_cpus_, thread_pool_);
   // A status of `INIT` means the preprocessor created a (usually) smaller
   // problem that needs solving. Other statuses mean the preprocessor solved
   // the problem completely.
@@ -1272,13 +1441,21 @@ std::optional<TerminationReason> PreprocessSolver::ApplyPresolveIfEnabled(
 
 void PreprocessSolver::ComputeAndApplyRescaling(
     const PrimalDualHybridGradientParams& params,
+    const PdlpWarmStartState* warm_start_state,
     VectorXd& starting_primal_solution, VectorXd& starting_dual_solution) {
-  ScalingVectors scaling = ApplyRescaling(
-      RescalingOptions{.l_inf_ruiz_iterations = params.l_inf_ruiz_iterations(),
-                       .l2_norm_rescaling = params.l2_norm_rescaling()},
-      sharded_qp_);
-  row_scaling_vec_ = std::move(scaling.row_scaling_vec);
-  col_scaling_vec_ = std::move(scaling.col_scaling_vec);
+  if (warm_start_state != nullptr) {
+    col_scaling_vec_ = warm_start_state->col_scaling_vec;
+    row_scaling_vec_ = warm_start_state->row_scaling_vec;
+    sharded_qp_.RescaleQuadraticProgram(col_scaling_vec_, row_scaling_vec_);
+  } else {
+    ScalingVectors scaling = ApplyRescaling(
+        RescalingOptions{
+            .l_inf_ruiz_iterations = params.l_inf_ruiz_iterations(),
+            .l2_norm_rescaling = params.l2_norm_rescaling()},
+        sharded_qp_);
+    row_scaling_vec_ = std::move(scaling.row_scaling_vec);
+    col_scaling_vec_ = std::move(scaling.col_scaling_vec);
+  }
 
   CoefficientWiseQuotientInPlace(col_scaling_vec_, sharded_qp_.PrimalSharder(),
                                  starting_primal_solution);
@@ -1795,8 +1972,11 @@ Solver::NextSolutionAndDelta Solver::ComputeNextPrimalSolution(
   // We omitted the constant terms from Chambolle and Pock's (7).
   // This minimization is easy to do in closed form since it can be separated
   // into independent problems for each of the primal variables.
-  ShardedWorkingQp().PrimalSharder().ParallelForEachShard(
-      [&](const Sharder::Shard& shard) {
+  // The squared norm of the delta is computed in the same pass since all the
+  // step size rules need it.
+  const Sharder& primal_sharder = ShardedWorkingQp().PrimalSharder();
+  result.delta_squared_norm =
+      primal_sharder.ParallelSumOverShards([&](const Sharder::Shard& shard) {
         if (!IsLinearProgram(qp)) {
           // TODO(user): Does changing this to auto (so it becomes an
           // Eigen deferred result), or inlining it below, change performance?
@@ -1823,6 +2003,7 @@ Solver::NextSolutionAndDelta Solver::ComputeNextPrimalSolution(
         }
         shard(result.delta) =
             shard(result.value) - shard(current_primal_solution_);
+        return shard(result.delta).squaredNorm();
       });
   return result;
 }
@@ -1846,14 +2027,28 @@ Solver::NextSolutionAndDelta Solver::ComputeNextDualSolution(
   // TODO(user): Refactor this multiplication so that we only do one matrix
   // vector multiply for the primal variable. This only applies to Malitsky and
   // Pock and not to the adaptive step size rule.
-  ShardedWorkingQp().TransposedConstraintMatrixSharder().ParallelForEachShard(
-      [&](const Sharder::Shard& shard) {
-        VectorXd temp =
-            shard(current_dual_solution_) -
-            dual_step_size *
-                shard(ShardedWorkingQp().TransposedConstraintMatrix())
-                    .transpose() *
-                extrapolated_primal;
+  VectorXd float32_primal_product;
+  if (UseFloat32MatrixProducts()) {
+    float32_primal_product = TransposedMatrixVectorProduct(
+        ShardedWorkingQp().Float32TransposedConstraintMatrix(),
+        extrapolated_primal,
+        ShardedWorkingQp().TransposedConstraintMatrixSharder());
+  }
+  const Sharder& dual_sharder =
+      ShardedWorkingQp().TransposedConstraintMatrixSharder();
+  result.delta_squared_norm =
+      dual_sharder.ParallelSumOverShards([&](const Sharder::Shard& shard) {
+        VectorXd temp;
+        if (UseFloat32MatrixProducts()) {
+          temp = shard(current_dual_solution_) -
+                 dual_step_size * shard(float32_primal_product);
+        } else {
+          temp = shard(current_dual_solution_) -
+                 dual_step_size *
+                     shard(ShardedWorkingQp().TransposedConstraintMatrix())
+                         .transpose() *
+                     extrapolated_primal;
+        }
         // Each element of the argument of `.cwiseMin()` is the critical point
         // of the respective 1D minimization problem if it's negative.
         // Likewise the argument to the `.cwiseMax()` is the critical point if
@@ -1866,18 +2061,34 @@ Solver::NextSolutionAndDelta Solver::ComputeNextDualSolution(
                           dual_step_size * shard(qp.constraint_lower_bounds));
         shard(result.delta) =
             (shard(result.value) - shard(current_dual_solution_));
+        return shard(result.delta).squaredNorm();
       });
   return result;
 }
 
-double Solver::ComputeMovement(const VectorXd& delta_primal,
-                               const VectorXd& delta_dual) const {
+bool Solver::UseFloat32MatrixProducts() const {
+  return params_.use_float32_matrix_products() &&
+         ShardedWorkingQp().HasFloat32ConstraintMatrices();
+}
+
+VectorXd Solver::ComputeIterationDualProduct(
+    const VectorXd& dual_solution) const {
+  if (UseFloat32MatrixProducts()) {
+    return TransposedMatrixVectorProduct(
+        ShardedWorkingQp().Float32ConstraintMatrix(), dual_solution,
+        ShardedWorkingQp().ConstraintMatrixSharder());
+  }
+  return TransposedMatrixVectorProduct(
+      WorkingQp().constraint_matrix, dual_solution,
+      ShardedWorkingQp().ConstraintMatrixSharder());
+}
+
+double Solver::ComputeMovement(const NextSolutionAndDelta& next_primal,
+                               const NextSolutionAndDelta& next_dual) const {
   const double primal_movement =
-      (0.5 * primal_weight_) *
-      SquaredNorm(delta_primal, ShardedWorkingQp().PrimalSharder());
+      (0.5 * primal_weight_) * next_primal.delta_squared_norm;
   const double dual_movement =
-      (0.5 / primal_weight_) *
-      SquaredNorm(delta_dual, ShardedWorkingQp().DualSharder());
+      (0.5 / primal_weight_) * next_dual.delta_squared_norm;
   return primal_movement + dual_movement;
 }
 
@@ -1893,6 +2104,31 @@ double Solver::ComputeNonlinearity(const VectorXd& delta_primal,
       });
 }
 
+VectorXd Solver::ComputeIterationDualProductAndNonlinearity(
+    const VectorXd& dual_solution, const VectorXd& delta_primal,
+    double& nonlinearity) const {
+  if (UseFloat32MatrixProducts()) {
+    VectorXd dual_product = ComputeIterationDualProduct(dual_solution);
+    nonlinearity = ComputeNonlinearity(delta_primal, dual_product);
+    return dual_product;
+  }
+  // The shards of the constraint matrix are also shards of the primal vectors,
+  // so the nonlinearity terms can be summed while the product is still hot in
+  // the cache.
+  VectorXd dual_product(ShardedWorkingQp().PrimalSize());
+  nonlinearity =
+      ShardedWorkingQp().ConstraintMatrixSharder().ParallelSumOverShards(
+          [&](const Sharder::Shard& shard) {
+            shard(dual_product) =
+                shard(WorkingQp().constraint_matrix).transpose() *
+                dual_solution;
+            return -shard(delta_primal)
+                        .dot(shard(dual_product) -
+                             shard(current_dual_product_));
+          });
+  return dual_product;
+}
+
 IterationStats Solver::CreateSimpleIterationStats(
     RestartChoice restart_used) const {
   IterationStats stats;
@@ -2333,6 +2569,7 @@ void Solver::LogInnerIterationLimitHit() const {
 }
 
 InnerStepOutcome Solver::TakeMalitskyPockStep() {
+  SCOPED_PROFILING_COUNTER("pdlp.TakeMalitskyPockStep");
   InnerStepOutcome outcome = InnerStepOutcome::kSuccessful;
   const double primal_step_size = step_size_ / primal_weight_;
   NextSolutionAndDelta next_primal_solution =
@@ -2364,11 +2601,9 @@ InnerStepOutcome Solver::TakeMalitskyPockStep() {
         dual_weight * new_primal_step_size, new_last_two_step_sizes_ratio,
         next_primal_solution);
 
-    VectorXd next_dual_product = TransposedMatrixVectorProduct(
-        WorkingQp().constraint_matrix, next_dual_solution.value,
-        ShardedWorkingQp().ConstraintMatrixSharder());
-    double delta_dual_norm =
-        Norm(next_dual_solution.delta, ShardedWorkingQp().DualSharder());
+    VectorXd next_dual_product =
+        ComputeIterationDualProduct(next_dual_solution.value);
+    double delta_dual_norm = std::sqrt(next_dual_solution.delta_squared_norm);
     double delta_dual_prod_norm =
         Distance(current_dual_product_, next_dual_product,
                  ShardedWorkingQp().PrimalSharder());
@@ -2395,7 +2630,7 @@ InnerStepOutcome Solver::TakeMalitskyPockStep() {
       dual_average_.Add(current_dual_solution_,
                         /*weight=*/new_primal_step_size);
       const double movement =
-          ComputeMovement(next_primal_solution.delta, next_dual_solution.delta);
+          ComputeMovement(next_primal_solution, next_dual_solution);
       if (movement == 0.0) {
         LogNumericalTermination();
         ResetAverageToCurrent();
@@ -2417,6 +2652,7 @@ InnerStepOutcome Solver::TakeMalitskyPockStep() {
 }
 
 InnerStepOutcome Solver::TakeAdaptiveStep() {
+  SCOPED_PROFILING_COUNTER("pdlp.TakeAdaptiveStep");
   InnerStepOutcome outcome = InnerStepOutcome::kSuccessful;
   int inner_iterations = 0;
   for (bool accepted_step = false; !accepted_step; ++inner_iterations) {
@@ -2433,7 +2669,7 @@ InnerStepOutcome Solver::TakeAdaptiveStep() {
     NextSolutionAndDelta next_dual_solution = ComputeNextDualSolution(
         dual_step_size, /*extrapolation_factor=*/1.0, next_primal_solution);
     const double movement =
-        ComputeMovement(next_primal_solution.delta, next_dual_solution.delta);
+        ComputeMovement(next_primal_solution, next_dual_solution);
     if (movement == 0.0) {
       LogNumericalTermination();
       ResetAverageToCurrent();
@@ -2444,11 +2680,9 @@ InnerStepOutcome Solver::TakeAdaptiveStep() {
       outcome = InnerStepOutcome::kForceNumericalTermination;
       break;
     }
-    VectorXd next_dual_product = TransposedMatrixVectorProduct(
-        WorkingQp().constraint_matrix, next_dual_solution.value,
-        ShardedWorkingQp().ConstraintMatrixSharder());
-    const double nonlinearity =
-        ComputeNonlinearity(next_primal_solution.delta, next_dual_product);
+    double nonlinearity;
+    VectorXd next_dual_product = ComputeIterationDualProductAndNonlinearity(
+        next_dual_solution.value, next_primal_solution.delta, nonlinearity);
 
     // See equation (5) in https://arxiv.org/pdf/2106.04756.pdf.
     const double step_size_limit =
@@ -2500,6 +2734,7 @@ InnerStepOutcome Solver::TakeAdaptiveStep() {
 }
 
 InnerStepOutcome Solver::TakeConstantSizeStep() {
+  SCOPED_PROFILING_COUNTER("pdlp.TakeConstantSizeStep");
   const double primal_step_size = step_size_ / primal_weight_;
   const double dual_step_size = step_size_ * primal_weight_;
   NextSolutionAndDelta next_primal_solution =
@@ -2507,7 +2742,7 @@ InnerStepOutcome Solver::TakeConstantSizeStep() {
   NextSolutionAndDelta next_dual_solution = ComputeNextDualSolution(
       dual_step_size, /*extrapolation_factor=*/1.0, next_primal_solution);
   const double movement =
-      ComputeMovement(next_primal_solution.delta, next_dual_solution.delta);
+      ComputeMovement(next_primal_solution, next_dual_solution);
   if (movement == 0.0) {
     LogNumericalTermination();
     ResetAverageToCurrent();
@@ -2516,9 +2751,8 @@ InnerStepOutcome Solver::TakeConstantSizeStep() {
     LogNumericalTermination();
     return InnerStepOutcome::kForceNumericalTermination;
   }
-  VectorXd next_dual_product = TransposedMatrixVectorProduct(
-      WorkingQp().constraint_matrix, next_dual_solution.value,
-      ShardedWorkingQp().ConstraintMatrixSharder());
+  VectorXd next_dual_product =
+      ComputeIterationDualProduct(next_dual_solution.value);
   current_primal_solution_ = std::move(next_primal_solution.value);
   current_dual_solution_ = std::move(next_dual_solution.value);
   current_dual_product_ = std::move(next_dual_product);
@@ -2532,10 +2766,19 @@ InnerStepOutcome Solver::TakeConstantSizeStep() {
 IterationStats Solver::TotalWorkSoFar(const SolveLog& solve_log) const {
   IterationStats stats = CreateSimpleIterationStats(RESTART_CHOICE_NO_RESTART);
   IterationStats full_stats =
-      AddWorkStats(stats, WorkFromFeasibilityPolishing(solve_log));
+      AddWorkStats(stats, FeasibilityPolishingWork(solve_log));
   return full_stats;
 }
 
+IterationStats Solver::FeasibilityPolishingWork(
+    const SolveLog& solve_log) const {
+  IterationStats work = WorkFromFeasibilityPolishing(solve_log);
+  if (params_.run_feasibility_polishing_concurrently()) {
+    work.set_cumulative_time_sec(0.0);
+  }
+  return work;
+}
+
 FeasibilityPolishingDetails BuildFeasibilityPolishingDetails(
     PolishingPhaseType phase_type, int iteration_count,
     const PrimalDualHybridGradientParams& params, const SolveLog& solve_log) {
@@ -2684,6 +2927,68 @@ std::optional<SolverResult> Solver::TryFeasibilityPolishing(
   return std::nullopt;
 }
 
+void Solver::StartConcurrentPolishing(const int iteration_limit,
+                                      const SolveLog& solve_log) {
+  DCHECK(concurrent_polishing_ == nullptr);
+  auto polishing = std::make_unique<ConcurrentPolishing>();
+  polishing->preprocess_solver =
+      preprocess_solver_->CloneForConcurrentPolishing(params_,
+                                                      &polishing->logger);
+  // Within the snapshot the polishing phases run sequentially, which gives them
+  // the same work limits as when they run in the main solve.
+  PrimalDualHybridGradientParams snapshot_params = params_;
+  snapshot_params.set_run_feasibility_polishing_concurrently(false);
+  // `TryFeasibilityPolishing()` starts from the average iterate, which for a
+  // solver without averaging weight is its current iterate.
+  polishing->snapshot = std::make_unique<Solver>(
+      snapshot_params, PrimalAverage(), DualAverage(), step_size_,
+      primal_weight_, polishing->preprocess_solver.get());
+  Solver& snapshot = *polishing->snapshot;
+  snapshot.iterations_completed_ = iterations_completed_;
+  snapshot.num_rejected_steps_ = num_rejected_steps_;
+  snapshot.preprocessing_time_sec_ = preprocessing_time_sec_ + timer_.Get();
+  *polishing->solve_log.mutable_feasibility_polishing_details() =
+      solve_log.feasibility_polishing_details();
+  polishing->num_previous_details =
+      solve_log.feasibility_polishing_details_size();
+  polishing->thread = std::make_unique<ThreadPool>("PDLPPolishing", 1);
+  polishing->thread->StartWorkers();
+  polishing->thread->Schedule([p = polishing.get(), iteration_limit]() {
+    p->result = p->snapshot->TryFeasibilityPolishing(
+        iteration_limit, &p->interrupt, p->solve_log);
+    p->done.Notify();
+  });
+  concurrent_polishing_ = std::move(polishing);
+}
+
+std::optional<SolverResult> Solver::FinishConcurrentPolishing(
+    SolveLog& solve_log) {
+  std::unique_ptr<ConcurrentPolishing> polishing =
+      std::move(concurrent_polishing_);
+  polishing->done.WaitForNotification();
+  const auto& details = polishing->solve_log.feasibility_polishing_details();
+  for (int i = polishing->num_previous_details; i < details.size(); ++i) {
+    *solve_log.add_feasibility_polishing_details() = details[i];
+  }
+  if (!polishing->result.has_value()) return std::nullopt;
+  SolverResult& result = *polishing->result;
+  // The work in `result` is the one of the snapshot, replace it by the work
+  // of this solver.
+  IterationStats full_stats = TotalWorkSoFar(solve_log);
+  *full_stats.mutable_convergence_information() =
+      result.solve_log.solution_stats().convergence_information();
+  if (params_.verbosity_level() >= 2) {
+    SOLVER_LOG(&preprocess_solver_->Logger(),
+               "Concurrent feasibility polishing started at iteration ",
+               polishing->snapshot->iterations_completed_,
+               " found a solution.");
+  }
+  return ConstructSolverResult(
+      std::move(result.primal_solution), std::move(result.dual_solution),
+      full_stats, result.solve_log.termination_reason(),
+      POINT_TYPE_FEASIBILITY_POLISHING_SOLUTION, solve_log);
+}
+
 TerminationCriteria ReduceWorkLimitsByPreviousWork(
     TerminationCriteria criteria, const int iteration_limit,
     const IterationStats& previous_work) {
@@ -2702,6 +3007,8 @@ SolverResult Solver::TryPrimalPolishing(
     VectorXd starting_primal_solution, const int iteration_limit,
     const std::atomic<bool>* interrupt_solve, SolveLog& solve_log) {
   PrimalDualHybridGradientParams primal_feasibility_params = params_;
+  // The polishing phases are meant to reach tight feasibility tolerances.
+  primal_feasibility_params.set_use_float32_matrix_products(false);
   *primal_feasibility_params.mutable_termination_criteria() =
       ReduceWorkLimitsByPreviousWork(params_.termination_criteria(),
                                      iteration_limit,
@@ -2762,6 +3069,7 @@ SolverResult Solver::TryDualPolishing(VectorXd starting_dual_solution,
                                       const std::atomic<bool>* interrupt_solve,
                                       SolveLog& solve_log) {
   PrimalDualHybridGradientParams dual_feasibility_params = params_;
+  dual_feasibility_params.set_use_float32_matrix_products(false);
   *dual_feasibility_params.mutable_termination_criteria() =
       ReduceWorkLimitsByPreviousWork(params_.termination_criteria(),
                                      iteration_limit,
@@ -2845,7 +3153,7 @@ SolverResult Solver::Solve(const IterationType iteration_type,
   num_rejected_steps_ = 0;
 
   IterationStats work_from_feasibility_polishing =
-      WorkFromFeasibilityPolishing(solve_log);
+      FeasibilityPolishingWork(solve_log);
   for (iterations_completed_ = 0;; ++iterations_completed_) {
     // This code performs the logic of the major iterations and termination
     // checks. It may modify the current solution and primal weight (e.g., when
@@ -2855,9 +3163,22 @@ SolverResult Solver::Solve(const IterationType iteration_type,
             iteration_type, force_numerical_termination, interrupt_solve,
             work_from_feasibility_polishing, solve_log);
     if (maybe_result.has_value()) {
+      // This interrupts a concurrent feasibility polishing attempt, if any.
+      concurrent_polishing_.reset();
       return maybe_result.value();
     }
 
+    if (concurrent_polishing_ != nullptr &&
+        concurrent_polishing_->done.HasBeenNotified()) {
+      std::optional<SolverResult> feasibility_result =
+          FinishConcurrentPolishing(solve_log);
+      if (feasibility_result.has_value()) {
+        return *std::move(feasibility_result);
+      }
+      // Update work to include new feasibility phases.
+      work_from_feasibility_polishing = FeasibilityPolishingWork(solve_log);
+    }
+
     if (params_.use_feasibility_polishing() &&
         iteration_type == IterationType::kNormal &&
         iterations_completed_ >= next_feasibility_polishing_iteration) {
@@ -2869,16 +3190,23 @@ SolverResult Solver::Solve(const IterationType iteration_type,
       // feasibility polishing phase, so the sum of iteration limits is at most
       // twice the last value.
       const int kFeasibilityIterationFraction = 8;
-      const std::optional<SolverResult> feasibility_result =
-          TryFeasibilityPolishing(
-              iterations_completed_ / kFeasibilityIterationFraction,
-              interrupt_solve, solve_log);
-      if (feasibility_result.has_value()) {
-        return *feasibility_result;
+      const int polishing_iteration_limit =
+          iterations_completed_ / kFeasibilityIterationFraction;
+      if (!params_.run_feasibility_polishing_concurrently()) {
+        const std::optional<SolverResult> feasibility_result =
+            TryFeasibilityPolishing(polishing_iteration_limit, interrupt_solve,
+                                    solve_log);
+        if (feasibility_result.has_value()) {
+          return *feasibility_result;
+        }
+        next_feasibility_polishing_iteration *= 2;
+        // Update work to include new feasibility phases.
+        work_from_feasibility_polishing = FeasibilityPolishingWork(solve_log);
+      } else if (concurrent_polishing_ == nullptr) {
+        // Otherwise the next attempt starts once the current one is done.
+        StartConcurrentPolishing(polishing_iteration_limit, solve_log);
+        next_feasibility_polishing_iteration *= 2;
       }
-      next_feasibility_polishing_iteration *= 2;
-      // Update work to include new feasibility phases.
-      work_from_feasibility_polishing = WorkFromFeasibilityPolishing(solve_log);
     }
 
     // TODO(user): If we use a step rule that could reject many steps in a
@@ -2918,9 +3246,12 @@ SolverResult PrimalDualHybridGradient(
                                   std::move(iteration_stats_callback));
 }
 
-SolverResult PrimalDualHybridGradient(
+namespace {
+
+SolverResult ValidateAndSolve(
     QuadraticProgram qp, const PrimalDualHybridGradientParams& params,
     std::optional<PrimalAndDualSolution> initial_solution,
+    std::optional<PdlpWarmStartState> warm_start_state,
     const std::atomic<bool>* interrupt_solve,
     std::function<void(const std::string&)> message_callback,
     IterationStatsCallback iteration_stats_callback) {
@@ -2960,9 +3291,36 @@ SolverResult PrimalDualHybridGradient(
         logger);
   }
   PreprocessSolver solver(std::move(qp), params, &logger);
-  return solver.PreprocessAndSolve(params, std::move(initial_solution),
-                                   interrupt_solve,
-                                   std::move(iteration_stats_callback));
+  return solver.PreprocessAndSolve(
+      params, std::move(initial_solution), std::move(warm_start_state),
+      interrupt_solve, std::move(iteration_stats_callback));
+}
+
+}  // namespace
+
+SolverResult PrimalDualHybridGradient(
+    QuadraticProgram qp, const PrimalDualHybridGradientParams& params,
+    std::optional<PrimalAndDualSolution> initial_solution,
+    const std::atomic<bool>* interrupt_solve,
+    std::function<void(const std::string&)> message_callback,
+    IterationStatsCallback iteration_stats_callback) {
+  return ValidateAndSolve(std::move(qp), params, std::move(initial_solution),
+                          /*warm_start_state=*/std::nullopt, interrupt_solve,
+                          std::move(message_callback),
+                          std::move(iteration_stats_callback));
+}
+
+SolverResult PrimalDualHybridGradient(
+    QuadraticProgram qp, const PrimalDualHybridGradientParams& params,
+    PrimalAndDualSolution initial_solution,
+    PdlpWarmStartState warm_start_state,
+    const std::atomic<bool>* interrupt_solve,
+    std::function<void(const std::string&)> message_callback,
+    IterationStatsCallback iteration_stats_callback) {
+  return ValidateAndSolve(std::move(qp), params, std::move(initial_solution),
+                          std::move(warm_start_state), interrupt_solve,
+                          std::move(message_callback),
+                          std::move(iteration_stats_callback));
 }
 
 namespace internal {
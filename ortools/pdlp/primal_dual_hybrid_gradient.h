@@ -33,6 +33,19 @@ struct PrimalAndDualSolution {
   Eigen::VectorXd dual_solution;
 };
 
+// Solver state, besides the iterate, that can be reused to warm-start the solve
+// of a closely related problem, for example the next problem of a
+// rolling-horizon sequence. Everything refers to the rescaled problem.
+struct PdlpWarmStartState {
+  // The diagonal rescaling that was applied to the columns and rows of the
+  // constraint matrix.
+  Eigen::VectorXd col_scaling_vec;
+  Eigen::VectorXd row_scaling_vec;
+  // The step size and primal weight when the main iterations stopped.
+  double step_size = 0.0;
+  double primal_weight = 0.0;
+};
+
 // The following table defines the interpretation of the result vectors
 // depending on the value of `solve_log.termination_reason`: (the
 // TERMINATION_REASON_ prefix is omitted for brevity):
@@ -68,6 +81,10 @@ struct SolverResult {
   // for details.
   Eigen::VectorXd reduced_costs;
   SolveLog solve_log;
+  // Set when the main PDHG iterations ran and presolve was not used. It can be
+  // passed to the next solve, see the `PrimalDualHybridGradient()` overload
+  // taking a `PdlpWarmStartState`.
+  std::optional<PdlpWarmStartState> warm_start_state;
 };
 
 // Identifies the iteration type in a callback. The callback is called both for
@@ -168,6 +185,24 @@ SolverResult PrimalDualHybridGradient(
     std::function<void(const IterationCallbackInfo&)> iteration_stats_callback =
         nullptr);
 
+// Like above, but also warm-starts from `warm_start_state`, usually the
+// `SolverResult::warm_start_state` of the solve of a structurally close
+// problem (same sizes, and constraint matrix, objective and bounds of similar
+// magnitudes). When the scaling vectors have the sizes of the problem, they are
+// applied instead of recomputing the rescaling, so `l_inf_ruiz_iterations` and
+// `l2_norm_rescaling` are ignored. The primal weight is used as the initial
+// primal weight, and unless `linesearch_rule` is `CONSTANT_STEP_SIZE_RULE` the
+// step size is used as the initial step size. `warm_start_state` is ignored if
+// presolve is enabled or if it doesn't match the problem.
+SolverResult PrimalDualHybridGradient(
+    QuadraticProgram qp, const PrimalDualHybridGradientParams& params,
+    PrimalAndDualSolution initial_solution,
+    PdlpWarmStartState warm_start_state,
+    const std::atomic<bool>* interrupt_solve = nullptr,
+    std::function<void(const std::string&)> message_callback = nullptr,
+    std::function<void(const IterationCallbackInfo&)> iteration_stats_callback =
+        nullptr);
+
 namespace internal {
 
 // Computes variable and constraint statuses. This determines if primal
@@ -787,6 +787,74 @@ TEST(PrimalDualHybridGradientTest, AdaptiveDistanceBasedRestartsWorkOnTestLp) {
   EXPECT_THAT(convergence_info->dual_objective(), DoubleNear(-34.0, 1.0e-4));
 }
 
+TEST(PrimalDualHybridGradientTest, Float32MatrixProductsWorkOnTestLp) {
+  PrimalDualHybridGradientParams params;
+  params.set_use_float32_matrix_products(true);
+  params.mutable_termination_criteria()->set_iteration_limit(1000);
+  params.mutable_termination_criteria()
+      ->mutable_simple_optimality_criteria()
+      ->set_eps_optimal_absolute(1.0e-4);
+  params.mutable_termination_criteria()
+      ->mutable_simple_optimality_criteria()
+      ->set_eps_optimal_relative(1.0e-4);
+  SolverResult output = PrimalDualHybridGradient(TestLp(), params);
+
+  EXPECT_EQ(output.solve_log.termination_reason(), TERMINATION_REASON_OPTIMAL);
+  EXPECT_THAT(output.primal_solution,
+              EigenArrayNear<double>({-1, 8, 1, 2.5}, 1.0e-2));
+  EXPECT_THAT(output.dual_solution,
+              EigenArrayNear<double>({-2, 0, 2.375, 2.0 / 3}, 1.0e-2));
+}
+
+TEST(PrimalDualHybridGradientTest, WarmStartStateIsReusedOnTestLp) {
+  PrimalDualHybridGradientParams params;
+  params.mutable_termination_criteria()->set_iteration_limit(1000);
+  params.mutable_termination_criteria()
+      ->mutable_simple_optimality_criteria()
+      ->set_eps_optimal_absolute(1.0e-6);
+  params.mutable_termination_criteria()
+      ->mutable_simple_optimality_criteria()
+      ->set_eps_optimal_relative(1.0e-6);
+  SolverResult first_output = PrimalDualHybridGradient(TestLp(), params);
+  ASSERT_EQ(first_output.solve_log.termination_reason(),
+            TERMINATION_REASON_OPTIMAL);
+  ASSERT_TRUE(first_output.warm_start_state.has_value());
+  EXPECT_GT(first_output.warm_start_state->step_size, 0.0);
+  EXPECT_GT(first_output.warm_start_state->primal_weight, 0.0);
+
+  SolverResult output = PrimalDualHybridGradient(
+      TestLp(), params,
+      PrimalAndDualSolution{
+          .primal_solution = first_output.primal_solution,
+          .dual_solution = first_output.dual_solution},
+      *first_output.warm_start_state);
+
+  EXPECT_EQ(output.solve_log.termination_reason(), TERMINATION_REASON_OPTIMAL);
+  EXPECT_LE(output.solve_log.iteration_count(),
+            first_output.solve_log.iteration_count());
+  EXPECT_THAT(output.primal_solution,
+              EigenArrayNear<double>({-1, 8, 1, 2.5}, 1.0e-4));
+  EXPECT_THAT(output.dual_solution,
+              EigenArrayNear<double>({-2, 0, 2.375, 2.0 / 3}, 1.0e-4));
+}
+
+TEST(PrimalDualHybridGradientTest, MismatchedWarmStartStateIsIgnored) {
+  PdlpWarmStartState warm_start_state{
+      .col_scaling_vec = Eigen::VectorXd::Ones(1),
+      .row_scaling_vec = Eigen::VectorXd::Ones(1),
+      .step_size = 1.0,
+      .primal_weight = 1.0};
+  PrimalDualHybridGradientParams params;
+  params.mutable_termination_criteria()->set_iteration_limit(1000);
+  SolverResult output = PrimalDualHybridGradient(
+      TestLp(), params,
+      PrimalAndDualSolution{.primal_solution = Eigen::VectorXd::Zero(4),
+                            .dual_solution = Eigen::VectorXd::Zero(4)},
+      std::move(warm_start_state));
+
+  EXPECT_EQ(output.solve_log.termination_reason(), TERMINATION_REASON_OPTIMAL);
+}
+
 TEST(PrimalDualHybridGradientTest, AdaptiveDistanceBasedRestartsWorkOnTestQp) {
   PrimalDualHybridGradientParams params;
   params.set_major_iteration_frequency(16);
@@ -1768,6 +1836,24 @@ TEST_F(FeasibilityPolishingDualTest, FeasibilityPolishingSolvesFaster) {
   EXPECT_EQ(output.solve_log.termination_reason(), TERMINATION_REASON_OPTIMAL);
 }
 
+TEST_F(FeasibilityPolishingPrimalTest, ConcurrentFeasibilityPolishingSolves) {
+  params_.set_run_feasibility_polishing_concurrently(true);
+  SolverResult output = PrimalDualHybridGradient(lp_, params_);
+  EXPECT_EQ(output.solve_log.termination_reason(), TERMINATION_REASON_OPTIMAL);
+  EXPECT_EQ(output.solve_log.solution_type(),
+            POINT_TYPE_FEASIBILITY_POLISHING_SOLUTION);
+  EXPECT_GE(output.solve_log.feasibility_polishing_details_size(), 2);
+  VerifyObjectiveValues(output, 1.0, 1.0e-2);
+}
+
+TEST_F(FeasibilityPolishingDualTest, ConcurrentFeasibilityPolishingSolves) {
+  params_.set_run_feasibility_polishing_concurrently(true);
+  SolverResult output = PrimalDualHybridGradient(lp_, params_);
+  EXPECT_EQ(output.solve_log.termination_reason(), TERMINATION_REASON_OPTIMAL);
+  EXPECT_EQ(output.solve_log.solution_type(),
+            POINT_TYPE_FEASIBILITY_POLISHING_SOLUTION);
+}
+
 TEST_F(FeasibilityPolishingPrimalTest, FeasibilityPolishingFindsValidSolution) {
   SolverResult output = PrimalDualHybridGradient(lp_, params_);
   EXPECT_EQ(output.solve_log.termination_reason(), TERMINATION_REASON_OPTIMAL);
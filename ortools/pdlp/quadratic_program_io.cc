@@ -13,11 +13,13 @@
 
 #include "ortools/pdlp/quadratic_program_io.h"
 
+#include <algorithm>
 #include <cmath>
 #include <cstdint>
 #include <limits>
 #include <optional>
 #include <string>
+#include <tuple>
 #include <utility>
 #include <vector>
 
@@ -42,6 +44,7 @@
 #include "ortools/linear_solver/model_exporter.h"
 #include "ortools/lp_data/mps_reader_template.h"
 #include "ortools/pdlp/quadratic_program.h"
+#include "ortools/pdlp/sharded_quadratic_program.h"
 #include "ortools/util/file_util.h"
 
 namespace operations_research::pdlp {
@@ -102,201 +105,178 @@ absl::Status WriteQuadraticProgramToMPModelProto(
 
 namespace {
 
-// Class implementing the
-// `ortools/lp_data/mps_reader_template.h` interface that only
-// stores the names of rows and columns, and the number of non-zeros found.
-class MpsReaderDimensionAndNames {
- public:
-  using IndexType = int64_t;
-  void SetUp() {
-    read_or_parse_failed_ = false;
-    col_name_to_index_.clear();
-    row_name_to_index_.clear();
-    added_non_zeros_ = 0;
-  }
-  void CleanUp() {}
-  double ConstraintLowerBound(IndexType index) { return 0; }
-  double ConstraintUpperBound(IndexType index) { return 0; }
-  IndexType FindOrCreateConstraint(absl::string_view row_name) {
-    const auto [it, success_unused] = row_name_to_index_.try_emplace(
-        row_name, static_cast<IndexType>(row_name_to_index_.size()));
-    return it->second;
-  }
-  IndexType FindOrCreateVariable(absl::string_view col_name) {
-    const auto [it, success_unused] = col_name_to_index_.try_emplace(
-        col_name, static_cast<IndexType>(col_name_to_index_.size()));
-    return it->second;
-  }
-  void SetConstraintBounds(IndexType row_index, double lower_bound,
-                           double upper_bound) {}
-  void SetConstraintCoefficient(IndexType row_index, IndexType col_index,
-                                double coefficient) {
-    ++added_non_zeros_;
-  }
-  void SetIsLazy(IndexType row_index) {}
-  void SetName(absl::string_view problem_name) {}
-  void SetObjectiveCoefficient(IndexType index, double coefficient) {}
-  void SetObjectiveDirection(bool maximize) {}
-  void SetObjectiveOffset(double offset) {}
-  void SetVariableTypeToInteger(IndexType index) {}
-  void SetVariableTypeToSemiContinuous(IndexType index) {
-    LOG_FIRST_N(WARNING, 1)
-        << "Semi-continuous variables not supported, failed to parse file";
-    read_or_parse_failed_ = true;
-  }
-  void SetVariableBounds(IndexType index, double lower_bound,
-                         double upper_bound) {}
-  double VariableLowerBound(IndexType index) { return 0; }
-  double VariableUpperBound(IndexType index) { return 0; }
-  absl::Status CreateIndicatorConstraint(absl::string_view row_name,
-                                         IndexType col_index, bool var_value) {
-    absl::string_view message =
-        "Indicator constraints not supported, failed to parse file";
-    LOG_FIRST_N(WARNING, 1) << message;
-    return absl::InvalidArgumentError(message);
-  }
-
-  // Lookup constant functions. They assume that `row_name` or `col_name`,
-  // respectively, have been previously added to the internal set of rows or
-  // variables. The functions QFAIL if this is not true.
-  IndexType FindVariableOrDie(absl::string_view col_name) const {
-    const auto it = col_name_to_index_.find(col_name);
-    if (it == col_name_to_index_.end()) {
-      LOG(QFATAL) << absl::StrFormat(
-          "column `%s` not previously found in file, internal error?",
-          col_name);
-    }
-    return it->second;
-  }
-  IndexType FindConstraintOrDie(absl::string_view row_name) const {
-    const auto it = row_name_to_index_.find(row_name);
-    if (it == row_name_to_index_.end()) {
-      LOG(QFATAL) << absl::StrFormat(
-          "row `%s` not previously found in file, internal error?", row_name);
-    }
-    return it->second;
-  }
-
-  // Number of non-zeros added so-far.
-  int64_t AddedNonZeros() const { return added_non_zeros_; }
-
-  // Number of variables added so-far.
-  int64_t NumVariables() const { return col_name_to_index_.size(); }
-
-  // Number of constraints added so-far.
-  int64_t NumConstraints() const { return row_name_to_index_.size(); }
-
-  // Return `true` if an unsupported MPS section was found.
-  bool FailedToParse() const { return read_or_parse_failed_; }
-
-  // Return a const-hash map of col names to indices.
-  const absl::flat_hash_map<std::string, IndexType>& ColNameIndexMap() const {
-    return col_name_to_index_;
-  }
-
-  // Return a const-hash map of row names to indices.
-  const absl::flat_hash_map<std::string, IndexType>& RowNameIndexMap() const {
-    return row_name_to_index_;
-  }
-
- private:
-  bool read_or_parse_failed_ = false;
-  absl::flat_hash_map<std::string, IndexType> col_name_to_index_;
-  absl::flat_hash_map<std::string, IndexType> row_name_to_index_;
-  int64_t added_non_zeros_ = 0;
-};
-
-// Class implementing the
-// `ortools/lp_data/mps_reader_template.h` interface.
-// It is intended to be used in conjunction with `MpsReaderDimensionAndNames`
-// as follows:
+// Class implementing the `ortools/lp_data/mps_reader_template.h` interface
+// that assembles a `QuadraticProgram` in a single pass over the file, without
+// going through an intermediate `MPModelProto`.
+//
+// Rows and columns are numbered in order of first appearance. Constraint
+// matrix entries are appended to fixed-size chunks of triplets, so that
+// growing the storage never moves the entries already read, and repeated
+// entries of the column being read are combined (summed) as they are found.
+// When each column is given as a single contiguous block, as is almost always
+// the case, the matrix is then filled in directly in compressed column form
+// and only the row order within each column needs to be fixed; otherwise the
+// triplets go through `SetEigenMatrixFromTriplets()`.
+//
+// Usage:
 //
-// // Retrieve dimension and name information from file.
-// MpsReaderDimensionAndNames dimension_and_name;
-// MPSReaderTemplate<MpsReaderDimensionAndNames> dimension_parser;
-// dimension_parser.ParseFile(file_name, &dimension_and_name);
-// // Store QP problem coefficients.
-// MpsReaderQpDataWrapper qp_wrapper(&dimension_and_name, include_names);
-// MPSReaderTemplate<MpsReaderQpDataWrapper> qp_parser;
-// qp_parser.ParseFile(file_name, &qp_wrapper);
-// // Retrieve fully assembled QP.
+// MpsReaderStreamingQpDataWrapper qp_wrapper(include_names);
+// MPSReaderTemplate<MpsReaderStreamingQpDataWrapper> parser;
+// RETURN_IF_ERROR(parser.ParseFile(file_name, &qp_wrapper).status());
+// RETURN_IF_ERROR(qp_wrapper.ParseStatus());
 // QuadraticProgram result = qp_wrapper.GetAndClearQuadraticProgram();
-class MpsReaderQpDataWrapper {
+class MpsReaderStreamingQpDataWrapper {
  public:
   using IndexType = int64_t;
-  // Constructor, `*dimension_and_names` must outlive the class, and be
-  // constant during the object's lifetime. If `include_names`=true, the
-  // resulting QuadraticProgram from `GetAndClearQuadraticProgram()` will
-  // include name information from the MPS file.
-  // NOTE: The code assumes that the file to be read is the same file already
-  // read using the `*dimension_and_names` argument.
-  MpsReaderQpDataWrapper(const MpsReaderDimensionAndNames* dimension_and_names,
-                         bool include_names)
-      : include_names_{include_names},
-        dimension_and_names_{*dimension_and_names} {}
+
+  // If `include_names`=true, the resulting QuadraticProgram from
+  // `GetAndClearQuadraticProgram()` will include name information from the
+  // MPS file.
+  explicit MpsReaderStreamingQpDataWrapper(bool include_names)
+      : include_names_{include_names} {}
 
   // Implements the `MPSReaderTemplate` interface.
   void SetUp() {
-    const int64_t num_variables = dimension_and_names_.NumVariables();
-    const int64_t num_constraints = dimension_and_names_.NumConstraints();
-    triplets_.reserve(dimension_and_names_.AddedNonZeros());
-    quadratic_program_ = QuadraticProgram(/*num_variables=*/num_variables,
-                                          /*num_constraints=*/num_constraints);
-    // Default variables in MPS files have a zero lower bound, an infinity
-    // upper bound, and a zero objective; while default constraints are
-    // 'equal to zero' constraints.
-    quadratic_program_.constraint_lower_bounds =
-        Eigen::VectorXd::Zero(num_constraints);
-    quadratic_program_.constraint_upper_bounds =
-        Eigen::VectorXd::Zero(num_constraints);
-    quadratic_program_.variable_lower_bounds =
-        Eigen::VectorXd::Zero(num_variables);
+    status_ = absl::OkStatus();
+    col_name_to_index_.clear();
+    row_name_to_index_.clear();
+    problem_name_.clear();
+    maximize_ = false;
+    objective_offset_ = 0.0;
+    objective_vector_.clear();
+    variable_lower_bounds_.clear();
+    variable_upper_bounds_.clear();
+    constraint_lower_bounds_.clear();
+    constraint_upper_bounds_.clear();
+    chunks_.clear();
+    num_entries_ = 0;
+    column_sizes_.clear();
+    row_last_position_.clear();
+    current_column_ = -1;
+    current_column_start_ = 0;
+    columns_in_order_ = true;
+    quadratic_program_ = QuadraticProgram();
   }
   void CleanUp() {
-    SetEigenMatrixFromTriplets(std::move(triplets_),
-                               quadratic_program_.constraint_matrix);
+    const int64_t num_variables = objective_vector_.size();
+    const int64_t num_constraints = constraint_lower_bounds_.size();
+    quadratic_program_ = QuadraticProgram(/*num_variables=*/num_variables,
+                                          /*num_constraints=*/num_constraints);
     // Deal with maximization problems.
-    if (quadratic_program_.objective_scaling_factor == -1) {
-      quadratic_program_.objective_offset *= -1;
-      for (double& objective_coefficient :
-           quadratic_program_.objective_vector) {
-        objective_coefficient *= -1;
+    const double objective_sign = maximize_ ? -1.0 : 1.0;
+    quadratic_program_.objective_scaling_factor = objective_sign;
+    quadratic_program_.objective_offset = objective_sign * objective_offset_;
+    for (int64_t col = 0; col < num_variables; ++col) {
+      quadratic_program_.objective_vector[col] =
+          objective_sign * objective_vector_[col];
+      quadratic_program_.variable_lower_bounds[col] =
+          variable_lower_bounds_[col];
+      quadratic_program_.variable_upper_bounds[col] =
+          variable_upper_bounds_[col];
+    }
+    for (int64_t row = 0; row < num_constraints; ++row) {
+      quadratic_program_.constraint_lower_bounds[row] =
+          constraint_lower_bounds_[row];
+      quadratic_program_.constraint_upper_bounds[row] =
+          constraint_upper_bounds_[row];
+    }
+    std::vector<double>().swap(objective_vector_);
+    std::vector<double>().swap(variable_lower_bounds_);
+    std::vector<double>().swap(variable_upper_bounds_);
+    std::vector<double>().swap(constraint_lower_bounds_);
+    std::vector<double>().swap(constraint_upper_bounds_);
+    std::vector<int64_t>().swap(row_last_position_);
+    if (columns_in_order_) {
+      FillCompressedConstraintMatrix();
+    } else {
+      std::vector<Eigen::Triplet<double, int64_t>> triplets;
+      triplets.reserve(num_entries_);
+      for (std::vector<Eigen::Triplet<double, int64_t>>& chunk : chunks_) {
+        triplets.insert(triplets.end(), chunk.begin(), chunk.end());
+        std::vector<Eigen::Triplet<double, int64_t>>().swap(chunk);
       }
+      SetEigenMatrixFromTriplets(std::move(triplets),
+                                 quadratic_program_.constraint_matrix);
     }
+    chunks_.clear();
+    std::vector<int64_t>().swap(column_sizes_);
     if (include_names_) {
+      quadratic_program_.problem_name = problem_name_;
       quadratic_program_.variable_names =
-          std::vector<std::string>(dimension_and_names_.NumVariables());
+          std::vector<std::string>(num_variables);
       quadratic_program_.constraint_names =
-          std::vector<std::string>(dimension_and_names_.NumConstraints());
-      for (const auto& [name, index] : dimension_and_names_.ColNameIndexMap()) {
+          std::vector<std::string>(num_constraints);
+      for (const auto& [name, index] : col_name_to_index_) {
         (*quadratic_program_.variable_names)[index] = name;
       }
-      for (const auto& [name, index] : dimension_and_names_.RowNameIndexMap()) {
+      for (const auto& [name, index] : row_name_to_index_) {
         (*quadratic_program_.constraint_names)[index] = name;
       }
     }
   }
   double ConstraintLowerBound(IndexType index) {
-    return quadratic_program_.constraint_lower_bounds[index];
+    return constraint_lower_bounds_[index];
   }
   double ConstraintUpperBound(IndexType index) {
-    return quadratic_program_.constraint_upper_bounds[index];
+    return constraint_upper_bounds_[index];
   }
   IndexType FindOrCreateConstraint(absl::string_view row_name) {
-    return dimension_and_names_.FindConstraintOrDie(row_name);
+    const auto [it, inserted] = row_name_to_index_.try_emplace(
+        row_name, static_cast<IndexType>(row_name_to_index_.size()));
+    if (inserted) {
+      // Default constraints in MPS files are 'equal to zero' constraints.
+      constraint_lower_bounds_.push_back(0.0);
+      constraint_upper_bounds_.push_back(0.0);
+      row_last_position_.push_back(-1);
+    }
+    return it->second;
   }
   IndexType FindOrCreateVariable(absl::string_view col_name) {
-    return dimension_and_names_.FindVariableOrDie(col_name);
+    const auto [it, inserted] = col_name_to_index_.try_emplace(
+        col_name, static_cast<IndexType>(col_name_to_index_.size()));
+    if (inserted) {
+      // Default variables in MPS files have a zero lower bound, an infinity
+      // upper bound, and a zero objective.
+      objective_vector_.push_back(0.0);
+      variable_lower_bounds_.push_back(0.0);
+      variable_upper_bounds_.push_back(std::numeric_limits<double>::infinity());
+      column_sizes_.push_back(0);
+    }
+    return it->second;
   }
   void SetConstraintBounds(IndexType index, double lower_bound,
                            double upper_bound) {
-    quadratic_program_.constraint_lower_bounds[index] = lower_bound;
-    quadratic_program_.constraint_upper_bounds[index] = upper_bound;
+    constraint_lower_bounds_[index] = lower_bound;
+    constraint_upper_bounds_[index] = upper_bound;
   }
   void SetConstraintCoefficient(IndexType row_index, IndexType col_index,
                                 double coefficient) {
-    DCHECK_LT(triplets_.size(), triplets_.capacity());
-    triplets_.emplace_back(row_index, col_index, coefficient);
+    if (col_index != current_column_) {
+      // Until the first column given in several blocks, the columns appear in
+      // increasing index order, so going back to a smaller index is the only
+      // way to break the order.
+      if (col_index < current_column_) columns_in_order_ = false;
+      current_column_ = col_index;
+      current_column_start_ = num_entries_;
+    }
+    // Entries of previous blocks have positions before
+    // `current_column_start_`, so this only combines entries of the current
+    // block.
+    int64_t& last_position = row_last_position_[row_index];
+    if (last_position >= current_column_start_) {
+      Eigen::Triplet<double, int64_t>& entry =
+          chunks_[last_position / kChunkSize][last_position % kChunkSize];
+      entry = {row_index, col_index, entry.value() + coefficient};
+      return;
+    }
+    if (num_entries_ % kChunkSize == 0) {
+      chunks_.emplace_back();
+      chunks_.back().reserve(kChunkSize);
+    }
+    chunks_.back().emplace_back(row_index, col_index, coefficient);
+    last_position = num_entries_;
+    ++num_entries_;
+    ++column_sizes_[col_index];
   }
   void SetIsLazy(IndexType row_index) {
     LOG_FIRST_N(WARNING, 1) << "Lazy constraint information lost, treated as "
@@ -304,47 +284,46 @@ class MpsReaderQpDataWrapper {
   }
   void SetName(absl::string_view problem_name) {
     if (include_names_) {
-      quadratic_program_.problem_name = std::string(problem_name);
+      problem_name_ = std::string(problem_name);
     }
   }
   void SetObjectiveCoefficient(IndexType index, double coefficient) {
-    quadratic_program_.objective_vector[index] = coefficient;
-  }
-  void SetObjectiveDirection(bool maximize) {
-    quadratic_program_.objective_scaling_factor = (maximize ? -1 : 1);
-  }
-  void SetObjectiveOffset(double offset) {
-    quadratic_program_.objective_offset = offset;
+    objective_vector_[index] = coefficient;
   }
+  void SetObjectiveDirection(bool maximize) { maximize_ = maximize; }
+  void SetObjectiveOffset(double offset) { objective_offset_ = offset; }
   void SetVariableTypeToInteger(IndexType index) {
     LOG_FIRST_N(WARNING, 1) << "Dropping integrality requirements, all "
                                "variables treated as continuous";
   }
   void SetVariableTypeToSemiContinuous(IndexType index) {
-    // This line should never execute, as the code must fail on
-    // `MpsReaderDimensionAndNames::SetVariableTypeToSemiContinuous` before.
-    LOG(QFATAL) << "Semi-continuous variables are unsupported, and should have "
-                   "been detected before (in MpsReaderDimensionAndNames)";
+    LOG_FIRST_N(WARNING, 1)
+        << "Semi-continuous variables not supported, failed to parse file";
+    status_ = absl::InvalidArgumentError(
+        "Semi-continuous variables are not supported");
   }
   void SetVariableBounds(IndexType index, double lower_bound,
                          double upper_bound) {
-    quadratic_program_.variable_lower_bounds[index] = lower_bound;
-    quadratic_program_.variable_upper_bounds[index] = upper_bound;
+    variable_lower_bounds_[index] = lower_bound;
+    variable_upper_bounds_[index] = upper_bound;
   }
   double VariableLowerBound(IndexType index) {
-    return quadratic_program_.variable_lower_bounds[index];
+    return variable_lower_bounds_[index];
   }
   double VariableUpperBound(IndexType index) {
-    return quadratic_program_.variable_upper_bounds[index];
+    return variable_upper_bounds_[index];
   }
   absl::Status CreateIndicatorConstraint(absl::string_view row_name,
                                          IndexType col_index, bool var_value) {
-    // This function should never be called, as the code must fail on
-    // `MpsReaderDimensionAndNames::CreateIndicatorConstraint` before.
-    LOG(QFATAL) << "Indicator constraints are unsupported, and should have "
-                   "been detected before (in MpsReaderDimensionAndNames)";
+    absl::string_view message =
+        "Indicator constraints not supported, failed to parse file";
+    LOG_FIRST_N(WARNING, 1) << message;
+    return absl::InvalidArgumentError(message);
   }
 
+  // Returns an error if an unsupported MPS feature was found while parsing.
+  const absl::Status& ParseStatus() const { return status_; }
+
   // Returns a `QuadraticProgram` holding all information read by the
   // `mps_reader_template.h` interface. It leaves the internal quadratic
   // program in an indeterminate state.
@@ -353,46 +332,101 @@ class MpsReaderQpDataWrapper {
   }
 
  private:
+  // Number of triplets per storage chunk.
+  static constexpr int64_t kChunkSize = 1 << 16;
+
+  // Fills `quadratic_program_.constraint_matrix` (already resized) from
+  // `chunks_`, which must hold the entries column after column, and releases
+  // the chunks as they are consumed.
+  void FillCompressedConstraintMatrix() {
+    Eigen::SparseMatrix<double, Eigen::ColMajor, int64_t>& matrix =
+        quadratic_program_.constraint_matrix;
+    matrix.resizeNonZeros(num_entries_);
+    int64_t* const outer_index = matrix.outerIndexPtr();
+    int64_t* const inner_index = matrix.innerIndexPtr();
+    double* const values = matrix.valuePtr();
+    outer_index[0] = 0;
+    for (int64_t col = 0; col < matrix.cols(); ++col) {
+      outer_index[col + 1] = outer_index[col] + column_sizes_[col];
+    }
+    int64_t position = 0;
+    for (std::vector<Eigen::Triplet<double, int64_t>>& chunk : chunks_) {
+      for (const Eigen::Triplet<double, int64_t>& triplet : chunk) {
+        inner_index[position] = triplet.row();
+        values[position] = triplet.value();
+        ++position;
+      }
+      std::vector<Eigen::Triplet<double, int64_t>>().swap(chunk);
+    }
+    DCHECK_EQ(position, num_entries_);
+    // Eigen expects the row indices of each column to be sorted.
+    std::vector<std::pair<int64_t, double>> column_entries;
+    for (int64_t col = 0; col < matrix.cols(); ++col) {
+      const int64_t start = outer_index[col];
+      const int64_t end = outer_index[col + 1];
+      if (std::is_sorted(inner_index + start, inner_index + end)) continue;
+      column_entries.clear();
+      for (int64_t i = start; i < end; ++i) {
+        column_entries.emplace_back(inner_index[i], values[i]);
+      }
+      std::sort(column_entries.begin(), column_entries.end());
+      for (int64_t i = start; i < end; ++i) {
+        std::tie(inner_index[i], values[i]) = column_entries[i - start];
+      }
+    }
+  }
+
   bool include_names_;
+  absl::Status status_;
+  absl::flat_hash_map<std::string, IndexType> col_name_to_index_;
+  absl::flat_hash_map<std::string, IndexType> row_name_to_index_;
+  std::string problem_name_;
+  bool maximize_ = false;
+  double objective_offset_ = 0.0;
+  std::vector<double> objective_vector_;
+  std::vector<double> variable_lower_bounds_;
+  std::vector<double> variable_upper_bounds_;
+  std::vector<double> constraint_lower_bounds_;
+  std::vector<double> constraint_upper_bounds_;
+
+  // Constraint matrix entries, in order of appearance, in chunks of
+  // `kChunkSize` triplets (only the last one may be partially filled).
+  std::vector<std::vector<Eigen::Triplet<double, int64_t>>> chunks_;
+  int64_t num_entries_ = 0;
+  // Number of entries stored for each column.
+  std::vector<int64_t> column_sizes_;
+  // For each row, the position in the chunks of its last stored entry, or -1.
+  std::vector<int64_t> row_last_position_;
+  // The column of the last stored entry and the position of the first entry
+  // of its current block.
+  int64_t current_column_ = -1;
+  int64_t current_column_start_ = 0;
+  // True while no column has been given in more than one block.
+  bool columns_in_order_ = true;
   QuadraticProgram quadratic_program_;
-  const MpsReaderDimensionAndNames& dimension_and_names_;
-  std::vector<Eigen::Triplet<double, int64_t>> triplets_;
 };
 
 }  // namespace
 
 absl::StatusOr<QuadraticProgram> ReadMpsLinearProgram(
     const std::string& lp_file, bool include_names) {
-  MpsReaderDimensionAndNames dimension_and_names;
-  // Collect MPS format, sizes and names.
-  MPSReaderTemplate<MpsReaderDimensionAndNames> pass_one_reader;
-  const absl::StatusOr<MPSReaderFormat> pass_one_format =
-      pass_one_reader.ParseFile(lp_file, &dimension_and_names,
-                                MPSReaderFormat::kAutoDetect);
-  if (!pass_one_format.ok()) {
-    return util::StatusBuilder(pass_one_format.status()) << absl::StrFormat(
+  MpsReaderStreamingQpDataWrapper qp_data_wrapper(include_names);
+  MPSReaderTemplate<MpsReaderStreamingQpDataWrapper> reader;
+  const absl::StatusOr<MPSReaderFormat> format = reader.ParseFile(
+      lp_file, &qp_data_wrapper, MPSReaderFormat::kAutoDetect);
+  if (!format.ok()) {
+    return util::StatusBuilder(format.status()) << absl::StrFormat(
                "Could not read or parse file `%s` as an MPS file", lp_file);
   }
-  if (dimension_and_names.FailedToParse()) {
-    return absl::InvalidArgumentError(absl::StrFormat(
-        "Could not read or parse file `%s` as an MPS file, or unsupported "
-        "features/sections found",
-        lp_file));
-  }
-  DCHECK(*pass_one_format == MPSReaderFormat::kFixed ||
-         *pass_one_format == MPSReaderFormat::kFree);
-  // Populate the QP with pre-allocated sizes.
-  MpsReaderQpDataWrapper qp_data_wrapper(&dimension_and_names, include_names);
-  MPSReaderTemplate<MpsReaderQpDataWrapper> pass_two_reader;
-  const absl::StatusOr<MPSReaderFormat> pass_two_format =
-      pass_two_reader.ParseFile(lp_file, &qp_data_wrapper, *pass_one_format);
-  if (!pass_two_format.ok()) {
-    return util::StatusBuilder(pass_two_format.status()) << absl::StrFormat(
-               "Could not read or parse file `%s` as an MPS file "
-               "(maybe file changed between reads?)",
+  if (const absl::Status& status = qp_data_wrapper.ParseStatus();
+      !status.ok()) {
+    return util::StatusBuilder(status) << absl::StrFormat(
+               "Could not read or parse file `%s` as an MPS file, or "
+               "unsupported features/sections found",
                lp_file);
   }
-  DCHECK(*pass_one_format == *pass_two_format);
+  DCHECK(*format == MPSReaderFormat::kFixed ||
+         *format == MPSReaderFormat::kFree);
   return qp_data_wrapper.GetAndClearQuadraticProgram();
 }
 
@@ -407,4 +441,17 @@ QuadraticProgram ReadMpsLinearProgramOrDie(const std::string& lp_file,
   return *result;
 }
 
+absl::StatusOr<ShardedQuadraticProgram> ReadMpsShardedLinearProgram(
+    const std::string& lp_file, const int num_threads, const int num_shards,
+    bool include_names) {
+  if (num_threads < 1 || num_shards < num_threads) {
+    return absl::InvalidArgumentError(absl::StrFormat(
+        "Invalid number of threads (%d) or shards (%d)", num_threads,
+        num_shards));
+  }
+  ASSIGN_OR_RETURN(QuadraticProgram qp,
+                   ReadMpsLinearProgram(lp_file, include_names));
+  return ShardedQuadraticProgram(std::move(qp), num_threads, num_shards);
+}
+
 }  // namespace operations_research::pdlp
@@ -22,6 +22,7 @@
 #include "absl/status/status.h"
 #include "absl/status/statusor.h"
 #include "ortools/pdlp/quadratic_program.h"
+#include "ortools/pdlp/sharded_quadratic_program.h"
 
 namespace operations_research::pdlp {
 
@@ -36,9 +37,20 @@ QuadraticProgram ReadQuadraticProgramOrDie(const std::string& filename,
 QuadraticProgram ReadMpsLinearProgramOrDie(const std::string& lp_file,
                                            bool include_names = false);
 
+// Reads the MPS file in a single pass, assembling the constraint matrix
+// directly from the parsed entries (repeated entries are summed). Integrality
+// is dropped; semi-continuous variables and indicator constraints are errors.
 absl::StatusOr<QuadraticProgram> ReadMpsLinearProgram(
     const std::string& lp_file, bool include_names = false);
 
+// Like `ReadMpsLinearProgram()`, but moves the result into a
+// `ShardedQuadraticProgram` with the given number of threads and shards,
+// without copying the quadratic program. Returns an `InvalidArgumentError` if
+// `num_threads` < 1 or `num_shards` < `num_threads`.
+absl::StatusOr<ShardedQuadraticProgram> ReadMpsShardedLinearProgram(
+    const std::string& lp_file, int num_threads, int num_shards,
+    bool include_names = false);
+
 // The input may be `MPModelProto` in text format, binary format, or JSON,
 // possibly gzipped.
 QuadraticProgram ReadMPModelProtoFileOrDie(
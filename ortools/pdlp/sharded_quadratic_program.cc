@@ -14,6 +14,7 @@
 #include "ortools/pdlp/sharded_quadratic_program.h"
 
 #include <cstdint>
+#include <limits>
 #include <memory>
 #include <optional>
 #include <utility>
@@ -72,28 +73,46 @@ void WarnIfMatrixUnbalanced(
   }
 }
 
+// The pool the sharders run on: none if single-threaded, else `thread_pool`
+// if not nullptr, else `owned_thread_pool`.
+ThreadPool* SelectThreadPool(
+    const int num_threads, ThreadPool* const thread_pool,
+    const std::unique_ptr<ThreadPool>& owned_thread_pool) {
+  if (num_threads == 1) return nullptr;
+  return thread_pool != nullptr ? thread_pool : owned_thread_pool.get();
+}
+
 }  // namespace
 
 ShardedQuadraticProgram::ShardedQuadraticProgram(
     QuadraticProgram qp, const int num_threads, const int num_shards,
-    operations_research::SolverLogger* logger)
+    operations_research::SolverLogger* logger, const bool pin_threads_to_cpus,
+    ThreadPool* const thread_pool)
     : qp_(std::move(qp)),
       transposed_constraint_matrix_(qp_.constraint_matrix.transpose()),
-      thread_pool_(num_threads == 1
-                       ? nullptr
-                       : std::make_unique<ThreadPool>("PDLP", num_threads)),
-      constraint_matrix_sharder_(qp_.constraint_matrix, num_shards,
-                                 thread_pool_.get()),
-      transposed_constraint_matrix_sharder_(transposed_constraint_matrix_,
-                                            num_shards, thread_pool_.get()),
-      primal_sharder_(qp_.variable_lower_bounds.size(), num_shards,
-                      thread_pool_.get()),
-      dual_sharder_(qp_.constraint_lower_bounds.size(), num_shards,
-                    thread_pool_.get()) {
+      owned_thread_pool_(num_threads == 1 || thread_pool != nullptr
+                             ? nullptr
+                             : std::make_unique<ThreadPool>("PDLP",
+                                                            num_threads)),
+      constraint_matrix_sharder_(
+          qp_.constraint_matrix, num_shards,
+          SelectThreadPool(num_threads, thread_pool, owned_thread_pool_)),
+      transposed_constraint_matrix_sharder_(
+          transposed_constraint_matrix_, num_shards,
+          SelectThreadPool(num_threads, thread_pool, owned_thread_pool_)),
+      primal_sharder_(
+          qp_.variable_lower_bounds.size(), num_shards,
+          SelectThreadPool(num_threads, thread_pool, owned_thread_pool_)),
+      dual_sharder_(
+          qp_.constraint_lower_bounds.size(), num_shards,
+          SelectThreadPool(num_threads, thread_pool, owned_thread_pool_)) {
   CHECK_GE(num_threads, 1);
   CHECK_GE(num_shards, num_threads);
   if (num_threads > 1) {
-    thread_pool_->StartWorkers();
+    if (owned_thread_pool_ != nullptr) {
+      if (pin_threads_to_cpus) owned_thread_pool_->PinWorkersToCpus();
+      owned_thread_pool_->StartWorkers();
+    }
     const int64_t work_per_iteration = qp_.constraint_matrix.nonZeros() +
                                        qp_.variable_lower_bounds.size() +
                                        qp_.constraint_lower_bounds.size();
@@ -178,6 +197,27 @@ void ShardedQuadraticProgram::RescaleQuadraticProgram(
   ScaleMatrix(row_scaling_vec, col_scaling_vec,
               transposed_constraint_matrix_sharder_,
               transposed_constraint_matrix_);
+  if (has_float32_constraint_matrices_) {
+    has_float32_constraint_matrices_ = false;
+    float32_constraint_matrix_.resize(0, 0);
+    float32_transposed_constraint_matrix_.resize(0, 0);
+  }
+}
+
+bool ShardedQuadraticProgram::CreateFloat32ConstraintMatrices() {
+  const auto& matrix = qp_.constraint_matrix;
+  constexpr int64_t kMaxIndex = std::numeric_limits<int32_t>::max();
+  if (matrix.rows() > kMaxIndex || matrix.cols() > kMaxIndex ||
+      matrix.nonZeros() > kMaxIndex) {
+    return false;
+  }
+  float32_constraint_matrix_ = matrix.cast<float>();
+  float32_constraint_matrix_.makeCompressed();
+  float32_transposed_constraint_matrix_ =
+      transposed_constraint_matrix_.cast<float>();
+  float32_transposed_constraint_matrix_.makeCompressed();
+  has_float32_constraint_matrices_ = true;
+  return true;
 }
 
 void ShardedQuadraticProgram::ReplaceLargeConstraintBoundsWithInfinity(
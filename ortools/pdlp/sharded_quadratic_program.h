@@ -21,6 +21,7 @@
 
 #include "Eigen/Core"
 #include "Eigen/SparseCore"
+#include "absl/log/check.h"
 #include "ortools/base/threadpool.h"
 #include "ortools/pdlp/quadratic_program.h"
 #include "ortools/pdlp/sharder.h"
@@ -40,8 +41,16 @@ class ShardedQuadraticProgram {
   // Note that the `qp` is intentionally passed by value.
   // If `logger` is not nullptr, warns about unbalanced matrices using it;
   // otherwise warns via Google standard logging.
+  // If `pin_threads_to_cpus` is true, the worker threads are bound to distinct
+  // CPUs, see `ThreadPool::PinWorkersToCpus()`.
+  // If `thread_pool` is not nullptr and `num_threads` > 1, the computations
+  // run on this started pool, which must outlive this object, instead of a
+  // pool of `num_threads` workers owned by this object; `pin_threads_to_cpus`
+  // is then ignored.
   ShardedQuadraticProgram(QuadraticProgram qp, int num_threads, int num_shards,
-                          operations_research::SolverLogger* logger = nullptr);
+                          operations_research::SolverLogger* logger = nullptr,
+                          bool pin_threads_to_cpus = false,
+                          ThreadPool* thread_pool = nullptr);
 
   // Movable but not copyable.
   ShardedQuadraticProgram(const ShardedQuadraticProgram&) = delete;
@@ -110,11 +119,43 @@ class ShardedQuadraticProgram {
   // the corresponding infinity.
   void ReplaceLargeConstraintBoundsWithInfinity(double threshold);
 
+  // Creates single precision copies, with 32-bit indices, of the constraint
+  // matrix and of its transpose. They halve the memory traffic of the matrix
+  // vector products compared to the double precision matrices, which are kept
+  // for everything that needs full precision. Returns false, and creates
+  // nothing, if the matrix is too large for 32-bit indices. The copies are
+  // discarded by `RescaleQuadraticProgram()`.
+  bool CreateFloat32ConstraintMatrices();
+
+  bool HasFloat32ConstraintMatrices() const {
+    return has_float32_constraint_matrices_;
+  }
+
+  // Returns the single precision copies of the constraint matrix and of its
+  // transpose. Requires `HasFloat32ConstraintMatrices()`.
+  const Eigen::SparseMatrix<float, Eigen::ColMajor, int32_t>&
+  Float32ConstraintMatrix() const {
+    DCHECK(has_float32_constraint_matrices_);
+    return float32_constraint_matrix_;
+  }
+  const Eigen::SparseMatrix<float, Eigen::ColMajor, int32_t>&
+  Float32TransposedConstraintMatrix() const {
+    DCHECK(has_float32_constraint_matrices_);
+    return float32_transposed_constraint_matrix_;
+  }
+
  private:
   QuadraticProgram qp_;
   Eigen::SparseMatrix<double, Eigen::ColMajor, int64_t>
       transposed_constraint_matrix_;
-  std::unique_ptr<ThreadPool> thread_pool_;
+  bool has_float32_constraint_matrices_ = false;
+  Eigen::SparseMatrix<float, Eigen::ColMajor, int32_t>
+      float32_constraint_matrix_;
+  Eigen::SparseMatrix<float, Eigen::ColMajor, int32_t>
+      float32_transposed_constraint_matrix_;
+  // The pool of the sharders when it is owned by this object, nullptr if
+  // single-threaded or when the pool is passed to the constructor.
+  std::unique_ptr<ThreadPool> owned_thread_pool_;
   Sharder constraint_matrix_sharder_;
   Sharder transposed_constraint_matrix_sharder_;
   Sharder primal_sharder_;
@@ -48,6 +48,17 @@ TEST(ShardedQuadraticProgramTest, BasicTest) {
             dual_size);
 }
 
+TEST(ShardedQuadraticProgramTest, PinnedThreads) {
+  const int num_threads = 2;
+  const int num_shards = 4;
+  ShardedQuadraticProgram sharded_qp(TestLp(), num_threads, num_shards,
+                                     /*logger=*/nullptr,
+                                     /*pin_threads_to_cpus=*/true);
+  EXPECT_EQ(sharded_qp.PrimalSharder().ParallelSumOverShards(
+                [](const Sharder::Shard& /*shard*/) { return 1.0; }),
+            sharded_qp.PrimalSharder().NumShards());
+}
+
 TEST(ShardedQuadraticProgramTest, SwapVariableBounds) {
   const int num_threads = 2;
   const int num_shards = 2;
@@ -153,6 +164,26 @@ TEST(RescaleProblem, BasicTest) {
               EigenArrayEq<double>({4, 0.25}));
 }
 
+TEST(ShardedQuadraticProgramTest, Float32ConstraintMatrices) {
+  const int num_threads = 2;
+  const int num_shards = 10;
+  ShardedQuadraticProgram sharded_qp(TestDiagonalQp1(), num_threads,
+                                     num_shards);
+  EXPECT_FALSE(sharded_qp.HasFloat32ConstraintMatrices());
+  ASSERT_TRUE(sharded_qp.CreateFloat32ConstraintMatrices());
+  ASSERT_TRUE(sharded_qp.HasFloat32ConstraintMatrices());
+  EXPECT_THAT(ToDense(sharded_qp.Float32ConstraintMatrix().cast<double>()),
+              EigenArrayEq<double>({{1, 1}}));
+  EXPECT_THAT(
+      ToDense(sharded_qp.Float32TransposedConstraintMatrix().cast<double>()),
+      EigenArrayEq<double>({{1}, {1}}));
+
+  // The copies are discarded when the problem is rescaled.
+  sharded_qp.RescaleQuadraticProgram(Eigen::VectorXd{{1, 0.5}},
+                                     Eigen::VectorXd{{0.5}});
+  EXPECT_FALSE(sharded_qp.HasFloat32ConstraintMatrices());
+}
+
 TEST(ShardedQuadraticProgramTest, ReplaceLargeConstraintBoundsWithInfinity) {
   const int num_threads = 2;
   const int num_shards = 2;
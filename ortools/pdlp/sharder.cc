@@ -112,7 +112,9 @@ void Sharder::ParallelForEachShard(
     absl::BlockingCounter counter(NumShards());
     VLOG(2) << "Starting ParallelForEachShard()";
     for (int shard_num = 0; shard_num < NumShards(); ++shard_num) {
-      thread_pool_->Schedule([&, shard_num]() {
+      // A given shard always goes to the same worker, so the parts of the
+      // vectors and matrices it touches stay local to that worker.
+      thread_pool_->ScheduleOnWorker(shard_num, [&, shard_num]() {
         WallTimer timer;
         if (VLOG_IS_ON(2)) {
           timer.Start();
@@ -140,24 +142,40 @@ void Sharder::ParallelForEachShard(
   }
 }
 
+namespace {
+
+// A per-shard result on its own cache line, so the shards do not invalidate
+// each other's cache lines when they store their result.
+template <typename T>
+struct alignas(64) ShardResult {
+  T value;
+};
+
+}  // namespace
+
 double Sharder::ParallelSumOverShards(
     const std::function<double(const Shard&)>& func) const {
-  VectorXd local_sums(NumShards());
+  std::vector<ShardResult<double>> local_sums(NumShards());
   ParallelForEachShard([&](const Sharder::Shard& shard) {
-    local_sums[shard.Index()] = func(shard);
+    local_sums[shard.Index()].value = func(shard);
   });
-  return local_sums.sum();
+  double sum = 0.0;
+  for (const ShardResult<double>& local_sum : local_sums) {
+    sum += local_sum.value;
+  }
+  return sum;
 }
 
 bool Sharder::ParallelTrueForAllShards(
     const std::function<bool(const Shard&)>& func) const {
   // Recall `std::vector<bool>` is not thread-safe.
-  std::vector<int> local_result(NumShards());
+  std::vector<ShardResult<int>> local_result(NumShards());
   ParallelForEachShard([&](const Sharder::Shard& shard) {
-    local_result[shard.Index()] = static_cast<int>(func(shard));
+    local_result[shard.Index()].value = static_cast<int>(func(shard));
   });
-  return std::all_of(local_result.begin(), local_result.end(),
-                     [](const int v) { return static_cast<bool>(v); });
+  return std::all_of(
+      local_result.begin(), local_result.end(),
+      [](const ShardResult<int>& r) { return static_cast<bool>(r.value); });
 }
 
 VectorXd TransposedMatrixVectorProduct(
@@ -175,6 +193,51 @@ VectorXd TransposedMatrixVectorProduct(
   return answer;
 }
 
+VectorXd TransposedMatrixVectorProduct(
+    const Eigen::SparseMatrix<float, Eigen::ColMajor, int32_t>& matrix,
+    const VectorXd& vector, const Sharder& sharder) {
+  CHECK_EQ(vector.size(), matrix.rows());
+  CHECK_EQ(matrix.cols(), sharder.NumElements());
+  CHECK(matrix.isCompressed());
+  VectorXd answer(matrix.cols());
+  const int32_t* const outer = matrix.outerIndexPtr();
+  const int32_t* const inner = matrix.innerIndexPtr();
+  const float* const values = matrix.valuePtr();
+  sharder.ParallelForEachShard([&](const Sharder::Shard& shard) {
+    const int64_t shard_start = sharder.ShardStart(shard.Index());
+    const int64_t shard_end = shard_start + sharder.ShardSize(shard.Index());
+    for (int64_t col = shard_start; col < shard_end; ++col) {
+      double sum = 0.0;
+      for (int32_t i = outer[col]; i < outer[col + 1]; ++i) {
+        sum += static_cast<double>(values[i]) * vector[inner[i]];
+      }
+      answer[col] = sum;
+    }
+  });
+  return answer;
+}
+
+RowMajorBlock TransposedMatrixBlockProduct(
+    const Eigen::SparseMatrix<double, Eigen::ColMajor, int64_t>& matrix,
+    const RowMajorBlock& block, const Sharder& sharder) {
+  using InnerIterator =
+      Eigen::SparseMatrix<double, Eigen::ColMajor, int64_t>::InnerIterator;
+  CHECK_EQ(block.rows(), matrix.rows());
+  CHECK_EQ(matrix.cols(), sharder.NumElements());
+  RowMajorBlock answer(matrix.cols(), block.cols());
+  sharder.ParallelForEachShard([&](const Sharder::Shard& shard) {
+    const int64_t shard_start = sharder.ShardStart(shard.Index());
+    const int64_t shard_end = shard_start + sharder.ShardSize(shard.Index());
+    for (int64_t col = shard_start; col < shard_end; ++col) {
+      answer.row(col).setZero();
+      for (InnerIterator it(matrix, col); it; ++it) {
+        answer.row(col) += it.value() * block.row(it.row());
+      }
+    }
+  });
+  return answer;
+}
+
 void SetZero(const Sharder& sharder, VectorXd& dest) {
   dest.resize(sharder.NumElements());
   sharder.ParallelForEachShard(
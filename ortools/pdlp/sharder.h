@@ -238,6 +238,29 @@ Eigen::VectorXd TransposedMatrixVectorProduct(
     const Eigen::SparseMatrix<double, Eigen::ColMajor, int64_t>& matrix,
     const Eigen::VectorXd& vector, const Sharder& sharder);
 
+// Same as above for a single precision `matrix` with 32-bit indices, which
+// needs half the memory bandwidth. The products and sums are computed in
+// double precision, so the only loss of precision comes from the rounding of
+// the matrix coefficients. `matrix` must be compressed.
+Eigen::VectorXd TransposedMatrixVectorProduct(
+    const Eigen::SparseMatrix<float, Eigen::ColMajor, int32_t>& matrix,
+    const Eigen::VectorXd& vector, const Sharder& sharder);
+
+// A dense block of vectors stored as the columns of a row major matrix, for
+// example the primal iterates of several problems sharing one constraint
+// matrix. Row major storage keeps the values multiplied by the same matrix
+// coefficient contiguous.
+using RowMajorBlock =
+    Eigen::Matrix<double, Eigen::Dynamic, Eigen::Dynamic, Eigen::RowMajor>;
+
+// Like `matrix.transpose() * block` but executed in parallel using `sharder`,
+// with the same requirements as `TransposedMatrixVectorProduct()`. Each matrix
+// coefficient is read once for all the `block.cols()` vectors, which is a lot
+// less memory traffic than one `TransposedMatrixVectorProduct()` per vector.
+RowMajorBlock TransposedMatrixBlockProduct(
+    const Eigen::SparseMatrix<double, Eigen::ColMajor, int64_t>& matrix,
+    const RowMajorBlock& block, const Sharder& sharder);
+
 ////////////////////////////////////////////////////////////////////////////////
 // The following functions use `sharder` to compute a vector operation in
 // parallel. `sharder` should have the same size as the vector(s). For best
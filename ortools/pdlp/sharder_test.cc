@@ -36,6 +36,7 @@ using ::Eigen::DiagonalMatrix;
 using ::Eigen::VectorXd;
 using ::testing::DoubleNear;
 using ::testing::ElementsAre;
+using ::testing::ElementsAreArray;
 using ::testing::Test;
 using Shard = Sharder::Shard;
 
@@ -257,6 +258,33 @@ TEST(MatrixVectorProductTest, SmallExample) {
   EXPECT_THAT(ans, ElementsAre(6.0, -0.5, 6.0, 19));
 }
 
+TEST(MatrixVectorProductTest, SmallFloat32Example) {
+  Eigen::SparseMatrix<double, Eigen::ColMajor, int64_t> mat =
+      TestSparseMatrix();
+  Eigen::SparseMatrix<float, Eigen::ColMajor, int32_t> float32_mat =
+      mat.cast<float>();
+  float32_mat.makeCompressed();
+  Sharder sharder(mat, /*num_shards=*/3, nullptr);
+  const VectorXd vec{{1, 2, 3}};
+  VectorXd ans = TransposedMatrixVectorProduct(float32_mat, vec, sharder);
+  EXPECT_THAT(ans, ElementsAre(6.0, -0.5, 6.0, 19));
+}
+
+TEST(MatrixBlockProductTest, SmallExample) {
+  Eigen::SparseMatrix<double, Eigen::ColMajor, int64_t> mat =
+      TestSparseMatrix();
+  Sharder sharder(mat, /*num_shards=*/3, nullptr);
+  RowMajorBlock block(3, 2);
+  block << 1, 0, 2, 0, 3, 1;
+  RowMajorBlock ans = TransposedMatrixBlockProduct(mat, block, sharder);
+  ASSERT_EQ(ans.rows(), 4);
+  ASSERT_EQ(ans.cols(), 2);
+  EXPECT_THAT(VectorXd(ans.col(0)), ElementsAre(6.0, -0.5, 6.0, 19));
+  EXPECT_THAT(VectorXd(ans.col(1)),
+              ElementsAreArray(TransposedMatrixVectorProduct(
+                  mat, VectorXd{{0, 0, 1}}, sharder)));
+}
+
 TEST(SetZeroTest, SmallExample) {
   Sharder sharder(3, /*num_shards=*/2, nullptr);
   VectorXd vec{{1, 7}};
@@ -443,6 +471,39 @@ TEST_P(VariousSizesTest, LargeMatVec) {
   EXPECT_LE((direct - threaded).norm(), 1.0e-8);
 }
 
+TEST_P(VariousSizesTest, LargeFloat32MatVec) {
+  const int64_t size = GetParam();
+  Eigen::SparseMatrix<double, Eigen::ColMajor, int64_t> mat =
+      LargeSparseMatrix(size);
+  Eigen::SparseMatrix<float, Eigen::ColMajor, int32_t> float32_mat =
+      mat.cast<float>();
+  float32_mat.makeCompressed();
+  const int num_threads = 5;
+  const int shards_per_thread = 3;
+  ThreadPool pool("MatrixVectorProductTest", num_threads);
+  pool.StartWorkers();
+  Sharder sharder(mat, shards_per_thread * num_threads, &pool);
+  VectorXd rhs = VectorXd::Random(size);
+  VectorXd direct = float32_mat.cast<double>().transpose() * rhs;
+  VectorXd threaded = TransposedMatrixVectorProduct(float32_mat, rhs, sharder);
+  EXPECT_LE((direct - threaded).norm(), 1.0e-8);
+}
+
+TEST_P(VariousSizesTest, LargeMatBlock) {
+  const int64_t size = GetParam();
+  Eigen::SparseMatrix<double, Eigen::ColMajor, int64_t> mat =
+      LargeSparseMatrix(size);
+  const int num_threads = 5;
+  const int shards_per_thread = 3;
+  ThreadPool pool("MatrixBlockProductTest", num_threads);
+  pool.StartWorkers();
+  Sharder sharder(mat, shards_per_thread * num_threads, &pool);
+  RowMajorBlock rhs = RowMajorBlock::Random(size, 3);
+  RowMajorBlock direct = mat.transpose() * rhs;
+  RowMajorBlock threaded = TransposedMatrixBlockProduct(mat, rhs, sharder);
+  EXPECT_LE((direct - threaded).norm(), 1.0e-8);
+}
+
 TEST_P(VariousSizesTest, LargeVectors) {
   const int64_t size = GetParam();
   const int num_threads = 5;
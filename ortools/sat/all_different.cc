@@ -162,6 +162,8 @@ AllDifferentConstraint::AllDifferentConstraint(
 
   successor_.resize(num_variables_);
   variable_to_value_.assign(num_variables_, -1);
+  value_visited_.assign(num_all_values_, false);
+  variable_visited_.assign(num_variables_, false);
   visiting_.resize(num_variables_);
   variable_visited_from_.resize(num_variables_);
   residual_graph_successors_.resize(num_variables_ + num_all_values_ + 1);
@@ -218,6 +220,7 @@ bool AllDifferentConstraint::MakeAugmentingPath(int start) {
     for (const int value : successor_[node]) {
       if (value_visited_[value]) continue;
       value_visited_[value] = true;
+      visited_values_.push_back(value);
       if (value_to_variable_[value] == -1) {
         // value is not matched: change path from node to start, and return.
         int path_node = node;
@@ -229,6 +232,7 @@ bool AllDifferentConstraint::MakeAugmentingPath(int start) {
           path_node = variable_visited_from_[path_node];
           path_value = old_value;
         }
+        num_visited_variables_ = num_to_visit;
         return true;
       } else {
         // Enqueue node matched to value.
@@ -239,9 +243,19 @@ bool AllDifferentConstraint::MakeAugmentingPath(int start) {
       }
     }
   }
+  num_visited_variables_ = num_to_visit;
   return false;
 }
 
+void AllDifferentConstraint::ClearVisitedNodes() {
+  for (const int value : visited_values_) value_visited_[value] = false;
+  visited_values_.clear();
+  for (int i = 0; i < num_visited_variables_; ++i) {
+    variable_visited_[visiting_[i]] = false;
+  }
+  num_visited_variables_ = 0;
+}
+
 // The algorithm copies the solver state to successor_, which is used to compute
 // a matching. If all variables can be matched, it generates the residual graph
 // in separate vectors, computes its SCCs, and filters variable -> value if
@@ -311,8 +325,7 @@ bool AllDifferentConstraint::Propagate() {
   int x = 0;
   for (; x < num_variables_; x++) {
     if (variable_to_value_[x] == -1) {
-      value_visited_.assign(num_all_values_, false);
-      variable_visited_.assign(num_variables_, false);
+      ClearVisitedNodes();
       MakeAugmentingPath(x);
     }
     if (variable_to_value_[x] == -1) break;  // No augmenting path exists.
@@ -399,8 +412,7 @@ bool AllDifferentConstraint::Propagate() {
         // then find another assignment for the variable matched to
         // offset_value. It will fail: explaining why is the same as
         // explaining failure as above, and it is an explanation of x != value.
-        value_visited_.assign(num_all_values_, false);
-        variable_visited_.assign(num_variables_, false);
+        ClearVisitedNodes();
         // Undo x -> old_value and old_variable -> offset_value.
         const int old_variable = value_to_variable_[offset_value];
         variable_to_value_[old_variable] = -1;
@@ -410,6 +422,7 @@ bool AllDifferentConstraint::Propagate() {
         value_to_variable_[offset_value] = x;
 
         value_visited_[offset_value] = true;
+        visited_values_.push_back(offset_value);
         MakeAugmentingPath(old_variable);
         DCHECK_EQ(variable_to_value_[old_variable], -1);  // No reassignment.
 
@@ -85,6 +85,11 @@ class AllDifferentConstraint : PropagatorInterface {
   // or manipulate it to create what-if scenarios without modifying successor_.
   bool MakeAugmentingPath(int start);
 
+  // Resets value/variable_visited_ to false. This only touches the nodes
+  // visited by the last call to MakeAugmentingPath(), so that repairing the
+  // previous matching does not cost O(num_all_values_) per unmatched variable.
+  void ClearVisitedNodes();
+
   // Accessors to the cache of literals.
   inline LiteralIndex VariableLiteralIndexOf(int x, int64_t value);
   inline bool VariableHasPossibleValue(int x, int64_t value);
@@ -114,6 +119,12 @@ class AllDifferentConstraint : PropagatorInterface {
   std::vector<int> visiting_;
   std::vector<int> variable_visited_from_;
 
+  // The variables visited by the last MakeAugmentingPath() are the first
+  // num_visited_variables_ of visiting_, and the visited values are listed in
+  // visited_values_.
+  int num_visited_variables_ = 0;
+  std::vector<int> visited_values_;
+
   // Internal state of ComputeSCCs().
   // Variable nodes are indexed by [0, num_variables_),
   // value nodes by [num_variables_, num_variables_ + num_all_values_),
@@ -13,6 +13,7 @@
 
 #include "ortools/sat/circuit.h"
 
+#include <cstdint>
 #include <functional>
 #include <utility>
 #include <vector>
@@ -46,6 +47,7 @@ CircuitPropagator::CircuitPropagator(const int num_nodes,
   prev_.resize(num_nodes_, -1);
   next_literal_.resize(num_nodes_);
   must_be_in_cycle_.resize(num_nodes_);
+  node_stamp_.resize(num_nodes_, 0);
   absl::flat_hash_map<LiteralIndex, int> literal_to_watch_index;
 
   const int num_arcs = tails.size();
@@ -133,20 +135,6 @@ void CircuitPropagator::SetLevel(int level) {
   level_ends_.resize(level);
 }
 
-void CircuitPropagator::FillReasonForPath(int start_node,
-                                          std::vector<Literal>* reason) const {
-  CHECK_NE(start_node, -1);
-  reason->clear();
-  int node = start_node;
-  while (next_[node] != -1) {
-    if (next_literal_[node] != kNoLiteralIndex) {
-      reason->push_back(Literal(next_literal_[node]).Negated());
-    }
-    node = next_[node];
-    if (node == start_node) break;
-  }
-}
-
 // If multiple_subcircuit_through_zero is true, we never fill next_[0] and
 // prev_[0].
 void CircuitPropagator::AddArc(int tail, int head, LiteralIndex literal_index) {
@@ -161,6 +149,8 @@ void CircuitPropagator::AddArc(int tail, int head, LiteralIndex literal_index) {
 
 bool CircuitPropagator::IncrementalPropagate(
     const std::vector<int>& watch_indices) {
+  const int old_must_be_in_cycle_size = rev_must_be_in_cycle_size_;
+  touched_nodes_.clear();
   for (const int w : watch_indices) {
     const Literal literal = watch_index_to_literal_[w];
     for (const Arc arc : watch_index_to_arcs_[w]) {
@@ -196,147 +186,172 @@ bool CircuitPropagator::IncrementalPropagate(
       // Add the arc.
       AddArc(arc.tail, arc.head, literal.Index());
       added_arcs_.push_back(arc);
+
+      // In the multiple_subcircuit_through_zero case, zero is never linked, so
+      // we need both extremities to find the path that changed.
+      touched_nodes_.push_back(arc.tail);
+      touched_nodes_.push_back(arc.head);
     }
   }
-  return Propagate();
+
+  // A new node that must be in the cycle can trigger a propagation on any
+  // path, so we need to look at all of them. Note that must_be_in_cycle_ is
+  // not used in the multiple_subcircuit_through_zero case.
+  if (rev_must_be_in_cycle_size_ != old_must_be_in_cycle_size &&
+      !options_.multiple_subcircuit_through_zero) {
+    return Propagate();
+  }
+
+  // Otherwise, only the paths that just changed can propagate something new.
+  pass_start_stamp_ = stamp_;
+  for (const int node : touched_nodes_) {
+    if (!PropagatePathContaining(node)) return false;
+  }
+  return true;
 }
 
 // This function assumes that next_, prev_, next_literal_ and must_be_in_cycle_
 // are all up to date.
 bool CircuitPropagator::Propagate() {
-  processed_.assign(num_nodes_, false);
+  pass_start_stamp_ = stamp_;
   for (int n = 0; n < num_nodes_; ++n) {
-    if (processed_[n]) continue;
-    if (next_[n] == n) continue;
-    if (next_[n] == -1 && prev_[n] == -1) continue;
-
-    // TODO(user): both this and the loop on must_be_in_cycle_ might take some
-    // time on large graph. Optimize if this become an issue.
-    in_current_path_.assign(num_nodes_, false);
-
-    // Find the start and end of the path containing node n. If this is a
-    // circuit, we will have start_node == end_node.
-    int start_node = n;
-    int end_node = n;
-    in_current_path_[n] = true;
-    processed_[n] = true;
-    while (next_[end_node] != -1) {
-      end_node = next_[end_node];
-      in_current_path_[end_node] = true;
-      processed_[end_node] = true;
-      if (end_node == n) break;
+    if (!PropagatePathContaining(n)) return false;
+  }
+  return true;
+}
+
+bool CircuitPropagator::PropagatePathContaining(int n) {
+  if (node_stamp_[n] > pass_start_stamp_) return true;
+  if (next_[n] == n) return true;
+  if (next_[n] == -1 && prev_[n] == -1) return true;
+
+  // Find the start of the path containing node n. If this is a circuit, we
+  // will have start_node == n.
+  int start_node = n;
+  while (prev_[start_node] != -1) {
+    start_node = prev_[start_node];
+    if (start_node == n) break;
+  }
+
+  // Walk the path once to stamp its nodes and to collect its reason, which is
+  // shared by all the propagations below. If this is a circuit, we will have
+  // start_node == end_node.
+  const int64_t path_stamp = ++stamp_;
+  const auto in_current_path = [this, path_stamp](int node) {
+    return node_stamp_[node] == path_stamp;
+  };
+  path_reason_.clear();
+  int end_node = start_node;
+  node_stamp_[start_node] = path_stamp;
+  while (next_[end_node] != -1) {
+    if (next_literal_[end_node] != kNoLiteralIndex) {
+      path_reason_.push_back(Literal(next_literal_[end_node]).Negated());
     }
-    while (prev_[start_node] != -1) {
-      start_node = prev_[start_node];
-      in_current_path_[start_node] = true;
-      processed_[start_node] = true;
-      if (start_node == n) break;
+    end_node = next_[end_node];
+    if (end_node == start_node) break;
+    node_stamp_[end_node] = path_stamp;
+  }
+
+  // TODO(user): we can fail early in more case, like no more possible path
+  // to any of the mandatory node.
+  if (options_.multiple_subcircuit_through_zero) {
+    // Any cycle must contain zero.
+    if (start_node == end_node && !in_current_path(0)) {
+      *trail_->MutableConflict() = path_reason_;
+      return false;
     }
 
-    // TODO(user): we can fail early in more case, like no more possible path
-    // to any of the mandatory node.
-    if (options_.multiple_subcircuit_through_zero) {
-      // Any cycle must contain zero.
-      if (start_node == end_node && !in_current_path_[0]) {
-        FillReasonForPath(start_node, trail_->MutableConflict());
+    // An incomplete path cannot be closed except if one of the end-points
+    // is zero.
+    if (start_node != end_node && start_node != 0 && end_node != 0) {
+      const auto it = graph_.find({end_node, start_node});
+      if (it == graph_.end()) return true;
+      const Literal literal = it->second;
+      if (assignment_.LiteralIsFalse(literal)) return true;
+
+      *trail_->GetEmptyVectorToStoreReason() = path_reason_;
+      if (!trail_->EnqueueWithStoredReason(literal.Negated())) {
         return false;
       }
+    }
 
-      // An incomplete path cannot be closed except if one of the end-points
-      // is zero.
-      if (start_node != end_node && start_node != 0 && end_node != 0) {
-        const auto it = graph_.find({end_node, start_node});
-        if (it == graph_.end()) continue;
-        const Literal literal = it->second;
-        if (assignment_.LiteralIsFalse(literal)) continue;
-
-        std::vector<Literal>* reason = trail_->GetEmptyVectorToStoreReason();
-        FillReasonForPath(start_node, reason);
-        if (!trail_->EnqueueWithStoredReason(literal.Negated())) {
-          return false;
-        }
-      }
+    // None of the other propagation below are valid in case of multiple
+    // circuits.
+    return true;
+  }
 
-      // None of the other propagation below are valid in case of multiple
-      // circuits.
-      continue;
+  // Check if we miss any node that must be in the circuit. Note that the ones
+  // for which self_arcs_[i] is kFalseLiteralIndex are first. This is good as
+  // it will produce shorter reason. Otherwise we prefer the first that was
+  // assigned in the trail.
+  bool miss_some_nodes = false;
+  LiteralIndex extra_reason = kFalseLiteralIndex;
+  for (int i = 0; i < rev_must_be_in_cycle_size_; ++i) {
+    const int node = must_be_in_cycle_[i];
+    if (!in_current_path(node)) {
+      miss_some_nodes = true;
+      extra_reason = self_arcs_[node].Index();
+      break;
     }
+  }
 
-    // Check if we miss any node that must be in the circuit. Note that the ones
-    // for which self_arcs_[i] is kFalseLiteralIndex are first. This is good as
-    // it will produce shorter reason. Otherwise we prefer the first that was
-    // assigned in the trail.
-    bool miss_some_nodes = false;
-    LiteralIndex extra_reason = kFalseLiteralIndex;
-    for (int i = 0; i < rev_must_be_in_cycle_size_; ++i) {
-      const int node = must_be_in_cycle_[i];
-      if (!in_current_path_[node]) {
-        miss_some_nodes = true;
-        extra_reason = self_arcs_[node].Index();
-        break;
+  if (miss_some_nodes) {
+    // A circuit that miss a mandatory node is a conflict.
+    if (start_node == end_node) {
+      std::vector<Literal>* conflict = trail_->MutableConflict();
+      *conflict = path_reason_;
+      if (extra_reason != kFalseLiteralIndex) {
+        conflict->push_back(Literal(extra_reason));
       }
+      return false;
     }
 
-    if (miss_some_nodes) {
-      // A circuit that miss a mandatory node is a conflict.
-      if (start_node == end_node) {
-        FillReasonForPath(start_node, trail_->MutableConflict());
-        if (extra_reason != kFalseLiteralIndex) {
-          trail_->MutableConflict()->push_back(Literal(extra_reason));
-        }
-        return false;
-      }
-
-      // We have an unclosed path. Propagate the fact that it cannot
-      // be closed into a cycle, i.e. not(end_node -> start_node).
-      if (start_node != end_node) {
-        const auto it = graph_.find({end_node, start_node});
-        if (it == graph_.end()) continue;
-        const Literal literal = it->second;
-        if (assignment_.LiteralIsFalse(literal)) continue;
-
-        std::vector<Literal>* reason = trail_->GetEmptyVectorToStoreReason();
-        FillReasonForPath(start_node, reason);
-        if (extra_reason != kFalseLiteralIndex) {
-          reason->push_back(Literal(extra_reason));
-        }
-        const bool ok = trail_->EnqueueWithStoredReason(literal.Negated());
-        if (!ok) return false;
-        continue;
-      }
+    // We have an unclosed path. Propagate the fact that it cannot
+    // be closed into a cycle, i.e. not(end_node -> start_node).
+    const auto it = graph_.find({end_node, start_node});
+    if (it == graph_.end()) return true;
+    const Literal literal = it->second;
+    if (assignment_.LiteralIsFalse(literal)) return true;
+
+    std::vector<Literal>* reason = trail_->GetEmptyVectorToStoreReason();
+    *reason = path_reason_;
+    if (extra_reason != kFalseLiteralIndex) {
+      reason->push_back(Literal(extra_reason));
     }
+    return trail_->EnqueueWithStoredReason(literal.Negated());
+  }
 
-    // If we have a cycle, we can propagate all the other nodes to point to
-    // themselves. Otherwise there is nothing else to do.
-    if (start_node != end_node) continue;
-    BooleanVariable variable_with_same_reason = kNoBooleanVariable;
-    for (int node = 0; node < num_nodes_; ++node) {
-      if (in_current_path_[node]) continue;
-      if (assignment_.LiteralIsTrue(self_arcs_[node])) continue;
-
-      // This shouldn't happen because ExactlyOnePerRowAndPerColumn() should
-      // have executed first and propagated self_arcs_[node] to false.
-      CHECK_EQ(next_[node], -1);
-
-      // We should have detected that above (miss_some_nodes == true). But we
-      // still need this for corner cases where the same literal is used for
-      // many arcs, and we just propagated it here.
-      if (assignment_.LiteralIsFalse(self_arcs_[node])) {
-        FillReasonForPath(start_node, trail_->MutableConflict());
-        trail_->MutableConflict()->push_back(self_arcs_[node]);
-        return false;
-      }
+  // If we have a cycle, we can propagate all the other nodes to point to
+  // themselves. Otherwise there is nothing else to do.
+  if (start_node != end_node) return true;
+  BooleanVariable variable_with_same_reason = kNoBooleanVariable;
+  for (int node = 0; node < num_nodes_; ++node) {
+    if (in_current_path(node)) continue;
+    if (assignment_.LiteralIsTrue(self_arcs_[node])) continue;
 
-      // Propagate.
-      const Literal literal(self_arcs_[node]);
-      if (variable_with_same_reason == kNoBooleanVariable) {
-        variable_with_same_reason = literal.Variable();
-        FillReasonForPath(start_node, trail_->GetEmptyVectorToStoreReason());
-        const bool ok = trail_->EnqueueWithStoredReason(literal);
-        if (!ok) return false;
-      } else {
-        trail_->EnqueueWithSameReasonAs(literal, variable_with_same_reason);
-      }
+    // This shouldn't happen because ExactlyOnePerRowAndPerColumn() should
+    // have executed first and propagated self_arcs_[node] to false.
+    CHECK_EQ(next_[node], -1);
+
+    // We should have detected that above (miss_some_nodes == true). But we
+    // still need this for corner cases where the same literal is used for
+    // many arcs, and we just propagated it here.
+    if (assignment_.LiteralIsFalse(self_arcs_[node])) {
+      std::vector<Literal>* conflict = trail_->MutableConflict();
+      *conflict = path_reason_;
+      conflict->push_back(self_arcs_[node]);
+      return false;
+    }
+
+    // Propagate.
+    const Literal literal(self_arcs_[node]);
+    if (variable_with_same_reason == kNoBooleanVariable) {
+      variable_with_same_reason = literal.Variable();
+      *trail_->GetEmptyVectorToStoreReason() = path_reason_;
+      const bool ok = trail_->EnqueueWithStoredReason(literal);
+      if (!ok) return false;
+    } else {
+      trail_->EnqueueWithSameReasonAs(literal, variable_with_same_reason);
     }
   }
   return true;
@@ -14,6 +14,7 @@
 #ifndef OR_TOOLS_SAT_CIRCUIT_H_
 #define OR_TOOLS_SAT_CIRCUIT_H_
 
+#include <cstdint>
 #include <functional>
 #include <memory>
 #include <utility>
@@ -71,10 +72,9 @@ class CircuitPropagator : PropagatorInterface, ReversibleInterface {
   // Updates the structures when the given arc is added to the paths.
   void AddArc(int tail, int head, LiteralIndex literal_index);
 
-  // Clears and fills reason with the literals of the arcs that form a path from
-  // the given node. The path can be a cycle, but in this case it must end at
-  // start (not like a rho shape).
-  void FillReasonForPath(int start_node, std::vector<Literal>* reason) const;
+  // Propagates on the path (or cycle) containing n, unless it was already
+  // processed during the current pass. Returns false on conflict.
+  bool PropagatePathContaining(int n);
 
   const int num_nodes_;
   const Options options_;
@@ -113,9 +113,17 @@ class CircuitPropagator : PropagatorInterface, ReversibleInterface {
   int rev_must_be_in_cycle_size_ = 0;
   std::vector<int> must_be_in_cycle_;
 
-  // Temporary vectors.
-  std::vector<bool> processed_;
-  std::vector<bool> in_current_path_;
+  // Each walked path gets a new stamp, and its nodes are marked with it. A
+  // node was processed during the current pass iff its stamp is greater than
+  // pass_start_stamp_. This avoids any O(num_nodes) reset per path.
+  int64_t stamp_ = 0;
+  int64_t pass_start_stamp_ = 0;
+  std::vector<int64_t> node_stamp_;
+
+  // Temporary vectors. path_reason_ contains the literals of the arcs of the
+  // last walked path, it is the reason of all the propagations on this path.
+  std::vector<int> touched_nodes_;
+  std::vector<Literal> path_reason_;
 };
 
 // Enforce the fact that there is no cycle in the given directed graph.
@@ -18,6 +18,7 @@
 #include <algorithm>
 #include <cstdint>
 #include <deque>
+#include <memory>
 #include <queue>
 #include <string>
 #include <utility>
@@ -73,6 +74,7 @@ ClauseManager::ClauseManager(Model* model)
     : SatPropagator("ClauseManager"),
       implication_graph_(model->GetOrCreate<BinaryImplicationGraph>()),
       trail_(model->GetOrCreate<Trail>()),
+      parameters_(*model->GetOrCreate<SatParameters>()),
       num_inspected_clauses_(0),
       num_inspected_clause_literals_(0),
       num_watched_clauses_(0),
@@ -81,7 +83,7 @@ ClauseManager::ClauseManager(Model* model)
 }
 
 ClauseManager::~ClauseManager() {
-  gtl::STLDeleteElements(&clauses_);
+  if (!use_clause_arena_) gtl::STLDeleteElements(&clauses_);
   IF_STATS_ENABLED(LOG(INFO) << stats_.StatString());
 }
 
@@ -99,6 +101,16 @@ void ClauseManager::AttachOnFalse(Literal literal, Literal blocking_literal,
   SCOPED_TIME_STAT(&stats_);
   DCHECK(is_clean_);
   DCHECK(!WatcherListContains(watchers_on_false_[literal], *clause));
+  if (clause->size() == 3) {
+    const Literal* literals = clause->begin();
+    const Literal other(LiteralIndex(
+        literals[0].Index().value() ^ literals[1].Index().value() ^
+        literals[2].Index().value() ^ literal.Index().value() ^
+        blocking_literal.Index().value()));
+    watchers_on_false_[literal].push_back(
+        Watcher::Ternary(clause, blocking_literal, other));
+    return;
+  }
   watchers_on_false_[literal].push_back(Watcher(clause, blocking_literal));
 }
 
@@ -124,6 +136,58 @@ bool ClauseManager::PropagateOnFalse(Literal false_literal, Trail* trail) {
     }
     ++num_inspected_clauses_;
 
+    if (it->IsTernary()) {
+      // If the last inlined literal is true, make it the blocking literal so
+      // that the fast path above skips this watcher next time.
+      const Literal ternary_literal = it->TernaryLiteral();
+      if (assignment.LiteralIsTrue(ternary_literal)) {
+        *new_it++ =
+            Watcher::Ternary(it->clause, ternary_literal, it->blocking_literal);
+        ++num_inspected_clause_literals_;
+        continue;
+      }
+
+      // None of the other two literals is true, we need the clause memory.
+      // Note that {blocking_literal, ternary_literal} is always the set of the
+      // literals of the clause different from false_literal.
+      Literal* literals = it->clause->literals();
+      const Literal other_watched_literal(
+          LiteralIndex(literals[0].Index().value() ^
+                       literals[1].Index().value() ^
+                       false_literal.Index().value()));
+      const Literal non_watched_literal(LiteralIndex(
+          it->blocking_literal.Index().value() ^
+          ternary_literal.Index().value() ^
+          other_watched_literal.Index().value()));
+      num_inspected_clause_literals_ += 3;
+      if (!assignment.LiteralIsFalse(non_watched_literal)) {
+        // Watch the non-watched literal instead, it must be unassigned.
+        literals[0] = other_watched_literal;
+        literals[1] = non_watched_literal;
+        literals[2] = false_literal;
+        watchers_on_false_[non_watched_literal].push_back(Watcher::Ternary(
+            it->clause, other_watched_literal, false_literal));
+        continue;
+      }
+      if (assignment.LiteralIsFalse(other_watched_literal)) {
+        // Conflict: All literals of it->clause are false.
+        trail->MutableConflict()->assign(it->clause->begin(),
+                                         it->clause->end());
+        trail->SetFailingSatClause(it->clause);
+        num_inspected_clause_literals_ += it - watchers.begin() + 1;
+        watchers.erase(new_it, it);
+        return false;
+      }
+
+      // Propagation, see the comment for the general case below.
+      literals[0] = other_watched_literal;
+      literals[1] = false_literal;
+      reasons_[trail->Index()] = it->clause;
+      trail->Enqueue(other_watched_literal, propagator_id_);
+      *new_it++ = *it;
+      continue;
+    }
+
     // If the other watched literal is true, just change the blocking literal.
     // Note that we use the fact that the first two literals of the clause are
     // the ones currently watched.
@@ -222,19 +286,29 @@ bool ClauseManager::AddClause(absl::Span<const Literal> literals) {
 
 bool ClauseManager::AddClause(absl::Span<const Literal> literals,
                               Trail* trail) {
-  SatClause* clause = SatClause::Create(literals);
-  clauses_.push_back(clause);
+  SatClause* clause = NewClause(literals);
   return AttachAndPropagate(clause, trail);
 }
 
 SatClause* ClauseManager::AddRemovableClause(
     const std::vector<Literal>& literals, Trail* trail) {
-  SatClause* clause = SatClause::Create(literals);
-  clauses_.push_back(clause);
+  SatClause* clause = NewClause(literals);
   CHECK(AttachAndPropagate(clause, trail));
   return clause;
 }
 
+SatClause* ClauseManager::NewClause(absl::Span<const Literal> literals) {
+  // Switching between the two modes is only safe if no clause is allocated.
+  if (clauses_.empty()) {
+    use_clause_arena_ = parameters_.use_clause_arena();
+    if (!use_clause_arena_) clause_arena_.Clear();
+  }
+  SatClause* clause = use_clause_arena_ ? clause_arena_.Create(literals)
+                                        : SatClause::Create(literals);
+  clauses_.push_back(clause);
+  return clause;
+}
+
 // Sets up the 2-watchers data structure. It selects two non-false literals
 // and attaches the clause to the event: one of the watched literals become
 // false. It returns false if the clause only contains literals assigned to
@@ -451,9 +525,7 @@ SatClause* ClauseManager::InprocessingAddClause(
     return nullptr;
   }
 
-  SatClause* clause = SatClause::Create(new_clause);
-  clauses_.push_back(clause);
-  return clause;
+  return NewClause(new_clause);
 }
 
 void ClauseManager::CleanUpWatchers() {
@@ -482,7 +554,7 @@ void ClauseManager::DeleteRemovedClauses() {
     if (i == to_minimize_index_) to_minimize_index_ = new_size;
     if (i == to_probe_index_) to_probe_index_ = new_size;
     if (clauses_[i]->IsRemoved()) {
-      delete clauses_[i];
+      if (!use_clause_arena_) delete clauses_[i];
     } else {
       clauses_[new_size++] = clauses_[i];
     }
@@ -493,6 +565,52 @@ void ClauseManager::DeleteRemovedClauses() {
   if (to_probe_index_ > new_size) to_probe_index_ = new_size;
 }
 
+void ClauseManager::CompactClauseArenaIfNeeded() {
+  if (!use_clause_arena_) return;
+  SCOPED_TIME_STAT(&stats_);
+  DCHECK(is_clean_);
+
+  int64_t num_live_words = 0;
+  for (const SatClause* clause : clauses_) {
+    DCHECK(!clause->IsRemoved());
+    num_live_words += ClauseArena::NumWords(clause->size());
+  }
+  if (clause_arena_.num_used_words() <= 2 * num_live_words) return;
+
+  // Copy all the clauses in creation order into a single new block.
+  ClauseArena new_arena;
+  new_arena.Reserve(num_live_words);
+  absl::flat_hash_map<SatClause*, SatClause*> new_address;
+  new_address.reserve(clauses_.size());
+  for (SatClause*& clause : clauses_) {
+    SatClause* new_clause = new_arena.Create(clause->AsSpan());
+    new_address[clause] = new_clause;
+    clause = new_clause;
+  }
+
+  // Update all the pointers we hold. Note that reasons_ might contain stale
+  // pointers for the literals not propagated by this class, these are never
+  // used and we can just ignore them.
+  for (std::vector<Watcher>& watchers : watchers_on_false_) {
+    for (Watcher& watcher : watchers) {
+      watcher.clause = new_address.at(watcher.clause);
+    }
+  }
+  for (int i = 0; i < trail_->Index(); ++i) {
+    const auto it = new_address.find(reasons_[i]);
+    if (it != new_address.end()) reasons_[i] = it->second;
+  }
+  absl::flat_hash_map<SatClause*, ClauseInfo> new_clauses_info;
+  new_clauses_info.reserve(clauses_info_.size());
+  for (const auto& [clause, info] : clauses_info_) {
+    new_clauses_info[new_address.at(clause)] = info;
+  }
+  clauses_info_ = std::move(new_clauses_info);
+
+  // This releases the old memory.
+  clause_arena_ = std::move(new_arena);
+}
+
 // ----- BinaryImplicationGraph -----
 
 void BinaryImplicationGraph::Resize(int num_variables) {
@@ -2469,9 +2587,16 @@ absl::Span<const Literal> BinaryImplicationGraph::NextAtMostOne() {
 
 // static
 SatClause* SatClause::Create(absl::Span<const Literal> literals) {
+  return CreateAt(
+      ::operator new(sizeof(SatClause) + literals.size() * sizeof(Literal)),
+      literals);
+}
+
+// static
+SatClause* SatClause::CreateAt(void* memory,
+                               absl::Span<const Literal> literals) {
   DCHECK_GE(literals.size(), 2);
-  SatClause* clause = reinterpret_cast<SatClause*>(
-      ::operator new(sizeof(SatClause) + literals.size() * sizeof(Literal)));
+  SatClause* clause = reinterpret_cast<SatClause*>(memory);
   clause->size_ = literals.size();
   for (int i = 0; i < literals.size(); ++i) {
     clause->literals_[i] = literals[i];
@@ -2479,6 +2604,37 @@ SatClause* SatClause::Create(absl::Span<const Literal> literals) {
   return clause;
 }
 
+// ----- ClauseArena -----
+
+static_assert(sizeof(SatClause) == sizeof(int32_t) &&
+                  sizeof(Literal) == sizeof(int32_t),
+              "ERROR_ClauseArena_word_size_mismatch");
+
+SatClause* ClauseArena::Create(absl::Span<const Literal> literals) {
+  const int64_t num_words = NumWords(literals.size());
+  if (current_block_used_ + num_words > current_block_size_) {
+    Reserve(num_words);
+  }
+  int32_t* memory = blocks_.back().get() + current_block_used_;
+  current_block_used_ += num_words;
+  num_used_words_ += num_words;
+  return SatClause::CreateAt(memory, literals);
+}
+
+void ClauseArena::Reserve(int64_t num_words) {
+  if (current_block_used_ + num_words <= current_block_size_) return;
+  current_block_size_ = std::max(num_words, kMinBlockSize);
+  current_block_used_ = 0;
+  blocks_.push_back(std::make_unique<int32_t[]>(current_block_size_));
+}
+
+void ClauseArena::Clear() {
+  blocks_.clear();
+  current_block_size_ = 0;
+  current_block_used_ = 0;
+  num_used_words_ = 0;
+}
+
 // Note that for an attached clause, removing fixed literal is okay because if
 // any of the watched literal is assigned, then the clause is necessarily true.
 bool SatClause::RemoveFixedLiteralsAndTestIfTrue(
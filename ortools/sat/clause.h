@@ -20,6 +20,7 @@
 #include <cstdint>
 #include <deque>
 #include <functional>
+#include <memory>
 #include <string>
 #include <utility>
 #include <vector>
@@ -116,6 +117,11 @@ class SatClause {
   // The manager needs to permute the order of literals in the clause and
   // call Clear()/Rewrite.
   friend class ClauseManager;
+  friend class ClauseArena;
+
+  // Initializes a clause in the given memory which must be large enough to
+  // hold literals.size() literals.
+  static SatClause* CreateAt(void* memory, absl::Span<const Literal> literals);
 
   Literal* literals() { return &(literals_[0]); }
 
@@ -138,6 +144,49 @@ class SatClause {
   Literal literals_[0];
 };
 
+// Owns the memory of the SatClause of a ClauseManager when
+// SatParameters::use_clause_arena() is true. Clauses are allocated one after
+// the other in a few large blocks, so that clauses created together are close
+// in memory. The memory of a clause is never freed individually, it is only
+// reclaimed when the whole arena is cleared. See
+// ClauseManager::CompactClauseArenaIfNeeded().
+class ClauseArena {
+ public:
+  ClauseArena() = default;
+
+  // This type is movable but not copyable.
+  ClauseArena(const ClauseArena&) = delete;
+  ClauseArena& operator=(const ClauseArena&) = delete;
+  ClauseArena(ClauseArena&&) = default;
+  ClauseArena& operator=(ClauseArena&&) = default;
+
+  // Returns a new clause with the given literals. Its memory is owned by the
+  // arena and must not be deleted.
+  SatClause* Create(absl::Span<const Literal> literals);
+
+  // Makes sure the next clauses for a total of num_words words are allocated
+  // in the same block.
+  void Reserve(int64_t num_words);
+
+  // Releases all the memory. All the clauses created so far become invalid.
+  void Clear();
+
+  // The number of words used to store a clause of the given size.
+  static int64_t NumWords(int num_literals) { return 1 + num_literals; }
+
+  // The number of words used by all the clauses created since the last
+  // Clear(), including the ones that are now removed.
+  int64_t num_used_words() const { return num_used_words_; }
+
+ private:
+  static constexpr int64_t kMinBlockSize = 1 << 16;
+
+  std::vector<std::unique_ptr<int32_t[]>> blocks_;
+  int64_t current_block_size_ = 0;
+  int64_t current_block_used_ = 0;
+  int64_t num_used_words_ = 0;
+};
+
 // Clause information used for the clause database management. Note that only
 // the clauses that can be removed have an info. The problem clauses and
 // the learned one that we wants to keep forever do not have one.
@@ -210,6 +259,15 @@ class ClauseManager : public SatPropagator {
   // zero) and remove them from AllClausesInCreationOrder() this work in
   // O(num_clauses()).
   void DeleteRemovedClauses();
+
+  // When the clauses are stored in a ClauseArena, moves all the clauses into
+  // a new contiguous arena if more than half of the current one is wasted by
+  // removed clauses. The clauses keep their creation order, and all the
+  // internal pointers (watchers, reasons, clauses info) are updated. This
+  // must be called right after DeleteRemovedClauses() and invalidates all the
+  // SatClause* held outside this class.
+  void CompactClauseArenaIfNeeded();
+
   int64_t num_clauses() const { return clauses_.size(); }
   const std::vector<SatClause*>& AllClausesInCreationOrder() const {
     return clauses_;
@@ -301,6 +359,20 @@ class ClauseManager : public SatPropagator {
     Watcher(SatClause* c, Literal b, int i = 2)
         : blocking_literal(b), start_index(i), clause(c) {}
 
+    // Watcher for a clause of size 3. Since such a clause only has one non
+    // watched literal, start_index is useless and we use it to store the
+    // literal of the clause that is neither the watched one nor the blocking
+    // one. It is stored as ~index to distinguish the two kind of watchers.
+    // This way PropagateOnFalse() only need to look at the clause memory when
+    // it must propagate or move the watch.
+    static Watcher Ternary(SatClause* c, Literal b, Literal other) {
+      return Watcher(c, b, ~other.Index().value());
+    }
+    bool IsTernary() const { return start_index < 0; }
+    Literal TernaryLiteral() const {
+      return Literal(LiteralIndex(~start_index));
+    }
+
     // Optimization. A literal from the clause that sometimes allow to not even
     // look at the clause memory when true.
     Literal blocking_literal;
@@ -314,6 +386,8 @@ class ClauseManager : public SatPropagator {
     // Note that ideally, this should be part of a SatClause, so it can be
     // shared across watchers. However, since we have 32 bits for "free" here
     // because of the struct alignment, we store it here instead.
+    //
+    // This is negative for the watchers created by Ternary().
     int32_t start_index;
 
     SatClause* clause;
@@ -336,13 +410,18 @@ class ClauseManager : public SatPropagator {
 
   // Attaches the given clause to the event: the given literal becomes false.
   // The blocking_literal can be any literal from the clause, it is used to
-  // speed up PropagateOnFalse() by skipping the clause if it is true.
+  // speed up PropagateOnFalse() by skipping the clause if it is true. Clauses
+  // of size 3 get a Watcher::Ternary().
   void AttachOnFalse(Literal literal, Literal blocking_literal,
                      SatClause* clause);
 
   // Common code between LazyDetach() and Detach().
   void InternalDetach(SatClause* clause);
 
+  // Creates a new clause and appends it to clauses_. Depending on the
+  // parameters, the memory comes from the heap or from clause_arena_.
+  SatClause* NewClause(absl::Span<const Literal> literals);
+
   absl::StrongVector<LiteralIndex, std::vector<Watcher>> watchers_on_false_;
 
   // SatClause reasons by trail_index.
@@ -355,6 +434,7 @@ class ClauseManager : public SatPropagator {
 
   BinaryImplicationGraph* implication_graph_;
   Trail* trail_;
+  const SatParameters& parameters_;
 
   int64_t num_inspected_clauses_;
   int64_t num_inspected_clause_literals_;
@@ -369,7 +449,12 @@ class ClauseManager : public SatPropagator {
   // can't be used with some STL algorithms like std::partition.
   //
   // Note that the unit clauses and binary clause are not kept here.
+  //
+  // If use_clause_arena_ is true, the memory is owned by clause_arena_
+  // instead. This can only change when there is no clauses.
   std::vector<SatClause*> clauses_;
+  bool use_clause_arena_ = false;
+  ClauseArena clause_arena_;
 
   int to_minimize_index_ = 0;
   int to_probe_index_ = 0;
@@ -84,6 +84,8 @@ bool LiteralValue(int lit, absl::Span<const int64_t> solution) {
 
 int LinearIncrementalEvaluator::NewConstraint(Domain domain) {
   DCHECK(creation_phase_);
+  domain_bounds_.push_back(
+      {domain.Min(), domain.Max(), domain.NumIntervals() > 1});
   domains_.push_back(domain);
   offsets_.push_back(0);
   activities_.push_back(0);
@@ -95,6 +97,7 @@ int LinearIncrementalEvaluator::NewConstraint(Domain domain) {
 
 void LinearIncrementalEvaluator::AddEnforcementLiteral(int ct_index, int lit) {
   DCHECK(creation_phase_);
+  if (view_ != nullptr) return;
   const int var = PositiveRef(lit);
   if (literal_entries_.size() <= var) {
     literal_entries_.resize(var + 1);
@@ -118,6 +121,11 @@ void LinearIncrementalEvaluator::AddTerm(int ct_index, int var, int64_t coeff,
   DCHECK(creation_phase_);
   DCHECK_GE(var, 0);
   if (coeff == 0) return;
+  if (view_ != nullptr) {
+    // Only the offset is not part of the shared view.
+    AddOffset(ct_index, offset);
+    return;
+  }
 
   if (var_entries_.size() <= var) {
     var_entries_.resize(var + 1);
@@ -166,36 +174,36 @@ void LinearIncrementalEvaluator::ComputeInitialActivities(
 
   // Resets the activity as the offset and the number of false enforcement to 0.
   activities_ = offsets_;
-  in_last_affected_variables_.resize(columns_.size(), false);
+  in_last_affected_variables_.resize(view_->columns.size(), false);
   num_false_enforcement_.assign(num_constraints_, 0);
 
   // Update these numbers for all columns.
-  for (int var = 0; var < columns_.size(); ++var) {
-    const SpanData& data = columns_[var];
+  for (int var = 0; var < view_->columns.size(); ++var) {
+    const SpanData& data = view_->columns[var];
     const int64_t value = solution[var];
 
     int i = data.start;
     for (int k = 0; k < data.num_pos_literal; ++k, ++i) {
-      const int c = ct_buffer_[i];
+      const int c = view_->ct_buffer[i];
       if (value == 0) num_false_enforcement_[c]++;
     }
     for (int k = 0; k < data.num_neg_literal; ++k, ++i) {
-      const int c = ct_buffer_[i];
+      const int c = view_->ct_buffer[i];
       if (value == 1) num_false_enforcement_[c]++;
     }
 
     if (value == 0) continue;
     int j = data.linear_start;
     for (int k = 0; k < data.num_linear_entries; ++k, ++i, ++j) {
-      const int c = ct_buffer_[i];
-      const int64_t coeff = coeff_buffer_[j];
+      const int c = view_->ct_buffer[i];
+      const int64_t coeff = view_->coeff_buffer[j];
       activities_[c] += coeff * value;
     }
   }
 
   // Cache violations (not counting enforcement).
   for (int c = 0; c < num_constraints_; ++c) {
-    distances_[c] = domains_[c].Distance(activities_[c]);
+    distances_[c] = DistanceToDomain(c, activities_[c]);
     is_violated_[c] = Violation(c) > 0;
   }
 }
@@ -206,12 +214,12 @@ void LinearIncrementalEvaluator::Update(
     std::vector<std::pair<int, int64_t>>* violation_deltas) {
   DCHECK(!creation_phase_);
   DCHECK_NE(delta, 0);
-  if (var >= columns_.size()) return;
+  if (var >= view_->columns.size()) return;
 
-  const SpanData& data = columns_[var];
+  const SpanData& data = view_->columns[var];
   int i = data.start;
   for (int k = 0; k < data.num_pos_literal; ++k, ++i) {
-    const int c = ct_buffer_[i];
+    const int c = view_->ct_buffer[i];
     const int64_t v0 = Violation(c);
     if (delta == 1) {
       num_false_enforcement_[c]--;
@@ -226,7 +234,7 @@ void LinearIncrementalEvaluator::Update(
     }
   }
   for (int k = 0; k < data.num_neg_literal; ++k, ++i) {
-    const int c = ct_buffer_[i];
+    const int c = view_->ct_buffer[i];
     const int64_t v0 = Violation(c);
     if (delta == -1) {
       num_false_enforcement_[c]--;
@@ -242,11 +250,11 @@ void LinearIncrementalEvaluator::Update(
   }
   int j = data.linear_start;
   for (int k = 0; k < data.num_linear_entries; ++k, ++i, ++j) {
-    const int c = ct_buffer_[i];
+    const int c = view_->ct_buffer[i];
     const int64_t v0 = Violation(c);
-    const int64_t coeff = coeff_buffer_[j];
+    const int64_t coeff = view_->coeff_buffer[j];
     activities_[c] += coeff * delta;
-    distances_[c] = domains_[c].Distance(activities_[c]);
+    distances_[c] = DistanceToDomain(c, activities_[c]);
     const int64_t v1 = Violation(c);
     is_violated_[c] = v1 > 0;
     if (violation_deltas != nullptr) {
@@ -256,7 +264,7 @@ void LinearIncrementalEvaluator::Update(
 }
 
 void LinearIncrementalEvaluator::ClearAffectedVariables() {
-  in_last_affected_variables_.resize(columns_.size(), false);
+  in_last_affected_variables_.resize(view_->columns.size(), false);
   for (const int var : last_affected_variables_) {
     in_last_affected_variables_[var] = false;
   }
@@ -272,10 +280,10 @@ void LinearIncrementalEvaluator::ClearAffectedVariables() {
 void LinearIncrementalEvaluator::UpdateScoreOnWeightUpdate(
     int c, absl::Span<const int64_t> jump_deltas,
     absl::Span<double> var_to_score_change) {
-  if (c >= rows_.size()) return;
+  if (c >= view_->rows.size()) return;
 
   DCHECK_EQ(num_false_enforcement_[c], 0);
-  const SpanData& data = rows_[c];
+  const SpanData& data = view_->rows[c];
 
   // Update enforcement part. Because we only update weight of currently
   // infeasible constraint, all change are 0 -> 1 transition and change by the
@@ -286,7 +294,7 @@ void LinearIncrementalEvaluator::UpdateScoreOnWeightUpdate(
     const int end = data.num_pos_literal + data.num_neg_literal;
     dtime_ += end;
     for (int k = 0; k < end; ++k, ++i) {
-      const int var = row_var_buffer_[i];
+      const int var = view_->row_var_buffer[i];
       if (!in_last_affected_variables_[var]) {
         var_to_score_change[var] = enforcement_change;
         in_last_affected_variables_[var] = true;
@@ -303,10 +311,10 @@ void LinearIncrementalEvaluator::UpdateScoreOnWeightUpdate(
   dtime_ += 2 * data.num_linear_entries;
   const int64_t old_distance = distances_[c];
   for (int k = 0; k < data.num_linear_entries; ++k, ++i, ++j) {
-    const int var = row_var_buffer_[i];
-    const int64_t coeff = row_coeff_buffer_[j];
+    const int var = view_->row_var_buffer[i];
+    const int64_t coeff = view_->row_coeff_buffer[j];
     const int64_t new_distance =
-        domains_[c].Distance(activities_[c] + coeff * jump_deltas[var]);
+        DistanceToDomain(c, activities_[c] + coeff * jump_deltas[var]);
     if (!in_last_affected_variables_[var]) {
       var_to_score_change[var] =
           static_cast<double>(new_distance - old_distance);
@@ -322,7 +330,7 @@ void LinearIncrementalEvaluator::UpdateScoreOnWeightUpdate(
 void LinearIncrementalEvaluator::UpdateScoreOnNewlyEnforced(
     int c, double weight, absl::Span<const int64_t> jump_deltas,
     absl::Span<double> jump_scores) {
-  const SpanData& data = rows_[c];
+  const SpanData& data = view_->rows[c];
 
   // Everyone else had a zero cost transition that now become enforced ->
   // unenforced. So they all have better score.
@@ -333,7 +341,7 @@ void LinearIncrementalEvaluator::UpdateScoreOnNewlyEnforced(
     const int end = data.num_pos_literal + data.num_neg_literal;
     dtime_ += end;
     for (int k = 0; k < end; ++k, ++i) {
-      const int var = row_var_buffer_[i];
+      const int var = view_->row_var_buffer[i];
       jump_scores[var] -= weight_time_violation;
       if (!in_last_affected_variables_[var]) {
         in_last_affected_variables_[var] = true;
@@ -349,10 +357,10 @@ void LinearIncrementalEvaluator::UpdateScoreOnNewlyEnforced(
     dtime_ += 2 * data.num_linear_entries;
     const int64_t old_distance = distances_[c];
     for (int k = 0; k < data.num_linear_entries; ++k, ++i, ++j) {
-      const int var = row_var_buffer_[i];
-      const int64_t coeff = row_coeff_buffer_[j];
+      const int var = view_->row_var_buffer[i];
+      const int64_t coeff = view_->row_coeff_buffer[j];
       const int64_t new_distance =
-          domains_[c].Distance(activities_[c] + coeff * jump_deltas[var]);
+          DistanceToDomain(c, activities_[c] + coeff * jump_deltas[var]);
       jump_scores[var] +=
           weight * static_cast<double>(new_distance - old_distance);
       if (!in_last_affected_variables_[var]) {
@@ -366,7 +374,7 @@ void LinearIncrementalEvaluator::UpdateScoreOnNewlyEnforced(
 void LinearIncrementalEvaluator::UpdateScoreOnNewlyUnenforced(
     int c, double weight, absl::Span<const int64_t> jump_deltas,
     absl::Span<double> jump_scores) {
-  const SpanData& data = rows_[c];
+  const SpanData& data = view_->rows[c];
 
   // Everyone else had a enforced -> unenforced transition that now become zero.
   // So they all have worst score, and we don't need to update
@@ -378,7 +386,7 @@ void LinearIncrementalEvaluator::UpdateScoreOnNewlyUnenforced(
     const int end = data.num_pos_literal + data.num_neg_literal;
     dtime_ += end;
     for (int k = 0; k < end; ++k, ++i) {
-      const int var = row_var_buffer_[i];
+      const int var = view_->row_var_buffer[i];
       jump_scores[var] += weight_time_violation;
     }
   }
@@ -390,10 +398,10 @@ void LinearIncrementalEvaluator::UpdateScoreOnNewlyUnenforced(
     dtime_ += 2 * data.num_linear_entries;
     const int64_t old_distance = distances_[c];
     for (int k = 0; k < data.num_linear_entries; ++k, ++i, ++j) {
-      const int var = row_var_buffer_[i];
-      const int64_t coeff = row_coeff_buffer_[j];
+      const int var = view_->row_var_buffer[i];
+      const int64_t coeff = view_->row_coeff_buffer[j];
       const int64_t new_distance =
-          domains_[c].Distance(activities_[c] + coeff * jump_deltas[var]);
+          DistanceToDomain(c, activities_[c] + coeff * jump_deltas[var]);
       jump_scores[var] -=
           weight * static_cast<double>(new_distance - old_distance);
       if (!in_last_affected_variables_[var]) {
@@ -411,11 +419,11 @@ void LinearIncrementalEvaluator::UpdateScoreOfEnforcementIncrease(
     absl::Span<double> jump_scores) {
   if (score_change == 0.0) return;
 
-  const SpanData& data = rows_[c];
+  const SpanData& data = view_->rows[c];
   int i = data.start;
   dtime_ += data.num_pos_literal;
   for (int k = 0; k < data.num_pos_literal; ++k, ++i) {
-    const int var = row_var_buffer_[i];
+    const int var = view_->row_var_buffer[i];
     if (jump_deltas[var] == 1) {
       jump_scores[var] += score_change;
       if (score_change < 0.0 && !in_last_affected_variables_[var]) {
@@ -426,7 +434,7 @@ void LinearIncrementalEvaluator::UpdateScoreOfEnforcementIncrease(
   }
   dtime_ += data.num_neg_literal;
   for (int k = 0; k < data.num_neg_literal; ++k, ++i) {
-    const int var = row_var_buffer_[i];
+    const int var = view_->row_var_buffer[i];
     if (jump_deltas[var] == -1) {
       jump_scores[var] += score_change;
       if (score_change < 0.0 && !in_last_affected_variables_[var]) {
@@ -441,7 +449,7 @@ void LinearIncrementalEvaluator::UpdateScoreOnActivityChange(
     int c, double weight, int64_t activity_delta,
     absl::Span<const int64_t> jump_deltas, absl::Span<double> jump_scores) {
   if (activity_delta == 0) return;
-  const SpanData& data = rows_[c];
+  const SpanData& data = view_->rows[c];
 
   // In some cases, we can know that the score of all the involved variable
   // will not change. This is the case if whatever 1 variable change the
@@ -457,27 +465,32 @@ void LinearIncrementalEvaluator::UpdateScoreOnActivityChange(
   int64_t min_range;
   int64_t max_range;
   if (new_activity > old_activity) {
-    min_range = old_activity - row_max_variations_[c];
-    max_range = new_activity + row_max_variations_[c];
+    min_range = old_activity - view_->row_max_variations[c];
+    max_range = new_activity + view_->row_max_variations[c];
   } else {
-    min_range = new_activity - row_max_variations_[c];
-    max_range = old_activity + row_max_variations_[c];
+    min_range = new_activity - view_->row_max_variations[c];
+    max_range = old_activity + view_->row_max_variations[c];
   }
 
   // If the violation delta was zero and will still always be zero, we can skip.
-  if (Domain(min_range, max_range).IsIncludedIn(domains_[c])) return;
+  const DomainBounds& bounds = domain_bounds_[c];
+  if (bounds.has_holes) {
+    if (Domain(min_range, max_range).IsIncludedIn(domains_[c])) return;
+  } else if (min_range >= bounds.min && max_range <= bounds.max) {
+    return;
+  }
 
   // Enforcement is always enforced -> un-enforced.
   // So it was -weight_time_distance and is now -weight_time_new_distance.
   const double delta =
       -weight *
-      static_cast<double>(domains_[c].Distance(new_activity) - distances_[c]);
+      static_cast<double>(DistanceToDomain(c, new_activity) - distances_[c]);
   if (delta != 0.0) {
     int i = data.start;
     const int end = data.num_pos_literal + data.num_neg_literal;
     dtime_ += end;
     for (int k = 0; k < end; ++k, ++i) {
-      const int var = row_var_buffer_[i];
+      const int var = view_->row_var_buffer[i];
       jump_scores[var] += delta;
       if (delta < 0.0 && !in_last_affected_variables_[var]) {
         in_last_affected_variables_[var] = true;
@@ -489,21 +502,20 @@ void LinearIncrementalEvaluator::UpdateScoreOnActivityChange(
   // If we are infeasible and no move can correct it, both old_b - old_a and
   // new_b - new_a will have the same value. We only needed to update the
   // violation of the enforced literal.
-  if (min_range >= domains_[c].Max() || max_range <= domains_[c].Min()) return;
+  if (min_range >= bounds.max || max_range <= bounds.min) return;
 
   // Update linear part.
   {
     int i = data.start + data.num_pos_literal + data.num_neg_literal;
     int j = data.linear_start;
     dtime_ += 2 * data.num_linear_entries;
-    const Domain& rhs = domains_[c];
     const int64_t old_a_minus_new_a =
-        distances_[c] - rhs.Distance(new_activity);
+        distances_[c] - DistanceToDomain(c, new_activity);
     for (int k = 0; k < data.num_linear_entries; ++k, ++i, ++j) {
-      const int var = row_var_buffer_[i];
-      const int64_t impact = row_coeff_buffer_[j] * jump_deltas[var];
-      const int64_t old_b = rhs.Distance(old_activity + impact);
-      const int64_t new_b = rhs.Distance(new_activity + impact);
+      const int var = view_->row_var_buffer[i];
+      const int64_t impact = view_->row_coeff_buffer[j] * jump_deltas[var];
+      const int64_t old_b = DistanceToDomain(c, old_activity + impact);
+      const int64_t new_b = DistanceToDomain(c, new_activity + impact);
 
       // The old score was:
       //   weight * static_cast<double>(old_b - old_a);
@@ -529,12 +541,12 @@ void LinearIncrementalEvaluator::UpdateVariableAndScores(
     std::vector<std::pair<int, int64_t>>* violation_deltas) {
   DCHECK(!creation_phase_);
   DCHECK_NE(delta, 0);
-  if (var >= columns_.size()) return;
+  if (var >= view_->columns.size()) return;
 
-  const SpanData& data = columns_[var];
+  const SpanData& data = view_->columns[var];
   int i = data.start;
   for (int k = 0; k < data.num_pos_literal; ++k, ++i) {
-    const int c = ct_buffer_[i];
+    const int c = view_->ct_buffer[i];
     const int64_t v0 = Violation(c);
     if (delta == 1) {
       num_false_enforcement_[c]--;
@@ -565,7 +577,7 @@ void LinearIncrementalEvaluator::UpdateVariableAndScores(
     }
   }
   for (int k = 0; k < data.num_neg_literal; ++k, ++i) {
-    const int c = ct_buffer_[i];
+    const int c = view_->ct_buffer[i];
     const int64_t v0 = Violation(c);
     if (delta == -1) {
       num_false_enforcement_[c]--;
@@ -597,16 +609,16 @@ void LinearIncrementalEvaluator::UpdateVariableAndScores(
   }
   int j = data.linear_start;
   for (int k = 0; k < data.num_linear_entries; ++k, ++i, ++j) {
-    const int c = ct_buffer_[i];
+    const int c = view_->ct_buffer[i];
     const int64_t v0 = Violation(c);
-    const int64_t coeff = coeff_buffer_[j];
+    const int64_t coeff = view_->coeff_buffer[j];
 
     if (num_false_enforcement_[c] == 1) {
       // Only the 1 -> 0 are impacted.
       // This is the same as the 1->2 transition, but the old 1->0 needs to
       // be changed from - weight * distance to - weight * new_distance.
       const int64_t new_distance =
-          domains_[c].Distance(activities_[c] + coeff * delta);
+          DistanceToDomain(c, activities_[c] + coeff * delta);
       if (new_distance != distances_[c]) {
         UpdateScoreOfEnforcementIncrease(
             c, -weights[c] * static_cast<double>(distances_[c] - new_distance),
@@ -618,7 +630,7 @@ void LinearIncrementalEvaluator::UpdateVariableAndScores(
     }
 
     activities_[c] += coeff * delta;
-    distances_[c] = domains_[c].Distance(activities_[c]);
+    distances_[c] = DistanceToDomain(c, activities_[c]);
     const int64_t v1 = Violation(c);
     is_violated_[c] = v1 > 0;
     if (violation_deltas != nullptr) {
@@ -643,7 +655,9 @@ bool LinearIncrementalEvaluator::IsViolated(int c) const {
 bool LinearIncrementalEvaluator::ReduceBounds(int c, int64_t lb, int64_t ub) {
   if (domains_[c].Min() >= lb && domains_[c].Max() <= ub) return false;
   domains_[c] = domains_[c].IntersectionWith(Domain(lb, ub));
-  distances_[c] = domains_[c].Distance(activities_[c]);
+  domain_bounds_[c] = {domains_[c].Min(), domains_[c].Max(),
+                       domains_[c].NumIntervals() > 1};
+  distances_[c] = DistanceToDomain(c, activities_[c]);
   return true;
 }
 
@@ -666,14 +680,14 @@ double LinearIncrementalEvaluator::WeightedViolation(
 double LinearIncrementalEvaluator::WeightedViolationDelta(
     absl::Span<const double> weights, int var, int64_t delta) const {
   DCHECK_NE(delta, 0);
-  if (var >= columns_.size()) return 0.0;
-  const SpanData& data = columns_[var];
+  if (var >= view_->columns.size()) return 0.0;
+  const SpanData& data = view_->columns[var];
 
   int i = data.start;
   double result = 0.0;
   dtime_ += data.num_pos_literal;
   for (int k = 0; k < data.num_pos_literal; ++k, ++i) {
-    const int c = ct_buffer_[i];
+    const int c = view_->ct_buffer[i];
     if (num_false_enforcement_[c] == 0) {
       // Since delta != 0, we are sure this is an enforced -> unenforced change.
       DCHECK_EQ(delta, -1);
@@ -687,7 +701,7 @@ double LinearIncrementalEvaluator::WeightedViolationDelta(
 
   dtime_ += data.num_neg_literal;
   for (int k = 0; k < data.num_neg_literal; ++k, ++i) {
-    const int c = ct_buffer_[i];
+    const int c = view_->ct_buffer[i];
     if (num_false_enforcement_[c] == 0) {
       // Since delta != 0, we are sure this is an enforced -> unenforced change.
       DCHECK_EQ(delta, 1);
@@ -702,12 +716,12 @@ double LinearIncrementalEvaluator::WeightedViolationDelta(
   int j = data.linear_start;
   dtime_ += 2 * data.num_linear_entries;
   for (int k = 0; k < data.num_linear_entries; ++k, ++i, ++j) {
-    const int c = ct_buffer_[i];
+    const int c = view_->ct_buffer[i];
     if (num_false_enforcement_[c] > 0) continue;
-    const int64_t coeff = coeff_buffer_[j];
+    const int64_t coeff = view_->coeff_buffer[j];
     const int64_t old_distance = distances_[c];
     const int64_t new_distance =
-        domains_[c].Distance(activities_[c] + coeff * delta);
+        DistanceToDomain(c, activities_[c] + coeff * delta);
     result += weights[c] * static_cast<double>(new_distance - old_distance);
   }
 
@@ -715,7 +729,7 @@ double LinearIncrementalEvaluator::WeightedViolationDelta(
 }
 
 bool LinearIncrementalEvaluator::AppearsInViolatedConstraints(int var) const {
-  if (var >= columns_.size()) return false;
+  if (var >= view_->columns.size()) return false;
   for (const int c : VarToConstraints(var)) {
     if (Violation(c) > 0) return true;
   }
@@ -725,23 +739,23 @@ bool LinearIncrementalEvaluator::AppearsInViolatedConstraints(int var) const {
 std::vector<int64_t> LinearIncrementalEvaluator::SlopeBreakpoints(
     int var, int64_t current_value, const Domain& var_domain) const {
   std::vector<int64_t> result = var_domain.FlattenedIntervals();
-  if (var_domain.Size() <= 2 || var >= columns_.size()) return result;
+  if (var_domain.Size() <= 2 || var >= view_->columns.size()) return result;
 
-  const SpanData& data = columns_[var];
+  const SpanData& data = view_->columns[var];
   int i = data.start + data.num_pos_literal + data.num_neg_literal;
   int j = data.linear_start;
   for (int k = 0; k < data.num_linear_entries; ++k, ++i, ++j) {
-    const int c = ct_buffer_[i];
+    const int c = view_->ct_buffer[i];
     if (num_false_enforcement_[c] > 0) continue;
 
     // We only consider min / max.
     // There is a change when we cross the slack.
     // TODO(user): Deal with holes?
-    const int64_t coeff = coeff_buffer_[j];
+    const int64_t coeff = view_->coeff_buffer[j];
     const int64_t activity = activities_[c] - current_value * coeff;
 
-    const int64_t slack_min = CapSub(domains_[c].Min(), activity);
-    const int64_t slack_max = CapSub(domains_[c].Max(), activity);
+    const int64_t slack_min = CapSub(domain_bounds_[c].min, activity);
+    const int64_t slack_max = CapSub(domain_bounds_[c].max, activity);
     if (slack_min != std::numeric_limits<int64_t>::min()) {
       const int64_t ceil_bp = CeilOfRatio(slack_min, coeff);
       if (ceil_bp != result.back() && var_domain.Contains(ceil_bp)) {
@@ -772,7 +786,21 @@ std::vector<int64_t> LinearIncrementalEvaluator::SlopeBreakpoints(
 void LinearIncrementalEvaluator::PrecomputeCompactView(
     absl::Span<const int64_t> var_max_variation) {
   creation_phase_ = false;
-  if (num_constraints_ == 0) return;
+  if (view_ != nullptr) {
+    // The view was computed by another evaluator, we just need to initialize
+    // the dynamic data.
+    DCHECK_EQ(view_->rows.size(), num_constraints_);
+    cached_deltas_.assign(view_->columns.size(), 0);
+    cached_scores_.assign(view_->columns.size(), 0);
+    return;
+  }
+
+  auto shared_view = std::make_shared<CompactView>();
+  CompactView& view = *shared_view;
+  if (num_constraints_ == 0) {
+    view_ = std::move(shared_view);
+    return;
+  }
 
   // Compute the total size.
   // Note that at this point the constraint indices are not "encoded" yet.
@@ -794,7 +822,7 @@ void LinearIncrementalEvaluator::PrecomputeCompactView(
     }
   }
 
-  row_max_variations_.assign(num_constraints_, 0);
+  view.row_max_variations.assign(num_constraints_, 0);
   for (int var = 0; var < var_entries_.size(); ++var) {
     const int64_t range = var_max_variation[var];
     const auto& column = var_entries_[var];
@@ -803,37 +831,37 @@ void LinearIncrementalEvaluator::PrecomputeCompactView(
     for (const auto [c, coeff] : column) {
       tmp_row_sizes_[c]++;
       tmp_row_num_linear_entries_[c]++;
-      row_max_variations_[c] =
-          std::max(row_max_variations_[c], range * std::abs(coeff));
+      view.row_max_variations[c] =
+          std::max(view.row_max_variations[c], range * std::abs(coeff));
     }
   }
 
   // Compactify for faster WeightedViolationDelta().
-  ct_buffer_.reserve(total_size);
-  coeff_buffer_.reserve(total_linear_size);
-  columns_.resize(std::max(literal_entries_.size(), var_entries_.size()));
-  for (int var = 0; var < columns_.size(); ++var) {
-    columns_[var].start = static_cast<int>(ct_buffer_.size());
-    columns_[var].linear_start = static_cast<int>(coeff_buffer_.size());
+  view.ct_buffer.reserve(total_size);
+  view.coeff_buffer.reserve(total_linear_size);
+  view.columns.resize(std::max(literal_entries_.size(), var_entries_.size()));
+  for (int var = 0; var < view.columns.size(); ++var) {
+    view.columns[var].start = static_cast<int>(view.ct_buffer.size());
+    view.columns[var].linear_start = static_cast<int>(view.coeff_buffer.size());
     if (var < literal_entries_.size()) {
       for (const auto [c, is_positive] : literal_entries_[var]) {
         if (is_positive) {
-          columns_[var].num_pos_literal++;
-          ct_buffer_.push_back(c);
+          view.columns[var].num_pos_literal++;
+          view.ct_buffer.push_back(c);
         }
       }
       for (const auto [c, is_positive] : literal_entries_[var]) {
         if (!is_positive) {
-          columns_[var].num_neg_literal++;
-          ct_buffer_.push_back(c);
+          view.columns[var].num_neg_literal++;
+          view.ct_buffer.push_back(c);
         }
       }
     }
     if (var < var_entries_.size()) {
       for (const auto [c, coeff] : var_entries_[var]) {
-        columns_[var].num_linear_entries++;
-        ct_buffer_.push_back(c);
-        coeff_buffer_.push_back(coeff);
+        view.columns[var].num_linear_entries++;
+        view.ct_buffer.push_back(c);
+        view.coeff_buffer.push_back(coeff);
       }
     }
   }
@@ -846,59 +874,67 @@ void LinearIncrementalEvaluator::PrecomputeCompactView(
   gtl::STLClearObject(&literal_entries_);
 
   // Initialize the SpanData.
-  // Transform tmp_row_sizes_ to starts in the row_var_buffer_.
-  // Transform tmp_row_num_linear_entries_ to starts in the row_coeff_buffer_.
+  // Transform tmp_row_sizes_ to starts in the view.row_var_buffer.
+  // Transform tmp_row_num_linear_entries_ to starts in the view.row_coeff_buffer.
   int offset = 0;
   int linear_offset = 0;
-  rows_.resize(num_constraints_);
+  view.rows.resize(num_constraints_);
   for (int c = 0; c < num_constraints_; ++c) {
-    rows_[c].num_pos_literal = tmp_row_num_positive_literals_[c];
-    rows_[c].num_neg_literal = tmp_row_num_negative_literals_[c];
-    rows_[c].num_linear_entries = tmp_row_num_linear_entries_[c];
+    view.rows[c].num_pos_literal = tmp_row_num_positive_literals_[c];
+    view.rows[c].num_neg_literal = tmp_row_num_negative_literals_[c];
+    view.rows[c].num_linear_entries = tmp_row_num_linear_entries_[c];
 
-    rows_[c].start = offset;
+    view.rows[c].start = offset;
     offset += tmp_row_sizes_[c];
-    tmp_row_sizes_[c] = rows_[c].start;
+    tmp_row_sizes_[c] = view.rows[c].start;
 
-    rows_[c].linear_start = linear_offset;
+    view.rows[c].linear_start = linear_offset;
     linear_offset += tmp_row_num_linear_entries_[c];
-    tmp_row_num_linear_entries_[c] = rows_[c].linear_start;
+    tmp_row_num_linear_entries_[c] = view.rows[c].linear_start;
   }
   DCHECK_EQ(offset, total_size);
   DCHECK_EQ(linear_offset, total_linear_size);
 
   // Copy data.
-  row_var_buffer_.resize(total_size);
-  row_coeff_buffer_.resize(total_linear_size);
-  for (int var = 0; var < columns_.size(); ++var) {
-    const SpanData& data = columns_[var];
+  view.row_var_buffer.resize(total_size);
+  view.row_coeff_buffer.resize(total_linear_size);
+  for (int var = 0; var < view.columns.size(); ++var) {
+    const SpanData& data = view.columns[var];
     int i = data.start;
     for (int k = 0; k < data.num_pos_literal; ++i, ++k) {
-      const int c = ct_buffer_[i];
-      row_var_buffer_[tmp_row_sizes_[c]++] = var;
+      const int c = view.ct_buffer[i];
+      view.row_var_buffer[tmp_row_sizes_[c]++] = var;
     }
   }
-  for (int var = 0; var < columns_.size(); ++var) {
-    const SpanData& data = columns_[var];
+  for (int var = 0; var < view.columns.size(); ++var) {
+    const SpanData& data = view.columns[var];
     int i = data.start + data.num_pos_literal;
     for (int k = 0; k < data.num_neg_literal; ++i, ++k) {
-      const int c = ct_buffer_[i];
-      row_var_buffer_[tmp_row_sizes_[c]++] = var;
+      const int c = view.ct_buffer[i];
+      view.row_var_buffer[tmp_row_sizes_[c]++] = var;
     }
   }
-  for (int var = 0; var < columns_.size(); ++var) {
-    const SpanData& data = columns_[var];
+  for (int var = 0; var < view.columns.size(); ++var) {
+    const SpanData& data = view.columns[var];
     int i = data.start + data.num_pos_literal + data.num_neg_literal;
     int j = data.linear_start;
     for (int k = 0; k < data.num_linear_entries; ++i, ++j, ++k) {
-      const int c = ct_buffer_[i];
-      row_var_buffer_[tmp_row_sizes_[c]++] = var;
-      row_coeff_buffer_[tmp_row_num_linear_entries_[c]++] = coeff_buffer_[j];
+      const int c = view.ct_buffer[i];
+      view.row_var_buffer[tmp_row_sizes_[c]++] = var;
+      view.row_coeff_buffer[tmp_row_num_linear_entries_[c]++] = view.coeff_buffer[j];
     }
   }
 
-  cached_deltas_.assign(columns_.size(), 0);
-  cached_scores_.assign(columns_.size(), 0);
+  cached_deltas_.assign(view.columns.size(), 0);
+  cached_scores_.assign(view.columns.size(), 0);
+  view_ = std::move(shared_view);
+}
+
+void LinearIncrementalEvaluator::UseSharedCompactView(
+    std::shared_ptr<const CompactView> view) {
+  DCHECK(creation_phase_);
+  DCHECK_EQ(num_constraints_, 0);
+  view_ = std::move(view);
 }
 
 bool LinearIncrementalEvaluator::ViolationChangeIsConvex(int var) const {
@@ -1381,9 +1417,13 @@ void AddCircuitFlowConstraints(LinearIncrementalEvaluator& linear_evaluator,
 
 // ----- LsEvaluator -----
 
-LsEvaluator::LsEvaluator(const CpModelProto& cp_model,
-                         const SatParameters& params)
+LsEvaluator::LsEvaluator(
+    const CpModelProto& cp_model, const SatParameters& params,
+    std::shared_ptr<const LinearIncrementalEvaluator::CompactView> linear_view)
     : cp_model_(cp_model), params_(params) {
+  if (linear_view != nullptr) {
+    linear_evaluator_.UseSharedCompactView(std::move(linear_view));
+  }
   var_to_constraints_.resize(cp_model_.variables_size());
   jump_value_optimal_.resize(cp_model_.variables_size(), true);
   num_violated_constraint_per_var_.assign(cp_model_.variables_size(), 0);
@@ -1398,8 +1438,12 @@ LsEvaluator::LsEvaluator(const CpModelProto& cp_model,
 LsEvaluator::LsEvaluator(
     const CpModelProto& cp_model, const SatParameters& params,
     const std::vector<bool>& ignored_constraints,
-    const std::vector<ConstraintProto>& additional_constraints)
+    const std::vector<ConstraintProto>& additional_constraints,
+    std::shared_ptr<const LinearIncrementalEvaluator::CompactView> linear_view)
     : cp_model_(cp_model), params_(params) {
+  if (linear_view != nullptr) {
+    linear_evaluator_.UseSharedCompactView(std::move(linear_view));
+  }
   var_to_constraints_.resize(cp_model_.variables_size());
   jump_value_optimal_.resize(cp_model_.variables_size(), true);
   num_violated_constraint_per_var_.assign(cp_model_.variables_size(), 0);
@@ -57,6 +57,18 @@ class LinearIncrementalEvaluator {
   // and before the class starts to be used. This is DCHECKed.
   void PrecomputeCompactView(absl::Span<const int64_t> var_max_variation);
 
+  // The immutable part of the evaluator, i.e. the column and row views of the
+  // constraints. It only depends on the constraints and can be shared between
+  // evaluators built from the exact same sequence of calls.
+  //
+  // If UseSharedCompactView() is called before any constraint is added, the
+  // terms and enforcement literals are not stored anymore, and
+  // PrecomputeCompactView() just uses the given view instead of recomputing
+  // it. This saves both memory and initialization time.
+  struct CompactView;
+  std::shared_ptr<const CompactView> compact_view() const { return view_; }
+  void UseSharedCompactView(std::shared_ptr<const CompactView> view);
+
   // Compute activities and update them.
   void ComputeInitialActivities(absl::Span<const int64_t> solution);
   void Update(int var, int64_t delta,
@@ -135,11 +147,11 @@ class LinearIncrementalEvaluator {
   }
 
   absl::Span<const int> ConstraintToVars(int c) const {
-    const SpanData& data = rows_[c];
+    const SpanData& data = view_->rows[c];
     const int size =
         data.num_pos_literal + data.num_neg_literal + data.num_linear_entries;
     if (size == 0) return {};
-    return absl::MakeSpan(&row_var_buffer_[data.start], size);
+    return absl::MakeSpan(&view_->row_var_buffer[data.start], size);
   }
 
  private:
@@ -163,17 +175,50 @@ class LinearIncrementalEvaluator {
     int num_linear_entries = 0;
   };
 
+ public:
+  struct CompactView {
+    // Column based data.
+    std::vector<SpanData> columns;
+    std::vector<int> ct_buffer;
+    std::vector<int64_t> coeff_buffer;
+
+    // Row based data.
+    std::vector<SpanData> rows;
+    std::vector<int> row_var_buffer;
+    std::vector<int64_t> row_coeff_buffer;
+
+    // In order to avoid scanning long constraint we compute for each of them
+    // the maximum activity variation of one variable (max-min) * abs(coeff).
+    // If the current activity plus this is still feasible, then the
+    // constraint do not need to be scanned.
+    std::vector<int64_t> row_max_variations;
+  };
+
+ private:
+
   absl::Span<const int> VarToConstraints(int var) const {
-    if (var >= columns_.size()) return {};
-    const SpanData& data = columns_[var];
+    if (var >= view_->columns.size()) return {};
+    const SpanData& data = view_->columns[var];
     const int size =
         data.num_pos_literal + data.num_neg_literal + data.num_linear_entries;
     if (size == 0) return {};
-    return absl::MakeSpan(&ct_buffer_[data.start], size);
+    return absl::MakeSpan(&view_->ct_buffer[data.start], size);
   }
 
   void ComputeAndCacheDistance(int ct_index);
 
+  // Same as domains_[c].Distance(activity), but without going through the
+  // Domain class in the usual case where the domain is a single interval.
+  // The interval case is branch-free so that the loops in which this is
+  // called can be if-converted by the compiler.
+  int64_t DistanceToDomain(int c, int64_t activity) const {
+    const DomainBounds& bounds = domain_bounds_[c];
+    if (bounds.has_holes) return domains_[c].Distance(activity);
+    const int64_t below = activity < bounds.min ? bounds.min - activity : 0;
+    const int64_t above = activity > bounds.max ? activity - bounds.max : 0;
+    return below + above;
+  }
+
   // Incremental row-based update.
   void UpdateScoreOnNewlyEnforced(int c, double weight,
                                   absl::Span<const int64_t> jump_deltas,
@@ -188,9 +233,17 @@ class LinearIncrementalEvaluator {
                                    absl::Span<const int64_t> jump_deltas,
                                    absl::Span<double> jump_scores);
 
+  // The convex hull of a constraint domain.
+  struct DomainBounds {
+    int64_t min;
+    int64_t max;
+    bool has_holes;
+  };
+
   // Constraint indexed data (static).
   int num_constraints_ = 0;
   std::vector<Domain> domains_;
+  std::vector<DomainBounds> domain_bounds_;
   std::vector<int64_t> offsets_;
 
   // Variable indexed data.
@@ -200,21 +253,9 @@ class LinearIncrementalEvaluator {
   std::vector<std::vector<Entry>> var_entries_;
   std::vector<std::vector<LiteralEntry>> literal_entries_;
 
-  // Memory efficient column based data (static).
-  std::vector<SpanData> columns_;
-  std::vector<int> ct_buffer_;
-  std::vector<int64_t> coeff_buffer_;
-
-  // Memory efficient row based data (static).
-  std::vector<SpanData> rows_;
-  std::vector<int> row_var_buffer_;
-  std::vector<int64_t> row_coeff_buffer_;
-
-  // In order to avoid scanning long constraint we compute for each of them
-  // the maximum activity variation of one variable (max-min) * abs(coeff).
-  // If the current activity plus this is still feasible, then the constraint
-  // do not need to be scanned.
-  std::vector<int64_t> row_max_variations_;
+  // Memory efficient column and row based data (static). This is set by
+  // PrecomputeCompactView() or UseSharedCompactView().
+  std::shared_ptr<const CompactView> view_;
 
   // Temporary data.
   std::vector<int> tmp_row_sizes_;
@@ -287,10 +328,18 @@ class CompiledConstraint {
 class LsEvaluator {
  public:
   // The cp_model must outlive this class.
-  LsEvaluator(const CpModelProto& cp_model, const SatParameters& params);
+  //
+  // If linear_view is not null, it must be the LinearEvaluator().compact_view()
+  // of another LsEvaluator constructed with the same arguments, and it will be
+  // shared instead of being recomputed.
+  LsEvaluator(const CpModelProto& cp_model, const SatParameters& params,
+              std::shared_ptr<const LinearIncrementalEvaluator::CompactView>
+                  linear_view = nullptr);
   LsEvaluator(const CpModelProto& cp_model, const SatParameters& params,
               const std::vector<bool>& ignored_constraints,
-              const std::vector<ConstraintProto>& additional_constraints);
+              const std::vector<ConstraintProto>& additional_constraints,
+              std::shared_ptr<const LinearIncrementalEvaluator::CompactView>
+                  linear_view = nullptr);
 
   // Intersects the domain of the objective with [lb..ub].
   // It returns true if a reduction of the domain took place.
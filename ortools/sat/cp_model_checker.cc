@@ -14,6 +14,7 @@
 #include "ortools/sat/cp_model_checker.h"
 
 #include <algorithm>
+#include <atomic>
 #include <cmath>
 #include <cstdint>
 #include <limits>
@@ -30,6 +31,7 @@
 #include "absl/strings/str_cat.h"
 #include "absl/types/span.h"
 #include "ortools/base/logging.h"
+#include "ortools/base/threadpool.h"
 #include "ortools/port/proto_utils.h"
 #include "ortools/sat/cp_model.pb.h"
 #include "ortools/sat/cp_model_utils.h"
@@ -1665,6 +1667,58 @@ class ConstraintChecker {
   const std::vector<int64_t> variable_values_;
 };
 
+// Below this number of constraints per thread, checking a solution in
+// parallel is not worth its overhead.
+constexpr int kNumConstraintsPerCheckShard = 10000;
+
+// Returns the index of an infeasible constraint of the model, or -1 if all
+// the constraints are feasible. With more than one thread, the constraints are
+// split into shards checked in parallel and we stop at the first infeasible
+// constraint found, which might not be the first one of the model.
+//
+// Note that the checker only reads the solution, so it can be shared.
+int FindInfeasibleConstraint(const CpModelProto& model,
+                             ConstraintChecker* checker, int num_threads) {
+  const int num_constraints = model.constraints_size();
+  const int num_shards =
+      (num_constraints + kNumConstraintsPerCheckShard - 1) /
+      kNumConstraintsPerCheckShard;
+  if (num_threads <= 1 || num_shards <= 1) {
+    for (int c = 0; c < num_constraints; ++c) {
+      if (!checker->ConstraintIsFeasible(model, model.constraints(c))) {
+        return c;
+      }
+    }
+    return -1;
+  }
+
+  std::atomic<int> next_shard = 0;
+  std::atomic<int> infeasible_constraint = -1;
+  {
+    const int num_workers = std::min(num_threads, num_shards);
+    ThreadPool pool("SolutionChecker", num_workers);
+    pool.StartWorkers();
+    for (int i = 0; i < num_workers; ++i) {
+      pool.Schedule([&]() {
+        while (infeasible_constraint.load(std::memory_order_relaxed) == -1) {
+          const int shard = next_shard.fetch_add(1);
+          if (shard >= num_shards) return;
+          const int end = std::min(num_constraints,
+                                   (shard + 1) * kNumConstraintsPerCheckShard);
+          for (int c = shard * kNumConstraintsPerCheckShard; c < end; ++c) {
+            if (!checker->ConstraintIsFeasible(model, model.constraints(c))) {
+              int expected = -1;
+              infeasible_constraint.compare_exchange_strong(expected, c);
+              return;
+            }
+          }
+        }
+      });
+    }
+  }
+  return infeasible_constraint.load();
+}
+
 }  // namespace
 
 bool ConstraintIsFeasible(const CpModelProto& model,
@@ -1677,7 +1731,8 @@ bool ConstraintIsFeasible(const CpModelProto& model,
 bool SolutionIsFeasible(const CpModelProto& model,
                         absl::Span<const int64_t> variable_values,
                         const CpModelProto* mapping_proto,
-                        const std::vector<int>* postsolve_mapping) {
+                        const std::vector<int>* postsolve_mapping,
+                        int num_threads) {
   if (variable_values.size() != model.variables_size()) {
     VLOG(1) << "Wrong number of variables (" << variable_values.size()
             << ") in the solution vector. It should be "
@@ -1698,10 +1753,8 @@ bool SolutionIsFeasible(const CpModelProto& model,
   CHECK_EQ(variable_values.size(), model.variables_size());
   ConstraintChecker checker(variable_values);
 
-  for (int c = 0; c < model.constraints_size(); ++c) {
-    const ConstraintProto& ct = model.constraints(c);
-    if (checker.ConstraintIsFeasible(model, ct)) continue;
-
+  const int c = FindInfeasibleConstraint(model, &checker, num_threads);
+  if (c >= 0) {
     // Display a message to help debugging.
     VLOG(1) << "Failing constraint #" << c << " : "
             << ProtobufShortDebugString(model.constraints(c));
@@ -60,12 +60,14 @@ bool PossibleIntegerOverflow(const CpModelProto& model,
 // given model. The values vector should be in one to one correspondence with
 // the model.variables() list of variables.
 //
-// The last two arguments are optional and help debugging a failing constraint
-// due to presolve.
+// The mapping arguments are optional and help debugging a failing constraint
+// due to presolve. If num_threads > 1, the constraints of large models are
+// checked in parallel.
 bool SolutionIsFeasible(const CpModelProto& model,
                         absl::Span<const int64_t> variable_values,
                         const CpModelProto* mapping_proto = nullptr,
-                        const std::vector<int>* postsolve_mapping = nullptr);
+                        const std::vector<int>* postsolve_mapping = nullptr,
+                        int num_threads = 1);
 
 // Checks a single constraint for feasibility.
 // This has some overhead, and should only be used for debugging.
@@ -1707,6 +1707,23 @@ void ExpandPositiveTable(ConstraintProto* ct, PresolveContext* context) {
     }
   }
 
+  // Large tables are kept and propagated directly, see CompactTablePropagator.
+  // We just remove the tuples that are no longer valid.
+  const int min_num_tuples =
+      context->params().min_num_tuples_for_table_propagator();
+  if (min_num_tuples > 0 && tuples.size() >= min_num_tuples &&
+      ct->enforcement_literal().empty()) {
+    if (tuples.size() < num_original_tuples) {
+      TableConstraintProto* mutable_table = ct->mutable_table();
+      mutable_table->clear_values();
+      for (const std::vector<int64_t>& tuple : tuples) {
+        for (const int64_t value : tuple) mutable_table->add_values(value);
+      }
+    }
+    context->UpdateRuleStats("table: kept for the table propagator");
+    return;
+  }
+
   // Tables with two variables do not need tuple literals.
   //
   // TODO(user): If there is an unique variable with cost, it is better to
@@ -186,6 +186,28 @@ void NeighborhoodGeneratorHelper::InitializeHelperData() {
       is_in_objective_[PositiveRef(ref)] = true;
     }
   }
+
+  // Note that a constraint using intervals is attached to the variables of its
+  // intervals, so that it is imported as soon as one of them is relaxed.
+  std::vector<int> keys;
+  std::vector<int> values;
+  std::vector<int> tmp_vars;
+  for (int c = 0; c < num_constraints; ++c) {
+    const ConstraintProto& ct = model_proto_.constraints(c);
+    tmp_vars = UsedVariables(ct);
+    for (const int i : UsedIntervals(ct)) {
+      const std::vector<int> interval_vars =
+          UsedVariables(model_proto_.constraints(i));
+      tmp_vars.insert(tmp_vars.end(), interval_vars.begin(),
+                      interval_vars.end());
+    }
+    gtl::STLSortAndRemoveDuplicates(&tmp_vars);
+    for (const int var : tmp_vars) {
+      keys.push_back(var);
+      values.push_back(c);
+    }
+  }
+  base_var_to_constraints_.ResetFromFlatMapping(keys, values);
 }
 
 // Recompute all the data when new variables have been fixed. Note that this
@@ -1009,6 +1031,11 @@ Neighborhood NeighborhoodGeneratorHelper::FixGivenVariables(
           : -1;
 
   // Fill in neighborhood.delta all variable domains.
+  //
+  // We only restrict the fragment to the constraints touching a relaxed
+  // variable if all the fixed variables take their base solution value, since
+  // otherwise the skipped constraints might not be satisfied.
+  bool all_fixed_to_base_value = true;
   {
     absl::ReaderMutexLock domain_lock(&domain_mutex_);
 
@@ -1046,8 +1073,12 @@ Neighborhood NeighborhoodGeneratorHelper::FixGivenVariables(
             }
           }
           FillDomainInProto(Domain(closest_value, closest_value), new_var);
+          all_fixed_to_base_value = false;
         }
       } else {
+        if (domain.IsFixed() && domain.FixedValue() != base_value) {
+          all_fixed_to_base_value = false;
+        }
         FillDomainInProto(domain, new_var);
       }
     }
@@ -1056,6 +1087,7 @@ Neighborhood NeighborhoodGeneratorHelper::FixGivenVariables(
   // Fill some statistic fields and detect if we cover a full component.
   //
   // TODO(user): If there is just one component, we can skip some computation.
+  std::vector<int> relaxed_variables;
   {
     absl::ReaderMutexLock graph_lock(&graph_mutex_);
     std::vector<int> count(components_.size(), 0);
@@ -1063,6 +1095,7 @@ Neighborhood NeighborhoodGeneratorHelper::FixGivenVariables(
     for (int var = 0; var < num_variables; ++var) {
       const auto& domain = neighborhood.delta.variables(var).domain();
       if (domain.size() != 2 || domain[0] != domain[1]) {
+        relaxed_variables.push_back(var);
         ++neighborhood.num_relaxed_variables;
         if (is_in_objective_[var]) {
           ++neighborhood.num_relaxed_variables_in_objective;
@@ -1093,6 +1126,10 @@ Neighborhood NeighborhoodGeneratorHelper::FixGivenVariables(
     neighborhood.variables_that_can_be_fixed_to_local_optimum.clear();
   }
 
+  if (all_fixed_to_base_value) {
+    ComputeBaseConstraintSubset(relaxed_variables, &neighborhood);
+  }
+
   AddSolutionHinting(base_solution, &neighborhood.delta);
 
   neighborhood.is_generated = true;
@@ -1106,6 +1143,37 @@ Neighborhood NeighborhoodGeneratorHelper::FixGivenVariables(
   return neighborhood;
 }
 
+void NeighborhoodGeneratorHelper::ComputeBaseConstraintSubset(
+    absl::Span<const int> relaxed_variables, Neighborhood* neighborhood) const {
+  // If the relaxed variables touch a large part of the model, it is not worth
+  // it, scanning all the constraints is just as fast.
+  const int num_constraints = model_proto_.constraints_size();
+  int64_t num_entries = 0;
+  for (const int var : relaxed_variables) {
+    if (var >= base_var_to_constraints_.size()) continue;
+    num_entries += base_var_to_constraints_[var].size();
+    if (num_entries > num_constraints / 2) return;
+  }
+
+  std::vector<int>& subset = neighborhood->base_constraint_subset;
+  subset.clear();
+  for (const int var : relaxed_variables) {
+    if (var >= base_var_to_constraints_.size()) continue;
+    for (const int c : base_var_to_constraints_[var]) subset.push_back(c);
+  }
+  gtl::STLSortAndRemoveDuplicates(&subset);
+
+  // The intervals used by an imported constraint must be imported too, even
+  // if all their variables are fixed.
+  const int num_touched = subset.size();
+  for (int i = 0; i < num_touched; ++i) {
+    const ConstraintProto& ct = model_proto_.constraints(subset[i]);
+    for (const int interval : UsedIntervals(ct)) subset.push_back(interval);
+  }
+  if (subset.size() > num_touched) gtl::STLSortAndRemoveDuplicates(&subset);
+  neighborhood->has_base_constraint_subset = true;
+}
+
 void NeighborhoodGeneratorHelper::AddSolutionHinting(
     const CpSolverResponse& initial_solution, CpModelProto* model_proto) const {
   // Set the current solution as a hint.
@@ -2301,7 +2369,7 @@ Neighborhood RoutingFullPathNeighborhoodGenerator::Generate(
 
 bool RelaxationInducedNeighborhoodGenerator::ReadyToGenerate() const {
   return (incomplete_solutions_->HasSolution() ||
-          lp_solutions_->NumSolutions() > 0);
+          lp_solutions_->LatestLPSolutionSequenceNumber() > 0);
 }
 
 Neighborhood RelaxationInducedNeighborhoodGenerator::Generate(
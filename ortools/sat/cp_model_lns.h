@@ -59,6 +59,17 @@ struct Neighborhood {
   // It can contains new variables and new constraints, and solution hinting.
   CpModelProto delta;
 
+  // If true, only the constraints of the initial model listed (in increasing
+  // order) in base_constraint_subset need to be imported in the lns fragment.
+  // All the other constraints only involve variables that are fixed by the
+  // delta to their value in a feasible base solution, so they are satisfied
+  // and can be skipped without even scanning them.
+  //
+  // Generators can further restrict the domains in the delta, but they must
+  // clear this if they relax the domain of a variable fixed by the delta.
+  bool has_base_constraint_subset = false;
+  std::vector<int> base_constraint_subset;
+
   // Neighborhood Id. Used to identify the neighborhood by a generator.
   // Currently only used by WeightedRandomRelaxationNeighborhoodGenerator.
   // TODO(user): Make sure that the id is unique for each generated
@@ -127,6 +138,12 @@ class NeighborhoodGeneratorHelper : public SubSolver {
   // It usually indicate that the generator failed to generated a neighborhood.
   Neighborhood NoNeighborhood() const;
 
+  // Fills the base_constraint_subset of the given neighborhood with all the
+  // constraints of the initial model touching one of the relaxed variables.
+  // This is a no-op if that subset would not be much smaller than the model.
+  void ComputeBaseConstraintSubset(absl::Span<const int> relaxed_variables,
+                                   Neighborhood* neighborhood) const;
+
   // Adds solution hinting to the neighborhood from the value of the initial
   // solution.
   void AddSolutionHinting(const CpSolverResponse& initial_solution,
@@ -306,6 +323,13 @@ class NeighborhoodGeneratorHelper : public SubSolver {
   // changes.
   std::vector<bool> is_in_objective_;
 
+  // For each variable, the list of model_proto_ constraints using it, either
+  // directly or through one of their intervals. Unlike var_to_constraint_, the
+  // indices here refer to model_proto_ and this never changes. This is used to
+  // only import the constraints touched by the relaxed variables of a
+  // neighborhood.
+  CompactVectorVector<int, int> base_var_to_constraints_;
+
   // A copy of CpModelProto where we did some basic presolving to remove all
   // constraint that are always true. The Variable-Constraint graph is based on
   // this model. Note that only the constraints field is present here.
@@ -56,6 +56,7 @@
 #include "ortools/sat/sat_parameters.pb.h"
 #include "ortools/sat/sat_solver.h"
 #include "ortools/sat/symmetry.h"
+#include "ortools/sat/table.h"
 #include "ortools/sat/timetable.h"
 #include "ortools/sat/util.h"
 #include "ortools/util/logging.h"
@@ -1653,6 +1654,27 @@ void LoadRoutesConstraint(const ConstraintProto& ct, Model* m) {
                               /*multiple_subcircuit_through_zero=*/true));
 }
 
+bool LoadTableConstraint(const ConstraintProto& ct, Model* m) {
+  // Only large positive tables are not expanded by the presolve.
+  if (ct.table().negated() || !ct.enforcement_literal().empty()) return false;
+  const int num_vars = ct.table().vars_size();
+  if (num_vars == 0) return true;
+
+  auto* mapping = m->GetOrCreate<CpModelMapping>();
+  const std::vector<IntegerVariable> vars =
+      mapping->Integers(ct.table().vars());
+  const int num_tuples = ct.table().values_size() / num_vars;
+  std::vector<std::vector<int64_t>> tuples(num_tuples);
+  int count = 0;
+  for (int t = 0; t < num_tuples; ++t) {
+    for (int i = 0; i < num_vars; ++i) {
+      tuples[t].push_back(ct.table().values(count++));
+    }
+  }
+  m->Add(TableConstraint(vars, tuples));
+  return true;
+}
+
 bool LoadConstraint(const ConstraintProto& ct, Model* m) {
   switch (ct.constraint_case()) {
     case ConstraintProto::ConstraintCase::CONSTRAINT_NOT_SET:
@@ -1711,6 +1733,8 @@ bool LoadConstraint(const ConstraintProto& ct, Model* m) {
     case ConstraintProto::ConstraintProto::kRoutes:
       LoadRoutesConstraint(ct, m);
       return true;
+    case ConstraintProto::ConstraintProto::kTable:
+      return LoadTableConstraint(ct, m);
     default:
       return false;
   }
@@ -107,6 +107,9 @@ void LoadCumulativeConstraint(const ConstraintProto& ct, Model* m);
 void LoadCircuitConstraint(const ConstraintProto& ct, Model* m);
 void LoadReservoirConstraint(const ConstraintProto& ct, Model* m);
 void LoadRoutesConstraint(const ConstraintProto& ct, Model* m);
+// Only positive tables without enforcement literal are supported, this returns
+// false otherwise.
+bool LoadTableConstraint(const ConstraintProto& ct, Model* m);
 void LoadCircuitCoveringConstraint(const ConstraintProto& ct, Model* m);
 
 // Part of LoadLinearConstraint() that we reuse to load the objective.
@@ -19,7 +19,9 @@
 #include <vector>
 
 #include "absl/log/check.h"
+#include "absl/synchronization/blocking_counter.h"
 #include "ortools/base/logging.h"
+#include "ortools/base/threadpool.h"
 #include "ortools/port/proto_utils.h"
 #include "ortools/sat/cp_model.pb.h"
 #include "ortools/sat/cp_model_utils.h"
@@ -330,10 +332,113 @@ void PostsolveIntMod(const ConstraintProto& ct, std::vector<Domain>* domains) {
   (*domains)[target.vars(0)] = Domain(value);
 }
 
+namespace {
+
+// Postsolves a single mapping constraint.
+void PostsolveConstraint(const ConstraintProto& ct,
+                         std::vector<Domain>* domains) {
+  // We ignore constraint with an enforcement literal set to false. If the
+  // enforcement is still unclear, we still process this constraint.
+  for (const int enf : ct.enforcement_literal()) {
+    const int var = PositiveRef(enf);
+    const bool is_false =
+        (*domains)[var].IsFixed() &&
+        RefIsPositive(enf) == ((*domains)[var].FixedValue() == 0);
+    if (is_false) return;
+  }
+
+  switch (ct.constraint_case()) {
+    case ConstraintProto::kBoolOr:
+      PostsolveClause(ct, domains);
+      break;
+    case ConstraintProto::kExactlyOne:
+      PostsolveExactlyOne(ct, domains);
+      break;
+    case ConstraintProto::kLinear:
+      PostsolveLinear(ct, domains);
+      break;
+    case ConstraintProto::kLinMax:
+      PostsolveLinMax(ct, domains);
+      break;
+    case ConstraintProto::kElement:
+      PostsolveElement(ct, domains);
+      break;
+    case ConstraintProto::kIntMod:
+      PostsolveIntMod(ct, domains);
+      break;
+    default:
+      // This should never happen as we control what kind of constraint we
+      // add to the mapping_proto;
+      LOG(FATAL) << "Unsupported constraint: " << ProtobufShortDebugString(ct);
+  }
+}
+
+// Below this number of mapping constraints, the parallel postsolve is not
+// worth its overhead.
+constexpr int kMinConstraintsForParallelPostsolve = 100000;
+
+// Below this size, a batch of independent constraints is processed by the
+// calling thread.
+constexpr int kMinBatchSizeForParallelPostsolve = 1000;
+
+// Same as calling PostsolveConstraint() on all the mapping constraints in
+// reverse order, but uses the given number of threads.
+//
+// Consecutive constraints (in postsolve order) that do not share any variable
+// only read and write disjoint domains, so they can be processed in any order.
+// We greedily split the constraints into maximal batches of such constraints
+// and process the large batches in parallel.
+void PostsolveInParallel(const CpModelProto& mapping_proto, int num_threads,
+                         std::vector<Domain>* domains) {
+  ThreadPool pool("Postsolve", num_threads);
+  pool.StartWorkers();
+
+  std::vector<int> batch;
+  const auto process_batch = [&pool, &batch, &mapping_proto, num_threads,
+                              domains]() {
+    if (batch.size() < kMinBatchSizeForParallelPostsolve) {
+      for (const int c : batch) {
+        PostsolveConstraint(mapping_proto.constraints(c), domains);
+      }
+    } else {
+      const int num_shards = std::min<int>(num_threads, batch.size());
+      absl::BlockingCounter counter(num_shards);
+      for (int shard = 0; shard < num_shards; ++shard) {
+        pool.Schedule([&, shard]() {
+          for (int i = shard; i < batch.size(); i += num_shards) {
+            PostsolveConstraint(mapping_proto.constraints(batch[i]), domains);
+          }
+          counter.DecrementCount();
+        });
+      }
+      counter.Wait();
+    }
+    batch.clear();
+  };
+
+  int batch_index = 0;
+  std::vector<int> last_batch_of_var(domains->size(), -1);
+  for (int c = mapping_proto.constraints_size() - 1; c >= 0; c--) {
+    const std::vector<int> vars = UsedVariables(mapping_proto.constraints(c));
+    for (const int var : vars) {
+      if (last_batch_of_var[var] == batch_index) {
+        process_batch();
+        ++batch_index;
+        break;
+      }
+    }
+    for (const int var : vars) last_batch_of_var[var] = batch_index;
+    batch.push_back(c);
+  }
+  process_batch();
+}
+
+}  // namespace
+
 void PostsolveResponse(const int64_t num_variables_in_original_model,
                        const CpModelProto& mapping_proto,
                        const std::vector<int>& postsolve_mapping,
-                       std::vector<int64_t>* solution) {
+                       std::vector<int64_t>* solution, int num_threads) {
   CHECK_EQ(solution->size(), postsolve_mapping.size());
 
   // Read the initial variable domains, either from the fixed solution of the
@@ -352,48 +457,12 @@ void PostsolveResponse(const int64_t num_variables_in_original_model,
 
   // Process the constraints in reverse order.
   const int num_constraints = mapping_proto.constraints_size();
-  for (int i = num_constraints - 1; i >= 0; i--) {
-    const ConstraintProto& ct = mapping_proto.constraints(i);
-
-    // We ignore constraint with an enforcement literal set to false. If the
-    // enforcement is still unclear, we still process this constraint.
-    bool constraint_can_be_ignored = false;
-    for (const int enf : ct.enforcement_literal()) {
-      const int var = PositiveRef(enf);
-      const bool is_false =
-          domains[var].IsFixed() &&
-          RefIsPositive(enf) == (domains[var].FixedValue() == 0);
-      if (is_false) {
-        constraint_can_be_ignored = true;
-        break;
-      }
-    }
-    if (constraint_can_be_ignored) continue;
-
-    switch (ct.constraint_case()) {
-      case ConstraintProto::kBoolOr:
-        PostsolveClause(ct, &domains);
-        break;
-      case ConstraintProto::kExactlyOne:
-        PostsolveExactlyOne(ct, &domains);
-        break;
-      case ConstraintProto::kLinear:
-        PostsolveLinear(ct, &domains);
-        break;
-      case ConstraintProto::kLinMax:
-        PostsolveLinMax(ct, &domains);
-        break;
-      case ConstraintProto::kElement:
-        PostsolveElement(ct, &domains);
-        break;
-      case ConstraintProto::kIntMod:
-        PostsolveIntMod(ct, &domains);
-        break;
-      default:
-        // This should never happen as we control what kind of constraint we
-        // add to the mapping_proto;
-        LOG(FATAL) << "Unsupported constraint: "
-                   << ProtobufShortDebugString(ct);
+  if (num_threads > 1 &&
+      num_constraints >= kMinConstraintsForParallelPostsolve) {
+    PostsolveInParallel(mapping_proto, num_threads, &domains);
+  } else {
+    for (int i = num_constraints - 1; i >= 0; i--) {
+      PostsolveConstraint(mapping_proto.constraints(i), &domains);
     }
   }
 
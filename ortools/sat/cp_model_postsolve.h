@@ -39,12 +39,15 @@ namespace sat {
 // Note: Most of the postsolve operations require the constraints to have been
 // written in the correct way by the presolve.
 //
+// If num_threads > 1 and there are a lot of mapping constraints, consecutive
+// constraints that do not share any variable are postsolved in parallel.
+//
 // TODO(user): We could use the search strategy to fix free variables to some
 // chosen values? The feature might never be needed though.
 void PostsolveResponse(int64_t num_variables_in_original_model,
                        const CpModelProto& mapping_proto,
                        const std::vector<int>& postsolve_mapping,
-                       std::vector<int64_t>* solution);
+                       std::vector<int64_t>* solution, int num_threads = 1);
 
 }  // namespace sat
 }  // namespace operations_research
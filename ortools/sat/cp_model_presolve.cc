@@ -47,6 +47,9 @@
 #include "ortools/base/protobuf_util.h"
 #include "ortools/base/stl_util.h"
 #include "ortools/base/strong_vector.h"
+#if !defined(__PORTABLE_PLATFORM__)
+#include "ortools/base/threadpool.h"
+#endif  // __PORTABLE_PLATFORM__
 #include "ortools/base/timer.h"
 #include "ortools/graph/strongly_connected_components.h"
 #include "ortools/graph/topologicalsorter.h"
@@ -57,6 +60,7 @@
 #include "ortools/sat/cp_model_checker.h"
 #include "ortools/sat/cp_model_expand.h"
 #include "ortools/sat/cp_model_mapping.h"
+#include "ortools/sat/cp_model_search.h"
 #include "ortools/sat/cp_model_symmetries.h"
 #include "ortools/sat/cp_model_utils.h"
 #include "ortools/sat/diffn_util.h"
@@ -6801,8 +6805,134 @@ void CpModelPresolver::ConvertToBoolAnd() {
   }
 }
 
-// TODO(user): It might make sense to run this in parallel. The same apply for
-// other expansive and self-contains steps like symmetry detection, etc...
+bool CpModelPresolver::ProbeInParallel(Model* model, PresolveTimer* timer) {
+  // We only do that on large problems, loading a copy of the model per worker
+  // is not free.
+  constexpr int kMinNumBooleansForParallelProbing = 10000;
+  auto* mapping = model->GetOrCreate<CpModelMapping>();
+  const int num_variables = context_->working_model->variables().size();
+  std::vector<int> bool_vars;
+  for (int var = 0; var < num_variables; ++var) {
+    if (mapping->IsBoolean(var) && !context_->IsFixed(var)) {
+      bool_vars.push_back(var);
+    }
+  }
+  const int num_workers = context_->num_threads;
+  if (num_workers <= 1 ||
+      bool_vars.size() < kMinNumBooleansForParallelProbing) {
+    return true;
+  }
+
+  // The copies are loaded sequentially since this touches the context. Each
+  // one gets its own random generator so that they can be used concurrently.
+  std::vector<std::unique_ptr<Model>> worker_models;
+  for (int w = 0; w < num_workers; ++w) {
+    auto local_model = std::make_unique<Model>(absl::StrCat("probing_", w));
+    auto* local_params = local_model->GetOrCreate<SatParameters>();
+    *local_params = context_->params();
+    local_params->set_random_seed(
+        ValidSumSeed(context_->params().random_seed(), w));
+    local_model->GetOrCreate<ModelRandomGenerator>();
+    if (!LoadModelForProbing(context_, local_model.get())) return false;
+    worker_models.push_back(std::move(local_model));
+  }
+
+  // Each worker probes a disjoint subset of the Boolean variables and records
+  // the binary clauses it learns so that we can export them afterwards. The
+  // fixed literals and the new domains are read from its model directly.
+  // Note that we do not use a vector<bool> since it is written concurrently.
+  std::vector<char> worker_is_feasible(num_workers, true);
+  std::vector<std::vector<std::pair<Literal, Literal>>> new_binary_clauses(
+      num_workers);
+  const double time_limit =
+      context_->params().probing_deterministic_time_limit();
+  const auto probe_worker = [&](int w) {
+    Model* local_model = worker_models[w].get();
+    auto* local_mapping = local_model->GetOrCreate<CpModelMapping>();
+    auto* prober = local_model->GetOrCreate<Prober>();
+    std::vector<BooleanVariable> to_probe;
+    for (int i = w; i < bool_vars.size(); i += num_workers) {
+      to_probe.push_back(local_mapping->Literal(bool_vars[i]).Variable());
+    }
+    prober->SetNewBinaryClauseCallback(
+        [clauses = &new_binary_clauses[w]](Literal a, Literal b) {
+          clauses->push_back({a, b});
+        });
+    worker_is_feasible[w] = prober->ProbeBooleanVariables(time_limit, to_probe);
+  };
+
+#if !defined(__PORTABLE_PLATFORM__)
+  {
+    ThreadPool pool("ParallelProbing", num_workers);
+    pool.StartWorkers();
+    for (int w = 0; w < num_workers; ++w) {
+      pool.Schedule([w, &probe_worker]() { probe_worker(w); });
+    }
+  }
+#else
+  for (int w = 0; w < num_workers; ++w) probe_worker(w);
+#endif  // __PORTABLE_PLATFORM__
+
+  // Merge everything in the main model in a deterministic order. Note that
+  // literals that do not correspond to a proto variable (like the ones created
+  // by the encoding during probing) do not have the same index in all the
+  // copies, so we just ignore them.
+  auto* sat_solver = model->GetOrCreate<SatSolver>();
+  auto* integer_trail = model->GetOrCreate<IntegerTrail>();
+  int64_t num_decisions = 0;
+  int num_fixed = 0;
+  int num_binary = 0;
+  for (int w = 0; w < num_workers; ++w) {
+    if (!worker_is_feasible[w]) return false;
+    Model* local_model = worker_models[w].get();
+    auto* local_mapping = local_model->GetOrCreate<CpModelMapping>();
+    const auto to_main_literal = [mapping, local_mapping](Literal l,
+                                                          Literal* output) {
+      const int var =
+          local_mapping->GetProtoVariableFromBooleanVariable(l.Variable());
+      if (var < 0) return false;
+      const Literal main_literal = mapping->Literal(var);
+      *output = l.IsPositive() ? main_literal : main_literal.Negated();
+      return true;
+    };
+
+    num_decisions += local_model->GetOrCreate<Prober>()->num_decisions();
+    Literal a;
+    Literal b;
+    const Trail& local_trail = *local_model->GetOrCreate<Trail>();
+    CHECK_EQ(local_trail.CurrentDecisionLevel(), 0);
+    for (int i = 0; i < local_trail.Index(); ++i) {
+      if (!to_main_literal(local_trail[i], &a)) continue;
+      if (sat_solver->Assignment().LiteralIsTrue(a)) continue;
+      ++num_fixed;
+      if (!sat_solver->AddUnitClause(a)) return false;
+    }
+    for (const auto& [local_a, local_b] : new_binary_clauses[w]) {
+      if (!to_main_literal(local_a, &a) || !to_main_literal(local_b, &b)) {
+        continue;
+      }
+      ++num_binary;
+      if (!sat_solver->AddBinaryClause(a, b)) return false;
+    }
+
+    auto* local_integer_trail = local_model->GetOrCreate<IntegerTrail>();
+    for (int var = 0; var < num_variables; ++var) {
+      if (mapping->IsBoolean(var)) continue;
+      if (!integer_trail->UpdateInitialDomain(
+              mapping->Integer(var), local_integer_trail->InitialVariableDomain(
+                                         local_mapping->Integer(var)))) {
+        return false;
+      }
+    }
+    if (!sat_solver->FinishPropagation()) return false;
+  }
+
+  timer->AddCounter("parallel_probed", num_decisions);
+  timer->AddCounter("parallel_fixed_bools", num_fixed);
+  timer->AddCounter("parallel_binary_clauses", num_binary);
+  return true;
+}
+
 void CpModelPresolver::Probe() {
   auto probing_timer =
       std::make_unique<PresolveTimer>(__FUNCTION__, logger_, time_limit_);
@@ -6810,6 +6940,14 @@ void CpModelPresolver::Probe() {
   Model model;
   if (!LoadModelForProbing(context_, &model)) return;
 
+  // On large problems, we first probe disjoint subsets of the Boolean
+  // variables in parallel on independent copies of the model, and merge back
+  // what they learned. The sequential probing below then starts with all
+  // these fixed literals and implications.
+  if (!ProbeInParallel(&model, probing_timer.get())) {
+    return (void)context_->NotifyThatModelIsUnsat("during parallel probing");
+  }
+
   // Probe.
   //
   // TODO(user): Compute the transitive reduction instead of just the
@@ -8661,7 +8799,7 @@ void CpModelPresolver::DetectDuplicateConstraints() {
   // TODO(user): We might want to do that earlier so that our count of variable
   // usage is not biased by duplicate constraints.
   const std::vector<std::pair<int, int>> duplicates =
-      FindDuplicateConstraints(*context_->working_model);
+      FindDuplicateConstraintsInWorkingModel(/*ignore_enforcement=*/false);
   timer.AddCounter("duplicates", duplicates.size());
   for (const auto& [dup, rep] : duplicates) {
     // Note that it is important to look at the type of the representative in
@@ -8732,7 +8870,7 @@ void CpModelPresolver::DetectDuplicateConstraints() {
   // cte and expr + Y = other_cte, we can see that X is in affine relation with
   // Y.
   const std::vector<std::pair<int, int>> duplicates_without_enforcement =
-      FindDuplicateConstraints(*context_->working_model, true);
+      FindDuplicateConstraintsInWorkingModel(/*ignore_enforcement=*/true);
   timer.AddCounter("without_enforcements",
                    duplicates_without_enforcement.size());
   for (const auto& [dup, rep] : duplicates_without_enforcement) {
@@ -11314,6 +11452,25 @@ void CpModelPresolver::PresolveToFixPoint() {
   // reason.
   absl::flat_hash_set<std::pair<int, int>> var_constraint_pair_already_called;
 
+  // On large models, the canonicalization that starts the presolve of each
+  // linear constraint can be done in parallel beforehand.
+  if (context_->num_threads > 1) {
+    std::vector<int> linear_constraints;
+    const int num_constraints = context_->working_model->constraints_size();
+    for (int c = 0; c < num_constraints; ++c) {
+      if (context_->working_model->constraints(c).constraint_case() ==
+          ConstraintProto::kLinear) {
+        linear_constraints.push_back(c);
+      }
+    }
+    if (linear_constraints.size() >= 10000) {
+      for (const int c : context_->CanonicalizeLinearConstraintsInParallel(
+               linear_constraints)) {
+        context_->UpdateConstraintVariableUsage(c);
+      }
+    }
+  }
+
   // The queue of "active" constraints, initialized to the non-empty ones.
   std::vector<bool> in_queue(context_->working_model->constraints_size(),
                              false);
@@ -11451,11 +11608,20 @@ void CpModelPresolver::PresolveToFixPoint() {
     // Starts by the "faster" algo that exploit variables that can move freely
     // in one direction. Or variables that are just blocked by one constraint in
     // one direction.
+    //
+    // These scan the full model, so we skip them if no presolve rule was
+    // applied since the last scan as they cannot find anything new.
     for (int i = 0; i < 10; ++i) {
       if (context_->ModelIsUnsat()) return;
+      if (context_->num_presolve_operations ==
+          num_operations_at_last_dual_strengthening_) {
+        break;
+      }
       ++num_dual_strengthening;
       DualBoundStrengthening dual_bound_strengthening;
       ScanModelForDualBoundStrengthening(*context_, &dual_bound_strengthening);
+      num_operations_at_last_dual_strengthening_ =
+          context_->num_presolve_operations;
       if (!dual_bound_strengthening.Strengthen(context_)) return;
       if (ProcessChangedVariables(&in_queue, &queue)) break;
 
@@ -11470,11 +11636,15 @@ void CpModelPresolver::PresolveToFixPoint() {
 
     // Detect & exploit dominance between variables.
     // TODO(user): This can be slow, remove from fix-pint loop?
-    if (num_dominance_tests++ < 2) {
+    if (context_->num_presolve_operations !=
+            num_operations_at_last_dominance_detection_ &&
+        num_dominance_tests++ < 2) {
       if (context_->ModelIsUnsat()) return;
       PresolveTimer timer("DetectDominanceRelations", logger_, time_limit_);
       VarDomination var_dom;
       ScanModelForDominanceDetection(*context_, &var_dom);
+      num_operations_at_last_dominance_detection_ =
+          context_->num_presolve_operations;
       if (!ExploitDominanceRelations(var_dom, context_)) return;
       if (ProcessChangedVariables(&in_queue, &queue)) continue;
     }
@@ -11562,6 +11732,19 @@ void ModelCopy::ImportVariablesAndMaybeIgnoreNames(
 // way to remind contributor to not forget this.
 bool ModelCopy::ImportAndSimplifyConstraints(const CpModelProto& in_model,
                                              bool first_copy) {
+  return ImportConstraints(in_model, first_copy, /*use_subset=*/false, {});
+}
+
+bool ModelCopy::ImportAndSimplifyConstraintSubset(
+    const CpModelProto& in_model, absl::Span<const int> subset) {
+  DCHECK(std::is_sorted(subset.begin(), subset.end()));
+  return ImportConstraints(in_model, /*first_copy=*/false,
+                           /*use_subset=*/true, subset);
+}
+
+bool ModelCopy::ImportConstraints(const CpModelProto& in_model,
+                                  bool first_copy, bool use_subset,
+                                  absl::Span<const int> subset) {
   context_->InitializeNewDomains();
   const bool ignore_names = context_->params().ignore_names();
 
@@ -11570,7 +11753,10 @@ bool ModelCopy::ImportAndSimplifyConstraints(const CpModelProto& in_model,
   std::vector<int> constraints_using_intervals;
 
   starting_constraint_index_ = context_->working_model->constraints_size();
-  for (int c = 0; c < in_model.constraints_size(); ++c) {
+  const int num_to_scan =
+      use_subset ? subset.size() : in_model.constraints_size();
+  for (int i = 0; i < num_to_scan; ++i) {
+    const int c = use_subset ? subset[i] : i;
     const ConstraintProto& ct = in_model.constraints(c);
     if (first_copy) {
       if (!PrepareEnforcementCopyWithDup(ct)) continue;
@@ -12912,27 +13098,54 @@ ConstraintProto CopyObjectiveForDuplicateDetection(
   return copy;
 }
 
-}  // namespace
+// Returns true if the two constraints are the same for the purpose of
+// FindDuplicateConstraints(). This is only called on constraints with the
+// same fingerprint.
+bool AreDuplicateConstraints(const ConstraintProto& a, const ConstraintProto& b,
+                             bool ignore_enforcement) {
+  if (a.constraint_case() != b.constraint_case()) return false;
+  if (!ignore_enforcement &&
+      absl::MakeConstSpan(a.enforcement_literal()) !=
+          absl::MakeConstSpan(b.enforcement_literal())) {
+    return false;
+  }
+  if (a.constraint_case() == ConstraintProto::kLinear) {
+    if (ignore_enforcement && absl::MakeConstSpan(a.linear().domain()) !=
+                                  absl::MakeConstSpan(b.linear().domain())) {
+      return false;
+    }
+    return absl::MakeConstSpan(a.linear().vars()) ==
+               absl::MakeConstSpan(b.linear().vars()) &&
+           absl::MakeConstSpan(a.linear().coeffs()) ==
+               absl::MakeConstSpan(b.linear().coeffs());
+  }
+  return CopyConstraintForDuplicateDetection(a, ignore_enforcement)
+             .SerializeAsString() ==
+         CopyConstraintForDuplicateDetection(b, ignore_enforcement)
+             .SerializeAsString();
+}
 
-std::vector<std::pair<int, int>> FindDuplicateConstraints(
-    const CpModelProto& model_proto, bool ignore_enforcement) {
+// The fingerprint of constraint c is given by fingerprint(c), so that the
+// presolve can use the cached ones from its context.
+template <typename FingerprintFunction>
+std::vector<std::pair<int, int>> FindDuplicateConstraintsInternal(
+    const CpModelProto& model_proto, bool ignore_enforcement,
+    const FingerprintFunction& fingerprint) {
   std::vector<std::pair<int, int>> result;
 
-  // We use a map hash: serialized_constraint_proto hash -> constraint index.
-  ConstraintProto copy;
-  std::string s;
+  // We use a map: fingerprint -> constraint index.
   absl::flat_hash_map<uint64_t, int> equiv_constraints;
 
   // Create a special representative for the linear objective.
   if (model_proto.has_objective() && !ignore_enforcement) {
-    copy = CopyObjectiveForDuplicateDetection(model_proto.objective());
-    s = copy.SerializeAsString();
-    equiv_constraints[absl::Hash<std::string>()(s)] = kObjectiveConstraint;
+    equiv_constraints[FingerprintObjectiveForDuplicateDetection(
+        model_proto.objective())] = kObjectiveConstraint;
   }
 
   const int num_constraints = model_proto.constraints().size();
   for (int c = 0; c < num_constraints; ++c) {
-    const auto type = model_proto.constraints(c).constraint_case();
+    const ConstraintProto& ct = model_proto.constraints(c);
+    const auto type = ct.constraint_case();
     if (type == ConstraintProto::CONSTRAINT_NOT_SET) continue;
 
     // TODO(user): we could delete duplicate identical interval, but we need
@@ -12942,24 +13155,23 @@ std::vector<std::pair<int, int>> FindDuplicateConstraints(
     // Nothing we will presolve in this case.
     if (ignore_enforcement && type == ConstraintProto::kBoolAnd) continue;
 
-    // We ignore names when comparing constraints.
-    //
-    // TODO(user): This is not particularly efficient.
-    copy = CopyConstraintForDuplicateDetection(model_proto.constraints(c),
-                                               ignore_enforcement);
-    s = copy.SerializeAsString();
-
-    const uint64_t hash = absl::Hash<std::string>()(s);
-    const auto [it, inserted] = equiv_constraints.insert({hash, c});
+    const auto [it, inserted] = equiv_constraints.insert({fingerprint(c), c});
     if (!inserted) {
       // Already present!
       const int other_c_with_same_hash = it->second;
-      copy = other_c_with_same_hash == kObjectiveConstraint
-                 ? CopyObjectiveForDuplicateDetection(model_proto.objective())
-                 : CopyConstraintForDuplicateDetection(
-                       model_proto.constraints(other_c_with_same_hash),
-                       ignore_enforcement);
-      if (s == copy.SerializeAsString()) {
+      bool is_duplicate;
+      if (other_c_with_same_hash == kObjectiveConstraint) {
+        is_duplicate =
+            CopyObjectiveForDuplicateDetection(model_proto.objective())
+                .SerializeAsString() ==
+            CopyConstraintForDuplicateDetection(ct, ignore_enforcement)
+                .SerializeAsString();
+      } else {
+        is_duplicate = AreDuplicateConstraints(
+            ct, model_proto.constraints(other_c_with_same_hash),
+            ignore_enforcement);
+      }
+      if (is_duplicate) {
         result.push_back({c, other_c_with_same_hash});
       }
     }
@@ -12968,5 +13180,26 @@ std::vector<std::pair<int, int>> FindDuplicateConstraints(
   return result;
 }
 
+}  // namespace
+
+std::vector<std::pair<int, int>> FindDuplicateConstraints(
+    const CpModelProto& model_proto, bool ignore_enforcement) {
+  return FindDuplicateConstraintsInternal(
+      model_proto, ignore_enforcement, [&model_proto, ignore_enforcement](int c) {
+        return FingerprintConstraintForDuplicateDetection(
+            model_proto.constraints(c), ignore_enforcement);
+      });
+}
+
+std::vector<std::pair<int, int>>
+CpModelPresolver::FindDuplicateConstraintsInWorkingModel(
+    bool ignore_enforcement) {
+  return FindDuplicateConstraintsInternal(
+      *context_->working_model, ignore_enforcement,
+      [this, ignore_enforcement](int c) {
+        return context_->DuplicateDetectionFingerprint(c, ignore_enforcement);
+      });
+}
+
 }  // namespace sat
 }  // namespace operations_research
@@ -23,8 +23,10 @@
 #include "absl/base/attributes.h"
 #include "absl/container/flat_hash_map.h"
 #include "absl/container/flat_hash_set.h"
+#include "absl/types/span.h"
 #include "ortools/sat/cp_model.pb.h"
 #include "ortools/sat/cp_model_utils.h"
+#include "ortools/sat/model.h"
 #include "ortools/sat/presolve_context.h"
 #include "ortools/sat/presolve_util.h"
 #include "ortools/sat/sat_parameters.pb.h"
@@ -99,6 +101,11 @@ class CpModelPresolver {
   // Runs the probing.
   void Probe();
 
+  // Called by Probe() when there is more than one thread. Probes the Boolean
+  // variables in parallel on copies of the model and merges the results into
+  // the given probing model. Returns false if the problem is infeasible.
+  bool ProbeInParallel(Model* model, PresolveTimer* timer);
+
   // Presolve functions.
   //
   // They should return false only if the constraint <-> variable graph didn't
@@ -187,6 +194,12 @@ class CpModelPresolver {
   // with duplicate linear expressions.
   void DetectDuplicateConstraints();
 
+  // Same as FindDuplicateConstraints() but uses the fingerprints cached in the
+  // context, so that only the constraints that changed since the last call are
+  // hashed again.
+  std::vector<std::pair<int, int>> FindDuplicateConstraintsInWorkingModel(
+      bool ignore_enforcement);
+
   // Detects variable that must take different values.
   void DetectDifferentVariables();
 
@@ -311,6 +324,12 @@ class CpModelPresolver {
   SolverLogger* logger_;
   TimeLimit* time_limit_;
 
+  // Value of context_->num_presolve_operations at the last full scan of the
+  // dual bound strengthening and of the dominance detection. If no rule was
+  // applied since then, a new scan would give the same result.
+  int64_t num_operations_at_last_dual_strengthening_ = -1;
+  int64_t num_operations_at_last_dominance_detection_ = -1;
+
   // Used by CanonicalizeLinearExpressionInternal().
   std::vector<std::pair<int, int64_t>> tmp_terms_;
 
@@ -370,12 +389,23 @@ class ModelCopy {
   bool ImportAndSimplifyConstraints(const CpModelProto& in_model,
                                     bool first_copy = false);
 
+  // Same as ImportAndSimplifyConstraints() but only import the constraints of
+  // in_model whose indices are listed in increasing order in the given subset.
+  // The intervals used by these constraints must be part of the subset.
+  bool ImportAndSimplifyConstraintSubset(const CpModelProto& in_model,
+                                         absl::Span<const int> subset);
+
   // Copy variables from the in_model to the working model.
   // It reads the 'ignore_names' parameters from the context, and keeps or
   // deletes names accordingly.
   void ImportVariablesAndMaybeIgnoreNames(const CpModelProto& in_model);
 
  private:
+  // Shared implementation of the two functions above. If use_subset is false,
+  // the subset is ignored and all the constraints of in_model are imported.
+  bool ImportConstraints(const CpModelProto& in_model, bool first_copy,
+                         bool use_subset, absl::Span<const int> subset);
+
   // Overwrites the out_model to be unsat. Returns false.
   // The arguments are used to log which constraint caused unsat.
   bool CreateUnsatModel(int c, const ConstraintProto& ct);
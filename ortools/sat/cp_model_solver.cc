@@ -33,6 +33,7 @@
 #if !defined(__PORTABLE_PLATFORM__)
 #include "ortools/base/helpers.h"
 #include "ortools/base/options.h"
+#include "ortools/base/threadpool.h"
 #endif  // __PORTABLE_PLATFORM__
 #include "absl/base/thread_annotations.h"
 #include "absl/cleanup/cleanup.h"
@@ -48,6 +49,7 @@
 #include "absl/strings/str_format.h"
 #include "absl/strings/str_join.h"
 #include "absl/strings/string_view.h"
+#include "absl/synchronization/blocking_counter.h"
 #include "absl/synchronization/mutex.h"
 #include "absl/types/span.h"
 #include "google/protobuf/arena.h"
@@ -88,6 +90,7 @@
 #include "ortools/sat/precedences.h"
 #include "ortools/sat/presolve_context.h"
 #include "ortools/sat/probing.h"
+#include "ortools/sat/pseudo_costs.h"
 #include "ortools/sat/sat_base.h"
 #include "ortools/sat/sat_inprocessing.h"
 #include "ortools/sat/sat_parameters.pb.h"
@@ -1433,6 +1436,26 @@ void RegisterClausesExport(int id, SharedClausesManager* shared_clauses_manager,
   };
   model->GetOrCreate<BinaryImplicationGraph>()->SetAdditionCallback(
       share_binary_clause);
+
+  const SatParameters& params = *model->GetOrCreate<SatParameters>();
+  if (!params.share_glue_clauses()) return;
+  const int max_size = params.glue_clause_sharing_max_size();
+  const int max_lbd = params.glue_clause_sharing_max_lbd();
+  auto* sat_solver = model->GetOrCreate<SatSolver>();
+  sat_solver->SetLearnedClauseCallback(
+      [mapping, id, shared_clauses_manager, max_size, max_lbd,
+       clause = std::vector<int>()](
+          int lbd, absl::Span<const Literal> literals) mutable {
+        if (literals.size() > max_size || lbd > max_lbd) return;
+        clause.clear();
+        for (const Literal l : literals) {
+          const int var =
+              mapping->GetProtoVariableFromBooleanVariable(l.Variable());
+          if (var == -1) return;
+          clause.push_back(l.IsPositive() ? var : NegatedRef(var));
+        }
+        shared_clauses_manager->AddGlueClause(id, lbd, clause);
+      });
 }
 
 // Registers a callback to import new clauses stored in the
@@ -1448,8 +1471,11 @@ int RegisterClausesLevelZeroImport(int id,
   CpModelMapping* const mapping = model->GetOrCreate<CpModelMapping>();
   auto* sat_solver = model->GetOrCreate<SatSolver>();
   auto* implications = model->GetOrCreate<BinaryImplicationGraph>();
+  const bool share_glue_clauses =
+      model->GetOrCreate<SatParameters>()->share_glue_clauses();
   const auto& import_level_zero_clauses = [shared_clauses_manager, id, mapping,
-                                           sat_solver, implications]() {
+                                           sat_solver, implications,
+                                           share_glue_clauses]() {
     std::vector<std::pair<int, int>> new_binary_clauses;
     shared_clauses_manager->GetUnseenBinaryClauses(id, &new_binary_clauses);
     implications->EnableSharing(false);
@@ -1460,6 +1486,21 @@ int RegisterClausesLevelZeroImport(int id,
         return false;
       }
     }
+    if (share_glue_clauses) {
+      std::vector<int> lbds;
+      CompactVectorVector<int, int> new_clauses;
+      shared_clauses_manager->GetUnseenGlueClauses(id, &lbds, &new_clauses);
+      std::vector<Literal> literals;
+      for (int i = 0; i < lbds.size(); ++i) {
+        literals.clear();
+        for (const int ref : new_clauses[i]) {
+          literals.push_back(mapping->Literal(ref));
+        }
+        if (!sat_solver->AddImportedLearnedClause(literals, lbds[i])) {
+          return false;
+        }
+      }
+    }
     implications->EnableSharing(true);
     return true;
   };
@@ -1468,6 +1509,17 @@ int RegisterClausesLevelZeroImport(int id,
   return id;
 }
 
+// Registers a callback that exchanges, at level zero, the pseudo costs learned
+// by this worker with the ones of the other workers.
+void RegisterPseudoCostsLevelZeroSync(Model* model) {
+  auto* pseudo_costs = model->GetOrCreate<PseudoCosts>();
+  model->GetOrCreate<LevelZeroCallbackHelper>()->callbacks.push_back(
+      [pseudo_costs]() {
+        pseudo_costs->SynchronizeWithSharedPseudoCosts();
+        return true;
+      });
+}
+
 void LoadBaseModel(const CpModelProto& model_proto, Model* model) {
   auto* shared_response_manager = model->GetOrCreate<SharedResponseManager>();
   CHECK(shared_response_manager != nullptr);
@@ -2256,7 +2308,51 @@ void PostsolveResponseWrapper(const SatParameters& params,
                                     mapping_proto, postsolve_mapping, solution);
   } else {
     PostsolveResponse(num_variable_in_original_model, mapping_proto,
-                      postsolve_mapping, solution);
+                      postsolve_mapping, solution,
+                      params.num_solution_postprocessing_threads());
+  }
+}
+
+// If collect_propagator_statistics is true, adds the propagator statistics of
+// the given worker model to its SharedStatistics so they are summed across
+// workers.
+void AddPropagatorStatistics(Model* model) {
+  if (!model->GetOrCreate<SatParameters>()->collect_propagator_statistics()) {
+    return;
+  }
+  SharedStatistics* stats = model->Mutable<SharedStatistics>();
+  const GenericLiteralWatcher* watcher = model->Get<GenericLiteralWatcher>();
+  if (stats == nullptr || watcher == nullptr) return;
+  stats->AddStats(watcher->PropagatorStatistics());
+}
+
+// Converts back the stats added by AddPropagatorStatistics() to protos.
+void FillPropagatorStatisticsInResponse(SharedStatistics* stats,
+                                        CpSolverResponse* response) {
+  const absl::string_view prefix =
+      GenericLiteralWatcher::kPropagatorStatsPrefix;
+  absl::btree_map<std::string, PropagatorStatistics> name_to_proto;
+  for (const auto& [key, count] : stats->GetStatsWithPrefix(prefix)) {
+    const absl::string_view name_and_counter =
+        absl::string_view(key).substr(prefix.size());
+    const size_t pos = name_and_counter.rfind('/');
+    if (pos == absl::string_view::npos) continue;
+    const std::string name(name_and_counter.substr(0, pos));
+    const absl::string_view counter = name_and_counter.substr(pos + 1);
+    PropagatorStatistics& proto = name_to_proto[name];
+    proto.set_name(name);
+    if (counter == "calls") {
+      proto.set_num_calls(count);
+    } else if (counter == "productive_calls") {
+      proto.set_num_productive_calls(count);
+    } else if (counter == "conflicts") {
+      proto.set_num_conflicts(count);
+    } else if (counter == "estimated_wall_time_ns") {
+      proto.set_wall_time(1e-9 * static_cast<double>(count));
+    }
+  }
+  for (const auto& [name, proto] : name_to_proto) {
+    *response->add_propagator_statistics() = proto;
   }
 }
 
@@ -2293,6 +2389,8 @@ struct SharedClasses {
   std::unique_ptr<SharedLPSolutionRepository> lp_solutions;
   std::unique_ptr<SharedIncompleteSolutionManager> incomplete_solutions;
   std::unique_ptr<SharedClausesManager> clauses;
+  std::unique_ptr<SharedCutPool> cuts;
+  std::unique_ptr<SharedPseudoCosts> pseudo_costs;
 
   // For displaying summary at the end.
   SharedStatTables stat_tables;
@@ -2353,6 +2451,14 @@ class FullProblemSolver : public SubSolver {
       local_model_.Register<SharedClausesManager>(shared->clauses.get());
     }
 
+    if (shared->cuts != nullptr) {
+      local_model_.Register<SharedCutPool>(shared->cuts.get());
+    }
+
+    if (shared->pseudo_costs != nullptr) {
+      local_model_.Register<SharedPseudoCosts>(shared->pseudo_costs.get());
+    }
+
     if (local_parameters.use_shared_tree_search()) {
       local_model_.Register<SharedTreeManager>(shared->shared_tree_manager);
     }
@@ -2366,6 +2472,7 @@ class FullProblemSolver : public SubSolver {
     CpSolverResponse response;
     FillSolveStatsInResponse(&local_model_, &response);
     shared_->response->AppendResponseToBeMerged(response);
+    AddPropagatorStatistics(&local_model_);
     shared_->stat_tables.AddTimingStat(*this);
     shared_->stat_tables.AddLpStat(name(), &local_model_);
     shared_->stat_tables.AddSearchStat(name(), &local_model_);
@@ -2425,6 +2532,10 @@ class FullProblemSolver : public SubSolver {
           RegisterClausesExport(id, shared_->clauses.get(), &local_model_);
         }
 
+        if (shared_->pseudo_costs != nullptr) {
+          RegisterPseudoCostsLevelZeroSync(&local_model_);
+        }
+
         if (local_model_.GetOrCreate<SatParameters>()->repair_hint()) {
           MinimizeL1DistanceWithHint(*shared_->model_proto, &local_model_);
         } else {
@@ -2790,6 +2901,115 @@ class FeasibilityPumpSolver : public SubSolver {
   bool previous_task_is_completed_ ABSL_GUARDED_BY(mutex_) = true;
 };
 
+// Runs the cut generators of its own LP relaxation on the LP solutions shared
+// by the other workers, and exports the cuts it finds to the SharedCutPool.
+class CutSeparationSolver : public SubSolver {
+ public:
+  CutSeparationSolver(const SatParameters& local_parameters,
+                      SharedClasses* shared)
+      : SubSolver("cut_separation", INCOMPLETE),
+        shared_(shared),
+        local_model_(std::make_unique<Model>(name())) {
+    // Setup the local model parameters and time limit.
+    *(local_model_->GetOrCreate<SatParameters>()) = local_parameters;
+    shared_->time_limit->UpdateLocalLimit(
+        local_model_->GetOrCreate<TimeLimit>());
+
+    if (shared->response != nullptr) {
+      local_model_->Register<SharedResponseManager>(shared->response);
+    }
+
+    // Level zero variable bounds sharing.
+    if (shared_->bounds != nullptr) {
+      RegisterVariableBoundsLevelZeroImport(
+          *shared_->model_proto, shared_->bounds.get(), local_model_.get());
+    }
+  }
+
+  ~CutSeparationSolver() override {
+    shared_->stat_tables.AddTimingStat(*this);
+    shared_->stat_tables.AddLpStat(name(), local_model_.get());
+  }
+
+  bool TaskIsAvailable() override {
+    if (shared_->SearchIsDone()) return false;
+    absl::MutexLock mutex_lock(&mutex_);
+    if (!previous_task_is_completed_) return false;
+    return solving_first_chunk_ || shared_->lp_solutions->NumSolutions() > 0;
+  }
+
+  std::function<void()> GenerateTask(int64_t /*task_id*/) override {
+    {
+      absl::MutexLock mutex_lock(&mutex_);
+      previous_task_is_completed_ = false;
+    }
+    return [this]() {
+      {
+        absl::MutexLock mutex_lock(&mutex_);
+        if (solving_first_chunk_) {
+          LoadCpModel(*shared_->model_proto, local_model_.get());
+
+          // No new task will be scheduled for this worker if there is no
+          // linear relaxation.
+          if (local_model_->GetOrCreate<SatSolver>()->ModelIsUnsat() ||
+              local_model_->GetOrCreate<LinearProgrammingConstraintCollection>()
+                  ->empty()) {
+            return;
+          }
+          solving_first_chunk_ = false;
+          previous_task_is_completed_ = true;
+          return;
+        }
+      }
+
+      // There is no point separating twice the same solution.
+      const std::shared_ptr<const SharedLPSolutionRepository::Solution>
+          lp_solution = shared_->lp_solutions->GetRandomBiasedSolution(
+              *local_model_->GetOrCreate<ModelRandomGenerator>());
+      if (lp_solution != last_lp_solution_) {
+        last_lp_solution_ = lp_solution;
+        auto* time_limit = local_model_->GetOrCreate<TimeLimit>();
+        const double saved_dtime = time_limit->GetElapsedDeterministicTime();
+        auto* lps =
+            local_model_->GetOrCreate<LinearProgrammingConstraintCollection>();
+        for (LinearProgrammingConstraint* lp : *lps) {
+          if (!lp->SeparateAndExportCuts(lp_solution->variable_values,
+                                         shared_->cuts.get())) {
+            shared_->response->NotifyThatImprovingProblemIsInfeasible(name());
+            return;
+          }
+        }
+        absl::MutexLock mutex_lock(&mutex_);
+        dtime_since_last_sync_ +=
+            time_limit->GetElapsedDeterministicTime() - saved_dtime;
+      }
+
+      absl::MutexLock mutex_lock(&mutex_);
+      previous_task_is_completed_ = true;
+    };
+  }
+
+  void Synchronize() override {
+    absl::MutexLock mutex_lock(&mutex_);
+    AddTaskDeterministicDuration(dtime_since_last_sync_);
+    shared_->time_limit->AdvanceDeterministicTime(dtime_since_last_sync_);
+    dtime_since_last_sync_ = 0.0;
+  }
+
+ private:
+  SharedClasses* shared_;
+  std::unique_ptr<Model> local_model_;
+  std::shared_ptr<const SharedLPSolutionRepository::Solution> last_lp_solution_;
+
+  absl::Mutex mutex_;
+
+  // The first chunk is special. It is the one in which we load the model.
+  bool solving_first_chunk_ ABSL_GUARDED_BY(mutex_) = true;
+
+  double dtime_since_last_sync_ ABSL_GUARDED_BY(mutex_) = 0.0;
+  bool previous_task_is_completed_ ABSL_GUARDED_BY(mutex_) = true;
+};
+
 // A Subsolver that generate LNS solve from a given neighborhood.
 class LnsSolver : public SubSolver {
  public:
@@ -2804,7 +3024,8 @@ class LnsSolver : public SubSolver {
 
   ~LnsSolver() override {
     shared_->stat_tables.AddTimingStat(*this);
-    shared_->stat_tables.AddLnsStat(name(), *generator_);
+    shared_->stat_tables.AddLnsStat(name(), *generator_,
+                                    deterministic_time());
   }
 
   bool TaskIsAvailable() override {
@@ -2812,6 +3033,14 @@ class LnsSolver : public SubSolver {
     return generator_->ReadyToGenerate();
   }
 
+  bool IsBanditArm() const override {
+    return lns_parameters_.use_lns_bandit_selection();
+  }
+
+  double BanditScore(int64_t total_num_tasks) const override {
+    return generator_->GetUCBScore(total_num_tasks);
+  }
+
   std::function<void()> GenerateTask(int64_t task_id) override {
     return [task_id, this]() {
       if (shared_->SearchIsDone()) return;
@@ -2835,16 +3064,17 @@ class LnsSolver : public SubSolver {
             shared_->response->SolutionsRepository();
         if (repo.NumSolutions() > 0) {
           base_response.set_status(CpSolverStatus::FEASIBLE);
-          const SharedSolutionRepository<int64_t>::Solution solution =
-              repo.GetRandomBiasedSolution(random);
-          for (const int64_t value : solution.variable_values) {
-            base_response.add_solution(value);
-          }
+          const std::shared_ptr<
+              const SharedSolutionRepository<int64_t>::Solution>
+              solution = repo.GetRandomBiasedSolution(random);
+          base_response.mutable_solution()->Assign(
+              solution->variable_values.begin(),
+              solution->variable_values.end());
 
           // Note: We assume that the solution rank is the solution internal
           // objective.
-          data.initial_best_objective = repo.GetSolution(0).rank;
-          data.base_objective = solution.rank;
+          data.initial_best_objective = repo.GetSolution(0)->rank;
+          data.base_objective = solution->rank;
         } else {
           base_response.set_status(CpSolverStatus::UNKNOWN);
 
@@ -2912,8 +3142,16 @@ class LnsSolver : public SubSolver {
       {
         ModelCopy copier(context.get());
 
-        // Copy and simplify the constraints from the initial model.
-        if (!copier.ImportAndSimplifyConstraints(helper_->ModelProto())) {
+        // Copy and simplify the constraints from the initial model. When the
+        // neighborhood only relaxes a small part of the model, we only scan the
+        // constraints touching it instead of the full shared model.
+        if (neighborhood.has_base_constraint_subset) {
+          if (!copier.ImportAndSimplifyConstraintSubset(
+                  helper_->ModelProto(), neighborhood.base_constraint_subset)) {
+            return;
+          }
+        } else if (!copier.ImportAndSimplifyConstraints(
+                       helper_->ModelProto())) {
           return;
         }
 
@@ -3218,6 +3456,21 @@ void SolveCpModelParallel(const CpModelProto& model_proto,
     shared.clauses = std::make_unique<SharedClausesManager>(always_synchronize);
   }
 
+  // TODO(user): for now this is not deterministic so we disable it on
+  // interleave search.
+  const bool use_shared_cut_pool =
+      params.use_shared_cut_pool() && params.linearization_level() > 0 &&
+      params.num_workers() > 1 && !testing && !params.interleave_search();
+  if (use_shared_cut_pool) {
+    shared.cuts = std::make_unique<SharedCutPool>();
+  }
+
+  if (params.share_pseudo_costs() && params.num_workers() > 1 &&
+      model_proto.has_objective()) {
+    shared.pseudo_costs =
+        std::make_unique<SharedPseudoCosts>(model_proto.variables_size());
+  }
+
   // The list of all the SubSolver that will be used in this parallel search.
   std::vector<std::unique_ptr<SubSolver>> subsolvers;
   std::vector<std::unique_ptr<SubSolver>> incomplete_subsolvers;
@@ -3293,6 +3546,13 @@ void SolveCpModelParallel(const CpModelProto& model_proto,
         std::make_unique<FeasibilityPumpSolver>(params, &shared));
   }
 
+  if (use_shared_cut_pool) {
+    SatParameters local_params = params;
+    local_params.set_linearization_level(2);
+    incomplete_subsolvers.push_back(
+        std::make_unique<CutSeparationSolver>(local_params, &shared));
+  }
+
   const SatParameters lns_params = GetNamedParameters(params).at("lns");
 
   if (use_rins_rens) {
@@ -3323,6 +3583,7 @@ void SolveCpModelParallel(const CpModelProto& model_proto,
       local_params.set_random_seed(ValidSumSeed(params.random_seed(), i));
       incomplete_subsolvers.push_back(std::make_unique<FeasibilityJumpSolver>(
           "violation_ls", SubSolver::INCOMPLETE, linear_model, local_params,
+          global_model->GetOrCreate<SharedLinearEvaluatorViews>(),
           shared.time_limit, shared.response, shared.bounds.get(), shared.stats,
           &shared.stat_tables));
     }
@@ -3411,6 +3672,7 @@ void SolveCpModelParallel(const CpModelProto& model_proto,
 
       incomplete_subsolvers.push_back(std::make_unique<FeasibilityJumpSolver>(
           name, SubSolver::FIRST_SOLUTION, linear_model, local_params,
+          global_model->GetOrCreate<SharedLinearEvaluatorViews>(),
           shared.time_limit, shared.response, shared.bounds.get(), shared.stats,
           &shared.stat_tables));
     }
@@ -3639,9 +3901,11 @@ void SolveCpModelParallel(const CpModelProto& model_proto,
           "Setting number of tasks in each batch of interleaved search to ",
           batch_size);
     }
-    DeterministicLoop(subsolvers, params.num_workers(), batch_size);
+    DeterministicLoop(subsolvers, params.num_workers(), batch_size,
+                      global_model->Mutable<ThreadPool>());
   } else {
-    NonDeterministicLoop(subsolvers, params.num_workers());
+    NonDeterministicLoop(subsolvers, params.num_workers(),
+                         global_model->Mutable<ThreadPool>());
   }
 
   // We need to delete the other subsolver in order to fill the stat tables.
@@ -3651,6 +3915,16 @@ void SolveCpModelParallel(const CpModelProto& model_proto,
     subsolvers[i].reset();
   }
 
+  if (params.fill_lns_statistics_in_response()) {
+    shared.response->AddFinalResponsePostprocessor(
+        [lns_statistics = shared.stat_tables.LnsStatistics()](
+            CpSolverResponse* response) {
+          for (const LnsGeneratorStatistics& stats : lns_statistics) {
+            *response->add_lns_statistics() = stats;
+          }
+        });
+  }
+
   // Log statistics.
   if (logger->LoggingIsEnabled()) {
     logger->FlushPendingThrottledLogs(/*ignore_rates=*/true);
@@ -3670,6 +3944,12 @@ void SolveCpModelParallel(const CpModelProto& model_proto,
     if (shared.incomplete_solutions != nullptr) {
       table.push_back(shared.incomplete_solutions->TableLineStats());
     }
+    if (shared.cuts != nullptr) {
+      table.push_back(shared.cuts->TableLineStats());
+    }
+    if (shared.pseudo_costs != nullptr) {
+      table.push_back(shared.pseudo_costs->TableLineStats());
+    }
     SOLVER_LOG(logger, FormatTable(table));
 
     if (shared.bounds) {
@@ -3775,6 +4055,9 @@ CpSolverResponse SolveCpModel(const CpModelProto& model_proto, Model* model) {
   // Enable the logging component.
   const SatParameters& params = *model->GetOrCreate<SatParameters>();
   SolverLogger* logger = model->GetOrCreate<SolverLogger>();
+  // The logger can't be configured in asynchronous mode, e.g. if it was left
+  // in this mode by a previous solve with the same model.
+  logger->SetAsynchronous(false);
   logger->EnableLogging(params.log_search_progress() || VLOG_IS_ON(1));
   logger->SetLogToStdOut(params.log_to_stdout());
   std::string log_string;
@@ -3783,6 +4066,8 @@ CpSolverResponse SolveCpModel(const CpModelProto& model_proto, Model* model) {
       absl::StrAppend(&log_string, message, "\n");
     });
   }
+  // Note that this must be done after all the callbacks are added.
+  logger->SetAsynchronous(params.log_asynchronously());
 
   auto* shared_response_manager = model->GetOrCreate<SharedResponseManager>();
   shared_response_manager->set_dump_prefix(
@@ -3811,6 +4096,7 @@ CpSolverResponse SolveCpModel(const CpModelProto& model_proto, Model* model) {
                                *response,
                                model_proto.has_objective() ||
                                    model_proto.has_floating_point_objective()));
+        logger->FlushAsynchronousMessages();
         if (!log_string.empty()) {
           response->set_solve_log(log_string);
         }
@@ -3922,6 +4208,7 @@ CpSolverResponse SolveCpModel(const CpModelProto& model_proto, Model* model) {
       google::protobuf::Arena::Create<CpModelProto>(&arena);
   auto context = std::make_unique<PresolveContext>(model, new_cp_model_proto,
                                                    mapping_proto);
+  context->num_threads = params.num_workers();
 
   if (absl::GetFlag(FLAGS_debug_model_copy)) {
     *new_cp_model_proto = model_proto;
@@ -4126,7 +4413,9 @@ CpSolverResponse SolveCpModel(const CpModelProto& model_proto, Model* model) {
                       ? postsolve_mapping[ref]
                       : NegatedRef(postsolve_mapping[PositiveRef(ref)]);
           }
-          if (!response->solution().empty()) {
+          if (!response->solution().empty() &&
+              (DEBUG_MODE ||
+               absl::GetFlag(FLAGS_cp_model_check_intermediate_solutions))) {
             CHECK(SolutionIsFeasible(
                 model_proto,
                 std::vector<int64_t>(response->solution().begin(),
@@ -4146,13 +4435,31 @@ CpSolverResponse SolveCpModel(const CpModelProto& model_proto, Model* model) {
             }
           }
         });
+
+    // The final solution is always checked.
+    shared_response_manager->AddFinalResponsePostprocessor(
+        [&model_proto, &params, mapping_proto,
+         &postsolve_mapping](CpSolverResponse* response) {
+          if (!response->solution().empty()) {
+            CHECK(SolutionIsFeasible(
+                model_proto,
+                std::vector<int64_t>(response->solution().begin(),
+                                     response->solution().end()),
+                mapping_proto, &postsolve_mapping,
+                params.num_solution_postprocessing_threads()))
+                << "postsolved solution";
+          }
+        });
   } else {
     shared_response_manager->AddFinalResponsePostprocessor(
-        [&model_proto](CpSolverResponse* response) {
+        [&model_proto, &params](CpSolverResponse* response) {
           if (!response->solution().empty()) {
             CHECK(SolutionIsFeasible(
-                model_proto, std::vector<int64_t>(response->solution().begin(),
-                                                  response->solution().end())));
+                model_proto,
+                std::vector<int64_t>(response->solution().begin(),
+                                     response->solution().end()),
+                /*mapping_proto=*/nullptr, /*postsolve_mapping=*/nullptr,
+                params.num_solution_postprocessing_threads()));
           }
         });
     shared_response_manager->AddResponsePostprocessor(
@@ -4354,6 +4661,15 @@ CpSolverResponse SolveCpModel(const CpModelProto& model_proto, Model* model) {
     CpSolverResponse status_response;
     FillSolveStatsInResponse(&local_model, &status_response);
     shared_response_manager->AppendResponseToBeMerged(status_response);
+    AddPropagatorStatistics(&local_model);
+  }
+
+  if (params.collect_propagator_statistics()) {
+    shared_response_manager->AddFinalResponsePostprocessor(
+        [stats = model->GetOrCreate<SharedStatistics>()](
+            CpSolverResponse* response) {
+          FillPropagatorStatisticsInResponse(stats, response);
+        });
   }
 
   // Extra logging if needed. Note that these are mainly activated on
@@ -4386,11 +4702,207 @@ CpSolverResponse SolveWithParameters(const CpModelProto& model_proto,
 }
 #endif  // !__PORTABLE_PLATFORM__
 
+CpModelBatchSolver::CpModelBatchSolver(const SatParameters& params,
+                                       int num_threads)
+    : params_(params), num_threads_(std::max(1, num_threads)) {
+  // Each model is solved on a single thread, the parallelism comes from
+  // solving many models at once.
+  params_.set_num_workers(1);
+  params_.set_num_search_workers(0);
+  params_.set_interleave_search(false);
+  params_.clear_subsolvers();
+#if !defined(__PORTABLE_PLATFORM__)
+  if (num_threads_ > 1) {
+    pool_ = std::make_unique<ThreadPool>("CpModelBatchSolver", num_threads_);
+    pool_->StartWorkers();
+  }
+#endif  // !__PORTABLE_PLATFORM__
+}
+
+CpModelBatchSolver::~CpModelBatchSolver() = default;
+
+std::vector<CpSolverResponse> CpModelBatchSolver::SolveBatch(
+    absl::Span<const CpModelProto> models) {
+  std::vector<CpSolverResponse> responses(models.size());
+  const auto solve = [this, models, &responses](int i) {
+    Model model;
+    *model.GetOrCreate<SatParameters>() = params_;
+    responses[i] = SolveCpModel(models[i], &model);
+  };
+#if !defined(__PORTABLE_PLATFORM__)
+  if (pool_ != nullptr && models.size() > 1) {
+    absl::BlockingCounter counter(models.size());
+    for (int i = 0; i < models.size(); ++i) {
+      pool_->Schedule([&solve, &counter, i]() {
+        solve(i);
+        counter.DecrementCount();
+      });
+    }
+    counter.Wait();
+    return responses;
+  }
+#endif  // !__PORTABLE_PLATFORM__
+  for (int i = 0; i < models.size(); ++i) solve(i);
+  return responses;
+}
+
+std::vector<CpSolverResponse> SolveCpModelsBatch(
+    absl::Span<const CpModelProto> models, const SatParameters& params,
+    int num_threads) {
+  CpModelBatchSolver solver(params, num_threads);
+  return solver.SolveBatch(models);
+}
+
 void LoadAndSolveCpModelForTest(const CpModelProto& model_proto, Model* model) {
   model->GetOrCreate<SharedResponseManager>()->InitializeObjective(model_proto);
   LoadCpModel(model_proto, model);
   SolveLoadedCpModel(model_proto, model);
 }
 
+CpSolverSession::CpSolverSession(const CpModelProto& model_proto,
+                                 const SatParameters& params)
+    : model_proto_(model_proto) {
+  model_.Add(NewSatParameters(params));
+  const std::string error = ValidateCpModel(model_proto_);
+  if (!error.empty()) {
+    VLOG(1) << "Invalid model: " << error;
+    model_is_valid_ = false;
+    return;
+  }
+  model_.GetOrCreate<SharedResponseManager>()->InitializeObjective(
+      model_proto_);
+  LoadCpModel(model_proto_, &model_);
+}
+
+bool CpSolverSession::AddConstraint(const ConstraintProto& ct) {
+  if (!model_is_valid_) return false;
+  auto* sat_solver = model_.GetOrCreate<SatSolver>();
+  if (!sat_solver->ResetToLevelZero()) return false;
+
+  // Note that the mapping keeps a pointer to the loaded constraints, which is
+  // fine since the elements of a repeated field are never moved.
+  ConstraintProto* new_ct = model_proto_.add_constraints();
+  *new_ct = ct;
+  if (!LoadConstraint(*new_ct, &model_)) {
+    VLOG(1) << "Unsupported constraint: " << ProtobufShortDebugString(ct);
+    model_proto_.mutable_constraints()->RemoveLast();
+    return false;
+  }
+  return sat_solver->FinishPropagation();
+}
+
+bool CpSolverSession::IntersectDomain(int var, const Domain& domain) {
+  if (!model_is_valid_) return false;
+  auto* sat_solver = model_.GetOrCreate<SatSolver>();
+  if (!sat_solver->ResetToLevelZero()) return false;
+
+  IntegerVariableProto* var_proto = model_proto_.mutable_variables(var);
+  const Domain new_domain =
+      ReadDomainFromProto(*var_proto).IntersectionWith(domain);
+  FillDomainInProto(new_domain, var_proto);
+
+  const auto* mapping = model_.GetOrCreate<CpModelMapping>();
+  if (mapping->IsInteger(var)) {
+    if (!model_.GetOrCreate<IntegerTrail>()->UpdateInitialDomain(
+            mapping->Integer(var), new_domain)) {
+      sat_solver->NotifyThatModelIsUnsat();
+      return false;
+    }
+  } else {
+    const Literal literal = mapping->Literal(var);
+    if (!new_domain.Contains(0) && !sat_solver->AddUnitClause(literal)) {
+      return false;
+    }
+    if (!new_domain.Contains(1) &&
+        !sat_solver->AddUnitClause(literal.Negated())) {
+      return false;
+    }
+  }
+  return sat_solver->FinishPropagation();
+}
+
+bool CpSolverSession::SetInnerObjectiveUpperBound(int64_t value) {
+  if (!model_is_valid_) return false;
+  const auto* objective = model_.Get<ObjectiveDefinition>();
+  if (objective == nullptr) return true;
+  auto* sat_solver = model_.GetOrCreate<SatSolver>();
+  if (!sat_solver->ResetToLevelZero()) return false;
+  if (!model_.GetOrCreate<IntegerTrail>()->Enqueue(
+          IntegerLiteral::LowerOrEqual(objective->objective_var,
+                                       IntegerValue(value)),
+          {}, {})) {
+    sat_solver->NotifyThatModelIsUnsat();
+    return false;
+  }
+  return sat_solver->FinishPropagation();
+}
+
+CpSolverResponse CpSolverSession::Solve(absl::Span<const int> assumptions) {
+  CpSolverResponse response;
+  if (!model_is_valid_) {
+    response.set_status(CpSolverStatus::MODEL_INVALID);
+    return response;
+  }
+
+  WallTimer wall_timer;
+  wall_timer.Start();
+  auto* sat_solver = model_.GetOrCreate<SatSolver>();
+  auto* time_limit = model_.GetOrCreate<TimeLimit>();
+  const int64_t old_num_conflicts = sat_solver->num_failures();
+  const int64_t old_num_branches = sat_solver->num_branches();
+
+  // Note that this also resets the elapsed deterministic time.
+  time_limit->ResetLimitFromParameters(*model_.GetOrCreate<SatParameters>());
+
+  const auto& mapping = *model_.GetOrCreate<CpModelMapping>();
+  SatSolver::Status status = SatSolver::INFEASIBLE;
+  if (sat_solver->ResetToLevelZero()) {
+    ConfigureSearchHeuristics(&model_);
+    status = ResetAndSolveIntegerProblem(
+        mapping.Literals(std::vector<int>(assumptions.begin(),
+                                          assumptions.end())),
+        &model_);
+  }
+
+  switch (status) {
+    case SatSolver::FEASIBLE: {
+      response.set_status(CpSolverStatus::FEASIBLE);
+      const std::vector<int64_t> solution =
+          GetSolutionValues(model_proto_, model_);
+      response.mutable_solution()->Assign(solution.begin(), solution.end());
+      if (model_proto_.has_objective()) {
+        const CpObjectiveProto& obj = model_proto_.objective();
+        response.set_objective_value(
+            ScaleObjectiveValue(obj, ComputeInnerObjective(obj, solution)));
+      }
+      break;
+    }
+    case SatSolver::ASSUMPTIONS_UNSAT: {
+      response.set_status(CpSolverStatus::INFEASIBLE);
+      std::vector<Literal> core = sat_solver->GetLastIncompatibleDecisions();
+      MinimizeCoreWithPropagation(time_limit, sat_solver, &core);
+      for (const Literal l : core) {
+        const int var =
+            mapping.GetProtoVariableFromBooleanVariable(l.Variable());
+        response.add_sufficient_assumptions_for_infeasibility(
+            l.IsPositive() ? var : NegatedRef(var));
+      }
+      break;
+    }
+    case SatSolver::INFEASIBLE:
+      response.set_status(CpSolverStatus::INFEASIBLE);
+      break;
+    default:
+      response.set_status(CpSolverStatus::UNKNOWN);
+      break;
+  }
+
+  response.set_num_conflicts(sat_solver->num_failures() - old_num_conflicts);
+  response.set_num_branches(sat_solver->num_branches() - old_num_branches);
+  response.set_wall_time(wall_timer.Get());
+  response.set_deterministic_time(time_limit->GetElapsedDeterministicTime());
+  return response;
+}
+
 }  // namespace sat
 }  // namespace operations_research
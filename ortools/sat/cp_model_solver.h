@@ -14,16 +14,23 @@
 #ifndef OR_TOOLS_SAT_CP_MODEL_SOLVER_H_
 #define OR_TOOLS_SAT_CP_MODEL_SOLVER_H_
 
+#include <cstdint>
 #include <functional>
+#include <memory>
 #include <string>
 #include <vector>
 
+#include "absl/types/span.h"
 #include "ortools/base/types.h"
 #include "ortools/sat/cp_model.pb.h"
 #include "ortools/sat/model.h"
 #include "ortools/sat/sat_parameters.pb.h"
+#include "ortools/util/sorted_interval_list.h"
 
 namespace operations_research {
+
+class ThreadPool;
+
 namespace sat {
 
 /// Returns a string that describes the version of the solver.
@@ -58,6 +65,9 @@ std::string CpSolverResponseStats(const CpSolverResponse& response,
  * - model->Add(NewSatParameters(parameters_as_string_or_proto));
  * - model->GetOrCreate<TimeLimit>()->RegisterExternalBooleanAsLimit(&stop);
  * - model->Add(NewFeasibleSolutionObserver(observer));
+ * - model->Register<ThreadPool>(thread_pool) to run the workers of a parallel
+ *   search on a started pool shared with other solves (see
+ *   SharedThreadPool()), instead of creating num_workers threads.
  */
 CpSolverResponse SolveCpModel(const CpModelProto& model_proto, Model* model);
 
@@ -129,6 +139,99 @@ std::function<SatParameters(Model*)> NewSatParameters(
 /// Solves a CpModelProto without any processing. Only used for unit tests.
 void LoadAndSolveCpModelForTest(const CpModelProto& model_proto, Model* model);
 
+/**
+ * Advanced API to solve many times the same model with small modifications.
+ *
+ * The model is loaded once, without presolve, in a single-thread Model. Each
+ * call to Solve() reuses everything that was learned by the previous ones: the
+ * learned clauses and their activities, the LP cuts, the level zero bounds and
+ * so on. In between two solves, one can add constraints, restrict the domain
+ * of some variables, tighten the objective or change the assumptions. All the
+ * modifications except the assumptions are permanent.
+ *
+ * Solve() only looks for a feasible solution. For an optimization problem, the
+ * usual pattern is to call SetInnerObjectiveUpperBound() with a better bound
+ * after each solution, or to encode the bound in an assumption literal.
+ *
+ * Note that constraints added with AddConstraint() are only propagated, they
+ * are not added to the linear relaxation. Adding new variables is not
+ * supported.
+ */
+class CpSolverSession {
+ public:
+  CpSolverSession(const CpModelProto& model_proto, const SatParameters& params);
+
+  // This type is neither copyable nor movable.
+  CpSolverSession(const CpSolverSession&) = delete;
+  CpSolverSession& operator=(const CpSolverSession&) = delete;
+
+  // Loads a new constraint. It must only refer to existing variables. Returns
+  // false if the constraint type is not supported or if the model is now
+  // infeasible.
+  bool AddConstraint(const ConstraintProto& ct);
+
+  // Intersects the domain of the given variable with the given one. Returns
+  // false if the model is now infeasible.
+  bool IntersectDomain(int var, const Domain& domain);
+
+  // Restricts the inner (i.e. unscaled, without offset) objective value to be
+  // at most the given value. Returns false if the model is now infeasible.
+  bool SetInnerObjectiveUpperBound(int64_t value);
+
+  // Searches for a feasible solution under the given assumptions, given as
+  // literals of the model. The time limits of the parameters apply to each
+  // call. The returned status is FEASIBLE, INFEASIBLE, UNKNOWN or
+  // MODEL_INVALID, and on INFEASIBLE due to the assumptions, the response
+  // contains a subset of them that is infeasible.
+  CpSolverResponse Solve(absl::Span<const int> assumptions = {});
+
+  // The Model used for all the solves. This can be used to access or configure
+  // more advanced features.
+  Model* model() { return &model_; }
+
+ private:
+  CpModelProto model_proto_;
+  Model model_;
+  bool model_is_valid_ = true;
+};
+
+/**
+ * Solves many small independent models with the same parameters.
+ *
+ * This is meant for throughput when the solve time of each model is small
+ * compared to the setup of a SolveCpModel() call. The models are solved
+ * concurrently, each of them on a single worker (the num_workers parameter is
+ * ignored), and the thread pool is created once and reused by all the calls
+ * to SolveBatch().
+ */
+class CpModelBatchSolver {
+ public:
+  CpModelBatchSolver(const SatParameters& params, int num_threads);
+  ~CpModelBatchSolver();
+
+  // This type is neither copyable nor movable.
+  CpModelBatchSolver(const CpModelBatchSolver&) = delete;
+  CpModelBatchSolver& operator=(const CpModelBatchSolver&) = delete;
+
+  // Returns the responses in the same order as the given models. This is not
+  // thread-safe, it must not be called concurrently on the same object.
+  std::vector<CpSolverResponse> SolveBatch(
+      absl::Span<const CpModelProto> models);
+
+ private:
+  SatParameters params_;
+  int num_threads_;
+#if !defined(__PORTABLE_PLATFORM__)
+  std::unique_ptr<ThreadPool> pool_;
+#endif  // !__PORTABLE_PLATFORM__
+};
+
+/// Solves all the given models with the given parameters, using at most
+/// num_threads threads. See CpModelBatchSolver.
+std::vector<CpSolverResponse> SolveCpModelsBatch(
+    absl::Span<const CpModelProto> models, const SatParameters& params,
+    int num_threads);
+
 }  // namespace sat
 }  // namespace operations_research
 
@@ -20,11 +20,13 @@
 #include <functional>
 #include <limits>
 #include <memory>
+#include <string>
 #include <utility>
 #include <vector>
 
 #include "absl/container/flat_hash_map.h"
 #include "absl/container/flat_hash_set.h"
+#include "absl/flags/flag.h"
 #include "absl/log/check.h"
 #include "absl/meta/type_traits.h"
 #include "absl/status/status.h"
@@ -32,8 +34,10 @@
 #include "absl/strings/str_join.h"
 #include "absl/types/span.h"
 #include "google/protobuf/message.h"
+#include "ortools/algorithms/dynamic_permutation.h"
 #include "ortools/algorithms/find_graph_symmetries.h"
 #include "ortools/algorithms/sparse_permutation.h"
+#include "ortools/base/file.h"
 #include "ortools/base/hash.h"
 #include "ortools/base/logging.h"
 #include "ortools/graph/graph.h"
@@ -51,6 +55,13 @@
 #include "ortools/util/logging.h"
 #include "ortools/util/time_limit.h"
 
+ABSL_FLAG(std::string, cp_model_symmetry_cache_dir, "",
+          "If non-empty, the generators found by the symmetry detection are "
+          "saved in this directory, keyed by a hash of the symmetry graph "
+          "node colors. On the next solve of a structurally identical model, "
+          "they are revalidated against the new graph and reused instead of "
+          "running the full symmetry search.");
+
 namespace operations_research {
 namespace sat {
 
@@ -509,6 +520,108 @@ std::unique_ptr<Graph> GenerateGraphForSymmetryDetection(
 
   return graph;
 }
+// Key used to store the generators of a symmetry graph in the cache. We only
+// hash the node colors, the arcs are checked when the generators are
+// revalidated, so that a collision just costs us a failed validation.
+uint64_t SymmetryCacheKey(absl::Span<const int> equivalence_classes) {
+  uint64_t hash = util_hash::Hash(equivalence_classes.size(), 0);
+  for (const int id : equivalence_classes) {
+    hash = util_hash::Hash(id, hash);
+  }
+  return hash;
+}
+
+std::string SymmetryCacheFilename(uint64_t key) {
+  return absl::StrCat(absl::GetFlag(FLAGS_cp_model_symmetry_cache_dir),
+                      "/symmetry_", absl::Hex(key, absl::kZeroPad16), ".pb");
+}
+
+void SaveSymmetryGeneratorsToCache(
+    uint64_t key,
+    absl::Span<const std::unique_ptr<SparsePermutation>> generators,
+    SolverLogger* logger) {
+  SymmetryProto cache;
+  for (const std::unique_ptr<SparsePermutation>& perm : generators) {
+    SparsePermutationProto* perm_proto = cache.add_permutations();
+    for (int i = 0; i < perm->NumCycles(); ++i) {
+      const int old_size = perm_proto->support().size();
+      for (const int node : perm->Cycle(i)) {
+        perm_proto->add_support(node);
+      }
+      perm_proto->add_cycle_sizes(perm_proto->support().size() - old_size);
+    }
+  }
+  const std::string filename = SymmetryCacheFilename(key);
+  const absl::Status status =
+      file::SetBinaryProto(filename, cache, file::Defaults());
+  if (!status.ok()) {
+    SOLVER_LOG(logger, "[Symmetry] Could not write cache file '", filename,
+               "': ", status.message());
+  }
+}
+
+// Loads the cached generators for the given key and checks that each of them
+// is still an automorphism of the graph that respects the node colors. This is
+// linear in the total support size times the degree, which is a lot cheaper
+// than the search. Returns false, and leaves generators empty, if there is no
+// cache entry or if any generator is no longer valid.
+template <typename Graph>
+bool LoadAndValidateCachedSymmetryGenerators(
+    uint64_t key, const Graph& graph, const GraphSymmetryFinder& finder,
+    absl::Span<const int> equivalence_classes,
+    std::vector<std::unique_ptr<SparsePermutation>>* generators) {
+  generators->clear();
+  SymmetryProto cache;
+  if (!file::GetBinaryProto(SymmetryCacheFilename(key), &cache,
+                            file::Defaults())
+           .ok()) {
+    return false;
+  }
+
+  const int num_nodes = graph.num_nodes();
+  DynamicPermutation dynamic_permutation(num_nodes);
+  std::vector<int> src;
+  std::vector<int> dst;
+  for (const SparsePermutationProto& perm_proto : cache.permutations()) {
+    auto perm = std::make_unique<SparsePermutation>(num_nodes);
+    dynamic_permutation.Reset();
+    int support_index = 0;
+    for (const int cycle_size : perm_proto.cycle_sizes()) {
+      if (cycle_size < 2 ||
+          support_index + cycle_size > perm_proto.support_size()) {
+        generators->clear();
+        return false;
+      }
+      src.clear();
+      dst.clear();
+      for (int i = 0; i < cycle_size; ++i) {
+        const int node = perm_proto.support(support_index + i);
+        const int image =
+            perm_proto.support(support_index + (i + 1) % cycle_size);
+        if (node < 0 || node >= num_nodes || image < 0 || image >= num_nodes ||
+            equivalence_classes[node] != equivalence_classes[image] ||
+            dynamic_permutation.ImageOf(node) != node) {
+          generators->clear();
+          return false;
+        }
+        src.push_back(node);
+        dst.push_back(image);
+        perm->AddToCurrentCycle(node);
+      }
+      perm->CloseCurrentCycle();
+      dynamic_permutation.AddMappings(src, dst);
+      support_index += cycle_size;
+    }
+    if (support_index != perm_proto.support_size() ||
+        !finder.IsGraphAutomorphism(dynamic_permutation)) {
+      generators->clear();
+      return false;
+    }
+    generators->push_back(std::move(perm));
+  }
+  return true;
+}
+
 }  // namespace
 
 void FindCpModelSymmetries(
@@ -547,18 +660,37 @@ void FindCpModelSymmetries(
   }
 
   GraphSymmetryFinder symmetry_finder(*graph, /*is_undirected=*/false);
-  std::vector<int> factorized_automorphism_group_size;
   std::unique_ptr<TimeLimit> time_limit =
       TimeLimit::FromDeterministicTime(deterministic_limit);
-  const absl::Status status = symmetry_finder.FindSymmetries(
-      &equivalence_classes, generators, &factorized_automorphism_group_size,
-      time_limit.get());
 
-  // TODO(user): Change the API to not return an error when the time limit is
-  // reached.
-  if (!status.ok()) {
-    SOLVER_LOG(logger,
-               "[Symmetry] GraphSymmetryFinder error: ", status.message());
+  // Note that the key must be computed before FindSymmetries() since it
+  // refines the equivalence classes in place.
+  const bool use_cache =
+      !absl::GetFlag(FLAGS_cp_model_symmetry_cache_dir).empty();
+  const uint64_t cache_key =
+      use_cache ? SymmetryCacheKey(equivalence_classes) : 0;
+  if (use_cache &&
+      LoadAndValidateCachedSymmetryGenerators(
+          cache_key, *graph, symmetry_finder, equivalence_classes,
+          generators)) {
+    SOLVER_LOG(logger, "[Symmetry] Reusing ", generators->size(),
+               " cached generators.");
+  } else {
+    std::vector<int> factorized_automorphism_group_size;
+    const absl::Status status = symmetry_finder.FindSymmetries(
+        &equivalence_classes, generators, &factorized_automorphism_group_size,
+        time_limit.get());
+
+    // TODO(user): Change the API to not return an error when the time limit
+    // is reached.
+    if (!status.ok()) {
+      SOLVER_LOG(logger,
+                 "[Symmetry] GraphSymmetryFinder error: ", status.message());
+    } else if (use_cache) {
+      // We only cache a complete search, and we store the generators on the
+      // full graph so that they can be revalidated as graph automorphisms.
+      SaveSymmetryGeneratorsToCache(cache_key, *generators, logger);
+    }
   }
 
   // Remove from the permutations the part not concerning the variables.
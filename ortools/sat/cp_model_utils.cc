@@ -644,6 +644,38 @@ uint64_t FingerprintExpression(const LinearExpressionProto& lin,
   return fp;
 }
 
+uint64_t FingerprintConstraintForDuplicateDetection(const ConstraintProto& ct,
+                                                    bool ignore_enforcement) {
+  uint64_t fp = FingerprintSingleField(static_cast<int>(ct.constraint_case()),
+                                       kDefaultFingerprintSeed);
+  if (!ignore_enforcement) {
+    fp = FingerprintRepeatedField(ct.enforcement_literal(), fp);
+  }
+
+  // This is by far the most common case, so we avoid a copy.
+  if (ct.constraint_case() == ConstraintProto::kLinear) {
+    fp = FingerprintRepeatedField(ct.linear().vars(), fp);
+    fp = FingerprintRepeatedField(ct.linear().coeffs(), fp);
+    return fp;
+  }
+
+  ConstraintProto copy = ct;
+  copy.clear_name();
+  copy.clear_enforcement_literal();
+  const std::string s = copy.SerializeAsString();
+  return fasthash64(s.data(), s.size(), fp);
+}
+
+uint64_t FingerprintObjectiveForDuplicateDetection(
+    const CpObjectiveProto& objective) {
+  uint64_t fp =
+      FingerprintSingleField(static_cast<int>(ConstraintProto::kLinear),
+                             kDefaultFingerprintSeed);
+  fp = FingerprintRepeatedField(objective.vars(), fp);
+  fp = FingerprintRepeatedField(objective.coeffs(), fp);
+  return fp;
+}
+
 uint64_t FingerprintModel(const CpModelProto& model, uint64_t seed) {
   uint64_t fp = seed;
   for (const IntegerVariableProto& var_proto : model.variables()) {
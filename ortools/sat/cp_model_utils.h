@@ -266,6 +266,15 @@ uint64_t FingerprintExpression(const LinearExpressionProto& lin, uint64_t seed);
 uint64_t FingerprintModel(const CpModelProto& model,
                           uint64_t seed = kDefaultFingerprintSeed);
 
+// Returns a fingerprint used to detect duplicate constraints. It ignores the
+// constraint name, the domain of a linear constraint, and the enforcement
+// literals if ignore_enforcement is true. The objective has the same
+// fingerprint as an unenforced linear constraint with the same expression.
+uint64_t FingerprintConstraintForDuplicateDetection(const ConstraintProto& ct,
+                                                    bool ignore_enforcement);
+uint64_t FingerprintObjectiveForDuplicateDetection(
+    const CpObjectiveProto& objective);
+
 #if !defined(__PORTABLE_PLATFORM__)
 
 // We register a few custom printers to display variables and linear
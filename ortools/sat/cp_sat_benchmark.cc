@@ -0,0 +1,200 @@
+// Copyright 2010-2024 Google LLC
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Runs the CP-SAT solver on a fixed set of CpModelProto files under a fixed
+// deterministic time limit, and outputs one CSV line per model with the
+// throughput of the solver: propagations, conflicts, LP iterations and LNS
+// neighborhoods per second, and the primal integral.
+//
+// The counts only depend on the deterministic time limit (with the default
+// --interleave_search), so two CSV files obtained with different versions of
+// the solver on the same machine can be compared line by line. The rates are
+// also given per unit of deterministic time, which does not depend on the
+// machine.
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdlib>
+#include <string>
+#include <vector>
+
+#include "absl/flags/flag.h"
+#include "absl/flags/parse.h"
+#include "absl/flags/usage.h"
+#include "absl/log/check.h"
+#include "absl/log/flags.h"
+#include "absl/log/initialize.h"
+#include "absl/status/status.h"
+#include "absl/strings/str_cat.h"
+#include "absl/strings/str_format.h"
+#include "absl/strings/str_split.h"
+#include "absl/strings/string_view.h"
+#include "google/protobuf/text_format.h"
+#include "ortools/base/file.h"
+#include "ortools/base/filesystem.h"
+#include "ortools/base/helpers.h"
+#include "ortools/base/logging.h"
+#include "ortools/base/options.h"
+#include "ortools/base/path.h"
+#include "ortools/sat/cp_model.pb.h"
+#include "ortools/sat/cp_model_solver.h"
+#include "ortools/sat/model.h"
+#include "ortools/sat/sat_parameters.pb.h"
+#include "ortools/util/file_util.h"
+
+ABSL_FLAG(std::string, inputs, "",
+          "Required: comma-separated list of CpModelProto files (binary or "
+          "text) or of directories, in which case all the files they contain "
+          "are used. Jobshop, RCPSP or MIP instances must first be converted "
+          "to CpModelProto, for instance by the examples that model them.");
+
+ABSL_FLAG(std::string, params, "",
+          "Parameters for the sat solver in a text format of the "
+          "SatParameters proto. They are applied after the benchmark ones, "
+          "so they can override them.");
+
+ABSL_FLAG(double, max_deterministic_time, 10.0,
+          "The deterministic time limit of each solve.");
+
+ABSL_FLAG(bool, interleave_search, true,
+          "If true, the workers are run in a deterministic way, so the "
+          "counts and the objective only depend on the deterministic time "
+          "limit.");
+
+ABSL_FLAG(std::string, output, "",
+          "If non-empty, write the CSV there instead of on stdout.");
+
+namespace operations_research {
+namespace sat {
+namespace {
+
+// Returns the files of --inputs, sorted so that the output does not depend on
+// the order of the files in a directory.
+std::vector<std::string> GetInputFiles() {
+  std::vector<std::string> files;
+  for (const absl::string_view input :
+       absl::StrSplit(absl::GetFlag(FLAGS_inputs), ',', absl::SkipEmpty())) {
+    if (file::IsDirectory(input, file::Defaults()).ok()) {
+      std::vector<std::string> directory_files;
+      CHECK_OK(file::Match(file::JoinPath(input, "*"), &directory_files,
+                           file::Defaults()));
+      for (const std::string& filename : directory_files) {
+        if (!file::IsDirectory(filename, file::Defaults()).ok()) {
+          files.push_back(filename);
+        }
+      }
+    } else {
+      files.push_back(std::string(input));
+    }
+  }
+  std::sort(files.begin(), files.end());
+  return files;
+}
+
+double Rate(int64_t count, double time) {
+  return time > 0.0 ? static_cast<double>(count) / time : 0.0;
+}
+
+std::string CsvHeader() {
+  return "name,status,objective,best_bound,gap_integral,deterministic_time,"
+         "wall_time,num_conflicts,num_branches,num_propagations,"
+         "num_lp_iterations,num_lns_neighborhoods,conflicts_per_second,"
+         "propagations_per_second,lp_iterations_per_second,"
+         "lns_neighborhoods_per_second,conflicts_per_dtime,"
+         "propagations_per_dtime,lp_iterations_per_dtime,"
+         "lns_neighborhoods_per_dtime\n";
+}
+
+std::string CsvLine(absl::string_view name, const CpSolverResponse& response) {
+  const int64_t num_propagations =
+      response.num_binary_propagations() + response.num_integer_propagations();
+  int64_t num_neighborhoods = 0;
+  for (const LnsGeneratorStatistics& stats : response.lns_statistics()) {
+    num_neighborhoods += stats.num_calls();
+  }
+  const double wall_time = response.wall_time();
+  const double dtime = response.deterministic_time();
+  return absl::StrFormat(
+      "%s,%s,%.9g,%.9g,%.9g,%.6f,%.6f,%d,%d,%d,%d,%d,%.6g,%.6g,%.6g,%.6g,%.6g,"
+      "%.6g,%.6g,%.6g\n",
+      name, CpSolverStatus_Name(response.status()), response.objective_value(),
+      response.best_objective_bound(), response.gap_integral(), dtime,
+      wall_time, response.num_conflicts(), response.num_branches(),
+      num_propagations, response.num_lp_iterations(), num_neighborhoods,
+      Rate(response.num_conflicts(), wall_time),
+      Rate(num_propagations, wall_time),
+      Rate(response.num_lp_iterations(), wall_time),
+      Rate(num_neighborhoods, wall_time), Rate(response.num_conflicts(), dtime),
+      Rate(num_propagations, dtime), Rate(response.num_lp_iterations(), dtime),
+      Rate(num_neighborhoods, dtime));
+}
+
+int Run() {
+  if (absl::GetFlag(FLAGS_inputs).empty()) {
+    LOG(FATAL) << "Please supply the models to solve with --inputs=";
+  }
+  SatParameters parameters;
+  parameters.set_max_deterministic_time(
+      absl::GetFlag(FLAGS_max_deterministic_time));
+  parameters.set_interleave_search(absl::GetFlag(FLAGS_interleave_search));
+  parameters.set_fill_lns_statistics_in_response(true);
+  if (!absl::GetFlag(FLAGS_params).empty()) {
+    CHECK(google::protobuf::TextFormat::MergeFromString(
+        absl::GetFlag(FLAGS_params), &parameters))
+        << absl::GetFlag(FLAGS_params);
+  }
+
+  std::string csv = CsvHeader();
+  for (const std::string& filename : GetInputFiles()) {
+    CpModelProto cp_model;
+    CHECK_OK(ReadFileToProto(filename, &cp_model));
+    const std::string name = cp_model.name().empty()
+                                 ? std::string(file::Basename(filename))
+                                 : cp_model.name();
+    LOG(INFO) << "Solving '" << name << "'.";
+
+    Model model;
+    model.Add(NewSatParameters(parameters));
+    const CpSolverResponse response = SolveCpModel(cp_model, &model);
+    const std::string line = CsvLine(name, response);
+    if (absl::GetFlag(FLAGS_output).empty()) {
+      // Output the lines as they come, a benchmark run can be long.
+      absl::PrintF("%s%s", csv, line);
+      csv.clear();
+    } else {
+      absl::StrAppend(&csv, line);
+    }
+  }
+
+  if (!absl::GetFlag(FLAGS_output).empty()) {
+    CHECK_OK(file::SetContents(absl::GetFlag(FLAGS_output), csv,
+                               file::Defaults()));
+  }
+  return EXIT_SUCCESS;
+}
+
+}  // namespace
+}  // namespace sat
+}  // namespace operations_research
+
+static const char kUsage[] =
+    "Usage: see flags.\n"
+    "This program benchmarks the CP-SAT solver on a set of models and outputs "
+    "its throughput in CSV format.";
+
+int main(int argc, char** argv) {
+  absl::InitializeLog();
+  absl::SetProgramUsageMessage(kUsage);
+  absl::ParseCommandLine(argc, argv);
+  return operations_research::sat::Run();
+}
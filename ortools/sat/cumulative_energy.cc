@@ -46,7 +46,8 @@ CumulativeEnergyConstraint::CumulativeEnergyConstraint(
     : capacity_(capacity),
       integer_trail_(model->GetOrCreate<IntegerTrail>()),
       helper_(helper),
-      demands_(demands) {
+      demands_(demands),
+      trail_(model->GetOrCreate<Trail>()) {
   const int num_tasks = helper_->NumTasks();
   task_to_start_event_.resize(num_tasks);
 }
@@ -59,6 +60,15 @@ void CumulativeEnergyConstraint::RegisterWith(GenericLiteralWatcher* watcher) {
 }
 
 bool CumulativeEnergyConstraint::Propagate() {
+  const int64_t timestamp = integer_trail_->timestamp();
+  const int trail_index = trail_->Index();
+  if (timestamp == last_propagation_timestamp_ &&
+      trail_index == last_propagation_trail_index_) {
+    return true;
+  }
+  last_propagation_timestamp_ = timestamp;
+  last_propagation_trail_index_ = trail_index;
+
   // This only uses one time direction, but the helper might be used elsewhere.
   // TODO(user): just keep the current direction?
   if (!helper_->SynchronizeAndSetTimeDirection(true)) return false;
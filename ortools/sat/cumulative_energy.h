@@ -69,6 +69,13 @@ class CumulativeEnergyConstraint : public PropagatorInterface {
   // Start event characteristics, by nondecreasing start time.
   std::vector<TaskTime> start_event_task_time_;
   std::vector<bool> start_event_is_present_;
+
+  // The solver state at the start of the last Propagate(). Since the
+  // propagation only depends on it, there is nothing to do if it did not
+  // change, which would be the case if the last call pushed nothing.
+  int64_t last_propagation_timestamp_ = -1;
+  int last_propagation_trail_index_ = -1;
+  const Trail* trail_;
 };
 
 // Given that the "tasks" are part of a cumulative constraint, this adds a
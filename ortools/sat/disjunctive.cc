@@ -19,7 +19,6 @@
 #include <utility>
 #include <vector>
 
-#include "absl/algorithm/container.h"
 #include "absl/log/check.h"
 #include "absl/types/span.h"
 #include "ortools/base/logging.h"
@@ -535,9 +534,19 @@ bool DisjunctiveOverloadChecker::PropagateSubwindow(
   theta_tree_.Reset(num_events);
 
   // Introduce events by increasing end_max, check for overloads.
-  // If end_max is the same, we want to add high start-min first.
-  absl::c_reverse(task_by_increasing_end_max_);
-  absl::c_stable_sort(task_by_increasing_end_max_);
+  // If end_max is the same, we want to add high start-min first, that is the
+  // events with the highest index since they are ordered by start-min.
+  //
+  // The vector is built by increasing start-min, so there is likely a good
+  // correlation with the end-max, hence the incremental sort. Note that this
+  // falls back to a regular sort if the vector is far from sorted.
+  IncrementalSort(task_by_increasing_end_max_.begin(),
+                  task_by_increasing_end_max_.end(),
+                  [this](TaskTime a, TaskTime b) {
+                    if (a.time != b.time) return a.time < b.time;
+                    return task_to_event_[a.task_index] >
+                           task_to_event_[b.task_index];
+                  });
   for (const auto task_time : task_by_increasing_end_max_) {
     const int current_task = task_time.task_index;
 
@@ -1375,8 +1384,11 @@ bool DisjunctiveEdgeFinding::PropagateSubwindow(IntegerValue window_end_min) {
   // If we have just 1 non-gray task, then this propagator does not propagate
   // more than the detectable precedences, so we abort early.
   if (task_by_increasing_end_max_.size() < 2) return true;
-  std::sort(task_by_increasing_end_max_.begin(),
-            task_by_increasing_end_max_.end());
+
+  // The window is sorted by start-min, so there is likely a good correlation
+  // with the end-max, hence the incremental sort.
+  IncrementalSort(task_by_increasing_end_max_.begin(),
+                  task_by_increasing_end_max_.end());
 
   // Set up theta tree.
   //
@@ -1385,8 +1397,8 @@ bool DisjunctiveEdgeFinding::PropagateSubwindow(IntegerValue window_end_min) {
   // - All the non-gray task
   // - All the non-gray task + at most one gray task.
   //
-  // TODO(user): it should be faster to initialize it all at once rather
-  // than calling AddOrUpdate() n times.
+  // We initialize it all at once in O(n) rather than calling AddOrUpdate() n
+  // times for O(n log n).
   const int window_size = window_.size();
   event_size_.clear();
   theta_tree_.Reset(window_size);
@@ -1396,13 +1408,15 @@ bool DisjunctiveEdgeFinding::PropagateSubwindow(IntegerValue window_end_min) {
     const IntegerValue energy_min = helper_->SizeMin(task);
     event_size_.push_back(energy_min);
     if (is_gray_[task]) {
-      theta_tree_.AddOrUpdateOptionalEvent(event, task_time.time, energy_min);
+      theta_tree_.DelayedAddOrUpdateOptionalEvent(event, task_time.time,
+                                                  energy_min);
     } else {
       non_gray_task_to_event_[task] = event;
-      theta_tree_.AddOrUpdateEvent(event, task_time.time, energy_min,
-                                   energy_min);
+      theta_tree_.DelayedAddOrUpdateEvent(event, task_time.time, energy_min,
+                                          energy_min);
     }
   }
+  theta_tree_.RecomputeTreeForDelayedOperations();
 
   // At each iteration we either transform a non-gray task into a gray one or
   // remove a gray task, so this loop is linear in complexity.
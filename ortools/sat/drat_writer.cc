@@ -13,49 +13,128 @@
 
 #include "ortools/sat/drat_writer.h"
 
+#include <memory>
 #include <string>
+#include <utility>
+
 #if !defined(__PORTABLE_PLATFORM__)
 #include "ortools/base/file.h"
 #include "ortools/base/helpers.h"
 #include "ortools/base/options.h"
+#include "ortools/base/threadpool.h"
 #endif  // !__PORTABLE_PLATFORM__
 #include "absl/log/check.h"
 #include "absl/strings/str_format.h"
+#include "absl/synchronization/mutex.h"
 #include "absl/types/span.h"
 #include "ortools/sat/sat_base.h"
 
 namespace operations_research {
 namespace sat {
 
+namespace {
+
+// Size above which the current buffer is handed over to the writer thread.
+constexpr int kBufferSize = 1 << 20;
+
+}  // namespace
+
+DratWriter::DratWriter(bool in_binary_format, File* output)
+    : in_binary_format_(in_binary_format), output_(output) {
+#if !defined(__PORTABLE_PLATFORM__)
+  if (output_ != nullptr) {
+    writer_thread_ = std::make_unique<ThreadPool>("DratWriter", 1);
+    writer_thread_->StartWorkers();
+    writer_thread_->Schedule([this]() { WriterLoop(); });
+  }
+#endif  // !__PORTABLE_PLATFORM__
+}
+
 DratWriter::~DratWriter() {
   if (output_ != nullptr) {
 #if !defined(__PORTABLE_PLATFORM__)
-    CHECK_OK(file::WriteString(output_, buffer_, file::Defaults()));
+    FlushBuffer();
+    {
+      absl::MutexLock mutex_lock(&mutex_);
+      done_ = true;
+    }
+
+    // This waits for the writer thread to finish writing pending_.
+    writer_thread_.reset();
     CHECK_OK(output_->Close(file::Defaults()));
 #endif  // !__PORTABLE_PLATFORM__
   }
 }
 
 void DratWriter::AddClause(absl::Span<const Literal> clause) {
+  if (in_binary_format_) buffer_ += 'a';
   WriteClause(clause);
 }
 
 void DratWriter::DeleteClause(absl::Span<const Literal> clause) {
-  buffer_ += "d ";
+  buffer_ += in_binary_format_ ? "d" : "d ";
   WriteClause(clause);
 }
 
 void DratWriter::WriteClause(absl::Span<const Literal> clause) {
-  for (const Literal literal : clause) {
-    absl::StrAppendFormat(&buffer_, "%d ", literal.SignedValue());
+  if (in_binary_format_) {
+    // In the binary format, each literal l is encoded as 2 * |l| + (l < 0)
+    // using a variable length encoding with 7 bits per byte, and the clause is
+    // terminated by a zero byte.
+    for (const Literal literal : clause) {
+      const int signed_value = literal.SignedValue();
+      unsigned int value = signed_value > 0 ? 2 * signed_value
+                                            : 2 * -signed_value + 1;
+      while (value > 127) {
+        buffer_ += static_cast<char>((value & 127) | 128);
+        value >>= 7;
+      }
+      buffer_ += static_cast<char>(value);
+    }
+    buffer_ += static_cast<char>(0);
+  } else {
+    for (const Literal literal : clause) {
+      absl::StrAppendFormat(&buffer_, "%d ", literal.SignedValue());
+    }
+    buffer_ += "0\n";
   }
-  buffer_ += "0\n";
-  if (buffer_.size() > 10000) {
+  if (buffer_.size() > kBufferSize) FlushBuffer();
+}
+
+void DratWriter::FlushBuffer() {
 #if !defined(__PORTABLE_PLATFORM__)
-    CHECK_OK(file::WriteString(output_, buffer_, file::Defaults()));
+  if (output_ != nullptr) {
+    // Must only be called while locking mutex_.
+    const auto pending_is_empty = [this]() { return pending_.empty(); };
+    absl::MutexLock mutex_lock(&mutex_);
+    mutex_.Await(absl::Condition(&pending_is_empty));
+
+    // We swap so that the memory of the buffer written last is reused.
+    std::swap(buffer_, pending_);
+    return;
+  }
 #endif  // !__PORTABLE_PLATFORM__
-    buffer_.clear();
+  buffer_.clear();
+}
+
+void DratWriter::WriterLoop() {
+#if !defined(__PORTABLE_PLATFORM__)
+  // Must only be called while locking mutex_.
+  const auto has_work = [this]() { return done_ || !pending_.empty(); };
+  std::string to_write;
+  while (true) {
+    {
+      absl::MutexLock mutex_lock(&mutex_);
+      mutex_.Await(absl::Condition(&has_work));
+      if (pending_.empty()) return;  // done_ must be true.
+
+      // Leave an empty buffer with some capacity in pending_.
+      to_write.clear();
+      std::swap(to_write, pending_);
+    }
+    CHECK_OK(file::WriteString(output_, to_write, file::Defaults()));
   }
+#endif  // !__PORTABLE_PLATFORM__
 }
 
 }  // namespace sat
@@ -14,13 +14,17 @@
 #ifndef OR_TOOLS_SAT_DRAT_WRITER_H_
 #define OR_TOOLS_SAT_DRAT_WRITER_H_
 
+#include <memory>
 #include <string>
 
 #if !defined(__PORTABLE_PLATFORM__)
 #include "ortools/base/file.h"
+#include "ortools/base/threadpool.h"
 #else
 class File {};
 #endif  // !__PORTABLE_PLATFORM__
+#include "absl/base/thread_annotations.h"
+#include "absl/synchronization/mutex.h"
 #include "absl/types/span.h"
 #include "ortools/sat/sat_base.h"
 
@@ -33,10 +37,13 @@ namespace sat {
 //
 // Note that DRAT proofs are often huge (can be GB), and take about as much time
 // to check as it takes for the solver to find the proof in the first place!
+//
+// To not slow down the solver, the proof is written by a background thread:
+// the clauses are appended to an in-memory buffer which is handed over to the
+// writer thread once it is large enough, while a new one is being filled.
 class DratWriter {
  public:
-  DratWriter(bool in_binary_format, File* output)
-      : in_binary_format_(in_binary_format), output_(output) {}
+  DratWriter(bool in_binary_format, File* output);
   ~DratWriter();
 
   // Writes a new clause to the DRAT output. Note that the RAT property is only
@@ -51,11 +58,27 @@ class DratWriter {
  private:
   void WriteClause(absl::Span<const Literal> clause);
 
-  // TODO(user): Support binary format as proof in text format can be large.
+  // Hands over buffer_ to the writer thread. This blocks if the previous
+  // buffer has not been picked up yet.
+  void FlushBuffer();
+
+  // Main loop of the writer thread, returns once done_ is true and there is
+  // nothing left to write.
+  void WriterLoop();
+
   bool in_binary_format_;
   File* output_;
 
+  // The buffer currently filled by the solver thread.
   std::string buffer_;
+
+  absl::Mutex mutex_;
+  std::string pending_ ABSL_GUARDED_BY(mutex_);
+  bool done_ ABSL_GUARDED_BY(mutex_) = false;
+
+#if !defined(__PORTABLE_PLATFORM__)
+  std::unique_ptr<ThreadPool> writer_thread_;
+#endif  // !__PORTABLE_PLATFORM__
 };
 
 }  // namespace sat
@@ -24,6 +24,7 @@
 #include <utility>
 #include <vector>
 
+#include "absl/container/flat_hash_map.h"
 #include "absl/log/check.h"
 #include "absl/strings/str_cat.h"
 #include "absl/types/span.h"
@@ -460,7 +461,8 @@ struct SortEncodingNodePointers {
 
 EncodingNode* LazyMergeAllNodeWithPQAndIncreaseLb(
     Coefficient weight, const std::vector<EncodingNode*>& nodes,
-    SatSolver* solver, std::deque<EncodingNode>* repository) {
+    SatSolver* solver, std::deque<EncodingNode>* repository,
+    EncodingNodeMergeCache* merge_cache, int* num_reused) {
   std::priority_queue<EncodingNode*, std::vector<EncodingNode*>,
                       SortEncodingNodePointers>
       pq(nodes.begin(), nodes.end());
@@ -469,8 +471,24 @@ EncodingNode* LazyMergeAllNodeWithPQAndIncreaseLb(
     pq.pop();
     EncodingNode* b = pq.top();
     pq.pop();
-    repository->push_back(LazyMerge(a, b, solver));
-    pq.push(&repository->back());
+    if (merge_cache == nullptr) {
+      repository->push_back(LazyMerge(a, b, solver));
+      pq.push(&repository->back());
+      continue;
+    }
+
+    // Note that a cached node is only valid if its children bounds did not
+    // change since it was created.
+    EncodingNode*& cached =
+        (*merge_cache)[std::make_pair(std::min(a, b), std::max(a, b))];
+    if (cached != nullptr && cached->lb() == a->lb() + b->lb() &&
+        cached->ub() == a->ub() + b->ub()) {
+      if (num_reused != nullptr) ++*num_reused;
+    } else {
+      repository->push_back(LazyMerge(a, b, solver));
+      cached = &repository->back();
+    }
+    pq.push(cached);
   }
 
   CHECK_EQ(pq.size(), 2);
@@ -784,9 +802,12 @@ bool ObjectiveEncoder::ProcessCore(absl::Span<const Literal> core,
     return !sat_solver_->ModelIsUnsat();
   }
 
+  int num_reused = 0;
   nodes_.push_back(LazyMergeAllNodeWithPQAndIncreaseLb(
-      min_weight, to_merge, sat_solver_, &repository_));
+      min_weight, to_merge, sat_solver_, &repository_, &merge_cache_,
+      &num_reused));
   absl::StrAppend(info, " d:", nodes_.back()->depth());
+  if (num_reused > 0) absl::StrAppend(info, " reused:", num_reused);
   return !sat_solver_->ModelIsUnsat();
 }
 
@@ -27,6 +27,7 @@
 #include <utility>
 #include <vector>
 
+#include "absl/container/flat_hash_map.h"
 #include "absl/log/check.h"
 #include "absl/types/span.h"
 #include "ortools/base/logging.h"
@@ -200,12 +201,23 @@ EncodingNode* MergeAllNodesWithDeque(Coefficient upper_bound,
                                      SatSolver* solver,
                                      std::deque<EncodingNode>* repository);
 
+// Cache of the nodes created by LazyMerge(), indexed by their children (in
+// increasing pointer order), so that an already encoded sum can be reused
+// instead of being encoded again with new literals.
+using EncodingNodeMergeCache =
+    absl::flat_hash_map<std::pair<EncodingNode*, EncodingNode*>, EncodingNode*>;
+
 // Same as MergeAllNodesWithDeque() but use a priority queue to merge in
 // priority nodes with smaller sizes. This also enforce that the sum of nodes
 // is greater than its lower bound.
+//
+// If merge_cache is not null, the intermediate nodes are looked up there
+// before being created, and the new ones are added to it. The number of reused
+// nodes is added to num_reused if it is not null.
 EncodingNode* LazyMergeAllNodeWithPQAndIncreaseLb(
     Coefficient weight, const std::vector<EncodingNode*>& nodes,
-    SatSolver* solver, std::deque<EncodingNode>* repository);
+    SatSolver* solver, std::deque<EncodingNode>* repository,
+    EncodingNodeMergeCache* merge_cache = nullptr, int* num_reused = nullptr);
 
 // Reduces the nodes using the now fixed literals, update the lower-bound, and
 // returns the set of assumptions for the next round of the core-based
@@ -270,6 +282,10 @@ class ObjectiveEncoder {
   std::vector<EncodingNode*> nodes_;
   std::deque<EncodingNode> repository_;
 
+  // With weights, the same nodes often appear together in many cores, so we
+  // reuse the partial sums we already encoded for them.
+  EncodingNodeMergeCache merge_cache_;
+
   const SatParameters& params_;
   SatSolver* sat_solver_;
   BinaryImplicationGraph* implications_;
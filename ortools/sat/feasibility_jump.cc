@@ -33,6 +33,7 @@
 #include "absl/random/bit_gen_ref.h"
 #include "absl/random/distributions.h"
 #include "absl/strings/str_cat.h"
+#include "absl/synchronization/mutex.h"
 #include "absl/types/span.h"
 #include "ortools/algorithms/binary_search.h"
 #include "ortools/base/logging.h"
@@ -102,6 +103,43 @@ std::pair<int64_t, double> JumpTable::GetJump(int var) {
   return std::make_pair(deltas_[var], scores_[var]);
 }
 
+std::unique_ptr<LsEvaluator> SharedLinearEvaluatorViews::NewEvaluator(
+    const LinearModel& linear_model, const SatParameters& params) {
+  // For now we just disable or enable it.
+  // But in the future we might have more variation.
+  const Key key = {
+      .use_linear_model = params.feasibility_jump_linearization_level() > 0,
+      .max_expanded_constraint_size =
+          params.feasibility_jump_max_expanded_constraint_size()};
+  const auto create = [&linear_model, &params, &key](
+                          std::shared_ptr<
+                              const LinearIncrementalEvaluator::CompactView>
+                              view) {
+    if (!key.use_linear_model) {
+      return std::make_unique<LsEvaluator>(linear_model.model_proto(), params,
+                                           std::move(view));
+    }
+    return std::make_unique<LsEvaluator>(
+        linear_model.model_proto(), params, linear_model.ignored_constraints(),
+        linear_model.additional_constraints(), std::move(view));
+  };
+
+  std::shared_ptr<const LinearIncrementalEvaluator::CompactView> view;
+  {
+    absl::MutexLock lock(&mutex_);
+    auto it = views_.begin();
+    while (it != views_.end() && !(it->first == key)) ++it;
+    if (it != views_.end()) view = it->second.lock();
+    if (view == nullptr) {
+      std::unique_ptr<LsEvaluator> evaluator = create(nullptr);
+      if (it == views_.end()) it = views_.insert(it, {key, {}});
+      it->second = evaluator->LinearEvaluator().compact_view();
+      return evaluator;
+    }
+  }
+  return create(std::move(view));
+}
+
 FeasibilityJumpSolver::~FeasibilityJumpSolver() {
   stat_tables_->AddTimingStat(*this);
   stat_tables_->AddLsStat(name(), num_batches_, num_restarts_,
@@ -123,17 +161,7 @@ FeasibilityJumpSolver::~FeasibilityJumpSolver() {
 void FeasibilityJumpSolver::Initialize() {
   is_initialized_ = true;
 
-  // For now we just disable or enable it.
-  // But in the future we might have more variation.
-  if (params_.feasibility_jump_linearization_level() == 0) {
-    evaluator_ =
-        std::make_unique<LsEvaluator>(linear_model_->model_proto(), params_);
-  } else {
-    evaluator_ =
-        std::make_unique<LsEvaluator>(linear_model_->model_proto(), params_,
-                                      linear_model_->ignored_constraints(),
-                                      linear_model_->additional_constraints());
-  }
+  evaluator_ = shared_views_->NewEvaluator(*linear_model_, params_);
 
   const int num_variables = linear_model_->model_proto().variables().size();
   var_domains_.resize(num_variables);
@@ -360,8 +388,10 @@ std::function<void()> FeasibilityJumpSolver::GenerateTask(int64_t /*task_id*/) {
       const SharedSolutionRepository<int64_t>& repo =
           shared_response_->SolutionsRepository();
       CHECK_GT(repo.NumSolutions(), 0);
-      const SharedSolutionRepository<int64_t>::Solution solution =
-          repo.GetRandomBiasedSolution(random_);
+      const std::shared_ptr<const SharedSolutionRepository<int64_t>::Solution>
+          solution_ptr = repo.GetRandomBiasedSolution(random_);
+      const SharedSolutionRepository<int64_t>::Solution& solution =
+          *solution_ptr;
       if (solution.rank < last_solution_rank_) {
         evaluator_->OverwriteCurrentSolution(solution.variable_values);
         should_recompute_violations = true;
@@ -25,6 +25,7 @@
 
 #include "absl/functional/any_invocable.h"
 #include "absl/functional/bind_front.h"
+#include "absl/synchronization/mutex.h"
 #include "absl/types/span.h"
 #include "ortools/sat/constraint_violation.h"
 #include "ortools/sat/linear_model.h"
@@ -39,6 +40,39 @@ namespace operations_research::sat {
 
 class CompoundMoveBuilder;
 
+// Creates LsEvaluator for a given LinearModel, sharing their immutable linear
+// part between all the evaluators that are compiled the same way. This is
+// thread-safe.
+//
+// Note that only the linear constraints are shared, the other constraints and
+// all the mutable state (activities, violations, ...) are per evaluator.
+class SharedLinearEvaluatorViews {
+ public:
+  std::unique_ptr<LsEvaluator> NewEvaluator(const LinearModel& linear_model,
+                                            const SatParameters& params);
+
+ private:
+  // The parameters that change how an LsEvaluator is compiled.
+  struct Key {
+    bool use_linear_model;
+    int max_expanded_constraint_size;
+    bool operator==(const Key& o) const {
+      return use_linear_model == o.use_linear_model &&
+             max_expanded_constraint_size == o.max_expanded_constraint_size;
+    }
+  };
+
+  // We keep the mutex while creating the first evaluator of a given key so
+  // that the other workers can reuse its view rather than computing it too.
+  //
+  // We only keep weak references so that the memory is reclaimed once all the
+  // evaluators using a view are gone.
+  absl::Mutex mutex_;
+  std::vector<std::pair<
+      Key, std::weak_ptr<const LinearIncrementalEvaluator::CompactView>>>
+      views_ ABSL_GUARDED_BY(mutex_);
+};
+
 // This class lazily caches the results of `compute_jump(var)` which returns a
 // <delta, score> pair.
 // Variables' scores can be manually modified using MutableScores (if the
@@ -96,13 +130,14 @@ class JumpTable {
 // value an integer variable should move to (its jump value). For binary, it
 // can only be swapped, so the situation is easier.
 //
-// TODO(user): If we have more than one of these solver, we might want to share
-// the evaluator memory between them. Right now we basically keep a copy of the
-// model and its transpose for each FeasibilityJumpSolver.
+// The immutable linear part of the evaluators (the model and its transpose) is
+// shared via the SharedLinearEvaluatorViews between all the solvers that use
+// the same LinearModel and compilation parameters.
 class FeasibilityJumpSolver : public SubSolver {
  public:
   FeasibilityJumpSolver(const std::string name, SubSolver::SubsolverType type,
                         const LinearModel* linear_model, SatParameters params,
+                        SharedLinearEvaluatorViews* shared_views,
                         ModelSharedTimeLimit* shared_time_limit,
                         SharedResponseManager* shared_response,
                         SharedBoundsManager* shared_bounds,
@@ -111,6 +146,7 @@ class FeasibilityJumpSolver : public SubSolver {
       : SubSolver(name, type),
         linear_model_(linear_model),
         params_(params),
+        shared_views_(shared_views),
         shared_time_limit_(shared_time_limit),
         shared_response_(shared_response),
         shared_bounds_(shared_bounds),
@@ -219,6 +255,7 @@ class FeasibilityJumpSolver : public SubSolver {
 
   const LinearModel* linear_model_;
   SatParameters params_;
+  SharedLinearEvaluatorViews* shared_views_;
   ModelSharedTimeLimit* shared_time_limit_;
   SharedResponseManager* shared_response_;
   SharedBoundsManager* shared_bounds_ = nullptr;
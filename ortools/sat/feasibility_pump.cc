@@ -210,7 +210,12 @@ void FeasibilityPump::MaybePushToRepo() {
         lp_solution[model_var] = GetLPSolutionValue(positive_var);
       }
     }
-    incomplete_solutions_->AddSolution(lp_solution);
+    if (integer_solution_is_feasible_) {
+      incomplete_solutions_->AddSolution(lp_solution);
+    } else {
+      incomplete_solutions_->AddSolution(std::move(lp_solution));
+      return;
+    }
   }
 
   if (integer_solution_is_feasible_) {
@@ -222,7 +227,7 @@ void FeasibilityPump::MaybePushToRepo() {
         lp_solution[model_var] = GetIntegerSolutionValue(positive_var);
       }
     }
-    incomplete_solutions_->AddSolution(lp_solution);
+    incomplete_solutions_->AddSolution(std::move(lp_solution));
   }
 }
 
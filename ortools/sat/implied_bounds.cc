@@ -20,6 +20,7 @@
 #include <array>
 #include <bitset>
 #include <string>
+#include <tuple>
 #include <utility>
 #include <vector>
 
@@ -57,6 +58,10 @@ ImpliedBounds::~ImpliedBounds() {
   stats.push_back({"implied_bound/num_stored", bounds_.size()});
   stats.push_back(
       {"implied_bound/num_stored_with_view", num_enqueued_in_var_to_bounds_});
+  stats.push_back({"implied_bound/num_memory_reductions",
+                   num_memory_reductions_});
+  stats.push_back({"implied_bound/num_ignored_because_of_memory_limit",
+                   num_ignored_because_of_memory_limit_});
   shared_stats_->AddStats(stats);
 }
 
@@ -75,8 +80,15 @@ bool ImpliedBounds::Add(Literal literal, IntegerLiteral integer_literal) {
   // it.
   if (root_lb + 1 >= integer_trail_->LevelZeroUpperBound(var)) return true;
 
-  // Add or update the current bound.
+  // Add or update the current bound. If we are at the memory limit, we only
+  // update the existing relations.
   const auto key = std::make_pair(literal.Index(), var);
+  const size_t max_num_entries = parameters_.implied_bounds_max_num_entries();
+  if (bounds_.size() >= max_num_entries && !bounds_.contains(key) &&
+      !ReduceMemoryUsage()) {
+    ++num_ignored_because_of_memory_limit_;
+    return true;
+  }
   auto insert_result = bounds_.insert({key, integer_literal.bound});
   if (!insert_result.second) {
     if (insert_result.first->second < integer_literal.bound) {
@@ -149,47 +161,110 @@ bool ImpliedBounds::Add(Literal literal, IntegerLiteral integer_literal) {
   // If we have a new implied bound and the literal has a view, add it to
   // var_to_bounds_. Note that we might add more than one entry with the same
   // literal_view, and we will later need to lazily clean the vector up.
+  ImpliedBoundEntry entry;
   if (integer_encoder_->GetLiteralView(literal) != kNoIntegerVariable) {
-    if (var_to_bounds_.size() <= var) {
-      var_to_bounds_.resize(var.value() + 1);
-      has_implied_bounds_.Resize(var + 1);
-    }
-    ++num_enqueued_in_var_to_bounds_;
-    has_implied_bounds_.Set(var);
-    var_to_bounds_[var].push_back({integer_encoder_->GetLiteralView(literal),
-                                   integer_literal.bound, true});
+    entry = {integer_encoder_->GetLiteralView(literal), integer_literal.bound,
+             true};
   } else if (integer_encoder_->GetLiteralView(literal.Negated()) !=
              kNoIntegerVariable) {
-    if (var_to_bounds_.size() <= var) {
-      var_to_bounds_.resize(var.value() + 1);
-      has_implied_bounds_.Resize(var + 1);
-    }
-    ++num_enqueued_in_var_to_bounds_;
-    has_implied_bounds_.Set(var);
-    var_to_bounds_[var].push_back(
-        {integer_encoder_->GetLiteralView(literal.Negated()),
-         integer_literal.bound, false});
+    entry = {integer_encoder_->GetLiteralView(literal.Negated()),
+             integer_literal.bound, false};
+  } else {
+    return true;
+  }
+  if (var_to_bounds_.size() <= var) {
+    var_to_bounds_.resize(var.value() + 1);
+    var_to_bounds_clean_size_.resize(var.value() + 1, 0);
+    has_implied_bounds_.Resize(var + 1);
+  }
+  ++num_enqueued_in_var_to_bounds_;
+  has_implied_bounds_.Set(var);
+  std::vector<ImpliedBoundEntry>& ref = var_to_bounds_[var];
+  ref.push_back(entry);
+
+  // Make sure the duplicates do not accumulate between two calls to
+  // GetImpliedBounds().
+  if (ref.size() >= 2 * std::max<size_t>(var_to_bounds_clean_size_[var], 8)) {
+    CleanUpEntries(integer_trail_->LevelZeroLowerBound(var), ref);
+    var_to_bounds_clean_size_[var] = ref.size();
   }
   return true;
 }
 
-const std::vector<ImpliedBoundEntry>& ImpliedBounds::GetImpliedBounds(
-    IntegerVariable var) {
-  if (var >= var_to_bounds_.size()) return empty_implied_bounds_;
+bool ImpliedBounds::ReduceMemoryUsage() {
+  const int64_t num_enqueues = integer_trail_->num_level_zero_enqueues();
+  if (num_enqueues == num_level_zero_enqueues_at_last_reduction_) {
+    return bounds_.size() <
+           static_cast<size_t>(parameters_.implied_bounds_max_num_entries());
+  }
+  num_level_zero_enqueues_at_last_reduction_ = num_enqueues;
+  ++num_memory_reductions_;
 
-  // Lazily remove obsolete entries from the vector.
-  //
-  // TODO(user): Check no duplicate and remove old entry if the enforcement
-  // is tighter.
+  for (auto it = bounds_.begin(); it != bounds_.end();) {
+    if (it->second <= integer_trail_->LevelZeroLowerBound(it->first.second)) {
+      bounds_.erase(it++);
+    } else {
+      ++it;
+    }
+  }
+  for (const IntegerVariable var :
+       has_implied_bounds_.PositionsSetAtLeastOnce()) {
+    std::vector<ImpliedBoundEntry>& ref = var_to_bounds_[var];
+    CleanUpEntries(integer_trail_->LevelZeroLowerBound(var), ref);
+    ref.shrink_to_fit();
+    var_to_bounds_clean_size_[var] = ref.size();
+  }
+  return bounds_.size() <
+         static_cast<size_t>(parameters_.implied_bounds_max_num_entries());
+}
+
+void ImpliedBounds::CleanUpEntries(IntegerValue root_lb,
+                                   std::vector<ImpliedBoundEntry>& ref) {
+  // Remove obsolete entries.
   int new_size = 0;
-  std::vector<ImpliedBoundEntry>& ref = var_to_bounds_[var];
-  const IntegerValue root_lb = integer_trail_->LevelZeroLowerBound(var);
   for (const ImpliedBoundEntry& entry : ref) {
     if (entry.lower_bound <= root_lb) continue;
     ref[new_size++] = entry;
   }
   ref.resize(new_size);
 
+  // Only keep the best bound of each (literal_view, is_positive) pair.
+  std::sort(ref.begin(), ref.end(),
+            [](const ImpliedBoundEntry& a, const ImpliedBoundEntry& b) {
+              return std::tie(a.literal_view, a.is_positive) <
+                     std::tie(b.literal_view, b.is_positive);
+            });
+  new_size = 0;
+  for (const ImpliedBoundEntry& entry : ref) {
+    if (new_size > 0 && ref[new_size - 1].literal_view == entry.literal_view &&
+        ref[new_size - 1].is_positive == entry.is_positive) {
+      ref[new_size - 1].lower_bound =
+          std::max(ref[new_size - 1].lower_bound, entry.lower_bound);
+      continue;
+    }
+    ref[new_size++] = entry;
+  }
+  ref.resize(new_size);
+}
+
+const std::vector<ImpliedBoundEntry>& ImpliedBounds::GetImpliedBounds(
+    IntegerVariable var) {
+  if (var >= var_to_bounds_.size()) return empty_implied_bounds_;
+
+  // Lazily remove obsolete and duplicate entries from the vector.
+  std::vector<ImpliedBoundEntry>& ref = var_to_bounds_[var];
+  const IntegerValue root_lb = integer_trail_->LevelZeroLowerBound(var);
+  if (ref.size() > var_to_bounds_clean_size_[var]) {
+    CleanUpEntries(root_lb, ref);
+  } else {
+    int new_size = 0;
+    for (const ImpliedBoundEntry& entry : ref) {
+      if (entry.lower_bound <= root_lb) continue;
+      ref[new_size++] = entry;
+    }
+    ref.resize(new_size);
+  }
+  var_to_bounds_clean_size_[var] = ref.size();
   return ref;
 }
 
@@ -48,30 +48,36 @@ namespace sat {
 // This is meant to be used in the cut generation code when it make sense: if we
 // have BoolVar => X >= bound, we can always lower bound the variable X by
 // (bound - X_lb) * BoolVar + X_lb, and that can lead to stronger cuts.
+//
+// Note that the fields are ordered so that an entry only takes 16 bytes.
 struct ImpliedBoundEntry {
-  // An integer variable in [0, 1]. When at 1, then the IntegerVariable
-  // corresponding to this entry must be greater or equal to the given lower
-  // bound.
-  IntegerVariable literal_view = kNoIntegerVariable;
+  // When literal_view is at 1, then the IntegerVariable corresponding to this
+  // entry must be greater or equal to this lower bound.
   IntegerValue lower_bound = IntegerValue(0);
 
+  // An integer variable in [0, 1].
+  IntegerVariable literal_view = kNoIntegerVariable;
+
   // If false, it is when the literal_view is zero that the lower bound is
   // valid.
   bool is_positive = true;
 
   // These constructors are needed for OR-Tools.
   ImpliedBoundEntry(IntegerVariable lit, IntegerValue lb, bool positive)
-      : literal_view(lit), lower_bound(lb), is_positive(positive) {}
+      : lower_bound(lb), literal_view(lit), is_positive(positive) {}
 
   ImpliedBoundEntry()
-      : literal_view(kNoIntegerVariable), lower_bound(0), is_positive(true) {}
+      : lower_bound(0), literal_view(kNoIntegerVariable), is_positive(true) {}
 };
+static_assert(sizeof(ImpliedBoundEntry) == 16);
 
 // Maintains all the implications of the form Literal => IntegerLiteral. We
 // collect these implication at model loading, during probing and during search.
 //
-// TODO(user): This can quickly use up too much memory. Add some limit in place.
-// In particular, each time we have literal => integer_literal we should avoid
+// The number of stored relations is limited by the
+// implied_bounds_max_num_entries parameter, see ReduceMemoryUsage().
+//
+// TODO(user): Each time we have literal => integer_literal we should avoid
 // storing the same integer_literal for all other_literal for which
 // other_literal => literal. For this we need to interact with the
 // BinaryImplicationGraph.
@@ -114,7 +120,8 @@ class ImpliedBounds {
   // must be equal to first decision (we currently do not CHECK that).
   bool ProcessIntegerTrail(Literal first_decision);
 
-  // Returns all the implied bounds stored for the given variable.
+  // Returns all the implied bounds stored for the given variable. There is at
+  // most one entry per (literal_view, is_positive) pair, with the best bound.
   // Note that only literal with an IntegerView are considered here.
   const std::vector<ImpliedBoundEntry>& GetImpliedBounds(IntegerVariable var);
 
@@ -139,6 +146,17 @@ class ImpliedBounds {
   bool EnqueueNewDeductions();
 
  private:
+  // Removes all the stored relations that are no longer stronger than the
+  // level zero bounds. This is only done when we reach the memory limit, and
+  // at most once per new level zero bounds. Returns true if there is room for
+  // new relations afterwards.
+  bool ReduceMemoryUsage();
+
+  // Removes from ref the entries with a bound <= root_lb and only keeps the
+  // best entry per (literal_view, is_positive) pair.
+  static void CleanUpEntries(IntegerValue root_lb,
+                             std::vector<ImpliedBoundEntry>& ref);
+
   const SatParameters& parameters_;
   SatSolver* sat_solver_;
   IntegerTrail* integer_trail_;
@@ -150,23 +168,30 @@ class ImpliedBounds {
 
   // For each (Literal, IntegerVariable) the best lower bound implied by this
   // literal. Note that there is no need to store any entries that do not
-  // improve on the level zero lower bound.
-  //
-  // TODO(user): we could lazily remove old entries to save a bit of space if
-  // many deduction where made at level zero.
+  // improve on the level zero lower bound, these are removed by
+  // ReduceMemoryUsage() when needed.
   absl::flat_hash_map<std::pair<LiteralIndex, IntegerVariable>, IntegerValue>
       bounds_;
 
+  // The value of IntegerTrail::num_level_zero_enqueues() at the last
+  // ReduceMemoryUsage(), there is no point calling it again if it didn't
+  // change.
+  int64_t num_level_zero_enqueues_at_last_reduction_ = -1;
+
   // Note(user): This is currently only used during cut generation, so only the
   // Literal with an IntegerView that can be used in the LP relaxation need to
   // be kept here.
   //
+  // The entries of a variable are cleaned up lazily in GetImpliedBounds() or
+  // when var_to_bounds_clean_size_ doubles.
+  //
   // TODO(user): Use inlined vectors. Even better, we actually only process
   // all variables at once, so no need to organize it by IntegerVariable even
   // if that might be more friendly cache-wise.
   std::vector<ImpliedBoundEntry> empty_implied_bounds_;
   absl::StrongVector<IntegerVariable, std::vector<ImpliedBoundEntry>>
       var_to_bounds_;
+  absl::StrongVector<IntegerVariable, int> var_to_bounds_clean_size_;
   SparseBitset<IntegerVariable> has_implied_bounds_;
 
   // Stores implied values per variable.
@@ -178,6 +203,8 @@ class ImpliedBounds {
   // Stats.
   int64_t num_deductions_ = 0;
   int64_t num_enqueued_in_var_to_bounds_ = 0;
+  int64_t num_memory_reductions_ = 0;
+  int64_t num_ignored_because_of_memory_limit_ = 0;
 };
 
 class ElementEncodings {
@@ -20,6 +20,7 @@
 #include <limits>
 #include <ostream>
 #include <string>
+#include <typeinfo>
 #include <utility>
 #include <vector>
 
@@ -30,7 +31,10 @@
 #include "absl/container/inlined_vector.h"
 #include "absl/log/check.h"
 #include "absl/meta/type_traits.h"
+#include "absl/strings/ascii.h"
 #include "absl/strings/str_cat.h"
+#include "absl/strings/string_view.h"
+#include "absl/time/clock.h"
 #include "absl/types/span.h"
 #include "ortools/base/logging.h"
 #include "ortools/base/strong_vector.h"
@@ -790,6 +794,7 @@ void IntegerTrail::Untrail(const Trail& trail, int literal_trail_index) {
     var_lbs_[entry.var] = integer_trail_[entry.prev_trail_index].bound;
   }
   integer_trail_.resize(target);
+  reason_indices_.resize(target);
 
   // Clear reason.
   const int old_size = reason_decision_levels_[level];
@@ -822,6 +827,7 @@ void IntegerTrail::ReserveSpaceForNumVariables(int num_vars) {
   var_lbs_.reserve(size);
   var_trail_index_.reserve(size);
   integer_trail_.reserve(size);
+  reason_indices_.reserve(size);
   var_trail_index_cache_.reserve(size);
   tmp_var_to_trail_index_in_queue_.reserve(size);
 }
@@ -840,12 +846,14 @@ IntegerVariable IntegerTrail::AddIntegerVariable(IntegerValue lower_bound,
   var_lbs_.push_back(lower_bound);
   var_trail_index_.push_back(integer_trail_.size());
   integer_trail_.push_back({lower_bound, i});
+  reason_indices_.push_back(0);
   domains_->push_back(Domain(lower_bound.value(), upper_bound.value()));
 
   CHECK_EQ(NegationOf(i).value(), var_lbs_.size());
   var_lbs_.push_back(-upper_bound);
   var_trail_index_.push_back(integer_trail_.size());
   integer_trail_.push_back({-upper_bound, NegationOf(i)});
+  reason_indices_.push_back(0);
 
   var_trail_index_cache_.resize(var_lbs_.size(), integer_trail_.size());
   tmp_var_to_trail_index_in_queue_.resize(var_lbs_.size(), 0);
@@ -1442,8 +1450,8 @@ void IntegerTrail::EnqueueLiteralInternal(
 
   integer_trail_.push_back({/*bound=*/IntegerValue(0),
                             /*var=*/kNoIntegerVariable,
-                            /*prev_trail_index=*/-1,
-                            /*reason_index=*/reason_index});
+                            /*prev_trail_index=*/-1});
+  reason_indices_.push_back(reason_index);
 
   trail_->Enqueue(literal, propagator_id_);
 }
@@ -1689,14 +1697,14 @@ bool IntegerTrail::EnqueueInternal(
                                    integer_reason.end());
     }
   } else {
-    reason_index = integer_trail_[trail_index_with_same_reason].reason_index;
+    reason_index = reason_indices_[trail_index_with_same_reason];
   }
 
   const int prev_trail_index = var_trail_index_[i_lit.var];
   integer_trail_.push_back({/*bound=*/i_lit.bound,
                             /*var=*/i_lit.var,
-                            /*prev_trail_index=*/prev_trail_index,
-                            /*reason_index=*/reason_index});
+                            /*prev_trail_index=*/prev_trail_index});
+  reason_indices_.push_back(reason_index);
 
   var_lbs_[i_lit.var] = i_lit.bound;
   var_trail_index_[i_lit.var] = integer_trail_.size() - 1;
@@ -1750,8 +1758,8 @@ bool IntegerTrail::EnqueueAssociatedIntegerLiteral(IntegerLiteral i_lit,
   const int prev_trail_index = var_trail_index_[i_lit.var];
   integer_trail_.push_back({/*bound=*/i_lit.bound,
                             /*var=*/i_lit.var,
-                            /*prev_trail_index=*/prev_trail_index,
-                            /*reason_index=*/reason_index});
+                            /*prev_trail_index=*/prev_trail_index});
+  reason_indices_.push_back(reason_index);
 
   var_lbs_[i_lit.var] = i_lit.bound;
   var_trail_index_[i_lit.var] = integer_trail_.size() - 1;
@@ -1759,7 +1767,7 @@ bool IntegerTrail::EnqueueAssociatedIntegerLiteral(IntegerLiteral i_lit,
 }
 
 void IntegerTrail::ComputeLazyReasonIfNeeded(int trail_index) const {
-  const int reason_index = integer_trail_[trail_index].reason_index;
+  const int reason_index = reason_indices_[trail_index];
   if (reason_index == -1) {
     const TrailEntry& entry = integer_trail_[trail_index];
     const IntegerLiteral literal(entry.var, entry.bound);
@@ -1769,7 +1777,7 @@ void IntegerTrail::ComputeLazyReasonIfNeeded(int trail_index) const {
 }
 
 absl::Span<const int> IntegerTrail::Dependencies(int trail_index) const {
-  const int reason_index = integer_trail_[trail_index].reason_index;
+  const int reason_index = reason_indices_[trail_index];
   if (reason_index == -1) {
     return absl::Span<const int>(lazy_reason_trail_indices_);
   }
@@ -1812,7 +1820,7 @@ absl::Span<const int> IntegerTrail::Dependencies(int trail_index) const {
 void IntegerTrail::AppendLiteralsReason(int trail_index,
                                         std::vector<Literal>* output) const {
   CHECK_GE(trail_index, var_lbs_.size());
-  const int reason_index = integer_trail_[trail_index].reason_index;
+  const int reason_index = reason_indices_[trail_index];
   if (reason_index == -1) {
     for (const Literal l : lazy_reason_literals_) {
       if (!added_variables_[l.Variable()]) {
@@ -1915,7 +1923,7 @@ void IntegerTrail::MergeReasonIntoInternal(std::vector<Literal>* output) const {
               IntegerVariable(entry.var), entry.bound));
       if (associated_lit != kNoLiteralIndex) {
         // We check that the reason is the same!
-        const int reason_index = integer_trail_[trail_index].reason_index;
+        const int reason_index = reason_indices_[trail_index];
         CHECK_NE(reason_index, -1);
         {
           const int start = literals_reason_starts_[reason_index];
@@ -2036,7 +2044,9 @@ GenericLiteralWatcher::GenericLiteralWatcher(Model* model)
     : SatPropagator("GenericLiteralWatcher"),
       time_limit_(model->GetOrCreate<TimeLimit>()),
       integer_trail_(model->GetOrCreate<IntegerTrail>()),
-      rev_int_repository_(model->GetOrCreate<RevIntRepository>()) {
+      rev_int_repository_(model->GetOrCreate<RevIntRepository>()),
+      collect_stats_(
+          model->GetOrCreate<SatParameters>()->collect_propagator_statistics()) {
   // TODO(user): This propagator currently needs to be last because it is the
   // only one enforcing that a fix-point is reached on the integer variables.
   // Figure out a better interaction between the sat propagation loop and
@@ -2177,10 +2187,27 @@ bool GenericLiteralWatcher::Propagate(Trail* trail) {
 
       // TODO(user): Maybe just provide one function Propagate(watch_indices) ?
       ++num_propagate_calls;
+      int64_t start_nanos = -1;
+      if (collect_stats_ &&
+          id_to_stats_[id].num_calls++ % kStatsSamplingPeriod == 0) {
+        start_nanos = absl::GetCurrentTimeNanos();
+      }
       const bool result =
           id_to_watch_indices_[id].empty()
               ? watchers_[id]->Propagate()
               : watchers_[id]->IncrementalPropagate(id_to_watch_indices_[id]);
+      if (collect_stats_) {
+        PropagatorStats& stats = id_to_stats_[id];
+        if (start_nanos >= 0) {
+          stats.sampled_nanos += absl::GetCurrentTimeNanos() - start_nanos;
+        }
+        if (!result) {
+          ++stats.num_conflicts;
+        } else if (trail->Index() > old_boolean_timestamp ||
+                   integer_trail_->num_enqueues() > old_integer_timestamp) {
+          ++stats.num_productive_calls;
+        }
+      }
       if (!result) {
         id_to_watch_indices_[id].clear();
         in_queue_[id] = false;
@@ -2287,6 +2314,7 @@ int GenericLiteralWatcher::Register(PropagatorInterface* propagator) {
   id_to_watch_indices_.push_back(std::vector<int>());
   id_to_priority_.push_back(1);
   id_to_idempotence_.push_back(true);
+  if (collect_stats_) id_to_stats_.push_back(PropagatorStats());
 
   // Call this propagator at least once the next time Propagate() is called.
   //
@@ -2300,6 +2328,58 @@ int GenericLiteralWatcher::Register(PropagatorInterface* propagator) {
   return id;
 }
 
+namespace {
+
+// Returns the unqualified class name of the given propagator. This only
+// handles the common Itanium mangling of nested names, like
+// "N19operations_research3sat12IntegerSumLEE", and returns the raw type name
+// otherwise.
+std::string PropagatorClassName(const PropagatorInterface& propagator) {
+  const absl::string_view mangled = typeid(propagator).name();
+  absl::string_view last_name;
+  int i = (!mangled.empty() && mangled[0] == 'N') ? 1 : 0;
+  while (i < mangled.size() && absl::ascii_isdigit(mangled[i])) {
+    int length = 0;
+    while (i < mangled.size() && absl::ascii_isdigit(mangled[i])) {
+      length = 10 * length + (mangled[i++] - '0');
+    }
+    if (i + length > mangled.size()) return std::string(mangled);
+    last_name = mangled.substr(i, length);
+    i += length;
+  }
+  return last_name.empty() ? std::string(mangled) : std::string(last_name);
+}
+
+}  // namespace
+
+std::vector<std::pair<std::string, int64_t>>
+GenericLiteralWatcher::PropagatorStatistics() const {
+  std::vector<std::pair<std::string, int64_t>> result;
+  if (!collect_stats_) return result;
+
+  absl::btree_map<std::string, PropagatorStats> class_to_stats;
+  for (int id = 0; id < watchers_.size(); ++id) {
+    const PropagatorStats& stats = id_to_stats_[id];
+    if (stats.num_calls == 0) continue;
+    PropagatorStats& merged =
+        class_to_stats[PropagatorClassName(*watchers_[id])];
+    merged.num_calls += stats.num_calls;
+    merged.num_productive_calls += stats.num_productive_calls;
+    merged.num_conflicts += stats.num_conflicts;
+    merged.sampled_nanos += stats.sampled_nanos;
+  }
+  for (const auto& [name, stats] : class_to_stats) {
+    const std::string prefix = absl::StrCat(kPropagatorStatsPrefix, name, "/");
+    result.push_back({absl::StrCat(prefix, "calls"), stats.num_calls});
+    result.push_back(
+        {absl::StrCat(prefix, "productive_calls"), stats.num_productive_calls});
+    result.push_back({absl::StrCat(prefix, "conflicts"), stats.num_conflicts});
+    result.push_back({absl::StrCat(prefix, "estimated_wall_time_ns"),
+                      stats.sampled_nanos * kStatsSamplingPeriod});
+  }
+  return result;
+}
+
 void GenericLiteralWatcher::SetPropagatorPriority(int id, int priority) {
   id_to_priority_[id] = priority;
   if (priority >= queue_by_priority_.size()) {
@@ -33,6 +33,7 @@
 #include "absl/container/inlined_vector.h"
 #include "absl/log/check.h"
 #include "absl/strings/str_cat.h"
+#include "absl/strings/string_view.h"
 #include "absl/types/span.h"
 #include "ortools/base/logging.h"
 #include "ortools/base/strong_vector.h"
@@ -1215,17 +1216,24 @@ class IntegerTrail : public SatPropagator {
 
   // The integer trail. It always start by num_vars sentinel values with the
   // level 0 bounds (in one to one correspondence with var_lbs_).
+  //
+  // The fields needed to follow the chain of bounds of a variable, which is
+  // what the conflict analysis mostly does, are packed in 16 bytes. The reason
+  // index, only needed when a reason is expanded, is stored in the parallel
+  // vector reason_indices_.
   struct TrailEntry {
     IntegerValue bound;
     IntegerVariable var;
     int32_t prev_trail_index;
-
-    // Index in literals_reason_start_/bounds_reason_starts_ If this is -1, then
-    // this was a propagation with a lazy reason, and the reason can be
-    // re-created by calling the function lazy_reasons_[trail_index].
-    int32_t reason_index;
   };
+  static_assert(sizeof(TrailEntry) == 16);
   std::vector<TrailEntry> integer_trail_;
+
+  // Index in literals_reason_start_/bounds_reason_starts_ of the reason of
+  // each trail entry. If this is -1, then this was a propagation with a lazy
+  // reason, and the reason can be re-created by calling the function
+  // lazy_reasons_[trail_index].
+  std::vector<int32_t> reason_indices_;
   std::vector<LazyReasonFunction> lazy_reasons_;
 
   // Start of each decision levels in integer_trail_.
@@ -1504,6 +1512,13 @@ class GenericLiteralWatcher : public SatPropagator {
   // Add the given propagator to its queue.
   void CallOnNextPropagate(int id);
 
+  // If the parameter collect_propagator_statistics is true, returns the
+  // statistics of all propagators, summed by C++ class name, in the format
+  // used by SharedStatistics: "<prefix><class>/<counter>". Otherwise this
+  // returns an empty vector.
+  static constexpr absl::string_view kPropagatorStatsPrefix = "Propagator/";
+  std::vector<std::pair<std::string, int64_t>> PropagatorStatistics() const;
+
  private:
   // Updates queue_ and in_queue_ with the propagator ids that need to be
   // called.
@@ -1543,6 +1558,19 @@ class GenericLiteralWatcher : public SatPropagator {
   std::vector<int> id_to_priority_;
   std::vector<int> id_to_idempotence_;
 
+  // Only filled if collect_propagator_statistics is true. We only time one
+  // call every kStatsSamplingPeriod calls of a given propagator since reading
+  // the clock is not free compared to many of our propagators.
+  struct PropagatorStats {
+    int64_t num_calls = 0;
+    int64_t num_productive_calls = 0;
+    int64_t num_conflicts = 0;
+    int64_t sampled_nanos = 0;
+  };
+  static constexpr int kStatsSamplingPeriod = 16;
+  const bool collect_stats_;
+  std::vector<PropagatorStats> id_to_stats_;
+
   // Special propagators that needs to always be called at level zero.
   std::vector<int> propagator_ids_to_call_at_level_zero_;
 
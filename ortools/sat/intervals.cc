@@ -905,6 +905,7 @@ void SchedulingDemandHelper::InitDecomposedEnergies() {
   // For the special case were demands is empty.
   const int num_tasks = helper_->NumTasks();
   if (demands_.size() != num_tasks) return;
+  cached_energies_timestamp_ = -1;
   for (int t = 0; t < num_tasks; ++t) {
     const AffineExpression size = helper_->Sizes()[t];
     const AffineExpression demand = demands_[t];
@@ -961,6 +962,15 @@ IntegerValue SchedulingDemandHelper::DecomposedEnergyMax(int t) const {
 }
 
 void SchedulingDemandHelper::CacheAllEnergyValues() {
+  const int64_t timestamp = integer_trail_->timestamp();
+  const int trail_index = sat_solver_->LiteralTrail().Index();
+  if (timestamp == cached_energies_timestamp_ &&
+      trail_index == cached_energies_trail_index_) {
+    return;
+  }
+  cached_energies_timestamp_ = timestamp;
+  cached_energies_trail_index_ = trail_index;
+
   const int num_tasks = cached_energies_min_.size();
   const bool is_at_level_zero = sat_solver_->CurrentDecisionLevel() == 0;
   for (int t = 0; t < num_tasks; ++t) {
@@ -1090,6 +1100,7 @@ void SchedulingDemandHelper::OverrideLinearizedEnergies(
     absl::Span<const LinearExpression> energies) {
   const int num_tasks = energies.size();
   DCHECK_EQ(num_tasks, helper_->NumTasks());
+  cached_energies_timestamp_ = -1;
   linearized_energies_.resize(num_tasks);
   for (int t = 0; t < num_tasks; ++t) {
     linearized_energies_[t] = energies[t];
@@ -1121,6 +1132,7 @@ std::vector<LiteralValueValue> SchedulingDemandHelper::FilteredDecomposedEnergy(
 void SchedulingDemandHelper::OverrideDecomposedEnergies(
     const std::vector<std::vector<LiteralValueValue>>& energies) {
   DCHECK_EQ(energies.size(), helper_->NumTasks());
+  cached_energies_timestamp_ = -1;
   decomposed_energies_ = energies;
 }
 
@@ -636,6 +636,9 @@ class SchedulingDemandHelper {
   // expressing the interval as a set of alternatives.
   //
   // At level 0, it will filter false literals from decomposed energies.
+  //
+  // This does nothing if no bound or literal changed since the last call, so
+  // the propagators and cut generators sharing this helper can all call it.
   void CacheAllEnergyValues();
   IntegerValue EnergyMin(int t) const { return cached_energies_min_[t]; }
   IntegerValue EnergyMax(int t) const { return cached_energies_max_[t]; }
@@ -698,6 +701,13 @@ class SchedulingDemandHelper {
   std::vector<IntegerValue> cached_energies_max_;
   std::vector<bool> energy_is_quadratic_;
 
+  // The solver state for which the values above were computed. The integer
+  // trail timestamp changes on each bound change and on each backtrack, and
+  // the Boolean trail index covers the literals that are not attached to an
+  // integer variable, like the presence or decomposed energy literals.
+  int64_t cached_energies_timestamp_ = -1;
+  int cached_energies_trail_index_ = -1;
+
   // A representation of the energies as a set of alternative.
   // If subvector is empty, we don't have this representation.
   std::vector<std::vector<LiteralValueValue>> decomposed_energies_;
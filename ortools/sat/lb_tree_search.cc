@@ -171,13 +171,24 @@ bool LbTreeSearch::FullRestart() {
   num_decisions_taken_at_last_restart_ = num_decisions_taken_;
   num_nodes_in_tree_ = 0;
   nodes_.clear();
+  free_nodes_.clear();
   current_branch_.clear();
   return sat_solver_->RestoreSolverToAssumptionLevel();
 }
 
-void LbTreeSearch::MarkAsDeletedNodeAndUnreachableSubtree(Node& node) {
+bool LbTreeSearch::TreeIsOverMemoryLimit() const {
+  // We only count the nodes in use, the free ones will be reused first.
+  const int64_t num_bytes =
+      static_cast<int64_t>(nodes_.size() - free_nodes_.size()) * sizeof(Node);
+  return num_bytes >
+         parameters_.lb_tree_search_max_memory_in_mb() * 1024 * 1024;
+}
+
+void LbTreeSearch::MarkAsDeletedNodeAndUnreachableSubtree(NodeIndex n) {
+  Node& node = nodes_[n];
   --num_nodes_in_tree_;
   node.is_deleted = true;
+  free_nodes_.push_back(n);
   if (sat_solver_->Assignment().LiteralIsTrue(node.literal)) {
     MarkSubtreeAsDeleted(node.false_child);
   } else {
@@ -193,6 +204,7 @@ void LbTreeSearch::MarkSubtreeAsDeleted(NodeIndex root) {
 
     --num_nodes_in_tree_;
     nodes_[n].is_deleted = true;
+    free_nodes_.push_back(n);
 
     to_delete.push_back(nodes_[n].true_child);
     to_delete.push_back(nodes_[n].false_child);
@@ -203,7 +215,8 @@ std::string LbTreeSearch::SmallProgressString() const {
   return absl::StrCat(
       "nodes=", num_nodes_in_tree_, "/", nodes_.size(),
       " rc=", num_rc_detected_, " decisions=", num_decisions_taken_,
-      " @root=", num_back_to_root_node_, " restarts=", num_full_restarts_);
+      " @root=", num_back_to_root_node_, " restarts=", num_full_restarts_,
+      " mem_restarts=", num_memory_restarts_);
 }
 
 SatSolver::Status LbTreeSearch::Search(
@@ -344,6 +357,15 @@ SatSolver::Status LbTreeSearch::Search(
       if (!FullRestart()) return sat_solver_->UnsatStatus();
     }
 
+    // Forget the whole tree if it uses too much memory. Note that the current
+    // objective lower bound is not lost since it is stored in the response.
+    if (TreeIsOverMemoryLimit()) {
+      ++num_memory_restarts_;
+      VLOG(2) << "lb_tree_search (memory_restart " << SmallProgressString()
+              << ")";
+      if (!FullRestart()) return sat_solver_->UnsatStatus();
+    }
+
     // Backtrack if needed.
     //
     // Our algorithm stop exploring a branch as soon as its objective lower
@@ -443,7 +465,7 @@ SatSolver::Status LbTreeSearch::Search(
           n = node.false_child;
           new_lb = node.false_objective;
         }
-        MarkAsDeletedNodeAndUnreachableSubtree(node);
+        MarkAsDeletedNodeAndUnreachableSubtree(current_branch_[level]);
 
         // We jump directly to the subnode.
         // Else we will change the root.
@@ -675,18 +697,26 @@ std::vector<Literal> LbTreeSearch::ExtractDecisions(
 }
 
 void LbTreeSearch::AppendNewNodeToCurrentBranch(Literal decision) {
-  const NodeIndex n(nodes_.size());
+  NodeIndex n;
   ++num_nodes_in_tree_;
-  nodes_.emplace_back(Literal(decision), current_objective_lb_);
+  if (free_nodes_.empty()) {
+    n = NodeIndex(nodes_.size());
+    nodes_.emplace_back(Literal(decision), current_objective_lb_);
+  } else {
+    n = free_nodes_.back();
+    free_nodes_.pop_back();
+    DCHECK(nodes_[n].is_deleted);
+    nodes_[n] = Node(Literal(decision), current_objective_lb_);
+  }
   if (!current_branch_.empty()) {
     const NodeIndex parent = current_branch_.back();
     if (sat_solver_->Assignment().LiteralIsTrue(nodes_[parent].literal)) {
       nodes_[parent].true_child = n;
-      nodes_[parent].UpdateTrueObjective(nodes_.back().MinObjective());
+      nodes_[parent].UpdateTrueObjective(nodes_[n].MinObjective());
     } else {
       CHECK(sat_solver_->Assignment().LiteralIsFalse(nodes_[parent].literal));
       nodes_[parent].false_child = n;
-      nodes_[parent].UpdateFalseObjective(nodes_.back().MinObjective());
+      nodes_[parent].UpdateFalseObjective(nodes_[n].MinObjective());
     }
   }
   current_branch_.push_back(n);
@@ -119,10 +119,16 @@ class LbTreeSearch {
   bool FullRestart();
 
   // Mark the given node as deleted. Its literal is assumed to be set. We also
-  // delete the subtree that is not longer relevant.
-  void MarkAsDeletedNodeAndUnreachableSubtree(Node& node);
+  // delete the subtree that is not longer relevant. The deleted nodes are added
+  // to free_nodes_ and will be reused by AppendNewNodeToCurrentBranch(), so
+  // nothing should point to them anymore.
+  void MarkAsDeletedNodeAndUnreachableSubtree(NodeIndex n);
   void MarkSubtreeAsDeleted(NodeIndex root);
 
+  // Returns true if the memory used by nodes_ is over the limit given by
+  // lb_tree_search_max_memory_in_mb.
+  bool TreeIsOverMemoryLimit() const;
+
   // Create a new node at the end of the current branch.
   // This assume the last decision in the branch is assigned.
   void AppendNewNodeToCurrentBranch(Literal decision);
@@ -165,6 +171,9 @@ class LbTreeSearch {
   int num_nodes_in_tree_ = 0;
   absl::StrongVector<NodeIndex, Node> nodes_;
 
+  // The indices of the deleted nodes in nodes_ that can be reused.
+  std::vector<NodeIndex> free_nodes_;
+
   // The list of nodes in the current branch, in order from the root.
   std::vector<NodeIndex> current_branch_;
 
@@ -184,6 +193,9 @@ class LbTreeSearch {
 
   // Count the number of time we are back to decision level zero.
   int64_t num_back_to_root_node_ = 0;
+
+  // Number of full restarts triggered by the memory limit.
+  int64_t num_memory_restarts_ = 0;
 };
 
 }  // namespace sat
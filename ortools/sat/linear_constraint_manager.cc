@@ -279,6 +279,24 @@ bool LinearConstraintManager::AddCut(LinearConstraint ct, std::string type_name,
   num_cuts_++;
   num_deletable_constraints_++;
   type_to_num_cuts_[type_name]++;
+  if (cut_export_callback_ != nullptr) {
+    cut_export_callback_(constraint_infos_[ct_index].constraint);
+  }
+  return true;
+}
+
+bool LinearConstraintManager::AddSharedCut(LinearConstraint ct) {
+  if (ct.num_terms == 0) return false;
+  if (PossibleOverflow(integer_trail_, ct)) return false;
+
+  bool added = false;
+  const ConstraintIndex ct_index = Add(std::move(ct), &added);
+  if (!added) return false;
+
+  constraint_infos_[ct_index].is_deletable = true;
+  num_cuts_++;
+  num_deletable_constraints_++;
+  type_to_num_cuts_["Shared"]++;
   return true;
 }
 
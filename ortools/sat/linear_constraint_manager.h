@@ -17,6 +17,7 @@
 #include <algorithm>
 #include <cstddef>
 #include <cstdint>
+#include <functional>
 #include <string>
 #include <utility>
 #include <vector>
@@ -121,6 +122,18 @@ class LinearConstraintManager {
   bool AddCut(LinearConstraint ct, std::string type_name,
               std::string extra_info = "");
 
+  // Adds a globally valid cut found by another worker. Unlike AddCut(), this
+  // does not require the cut to be violated by the current LP solution, it
+  // will enter the LP when ChangeLp() finds it violated. Returns true if this
+  // was a new cut.
+  bool AddSharedCut(LinearConstraint ct);
+
+  // If set, this is called on each new cut added by AddCut().
+  void SetCutExportCallback(
+      std::function<void(const LinearConstraint&)> callback) {
+    cut_export_callback_ = std::move(callback);
+  }
+
   // These must be level zero bounds.
   bool UpdateConstraintLb(glop::RowIndex index_in_lp, IntegerValue new_lb);
   bool UpdateConstraintUb(glop::RowIndex index_in_lp, IntegerValue new_ub);
@@ -253,6 +266,7 @@ class LinearConstraintManager {
   int64_t num_cuts_ = 0;
   int64_t num_add_cut_calls_ = 0;
   absl::btree_map<std::string, int> type_to_num_cuts_;
+  std::function<void(const LinearConstraint&)> cut_export_callback_;
 
   bool objective_is_defined_ = false;
   bool objective_norm_computed_ = false;
@@ -18,6 +18,7 @@
 #include <cmath>
 #include <cstddef>
 #include <cstdint>
+#include <deque>
 #include <functional>
 #include <limits>
 #include <memory>
@@ -35,6 +36,7 @@
 #include "absl/strings/string_view.h"
 #include "absl/types/span.h"
 #include "ortools/algorithms/binary_search.h"
+#include "ortools/base/hash.h"
 #include "ortools/base/logging.h"
 #include "ortools/base/mathutil.h"
 #include "ortools/base/strong_vector.h"
@@ -258,11 +260,13 @@ LinearProgrammingConstraint::LinearProgrammingConstraint(
       time_limit_(model->GetOrCreate<TimeLimit>()),
       integer_trail_(model->GetOrCreate<IntegerTrail>()),
       trail_(model->GetOrCreate<Trail>()),
+      sat_solver_(model->GetOrCreate<SatSolver>()),
       integer_encoder_(model->GetOrCreate<IntegerEncoder>()),
       product_detector_(model->GetOrCreate<ProductDetector>()),
       objective_definition_(model->GetOrCreate<ObjectiveDefinition>()),
       shared_stats_(model->GetOrCreate<SharedStatistics>()),
       shared_response_manager_(model->GetOrCreate<SharedResponseManager>()),
+      shared_cut_pool_(model->Mutable<SharedCutPool>()),
       random_(model->GetOrCreate<ModelRandomGenerator>()),
       rlt_cut_helper_(model),
       implied_bounds_processor_({}, integer_trail_,
@@ -357,6 +361,7 @@ void LinearProgrammingConstraint::SetObjectiveCoefficient(IntegerVariable ivar,
 // fraction will be used in the optimal solution.
 bool LinearProgrammingConstraint::CreateLpFromConstraintManager() {
   simplex_.NotifyThatMatrixIsChangedForNextSolve();
+  basis_cache_.clear();
 
   // Fill integer_lp_.
   integer_lp_.clear();
@@ -666,10 +671,32 @@ void LinearProgrammingConstraint::UpdateBoundsOfLpVariables() {
   }
 }
 
+uint64_t LinearProgrammingConstraint::CurrentNodeHash() const {
+  uint64_t hash = 0;
+  const int level = trail_->CurrentDecisionLevel();
+  const std::vector<SatSolver::Decision>& decisions = sat_solver_->Decisions();
+  for (int i = 0; i < level; ++i) {
+    hash = util_hash::Hash(decisions[i].literal.Index().value(), hash);
+  }
+  return hash;
+}
+
+void LinearProgrammingConstraint::MaybeLoadCachedBasis() {
+  const uint64_t node_hash = CurrentNodeHash();
+  if (node_hash == last_solve_node_hash_) return;
+  for (const CachedBasis& cached : basis_cache_) {
+    if (cached.node_hash == node_hash) {
+      simplex_.LoadStateForNextSolve(cached.state);
+      return;
+    }
+  }
+}
+
 bool LinearProgrammingConstraint::SolveLp() {
   if (trail_->CurrentDecisionLevel() == 0) {
     lp_at_level_zero_is_final_ = false;
   }
+  const uint64_t node_hash = CurrentNodeHash();
 
   const auto status = simplex_.Solve(lp_data_, time_limit_);
   total_num_simplex_iterations_ += simplex_.GetNumberOfIterations();
@@ -708,6 +735,19 @@ bool LinearProgrammingConstraint::SolveLp() {
   }
   lp_at_optimal_ = simplex_.GetProblemStatus() == glop::ProblemStatus::OPTIMAL;
 
+  last_solve_node_hash_ = node_hash;
+  if (simplex_.GetProblemStatus() == glop::ProblemStatus::OPTIMAL &&
+      trail_->CurrentDecisionLevel() > 0) {
+    for (auto it = basis_cache_.begin(); it != basis_cache_.end(); ++it) {
+      if (it->node_hash == node_hash) {
+        basis_cache_.erase(it);
+        break;
+      }
+    }
+    if (basis_cache_.size() == kBasisCacheSize) basis_cache_.pop_back();
+    basis_cache_.push_front({node_hash, simplex_.GetState()});
+  }
+
   if (simplex_.GetProblemStatus() == glop::ProblemStatus::OPTIMAL) {
     lp_solution_is_set_ = true;
     lp_solution_level_ = trail_->CurrentDecisionLevel();
@@ -1700,11 +1740,96 @@ void LinearProgrammingConstraint::UpdateSimplexIterationLimit(
       std::max(min_iter, std::min(max_iter, next_simplex_iter_));
 }
 
+void LinearProgrammingConstraint::ImportSharedCuts() {
+  if (shared_cut_pool_ == nullptr) return;
+  auto* mapping = model_->GetOrCreate<CpModelMapping>();
+  for (const std::shared_ptr<const SharedCutPool::Cut>& cut :
+       shared_cut_pool_->GetNewCuts(&num_imported_shared_cuts_)) {
+    LinearConstraintBuilder builder(IntegerValue(cut->lb),
+                                    IntegerValue(cut->ub));
+    bool is_in_lp = true;
+    for (int i = 0; i < cut->vars.size(); ++i) {
+      if (!mapping->IsInteger(cut->vars[i])) {
+        is_in_lp = false;
+        break;
+      }
+      const IntegerVariable var = mapping->Integer(cut->vars[i]);
+      if (!mirror_lp_variable_.contains(PositiveVariable(var))) {
+        is_in_lp = false;
+        break;
+      }
+      builder.AddTerm(var, IntegerValue(cut->coeffs[i]));
+    }
+    if (is_in_lp) constraint_manager_.AddSharedCut(builder.Build());
+  }
+}
+
+bool LinearProgrammingConstraint::SeparateAndExportCuts(
+    absl::Span<const double> proto_lp_solution, SharedCutPool* pool) {
+  CHECK_EQ(trail_->CurrentDecisionLevel(), 0);
+  auto* mapping = model_->GetOrCreate<CpModelMapping>();
+  for (const IntegerVariable var : integer_variables_) {
+    const int proto_var = mapping->GetProtoVariableFromIntegerVariable(var);
+    double value = ToDouble(integer_trail_->LevelZeroLowerBound(var));
+    if (proto_var >= 0 && proto_var < proto_lp_solution.size() &&
+        std::isfinite(proto_lp_solution[proto_var])) {
+      value = proto_lp_solution[proto_var];
+    }
+    expanded_lp_solution_[var] = value;
+    expanded_lp_solution_[NegationOf(var)] = -value;
+  }
+
+  // The cuts are mapped back to the proto variables. We cannot share the ones
+  // that use a variable without a proto counterpart.
+  constraint_manager_.SetCutExportCallback(
+      [mapping, pool](const LinearConstraint& ct) {
+        SharedCutPool::Cut cut;
+        cut.lb = ct.lb.value();
+        cut.ub = ct.ub.value();
+        for (int i = 0; i < ct.num_terms; ++i) {
+          IntegerVariable var = ct.vars[i];
+          IntegerValue coeff = ct.coeffs[i];
+          if (!VariableIsPositive(var)) {
+            var = NegationOf(var);
+            coeff = -coeff;
+          }
+          const int proto_var =
+              mapping->GetProtoVariableFromIntegerVariable(var);
+          if (proto_var < 0) return;
+          cut.vars.push_back(proto_var);
+          cut.coeffs.push_back(coeff.value());
+        }
+        pool->AddCut(std::move(cut));
+      });
+
+  bool feasible = true;
+  implied_bounds_processor_.RecomputeCacheAndSeparateSomeImpliedBoundCuts(
+      expanded_lp_solution_);
+  if (parameters_.add_rlt_cuts()) {
+    rlt_cut_helper_.Initialize(mirror_lp_variable_);
+  }
+  for (const CutGenerator& generator : cut_generators_) {
+    if (!generator.generate_cuts(&constraint_manager_)) {
+      feasible = false;
+      break;
+    }
+  }
+  if (feasible) {
+    implied_bounds_processor_.IbCutPool().TransferToManager(
+        &constraint_manager_);
+  }
+  constraint_manager_.SetCutExportCallback(nullptr);
+  return feasible;
+}
+
 bool LinearProgrammingConstraint::Propagate() {
   if (!enabled_) return true;
   if (time_limit_->LimitReached()) return true;
   UpdateBoundsOfLpVariables();
 
+  // Note that the imported cuts only enter the LP through ChangeLp().
+  if (trail_->CurrentDecisionLevel() == 0) ImportSharedCuts();
+
   // TODO(user): It seems the time we loose by not stopping early might be worth
   // it because we end up with a better explanation at optimality.
   if (/* DISABLES CODE */ (false) && objective_is_defined_) {
@@ -1731,6 +1856,7 @@ bool LinearProgrammingConstraint::Propagate() {
   }
 
   simplex_.SetParameters(simplex_params_);
+  if (trail_->CurrentDecisionLevel() > 0) MaybeLoadCachedBasis();
   if (!SolveLp()) return true;
   if (!AnalyzeLp()) return false;
 
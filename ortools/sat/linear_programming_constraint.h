@@ -15,6 +15,7 @@
 #define OR_TOOLS_SAT_LINEAR_PROGRAMMING_CONSTRAINT_H_
 
 #include <cstdint>
+#include <deque>
 #include <functional>
 #include <limits>
 #include <memory>
@@ -45,6 +46,7 @@
 #include "ortools/sat/model.h"
 #include "ortools/sat/sat_base.h"
 #include "ortools/sat/sat_parameters.pb.h"
+#include "ortools/sat/sat_solver.h"
 #include "ortools/sat/synchronization.h"
 #include "ortools/sat/util.h"
 #include "ortools/sat/zero_half_cuts.h"
@@ -158,6 +160,16 @@ class LinearProgrammingConstraint : public PropagatorInterface,
   // Register a new cut generator with this constraint.
   void AddCutGenerator(CutGenerator generator);
 
+  // Used by the cut separation worker. This runs all the cut generators on the
+  // given LP solution of the model proto variables, which usually comes from
+  // another worker, and adds the cuts found to the given pool. Variables with
+  // an infinite value take their level zero lower bound. This must be called
+  // at level zero so that the cuts are globally valid.
+  //
+  // Returns false if a cut generator proved the problem infeasible.
+  bool SeparateAndExportCuts(absl::Span<const double> proto_lp_solution,
+                             SharedCutPool* pool);
+
   // Returns the LP value and reduced cost of a variable in the current
   // solution. These functions should only be called when HasSolution() is true.
   //
@@ -258,9 +270,20 @@ class LinearProgrammingConstraint : public PropagatorInterface,
   // and some LP constraint are trivially false).
   bool CreateLpFromConstraintManager();
 
+  // Imports into the constraint manager the new cuts of the SharedCutPool
+  // whose variables all belong to this LP.
+  void ImportSharedCuts();
+
   // Solve the LP, returns false if something went wrong in the LP solver.
   bool SolveLp();
 
+  // Returns a hash of the current decisions, this identifies the search node.
+  uint64_t CurrentNodeHash() const;
+
+  // If we solved the LP at the current node before, loads the basis we found
+  // there unless it is already the last basis of the simplex.
+  void MaybeLoadCachedBasis();
+
   // Analyzes the result of an LP Solution. Returns false on conflict.
   bool AnalyzeLp();
 
@@ -441,6 +464,18 @@ class LinearProgrammingConstraint : public PropagatorInterface,
   // Underlying LP solver API.
   glop::GlopParameters simplex_params_;
   glop::BasisState state_;
+
+  // Small LRU cache of the last optimal basis found at a few search nodes,
+  // most recent first. Returning to one of these nodes, after a restart or in
+  // LbTreeSearch, restores its basis instead of starting from the basis of
+  // the last node. This is cleared each time the LP changes.
+  struct CachedBasis {
+    uint64_t node_hash;
+    glop::BasisState state;
+  };
+  static constexpr int kBasisCacheSize = 16;
+  std::deque<CachedBasis> basis_cache_;
+  uint64_t last_solve_node_hash_ = 0;
   glop::LinearProgram lp_data_;
   glop::RevisedSimplex simplex_;
   int64_t next_simplex_iter_ = 500;
@@ -497,11 +532,14 @@ class LinearProgrammingConstraint : public PropagatorInterface,
   TimeLimit* time_limit_;
   IntegerTrail* integer_trail_;
   Trail* trail_;
+  SatSolver* sat_solver_;
   IntegerEncoder* integer_encoder_;
   ProductDetector* product_detector_;
   ObjectiveDefinition* objective_definition_;
   SharedStatistics* shared_stats_;
   SharedResponseManager* shared_response_manager_;
+  SharedCutPool* shared_cut_pool_;
+  int num_imported_shared_cuts_ = 0;
   ModelRandomGenerator* random_;
 
   BoolRLTCutHelper rlt_cut_helper_;
@@ -400,6 +400,7 @@ LinearPropagator::~LinearPropagator() {
   stats.push_back({"linear_propag/num_loop_aborts", num_loop_aborts_});
   stats.push_back({"linear_propag/num_ignored", num_ignored_});
   stats.push_back({"linear_propag/num_delayed", num_delayed_});
+  stats.push_back({"linear_propag/num_sorted_batches", num_sorted_batches_});
   shared_stats_->AddStats(stats);
 }
 
@@ -474,11 +475,27 @@ bool LinearPropagator::Propagate() {
   //
   // We will clear modified_vars_ on exit since everything we propagate here
   // is handled by PropagateOneConstraint().
+  const int old_queue_size = propagation_queue_.size();
   for (const IntegerVariable var : modified_vars_.PositionsSetAtLeastOnce()) {
     if (var >= var_to_constraint_ids_.size()) continue;
     OnVariableChange(var, integer_trail_->LowerBound(var), -1);
   }
 
+  // When a lot of bounds changed at once (typically at level zero after a
+  // restart or when importing shared bounds), we scan the newly queued
+  // constraints by increasing id rather than in the order of the modified
+  // variables. Since the constraints are stored in the buffers in the order
+  // they were added, this results in a mostly sequential scan of the packed
+  // variables and coefficients. Each constraint is still only analyzed once
+  // for this initial batch thanks to in_queue_.
+  constexpr int kMinBatchSizeForSortedScan = 1000;
+  if (propagation_queue_.size() - old_queue_size >=
+      kMinBatchSizeForSortedScan) {
+    ++num_sorted_batches_;
+    std::sort(propagation_queue_.begin() + old_queue_size,
+              propagation_queue_.end());
+  }
+
   // Cleanup.
   num_terms_for_dtime_update_ = 0;
   const auto cleanup = ::absl::MakeCleanup([this]() {
@@ -458,6 +458,7 @@ class LinearPropagator : public PropagatorInterface, ReversibleInterface {
   int64_t num_bool_aborts_ = 0;
   int64_t num_loop_aborts_ = 0;
   int64_t num_ignored_ = 0;
+  int64_t num_sorted_batches_ = 0;
 };
 
 }  // namespace sat
@@ -68,7 +68,9 @@ void MinimizeCoreWithPropagation(TimeLimit* limit, SatSolver* solver,
   solver->Backtrack(0);
   solver->SetAssumptionLevel(0);
   if (!solver->FinishPropagation()) return;
-  while (!limit->LimitReached()) {
+  const double deadline = solver->deterministic_time() +
+                          solver->parameters().core_minimization_dtime();
+  while (!limit->LimitReached() && solver->deterministic_time() < deadline) {
     // We want each literal in candidate to appear last once in our propagation
     // order. We want to do that while maximizing the reutilization of the
     // current assignment prefix, that is minimizing the number of
@@ -127,10 +129,13 @@ void MinimizeCoreWithSearch(TimeLimit* limit, SatSolver* solver,
   solver->mutable_logger()->EnableLogging(false);
 
   const int old_size = core->size();
+  const double deadline = solver->deterministic_time() +
+                          solver->parameters().core_minimization_dtime();
   std::vector<Literal> assumptions;
   absl::flat_hash_set<LiteralIndex> removed_once;
   while (true) {
     if (limit->LimitReached()) break;
+    if (solver->deterministic_time() > deadline) break;
 
     // Find a not yet removed literal to remove.
     // We prefer to remove high indices since these are more likely to be of
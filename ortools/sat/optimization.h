@@ -39,7 +39,8 @@ namespace sat {
 //
 // Note that the literal of the minimized core will stay in the same order.
 //
-// TODO(user): Avoid spending too much time trying to minimize a core.
+// Both functions below stop after core_minimization_dtime of the solver
+// parameters, and then return the core minimized so far.
 void MinimizeCoreWithPropagation(TimeLimit* limit, SatSolver* solver,
                                  std::vector<Literal>* core);
 
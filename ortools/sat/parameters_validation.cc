@@ -94,6 +94,7 @@ std::string ValidateParameters(const SatParameters& params) {
   TEST_IS_FINITE(shared_tree_open_leaves_per_worker);
 
   TEST_POSITIVE(at_most_one_max_expansion_size);
+  TEST_NON_NEGATIVE(implied_bounds_max_num_entries);
 
   TEST_NOT_NAN(max_time_in_seconds);
   TEST_NOT_NAN(max_deterministic_time);
@@ -104,6 +105,8 @@ std::string ValidateParameters(const SatParameters& params) {
   TEST_IN_RANGE(num_search_workers, 0, kMaxReasonableParallelism);
   TEST_IN_RANGE(min_num_lns_workers, 0, kMaxReasonableParallelism);
   TEST_IN_RANGE(shared_tree_num_workers, 0, kMaxReasonableParallelism);
+  TEST_IN_RANGE(num_solution_postprocessing_threads, 1,
+                kMaxReasonableParallelism);
   TEST_IN_RANGE(interleave_batch_size, 0, kMaxReasonableParallelism);
   TEST_IN_RANGE(shared_tree_open_leaves_per_worker, 1,
                 kMaxReasonableParallelism);
@@ -129,6 +132,10 @@ std::string ValidateParameters(const SatParameters& params) {
   TEST_IN_RANGE(violation_ls_perturbation_period, 1, 1'000'000'000);
   TEST_IN_RANGE(violation_ls_compound_move_probability, 0.0, 1.0);
 
+  // Clause sharing.
+  TEST_IN_RANGE(glue_clause_sharing_max_size, 3, 1'000);
+  TEST_POSITIVE(glue_clause_sharing_max_lbd);
+
   TEST_POSITIVE(glucose_decay_increment_period);
   TEST_POSITIVE(shared_tree_max_nodes_per_worker);
   TEST_POSITIVE(shared_tree_open_leaves_per_worker);
@@ -173,6 +173,17 @@ IntegerValue PrecedenceRelations::GetOffset(IntegerVariable a,
   return kMinIntegerValue;
 }
 
+IntegerValue PrecedenceRelations::GetLevelZeroMinDistance(
+    const AffineExpression& before, const AffineExpression& after) const {
+  if (before.var == kNoIntegerVariable || before.coeff != 1 ||
+      after.var == kNoIntegerVariable || after.coeff != 1) {
+    return kMinIntegerValue;
+  }
+  const IntegerValue offset = GetOffset(before.var, after.var);
+  if (offset == kMinIntegerValue) return kMinIntegerValue;
+  return offset + after.constant - before.constant;
+}
+
 absl::Span<const Literal> PrecedenceRelations::GetConditionalEnforcements(
     IntegerVariable a, IntegerVariable b) const {
   const auto it = conditional_relations_.find(GetKey(a, NegationOf(b)));
@@ -122,6 +122,14 @@ class PrecedenceRelations : public ReversibleInterface {
   // Otherwise a + offset <= b.
   IntegerValue GetOffset(IntegerVariable a, IntegerVariable b) const;
 
+  // Same as GetOffset() but for two affine expressions with an unit coeff.
+  // Returns a lower bound on (after - before) implied by the level zero
+  // relations, or kMinIntegerValue if none is known. Like GetOffset() this is
+  // a single O(1) lookup, so it can be used in tight loops, like when scanning
+  // all pairs of tasks in the scheduling cuts.
+  IntegerValue GetLevelZeroMinDistance(const AffineExpression& before,
+                                       const AffineExpression& after) const;
+
   // Returns the minimum distance between a and b, and the reason for it (all
   // true). Note that we always check GetOffset() so if it is better, the
   // returned literal reason will be empty.
@@ -35,6 +35,9 @@
 #include "absl/types/span.h"
 #include "ortools/base/logging.h"
 #include "ortools/base/mathutil.h"
+#if !defined(__PORTABLE_PLATFORM__)
+#include "ortools/base/threadpool.h"
+#endif  // __PORTABLE_PLATFORM__
 #include "ortools/port/proto_utils.h"
 #include "ortools/sat/cp_model.pb.h"
 #include "ortools/sat/cp_model_loader.h"
@@ -703,6 +706,10 @@ void PresolveContext::UpdateConstraintVariableUsage(int c) {
 
   UpdateLinear1Usage(ct, c);
 
+  for (std::vector<uint64_t>& fingerprints : duplicate_fingerprints_) {
+    if (c < fingerprints.size()) fingerprints[c] = 0;
+  }
+
 #ifdef CHECK_HINT
   // Crash if the loaded hint is infeasible for this constraint.
   // This is helpful to debug a wrong presolve that kill a feasible solution.
@@ -717,6 +724,22 @@ bool PresolveContext::ConstraintVariableGraphIsUpToDate() const {
   return constraint_to_vars_.size() == working_model->constraints_size();
 }
 
+uint64_t PresolveContext::DuplicateDetectionFingerprint(
+    int c, bool ignore_enforcement) {
+  const ConstraintProto& ct = working_model->constraints(c);
+  if (!ConstraintVariableGraphIsUpToDate()) {
+    return FingerprintConstraintForDuplicateDetection(ct, ignore_enforcement);
+  }
+  std::vector<uint64_t>& fingerprints =
+      duplicate_fingerprints_[ignore_enforcement ? 1 : 0];
+  if (c >= fingerprints.size()) fingerprints.resize(c + 1, 0);
+  if (fingerprints[c] == 0) {
+    fingerprints[c] =
+        FingerprintConstraintForDuplicateDetection(ct, ignore_enforcement);
+  }
+  return fingerprints[c];
+}
+
 void PresolveContext::UpdateNewConstraintsVariableUsage() {
   if (is_unsat_) return;
   const int old_size = constraint_to_vars_.size();
@@ -2281,7 +2304,9 @@ bool LoadModelForProbing(PresolveContext* context, Model* local_model) {
 
   local_model->GetOrCreate<TimeLimit>()->MergeWithGlobalTimeLimit(
       context->time_limit());
-  local_model->Register<ModelRandomGenerator>(context->random());
+  if (local_model->Mutable<ModelRandomGenerator>() == nullptr) {
+    local_model->Register<ModelRandomGenerator>(context->random());
+  }
   auto* encoder = local_model->GetOrCreate<IntegerEncoder>();
   encoder->DisableImplicationBetweenLiteral();
   auto* mapping = local_model->GetOrCreate<CpModelMapping>();
@@ -2333,11 +2358,13 @@ int PresolveContext::GetIntervalRepresentative(int index) {
   return index;
 }
 
-template <typename ProtoWithVarsAndCoeffs>
+// The Context is usually a PresolveContext, but it can also be a read-only view
+// of it, see CanonicalizeLinearConstraintsInParallel().
+template <typename ProtoWithVarsAndCoeffs, typename Context>
 bool CanonicalizeLinearExpressionInternal(
     absl::Span<const int> enforcements, ProtoWithVarsAndCoeffs* proto,
     int64_t* offset, std::vector<std::pair<int, int64_t>>* tmp_terms,
-    PresolveContext* context) {
+    Context* context) {
   // First regroup the terms on the same variables and sum the fixed ones.
   //
   // TODO(user): Add a quick pass to skip most of the work below if the
@@ -2452,6 +2479,105 @@ bool PresolveContext::CanonicalizeLinearExpression(
   return result;
 }
 
+namespace {
+
+// What CanonicalizeLinearExpressionInternal() needs from a PresolveContext,
+// in a form that can be used concurrently. Reading an affine relation might
+// compress a path in the underlying union-find, so we precompute all of them,
+// and the rule statistics are counted locally.
+class ConcurrentCanonicalizationView {
+ public:
+  ConcurrentCanonicalizationView(
+      const PresolveContext* context,
+      absl::Span<const AffineRelation::Relation> relations)
+      : context_(context), relations_(relations) {}
+
+  bool IsFixed(int var) const { return context_->IsFixed(var); }
+  int64_t FixedValue(int var) const { return context_->FixedValue(var); }
+  AffineRelation::Relation GetAffineRelation(int var) const {
+    return relations_[var];
+  }
+  void UpdateRuleStats(const std::string& name) { rule_stats_[name]++; }
+
+  const absl::btree_map<std::string, int>& rule_stats() const {
+    return rule_stats_;
+  }
+
+ private:
+  const PresolveContext* context_;
+  absl::Span<const AffineRelation::Relation> relations_;
+  absl::btree_map<std::string, int> rule_stats_;
+};
+
+}  // namespace
+
+std::vector<int> PresolveContext::CanonicalizeLinearConstraintsInParallel(
+    absl::Span<const int> constraints) {
+  std::vector<int> changed;
+  if (constraints.empty()) return changed;
+
+  const int num_vars = working_model->variables_size();
+  std::vector<AffineRelation::Relation> relations;
+  relations.reserve(num_vars);
+  for (int var = 0; var < num_vars; ++var) {
+    relations.push_back(GetAffineRelation(var));
+  }
+
+  // We use a fixed number of chunks so that the order in which we merge the
+  // statistics does not depend on the number of threads.
+  constexpr int kNumChunks = 64;
+  const int chunk_size =
+      (static_cast<int>(constraints.size()) + kNumChunks - 1) / kNumChunks;
+  std::vector<ConcurrentCanonicalizationView> views(
+      kNumChunks, ConcurrentCanonicalizationView(this, relations));
+  std::vector<std::vector<int>> changed_per_chunk(kNumChunks);
+  const auto process_chunk = [&](int chunk) {
+    std::vector<std::pair<int, int64_t>> tmp_terms;
+    const int begin = chunk * chunk_size;
+    const int end =
+        std::min(begin + chunk_size, static_cast<int>(constraints.size()));
+    for (int i = begin; i < end; ++i) {
+      const int c = constraints[i];
+      ConstraintProto* ct = working_model->mutable_constraints(c);
+      DCHECK_EQ(ct->constraint_case(), ConstraintProto::kLinear);
+      int64_t offset = 0;
+      if (CanonicalizeLinearExpressionInternal(ct->enforcement_literal(),
+                                               ct->mutable_linear(), &offset,
+                                               &tmp_terms, &views[chunk])) {
+        changed_per_chunk[chunk].push_back(c);
+      }
+      if (offset != 0) {
+        FillDomainInProto(
+            ReadDomainFromProto(ct->linear()).AdditionWith(Domain(-offset)),
+            ct->mutable_linear());
+      }
+    }
+  };
+
+#if !defined(__PORTABLE_PLATFORM__)
+  if (num_threads > 1) {
+    ThreadPool pool("CanonicalizeLinearConstraintsInParallel",
+                    std::min(num_threads, kNumChunks));
+    pool.StartWorkers();
+    for (int chunk = 0; chunk < kNumChunks; ++chunk) {
+      pool.Schedule([chunk, &process_chunk]() { process_chunk(chunk); });
+    }
+  } else  // NOLINT
+#endif      // __PORTABLE_PLATFORM__
+  {
+    for (int chunk = 0; chunk < kNumChunks; ++chunk) process_chunk(chunk);
+  }
+
+  for (int chunk = 0; chunk < kNumChunks; ++chunk) {
+    changed.insert(changed.end(), changed_per_chunk[chunk].begin(),
+                   changed_per_chunk[chunk].end());
+    for (const auto& [name, count] : views[chunk].rule_stats()) {
+      UpdateRuleStats(name, count);
+    }
+  }
+  return changed;
+}
+
 ConstraintProto* PresolveContext::NewMappingConstraint(absl::string_view file,
                                                        int line) {
   const int c = mapping_model->constraints().size();
@@ -191,6 +191,13 @@ class PresolveContext {
   //
   // This uses affine relation and regroup duplicate/fixed terms.
   bool CanonicalizeLinearConstraint(ConstraintProto* ct);
+
+  // Calls CanonicalizeLinearConstraint() on the given linear constraints of
+  // the working model using up to num_threads threads. The result does not
+  // depend on the number of threads. Returns the constraints whose set of
+  // variables changed, on which UpdateConstraintVariableUsage() must be called.
+  std::vector<int> CanonicalizeLinearConstraintsInParallel(
+      absl::Span<const int> constraints);
   bool CanonicalizeLinearExpression(absl::Span<const int> enforcements,
                                     LinearExpressionProto* expr);
 
@@ -520,6 +527,12 @@ class PresolveContext {
     DCHECK(ConstraintVariableGraphIsUpToDate());
     return var_to_constraints_[var];
   }
+  // Returns FingerprintConstraintForDuplicateDetection() of the constraint c.
+  // Once the constraint graph is up to date, this is cached and only recomputed
+  // after UpdateConstraintVariableUsage(c), so that successive duplicate
+  // detections only need to look at the constraints that changed.
+  uint64_t DuplicateDetectionFingerprint(int c, bool ignore_enforcement);
+
   int IntervalUsage(int c) const {
     DCHECK(ConstraintVariableGraphIsUpToDate());
     if (c >= interval_usage_.size()) return 0;
@@ -596,6 +609,11 @@ class PresolveContext {
   // bounds in the response.
   bool keep_all_feasible_solutions = false;
 
+  // The number of threads the presolve can use for the few steps that are
+  // parallelized. This should only be more than one if these threads would be
+  // idle otherwise.
+  int num_threads = 1;
+
   // Number of "rules" applied. This should be equal to the sum of all numbers
   // in stats_by_rule_name. This is used to decide if we should do one more pass
   // of the presolve or not. Note that depending on the presolve transformation,
@@ -703,6 +721,10 @@ class PresolveContext {
   std::vector<int> constraint_to_linear1_var_;
   std::vector<int> var_to_num_linear1_;
 
+  // Cache for DuplicateDetectionFingerprint(), indexed by ignore_enforcement.
+  // Zero means not computed yet.
+  std::vector<uint64_t> duplicate_fingerprints_[2];
+
   // We maintain how many time each interval is used.
   std::vector<std::vector<int>> constraint_to_intervals_;
   std::vector<int> interval_usage_;
@@ -757,6 +779,10 @@ class PresolveContext {
 
 // Utility function to load the current problem into a in-memory representation
 // that will be used for probing. Returns false if UNSAT.
+//
+// By default the local model shares the random generator of the context. If
+// the local model already contains a ModelRandomGenerator, it is kept instead,
+// which is needed if several such models are used from different threads.
 bool LoadModelForProbing(PresolveContext* context, Model* local_model);
 
 }  // namespace sat
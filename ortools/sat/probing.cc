@@ -123,6 +123,9 @@ bool Prober::ProbeOneVariableInternal(BooleanVariable b) {
     num_new_binary_ += new_binary_clauses_.size();
     for (auto binary : new_binary_clauses_) {
       sat_solver_->AddBinaryClause(binary.first, binary.second);
+      if (new_binary_clause_callback_ != nullptr) {
+        new_binary_clause_callback_(binary.first, binary.second);
+      }
     }
     new_binary_clauses_.clear();
     if (!sat_solver_->FinishPropagation()) return false;
@@ -103,6 +103,13 @@ class Prober {
     callback_ = f;
   }
 
+  // Register a callback that will be called on each new binary clause learned
+  // by ProbeBooleanVariables(). This is used to export them to another model
+  // when probing is done in parallel on independent copies of the problem.
+  void SetNewBinaryClauseCallback(std::function<void(Literal a, Literal b)> f) {
+    new_binary_clause_callback_ = f;
+  }
+
  private:
   bool ProbeOneVariableInternal(BooleanVariable b);
 
@@ -138,6 +145,8 @@ class Prober {
   int num_new_literals_fixed_ = 0;
 
   std::function<void(Literal decision)> callback_ = nullptr;
+  std::function<void(Literal a, Literal b)> new_binary_clause_callback_ =
+      nullptr;
 
   // Logger.
   SolverLogger* logger_;
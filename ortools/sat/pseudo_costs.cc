@@ -34,6 +34,7 @@
 #include "ortools/sat/model.h"
 #include "ortools/sat/sat_base.h"
 #include "ortools/sat/sat_parameters.pb.h"
+#include "ortools/sat/synchronization.h"
 #include "ortools/sat/util.h"
 #include "ortools/util/strong_integers.h"
 
@@ -61,7 +62,9 @@ PseudoCosts::PseudoCosts(Model* model)
       integer_trail_(model->GetOrCreate<IntegerTrail>()),
       encoder_(model->GetOrCreate<IntegerEncoder>()),
       lp_values_(model->GetOrCreate<ModelLpValues>()),
-      lps_(model->GetOrCreate<LinearProgrammingConstraintCollection>()) {
+      lps_(model->GetOrCreate<LinearProgrammingConstraintCollection>()),
+      mapping_(model->GetOrCreate<CpModelMapping>()),
+      shared_pseudo_costs_(model->Mutable<SharedPseudoCosts>()) {
   const int num_vars = integer_trail_->NumIntegerVariables().value();
   pseudo_costs_.resize(num_vars);
   is_relevant_.resize(num_vars, false);
@@ -137,22 +140,72 @@ PseudoCosts::BranchingInfo PseudoCosts::EvaluateVar(
 
   const int max_index = std::max(var.value(), NegationOf(var).value());
   if (max_index < average_unit_objective_increase_.size()) {
-    result.down_score =
-        down_fractionality *
-        average_unit_objective_increase_[NegationOf(var)].CurrentAverage();
-    result.up_score = (1.0 - down_fractionality) *
-                      average_unit_objective_increase_[var].CurrentAverage();
+    const auto [down_average, down_records] =
+        UnitObjectiveIncrease(NegationOf(var));
+    const auto [up_average, up_records] = UnitObjectiveIncrease(var);
+    result.down_score = down_fractionality * down_average;
+    result.up_score = (1.0 - down_fractionality) * up_average;
     result.score = CombineScores(result.down_score, result.up_score);
 
-    const int reliablitity = std::min(
-        average_unit_objective_increase_[var].NumRecords(),
-        average_unit_objective_increase_[NegationOf(var)].NumRecords());
+    const int64_t reliablitity = std::min(up_records, down_records);
     result.is_reliable = reliablitity >= 4;
   }
 
   return result;
 }
 
+std::pair<double, int64_t> PseudoCosts::UnitObjectiveIncrease(
+    IntegerVariable var) const {
+  const IncrementalAverage& local = average_unit_objective_increase_[var];
+  if (var >= other_workers_records_.size() ||
+      other_workers_records_[var].count == 0) {
+    return {local.CurrentAverage(), local.NumRecords()};
+  }
+  const SharedPseudoCosts::Records& others = other_workers_records_[var];
+  const int64_t count = local.NumRecords() + others.count;
+  return {(local.CurrentAverage() * local.NumRecords() + others.sum) / count,
+          count};
+}
+
+int PseudoCosts::SharedIndex(IntegerVariable var) const {
+  const int proto_var =
+      mapping_->GetProtoVariableFromIntegerVariable(PositiveVariable(var));
+  if (proto_var == -1) return -1;
+  return 2 * proto_var + (VariableIsPositive(var) ? 0 : 1);
+}
+
+void PseudoCosts::SynchronizeWithSharedPseudoCosts() {
+  if (shared_pseudo_costs_ == nullptr) return;
+
+  std::vector<std::pair<int, SharedPseudoCosts::Records>> new_records;
+  for (const IntegerVariable var : vars_with_unexported_records_) {
+    const int index = SharedIndex(var);
+    if (index != -1) new_records.push_back({index, unexported_records_[var]});
+    unexported_records_[var] = SharedPseudoCosts::Records();
+  }
+  vars_with_unexported_records_.clear();
+  shared_pseudo_costs_->ExchangeRecords(new_records, &tmp_shared_records_);
+
+  // The shared records include all the ones of this worker, so we remove them
+  // to get the records of the other workers.
+  const int num_vars = integer_trail_->NumIntegerVariables().value();
+  if (average_unit_objective_increase_.size() < num_vars) {
+    average_unit_objective_increase_.resize(num_vars);
+  }
+  other_workers_records_.assign(num_vars, SharedPseudoCosts::Records());
+  for (IntegerVariable var(0); var < num_vars; ++var) {
+    const int index = SharedIndex(var);
+    if (index == -1) continue;
+    const SharedPseudoCosts::Records& total = tmp_shared_records_[index];
+    const IncrementalAverage& local = average_unit_objective_increase_[var];
+    const int64_t count = total.count - local.NumRecords();
+    if (count <= 0) continue;
+    other_workers_records_[var].count = count;
+    other_workers_records_[var].sum = std::max(
+        0.0, total.sum - local.CurrentAverage() * local.NumRecords());
+  }
+}
+
 void PseudoCosts::UpdateBoolPseudoCosts(absl::Span<const Literal> reason,
                                         IntegerValue objective_increase) {
   const double relative_increase =
@@ -211,7 +264,18 @@ void PseudoCosts::AfterTakingDecision(bool conflict) {
       if (var >= average_unit_objective_increase_.size()) {
         average_unit_objective_increase_.resize(var + 1);
       }
-      average_unit_objective_increase_[var].AddData(obj_increase / lp_increase);
+      const double unit_increase = obj_increase / lp_increase;
+      average_unit_objective_increase_[var].AddData(unit_increase);
+      if (shared_pseudo_costs_ != nullptr) {
+        if (var >= unexported_records_.size()) {
+          unexported_records_.resize(var + 1);
+        }
+        if (unexported_records_[var].count == 0) {
+          vars_with_unexported_records_.push_back(var);
+        }
+        unexported_records_[var].sum += unit_increase;
+        ++unexported_records_[var].count;
+      }
     }
   }
 
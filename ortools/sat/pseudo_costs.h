@@ -14,16 +14,20 @@
 #ifndef OR_TOOLS_SAT_PSEUDO_COSTS_H_
 #define OR_TOOLS_SAT_PSEUDO_COSTS_H_
 
+#include <cstdint>
+#include <utility>
 #include <vector>
 
 #include "absl/log/check.h"
 #include "ortools/base/logging.h"
 #include "ortools/base/strong_vector.h"
 #include "ortools/sat/integer.h"
+#include "ortools/sat/cp_model_mapping.h"
 #include "ortools/sat/linear_programming_constraint.h"
 #include "ortools/sat/model.h"
 #include "ortools/sat/sat_base.h"
 #include "ortools/sat/sat_parameters.pb.h"
+#include "ortools/sat/synchronization.h"
 #include "ortools/sat/util.h"
 #include "ortools/util/strong_integers.h"
 
@@ -85,6 +89,11 @@ class PseudoCosts {
   BranchingInfo EvaluateVar(IntegerVariable var,
                             absl::Span<const double> lp_values);
 
+  // If a SharedPseudoCosts is registered in the model, exports the unit
+  // objective increases recorded since the last call, and imports the ones
+  // recorded by the other workers. They are then used by EvaluateVar().
+  void SynchronizeWithSharedPseudoCosts();
+
   // Experimental alternative pseudo cost based on the explanation for bound
   // increases.
   void UpdateBoolPseudoCosts(absl::Span<const Literal> reason,
@@ -113,12 +122,22 @@ class PseudoCosts {
   };
   ObjectiveInfo GetCurrentObjectiveInfo();
 
+  // Returns the index of the given branch in the SharedPseudoCosts, or -1 if
+  // var does not correspond to a proto variable.
+  int SharedIndex(IntegerVariable var) const;
+
+  // Returns the average unit objective increase of var and its number of
+  // records, merging the ones of this worker and of the other workers.
+  std::pair<double, int64_t> UnitObjectiveIncrease(IntegerVariable var) const;
+
   // Model object.
   const SatParameters& parameters_;
   IntegerTrail* integer_trail_;
   IntegerEncoder* encoder_;
   ModelLpValues* lp_values_;
   LinearProgrammingConstraintCollection* lps_;
+  CpModelMapping* mapping_;
+  SharedPseudoCosts* shared_pseudo_costs_;
   IntegerVariable objective_var_ = kNoIntegerVariable;
 
   // Saved info by BeforeTakingDecision().
@@ -135,6 +154,15 @@ class PseudoCosts {
   absl::StrongVector<IntegerVariable, IncrementalAverage>
       average_unit_objective_increase_;
 
+  // The records of average_unit_objective_increase_ that were not yet exported,
+  // and the records of the other workers as of the last synchronization.
+  std::vector<IntegerVariable> vars_with_unexported_records_;
+  absl::StrongVector<IntegerVariable, SharedPseudoCosts::Records>
+      unexported_records_;
+  absl::StrongVector<IntegerVariable, SharedPseudoCosts::Records>
+      other_workers_records_;
+  std::vector<SharedPseudoCosts::Records> tmp_shared_records_;
+
   // This version is based on objective increase explanation.
   absl::StrongVector<LiteralIndex, IncrementalAverage> lit_pseudo_costs_;
 };
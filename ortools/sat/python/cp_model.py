@@ -66,6 +66,7 @@ from typing import (
 import warnings
 
 import numpy as np
+from numpy import typing as npt
 import pandas as pd
 
 from ortools.sat import cp_model_pb2
@@ -1488,6 +1489,73 @@ class CpModel:
             name=name, index=index, lower_bounds=0, upper_bounds=1
         )
 
+    def new_int_var_array(
+        self,
+        lower_bounds: npt.ArrayLike,
+        upper_bounds: npt.ArrayLike,
+        name_prefix: Optional[str] = None,
+    ) -> np.ndarray:
+        """Creates an array of integer variables in bulk.
+
+        Unlike new_int_var_series(), no `IntVar` object is created: the variables
+        are added directly to the proto, and are referred to by their indices.
+        This is much faster on large models. The indices can be used with
+        add_linear_constraints_from_csr() and CpSolver.values_as_numpy(), or
+        wrapped with get_int_var_from_proto_index().
+
+        Args:
+          lower_bounds: The lower bounds of the variables, as a 1D integral array.
+          upper_bounds: The upper bounds of the variables, with the same shape as
+            `lower_bounds`.
+          name_prefix: If not None, the i-th variable is named `name_prefix[i]`.
+
+        Returns:
+          np.ndarray: The indices of the new variables in the model.
+
+        Raises:
+          ValueError: if the bounds do not have the same 1D shape, or if a lower
+          bound is greater than the corresponding upper bound.
+        """
+        lbs = np.asarray(lower_bounds, dtype=np.int64)
+        ubs = np.asarray(upper_bounds, dtype=np.int64)
+        if lbs.ndim != 1 or lbs.shape != ubs.shape:
+            raise ValueError(
+                f"bounds must be 1D arrays of the same shape, got {lbs.shape} and"
+                f" {ubs.shape}"
+            )
+        if np.any(lbs > ubs):
+            raise ValueError("a lower bound is greater than its upper bound")
+        first_index = len(self.__model.variables)
+        variables = self.__model.variables
+        # Converting the arrays to lists once is much faster than converting
+        # each numpy scalar.
+        for i, (lb, ub) in enumerate(zip(lbs.tolist(), ubs.tolist())):
+            if name_prefix is None:
+                variables.add(domain=(lb, ub))
+            else:
+                variables.add(domain=(lb, ub), name=f"{name_prefix}[{i}]")
+        return np.arange(first_index, len(variables), dtype=np.int32)
+
+    def new_bool_var_array(
+        self, size: int, name_prefix: Optional[str] = None
+    ) -> np.ndarray:
+        """Creates an array of `size` Boolean variables in bulk.
+
+        See new_int_var_array().
+
+        Args:
+          size: The number of variables to create.
+          name_prefix: If not None, the i-th variable is named `name_prefix[i]`.
+
+        Returns:
+          np.ndarray: The indices of the new variables in the model.
+        """
+        return self.new_int_var_array(
+            np.zeros(size, dtype=np.int64),
+            np.ones(size, dtype=np.int64),
+            name_prefix,
+        )
+
     # Linear constraints.
 
     def add_linear_constraint(
@@ -1532,6 +1600,71 @@ class CpModel:
             + ")"
         )
 
+    def add_linear_constraints_from_csr(
+        self,
+        indptr: npt.ArrayLike,
+        indices: npt.ArrayLike,
+        data: npt.ArrayLike,
+        lower_bounds: npt.ArrayLike,
+        upper_bounds: npt.ArrayLike,
+    ) -> np.ndarray:
+        """Adds the constraints `lower_bounds <= A @ x <= upper_bounds` in bulk.
+
+        The matrix `A` is given in the compressed sparse row format of
+        `scipy.sparse.csr_matrix`: the terms of the i-th constraint are the
+        variables `indices[indptr[i]:indptr[i + 1]]`, which are indices in the
+        model as returned by new_int_var_array() or `IntVar.index`, with the
+        coefficients `data[indptr[i]:indptr[i + 1]]`.
+
+        Args:
+          indptr: The row pointers, of size `num_constraints + 1`.
+          indices: The variable indices of the terms.
+          data: The integral coefficients of the terms.
+          lower_bounds: The lower bounds of the constraints, of size
+            `num_constraints`.
+          upper_bounds: The upper bounds of the constraints, of size
+            `num_constraints`.
+
+        Returns:
+          np.ndarray: The indices of the new constraints in the model.
+
+        Raises:
+          ValueError: if the arrays are not consistent, or refer to variables that
+          are not in the model.
+        """
+        indptr = np.asarray(indptr, dtype=np.int64)
+        indices = np.asarray(indices, dtype=np.int64)
+        data = np.asarray(data, dtype=np.int64)
+        lbs = np.asarray(lower_bounds, dtype=np.int64)
+        ubs = np.asarray(upper_bounds, dtype=np.int64)
+        num_constraints = len(indptr) - 1
+        if num_constraints < 0 or lbs.shape != (num_constraints,):
+            raise ValueError("indptr and lower_bounds sizes do not match")
+        if ubs.shape != lbs.shape:
+            raise ValueError("lower_bounds and upper_bounds sizes do not match")
+        if indices.shape != data.shape or indptr[-1] != len(indices):
+            raise ValueError("indptr, indices and data sizes do not match")
+        if np.any(np.diff(indptr) < 0):
+            raise ValueError("indptr must be non-decreasing")
+        if len(indices) and (
+            indices.min() < 0 or indices.max() >= len(self.__model.variables)
+        ):
+            raise ValueError("a variable index is out of bound")
+        first_index = len(self.__model.constraints)
+        constraints = self.__model.constraints
+        # Converting the arrays to lists once is much faster than converting
+        # each numpy scalar.
+        starts = indptr.tolist()
+        var_list = indices.tolist()
+        coeff_list = data.tolist()
+        for i, (lb, ub) in enumerate(zip(lbs.tolist(), ubs.tolist())):
+            start, end = starts[i], starts[i + 1]
+            linear = constraints.add().linear
+            linear.vars.extend(var_list[start:end])
+            linear.coeffs.extend(coeff_list[start:end])
+            linear.domain.extend((lb, ub))
+        return np.arange(first_index, len(constraints), dtype=np.int32)
+
     @overload
     def add(self, ct: BoundedLinearExpression) -> Constraint: ...
 
@@ -3199,6 +3332,28 @@ class CpSolver:
             values=variables,
         )
 
+    def values_as_numpy(
+        self, variable_indices: Optional[npt.ArrayLike] = None
+    ) -> np.ndarray:
+        """Returns the values of the variables as a numpy array.
+
+        This does not go through a Python call per variable, and is the fastest
+        way to read a large solution.
+
+        Args:
+          variable_indices: If not None, the indices in the model of the
+            variables, as returned by CpModel.new_int_var_array(). Otherwise, the
+            values of all the variables of the model are returned.
+
+        Returns:
+          np.ndarray: The values of the variables, as an int64 array.
+        """
+        solution = self._solution.solution
+        values = np.fromiter(solution, dtype=np.int64, count=len(solution))
+        if variable_indices is None:
+            return values
+        return values[np.asarray(variable_indices, dtype=np.int64)]
+
     def boolean_value(self, literal: LiteralT) -> bool:
         """Returns the boolean value of a literal after solve."""
         return evaluate_boolean_expression(literal, self._solution)
@@ -3514,6 +3669,20 @@ class CpSolverSolutionCallback(swig_helper.SolutionCallback):
             raise RuntimeError("solve() has not been called.")
         self.StopSearch()
 
+    def set_callback_period(self, period: int) -> None:
+        """Only calls on_solution_callback() on every `period`-th solution.
+
+        The solver workers wait while the Python callback runs. On models with
+        many improving solutions, a period greater than 1 reduces this overhead.
+        The final solution is always available in the solver response.
+
+        Args:
+          period: A positive integer, 1 by default.
+        """
+        if period < 1:
+            raise ValueError(f"invalid callback period {period}")
+        self.SetCallbackPeriod(period)
+
     @property
     def objective_value(self) -> float:
         """Returns the value of the objective after solve."""
@@ -658,6 +658,20 @@ class CpModelTest(absltest.TestCase):
             [(0, 1, 2, 3, 4), (4, 3, 2, 1, 1), (0, 0, 0, 0)],
         )
 
+    def testAllowedAssignmentsWithTablePropagator(self):
+        print("testAllowedAssignmentsWithTablePropagator")
+        model = cp_model.CpModel()
+        x = [model.new_int_var(0, 4, "x%i" % i) for i in range(3)]
+        tuples = [(i, (i + 1) % 5, (i * 3) % 5) for i in range(5)]
+        model.add_allowed_assignments(x, tuples)
+        model.add(x[0] != 4)
+        model.maximize(x[0] + x[1] + x[2])
+        solver = cp_model.CpSolver()
+        solver.parameters.min_num_tuples_for_table_propagator = 1
+        self.assertEqual(cp_model.OPTIMAL, solver.solve(model))
+        self.assertIn(tuple(solver.value(v) for v in x), tuples)
+        self.assertEqual(11, solver.objective_value)
+
     def testAutomaton(self):
         print("testAutomaton")
         model = cp_model.CpModel()
@@ -1239,6 +1253,21 @@ class CpModelTest(absltest.TestCase):
         self.assertEqual(5, solution_counter.solution_count)
         model.minimize(x)
 
+    def testSearchForAllSolutionsWithCallbackPeriod(self):
+        print("testSearchForAllSolutionsWithCallbackPeriod")
+        model = cp_model.CpModel()
+        x = model.new_int_var(0, 5, "x")
+        y = model.new_int_var(0, 5, "y")
+        model.add_linear_constraint(x + y, 6, 6)
+
+        solver = cp_model.CpSolver()
+        solver.parameters.enumerate_all_solutions = True
+        solution_counter = SolutionCounter()
+        solution_counter.set_callback_period(2)
+        status = solver.solve(model, solution_counter)
+        self.assertEqual(cp_model.OPTIMAL, status)
+        self.assertEqual(2, solution_counter.solution_count)
+
     def testSolveWithSolutionCallback(self):
         print("testSolveWithSolutionCallback")
         model = cp_model.CpModel()
@@ -1540,6 +1569,30 @@ class CpModelTest(absltest.TestCase):
         solution = solver.boolean_values(x)
         self.assertTrue((solution.values == [False, True, False]).all())
 
+    def testIntVarArrayAndCsrConstraints(self):
+        print("testIntVarArrayAndCsrConstraints")
+        model = cp_model.CpModel()
+        x = model.new_int_var_array([0, 0, 0], [5, 5, 5], "x")
+        self.assertEqual(x.tolist(), [0, 1, 2])
+        self.assertEqual(model.proto.variables[1].name, "x[1]")
+        # x0 + x1 >= 3, x1 - x2 == 1.
+        cts = model.add_linear_constraints_from_csr(
+            indptr=[0, 2, 4],
+            indices=[x[0], x[1], x[1], x[2]],
+            data=[1, 1, 1, -1],
+            lower_bounds=[3, 1],
+            upper_bounds=[10, 1],
+        )
+        self.assertEqual(cts.tolist(), [0, 1])
+        self.assertEqual(model.proto.constraints[1].linear.coeffs, [1, -1])
+        model.minimize(sum(model.get_int_var_from_proto_index(i) for i in x))
+        solver = cp_model.CpSolver()
+        self.assertEqual(cp_model.OPTIMAL, solver.solve(model))
+        self.assertEqual(solver.values_as_numpy(x).tolist(), [2, 1, 0])
+        self.assertEqual(solver.values_as_numpy().tolist(), [2, 1, 0])
+        with self.assertRaises(ValueError):
+            model.add_linear_constraints_from_csr([0, 1], [3], [1], [0], [1])
+
     def testFixedSizeIntervalVarSeries(self):
         print("testFixedSizeIntervalVarSeries")
         df = pd.DataFrame([2, 4, 6], columns=["size"])
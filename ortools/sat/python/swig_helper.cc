@@ -82,6 +82,8 @@ PYBIND11_MODULE(swig_helper, m) {
            arg("index"))
       .def("SolutionIntegerValue", &SolutionCallback::SolutionIntegerValue,
            arg("index"))
+      .def("SetCallbackPeriod", &SolutionCallback::SetCallbackPeriod,
+           arg("period"))
       .def("StopSearch", &SolutionCallback::StopSearch)
       .def("UserTime", &SolutionCallback::UserTime)
       .def("WallTime", &SolutionCallback::WallTime);
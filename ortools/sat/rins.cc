@@ -17,6 +17,7 @@
 #include <cmath>
 #include <cstdint>
 #include <limits>
+#include <memory>
 #include <random>
 #include <string>
 #include <utility>
@@ -64,24 +65,6 @@ void RecordLPRelaxationValues(Model* model) {
 
 namespace {
 
-std::vector<double> GetLPRelaxationValues(
-    const SharedLPSolutionRepository* lp_solutions, absl::BitGenRef random) {
-  std::vector<double> relaxation_values;
-
-  if (lp_solutions == nullptr || lp_solutions->NumSolutions() == 0) {
-    return relaxation_values;
-  }
-
-  const SharedSolutionRepository<double>::Solution lp_solution =
-      lp_solutions->GetRandomBiasedSolution(random);
-
-  for (int model_var = 0; model_var < lp_solution.variable_values.size();
-       ++model_var) {
-    relaxation_values.push_back(lp_solution.variable_values[model_var]);
-  }
-  return relaxation_values;
-}
-
 std::vector<double> GetIncompleteSolutionValues(
     SharedIncompleteSolutionManager* incomplete_solutions) {
   std::vector<double> empty_solution_values;
@@ -179,7 +162,8 @@ ReducedDomainNeighborhood GetRinsRensNeighborhood(
   ReducedDomainNeighborhood reduced_domains;
   CHECK(lp_solutions != nullptr);
   CHECK(incomplete_solutions != nullptr);
-  const bool lp_solution_available = lp_solutions->NumSolutions() > 0;
+  const bool lp_solution_available =
+      lp_solutions->LatestLPSolutionSequenceNumber() > 0;
   const bool incomplete_solution_available =
       incomplete_solutions->HasSolution();
 
@@ -196,9 +180,18 @@ ReducedDomainNeighborhood GetRinsRensNeighborhood(
           ? random_bool(random)
           : lp_solution_available;
 
-  const std::vector<double> relaxation_values =
-      use_lp_relaxation ? GetLPRelaxationValues(lp_solutions, random)
-                        : GetIncompleteSolutionValues(incomplete_solutions);
+  // The LP solutions are shared and never modified, so we do not need to copy
+  // them. We always use the freshest one.
+  std::shared_ptr<const SharedLPSolutionRepository::Solution> lp_solution;
+  std::vector<double> incomplete_solution;
+  absl::Span<const double> relaxation_values;
+  if (use_lp_relaxation) {
+    lp_solution = lp_solutions->GetLatestLPSolution();
+    if (lp_solution != nullptr) relaxation_values = lp_solution->variable_values;
+  } else {
+    incomplete_solution = GetIncompleteSolutionValues(incomplete_solutions);
+    relaxation_values = incomplete_solution;
+  }
   if (relaxation_values.empty()) return reduced_domains;  // Not generated.
 
   std::bernoulli_distribution three_out_of_four(0.75);
@@ -206,12 +199,11 @@ ReducedDomainNeighborhood GetRinsRensNeighborhood(
   if (response_manager != nullptr &&
       response_manager->SolutionsRepository().NumSolutions() > 0 &&
       three_out_of_four(random)) {  // Rins.
-    const std::vector<int64_t> solution =
-        response_manager->SolutionsRepository()
-            .GetRandomBiasedSolution(random)
-            .variable_values;
-    FillRinsNeighborhood(solution, relaxation_values, difficulty, random,
-                         reduced_domains);
+    const std::shared_ptr<const SharedSolutionRepository<int64_t>::Solution>
+        solution = response_manager->SolutionsRepository()
+                       .GetRandomBiasedSolution(random);
+    FillRinsNeighborhood(solution->variable_values, relaxation_values,
+                         difficulty, random, reduced_domains);
     reduced_domains.source_info = "rins_";
   } else {  // Rens.
     FillRensNeighborhood(relaxation_values, difficulty, random,
@@ -290,7 +290,7 @@ void SatDecisionPolicy::BumpVariableActivities(
     return;
   }
 
-  const double max_activity_value = parameters_.max_variable_activity_value();
+  const double max_activity_value = MaxActivityValue();
   for (const Literal literal : literals) {
     const BooleanVariable var = literal.Variable();
     const int level = trail_.Info(var).level;
@@ -325,6 +325,19 @@ void SatDecisionPolicy::RescaleVariableActivities(double scaling_factor) {
 
 void SatDecisionPolicy::UpdateVariableActivityIncrement() {
   variable_activity_increment_ *= 1.0 / parameters_.variable_activity_decay();
+
+  // The increment can grow without any bumped activity if all the conflict
+  // literals were fixed at level zero.
+  const double max_activity_value = MaxActivityValue();
+  if (variable_activity_increment_ > max_activity_value) {
+    RescaleVariableActivities(1.0 / max_activity_value);
+  }
+}
+
+double SatDecisionPolicy::MaxActivityValue() const {
+  // Note that we stay far from the float limit so that an activity can still be
+  // incremented once above this value without overflowing.
+  return std::min(parameters_.max_variable_activity_value(), 1e30);
 }
 
 Literal SatDecisionPolicy::NextBranch() {
@@ -445,6 +445,13 @@ bool Inprocessing::SubsumeAndStrenghtenRound(bool log_info) {
   int64_t num_removed_literals = 0;
   int64_t num_inspected_signatures = 0;
   int64_t num_inspected_literals = 0;
+  int64_t num_binary_subsumed_clauses = 0;
+  int64_t num_binary_removed_literals = 0;
+  const auto work_done = [&num_inspected_signatures,
+                          &num_inspected_literals]() {
+    return static_cast<double>(num_inspected_signatures) * 1e-8 +
+           static_cast<double>(num_inspected_literals) * 5e-9;
+  };
 
   // We need this temporary vector for the DRAT proof settings, otherwise
   // we could just have done an in-place transformation.
@@ -482,23 +489,11 @@ bool Inprocessing::SubsumeAndStrenghtenRound(bool log_info) {
   for (int clause_index = 0; clause_index < clauses.size(); ++clause_index) {
     SatClause* clause = clauses[clause_index];
 
-    // TODO(user): Better abort limit. We could also limit the watcher sizes and
-    // never look at really long clauses. Note that for an easier
-    // incrementality, it is better to reach some kind of completion so we know
-    // what new stuff need to be done.
-    if (num_inspected_literals + num_inspected_signatures > 1e9) {
-      break;
-    }
-
-    // Check for subsumption, note that this currently ignore all clauses in the
-    // binary implication graphs. Stamping is doing some of that (and some also
-    // happen during probing), but we could consider only direct implications
-    // here and be a bit more exhaustive than what stamping do with them (at
-    // least for node with many incoming and outgoing implications).
-    //
-    // TODO(user): Do some reduction using binary clauses. Note that only clause
-    // that never propagated since last round need to be checked for binary
-    // subsumption.
+    // TODO(user): We could also limit the watcher sizes and never look at
+    // really long clauses. Note that for an easier incrementality, it is better
+    // to reach some kind of completion so we know what new stuff need to be
+    // done.
+    if (work_done() > params_.inprocessing_subsumption_dtime()) break;
 
     // Compute hash and mark literals.
     uint64_t signature = 0;
@@ -508,11 +503,42 @@ bool Inprocessing::SubsumeAndStrenghtenRound(bool log_info) {
       signature |= (uint64_t{1} << (l.Variable().value() % 64));
     }
 
+    // Check for subsumption and strengthening with the direct implications of
+    // the binary implication graph. A binary clause (l, m) with l in the
+    // clause subsumes it if m is also in the clause, and otherwise allows to
+    // remove not(m) from it. Stamping is doing some of that, but only with the
+    // implications captured by its spanning tree.
+    //
+    // TODO(user): Note that only clause that never propagated since last round
+    // need to be checked for binary subsumption.
+    bool removed = false;
+    candidates_for_removal.clear();
+    for (const Literal l : clause->AsSpan()) {
+      const auto& implications = implication_graph_->Implications(l.Negated());
+      num_inspected_literals += implications.size();
+      for (const Literal m : implications) {
+        if (marked[m]) {
+          removed = true;
+          break;
+        }
+        if (marked[m.NegatedIndex()]) {
+          candidates_for_removal.push_back(m.Negated());
+        }
+      }
+      if (removed) break;
+    }
+    if (removed) {
+      ++num_subsumed_clauses;
+      ++num_binary_subsumed_clauses;
+      num_removed_literals += clause->size();
+      clause_manager_->InprocessingRemoveClause(clause);
+      continue;
+    }
+    const bool strengthened_with_binary = !candidates_for_removal.empty();
+
     // Look for clause that subsumes this one. Note that because we inspect
     // all one watcher lists for the literals of this clause, if a clause is
     // included inside this one, it must appear in one of these lists.
-    bool removed = false;
-    candidates_for_removal.clear();
     const uint64_t mask = ~signature;
     for (const Literal l : clause->AsSpan()) {
       num_inspected_signatures += one_watcher[l].size();
@@ -586,6 +612,7 @@ bool Inprocessing::SubsumeAndStrenghtenRound(bool log_info) {
       CHECK_EQ(new_clause.size() + 1, clause->size());
 
       num_removed_literals += clause->size() - new_clause.size();
+      if (strengthened_with_binary) ++num_binary_removed_literals;
       if (!clause_manager_->InprocessingRewriteClause(clause, new_clause)) {
         return false;
       }
@@ -636,12 +663,13 @@ bool Inprocessing::SubsumeAndStrenghtenRound(bool log_info) {
   if (!LevelZeroPropagate()) return false;
 
   // TODO(user): tune the deterministic time.
-  const double dtime = static_cast<double>(num_inspected_signatures) * 1e-8 +
-                       static_cast<double>(num_inspected_literals) * 5e-9;
+  const double dtime = work_done();
   time_limit_->AdvanceDeterministicTime(dtime);
   LOG_IF(INFO, log_info) << "Subsume. num_removed_literals: "
                          << num_removed_literals
                          << " num_subsumed: " << num_subsumed_clauses
+                         << " with_binary: " << num_binary_removed_literals
+                         << "|" << num_binary_subsumed_clauses
                          << " dtime: " << dtime
                          << " wtime: " << wall_timer.Get();
   return true;
@@ -1148,6 +1176,14 @@ bool BlockedClauseSimplifier::ClauseIsBlocked(
   return is_blocked;
 }
 
+namespace {
+
+uint64_t LiteralSignature(LiteralIndex index) {
+  return uint64_t{1} << (index.value() & 63);
+}
+
+}  // namespace
+
 bool BoundedVariableElimination::DoOneRound(bool log_info) {
   WallTimer wall_timer;
   wall_timer.Start();
@@ -1159,6 +1195,7 @@ bool BoundedVariableElimination::DoOneRound(bool log_info) {
   num_clauses_diff_ = 0;
   num_simplifications_ = 0;
   num_blocked_clauses_ = 0;
+  num_resolvents_with_signature_ = 0;
 
   clauses_.clear();
   clause_manager_->DeleteRemovedClauses();
@@ -1177,10 +1214,14 @@ bool BoundedVariableElimination::DoOneRound(bool log_info) {
   literal_to_clauses_.clear();
   literal_to_clauses_.resize(num_literals);
   literal_to_num_clauses_.assign(num_literals, 0);
+  clause_signatures_.assign(clauses_.size(), ClauseSignature());
   for (ClauseIndex i(0); i < clauses_.size(); ++i) {
+    ClauseSignature& signature = clause_signatures_[i];
     for (const Literal l : clauses_[i]->AsSpan()) {
       literal_to_clauses_[l].push_back(i);
       literal_to_num_clauses_[l]++;
+      signature.literals |= LiteralSignature(l.Index());
+      signature.negations |= LiteralSignature(l.NegatedIndex());
     }
     num_inspected_literals_ += clauses_[i]->size();
   }
@@ -1250,6 +1291,7 @@ bool BoundedVariableElimination::DoOneRound(bool log_info) {
   // Release some memory.
   literal_to_clauses_.clear();
   literal_to_num_clauses_.clear();
+  clause_signatures_.clear();
 
   dtime_ += 1e-8 * num_inspected_literals_;
   time_limit_->AdvanceDeterministicTime(dtime_);
@@ -1261,6 +1303,8 @@ bool BoundedVariableElimination::DoOneRound(bool log_info) {
                          << " num_eliminations: " << num_eliminated_variables_
                          << " num_literals_diff: " << num_literals_diff_
                          << " num_clause_diff: " << num_clauses_diff_
+                         << " num_resolvents_with_signature: "
+                         << num_resolvents_with_signature_
                          << " dtime: " << dtime_
                          << " wtime: " << wall_timer.Get();
   return true;
@@ -1375,6 +1419,12 @@ void BoundedVariableElimination::AddClause(absl::Span<const Literal> clause) {
 
   const ClauseIndex index(clauses_.size());
   clauses_.push_back(pt);
+  ClauseSignature signature;
+  for (const Literal l : clause) {
+    signature.literals |= LiteralSignature(l.Index());
+    signature.negations |= LiteralSignature(l.NegatedIndex());
+  }
+  clause_signatures_.push_back(signature);
   for (const Literal l : clause) {
     literal_to_num_clauses_[l]++;
     literal_to_clauses_[l].push_back(index);
@@ -1398,8 +1448,12 @@ bool BoundedVariableElimination::ResolveAllClauseContaining(Literal lit) {
     if (clause.empty()) continue;
 
     if (!score_only) resolvant_.clear();
+    uint64_t signature_without_lit = 0;
     for (const Literal l : clause) {
       if (!score_only && l != lit) resolvant_.push_back(l);
+      if (score_only && l != lit) {
+        signature_without_lit |= LiteralSignature(l.Index());
+      }
       marked_[l] = true;
     }
     DCHECK(marked_[lit]);
@@ -1438,17 +1492,29 @@ bool BoundedVariableElimination::ResolveAllClauseContaining(Literal lit) {
         if (other.empty()) continue;
         bool trivial = false;
         int extra_size = 0;
-        for (const Literal l : other) {
-          // TODO(user): we can optimize this by updating it outside the loop.
+        const ClauseSignature& other_signature =
+            clause_signatures_[other_index];
+        if (score_only &&
+            (signature_without_lit &
+             (other_signature.literals | other_signature.negations)) == 0) {
+          // No literal of other, except not(lit), appears in clause, negated
+          // or not.
+          ++num_resolvents_with_signature_;
           ++num_inspected_literals_;
-          if (l == lit.Negated()) continue;
-          if (marked_[l.NegatedIndex()]) {
-            trivial = true;
-            break;
-          }
-          if (!marked_[l]) {
-            ++extra_size;
-            if (!score_only) resolvant_.push_back(l);
+          extra_size = other.size() - 1;
+        } else {
+          for (const Literal l : other) {
+            // TODO(user): we can optimize this by updating it outside the loop.
+            ++num_inspected_literals_;
+            if (l == lit.Negated()) continue;
+            if (marked_[l.NegatedIndex()]) {
+              trivial = true;
+              break;
+            }
+            if (!marked_[l]) {
+              ++extra_size;
+              if (!score_only) resolvant_.push_back(l);
+            }
           }
         }
         if (trivial) {
@@ -396,6 +396,19 @@ class BoundedVariableElimination {
   absl::StrongVector<LiteralIndex, std::vector<ClauseIndex>>
       literal_to_clauses_;
   absl::StrongVector<LiteralIndex, int> literal_to_num_clauses_;
+
+  // A 64 bits signature of the literals of each clause, and of their
+  // negations. When the signature of a clause does not intersect the ones of
+  // the other side, the resolvent is not trivial and contains all the literals
+  // of both clauses, so its size is known without looking at the literals.
+  // The signatures are not updated when literals are removed from a clause,
+  // this is fine since they stay a superset of the actual ones.
+  struct ClauseSignature {
+    uint64_t literals = 0;
+    uint64_t negations = 0;
+  };
+  absl::StrongVector<ClauseIndex, ClauseSignature> clause_signatures_;
+  int64_t num_resolvents_with_signature_ = 0;
 };
 
 }  // namespace sat
@@ -11,8 +11,13 @@
 // See the License for the specific language governing permissions and
 // limitations under the License.
 
+#include <algorithm>
+#include <atomic>
 #include <cstdlib>
+#include <memory>
 #include <string>
+#include <thread>  // NOLINT
+#include <vector>
 
 #include "absl/flags/flag.h"
 #include "absl/flags/parse.h"
@@ -23,12 +28,16 @@
 #include "absl/strings/match.h"
 #include "absl/strings/str_format.h"
 #include "absl/strings/string_view.h"
+#include "absl/synchronization/blocking_counter.h"
 #include "google/protobuf/arena.h"
 #include "google/protobuf/text_format.h"
+#include "ortools/base/file.h"
 #include "ortools/base/helpers.h"
 #include "ortools/base/logging.h"
 #include "ortools/base/options.h"
 #include "ortools/base/path.h"
+#include "ortools/base/recordio.h"
+#include "ortools/base/threadpool.h"
 #include "ortools/sat/boolean_problem.h"
 #include "ortools/sat/boolean_problem.pb.h"
 #include "ortools/sat/cp_model.pb.h"
@@ -44,7 +53,10 @@ ABSL_FLAG(
     std::string, input, "",
     "Required: input file of the problem to solve. Many format are supported:"
     ".cnf (sat, max-sat, weighted max-sat), .opb (pseudo-boolean sat/optim) "
-    "and by default the CpModelProto proto (binary or text).");
+    "and by default the CpModelProto proto (binary or text). Very large "
+    "models can also be given as a .recordio file whose first record is a "
+    "CpModelProto without constraints and each following record is one "
+    "ConstraintProto. The constraints are then parsed in parallel.");
 
 ABSL_FLAG(
     std::string, hint_file, "",
@@ -84,9 +96,80 @@ std::string ExtractName(absl::string_view full_filename) {
   TryToRemoveSuffix("prototxt", &filename);
   TryToRemoveSuffix("textproto", &filename);
   TryToRemoveSuffix("bin", &filename);
+  TryToRemoveSuffix("recordio", &filename);
   return filename;
 }
 
+// Reads a model in the recordio format described in --input. The records are
+// read sequentially, but they are parsed by batches in a thread pool, directly
+// into the constraints of cp_model. We read the next batch while the current
+// one is being parsed.
+bool LoadCpModelFromRecordIo(const std::string& filename,
+                             CpModelProto* cp_model) {
+  File* file;
+  if (!file::Open(filename, "r", &file, file::Defaults()).ok()) return false;
+  recordio::RecordReader reader(file);
+  std::string header;
+  if (!reader.ReadRecord(&header) || !cp_model->ParseFromString(header)) {
+    LOG(ERROR) << "Cannot read the model header in '" << filename << "'.";
+    return false;
+  }
+
+  constexpr int kBatchSize = 1 << 14;
+  const int num_threads = std::max<int>(std::thread::hardware_concurrency(), 1);
+  ThreadPool pool("LoadCpModelFromRecordIo", num_threads);
+  pool.StartWorkers();
+
+  std::atomic<bool> parse_ok = true;
+  std::vector<std::string> batches[2];
+  std::vector<ConstraintProto*> batch_constraints[2];
+  std::unique_ptr<absl::BlockingCounter> in_flight[2];
+  for (int batch = 0;; batch ^= 1) {
+    // Wait until the records of the batch that used this buffer are parsed.
+    if (in_flight[batch] != nullptr) {
+      in_flight[batch]->Wait();
+      in_flight[batch].reset();
+    }
+    std::vector<std::string>& records = batches[batch];
+    records.resize(kBatchSize);
+    int num_records = 0;
+    while (num_records < kBatchSize &&
+           reader.ReadRecord(&records[num_records])) {
+      ++num_records;
+    }
+    if (num_records == 0) break;
+
+    // Allocating the messages is not thread-safe, so we do it here.
+    std::vector<ConstraintProto*>& constraints = batch_constraints[batch];
+    constraints.resize(num_records);
+    for (int i = 0; i < num_records; ++i) {
+      constraints[i] = cp_model->add_constraints();
+    }
+    const int chunk_size = (num_records + num_threads - 1) / num_threads;
+    const int num_chunks = (num_records + chunk_size - 1) / chunk_size;
+    in_flight[batch] = std::make_unique<absl::BlockingCounter>(num_chunks);
+    for (int begin = 0; begin < num_records; begin += chunk_size) {
+      const int end = std::min(begin + chunk_size, num_records);
+      pool.Schedule([begin, end, &constraints, &records, &parse_ok,
+                     counter = in_flight[batch].get()]() {
+        for (int i = begin; i < end; ++i) {
+          if (!constraints[i]->ParseFromString(records[i])) parse_ok = false;
+        }
+        counter->DecrementCount();
+      });
+    }
+    if (num_records < kBatchSize) break;
+  }
+  for (auto& counter : in_flight) {
+    if (counter != nullptr) counter->Wait();
+  }
+  if (!parse_ok) {
+    LOG(ERROR) << "Cannot parse a constraint in '" << filename << "'.";
+    return false;
+  }
+  return reader.Close();
+}
+
 bool LoadProblem(const std::string& filename, absl::string_view hint_file,
                  CpModelProto* cp_model) {
   if (absl::EndsWith(filename, ".opb") ||
@@ -107,6 +190,11 @@ bool LoadProblem(const std::string& filename, absl::string_view hint_file,
     if (!reader.Load(filename, cp_model)) {
       LOG(FATAL) << "Cannot load file '" << filename << "'.";
     }
+  } else if (absl::EndsWith(filename, ".recordio")) {
+    LOG(INFO) << "Reading a CpModelProto from a recordio file.";
+    if (!LoadCpModelFromRecordIo(filename, cp_model)) {
+      LOG(FATAL) << "Cannot load file '" << filename << "'.";
+    }
   } else {
     LOG(INFO) << "Reading a CpModelProto.";
     CHECK_OK(ReadFileToProto(filename, cp_model));
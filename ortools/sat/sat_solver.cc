@@ -189,6 +189,33 @@ bool SatSolver::AddClauseDuringSearch(absl::Span<const Literal> literals) {
   return FinishPropagation();
 }
 
+bool SatSolver::AddImportedLearnedClause(absl::Span<const Literal> literals,
+                                         int lbd) {
+  CHECK_EQ(CurrentDecisionLevel(), 0);
+  if (model_is_unsat_) return false;
+
+  // We cannot justify such a clause in the proof.
+  if (drat_proof_handler_ != nullptr) return true;
+
+  literals_scratchpad_.clear();
+  for (const Literal l : literals) {
+    if (trail_->Assignment().LiteralIsTrue(l)) return true;
+    if (trail_->Assignment().LiteralIsFalse(l)) continue;
+    literals_scratchpad_.push_back(l);
+  }
+  if (literals_scratchpad_.size() <= 2) {
+    return AddProblemClause(literals_scratchpad_);
+  }
+
+  // All the literals are unassigned, so this cannot propagate anything.
+  SatClause* clause =
+      clauses_propagator_->AddRemovableClause(literals_scratchpad_, trail_);
+  ClauseInfo& info = (*clauses_propagator_->mutable_clauses_info())[clause];
+  info.lbd = std::min<int>(lbd, literals_scratchpad_.size());
+  BumpClauseActivity(clause);
+  return true;
+}
+
 bool SatSolver::AddUnitClause(Literal true_literal) {
   return AddProblemClause({true_literal});
 }
@@ -428,6 +455,9 @@ int SatSolver::AddLearnedClauseAndEnqueueUnitPropagation(
   // Important: Even though the only literal at the last decision level has
   // been unassigned, its level was not modified, so ComputeLbd() works.
   const int lbd = ComputeLbd(literals);
+  if (learned_clause_callback_ != nullptr) {
+    learned_clause_callback_(lbd, literals);
+  }
   if (is_redundant && lbd > parameters_->clause_cleanup_lbd_bound()) {
     --num_learned_clause_before_cleanup_;
 
@@ -1713,8 +1743,9 @@ std::string SatSolver::StatusString(Status status) const {
              binary_implication_graph_->num_redundant_implications()) +
          absl::StrFormat(
              "  num classic minimizations: %d"
-             "  (literals removed: %d)\n",
-             counters_.num_minimizations, counters_.num_literals_removed) +
+             "  (literals removed: %d, literals inspected: %d)\n",
+             counters_.num_minimizations, counters_.num_literals_removed,
+             counters_.num_minimization_inspected_literals) +
          absl::StrFormat(
              "  num binary minimizations: %d"
              "  (literals removed: %d)\n",
@@ -1862,6 +1893,7 @@ bool SatSolver::PropagationIsDone() const {
 // part or the full integer part...
 bool SatSolver::Propagate() {
   SCOPED_TIME_STAT(&stats_);
+  SCOPED_PROFILING_COUNTER("sat.Propagate");
   DCHECK(!ModelIsUnsat());
 
   while (true) {
@@ -2424,8 +2456,10 @@ void SatSolver::MinimizeConflictRecursively(std::vector<Literal>* conflict) {
   // Note(user): Because is_marked_ may actually contains literals that are
   // implied if the 1-UIP literal is false, we can't just iterate on the
   // variables of the conflict here.
+  conflict_level_abstraction_ = 0;
   for (BooleanVariable var : is_marked_.PositionsSetAtLeastOnce()) {
     const int level = DecisionLevel(var);
+    conflict_level_abstraction_ |= LevelAbstraction(level);
     min_trail_index_per_level_[level] = std::min(
         min_trail_index_per_level_[level], trail_->Info(var).trail_index);
   }
@@ -2487,7 +2521,9 @@ bool SatSolver::CanBeInferedFromConflictVariables(BooleanVariable variable) {
   variable_to_process_.push_back(variable);
 
   // First we expand the reason for the given variable.
-  for (const Literal literal : trail_->Reason(variable)) {
+  const absl::Span<const Literal> reason = trail_->Reason(variable);
+  counters_.num_minimization_inspected_literals += reason.size();
+  for (const Literal literal : reason) {
     const BooleanVariable var = literal.Variable();
     DCHECK_NE(var, variable);
     if (is_marked_[var]) continue;
@@ -2500,7 +2536,8 @@ bool SatSolver::CanBeInferedFromConflictVariables(BooleanVariable variable) {
       is_marked_.Set(var);
       continue;
     }
-    if (info.trail_index <= min_trail_index_per_level_[info.level] ||
+    if ((conflict_level_abstraction_ & LevelAbstraction(info.level)) == 0 ||
+        info.trail_index <= min_trail_index_per_level_[info.level] ||
         info.type == AssignmentType::kSearchDecision || is_independent_[var]) {
       return false;
     }
@@ -2547,12 +2584,15 @@ bool SatSolver::CanBeInferedFromConflictVariables(BooleanVariable variable) {
     // Expand the variable. This can be seen as making a recursive call.
     dfs_stack_.push_back(current_var);
     bool abort_early = false;
-    for (Literal literal : trail_->Reason(current_var)) {
+    const absl::Span<const Literal> reason = trail_->Reason(current_var);
+    counters_.num_minimization_inspected_literals += reason.size();
+    for (Literal literal : reason) {
       const BooleanVariable var = literal.Variable();
       DCHECK_NE(var, current_var);
       const AssignmentInfo& info = trail_->Info(var);
       if (info.level == 0 || is_marked_[var]) continue;
-      if (info.trail_index <= min_trail_index_per_level_[info.level] ||
+      if ((conflict_level_abstraction_ & LevelAbstraction(info.level)) == 0 ||
+          info.trail_index <= min_trail_index_per_level_[info.level] ||
           info.type == AssignmentType::kSearchDecision ||
           is_independent_[var]) {
         abort_early = true;
@@ -2753,6 +2793,7 @@ void SatSolver::CleanClauseDatabaseIfNeeded() {
     // full list of clauses by not keeping the clauses from clauses_info there.
     if (!block_clause_deletion_) {
       clauses_propagator_->DeleteRemovedClauses();
+      clauses_propagator_->CompactClauseArenaIfNeeded();
     }
   }
 
@@ -408,6 +408,11 @@ class SatSolver {
     int64_t num_minimizations = 0;
     int64_t num_literals_removed = 0;
 
+    // Number of reason literals looked at by MinimizeConflictRecursively().
+    // This measures the cost of the minimization, to compare with the number
+    // of literals it removed.
+    int64_t num_minimization_inspected_literals = 0;
+
     // PB constraints.
     int64_t num_learned_pb_literals = 0;
 
@@ -465,6 +470,20 @@ class SatSolver {
   // not needed.
   bool AddClauseDuringSearch(absl::Span<const Literal> literals);
 
+  // Adds a clause learned by another solver. This must be called at level
+  // zero. The clause is first simplified with the fixed literals, and if it is
+  // still of size 3 or more, it is added as a removable clause with the given
+  // lbd, like the clauses learned by this solver. Returns false if the model
+  // becomes UNSAT.
+  bool AddImportedLearnedClause(absl::Span<const Literal> literals, int lbd);
+
+  // If set, this is called on each new learned clause of size at least 3 with
+  // its LBD. This is used to share the good clauses with other solvers.
+  void SetLearnedClauseCallback(
+      std::function<void(int lbd, absl::Span<const Literal>)> callback) {
+    learned_clause_callback_ = std::move(callback);
+  }
+
   // Performs propagation of the recently enqueued elements.
   // Mainly visible for testing.
   ABSL_MUST_USE_RESULT bool Propagate();
@@ -476,7 +495,8 @@ class SatSolver {
   void AdvanceDeterministicTime(TimeLimit* limit) {
     const double current = deterministic_time();
     limit->AdvanceDeterministicTime(
-        current - deterministic_time_at_last_advanced_time_limit_);
+        current - deterministic_time_at_last_advanced_time_limit_,
+        "sat_solver");
     deterministic_time_at_last_advanced_time_limit_ = current;
   }
 
@@ -676,6 +696,13 @@ class SatSolver {
   // Utility function used by MinimizeConflictRecursively().
   bool CanBeInferedFromConflictVariables(BooleanVariable variable);
 
+  // MiniSat "abstract level" of a decision level. The union of these bits over
+  // the conflict variables quickly tells us that a level does not appear in
+  // the conflict, in which case a variable of that level is not redundant.
+  static uint64_t LevelAbstraction(int level) {
+    return uint64_t{1} << (level & 63);
+  }
+
   // To be used in DCHECK(). Verifies some property of the conflict clause:
   // - There is an unique literal with the highest decision level.
   // - This literal appears in the first position.
@@ -814,6 +841,7 @@ class SatSolver {
   SparseBitset<BooleanVariable> is_independent_;
   SparseBitset<BooleanVariable> tmp_mark_;
   std::vector<int> min_trail_index_per_level_;
+  uint64_t conflict_level_abstraction_ = 0;
 
   // Temporary members used by CanBeInferedFromConflictVariables().
   std::vector<BooleanVariable> dfs_stack_;
@@ -822,6 +850,9 @@ class SatSolver {
   // Temporary member used when adding clauses.
   std::vector<Literal> literals_scratchpad_;
 
+  std::function<void(int lbd, absl::Span<const Literal>)>
+      learned_clause_callback_ = nullptr;
+
   // A boolean vector used to temporarily mark decision levels.
   DEFINE_STRONG_INDEX_TYPE(SatDecisionLevel);
   SparseBitset<SatDecisionLevel> is_level_marked_;
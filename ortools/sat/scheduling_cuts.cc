@@ -41,6 +41,7 @@
 #include "ortools/sat/linear_constraint.h"
 #include "ortools/sat/linear_constraint_manager.h"
 #include "ortools/sat/model.h"
+#include "ortools/sat/precedences.h"
 #include "ortools/sat/sat_base.h"
 #include "ortools/sat/util.h"
 #include "ortools/util/sorted_interval_list.h"
@@ -855,6 +856,11 @@ void GenerateCutsBetweenPairOfNonOverlappingTasks(
   const int num_events = events.size();
   if (num_events <= 1) return;
 
+  // The level zero precedences (with their transitive closure) can rule out
+  // one of the two orders even when the bounds do not.
+  const PrecedenceRelations* precedences =
+      model->GetOrCreate<PrecedenceRelations>();
+
   std::sort(events.begin(), events.end(),
             [](const CachedIntervalData& e1, const CachedIntervalData& e2) {
               return e1.start_min < e2.start_min ||
@@ -905,8 +911,15 @@ void GenerateCutsBetweenPairOfNonOverlappingTasks(
       // Encode only the interesting pairs.
       if (e1.demand_min + e2.demand_min <= capacity_max) continue;
 
-      const bool interval_1_can_precede_2 = e1.end_min <= e2.start_max;
-      const bool interval_2_can_precede_1 = e2.end_min <= e1.start_max;
+      bool interval_1_can_precede_2 = e1.end_min <= e2.start_max;
+      bool interval_2_can_precede_1 = e2.end_min <= e1.start_max;
+      if (interval_1_can_precede_2 && interval_2_can_precede_1) {
+        // If start_1 < end_2, then 2 cannot be before 1, and vice versa.
+        interval_2_can_precede_1 =
+            precedences->GetLevelZeroMinDistance(e1.start, e2.end) <= 0;
+        interval_1_can_precede_2 =
+            precedences->GetLevelZeroMinDistance(e2.start, e1.end) <= 0;
+      }
 
       if (interval_1_can_precede_2 && !interval_2_can_precede_1 &&
           e1.end.LpValue(lp_values) >=
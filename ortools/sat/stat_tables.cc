@@ -48,9 +48,9 @@ SharedStatTables::SharedStatTables() {
                            "Restarts", "BoolPropag", "IntegerPropag"});
 
   clauses_table_.push_back({"SAT stats", "ClassicMinim", "LitRemoved",
-                            "LitLearned", "LitForgotten", "Subsumed",
-                            "MClauses", "MDecisions", "MLitTrue", "MSubsumed",
-                            "MLitRemoved", "MReused"});
+                            "LitInspected", "LitLearned", "LitForgotten",
+                            "Subsumed", "MClauses", "MDecisions", "MLitTrue",
+                            "MSubsumed", "MLitRemoved", "MReused"});
 
   lp_table_.push_back({"Lp stats", "Component", "Iterations", "AddedCuts",
                        "OPTIMAL", "DUAL_F.", "DUAL_U."});
@@ -96,6 +96,7 @@ void SharedStatTables::AddClausesStat(absl::string_view name, Model* model) {
   clauses_table_.push_back(
       {FormatName(name), FormatCounter(counters.num_minimizations),
        FormatCounter(counters.num_literals_removed),
+       FormatCounter(counters.num_minimization_inspected_literals),
        FormatCounter(counters.num_literals_learned),
        FormatCounter(counters.num_literals_forgotten),
        FormatCounter(counters.num_subsumed_clauses),
@@ -227,8 +228,18 @@ void SharedStatTables::AddLpStat(absl::string_view name, Model* model) {
 }
 
 void SharedStatTables::AddLnsStat(absl::string_view name,
-                                  const NeighborhoodGenerator& generator) {
+                                  const NeighborhoodGenerator& generator,
+                                  double deterministic_time) {
   absl::MutexLock mutex_lock(&mutex_);
+  LnsGeneratorStatistics& stats = lns_statistics_.emplace_back();
+  stats.set_name(std::string(name));
+  stats.set_num_calls(generator.num_calls());
+  stats.set_num_improving_calls(generator.num_improving_calls());
+  stats.set_num_fully_solved_calls(generator.num_fully_solved_calls());
+  stats.set_difficulty(generator.difficulty());
+  stats.set_deterministic_limit(generator.deterministic_limit());
+  stats.set_deterministic_time(deterministic_time);
+
   const double fully_solved_proportion =
       static_cast<double>(generator.num_fully_solved_calls()) /
       static_cast<double>(std::max(int64_t{1}, generator.num_calls()));
@@ -254,6 +265,11 @@ void SharedStatTables::AddLsStat(absl::string_view name, int64_t num_batches,
        FormatCounter(num_weight_updates)});
 }
 
+std::vector<LnsGeneratorStatistics> SharedStatTables::LnsStatistics() const {
+  absl::MutexLock mutex_lock(&mutex_);
+  return lns_statistics_;
+}
+
 void SharedStatTables::Display(SolverLogger* logger) {
   if (!logger->LoggingIsEnabled()) return;
 
@@ -20,6 +20,7 @@
 
 #include "absl/strings/string_view.h"
 #include "absl/synchronization/mutex.h"
+#include "ortools/sat/cp_model.pb.h"
 #include "ortools/sat/cp_model_lns.h"
 #include "ortools/sat/model.h"
 #include "ortools/sat/subsolver.h"
@@ -42,8 +43,11 @@ class SharedStatTables {
 
   void AddLpStat(absl::string_view name, Model* model);
 
+  // This also records the statistics in a structured form, see
+  // LnsStatistics().
   void AddLnsStat(absl::string_view name,
-                  const NeighborhoodGenerator& generator);
+                  const NeighborhoodGenerator& generator,
+                  double deterministic_time);
 
   void AddLsStat(absl::string_view name, int64_t num_batches,
                  int64_t num_restarts, int64_t num_linear_moves,
@@ -53,6 +57,9 @@ class SharedStatTables {
   // Display the set of table at the end.
   void Display(SolverLogger* logger);
 
+  // The statistics of all the LNS generators added so far.
+  std::vector<LnsGeneratorStatistics> LnsStatistics() const;
+
  private:
   mutable absl::Mutex mutex_;
 
@@ -67,6 +74,7 @@ class SharedStatTables {
       ABSL_GUARDED_BY(mutex_);
 
   std::vector<std::vector<std::string>> lns_table_ ABSL_GUARDED_BY(mutex_);
+  std::vector<LnsGeneratorStatistics> lns_statistics_ ABSL_GUARDED_BY(mutex_);
   std::vector<std::vector<std::string>> ls_table_ ABSL_GUARDED_BY(mutex_);
 
   // This one is dynamic, so we generate it in Display().
@@ -13,6 +13,8 @@
 
 #include "ortools/sat/subsolver.h"
 
+#include <algorithm>
+#include <atomic>
 #include <cstdint>
 #include <functional>
 #include <memory>
@@ -46,14 +48,39 @@ namespace {
 int NextSubsolverToSchedule(std::vector<std::unique_ptr<SubSolver>>& subsolvers,
                             const std::vector<int64_t>& num_generated_tasks) {
   int best = -1;
+  std::vector<int> available_arms;
+  int64_t num_arm_tasks = 0;
   for (int i = 0; i < subsolvers.size(); ++i) {
     if (subsolvers[i] == nullptr) continue;
     if (subsolvers[i]->TaskIsAvailable()) {
+      if (subsolvers[i]->IsBanditArm()) {
+        available_arms.push_back(i);
+        num_arm_tasks += num_generated_tasks[i];
+        continue;
+      }
       if (best == -1 || num_generated_tasks[i] < num_generated_tasks[best]) {
         best = i;
       }
     }
   }
+
+  // The bandit arms are scheduled as a group, as if each of them had the
+  // average number of tasks of the group.
+  const int num_arms = available_arms.size();
+  if (num_arms > 0 &&
+      (best == -1 || num_arm_tasks < num_generated_tasks[best] * num_arms)) {
+    double best_score = 0.0;
+    best = -1;
+    for (const int i : available_arms) {
+      const double score = subsolvers[i]->BanditScore(num_arm_tasks);
+      if (best == -1 || score > best_score ||
+          (score == best_score &&
+           num_generated_tasks[i] < num_generated_tasks[best])) {
+        best = i;
+        best_score = score;
+      }
+    }
+  }
   if (best != -1) VLOG(1) << "Scheduling " << subsolvers[best]->name();
   return best;
 }
@@ -105,19 +132,21 @@ void SequentialLoop(std::vector<std::unique_ptr<SubSolver>>& subsolvers) {
 // On portable platform, we don't support multi-threading for now.
 
 void NonDeterministicLoop(std::vector<std::unique_ptr<SubSolver>>& subsolvers,
-                          int num_threads) {
+                          int num_threads, ThreadPool* thread_pool) {
   SequentialLoop(subsolvers);
 }
 
 void DeterministicLoop(std::vector<std::unique_ptr<SubSolver>>& subsolvers,
-                       int num_threads, int batch_size) {
+                       int num_threads, int batch_size,
+                       ThreadPool* thread_pool) {
   SequentialLoop(subsolvers);
 }
 
 #else  // __PORTABLE_PLATFORM__
 
 void DeterministicLoop(std::vector<std::unique_ptr<SubSolver>>& subsolvers,
-                       int num_threads, int batch_size) {
+                       int num_threads, int batch_size,
+                       ThreadPool* thread_pool) {
   CHECK_GT(num_threads, 0);
   CHECK_GT(batch_size, 0);
   if (batch_size == 1) {
@@ -129,10 +158,20 @@ void DeterministicLoop(std::vector<std::unique_ptr<SubSolver>>& subsolvers,
   std::vector<int> num_in_flight_per_subsolvers(subsolvers.size(), 0);
   std::vector<std::function<void()>> to_run;
   std::vector<int> indices;
+  std::vector<int> order;
   std::vector<double> timing;
   to_run.reserve(batch_size);
-  ThreadPool pool("DeterministicLoop", num_threads);
-  pool.StartWorkers();
+
+  // The main thread also executes tasks while a batch is running, so we only
+  // need num_threads - 1 workers in the pool.
+  std::unique_ptr<ThreadPool> owned_pool;
+  ThreadPool* pool = thread_pool;
+  if (num_threads > 1 && pool == nullptr) {
+    owned_pool =
+        std::make_unique<ThreadPool>("DeterministicLoop", num_threads - 1);
+    owned_pool->StartWorkers();
+    pool = owned_pool.get();
+  }
   while (true) {
     SynchronizeAll(subsolvers);
     ClearSubsolversThatAreDone(num_in_flight_per_subsolvers, subsolvers);
@@ -152,19 +191,42 @@ void DeterministicLoop(std::vector<std::unique_ptr<SubSolver>>& subsolvers,
     }
     if (to_run.empty()) break;
 
-    // Schedule each task.
+    // The results of a batch do not depend on the order in which its tasks are
+    // executed. We start the tasks we expect to be the longest first so that
+    // the batch is not delayed by a long task started last while the other
+    // threads are idle.
+    order.resize(to_run.size());
+    for (int i = 0; i < to_run.size(); ++i) order[i] = i;
+    std::stable_sort(order.begin(), order.end(), [&](int a, int b) {
+      return subsolvers[indices[a]]->AverageTaskDuration() >
+             subsolvers[indices[b]]->AverageTaskDuration();
+    });
+
+    // Each runner picks the next task to execute in that order. The pool
+    // workers and the main thread all run the same loop.
     timing.resize(to_run.size());
-    absl::BlockingCounter blocking_counter(static_cast<int>(to_run.size()));
-    for (int i = 0; i < to_run.size(); ++i) {
-      pool.Schedule(
-          [i, f = std::move(to_run[i]), &timing, &blocking_counter]() {
-            WallTimer timer;
-            timer.Start();
-            f();
-            timing[i] = timer.Get();
-            blocking_counter.DecrementCount();
-          });
+    std::atomic<int> next_task = 0;
+    const auto run_tasks = [&to_run, &order, &timing, &next_task]() {
+      for (;;) {
+        const int k = next_task.fetch_add(1, std::memory_order_relaxed);
+        if (k >= order.size()) return;
+        const int i = order[k];
+        WallTimer timer;
+        timer.Start();
+        to_run[i]();
+        timing[i] = timer.Get();
+      }
+    };
+    const int num_helpers =
+        std::min(num_threads, static_cast<int>(to_run.size())) - 1;
+    absl::BlockingCounter blocking_counter(num_helpers);
+    for (int i = 0; i < num_helpers; ++i) {
+      pool->Schedule([&run_tasks, &blocking_counter]() {
+        run_tasks();
+        blocking_counter.DecrementCount();
+      });
     }
+    run_tasks();
 
     // Wait for all tasks of this batch to be done before scheduling another
     // batch.
@@ -179,15 +241,17 @@ void DeterministicLoop(std::vector<std::unique_ptr<SubSolver>>& subsolvers,
 }
 
 void NonDeterministicLoop(std::vector<std::unique_ptr<SubSolver>>& subsolvers,
-                          const int num_threads) {
+                          const int num_threads, ThreadPool* thread_pool) {
   CHECK_GT(num_threads, 0);
   if (num_threads == 1) {
     return SequentialLoop(subsolvers);
   }
 
   // The mutex guards num_in_flight and num_in_flight_per_subsolvers.
-  // This is used to detect when the search is done.
-  absl::Mutex mutex;
+  // This is used to detect when the search is done. It is shared with the
+  // tasks because, with a `thread_pool` that outlives this loop, the last task
+  // may still be releasing it when the loop returns.
+  const auto mutex = std::make_shared<absl::Mutex>();
   int num_in_flight = 0;  // Guarded by `mutex`.
   std::vector<int> num_in_flight_per_subsolvers(subsolvers.size(), 0);
 
@@ -197,8 +261,14 @@ void NonDeterministicLoop(std::vector<std::unique_ptr<SubSolver>>& subsolvers,
     return num_in_flight < num_threads;
   };
 
-  ThreadPool pool("NonDeterministicLoop", num_threads);
-  pool.StartWorkers();
+  std::unique_ptr<ThreadPool> owned_pool;
+  ThreadPool* pool = thread_pool;
+  if (pool == nullptr) {
+    owned_pool =
+        std::make_unique<ThreadPool>("NonDeterministicLoop", num_threads);
+    owned_pool->StartWorkers();
+    pool = owned_pool.get();
+  }
 
   // The lambda below are using little space, but there is no reason
   // to create millions of them, so we use the blocking nature of
@@ -210,7 +280,7 @@ void NonDeterministicLoop(std::vector<std::unique_ptr<SubSolver>>& subsolvers,
     bool all_done = false;
     {
       // Wait if num_in_flight == num_threads.
-      const bool condition = mutex.LockWhenWithTimeout(
+      const bool condition = mutex->LockWhenWithTimeout(
           absl::Condition(&num_in_flight_lt_num_threads),
           absl::Milliseconds(100));
 
@@ -220,7 +290,7 @@ void NonDeterministicLoop(std::vector<std::unique_ptr<SubSolver>>& subsolvers,
       // TODO(user): We could also directly register callback to set stopping
       // Boolean to false in a few places.
       if (!condition) {
-        mutex.Unlock();
+        mutex->Unlock();
         SynchronizeAll(subsolvers);
         continue;
       }
@@ -228,14 +298,14 @@ void NonDeterministicLoop(std::vector<std::unique_ptr<SubSolver>>& subsolvers,
       // The stopping condition is that we do not have anything else to generate
       // once all the task are done and synchronized.
       if (num_in_flight == 0) all_done = true;
-      mutex.Unlock();
+      mutex->Unlock();
     }
 
     SynchronizeAll(subsolvers);
     {
       // We need to do that while holding the lock since substask below might
       // be currently updating the time via AddTaskDuration().
-      const absl::MutexLock mutex_lock(&mutex);
+      const absl::MutexLock mutex_lock(mutex.get());
       ClearSubsolversThatAreDone(num_in_flight_per_subsolvers, subsolvers);
     }
     const int best = NextSubsolverToSchedule(subsolvers, num_generated_tasks);
@@ -253,19 +323,22 @@ void NonDeterministicLoop(std::vector<std::unique_ptr<SubSolver>>& subsolvers,
     // Schedule next task.
     num_generated_tasks[best]++;
     {
-      absl::MutexLock mutex_lock(&mutex);
+      absl::MutexLock mutex_lock(mutex.get());
       num_in_flight++;
       num_in_flight_per_subsolvers[best]++;
     }
     std::function<void()> task = subsolvers[best]->GenerateTask(task_id++);
     const std::string name = subsolvers[best]->name();
-    pool.Schedule([task = std::move(task), name, best, &subsolvers, &mutex,
-                   &num_in_flight, &num_in_flight_per_subsolvers]() {
+    pool->Schedule([task = std::move(task), name, best, &subsolvers, mutex,
+                    &num_in_flight, &num_in_flight_per_subsolvers]() mutable {
       WallTimer timer;
       timer.Start();
       task();
+      // The task may reference the subsolvers, which can be deleted as soon
+      // as num_in_flight reaches zero.
+      task = nullptr;
 
-      const absl::MutexLock mutex_lock(&mutex);
+      const absl::MutexLock mutex_lock(mutex.get());
       DCHECK(subsolvers[best] != nullptr);
       DCHECK_GT(num_in_flight_per_subsolvers[best], 0);
       num_in_flight_per_subsolvers[best]--;
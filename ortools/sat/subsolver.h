@@ -21,6 +21,7 @@
 #include <cmath>
 #include <cstdint>
 #include <functional>
+#include <limits>
 #include <memory>
 #include <string>
 #include <utility>
@@ -35,6 +36,9 @@
 #endif  // __PORTABLE_PLATFORM__
 
 namespace operations_research {
+
+class ThreadPool;
+
 namespace sat {
 
 // The API used for distributing work. Each subsolver can generate tasks and
@@ -88,6 +92,18 @@ class SubSolver {
   // This is only called by the main thread.
   virtual std::function<void()> GenerateTask(int64_t task_id) = 0;
 
+  // Subsolvers that return true here are scheduled as the arms of a
+  // multi-armed bandit by the *Loop() functions below. As a group, they get
+  // the same share of tasks as if they were scheduled individually, but among
+  // them we always pick the available one with the highest BanditScore().
+  //
+  // This is only called by the main thread.
+  virtual bool IsBanditArm() const { return false; }
+
+  // Only called if IsBanditArm() is true. The total_num_tasks is the number of
+  // tasks generated so far by all the currently available arms.
+  virtual double BanditScore(int64_t /*total_num_tasks*/) const { return 0.0; }
+
   // Returns the total deterministic time spend by the completed tasks before
   // the last Synchronize() call.
   double deterministic_time() const { return deterministic_time_; }
@@ -112,6 +128,13 @@ class SubSolver {
     dtiming_.AddTimeInSec(deterministic_duration);
   }
 
+  // Returns the average wall time of the tasks of this subsolver, or infinity
+  // if no task completed yet. This is only used as a scheduling hint.
+  double AverageTaskDuration() const {
+    if (timing_.Num() == 0) return std::numeric_limits<double>::infinity();
+    return timing_.Average();
+  }
+
   std::string TimingInfo() const {
     // TODO(user): remove trailing "\n" from ValueAsString() or just build the
     // table line directly.
@@ -162,8 +185,13 @@ class SynchronizationPoint : public SubSolver {
 // Note that it is okay to incorporate "special" subsolver that never produce
 // any tasks. This can be used to synchronize classes used by many subsolvers
 // just once for instance.
+//
+// The tasks run on `thread_pool` if it is not nullptr, e.g. a pool shared by
+// concurrent solves, or else on a pool of `num_threads` threads created for
+// the loop. In both cases at most `num_threads` tasks run at the same time.
+// The calling thread must not be a worker of `thread_pool`.
 void NonDeterministicLoop(std::vector<std::unique_ptr<SubSolver>>& subsolvers,
-                          int num_threads);
+                          int num_threads, ThreadPool* thread_pool = nullptr);
 
 // Similar to NonDeterministicLoop() except this should result in a
 // deterministic solver provided that all SubSolver respect the Synchronize()
@@ -175,8 +203,12 @@ void NonDeterministicLoop(std::vector<std::unique_ptr<SubSolver>>& subsolvers,
 //    which one to run.
 // 3/ wait for all task to finish.
 // 4/ repeat until no task can be generated in step 2.
+//
+// `thread_pool` is used as in NonDeterministicLoop(), the calling thread also
+// running tasks.
 void DeterministicLoop(std::vector<std::unique_ptr<SubSolver>>& subsolvers,
-                       int num_threads, int batch_size);
+                       int num_threads, int batch_size,
+                       ThreadPool* thread_pool = nullptr);
 
 // Same as above, but specialized implementation for the case num_threads=1.
 // This avoids using a Threadpool altogether. It should have the same behavior
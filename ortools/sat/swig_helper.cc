@@ -37,6 +37,9 @@ SolutionCallback::~SolutionCallback() = default;
 
 void SolutionCallback::Run(
     const operations_research::sat::CpSolverResponse& response) const {
+  // The solutions are reported one at a time, under the lock of the shared
+  // response manager, so there is no need to synchronize the counter.
+  if (++num_solutions_ % period_ != 0) return;
   response_ = response;
   has_response_ = true;
   OnSolutionCallback();
@@ -94,6 +97,11 @@ void SolutionCallback::StopSearch() {
   }
 }
 
+void SolutionCallback::SetCallbackPeriod(int period) {
+  CHECK_GE(period, 1);
+  period_ = period;
+}
+
 operations_research::sat::CpSolverResponse SolutionCallback::Response() const {
   return response_;
 }
@@ -69,6 +69,11 @@ class SolutionCallback {
   // Stops the search.
   void StopSearch();
 
+  // Only calls OnSolutionCallback() on every period-th solution. The solver
+  // workers wait while the callback runs, so this reduces the overhead of
+  // slow callbacks, e.g. in Python. The default period is 1.
+  void SetCallbackPeriod(int period);
+
   operations_research::sat::CpSolverResponse Response() const;
 
   // We use mutable and non const methods to overcome SWIG difficulties.
@@ -80,6 +85,8 @@ class SolutionCallback {
   mutable CpSolverResponse response_;
   mutable bool has_response_ = false;
   mutable std::atomic<bool>* stopped_ptr_;
+  int period_ = 1;
+  mutable int64_t num_solutions_ = 0;
 };
 
 // Simple director class for C#.
@@ -21,6 +21,7 @@
 #include <deque>
 #include <functional>
 #include <limits>
+#include <memory>
 #include <string>
 #include <utility>
 #include <vector>
@@ -32,11 +33,14 @@
 #include "ortools/base/options.h"
 #endif  // __PORTABLE_PLATFORM__
 #include "absl/algorithm/container.h"
+#include "absl/cleanup/cleanup.h"
 #include "absl/container/btree_map.h"
 #include "absl/container/flat_hash_map.h"
 #include "absl/container/flat_hash_set.h"
 #include "absl/flags/flag.h"
+#include "absl/functional/function_ref.h"
 #include "absl/log/check.h"
+#include "absl/strings/match.h"
 #include "absl/strings/str_cat.h"
 #include "absl/strings/str_format.h"
 #include "absl/strings/string_view.h"
@@ -71,26 +75,36 @@ void SharedLPSolutionRepository::NewLPSolution(
   if (lp_solution.empty()) return;
 
   // Add this solution to the pool.
-  SharedSolutionRepository<double>::Solution solution;
-  solution.variable_values = std::move(lp_solution);
+  auto solution = std::make_shared<SharedSolutionRepository<double>::Solution>();
+  solution->variable_values = std::move(lp_solution);
+
+  std::shared_ptr<const Solution> latest = solution;
+  {
+    // We always prefer to keep the solution from the last synchronize batch.
+    absl::MutexLock mutex_lock(&mutex_);
+    solution->rank = -num_synchronization_;
+    AddInternal(std::move(solution));
+  }
 
-  // We always prefer to keep the solution from the last synchronize batch.
-  absl::MutexLock mutex_lock(&mutex_);
-  solution.rank = -num_synchronization_;
-  AddInternal(solution);
+  absl::MutexLock mutex_lock(&latest_mutex_);
+  latest_solution_ = std::move(latest);
+  latest_sequence_number_.fetch_add(1, std::memory_order_release);
+}
+
+std::shared_ptr<const SharedLPSolutionRepository::Solution>
+SharedLPSolutionRepository::GetLatestLPSolution() const {
+  if (LatestLPSolutionSequenceNumber() == 0) return nullptr;
+  absl::MutexLock mutex_lock(&latest_mutex_);
+  return latest_solution_;
 }
 
 void SharedIncompleteSolutionManager::AddSolution(
-    const std::vector<double>& lp_solution) {
+    std::vector<double> lp_solution) {
   absl::MutexLock mutex_lock(&mutex_);
   ++num_added_;
-  solutions_.push_back(lp_solution);
+  solutions_.push_back(std::move(lp_solution));
   if (solutions_.size() > 100) solutions_.pop_front();
-}
-
-bool SharedIncompleteSolutionManager::HasSolution() const {
-  absl::MutexLock mutex_lock(&mutex_);
-  return !solutions_.empty();
+  num_available_.store(solutions_.size(), std::memory_order_release);
 }
 
 std::vector<double> SharedIncompleteSolutionManager::PopLast() {
@@ -100,9 +114,50 @@ std::vector<double> SharedIncompleteSolutionManager::PopLast() {
   ++num_queried_;
   std::vector<double> solution = std::move(solutions_.back());
   solutions_.pop_back();
+  num_available_.store(solutions_.size(), std::memory_order_release);
   return solution;
 }
 
+void SharedCutPool::AddCut(Cut cut) {
+  uint64_t fp = kDefaultFingerprintSeed;
+  fp = fasthash64(cut.vars.data(), cut.vars.size() * sizeof(int), fp);
+  fp = fasthash64(cut.coeffs.data(), cut.coeffs.size() * sizeof(int64_t), fp);
+  fp = FingerprintSingleField(cut.lb, fp);
+  fp = FingerprintSingleField(cut.ub, fp);
+
+  absl::MutexLock mutex_lock(&mutex_);
+  if (cuts_.size() >= max_num_cuts_ || !fingerprints_.insert(fp).second) {
+    ++num_ignored_;
+    return;
+  }
+  cuts_.push_back(std::make_shared<const Cut>(std::move(cut)));
+}
+
+std::vector<std::shared_ptr<const SharedCutPool::Cut>>
+SharedCutPool::GetNewCuts(int* num_imported) const {
+  absl::MutexLock mutex_lock(&mutex_);
+  std::vector<std::shared_ptr<const Cut>> result(
+      cuts_.begin() + std::min<int>(*num_imported, cuts_.size()), cuts_.end());
+  *num_imported = cuts_.size();
+  num_queried_ += result.size();
+  return result;
+}
+
+void SharedPseudoCosts::ExchangeRecords(
+    absl::Span<const std::pair<int, Records>> new_records,
+    std::vector<Records>* all_records) {
+  absl::MutexLock mutex_lock(&mutex_);
+  for (const auto& [index, records] : new_records) {
+    DCHECK_GE(index, 0);
+    DCHECK_LT(index, records_.size());
+    records_[index].sum += records.sum;
+    records_[index].count += records.count;
+    num_added_ += records.count;
+  }
+  ++num_exchanges_;
+  *all_records = records_;
+}
+
 SharedResponseManager::SharedResponseManager(Model* model)
     : parameters_(*model->GetOrCreate<SatParameters>()),
       wall_timer_(*model->GetOrCreate<WallTimer>()),
@@ -551,17 +606,19 @@ CpSolverResponse SharedResponseManager::GetResponseInternal(
 
 CpSolverResponse SharedResponseManager::GetResponse() {
   absl::MutexLock mutex_lock(&mutex_);
-  CpSolverResponse result =
-      solutions_.NumSolutions() == 0
-          ? GetResponseInternal({}, "")
-          : GetResponseInternal(solutions_.GetSolution(0).variable_values,
-                                solutions_.GetSolution(0).info);
+  CpSolverResponse result;
+  if (solutions_.NumSolutions() == 0) {
+    result = GetResponseInternal({}, "");
+  } else {
+    const auto best = solutions_.GetSolution(0);
+    result = GetResponseInternal(best->variable_values, best->info);
+  }
 
   // If this is true, we postsolve and copy all of our solutions.
   if (parameters_.fill_additional_solutions_in_response()) {
     std::vector<int64_t> temp;
     for (int i = 0; i < solutions_.NumSolutions(); ++i) {
-      temp = solutions_.GetSolution(i).variable_values;
+      temp = solutions_.GetSolution(i)->variable_values;
       for (int i = solution_postprocessors_.size(); --i >= 0;) {
         solution_postprocessors_[i](&temp);
       }
@@ -630,7 +687,7 @@ void SharedResponseManager::NewSolution(
                                     solution_values.end());
     solution.info = solution_info;
 
-    solutions_.Add(solution);
+    solutions_.Add(std::move(solution));
   }
 
   if (objective_or_null_ != nullptr) {
@@ -644,7 +701,7 @@ void SharedResponseManager::NewSolution(
                                       solution_values.end());
       solution.rank = objective_value;
       solution.info = solution_info;
-      solutions_.Add(solution);
+      solutions_.Add(std::move(solution));
     }
 
     // Ignore any non-strictly improving solution.
@@ -826,21 +883,24 @@ void SharedResponseManager::DisplayImprovementStatistics() {
 }
 
 SharedBoundsManager::SharedBoundsManager(const CpModelProto& model_proto)
-    : num_variables_(model_proto.variables_size()),
-      model_proto_(model_proto),
-      lower_bounds_(num_variables_, std::numeric_limits<int64_t>::min()),
-      upper_bounds_(num_variables_, std::numeric_limits<int64_t>::max()),
-      synchronized_lower_bounds_(num_variables_,
-                                 std::numeric_limits<int64_t>::min()),
-      synchronized_upper_bounds_(num_variables_,
-                                 std::numeric_limits<int64_t>::max()) {
-  changed_variables_since_last_synchronize_.ClearAndResize(num_variables_);
-  for (int i = 0; i < num_variables_; ++i) {
-    lower_bounds_[i] = model_proto.variables(i).domain(0);
-    const int domain_size = model_proto.variables(i).domain_size();
-    upper_bounds_[i] = model_proto.variables(i).domain(domain_size - 1);
-    synchronized_lower_bounds_[i] = lower_bounds_[i];
-    synchronized_upper_bounds_[i] = upper_bounds_[i];
+    : num_variables_(model_proto.variables_size()), model_proto_(model_proto) {
+  const int num_shards = (num_variables_ + kShardSize - 1) / kShardSize;
+  shards_.reserve(num_shards);
+  for (int s = 0; s < num_shards; ++s) {
+    const int begin = s * kShardSize;
+    const int end = std::min(num_variables_, begin + kShardSize);
+    auto shard = std::make_unique<Shard>();
+    absl::MutexLock mutex_lock(&shard->mutex);
+    shard->changed_variables_since_last_synchronize.ClearAndResize(end - begin);
+    for (int var = begin; var < end; ++var) {
+      const IntegerVariableProto& var_proto = model_proto.variables(var);
+      shard->lower_bounds.push_back(var_proto.domain(0));
+      shard->upper_bounds.push_back(
+          var_proto.domain(var_proto.domain_size() - 1));
+    }
+    shard->synchronized_lower_bounds = shard->lower_bounds;
+    shard->synchronized_upper_bounds = shard->upper_bounds;
+    shards_.push_back(std::move(shard));
   }
 }
 
@@ -852,55 +912,79 @@ void SharedBoundsManager::ReportPotentialNewBounds(
   CHECK_EQ(variables.size(), new_upper_bounds.size());
   int num_improvements = 0;
 
-  absl::MutexLock mutex_lock(&mutex_);
-  for (int i = 0; i < variables.size(); ++i) {
-    const int var = variables[i];
-    if (var >= num_variables_) continue;
-    const int64_t old_lb = lower_bounds_[var];
-    const int64_t old_ub = upper_bounds_[var];
-    const int64_t new_lb = new_lower_bounds[i];
-    const int64_t new_ub = new_upper_bounds[i];
-    const bool changed_lb = new_lb > old_lb;
-    const bool changed_ub = new_ub < old_ub;
-    if (!changed_lb && !changed_ub) continue;
-
-    VLOG(3) << worker_name << " var=" << var << " [" << old_lb << "," << old_ub
-            << "] -> [" << new_lb << "," << new_ub << "]";
-
-    if (changed_lb) {
-      if (DEBUG_MODE && !debug_solution_.empty()) {
-        CHECK_LE(new_lb, debug_solution_[var]) << worker_name << " var=" << var;
-      }
-      lower_bounds_[var] = new_lb;
+  // We process the variables shard by shard, in the given order, and only
+  // lock one shard at the time.
+  int i = 0;
+  while (i < variables.size()) {
+    if (variables[i] >= num_variables_) {
+      ++i;
+      continue;
     }
-    if (changed_ub) {
-      if (DEBUG_MODE && !debug_solution_.empty()) {
-        CHECK_GE(new_ub, debug_solution_[var]) << worker_name << " var=" << var;
+    const int shard_index = variables[i] / kShardSize;
+    const int offset = shard_index * kShardSize;
+    Shard& shard = *shards_[shard_index];
+    absl::MutexLock mutex_lock(&shard.mutex);
+    for (; i < variables.size(); ++i) {
+      const int var = variables[i];
+      if (var >= num_variables_) continue;
+      if (var / kShardSize != shard_index) break;
+      const int local_var = var - offset;
+      const int64_t old_lb = shard.lower_bounds[local_var];
+      const int64_t old_ub = shard.upper_bounds[local_var];
+      const int64_t new_lb = new_lower_bounds[i];
+      const int64_t new_ub = new_upper_bounds[i];
+      const bool changed_lb = new_lb > old_lb;
+      const bool changed_ub = new_ub < old_ub;
+      if (!changed_lb && !changed_ub) continue;
+
+      VLOG(3) << worker_name << " var=" << var << " [" << old_lb << ","
+              << old_ub << "] -> [" << new_lb << "," << new_ub << "]";
+
+      if (changed_lb) {
+        if (DEBUG_MODE && !debug_solution_.empty()) {
+          CHECK_LE(new_lb, debug_solution_[var])
+              << worker_name << " var=" << var;
+        }
+        shard.lower_bounds[local_var] = new_lb;
+      }
+      if (changed_ub) {
+        if (DEBUG_MODE && !debug_solution_.empty()) {
+          CHECK_GE(new_ub, debug_solution_[var])
+              << worker_name << " var=" << var;
+        }
+        shard.upper_bounds[local_var] = new_ub;
       }
-      upper_bounds_[var] = new_ub;
+      shard.changed_variables_since_last_synchronize.Set(local_var);
+      num_improvements++;
     }
-    changed_variables_since_last_synchronize_.Set(var);
-    num_improvements++;
-  }
-  if (num_improvements > 0) {
-    total_num_improvements_ += num_improvements;
-    VLOG(3) << total_num_improvements_ << "/" << num_variables_;
-    bounds_exported_[worker_name] += num_improvements;
-    if (absl::GetFlag(FLAGS_cp_model_dump_tightened_models)) {
-      CpModelProto tight_model = model_proto_;
-      for (int i = 0; i < num_variables_; ++i) {
-        IntegerVariableProto* var_proto = tight_model.mutable_variables(i);
+  }
+  if (num_improvements == 0) return;
+
+  absl::MutexLock mutex_lock(&stats_mutex_);
+  total_num_improvements_ += num_improvements;
+  VLOG(3) << total_num_improvements_ << "/" << num_variables_;
+  bounds_exported_[worker_name] += num_improvements;
+  if (absl::GetFlag(FLAGS_cp_model_dump_tightened_models)) {
+    CpModelProto tight_model = model_proto_;
+    for (int s = 0; s < NumShards(); ++s) {
+      Shard& shard = *shards_[s];
+      absl::MutexLock shard_lock(&shard.mutex);
+      for (int local_var = 0; local_var < shard.lower_bounds.size();
+           ++local_var) {
+        IntegerVariableProto* var_proto =
+            tight_model.mutable_variables(s * kShardSize + local_var);
         const Domain domain =
             ReadDomainFromProto(*var_proto)
-                .IntersectionWith(Domain(lower_bounds_[i], upper_bounds_[i]));
+                .IntersectionWith(Domain(shard.lower_bounds[local_var],
+                                         shard.upper_bounds[local_var]));
         FillDomainInProto(domain, var_proto);
       }
-      const std::string filename = absl::StrCat(dump_prefix_, "tighened_model_",
-                                                export_counter_, ".pb.txt");
-      LOG(INFO) << "Dumping tightened model proto to '" << filename << "'.";
-      export_counter_++;
-      CHECK(WriteModelProtoToFile(tight_model, filename));
     }
+    const std::string filename = absl::StrCat(dump_prefix_, "tighened_model_",
+                                              export_counter_, ".pb.txt");
+    LOG(INFO) << "Dumping tightened model proto to '" << filename << "'.";
+    export_counter_++;
+    CHECK(WriteModelProtoToFile(tight_model, filename));
   }
 }
 
@@ -910,33 +994,51 @@ void SharedBoundsManager::ReportPotentialNewBounds(
 void SharedBoundsManager::FixVariablesFromPartialSolution(
     const std::vector<int64_t>& solution,
     const std::vector<int>& variables_to_fix) {
-  absl::MutexLock mutex_lock(&mutex_);
+  // We need to check and fix all the variables atomically, so we lock all the
+  // involved shards, in increasing order to avoid any deadlock.
+  std::vector<int> shard_indices;
+  for (const int var : variables_to_fix) {
+    shard_indices.push_back(var / kShardSize);
+  }
+  gtl::STLSortAndRemoveDuplicates(&shard_indices);
+  for (const int s : shard_indices) shards_[s]->mutex.Lock();
+  absl::Cleanup unlock = [this, &shard_indices] {
+    for (const int s : shard_indices) shards_[s]->mutex.Unlock();
+  };
 
   // Abort if incompatible. Note that we only check the position that we are
   // about to fix. This should be enough. Otherwise we might never accept any
   // solution because the base LNS solution was not the same in some of the
   // variables that we fixed here.
   for (const int var : variables_to_fix) {
+    const Shard& shard = ShardOf(var);
+    const int local_var = var % kShardSize;
     const int64_t value = solution[var];
-    if (value < lower_bounds_[var] || value > upper_bounds_[var]) {
+    shard.mutex.AssertHeld();
+    if (value < shard.lower_bounds[local_var] ||
+        value > shard.upper_bounds[local_var]) {
       VLOG(1) << "Incompatibility in FixVariablesFromPartialSolution() "
               << "var: " << var << " value: " << value << " bounds: ["
-              << lower_bounds_[var] << "," << upper_bounds_[var] << "]";
+              << shard.lower_bounds[local_var] << ","
+              << shard.upper_bounds[local_var] << "]";
       return;
     }
   }
 
   // Fix the variables.
   for (const int var : variables_to_fix) {
-    const int64_t old_lb = lower_bounds_[var];
-    const int64_t old_ub = upper_bounds_[var];
+    Shard& shard = ShardOf(var);
+    const int local_var = var % kShardSize;
+    shard.mutex.AssertHeld();
+    const int64_t old_lb = shard.lower_bounds[local_var];
+    const int64_t old_ub = shard.upper_bounds[local_var];
     const bool changed_lb = solution[var] > old_lb;
     const bool changed_ub = solution[var] < old_ub;
     if (!changed_lb && !changed_ub) continue;
 
-    lower_bounds_[var] = solution[var];
-    upper_bounds_[var] = solution[var];
-    changed_variables_since_last_synchronize_.Set(var);
+    shard.lower_bounds[local_var] = solution[var];
+    shard.upper_bounds[local_var] = solution[var];
+    shard.changed_variables_since_last_synchronize.Set(local_var);
 
     // This is problematic as we might find a different partial solution.
     // To allow for further investigation, we currently fix it to the debug
@@ -946,40 +1048,44 @@ void SharedBoundsManager::FixVariablesFromPartialSolution(
         LOG(INFO) << "Fixing to a different solution for var=" << var
                   << " debug=" << debug_solution_[var]
                   << " partial=" << solution[var];
-        lower_bounds_[var] = debug_solution_[var];
-        upper_bounds_[var] = debug_solution_[var];
+        shard.lower_bounds[local_var] = debug_solution_[var];
+        shard.upper_bounds[local_var] = debug_solution_[var];
       }
     }
   }
 }
 
 void SharedBoundsManager::Synchronize() {
-  absl::MutexLock mutex_lock(&mutex_);
-  for (const int var :
-       changed_variables_since_last_synchronize_.PositionsSetAtLeastOnce()) {
-    synchronized_lower_bounds_[var] = lower_bounds_[var];
-    synchronized_upper_bounds_[var] = upper_bounds_[var];
-    for (int j = 0; j < id_to_changed_variables_.size(); ++j) {
-      id_to_changed_variables_[j].Set(var);
+  const int64_t new_epoch = epoch_.load(std::memory_order_relaxed) + 1;
+  bool changed = false;
+  for (const std::unique_ptr<Shard>& shard : shards_) {
+    absl::MutexLock mutex_lock(&shard->mutex);
+    SparseBitset<int>& to_publish =
+        shard->changed_variables_since_last_synchronize;
+    if (to_publish.PositionsSetAtLeastOnce().empty()) continue;
+    for (const int local_var : to_publish.PositionsSetAtLeastOnce()) {
+      shard->synchronized_lower_bounds[local_var] =
+          shard->lower_bounds[local_var];
+      shard->synchronized_upper_bounds[local_var] =
+          shard->upper_bounds[local_var];
+      shard->changelog.push_back(local_var);
     }
+    to_publish.ClearAll();
+    shard->last_changed_epoch.store(new_epoch, std::memory_order_release);
+    changed = true;
   }
-  changed_variables_since_last_synchronize_.ClearAll();
+  if (changed) epoch_.store(new_epoch, std::memory_order_release);
 }
 
 int SharedBoundsManager::RegisterNewId() {
-  absl::MutexLock mutex_lock(&mutex_);
-  const int id = id_to_changed_variables_.size();
-  id_to_changed_variables_.resize(id + 1);
-  id_to_changed_variables_[id].ClearAndResize(num_variables_);
-  for (int var = 0; var < num_variables_; ++var) {
-    const int64_t lb = model_proto_.variables(var).domain(0);
-    const int domain_size = model_proto_.variables(var).domain_size();
-    const int64_t ub = model_proto_.variables(var).domain(domain_size - 1);
-    if (lb != synchronized_lower_bounds_[var] ||
-        ub != synchronized_upper_bounds_[var]) {
-      id_to_changed_variables_[id].Set(var);
-    }
-  }
+  absl::MutexLock mutex_lock(&workers_mutex_);
+  const int id = id_to_worker_state_.size();
+  WorkerState& state = id_to_worker_state_.emplace_back();
+
+  // Starting from the beginning of all the changelogs gives us all the bounds
+  // that differ from the ones in model_proto_.
+  state.changelog_positions.assign(NumShards(), 0);
+  state.changed_variables.ClearAndResize(num_variables_);
   return id;
 }
 
@@ -990,33 +1096,74 @@ void SharedBoundsManager::GetChangedBounds(
   new_lower_bounds->clear();
   new_upper_bounds->clear();
 
-  absl::MutexLock mutex_lock(&mutex_);
-  for (const int var : id_to_changed_variables_[id].PositionsSetAtLeastOnce()) {
-    variables->push_back(var);
+  // We only need a reader lock to access our state since no other thread will
+  // access it concurrently. This only synchronizes with RegisterNewId().
+  absl::ReaderMutexLock workers_lock(&workers_mutex_);
+  WorkerState& state = id_to_worker_state_[id];
+  const int64_t epoch = epoch_.load(std::memory_order_acquire);
+  if (epoch == state.epoch) return;
+
+  for (int s = 0; s < NumShards(); ++s) {
+    Shard& shard = *shards_[s];
+    if (shard.last_changed_epoch.load(std::memory_order_acquire) <=
+        state.epoch) {
+      continue;
+    }
+    absl::MutexLock mutex_lock(&shard.mutex);
+    const int offset = s * kShardSize;
+    for (int i = state.changelog_positions[s]; i < shard.changelog.size();
+         ++i) {
+      const int var = offset + shard.changelog[i];
+      if (state.changed_variables[var]) continue;
+      state.changed_variables.Set(var);
+      variables->push_back(var);
+    }
+    state.changelog_positions[s] = shard.changelog.size();
   }
-  id_to_changed_variables_[id].ClearAll();
+  state.changed_variables.ClearAll();
+  state.epoch = epoch;
 
   // We need to report the bounds in a deterministic order as it is difficult to
   // guarantee that nothing depend on the order in which the new bounds are
   // processed.
+  //
+  // Note that since the shards contain consecutive variables, we only need to
+  // lock each changed shard once more.
   absl::c_sort(*variables);
-  for (const int var : *variables) {
-    new_lower_bounds->push_back(synchronized_lower_bounds_[var]);
-    new_upper_bounds->push_back(synchronized_upper_bounds_[var]);
+  int i = 0;
+  while (i < variables->size()) {
+    const int shard_index = (*variables)[i] / kShardSize;
+    Shard& shard = *shards_[shard_index];
+    absl::MutexLock mutex_lock(&shard.mutex);
+    for (; i < variables->size(); ++i) {
+      const int var = (*variables)[i];
+      if (var / kShardSize != shard_index) break;
+      new_lower_bounds->push_back(
+          shard.synchronized_lower_bounds[var - shard_index * kShardSize]);
+      new_upper_bounds->push_back(
+          shard.synchronized_upper_bounds[var - shard_index * kShardSize]);
+    }
   }
 }
 
 void SharedBoundsManager::UpdateDomains(std::vector<Domain>* domains) {
-  absl::MutexLock mutex_lock(&mutex_);
-  CHECK_EQ(domains->size(), synchronized_lower_bounds_.size());
-  for (int var = 0; var < domains->size(); ++var) {
-    (*domains)[var] = (*domains)[var].IntersectionWith(Domain(
-        synchronized_lower_bounds_[var], synchronized_upper_bounds_[var]));
+  CHECK_EQ(domains->size(), num_variables_);
+  for (int s = 0; s < NumShards(); ++s) {
+    Shard& shard = *shards_[s];
+    absl::MutexLock mutex_lock(&shard.mutex);
+    const int offset = s * kShardSize;
+    for (int local_var = 0; local_var < shard.synchronized_lower_bounds.size();
+         ++local_var) {
+      Domain& domain = (*domains)[offset + local_var];
+      domain = domain.IntersectionWith(
+          Domain(shard.synchronized_lower_bounds[local_var],
+                 shard.synchronized_upper_bounds[local_var]));
+    }
   }
 }
 
 void SharedBoundsManager::LogStatistics(SolverLogger* logger) {
-  absl::MutexLock mutex_lock(&mutex_);
+  absl::MutexLock mutex_lock(&stats_mutex_);
   if (!bounds_exported_.empty()) {
     std::vector<std::vector<std::string>> table;
     table.push_back({"Improving bounds shared", "Num"});
@@ -1028,12 +1175,80 @@ void SharedBoundsManager::LogStatistics(SolverLogger* logger) {
 }
 
 int SharedBoundsManager::NumBoundsExported(const std::string& worker_name) {
-  absl::MutexLock mutex_lock(&mutex_);
+  absl::MutexLock mutex_lock(&stats_mutex_);
   const auto it = bounds_exported_.find(worker_name);
   if (it == bounds_exported_.end()) return 0;
   return it->second;
 }
 
+SharedClauseRingBuffer::SharedClauseRingBuffer(int capacity)
+    : capacity_(capacity), slots_(new std::atomic<int>[capacity]) {
+  CHECK_GT(capacity, 0);
+  CHECK_EQ(capacity & (capacity - 1), 0) << "Must be a power of two.";
+}
+
+void SharedClauseRingBuffer::Add(int lbd, absl::Span<const int> clause) {
+  const int64_t num_slots = 2 + clause.size();
+  if (num_slots > capacity_) return;
+
+  // This follows the usual "seqlock" pattern: we first advertise the slots
+  // we are about to overwrite, and only then write them.
+  const int64_t start = write_end_.load(std::memory_order_relaxed);
+  write_start_.store(start + num_slots, std::memory_order_relaxed);
+  std::atomic_thread_fence(std::memory_order_release);
+
+  const int64_t mask = capacity_ - 1;
+  int64_t pos = start;
+  slots_[pos++ & mask].store(clause.size(), std::memory_order_relaxed);
+  slots_[pos++ & mask].store(lbd, std::memory_order_relaxed);
+  for (const int lit : clause) {
+    slots_[pos++ & mask].store(lit, std::memory_order_relaxed);
+  }
+  write_end_.store(pos, std::memory_order_release);
+  num_added_.store(num_added_.load(std::memory_order_relaxed) + 1,
+                   std::memory_order_relaxed);
+}
+
+void SharedClauseRingBuffer::Publish() {
+  visible_end_.store(write_end_.load(std::memory_order_acquire),
+                     std::memory_order_release);
+}
+
+int SharedClauseRingBuffer::ReadFrom(
+    int64_t* position,
+    absl::FunctionRef<void(int, absl::Span<const int>)> f) const {
+  const int64_t begin = *position;
+  const int64_t end = visible_end_.load(std::memory_order_acquire);
+  if (end <= begin) return 0;
+  *position = end;
+
+  // We do not know where the clauses start in the middle of the buffer, so
+  // if we are too late, we just skip everything.
+  if (end - begin > capacity_) return 0;
+
+  std::vector<int> buffer(end - begin);
+  const int64_t mask = capacity_ - 1;
+  for (int64_t pos = begin; pos < end; ++pos) {
+    buffer[pos - begin] = slots_[pos & mask].load(std::memory_order_relaxed);
+  }
+
+  // Abort if the producer started to overwrite what we just read.
+  std::atomic_thread_fence(std::memory_order_acquire);
+  if (write_start_.load(std::memory_order_relaxed) - begin > capacity_) {
+    return 0;
+  }
+
+  int num_read = 0;
+  for (int i = 0; i < buffer.size();) {
+    const int size = buffer[i];
+    const int lbd = buffer[i + 1];
+    f(lbd, absl::MakeConstSpan(&buffer[i + 2], size));
+    i += 2 + size;
+    ++num_read;
+  }
+  return num_read;
+}
+
 SharedClausesManager::SharedClausesManager(bool always_synchronize)
     : always_synchronize_(always_synchronize) {}
 
@@ -1042,6 +1257,10 @@ int SharedClausesManager::RegisterNewId() {
   const int id = id_to_last_processed_binary_clause_.size();
   id_to_last_processed_binary_clause_.resize(id + 1, 0);
   id_to_clauses_exported_.resize(id + 1, 0);
+  if (id < kMaxNumGlueClauseBuffers) {
+    glue_clause_buffers_[id] = std::make_unique<GlueClauseBuffer>();
+    num_glue_clause_buffers_.store(id + 1, std::memory_order_release);
+  }
   return id;
 }
 
@@ -1083,18 +1302,54 @@ void SharedClausesManager::GetUnseenBinaryClauses(
   id_to_last_processed_binary_clause_[id] = last_visible_clause_;
 }
 
+void SharedClausesManager::AddGlueClause(int id, int lbd,
+                                         absl::Span<const int> clause) {
+  if (id >= kMaxNumGlueClauseBuffers) return;
+  SharedClauseRingBuffer& ring_buffer = glue_clause_buffers_[id]->ring_buffer;
+  ring_buffer.Add(lbd, clause);
+  if (always_synchronize_) ring_buffer.Publish();
+}
+
+void SharedClausesManager::GetUnseenGlueClauses(
+    int id, std::vector<int>* lbds, CompactVectorVector<int, int>* clauses) {
+  if (id >= kMaxNumGlueClauseBuffers) return;
+  GlueClauseBuffer& buffer = *glue_clause_buffers_[id];
+  const int num_buffers =
+      num_glue_clause_buffers_.load(std::memory_order_acquire);
+  if (buffer.read_positions.size() < num_buffers) {
+    buffer.read_positions.resize(num_buffers, 0);
+  }
+  for (int other = 0; other < num_buffers; ++other) {
+    if (other == id) continue;
+    buffer.num_imported +=
+        glue_clause_buffers_[other]->ring_buffer.ReadFrom(
+            &buffer.read_positions[other],
+            [lbds, clauses](int lbd, absl::Span<const int> clause) {
+              lbds->push_back(lbd);
+              clauses->Add(clause);
+            });
+  }
+}
+
 void SharedClausesManager::LogStatistics(SolverLogger* logger) {
   absl::MutexLock mutex_lock(&mutex_);
-  absl::btree_map<std::string, int64_t> name_to_clauses;
+  absl::btree_map<std::string, std::pair<int64_t, int64_t>> name_to_clauses;
+  const int num_buffers =
+      num_glue_clause_buffers_.load(std::memory_order_acquire);
   for (int id = 0; id < id_to_clauses_exported_.size(); ++id) {
-    if (id_to_clauses_exported_[id] == 0) continue;
-    name_to_clauses[id_to_worker_name_[id]] = id_to_clauses_exported_[id];
+    const int64_t num_glue =
+        id < num_buffers ? glue_clause_buffers_[id]->ring_buffer.num_added()
+                         : 0;
+    if (id_to_clauses_exported_[id] == 0 && num_glue == 0) continue;
+    name_to_clauses[id_to_worker_name_[id]] = {id_to_clauses_exported_[id],
+                                               num_glue};
   }
   if (!name_to_clauses.empty()) {
     std::vector<std::vector<std::string>> table;
-    table.push_back({"Clauses shared", "Num"});
-    for (const auto& entry : name_to_clauses) {
-      table.push_back({FormatName(entry.first), FormatCounter(entry.second)});
+    table.push_back({"Clauses shared", "#Binary", "#Glue"});
+    for (const auto& [name, counts] : name_to_clauses) {
+      table.push_back({FormatName(name), FormatCounter(counts.first),
+                       FormatCounter(counts.second)});
     }
     SOLVER_LOG(logger, FormatTable(table));
   }
@@ -1104,6 +1359,16 @@ void SharedClausesManager::Synchronize() {
   absl::MutexLock mutex_lock(&mutex_);
   last_visible_clause_ = added_binary_clauses_.size();
   // TODO(user): We could cleanup added_binary_clauses_ periodically.
+
+  // In the deterministic mode, this is called while no worker is running, so
+  // all the glue clauses exported so far become visible at the same time.
+  if (!always_synchronize_) {
+    const int num_buffers =
+        num_glue_clause_buffers_.load(std::memory_order_acquire);
+    for (int id = 0; id < num_buffers; ++id) {
+      glue_clause_buffers_[id]->ring_buffer.Publish();
+    }
+  }
 }
 
 void SharedStatistics::AddStats(
@@ -1114,6 +1379,17 @@ void SharedStatistics::AddStats(
   }
 }
 
+std::vector<std::pair<std::string, int64_t>>
+SharedStatistics::GetStatsWithPrefix(absl::string_view prefix) {
+  std::vector<std::pair<std::string, int64_t>> result;
+  absl::MutexLock mutex_lock(&mutex_);
+  for (const auto& [key, count] : stats_) {
+    if (absl::StartsWith(key, prefix)) result.push_back({key, count});
+  }
+  std::sort(result.begin(), result.end());
+  return result;
+}
+
 void SharedStatistics::Log(SolverLogger* logger) {
   absl::MutexLock mutex_lock(&mutex_);
   if (stats_.empty()) return;
@@ -14,11 +14,13 @@
 #ifndef OR_TOOLS_SAT_SYNCHRONIZATION_H_
 #define OR_TOOLS_SAT_SYNCHRONIZATION_H_
 
+#include <algorithm>
 #include <atomic>
 #include <cstdint>
 #include <deque>
 #include <functional>
 #include <limits>
+#include <memory>
 #include <string>
 #include <utility>
 #include <vector>
@@ -27,6 +29,7 @@
 #include "absl/container/btree_map.h"
 #include "absl/container/flat_hash_map.h"
 #include "absl/container/flat_hash_set.h"
+#include "absl/functional/function_ref.h"
 #include "absl/random/bit_gen_ref.h"
 #include "absl/random/random.h"
 #include "absl/strings/string_view.h"
@@ -50,6 +53,10 @@ namespace sat {
 
 // Thread-safe. Keeps a set of n unique best solution found so far.
 //
+// The solutions are immutable once added and are shared via std::shared_ptr,
+// so that the readers do not need to copy them, and the mutex is only held
+// for the time needed to select a solution.
+//
 // TODO(user): Maybe add some criteria to only keep solution with an objective
 // really close to the best solution.
 template <typename ValueType>
@@ -95,7 +102,7 @@ class SharedSolutionRepository {
   int NumSolutions() const;
 
   // Returns the solution #i where i must be smaller than NumSolutions().
-  Solution GetSolution(int index) const;
+  std::shared_ptr<const Solution> GetSolution(int index) const;
 
   // Returns the variable value of variable 'var_index' from solution
   // 'solution_index' where solution_index must be smaller than NumSolutions()
@@ -103,13 +110,14 @@ class SharedSolutionRepository {
   ValueType GetVariableValueInSolution(int var_index, int solution_index) const;
 
   // Returns a random solution biased towards good solutions.
-  Solution GetRandomBiasedSolution(absl::BitGenRef random) const;
+  std::shared_ptr<const Solution> GetRandomBiasedSolution(
+      absl::BitGenRef random) const;
 
   // Add a new solution. Note that it will not be added to the pool of solution
   // right away. One must call Synchronize for this to happen.
   //
   // Works in O(num_solutions_to_keep_).
-  void Add(const Solution& solution);
+  void Add(Solution solution);
 
   // Updates the current pool of solution with the one recently added. Note that
   // we use a stable ordering of solutions, so the final pool will be
@@ -128,7 +136,7 @@ class SharedSolutionRepository {
 
  protected:
   // Helper method for adding the solutions once the mutex is acquired.
-  void AddInternal(const Solution& solution)
+  void AddInternal(std::shared_ptr<const Solution> solution)
       ABSL_EXCLUSIVE_LOCKS_REQUIRED(mutex_);
 
   const std::string name_;
@@ -143,8 +151,10 @@ class SharedSolutionRepository {
   // Our two solutions pools, the current one and the new one that will be
   // merged into the current one on each Synchronize() calls.
   mutable std::vector<int> tmp_indices_ ABSL_GUARDED_BY(mutex_);
-  std::vector<Solution> solutions_ ABSL_GUARDED_BY(mutex_);
-  std::vector<Solution> new_solutions_ ABSL_GUARDED_BY(mutex_);
+  std::vector<std::shared_ptr<const Solution>> solutions_
+      ABSL_GUARDED_BY(mutex_);
+  std::vector<std::shared_ptr<const Solution>> new_solutions_
+      ABSL_GUARDED_BY(mutex_);
 };
 
 class SharedLPSolutionRepository : public SharedSolutionRepository<double> {
@@ -154,6 +164,99 @@ class SharedLPSolutionRepository : public SharedSolutionRepository<double> {
                                          "lp solutions") {}
 
   void NewLPSolution(std::vector<double> lp_solution);
+
+  // Returns the last solution given to NewLPSolution(), or nullptr if there is
+  // none. Unlike the pool above, this does not wait for the next
+  // Synchronize() and does not copy the values, so consumers like RINS always
+  // start from the freshest LP point.
+  std::shared_ptr<const Solution> GetLatestLPSolution() const;
+
+  // Sequence number of the solution returned by GetLatestLPSolution(), it is
+  // zero if there is none. This does not take any lock and can be used to
+  // cheaply check if a new LP solution was published.
+  int64_t LatestLPSolutionSequenceNumber() const {
+    return latest_sequence_number_.load(std::memory_order_acquire);
+  }
+
+ private:
+  // This is separate from mutex_ since readers only copy a pointer here.
+  mutable absl::Mutex latest_mutex_;
+  std::shared_ptr<const Solution> latest_solution_
+      ABSL_GUARDED_BY(latest_mutex_);
+  std::atomic<int64_t> latest_sequence_number_ = 0;
+};
+
+// Thread-safe. A pool of globally valid cuts expressed on the variables of the
+// model proto. The cut separation worker adds the cuts it finds on the shared
+// LP solutions, and all the workers with an LP import the new ones.
+class SharedCutPool {
+ public:
+  // Represents lb <= sum coeffs[i] * vars[i] <= ub where vars are indices of
+  // proto variables. An infinite bound uses kMinIntegerValue/kMaxIntegerValue.
+  struct Cut {
+    std::vector<int> vars;
+    std::vector<int64_t> coeffs;
+    int64_t lb;
+    int64_t ub;
+  };
+
+  explicit SharedCutPool(int max_num_cuts = 10000)
+      : max_num_cuts_(max_num_cuts) {}
+
+  // Adds a cut, unless the same cut was already added or the pool is full.
+  void AddCut(Cut cut);
+
+  // Returns the cuts added after the first *num_imported ones and updates
+  // *num_imported. Each reader should start with an index of zero.
+  std::vector<std::shared_ptr<const Cut>> GetNewCuts(int* num_imported) const;
+
+  std::vector<std::string> TableLineStats() const {
+    absl::MutexLock mutex_lock(&mutex_);
+    return {FormatName("cuts"), FormatCounter(cuts_.size()),
+            FormatCounter(num_queried_), FormatCounter(num_ignored_)};
+  }
+
+ private:
+  const int max_num_cuts_;
+  mutable absl::Mutex mutex_;
+  std::vector<std::shared_ptr<const Cut>> cuts_ ABSL_GUARDED_BY(mutex_);
+  absl::flat_hash_set<uint64_t> fingerprints_ ABSL_GUARDED_BY(mutex_);
+  int64_t num_ignored_ ABSL_GUARDED_BY(mutex_) = 0;
+  mutable int64_t num_queried_ ABSL_GUARDED_BY(mutex_) = 0;
+};
+
+// Thread-safe. Pseudo costs aggregated over all the workers, expressed on the
+// variables of the model proto. For a proto variable var, the index 2 * var is
+// used for the branch that increases its lower bound, and 2 * var + 1 for the
+// branch that decreases its upper bound. Each index stores the sum and the
+// number of observed objective increases per unit of lp value change.
+class SharedPseudoCosts {
+ public:
+  struct Records {
+    double sum = 0.0;
+    int64_t count = 0;
+  };
+
+  explicit SharedPseudoCosts(int num_proto_variables)
+      : records_(2 * num_proto_variables) {}
+
+  // Adds the records observed by one worker since its last call, and fills
+  // all_records with the aggregated records of all the workers, this one
+  // included.
+  void ExchangeRecords(absl::Span<const std::pair<int, Records>> new_records,
+                       std::vector<Records>* all_records);
+
+  std::vector<std::string> TableLineStats() const {
+    absl::MutexLock mutex_lock(&mutex_);
+    return {FormatName("pseudo costs"), FormatCounter(num_added_),
+            FormatCounter(num_exchanges_)};
+  }
+
+ private:
+  mutable absl::Mutex mutex_;
+  std::vector<Records> records_ ABSL_GUARDED_BY(mutex_);
+  int64_t num_added_ ABSL_GUARDED_BY(mutex_) = 0;
+  int64_t num_exchanges_ ABSL_GUARDED_BY(mutex_) = 0;
 };
 
 // Set of partly filled solutions. They are meant to be finished by some lns
@@ -168,9 +271,12 @@ class SharedIncompleteSolutionManager {
  public:
   // This adds a new solution to the stack.
   // Note that we keep the last 100 ones at most.
-  void AddSolution(const std::vector<double>& lp_solution);
+  void AddSolution(std::vector<double> lp_solution);
 
-  bool HasSolution() const;
+  // This does not take any lock.
+  bool HasSolution() const {
+    return num_available_.load(std::memory_order_acquire) > 0;
+  }
 
   // If there are no solution, this return an empty vector.
   std::vector<double> PopLast();
@@ -184,6 +290,7 @@ class SharedIncompleteSolutionManager {
  private:
   mutable absl::Mutex mutex_;
   std::deque<std::vector<double>> solutions_ ABSL_GUARDED_BY(mutex_);
+  std::atomic<int> num_available_ = 0;
   int64_t num_added_ ABSL_GUARDED_BY(mutex_) = 0;
   mutable int64_t num_queried_ ABSL_GUARDED_BY(mutex_) = 0;
 };
@@ -518,6 +625,10 @@ class SharedBoundsManager {
 
   // When called, returns the set of bounds improvements since
   // the last time this method was called with the same id.
+  //
+  // This only locks the shards that changed since the last call with the same
+  // id. Note however that two concurrent calls with the same id are not
+  // supported.
   void GetChangedBounds(int id, std::vector<int>* variables,
                         std::vector<int64_t>* new_lower_bounds,
                         std::vector<int64_t>* new_upper_bounds);
@@ -527,7 +638,7 @@ class SharedBoundsManager {
   void UpdateDomains(std::vector<Domain>* domains);
 
   // Publishes any new bounds so that GetChangedBounds() will reflect the latest
-  // state.
+  // state. This must not be called concurrently with itself.
   void Synchronize();
 
   void LogStatistics(SolverLogger* logger);
@@ -546,28 +657,67 @@ class SharedBoundsManager {
   }
 
  private:
+  // The variables are split into shards of consecutive variables, each with
+  // its own mutex, so that workers reporting or reading bounds on different
+  // parts of the model do not wait for each other.
+  static constexpr int kShardSize = 4096;
+  struct Shard {
+    absl::Mutex mutex;
+
+    // These are always up to date. The variables are indexed relatively to the
+    // first variable of the shard.
+    std::vector<int64_t> lower_bounds ABSL_GUARDED_BY(mutex);
+    std::vector<int64_t> upper_bounds ABSL_GUARDED_BY(mutex);
+    SparseBitset<int> changed_variables_since_last_synchronize
+        ABSL_GUARDED_BY(mutex);
+
+    // These are only updated on Synchronize().
+    std::vector<int64_t> synchronized_lower_bounds ABSL_GUARDED_BY(mutex);
+    std::vector<int64_t> synchronized_upper_bounds ABSL_GUARDED_BY(mutex);
+
+    // All the variables whose synchronized bounds changed, in the order of the
+    // Synchronize() calls. A worker only needs to remember its position in
+    // this log to know what changed since its last GetChangedBounds().
+    std::vector<int> changelog ABSL_GUARDED_BY(mutex);
+
+    // The last epoch at which the synchronized bounds of this shard changed.
+    // This allows the readers to skip the shard without locking it.
+    std::atomic<int64_t> last_changed_epoch = 0;
+  };
+
+  // The state of a worker registered with RegisterNewId().
+  struct WorkerState {
+    // The epoch_ at the last GetChangedBounds() call and the corresponding
+    // positions in each shard changelog.
+    int64_t epoch = 0;
+    std::vector<int> changelog_positions;
+
+    // Used to deduplicate the variables that changed more than once.
+    SparseBitset<int> changed_variables;
+  };
+
+  int NumShards() const { return shards_.size(); }
+  Shard& ShardOf(int var) { return *shards_[var / kShardSize]; }
+
   const int num_variables_;
   const CpModelProto& model_proto_;
 
-  absl::Mutex mutex_;
+  std::vector<std::unique_ptr<Shard>> shards_;
 
-  // These are always up to date.
-  std::vector<int64_t> lower_bounds_ ABSL_GUARDED_BY(mutex_);
-  std::vector<int64_t> upper_bounds_ ABSL_GUARDED_BY(mutex_);
-  SparseBitset<int> changed_variables_since_last_synchronize_
-      ABSL_GUARDED_BY(mutex_);
-  int64_t total_num_improvements_ ABSL_GUARDED_BY(mutex_) = 0;
+  // Incremented by each Synchronize() that changed some bounds.
+  std::atomic<int64_t> epoch_ = 0;
 
-  // These are only updated on Synchronize().
-  std::vector<int64_t> synchronized_lower_bounds_ ABSL_GUARDED_BY(mutex_);
-  std::vector<int64_t> synchronized_upper_bounds_ ABSL_GUARDED_BY(mutex_);
-  std::deque<SparseBitset<int>> id_to_changed_variables_
-      ABSL_GUARDED_BY(mutex_);
-  absl::btree_map<std::string, int> bounds_exported_ ABSL_GUARDED_BY(mutex_);
+  absl::Mutex workers_mutex_;
+  std::deque<WorkerState> id_to_worker_state_ ABSL_GUARDED_BY(workers_mutex_);
 
+  // Only used for the statistics and debugging.
+  absl::Mutex stats_mutex_;
+  int64_t total_num_improvements_ ABSL_GUARDED_BY(stats_mutex_) = 0;
+  absl::btree_map<std::string, int> bounds_exported_
+      ABSL_GUARDED_BY(stats_mutex_);
   std::vector<int64_t> debug_solution_;
   std::string dump_prefix_;
-  int export_counter_ = 0;
+  int export_counter_ ABSL_GUARDED_BY(stats_mutex_) = 0;
 };
 
 // This class holds all the binary clauses that were found and shared by the
@@ -577,11 +727,71 @@ class SharedBoundsManager {
 //
 // Note that this uses literal as encoded in a cp_model.proto. Thus, the
 // literals can be negative numbers.
+// A fixed capacity ring buffer of clauses with a single producer and any
+// number of concurrent consumers. Nothing is locked: the producer never waits
+// for the consumers, it just overwrites the oldest clauses, and a consumer
+// detects that what it read was overwritten and skips it.
+//
+// Each clause is stored as [size, lbd, literals...]. Each consumer keeps its
+// own read position, starting at zero.
+class SharedClauseRingBuffer {
+ public:
+  // The capacity is in number of int slots and must be a power of two.
+  explicit SharedClauseRingBuffer(int capacity);
+
+  // This type is neither copyable nor movable.
+  SharedClauseRingBuffer(const SharedClauseRingBuffer&) = delete;
+  SharedClauseRingBuffer& operator=(const SharedClauseRingBuffer&) = delete;
+
+  // Only the producer can call this. The clause is not visible to the
+  // consumers until the next Publish().
+  void Add(int lbd, absl::Span<const int> clause);
+
+  // Makes all the clauses added so far visible to the consumers. This can be
+  // called by any thread, but not concurrently.
+  void Publish();
+
+  // Calls f(lbd, clause) for all the clauses published since *position and
+  // updates *position. It is safe to call this concurrently with Add(). If the
+  // producer overwrote some of the clauses since *position, we skip all the
+  // currently published clauses instead. Returns the number of clauses read.
+  int ReadFrom(int64_t* position,
+               absl::FunctionRef<void(int, absl::Span<const int>)> f) const;
+
+  int64_t num_added() const {
+    return num_added_.load(std::memory_order_relaxed);
+  }
+
+ private:
+  const int64_t capacity_;
+  std::unique_ptr<std::atomic<int>[]> slots_;
+
+  // All positions are increasing and taken modulo capacity_ to index slots_.
+  // We always have visible_end_ <= write_end_ <= write_start_ and the slots in
+  // [write_end_, write_start_) are the ones currently being written.
+  std::atomic<int64_t> write_start_ = 0;
+  std::atomic<int64_t> write_end_ = 0;
+  std::atomic<int64_t> visible_end_ = 0;
+  std::atomic<int64_t> num_added_ = 0;
+};
+
 class SharedClausesManager {
  public:
   explicit SharedClausesManager(bool always_synchronize);
   void AddBinaryClause(int id, int lit1, int lit2);
 
+  // Exports a learned clause of size >= 3 from the worker with given id. The
+  // clause is stored in the ring buffer of this worker, so this does not lock
+  // anything and can only be called by the thread of this worker.
+  void AddGlueClause(int id, int lbd, absl::Span<const int> clause);
+
+  // Appends to clauses (and lbds) the glue clauses exported by the other
+  // workers since the last call with the same id. This must only be called by
+  // the thread of the worker with the given id, but it does not lock anything
+  // either.
+  void GetUnseenGlueClauses(int id, std::vector<int>* lbds,
+                            CompactVectorVector<int, int>* clauses);
+
   // Fills new_clauses with
   //   {{lit1 of clause1, lit2 of clause1},
   //    {lit1 of clause2, lit2 of clause2},
@@ -612,6 +822,25 @@ class SharedClausesManager {
   int last_visible_clause_ ABSL_GUARDED_BY(mutex_) = 0;
   const bool always_synchronize_ = true;
 
+  // One ring buffer per registered id for the glue clauses. These are created
+  // by RegisterNewId() and never reallocated, so the workers can access them
+  // without locking. The ids above kMaxNumGlueClauseBuffers do not share glue
+  // clauses.
+  static constexpr int kMaxNumGlueClauseBuffers = 1024;
+  static constexpr int kGlueClauseBufferCapacity = 1 << 16;
+  struct GlueClauseBuffer {
+    GlueClauseBuffer() : ring_buffer(kGlueClauseBufferCapacity) {}
+    SharedClauseRingBuffer ring_buffer;
+
+    // The read positions of the worker owning this buffer in the buffers of
+    // all the other workers. Only accessed by this worker.
+    std::vector<int64_t> read_positions;
+    int64_t num_imported = 0;
+  };
+  std::unique_ptr<GlueClauseBuffer>
+      glue_clause_buffers_[kMaxNumGlueClauseBuffers];
+  std::atomic<int> num_glue_clause_buffers_ = 0;
+
   // Used for reporting statistics.
   absl::flat_hash_map<int, std::string> id_to_worker_name_;
 };
@@ -627,6 +856,10 @@ class SharedStatistics {
   // Logs all the added stats.
   void Log(SolverLogger* logger);
 
+  // Returns the sorted list of stats whose key starts with the given prefix.
+  std::vector<std::pair<std::string, int64_t>> GetStatsWithPrefix(
+      absl::string_view prefix);
+
  private:
   absl::Mutex mutex_;
   absl::flat_hash_map<std::string, int64_t> stats_ ABSL_GUARDED_BY(mutex_);
@@ -639,7 +872,7 @@ int SharedSolutionRepository<ValueType>::NumSolutions() const {
 }
 
 template <typename ValueType>
-typename SharedSolutionRepository<ValueType>::Solution
+std::shared_ptr<const typename SharedSolutionRepository<ValueType>::Solution>
 SharedSolutionRepository<ValueType>::GetSolution(int i) const {
   absl::MutexLock mutex_lock(&mutex_);
   ++num_queried_;
@@ -650,17 +883,17 @@ template <typename ValueType>
 ValueType SharedSolutionRepository<ValueType>::GetVariableValueInSolution(
     int var_index, int solution_index) const {
   absl::MutexLock mutex_lock(&mutex_);
-  return solutions_[solution_index].variable_values[var_index];
+  return solutions_[solution_index]->variable_values[var_index];
 }
 
 // TODO(user): Experiments on the best distribution.
 template <typename ValueType>
-typename SharedSolutionRepository<ValueType>::Solution
+std::shared_ptr<const typename SharedSolutionRepository<ValueType>::Solution>
 SharedSolutionRepository<ValueType>::GetRandomBiasedSolution(
     absl::BitGenRef random) const {
   absl::MutexLock mutex_lock(&mutex_);
   ++num_queried_;
-  const int64_t best_rank = solutions_[0].rank;
+  const int64_t best_rank = solutions_[0]->rank;
 
   // As long as we have solution with the best objective that haven't been
   // explored too much, we select one uniformly. Otherwise, we select a solution
@@ -674,7 +907,7 @@ SharedSolutionRepository<ValueType>::GetRandomBiasedSolution(
   // Select all the best solution with a low enough selection count.
   tmp_indices_.clear();
   for (int i = 0; i < solutions_.size(); ++i) {
-    const auto& solution = solutions_[i];
+    const Solution& solution = *solutions_[i];
     if (solution.rank == best_rank &&
         solution.num_selected <= kExplorationThreshold) {
       tmp_indices_.push_back(i);
@@ -687,34 +920,37 @@ SharedSolutionRepository<ValueType>::GetRandomBiasedSolution(
   } else {
     index = tmp_indices_[absl::Uniform<int>(random, 0, tmp_indices_.size())];
   }
-  solutions_[index].num_selected++;
+  solutions_[index]->num_selected++;
   return solutions_[index];
 }
 
 template <typename ValueType>
-void SharedSolutionRepository<ValueType>::Add(const Solution& solution) {
+void SharedSolutionRepository<ValueType>::Add(Solution solution) {
   if (num_solutions_to_keep_ <= 0) return;
+
+  // We allocate the shared copy outside of the critical section.
+  auto shared_solution = std::make_shared<const Solution>(std::move(solution));
   absl::MutexLock mutex_lock(&mutex_);
-  AddInternal(solution);
+  AddInternal(std::move(shared_solution));
 }
 
 template <typename ValueType>
 void SharedSolutionRepository<ValueType>::AddInternal(
-    const Solution& solution) {
+    std::shared_ptr<const Solution> solution) {
   int worse_solution_index = 0;
   for (int i = 0; i < new_solutions_.size(); ++i) {
     // Do not add identical solution.
-    if (new_solutions_[i] == solution) return;
-    if (new_solutions_[worse_solution_index] < new_solutions_[i]) {
+    if (*new_solutions_[i] == *solution) return;
+    if (*new_solutions_[worse_solution_index] < *new_solutions_[i]) {
       worse_solution_index = i;
     }
   }
   if (new_solutions_.size() < num_solutions_to_keep_) {
     ++num_added_;
-    new_solutions_.push_back(solution);
-  } else if (solution < new_solutions_[worse_solution_index]) {
+    new_solutions_.push_back(std::move(solution));
+  } else if (*solution < *new_solutions_[worse_solution_index]) {
     ++num_added_;
-    new_solutions_[worse_solution_index] = solution;
+    new_solutions_[worse_solution_index] = std::move(solution);
   } else {
     ++num_ignored_;
   }
@@ -733,15 +969,25 @@ void SharedSolutionRepository<ValueType>::Synchronize() {
   // existing solutions.
   //
   // TODO(user): Introduce a notion of orthogonality to diversify the pool?
-  gtl::STLStableSortAndRemoveDuplicates(&solutions_);
+  std::stable_sort(solutions_.begin(), solutions_.end(),
+                   [](const std::shared_ptr<const Solution>& a,
+                      const std::shared_ptr<const Solution>& b) {
+                     return *a < *b;
+                   });
+  solutions_.erase(std::unique(solutions_.begin(), solutions_.end(),
+                               [](const std::shared_ptr<const Solution>& a,
+                                  const std::shared_ptr<const Solution>& b) {
+                                 return *a == *b;
+                               }),
+                   solutions_.end());
   if (solutions_.size() > num_solutions_to_keep_) {
     solutions_.resize(num_solutions_to_keep_);
   }
 
   if (!solutions_.empty()) {
     VLOG(2) << "Solution pool update:" << " num_solutions=" << solutions_.size()
-            << " min_rank=" << solutions_[0].rank
-            << " max_rank=" << solutions_.back().rank;
+            << " min_rank=" << solutions_[0]->rank
+            << " max_rank=" << solutions_.back()->rank;
   }
 
   num_synchronization_++;
@@ -13,12 +13,15 @@
 
 #include "ortools/sat/table.h"
 
+#include <cstdint>
 #include <functional>
 #include <utility>
 #include <vector>
 
 #include "absl/container/flat_hash_map.h"
 #include "absl/log/check.h"
+#include "absl/types/span.h"
+#include "ortools/sat/integer.h"
 #include "ortools/sat/model.h"
 #include "ortools/sat/sat_base.h"
 #include "ortools/sat/sat_solver.h"
@@ -74,5 +77,188 @@ std::function<void(Model*)> LiteralTableConstraint(
   };
 }
 
+std::function<void(Model*)> TableConstraint(
+    absl::Span<const IntegerVariable> vars,
+    const std::vector<std::vector<int64_t>>& tuples) {
+  return [variables = std::vector<IntegerVariable>(vars.begin(), vars.end()),
+          tuples](Model* model) {
+    const int num_vars = variables.size();
+    if (num_vars == 0) return;
+
+    // Fully encode all the variables, and index their values.
+    IntegerEncoder* encoder = model->GetOrCreate<IntegerEncoder>();
+    std::vector<std::vector<Literal>> column_literals(num_vars);
+    std::vector<absl::flat_hash_map<int64_t, int>> value_to_index(num_vars);
+    for (int i = 0; i < num_vars; ++i) {
+      encoder->FullyEncodeVariable(variables[i]);
+      for (const auto& entry : encoder->FullDomainEncoding(variables[i])) {
+        value_to_index[i][entry.value.value()] = column_literals[i].size();
+        column_literals[i].push_back(entry.literal);
+      }
+    }
+
+    // Only keep the tuples compatible with the current domains.
+    std::vector<std::vector<int>> indexed_tuples;
+    for (const std::vector<int64_t>& tuple : tuples) {
+      CHECK_EQ(tuple.size(), num_vars);
+      std::vector<int> indices(num_vars);
+      bool keep = true;
+      for (int i = 0; i < num_vars; ++i) {
+        const auto it = value_to_index[i].find(tuple[i]);
+        if (it == value_to_index[i].end()) {
+          keep = false;
+          break;
+        }
+        indices[i] = it->second;
+      }
+      if (keep) indexed_tuples.push_back(std::move(indices));
+    }
+    if (indexed_tuples.empty()) {
+      model->GetOrCreate<SatSolver>()->NotifyThatModelIsUnsat();
+      return;
+    }
+
+    CompactTablePropagator* constraint =
+        new CompactTablePropagator(column_literals, indexed_tuples, model);
+    constraint->RegisterWith(model->GetOrCreate<GenericLiteralWatcher>());
+    model->TakeOwnership(constraint);
+  };
+}
+
+CompactTablePropagator::CompactTablePropagator(
+    const std::vector<std::vector<Literal>>& column_literals,
+    const std::vector<std::vector<int>>& tuples, Model* model)
+    : assignment_(model->GetOrCreate<Trail>()->Assignment()),
+      trail_(model->GetOrCreate<Trail>()) {
+  std::vector<int> column_starts;
+  for (int i = 0; i < column_literals.size(); ++i) {
+    column_starts.push_back(entries_.size());
+    for (const Literal literal : column_literals[i]) {
+      entries_.push_back({literal, i});
+    }
+  }
+
+  // Because we process the tuples in order, the words of each entry are
+  // sorted and we only need to look at the last one.
+  const int num_tuples = tuples.size();
+  for (int t = 0; t < num_tuples; ++t) {
+    const int word = t / 64;
+    const uint64_t bit = uint64_t{1} << (t % 64);
+    for (int i = 0; i < tuples[t].size(); ++i) {
+      Entry& entry = entries_[column_starts[i] + tuples[t][i]];
+      if (entry.words.empty() || entry.words.back() != word) {
+        entry.words.push_back(word);
+        entry.masks.push_back(0);
+      }
+      entry.masks.back() |= bit;
+    }
+  }
+
+  valid_tuples_.assign((num_tuples + 63) / 64, ~uint64_t{0});
+  if (num_tuples % 64 != 0) {
+    valid_tuples_.back() = (uint64_t{1} << (num_tuples % 64)) - 1;
+  }
+  num_non_zero_words_ = valid_tuples_.size();
+}
+
+void CompactTablePropagator::RegisterWith(GenericLiteralWatcher* watcher) {
+  const int id = watcher->Register(this);
+  for (int e = 0; e < entries_.size(); ++e) {
+    watcher->WatchLiteral(entries_[e].literal.Negated(), id, e);
+  }
+  watcher->RegisterReversibleClass(id, this);
+  watcher->RegisterReversibleInt(id, &num_non_zero_words_);
+}
+
+void CompactTablePropagator::SetLevel(int level) {
+  if (level == level_ends_.size()) return;
+  if (level > level_ends_.size()) {
+    while (level > level_ends_.size()) {
+      level_ends_.push_back(saved_words_.size());
+    }
+    return;
+  }
+
+  // Backtrack.
+  for (int i = saved_words_.size(); --i >= level_ends_[level];) {
+    valid_tuples_[saved_words_[i].first] = saved_words_[i].second;
+  }
+  saved_words_.resize(level_ends_[level]);
+  level_ends_.resize(level);
+}
+
+void CompactTablePropagator::RemoveTuplesOf(const Entry& entry) {
+  for (int i = 0; i < entry.words.size(); ++i) {
+    const int word = entry.words[i];
+    const uint64_t old_value = valid_tuples_[word];
+    const uint64_t new_value = old_value & ~entry.masks[i];
+    if (new_value == old_value) continue;
+
+    // Nothing done at level zero needs to be restored.
+    if (!level_ends_.empty()) saved_words_.push_back({word, old_value});
+    valid_tuples_[word] = new_value;
+    if (new_value == 0) --num_non_zero_words_;
+  }
+}
+
+bool CompactTablePropagator::Propagate() {
+  // The valid tuples are in the state they had when we last propagated at the
+  // current level, so we just need to remove the tuples of all the false
+  // values. Note that this is idempotent.
+  for (const Entry& entry : entries_) {
+    if (assignment_.LiteralIsFalse(entry.literal)) RemoveTuplesOf(entry);
+  }
+  return FilterUnsupportedValues();
+}
+
+bool CompactTablePropagator::IncrementalPropagate(
+    const std::vector<int>& watch_indices) {
+  for (const int e : watch_indices) RemoveTuplesOf(entries_[e]);
+  return FilterUnsupportedValues();
+}
+
+bool CompactTablePropagator::FilterUnsupportedValues() {
+  if (num_non_zero_words_ == 0) {
+    FillReason(/*column=*/-1, trail_->MutableConflict());
+    return false;
+  }
+
+  // Note that removing an unsupported value does not remove any valid tuple,
+  // so one pass is enough to reach the fix point.
+  for (Entry& entry : entries_) {
+    if (assignment_.LiteralIsFalse(entry.literal)) continue;
+
+    // Look for a valid tuple, starting from the last one we found.
+    bool supported = false;
+    const int size = entry.words.size();
+    for (int k = 0, r = entry.residue; k < size; ++k, ++r) {
+      if (r == size) r = 0;
+      if ((valid_tuples_[entry.words[r]] & entry.masks[r]) != 0) {
+        entry.residue = r;
+        supported = true;
+        break;
+      }
+    }
+    if (supported) continue;
+
+    FillReason(entry.column, trail_->GetEmptyVectorToStoreReason());
+    if (!trail_->EnqueueWithStoredReason(entry.literal.Negated())) {
+      return false;
+    }
+  }
+  return true;
+}
+
+void CompactTablePropagator::FillReason(int column,
+                                        std::vector<Literal>* reason) const {
+  reason->clear();
+  for (const Entry& entry : entries_) {
+    if (entry.column == column) continue;
+    if (assignment_.LiteralIsFalse(entry.literal)) {
+      reason->push_back(entry.literal);
+    }
+  }
+}
+
 }  // namespace sat
 }  // namespace operations_research
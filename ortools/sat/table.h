@@ -16,6 +16,7 @@
 
 #include <cstdint>
 #include <functional>
+#include <utility>
 #include <vector>
 
 #include "absl/types/span.h"
@@ -23,6 +24,7 @@
 #include "ortools/sat/integer.h"
 #include "ortools/sat/model.h"
 #include "ortools/sat/sat_base.h"
+#include "ortools/util/rev.h"
 
 namespace operations_research {
 namespace sat {
@@ -35,6 +37,82 @@ std::function<void(Model*)> LiteralTableConstraint(
     const std::vector<std::vector<Literal>>& literal_tuples,
     const std::vector<Literal>& line_literals);
 
+// Enforces that the given variables take the values of one of the given
+// tuples. Unlike the expansion done in the presolve, this does not create any
+// literal or clause per tuple, so this is meant for large tables. The variables
+// are fully encoded.
+std::function<void(Model*)> TableConstraint(
+    absl::Span<const IntegerVariable> vars,
+    const std::vector<std::vector<int64_t>>& tuples);
+
+// Implements the "compact table" propagator from "Compact-Table: Efficiently
+// Filtering Table Constraints with Reversible Sparse Bit-Sets", Jordan
+// Demeulenaere, Renaud Hartert, Christophe Lecoutre, Guillaume Perez, Laurent
+// Perron, Jean-Charles Régin, Pierre Schaus, CP 2016.
+//
+// Column i of the table can take the values whose literals are given in
+// column_literals[i], and tuples[t][i] is the index of the value of tuple t in
+// column_literals[i]. Exactly one literal per column must be true, this must
+// be enforced elsewhere.
+//
+// We maintain a reversible bitset of the tuples that are still valid, and
+// remove a value as soon as none of the valid tuples uses it. The support of a
+// value is stored sparsely, as the list of the non-zero 64 bits words of its
+// tuple bitset.
+class CompactTablePropagator : public PropagatorInterface, ReversibleInterface {
+ public:
+  CompactTablePropagator(
+      const std::vector<std::vector<Literal>>& column_literals,
+      const std::vector<std::vector<int>>& tuples, Model* model);
+
+  // This type is neither copyable nor movable.
+  CompactTablePropagator(const CompactTablePropagator&) = delete;
+  CompactTablePropagator& operator=(const CompactTablePropagator&) = delete;
+
+  void SetLevel(int level) final;
+  bool Propagate() final;
+  bool IncrementalPropagate(const std::vector<int>& watch_indices) final;
+  void RegisterWith(GenericLiteralWatcher* watcher);
+
+ private:
+  // A value of a column, and the tuples that use it.
+  struct Entry {
+    Literal literal;
+    int column;
+    std::vector<int> words;
+    std::vector<uint64_t> masks;
+
+    // Index in words of the last valid tuple we found for this entry. This
+    // does not need to be reversible, it is just a good first guess.
+    int residue = 0;
+  };
+
+  // Removes the tuples of the given entry from the valid ones.
+  void RemoveTuplesOf(const Entry& entry);
+
+  // Removes the values that are no longer supported by a valid tuple until a
+  // fix point is reached.
+  bool FilterUnsupportedValues();
+
+  // Fills reason with the false literals of all the columns except the given
+  // one. The valid tuples only depend on these.
+  void FillReason(int column, std::vector<Literal>* reason) const;
+
+  const VariablesAssignment& assignment_;
+  Trail* trail_;
+
+  std::vector<Entry> entries_;
+
+  // The valid tuples, and the number of non-zero words in this bitset.
+  std::vector<uint64_t> valid_tuples_;
+  int num_non_zero_words_ = 0;
+
+  // Backtrack support for valid_tuples_, level_ends_[level] is an index in
+  // saved_words_.
+  std::vector<int> level_ends_;
+  std::vector<std::pair<int, uint64_t>> saved_words_;
+};
+
 }  // namespace sat
 }  // namespace operations_research
 
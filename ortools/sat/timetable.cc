@@ -416,35 +416,9 @@ bool TimeTablingPerTask::BuildProfile() {
   const IntegerValue default_non_relevant_height =
       has_demand_equal_to_capacity_ ? 1 : 0;
 
-  const auto& by_decreasing_start_max = helper_->TaskByDecreasingStartMax();
-  const auto& by_end_min = helper_->TaskByIncreasingEndMin();
-
-  // Next start/end of the compulsory parts to be processed. Note that only the
-  // task for which IsInProfile() is true must be considered.
-  int next_start = num_tasks_ - 1;
-  int next_end = 0;
-  const int num_tasks = num_tasks_;
-  while (next_end < num_tasks) {
-    IntegerValue time = by_end_min[next_end].time;
-    if (next_start >= 0) {
-      time = std::min(time, by_decreasing_start_max[next_start].time);
-    }
-
-    // Process the starting compulsory parts.
-    while (next_start >= 0 &&
-           by_decreasing_start_max[next_start].time == time) {
-      const int t = by_decreasing_start_max[next_start].task_index;
-      current_height += demands_min[t];
-      --next_start;
-    }
-
-    // Process the ending compulsory parts.
-    while (next_end < num_tasks && by_end_min[next_end].time == time) {
-      const int t = by_end_min[next_end].task_index;
-      current_height -= demands_min[t];
-      ++next_end;
-    }
-
+  // Updates the profile once all the compulsory parts starting or ending at
+  // the given time have been accounted for in current_height.
+  const auto close_time = [&](IntegerValue time) {
     if (current_height > max_height) {
       max_height = current_height;
       max_height_start = time;
@@ -461,6 +435,60 @@ bool TimeTablingPerTask::BuildProfile() {
       current_start = time;
       height_at_start = effective_height;
     }
+  };
+
+  // On large cumulatives, it is common that only a few tasks have a
+  // compulsory part. In this case, it is a lot faster to sort the events of
+  // these tasks than to scan all the tasks in the helper sorted orders, most
+  // of them contributing nothing to the profile.
+  const int num_tasks = num_tasks_;
+  if (num_profile_tasks_ < num_tasks / kSparseProfileBuildRatio) {
+    profile_events_.clear();
+    for (int i = 0; i < num_profile_tasks_; ++i) {
+      const int t = profile_tasks_[i];
+      profile_events_.push_back({helper_->StartMax(t), demands_min[t]});
+      profile_events_.push_back({helper_->EndMin(t), -demands_min[t]});
+    }
+    std::sort(profile_events_.begin(), profile_events_.end());
+    const int num_events = profile_events_.size();
+    for (int i = 0; i < num_events;) {
+      const IntegerValue time = profile_events_[i].first;
+      for (; i < num_events && profile_events_[i].first == time; ++i) {
+        current_height += profile_events_[i].second;
+      }
+      close_time(time);
+    }
+  } else {
+    const auto& by_decreasing_start_max = helper_->TaskByDecreasingStartMax();
+    const auto& by_end_min = helper_->TaskByIncreasingEndMin();
+
+    // Next start/end of the compulsory parts to be processed. Note that only
+    // the task for which IsInProfile() is true must be considered.
+    int next_start = num_tasks_ - 1;
+    int next_end = 0;
+    while (next_end < num_tasks) {
+      IntegerValue time = by_end_min[next_end].time;
+      if (next_start >= 0) {
+        time = std::min(time, by_decreasing_start_max[next_start].time);
+      }
+
+      // Process the starting compulsory parts.
+      while (next_start >= 0 &&
+             by_decreasing_start_max[next_start].time == time) {
+        const int t = by_decreasing_start_max[next_start].task_index;
+        current_height += demands_min[t];
+        --next_start;
+      }
+
+      // Process the ending compulsory parts.
+      while (next_end < num_tasks && by_end_min[next_end].time == time) {
+        const int t = by_end_min[next_end].task_index;
+        current_height -= demands_min[t];
+        ++next_end;
+      }
+
+      close_time(time);
+    }
   }
 
   // Build the last profile rectangle.
@@ -15,6 +15,7 @@
 #define OR_TOOLS_SAT_TIMETABLE_H_
 
 #include <cstdint>
+#include <utility>
 #include <vector>
 
 #include "ortools/sat/integer.h"
@@ -205,6 +206,12 @@ class TimeTablingPerTask : public PropagatorInterface {
   // Others will have zero here.
   std::vector<IntegerValue> cached_demands_min_;
 
+  // If less than 1 / kSparseProfileBuildRatio of the tasks have a compulsory
+  // part, BuildProfile() sorts their (time, demand delta) events in this
+  // vector instead of scanning all the tasks.
+  static constexpr int kSparseProfileBuildRatio = 8;
+  std::vector<std::pair<IntegerValue, IntegerValue>> profile_events_;
+
   // Statically computed.
   // This allow to simplify the profile for common usage.
   bool has_demand_equal_to_capacity_ = false;
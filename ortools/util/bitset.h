@@ -594,13 +594,18 @@ class Bitset64 {
   // Sets "this" to be the intersection of "this" and "other". The
   // bitsets do not have to be the same size. If other is smaller, all
   // the higher order bits are assumed to be 0.
+  //
+  // Note that the word loops of these bulk operations work on raw pointers so
+  // that the compiler vectorizes them.
   void Intersection(const Bitset64<IndexType>& other) {
     const int min_size = std::min(data_.size(), other.data_.size());
+    uint64_t* const data = data_.data();
+    const uint64_t* const other_data = other.data_.data();
     for (int i = 0; i < min_size; ++i) {
-      data_[i] &= other.data_[i];
+      data[i] &= other_data[i];
     }
     for (int i = min_size; i < data_.size(); ++i) {
-      data_[i] = 0;
+      data[i] = 0;
     }
   }
 
@@ -609,8 +614,72 @@ class Bitset64 {
   // the higher order bits are assumed to be 0.
   void Union(const Bitset64<IndexType>& other) {
     const int min_size = std::min(data_.size(), other.data_.size());
+    uint64_t* const data = data_.data();
+    const uint64_t* const other_data = other.data_.data();
+    for (int i = 0; i < min_size; ++i) {
+      data[i] |= other_data[i];
+    }
+  }
+
+  // Sets "this" to be "this" minus "other", i.e. clears the bits set in
+  // "other". The bitsets do not have to be the same size.
+  void Difference(const Bitset64<IndexType>& other) {
+    const int min_size = std::min(data_.size(), other.data_.size());
+    uint64_t* const data = data_.data();
+    const uint64_t* const other_data = other.data_.data();
     for (int i = 0; i < min_size; ++i) {
-      data_[i] |= other.data_[i];
+      data[i] &= ~other_data[i];
+    }
+  }
+
+  // Returns the number of bits set.
+  int64_t BitCount() const {
+    const uint64_t* const data = data_.data();
+    int64_t count = 0;
+    for (int i = 0; i < data_.size(); ++i) {
+      count += BitCount64(data[i]);
+    }
+    return count;
+  }
+
+  // Returns the number of bits set in both "this" and "other", without
+  // computing their intersection. The bitsets do not have to be the same size.
+  int64_t IntersectionBitCount(const Bitset64<IndexType>& other) const {
+    const int min_size = std::min(data_.size(), other.data_.size());
+    const uint64_t* const data = data_.data();
+    const uint64_t* const other_data = other.data_.data();
+    int64_t count = 0;
+    for (int i = 0; i < min_size; ++i) {
+      count += BitCount64(data[i] & other_data[i]);
+    }
+    return count;
+  }
+
+  // Returns true if "this" and "other" have a bit set in common.
+  bool Intersects(const Bitset64<IndexType>& other) const {
+    const int min_size = std::min(data_.size(), other.data_.size());
+    const uint64_t* const data = data_.data();
+    const uint64_t* const other_data = other.data_.data();
+    for (int i = 0; i < min_size; ++i) {
+      if (data[i] & other_data[i]) return true;
+    }
+    return false;
+  }
+
+  // Appends the positions of the bits set to "positions", in increasing
+  // order. This is faster than a loop over the Iterator below when most of
+  // the positions are needed, since the size of "positions" is reserved
+  // and there is no per-position state to maintain.
+  void AppendSetPositions(std::vector<IndexType>* positions) const {
+    const uint64_t* const data = data_.data();
+    positions->reserve(positions->size() + BitCount());
+    for (int bucket = 0; bucket < data_.size(); ++bucket) {
+      uint64_t word = data[bucket];
+      while (word != 0) {
+        positions->push_back(IndexType(BitShift64(bucket) |
+                                       LeastSignificantBitPosition64(word)));
+        word &= word - 1;
+      }
     }
   }
 
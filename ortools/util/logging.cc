@@ -16,15 +16,95 @@
 #include <algorithm>
 #include <functional>
 #include <iostream>
+#include <memory>
 #include <ostream>
 #include <string>
+#include <thread>  // NOLINT
+#include <utility>
+#include <vector>
 
+#include "absl/base/thread_annotations.h"
+#include "absl/log/check.h"
 #include "absl/strings/str_cat.h"
+#include "absl/synchronization/mutex.h"
 
 namespace operations_research {
 
+// A bounded queue of messages, emptied by a thread calling OutputMessage() on
+// it. The messages are taken as a batch each time, so that the producers only
+// hold the mutex to append their message.
+class SolverLogger::AsynchronousOutput {
+ public:
+  AsynchronousOutput(SolverLogger* logger, int max_pending_messages)
+      : logger_(logger), max_pending_messages_(max_pending_messages) {
+    CHECK_GE(max_pending_messages, 1);
+    thread_ = std::thread([this]() { Run(); });
+  }
+
+  // Outputs the queued messages and stops the thread.
+  ~AsynchronousOutput() {
+    {
+      const absl::MutexLock lock(&mutex_);
+      stop_ = true;
+    }
+    thread_.join();
+  }
+
+  void Push(const std::string& message) {
+    const auto has_room = [this]() ABSL_SHARED_LOCKS_REQUIRED(mutex_) {
+      return pending_.size() < max_pending_messages_;
+    };
+    const absl::MutexLock lock(&mutex_);
+    mutex_.Await(absl::Condition(&has_room));
+    pending_.push_back(message);
+    ++num_unwritten_;
+  }
+
+  void Flush() {
+    const auto all_written = [this]() ABSL_SHARED_LOCKS_REQUIRED(mutex_) {
+      return num_unwritten_ == 0;
+    };
+    const absl::MutexLock lock(&mutex_);
+    mutex_.Await(absl::Condition(&all_written));
+  }
+
+ private:
+  void Run() {
+    const auto has_work = [this]() ABSL_SHARED_LOCKS_REQUIRED(mutex_) {
+      return !pending_.empty() || stop_;
+    };
+    std::vector<std::string> batch;
+    while (true) {
+      {
+        const absl::MutexLock lock(&mutex_);
+        mutex_.Await(absl::Condition(&has_work));
+        if (pending_.empty()) return;  // stop_ is true.
+        std::swap(batch, pending_);
+      }
+      for (const std::string& message : batch) {
+        logger_->OutputMessage(message);
+      }
+      const int num_written = batch.size();
+      batch.clear();
+      const absl::MutexLock lock(&mutex_);
+      num_unwritten_ -= num_written;
+    }
+  }
+
+  SolverLogger* const logger_;
+  const int max_pending_messages_;
+  absl::Mutex mutex_;
+  std::vector<std::string> pending_ ABSL_GUARDED_BY(mutex_);
+  // The number of messages pushed but not yet output.
+  int64_t num_unwritten_ ABSL_GUARDED_BY(mutex_) = 0;
+  bool stop_ ABSL_GUARDED_BY(mutex_) = false;
+  std::thread thread_;
+};
+
 SolverLogger::SolverLogger() { timer_.Start(); }
 
+SolverLogger::~SolverLogger() = default;
+
 void SolverLogger::AddInfoLoggingCallback(
     std::function<void(const std::string& message)> callback) {
   info_callbacks_.push_back(callback);
@@ -34,6 +114,14 @@ void SolverLogger::ClearInfoLoggingCallbacks() { info_callbacks_.clear(); }
 
 void SolverLogger::LogInfo(const char* source_filename, int source_line,
                            const std::string& message) {
+  if (async_output_ != nullptr) {
+    async_output_->Push(message);
+  } else {
+    OutputMessage(message);
+  }
+}
+
+void SolverLogger::OutputMessage(const std::string& message) {
   if (log_to_stdout_) {
     std::cout << message << std::endl;
   }
@@ -43,6 +131,21 @@ void SolverLogger::LogInfo(const char* source_filename, int source_line,
   }
 }
 
+void SolverLogger::SetAsynchronous(bool asynchronous,
+                                   int max_pending_messages) {
+  if (asynchronous == IsAsynchronous()) return;
+  if (asynchronous) {
+    async_output_ =
+        std::make_unique<AsynchronousOutput>(this, max_pending_messages);
+  } else {
+    async_output_.reset();
+  }
+}
+
+void SolverLogger::FlushAsynchronousMessages() {
+  if (async_output_ != nullptr) async_output_->Flush();
+}
+
 int SolverLogger::GetNewThrottledId() {
   const int id = id_to_throttling_data_.size();
   id_to_throttling_data_.resize(id + 1);
@@ -14,7 +14,9 @@
 #ifndef OR_TOOLS_UTIL_LOGGING_H_
 #define OR_TOOLS_UTIL_LOGGING_H_
 
+#include <cstdint>
 #include <functional>
+#include <memory>
 #include <string>
 #include <vector>
 
@@ -33,10 +35,12 @@ namespace operations_research {
 //
 // Important: This class is currently not thread-safe, it is easy to add a mutex
 // if needed. In CP-SAT, we currently make sure all access to this class do not
-// happen concurrently.
+// happen concurrently. Only LogInfo() is thread-safe in asynchronous mode, see
+// SetAsynchronous().
 class SolverLogger {
  public:
   SolverLogger();
+  ~SolverLogger();
 
   // Enables all logging.
   //
@@ -66,6 +70,23 @@ class SolverLogger {
   void LogInfo(const char* source_filename, int source_line,
                const std::string& message);
 
+  // In asynchronous mode, LogInfo() only queues the message, and a background
+  // thread writes the queued messages to stdout and passes them to the
+  // callbacks, in order. LogInfo() is then thread-safe, and only blocks when
+  // `max_pending_messages` messages are already queued. Note that the callbacks
+  // are then run on the background thread.
+  //
+  // The callbacks and SetLogToStdOut() must not be changed while in
+  // asynchronous mode, and this must not be called concurrently with
+  // LogInfo(). Leaving the asynchronous mode (or destroying the logger) first
+  // outputs all the queued messages.
+  void SetAsynchronous(bool asynchronous, int max_pending_messages = 1024);
+  bool IsAsynchronous() const { return async_output_ != nullptr; }
+
+  // Waits until all the messages queued by LogInfo() in asynchronous mode have
+  // been output. Does nothing in synchronous mode.
+  void FlushAsynchronousMessages();
+
   // Facility to avoid having multi megabytes logs when it brings little
   // benefits. Logs with the same id will be kept under an average of
   // throttling_rate_ logs per second.
@@ -91,6 +112,13 @@ class SolverLogger {
   };
   bool RateIsOk(const ThrottlingData& data);
 
+  // Writes a message to stdout and passes it to all callbacks.
+  void OutputMessage(const std::string& message);
+
+  // The queue and thread of the asynchronous mode, defined in the .cc.
+  class AsynchronousOutput;
+  std::unique_ptr<AsynchronousOutput> async_output_;
+
   bool is_enabled_ = false;
   bool log_to_stdout_ = false;
   std::vector<std::function<void(const std::string& message)>> info_callbacks_;
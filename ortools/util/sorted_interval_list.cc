@@ -375,7 +375,44 @@ void Domain::NegateInPlace() {
   DCHECK(IntervalsAreSortedAndNonAdjacent(intervals_));
 }
 
+void Domain::IntersectWithIntervalInPlace(const ClosedInterval interval) {
+  DCHECK_LE(interval.start, interval.end);
+  // Each interval of the domain gives at most one interval of the result, so
+  // the result can be written over the intervals already read.
+  int new_size = 0;
+  for (int i = 0; i < intervals_.size(); ++i) {
+    const ClosedInterval current = intervals_[i];
+    if (current.end < interval.start) continue;
+    if (current.start > interval.end) break;
+    intervals_[new_size++] = {std::max(current.start, interval.start),
+                              std::min(current.end, interval.end)};
+  }
+  intervals_.resize(new_size);
+  // Go back to the inlined storage, like UnionOfSortedIntervals().
+  if (new_size <= 1) intervals_.shrink_to_fit();
+  DCHECK(IntervalsAreSortedAndNonAdjacent(intervals_));
+}
+
+void Domain::IntersectInPlace(const Domain& domain) {
+  if (domain.intervals_.size() == 1) {
+    IntersectWithIntervalInPlace(domain.intervals_[0]);
+  } else if (intervals_.size() == 1 && !domain.intervals_.empty()) {
+    const ClosedInterval interval = intervals_[0];
+    *this = domain;
+    IntersectWithIntervalInPlace(interval);
+  } else {
+    *this = IntersectionWith(domain);
+  }
+}
+
 Domain Domain::IntersectionWith(const Domain& domain) const {
+  if (domain.intervals_.size() == 1) {
+    Domain result = *this;
+    result.IntersectWithIntervalInPlace(domain.intervals_[0]);
+    return result;
+  }
+  if (intervals_.size() == 1) return domain.IntersectionWith(*this);
+
   Domain result;
   const auto& a = intervals_;
   const auto& b = domain.intervals_;
@@ -425,7 +462,49 @@ Domain Domain::UnionWith(const Domain& domain) const {
 }
 
 // TODO(user): Use a better algorithm.
+void Domain::AddIntervalInPlace(const ClosedInterval interval) {
+  DCHECK_LE(interval.start, interval.end);
+  // Same as the loop of AdditionWith() for a single interval j. Since the
+  // starts and ends are shifted by non-decreasing functions, the result is
+  // still sorted.
+  const ClosedInterval j = interval;
+  int new_size = 0;
+  for (int index = 0; index < intervals_.size(); ++index) {
+    const ClosedInterval i = intervals_[index];
+    if (i.start > 0 && j.start > 0) {
+      if (AddOverflows(i.start, j.start)) continue;  // empty.
+      intervals_[new_size++] = {i.start + j.start, CapAdd(i.end, j.end)};
+    } else if (i.end < 0 && j.end < 0) {
+      if (AddOverflows(i.end, j.end)) continue;  // empty.
+      intervals_[new_size++] = {CapAdd(i.start, j.start), i.end + j.end};
+    } else {
+      intervals_[new_size++] = {CapAdd(i.start, j.start), CapAdd(i.end, j.end)};
+    }
+  }
+  intervals_.resize(new_size);
+  UnionOfSortedIntervals(&intervals_);
+}
+
+void Domain::AddInPlace(const Domain& domain) {
+  if (domain.intervals_.size() == 1) {
+    AddIntervalInPlace(domain.intervals_[0]);
+  } else if (intervals_.size() == 1) {
+    const ClosedInterval interval = intervals_[0];
+    *this = domain;
+    AddIntervalInPlace(interval);
+  } else {
+    *this = AdditionWith(domain);
+  }
+}
+
 Domain Domain::AdditionWith(const Domain& domain) const {
+  if (domain.intervals_.size() == 1) {
+    Domain result = *this;
+    result.AddIntervalInPlace(domain.intervals_[0]);
+    return result;
+  }
+  if (intervals_.size() == 1) return domain.AdditionWith(*this);
+
   Domain result;
 
   const auto& a = intervals_;
@@ -499,15 +578,19 @@ Domain Domain::MultiplicationBy(int64_t coeff, bool* exact) const {
   return result;
 }
 
-Domain Domain::ContinuousMultiplicationBy(int64_t coeff) const {
-  Domain result = *this;
+void Domain::ContinuousMultiplyInPlace(int64_t coeff) {
   const int64_t abs_coeff = std::abs(coeff);
-  for (ClosedInterval& i : result.intervals_) {
+  for (ClosedInterval& i : intervals_) {
     i.start = CapProd(i.start, abs_coeff);
     i.end = CapProd(i.end, abs_coeff);
   }
-  UnionOfSortedIntervals(&result.intervals_);
-  if (coeff < 0) result.NegateInPlace();
+  UnionOfSortedIntervals(&intervals_);
+  if (coeff < 0) NegateInPlace();
+}
+
+Domain Domain::ContinuousMultiplicationBy(int64_t coeff) const {
+  Domain result = *this;
+  result.ContinuousMultiplyInPlace(coeff);
   return result;
 }
 
@@ -329,6 +329,14 @@ class Domain {
    */
   Domain IntersectionWith(const Domain& domain) const;
 
+#if !defined(SWIG)
+  /**
+   * Same as IntersectionWith() but modifies D. This doesn't allocate when
+   * domain is a single interval.
+   */
+  void IntersectInPlace(const Domain& domain);
+#endif  // !defined(SWIG)
+
   /**
    * Returns the union of D and domain.
    */
@@ -339,6 +347,14 @@ class Domain {
    */
   Domain AdditionWith(const Domain& domain) const;
 
+#if !defined(SWIG)
+  /**
+   * Same as AdditionWith() but modifies D. This doesn't allocate when domain
+   * is a single interval.
+   */
+  void AddInPlace(const Domain& domain);
+#endif  // !defined(SWIG)
+
   /**
    * Returns {x ∈ Int64, ∃ e ∈ D, x = e * coeff}.
    *
@@ -371,6 +387,14 @@ class Domain {
    */
   Domain ContinuousMultiplicationBy(int64_t coeff) const;
 
+#if !defined(SWIG)
+  /**
+   * Same as ContinuousMultiplicationBy(coeff) but modifies D, without
+   * allocating.
+   */
+  void ContinuousMultiplyInPlace(int64_t coeff);
+#endif  // !defined(SWIG)
+
   /**
    * Returns a superset of MultiplicationBy() to avoid the explosion in the
    * representation size. This behaves as if we replace the set D of
@@ -487,6 +511,12 @@ class Domain {
   // Same as Negation() but modify the current domain.
   void NegateInPlace();
 
+  // Intersects the current domain with a single non-empty interval.
+  void IntersectWithIntervalInPlace(ClosedInterval interval);
+
+  // Adds a single non-empty interval to the current domain.
+  void AddIntervalInPlace(ClosedInterval interval);
+
   // Some functions relax the domain when its "complexity" (i.e NumIntervals())
   // become too large.
   static constexpr int kDomainComplexityLimit = 100;
@@ -14,12 +14,18 @@
 #include "ortools/util/stats.h"
 
 #include <algorithm>
+#include <atomic>
 #include <cmath>
+#include <cstdint>
 #include <string>
 #include <vector>
 
+#include "absl/base/thread_annotations.h"
 #include "absl/log/check.h"
+#include "absl/strings/str_cat.h"
 #include "absl/strings/str_format.h"
+#include "absl/strings/string_view.h"
+#include "absl/synchronization/mutex.h"
 #include "ortools/base/logging.h"
 #include "ortools/base/stl_util.h"
 #include "ortools/base/types.h"
@@ -241,4 +247,109 @@ std::string IntegerDistribution::ValueAsString() const {
                          max_, Average(), StdDeviation(), sum_);
 }
 
+namespace internal {
+std::atomic<bool> profiling_counters_enabled{false};
+}  // namespace internal
+
+namespace {
+
+// The list of all the ProfilingCounter, which are never destroyed.
+struct ProfilingCounterList {
+  absl::Mutex mutex;
+  std::vector<ProfilingCounter*> counters ABSL_GUARDED_BY(mutex);
+};
+
+ProfilingCounterList& GetProfilingCounterList() {
+  static ProfilingCounterList* const list = new ProfilingCounterList();
+  return *list;
+}
+
+}  // namespace
+
+void EnableProfilingCounters(bool enabled) {
+  internal::profiling_counters_enabled.store(enabled,
+                                             std::memory_order_relaxed);
+}
+
+ProfilingCounter::ProfilingCounter(absl::string_view name) : name_(name) {
+  ProfilingCounterList& list = GetProfilingCounterList();
+  const absl::MutexLock lock(&list.mutex);
+  list.counters.push_back(this);
+}
+
+int ProfilingCounter::ShardOfThisThread() {
+  static std::atomic<int> next_shard{0};
+  thread_local const int shard =
+      next_shard.fetch_add(1, std::memory_order_relaxed) % kNumShards;
+  return shard;
+}
+
+int64_t ProfilingCounter::NumCalls() const {
+  int64_t num_calls = 0;
+  for (const Shard& shard : shards_) {
+    num_calls += shard.num_calls.load(std::memory_order_relaxed);
+  }
+  return num_calls;
+}
+
+int64_t ProfilingCounter::TotalNanos() const {
+  int64_t total_nanos = 0;
+  for (const Shard& shard : shards_) {
+    total_nanos += shard.total_nanos.load(std::memory_order_relaxed);
+  }
+  return total_nanos;
+}
+
+void ProfilingCounter::Reset() {
+  for (Shard& shard : shards_) {
+    shard.num_calls.store(0, std::memory_order_relaxed);
+    shard.total_nanos.store(0, std::memory_order_relaxed);
+  }
+}
+
+std::vector<ProfilingCounterSample> ProfilingCountersSnapshot() {
+  std::vector<ProfilingCounterSample> samples;
+  {
+    ProfilingCounterList& list = GetProfilingCounterList();
+    const absl::MutexLock lock(&list.mutex);
+    samples.reserve(list.counters.size());
+    for (const ProfilingCounter* counter : list.counters) {
+      samples.push_back({.name = counter->name(),
+                         .num_calls = counter->NumCalls(),
+                         .total_seconds = counter->TotalNanos() * 1e-9});
+    }
+  }
+  std::sort(samples.begin(), samples.end(),
+            [](const ProfilingCounterSample& a,
+               const ProfilingCounterSample& b) { return a.name < b.name; });
+  return samples;
+}
+
+std::string ProfilingCountersAsPrometheusText() {
+  const std::vector<ProfilingCounterSample> samples =
+      ProfilingCountersSnapshot();
+  // The samples of a metric must be grouped after its TYPE line.
+  std::string result = "# TYPE ortools_profiling_calls_total counter\n";
+  for (const ProfilingCounterSample& sample : samples) {
+    absl::StrAppendFormat(&result,
+                          "ortools_profiling_calls_total{counter=\"%s\"} %d\n",
+                          sample.name, sample.num_calls);
+  }
+  absl::StrAppend(&result, "# TYPE ortools_profiling_seconds_total counter\n");
+  for (const ProfilingCounterSample& sample : samples) {
+    absl::StrAppendFormat(
+        &result, "ortools_profiling_seconds_total{counter=\"%s\"} %.9f\n",
+        sample.name, sample.total_seconds);
+  }
+  return result;
+}
+
+void ResetProfilingCounters() {
+  ProfilingCounterList& list = GetProfilingCounterList();
+  const absl::MutexLock lock(&list.mutex);
+  for (ProfilingCounter* counter : list.counters) {
+    counter->Reset();
+  }
+}
+
 }  // namespace operations_research
@@ -64,15 +64,21 @@
 // The idea is that by default the instrumentation is off. You can also use the
 // macro IF_STATS_ENABLED() that does nothing if OR_STATS is not defined or just
 // translates to its argument otherwise.
+//
+// The ProfilingCounter at the end of this file are instead always compiled in
+// and enabled at run time, see SCOPED_PROFILING_COUNTER().
 
 #ifndef OR_TOOLS_UTIL_STATS_H_
 #define OR_TOOLS_UTIL_STATS_H_
 
+#include <atomic>
+#include <cstdint>
 #include <map>
 #include <string>
 #include <vector>
 
 #include "absl/strings/string_view.h"
+#include "absl/time/clock.h"
 #include "absl/time/time.h"
 #include "ortools/base/timer.h"
 
@@ -419,6 +425,130 @@ using ScopedInstructionCounter = DisabledScopedInstructionCounter;
 
 #endif  // OR_STATS
 
+// Process-wide counters of the number of calls of, and time spent in, a few
+// hot functions of the solvers, which can be enabled at run time, e.g. to
+// monitor a production binary:
+//
+//   Status RevisedSimplex::UpdateAndPivot(...) {
+//     SCOPED_PROFILING_COUNTER("glop.UpdateAndPivot");
+//     ...
+//   }
+//
+//   EnableProfilingCounters(true);
+//   ...  // Solve.
+//   // From any thread, e.g. in a callback of the solve:
+//   LOG(INFO) << ProfilingCountersAsPrometheusText();
+//
+// When the counters are disabled (the default), a SCOPED_PROFILING_COUNTER()
+// costs a relaxed atomic load. When enabled, it reads the clock twice and
+// updates the counter without lock, on one of a few cache lines shared by
+// fewer threads.
+
+// Enables or disables the profiling counters. This can be called at any time;
+// the scopes running when the counters are enabled are not counted.
+void EnableProfilingCounters(bool enabled);
+
+namespace internal {
+extern std::atomic<bool> profiling_counters_enabled;
+}  // namespace internal
+
+inline bool ProfilingCountersEnabled() {
+  return internal::profiling_counters_enabled.load(std::memory_order_relaxed);
+}
+
+class ProfilingCounter {
+ public:
+  // Registers the counter in the process-wide list of counters. Counters are
+  // never unregistered, so they must never be destroyed, and there should be
+  // one counter for a given name. `name` should only contain letters, digits,
+  // '.' and '_'.
+  explicit ProfilingCounter(absl::string_view name);
+
+  // This type is neither copyable nor movable.
+  ProfilingCounter(const ProfilingCounter&) = delete;
+  ProfilingCounter& operator=(const ProfilingCounter&) = delete;
+
+  const std::string& name() const { return name_; }
+
+  // Counts one call that took `nanos` nanoseconds. Thread-safe.
+  void Add(int64_t nanos) {
+    Shard& shard = shards_[ShardOfThisThread()];
+    shard.num_calls.fetch_add(1, std::memory_order_relaxed);
+    shard.total_nanos.fetch_add(nanos, std::memory_order_relaxed);
+  }
+
+  // The totals over all the threads. Thread-safe, but not atomic with respect
+  // to concurrent calls to Add().
+  int64_t NumCalls() const;
+  int64_t TotalNanos() const;
+
+  void Reset();
+
+ private:
+  static constexpr int kNumShards = 16;
+
+  // Each thread always uses the same shard, assigned in a round-robin way.
+  static int ShardOfThisThread();
+
+  struct alignas(64) Shard {
+    std::atomic<int64_t> num_calls{0};
+    std::atomic<int64_t> total_nanos{0};
+  };
+
+  const std::string name_;
+  Shard shards_[kNumShards];
+};
+
+// Times the scope in which it is defined and adds it to a ProfilingCounter,
+// if the counters are enabled when it is created.
+class ScopedProfilingCounter {
+ public:
+  // Note that this does not take ownership of the given counter.
+  explicit ScopedProfilingCounter(ProfilingCounter* counter)
+      : counter_(ProfilingCountersEnabled() ? counter : nullptr),
+        start_nanos_(counter_ == nullptr ? 0 : absl::GetCurrentTimeNanos()) {}
+
+  // This type is neither copyable nor movable.
+  ScopedProfilingCounter(const ScopedProfilingCounter&) = delete;
+  ScopedProfilingCounter& operator=(const ScopedProfilingCounter&) = delete;
+
+  ~ScopedProfilingCounter() {
+    if (counter_ != nullptr) {
+      counter_->Add(absl::GetCurrentTimeNanos() - start_nanos_);
+    }
+  }
+
+ private:
+  ProfilingCounter* const counter_;
+  const int64_t start_nanos_;
+};
+
+// Counts the calls and the time spent from this macro line to the end of the
+// scope in the counter `name`, which must be a string literal.
+#define SCOPED_PROFILING_COUNTER(name)                                  \
+  static operations_research::ProfilingCounter* const                   \
+      scoped_profiling_counter_counter =                                \
+          new operations_research::ProfilingCounter(name);              \
+  operations_research::ScopedProfilingCounter scoped_profiling_counter( \
+      scoped_profiling_counter_counter)
+
+struct ProfilingCounterSample {
+  std::string name;
+  int64_t num_calls = 0;
+  double total_seconds = 0.0;
+};
+
+// Returns the values of all the counters, sorted by name. Thread-safe.
+std::vector<ProfilingCounterSample> ProfilingCountersSnapshot();
+
+// Returns the values of all the counters in the text exposition format of
+// Prometheus, as the metrics `ortools_profiling_calls_total` and
+// `ortools_profiling_seconds_total` with a `counter` label. Thread-safe.
+std::string ProfilingCountersAsPrometheusText();
+
+// Resets all the counters to zero. Thread-safe.
+void ResetProfilingCounters();
+
 }  // namespace operations_research
 
 #endif  // OR_TOOLS_UTIL_STATS_H_
@@ -14,10 +14,13 @@
 #include "ortools/util/time_limit.h"
 
 #include <algorithm>
+#include <atomic>
+#include <cstdint>
 #include <limits>
 #include <memory>
 #include <string>
 #include <utility>
+#include <vector>
 
 #include "absl/strings/str_cat.h"
 
@@ -37,16 +40,76 @@ std::string TimeLimit::DebugString() const {
       "\nDeterministic time left: ", (GetDeterministicTimeLeft()),
       "\nElapsed time: ", (GetElapsedTime()),
       "\nElapsed deterministic time: ", (GetElapsedDeterministicTime()));
-#ifndef NDEBUG
-  for (const auto& counter : deterministic_counters_) {
-    const std::string& counter_name = counter.first;
-    const double counter_value = counter.second;
-    absl::StrAppend(&buffer, "\n", counter_name, ": ", (counter_value));
+  for (const DeterministicCounter& counter : GetDeterministicCounters()) {
+    absl::StrAppend(&buffer, "\n", counter.name, ": ",
+                    counter.deterministic_time);
+    if (counter.deterministic_time > 0.0) {
+      absl::StrAppend(&buffer, " (wall/deterministic time: ",
+                      counter.wall_time / counter.deterministic_time, ")");
+    }
   }
-#endif
   return buffer;
 }
 
+int SharedTimeLimit::SlotOfThisThread() {
+  static std::atomic<int> next_slot{0};
+  thread_local const int slot =
+      next_slot.fetch_add(1, std::memory_order_relaxed) % kNumSlots;
+  return slot;
+}
+
+void SharedTimeLimit::FlushPendingDeterministicTime() const {
+  double pending = 0.0;
+  for (Slot& slot : pending_deterministic_time_) {
+    pending += slot.value.exchange(0.0, std::memory_order_relaxed);
+  }
+  if (pending > 0.0) time_limit_->AdvanceDeterministicTime(pending);
+  deterministic_time_left_.store(time_limit_->GetDeterministicTimeLeft(),
+                                 std::memory_order_relaxed);
+}
+
+void TimeLimit::EnableDeterministicCounters(bool enable) {
+  if (enable && !counters_enabled_) {
+    last_counter_update_ns_ = absl::GetCurrentTimeNanos();
+  }
+  counters_enabled_ = enable;
+}
+
+void TimeLimit::UpdateDeterministicCounter(const char* counter_name,
+                                           double deterministic_duration) {
+  const int64_t now_ns = absl::GetCurrentTimeNanos();
+  DeterministicCounter& counter = deterministic_counters_[counter_name];
+  ++counter.num_calls;
+  counter.deterministic_time += deterministic_duration;
+  counter.wall_time += 1e-9 * (now_ns - last_counter_update_ns_);
+  last_counter_update_ns_ = now_ns;
+}
+
+std::vector<TimeLimit::DeterministicCounter>
+TimeLimit::GetDeterministicCounters() const {
+  std::vector<DeterministicCounter> result;
+  result.reserve(deterministic_counters_.size());
+  for (const auto& [name, counter] : deterministic_counters_) {
+    result.push_back(counter);
+    result.back().name = name;
+  }
+  std::sort(result.begin(), result.end(),
+            [](const DeterministicCounter& a, const DeterministicCounter& b) {
+              return a.name < b.name;
+            });
+  return result;
+}
+
+void TimeLimit::MergeDeterministicCounters(const TimeLimit& other) {
+  if (!counters_enabled_) return;
+  for (const auto& [name, other_counter] : other.deterministic_counters_) {
+    DeterministicCounter& counter = deterministic_counters_[name];
+    counter.num_calls += other_counter.num_calls;
+    counter.deterministic_time += other_counter.deterministic_time;
+    counter.wall_time += other_counter.wall_time;
+  }
+}
+
 NestedTimeLimit::NestedTimeLimit(TimeLimit* base_time_limit,
                                  double limit_in_seconds,
                                  double deterministic_limit)
@@ -58,10 +121,20 @@ NestedTimeLimit::NestedTimeLimit(TimeLimit* base_time_limit,
     time_limit_.RegisterExternalBooleanAsLimit(
         base_time_limit_->external_boolean_as_limit_);
   }
+  time_limit_.EnableDeterministicCounters(base_time_limit_->counters_enabled_);
 }
 
 NestedTimeLimit::~NestedTimeLimit() {
-  base_time_limit_->AdvanceDeterministicTime(
-      time_limit_.GetElapsedDeterministicTime());
+  // The nested counters already account for the deterministic time, so it is
+  // not added again to the "unnamed" counter of the base limit.
+  if (base_time_limit_->counters_enabled_) {
+    base_time_limit_->elapsed_deterministic_time_ +=
+        time_limit_.GetElapsedDeterministicTime();
+    base_time_limit_->MergeDeterministicCounters(time_limit_);
+    base_time_limit_->last_counter_update_ns_ = absl::GetCurrentTimeNanos();
+  } else {
+    base_time_limit_->AdvanceDeterministicTime(
+        time_limit_.GetElapsedDeterministicTime());
+  }
 }
 }  // namespace operations_research
@@ -16,6 +16,7 @@
 
 #include <algorithm>
 #include <atomic>
+#include <cstdint>
 #include <limits>
 #include <memory>
 #include <string>
@@ -59,12 +60,12 @@ namespace operations_research {
  *
  * The deterministic time limit can be logged at a more granular level: the
  * method TimeLimit::AdvanceDeterministicTime takes an optional string argument:
- * the name of a counter. In debug mode, the time limit object computes also the
- * elapsed time for each named counter separately, and these values can be used
- * to determine the coefficients for computing the deterministic duration from
- * the number of operations. The values of the counters can be printed using
- * TimeLimit::DebugString(). There is no API to access the values of the
- * counters directly, because they do not exist in optimized mode.
+ * the name of a counter. In debug mode, or when EnableDeterministicCounters()
+ * was called, the time limit object computes also the elapsed deterministic
+ * time and wall time for each named counter separately, and these values can
+ * be used to determine the coefficients for computing the deterministic
+ * duration from the number of operations. The values of the counters are
+ * returned by GetDeterministicCounters() and printed by DebugString().
  *
  * The basic steps for determining coefficients for the deterministic time are:
  * 1. Run the code in debug mode to collect the values of the deterministic time
@@ -80,9 +81,15 @@ namespace operations_research {
  *    measurement error and T is the measured real time. The equation can be
  *    solved e.g. using the least squares method.
  *
- * Note that in optimized mode, the counters are disabled for performance
- * reasons, and calling AdvanceDeterministicTime(duration, counter_name) is
- * equivalent to calling AdvanceDeterministicTime(duration).
+ * On a given host, the ratio of the wall time to the deterministic time of a
+ * counter (see DeterministicCounter) tells how much wall time a deterministic
+ * limit costs in this component, and thus which max_deterministic_time gives a
+ * reproducible budget of a given wall time.
+ *
+ * Note that in optimized mode, the counters are disabled by default for
+ * performance reasons, and calling AdvanceDeterministicTime(duration,
+ * counter_name) is then equivalent to calling
+ * AdvanceDeterministicTime(duration).
  */
 // TODO(user): The expression "deterministic time" should be replaced with
 //                 "number of operations" to avoid confusion with "real" time.
@@ -178,6 +185,9 @@ class TimeLimit {
   inline void AdvanceDeterministicTime(double deterministic_duration) {
     DCHECK_LE(0.0, deterministic_duration);
     elapsed_deterministic_time_ += deterministic_duration;
+    if (counters_enabled_) {
+      UpdateDeterministicCounter(kUnnamedCounter, deterministic_duration);
+    }
   }
 
   /**
@@ -185,18 +195,53 @@ class TimeLimit {
    * deterministic time doesn't advance automatically as the regular elapsed
    * time does.
    *
-   * In debug mode, this method also updates the deterministic time counter with
-   * the given name. In optimized mode, this method is equivalent to
+   * If the counters are enabled (see EnableDeterministicCounters()), this
+   * method also updates the deterministic time counter with the given name.
+   * Otherwise, this method is equivalent to
    * \c AdvanceDeterministicTime(double).
    */
   inline void AdvanceDeterministicTime(double deterministic_duration,
                                        const char* counter_name) {
-    AdvanceDeterministicTime(deterministic_duration);
-#ifndef NDEBUG
-    deterministic_counters_[counter_name] += deterministic_duration;
-#endif
+    DCHECK_LE(0.0, deterministic_duration);
+    elapsed_deterministic_time_ += deterministic_duration;
+    if (counters_enabled_) {
+      UpdateDeterministicCounter(counter_name, deterministic_duration);
+    }
   }
 
+  /**
+   * The values of a deterministic time counter. The wall time of a call to
+   * AdvanceDeterministicTime() is the time elapsed since the previous call (or
+   * since the counters were enabled), i.e. the time spent doing the work whose
+   * deterministic duration is reported.
+   */
+  struct DeterministicCounter {
+    std::string name;
+    int64_t num_calls = 0;
+    double deterministic_time = 0.0;
+    double wall_time = 0.0;
+  };
+
+  /**
+   * Enables or disables the deterministic time counters, which are enabled by
+   * default in debug mode only. The calls to AdvanceDeterministicTime()
+   * without a counter name are counted in the counter "unnamed".
+   */
+  void EnableDeterministicCounters(bool enable);
+  bool DeterministicCountersEnabled() const { return counters_enabled_; }
+
+  /**
+   * Returns the deterministic time counters, sorted by name.
+   */
+  std::vector<DeterministicCounter> GetDeterministicCounters() const;
+
+  /**
+   * Adds the counters of `other` to the ones of this object, e.g. for a
+   * TimeLimit used by a sub-algorithm. Does nothing if the counters of this
+   * object are disabled.
+   */
+  void MergeDeterministicCounters(const TimeLimit& other);
+
   /**
    * Returns the time elapsed in seconds since the construction of this object.
    */
@@ -281,6 +326,11 @@ class TimeLimit {
  private:
   void ResetTimers(double limit_in_seconds, double deterministic_limit);
 
+  static constexpr char kUnnamedCounter[] = "unnamed";
+
+  void UpdateDeterministicCounter(const char* counter_name,
+                                  double deterministic_duration);
+
   mutable int64_t start_ns_;  // Not const! this is initialized after
                               // instruction counter initialization.
   int64_t last_ns_;
@@ -299,15 +349,30 @@ class TimeLimit {
   std::atomic<bool>* secondary_external_boolean_as_limit_ = nullptr;
 
 #ifndef NDEBUG
-  // Contains the values of the deterministic time counters.
-  absl::flat_hash_map<std::string, double> deterministic_counters_;
+  bool counters_enabled_ = true;
+#else
+  bool counters_enabled_ = false;
 #endif
+  // The time of the last update of the counters.
+  int64_t last_counter_update_ns_ = 0;
+  // Contains the values of the deterministic time counters, the name of the
+  // DeterministicCounter being unused.
+  absl::flat_hash_map<std::string, DeterministicCounter>
+      deterministic_counters_;
 
   friend class NestedTimeLimit;
   friend class ParallelTimeLimit;
 };
 
 // Wrapper around TimeLimit to make it thread safe and add Stop() support.
+//
+// Many workers can call LimitReached() and AdvanceDeterministicTime()
+// concurrently without contending on a lock: the deterministic durations are
+// accumulated in a few atomic slots, one per group of threads, and only added
+// to the wrapped TimeLimit by the thread that gets to check its wall time
+// limit, see LimitReached(). The other methods (e.g. UpdateLocalLimit()) first
+// add the pending deterministic time to the wrapped TimeLimit, which thus
+// lags behind the shared limit only while the shared limit is used.
 class SharedTimeLimit {
  public:
   explicit SharedTimeLimit(TimeLimit* time_limit)
@@ -318,34 +383,53 @@ class SharedTimeLimit {
       stopped_ = &stopped_boolean_;
       time_limit->RegisterExternalBooleanAsLimit(stopped_);
     }
+    deterministic_time_left_.store(time_limit->GetDeterministicTimeLeft(),
+                                   std::memory_order_relaxed);
   }
 
   ~SharedTimeLimit() {
+    absl::MutexLock lock(&mutex_);
+    FlushPendingDeterministicTime();
     if (stopped_ == &stopped_boolean_) {
       time_limit_->RegisterExternalBooleanAsLimit(nullptr);
     }
   }
 
+  // Lock free, except for the check of the wall time limit, which is done by
+  // one thread at a time: when another thread is doing it, this returns false
+  // and the limit will be seen by the next calls.
   bool LimitReached() const {
+    if (stopped_->load(std::memory_order_relaxed)) return true;
+    if (PendingDeterministicTime() >=
+        deterministic_time_left_.load(std::memory_order_relaxed)) {
+      return true;
+    }
     // Note, time_limit_->LimitReached() is not const, and changes internal
     // state of time_limit_, hence we need a writer's lock.
-    absl::MutexLock lock(&mutex_);
-    return time_limit_->LimitReached();
+    if (!mutex_.TryLock()) return false;
+    FlushPendingDeterministicTime();
+    const bool limit_reached = time_limit_->LimitReached();
+    mutex_.Unlock();
+    return limit_reached;
   }
 
-  void Stop() {
-    absl::MutexLock lock(&mutex_);
-    *stopped_ = true;
-  }
+  void Stop() { stopped_->store(true); }
 
   void UpdateLocalLimit(TimeLimit* local_limit) {
     absl::MutexLock lock(&mutex_);
+    FlushPendingDeterministicTime();
     local_limit->MergeWithGlobalTimeLimit(time_limit_);
   }
 
+  // Lock free.
   void AdvanceDeterministicTime(double deterministic_duration) {
-    absl::MutexLock lock(&mutex_);
-    time_limit_->AdvanceDeterministicTime(deterministic_duration);
+    std::atomic<double>& slot =
+        pending_deterministic_time_[SlotOfThisThread()].value;
+    double pending = slot.load(std::memory_order_relaxed);
+    while (!slot.compare_exchange_weak(pending,
+                                       pending + deterministic_duration,
+                                       std::memory_order_relaxed)) {
+    }
   }
 
   double GetTimeLeft() const {
@@ -355,21 +439,72 @@ class SharedTimeLimit {
 
   double GetElapsedDeterministicTime() const {
     absl::ReaderMutexLock lock(&mutex_);
-    return time_limit_->GetElapsedDeterministicTime();
+    return time_limit_->GetElapsedDeterministicTime() +
+           PendingDeterministicTime();
+  }
+
+  void AdvanceDeterministicTime(double deterministic_duration,
+                                const char* counter_name) {
+    absl::MutexLock lock(&mutex_);
+    time_limit_->AdvanceDeterministicTime(deterministic_duration,
+                                          counter_name);
+    deterministic_time_left_.store(time_limit_->GetDeterministicTimeLeft(),
+                                   std::memory_order_relaxed);
+  }
+
+  // Adds the deterministic time counters of `local_limit`, e.g. the limit of a
+  // worker, to the ones of the shared limit.
+  void MergeDeterministicCounters(const TimeLimit& local_limit) {
+    absl::MutexLock lock(&mutex_);
+    time_limit_->MergeDeterministicCounters(local_limit);
+  }
+
+  std::vector<TimeLimit::DeterministicCounter> GetDeterministicCounters()
+      const {
+    absl::MutexLock lock(&mutex_);
+    FlushPendingDeterministicTime();
+    return time_limit_->GetDeterministicCounters();
   }
 
   std::atomic<bool>* ExternalBooleanAsLimit() const {
-    absl::ReaderMutexLock lock(&mutex_);
     // We can simply return the "external bool" and remain thread-safe because
     // it's wrapped in std::atomic.
-    return time_limit_->ExternalBooleanAsLimit();
+    return stopped_;
   }
 
  private:
+  static constexpr int kNumSlots = 16;
+
+  // Each thread always uses the same slot, assigned in a round-robin way.
+  static int SlotOfThisThread();
+
+  double PendingDeterministicTime() const {
+    double pending = 0.0;
+    for (const Slot& slot : pending_deterministic_time_) {
+      pending += slot.value.load(std::memory_order_relaxed);
+    }
+    return pending;
+  }
+
+  // Moves the deterministic time of the slots to the wrapped TimeLimit.
+  void FlushPendingDeterministicTime() const
+      ABSL_EXCLUSIVE_LOCKS_REQUIRED(mutex_);
+
+  struct alignas(64) Slot {
+    std::atomic<double> value{0.0};
+  };
+
   mutable absl::Mutex mutex_;
   TimeLimit* time_limit_ ABSL_GUARDED_BY(mutex_);
-  std::atomic<bool> stopped_boolean_ ABSL_GUARDED_BY(mutex_);
-  std::atomic<bool>* stopped_ ABSL_GUARDED_BY(mutex_);
+  std::atomic<bool> stopped_boolean_;
+  // Set at construction, so it can be read without lock.
+  std::atomic<bool>* stopped_;
+  // The deterministic time added by AdvanceDeterministicTime() and not yet
+  // added to time_limit_.
+  mutable Slot pending_deterministic_time_[kNumSlots];
+  // The deterministic time left of time_limit_, updated when the pending
+  // deterministic time is flushed.
+  mutable std::atomic<double> deterministic_time_left_;
 };
 
 /**
@@ -468,6 +603,7 @@ inline void TimeLimit::ResetTimers(double limit_in_seconds,
   }
   start_ns_ = absl::GetCurrentTimeNanos();
   last_ns_ = start_ns_;
+  last_counter_update_ns_ = start_ns_;
   // Note that duration arithmetic is properly saturated.
   limit_ns_ = (absl::Seconds(limit_in_seconds) + absl::Nanoseconds(start_ns_)) /
               absl::Nanoseconds(1);